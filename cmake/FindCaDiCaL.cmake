@@ -6,6 +6,16 @@
 find_path(CaDiCaL_INCLUDE_DIR NAMES cadical.hpp)
 find_library(CaDiCaL_LIBRARIES NAMES cadical)
 
+# CaDiCaL_HAS_EXTERNAL_PROPAGATOR - CaDiCaL provides the external propagator
+#                                   interface (IPASIR-UP, CaDiCaL 1.9 or later)
+if(CaDiCaL_INCLUDE_DIR)
+  file(STRINGS "${CaDiCaL_INCLUDE_DIR}/cadical.hpp" CaDiCaL_PROPAGATOR_DECL
+    REGEX "class ExternalPropagator")
+  if(CaDiCaL_PROPAGATOR_DECL)
+    set(CaDiCaL_HAS_EXTERNAL_PROPAGATOR TRUE)
+  endif()
+endif()
+
 include(FindPackageHandleStandardArgs)
 find_package_handle_standard_args(CaDiCaL
   DEFAULT_MSG
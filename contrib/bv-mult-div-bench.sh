@@ -0,0 +1,80 @@
+#!/bin/bash
+#
+# contrib/bv-mult-div-bench.sh
+#
+# ./contrib/bv-mult-div-bench.sh <CVC4> [TIMEOUT] [WIDTH...]
+#
+# Compares the bit-blasting encodings of multiplication (--bv-mult) and of
+# unsigned division (--bv-div) on small generated QF_BV queries.  For each
+# width (32, 64 and 128 by default) and encoding it prints the result, the
+# solving time and the clause statistics of the bit-blaster, which can be
+# used to choose --bv-mult-wallace-width for --bv-mult=auto.
+
+CVC4=$1
+TIMEOUT=${2:-60}
+WIDTHS=${*:3}
+WIDTHS=${WIDTHS:-32 64 128}
+
+if [ -z "$CVC4" ] || [ ! -x "$CVC4" ]; then
+  echo "usage: $0 <CVC4> [TIMEOUT] [WIDTH...]" >&2
+  exit 1
+fi
+
+TMPDIR=$(mktemp -d)
+trap 'rm -rf "$TMPDIR"' EXIT
+
+# the low half of the product of two odd factors, which must be found again
+mult_query() {
+  local w=$1
+  cat <<EOF
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec $w))
+(declare-fun y () (_ BitVec $w))
+(assert (= (bvmul x y) (bvmul ((_ zero_extend $((w - 16))) #xfffb) ((_ zero_extend $((w - 16))) #xfff1))))
+(assert (bvugt x (_ bv1 $w)))
+(assert (bvugt y (_ bv1 $w)))
+(assert (bvult x (_ bv65536 $w)))
+(assert (bvult y (_ bv65536 $w)))
+(check-sat)
+EOF
+}
+
+# a dividend given by its quotient and remainder
+div_query() {
+  local w=$1
+  cat <<EOF
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec $w))
+(declare-fun y () (_ BitVec $w))
+(assert (= (bvudiv x y) (_ bv12345 $w)))
+(assert (= (bvurem x y) (_ bv678 $w)))
+(assert (bvugt y (_ bv1000 $w)))
+(check-sat)
+EOF
+}
+
+run() {
+  local file=$1
+  shift
+  local start=$(date +%s.%N)
+  local out=$(timeout "$TIMEOUT" "$CVC4" --stats "$@" "$file" 2>&1)
+  local end=$(date +%s.%N)
+  local result=$(echo "$out" | grep -m1 -E '^(sat|unsat|unknown)$')
+  local clauses=$(echo "$out" | grep -i 'clauses' | grep -i -E 'bitblast|bvminisat' \
+                  | sed 's/.*, *//' | paste -sd' ')
+  printf "%-32s %-8s %8.2fs  %s\n" "$*" "${result:-timeout}" \
+         "$(echo "$end - $start" | bc)" "$clauses"
+}
+
+for w in $WIDTHS; do
+  mult_query "$w" > "$TMPDIR/mult$w.smt2"
+  div_query "$w" > "$TMPDIR/div$w.smt2"
+  echo "== bvmul, width $w"
+  for mode in shift-add wallace; do
+    run "$TMPDIR/mult$w.smt2" --bv-mult=$mode
+  done
+  echo "== bvudiv/bvurem, width $w"
+  for mode in restoring non-restoring; do
+    run "$TMPDIR/div$w.smt2" --bv-div=$mode
+  done
+done
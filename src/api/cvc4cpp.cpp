@@ -49,10 +49,14 @@
 #include "smt/smt_engine.h"
 #include "theory/logic_info.h"
 #include "util/random.h"
+#include "util/resource_manager.h"
 #include "util/result.h"
+#include "util/statistics.h"
 #include "util/utility.h"
 
 #include <cstring>
+#include <future>
+#include <memory>
 #include <sstream>
 
 namespace CVC4 {
@@ -817,9 +821,9 @@ std::ostream& operator<<(std::ostream& out, const Result& r)
 /* Sort                                                                       */
 /* -------------------------------------------------------------------------- */
 
-Sort::Sort(const CVC4::Type& t) : d_type(new CVC4::Type(t)) {}
+Sort::Sort(const CVC4::Type& t) : d_type(std::make_shared<CVC4::Type>(t)) {}
 
-Sort::Sort() : d_type(new CVC4::Type()) {}
+Sort::Sort() : d_type(std::make_shared<CVC4::Type>()) {}
 
 Sort::~Sort() {}
 
@@ -1097,11 +1101,12 @@ size_t SortHashFunction::operator()(const Sort& s) const
 /* Op                                                                     */
 /* -------------------------------------------------------------------------- */
 
-Op::Op() : d_kind(NULL_EXPR), d_expr(new CVC4::Expr()) {}
+Op::Op() : d_kind(NULL_EXPR), d_expr(std::make_shared<CVC4::Expr>()) {}
 
-Op::Op(const Kind k) : d_kind(k), d_expr(new CVC4::Expr()) {}
+Op::Op(const Kind k) : d_kind(k), d_expr(std::make_shared<CVC4::Expr>()) {}
 
-Op::Op(const Kind k, const CVC4::Expr& e) : d_kind(k), d_expr(new CVC4::Expr(e))
+Op::Op(const Kind k, const CVC4::Expr& e)
+    : d_kind(k), d_expr(std::make_shared<CVC4::Expr>(e))
 {
 }
 
@@ -1320,9 +1325,9 @@ size_t OpHashFunction::operator()(const Op& t) const
 /* Term                                                                       */
 /* -------------------------------------------------------------------------- */
 
-Term::Term() : d_expr(new CVC4::Expr()) {}
+Term::Term() : d_expr(std::make_shared<CVC4::Expr>()) {}
 
-Term::Term(const CVC4::Expr& e) : d_expr(new CVC4::Expr(e)) {}
+Term::Term(const CVC4::Expr& e) : d_expr(std::make_shared<CVC4::Expr>(e)) {}
 
 Term::~Term() {}
 
@@ -2376,7 +2381,9 @@ Term Solver::mkTermFromKind(Kind kind) const
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
 
-Term Solver::mkTermInternal(Kind kind, const std::vector<Term>& children) const
+Term Solver::mkTermInternal(Kind kind,
+                            const std::vector<Term>& children,
+                            bool typeCheck) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
   for (size_t i = 0, size = children.size(); i < size; ++i)
@@ -2436,7 +2443,10 @@ Term Solver::mkTermInternal(Kind kind, const std::vector<Term>& children) const
     res = d_exprMgr->mkExpr(k, echildren);
   }
 
-  (void)res.d_expr->getType(true); /* kick off type checking */
+  if (typeCheck)
+  {
+    (void)res.d_expr->getType(true); /* kick off type checking */
+  }
   return res;
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
@@ -3203,7 +3213,7 @@ Term Solver::mkTerm(Kind kind) const
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
 
-Term Solver::mkTerm(Kind kind, Term child) const
+Term Solver::mkTerm(Kind kind, const Term& child) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
   CVC4_API_ARG_CHECK_EXPECTED(!child.isNull(), child) << "non-null term";
@@ -3216,7 +3226,7 @@ Term Solver::mkTerm(Kind kind, Term child) const
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
 
-Term Solver::mkTerm(Kind kind, Term child1, Term child2) const
+Term Solver::mkTerm(Kind kind, const Term& child1, const Term& child2) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
   CVC4_API_ARG_CHECK_EXPECTED(!child1.isNull(), child1) << "non-null term";
@@ -3231,7 +3241,10 @@ Term Solver::mkTerm(Kind kind, Term child1, Term child2) const
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
 
-Term Solver::mkTerm(Kind kind, Term child1, Term child2, Term child3) const
+Term Solver::mkTerm(Kind kind,
+                    const Term& child1,
+                    const Term& child2,
+                    const Term& child3) const
 {
   // need to use internal term call to check e.g. associative construction
   return mkTermInternal(kind, std::vector<Term>{child1, child2, child3});
@@ -3242,7 +3255,48 @@ Term Solver::mkTerm(Kind kind, const std::vector<Term>& children) const
   return mkTermInternal(kind, children);
 }
 
-Term Solver::mkTerm(Op op) const
+std::vector<Term> Solver::mkTerms(
+    const std::vector<Kind>& kinds,
+    const std::vector<std::vector<uint32_t>>& children,
+    const std::vector<Term>& leaves) const
+{
+  CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_CHECK(kinds.size() == children.size())
+      << "Expected as many vectors of children as kinds";
+  for (size_t i = 0, size = leaves.size(); i < size; ++i)
+  {
+    CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
+        !leaves[i].isNull(), "leaf term", leaves[i], i)
+        << "non-null term";
+  }
+
+  std::vector<Term> res;
+  res.reserve(kinds.size());
+  std::vector<Term> echildren;
+  for (size_t i = 0, size = kinds.size(); i < size; ++i)
+  {
+    echildren.clear();
+    for (uint32_t c : children[i])
+    {
+      CVC4_API_CHECK(c < leaves.size() + i)
+          << "Invalid child index " << c << " of term " << i
+          << ", expected an index of a leaf or of a previous term";
+      echildren.push_back(c < leaves.size() ? leaves[c]
+                                            : res[c - leaves.size()]);
+    }
+    res.push_back(mkTermInternal(kinds[i], echildren, false));
+  }
+  // the subterms come first, so each term only checks its own operator
+  for (const Term& t : res)
+  {
+    (void)t.d_expr->getType(true);
+  }
+  return res;
+
+  CVC4_API_SOLVER_TRY_CATCH_END;
+}
+
+Term Solver::mkTerm(const Op& op) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
 
@@ -3263,7 +3317,7 @@ Term Solver::mkTerm(Op op) const
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
 
-Term Solver::mkTerm(Op op, Term child) const
+Term Solver::mkTerm(const Op& op, const Term& child) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
   CVC4_API_ARG_CHECK_EXPECTED(!child.isNull(), child) << "non-null term";
@@ -3285,7 +3339,7 @@ Term Solver::mkTerm(Op op, Term child) const
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
 
-Term Solver::mkTerm(Op op, Term child1, Term child2) const
+Term Solver::mkTerm(const Op& op, const Term& child1, const Term& child2) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
   CVC4_API_ARG_CHECK_EXPECTED(!child1.isNull(), child1) << "non-null term";
@@ -3308,7 +3362,10 @@ Term Solver::mkTerm(Op op, Term child1, Term child2) const
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
 
-Term Solver::mkTerm(Op op, Term child1, Term child2, Term child3) const
+Term Solver::mkTerm(const Op& op,
+                    const Term& child1,
+                    const Term& child2,
+                    const Term& child3) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
   CVC4_API_ARG_CHECK_EXPECTED(!child1.isNull(), child1) << "non-null term";
@@ -3334,7 +3391,7 @@ Term Solver::mkTerm(Op op, Term child1, Term child2, Term child3) const
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
 
-Term Solver::mkTerm(Op op, const std::vector<Term>& children) const
+Term Solver::mkTerm(const Op& op, const std::vector<Term>& children) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
   for (size_t i = 0, size = children.size(); i < size; ++i)
@@ -3638,6 +3695,22 @@ void Solver::assertFormula(Term term) const
   d_smtEngine->assertFormula(*term.d_expr);
 }
 
+void Solver::assertFormulas(const std::vector<Term>& terms) const
+{
+  CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  for (size_t i = 0, size = terms.size(); i < size; ++i)
+  {
+    CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
+        !terms[i].isNull(), "term", terms[i], i)
+        << "non-null term";
+  }
+  for (const Term& t : terms)
+  {
+    d_smtEngine->assertFormula(*t.d_expr);
+  }
+  CVC4_API_SOLVER_TRY_CATCH_END;
+}
+
 /**
  *  ( check-sat )
  */
@@ -3672,6 +3745,45 @@ Result Solver::checkSatAssuming(const std::vector<Term>& assumptions) const
   return Result(r);
 }
 
+std::future<Result> Solver::checkSatAsync() const
+{
+  return std::async(std::launch::async, [this]() { return checkSat(); });
+}
+
+int Solver::fork() const
+{
+  CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  return d_smtEngine->fork();
+  CVC4_API_SOLVER_TRY_CATCH_END;
+}
+
+void Solver::cancel() const { d_exprMgr->getResourceManager()->cancel(); }
+
+void Solver::setProgressCallback(std::function<void(const Progress&)> callback,
+                                 uint64_t millis) const
+{
+  ResourceManager* rm = d_exprMgr->getResourceManager();
+  if (!callback)
+  {
+    rm->setProgressCallback(std::function<void()>(), millis);
+    return;
+  }
+  rm->setProgressCallback(
+      [this, rm, callback]() {
+        typedef ResourceManager::Resource Resource;
+        Progress p;
+        p.d_conflicts = rm->getStepCount(Resource::SatConflictStep);
+        p.d_decisions = rm->getStepCount(Resource::DecisionStep);
+        p.d_lemmas = rm->getStepCount(Resource::LemmaStep);
+        SExpr insts =
+            d_smtEngine->getStatistic("Instantiate::Instantiations_Total");
+        p.d_instantiations =
+            insts.isInteger() ? insts.getIntegerValue().getUnsignedLong() : 0;
+        callback(p);
+      },
+      millis);
+}
+
 /**
  *  ( declare-datatype <symbol> <datatype_decl> )
  */
@@ -3984,6 +4096,61 @@ std::string Solver::getInfo(const std::string& flag) const
   return d_smtEngine->getInfo(flag).toString();
 }
 
+std::map<std::string, std::string> Solver::getStatistics() const
+{
+  std::map<std::string, std::string> res;
+  Statistics stats = d_smtEngine->getStatistics();
+  for (const std::pair<std::string, SExpr>& s : stats)
+  {
+    res[s.first] = s.second.toString();
+  }
+  return res;
+}
+
+std::map<std::string, std::string> Solver::getStatisticsSince(
+    const std::map<std::string, std::string>& snapshot) const
+{
+  std::map<std::string, std::string> res;
+  Statistics stats = d_smtEngine->getStatistics();
+  for (const std::pair<std::string, SExpr>& s : stats)
+  {
+    std::string value = s.second.toString();
+    std::map<std::string, std::string>::const_iterator it =
+        snapshot.find(s.first);
+    if (it == snapshot.end())
+    {
+      res[s.first] = value;
+      continue;
+    }
+    if (it->second == value)
+    {
+      continue;
+    }
+    try
+    {
+      if (s.second.isInteger())
+      {
+        res[s.first] =
+            (s.second.getIntegerValue() - Integer(it->second)).toString();
+        continue;
+      }
+      if (s.second.isRational())
+      {
+        std::stringstream ss;
+        ss << s.second.getRationalValue().getDouble() - std::stod(it->second);
+        res[s.first] = ss.str();
+        continue;
+      }
+    }
+    catch (const std::exception& e)
+    {
+      // the snapshot value is not numeric, keep the current value
+    }
+    res[s.first] = value;
+  }
+  return res;
+}
+
 /**
  *  ( get-option <keyword> )
  */
@@ -4052,13 +4219,27 @@ std::vector<Term> Solver::getValue(const std::vector<Term>& terms) const
   // for e in exprs:
   // NodeManager::fromExprManager(d_exprMgr)
   // == NodeManager::fromExprManager(e.getExprManager())
-  std::vector<Term> res;
-  for (const Term& t : terms)
+  return exprVectorToTerms(d_smtEngine->getValues(termVectorToExprs(terms)));
+}
+
+Term Solver::countModels(const std::vector<Term>& terms,
+                         bool approximate) const
+{
+  CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4::ExprManagerScope exmgrs(*(d_exprMgr.get()));
+  for (size_t i = 0, size = terms.size(); i < size; ++i)
   {
-    /* Can not use emplace_back here since constructor is private. */
-    res.push_back(Term(d_smtEngine->getValue(*t.d_expr)));
+    CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
+        terms[i].getSort().isBoolean() || terms[i].getSort().isBitVector(),
+        "term",
+        terms[i],
+        i)
+        << "Boolean or bit-vector term";
   }
-  return res;
+  Integer count =
+      d_smtEngine->countModels(termVectorToExprs(terms), approximate);
+  return Term(d_exprMgr->mkConst(Rational(count)));
+  CVC4_API_SOLVER_TRY_CATCH_END;
 }
 
 /**
@@ -25,6 +25,9 @@
 #include "expr/kind.h"
 // !!!
 
+#include <cstdint>
+#include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <set>
@@ -1781,6 +1784,22 @@ struct CVC4_PUBLIC RoundingModeHashFunction
 /* Solver                                                                     */
 /* -------------------------------------------------------------------------- */
 
+/**
+ * The progress of a check call, as reported by the progress callback of a
+ * Solver. The counts are cumulative over the lifetime of the solver.
+ */
+struct CVC4_PUBLIC Progress
+{
+  /* The number of conflicts of the SAT solver. */
+  uint64_t d_conflicts;
+  /* The number of decisions of the SAT solver. */
+  uint64_t d_decisions;
+  /* The number of lemmas of the theories. */
+  uint64_t d_lemmas;
+  /* The number of quantifier instantiations. */
+  uint64_t d_instantiations;
+};
+
 /*
  * A CVC4 solver.
  */
@@ -1992,7 +2011,7 @@ class CVC4_PUBLIC Solver
    * @param child the child of the term
    * @return the Term
    */
-  Term mkTerm(Kind kind, Term child) const;
+  Term mkTerm(Kind kind, const Term& child) const;
 
   /**
    * Create binary term of given kind.
@@ -2001,7 +2020,7 @@ class CVC4_PUBLIC Solver
    * @param child2 the second child of the term
    * @return the Term
    */
-  Term mkTerm(Kind kind, Term child1, Term child2) const;
+  Term mkTerm(Kind kind, const Term& child1, const Term& child2) const;
 
   /**
    * Create ternary term of given kind.
@@ -2011,7 +2030,10 @@ class CVC4_PUBLIC Solver
    * @param child3 the third child of the term
    * @return the Term
    */
-  Term mkTerm(Kind kind, Term child1, Term child2, Term child3) const;
+  Term mkTerm(Kind kind,
+              const Term& child1,
+              const Term& child2,
+              const Term& child3) const;
 
   /**
    * Create n-ary term of given kind.
@@ -2027,7 +2049,7 @@ class CVC4_PUBLIC Solver
    * @param the operator
    * @return the Term
    */
-  Term mkTerm(Op op) const;
+  Term mkTerm(const Op& op) const;
 
   /**
    * Create unary term of given kind from a given operator.
@@ -2036,7 +2058,7 @@ class CVC4_PUBLIC Solver
    * @child the child of the term
    * @return the Term
    */
-  Term mkTerm(Op op, Term child) const;
+  Term mkTerm(const Op& op, const Term& child) const;
 
   /**
    * Create binary term of given kind from a given operator.
@@ -2046,7 +2068,7 @@ class CVC4_PUBLIC Solver
    * @child2 the second child of the term
    * @return the Term
    */
-  Term mkTerm(Op op, Term child1, Term child2) const;
+  Term mkTerm(const Op& op, const Term& child1, const Term& child2) const;
 
   /**
    * Create ternary term of given kind from a given operator.
@@ -2057,7 +2079,10 @@ class CVC4_PUBLIC Solver
    * @child3 the third child of the term
    * @return the Term
    */
-  Term mkTerm(Op op, Term child1, Term child2, Term child3) const;
+  Term mkTerm(const Op& op,
+              const Term& child1,
+              const Term& child2,
+              const Term& child3) const;
 
   /**
    * Create n-ary term of given kind from a given operator.
@@ -2067,7 +2092,25 @@ class CVC4_PUBLIC Solver
    * @children the children of the term
    * @return the Term
    */
-  Term mkTerm(Op op, const std::vector<Term>& children) const;
+  Term mkTerm(const Op& op, const std::vector<Term>& children) const;
+
+  /**
+   * Create the terms of a DAG in one call. The new terms are given in
+   * topological order: the i-th new term has kind kinds[i] and the children
+   * whose indices are children[i], where an index j < leaves.size() refers
+   * to leaves[j], and an index leaves.size() + k refers to the k-th new term,
+   * with k < i. The terms are type checked after they are all built, each
+   * shared subterm once.
+   * @param kinds the kinds of the new terms
+   * @param children the indices of the children of the new terms
+   * @param leaves the terms over which the new terms are built, e.g.
+   *        constants and variables
+   * @return the new terms, in order
+   */
+  std::vector<Term> mkTerms(
+      const std::vector<Kind>& kinds,
+      const std::vector<std::vector<uint32_t>>& children,
+      const std::vector<Term>& leaves) const;
 
   /**
    * Create a tuple term. Terms are automatically converted if sorts are
@@ -2531,6 +2574,13 @@ class CVC4_PUBLIC Solver
    */
   void assertFormula(Term term) const;
 
+  /**
+   * Assert a batch of formulas, as assertFormula() on each of them.
+   * SMT-LIB: ( assert <term> ) for each term
+   * @param terms the formulas to assert
+   */
+  void assertFormulas(const std::vector<Term>& terms) const;
+
   /**
    * Check satisfiability.
    * SMT-LIB: ( check-sat )
@@ -2554,6 +2604,40 @@ class CVC4_PUBLIC Solver
    */
   Result checkSatAssuming(const std::vector<Term>& assumptions) const;
 
+  /**
+   * Check satisfiability asynchronously, in a new thread.
+   * The solver must not be used until the returned future is ready, except
+   * for cancel().
+   * @return the future result of the satisfiability check.
+   */
+  std::future<Result> checkSatAsync() const;
+
+  /**
+   * Fork the process, so that the child continues with a copy of this
+   * solver in its current state. The assertions are preprocessed before
+   * forking, so that the children share the preprocessing of a common
+   * prefix of assertions.
+   * @return the pid of the child in the parent, and 0 in the child
+   */
+  int fork() const;
+
+  /**
+   * Cancel the check in progress, or the next one if no check is in
+   * progress. The check stops at its next resource step (see
+   * --rlimit), and its result is unknown with explanation INTERRUPTED.
+   * This method can be called from any thread.
+   */
+  void cancel() const;
+
+  /**
+   * Set the callback that reports the progress of checks. It is called by
+   * the thread of the check, at most every millis milliseconds.
+   * @param callback the callback, or an empty function to disable it
+   * @param millis the minimal interval between two calls, in milliseconds
+   */
+  void setProgressCallback(std::function<void(const Progress&)> callback,
+                           uint64_t millis) const;
+
   /**
    * Check validity.
    * @return the result of the validity check.
@@ -2701,6 +2785,25 @@ class CVC4_PUBLIC Solver
    */
   std::string getInfo(const std::string& flag) const;
 
+  /**
+   * Get a snapshot of the statistics of this solver.
+   * @return a map from the names of the statistics to their values
+   */
+  std::map<std::string, std::string> getStatistics() const;
+
+  /**
+   * Get the statistics that changed since a snapshot of the statistics of
+   * this solver. The values of the numeric statistics, such as the counters
+   * and the timers, are their increase since the snapshot, so that the
+   * statistics of a query are obtained from a snapshot taken before it.
+   * The statistics are those of this solver only, even if other solvers run
+   * in other threads.
+   * @param snapshot a snapshot returned by getStatistics()
+   * @return a map from the names of the changed statistics to their values
+   */
+  std::map<std::string, std::string> getStatisticsSince(
+      const std::map<std::string, std::string>& snapshot) const;
+
   /**
    * Get the value of a given option.
    * SMT-LIB: ( get-option <keyword> )
@@ -2740,6 +2843,20 @@ class CVC4_PUBLIC Solver
    */
   std::vector<Term> getValue(const std::vector<Term>& terms) const;
 
+  /**
+   * Count the models of the current assertions projected on the given
+   * Boolean and bit-vector terms, i.e. the number of distinct tuples of
+   * values of the terms in the models.
+   * Requires to enable options 'produce-models' and 'incremental'.
+   * @param terms the terms on which the models are projected
+   * @param approximate whether to estimate the count by hashing instead of
+   *        enumerating all models (see options 'model-count-threshold' and
+   *        'model-count-iterations')
+   * @return the number of models, as an integer constant
+   */
+  Term countModels(const std::vector<Term>& terms,
+                   bool approximate = false) const;
+
   /**
    * Pop (a) level(s) from the assertion stack.
    * SMT-LIB: ( pop <numeral> )
@@ -2845,9 +2962,12 @@ class CVC4_PUBLIC Solver
    * children exceeds the maximum arity for the kind.
    * @param kind the kind of the term
    * @param children the children of the term
+   * @param typeCheck whether to type check the term
    * @return the Term
    */
-  Term mkTermInternal(Kind kind, const std::vector<Term>& children) const;
+  Term mkTermInternal(Kind kind,
+                      const std::vector<Term>& children,
+                      bool typeCheck = true) const;
 
   /**
    * Create a vector of datatype sorts, using unresolved sorts.
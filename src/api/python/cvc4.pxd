@@ -121,6 +121,9 @@ cdef extern from "api/cvc4cpp.h" namespace "CVC4::api":
         Sort mkTupleSort(const vector[Sort]& sorts) except +
         Term mkTerm(Op op) except +
         Term mkTerm(Op op, const vector[Term]& children) except +
+        vector[Term] mkTerms(const vector[Kind]& kinds,
+                             const vector[vector[uint32_t]]& children,
+                             const vector[Term]& leaves) except +
         Op mkOp(Kind kind) except +
         Op mkOp(Kind kind, Kind k) except +
         Op mkOp(Kind kind, const string& arg) except +
@@ -166,8 +169,9 @@ cdef extern from "api/cvc4cpp.h" namespace "CVC4::api":
         Term mkVar(Sort sort) except +
         Term simplify(const Term& t) except +
         void assertFormula(Term term) except +
-        Result checkSat() except +
-        Result checkSatAssuming(const vector[Term]& assumptions) except +
+        void assertFormulas(const vector[Term]& terms) except +
+        Result checkSat() nogil except +
+        Result checkSatAssuming(const vector[Term]& assumptions) nogil except +
         Result checkValid() except +
         Result checkValidAssuming(const vector[Term]& assumptions) except +
         Sort declareDatatype(const string& symbol, const vector[DatatypeConstructorDecl]& ctors)
@@ -467,6 +467,33 @@ cdef class Solver:
             term.cterm = self.csolver.mkTerm((<Op?> op).cop, v)
         return term
 
+    def mkTerms(self, kinds, children, leaves):
+        '''
+            Creates the terms of a DAG in one call, see Solver::mkTerms:
+                    List[Term] mkTerms(List[Kind] kinds,
+                                       List[List[int]] children,
+                                       List[Term] leaves)
+        '''
+        cdef vector[c_Kind] ck
+        cdef vector[vector[uint32_t]] cc
+        cdef vector[uint32_t] indices
+        cdef vector[c_Term] cl
+        for k in kinds:
+            ck.push_back((<kind?> k).k)
+        for c in children:
+            indices.clear()
+            for i in c:
+                indices.push_back(<uint32_t?> i)
+            cc.push_back(indices)
+        for l in leaves:
+            cl.push_back((<Term?> l).cterm)
+        terms = []
+        for a in self.csolver.mkTerms(ck, cc, cl):
+            term = Term()
+            term.cterm = a
+            terms.append(term)
+        return terms
+
     def mkOp(self, kind k, arg0=None, arg1 = None):
         '''
         Supports the following uses:
@@ -720,8 +747,20 @@ cdef class Solver:
     def assertFormula(self, Term term):
         self.csolver.assertFormula(term.cterm)
 
+    def assertFormulas(self, terms):
+        cdef vector[c_Term] v
+        for t in terms:
+            v.push_back((<Term?> t).cterm)
+        self.csolver.assertFormulas(v)
+
     def checkSat(self):
-        cdef c_Result r = self.csolver.checkSat()
+        '''
+            The GIL is released during the check, so that Python threads can
+            drive several solvers concurrently.
+        '''
+        cdef c_Result r
+        with nogil:
+            r = self.csolver.checkSat()
         name = r.toString().decode()
         explanation = ""
         if r.isSatUnknown():
@@ -742,7 +781,9 @@ cdef class Solver:
         cdef vector[c_Term] v
         for a in assumptions:
             v.push_back((<Term?> a).cterm)
-        r = self.csolver.checkSatAssuming(<const vector[c_Term]&> v)
+        # the GIL is released during the check, as in checkSat
+        with nogil:
+            r = self.csolver.checkSatAssuming(<const vector[c_Term]&> v)
         name = r.toString().decode()
         explanation = ""
         if r.isSatUnknown():
@@ -926,6 +967,21 @@ cdef class Solver:
         term.cterm = self.csolver.getValue(t.cterm)
         return term
 
+    def getValues(self, terms):
+        '''
+            Returns the values of a list of terms, in a single call to the
+            solver.
+        '''
+        cdef vector[c_Term] v
+        for t in terms:
+            v.push_back((<Term?> t).cterm)
+        values = []
+        for a in self.csolver.getValue(<const vector[c_Term]&> v):
+            term = Term()
+            term.cterm = a
+            values.append(term)
+        return values
+
     def pop(self, nscopes=1):
         self.csolver.pop(nscopes)
 
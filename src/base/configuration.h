@@ -99,6 +99,12 @@ public:
 
   static bool isBuiltWithCadical();
 
+  /**
+   * Is CaDiCaL built with its external propagator interface, so that it can
+   * serve as the SAT solver of DPLL(T) (--sat-solver=cadical)?
+   */
+  static bool isBuiltWithCadicalPropagator();
+
   static bool isBuiltWithCryptominisat();
 
   static bool isBuiltWithDrat2Er();
@@ -41,4 +41,48 @@ TraceC TraceChannel CVC4_PUBLIC (&cout);
 std::ostream DumpOutC::dump_cout(cout.rdbuf());// copy cout stream buffer
 DumpOutC DumpOutChannel CVC4_PUBLIC (&DumpOutC::dump_cout);
 
+size_t TraceC::registerTag(TraceTag& tag)
+{
+  std::map<std::string, size_t>::iterator it = d_tagIds.find(tag.d_name);
+  size_t i;
+  if (it != d_tagIds.end())
+  {
+    i = it->second;
+  }
+  else
+  {
+    // new name, whose bit is set if the tag was turned on before
+    i = d_tagIds.size();
+    d_tagIds[tag.d_name] = i;
+    if ((i >> 6) >= d_tagBits.size())
+    {
+      d_tagBits.push_back(0);
+    }
+    if (d_tags.find(tag.d_name) != d_tags.end())
+    {
+      d_tagBits[i >> 6] |= uint64_t(1) << (i & 63);
+    }
+  }
+  tag.d_id = i + 1;
+  return i;
+}
+
+void TraceC::setTagBit(const std::string& tag, bool value)
+{
+  std::map<std::string, size_t>::iterator it = d_tagIds.find(tag);
+  if (it == d_tagIds.end())
+  {
+    return;
+  }
+  size_t i = it->second;
+  if (value)
+  {
+    d_tagBits[i >> 6] |= uint64_t(1) << (i & 63);
+  }
+  else
+  {
+    d_tagBits[i >> 6] &= ~(uint64_t(1) << (i & 63));
+  }
+}
+
 }/* CVC4 namespace */
@@ -25,8 +25,11 @@
 #include <string>
 #include <cstdio>
 #include <cstdarg>
+#include <cstdint>
+#include <map>
 #include <set>
 #include <utility>
+#include <vector>
 
 namespace CVC4 {
 
@@ -198,6 +201,14 @@ public:
       return CVC4ostream();
     }
   }
+  CVC4ostream operator()(const char* tag) const
+  {
+    if(!d_tags.empty() && d_tags.find(tag) != d_tags.end()) {
+      return CVC4ostream(d_os);
+    } else {
+      return CVC4ostream();
+    }
+  }
 
   bool on(const std::string& tag)
   {
@@ -215,6 +226,11 @@ public:
   {
     return d_tags.find(tag) != d_tags.end();
   }
+  /** in contrast to the above, this does not construct a string */
+  bool isOn(const char* tag) const
+  {
+    return !d_tags.empty() && d_tags.find(tag) != d_tags.end();
+  }
 
   std::ostream& setStream(std::ostream* os) { d_os = os; return *os; }
   std::ostream& getStream() const { return *d_os; }
@@ -303,15 +319,48 @@ public:
   bool isOn() const { return d_os != &null_os; }
 };/* class ChatC */
 
+/**
+ * A trace tag that is checked by a bit test instead of a lookup of its name,
+ * for use in hot paths. It is meant to be a static object, e.g.
+ *
+ *   static TraceTag s_propTag("dtview::prop");
+ *   ...
+ *   if (Trace.isOn(s_propTag)) { ... }
+ *
+ * The tag is given its index by the trace output class on its first check,
+ * so that such objects may be defined in any translation unit regardless of
+ * the order of static initialization.
+ */
+class CVC4_PUBLIC TraceTag {
+  friend class TraceC;
+  /** the name of this tag */
+  const char* d_name;
+  /** one plus the index of this tag, or zero if it has no index yet */
+  size_t d_id;
+
+public:
+  explicit TraceTag(const char* name) : d_name(name), d_id(0) {}
+  const char* getName() const { return d_name; }
+};/* class TraceTag */
+
 /** The trace output class */
 class CVC4_PUBLIC TraceC {
   std::ostream* d_os;
   std::set<std::string> d_tags;
+  /** the indices of the tags of TraceTag objects, by name */
+  std::map<std::string, size_t> d_tagIds;
+  /** the bitmap of the TraceTag indices whose tags are on */
+  std::vector<uint64_t> d_tagBits;
+
+  /** gives tag the index of its name, and returns that index */
+  size_t registerTag(TraceTag& tag);
+  /** sets the bit of the index of tag, if it has one, to value */
+  void setTagBit(const std::string& tag, bool value);
 
 public:
   explicit TraceC(std::ostream* os) : d_os(os) {}
 
-  CVC4ostream operator()(std::string tag) const
+  CVC4ostream operator()(const std::string& tag) const
   {
     if(!d_tags.empty() && d_tags.find(tag) != d_tags.end()) {
       return CVC4ostream(d_os);
@@ -319,23 +368,52 @@ public:
       return CVC4ostream();
     }
   }
+  CVC4ostream operator()(const char* tag) const
+  {
+    if(!d_tags.empty() && d_tags.find(tag) != d_tags.end()) {
+      return CVC4ostream(d_os);
+    } else {
+      return CVC4ostream();
+    }
+  }
+  CVC4ostream operator()(TraceTag& tag)
+  {
+    return isOn(tag) ? CVC4ostream(d_os) : CVC4ostream();
+  }
 
   bool on(const std::string& tag)
   {
     d_tags.insert(tag);
+    setTagBit(tag, true);
     return true;
   }
   bool off(const std::string& tag)
   {
     d_tags.erase(tag);
+    setTagBit(tag, false);
+    return false;
+  }
+  bool off()
+  {
+    d_tags.clear();
+    d_tagBits.assign(d_tagBits.size(), 0);
     return false;
   }
-  bool off()                { d_tags.clear(); return false; }
 
   bool isOn(const std::string& tag) const
   {
     return d_tags.find(tag) != d_tags.end();
   }
+  /** in contrast to the above, this does not construct a string */
+  bool isOn(const char* tag) const
+  {
+    return !d_tags.empty() && d_tags.find(tag) != d_tags.end();
+  }
+  bool isOn(TraceTag& tag)
+  {
+    size_t i = tag.d_id == 0 ? registerTag(tag) : tag.d_id - 1;
+    return (d_tagBits[i >> 6] >> (i & 63)) & 1;
+  }
 
   std::ostream& setStream(std::ostream* os) { d_os = os; return *d_os; }
   std::ostream& getStream() const { return *d_os; }
@@ -0,0 +1,315 @@
+/*********************                                                        */
+/*! \file cdtrail_hashmap.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Context-dependent open addressing hashmap built using a trail of
+ ** edits
+ **
+ ** Context-dependent hashmap that stores its elements in a single array,
+ ** indexed by an open addressing table, and records the edits made to it on
+ ** an undo trail. Restoring a context pops the trail instead of restoring
+ ** a context object per element, as CDHashMap does.
+ **
+ ** See also:
+ **  CDInsertHashMap : A CD hash map allowing only one insertion per element.
+ **  CDHashMap : A fully featured CD hash map. (The closest to <ext/hash_map>)
+ **
+ ** Notes:
+ ** - insert(k, d) maps k to d, overwriting the data that k may be mapped to.
+ ** - operator[] is only supported as a const derefence (must succeed).
+ ** - Elements cannot be erased, except by restoring a context.
+ ** - Iterators are invalidated by insertions and restores.
+ **/
+
+#include "cvc4_private.h"
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "base/check.h"
+#include "base/output.h"
+#include "context/context.h"
+
+namespace CVC4 {
+namespace context {
+
+template <class Key, class Data, class HashFcn = std::hash<Key> >
+class TrailHashMap
+{
+ public:
+  // The type of the <Key, Data> values in the hashmap.
+  using value_type = std::pair<Key, Data>;
+
+ private:
+  using ElementVec = std::vector<value_type>;
+  /** The elements of the map, in the order of their insertion. */
+  ElementVec d_elements;
+  /** The slot of d_table of each element of d_elements. */
+  std::vector<size_t> d_slots;
+  /**
+   * The open addressing table with linear probing, whose slots contain one
+   * plus the index of an element of d_elements, or zero if they are empty.
+   * Its size is the power of two d_mask + 1.
+   */
+  std::vector<uint32_t> d_table;
+  size_t d_mask;
+
+  /** An edit of the map, undone when restoring a context. */
+  struct Edit
+  {
+    Edit(size_t index, bool inserted, const Data& old)
+        : d_index(index), d_inserted(inserted), d_old(old)
+    {
+    }
+    /** The index of the element that was edited. */
+    size_t d_index;
+    /** Whether the element was inserted, or only its data changed. */
+    bool d_inserted;
+    /** The previous data of the element, if it was not inserted. */
+    Data d_old;
+  };
+  /** The trail of edits. */
+  std::vector<Edit> d_trail;
+
+  /**
+   * Returns the slot that contains the element of k, or the empty slot where
+   * it would be inserted.
+   */
+  size_t findSlot(const Key& k) const
+  {
+    size_t slot = HashFcn()(k) & d_mask;
+    while (d_table[slot] != 0 && !(d_elements[d_table[slot] - 1].first == k))
+    {
+      slot = (slot + 1) & d_mask;
+    }
+    return slot;
+  }
+
+  /** Doubles the size of the table, and inserts the elements again. */
+  void grow()
+  {
+    d_table.assign(2 * d_table.size(), 0);
+    d_mask = d_table.size() - 1;
+    // insert in order, so that the elements are erased in the reverse order
+    // of the probes
+    for (size_t i = 0, size = d_elements.size(); i < size; i++)
+    {
+      size_t slot = findSlot(d_elements[i].first);
+      d_table[slot] = i + 1;
+      d_slots[i] = slot;
+    }
+  }
+
+ public:
+  TrailHashMap() : d_table(16, 0), d_mask(15) {}
+
+  /** An iterator over the elements in the map. */
+  typedef typename ElementVec::const_iterator const_iterator;
+
+  const_iterator begin() const { return d_elements.begin(); }
+  const_iterator end() const { return d_elements.end(); }
+
+  /**
+   * Returns an iterator to the element of Key k, or end() if k is not
+   * mapped.
+   */
+  const_iterator find(const Key& k) const
+  {
+    size_t slot = findSlot(k);
+    return d_table[slot] == 0 ? end() : begin() + (d_table[slot] - 1);
+  }
+
+  /** Returns true if the map is empty. */
+  bool empty() const { return d_elements.empty(); }
+  /** Returns the number of elements in the map. */
+  size_t size() const { return d_elements.size(); }
+  /** Returns the number of edits on the trail. */
+  size_t trailSize() const { return d_trail.size(); }
+
+  /** Returns true if k is a mapped key. */
+  bool contains(const Key& k) const { return find(k) != end(); }
+
+  /**
+   * Returns a reference the data mapped by k.
+   * This must succeed.
+   */
+  const Data& operator[](const Key& k) const
+  {
+    const_iterator ci = find(k);
+    Assert(ci != end());
+    return (*ci).second;
+  }
+
+  /**
+   * Maps k to d, and records the edit on the trail. Returns true if k was not
+   * mapped.
+   */
+  bool insert(const Key& k, const Data& d)
+  {
+    size_t slot = findSlot(k);
+    if (d_table[slot] != 0)
+    {
+      size_t index = d_table[slot] - 1;
+      d_trail.push_back(Edit(index, false, d_elements[index].second));
+      d_elements[index].second = d;
+      return false;
+    }
+    size_t index = d_elements.size();
+    d_elements.push_back(value_type(k, d));
+    d_slots.push_back(slot);
+    d_table[slot] = index + 1;
+    d_trail.push_back(Edit(index, true, d));
+    // keep the load factor of the table below one half
+    if (2 * d_elements.size() > d_table.size())
+    {
+      grow();
+    }
+    return true;
+  }
+
+  /**
+   * Undoes the edits at the back of the trail until its size is s. Since the
+   * elements are erased in the reverse order of their insertion, no probe
+   * sequence of a remaining element goes through their slots.
+   */
+  void pop_to_size(size_t s)
+  {
+    while (d_trail.size() > s)
+    {
+      const Edit& e = d_trail.back();
+      if (e.d_inserted)
+      {
+        Assert(e.d_index + 1 == d_elements.size());
+        d_table[d_slots.back()] = 0;
+        d_slots.pop_back();
+        d_elements.pop_back();
+      }
+      else
+      {
+        d_elements[e.d_index].second = e.d_old;
+      }
+      d_trail.pop_back();
+    }
+    Debug("TrailHashMap") << "TrailHashMap pop_to_size " << s << std::endl;
+  }
+}; /* class TrailHashMap<> */
+
+template <class Key, class Data, class HashFcn = std::hash<Key> >
+class CDTrailHashMap : public ContextObj
+{
+ private:
+  typedef TrailHashMap<Key, Data, HashFcn> THM;
+
+  /** A TrailHashMap that backs all of the data. */
+  THM* d_trailMap;
+
+  /** For restores, we need to keep track of the previous size of the trail. */
+  size_t d_trailSize;
+
+  /**
+   * Private copy constructor used only by save(). d_trailMap is not copied:
+   * only the base class information and d_trailSize are needed in restore.
+   */
+  CDTrailHashMap(const CDTrailHashMap& l)
+      : ContextObj(l), d_trailMap(nullptr), d_trailSize(l.d_trailSize)
+  {
+  }
+  CDTrailHashMap& operator=(const CDTrailHashMap&) = delete;
+
+  /**
+   * Implementation of mandatory ContextObj method save: simply copies the
+   * current size of the trail to a copy using the copy constructor. The
+   * saved information is allocated using the ContextMemoryManager.
+   */
+  ContextObj* save(ContextMemoryManager* pCMM) override
+  {
+    return new (pCMM) CDTrailHashMap<Key, Data, HashFcn>(*this);
+  }
+
+ protected:
+  /**
+   * Implementation of mandatory ContextObj method restore: undoes the edits
+   * made since saving.
+   */
+  void restore(ContextObj* data) override
+  {
+    d_trailSize = ((CDTrailHashMap<Key, Data, HashFcn>*)data)->d_trailSize;
+    d_trailMap->pop_to_size(d_trailSize);
+    Debug("CDTrailHashMap")
+        << "restore " << this << " level " << this->getContext()->getLevel()
+        << " trail size back to " << d_trailSize << std::endl;
+  }
+
+ public:
+  /** Main constructor: d_trailMap starts as an empty map */
+  CDTrailHashMap(Context* context)
+      : ContextObj(context), d_trailMap(new THM()), d_trailSize(0)
+  {
+  }
+
+  /** Destructor: delete the d_trailMap */
+  ~CDTrailHashMap()
+  {
+    this->destroy();
+    delete d_trailMap;
+  }
+
+  /** An iterator over the elements in the map. */
+  typedef typename THM::const_iterator const_iterator;
+
+  // The type of the <key, data> values in the hashmap.
+  using value_type = typename THM::value_type;
+
+  /** Returns true if the map is empty in the current context. */
+  bool empty() const { return d_trailMap->empty(); }
+
+  /** Returns the size of the map in the current context. */
+  size_t size() const { return d_trailMap->size(); }
+
+  /**
+   * Maps k to d in the current context, overwriting the data that k may be
+   * mapped to. Returns true if k was not mapped.
+   */
+  bool insert(const Key& k, const Data& d)
+  {
+    makeCurrent();
+    bool inserted = d_trailMap->insert(k, d);
+    d_trailSize = d_trailMap->trailSize();
+    return inserted;
+  }
+
+  /** Returns true if k is a mapped key in the context. */
+  bool contains(const Key& k) const { return d_trailMap->contains(k); }
+
+  /**
+   * Returns a reference the data mapped by k.
+   * k must be in the map in this context.
+   */
+  const Data& operator[](const Key& k) const { return (*d_trailMap)[k]; }
+
+  /**
+   * Returns a const_iterator to the value_type if k is a mapped key in
+   * the context, or end() otherwise.
+   */
+  const_iterator find(const Key& k) const { return d_trailMap->find(k); }
+
+  /** Returns an iterator to the begining of the map. */
+  const_iterator begin() const { return d_trailMap->begin(); }
+
+  /** Returns an iterator to the end of the map. */
+  const_iterator end() const { return d_trailMap->end(); }
+}; /* class CDTrailHashMap<> */
+
+}  // namespace context
+}  // namespace CVC4
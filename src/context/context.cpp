@@ -26,7 +26,7 @@ namespace CVC4 {
 namespace context {
 
 
-Context::Context() : d_pCNOpre(NULL), d_pCNOpost(NULL) {
+Context::Context() : d_level(0), d_pCNOpre(NULL), d_pCNOpost(NULL) {
   // Create new memory manager
   d_pCMM = new ContextMemoryManager();
 
@@ -63,11 +63,21 @@ void Context::push() {
   Trace("pushpop") << std::string(2 * getLevel(), ' ') << "Push [to "
                    << getLevel() + 1 << "] { " << this << std::endl;
 
+  // The Scope of the new level, and its memory region, are only created if
+  // they are needed (see getTopScope()), so that pushing and popping levels
+  // where nothing changes is cheap.
+  ++d_level;
+}
+
+void Context::pushScope() const
+{
+  Assert(d_scopeList.back()->getLevel() < d_level);
   // Create a new memory region
   d_pCMM->push();
 
   // Create a new top Scope
-  d_scopeList.push_back(new(d_pCMM) Scope(this, d_pCMM, getLevel()+1));
+  d_scopeList.push_back(new (d_pCMM)
+                            Scope(const_cast<Context*>(this), d_pCMM, d_level));
 }
 
 
@@ -83,17 +93,21 @@ void Context::pop() {
     pCNO = next;
   }
 
-  // Grab the top Scope
-  Scope* pScope = d_scopeList.back();
+  if (d_scopeList.back()->getLevel() == d_level)
+  {
+    // Grab the top Scope
+    Scope* pScope = d_scopeList.back();
 
-  // Restore the previous Scope
-  d_scopeList.pop_back();
+    // Restore the previous Scope
+    d_scopeList.pop_back();
 
-  // Restore all objects in the top Scope
-  delete pScope;
+    // Restore all objects in the top Scope
+    delete pScope;
 
-  // Pop the memory region
-  d_pCMM->pop();
+    // Pop the memory region
+    d_pCMM->pop();
+  }
+  --d_level;
 
   // Notify the (post-pop) ContextNotifyObj objects
   pCNO = d_pCNOpost;
@@ -141,8 +155,11 @@ void ContextObj::update()
                    << "context is " << getContext() << std::endl
                    << *getContext() << std::endl;
 
+  // Get the top Scope first, which creates it if needed, so that the saved
+  // copy is allocated in its memory region
+  Scope* pTopScope = d_pScope->getContext()->getTopScope();
   // Call save() to save the information in the current object
-  ContextObj* pContextObjSaved = save(d_pScope->getCMM());
+  ContextObj* pContextObjSaved = save(pTopScope->getCMM());
 
   Debug("context") << "in update(" << this << ") with restore "
                    << pContextObjSaved << ": waypoint 1" << std::endl
@@ -180,7 +197,7 @@ void ContextObj::update()
                    << *getContext() << std::endl;
 
   // Update Scope pointer to current top Scope
-  d_pScope = d_pScope->getContext()->getTopScope();
+  d_pScope = pTopScope;
 
   // Store the saved copy in the restore pointer
   d_pContextObjRestore = pContextObjSaved;
@@ -321,13 +338,13 @@ std::ostream& operator<<(std::ostream& out, const Context& context)
 {
   static const std::string separator(79, '-');
 
-  int level = context.d_scopeList.size() - 1;
+  // only the Scopes that were created are printed
   typedef std::vector<Scope*>::const_reverse_iterator const_reverse_iterator;
   for(const_reverse_iterator i = context.d_scopeList.rbegin();
       i != context.d_scopeList.rend();
-      ++i, --level) {
+      ++i) {
     Scope* pScope = *i;
-    Assert(pScope->getLevel() == level);
+    Assert(pScope->getLevel() <= context.getLevel());
     Assert(pScope->getContext() == &context);
     out << separator << std::endl
         << *pScope << std::endl;
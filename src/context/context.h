@@ -75,9 +75,22 @@ class Context {
   ContextMemoryManager* d_pCMM;
 
   /**
-   * List of all scopes for this context.
+   * List of the scopes for this context. The Scope of a level is only
+   * created when it is needed, e.g. when a ContextObj is modified at that
+   * level, hence this contains the Scopes of some of the levels up to
+   * d_level, in increasing order of levels, including level 0.
    */
-  std::vector<Scope*> d_scopeList;
+  mutable std::vector<Scope*> d_scopeList;
+
+  /**
+   * The current level, i.e. the number of outstanding push() calls.
+   */
+  int d_level;
+
+  /**
+   * Create the Scope of the current level, which must not exist yet.
+   */
+  void pushScope() const;
 
   /**
    * Doubly-linked list of objects to notify before every pop.  See
@@ -153,9 +166,10 @@ public:
   ~Context();
 
   /**
-   * Return the current (top) scope
+   * Return the current (top) scope, which is created if it does not exist
+   * yet. Defined inline below.
    */
-  Scope* getTopScope() const { return d_scopeList.back(); }
+  Scope* getTopScope() const;
 
   /**
    * Return the initial (bottom) scope
@@ -165,12 +179,13 @@ public:
   /**
    * Return the current Scope level.
    */
-  int getLevel() const { return d_scopeList.size() - 1; }
+  int getLevel() const { return d_level; }
 
   /**
-   * Return the ContextMemoryManager associated with the context.
+   * Return the ContextMemoryManager associated with the context, whose
+   * current region is the one of the top scope. Defined inline below.
    */
-  ContextMemoryManager* getCMM() { return d_pCMM; }
+  ContextMemoryManager* getCMM();
 
   /**
    * Save the current state, create a new Scope
@@ -303,7 +318,7 @@ class Scope {
   /**
    * Return true iff this Scope is the current top Scope
    */
-  bool isCurrent() const { return this == d_pContext->getTopScope(); }
+  bool isCurrent() const { return d_level == d_pContext->getLevel(); }
 
   /**
    * When a ContextObj object is modified for the first time in this
@@ -722,6 +737,21 @@ public:
 
 };/* class ContextNotifyObj */
 
+inline Scope* Context::getTopScope() const
+{
+  if (d_scopeList.back()->getLevel() != d_level)
+  {
+    pushScope();
+  }
+  return d_scopeList.back();
+}
+
+inline ContextMemoryManager* Context::getCMM()
+{
+  getTopScope();
+  return d_pCMM;
+}
+
 inline void ContextObj::makeCurrent()
 {
   if(!(d_pScope->isCurrent())) {
@@ -127,9 +127,7 @@ void ContextMemoryManager::push() {
 #endif /* CVC4_VALGRIND */
 
   // Store current state on the stack
-  d_nextFreeStack.push_back(d_nextFree);
-  d_endChunkStack.push_back(d_endChunk);
-  d_indexChunkListStack.push_back(d_indexChunkList);
+  d_watermarks.push_back(Watermark{d_nextFree, d_endChunk, d_indexChunkList});
 }
 
 
@@ -142,16 +140,15 @@ void ContextMemoryManager::pop() {
   d_allocations.pop_back();
 #endif /* CVC4_VALGRIND */
 
-  Assert(d_nextFreeStack.size() > 0 && d_endChunkStack.size() > 0);
+  Assert(!d_watermarks.empty());
+  const Watermark& w = d_watermarks.back();
 
-  // Restore state from stack
-  d_nextFree = d_nextFreeStack.back();
-  d_nextFreeStack.pop_back();
-  d_endChunk = d_endChunkStack.back();
-  d_endChunkStack.pop_back();
+  // Restore state from the watermark
+  d_nextFree = w.d_nextFree;
+  d_endChunk = w.d_endChunk;
 
   // Free all the new chunks since the last push
-  while(d_indexChunkList > d_indexChunkListStack.back()) {
+  while(d_indexChunkList > w.d_indexChunkList) {
     d_freeChunks.push_back(d_chunkList.back());
 #ifdef CVC4_VALGRIND
     VALGRIND_MAKE_MEM_NOACCESS(d_chunkList.back(), chunkSizeBytes);
@@ -159,7 +156,7 @@ void ContextMemoryManager::pop() {
     d_chunkList.pop_back();
     --d_indexChunkList;
   }
-  d_indexChunkListStack.pop_back();
+  d_watermarks.pop_back();
 
   // Delete excess free chunks
   while(d_freeChunks.size() > maxFreeChunks) {
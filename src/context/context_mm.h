@@ -80,22 +80,23 @@ class ContextMemoryManager {
   unsigned d_indexChunkList;
 
   /**
-   * Part of the stack of saved regions.  This vector stores the saved value
-   * of d_nextFree
+   * The position of the bump pointer when a region was saved, i.e. its
+   * watermark, which is restored when the region is popped.
    */
-  std::vector<char*> d_nextFreeStack;
-
-  /**
-   * Part of the stack of saved regions.  This vector stores the saved value
-   * of d_endChunk.
-   */
-  std::vector<char*> d_endChunkStack;
+  struct Watermark
+  {
+    /** The saved value of d_nextFree */
+    char* d_nextFree;
+    /** The saved value of d_endChunk */
+    char* d_endChunk;
+    /** The saved value of d_indexChunkList */
+    unsigned d_indexChunkList;
+  };
 
   /**
-   * Part of the stack of saved regions.  This vector stores the saved value
-   * of d_indexChunkList
+   * The stack of the watermarks of the saved regions.
    */
-  std::vector<unsigned> d_indexChunkListStack;
+  std::vector<Watermark> d_watermarks;
 
   /**
    * Private method to grab a new chunk for the current region.  Uses chunk
@@ -146,6 +147,15 @@ class ContextMemoryManager {
    */
   void pop();
 
+  /**
+   * Get the number of bytes of the chunks held by this memory manager,
+   * including the free chunks kept for reuse
+   */
+  size_t getMemoryUsage() const
+  {
+    return (d_chunkList.size() + d_freeChunks.size()) * chunkSizeBytes;
+  }
+
 };/* class ContextMemoryManager */
 
 #else /* CVC4_DEBUG_CONTEXT_MEMORY_MANAGER */
@@ -196,6 +206,9 @@ class ContextMemoryManager
     d_allocations.pop_back();
   }
 
+  /** The sizes of the allocations are not tracked by this implementation */
+  size_t getMemoryUsage() const { return 0; }
+
  private:
   std::vector<std::vector<char*>> d_allocations;
 }; /* ContextMemoryManager */
@@ -166,6 +166,9 @@ public:
   SatValue getSatValue(TNode n) {
     return getSatValue(getSatLiteral(n));
   }
+  double getActivity(SatLiteral l) {
+    return d_satSolver->getActivity(l.getSatVariable());
+  }
   Node getNode(SatLiteral l) {
     return d_cnfStream->getNode(l);
   }
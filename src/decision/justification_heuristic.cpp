@@ -351,7 +351,34 @@ TNode JustificationHeuristic::getChildByWeight(TNode n, int i, bool polarity) {
   }
 }
 
-SatValue JustificationHeuristic::tryGetSatValue(Node n)
+int JustificationHeuristic::getMostActiveChild(TNode n, SatValue desiredVal)
+{
+  SatValue desiredValInverted = invertValue(desiredVal);
+  int best = 0;
+  double bestActivity = -1;
+  for (int i = 0, numChildren = n.getNumChildren(); i < numChildren; ++i)
+  {
+    TNode child = getChildByWeight(n, i, desiredVal);
+    if (!d_decisionEngine->hasSatLiteral(child))
+    {
+      continue;
+    }
+    SatLiteral lit = d_decisionEngine->getSatLiteral(child);
+    if (d_decisionEngine->getSatValue(lit) == desiredValInverted)
+    {
+      continue;
+    }
+    double activity = d_decisionEngine->getActivity(lit);
+    if (activity > bestActivity)
+    {
+      best = i;
+      bestActivity = activity;
+    }
+  }
+  return best;
+}
+
+SatValue JustificationHeuristic::tryGetSatValue(TNode n)
 {
   Debug("decision") << "   "  << n << " has sat value " << " ";
   if(d_decisionEngine->hasSatLiteral(n) ) {
@@ -363,21 +390,21 @@ SatValue JustificationHeuristic::tryGetSatValue(Node n)
   }//end of else
 }
 
-JustificationHeuristic::IteList
+const JustificationHeuristic::IteList&
 JustificationHeuristic::getITEs(TNode n)
 {
   IteCache::iterator it = d_iteCache.find(n);
-  if(it != d_iteCache.end()) {
-    return (*it).second;
-  } else {
+  if (it == d_iteCache.end())
+  {
     // Compute the list of ITEs
-    // TODO: optimize by avoiding multiple lookup for d_iteCache[n]
     d_visitedComputeITE.clear();
     IteList ilist;
     computeITEs(n, ilist);
     d_iteCache.insert(n, ilist);
-    return ilist;
+    it = d_iteCache.find(n);
   }
+  // the elements of the cache are not moved by later insertions
+  return (*it).second;
 }
 
 void JustificationHeuristic::computeITEs(TNode n, IteList &l)
@@ -562,7 +589,10 @@ JustificationHeuristic::handleAndOrEasy(TNode node, SatValue desiredVal)
 
   int numChildren = node.getNumChildren();
   SatValue desiredValInverted = invertValue(desiredVal);
-  for(int i = 0; i < numChildren; ++i) {
+  int first =
+      options::decisionActivity() ? getMostActiveChild(node, desiredVal) : 0;
+  for(int j = 0; j < numChildren; ++j) {
+    int i = (first + j) % numChildren;
     TNode curNode = getChildByWeight(node, i, desiredVal);
     if ( tryGetSatValue(curNode) != desiredValInverted ) {
       SearchResult ret = findSplitterRec(curNode, desiredVal);
@@ -612,6 +642,18 @@ JustificationHeuristic::SearchResult JustificationHeuristic::handleBinaryEasy(TN
     swap(node1, node2);
     swap(desiredVal1, desiredVal2);
   }
+  else if (options::decisionActivity()
+           && tryGetSatValue(node2) != invertValue(desiredVal2)
+           && d_decisionEngine->hasSatLiteral(node1)
+           && d_decisionEngine->hasSatLiteral(node2)
+           && d_decisionEngine->getActivity(
+                  d_decisionEngine->getSatLiteral(node2))
+                  > d_decisionEngine->getActivity(
+                        d_decisionEngine->getSatLiteral(node1)))
+  {
+    swap(node1, node2);
+    swap(desiredVal1, desiredVal2);
+  }
 
   if ( tryGetSatValue(node1) != invertValue(desiredVal1) ) {
     SearchResult ret = findSplitterRec(node1, desiredVal1);
@@ -702,7 +744,11 @@ JustificationHeuristic::SearchResult JustificationHeuristic::handleITE(TNode nod
 
 JustificationHeuristic::SearchResult JustificationHeuristic::handleEmbeddedITEs(TNode node)
 {
-  const IteList l = getITEs(node);
+  if (d_iteAssertions.empty())
+  {
+    return NO_SPLITTER;
+  }
+  const IteList& l = getITEs(node);
   Trace("decision::jh::ite") << " ite size = " << l.size() << std::endl;
 
   bool noSplitter = true;
@@ -147,13 +147,19 @@ public:
   bool compareByWeightFalse(TNode, TNode);
   bool compareByWeightTrue(TNode, TNode);
   TNode getChildByWeight(TNode n, int i, bool polarity);
+  /**
+   * Returns the index (see getChildByWeight) of the child of n with the
+   * highest activity in the SAT solver among those that are not assigned
+   * the opposite of desiredVal, or 0 if none has a SAT literal.
+   */
+  int getMostActiveChild(TNode n, SatValue desiredVal);
 
   /* If literal exists corresponding to the node return
      that. Otherwise an UNKNOWN */
-  SatValue tryGetSatValue(Node n);
+  SatValue tryGetSatValue(TNode n);
 
   /* Get list of all term-ITEs for the atomic formula v */
-  JustificationHeuristic::IteList getITEs(TNode n);
+  const JustificationHeuristic::IteList& getITEs(TNode n);
 
 
   /**
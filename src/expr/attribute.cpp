@@ -50,6 +50,8 @@ void AttributeManager::deleteAllAttributes(NodeValue* nv) {
   deleteFromTable(d_nodes, nv);
   deleteFromTable(d_types, nv);
   deleteFromTable(d_strings, nv);
+  d_denseNodes.erase(nv);
+  d_denseTypes.erase(nv);
 }
 
 void AttributeManager::deleteAllAttributes() {
@@ -59,6 +61,8 @@ void AttributeManager::deleteAllAttributes() {
   deleteAllFromTable(d_nodes);
   deleteAllFromTable(d_types);
   deleteAllFromTable(d_strings);
+  d_denseNodes.clear();
+  d_denseTypes.clear();
 }
 
 void AttributeManager::deleteAttributes(const AttrIdVec& atids) {
@@ -89,9 +93,11 @@ void AttributeManager::deleteAttributes(const AttrIdVec& atids) {
       break;
     case AttrTableNode:
       deleteAttributesFromTable(d_nodes, ids);
+      d_denseNodes.eraseAttributes(ids);
       break;
     case AttrTableTypeNode:
       deleteAttributesFromTable(d_types, ids);
+      d_denseTypes.eraseAttributes(ids);
       break;
     case AttrTableString:
       deleteAttributesFromTable(d_strings, ids);
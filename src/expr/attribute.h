@@ -88,6 +88,10 @@ public:
   AttrHash<TypeNode> d_types;
   /** Underlying hash table for string-valued attributes */
   AttrHash<std::string> d_strings;
+  /** Underlying dense table for dense node-valued attributes */
+  AttrDense<Node> d_denseNodes;
+  /** Underlying dense table for dense types attributes */
+  AttrDense<TypeNode> d_denseTypes;
 
   /**
    * Get a particular attribute on a particular node.
@@ -281,6 +285,131 @@ struct getTable<std::string, false> {
   }
 };
 
+/**
+ * The getDenseTable<> template provides (static) access to the
+ * AttributeManager field holding the dense table of the attributes of
+ * value type T.
+ */
+template <class T>
+struct getDenseTable;
+
+/** Access the "d_denseNodes" member of AttributeManager. */
+template <>
+struct getDenseTable<Node>
+{
+  typedef AttrDense<Node> table_type;
+  static inline table_type& get(AttributeManager& am)
+  {
+    return am.d_denseNodes;
+  }
+  static inline const table_type& get(const AttributeManager& am)
+  {
+    return am.d_denseNodes;
+  }
+};
+
+/** Access the "d_denseTypes" member of AttributeManager. */
+template <>
+struct getDenseTable<TypeNode>
+{
+  typedef AttrDense<TypeNode> table_type;
+  static inline table_type& get(AttributeManager& am)
+  {
+    return am.d_denseTypes;
+  }
+  static inline const table_type& get(const AttributeManager& am)
+  {
+    return am.d_denseTypes;
+  }
+};
+
+/**
+ * The AttrStore<> template finds and sets the values of an attribute kind
+ * in the table holding them, which is a hash table unless the attribute
+ * kind is dense.
+ */
+template <class AttrKind, bool dense = AttrKind::dense>
+struct AttrStore
+{
+  typedef typename AttrKind::value_type value_type;
+  typedef KindValueToTableValueMapping<value_type> mapping;
+  typedef typename getTable<value_type, AttrKind::context_dependent>::
+            table_type table_type;
+
+  /** Returns true if nv has the attribute, and sets ret to its value. */
+  static inline bool find(const AttributeManager& am,
+                          NodeValue* nv,
+                          value_type& ret)
+  {
+    const table_type& ah =
+      getTable<value_type, AttrKind::context_dependent>::get(am);
+    typename table_type::const_iterator i =
+      ah.find(std::make_pair(AttrKind::getId(), nv));
+    if(i == ah.end()) {
+      return false;
+    }
+    ret = mapping::convertBack((*i).second);
+    return true;
+  }
+
+  /** Returns true if nv has the attribute. */
+  static inline bool has(const AttributeManager& am, NodeValue* nv)
+  {
+    const table_type& ah =
+      getTable<value_type, AttrKind::context_dependent>::get(am);
+    typename table_type::const_iterator i =
+      ah.find(std::make_pair(AttrKind::getId(), nv));
+    return !(i == ah.end());
+  }
+
+  /** Sets the value of the attribute of nv. */
+  static inline void set(AttributeManager& am,
+                         NodeValue* nv,
+                         const value_type& value)
+  {
+    table_type& ah =
+      getTable<value_type, AttrKind::context_dependent>::get(am);
+    ah[std::make_pair(AttrKind::getId(), nv)] = mapping::convert(value);
+  }
+};
+
+/** Specialization of AttrStore<> for the dense attribute kinds. */
+template <class AttrKind>
+struct AttrStore<AttrKind, true>
+{
+  typedef typename AttrKind::value_type value_type;
+  typedef typename getDenseTable<value_type>::table_type table_type;
+  static_assert(!AttrKind::context_dependent,
+                "Context-dependent attributes cannot be dense");
+
+  static inline bool find(const AttributeManager& am,
+                          NodeValue* nv,
+                          value_type& ret)
+  {
+    const value_type* v =
+        getDenseTable<value_type>::get(am).find(AttrKind::getId(), nv);
+    if (v == nullptr)
+    {
+      return false;
+    }
+    ret = *v;
+    return true;
+  }
+
+  static inline bool has(const AttributeManager& am, NodeValue* nv)
+  {
+    return getDenseTable<value_type>::get(am).find(AttrKind::getId(), nv)
+           != nullptr;
+  }
+
+  static inline void set(AttributeManager& am,
+                         NodeValue* nv,
+                         const value_type& value)
+  {
+    getDenseTable<value_type>::get(am).set(AttrKind::getId(), nv, value);
+  }
+};
+
 }/* CVC4::expr::attr namespace */
 
 // ATTRIBUTE MANAGER IMPLEMENTATIONS ===========================================
@@ -291,21 +420,12 @@ namespace attr {
 template <class AttrKind>
 typename AttrKind::value_type
 AttributeManager::getAttribute(NodeValue* nv, const AttrKind&) const {
-  typedef typename AttrKind::value_type value_type;
-  typedef KindValueToTableValueMapping<value_type> mapping;
-  typedef typename getTable<value_type, AttrKind::context_dependent>::
-            table_type table_type;
-
-  const table_type& ah =
-    getTable<value_type, AttrKind::context_dependent>::get(*this);
-  typename table_type::const_iterator i =
-    ah.find(std::make_pair(AttrKind::getId(), nv));
-
-  if(i == ah.end()) {
+  typename AttrKind::value_type ret;
+  if (!AttrStore<AttrKind>::find(*this, nv, ret))
+  {
     return typename AttrKind::value_type();
   }
-
-  return mapping::convertBack((*i).second);
+  return ret;
 }
 
 /* Helper template class for hasAttribute(), specialized based on
@@ -333,21 +453,9 @@ struct HasAttribute<true, AttrKind> {
   static inline bool getAttribute(const AttributeManager* am,
                                   NodeValue* nv,
                                   typename AttrKind::value_type& ret) {
-    typedef typename AttrKind::value_type value_type;
-    typedef KindValueToTableValueMapping<value_type> mapping;
-    typedef typename getTable<value_type,
-                              AttrKind::context_dependent>::table_type
-      table_type;
-
-    const table_type& ah =
-      getTable<value_type, AttrKind::context_dependent>::get(*am);
-    typename table_type::const_iterator i =
-      ah.find(std::make_pair(AttrKind::getId(), nv));
-
-    if(i == ah.end()) {
+    if (!AttrStore<AttrKind>::find(*am, nv, ret))
+    {
       ret = AttrKind::default_value;
-    } else {
-      ret = mapping::convertBack((*i).second);
     }
 
     return true;
@@ -362,43 +470,13 @@ template <class AttrKind>
 struct HasAttribute<false, AttrKind> {
   static inline bool hasAttribute(const AttributeManager* am,
                                   NodeValue* nv) {
-    typedef typename AttrKind::value_type value_type;
-    //typedef KindValueToTableValueMapping<value_type> mapping;
-    typedef typename getTable<value_type, AttrKind::context_dependent>::
-              table_type table_type;
-
-    const table_type& ah =
-      getTable<value_type, AttrKind::context_dependent>::get(*am);
-    typename table_type::const_iterator i =
-      ah.find(std::make_pair(AttrKind::getId(), nv));
-
-    if(i == ah.end()) {
-      return false;
-    }
-
-    return true;
+    return AttrStore<AttrKind>::has(*am, nv);
   }
 
   static inline bool getAttribute(const AttributeManager* am,
                                   NodeValue* nv,
                                   typename AttrKind::value_type& ret) {
-    typedef typename AttrKind::value_type value_type;
-    typedef KindValueToTableValueMapping<value_type> mapping;
-    typedef typename getTable<value_type, AttrKind::context_dependent>::
-              table_type table_type;
-
-    const table_type& ah =
-      getTable<value_type, AttrKind::context_dependent>::get(*am);
-    typename table_type::const_iterator i =
-      ah.find(std::make_pair(AttrKind::getId(), nv));
-
-    if(i == ah.end()) {
-      return false;
-    }
-
-    ret = mapping::convertBack((*i).second);
-
-    return true;
+    return AttrStore<AttrKind>::find(*am, nv, ret);
   }
 };
 
@@ -422,14 +500,7 @@ inline void
 AttributeManager::setAttribute(NodeValue* nv,
                                const AttrKind&,
                                const typename AttrKind::value_type& value) {
-  typedef typename AttrKind::value_type value_type;
-  typedef KindValueToTableValueMapping<value_type> mapping;
-  typedef typename getTable<value_type, AttrKind::context_dependent>::
-            table_type table_type;
-
-  table_type& ah =
-      getTable<value_type, AttrKind::context_dependent>::get(*this);
-  ah[std::make_pair(AttrKind::getId(), nv)] = mapping::convert(value);
+  AttrStore<AttrKind>::set(*this, nv, value);
 }
 
 /** Search for the NodeValue in all attribute tables and remove it. */
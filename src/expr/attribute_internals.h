@@ -24,7 +24,11 @@
 #define CVC4__EXPR__ATTRIBUTE_INTERNALS_H
 
 #include <cstdint>
+#include <memory>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace CVC4 {
 namespace expr {
@@ -44,17 +48,6 @@ struct AttrHashFunction {
   }
 };/* struct AttrHashFunction */
 
-/**
- * A hash function for boolean-valued attribute table keys; here we
- * don't have to store a pair as the key, because we use a known bit
- * in [0..63] for each attribute
- */
-struct AttrBoolHashFunction {
-  std::size_t operator()(NodeValue* nv) const {
-    return (size_t)nv->getId();
-  }
-};/* struct AttrBoolHashFunction */
-
 }/* CVC4::expr::attr namespace */
 
 // ATTRIBUTE TYPE MAPPINGS =====================================================
@@ -158,18 +151,132 @@ class AttrHash :
                                AttrHashFunction> {
 };/* class AttrHash<> */
 
+/**
+ * A map from node ids to values of type T, where the values of consecutive
+ * ids are stored in pages, allocated when one of their values is set and
+ * freed when all of their values are erased.  Looking up the value of an id
+ * is two array accesses, instead of a hashed lookup.
+ */
+template <class T>
+class NodeIdPages
+{
+  static const uint64_t s_pageBits = 10;
+  static const uint64_t s_pageSize = uint64_t(1) << s_pageBits;
+
+  struct Page
+  {
+    Page() : d_set(), d_count(0) {}
+    /** The values of the ids of this page */
+    T d_values[s_pageSize];
+    /** The bits of the ids of this page that have a value */
+    uint64_t d_set[s_pageSize / 64];
+    /** The number of ids of this page that have a value */
+    uint64_t d_count;
+  };
+
+  /** The pages, indexed by the ids divided by the size of pages */
+  std::vector<std::unique_ptr<Page>> d_pages;
+  /** The number of ids that have a value */
+  size_t d_size = 0;
+
+ public:
+  /** Returns the value of id, or nullptr if id has none. */
+  T* find(uint64_t id) const
+  {
+    uint64_t p = id >> s_pageBits;
+    if (p >= d_pages.size() || d_pages[p] == nullptr)
+    {
+      return nullptr;
+    }
+    Page* page = d_pages[p].get();
+    uint64_t i = id & (s_pageSize - 1);
+    if (!(page->d_set[i >> 6] & GetBitSet(i & 63)))
+    {
+      return nullptr;
+    }
+    return &page->d_values[i];
+  }
+
+  /**
+   * Returns the value of id, which is set to a default-constructed value if
+   * id has none.
+   */
+  T& operator[](uint64_t id)
+  {
+    uint64_t p = id >> s_pageBits;
+    if (p >= d_pages.size())
+    {
+      d_pages.resize(p + 1);
+    }
+    if (d_pages[p] == nullptr)
+    {
+      d_pages[p].reset(new Page());
+    }
+    Page* page = d_pages[p].get();
+    uint64_t i = id & (s_pageSize - 1);
+    uint64_t& word = page->d_set[i >> 6];
+    if (!(word & GetBitSet(i & 63)))
+    {
+      word |= GetBitSet(i & 63);
+      ++page->d_count;
+      ++d_size;
+    }
+    return page->d_values[i];
+  }
+
+  /** Erases the value of id, if any. */
+  void erase(uint64_t id)
+  {
+    uint64_t p = id >> s_pageBits;
+    if (p >= d_pages.size() || d_pages[p] == nullptr)
+    {
+      return;
+    }
+    Page* page = d_pages[p].get();
+    uint64_t i = id & (s_pageSize - 1);
+    uint64_t& word = page->d_set[i >> 6];
+    if (!(word & GetBitSet(i & 63)))
+    {
+      return;
+    }
+    word &= ~GetBitSet(i & 63);
+    --d_size;
+    // The value is released once this table is consistent, since releasing
+    // a node may delete other nodes and erase their values.
+    T old = T();
+    std::swap(old, page->d_values[i]);
+    std::unique_ptr<Page> freed;
+    if (--page->d_count == 0)
+    {
+      freed = std::move(d_pages[p]);
+    }
+  }
+
+  /** Erases all values. */
+  void clear()
+  {
+    std::vector<std::unique_ptr<Page>> pages;
+    pages.swap(d_pages);
+    d_size = 0;
+  }
+
+  /** Is the table empty? */
+  bool empty() const { return d_size == 0; }
+
+  /** The number of ids that have a value */
+  size_t size() const { return d_size; }
+}; /* class NodeIdPages<> */
+
 /**
  * In the case of Boolean-valued attributes we have a special
- * "AttrHash<bool>" to pack bits together in words.
+ * "AttrHash<bool>" to pack bits together in words. The words are indexed
+ * by the ids of the nodes, hence not hashed despite the name of this class.
  */
 template <>
-class AttrHash<bool> :
-    protected std::unordered_map<NodeValue*,
-                                  uint64_t,
-                                  AttrBoolHashFunction> {
-
-  /** A "super" type, like in Java, for easy reference below. */
-  typedef std::unordered_map<NodeValue*, uint64_t, AttrBoolHashFunction> super;
+class AttrHash<bool>
+{
+  /** The words of flags of the nodes, indexed by their ids */
+  NodeIdPages<uint64_t> d_words;
 
   /**
    * BitAccessor allows us to return a bit "by reference."  Of course,
@@ -208,29 +315,31 @@ class AttrHash<bool> :
    */
   class BitIterator {
 
-    std::pair<NodeValue* const, uint64_t>* d_entry;
+    NodeValue* d_nv;
+
+    uint64_t* d_word;
 
     uint64_t d_bit;
 
    public:
 
     BitIterator() :
-      d_entry(NULL),
+      d_nv(NULL),
+      d_word(NULL),
       d_bit(0) {
     }
 
-    BitIterator(std::pair<NodeValue* const, uint64_t>& entry, uint64_t bit)
-        : d_entry(&entry), d_bit(bit)
+    BitIterator(NodeValue* nv, uint64_t& word, uint64_t bit)
+        : d_nv(nv), d_word(&word), d_bit(bit)
     {
     }
 
     std::pair<NodeValue* const, BitAccessor> operator*() {
-      return std::make_pair(d_entry->first,
-                            BitAccessor(d_entry->second, d_bit));
+      return std::make_pair(d_nv, BitAccessor(*d_word, d_bit));
     }
 
     bool operator==(const BitIterator& b) {
-      return d_entry == b.d_entry && d_bit == b.d_bit;
+      return d_word == b.d_word && d_bit == b.d_bit;
     }
   };/* class AttrHash<bool>::BitIterator */
 
@@ -242,31 +351,33 @@ class AttrHash<bool> :
    */
   class ConstBitIterator {
 
-    const std::pair<NodeValue* const, uint64_t>* d_entry;
+    NodeValue* d_nv;
+
+    const uint64_t* d_word;
 
     uint64_t d_bit;
 
    public:
 
     ConstBitIterator() :
-      d_entry(NULL),
+      d_nv(NULL),
+      d_word(NULL),
       d_bit(0) {
     }
 
-    ConstBitIterator(const std::pair<NodeValue* const, uint64_t>& entry,
-                     uint64_t bit)
-        : d_entry(&entry), d_bit(bit)
+    ConstBitIterator(NodeValue* nv, const uint64_t& word, uint64_t bit)
+        : d_nv(nv), d_word(&word), d_bit(bit)
     {
     }
 
     std::pair<NodeValue* const, bool> operator*()
     {
-      return std::make_pair(
-          d_entry->first, (d_entry->second & GetBitSet(d_bit)) ? true : false);
+      return std::make_pair(d_nv,
+                            (*d_word & GetBitSet(d_bit)) ? true : false);
     }
 
     bool operator==(const ConstBitIterator& b) {
-      return d_entry == b.d_entry && d_bit == b.d_bit;
+      return d_word == b.d_word && d_bit == b.d_bit;
     }
   };/* class AttrHash<bool>::ConstBitIterator */
 
@@ -282,22 +393,16 @@ public:
   typedef ConstBitIterator const_iterator;
 
   /**
-   * Find the boolean value in the hash table.  Returns something ==
+   * Find the boolean value in the table.  Returns something ==
    * end() if not found.
    */
   BitIterator find(const std::pair<uint64_t, NodeValue*>& k) {
-    super::iterator i = super::find(k.second);
-    if(i == super::end()) {
+    uint64_t* word = d_words.find(k.second->getId());
+    if (word == nullptr)
+    {
       return BitIterator();
     }
-    /*
-    Debug.printf("boolattr",
-                 "underlying word at 0x%p looks like 0x%016llx, bit is %u\n",
-                 &(*i).second,
-                 (uint64_t)((*i).second),
-                 uint64_t(k.first));
-    */
-    return BitIterator(*i, k.first);
+    return BitIterator(k.second, *word, k.first);
   }
 
   /** The "off the end" iterator */
@@ -306,22 +411,16 @@ public:
   }
 
   /**
-   * Find the boolean value in the hash table.  Returns something ==
+   * Find the boolean value in the table.  Returns something ==
    * end() if not found.
    */
   ConstBitIterator find(const std::pair<uint64_t, NodeValue*>& k) const {
-    super::const_iterator i = super::find(k.second);
-    if(i == super::end()) {
+    const uint64_t* word = d_words.find(k.second->getId());
+    if (word == nullptr)
+    {
       return ConstBitIterator();
     }
-    /*
-    Debug.printf("boolattr",
-                 "underlying word at 0x%p looks like 0x%016llx, bit is %u\n",
-                 &(*i).second,
-                 (uint64_t)((*i).second),
-                 uint64_t(k.first));
-    */
-    return ConstBitIterator(*i, k.first);
+    return ConstBitIterator(k.second, *word, k.first);
   }
 
   /** The "off the end" const_iterator */
@@ -330,39 +429,93 @@ public:
   }
 
   /**
-   * Access the hash table using the underlying operator[].  Inserts
-   * the key into the table (associated to default value) if it's not
-   * already there.
+   * Access the table.  Inserts the key into the table (associated to
+   * default value) if it's not already there.
    */
   BitAccessor operator[](const std::pair<uint64_t, NodeValue*>& k) {
-    uint64_t& word = super::operator[](k.second);
+    uint64_t& word = d_words[k.second->getId()];
     return BitAccessor(word, k.first);
   }
 
   /**
    * Delete all flags from the given node.
    */
-  void erase(NodeValue* nv) {
-    super::erase(nv);
-  }
+  void erase(NodeValue* nv) { d_words.erase(nv->getId()); }
 
   /**
-   * Clear the hash table.
+   * Clear the table.
    */
-  void clear() {
-    super::clear();
+  void clear() { d_words.clear(); }
+
+  /** Is the table empty? */
+  bool empty() const { return d_words.empty(); }
+
+  /** This is currently very misleading! */
+  size_t size() const { return d_words.size(); }
+};/* class AttrHash<bool> */
+
+/**
+ * An "AttrDense<value_type>"---the table underlying the attributes that
+ * are stored densely (see IsDenseAttribute)---maps each such attribute to
+ * the values of the nodes, indexed by their ids.
+ */
+template <class value_type>
+class AttrDense
+{
+  /** The values of the attributes, indexed by the ids of the attributes */
+  std::vector<NodeIdPages<value_type>> d_tables;
+
+ public:
+  /** Returns the value of attribute id of nv, or nullptr if it has none. */
+  const value_type* find(uint64_t id, NodeValue* nv) const
+  {
+    if (id >= d_tables.size())
+    {
+      return nullptr;
+    }
+    return d_tables[id].find(nv->getId());
   }
 
-  /** Is the hash table empty? */
-  bool empty() const {
-    return super::empty();
+  /** Sets the value of attribute id of nv. */
+  void set(uint64_t id, NodeValue* nv, const value_type& value)
+  {
+    if (id >= d_tables.size())
+    {
+      d_tables.resize(id + 1);
+    }
+    d_tables[id][nv->getId()] = value;
   }
 
-  /** This is currently very misleading! */
-  size_t size() const {
-    return super::size();
+  /** Erases the values of all attributes of nv. */
+  void erase(NodeValue* nv)
+  {
+    for (NodeIdPages<value_type>& t : d_tables)
+    {
+      t.erase(nv->getId());
+    }
+  }
+
+  /** Erases the values of the attributes ids, for all nodes. */
+  void eraseAttributes(const std::vector<uint64_t>& ids)
+  {
+    for (uint64_t id : ids)
+    {
+      if (id < d_tables.size())
+      {
+        d_tables[id].clear();
+      }
+    }
   }
-};/* class AttrHash<bool> */
+
+  /** Erases all values. */
+  void clear()
+  {
+    for (NodeIdPages<value_type>& t : d_tables)
+    {
+      t.clear();
+    }
+  }
+}; /* class AttrDense<> */
 
 }/* CVC4::expr::attr namespace */
 
@@ -398,6 +551,22 @@ struct LastAttributeId {
 
 // ATTRIBUTE DEFINITION ========================================================
 
+namespace attr {
+
+/**
+ * Whether the values of the attributes of tag T are stored in the dense
+ * tables of the AttributeManager (see AttrDense), indexed by node ids,
+ * instead of its hash tables.  This is specialized next to the tags of the
+ * Node- and TypeNode-valued attributes that are set on most nodes and
+ * looked up often, such as the type and the rewrite caches.
+ */
+template <class T>
+struct IsDenseAttribute : std::false_type
+{
+};
+
+}/* CVC4::expr::attr namespace */
+
 /**
  * An "attribute type" structure.
  *
@@ -438,6 +607,11 @@ public:
    */
   static const bool context_dependent = context_dep;
 
+  /**
+   * Whether the values of this attribute kind are stored in a dense table.
+   */
+  static const bool dense = attr::IsDenseAttribute<T>::value;
+
   /**
    * Register this attribute kind and check that the ID is a valid ID
    * for bool-valued attributes.  Fail an assert if not.  Otherwise
@@ -486,6 +660,12 @@ public:
    */
   static const bool context_dependent = context_dep;
 
+  /**
+   * The flags are stored in the table of bool-valued attributes, whose
+   * words are already indexed by node ids.
+   */
+  static const bool dense = false;
+
   /**
    * Register this attribute kind and check that the ID is a valid ID
    * for bool-valued attributes.  Fail an assert if not.  Otherwise
@@ -283,6 +283,17 @@ private:
       {
         return d_exportCache[n];
       }
+      // expressions exported by previous calls with the same collection
+      Expr from_e(d_from, new Node(n));
+      std::unordered_map<Expr, Expr, ExprHashFunction>::const_iterator itc =
+          d_vmap.d_exportCache.find(from_e);
+      if (itc != d_vmap.d_exportCache.end()
+          && itc->second.getExprManager() == d_to)
+      {
+        Node ret = itc->second.getNode();
+        d_exportCache[n] = ret;
+        return ret;
+      }
 
       std::vector<Node> children;
       Debug("export") << "n: " << n << std::endl;
@@ -309,10 +320,16 @@ private:
       }
 
       // FIXME thread safety
-      Node ret =
-          NodeManager::fromExprManager(d_to)->mkNode(n.getKind(), children);
+      NodeManager* to_nm = NodeManager::fromExprManager(d_to);
+      Node ret = to_nm->mkNode(n.getKind(), children);
 
       d_exportCache[n] = ret;
+      // Make sure that the correct `NodeManager` is in scope while
+      // converting the node to an expression.
+      NodeManagerScope to_nms(to_nm);
+      Expr to_e = ret.toExpr();
+      d_vmap.d_exportCache[from_e] = to_e;
+      d_vmap.d_exportCache[to_e] = from_e;
       return ret;
     }
   }/* exportInternal() */
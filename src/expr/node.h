@@ -584,6 +584,15 @@ public:
     return d_nv->getRefCount();
   }
 
+  /**
+   * Returns true if this node is known to be in rewritten form. The flag is
+   * kept in the node value, so it is checked without a cache lookup.
+   */
+  bool isRewritten() const { return d_nv->isRewritten(); }
+
+  /** Marks this node as being in rewritten form. */
+  void setRewritten() const { d_nv->setRewritten(); }
+
   /**
    * Returns the value of the given attribute that this has been attached.
    * @param attKind the kind of the attribute
@@ -19,59 +19,25 @@
 
 #include "expr/attribute.h"
 #include "expr/dtype.h"
+#include "expr/node_traversal.h"
 
 namespace CVC4 {
 namespace expr {
 
 bool hasSubterm(TNode n, TNode t, bool strict)
 {
-  if (!strict && n == t)
+  if (n == t)
   {
-    return true;
-  }
-
-  std::unordered_set<TNode, TNodeHashFunction> visited;
-  std::vector<TNode> toProcess;
-
-  toProcess.push_back(n);
-
-  // incrementally iterate and add to toProcess
-  for (unsigned i = 0; i < toProcess.size(); ++i)
-  {
-    TNode current = toProcess[i];
-    for (unsigned j = 0, j_end = current.getNumChildren(); j <= j_end; ++j)
-    {
-      TNode child;
-      // try children then operator
-      if (j < j_end)
-      {
-        child = current[j];
-      }
-      else if (current.hasOperator())
-      {
-        child = current.getOperator();
-      }
-      else
-      {
-        break;
-      }
-      if (child == t)
-      {
-        return true;
-      }
-      if (visited.find(child) != visited.end())
-      {
-        continue;
-      }
-      else
-      {
-        visited.insert(child);
-        toProcess.push_back(child);
-      }
-    }
+    // a term is not a strict subterm of itself
+    return !strict;
   }
-
-  return false;
+  // the traversal is aborted when t is found
+  return !traverseDag(n,
+                      [&t](TNode cur) {
+                        return cur == t ? VisitAction::ABORT
+                                        : VisitAction::CONTINUE;
+                      },
+                      true);
 }
 
 bool hasSubtermMulti(TNode n, TNode t)
@@ -131,28 +97,9 @@ bool hasSubtermMulti(TNode n, TNode t)
 
 bool hasSubtermKind(Kind k, Node n)
 {
-  std::unordered_set<TNode, TNodeHashFunction> visited;
-  std::vector<TNode> visit;
-  TNode cur;
-  visit.push_back(n);
-  do
-  {
-    cur = visit.back();
-    visit.pop_back();
-    if (visited.find(cur) == visited.end())
-    {
-      visited.insert(cur);
-      if (cur.getKind() == k)
-      {
-        return true;
-      }
-      for (const Node& cn : cur)
-      {
-        visit.push_back(cn);
-      }
-    }
-  } while (!visit.empty());
-  return false;
+  return !traverseDag(n, [k](TNode cur) {
+    return cur.getKind() == k ? VisitAction::ABORT : VisitAction::CONTINUE;
+  });
 }
 
 bool hasSubterm(TNode n, const std::vector<Node>& t, bool strict)
@@ -165,49 +112,16 @@ bool hasSubterm(TNode n, const std::vector<Node>& t, bool strict)
   {
     return true;
   }
-
-  std::unordered_set<TNode, TNodeHashFunction> visited;
-  std::vector<TNode> toProcess;
-
-  toProcess.push_back(n);
-
-  // incrementally iterate and add to toProcess
-  for (unsigned i = 0; i < toProcess.size(); ++i)
-  {
-    TNode current = toProcess[i];
-    for (unsigned j = 0, j_end = current.getNumChildren(); j <= j_end; ++j)
-    {
-      TNode child;
-      // try children then operator
-      if (j < j_end)
-      {
-        child = current[j];
-      }
-      else if (current.hasOperator())
-      {
-        child = current.getOperator();
-      }
-      else
-      {
-        break;
-      }
-      if (std::find(t.begin(), t.end(), child) != t.end())
-      {
-        return true;
-      }
-      if (visited.find(child) != visited.end())
-      {
-        continue;
-      }
-      else
-      {
-        visited.insert(child);
-        toProcess.push_back(child);
-      }
-    }
-  }
-
-  return false;
+  // the traversal is aborted when a strict subterm of n is in t
+  return !traverseDag(n,
+                      [&n, &t](TNode cur) {
+                        return cur != n
+                                       && std::find(t.begin(), t.end(), cur)
+                                              != t.end()
+                                   ? VisitAction::ABORT
+                                   : VisitAction::CONTINUE;
+                      },
+                      true);
 }
 
 struct HasBoundVarTag
@@ -367,40 +281,28 @@ bool getFreeVariables(TNode n,
 
 bool getVariables(TNode n, std::unordered_set<TNode, TNodeHashFunction>& vs)
 {
-  std::unordered_set<TNode, TNodeHashFunction> visited;
-  std::vector<TNode> visit;
-  TNode cur;
-  visit.push_back(n);
-  do
-  {
-    cur = visit.back();
-    visit.pop_back();
-    std::unordered_set<TNode, TNodeHashFunction>::iterator itv =
-        visited.find(cur);
-    if (itv == visited.end())
+  traverseDag(n, [&vs](TNode cur) {
+    if (cur.isVar())
     {
-      if (cur.isVar())
-      {
-        vs.insert(cur);
-      }
-      else
-      {
-        for (const TNode& cn : cur)
-        {
-          visit.push_back(cn);
-        }
-      }
-      visited.insert(cur);
+      vs.insert(cur);
+      return VisitAction::SKIP_CHILDREN;
     }
-  } while (!visit.empty());
-
+    return VisitAction::CONTINUE;
+  });
   return !vs.empty();
 }
 
 void getSymbols(TNode n, std::unordered_set<Node, NodeHashFunction>& syms)
 {
-  std::unordered_set<TNode, TNodeHashFunction> visited;
-  getSymbols(n, syms, visited);
+  traverseDag(n,
+              [&syms](TNode cur) {
+                if (cur.isVar() && cur.getKind() != kind::BOUND_VARIABLE)
+                {
+                  syms.insert(cur);
+                }
+                return VisitAction::CONTINUE;
+              },
+              true);
 }
 
 void getSymbols(TNode n,
@@ -437,8 +339,15 @@ void getOperatorsMap(
     TNode n,
     std::map<TypeNode, std::unordered_set<Node, NodeHashFunction>>& ops)
 {
-  std::unordered_set<TNode, TNodeHashFunction> visited;
-  getOperatorsMap(n, ops, visited);
+  traverseDag(n, [&ops](TNode cur) {
+    // add the current operator to the result
+    if (cur.hasOperator())
+    {
+      ops[cur.getType()].insert(
+          NodeManager::currentNM()->operatorOf(cur.getKind()));
+    }
+    return VisitAction::CONTINUE;
+  });
 }
 
 void getOperatorsMap(
@@ -458,6 +367,7 @@ void getOperatorsMap(
     // if cur is in the cache, do nothing
     if (visited.find(cur) == visited.end())
     {
+      visited.insert(cur);
       // fetch the correct type
       TypeNode tn = cur.getType();
       // add the current operator to the result
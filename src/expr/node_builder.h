@@ -370,6 +370,7 @@ public:
 
     d_inlineNv.d_id = 0;
     d_inlineNv.d_rc = 0;
+    d_inlineNv.d_rewritten = 0;
     d_inlineNv.d_kind = expr::NodeValue::kindToDKind(kind::UNDEFINED_KIND);
     d_inlineNv.d_nchildren = 0;
   }
@@ -383,6 +384,7 @@ public:
 
     d_inlineNv.d_id = 1; // have a kind already
     d_inlineNv.d_rc = 0;
+    d_inlineNv.d_rewritten = 0;
     d_inlineNv.d_kind = expr::NodeValue::kindToDKind(k);
     d_inlineNv.d_nchildren = 0;
   }
@@ -394,6 +396,7 @@ public:
 
     d_inlineNv.d_id = 0;
     d_inlineNv.d_rc = 0;
+    d_inlineNv.d_rewritten = 0;
     d_inlineNv.d_kind = expr::NodeValue::kindToDKind(kind::UNDEFINED_KIND);
     d_inlineNv.d_nchildren = 0;
   }
@@ -407,6 +410,7 @@ public:
 
     d_inlineNv.d_id = 1; // have a kind already
     d_inlineNv.d_rc = 0;
+    d_inlineNv.d_rewritten = 0;
     d_inlineNv.d_kind = expr::NodeValue::kindToDKind(k);
     d_inlineNv.d_nchildren = 0;
   }
@@ -430,6 +434,7 @@ public:
 
     d_inlineNv.d_id = nb.d_nv->d_id;
     d_inlineNv.d_rc = 0;
+    d_inlineNv.d_rewritten = 0;
     d_inlineNv.d_kind = nb.d_nv->d_kind;
     d_inlineNv.d_nchildren = 0;
 
@@ -445,6 +450,7 @@ public:
 
     d_inlineNv.d_id = nb.d_nv->d_id;
     d_inlineNv.d_rc = 0;
+    d_inlineNv.d_rewritten = 0;
     d_inlineNv.d_kind = nb.d_nv->d_kind;
     d_inlineNv.d_nchildren = 0;
 
@@ -804,6 +810,7 @@ void NodeBuilder<nchild_thresh>::realloc(size_t toSize) {
     d_nv = newBlock;
     d_nv->d_id = d_inlineNv.d_id;
     d_nv->d_rc = 0;
+    d_nv->d_rewritten = 0;
     d_nv->d_kind = d_inlineNv.d_kind;
     d_nv->d_nchildren = d_inlineNv.d_nchildren;
 
@@ -934,17 +941,14 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() {
            "no children permitted";
 
     // we have to copy the inline NodeValue out
-    expr::NodeValue* nv = (expr::NodeValue*)
-      std::malloc(sizeof(expr::NodeValue));
-    if(nv == NULL) {
-      throw std::bad_alloc();
-    }
+    expr::NodeValue* nv = d_nm->allocNodeValue(0);
     // there are no children, so we don't have to worry about
     // reference counts in this case.
     nv->d_nchildren = 0;
     nv->d_kind = d_nv->d_kind;
     nv->d_id = d_nm->next_id++;// FIXME multithreading
     nv->d_rc = 0;
+    nv->d_rewritten = 0;
     setUsed();
     if(Debug.isOn("gc")) {
       Debug("gc") << "creating node value " << nv
@@ -1012,16 +1016,12 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() {
        * reference count. */
 
       // create the canonical expression value for this node
-      expr::NodeValue* nv = (expr::NodeValue*)
-        std::malloc(sizeof(expr::NodeValue) +
-                    ( sizeof(expr::NodeValue*) * d_inlineNv.d_nchildren ));
-      if(nv == NULL) {
-        throw std::bad_alloc();
-      }
+      expr::NodeValue* nv = d_nm->allocNodeValue(d_inlineNv.d_nchildren);
       nv->d_nchildren = d_inlineNv.d_nchildren;
       nv->d_kind = d_inlineNv.d_kind;
       nv->d_id = d_nm->next_id++;// FIXME multithreading
       nv->d_rc = 0;
+      nv->d_rewritten = 0;
 
       std::copy(d_inlineNv.d_children,
                 d_inlineNv.d_children + d_inlineNv.d_nchildren,
@@ -1072,8 +1072,28 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() {
        * it had is placed into the NodeManager's pool and returned in
        * a Node wrapper. */
 
-      crop();
-      expr::NodeValue* nv = d_nv;
+      expr::NodeValue* nv;
+      if (d_nv->d_nchildren <= expr::NodeValueArena::s_maxSlabChildren)
+      {
+        // narrow enough to live in a slab of the NodeManager's arena, move
+        // the children (and their references) over
+        nv = d_nm->allocNodeValue(d_nv->d_nchildren);
+        nv->d_nchildren = d_nv->d_nchildren;
+        nv->d_kind = d_nv->d_kind;
+        nv->d_rc = 0;
+        nv->d_rewritten = 0;
+        std::copy(d_nv->d_children,
+                  d_nv->d_children + d_nv->d_nchildren,
+                  nv->d_children);
+        free(d_nv);
+      }
+      else
+      {
+        // wide NodeValues are malloc'ed by the arena as well, so the
+        // buffer can be handed over as is
+        crop();
+        nv = d_nv;
+      }
       nv->d_id = d_nm->next_id++;// FIXME multithreading
       d_nv = &d_inlineNv;
       d_nvMaxChildren = nchild_thresh;
@@ -1114,17 +1134,14 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() const {
            "no children permitted";
 
     // we have to copy the inline NodeValue out
-    expr::NodeValue* nv = (expr::NodeValue*)
-      std::malloc(sizeof(expr::NodeValue));
-    if(nv == NULL) {
-      throw std::bad_alloc();
-    }
+    expr::NodeValue* nv = d_nm->allocNodeValue(0);
     // there are no children, so we don't have to worry about
     // reference counts in this case.
     nv->d_nchildren = 0;
     nv->d_kind = d_nv->d_kind;
     nv->d_id = d_nm->next_id++;// FIXME multithreading
     nv->d_rc = 0;
+    nv->d_rewritten = 0;
     Debug("gc") << "creating node value " << nv
                 << " [" << nv->d_id << "]: " << *nv << "\n";
     return nv;
@@ -1189,16 +1206,12 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() const {
        * count. */
 
       // create the canonical expression value for this node
-      expr::NodeValue* nv = (expr::NodeValue*)
-        std::malloc(sizeof(expr::NodeValue) +
-                    ( sizeof(expr::NodeValue*) * d_inlineNv.d_nchildren ));
-      if(nv == NULL) {
-        throw std::bad_alloc();
-      }
+      expr::NodeValue* nv = d_nm->allocNodeValue(d_inlineNv.d_nchildren);
       nv->d_nchildren = d_inlineNv.d_nchildren;
       nv->d_kind = d_inlineNv.d_kind;
       nv->d_id = d_nm->next_id++;// FIXME multithreading
       nv->d_rc = 0;
+      nv->d_rewritten = 0;
 
       std::copy(d_inlineNv.d_children,
                 d_inlineNv.d_children + d_inlineNv.d_nchildren,
@@ -1243,16 +1256,12 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() const {
        * decremented to match at NodeBuilder destruction time. */
 
       // create the canonical expression value for this node
-      expr::NodeValue* nv = (expr::NodeValue*)
-        std::malloc(sizeof(expr::NodeValue) +
-                    ( sizeof(expr::NodeValue*) * d_nv->d_nchildren ));
-      if(nv == NULL) {
-        throw std::bad_alloc();
-      }
+      expr::NodeValue* nv = d_nm->allocNodeValue(d_nv->d_nchildren);
       nv->d_nchildren = d_nv->d_nchildren;
       nv->d_kind = d_nv->d_kind;
       nv->d_id = d_nm->next_id++;// FIXME multithreading
       nv->d_rc = 0;
+      nv->d_rewritten = 0;
 
       std::copy(d_nv->d_children,
                 d_nv->d_children + d_nv->d_nchildren,
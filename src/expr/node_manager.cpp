@@ -18,7 +18,6 @@
 #include "expr/node_manager.h"
 
 #include <algorithm>
-#include <stack>
 #include <utility>
 
 #include "base/check.h"
@@ -27,9 +26,11 @@
 #include "expr/dtype.h"
 #include "expr/node_manager_attributes.h"
 #include "expr/node_manager_listeners.h"
+#include "expr/node_traversal.h"
 #include "expr/type_checker.h"
 #include "options/options.h"
 #include "options/smt_options.h"
+#include "util/rational.h"
 #include "util/resource_manager.h"
 #include "util/statistics_registry.h"
 
@@ -132,8 +133,14 @@ void NodeManager::init() {
 
     if(hasOperator(k)) {
       d_operators[i] = mkConst(Kind(k));
+      pinNode(d_operators[i]);
     }
   }
+  // the constants that are the most often referenced
+  pinNode(mkConst(true));
+  pinNode(mkConst(false));
+  pinNode(mkConst(Rational(0)));
+  pinNode(mkConst(Rational(1)));
   d_resourceManager->setHardLimit((*d_options)[options::hardLimit]);
   if((*d_options)[options::perCallResourceLimit] != 0) {
     d_resourceManager->setResourceLimit((*d_options)[options::perCallResourceLimit], false);
@@ -150,6 +157,10 @@ void NodeManager::init() {
   if((*d_options)[options::cpuTime]) {
     d_resourceManager->useCPUTime(true);
   }
+  if ((*d_options)[options::memoryLimit] != 0)
+  {
+    d_resourceManager->setMemoryLimit((*d_options)[options::memoryLimit]);
+  }
 
   // Do not notify() upon registration as these were handled manually above.
   d_registrations->add(d_options->registerTlimitListener(
@@ -240,6 +251,16 @@ NodeManager::~NodeManager() {
   d_options = NULL;
 }
 
+void NodeManager::pinNode(TNode n)
+{
+  NodeValue* nv = n.d_nv;
+  if (!nv->HasMaximizedReferenceCount())
+  {
+    nv->d_rc = NodeValue::MAX_RC;
+    markRefCountMaxedOut(nv);
+  }
+}
+
 size_t NodeManager::registerDatatype(std::shared_ptr<DType> dt)
 {
   size_t sz = d_ownedDTypes.size();
@@ -253,6 +274,26 @@ const DType& NodeManager::getDTypeForIndex(unsigned index) const
   return *d_ownedDTypes[index];
 }
 
+NodeValue* NodeManager::insertNodeValue(const NodeValue& nvStack)
+{
+  uint32_t n = nvStack.d_nchildren;
+  NodeValue* nv = allocNodeValue(n);
+  nv->d_nchildren = n;
+  nv->d_kind = nvStack.d_kind;
+  nv->d_rc = 0;
+  nv->d_rewritten = 0;
+  for (uint32_t i = 0; i < n; ++i)
+  {
+    nv->d_children[i] = nvStack.d_children[i];
+    nv->d_children[i]->inc();
+  }
+  nv->d_id = next_id++;
+  poolInsert(nv);
+  Debug("gc") << "creating node value " << nv << " [" << nv->d_id
+              << "]: " << *nv << "\n";
+  return nv;
+}
+
 void NodeManager::reclaimZombies() {
   // FIXME multithreading
   Assert(!d_attrManager->inGarbageCollection());
@@ -339,6 +380,7 @@ void NodeManager::reclaimZombies() {
         Assert(nv->d_rc == 1);
       }
       nv->d_rc = 0;
+      nv->d_rewritten = 0;
       d_attrManager->deleteAllAttributes(nv);
 
       // decr ref counts of children
@@ -353,7 +395,7 @@ void NodeManager::reclaimZombies() {
         // type for a constant payload.)
         kind::metakind::deleteNodeValueConstant(nv);
       }
-      free(nv);
+      freeNodeValue(nv);
     }
   }
 }/* NodeManager::reclaimZombies() */
@@ -421,34 +463,43 @@ TypeNode NodeManager::getType(TNode n, bool check)
 
   Debug("getType") << this << " getting type for " << &n << " " << n << ", check=" << check << ", needsCheck = " << needsCheck << ", hasType = " << hasType << endl;
   
-  if(needsCheck && !(*d_options)[options::earlyTypeChecking]) {
-    /* Iterate and compute the children bottom up. This avoids stack
-       overflows in computeType() when the Node graph is really deep,
-       which should only affect us when we're type checking lazily. */
-    stack<TNode> worklist;
-    worklist.push(n);
+  if ((!hasType || needsCheck) && !(*d_options)[options::earlyTypeChecking])
+  {
+    /* Compute the types of the subterms bottom up, visiting each of them
+       once. This avoids stack overflows in computeType() when the Node graph
+       is really deep, which should only affect us when we're type checking
+       lazily. */
+    expr::NodeIdSet visited;
+    // the subterms to visit, paired with whether their children were visited
+    std::vector<std::pair<TNode, bool> > worklist;
+    worklist.push_back(std::make_pair(n, false));
 
     while( !worklist.empty() ) {
-      TNode m = worklist.top();
+      std::pair<TNode, bool> cur = worklist.back();
+      worklist.pop_back();
+      TNode m = cur.first;
 
-      bool readyToCompute = true;
+      if (cur.second)
+      {
+        Assert(check || m.getMetaKind() != kind::metakind::NULLARY_OPERATOR);
+        /* All the children have types, time to compute */
+        typeNode = TypeChecker::computeType(this, m, check);
+        continue;
+      }
+      if (!visited.insert(m))
+      {
+        continue;
+      }
 
+      worklist.push_back(std::make_pair(m, true));
       for( TNode::iterator it = m.begin(), end = m.end();
            it != end;
            ++it ) {
         if( !hasAttribute(*it, TypeAttr())
             || (check && !getAttribute(*it, TypeCheckedAttr())) ) {
-          readyToCompute = false;
-          worklist.push(*it);
+          worklist.push_back(std::make_pair(*it, false));
         }
       }
-
-      if( readyToCompute ) {
-        Assert(check || m.getMetaKind() != kind::metakind::NULLARY_OPERATOR);
-        /* All the children have types, time to compute */
-        typeNode = TypeChecker::computeType(this, m, check);
-        worklist.pop();
-      }
     } // end while
 
     /* Last type computed in loop should be the type of n */
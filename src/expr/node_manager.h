@@ -28,14 +28,16 @@
 #ifndef CVC4__NODE_MANAGER_H
 #define CVC4__NODE_MANAGER_H
 
-#include <vector>
+#include <memory>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "base/check.h"
 #include "expr/kind.h"
 #include "expr/metakind.h"
 #include "expr/node_value.h"
+#include "expr/node_value_arena.h"
 #include "options/options.h"
 
 namespace CVC4 {
@@ -121,6 +123,12 @@ class NodeManager {
 
   NodeValuePool d_nodeValuePool;
 
+  /**
+   * The storage of the non-constant NodeValues of this NodeManager.  It is
+   * declared before all Node members so that it outlives them.
+   */
+  expr::NodeValueArena d_nodeValueArena;
+
   size_t next_id;
 
   expr::attr::AttributeManager* d_attrManager;
@@ -249,6 +257,53 @@ class NodeManager {
    */
   inline void poolInsert(expr::NodeValue* nv);
 
+  /** The most children of the nodes built by mkNodeDirect() */
+  static const uint32_t s_maxDirectChildren = 8;
+
+  /**
+   * Make the node of kind with the n children in children, without a
+   * NodeBuilder.  The pool is probed with a NodeValue on the stack that
+   * points at the children, without references on them, and a NodeValue is
+   * only allocated (and the references taken) if the node is new.  Kinds
+   * that are not plain operators, and nodes with more than
+   * s_maxDirectChildren children, go through a NodeBuilder.
+   */
+  inline Node mkNodeDirect(Kind kind, const TNode* children, uint32_t n);
+
+  /**
+   * Insert a copy of the stack NodeValue nvStack, which was not in the pool,
+   * into the pool, and return the canonical NodeValue.
+   */
+  expr::NodeValue* insertNodeValue(const expr::NodeValue& nvStack);
+
+  /**
+   * Allocate the storage for a (non-constant) NodeValue with nchildren
+   * children, including the operator of parameterized kinds.
+   *
+   * @throws bad_alloc if the allocation fails
+   */
+  expr::NodeValue* allocNodeValue(uint32_t nchildren)
+  {
+    return d_nodeValueArena.allocate(nchildren);
+  }
+
+  /**
+   * Release the storage of nv, whose payload (if a constant) must already
+   * have been destroyed.  Constants are malloc'ed by mkConst(), all other
+   * NodeValues come from allocNodeValue().
+   */
+  void freeNodeValue(expr::NodeValue* nv)
+  {
+    if (nv->getMetaKind() == kind::metakind::CONSTANT)
+    {
+      std::free(nv);
+    }
+    else
+    {
+      d_nodeValueArena.deallocate(nv, nv->d_nchildren);
+    }
+  }
+
   /**
    * Remove a NodeValue from the NodeManager's pool.
    *
@@ -565,6 +620,15 @@ public:
   /** make unique (per Type,Kind) variable. */
   Node mkNullaryOperator(const TypeNode& type, Kind k);
 
+  /**
+   * Pins n, i.e. sets its reference count to the maximal one, so that it
+   * lives as long as this NodeManager. The reference count of a pinned node
+   * is not written when copying or destroying its handles, which avoids
+   * writing to the cache line of the node for hot constants such as true,
+   * false, 0 and 1, which are pinned on creation of the NodeManager.
+   */
+  void pinNode(TNode n);
+
   /**
    * Create a constant of type T.  It will have the appropriate
    * CONST_* kind defined for T.
@@ -1254,6 +1318,60 @@ inline TypeNode NodeManager::fromType(Type t) {
 
 namespace CVC4 {
 
+inline Node NodeManager::mkNodeDirect(Kind kind,
+                                      const TNode* children,
+                                      uint32_t n)
+{
+  if (n > s_maxDirectChildren
+      || kind::metaKindOf(kind) != kind::metakind::OPERATOR)
+  {
+    NodeBuilder<> nb(this, kind);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      nb << children[i];
+    }
+    return nb.constructNode();
+  }
+  Assert(n >= kind::metakind::getLowerBoundForKind(kind))
+      << "Nodes with kind " << kind << " must have at least "
+      << kind::metakind::getLowerBoundForKind(kind) << " children";
+  Assert(n <= kind::metakind::getUpperBoundForKind(kind))
+      << "Nodes with kind " << kind << " must have at most "
+      << kind::metakind::getUpperBoundForKind(kind) << " children";
+  NVStorage<s_maxDirectChildren> nvStorage;
+  expr::NodeValue& nvStack = reinterpret_cast<expr::NodeValue&>(nvStorage);
+  nvStack.d_id = 0;
+  nvStack.d_kind = kind;
+  nvStack.d_rc = 0;
+  nvStack.d_rewritten = 0;
+  nvStack.d_nchildren = n;
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6))
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#endif
+  for (uint32_t i = 0; i < n; ++i)
+  {
+    Assert(!children[i].isNull()) << "Cannot use NULL Node as a child of a Node";
+    nvStack.d_children[i] = children[i].d_nv;
+  }
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6))
+#pragma GCC diagnostic pop
+#endif
+  expr::NodeValue* nv = poolLookup(&nvStack);
+  if (nv == nullptr)
+  {
+    nv = insertNodeValue(nvStack);
+  }
+  Node res(nv);
+#ifdef CVC4_DEBUG
+  if (getOptions()[options::earlyTypeChecking])
+  {
+    getType(res, true);
+  }
+#endif /* CVC4_DEBUG */
+  return res;
+}
+
 // general expression-builders
 
 inline bool NodeManager::hasOperator(Kind k) {
@@ -1280,9 +1398,8 @@ inline Kind NodeManager::operatorToKind(TNode n) {
 }
 
 inline Node NodeManager::mkNode(Kind kind, TNode child1) {
-  NodeBuilder<1> nb(this, kind);
-  nb << child1;
-  return nb.constructNode();
+  TNode children[] = {child1};
+  return mkNodeDirect(kind, children, 1);
 }
 
 inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1) {
@@ -1292,9 +1409,8 @@ inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1) {
 }
 
 inline Node NodeManager::mkNode(Kind kind, TNode child1, TNode child2) {
-  NodeBuilder<2> nb(this, kind);
-  nb << child1 << child2;
-  return nb.constructNode();
+  TNode children[] = {child1, child2};
+  return mkNodeDirect(kind, children, 2);
 }
 
 inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1, TNode child2) {
@@ -1305,9 +1421,8 @@ inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1, TNode child2) {
 
 inline Node NodeManager::mkNode(Kind kind, TNode child1, TNode child2,
                                 TNode child3) {
-  NodeBuilder<3> nb(this, kind);
-  nb << child1 << child2 << child3;
-  return nb.constructNode();
+  TNode children[] = {child1, child2, child3};
+  return mkNodeDirect(kind, children, 3);
 }
 
 inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1, TNode child2,
@@ -1319,9 +1434,8 @@ inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1, TNode child2,
 
 inline Node NodeManager::mkNode(Kind kind, TNode child1, TNode child2,
                                 TNode child3, TNode child4) {
-  NodeBuilder<4> nb(this, kind);
-  nb << child1 << child2 << child3 << child4;
-  return nb.constructNode();
+  TNode children[] = {child1, child2, child3, child4};
+  return mkNodeDirect(kind, children, 4);
 }
 
 inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1, TNode child2,
@@ -1333,9 +1447,8 @@ inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1, TNode child2,
 
 inline Node NodeManager::mkNode(Kind kind, TNode child1, TNode child2,
                                 TNode child3, TNode child4, TNode child5) {
-  NodeBuilder<5> nb(this, kind);
-  nb << child1 << child2 << child3 << child4 << child5;
-  return nb.constructNode();
+  TNode children[] = {child1, child2, child3, child4, child5};
+  return mkNodeDirect(kind, children, 5);
 }
 
 inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1, TNode child2,
@@ -1350,6 +1463,12 @@ template <bool ref_count>
 inline Node NodeManager::mkNode(Kind kind,
                                 const std::vector<NodeTemplate<ref_count> >&
                                 children) {
+  if (children.size() <= s_maxDirectChildren)
+  {
+    TNode cs[s_maxDirectChildren];
+    std::copy(children.begin(), children.end(), cs);
+    return mkNodeDirect(kind, cs, children.size());
+  }
   NodeBuilder<> nb(this, kind);
   nb.append(children);
   return nb.constructNode();
@@ -1543,6 +1662,7 @@ NodeClass NodeManager::mkConstInternal(const T& val) {
   nvStack.d_id = 0;
   nvStack.d_kind = kind::metakind::ConstantMap<T>::kind;
   nvStack.d_rc = 0;
+  nvStack.d_rewritten = 0;
   nvStack.d_nchildren = 1;
 
 #if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6))
@@ -1572,6 +1692,7 @@ NodeClass NodeManager::mkConstInternal(const T& val) {
   nv->d_kind = kind::metakind::ConstantMap<T>::kind;
   nv->d_id = next_id++;// FIXME multithreading
   nv->d_rc = 0;
+  nv->d_rewritten = 0;
 
   //OwningTheory::mkConst(val);
   new (&nv->d_children) T(val);
@@ -30,6 +30,12 @@ namespace attr {
   struct SortArityTag { };
   struct TypeTag { };
   struct TypeCheckedTag { };
+
+  /** The types are stored densely. */
+  template <>
+  struct IsDenseAttribute<TypeTag> : std::true_type
+  {
+  };
 }/* CVC4::expr::attr namespace */
 
 typedef Attribute<attr::VarNameTag, std::string> VarNameAttr;
@@ -0,0 +1,94 @@
+/*********************                                                        */
+/*! \file node_traversal.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Iterative traversals of the DAG of a node
+ **
+ ** Implementation of the sets of node ids used by the traversals.
+ **/
+
+#include "expr/node_traversal.h"
+
+#include <algorithm>
+
+namespace CVC4 {
+namespace expr {
+
+namespace {
+
+/** The maximal size of the arrays of stamps */
+const uint64_t s_maxStamps = uint64_t(1) << 24;
+
+/** The pool of the arrays of stamps that are not in use */
+class StampPool
+{
+ public:
+  ~StampPool()
+  {
+    for (const std::pair<std::vector<uint32_t>*, uint32_t>& s : d_free)
+    {
+      delete s.first;
+    }
+  }
+  /** Takes an array from the pool, and returns a fresh epoch for it */
+  std::vector<uint32_t>* acquire(uint32_t& epoch)
+  {
+    if (d_free.empty())
+    {
+      epoch = 1;
+      return new std::vector<uint32_t>();
+    }
+    std::vector<uint32_t>* stamps = d_free.back().first;
+    epoch = d_free.back().second + 1;
+    d_free.pop_back();
+    if (epoch == 0)
+    {
+      // the epochs wrapped around, the stamps are cleared
+      std::fill(stamps->begin(), stamps->end(), 0);
+      epoch = 1;
+    }
+    return stamps;
+  }
+  /** Returns an array whose last epoch is epoch to the pool */
+  void release(std::vector<uint32_t>* stamps, uint32_t epoch)
+  {
+    d_free.push_back(std::make_pair(stamps, epoch));
+  }
+
+ private:
+  /** The arrays, paired with their last epoch */
+  std::vector<std::pair<std::vector<uint32_t>*, uint32_t> > d_free;
+};
+
+thread_local StampPool s_stampPool;
+
+}  // namespace
+
+NodeIdSet::NodeIdSet() : d_stamps(s_stampPool.acquire(d_epoch)) {}
+
+NodeIdSet::~NodeIdSet() { s_stampPool.release(d_stamps, d_epoch); }
+
+bool NodeIdSet::insertSlow(TNode n)
+{
+  uint64_t id = n.getId();
+  if (id < s_maxStamps)
+  {
+    // the new stamps are zero, which is not an epoch
+    d_stamps->resize(std::min(s_maxStamps,
+                              std::max(id + 1, uint64_t(2 * d_stamps->size()))),
+                     0);
+    (*d_stamps)[id] = d_epoch;
+    return true;
+  }
+  return d_large.insert(id).second;
+}
+
+}  // namespace expr
+}  // namespace CVC4
@@ -0,0 +1,179 @@
+/*********************                                                        */
+/*! \file node_traversal.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Iterative traversals of the DAG of a node
+ **
+ ** This file implements iterative traversals of the DAG of a node, visiting
+ ** each of its subterms once, where the visited subterms are tracked by a set
+ ** of node ids instead of a hash set of nodes.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__EXPR__NODE_TRAVERSAL_H
+#define CVC4__EXPR__NODE_TRAVERSAL_H
+
+#include <cstdint>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "expr/node.h"
+
+namespace CVC4 {
+namespace expr {
+
+/**
+ * A set of nodes, represented by an array of epoch stamps indexed by the ids
+ * of the nodes, where the nodes in the set are those whose stamp is the epoch
+ * of this set. Creating a set only increments the epoch of its array, hence
+ * it is not cleared element by element.
+ *
+ * The arrays are taken from a (thread local) pool, so that the sets that are
+ * alive at the same time, e.g. those of nested traversals, use different
+ * arrays. The nodes whose id is beyond the size limit of the arrays are
+ * stored in a hash set.
+ */
+class NodeIdSet
+{
+ public:
+  NodeIdSet();
+  ~NodeIdSet();
+  NodeIdSet(const NodeIdSet&) = delete;
+  NodeIdSet& operator=(const NodeIdSet&) = delete;
+
+  /** Adds n to this set, returns true if n was not in this set. */
+  bool insert(TNode n)
+  {
+    uint64_t id = n.getId();
+    if (id < d_stamps->size())
+    {
+      if ((*d_stamps)[id] == d_epoch)
+      {
+        return false;
+      }
+      (*d_stamps)[id] = d_epoch;
+      return true;
+    }
+    return insertSlow(n);
+  }
+  /** Returns true if n is in this set. */
+  bool contains(TNode n) const
+  {
+    uint64_t id = n.getId();
+    if (id < d_stamps->size())
+    {
+      return (*d_stamps)[id] == d_epoch;
+    }
+    return d_large.find(id) != d_large.end();
+  }
+
+ private:
+  /** The insertion of a node whose id is beyond the size of the array */
+  bool insertSlow(TNode n);
+  /** The array of stamps */
+  std::vector<uint32_t>* d_stamps;
+  /** The epoch of this set */
+  uint32_t d_epoch;
+  /** The ids of the nodes in this set beyond the size limit of the array */
+  std::unordered_set<uint64_t> d_large;
+};
+
+/** The action taken after visiting a node in a traversal */
+enum class VisitAction
+{
+  /** visit the children of the node */
+  CONTINUE,
+  /** do not visit the children of the node */
+  SKIP_CHILDREN,
+  /** stop the traversal */
+  ABORT
+};
+
+/** A post-order callback that does nothing */
+struct NoPostVisit
+{
+  void operator()(TNode n) const {}
+};
+
+/**
+ * Traverses the DAG of n iteratively, visiting each of its subterms once,
+ * and their operators if visitOperators is true.
+ *
+ * @param pre Called on each subterm when it is visited for the first time,
+ * callable as VisitAction pre(TNode)
+ * @param post Called on each subterm whose children were visited, after all
+ * of them were processed, callable as void post(TNode)
+ * @return false if the traversal was aborted by pre
+ */
+template <class PreVisit, class PostVisit>
+bool traverseDagPost(TNode n,
+                     PreVisit pre,
+                     PostVisit post,
+                     bool visitOperators = false)
+{
+  const bool hasPost = !std::is_same<PostVisit, NoPostVisit>::value;
+  NodeIdSet visited;
+  // the nodes to visit, paired with whether their children were visited
+  std::vector<std::pair<TNode, bool> > visit;
+  visit.push_back(std::make_pair(n, false));
+  do
+  {
+    std::pair<TNode, bool> cur = visit.back();
+    visit.pop_back();
+    if (cur.second)
+    {
+      post(cur.first);
+      continue;
+    }
+    if (!visited.insert(cur.first))
+    {
+      continue;
+    }
+    VisitAction action = pre(cur.first);
+    if (action == VisitAction::ABORT)
+    {
+      return false;
+    }
+    if (action == VisitAction::SKIP_CHILDREN)
+    {
+      continue;
+    }
+    if (hasPost)
+    {
+      visit.push_back(std::make_pair(cur.first, true));
+    }
+    if (visitOperators && cur.first.hasOperator())
+    {
+      visit.push_back(std::make_pair(cur.first.getOperator(), false));
+    }
+    for (TNode cn : cur.first)
+    {
+      visit.push_back(std::make_pair(cn, false));
+    }
+  } while (!visit.empty());
+  return true;
+}
+
+/**
+ * Same as above, without a post-order callback.
+ */
+template <class PreVisit>
+bool traverseDag(TNode n, PreVisit pre, bool visitOperators = false)
+{
+  return traverseDagPost(n, pre, NoPostVisit(), visitOperators);
+}
+
+}  // namespace expr
+}  // namespace CVC4
+
+#endif /* CVC4__EXPR__NODE_TRAVERSAL_H */
@@ -14,6 +14,8 @@
 
 #include "expr/node_trie.h"
 
+#include <algorithm>
+
 namespace CVC4 {
 namespace theory {
 
@@ -91,5 +93,157 @@ template void NodeTemplateTrie<false>::debugPrint(const char* c,
 template void NodeTemplateTrie<true>::debugPrint(const char* c,
                                                  unsigned depth) const;
 
+template <bool ref_count>
+NodeTemplateFlatTrie<ref_count>::NodeTemplateFlatTrie()
+    : d_nodes(1, TrieNode{NodeTemplate<ref_count>::null(), 0, 0, 0}),
+      d_table(16, Slot{0, 0, 0}),
+      d_generation(1)
+{
+}
+
+template <bool ref_count>
+size_t NodeTemplateFlatTrie<ref_count>::hash(
+    Index parent, const NodeTemplate<ref_count>& key) const
+{
+  uint64_t h = (key.getId() * 0x9e3779b97f4a7c15ULL) ^ parent;
+  h ^= h >> 29;
+  return static_cast<size_t>(h) & (d_table.size() - 1);
+}
+
+template <bool ref_count>
+typename NodeTemplateFlatTrie<ref_count>::Index
+NodeTemplateFlatTrie<ref_count>::getChild(Index i,
+                                          NodeTemplate<ref_count> key) const
+{
+  size_t mask = d_table.size() - 1;
+  for (size_t s = hash(i, key); d_table[s].d_generation == d_generation;
+       s = (s + 1) & mask)
+  {
+    const Slot& slot = d_table[s];
+    if (slot.d_parent == i && d_nodes[slot.d_child].d_key == key)
+    {
+      return slot.d_child;
+    }
+  }
+  return 0;
+}
+
+template <bool ref_count>
+typename NodeTemplateFlatTrie<ref_count>::Index
+NodeTemplateFlatTrie<ref_count>::getOrMakeChild(Index i,
+                                                NodeTemplate<ref_count> key)
+{
+  Index child = getChild(i, key);
+  if (child != 0)
+  {
+    return child;
+  }
+  // keep the load factor of the hash table below 1/2
+  if (2 * d_nodes.size() >= d_table.size())
+  {
+    grow();
+  }
+  child = d_nodes.size();
+  d_nodes.push_back(TrieNode{key, 0, 0, 0});
+  TrieNode& parent = d_nodes[i];
+  if (parent.d_lastChild == 0)
+  {
+    parent.d_firstChild = child;
+  }
+  else
+  {
+    d_nodes[parent.d_lastChild].d_nextSibling = child;
+  }
+  parent.d_lastChild = child;
+
+  size_t mask = d_table.size() - 1;
+  size_t s = hash(i, key);
+  while (d_table[s].d_generation == d_generation)
+  {
+    s = (s + 1) & mask;
+  }
+  d_table[s] = Slot{i, child, d_generation};
+  return child;
+}
+
+template <bool ref_count>
+void NodeTemplateFlatTrie<ref_count>::grow()
+{
+  std::vector<Slot> old(2 * d_table.size(), Slot{0, 0, 0});
+  old.swap(d_table);
+  uint32_t oldGeneration = d_generation;
+  d_generation = 1;
+  size_t mask = d_table.size() - 1;
+  for (const Slot& slot : old)
+  {
+    if (slot.d_generation == oldGeneration)
+    {
+      size_t s = hash(slot.d_parent, d_nodes[slot.d_child].d_key);
+      while (d_table[s].d_generation == d_generation)
+      {
+        s = (s + 1) & mask;
+      }
+      d_table[s] = Slot{slot.d_parent, slot.d_child, d_generation};
+    }
+  }
+}
+
+template <bool ref_count>
+void NodeTemplateFlatTrie<ref_count>::clear()
+{
+  d_nodes.resize(1);
+  d_nodes[0].d_firstChild = 0;
+  d_nodes[0].d_lastChild = 0;
+  ++d_generation;
+  if (d_generation == 0)
+  {
+    // the stamps wrapped around, invalidate all entries explicitly
+    std::fill(d_table.begin(), d_table.end(), Slot{0, 0, 0});
+    d_generation = 1;
+  }
+}
+
+template <bool ref_count>
+NodeTemplate<ref_count> NodeTemplateFlatTrie<ref_count>::existsTerm(
+    const std::vector<NodeTemplate<ref_count>>& reps) const
+{
+  Index i = root();
+  for (const NodeTemplate<ref_count>& r : reps)
+  {
+    i = getChild(i, r);
+    if (i == 0)
+    {
+      // didn't find this child, return null
+      return Node::null();
+    }
+  }
+  if (!hasData(i))
+  {
+    return Node::null();
+  }
+  return getData(i);
+}
+
+template <bool ref_count>
+NodeTemplate<ref_count> NodeTemplateFlatTrie<ref_count>::addOrGetTerm(
+    NodeTemplate<ref_count> n, const std::vector<NodeTemplate<ref_count>>& reps)
+{
+  Index i = root();
+  for (const NodeTemplate<ref_count>& r : reps)
+  {
+    i = getOrMakeChild(i, r);
+  }
+  if (!hasData(i))
+  {
+    // Store n as the only child, which should be interpretted as the "data"
+    getOrMakeChild(i, n);
+    return n;
+  }
+  return getData(i);
+}
+
+template class NodeTemplateFlatTrie<false>;
+template class NodeTemplateFlatTrie<true>;
+
 }  // namespace theory
 }  // namespace CVC4
@@ -18,6 +18,8 @@
 #define CVC4__EXPR__NODE_TRIE_H
 
 #include <map>
+#include <vector>
+
 #include "expr/node.h"
 
 namespace CVC4 {
@@ -106,6 +108,117 @@ typedef NodeTemplateTrie<true> NodeTrie;
 /** Non-reference-counted version of the above data structure */
 typedef NodeTemplateTrie<false> TNodeTrie;
 
+/** NodeTemplate flat trie class
+ *
+ * This is a trie with the same use as NodeTemplateTrie, i.e. term indices
+ * whose leaves store the indexed terms, whose nodes are stored in a single
+ * array instead of a map at each node. The nodes are identified by their
+ * indices in this array. The root has index 0, which is never a child, so
+ * 0 also stands for "no node" in the navigation methods below.
+ *
+ * The children of a node are found through an open addressing hash table
+ * from (parent, key) to child, and can be iterated in their order of
+ * insertion through sibling links. Clearing the trie keeps the storage of
+ * both the nodes and the hash table for reuse, and is O(1) for TNodes: the
+ * entries of the hash table are invalidated by bumping a generation stamp.
+ * This makes it suited for indices that are rebuilt every round.
+ */
+template <bool ref_count>
+class NodeTemplateFlatTrie
+{
+ public:
+  /** The index of a node of the trie */
+  typedef uint32_t Index;
+
+  NodeTemplateFlatTrie();
+
+  /** Get the root of the trie */
+  static Index root() { return 0; }
+  /** Get the child of node i with the given key, or 0 if none */
+  Index getChild(Index i, NodeTemplate<ref_count> key) const;
+  /** Get the child of node i with the given key, making it if none */
+  Index getOrMakeChild(Index i, NodeTemplate<ref_count> key);
+  /** Get the first child of node i, or 0 if none */
+  Index getFirstChild(Index i) const { return d_nodes[i].d_firstChild; }
+  /** Get the next sibling of node i, or 0 if none */
+  Index getNextSibling(Index i) const { return d_nodes[i].d_nextSibling; }
+  /** Get the key of node i */
+  const NodeTemplate<ref_count>& getKey(Index i) const
+  {
+    return d_nodes[i].d_key;
+  }
+  /** For leaf nodes : does node i have data? */
+  bool hasData(Index i) const { return getFirstChild(i) != 0; }
+  /** For leaf nodes : get the node corresponding to leaf i. */
+  NodeTemplate<ref_count> getData(Index i) const
+  {
+    return getKey(getFirstChild(i));
+  }
+  /**
+   * Returns the term that is indexed by reps, if one exists, or
+   * or returns null otherwise.
+   */
+  NodeTemplate<ref_count> existsTerm(
+      const std::vector<NodeTemplate<ref_count>>& reps) const;
+  /**
+   * Returns the term that is previously indexed by reps, if one exists, or
+   * adds n to the trie, indexed by reps, and returns n.
+   */
+  NodeTemplate<ref_count> addOrGetTerm(
+      NodeTemplate<ref_count> n,
+      const std::vector<NodeTemplate<ref_count>>& reps);
+  /**
+   * Returns false if a term is previously indexed by reps.
+   * Returns true if no term is previously indexed by reps,
+   *   and adds n to the trie, indexed by reps.
+   */
+  bool addTerm(NodeTemplate<ref_count> n,
+               const std::vector<NodeTemplate<ref_count>>& reps)
+  {
+    return addOrGetTerm(n, reps) == n;
+  }
+  /** Clear all data from this trie, keeping its storage. */
+  void clear();
+  /** Is this trie empty? */
+  bool empty() const { return d_nodes.size() == 1; }
+
+ private:
+  /** A node of the trie */
+  struct TrieNode
+  {
+    /** The key of the node in its parent */
+    NodeTemplate<ref_count> d_key;
+    /** The first child of the node, or 0 */
+    Index d_firstChild;
+    /** The last child of the node, or 0 */
+    Index d_lastChild;
+    /** The next sibling of the node, or 0 */
+    Index d_nextSibling;
+  };
+  /** An entry of the hash table, valid if its generation is the current one */
+  struct Slot
+  {
+    Index d_parent;
+    Index d_child;
+    uint32_t d_generation;
+  };
+  /** The nodes of the trie, the root first */
+  std::vector<TrieNode> d_nodes;
+  /** The hash table from (parent, key) to child, of size a power of 2 */
+  std::vector<Slot> d_table;
+  /** The current generation of the hash table */
+  uint32_t d_generation;
+  /** Returns the first slot to probe for the child of parent with key */
+  size_t hash(Index parent, const NodeTemplate<ref_count>& key) const;
+  /** Doubles the size of the hash table */
+  void grow();
+}; /* class NodeTemplateFlatTrie */
+
+/** Reference-counted version of the above data structure */
+typedef NodeTemplateFlatTrie<true> NodeFlatTrie;
+/** Non-reference-counted version of the above data structure */
+typedef NodeTemplateFlatTrie<false> TNodeFlatTrie;
+
 }  // namespace theory
 }  // namespace CVC4
 
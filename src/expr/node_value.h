@@ -172,8 +172,12 @@ class NodeValue
   /** Number of bits reserved for node id. */
   static constexpr uint32_t NBITS_ID = 40;
   /** Number of bits reserved for number of children. */
-  static const uint32_t NBITS_NCHILDREN = 26;
-  static_assert(NBITS_REFCOUNT + NBITS_KIND + NBITS_ID + NBITS_NCHILDREN == 96,
+  static const uint32_t NBITS_NCHILDREN = 25;
+  /** Number of bits reserved for the rewritten flag. */
+  static constexpr uint32_t NBITS_REWRITTEN = 1;
+  static_assert(NBITS_REFCOUNT + NBITS_KIND + NBITS_ID + NBITS_NCHILDREN
+                        + NBITS_REWRITTEN
+                    == 96,
                 "NodeValue header bit assignment does not sum to 96 !");
   /* ------------------- This header fits into 96 bits ---------------------- */
 
@@ -183,6 +187,14 @@ class NodeValue
 
   uint32_t getRefCount() const { return d_rc; }
 
+  /**
+   * Returns true if this node is known to be in rewritten form, i.e. if
+   * rewriting it returns the node itself.
+   */
+  bool isRewritten() const { return d_rewritten; }
+  /** Marks this node as being in rewritten form. */
+  void setRewritten() { d_rewritten = 1; }
+
   NodeValue* getOperator() const;
   NodeValue* getChild(int i) const;
 
@@ -343,6 +355,9 @@ class NodeValue
   /** Number of children */
   uint32_t d_nchildren : NBITS_NCHILDREN;
 
+  /** Whether the expression is in rewritten form */
+  uint32_t d_rewritten : NBITS_REWRITTEN;
+
   /** Variable number of child nodes */
   NodeValue* d_children[0];
 }; /* class NodeValue */
@@ -411,7 +426,8 @@ inline NodeValue::NodeValue(int) :
   d_id(0),
   d_rc(MAX_RC),
   d_kind(kind::NULL_EXPR),
-  d_nchildren(0) {
+  d_nchildren(0),
+  d_rewritten(0) {
 }
 
 inline void NodeValue::decrRefCounts() {
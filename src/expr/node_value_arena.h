@@ -0,0 +1,162 @@
+/*********************                                                        */
+/*! \file node_value_arena.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Slab allocator for the NodeValues of a NodeManager
+ **
+ ** Slab allocator for the NodeValues of a NodeManager.  NodeValues with up
+ ** to s_maxSlabChildren children are carved out of large slabs, with one
+ ** size class (and free list) per number of children.  Wider NodeValues
+ ** fall back to malloc.  The slabs are only returned to the system when the
+ ** arena is destroyed, i.e. together with the NodeManager.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__EXPR__NODE_VALUE_ARENA_H
+#define CVC4__EXPR__NODE_VALUE_ARENA_H
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "expr/node_value.h"
+
+namespace CVC4 {
+namespace expr {
+
+class NodeValueArena
+{
+ public:
+  /** NodeValues with more children than this are malloc'ed. */
+  static const uint32_t s_maxSlabChildren = 7;
+
+  NodeValueArena()
+  {
+    for (SizeClass& sc : d_classes)
+    {
+      sc.d_free = NULL;
+      sc.d_bump = NULL;
+      sc.d_end = NULL;
+    }
+  }
+
+  /** Release all slabs, along with any NodeValue still living in them. */
+  ~NodeValueArena()
+  {
+    for (void* slab : d_slabs)
+    {
+      std::free(slab);
+    }
+  }
+
+  /**
+   * Allocate (uninitialized) storage for a NodeValue with nchildren
+   * children.
+   *
+   * @throws bad_alloc if the allocation fails
+   */
+  NodeValue* allocate(uint32_t nchildren)
+  {
+    if (nchildren > s_maxSlabChildren)
+    {
+      void* p = std::malloc(getCellSize(nchildren));
+      if (p == NULL)
+      {
+        throw std::bad_alloc();
+      }
+      return static_cast<NodeValue*>(p);
+    }
+    SizeClass& sc = d_classes[nchildren];
+    if (sc.d_free != NULL)
+    {
+      FreeCell* cell = sc.d_free;
+      sc.d_free = cell->d_next;
+      return reinterpret_cast<NodeValue*>(cell);
+    }
+    if (sc.d_bump == sc.d_end)
+    {
+      newSlab(nchildren);
+    }
+    char* p = sc.d_bump;
+    sc.d_bump += getCellSize(nchildren);
+    return reinterpret_cast<NodeValue*>(p);
+  }
+
+  /**
+   * Return the storage of nv, which was allocated for nchildren children,
+   * to the arena.
+   */
+  void deallocate(NodeValue* nv, uint32_t nchildren)
+  {
+    if (nchildren > s_maxSlabChildren)
+    {
+      std::free(nv);
+      return;
+    }
+    FreeCell* cell = reinterpret_cast<FreeCell*>(nv);
+    cell->d_next = d_classes[nchildren].d_free;
+    d_classes[nchildren].d_free = cell;
+  }
+
+  /** The number of slabs allocated so far. */
+  size_t getNumSlabs() const { return d_slabs.size(); }
+
+  /** The size of a NodeValue with nchildren children. */
+  static size_t getCellSize(uint32_t nchildren)
+  {
+    return sizeof(NodeValue) + sizeof(NodeValue*) * nchildren;
+  }
+
+ private:
+  /** A cell on a free list. */
+  struct FreeCell
+  {
+    FreeCell* d_next;
+  };
+
+  /** The state of the cells holding NodeValues with a given arity. */
+  struct SizeClass
+  {
+    /** Cells that were deallocated. */
+    FreeCell* d_free;
+    /** The next never-used cell of the current slab of this class. */
+    char* d_bump;
+    /** The end of the current slab of this class. */
+    char* d_end;
+  };
+
+  /** The number of cells per slab. */
+  static const size_t s_cellsPerSlab = 1024;
+
+  /** Start a new slab for arity nchildren. */
+  void newSlab(uint32_t nchildren)
+  {
+    size_t size = getCellSize(nchildren) * s_cellsPerSlab;
+    d_slabs.reserve(d_slabs.size() + 1);
+    char* slab = static_cast<char*>(std::malloc(size));
+    if (slab == NULL)
+    {
+      throw std::bad_alloc();
+    }
+    d_slabs.push_back(slab);
+    d_classes[nchildren].d_bump = slab;
+    d_classes[nchildren].d_end = slab + size;
+  }
+
+  SizeClass d_classes[s_maxSlabChildren + 1];
+  /** All slabs, released on destruction. */
+  std::vector<void*> d_slabs;
+}; /* class NodeValueArena */
+
+}  // namespace expr
+}  // namespace CVC4
+
+#endif /* CVC4__EXPR__NODE_VALUE_ARENA_H */
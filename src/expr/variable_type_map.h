@@ -56,6 +56,14 @@ struct CVC4_PUBLIC ExprManagerMapCollection {
   VariableTypeMap d_typeMap;
   VarMap d_to;
   VarMap d_from;
+  /**
+   * A map from the non-variable expressions exported with this collection to
+   * their exported expressions, and back. This is used so that exporting an
+   * expression again, or exporting it back, or exporting an expression that
+   * shares subexpressions with previous ones, does not rebuild the shared
+   * subexpressions.
+   */
+  std::unordered_map<Expr, Expr, ExprHashFunction> d_exportCache;
 };/* struct ExprManagerMapCollection */
 
 }/* CVC4 namespace */
@@ -0,0 +1,101 @@
+/*********************                                                        */
+/*! \file clause_exchange.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The exchange of learned clauses between the portfolio workers.
+ **/
+
+#include "main/clause_exchange.h"
+
+namespace CVC4 {
+namespace main {
+
+ClauseRing::ClauseRing(size_t capacity)
+    : d_buffer(capacity), d_head(0), d_tail(0)
+{
+}
+
+bool ClauseRing::push(const std::vector<uint32_t>& clause)
+{
+  size_t size = clause.size() + 1;
+  size_t tail = d_tail.load(std::memory_order_relaxed);
+  // acquire the slots that the consumer is done with
+  size_t head = d_head.load(std::memory_order_acquire);
+  if (d_buffer.size() - (tail - head) < size)
+  {
+    return false;
+  }
+  d_buffer[tail % d_buffer.size()] = clause.size();
+  for (size_t i = 0; i < clause.size(); ++i)
+  {
+    d_buffer[(tail + 1 + i) % d_buffer.size()] = clause[i];
+  }
+  // publish the clause
+  d_tail.store(tail + size, std::memory_order_release);
+  return true;
+}
+
+void ClauseRing::pop(std::vector<std::vector<uint32_t> >& clauses)
+{
+  size_t head = d_head.load(std::memory_order_relaxed);
+  size_t tail = d_tail.load(std::memory_order_acquire);
+  while (head != tail)
+  {
+    size_t size = d_buffer[head % d_buffer.size()];
+    clauses.emplace_back();
+    std::vector<uint32_t>& clause = clauses.back();
+    for (size_t i = 0; i < size; ++i)
+    {
+      clause.push_back(d_buffer[(head + 1 + i) % d_buffer.size()]);
+    }
+    head += size + 1;
+  }
+  // give the slots back to the producer
+  d_head.store(head, std::memory_order_release);
+}
+
+ClauseExchange::ClauseExchange(unsigned n, size_t capacity) : d_n(n)
+{
+  for (unsigned i = 0; i < n * n; ++i)
+  {
+    d_rings.emplace_back(new ClauseRing(i / n == i % n ? 0 : capacity));
+  }
+  for (unsigned i = 0; i < n; ++i)
+  {
+    d_endpoints.emplace_back(new Endpoint(*this, i));
+  }
+}
+
+void ClauseExchange::Endpoint::exportClause(
+    const std::vector<uint32_t>& clause)
+{
+  for (unsigned j = 0; j < d_exchange.d_n; ++j)
+  {
+    if (j != d_index)
+    {
+      d_exchange.getRing(d_index, j).push(clause);
+    }
+  }
+}
+
+void ClauseExchange::Endpoint::importClauses(
+    std::vector<std::vector<uint32_t> >& clauses)
+{
+  for (unsigned j = 0; j < d_exchange.d_n; ++j)
+  {
+    if (j != d_index)
+    {
+      d_exchange.getRing(j, d_index).pop(clauses);
+    }
+  }
+}
+
+}  // namespace main
+}  // namespace CVC4
@@ -0,0 +1,98 @@
+/*********************                                                        */
+/*! \file clause_exchange.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The exchange of learned clauses between the portfolio workers.
+ **
+ ** Each pair of workers is connected by a lock-free ring with a single
+ ** producer and a single consumer: a worker exports a clause by pushing it
+ ** into its rings to the others, and imports by draining the rings of the
+ ** others to itself.  A clause that does not fit into a full ring is dropped,
+ ** so that no worker ever waits for another.
+ **/
+
+#ifndef CVC4__MAIN__CLAUSE_EXCHANGE_H
+#define CVC4__MAIN__CLAUSE_EXCHANGE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "smt/clause_sharing.h"
+
+namespace CVC4 {
+namespace main {
+
+/**
+ * A ring of clauses between the thread of a producer and the thread of a
+ * consumer.  A clause is stored as its size followed by its literals.
+ */
+class ClauseRing
+{
+ public:
+  /** Create a ring of capacity literals, sizes included. */
+  explicit ClauseRing(size_t capacity);
+
+  /** Push clause, called by the producer. Returns false if it is full. */
+  bool push(const std::vector<uint32_t>& clause);
+
+  /** Append the pushed clauses to clauses, called by the consumer. */
+  void pop(std::vector<std::vector<uint32_t> >& clauses);
+
+ private:
+  std::vector<uint32_t> d_buffer;
+  /** The position of the next clause to pop, written by the consumer */
+  std::atomic<size_t> d_head;
+  /** Keeps the positions on separate cache lines */
+  char d_padding[64 - sizeof(std::atomic<size_t>)];
+  /** The position of the next clause to push, written by the producer */
+  std::atomic<size_t> d_tail;
+}; /* class ClauseRing */
+
+/** The rings between n workers, and the endpoint of each worker. */
+class ClauseExchange
+{
+ public:
+  ClauseExchange(unsigned n, size_t capacity);
+
+  /** Get the endpoint of the i-th worker, to pass to its SmtEngine. */
+  ClauseSharing* getEndpoint(unsigned i) { return d_endpoints[i].get(); }
+
+ private:
+  class Endpoint : public ClauseSharing
+  {
+   public:
+    Endpoint(ClauseExchange& exchange, unsigned i)
+        : d_exchange(exchange), d_index(i)
+    {
+    }
+    void exportClause(const std::vector<uint32_t>& clause) override;
+    void importClauses(std::vector<std::vector<uint32_t> >& clauses) override;
+
+   private:
+    ClauseExchange& d_exchange;
+    unsigned d_index;
+  };
+
+  /** Get the ring from worker i to worker j. */
+  ClauseRing& getRing(unsigned i, unsigned j) { return *d_rings[i * d_n + j]; }
+
+  unsigned d_n;
+  /** The rings, by producer and consumer (those from a worker to itself are
+   * unused) */
+  std::vector<std::unique_ptr<ClauseRing> > d_rings;
+  std::vector<std::unique_ptr<Endpoint> > d_endpoints;
+}; /* class ClauseExchange */
+
+}  // namespace main
+}  // namespace CVC4
+
+#endif /* CVC4__MAIN__CLAUSE_EXCHANGE_H */
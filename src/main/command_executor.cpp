@@ -63,6 +63,7 @@ void CommandExecutor::flushStatistics(std::ostream& out) const
   d_solver->getExprManager()->getStatistics().flushInformation(out);
   d_smtEngine->getStatistics().flushInformation(out);
   d_stats.flushInformation(out);
+  d_smtEngine->printPreprocessingProfile(out);
 }
 
 void CommandExecutor::safeFlushStatistics(int fd) const
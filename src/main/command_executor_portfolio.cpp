@@ -0,0 +1,609 @@
+/*********************                                                        */
+/*! \file command_executor_portfolio.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A command executor that races a portfolio of solvers.
+ **/
+
+#include "main/command_executor_portfolio.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+#include "base/configuration.h"
+#include "base/output.h"
+#include "expr/kind.h"
+#include "expr/type.h"
+#include "main/cube_rpc.h"
+#include "options/option_exception.h"
+#include "smt/command.h"
+#include "smt/cube_generator.h"
+
+namespace CVC4 {
+namespace main {
+
+namespace {
+
+/**
+ * Returns the atoms of the Boolean structure of the assertions of commands,
+ * i.e. the formulas below the Boolean connectives that the CNF stream gives
+ * a SAT variable, in the order in which they are first found.
+ */
+std::vector<Expr> collectAtoms(
+    const std::vector<std::unique_ptr<Command> >& commands)
+{
+  std::vector<Expr> atoms;
+  std::unordered_set<Expr, ExprHashFunction> visited;
+  std::vector<Expr> visit;
+  for (const std::unique_ptr<Command>& c : commands)
+  {
+    AssertCommand* ac = dynamic_cast<AssertCommand*>(c.get());
+    if (ac != nullptr)
+    {
+      visit.push_back(ac->getExpr());
+    }
+  }
+  std::reverse(visit.begin(), visit.end());
+  while (!visit.empty())
+  {
+    Expr e = visit.back();
+    visit.pop_back();
+    if (!visited.insert(e).second || e.isConst())
+    {
+      continue;
+    }
+    bool connective;
+    switch (e.getKind())
+    {
+      case kind::NOT:
+      case kind::AND:
+      case kind::OR:
+      case kind::IMPLIES:
+      case kind::XOR: connective = true; break;
+      case kind::ITE:
+      case kind::EQUAL: connective = e[1].getType().isBoolean(); break;
+      default: connective = false; break;
+    }
+    if (!connective)
+    {
+      atoms.push_back(e);
+      continue;
+    }
+    for (size_t i = e.getNumChildren(); i > 0; --i)
+    {
+      visit.push_back(e[i - 1]);
+    }
+  }
+  return atoms;
+}
+
+}  // namespace
+
+CommandExecutorPortfolio::CommandExecutorPortfolio(Options& options)
+    : CommandExecutor(options)
+{
+  if (!d_options.getAutoStrategy())
+  {
+    return;
+  }
+  const std::string& file = d_options.getStrategyTable();
+  if (file.empty())
+  {
+    d_selector.reset(new StrategyTable(StrategyTable::getDefault()));
+    return;
+  }
+  std::ifstream in(file);
+  if (!in)
+  {
+    throw OptionException("cannot read the strategy table " + file);
+  }
+  d_selector.reset(new StrategyTable(in, file));
+}
+
+void CommandExecutorPortfolio::configureWorker(
+    api::Solver* solver,
+    unsigned i,
+    const std::vector<std::pair<std::string, std::string> >& preset) const
+{
+  bool cubing = d_options.getCubeDepth() > 0;
+  if (i == 0 || cubing)
+  {
+    for (const std::pair<std::string, std::string>& o : preset)
+    {
+      solver->setOption(o.first, o.second);
+    }
+  }
+  if (cubing)
+  {
+    // workers solve several cubes each, reusing what they learned
+    solver->setOption("incremental", "true");
+    return;
+  }
+  // Worker 0 runs the configuration given by the user, or the selected
+  // preset.  The others use distinct SAT seeds, alternate between the
+  // justification and the internal decision heuristic, and every other pair
+  // of them uses CaDiCaL unless the user chose the SAT solver or needs a
+  // feature that only Minisat supports.
+  if (i == 0)
+  {
+    return;
+  }
+  solver->setOption("random-seed", std::to_string(i));
+  solver->setOption("decision", i % 2 == 1 ? "justification" : "internal");
+  SmtEngine* smt = solver->getSmtEngine();
+  if (i / 2 % 2 == 1 && Configuration::isBuiltWithCadicalPropagator()
+      && !d_options.wasSetByUserSatSolver()
+      && smt->getOption("produce-unsat-cores").getValue() == "false"
+      && smt->getOption("produce-proofs").getValue() == "false"
+      && smt->getOption("decision-activity").getValue() == "false"
+      && smt->getOption("sat-hints-save").getValue().empty())
+  {
+    solver->setOption("sat-solver", "cadical");
+  }
+}
+
+bool CommandExecutorPortfolio::doCommandSingleton(Command* cmd)
+{
+  if (d_winner != nullptr)
+  {
+    // After a race, the remaining commands of the script (get-model,
+    // get-value, ...) are answered by the winner.
+    Command* exported = cmd->exportTo(d_winner->d_solver->getExprManager(),
+                                      d_winner->d_vmap);
+    d_winner->d_commands.emplace_back(exported);
+    return smtEngineInvoke(d_winner->d_solver->getSmtEngine(),
+                           exported,
+                           d_options.getVerbosity() >= -1 ? d_options.getOut()
+                                                          : nullptr);
+  }
+  CheckSatCommand* cs = dynamic_cast<CheckSatCommand*>(cmd);
+  if (cs != nullptr && !d_options.getIncrementalSolving())
+  {
+    return raceCheckSat(cs);
+  }
+  d_history.emplace_back(cmd->clone());
+  return CommandExecutor::doCommandSingleton(cmd);
+}
+
+bool CommandExecutorPortfolio::raceCheckSat(CheckSatCommand* cmd)
+{
+  unsigned n = std::max(d_options.getThreads(), 1u);
+  bool cubing = d_options.getCubeDepth() > 0;
+
+  // In cube-and-conquer mode, the jobs are the cubes, which are handed out
+  // to whichever worker asks next.  Otherwise, each worker has a single job,
+  // the check-sat command itself.
+  std::vector<std::vector<Expr> > cubes;
+  if (cubing)
+  {
+    CubeGenerator cg;
+    for (const std::unique_ptr<Command>& c : d_history)
+    {
+      AssertCommand* ac = dynamic_cast<AssertCommand*>(c.get());
+      if (ac != nullptr)
+      {
+        cg.addAssertion(ac->getExpr());
+      }
+    }
+    cubes = cg.getCubes(d_options.getCubeDepth());
+    Trace("portfolio") << "portfolio: solving " << cubes.size()
+                       << " cubes on " << n << " workers" << std::endl;
+  }
+  size_t numJobs = cubing ? cubes.size() : 1;
+
+  std::vector<std::pair<std::string, std::string> > preset;
+  if (d_selector != nullptr)
+  {
+    ProblemFeatures features;
+    for (const std::unique_ptr<Command>& c : d_history)
+    {
+      SetBenchmarkLogicCommand* sl =
+          dynamic_cast<SetBenchmarkLogicCommand*>(c.get());
+      AssertCommand* ac = dynamic_cast<AssertCommand*>(c.get());
+      if (sl != nullptr)
+      {
+        features.setLogic(sl->getLogic());
+      }
+      else if (ac != nullptr)
+      {
+        features.addAssertion(ac->getExpr());
+      }
+    }
+    preset = d_selector->select(features);
+    if (Trace.isOn("strategy"))
+    {
+      std::ostringstream out;
+      features.toStream(out);
+      Trace("strategy") << out.str();
+      for (const std::pair<std::string, std::string>& o : preset)
+      {
+        Trace("strategy") << "strategy: --" << o.first << "=" << o.second
+                          << std::endl;
+      }
+    }
+  }
+
+  // Exporting reads the nodes of the main ExprManager, so it cannot happen
+  // concurrently; set up all workers before starting any of them.
+  // When racing, the workers that preprocess the problem alike share their
+  // learned clauses over the atoms of the assertions; worker 0 does not if
+  // it runs a preset.
+  std::vector<Expr> atoms;
+  unsigned firstSharing = preset.empty() ? 0 : 1;
+  d_exchange.reset();
+  if (!cubing && n - firstSharing > 1)
+  {
+    atoms = collectAtoms(d_history);
+    d_exchange.reset(new ClauseExchange(n - firstSharing, 1 << 14));
+    Trace("portfolio") << "portfolio: sharing clauses over " << atoms.size()
+                       << " atoms between " << n - firstSharing << " workers"
+                       << std::endl;
+  }
+  std::vector<std::unique_ptr<Worker> > workers;
+  std::vector<std::vector<Command*> > jobs(n);
+  for (unsigned i = 0; i < n; ++i)
+  {
+    workers.emplace_back(new Worker());
+    Worker& w = *workers.back();
+    w.d_solver.reset(new api::Solver(&d_options));
+    configureWorker(w.d_solver.get(), i, preset);
+    ExprManager* em = w.d_solver->getExprManager();
+    if (d_exchange != nullptr && i >= firstSharing)
+    {
+      std::vector<Expr> exported;
+      for (const Expr& a : atoms)
+      {
+        exported.push_back(a.exportTo(em, w.d_vmap));
+      }
+      w.d_solver->getSmtEngine()->setClauseSharing(
+          d_exchange->getEndpoint(i - firstSharing), exported);
+    }
+    for (const std::unique_ptr<Command>& c : d_history)
+    {
+      w.d_commands.emplace_back(c->exportTo(em, w.d_vmap));
+    }
+    if (cubing)
+    {
+      for (const std::vector<Expr>& cube : cubes)
+      {
+        CheckSatAssumingCommand csa(cube);
+        jobs[i].push_back(csa.exportTo(em, w.d_vmap));
+      }
+    }
+    else
+    {
+      jobs[i].push_back(cmd->exportTo(em, w.d_vmap));
+    }
+  }
+
+  // Remote workers get the script in the binary language, followed by the
+  // cubes; they only ever refer to cubes by their index.
+  std::vector<std::unique_ptr<CubeConnection> > remotes;
+  std::string problem;
+  if (cubing && !d_options.getCubeWorkers().empty())
+  {
+    std::ostringstream out;
+    for (const std::unique_ptr<Command>& c : d_history)
+    {
+      c->toStream(out, -1, false, 1, language::output::LANG_BINARY);
+    }
+    for (const std::vector<Expr>& cube : cubes)
+    {
+      CheckSatAssumingCommand csa(cube);
+      csa.toStream(out, -1, false, 1, language::output::LANG_BINARY);
+    }
+    problem = out.str();
+    std::stringstream addresses(d_options.getCubeWorkers());
+    std::string address;
+    while (std::getline(addresses, address, ','))
+    {
+      try
+      {
+        remotes.push_back(CubeConnection::connect(address));
+      }
+      catch (const Exception& e)
+      {
+        Warning() << "portfolio: " << e.getMessage() << std::endl;
+      }
+    }
+    Trace("portfolio") << "portfolio: shipping " << problem.size()
+                       << " bytes to " << remotes.size() << " remote workers"
+                       << std::endl;
+  }
+  unsigned total = n + remotes.size();
+
+  std::mutex lock;
+  std::condition_variable finishedCond;
+  std::condition_variable jobCond;
+  std::vector<bool> finished(total, false);
+  std::vector<bool> status(total, false);
+  std::vector<Result> results(total);
+  std::vector<Command*> lastJob(total, nullptr);
+  std::vector<size_t> lastCube(total, 0);
+  unsigned numFinished = 0;
+  size_t nextCube = 0;
+  size_t numUnsatCubes = 0;
+  // The cubes given up by remote workers that were lost, which the other
+  // workers take before the untouched ones, and the number of cubes that are
+  // being solved.  Workers that run out of cubes wait for the ones being
+  // solved remotely, in case they are given up.
+  std::vector<size_t> givenUp;
+  size_t numSolving = 0;
+  int winner = -1;
+  bool stop = false;
+
+  // Take the next cube into job; returns false if there is none left.
+  auto takeCube = [&](size_t& job) {
+    std::unique_lock<std::mutex> guard(lock);
+    jobCond.wait(guard, [&]() {
+      return stop || !givenUp.empty() || nextCube < numJobs
+             || numSolving == 0;
+    });
+    if (stop)
+    {
+      return false;
+    }
+    if (!givenUp.empty())
+    {
+      job = givenUp.back();
+      givenUp.pop_back();
+    }
+    else if (nextCube < numJobs)
+    {
+      job = nextCube++;
+    }
+    else
+    {
+      return false;
+    }
+    ++numSolving;
+    return true;
+  };
+  // Record that job was solved, as unsat if unsat holds, by worker i.
+  auto solvedCube = [&](size_t job, unsigned i, bool unsat) {
+    std::lock_guard<std::mutex> guard(lock);
+    --numSolving;
+    lastCube[i] = job;
+    numUnsatCubes += unsat ? 1 : 0;
+    jobCond.notify_all();
+  };
+  // Record that whoever reaches this point has finished.
+  auto finish = [&](unsigned i, bool ok, const Result& r, Command* c) {
+    std::lock_guard<std::mutex> guard(lock);
+    finished[i] = true;
+    status[i] = ok;
+    results[i] = r;
+    lastJob[i] = c;
+    ++numFinished;
+    if (winner < 0 && ok && !r.isNull() && !r.isUnknown()
+        && (!cubing || r.isSat() == Result::SAT))
+    {
+      winner = i;
+    }
+    finishedCond.notify_all();
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned i = 0; i < n; ++i)
+  {
+    threads.emplace_back([&, i]() {
+      Worker& w = *workers[i];
+      SmtEngine* smt = w.d_solver->getSmtEngine();
+      bool ok = true;
+      for (size_t j = 0, nsetup = w.d_commands.size(); j < nsetup && ok; ++j)
+      {
+        ok = smtEngineInvoke(smt, w.d_commands[j].get(), nullptr);
+      }
+      Result r;
+      Command* c = nullptr;
+      size_t job = 0;
+      while (ok && (cubing ? takeCube(job) : c == nullptr))
+      {
+        c = jobs[i][job];
+        ok = smtEngineInvoke(smt, c, nullptr);
+        if (!cubing)
+        {
+          r = static_cast<CheckSatCommand*>(c)->getResult();
+          break;
+        }
+        r = static_cast<CheckSatAssumingCommand*>(c)->getResult();
+        bool unsat = ok && r.isSat() == Result::UNSAT;
+        solvedCube(job, i, unsat);
+        if (!unsat)
+        {
+          break;
+        }
+      }
+      finish(i, ok, r, c);
+    });
+  }
+  for (unsigned i = n; i < total; ++i)
+  {
+    threads.emplace_back([&, i]() {
+      CubeConnection& conn = *remotes[i - n];
+      bool ok = true;
+      Result r;
+      size_t job = 0;
+      bool solving = false;
+      try
+      {
+        conn.send(problem);
+        while (takeCube(job))
+        {
+          solving = true;
+          conn.send("solve " + std::to_string(job));
+          std::string answer;
+          if (!conn.receive(answer))
+          {
+            throw Exception("lost the cube worker "
+                            + std::to_string(i - n));
+          }
+          solving = false;
+          r = answer == "sat"
+                  ? Result(Result::SAT)
+                  : answer == "unsat"
+                        ? Result(Result::UNSAT)
+                        : Result(Result::SAT_UNKNOWN, Result::UNKNOWN_REASON);
+          bool unsat = r.isSat() == Result::UNSAT;
+          solvedCube(job, i, unsat);
+          if (!unsat)
+          {
+            break;
+          }
+        }
+      }
+      catch (const Exception& e)
+      {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!stop)
+        {
+          Warning() << "portfolio: " << e.getMessage() << std::endl;
+        }
+        if (solving)
+        {
+          // another worker has to solve the cube
+          --numSolving;
+          givenUp.push_back(job);
+          jobCond.notify_all();
+        }
+        ok = false;
+      }
+      finish(i, ok, r, nullptr);
+    });
+  }
+
+  {
+    std::unique_lock<std::mutex> guard(lock);
+    finishedCond.wait(guard,
+                      [&]() { return winner >= 0 || numFinished == total; });
+    stop = true;
+    jobCond.notify_all();
+    // The workers may still be running their setup commands, so they are
+    // cancelled through their resource manager, which is safe to do from
+    // this thread.  A cancellation is cleared at the end of each check, so
+    // keep on cancelling until everybody is done.
+    while (numFinished < total)
+    {
+      for (unsigned i = 0; i < total; ++i)
+      {
+        if (finished[i])
+        {
+          continue;
+        }
+        if (i < n)
+        {
+          workers[i]->d_solver->cancel();
+        }
+        else
+        {
+          remotes[i - n]->shutdown();
+        }
+      }
+      finishedCond.wait_for(guard, std::chrono::milliseconds(10));
+    }
+  }
+  for (std::thread& t : threads)
+  {
+    t.join();
+  }
+  // the exported jobs are owned by their worker from now on
+  for (unsigned i = 0; i < n; ++i)
+  {
+    for (Command* c : jobs[i])
+    {
+      workers[i]->d_commands.emplace_back(c);
+    }
+  }
+
+  unsigned w = winner >= 0 ? winner : 0;
+  if (!cubing || winner >= 0)
+  {
+    d_result = results[w];
+  }
+  else if (numUnsatCubes == cubes.size())
+  {
+    // the script is unsat iff all of its cubes are
+    d_result = Result(Result::UNSAT);
+  }
+  else
+  {
+    d_result = Result(Result::SAT_UNKNOWN, Result::UNKNOWN_REASON);
+  }
+  Trace("portfolio") << "portfolio: worker " << w << " of " << total
+                     << " answered "
+                     << d_result << std::endl;
+  bool ok = status[w] || d_result.asSatisfiabilityResult() == Result::UNSAT;
+  // Print the result as Command::invoke and smtEngineInvoke would have for
+  // cmd, i.e. not at all if it is muted and succeeded, and ignore the error
+  // if the command-verbosity of check-sat is 0.
+  uint32_t verbosity =
+      d_smtEngine->getOption("command-verbosity:" + cmd->getCommandName())
+          .getIntegerValue()
+          .toUnsignedInt();
+  if (d_options.getVerbosity() >= -1 && !(cmd->isMuted() && ok))
+  {
+    if (!ok && lastJob[w] != nullptr)
+    {
+      lastJob[w]->printResult(*d_options.getOut(), verbosity);
+    }
+    else
+    {
+      *d_options.getOut() << d_result << std::endl;
+    }
+  }
+  ok = ok || verbosity == 0;
+  if (w >= n)
+  {
+    // A remote worker won, follow-up commands are answered locally, by
+    // solving its cube again if they need a model.
+    size_t job = lastCube[w];
+    w = 0;
+    if (ok && d_options.getProduceModels())
+    {
+      // A cancellation that landed after the last check of the worker
+      // cancels the next one, so solve again if that happened.
+      CheckSatAssumingCommand* c =
+          static_cast<CheckSatAssumingCommand*>(jobs[w][job]);
+      SmtEngine* smt = workers[w]->d_solver->getSmtEngine();
+      ok = smtEngineInvoke(smt, c, nullptr);
+      if (ok && c->getResult().isUnknown()
+          && c->getResult().whyUnknown() == Result::INTERRUPTED)
+      {
+        ok = smtEngineInvoke(smt, c, nullptr);
+      }
+    }
+  }
+  d_winner = std::move(workers[w]);
+
+  if (ok && d_options.getDumpModels() && d_options.getProduceModels()
+      && d_result.asSatisfiabilityResult() == Result::SAT)
+  {
+    GetModelCommand gm;
+    ok = doCommandSingleton(&gm);
+  }
+  if (ok && !cubing && d_options.getDumpUnsatCores()
+      && d_result.asSatisfiabilityResult() == Result::UNSAT)
+  {
+    GetUnsatCoreCommand guc;
+    ok = doCommandSingleton(&guc);
+  }
+  return ok;
+}
+
+}  // namespace main
+}  // namespace CVC4
@@ -0,0 +1,106 @@
+/*********************                                                        */
+/*! \file command_executor_portfolio.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A command executor that races a portfolio of solvers.
+ **
+ ** A command executor that races a portfolio of differently configured
+ ** solvers on each check-sat of a non-incremental script.  Each worker has
+ ** its own ExprManager; commands are exported to it on the main thread
+ ** before the workers are started.  The first worker to answer sat or unsat
+ ** interrupts the others, and the remaining commands of the script (e.g.
+ ** get-model) are forwarded to it.
+ **
+ ** With --cube-depth=N, the workers instead share the configuration of the
+ ** user and solve the cubes computed by a CubeGenerator for the assertions
+ ** of the script, each taking the next unsolved cube when it is done.  With
+ ** --cube-workers, remote workers (see cube_rpc.h) take cubes from the same
+ ** queue, and the cubes of the remote workers that are lost are put back
+ ** into it.
+ **
+ ** When racing, the workers that preprocess the problem alike (all but the
+ ** first one if it runs a preset) share their short learned clauses through
+ ** a ClauseExchange, over the atoms of the Boolean structure of the
+ ** assertions.
+ **
+ ** With --auto-strategy, a StrategySelector picks the options of the workers
+ ** (of the first one when racing) from the features of the assertions.
+ **/
+
+#ifndef CVC4__MAIN__COMMAND_EXECUTOR_PORTFOLIO_H
+#define CVC4__MAIN__COMMAND_EXECUTOR_PORTFOLIO_H
+
+#include <memory>
+#include <vector>
+
+#include "main/clause_exchange.h"
+#include "main/command_executor.h"
+#include "smt/strategy_selector.h"
+
+namespace CVC4 {
+namespace main {
+
+class CommandExecutorPortfolio : public CommandExecutor
+{
+ public:
+  CommandExecutorPortfolio(Options& options);
+
+ protected:
+  bool doCommandSingleton(CVC4::Command* cmd) override;
+
+ private:
+  /**
+   * A portfolio worker: a solver and the commands exported to it.  The
+   * commands and map are declared after the solver so that they are
+   * destroyed before it.
+   */
+  struct Worker
+  {
+    std::unique_ptr<api::Solver> d_solver;
+    ExprManagerMapCollection d_vmap;
+    std::vector<std::unique_ptr<Command> > d_commands;
+  };
+
+  /**
+   * Race the configured number of workers on check-sat command cmd, or on
+   * its cubes in cube-and-conquer mode. Returns the command status of the
+   * winner.
+   */
+  bool raceCheckSat(CheckSatCommand* cmd);
+
+  /**
+   * Configure the solver of the i-th worker, which uses the options preset
+   * selected for the problem.
+   */
+  void configureWorker(
+      api::Solver* solver,
+      unsigned i,
+      const std::vector<std::pair<std::string, std::string> >& preset) const;
+
+  /** The strategy selector of --auto-strategy, if any. */
+  std::unique_ptr<StrategySelector> d_selector;
+
+  /** The commands executed so far, replayed into each worker. */
+  std::vector<std::unique_ptr<Command> > d_history;
+
+  /**
+   * The clause exchange of the last race, if any, which the winner keeps on
+   * using.  It is declared before the winner so that it outlives it.
+   */
+  std::unique_ptr<ClauseExchange> d_exchange;
+
+  /** The worker that won the last race, if any. */
+  std::unique_ptr<Worker> d_winner;
+}; /* class CommandExecutorPortfolio */
+
+}  // namespace main
+}  // namespace CVC4
+
+#endif /* CVC4__MAIN__COMMAND_EXECUTOR_PORTFOLIO_H */
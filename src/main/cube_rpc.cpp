@@ -0,0 +1,314 @@
+/*********************                                                        */
+/*! \file cube_rpc.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The connections between a cube-and-conquer coordinator and its
+ ** remote workers.
+ **/
+
+#include "main/cube_rpc.h"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "base/exception.h"
+#include "base/output.h"
+#include "main/command_executor.h"
+#include "parser/parser.h"
+#include "parser/parser_builder.h"
+#include "parser/parser_exception.h"
+#include "smt/command.h"
+
+namespace CVC4 {
+namespace main {
+
+CubeConnection::CubeConnection(int fd) : d_fd(fd) {}
+
+CubeConnection::~CubeConnection() { close(d_fd); }
+
+std::unique_ptr<CubeConnection> CubeConnection::connect(
+    const std::string& address)
+{
+  size_t colon = address.rfind(':');
+  if (colon == std::string::npos || colon + 1 == address.size())
+  {
+    throw Exception("expected a cube worker of the form HOST:PORT, got "
+                    + address);
+  }
+  std::string host = address.substr(0, colon);
+  std::string port = address.substr(colon + 1);
+
+  addrinfo hints;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* addrs = nullptr;
+  int err = getaddrinfo(host.c_str(), port.c_str(), &hints, &addrs);
+  if (err != 0)
+  {
+    throw Exception("cannot resolve cube worker " + address + ": "
+                    + gai_strerror(err));
+  }
+  int fd = -1;
+  for (addrinfo* a = addrs; a != nullptr && fd < 0; a = a->ai_next)
+  {
+    fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+    if (fd >= 0 && ::connect(fd, a->ai_addr, a->ai_addrlen) != 0)
+    {
+      err = errno;
+      close(fd);
+      fd = -1;
+    }
+  }
+  freeaddrinfo(addrs);
+  if (fd < 0)
+  {
+    throw Exception("cannot connect to cube worker " + address + ": "
+                    + strerror(err));
+  }
+  return std::unique_ptr<CubeConnection>(new CubeConnection(fd));
+}
+
+void CubeConnection::send(const std::string& msg)
+{
+  if (msg.size() > s_maxMessageSize)
+  {
+    throw Exception("the cube message of " + std::to_string(msg.size())
+                    + " bytes exceeds the limit of "
+                    + std::to_string(s_maxMessageSize) + " bytes");
+  }
+  std::string data = std::to_string(msg.size()) + "\n" + msg;
+  for (size_t sent = 0; sent < data.size();)
+  {
+    ssize_t n =
+        ::send(d_fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (n <= 0)
+    {
+      throw Exception(std::string("lost the cube connection: ")
+                      + strerror(errno));
+    }
+    sent += n;
+  }
+}
+
+bool CubeConnection::readFully(char* buf, size_t n)
+{
+  while (n > 0)
+  {
+    ssize_t r = ::recv(d_fd, buf, n, 0);
+    if (r < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (r <= 0)
+    {
+      return false;
+    }
+    buf += r;
+    n -= r;
+  }
+  return true;
+}
+
+bool CubeConnection::receive(std::string& msg)
+{
+  size_t size = 0;
+  char c;
+  do
+  {
+    if (!readFully(&c, 1))
+    {
+      return false;
+    }
+    if (c != '\n')
+    {
+      // the bound also rules out an overflow of size
+      if (c < '0' || c > '9' || size > (s_maxMessageSize - (c - '0')) / 10)
+      {
+        Trace("portfolio") << "cube connection: bad frame header" << std::endl;
+        shutdown();
+        return false;
+      }
+      size = 10 * size + (c - '0');
+    }
+  } while (c != '\n');
+  msg.resize(size);
+  return size == 0 || readFully(&msg[0], size);
+}
+
+bool CubeConnection::poll(int ms)
+{
+  pollfd p;
+  p.fd = d_fd;
+  p.events = POLLIN;
+  p.revents = 0;
+  return ::poll(&p, 1, ms) > 0;
+}
+
+void CubeConnection::shutdown() { ::shutdown(d_fd, SHUT_RDWR); }
+
+namespace {
+
+/**
+ * Answer the requests of the coordinator on connection conn, with the solver
+ * of executor.
+ */
+void serveConnection(CommandExecutor* executor,
+                     Options& opts,
+                     CubeConnection& conn)
+{
+  SmtEngine* smt = executor->getSmtEngine();
+  smt->setOption("incremental", SExpr(true));
+
+  std::string problem;
+  if (!conn.receive(problem))
+  {
+    return;
+  }
+  parser::ParserBuilder parserBuilder(
+      executor->getSolver(), "<cube-problem>", opts);
+  parserBuilder.withInputLanguage(language::input::LANG_BINARY)
+      .withStringInput(problem);
+  std::unique_ptr<parser::Parser> parser(parserBuilder.build());
+  std::vector<std::unique_ptr<Command> > cubes;
+  Command* cmd;
+  while ((cmd = parser->nextCommand()) != nullptr)
+  {
+    if (dynamic_cast<CheckSatAssumingCommand*>(cmd) != nullptr)
+    {
+      cubes.emplace_back(cmd);
+      continue;
+    }
+    bool ok = smtEngineInvoke(smt, cmd, nullptr);
+    delete cmd;
+    if (!ok)
+    {
+      throw Exception("the problem of the coordinator failed");
+    }
+  }
+  Trace("portfolio") << "cube server: received " << cubes.size() << " cubes"
+                     << std::endl;
+
+  std::string request;
+  while (conn.receive(request))
+  {
+    std::istringstream in(request);
+    std::string verb;
+    size_t i = 0;
+    if (!(in >> verb >> i) || verb != "solve" || i >= cubes.size())
+    {
+      throw Exception("unexpected request from the coordinator: " + request);
+    }
+    CheckSatAssumingCommand* c =
+        static_cast<CheckSatAssumingCommand*>(cubes[i].get());
+    // Solve on another thread, so that the coordinator hanging up (because
+    // another worker answered) interrupts the search.
+    std::atomic<bool> done(false);
+    bool ok = false;
+    std::thread solver([&]() {
+      ok = smtEngineInvoke(smt, c, nullptr);
+      done = true;
+    });
+    while (!done)
+    {
+      if (conn.poll(10))
+      {
+        smt->interrupt();
+      }
+    }
+    solver.join();
+    Result r = c->getResult();
+    std::string answer = "unknown";
+    if (ok && r.isSat() == Result::SAT)
+    {
+      answer = "sat";
+    }
+    else if (ok && r.isSat() == Result::UNSAT)
+    {
+      answer = "unsat";
+    }
+    Trace("portfolio") << "cube server: cube " << i << " is " << answer
+                       << std::endl;
+    conn.send(answer);
+  }
+}
+
+}  // namespace
+
+void serveCubes(CommandExecutor* executor, Options& opts, unsigned port)
+{
+  int lfd = socket(AF_INET, SOCK_STREAM, 0);
+  int one = 1;
+  sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port);
+  if (lfd < 0
+      || setsockopt(lfd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) != 0
+      || bind(lfd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0
+      || listen(lfd, 1) != 0)
+  {
+    std::string reason = strerror(errno);
+    if (lfd >= 0)
+    {
+      close(lfd);
+    }
+    throw Exception("--cube-server cannot listen on port "
+                    + std::to_string(port) + ": " + reason);
+  }
+  for (;;)
+  {
+    int fd = accept(lfd, nullptr, nullptr);
+    if (fd < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      std::string reason = strerror(errno);
+      close(lfd);
+      throw Exception("--cube-server cannot accept a coordinator: " + reason);
+    }
+    CubeConnection conn(fd);
+    try
+    {
+      serveConnection(executor, opts, conn);
+    }
+    catch (const parser::ParserException& e)
+    {
+      Warning() << "cube server: cannot parse the problem: " << e.getMessage()
+                << std::endl;
+    }
+    catch (const Exception& e)
+    {
+      Warning() << "cube server: " << e.getMessage() << std::endl;
+    }
+    executor->getSmtEngine()->reset();
+  }
+}
+
+}  // namespace main
+}  // namespace CVC4
@@ -0,0 +1,110 @@
+/*********************                                                        */
+/*! \file cube_rpc.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The connections between a cube-and-conquer coordinator and its
+ ** remote workers.
+ **
+ ** A coordinator (--cube-depth with --cube-workers) ships its problem to
+ ** workers started with --cube-server=PORT, over TCP.  Each message is framed
+ ** by a line with its size in bytes, as the requests of --server, of at most
+ ** CubeConnection::s_maxMessageSize bytes.  The protocol is:
+ **
+ ** - the coordinator sends the problem, the script of its commands in the
+ **   binary language followed by one check-sat-assuming per cube;
+ ** - it then sends requests "solve <i>", one at a time, and the worker
+ **   answers each by "sat", "unsat" or "unknown" for the i-th cube;
+ ** - it closes the connection when it is done, which interrupts the cube
+ **   the worker is solving, if any.
+ **/
+
+#ifndef CVC4__MAIN__CUBE_RPC_H
+#define CVC4__MAIN__CUBE_RPC_H
+
+#include <memory>
+#include <string>
+
+#include "options/options.h"
+
+namespace CVC4 {
+namespace main {
+
+class CommandExecutor;
+
+/** A connection between a coordinator and a remote cube worker. */
+class CubeConnection
+{
+ public:
+  /**
+   * The largest message, in bytes. A peer announcing a larger one is
+   * disconnected.
+   */
+  static const size_t s_maxMessageSize = size_t(1) << 30;
+
+  /** Take ownership of the connected socket fd. */
+  explicit CubeConnection(int fd);
+  ~CubeConnection();
+
+  /**
+   * Connect to the worker at address, of the form HOST:PORT.
+   *
+   * @throws Exception if the connection cannot be established
+   */
+  static std::unique_ptr<CubeConnection> connect(const std::string& address);
+
+  /**
+   * Send message msg.
+   *
+   * @throws Exception if the connection is broken or msg is larger than
+   * s_maxMessageSize
+   */
+  void send(const std::string& msg);
+
+  /**
+   * Receive the next message into msg. Returns false if the connection was
+   * closed (or shut down) instead. A malformed or oversized frame shuts the
+   * connection down and returns false as well.
+   */
+  bool receive(std::string& msg);
+
+  /**
+   * Wait for at most ms milliseconds for the peer to send data or to hang up,
+   * and return true if it did.
+   */
+  bool poll(int ms);
+
+  /**
+   * Shut the connection down, so that pending and later calls to receive()
+   * return false. This can be called from another thread than the one using
+   * the connection.
+   */
+  void shutdown();
+
+ private:
+  /** Read exactly n bytes into buf; returns false at the end of the input. */
+  bool readFully(char* buf, size_t n);
+
+  /** The socket */
+  int d_fd;
+}; /* class CubeConnection */
+
+/**
+ * Serve the coordinators connecting on port, one after the other, with the
+ * solver of executor, until the process is killed. The solver is reset to
+ * the command-line options, in incremental mode, for each coordinator.
+ *
+ * @throws Exception if port cannot be listened on
+ */
+void serveCubes(CommandExecutor* executor, Options& opts, unsigned port);
+
+}  // namespace main
+}  // namespace CVC4
+
+#endif /* CVC4__MAIN__CUBE_RPC_H */
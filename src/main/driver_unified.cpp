@@ -21,6 +21,7 @@
 #include <iostream>
 #include <memory>
 #include <new>
+#include <sstream>
 
 #include "cvc4autoconfig.h"
 
@@ -30,6 +31,8 @@
 #include "expr/expr_iomanip.h"
 #include "expr/expr_manager.h"
 #include "main/command_executor.h"
+#include "main/command_executor_portfolio.h"
+#include "main/cube_rpc.h"
 #include "main/interactive_shell.h"
 #include "main/main.h"
 #include "options/options.h"
@@ -38,6 +41,7 @@
 #include "parser/parser_builder.h"
 #include "parser/parser_exception.h"
 #include "smt/command.h"
+#include "util/phase_profiler.h"
 #include "util/result.h"
 #include "util/statistics_registry.h"
 
@@ -160,6 +164,13 @@ int runCvc4(int argc, char* argv[], Options& opts) {
         opts.setInputLanguage(language::input::LANG_SYGUS);
         //since there is no sygus output language, set this to SMT lib 2
         //opts.setOutputLanguage(language::output::LANG_SMTLIB_V2_0);
+      } else if(len >= 6 && !strcmp(".cvc4b", filename + len - 6)) {
+        opts.setInputLanguage(language::input::LANG_BINARY);
+      } else if((len >= 4 && !strcmp(".cnf", filename + len - 4))
+                || (len >= 7 && !strcmp(".dimacs", filename + len - 7))) {
+        opts.setInputLanguage(language::input::LANG_DIMACS);
+      } else if(len >= 4 && !strcmp(".opb", filename + len - 4)) {
+        opts.setInputLanguage(language::input::LANG_OPB);
       }
     }
   }
@@ -182,7 +193,15 @@ int runCvc4(int argc, char* argv[], Options& opts) {
   (*(opts.getOut())) << language::SetLanguage(opts.getOutputLanguage());
 
   // Create the command executor to execute the parsed commands
-  pExecutor = new CommandExecutor(opts);
+  if (opts.getThreads() > 1 || opts.getCubeDepth() > 0
+      || opts.getAutoStrategy())
+  {
+    pExecutor = new CommandExecutorPortfolio(opts);
+  }
+  else
+  {
+    pExecutor = new CommandExecutor(opts);
+  }
 
   std::unique_ptr<Parser> replayParser;
   if (opts.getReplayInputFilename() != "")
@@ -214,10 +233,76 @@ int runCvc4(int argc, char* argv[], Options& opts) {
     // set filename in smt engine
     pExecutor->getSmtEngine()->setFilename(filenameStr);
 
+    if (!opts.getProfilePhases().empty())
+    {
+      PhaseProfiler::start(opts.getProfilePhases(),
+                           opts.getProfilePhasesInterval());
+    }
+
     // Parse and execute commands until we are done
     Command* cmd;
     bool status = true;
-    if(opts.getInteractive() && inputFromStdin) {
+    if (opts.getCubeServer() > 0)
+    {
+      serveCubes(pExecutor, opts, opts.getCubeServer());
+    }
+    else if (opts.getServer())
+    {
+      if (!inputFromStdin)
+      {
+        throw OptionException("--server reads its requests from stdin");
+      }
+      /* Each request is a line with the size of the request in bytes,
+       * followed by the request, and its response is followed by a line
+       * "(done)". The requests share the ExprManager, hence the builtin
+       * nodes and the rewriter tables, and each one is answered by an
+       * SmtEngine reset to the command-line options. */
+      std::string header;
+      while (std::getline(cin, header))
+      {
+        if (header.empty())
+        {
+          continue;
+        }
+        size_t size = 0;
+        std::istringstream sizeStream(header);
+        if (!(sizeStream >> size))
+        {
+          throw OptionException("--server expected the size of a request, got "
+                                + header);
+        }
+        std::string request(size, '\0');
+        cin.read(&request[0], size);
+        request.resize(cin.gcount());
+        try
+        {
+          ParserBuilder parserBuilder(
+              pExecutor->getSolver(), "<request>", opts);
+          parserBuilder.withStringInput(request);
+          std::unique_ptr<Parser> parser(parserBuilder.build());
+          while ((cmd = parser->nextCommand()) != nullptr)
+          {
+            bool quit = dynamic_cast<QuitCommand*>(cmd) != nullptr;
+            status = pExecutor->doCommand(cmd) && status;
+            delete cmd;
+            if (quit)
+            {
+              break;
+            }
+          }
+        }
+        catch (const ParserException& e)
+        {
+          (*opts.getOut()) << "(error \"" << e.getMessage() << "\")"
+                           << std::endl;
+          status = false;
+        }
+        pExecutor->getSmtEngine()->reset();
+        (*opts.getOut()) << "(done)" << std::endl;
+      }
+    }
+    else if (opts.getInteractive() && inputFromStdin)
+    {
       if(opts.getTearDownIncremental() > 0) {
         throw OptionException(
             "--tear-down-incremental doesn't work in interactive mode");
@@ -509,6 +594,7 @@ int runCvc4(int argc, char* argv[], Options& opts) {
                                        &s_statSatResult);
 
     pTotalTime->stop();
+    PhaseProfiler::stop();
 
     // Tim: I think that following comment is out of date?
     // Set the global executor pointer to NULL first.  If we get a
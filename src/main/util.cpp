@@ -38,6 +38,7 @@
 #include "main/main.h"
 #include "options/options.h"
 #include "smt/smt_engine.h"
+#include "util/phase_profiler.h"
 #include "util/safe_print.h"
 #include "util/statistics.h"
 
@@ -55,6 +56,8 @@ namespace main {
 bool segvSpin = false;
 
 void print_statistics() {
+  // the samples of --profile-phases are written even without statistics
+  PhaseProfiler::flush();
   if (pOptions != NULL && pOptions->getStatistics() && pExecutor != NULL) {
     if (pTotalTime != NULL && pTotalTime->running()) {
       pTotalTime->stop();
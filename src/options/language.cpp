@@ -89,6 +89,7 @@ InputLanguage toInputLanguage(OutputLanguage language) {
   case output::LANG_Z3STR:
   case output::LANG_SYGUS:
   case output::LANG_SYGUS_V2:
+  case output::LANG_BINARY:
     // these entries directly correspond (by design)
     return InputLanguage(int(language));
 
@@ -115,6 +116,12 @@ OutputLanguage toOutputLanguage(InputLanguage language) {
     // these entries directly correspond (by design)
     return OutputLanguage(int(language));
 
+  case input::LANG_BINARY:
+  case input::LANG_DIMACS:
+  case input::LANG_OPB:
+    // binary and SAT inputs are prebuilt problems, respond in SMT-LIB
+    return output::LANG_SMTLIB_V2_6;
+
   default:
     // Revert to the default (AST) language.
     //
@@ -169,6 +176,10 @@ OutputLanguage toOutputLanguage(std::string language) {
   {
     return output::LANG_SYGUS_V2;
   }
+  else if (language == "binary" || language == "LANG_BINARY")
+  {
+    return output::LANG_BINARY;
+  }
   else if (language == "ast" || language == "LANG_AST")
   {
     return output::LANG_AST;
@@ -214,6 +225,19 @@ InputLanguage toInputLanguage(std::string language) {
   {
     return input::LANG_SYGUS_V2;
   }
+  else if (language == "binary" || language == "LANG_BINARY")
+  {
+    return input::LANG_BINARY;
+  }
+  else if (language == "dimacs" || language == "cnf"
+           || language == "LANG_DIMACS")
+  {
+    return input::LANG_DIMACS;
+  }
+  else if (language == "opb" || language == "LANG_OPB")
+  {
+    return input::LANG_OPB;
+  }
   else if (language == "auto" || language == "LANG_AUTO")
   {
     return input::LANG_AUTO;
@@ -64,9 +64,16 @@ enum CVC4_PUBLIC Language
   LANG_SYGUS,
   /** The SyGuS input language version 2.0 */
   LANG_SYGUS_V2,
+  /** The binary format for DAG-shared terms and commands */
+  LANG_BINARY,
 
-  // START OUTPUT-ONLY LANGUAGES AT ENUM VALUE 10
-  // THESE ARE IN PRINCIPLE NOT POSSIBLE INPUT LANGUAGES
+  // START INPUT-ONLY LANGUAGES AT ENUM VALUE 10
+  // THESE ARE IN PRINCIPLE NOT POSSIBLE OUTPUT LANGUAGES
+
+  /** The DIMACS CNF input language */
+  LANG_DIMACS = 10,
+  /** The OPB pseudo-Boolean input language */
+  LANG_OPB,
 
   /** LANG_MAX is > any valid InputLanguage id */
   LANG_MAX
@@ -101,6 +108,9 @@ inline std::ostream& operator<<(std::ostream& out, Language lang) {
     out << "LANG_SYGUS";
     break;
   case LANG_SYGUS_V2: out << "LANG_SYGUS_V2"; break;
+  case LANG_BINARY: out << "LANG_BINARY"; break;
+  case LANG_DIMACS: out << "LANG_DIMACS"; break;
+  case LANG_OPB: out << "LANG_OPB"; break;
   default:
     out << "undefined_input_language";
   }
@@ -145,6 +155,8 @@ enum CVC4_PUBLIC Language
   LANG_SYGUS = input::LANG_SYGUS,
   /** The sygus output language version 2.0 */
   LANG_SYGUS_V2 = input::LANG_SYGUS_V2,
+  /** The binary format for DAG-shared terms and commands */
+  LANG_BINARY = input::LANG_BINARY,
 
   // START OUTPUT-ONLY LANGUAGES AT ENUM VALUE 10
   // THESE ARE IN PRINCIPLE NOT POSSIBLE INPUT LANGUAGES
@@ -182,6 +194,7 @@ inline std::ostream& operator<<(std::ostream& out, Language lang) {
     out << "LANG_SYGUS";
     break;
   case LANG_SYGUS_V2: out << "LANG_SYGUS_V2"; break;
+  case LANG_BINARY: out << "LANG_BINARY"; break;
   case LANG_AST:
     out << "LANG_AST";
     break;
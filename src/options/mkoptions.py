@@ -105,9 +105,11 @@ TPL_DECL_ASSIGN = \
 TPL_IMPL_ASSIGN = TPL_DECL_ASSIGN[:-1] + \
 """
 {{
-  d_holder->{name} =
+  options::{name}__option_t::type v =
     runHandlerAndPredicates(options::{name}, option, value, d_handler);
-  d_holder->{name}__setByUser__ = true;
+  options::OptionsHolder* holder = writableHolder();
+  holder->{name} = v;
+  holder->{name}__setByUser__ = true;
   Trace("options") << "user assigned option {name}" << std::endl;
   {notifications}
 }}"""
@@ -133,8 +135,9 @@ TPL_IMPL_ASSIGN_BOOL = TPL_DECL_ASSIGN_BOOL[:-1] + \
 """
 {{
   runBoolPredicates(options::{name}, option, value, d_handler);
-  d_holder->{name} = value;
-  d_holder->{name}__setByUser__ = true;
+  options::OptionsHolder* holder = writableHolder();
+  holder->{name} = value;
+  holder->{name}__setByUser__ = true;
   Trace("options") << "user assigned option {name}" << std::endl;
   {notifications}
 }}"""
@@ -183,7 +186,7 @@ TPL_DECL_SET = \
 TPL_IMPL_SET = TPL_DECL_SET[:-1] + \
 """
 {{
-  d_holder->{name} = x;
+  writableHolder()->{name} = x;
 }}"""
 
 
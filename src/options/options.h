@@ -19,7 +19,9 @@
 #ifndef CVC4__OPTIONS__OPTIONS_H
 #define CVC4__OPTIONS__OPTIONS_H
 
+#include <cstdint>
 #include <fstream>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -43,8 +45,22 @@ namespace options {
 
 class CVC4_PUBLIC Options {
   friend api::Solver;
-  /** The struct that holds all option values. */
-  options::OptionsHolder* d_holder;
+  /**
+   * The struct that holds all option values. It is shared with the copies of
+   * these options until either of them writes an option value, so that
+   * copying options is cheap.
+   */
+  std::shared_ptr<options::OptionsHolder> d_holder;
+
+  /**
+   * Returns the holder of the option values, after making a private copy of
+   * it if it is shared with other options. Writes must go through this
+   * method, reads use d_holder directly.
+   */
+  options::OptionsHolder* writableHolder();
+
+  /** The number of writes to the option values, see getValuesVersion(). */
+  uint64_t d_valuesVersion;
 
   /** The handler for the options of the theory. */
   options::OptionsHandler* d_handler;
@@ -157,11 +173,19 @@ public:
 
   /**
    * Copies the value of the options stored in OptionsHolder into the current
-   * Options object.
+   * Options object. The values are shared until either object writes an
+   * option value.
    * This does not copy the listeners in the Options object.
    */
   void copyValues(const Options& options);
 
+  /**
+   * Returns a number that changes whenever an option value may have changed,
+   * so that values derived from the options can be recomputed only when
+   * needed.
+   */
+  uint64_t getValuesVersion() const { return d_valuesVersion; }
+
   /**
    * Set the value of the given option.  Use of this default
    * implementation causes a compile-time error; write-able
@@ -211,18 +235,28 @@ public:
   bool getIncrementalSolving() const;
   bool getInteractive() const;
   bool getInteractivePrompt() const;
+  bool getFastParse() const;
   bool getLanguageHelp() const;
   bool getMemoryMap() const;
   bool getParseOnly() const;
   bool getProduceModels() const;
   bool getProof() const;
+  const std::string& getProfilePhases() const;
+  unsigned getProfilePhasesInterval() const;
   bool getSegvSpin() const;
+  bool getServer() const;
   bool getSemanticChecks() const;
   bool getStatistics() const;
   bool getStatsEveryQuery() const;
   bool getStatsHideZeros() const;
   bool getStrictParsing() const;
   int getTearDownIncremental() const;
+  unsigned getThreads() const;
+  unsigned getCubeDepth() const;
+  const std::string& getCubeWorkers() const;
+  unsigned getCubeServer() const;
+  bool getAutoStrategy() const;
+  const std::string& getStrategyTable() const;
   bool getVersion() const;
   const std::string& getForceLogicString() const;
   int getVerbosity() const;
@@ -245,6 +279,7 @@ public:
   bool wasSetByUserForceLogicString() const;
   bool wasSetByUserIncrementalSolving() const;
   bool wasSetByUserInteractive() const;
+  bool wasSetByUserSatSolver() const;
 
   // Static accessor functions.
   // TODO: Document these.
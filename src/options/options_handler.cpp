@@ -145,6 +145,21 @@ void OptionsHandler::abcEnabledBuild(std::string option, std::string value)
 #endif /* CVC4_USE_ABC */
 }
 
+void OptionsHandler::checkPropSatSolver(std::string option,
+                                        PropSatSolverMode m)
+{
+  if (m == PropSatSolverMode::CADICAL
+      && !Configuration::isBuiltWithCadicalPropagator())
+  {
+    std::stringstream ss;
+    ss << "option `" << option
+       << "' requires a build of CVC4 with CaDiCaL 1.9 or later; this binary "
+          "was not built with a CaDiCaL that provides the external propagator "
+          "interface";
+    throw OptionException(ss.str());
+  }
+}
+
 void OptionsHandler::checkBvSatSolver(std::string option, SatSolverMode m)
 {
   if (m == SatSolverMode::CRYPTOMINISAT
@@ -194,7 +209,7 @@ void OptionsHandler::checkBitblastMode(std::string option, BitblastMode m)
     }
     if (!options::bitvectorEqualitySlicer.wasSetByUser())
     {
-      if (options::incrementalSolving() || options::produceModels())
+      if (options::produceModels())
       {
         options::bitvectorEqualitySlicer.set(options::BvSlicerMode::OFF);
       }
@@ -472,6 +487,8 @@ void OptionsHandler::showConfiguration(std::string option) {
   print_config_cond("cln", Configuration::isBuiltWithCln());
   print_config_cond("glpk", Configuration::isBuiltWithGlpk());
   print_config_cond("cadical", Configuration::isBuiltWithCadical());
+  print_config_cond("cadical-propagator",
+                    Configuration::isBuiltWithCadicalPropagator());
   print_config_cond("cryptominisat", Configuration::isBuiltWithCryptominisat());
   print_config_cond("drat2er", Configuration::isBuiltWithDrat2Er());
   print_config_cond("gmp", Configuration::isBuiltWithGmp());
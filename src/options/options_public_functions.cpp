@@ -32,6 +32,7 @@
 #include "options/parser_options.h"
 #include "options/printer_modes.h"
 #include "options/printer_options.h"
+#include "options/prop_options.h"
 #include "options/quantifiers_options.h"
 #include "options/smt_options.h"
 #include "options/uf_options.h"
@@ -106,6 +107,10 @@ bool Options::getInteractivePrompt() const{
   return (*this)[options::interactivePrompt];
 }
 
+bool Options::getFastParse() const{
+  return (*this)[options::fastParse];
+}
+
 bool Options::getLanguageHelp() const{
   return (*this)[options::languageHelp];
 }
@@ -126,6 +131,18 @@ bool Options::getProof() const{
   return (*this)[options::proof];
 }
 
+const std::string& Options::getProfilePhases() const{
+  return (*this)[options::profilePhases];
+}
+
+unsigned Options::getProfilePhasesInterval() const{
+  return (*this)[options::profilePhasesInterval];
+}
+
+bool Options::getServer() const{
+  return (*this)[options::server];
+}
+
 bool Options::getSegvSpin() const{
   return (*this)[options::segvSpin];
 }
@@ -154,6 +171,30 @@ int Options::getTearDownIncremental() const{
   return (*this)[options::tearDownIncremental];
 }
 
+unsigned Options::getThreads() const { return (*this)[options::threads]; }
+
+unsigned Options::getCubeDepth() const { return (*this)[options::cubeDepth]; }
+
+const std::string& Options::getCubeWorkers() const
+{
+  return (*this)[options::cubeWorkers];
+}
+
+unsigned Options::getCubeServer() const
+{
+  return (*this)[options::cubeServer];
+}
+
+bool Options::getAutoStrategy() const
+{
+  return (*this)[options::autoStrategy];
+}
+
+const std::string& Options::getStrategyTable() const
+{
+  return (*this)[options::strategyTable];
+}
+
 bool Options::getVersion() const{
   return (*this)[options::version];
 }
@@ -238,6 +279,10 @@ bool Options::wasSetByUserInteractive() const {
   return wasSetByUser(options::interactive);
 }
 
+bool Options::wasSetByUserSatSolver() const {
+  return wasSetByUser(options::satSolver);
+}
+
 
 void Options::flushErr() {
   if(getErr() != NULL) {
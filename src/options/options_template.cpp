@@ -230,6 +230,7 @@ void runBoolPredicates(T, std::string option, bool b, options::OptionsHandler* h
 
 Options::Options()
     : d_holder(new options::OptionsHolder())
+    , d_valuesVersion(0)
     , d_handler(new options::OptionsHandler(this))
     , d_beforeSearchListeners()
     , d_tlimitListeners()
@@ -240,16 +241,25 @@ Options::Options()
 
 Options::~Options() {
   delete d_handler;
-  delete d_holder;
 }
 
 void Options::copyValues(const Options& options){
   if(this != &options) {
-    delete d_holder;
-    d_holder = new options::OptionsHolder(*options.d_holder);
+    d_holder = options.d_holder;
+    ++d_valuesVersion;
   }
 }
 
+options::OptionsHolder* Options::writableHolder()
+{
+  ++d_valuesVersion;
+  if (d_holder.use_count() > 1)
+  {
+    d_holder = std::make_shared<options::OptionsHolder>(*d_holder);
+  }
+  return d_holder.get();
+}
+
 std::string Options::formatThreadOptionException(const std::string& option) {
   std::stringstream ss;
   ss << "can't understand option `" << option
@@ -439,6 +449,9 @@ Languages currently supported as arguments to the -L / --lang option:\n\
   smt2.6.1 | smtlib2.6.1         SMT-LIB format 2.6 with support for the strings standard\n\
   tptp                           TPTP format (cnf, fof and tff)\n\
   sygus | sygus2                 SyGuS version 1.0 and 2.0 formats\n\
+  binary                         CVC4 binary format, as written by --output-lang\n\
+  dimacs | cnf                   DIMACS CNF format, solved by the SAT solver\n\
+  opb                            OPB pseudo-Boolean format (decision problems)\n\
 \n\
 Languages currently supported as arguments to the --output-lang option:\n\
   auto                           match output language to input language\n\
@@ -451,6 +464,7 @@ Languages currently supported as arguments to the --output-lang option:\n\
   smt2.6.1 | smtlib2.6.1         SMT-LIB format 2.6 with support for the strings standard\n\
   tptp                           TPTP format\n\
   z3str                          SMT-LIB 2.0 with Z3-str string constraints\n\
+  binary                         CVC4 binary format (DAG-shared, for --dump)\n\
   ast                            internal format (simple syntax trees)\n\
 ";
 
@@ -580,7 +594,7 @@ std::vector<std::string> Options::parseOptions(Options* options,
   if(x != NULL) {
     progName = x + 1;
   }
-  options->d_holder->binary_name = std::string(progName);
+  options->writableHolder()->binary_name = std::string(progName);
 
   ArgumentExtender* argumentExtender = new ArgumentExtenderImplementation();
   for(int position = 1; position < argc; position++) {
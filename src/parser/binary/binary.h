@@ -0,0 +1,47 @@
+/*********************                                                        */
+/*! \file binary.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The parser class for the binary language.
+ **
+ ** The parser class for the binary language.  Binary inputs refer to terms
+ ** by their position in the stream rather than by name, so there is no
+ ** language-specific parser state; the tables live in the BinaryInput.
+ **/
+
+#include "cvc4parser_private.h"
+
+#ifndef CVC4__PARSER__BINARY_H
+#define CVC4__PARSER__BINARY_H
+
+#include "api/cvc4cpp.h"
+#include "parser/parser.h"
+
+namespace CVC4 {
+namespace parser {
+
+class Binary : public Parser
+{
+  friend class ParserBuilder;
+
+ protected:
+  Binary(api::Solver* solver,
+         Input* input,
+         bool strictMode = false,
+         bool parseOnly = false)
+      : Parser(solver, input, strictMode, parseOnly)
+  {
+  }
+};
+
+}  // namespace parser
+}  // namespace CVC4
+
+#endif /* CVC4__PARSER__BINARY_H */
@@ -0,0 +1,479 @@
+/*********************                                                        */
+/*! \file binary_input.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The input class for the binary language.
+ **/
+
+#include "parser/binary/binary_input.h"
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+#include "base/output.h"
+#include "expr/expr_manager.h"
+#include "parser/parser.h"
+#include "parser/parser_exception.h"
+#include "printer/binary/binary_format.h"
+#include "smt/command.h"
+#include "util/bitvector.h"
+#include "util/rational.h"
+
+namespace CVC4 {
+namespace parser {
+
+using namespace CVC4::binary;
+
+namespace {
+
+/** The contents of a binary input. */
+class BinaryInputStream : public InputStream
+{
+ public:
+  BinaryInputStream(const std::string& name, const std::string& bytes)
+      : InputStream(name), d_bytes(bytes)
+  {
+  }
+  std::string d_bytes;
+}; /* class BinaryInputStream */
+
+/**
+ * Get the kinds by the names written in the kind table. The map is built
+ * once, by the initialization of the static, so parsers may call this
+ * concurrently.
+ */
+const std::unordered_map<std::string, Kind>& getKindsByName()
+{
+  static const std::unordered_map<std::string, Kind> kinds = []() {
+    std::unordered_map<std::string, Kind> byName;
+    for (int k = kind::NULL_EXPR; k < kind::LAST_KIND; ++k)
+    {
+      byName[kind::kindToString(Kind(k))] = Kind(k);
+    }
+    return byName;
+  }();
+  return kinds;
+}
+
+}  // namespace
+
+BinaryInput::BinaryInput(const std::string& name, const std::string& bytes)
+    : Input(*new BinaryInputStream(name, bytes)),
+      d_bytes(static_cast<BinaryInputStream*>(getInputStream())->d_bytes),
+      d_pos(0),
+      d_em(nullptr),
+      d_seenHeader(false)
+{
+}
+
+BinaryInput::~BinaryInput() {}
+
+BinaryInput* BinaryInput::newFileInput(const std::string& filename)
+{
+  std::ifstream in(filename.c_str(), std::ios::binary);
+  if (!in)
+  {
+    throw InputStreamException("Couldn't open file: " + filename);
+  }
+  return newStreamInput(in, filename);
+}
+
+BinaryInput* BinaryInput::newStreamInput(std::istream& input,
+                                         const std::string& name)
+{
+  std::stringstream ss;
+  ss << input.rdbuf();
+  return new BinaryInput(name, ss.str());
+}
+
+void BinaryInput::setParser(Parser& parser)
+{
+  d_em = parser.getSolver()->getExprManager();
+}
+
+void BinaryInput::warning(const std::string& msg)
+{
+  Warning() << getInputStream()->getName() << ": byte " << d_pos
+            << ": warning: " << msg << std::endl;
+}
+
+void BinaryInput::parseError(const std::string& msg, bool eofException)
+{
+  std::stringstream ss;
+  ss << getInputStream()->getName() << ": byte " << d_pos << ": " << msg;
+  if (eofException)
+  {
+    throw ParserEndOfFileException(ss.str());
+  }
+  throw ParserException(ss.str());
+}
+
+char BinaryInput::readByte()
+{
+  if (d_pos == d_bytes.size())
+  {
+    parseError("unexpected end of input", true);
+  }
+  return d_bytes[d_pos++];
+}
+
+uint64_t BinaryInput::readUnsigned()
+{
+  uint64_t n = 0;
+  for (unsigned shift = 0;; shift += 7)
+  {
+    unsigned char b = static_cast<unsigned char>(readByte());
+    if (shift > 63)
+    {
+      parseError("number out of range");
+    }
+    n |= static_cast<uint64_t>(b & 0x7f) << shift;
+    if ((b & 0x80) == 0)
+    {
+      return n;
+    }
+  }
+}
+
+std::string BinaryInput::readString()
+{
+  uint64_t length = readUnsigned();
+  if (length > d_bytes.size() - d_pos)
+  {
+    parseError("unexpected end of input", true);
+  }
+  std::string s = d_bytes.substr(d_pos, length);
+  d_pos += length;
+  return s;
+}
+
+Kind BinaryInput::readKind()
+{
+  uint64_t id = readUnsigned();
+  if (id >= d_kinds.size())
+  {
+    parseError("undefined kind");
+  }
+  return d_kinds[id];
+}
+
+uint64_t BinaryInput::readTypeId()
+{
+  uint64_t id = readUnsigned();
+  if (id >= d_types.size())
+  {
+    parseError("undefined type");
+  }
+  return id;
+}
+
+uint64_t BinaryInput::readTermId()
+{
+  uint64_t id = readUnsigned();
+  if (id >= d_terms.size())
+  {
+    parseError("undefined term");
+  }
+  return id;
+}
+
+void BinaryInput::readHeader()
+{
+  size_t length = sizeof(s_magic) - 1;
+  if (d_bytes.size() - d_pos < length
+      || d_bytes.compare(d_pos, length, s_magic) != 0)
+  {
+    parseError("not a CVC4 binary input");
+  }
+  d_pos += length;
+  uint64_t version = readUnsigned();
+  if (version != s_version)
+  {
+    std::stringstream ss;
+    ss << "unsupported version " << version << " of the binary format";
+    parseError(ss.str());
+  }
+  d_seenHeader = true;
+  d_kinds.clear();
+  d_types.clear();
+  d_terms.clear();
+  d_typeNames.clear();
+  d_termNames.clear();
+}
+
+void BinaryInput::readTypeRecord()
+{
+  Kind k = readKind();
+  Type t;
+  std::string name;
+  switch (k)
+  {
+    case kind::TYPE_CONSTANT:
+    {
+      std::string c = readString();
+      if (c == "Bool")
+      {
+        t = d_em->booleanType();
+      }
+      else if (c == "Int")
+      {
+        t = d_em->integerType();
+      }
+      else if (c == "Real")
+      {
+        t = d_em->realType();
+      }
+      else if (c == "String")
+      {
+        t = d_em->stringType();
+      }
+      else if (c == "RegLan")
+      {
+        t = d_em->regExpType();
+      }
+      else if (c == "RoundingMode")
+      {
+        t = d_em->roundingModeType();
+      }
+      else
+      {
+        parseError("unknown type constant " + c);
+      }
+      break;
+    }
+    case kind::SORT_TYPE:
+      name = readString();
+      t = d_em->mkSort(name);
+      break;
+    case kind::BITVECTOR_TYPE: t = d_em->mkBitVectorType(readUnsigned()); break;
+    case kind::FLOATINGPOINT_TYPE:
+    {
+      unsigned exp = readUnsigned();
+      t = d_em->mkFloatingPointType(exp, readUnsigned());
+      break;
+    }
+    case kind::FUNCTION_TYPE:
+    case kind::ARRAY_TYPE:
+    {
+      std::vector<Type> children;
+      for (uint64_t i = 0, n = readUnsigned(); i < n; ++i)
+      {
+        children.push_back(d_types[readTypeId()]);
+      }
+      if (k == kind::ARRAY_TYPE && children.size() == 2)
+      {
+        t = d_em->mkArrayType(children[0], children[1]);
+      }
+      else if (k == kind::FUNCTION_TYPE && children.size() >= 2)
+      {
+        t = d_em->mkFunctionType(children);
+      }
+      else
+      {
+        parseError("wrong number of children for " + kind::kindToString(k));
+      }
+      break;
+    }
+    default: parseError("unsupported type kind " + kind::kindToString(k));
+  }
+  d_types.push_back(t);
+  d_typeNames.push_back(name);
+}
+
+void BinaryInput::readTermRecord()
+{
+  Kind k = readKind();
+  Expr e;
+  std::string name;
+  switch (k)
+  {
+    case kind::VARIABLE:
+    case kind::BOUND_VARIABLE:
+    case kind::SKOLEM:
+    {
+      Type t = d_types[readTypeId()];
+      name = readString();
+      // skolems come back as ordinary variables
+      e = k == kind::BOUND_VARIABLE ? d_em->mkBoundVar(name, t)
+                                    : d_em->mkVar(name, t);
+      break;
+    }
+    case kind::CONST_BOOLEAN: e = d_em->mkConst(readUnsigned() != 0); break;
+    case kind::CONST_RATIONAL: e = d_em->mkConst(Rational(readString())); break;
+    case kind::CONST_BITVECTOR:
+    {
+      unsigned size = readUnsigned();
+      e = d_em->mkConst(BitVector(size, Integer(readString())));
+      break;
+    }
+    case kind::BITVECTOR_EXTRACT_OP:
+    {
+      unsigned high = readUnsigned();
+      e = d_em->mkConst(BitVectorExtract(high, readUnsigned()));
+      break;
+    }
+    case kind::BITVECTOR_REPEAT_OP:
+      e = d_em->mkConst(BitVectorRepeat(readUnsigned()));
+      break;
+    case kind::BITVECTOR_ZERO_EXTEND_OP:
+      e = d_em->mkConst(BitVectorZeroExtend(readUnsigned()));
+      break;
+    case kind::BITVECTOR_SIGN_EXTEND_OP:
+      e = d_em->mkConst(BitVectorSignExtend(readUnsigned()));
+      break;
+    case kind::BITVECTOR_ROTATE_LEFT_OP:
+      e = d_em->mkConst(BitVectorRotateLeft(readUnsigned()));
+      break;
+    case kind::BITVECTOR_ROTATE_RIGHT_OP:
+      e = d_em->mkConst(BitVectorRotateRight(readUnsigned()));
+      break;
+    case kind::INT_TO_BITVECTOR_OP:
+      e = d_em->mkConst(IntToBitVector(readUnsigned()));
+      break;
+    case kind::BITVECTOR_BITOF_OP:
+      e = d_em->mkConst(BitVectorBitOf(readUnsigned()));
+      break;
+    default:
+    {
+      // the operator of a parameterized kind comes first, as mkExpr expects
+      std::vector<Expr> children;
+      for (uint64_t i = 0, n = readUnsigned(); i < n; ++i)
+      {
+        children.push_back(d_terms[readTermId()]);
+      }
+      e = d_em->mkExpr(k, children);
+      break;
+    }
+  }
+  d_terms.push_back(e);
+  d_termNames.push_back(name);
+}
+
+char BinaryInput::readTableRecords()
+{
+  for (;;)
+  {
+    if (d_pos == d_bytes.size())
+    {
+      return 0;
+    }
+    char tag = readByte();
+    if (tag == '\n')
+    {
+      continue;
+    }
+    if (!d_seenHeader && tag != TAG_HEADER)
+    {
+      parseError("not a CVC4 binary input");
+    }
+    switch (tag)
+    {
+      case TAG_HEADER: readHeader(); break;
+      case TAG_KIND:
+      {
+        std::string name = readString();
+        const std::unordered_map<std::string, Kind>& kinds = getKindsByName();
+        std::unordered_map<std::string, Kind>::const_iterator it =
+            kinds.find(name);
+        if (it == kinds.end())
+        {
+          parseError("unknown kind " + name);
+        }
+        d_kinds.push_back(it->second);
+        break;
+      }
+      case TAG_TYPE: readTypeRecord(); break;
+      case TAG_TERM: readTermRecord(); break;
+      default: return tag;
+    }
+  }
+}
+
+Command* BinaryInput::parseCommand()
+{
+  char tag = readTableRecords();
+  switch (tag)
+  {
+    case 0: return nullptr;
+    case TAG_SET_LOGIC: return new SetBenchmarkLogicCommand(readString());
+    case TAG_DECLARE_SORT:
+    {
+      uint64_t id = readTypeId();
+      return new DeclareTypeCommand(
+          d_typeNames[id], readUnsigned(), d_types[id]);
+    }
+    case TAG_DECLARE_FUN:
+    {
+      uint64_t id = readTermId();
+      return new DeclareFunctionCommand(
+          d_termNames[id], d_terms[id], d_terms[id].getType());
+    }
+    case TAG_DEFINE_FUN:
+    {
+      uint64_t id = readTermId();
+      std::vector<Expr> formals;
+      for (uint64_t i = 0, n = readUnsigned(); i < n; ++i)
+      {
+        formals.push_back(d_terms[readTermId()]);
+      }
+      Expr formula = d_terms[readTermId()];
+      return new DefineFunctionCommand(
+          d_termNames[id], d_terms[id], formals, formula);
+    }
+    case TAG_ASSERT: return new AssertCommand(d_terms[readTermId()], false);
+    case TAG_CHECK_SAT:
+      if (readUnsigned() == 0)
+      {
+        return new CheckSatCommand();
+      }
+      return new CheckSatCommand(d_terms[readTermId()]);
+    case TAG_CHECK_SAT_ASSUMING:
+    {
+      std::vector<Expr> terms;
+      for (uint64_t i = 0, n = readUnsigned(); i < n; ++i)
+      {
+        terms.push_back(d_terms[readTermId()]);
+      }
+      return new CheckSatAssumingCommand(terms);
+    }
+    case TAG_PUSH: return new PushCommand();
+    case TAG_POP: return new PopCommand();
+    case TAG_GET_MODEL: return new GetModelCommand();
+    case TAG_QUIT: return new QuitCommand();
+    default:
+    {
+      std::stringstream ss;
+      ss << "unexpected record '" << tag << "'";
+      parseError(ss.str());
+      return nullptr;
+    }
+  }
+}
+
+api::Term BinaryInput::parseExpr()
+{
+  char tag = readTableRecords();
+  if (tag == 0)
+  {
+    return api::Term();
+  }
+  if (tag != TAG_EXPR)
+  {
+    std::stringstream ss;
+    ss << "unexpected record '" << tag << "' where a term was expected";
+    parseError(ss.str());
+  }
+  return api::Term(d_terms[readTermId()]);
+}
+
+}  // namespace parser
+}  // namespace CVC4
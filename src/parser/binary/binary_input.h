@@ -0,0 +1,131 @@
+/*********************                                                        */
+/*! \file binary_input.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The input class for the binary language.
+ **
+ ** The input class for the binary language, which reads back the records
+ ** written by the binary printer (see printer/binary/binary_format.h).
+ **/
+
+#include "cvc4parser_private.h"
+
+#ifndef CVC4__PARSER__BINARY_INPUT_H
+#define CVC4__PARSER__BINARY_INPUT_H
+
+#include <string>
+#include <vector>
+
+#include "api/cvc4cpp.h"
+#include "expr/expr.h"
+#include "expr/kind.h"
+#include "expr/type.h"
+#include "parser/input.h"
+
+namespace CVC4 {
+
+class Command;
+class ExprManager;
+
+namespace parser {
+
+class BinaryInput : public Input
+{
+ public:
+  /**
+   * Create an input for the given bytes.
+   *
+   * @param name the name of the input, for error messages
+   * @param bytes the contents of the input
+   */
+  BinaryInput(const std::string& name, const std::string& bytes);
+  ~BinaryInput() override;
+
+  /**
+   * Create an input for the contents of a file.
+   *
+   * @throws InputStreamException if the file cannot be read
+   */
+  static BinaryInput* newFileInput(const std::string& filename);
+
+  /** Create an input for the (whole) contents of a stream. */
+  static BinaryInput* newStreamInput(std::istream& input,
+                                     const std::string& name);
+
+ protected:
+  /**
+   * Parse a command from the input. Returns <code>NULL</code> if there is
+   * no command there to parse.
+   *
+   * @throws ParserException if an error is encountered during parsing.
+   */
+  Command* parseCommand() override;
+
+  /**
+   * Parse an expression from the input. Returns a null term if there is no
+   * expression there to parse.
+   *
+   * @throws ParserException if an error is encountered during parsing.
+   */
+  api::Term parseExpr() override;
+
+  void warning(const std::string& msg) override;
+
+  void parseError(const std::string& msg, bool eofException = false) override;
+
+  void setParser(Parser& parser) override;
+
+ private:
+  /** Read a byte, which must exist. */
+  char readByte();
+  /** Read an unsigned LEB128 number. */
+  uint64_t readUnsigned();
+  /** Read a string. */
+  std::string readString();
+  /** Read an id of the kind table and return its kind. */
+  Kind readKind();
+  /** Read an id of the type table. */
+  uint64_t readTypeId();
+  /** Read an id of the term table. */
+  uint64_t readTermId();
+
+  /** Read the rest of a header record. */
+  void readHeader();
+  /** Read the rest of a type record. */
+  void readTypeRecord();
+  /** Read the rest of a term record. */
+  void readTermRecord();
+  /**
+   * Read the records up to the next command or expression record, and
+   * return its tag, or 0 at the end of the input.
+   */
+  char readTableRecords();
+
+  /** The contents of the input. */
+  const std::string& d_bytes;
+  /** The position in d_bytes. */
+  size_t d_pos;
+  /** The expression manager building the terms. */
+  ExprManager* d_em;
+  /** Has the header been read? */
+  bool d_seenHeader;
+  /** The tables of the stream. */
+  std::vector<Kind> d_kinds;
+  std::vector<Type> d_types;
+  std::vector<Expr> d_terms;
+  /** The names of the sorts and variables, by id (empty for the others). */
+  std::vector<std::string> d_typeNames;
+  std::vector<std::string> d_termNames;
+}; /* class BinaryInput */
+
+}  // namespace parser
+}  // namespace CVC4
+
+#endif /* CVC4__PARSER__BINARY_INPUT_H */
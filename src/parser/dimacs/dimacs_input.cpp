@@ -0,0 +1,575 @@
+/*********************                                                        */
+/*! \file dimacs_input.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The input class for the DIMACS and OPB languages.
+ **/
+
+#include "parser/dimacs/dimacs_input.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+
+#include "base/output.h"
+#include "parser/parser.h"
+#include "parser/parser_exception.h"
+#include "smt/command.h"
+
+namespace CVC4 {
+namespace parser {
+
+namespace {
+
+/** The contents of a DIMACS or OPB input. */
+class DimacsInputStream : public InputStream
+{
+ public:
+  DimacsInputStream(const std::string& name, const std::string& text)
+      : InputStream(name), d_text(text)
+  {
+  }
+  std::string d_text;
+}; /* class DimacsInputStream */
+
+/** The literals standing for the constants of the BDD encoding. */
+const int s_trueLit = std::numeric_limits<int>::max();
+const int s_falseLit = -s_trueLit;
+
+/**
+ * A node of the BDD encoding a pseudo-Boolean constraint. At level i, it
+ * stands for sum of terms i, i+1, ... >= k for all bounds k in [lower,
+ * upper], which are equivalent constraints.
+ */
+struct BddNode
+{
+  int64_t d_lower;
+  int64_t d_upper;
+  int d_lit;
+};
+
+/** Add a to a bound, keeping the infinite bounds. */
+int64_t addToBound(int64_t bound, int64_t a)
+{
+  if (bound == std::numeric_limits<int64_t>::min()
+      || bound == std::numeric_limits<int64_t>::max())
+  {
+    return bound;
+  }
+  return bound + a;
+}
+
+/** The bound on the sums of the absolute values of coefficients. */
+const int64_t s_maxCoefficientSum = std::numeric_limits<int64_t>::max() / 4;
+
+}  // namespace
+
+DimacsInput::DimacsInput(InputLanguage lang,
+                         const std::string& name,
+                         const std::string& text)
+    : Input(*new DimacsInputStream(name, text)),
+      d_lang(lang),
+      d_text(static_cast<DimacsInputStream*>(getInputStream())->d_text),
+      d_pos(0),
+      d_line(1),
+      d_numVars(0),
+      d_commands(0),
+      d_parser(nullptr)
+{
+}
+
+DimacsInput::~DimacsInput() {}
+
+DimacsInput* DimacsInput::newFileInput(InputLanguage lang,
+                                       const std::string& filename)
+{
+  std::ifstream in(filename.c_str(), std::ios::binary);
+  if (!in)
+  {
+    throw InputStreamException("Couldn't open file: " + filename);
+  }
+  return newStreamInput(lang, in, filename);
+}
+
+DimacsInput* DimacsInput::newStreamInput(InputLanguage lang,
+                                         std::istream& input,
+                                         const std::string& name)
+{
+  std::stringstream ss;
+  ss << input.rdbuf();
+  return new DimacsInput(lang, name, ss.str());
+}
+
+void DimacsInput::setParser(Parser& parser) { d_parser = &parser; }
+
+void DimacsInput::warning(const std::string& msg)
+{
+  Warning() << getInputStream()->getName() << ":" << d_line
+            << ": warning: " << msg << std::endl;
+}
+
+void DimacsInput::parseError(const std::string& msg, bool eofException)
+{
+  std::stringstream ss;
+  ss << getInputStream()->getName() << ":" << d_line << ": " << msg;
+  if (eofException)
+  {
+    throw ParserEndOfFileException(ss.str());
+  }
+  throw ParserException(ss.str());
+}
+
+bool DimacsInput::skipSpace()
+{
+  for (size_t size = d_text.size(); d_pos < size; ++d_pos)
+  {
+    char c = d_text[d_pos];
+    if (c == '\n')
+    {
+      ++d_line;
+    }
+    else if (!isspace(static_cast<unsigned char>(c)))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void DimacsInput::skipLine()
+{
+  size_t end = d_text.find('\n', d_pos);
+  d_pos = end == std::string::npos ? d_text.size() : end;
+}
+
+int64_t DimacsInput::readInteger()
+{
+  bool negative = false;
+  if (d_pos < d_text.size() && (d_text[d_pos] == '-' || d_text[d_pos] == '+'))
+  {
+    negative = d_text[d_pos++] == '-';
+  }
+  if (d_pos == d_text.size())
+  {
+    parseError("unexpected end of input, expected an integer", true);
+  }
+  if (!isdigit(static_cast<unsigned char>(d_text[d_pos])))
+  {
+    std::stringstream ss;
+    ss << "unexpected character `" << d_text[d_pos]
+       << "', expected an integer";
+    parseError(ss.str());
+  }
+  int64_t n = 0;
+  for (size_t size = d_text.size();
+       d_pos < size && isdigit(static_cast<unsigned char>(d_text[d_pos]));
+       ++d_pos)
+  {
+    int64_t digit = d_text[d_pos] - '0';
+    if (n > (std::numeric_limits<int64_t>::max() - digit) / 10)
+    {
+      parseError("integer out of range");
+    }
+    n = n * 10 + digit;
+  }
+  return negative ? -n : n;
+}
+
+int DimacsInput::readOpbLiteral()
+{
+  bool negated = d_text[d_pos] == '~';
+  if (negated)
+  {
+    ++d_pos;
+  }
+  if (d_pos == d_text.size() || d_text[d_pos] != 'x')
+  {
+    parseError("expected a variable x<n>", d_pos == d_text.size());
+  }
+  ++d_pos;
+  int64_t v = readInteger();
+  if (v <= 0 || v >= std::numeric_limits<int>::max())
+  {
+    parseError("variable out of range");
+  }
+  d_numVars = std::max(d_numVars, static_cast<int>(v));
+  return negated ? -static_cast<int>(v) : static_cast<int>(v);
+}
+
+void DimacsInput::readDimacs()
+{
+  bool inClause = false;
+  while (skipSpace())
+  {
+    char c = d_text[d_pos];
+    if (c == 'c')
+    {
+      skipLine();
+      continue;
+    }
+    if (c == '%')
+    {
+      // the end marker of some benchmark sets
+      break;
+    }
+    if (c == 'p')
+    {
+      ++d_pos;
+      if (inClause || !skipSpace() || d_text.compare(d_pos, 3, "cnf") != 0)
+      {
+        parseError("expected a `p cnf' header");
+      }
+      d_pos += 3;
+      skipSpace();
+      int64_t vars = readInteger();
+      skipSpace();
+      int64_t clauses = readInteger();
+      if (vars < 0 || vars >= std::numeric_limits<int>::max() || clauses < 0)
+      {
+        parseError("invalid `p cnf' header");
+      }
+      d_numVars = std::max(d_numVars, static_cast<int>(vars));
+      d_literals.reserve(4 * std::min<size_t>(clauses, 1 << 24));
+      continue;
+    }
+    int64_t lit = readInteger();
+    if (lit <= -std::numeric_limits<int>::max()
+        || lit >= std::numeric_limits<int>::max())
+    {
+      parseError("variable out of range");
+    }
+    d_literals.push_back(static_cast<int>(lit));
+    inClause = lit != 0;
+    d_numVars = std::max(d_numVars, static_cast<int>(lit < 0 ? -lit : lit));
+  }
+  if (inClause)
+  {
+    warning("the last clause is not terminated by 0");
+    d_literals.push_back(0);
+  }
+}
+
+void DimacsInput::readOpbTerms(std::vector<PbTerm>& terms)
+{
+  while (skipSpace())
+  {
+    char c = d_text[d_pos];
+    if (c == '>' || c == '<' || c == '=' || c == ';')
+    {
+      return;
+    }
+    int64_t a = c == 'x' || c == '~' ? 1 : readInteger();
+    if (!skipSpace())
+    {
+      break;
+    }
+    int lit = readOpbLiteral();
+    if (skipSpace() && (d_text[d_pos] == 'x' || d_text[d_pos] == '~'))
+    {
+      parseError("non-linear terms are not supported");
+    }
+    terms.push_back(PbTerm(a, lit));
+  }
+  parseError("unexpected end of input, expected `;'", true);
+}
+
+void DimacsInput::readOpb()
+{
+  // the constraints sum of terms >= bound, encoded after all variables of the
+  // input are known
+  std::vector<std::pair<std::vector<PbTerm>, int64_t>> constraints;
+  bool seenObjective = false;
+  while (skipSpace())
+  {
+    if (d_text[d_pos] == '*')
+    {
+      skipLine();
+      continue;
+    }
+    std::vector<PbTerm> terms;
+    if (d_text.compare(d_pos, 4, "min:") == 0
+        || d_text.compare(d_pos, 4, "max:") == 0)
+    {
+      if (seenObjective)
+      {
+        parseError("more than one objective function");
+      }
+      seenObjective = true;
+      d_pos += 4;
+      readOpbTerms(terms);
+      if (d_text[d_pos] != ';')
+      {
+        parseError("expected `;' after the objective function");
+      }
+      ++d_pos;
+      warning(
+          "ignoring the objective function, only the constraints are "
+          "checked for satisfiability");
+      continue;
+    }
+    readOpbTerms(terms);
+    bool geq = false;
+    bool leq = false;
+    if (d_text.compare(d_pos, 2, ">=") == 0)
+    {
+      geq = true;
+      d_pos += 2;
+    }
+    else if (d_text.compare(d_pos, 2, "<=") == 0)
+    {
+      leq = true;
+      d_pos += 2;
+    }
+    else if (d_text[d_pos] == '=')
+    {
+      geq = leq = true;
+      ++d_pos;
+    }
+    else
+    {
+      parseError("expected a relation `>=', `<=' or `='");
+    }
+    skipSpace();
+    int64_t bound = readInteger();
+    if (!skipSpace() || d_text[d_pos] != ';')
+    {
+      parseError("expected `;' after the constraint", d_pos == d_text.size());
+    }
+    ++d_pos;
+    // the normalization of encodeAtLeast must not overflow
+    int64_t sum = bound < 0 ? -bound : bound;
+    for (const PbTerm& t : terms)
+    {
+      if (t.first < -s_maxCoefficientSum || t.first > s_maxCoefficientSum
+          || sum > s_maxCoefficientSum - std::abs(t.first))
+      {
+        parseError("coefficients out of range");
+      }
+      sum += std::abs(t.first);
+    }
+    if (geq)
+    {
+      constraints.push_back(std::make_pair(terms, bound));
+    }
+    if (leq)
+    {
+      // sum of terms <= bound is sum of negated terms >= -bound
+      for (PbTerm& t : terms)
+      {
+        t.first = -t.first;
+      }
+      constraints.push_back(std::make_pair(terms, -bound));
+    }
+  }
+  for (std::pair<std::vector<PbTerm>, int64_t>& c : constraints)
+  {
+    encodeAtLeast(std::move(c.first), c.second);
+  }
+}
+
+int DimacsInput::newVar()
+{
+  if (d_numVars == std::numeric_limits<int>::max() - 1)
+  {
+    parseError("too many auxiliary variables for the encoding");
+  }
+  return ++d_numVars;
+}
+
+void DimacsInput::encodeAtLeast(std::vector<PbTerm> terms, int64_t bound)
+{
+  // make the coefficients positive, using a * l = a + (-a) * ~l, and bound
+  // them by the bound, which does not change the constraint
+  for (PbTerm& t : terms)
+  {
+    if (t.first < 0)
+    {
+      bound -= t.first;
+      t.first = -t.first;
+      t.second = -t.second;
+    }
+  }
+  if (bound <= 0)
+  {
+    return;
+  }
+  int64_t total = 0;
+  for (PbTerm& t : terms)
+  {
+    t.first = std::min(t.first, bound);
+    total += t.first;
+  }
+  if (total < bound)
+  {
+    // no assignment satisfies the constraint, add the empty clause
+    d_literals.push_back(0);
+    return;
+  }
+  terms.erase(std::remove_if(terms.begin(),
+                             terms.end(),
+                             [](const PbTerm& t) { return t.first == 0; }),
+              terms.end());
+  // larger coefficients first give smaller BDDs
+  std::stable_sort(
+      terms.begin(), terms.end(), [](const PbTerm& t1, const PbTerm& t2) {
+        return t1.first > t2.first;
+      });
+  size_t n = terms.size();
+  std::vector<int64_t> rest(n + 1, 0);
+  for (size_t i = n; i > 0; --i)
+  {
+    rest[i - 1] = rest[i] + terms[i - 1].first;
+  }
+
+  // The BDD of the constraint, built bottom up with intervals of equivalent
+  // bounds at each level, as in Abio et al., "A New Look at BDDs for
+  // Pseudo-Boolean Constraints", JAIR 2012. The nodes are indexed by level
+  // and by the lower ends of their intervals.
+  std::vector<std::map<int64_t, BddNode>> levels(n + 1);
+  auto find = [&](size_t i, int64_t k, BddNode& node) {
+    if (k <= 0)
+    {
+      node = {std::numeric_limits<int64_t>::min(), 0, s_trueLit};
+      return true;
+    }
+    if (k > rest[i])
+    {
+      node = {rest[i] + 1, std::numeric_limits<int64_t>::max(), s_falseLit};
+      return true;
+    }
+    std::map<int64_t, BddNode>::iterator it = levels[i].upper_bound(k);
+    if (it == levels[i].begin())
+    {
+      return false;
+    }
+    --it;
+    if (it->second.d_upper < k)
+    {
+      return false;
+    }
+    node = it->second;
+    return true;
+  };
+  BddNode root;
+  std::vector<std::pair<size_t, int64_t>> toVisit;
+  toVisit.push_back(std::make_pair(0, bound));
+  while (!toVisit.empty())
+  {
+    size_t i = toVisit.back().first;
+    int64_t k = toVisit.back().second;
+    BddNode node;
+    if (find(i, k, node))
+    {
+      toVisit.pop_back();
+      continue;
+    }
+    int64_t a = terms[i].first;
+    int lit = terms[i].second;
+    BddNode hi;
+    BddNode lo;
+    bool hasHi = find(i + 1, k - a, hi);
+    bool hasLo = find(i + 1, k, lo);
+    if (!hasHi || !hasLo)
+    {
+      if (!hasHi)
+      {
+        toVisit.push_back(std::make_pair(i + 1, k - a));
+      }
+      if (!hasLo)
+      {
+        toVisit.push_back(std::make_pair(i + 1, k));
+      }
+      continue;
+    }
+    toVisit.pop_back();
+    node.d_lower = std::max(addToBound(hi.d_lower, a), lo.d_lower);
+    node.d_upper = std::min(addToBound(hi.d_upper, a), lo.d_upper);
+    if (hi.d_lit == lo.d_lit)
+    {
+      node.d_lit = hi.d_lit;
+    }
+    else if (hi.d_lit == s_trueLit && lo.d_lit == s_falseLit)
+    {
+      node.d_lit = lit;
+    }
+    else
+    {
+      // The node implies ite(lit, hi, lo). Since lo implies hi, this is
+      // (hi) and (lit or lo); the converse is not needed since the
+      // constraint is only asserted positively.
+      node.d_lit = newVar();
+      if (hi.d_lit != s_trueLit)
+      {
+        d_literals.push_back(-node.d_lit);
+        if (hi.d_lit != s_falseLit)
+        {
+          d_literals.push_back(hi.d_lit);
+        }
+        d_literals.push_back(0);
+      }
+      d_literals.push_back(-node.d_lit);
+      d_literals.push_back(lit);
+      if (lo.d_lit != s_falseLit)
+      {
+        d_literals.push_back(lo.d_lit);
+      }
+      d_literals.push_back(0);
+    }
+    levels[i][node.d_lower] = node;
+  }
+  find(0, bound, root);
+  if (root.d_lit == s_falseLit)
+  {
+    d_literals.push_back(0);
+  }
+  else if (root.d_lit != s_trueLit)
+  {
+    d_literals.push_back(root.d_lit);
+    d_literals.push_back(0);
+  }
+}
+
+Command* DimacsInput::parseCommand()
+{
+  switch (d_commands++)
+  {
+    case 0:
+      return new SetBenchmarkLogicCommand(d_parser->logicIsForced()
+                                              ? d_parser->getForcedLogic()
+                                              : std::string("QF_SAT"));
+    case 1:
+      if (d_lang == language::input::LANG_DIMACS)
+      {
+        readDimacs();
+      }
+      else
+      {
+        readOpb();
+      }
+      Debug("parser") << "DimacsInput: " << d_numVars << " variables, "
+                      << d_literals.size() << " literals" << std::endl;
+      return new AssertClausesCommand(std::move(d_literals));
+    case 2: return new CheckSatCommand();
+    default: return nullptr;
+  }
+}
+
+api::Term DimacsInput::parseExpr()
+{
+  parseError("DIMACS and OPB inputs have no expressions");
+  return api::Term();
+}
+
+}  // namespace parser
+}  // namespace CVC4
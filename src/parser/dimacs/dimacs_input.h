@@ -0,0 +1,143 @@
+/*********************                                                        */
+/*! \file dimacs_input.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The input class for the DIMACS and OPB languages.
+ **
+ ** The input class for the DIMACS CNF and OPB pseudo-Boolean languages. The
+ ** whole input is read into clauses over DIMACS variables, which are
+ ** asserted to the SAT solver by a single AssertClausesCommand followed by a
+ ** check-sat; no terms are built. The pseudo-Boolean constraints of OPB
+ ** inputs are encoded by BDDs into clauses over auxiliary variables, and
+ ** their objective functions are ignored.
+ **/
+
+#include "cvc4parser_private.h"
+
+#ifndef CVC4__PARSER__DIMACS_INPUT_H
+#define CVC4__PARSER__DIMACS_INPUT_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "api/cvc4cpp.h"
+#include "options/language.h"
+#include "parser/input.h"
+
+namespace CVC4 {
+
+class Command;
+
+namespace parser {
+
+class DimacsInput : public Input
+{
+ public:
+  /**
+   * Create an input for the given text.
+   *
+   * @param lang the language of the input, LANG_DIMACS or LANG_OPB
+   * @param name the name of the input, for error messages
+   * @param text the contents of the input
+   */
+  DimacsInput(InputLanguage lang,
+              const std::string& name,
+              const std::string& text);
+  ~DimacsInput() override;
+
+  /**
+   * Create an input for the contents of a file.
+   *
+   * @throws InputStreamException if the file cannot be read
+   */
+  static DimacsInput* newFileInput(InputLanguage lang,
+                                   const std::string& filename);
+
+  /** Create an input for the (whole) contents of a stream. */
+  static DimacsInput* newStreamInput(InputLanguage lang,
+                                     std::istream& input,
+                                     const std::string& name);
+
+ protected:
+  /**
+   * Parse a command from the input. The commands are, in order, the
+   * set-logic (QF_SAT unless the logic is forced), the clauses of the input
+   * and a check-sat. Returns <code>NULL</code> after the last one.
+   *
+   * @throws ParserException if an error is encountered during parsing.
+   */
+  Command* parseCommand() override;
+
+  /**
+   * These inputs have no expressions; a parse error is signaled.
+   *
+   * @throws ParserException
+   */
+  api::Term parseExpr() override;
+
+  void warning(const std::string& msg) override;
+
+  void parseError(const std::string& msg, bool eofException = false) override;
+
+  void setParser(Parser& parser) override;
+
+ private:
+  /** A pseudo-Boolean term: a coefficient and a DIMACS literal. */
+  typedef std::pair<int64_t, int> PbTerm;
+
+  /** Skip whitespace, and return false at the end of the input. */
+  bool skipSpace();
+  /** Skip the rest of the current line. */
+  void skipLine();
+  /** Read an integer, with an optional sign. */
+  int64_t readInteger();
+  /** Read an OPB literal, x<n> or ~x<n>. */
+  int readOpbLiteral();
+
+  /** Read the clauses of a DIMACS input into d_literals. */
+  void readDimacs();
+  /** Read the constraints of an OPB input and encode them into d_literals. */
+  void readOpb();
+  /**
+   * Read the terms of an OPB constraint or objective, up to a relation or
+   * ';', into terms.
+   */
+  void readOpbTerms(std::vector<PbTerm>& terms);
+  /**
+   * Add clauses encoding sum of terms >= bound to d_literals, introducing
+   * auxiliary variables after d_numVars.
+   */
+  void encodeAtLeast(std::vector<PbTerm> terms, int64_t bound);
+  /** Return a fresh auxiliary variable. */
+  int newVar();
+
+  /** The language of the input (LANG_DIMACS or LANG_OPB) */
+  InputLanguage d_lang;
+  /** The contents of the input. */
+  const std::string& d_text;
+  /** The position in d_text. */
+  size_t d_pos;
+  /** The current line, for error messages. */
+  size_t d_line;
+  /** The number of variables, including the auxiliary ones. */
+  int d_numVars;
+  /** The number of commands produced so far. */
+  unsigned d_commands;
+  /** The parser of this input. */
+  Parser* d_parser;
+  /** The literals of the clauses, each terminated by 0. */
+  std::vector<int> d_literals;
+}; /* class DimacsInput */
+
+}  // namespace parser
+}  // namespace CVC4
+
+#endif /* CVC4__PARSER__DIMACS_INPUT_H */
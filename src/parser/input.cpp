@@ -20,6 +20,8 @@
 #include "parser/input.h"
 
 #include "base/output.h"
+#include "parser/binary/binary_input.h"
+#include "parser/dimacs/dimacs_input.h"
 #include "expr/type.h"
 #include "parser/parser.h"
 #include "parser/parser_exception.h"
@@ -58,6 +60,15 @@ Input* Input::newFileInput(InputLanguage lang,
                            const std::string& filename,
                            bool useMmap)
 {
+  if (lang == language::input::LANG_BINARY)
+  {
+    return BinaryInput::newFileInput(filename);
+  }
+  if (lang == language::input::LANG_DIMACS
+      || lang == language::input::LANG_OPB)
+  {
+    return DimacsInput::newFileInput(lang, filename);
+  }
   AntlrInputStream *inputStream = 
     AntlrInputStream::newFileInputStream(filename, useMmap);
   return AntlrInput::newInput(lang, *inputStream);
@@ -68,6 +79,15 @@ Input* Input::newStreamInput(InputLanguage lang,
                              const std::string& name,
                              bool lineBuffered)
 {
+  if (lang == language::input::LANG_BINARY)
+  {
+    return BinaryInput::newStreamInput(input, name);
+  }
+  if (lang == language::input::LANG_DIMACS
+      || lang == language::input::LANG_OPB)
+  {
+    return DimacsInput::newStreamInput(lang, input, name);
+  }
   AntlrInputStream *inputStream =
     AntlrInputStream::newStreamInputStream(input, name, lineBuffered);
   return AntlrInput::newInput(lang, *inputStream);
@@ -77,6 +97,15 @@ Input* Input::newStringInput(InputLanguage lang,
                              const std::string& str,
                              const std::string& name)
 {
+  if (lang == language::input::LANG_BINARY)
+  {
+    return new BinaryInput(name, str);
+  }
+  if (lang == language::input::LANG_DIMACS
+      || lang == language::input::LANG_OPB)
+  {
+    return new DimacsInput(lang, name, str);
+  }
   AntlrInputStream *inputStream = AntlrInputStream::newStringInputStream(str, name);
   return AntlrInput::newInput(lang, *inputStream);
 }
@@ -83,6 +83,7 @@ class Parser;
 class CVC4_PUBLIC Input {
   friend class Parser; // for parseError, parseCommand, parseExpr
   friend class ParserBuilder;
+  friend class Smt2FastInput; // for parseCommand, parseExpr of its fallback
 
   /** The input stream. */
   InputStream *d_inputStream;
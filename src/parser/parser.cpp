@@ -35,6 +35,7 @@
 #include "parser/input.h"
 #include "parser/parser_exception.h"
 #include "smt/command.h"
+#include "util/phase_profiler.h"
 #include "util/resource_manager.h"
 
 using namespace std;
@@ -696,6 +697,7 @@ void Parser::preemptCommand(Command* cmd) { d_commandQueue.push_back(cmd); }
 Command* Parser::nextCommand()
 {
   Debug("parser") << "nextCommand()" << std::endl;
+  PhaseScope phase("parse");
   Command* cmd = NULL;
   if (!d_commandQueue.empty()) {
     cmd = d_commandQueue.front();
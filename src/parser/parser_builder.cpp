@@ -22,12 +22,15 @@
 #include <string>
 
 #include "api/cvc4cpp.h"
+#include "binary/binary.h"
 #include "cvc/cvc.h"
+#include "dimacs/dimacs.h"
 #include "expr/expr_manager.h"
 #include "options/options.h"
 #include "parser/input.h"
 #include "parser/parser.h"
 #include "smt2/smt2.h"
+#include "smt2/smt2_fast_input.h"
 #include "tptp/tptp.h"
 
 namespace CVC4 {
@@ -59,6 +62,7 @@ void ParserBuilder::init(api::Solver* solver, const std::string& filename)
   d_strictMode = false;
   d_canIncludeFile = true;
   d_mmap = false;
+  d_fastParse = false;
   d_parseOnly = false;
   d_logicIsForced = false;
   d_forcedLogic = "";
@@ -69,7 +73,14 @@ Parser* ParserBuilder::build()
   Input* input = NULL;
   switch( d_inputType ) {
   case FILE_INPUT:
-    input = Input::newFileInput(d_lang, d_filename, d_mmap);
+    if (d_fastParse && language::isInputLang_smt2(d_lang))
+    {
+      input = new Smt2FastInput(d_lang, d_filename);
+    }
+    else
+    {
+      input = Input::newFileInput(d_lang, d_filename, d_mmap);
+    }
     break;
   case LINE_BUFFERED_STREAM_INPUT:
     assert( d_streamInput != NULL );
@@ -96,6 +107,13 @@ Parser* ParserBuilder::build()
     case language::input::LANG_TPTP:
       parser = new Tptp(d_solver, input, d_strictMode, d_parseOnly);
       break;
+    case language::input::LANG_BINARY:
+      parser = new Binary(d_solver, input, d_strictMode, d_parseOnly);
+      break;
+    case language::input::LANG_DIMACS:
+    case language::input::LANG_OPB:
+      parser = new Dimacs(d_solver, input, d_strictMode, d_parseOnly);
+      break;
     default:
       if (language::isInputLang_smt2(d_lang))
       {
@@ -158,6 +176,11 @@ ParserBuilder& ParserBuilder::withMmap(bool flag) {
   return *this;
 }
 
+ParserBuilder& ParserBuilder::withFastParse(bool flag) {
+  d_fastParse = flag;
+  return *this;
+}
+
 ParserBuilder& ParserBuilder::withParseOnly(bool flag) {
   d_parseOnly = flag;
   return *this;
@@ -168,6 +191,7 @@ ParserBuilder& ParserBuilder::withOptions(const Options& options) {
   retval =
       retval.withInputLanguage(options.getInputLanguage())
       .withMmap(options.getMemoryMap())
+      .withFastParse(options.getFastParse())
       .withChecks(options.getSemanticChecks())
       .withStrictMode(options.getStrictParsing())
       .withParseOnly(options.getParseOnly())
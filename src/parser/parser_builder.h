@@ -79,6 +79,9 @@ class CVC4_PUBLIC ParserBuilder {
   /** Should we memory-map a file input? */
   bool d_mmap;
 
+  /** Should we use the hand-written parser for SMT-LIB 2 file inputs? */
+  bool d_fastParse;
+
   /** Are we parsing only? */
   bool d_parseOnly;
 
@@ -134,6 +137,15 @@ class CVC4_PUBLIC ParserBuilder {
    */
   ParserBuilder& withMmap(bool flag = true);
 
+  /**
+   * Should the parser use the hand-written SMT-LIB 2 parser for a file
+   * input, falling back to the grammar for unsupported commands? This is
+   * only relevant for SMT-LIB 2 (but not SyGuS) file inputs.
+   *
+   * (Default: no)
+   */
+  ParserBuilder& withFastParse(bool flag = true);
+
   /**
    * Are we only parsing, or doing something with the resulting
    * commands and expressions?  This setting affects whether the
@@ -853,7 +853,11 @@ void Smt2::includeFile(const std::string& filename) {
   }
 
   // Get the lexer
-  AntlrInput* ai = static_cast<AntlrInput*>(getInput());
+  AntlrInput* ai = dynamic_cast<AntlrInput*>(getInput());
+  if (ai == nullptr)
+  {
+    parseError("include-file is not supported with --fast-parse.");
+  }
   pANTLR3_LEXER lexer = ai->getAntlr3Lexer();
   // get the name of the current stream "Does it work inside an include?"
   const std::string inputName = ai->getInputStreamName();
@@ -0,0 +1,892 @@
+/*********************                                                        */
+/*! \file smt2_fast_input.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A hand-written SMT-LIB 2 input over a memory-mapped file
+ **/
+
+#include "parser/smt2/smt2_fast_input.h"
+
+#include <fcntl.h>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif /* _WIN32 */
+
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <unordered_set>
+
+#include "base/output.h"
+#include "parser/parse_op.h"
+#include "parser/parser.h"
+#include "parser/parser_exception.h"
+#include "parser/smt2/smt2.h"
+#include "smt/command.h"
+
+namespace CVC4 {
+namespace parser {
+
+namespace {
+
+/** The contents of a file, memory-mapped where possible. */
+class MappedFileInputStream : public InputStream
+{
+ public:
+  MappedFileInputStream(const std::string& filename)
+      : InputStream(filename), d_data(nullptr), d_size(0)
+  {
+#ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      throw InputStreamException("Couldn't open file: " + filename);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+      close(fd);
+      throw InputStreamException("Couldn't stat file: " + filename);
+    }
+    d_size = st.st_size;
+    if (d_size > 0)
+    {
+      void* data = mmap(nullptr, d_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED)
+      {
+        close(fd);
+        throw InputStreamException("Couldn't memory map file: " + filename);
+      }
+      // the input is read once, front to back
+      madvise(data, d_size, MADV_SEQUENTIAL);
+      d_data = static_cast<const char*>(data);
+    }
+    close(fd);
+#else  /* _WIN32 */
+    std::ifstream in(filename.c_str(), std::ios::binary);
+    if (!in)
+    {
+      throw InputStreamException("Couldn't open file: " + filename);
+    }
+    std::stringstream ss;
+    ss << in.rdbuf();
+    d_contents = ss.str();
+    d_data = d_contents.data();
+    d_size = d_contents.size();
+#endif /* _WIN32 */
+  }
+
+  ~MappedFileInputStream() override
+  {
+#ifndef _WIN32
+    if (d_data != nullptr)
+    {
+      munmap(const_cast<char*>(d_data), d_size);
+    }
+#endif /* _WIN32 */
+  }
+
+  const char* d_data;
+  size_t d_size;
+#ifdef _WIN32
+  std::string d_contents;
+#endif /* _WIN32 */
+}; /* class MappedFileInputStream */
+
+bool isSymbolChar(char c)
+{
+  return isalnum(static_cast<unsigned char>(c))
+         || strchr("+-/*=%?!.$_~&^<>@", c) != nullptr;
+}
+
+/**
+ * The words that the ANTLR lexer turns into tokens of their own, which the
+ * fast path leaves to the grammar wherever they occur.
+ */
+const std::unordered_set<std::string>& getReservedWords()
+{
+  static const std::unordered_set<std::string> words = {
+      "!",        "_",           "as",     "let",     "forall",  "exists",
+      "match",    "par",         "const",  "is",      "emp",     "mkTuple",
+      "tupSel",   "->",          "lambda", "comprehension",      "assert",
+      "check-sat",             "check-sat-assuming", "declare-fun",
+      "declare-sort",          "define-fun",         "define-fun-rec",
+      "define-funs-rec",       "define-sort",        "get-value",
+      "get-assignment",        "get-assertions",     "get-proof",
+      "get-unsat-assumptions", "get-unsat-core",     "exit",
+      "reset",                 "reset-assertions",   "set-logic",
+      "set-info",              "get-info",           "set-option",
+      "get-option",            "push",               "pop",
+      "declare-codatatype",    "declare-datatype",   "declare-datatypes",
+      "declare-codatatypes",   "get-model",          "block-model",
+      "block-model-values",    "echo",               "declare-sorts",
+      "declare-funs",          "declare-preds",      "define",
+      "declare-const",         "define-const",       "simplify",
+      "include",               "get-qe",             "get-qe-disjunct",
+      "get-abduct",            "get-interpol",       "synth-fun",
+      "synth-inv",             "check-synth",        "declare-var",
+      "declare-primed-var",    "constraint",         "inv-constraint",
+      "set-options",           "Constant",           "Variable",
+      "InputVariable",         "LocalVariable",      "declare-heap"};
+  return words;
+}
+
+}  // namespace
+
+std::string Smt2FastInput::Token::getText() const
+{
+  if (d_kind == TOK_SYMBOL && d_begin[0] == '|')
+  {
+    return std::string(d_begin + 1, d_length - 2);
+  }
+  return std::string(d_begin, d_length);
+}
+
+Smt2FastInput::Smt2FastInput(InputLanguage lang, const std::string& filename)
+    : Input(*new MappedFileInputStream(filename)),
+      d_lang(lang),
+      d_parser(nullptr)
+{
+  MappedFileInputStream* in =
+      static_cast<MappedFileInputStream*>(getInputStream());
+  d_begin = in->d_data;
+  d_end = in->d_data + in->d_size;
+  d_pos = d_begin;
+  d_line = 1;
+  d_lineBegin = d_begin;
+  d_startPos = d_begin;
+  d_startLine = 1;
+  d_startLineBegin = d_begin;
+  d_epoch = 1;
+}
+
+Smt2FastInput::~Smt2FastInput() {}
+
+void Smt2FastInput::setParser(Parser& parser)
+{
+  d_parser = dynamic_cast<Smt2*>(&parser);
+  if (d_parser == nullptr)
+  {
+    throw ParserException("The fast SMT-LIB 2 input needs an SMT-LIB 2 parser");
+  }
+}
+
+void Smt2FastInput::warning(const std::string& msg)
+{
+  Warning() << getInputStream()->getName() << ':' << d_startLine
+            << ": warning: " << msg << std::endl;
+}
+
+void Smt2FastInput::parseError(const std::string& msg, bool eofException)
+{
+  // errors of the fast path are not reported, the grammar parses the command
+  // again; these are the errors raised by the parser state on the fallback
+  if (eofException)
+  {
+    throw ParserEndOfFileException(msg,
+                                   getInputStream()->getName(),
+                                   d_startLine,
+                                   d_startPos - d_startLineBegin + 1);
+  }
+  throw FileParserException(msg,
+                            getInputStream()->getName(),
+                            d_startLine,
+                            d_startPos - d_startLineBegin + 1);
+}
+
+void Smt2FastInput::skipWhitespace()
+{
+  while (d_pos < d_end)
+  {
+    char c = *d_pos;
+    if (c == '\n')
+    {
+      ++d_line;
+      d_lineBegin = ++d_pos;
+    }
+    else if (c == ' ' || c == '\t' || c == '\r' || c == '\f')
+    {
+      ++d_pos;
+    }
+    else if (c == ';')
+    {
+      while (d_pos < d_end && *d_pos != '\n')
+      {
+        ++d_pos;
+      }
+    }
+    else
+    {
+      break;
+    }
+  }
+}
+
+Smt2FastInput::Token Smt2FastInput::nextToken()
+{
+  skipWhitespace();
+  Token t;
+  t.d_begin = d_pos;
+  if (d_pos == d_end)
+  {
+    t.d_kind = TOK_EOF;
+    t.d_length = 0;
+    return t;
+  }
+  char c = *d_pos++;
+  if (c == '(')
+  {
+    t.d_kind = TOK_LPAREN;
+  }
+  else if (c == ')')
+  {
+    t.d_kind = TOK_RPAREN;
+  }
+  else if (c == '|' || c == '"')
+  {
+    // quoted symbols and strings may span lines
+    t.d_kind = c == '|' ? TOK_SYMBOL : TOK_OTHER;
+    bool dupQuote = c == '"' && d_parser->escapeDupDblQuote();
+    for (;;)
+    {
+      if (d_pos == d_end)
+      {
+        // unterminated, let the grammar complain
+        t.d_kind = TOK_OTHER;
+        break;
+      }
+      char d = *d_pos++;
+      if (d == '\n')
+      {
+        ++d_line;
+        d_lineBegin = d_pos;
+      }
+      if (d == '\\')
+      {
+        if (c == '|')
+        {
+          t.d_kind = TOK_OTHER;
+        }
+        else if (!dupQuote && d_pos < d_end)
+        {
+          ++d_pos;
+        }
+      }
+      else if (d == c)
+      {
+        if (!dupQuote || d_pos == d_end || *d_pos != '"')
+        {
+          break;
+        }
+        ++d_pos;
+      }
+    }
+  }
+  else if (c == '#' && d_pos < d_end && (*d_pos == 'x' || *d_pos == 'b'))
+  {
+    bool hex = *d_pos++ == 'x';
+    const char* digits = d_pos;
+    while (d_pos < d_end
+           && (hex ? isxdigit(static_cast<unsigned char>(*d_pos))
+                   : (*d_pos == '0' || *d_pos == '1')))
+    {
+      ++d_pos;
+    }
+    t.d_kind = d_pos == digits ? TOK_OTHER : (hex ? TOK_HEX : TOK_BINARY);
+  }
+  else if (isdigit(static_cast<unsigned char>(c)))
+  {
+    while (d_pos < d_end && isdigit(static_cast<unsigned char>(*d_pos)))
+    {
+      ++d_pos;
+    }
+    t.d_kind = TOK_NUMERAL;
+    if (d_pos + 1 < d_end && *d_pos == '.'
+        && isdigit(static_cast<unsigned char>(d_pos[1])))
+    {
+      ++d_pos;
+      while (d_pos < d_end && isdigit(static_cast<unsigned char>(*d_pos)))
+      {
+        ++d_pos;
+      }
+      t.d_kind = TOK_DECIMAL;
+    }
+    if (c == '0' && d_pos - t.d_begin > 1 && t.d_kind == TOK_NUMERAL)
+    {
+      // leading zeroes depend on strict mode
+      t.d_kind = TOK_OTHER;
+    }
+  }
+  else if (c == ':' || isSymbolChar(c))
+  {
+    while (d_pos < d_end && isSymbolChar(*d_pos))
+    {
+      ++d_pos;
+    }
+    t.d_kind = c == ':' ? TOK_OTHER : TOK_SYMBOL;
+  }
+  else
+  {
+    t.d_kind = TOK_OTHER;
+  }
+  t.d_length = d_pos - t.d_begin;
+  return t;
+}
+
+Smt2FastInput::Token Smt2FastInput::expect(TokenKind k)
+{
+  Token t = nextToken();
+  if (t.d_kind != k)
+  {
+    throw Unsupported();
+  }
+  return t;
+}
+
+void Smt2FastInput::skipToClose()
+{
+  for (size_t depth = 1; depth > 0;)
+  {
+    Token t = nextToken();
+    if (t.d_kind == TOK_EOF)
+    {
+      return;
+    }
+    if (t.d_kind == TOK_LPAREN)
+    {
+      ++depth;
+    }
+    else if (t.d_kind == TOK_RPAREN)
+    {
+      --depth;
+    }
+  }
+}
+
+size_t Smt2FastInput::getSymbolId(const Token& t)
+{
+  if (t.d_kind != TOK_SYMBOL)
+  {
+    throw Unsupported();
+  }
+  bool quoted = t.d_begin[0] == '|';
+  if (quoted)
+  {
+    d_symbolText.assign(t.d_begin + 1, t.d_length - 2);
+  }
+  else
+  {
+    d_symbolText.assign(t.d_begin, t.d_length);
+  }
+  size_t id;
+  std::unordered_map<std::string, size_t>::const_iterator it =
+      d_symbolIds.find(d_symbolText);
+  if (it == d_symbolIds.end())
+  {
+    id = d_symbols.size();
+    d_symbols.push_back(
+        Symbol(d_symbolText, getReservedWords().count(d_symbolText) > 0));
+    d_symbolIds[d_symbolText] = id;
+  }
+  else
+  {
+    id = it->second;
+  }
+  if (!quoted && d_symbols[id].d_reserved)
+  {
+    throw Unsupported();
+  }
+  return id;
+}
+
+std::string Smt2FastInput::getSymbol(const Token& t)
+{
+  return d_symbols[getSymbolId(t)].d_name;
+}
+
+Smt2FastInput::Symbol& Smt2FastInput::getResolvedSymbol(size_t id)
+{
+  Symbol& s = d_symbols[id];
+  if (s.d_epoch != d_epoch)
+  {
+    s.d_term = api::Term();
+    s.d_headResolved = false;
+    s.d_function = api::Term();
+    s.d_epoch = d_epoch;
+  }
+  return s;
+}
+
+Command* Smt2FastInput::parseCommand()
+{
+  Token t = nextToken();
+  if (t.d_kind == TOK_EOF)
+  {
+    return nullptr;
+  }
+  d_startPos = t.d_begin;
+  d_startLine = d_line;
+  d_startLineBegin = d_lineBegin;
+  if (t.d_kind != TOK_LPAREN)
+  {
+    // not a command, let the grammar report the error
+    d_pos = d_end;
+    return fallbackCommand(d_startPos, d_startLine);
+  }
+  size_t scopeLevel = d_parser->scopeLevel();
+  try
+  {
+    return parseCommandBody();
+  }
+  catch (Unsupported&)
+  {
+  }
+  catch (ParserException&)
+  {
+    // the grammar will produce the error, with the right context
+  }
+  while (d_parser->scopeLevel() > scopeLevel)
+  {
+    d_parser->popScope();
+  }
+  d_pos = d_startPos + 1;
+  d_line = d_startLine;
+  d_lineBegin = d_startLineBegin;
+  skipToClose();
+  return fallbackCommand(d_startPos, d_startLine);
+}
+
+api::Term Smt2FastInput::parseExpr()
+{
+  Token t = nextToken();
+  if (t.d_kind == TOK_EOF)
+  {
+    return api::Term();
+  }
+  d_startPos = t.d_begin;
+  d_startLine = d_line;
+  d_startLineBegin = d_lineBegin;
+  size_t scopeLevel = d_parser->scopeLevel();
+  try
+  {
+    return parseTerm(t);
+  }
+  catch (Unsupported&)
+  {
+  }
+  catch (ParserException&)
+  {
+  }
+  while (d_parser->scopeLevel() > scopeLevel)
+  {
+    d_parser->popScope();
+  }
+  d_pos = d_startPos;
+  d_line = d_startLine;
+  d_lineBegin = d_startLineBegin;
+  t = nextToken();
+  if (t.d_kind == TOK_LPAREN)
+  {
+    skipToClose();
+  }
+  return fallbackExpr(d_startPos, d_startLine);
+}
+
+Command* Smt2FastInput::parseCommandBody()
+{
+  std::string cmd = expect(TOK_SYMBOL).getText();
+  std::unique_ptr<Command> result;
+  if (cmd == "assert")
+  {
+    d_parser->checkThatLogicIsSet();
+    d_parser->clearLastNamedTerm();
+    api::Term e = parseTerm(nextToken());
+    result.reset(new AssertCommand(e.getExpr(), false));
+  }
+  else if (cmd == "declare-fun" || cmd == "declare-const")
+  {
+    d_parser->checkThatLogicIsSet();
+    size_t id = getSymbolId(nextToken());
+    std::string name = d_symbols[id].d_name;
+    d_parser->checkUserSymbol(name);
+    std::vector<api::Sort> sorts;
+    if (cmd == "declare-fun")
+    {
+      expect(TOK_LPAREN);
+      for (Token s = nextToken(); s.d_kind != TOK_RPAREN; s = nextToken())
+      {
+        sorts.push_back(parseSort(s));
+      }
+    }
+    api::Sort t = parseSort(nextToken());
+    if (!sorts.empty())
+    {
+      t = d_parser->mkFlatFunctionType(sorts, t);
+    }
+    if (t.isFunction())
+    {
+      d_parser->checkLogicAllowsFunctions();
+    }
+    expect(TOK_RPAREN);
+    api::Term func =
+        d_parser->bindVar(name, t, ExprManager::VAR_FLAG_NONE, true);
+    // a previous binding of name is now overloaded
+    invalidateSymbol(id);
+    result.reset(new DeclareFunctionCommand(name, func.getExpr(), t.getType()));
+    return result.release();
+  }
+  else if (cmd == "define-fun")
+  {
+    d_parser->checkThatLogicIsSet();
+    size_t id = getSymbolId(nextToken());
+    std::string name = d_symbols[id].d_name;
+    d_parser->checkDeclaration(name, CHECK_UNDECLARED, SYM_VARIABLE);
+    d_parser->checkUserSymbol(name);
+    std::vector<std::pair<std::string, api::Sort> > sortedVarNames;
+    std::vector<size_t> varIds;
+    std::vector<api::Sort> sorts;
+    expect(TOK_LPAREN);
+    for (Token s = nextToken(); s.d_kind != TOK_RPAREN; s = nextToken())
+    {
+      if (s.d_kind != TOK_LPAREN)
+      {
+        throw Unsupported();
+      }
+      varIds.push_back(getSymbolId(nextToken()));
+      sorts.push_back(parseSort(nextToken()));
+      sortedVarNames.push_back(
+          std::make_pair(d_symbols[varIds.back()].d_name, sorts.back()));
+      expect(TOK_RPAREN);
+    }
+    api::Sort t = parseSort(nextToken());
+    if (!sorts.empty())
+    {
+      std::vector<api::Term> flattenVars;
+      t = d_parser->mkFlatFunctionType(sorts, t, flattenVars);
+      if (!flattenVars.empty())
+      {
+        throw Unsupported();
+      }
+    }
+    d_parser->pushScope(true);
+    std::vector<api::Term> terms = d_parser->bindBoundVars(sortedVarNames);
+    for (size_t vid : varIds)
+    {
+      invalidateSymbol(vid);
+    }
+    api::Term e = parseTerm(nextToken());
+    d_parser->popScope();
+    for (size_t vid : varIds)
+    {
+      invalidateSymbol(vid);
+    }
+    expect(TOK_RPAREN);
+    api::Term func =
+        d_parser->bindVar(name, t, ExprManager::VAR_FLAG_DEFINED, true);
+    invalidateSymbol(id);
+    result.reset(new DefineFunctionCommand(
+        name, func.getExpr(), api::termVectorToExprs(terms), e.getExpr()));
+    return result.release();
+  }
+  else if (cmd == "check-sat")
+  {
+    d_parser->checkThatLogicIsSet();
+    result.reset(new CheckSatCommand());
+  }
+  else if (cmd == "push" || cmd == "pop")
+  {
+    d_parser->checkThatLogicIsSet();
+    Token n = expect(TOK_NUMERAL);
+    expect(TOK_RPAREN);
+    if (n.d_length != 1 || n.d_begin[0] != '1'
+        || (cmd == "pop" && d_parser->scopeLevel() == 0))
+    {
+      throw Unsupported();
+    }
+    // the declarations of the scope may be global or not
+    ++d_epoch;
+    if (cmd == "push")
+    {
+      d_parser->pushScope();
+      return new PushCommand();
+    }
+    d_parser->popScope();
+    return new PopCommand();
+  }
+  else if (cmd == "get-model")
+  {
+    d_parser->checkThatLogicIsSet();
+    result.reset(new GetModelCommand());
+  }
+  else if (cmd == "exit")
+  {
+    result.reset(new QuitCommand());
+  }
+  else
+  {
+    throw Unsupported();
+  }
+  expect(TOK_RPAREN);
+  return result.release();
+}
+
+api::Sort Smt2FastInput::parseSort(const Token& t)
+{
+  if (t.d_kind == TOK_LPAREN)
+  {
+    Token u = expect(TOK_SYMBOL);
+    if (u.getText() != "_")
+    {
+      throw Unsupported();
+    }
+    std::string name;
+    std::vector<uint64_t> indices = parseIndices(name);
+    if (name != "BitVec" || indices.size() != 1 || indices[0] == 0)
+    {
+      throw Unsupported();
+    }
+    return d_parser->getSolver()->mkBitVectorSort(indices[0]);
+  }
+  std::string name = getSymbol(t);
+  d_parser->checkDeclaration(name, CHECK_DECLARED, SYM_SORT);
+  return d_parser->getSort(name);
+}
+
+std::vector<uint64_t> Smt2FastInput::parseIndices(std::string& sym)
+{
+  sym = getSymbol(nextToken());
+  std::vector<uint64_t> indices;
+  for (Token n = nextToken(); n.d_kind != TOK_RPAREN; n = nextToken())
+  {
+    if (n.d_kind != TOK_NUMERAL || n.d_length > 9)
+    {
+      throw Unsupported();
+    }
+    uint64_t index = 0;
+    for (size_t i = 0; i < n.d_length; ++i)
+    {
+      index = index * 10 + (n.d_begin[i] - '0');
+    }
+    indices.push_back(index);
+  }
+  if (indices.empty())
+  {
+    throw Unsupported();
+  }
+  return indices;
+}
+
+api::Term Smt2FastInput::parseTerm(const Token& t)
+{
+  api::Solver* solver = d_parser->getSolver();
+  switch (t.d_kind)
+  {
+    case TOK_NUMERAL: return solver->mkReal(t.getText());
+    case TOK_DECIMAL:
+      return solver->ensureTermSort(solver->mkReal(t.getText()),
+                                    solver->getRealSort());
+    case TOK_HEX:
+      return solver->mkBitVector(std::string(t.d_begin + 2, t.d_length - 2),
+                                 16);
+    case TOK_BINARY:
+      return solver->mkBitVector(std::string(t.d_begin + 2, t.d_length - 2),
+                                 2);
+    case TOK_SYMBOL:
+    {
+      Symbol& s = getResolvedSymbol(getSymbolId(t));
+      if (s.d_term.isNull())
+      {
+        ParseOp p;
+        p.d_name = s.d_name;
+        s.d_term = d_parser->parseOpToExpr(p);
+      }
+      return s.d_term;
+    }
+    case TOK_LPAREN: return parseCompoundTerm();
+    default: throw Unsupported();
+  }
+}
+
+api::Term Smt2FastInput::parseCompoundTerm()
+{
+  Token head = nextToken();
+  ParseOp p;
+  if (head.d_kind == TOK_LPAREN)
+  {
+    // an indexed operator, e.g. ((_ extract 7 0) x)
+    if (expect(TOK_SYMBOL).getText() != "_")
+    {
+      throw Unsupported();
+    }
+    std::string sym;
+    std::vector<uint64_t> indices = parseIndices(sym);
+    p.d_op = d_parser->mkIndexedOp(sym, indices);
+  }
+  else if (head.d_kind == TOK_SYMBOL && head.d_begin[0] != '|'
+           && head.getText() == "_")
+  {
+    // an indexed constant, e.g. (_ bv5 32)
+    std::string sym;
+    std::vector<uint64_t> indices = parseIndices(sym);
+    return d_parser->mkIndexedConstant(sym, indices);
+  }
+  else if (head.d_kind == TOK_SYMBOL && head.d_begin[0] != '|'
+           && head.getText() == "let")
+  {
+    expect(TOK_LPAREN);
+    std::vector<std::pair<size_t, api::Term> > binders;
+    std::unordered_set<size_t> ids;
+    for (Token b = nextToken(); b.d_kind != TOK_RPAREN; b = nextToken())
+    {
+      if (b.d_kind != TOK_LPAREN)
+      {
+        throw Unsupported();
+      }
+      size_t id = getSymbolId(nextToken());
+      if (!ids.insert(id).second)
+      {
+        // the grammar warns about shadowed bindings
+        throw Unsupported();
+      }
+      binders.push_back(std::make_pair(id, parseTerm(nextToken())));
+      expect(TOK_RPAREN);
+    }
+    if (binders.empty())
+    {
+      throw Unsupported();
+    }
+    d_parser->pushScope(true);
+    for (const std::pair<size_t, api::Term>& binder : binders)
+    {
+      d_parser->defineVar(d_symbols[binder.first].d_name, binder.second);
+      invalidateSymbol(binder.first);
+    }
+    api::Term body = parseTerm(nextToken());
+    expect(TOK_RPAREN);
+    d_parser->popScope();
+    for (const std::pair<size_t, api::Term>& binder : binders)
+    {
+      invalidateSymbol(binder.first);
+    }
+    return body;
+  }
+  else
+  {
+    Symbol& s = getResolvedSymbol(getSymbolId(head));
+    if (!s.d_headResolved)
+    {
+      // declared functions are applied as explicit operators, the builtin
+      // operators and overloaded symbols are resolved by the grammar
+      if (!d_parser->isOperatorEnabled(s.d_name)
+          && d_parser->isDeclared(s.d_name, SYM_VARIABLE))
+      {
+        api::Term v = d_parser->getVariable(s.d_name);
+        if (!v.isNull() && v.getSort().isFunction())
+        {
+          s.d_function = v;
+        }
+      }
+      s.d_headResolved = true;
+    }
+    if (s.d_function.isNull())
+    {
+      p.d_name = s.d_name;
+    }
+    else
+    {
+      p.d_expr = s.d_function;
+    }
+  }
+  std::vector<api::Term> args;
+  for (Token a = nextToken(); a.d_kind != TOK_RPAREN; a = nextToken())
+  {
+    args.push_back(parseTerm(a));
+  }
+  if (args.empty())
+  {
+    throw Unsupported();
+  }
+  return d_parser->applyParseOp(p, args);
+}
+
+Input* Smt2FastInput::newFallbackInput(const char* begin, size_t line)
+{
+  Trace("parser-fast") << "falling back to the grammar at line " << line
+                       << std::endl;
+  // the grammar may bind any symbol
+  ++d_epoch;
+  Input* input = Input::newStringInput(
+      d_lang, std::string(begin, d_pos - begin), getInputStream()->getName());
+  input->setParser(*d_parser);
+  return input;
+}
+
+void Smt2FastInput::rethrowShifted(const ParserException& e, size_t line)
+{
+  if (e.getLine() <= 0)
+  {
+    throw;
+  }
+  throw ParserException(e.getMessage(),
+                        getInputStream()->getName(),
+                        e.getLine() + line - 1,
+                        e.getColumn());
+}
+
+Command* Smt2FastInput::fallbackCommand(const char* begin, size_t line)
+{
+  std::unique_ptr<Input> input(newFallbackInput(begin, line));
+  try
+  {
+    return input->parseCommand();
+  }
+  catch (ParserEndOfFileException&)
+  {
+    throw;
+  }
+  catch (FileParserException&)
+  {
+    throw;
+  }
+  catch (ParserException& e)
+  {
+    rethrowShifted(e, line);
+  }
+  return nullptr;
+}
+
+api::Term Smt2FastInput::fallbackExpr(const char* begin, size_t line)
+{
+  std::unique_ptr<Input> input(newFallbackInput(begin, line));
+  try
+  {
+    return input->parseExpr();
+  }
+  catch (ParserEndOfFileException&)
+  {
+    throw;
+  }
+  catch (FileParserException&)
+  {
+    throw;
+  }
+  catch (ParserException& e)
+  {
+    rethrowShifted(e, line);
+  }
+  return api::Term();
+}
+
+}  // namespace parser
+}  // namespace CVC4
@@ -0,0 +1,224 @@
+/*********************                                                        */
+/*! \file smt2_fast_input.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A hand-written SMT-LIB 2 input over a memory-mapped file
+ **
+ ** A hand-written SMT-LIB 2 input over a memory-mapped file.  The lexer
+ ** works directly on the mapped bytes.  The parser handles the common
+ ** subset of commands used by generated benchmarks (declarations, define-fun,
+ ** assert, check-sat, push/pop, ...) over terms made of literals, symbols,
+ ** function applications, indexed operators and let.  It builds terms
+ ** through the same Smt2 parser state as the ANTLR grammar.  Any command
+ ** outside of that subset, or with an error, is handed as text to the
+ ** ANTLR parser, which produces the command or the error message.
+ **/
+
+#include "cvc4parser_private.h"
+
+#ifndef CVC4__PARSER__SMT2_FAST_INPUT_H
+#define CVC4__PARSER__SMT2_FAST_INPUT_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "api/cvc4cpp.h"
+#include "options/language.h"
+#include "parser/input.h"
+#include "parser/parser_exception.h"
+
+namespace CVC4 {
+
+class Command;
+
+namespace parser {
+
+class Smt2;
+
+class Smt2FastInput : public Input
+{
+ public:
+  /**
+   * Create an input for the given file, which is mapped into memory.
+   *
+   * @throws InputStreamException if the file cannot be mapped
+   */
+  Smt2FastInput(InputLanguage lang, const std::string& filename);
+  ~Smt2FastInput() override;
+
+ protected:
+  /**
+   * Parse a command from the input. Returns <code>NULL</code> if there is
+   * no command there to parse.
+   *
+   * @throws ParserException if an error is encountered during parsing.
+   */
+  Command* parseCommand() override;
+
+  /**
+   * Parse an expression from the input. Returns a null term if there is no
+   * expression there to parse.
+   *
+   * @throws ParserException if an error is encountered during parsing.
+   */
+  api::Term parseExpr() override;
+
+  void warning(const std::string& msg) override;
+
+  void parseError(const std::string& msg, bool eofException = false) override;
+
+  void setParser(Parser& parser) override;
+
+ private:
+  /** The kinds of tokens. */
+  enum TokenKind
+  {
+    TOK_EOF,
+    TOK_LPAREN,
+    TOK_RPAREN,
+    TOK_SYMBOL,
+    TOK_NUMERAL,
+    TOK_DECIMAL,
+    TOK_HEX,
+    TOK_BINARY,
+    /** Keywords, strings and anything else the fast path does not handle. */
+    TOK_OTHER
+  };
+
+  /** A token, pointing into the mapped file. */
+  struct Token
+  {
+    TokenKind d_kind;
+    const char* d_begin;
+    size_t d_length;
+    /** Get the text of the token, without the bars of a quoted symbol. */
+    std::string getText() const;
+  };
+
+  /**
+   * A symbol interned by the fast path, with the resolutions of its last
+   * occurrences.  The resolutions are valid while d_epoch is the epoch of the
+   * input and the symbol was not rebound.
+   */
+  struct Symbol
+  {
+    Symbol(const std::string& name, bool reserved)
+        : d_name(name), d_reserved(reserved), d_headResolved(false), d_epoch(0)
+    {
+    }
+    /** The name of the symbol, without the bars. */
+    std::string d_name;
+    /** Whether the unquoted symbol is a reserved word of the grammar. */
+    bool d_reserved;
+    /** The term of the symbol in term position. */
+    api::Term d_term;
+    /**
+     * Whether the symbol in head position was resolved, to d_function if it
+     * is a declared function and to the parse op of the grammar otherwise.
+     */
+    bool d_headResolved;
+    api::Term d_function;
+    /** The epoch of the resolutions. */
+    size_t d_epoch;
+  };
+
+  /** Thrown internally when the fast path cannot handle the input. */
+  struct Unsupported
+  {
+  };
+
+  /** A parse error whose position is already relative to the whole file. */
+  struct FileParserException : public ParserException
+  {
+    FileParserException(const std::string& msg,
+                        const std::string& filename,
+                        unsigned long line,
+                        unsigned long column)
+        : ParserException(msg, filename, line, column)
+    {
+    }
+  };
+
+  /** Lex the next token, updating the position and line. */
+  Token nextToken();
+  /** Skip whitespace and comments. */
+  void skipWhitespace();
+  /** Lex the next token, which must be of kind k. */
+  Token expect(TokenKind k);
+  /** Skip the rest of the S-expression that was opened before d_pos. */
+  void skipToClose();
+
+  /** Parse a command after its opening parenthesis. */
+  Command* parseCommandBody();
+  /** Parse a term starting at token t. */
+  api::Term parseTerm(const Token& t);
+  /** Parse the rest of an application or let after the opening paren. */
+  api::Term parseCompoundTerm();
+  /** Parse the rest of (_ sym num+) after the `_', returning the numerals. */
+  std::vector<uint64_t> parseIndices(std::string& sym);
+  /** Parse a sort starting at token t. */
+  api::Sort parseSort(const Token& t);
+  /** Get the id of a symbol that is not a reserved word of the grammar. */
+  size_t getSymbolId(const Token& t);
+  /** Get the text of a symbol that is not a reserved word of the grammar. */
+  std::string getSymbol(const Token& t);
+  /** Get the symbol of id, whose resolutions are cleared if they are stale. */
+  Symbol& getResolvedSymbol(size_t id);
+  /** Clear the resolutions of the symbol of id, which was (un)bound. */
+  void invalidateSymbol(size_t id) { d_symbols[id].d_epoch = 0; }
+
+  /**
+   * Parse the text between begin and d_pos, which starts on the given line,
+   * with the ANTLR grammar.
+   */
+  Command* fallbackCommand(const char* begin, size_t line);
+  api::Term fallbackExpr(const char* begin, size_t line);
+  /** Create an ANTLR input for the text between begin and d_pos. */
+  Input* newFallbackInput(const char* begin, size_t line);
+  /** Rethrow e with its line shifted to the position of the fallback. */
+  void rethrowShifted(const ParserException& e, size_t line);
+
+  /** The input language. */
+  InputLanguage d_lang;
+  /** The Smt2 parser state. */
+  Smt2* d_parser;
+  /** The mapped file. */
+  const char* d_begin;
+  const char* d_end;
+  /** The current position in the mapped file. */
+  const char* d_pos;
+  /** The line of d_pos, counting from 1. */
+  size_t d_line;
+  /** The position following the last newline before d_pos. */
+  const char* d_lineBegin;
+  /** The start of the command or term being parsed, for error messages. */
+  const char* d_startPos;
+  size_t d_startLine;
+  const char* d_startLineBegin;
+
+  /** The ids of the interned symbols. */
+  std::unordered_map<std::string, size_t> d_symbolIds;
+  /** The interned symbols, by id. */
+  std::vector<Symbol> d_symbols;
+  /** The text of the last symbol, reused to look up its id. */
+  std::string d_symbolText;
+  /**
+   * The epoch of the symbol resolutions, incremented when the symbols may be
+   * rebound outside of the fast path: on push, pop and fallbacks to the
+   * grammar.
+   */
+  size_t d_epoch;
+}; /* class Smt2FastInput */
+
+}  // namespace parser
+}  // namespace CVC4
+
+#endif /* CVC4__PARSER__SMT2_FAST_INPUT_H */
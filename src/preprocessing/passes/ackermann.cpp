@@ -26,6 +26,8 @@
 #include "base/check.h"
 #include "expr/node_algorithm.h"
 #include "options/options.h"
+#include "options/smt_options.h"
+#include "theory/rewriter.h"
 
 using namespace CVC4;
 using namespace CVC4::theory;
@@ -44,7 +46,7 @@ void addLemmaForPair(TNode args1,
                      AssertionPipeline* assertionsToPreprocess,
                      NodeManager* nm)
 {
-  Node args_eq;
+  std::vector<Node> eqs;
 
   if (args1.getKind() == kind::APPLY_UF)
   {
@@ -53,19 +55,9 @@ void addLemmaForPair(TNode args1,
     Assert(args1.getNumChildren() == args2.getNumChildren());
     Assert(args1.getNumChildren() >= 1);
 
-    std::vector<Node> eqs(args1.getNumChildren());
-
     for (unsigned i = 0, n = args1.getNumChildren(); i < n; ++i)
     {
-      eqs[i] = nm->mkNode(kind::EQUAL, args1[i], args2[i]);
-    }
-    if (eqs.size() >= 2)
-    {
-      args_eq = nm->mkNode(kind::AND, eqs);
-    }
-    else
-    {
-      args_eq = eqs[0];
+      eqs.push_back(nm->mkNode(kind::EQUAL, args1[i], args2[i]));
     }
   }
   else
@@ -74,9 +66,37 @@ void addLemmaForPair(TNode args1,
     Assert(args2.getKind() == kind::SELECT && args2[0] == func);
     Assert(args1.getNumChildren() == 2);
     Assert(args2.getNumChildren() == 2);
-    args_eq = nm->mkNode(kind::EQUAL, args1[1], args2[1]);
+    eqs.push_back(nm->mkNode(kind::EQUAL, args1[1], args2[1]));
+  }
+  if (options::ackermannPrune())
+  {
+    /* The lemma is dropped if an argument equality rewrites to false, and
+     * the argument equalities that rewrite to true are dropped from the
+     * premise. The premise keeps the equalities as they are, so that the
+     * applications they contain are replaced by their skolems. */
+    std::vector<Node> premises;
+    for (const Node& eq : eqs)
+    {
+      Node req = Rewriter::rewrite(eq);
+      if (req.isConst())
+      {
+        if (!req.getConst<bool>())
+        {
+          return;
+        }
+        continue;
+      }
+      premises.push_back(eq);
+    }
+    eqs.swap(premises);
   }
   Node func_eq = nm->mkNode(kind::EQUAL, args1, args2);
+  if (eqs.empty())
+  {
+    assertionsToPreprocess->push_back(func_eq);
+    return;
+  }
+  Node args_eq = eqs.size() >= 2 ? nm->mkNode(kind::AND, eqs) : eqs[0];
   Node lemma = nm->mkNode(kind::IMPLIES, args_eq, func_eq);
   assertionsToPreprocess->push_back(lemma);
 }
@@ -46,6 +46,11 @@ PreprocessingPassResult BvAbstraction::applyInternal(
                                assertionsToPreprocess->end());
   TheoryEngine* te = d_preprocContext->getTheoryEngine();
   bv::TheoryBV* bv_theory = static_cast<bv::TheoryBV*>(te->theoryOf(THEORY_BV));
+  if (bv_theory == nullptr)
+  {
+    // bit-vectors are not in the logic
+    return PreprocessingPassResult::NO_CONFLICT;
+  }
   bool changed = bv_theory->applyAbstraction(assertions, new_assertions);
   for (unsigned i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
   {
@@ -23,6 +23,7 @@
 #include "theory/rewriter.h"
 #include "util/bitvector.h"
 
+#include <cstdint>
 #include <unordered_map>
 #include <vector>
 
@@ -55,6 +56,317 @@ Integer get_bv_const_value(Node n)
   return get_bv_const(n).getConst<BitVector>().getValue();
 }
 
+/**
+ * Gaussian Elimination modulo 'prime' on Integers, see BVGauss::gaussElim.
+ * Returns false if an element of a pivot column is not coprime to 'prime'.
+ */
+bool gaussElimInteger(const Integer& prime,
+                      std::vector<Integer>& rhs,
+                      std::vector<std::vector<Integer>>& lhs)
+{
+  size_t nrows = lhs.size();
+  size_t ncols = lhs[0].size();
+
+  /* (1) if element in pivot column is non-zero and != 1, divide row elements
+   *     by element in pivot column modulo prime, i.e., multiply row with
+   *     multiplicative inverse of element in pivot column modulo prime
+   *
+   * (2) subtract pivot row from all rows below pivot row
+   *
+   * (3) subtract (multiple of) current row from all rows above s.t. all
+   *     elements in current pivot column above current row become equal to one
+   *
+   * Note: we do not normalize the given matrix to values modulo prime
+   *       beforehand but on-the-fly. */
+
+  /* pivot = lhs[pcol][pcol] */
+  for (size_t pcol = 0, prow = 0; pcol < ncols && prow < nrows; ++pcol, ++prow)
+  {
+    /* lhs[j][pcol]: element in pivot column */
+    for (size_t j = prow; j < nrows; ++j)
+    {
+#ifdef CVC4_ASSERTIONS
+      for (size_t k = 0; k < pcol; ++k)
+      {
+        Assert(lhs[j][k] == 0);
+      }
+#endif
+      /* normalize element in pivot column to modulo prime */
+      lhs[j][pcol] = lhs[j][pcol].euclidianDivideRemainder(prime);
+      /* exchange rows if pivot elem is 0 */
+      if (j == prow)
+      {
+        while (lhs[j][pcol] == 0)
+        {
+          for (size_t k = prow + 1; k < nrows; ++k)
+          {
+            lhs[k][pcol] = lhs[k][pcol].euclidianDivideRemainder(prime);
+            if (lhs[k][pcol] != 0)
+            {
+              std::swap(rhs[j], rhs[k]);
+              std::swap(lhs[j], lhs[k]);
+              break;
+            }
+          }
+          if (pcol >= ncols - 1) break;
+          if (lhs[j][pcol] == 0)
+          {
+            pcol += 1;
+            if (lhs[j][pcol] != 0)
+              lhs[j][pcol] = lhs[j][pcol].euclidianDivideRemainder(prime);
+          }
+        }
+      }
+
+      if (lhs[j][pcol] != 0)
+      {
+        /* (1) */
+        if (lhs[j][pcol] != 1)
+        {
+          Integer inv = lhs[j][pcol].modInverse(prime);
+          if (inv == -1)
+          {
+            return false; /* not coprime */
+          }
+          for (size_t k = pcol; k < ncols; ++k)
+          {
+            lhs[j][k] = lhs[j][k].modMultiply(inv, prime);
+            if (j <= prow) continue; /* pivot */
+            lhs[j][k] = lhs[j][k].modAdd(-lhs[prow][k], prime);
+          }
+          rhs[j] = rhs[j].modMultiply(inv, prime);
+          if (j > prow) { rhs[j] = rhs[j].modAdd(-rhs[prow], prime); }
+        }
+        /* (2) */
+        else if (j != prow)
+        {
+          for (size_t k = pcol; k < ncols; ++k)
+          {
+            lhs[j][k] = lhs[j][k].modAdd(-lhs[prow][k], prime);
+          }
+          rhs[j] = rhs[j].modAdd(-rhs[prow], prime);
+        }
+      }
+    }
+    /* (3) */
+    for (size_t j = 0; j < prow; ++j)
+    {
+      Integer mul = lhs[j][pcol];
+      if (mul != 0)
+      {
+        for (size_t k = pcol; k < ncols; ++k)
+        {
+          lhs[j][k] = lhs[j][k].modAdd(-lhs[prow][k] * mul, prime);
+        }
+        rhs[j] = rhs[j].modAdd(-rhs[prow] * mul, prime);
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * The multiplicative inverse of 'a' modulo 'm', or 0 if they are not coprime.
+ */
+uint64_t modInverseWord(uint64_t a, uint64_t m)
+{
+  int64_t t = 0, newt = 1;
+  int64_t r = m, newr = a;
+  while (newr != 0)
+  {
+    int64_t q = r / newr;
+    int64_t tmp = t - q * newt;
+    t = newt;
+    newt = tmp;
+    tmp = r - q * newr;
+    r = newr;
+    newr = tmp;
+  }
+  if (r != 1)
+  {
+    return 0;
+  }
+  return t < 0 ? t + m : t;
+}
+
+/**
+ * Gaussian Elimination modulo a 'prime' that fits into 32 bits.
+ *
+ * Performs the same row operations as gaussElimInteger, but on machine words
+ * normalized to [0, prime) rather than on arbitrary precision Integers, which
+ * is significantly faster for the (common) case of small moduli.
+ */
+bool gaussElimWord(uint64_t prime,
+                   std::vector<Integer>& rhs,
+                   std::vector<std::vector<Integer>>& lhs)
+{
+  size_t nrows = lhs.size();
+  size_t ncols = lhs[0].size();
+  Integer iprime(prime);
+
+  /* the right hand side is stored as column 'ncols' */
+  std::vector<std::vector<uint64_t>> mat(nrows,
+                                         std::vector<uint64_t>(ncols + 1));
+  for (size_t i = 0; i < nrows; ++i)
+  {
+    for (size_t j = 0; j < ncols; ++j)
+    {
+      mat[i][j] = lhs[i][j].euclidianDivideRemainder(iprime).getUnsignedInt();
+    }
+    mat[i][ncols] = rhs[i].euclidianDivideRemainder(iprime).getUnsignedInt();
+  }
+
+  /* row[k] = row[k] * mul for k >= pcol */
+  auto scale = [prime, ncols](std::vector<uint64_t>& row,
+                              size_t pcol,
+                              uint64_t mul) {
+    for (size_t k = pcol; k <= ncols; ++k)
+    {
+      row[k] = row[k] * mul % prime;
+    }
+  };
+  /* row[k] = row[k] - piv[k] * mul for k >= pcol */
+  auto subtract = [prime, ncols](std::vector<uint64_t>& row,
+                                 const std::vector<uint64_t>& piv,
+                                 size_t pcol,
+                                 uint64_t mul) {
+    for (size_t k = pcol; k <= ncols; ++k)
+    {
+      uint64_t m = piv[k] * mul % prime;
+      row[k] = row[k] >= m ? row[k] - m : row[k] + prime - m;
+    }
+  };
+
+  for (size_t pcol = 0, prow = 0; pcol < ncols && prow < nrows; ++pcol, ++prow)
+  {
+    for (size_t j = prow; j < nrows; ++j)
+    {
+      /* exchange rows if pivot elem is 0 */
+      if (j == prow)
+      {
+        while (mat[j][pcol] == 0)
+        {
+          for (size_t k = prow + 1; k < nrows; ++k)
+          {
+            if (mat[k][pcol] != 0)
+            {
+              std::swap(mat[j], mat[k]);
+              break;
+            }
+          }
+          if (pcol >= ncols - 1) break;
+          if (mat[j][pcol] == 0)
+          {
+            pcol += 1;
+          }
+        }
+      }
+
+      if (mat[j][pcol] != 0)
+      {
+        if (mat[j][pcol] != 1)
+        {
+          uint64_t inv = modInverseWord(mat[j][pcol], prime);
+          if (inv == 0)
+          {
+            return false; /* not coprime */
+          }
+          scale(mat[j], pcol, inv);
+          if (j > prow)
+          {
+            subtract(mat[j], mat[prow], pcol, 1);
+          }
+        }
+        else if (j != prow)
+        {
+          subtract(mat[j], mat[prow], pcol, 1);
+        }
+      }
+    }
+    for (size_t j = 0; j < prow; ++j)
+    {
+      uint64_t mul = mat[j][pcol];
+      if (mul != 0)
+      {
+        subtract(mat[j], mat[prow], pcol, mul);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < nrows; ++i)
+  {
+    for (size_t j = 0; j < ncols; ++j)
+    {
+      lhs[i][j] = Integer(mat[i][j]);
+    }
+    rhs[i] = Integer(mat[i][ncols]);
+  }
+  return true;
+}
+
+/**
+ * Gaussian Elimination modulo 2.
+ *
+ * The rows are packed into bitsets of 64-bit words (with the right hand side
+ * as the last bit), so that a row operation is a word-wise exclusive or.
+ * Since Z/2Z is a field, the resulting reduced row echelon form is the same
+ * as the one computed by gaussElimInteger.
+ */
+void gaussElimGF2(std::vector<Integer>& rhs,
+                  std::vector<std::vector<Integer>>& lhs)
+{
+  size_t nrows = lhs.size();
+  size_t ncols = lhs[0].size();
+  size_t nwords = (ncols + 1 + 63) / 64;
+  Integer two(2);
+
+  std::vector<std::vector<uint64_t>> mat(nrows,
+                                         std::vector<uint64_t>(nwords, 0));
+  auto bit = [&mat](size_t i, size_t j) {
+    return (mat[i][j / 64] >> (j % 64)) & 1;
+  };
+  for (size_t i = 0; i < nrows; ++i)
+  {
+    for (size_t j = 0; j <= ncols; ++j)
+    {
+      const Integer& val = j < ncols ? lhs[i][j] : rhs[i];
+      if (val.euclidianDivideRemainder(two) != 0)
+      {
+        mat[i][j / 64] |= uint64_t(1) << (j % 64);
+      }
+    }
+  }
+
+  for (size_t pcol = 0, prow = 0; pcol < ncols && prow < nrows; ++pcol)
+  {
+    size_t k = prow;
+    while (k < nrows && !bit(k, pcol)) ++k;
+    if (k == nrows) continue;
+    std::swap(mat[prow], mat[k]);
+    const std::vector<uint64_t>& piv = mat[prow];
+    for (size_t j = 0; j < nrows; ++j)
+    {
+      if (j == prow || !bit(j, pcol)) continue;
+      std::vector<uint64_t>& row = mat[j];
+      /* the pivot row is zero in the words left of the pivot */
+      for (size_t w = pcol / 64; w < nwords; ++w)
+      {
+        row[w] ^= piv[w];
+      }
+    }
+    ++prow;
+  }
+
+  for (size_t i = 0; i < nrows; ++i)
+  {
+    for (size_t j = 0; j < ncols; ++j)
+    {
+      lhs[i][j] = Integer(static_cast<unsigned>(bit(i, j)));
+    }
+    rhs[i] = Integer(static_cast<unsigned>(bit(i, ncols)));
+  }
+}
+
 }  // namespace
 
 /**
@@ -240,6 +552,9 @@ unsigned BVGauss::getMinBwExpr(Node expr)
  * of the given matrix, respectively. The resulting matrix (in row echelon
  * form) is stored in 'rhs' and 'lhs', i.e., the given matrix is overwritten
  * with the resulting matrix.
+ *
+ * Systems modulo 2 and modulo numbers that fit into 32 bits are eliminated on
+ * machine words rather than on Integers.
  */
 BVGauss::Result BVGauss::gaussElim(Integer prime,
                                    std::vector<Integer>& rhs,
@@ -265,100 +580,23 @@ BVGauss::Result BVGauss::gaussElim(Integer prime,
   #ifdef CVC4_ASSERTIONS
   for (size_t i = 1; i < nrows; ++i) Assert(lhs[i].size() == ncols);
 #endif
-  /* (1) if element in pivot column is non-zero and != 1, divide row elements
-   *     by element in pivot column modulo prime, i.e., multiply row with
-   *     multiplicative inverse of element in pivot column modulo prime
-   *
-   * (2) subtract pivot row from all rows below pivot row
-   *
-   * (3) subtract (multiple of) current row from all rows above s.t. all
-   *     elements in current pivot column above current row become equal to one
-   *
-   * Note: we do not normalize the given matrix to values modulo prime
-   *       beforehand but on-the-fly. */
-
-  /* pivot = lhs[pcol][pcol] */
-  for (size_t pcol = 0, prow = 0; pcol < ncols && prow < nrows; ++pcol, ++prow)
+  bool coprime;
+  if (prime == 2)
   {
-    /* lhs[j][pcol]: element in pivot column */
-    for (size_t j = prow; j < nrows; ++j)
-    {
-#ifdef CVC4_ASSERTIONS
-      for (size_t k = 0; k < pcol; ++k)
-      {
-        Assert(lhs[j][k] == 0);
-      }
-#endif
-      /* normalize element in pivot column to modulo prime */
-      lhs[j][pcol] = lhs[j][pcol].euclidianDivideRemainder(prime);
-      /* exchange rows if pivot elem is 0 */
-      if (j == prow)
-      {
-        while (lhs[j][pcol] == 0)
-        {
-          for (size_t k = prow + 1; k < nrows; ++k)
-          {
-            lhs[k][pcol] = lhs[k][pcol].euclidianDivideRemainder(prime);
-            if (lhs[k][pcol] != 0)
-            {
-              std::swap(rhs[j], rhs[k]);
-              std::swap(lhs[j], lhs[k]);
-              break;
-            }
-          }
-          if (pcol >= ncols - 1) break;
-          if (lhs[j][pcol] == 0)
-          {
-            pcol += 1;
-            if (lhs[j][pcol] != 0)
-              lhs[j][pcol] = lhs[j][pcol].euclidianDivideRemainder(prime);
-          }
-        }
-      }
-
-      if (lhs[j][pcol] != 0)
-      {
-        /* (1) */
-        if (lhs[j][pcol] != 1)
-        {
-          Integer inv = lhs[j][pcol].modInverse(prime);
-          if (inv == -1)
-          {
-            return BVGauss::Result::INVALID; /* not coprime */
-          }
-          for (size_t k = pcol; k < ncols; ++k)
-          {
-            lhs[j][k] = lhs[j][k].modMultiply(inv, prime);
-            if (j <= prow) continue; /* pivot */
-            lhs[j][k] = lhs[j][k].modAdd(-lhs[prow][k], prime);
-          }
-          rhs[j] = rhs[j].modMultiply(inv, prime);
-          if (j > prow) { rhs[j] = rhs[j].modAdd(-rhs[prow], prime); }
-        }
-        /* (2) */
-        else if (j != prow)
-        {
-          for (size_t k = pcol; k < ncols; ++k)
-          {
-            lhs[j][k] = lhs[j][k].modAdd(-lhs[prow][k], prime);
-          }
-          rhs[j] = rhs[j].modAdd(-rhs[prow], prime);
-        }
-      }
-    }
-    /* (3) */
-    for (size_t j = 0; j < prow; ++j)
-    {
-      Integer mul = lhs[j][pcol];
-      if (mul != 0)
-      {
-        for (size_t k = pcol; k < ncols; ++k)
-        {
-          lhs[j][k] = lhs[j][k].modAdd(-lhs[prow][k] * mul, prime);
-        }
-        rhs[j] = rhs[j].modAdd(-rhs[prow] * mul, prime);
-      }
-    }
+    gaussElimGF2(rhs, lhs);
+    coprime = true;
+  }
+  else if (prime.fitsUnsignedInt())
+  {
+    coprime = gaussElimWord(prime.getUnsignedInt(), rhs, lhs);
+  }
+  else
+  {
+    coprime = gaussElimInteger(prime, rhs, lhs);
+  }
+  if (!coprime)
+  {
+    return BVGauss::Result::INVALID;
   }
 
   bool ispart = false;
@@ -45,6 +45,9 @@ class BVGauss : public PreprocessingPass
   PreprocessingPassResult applyInternal(
       AssertionPipeline* assertionsToPreprocess) override;
 
+  /* The pass only rewrites the assertions. */
+  bool isCacheable() const override { return true; }
+
  private:
   /* Note: The following functionality is only exposed for unit testing in
    * pass_bv_gauss_white.h. */
@@ -329,6 +329,7 @@ Node BVToInt::bvToInt(Node n)
               BitVector constant(current.getConst<BitVector>());
               Integer c = constant.toInteger();
               d_bvToIntCache[current] = d_nm->mkConst<Rational>(c);
+              setUpperBound(current, c);
             }
             else
             {
@@ -361,6 +362,16 @@ Node BVToInt::bvToInt(Node n)
             case kind::BITVECTOR_PLUS:
             {
               uint64_t bvsize = current[0].getType().getBitVectorSize();
+              Integer ub =
+                  getUpperBound(current[0]) + getUpperBound(current[1]);
+              if (ub < Integer(2).pow(bvsize))
+              {
+                // the addition cannot overflow
+                d_bvToIntCache[current] =
+                    d_nm->mkNode(kind::PLUS, translated_children);
+                setUpperBound(current, ub);
+                break;
+              }
               /**
                * we avoid modular arithmetics by the addition of an
                * indicator variable sigma.
@@ -385,6 +396,16 @@ Node BVToInt::bvToInt(Node n)
             case kind::BITVECTOR_MULT:
             {
               uint64_t bvsize = current[0].getType().getBitVectorSize();
+              Integer ub =
+                  getUpperBound(current[0]) * getUpperBound(current[1]);
+              if (ub < Integer(2).pow(bvsize))
+              {
+                // the multiplication cannot overflow
+                d_bvToIntCache[current] =
+                    d_nm->mkNode(kind::MULT, translated_children);
+                setUpperBound(current, ub);
+                break;
+              }
               /**
                * we use a similar trick to the one used for addition.
                * Tr(a*b) is Tr(a)*Tr(b)-(sigma*2^k),
@@ -438,6 +459,14 @@ Node BVToInt::bvToInt(Node n)
                   d_nm->mkNode(kind::MINUS, pow2BvSize, d_one),
                   divNode);
               d_bvToIntCache[current] = ite;
+              if (current[1].isConst() && translated_children[1] != d_zero)
+              {
+                setUpperBound(current,
+                              getUpperBound(current[0]).floorDivideQuotient(
+                                  translated_children[1]
+                                      .getConst<Rational>()
+                                      .getNumerator()));
+              }
               break;
             }
             case kind::BITVECTOR_UREM_TOTAL:
@@ -451,6 +480,8 @@ Node BVToInt::bvToInt(Node n)
                   translated_children[0],
                   modNode);
               d_bvToIntCache[current] = ite;
+              // the remainder is at most the dividend
+              setUpperBound(current, getUpperBound(current[0]));
               break;
             }
             case kind::BITVECTOR_NEG:
@@ -496,6 +527,9 @@ Node BVToInt::bvToInt(Node n)
                                                granularity,
                                                &oneBitAnd);
               d_bvToIntCache[current] = newNode;
+              setUpperBound(current,
+                            Integer::min(getUpperBound(current[0]),
+                                         getUpperBound(current[1])));
               break;
             }
             case kind::BITVECTOR_OR:
@@ -582,6 +616,7 @@ Node BVToInt::bvToInt(Node n)
               uint64_t bvsize = current[0].getType().getBitVectorSize();
               Node newNode = createShiftNode(translated_children, bvsize, false);
               d_bvToIntCache[current] = newNode;
+              setUpperBound(current, getUpperBound(current[0]));
               break;
             }
             case kind::BITVECTOR_ASHR:
@@ -621,6 +656,9 @@ Node BVToInt::bvToInt(Node n)
               Node ite = d_nm->mkNode(
                   kind::ITE, cond, translated_children[1], translated_children[2]);
               d_bvToIntCache[current] = ite;
+              setUpperBound(current,
+                            Integer::max(getUpperBound(current[1]),
+                                         getUpperBound(current[2])));
               break;
             }
             case kind::BITVECTOR_CONCAT:
@@ -633,6 +671,10 @@ Node BVToInt::bvToInt(Node n)
               Node b = translated_children[1];
               Node sum = d_nm->mkNode(kind::PLUS, a, b);
               d_bvToIntCache[current] = sum;
+              Integer ub =
+                  getUpperBound(current[0]).multiplyByPow2(bvsizeRight)
+                  + getUpperBound(current[1]);
+              setUpperBound(current, ub);
               break;
             }
             case kind::BITVECTOR_EXTRACT:
@@ -644,9 +686,22 @@ Node BVToInt::bvToInt(Node n)
               uint64_t j = bv::utils::getExtractLow(current);
               Assert(d_bvToIntCache.find(a) != d_bvToIntCache.end());
               Assert(i >= j);
-              Node div = d_nm->mkNode(
-                  kind::INTS_DIVISION_TOTAL, d_bvToIntCache[a], pow2(j));
-              d_bvToIntCache[current] = modpow2(div, i - j + 1);
+              Integer ub = getUpperBound(a);
+              Node div = j == 0 ? d_bvToIntCache[a]
+                                : d_nm->mkNode(kind::INTS_DIVISION_TOTAL,
+                                               d_bvToIntCache[a],
+                                               pow2(j));
+              if (ub < Integer(2).pow(i + 1))
+              {
+                // the bits of a above i are zero
+                d_bvToIntCache[current] = div;
+                setUpperBound(current,
+                              ub.floorDivideQuotient(Integer(2).pow(j)));
+              }
+              else
+              {
+                d_bvToIntCache[current] = modpow2(div, i - j + 1);
+              }
               break;
             }
             case kind::EQUAL:
@@ -706,6 +761,12 @@ Node BVToInt::bvToInt(Node n)
             case kind::ITE:
             {
               d_bvToIntCache[current] = d_nm->mkNode(oldKind, translated_children);
+              if (current.getType().isBitVector())
+              {
+                setUpperBound(current,
+                              Integer::max(getUpperBound(current[1]),
+                                           getUpperBound(current[2])));
+              }
               break;
             }
             case kind::APPLY_UF:
@@ -825,6 +886,25 @@ bool BVToInt::childrenTypesChanged(Node n) {
   return result;
 }
 
+Integer BVToInt::getUpperBound(Node n)
+{
+  std::unordered_map<Node, Integer, NodeHashFunction>::const_iterator it =
+      d_upperBounds.find(n);
+  if (it != d_upperBounds.end())
+  {
+    return it->second;
+  }
+  return Integer(2).pow(n.getType().getBitVectorSize()) - 1;
+}
+
+void BVToInt::setUpperBound(Node n, const Integer& ub)
+{
+  if (ub < Integer(2).pow(n.getType().getBitVectorSize()) - 1)
+  {
+    d_upperBounds[n] = ub;
+  }
+}
+
 BVToInt::BVToInt(PreprocessingPassContext* preprocContext)
     : PreprocessingPass(preprocContext, "bv-to-int"),
       d_binarizeCache(),
@@ -899,12 +979,14 @@ Node BVToInt::createShiftNode(vector<Node> children,
    * Since we don't have exponentiation, we use the ite declared above.
    */
   kind::Kind_t then_kind = isLeftShift ? kind::MULT : kind::INTS_DIVISION_TOTAL;
-  return d_nm->mkNode(kind::ITE,
-                              d_nm->mkNode(kind::LT, y, d_nm->mkConst<Rational>(bvsize)),
-                              d_nm->mkNode(kind::INTS_MODULUS_TOTAL,
-                                                            d_nm->mkNode(then_kind, x, ite),
-                                                            pow2(bvsize)),
-                              d_zero);
+  Node shift = d_nm->mkNode(then_kind, x, ite);
+  // a right shift of x, which is in [0, 2^k), cannot wrap around
+  if (isLeftShift)
+  {
+    shift = d_nm->mkNode(kind::INTS_MODULUS_TOTAL, shift, pow2(bvsize));
+  }
+  Node inRange = d_nm->mkNode(kind::LT, y, d_nm->mkConst<Rational>(bvsize));
+  return d_nm->mkNode(kind::ITE, inRange, shift, d_zero);
 }
 
 Node BVToInt::createITEFromTable(
@@ -1004,14 +1086,24 @@ Node BVToInt::createBitwiseNode(Node x,
    */
   for (uint64_t i = 0; i < sumSize; i++)
   {
-    Node xExtract = d_nm->mkNode(
-        kind::INTS_MODULUS_TOTAL,
-        d_nm->mkNode(kind::INTS_DIVISION_TOTAL, x, pow2(i * granularity)),
-        pow2(granularity));
-    Node yExtract = d_nm->mkNode(
-        kind::INTS_MODULUS_TOTAL,
-        d_nm->mkNode(kind::INTS_DIVISION_TOTAL, y, pow2(i * granularity)),
-        pow2(granularity));
+    Node xExtract = x;
+    Node yExtract = y;
+    // x and y are in [0, 2^bvsize), hence the least significant chunk needs
+    // no division and the most significant chunk needs no modulus
+    if (i > 0)
+    {
+      xExtract =
+          d_nm->mkNode(kind::INTS_DIVISION_TOTAL, x, pow2(i * granularity));
+      yExtract =
+          d_nm->mkNode(kind::INTS_DIVISION_TOTAL, y, pow2(i * granularity));
+    }
+    if (i + 1 < sumSize)
+    {
+      xExtract = d_nm->mkNode(
+          kind::INTS_MODULUS_TOTAL, xExtract, pow2(granularity));
+      yExtract = d_nm->mkNode(
+          kind::INTS_MODULUS_TOTAL, yExtract, pow2(granularity));
+    }
     Node ite = createITEFromTable(xExtract, yExtract, granularity, table);
     sumNode =
         d_nm->mkNode(kind::PLUS,
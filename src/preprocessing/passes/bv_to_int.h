@@ -64,6 +64,7 @@
 
 #include "preprocessing/preprocessing_pass.h"
 #include "preprocessing/preprocessing_pass_context.h"
+#include "util/integer.h"
 
 namespace CVC4 {
 namespace preprocessing {
@@ -233,6 +234,19 @@ class BVToInt : public PreprocessingPass
 
   bool childrenTypesChanged(Node n);
 
+  /**
+   * Returns an upper bound of the value of the translation of the bit-vector
+   * term n, which is 2^k-1 for bit width k unless a smaller bound was
+   * recorded when n was translated.
+   */
+  Integer getUpperBound(Node n);
+
+  /**
+   * Records ub as an upper bound of the value of the translation of the
+   * bit-vector term n, if it is smaller than 2^k-1.
+   */
+  void setUpperBound(Node n, const Integer& ub);
+
   /**
    * Add the range assertions collected in d_rangeAssertions
    * (using mkRangeConstraint) to the assertion pipeline.
@@ -250,6 +264,13 @@ class BVToInt : public PreprocessingPass
   NodeMap d_rebuildCache;
   NodeMap d_bvToIntCache;
 
+  /**
+   * The upper bounds of the translations of bit-vector terms that are
+   * smaller than 2^k-1. They are used to drop the wrap-around of the
+   * additions, multiplications and extracts that cannot overflow.
+   */
+  std::unordered_map<Node, Integer, NodeHashFunction> d_upperBounds;
+
   /**
    * Node manager that is used throughout the pass
    */
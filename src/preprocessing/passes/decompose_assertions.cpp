@@ -0,0 +1,253 @@
+/*********************                                                        */
+/*! \file decompose_assertions.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Decomposes the assertions into independent components
+ **/
+
+#include "preprocessing/passes/decompose_assertions.h"
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "expr/node_algorithm.h"
+#include "options/smt_options.h"
+#include "smt/smt_statistics_registry.h"
+#include "theory/smt_engine_subsolver.h"
+#include "theory/theory_model.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+using namespace CVC4::theory;
+
+namespace {
+
+/** Returns the representative of i in the union-find parent. */
+size_t findRoot(std::vector<size_t>& parent, size_t i)
+{
+  while (parent[i] != i)
+  {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+
+}  // namespace
+
+DecomposeAssertions::DecomposeAssertions(
+    PreprocessingPassContext* preprocContext)
+    : PreprocessingPass(preprocContext, "decompose-assertions"){};
+
+DecomposeAssertions::Statistics::Statistics()
+    : d_components("preprocessing::passes::DecomposeAssertions::Components",
+                   0),
+      d_checked("preprocessing::passes::DecomposeAssertions::Checked", 0),
+      d_solved("preprocessing::passes::DecomposeAssertions::Solved", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_components);
+  smtStatisticsRegistry()->registerStat(&d_checked);
+  smtStatisticsRegistry()->registerStat(&d_solved);
+}
+
+DecomposeAssertions::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_components);
+  smtStatisticsRegistry()->unregisterStat(&d_checked);
+  smtStatisticsRegistry()->unregisterStat(&d_solved);
+}
+
+Result DecomposeAssertions::checkComponent(const std::vector<Node>& conjuncts,
+                                           const std::vector<Node>& syms)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  Node query = conjuncts.size() == 1 ? conjuncts[0]
+                                     : nm->mkNode(kind::AND, conjuncts);
+  ++d_statistics.d_checked;
+  if (!options::produceModels())
+  {
+    return checkWithSubsolver(query);
+  }
+  std::vector<Node> modelVals;
+  Result r = checkWithSubsolver(query, syms, modelVals);
+  if (r.asSatisfiabilityResult().isSat() == Result::SAT)
+  {
+    TheoryModel* m = d_preprocContext->getTheoryEngine()->getModel();
+    for (size_t i = 0, size = syms.size(); i < size; ++i)
+    {
+      m->addSubstitution(syms[i], modelVals[i]);
+    }
+  }
+  return r;
+}
+
+PreprocessingPassResult DecomposeAssertions::applyInternal(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  NodeManager* nm = NodeManager::currentNM();
+
+  // the conjuncts of the assertions, with the index of their assertion
+  std::vector<Node> conjuncts;
+  std::vector<size_t> assertionIndex;
+  for (size_t i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
+  {
+    std::vector<TNode> toVisit;
+    toVisit.push_back((*assertionsToPreprocess)[i]);
+    while (!toVisit.empty())
+    {
+      TNode cur = toVisit.back();
+      toVisit.pop_back();
+      if (cur.getKind() == kind::AND)
+      {
+        toVisit.insert(toVisit.end(), cur.begin(), cur.end());
+      }
+      else if (!cur.isConst() || !cur.getConst<bool>())
+      {
+        conjuncts.push_back(cur);
+        assertionIndex.push_back(i);
+      }
+    }
+  }
+
+  // the conjuncts that share a symbol are in the same component
+  std::vector<size_t> parent(conjuncts.size());
+  std::vector<std::unordered_set<Node, NodeHashFunction>> conjunctSyms(
+      conjuncts.size());
+  std::unordered_map<Node, size_t, NodeHashFunction> symConjunct;
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  for (size_t c = 0, size = conjuncts.size(); c < size; ++c)
+  {
+    parent[c] = c;
+    visited.clear();
+    expr::getSymbols(conjuncts[c], conjunctSyms[c], visited);
+    for (const Node& s : conjunctSyms[c])
+    {
+      std::unordered_map<Node, size_t, NodeHashFunction>::iterator it =
+          symConjunct.find(s);
+      if (it == symConjunct.end())
+      {
+        symConjunct[s] = c;
+      }
+      else
+      {
+        parent[findRoot(parent, c)] = findRoot(parent, it->second);
+      }
+    }
+  }
+  std::unordered_map<size_t, std::vector<size_t>> components;
+  std::vector<size_t> roots;
+  for (size_t c = 0, size = conjuncts.size(); c < size; ++c)
+  {
+    size_t root = findRoot(parent, c);
+    if (components.find(root) == components.end())
+    {
+      roots.push_back(root);
+    }
+    components[root].push_back(c);
+  }
+  d_statistics.d_components += roots.size();
+  Trace("decompose-assertions")
+      << "decompose-assertions: " << roots.size() << " components" << std::endl;
+  if (roots.size() < 2)
+  {
+    return PreprocessingPassResult::NO_CONFLICT;
+  }
+
+  // the largest component is left to the current solver
+  size_t largest = roots[0];
+  for (size_t root : roots)
+  {
+    if (components[root].size() > components[largest].size())
+    {
+      largest = root;
+    }
+  }
+  std::vector<bool> solved(conjuncts.size(), false);
+  for (size_t root : roots)
+  {
+    if (root == largest)
+    {
+      continue;
+    }
+    std::vector<Node> comp;
+    std::unordered_set<Node, NodeHashFunction> syms;
+    bool supported = true;
+    for (size_t c : components[root])
+    {
+      comp.push_back(conjuncts[c]);
+      for (const Node& s : conjunctSyms[c])
+      {
+        // the model values of functions and uninterpreted sorts are not
+        // imported from subsolvers
+        TypeNode tn = s.getType();
+        supported = supported && !tn.isFunction() && !tn.isSort();
+        syms.insert(s);
+      }
+    }
+    if (!supported)
+    {
+      continue;
+    }
+    Result r =
+        checkComponent(comp, std::vector<Node>(syms.begin(), syms.end()));
+    Trace("decompose-assertions") << "decompose-assertions: component of size "
+                                  << comp.size() << " is " << r << std::endl;
+    Result::Sat sat = r.asSatisfiabilityResult().isSat();
+    if (sat == Result::UNSAT)
+    {
+      assertionsToPreprocess->clear();
+      assertionsToPreprocess->push_back(nm->mkConst(false));
+      return PreprocessingPassResult::CONFLICT;
+    }
+    if (sat == Result::SAT)
+    {
+      ++d_statistics.d_solved;
+      for (size_t c : components[root])
+      {
+        solved[c] = true;
+      }
+    }
+  }
+
+  // the assertions with solved conjuncts are the conjunctions of their
+  // unsolved conjuncts
+  std::vector<std::vector<Node>> remaining(assertionsToPreprocess->size());
+  std::vector<bool> changed(assertionsToPreprocess->size(), false);
+  for (size_t c = 0, size = conjuncts.size(); c < size; ++c)
+  {
+    if (solved[c])
+    {
+      changed[assertionIndex[c]] = true;
+    }
+    else
+    {
+      remaining[assertionIndex[c]].push_back(conjuncts[c]);
+    }
+  }
+  for (size_t i = 0, size = remaining.size(); i < size; ++i)
+  {
+    if (!changed[i])
+    {
+      continue;
+    }
+    const std::vector<Node>& rem = remaining[i];
+    assertionsToPreprocess->replace(
+        i,
+        rem.empty() ? nm->mkConst(true)
+                    : (rem.size() == 1 ? rem[0] : nm->mkNode(kind::AND, rem)));
+  }
+  return PreprocessingPassResult::NO_CONFLICT;
+}
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
@@ -0,0 +1,76 @@
+/*********************                                                        */
+/*! \file decompose_assertions.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Decomposes the assertions into independent components
+ **
+ ** This preprocessing pass partitions the conjuncts of the assertions into
+ ** components that share no free symbols, and checks all components but the
+ ** largest one in subsolvers. If a component is unsatisfiable, the
+ ** assertions are replaced by false. The conjuncts of the satisfiable
+ ** components are removed, and their symbols are substituted by their values
+ ** in the models of the subsolvers. The other components are left to the
+ ** current solver.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PREPROCESSING__PASSES__DECOMPOSE_ASSERTIONS_H
+#define CVC4__PREPROCESSING__PASSES__DECOMPOSE_ASSERTIONS_H
+
+#include <vector>
+
+#include "expr/node.h"
+#include "preprocessing/preprocessing_pass.h"
+#include "preprocessing/preprocessing_pass_context.h"
+#include "util/result.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+class DecomposeAssertions : public PreprocessingPass
+{
+ public:
+  DecomposeAssertions(PreprocessingPassContext* preprocContext);
+
+ protected:
+  PreprocessingPassResult applyInternal(
+      AssertionPipeline* assertionsToPreprocess) override;
+
+ private:
+  /**
+   * Checks the satisfiability of the conjunction of conjuncts in a
+   * subsolver. If it is satisfiable and models are produced, the model
+   * values of the symbols syms are added as substitutions to the model.
+   */
+  Result checkComponent(const std::vector<Node>& conjuncts,
+                        const std::vector<Node>& syms);
+
+  struct Statistics
+  {
+    /** The number of components of the decomposed assertions */
+    IntStat d_components;
+    /** The number of components checked in subsolvers */
+    IntStat d_checked;
+    /** The number of components removed since they are satisfiable */
+    IntStat d_solved;
+    Statistics();
+    ~Statistics();
+  };
+  Statistics d_statistics;
+};
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
+
+#endif /* CVC4__PREPROCESSING__PASSES__DECOMPOSE_ASSERTIONS_H */
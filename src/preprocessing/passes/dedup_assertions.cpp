@@ -0,0 +1,273 @@
+/*********************                                                        */
+/*! \file dedup_assertions.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Removes duplicate and subsumed assertions
+ **/
+
+#include "preprocessing/passes/dedup_assertions.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "options/smt_options.h"
+#include "smt/smt_statistics_registry.h"
+#include "theory/rewriter.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+using namespace CVC4::theory;
+
+namespace {
+
+/**
+ * The maximal number of clauses containing a literal for this literal to be
+ * used to find the clauses subsumed by a clause
+ */
+const size_t s_maxOccurrences = 1000;
+
+/** Returns the negation of the literal lit */
+Node negate(TNode lit)
+{
+  return lit.getKind() == kind::NOT ? Node(lit[0]) : lit.notNode();
+}
+
+}  // namespace
+
+DedupAssertions::DedupAssertions(PreprocessingPassContext* preprocContext)
+    : PreprocessingPass(preprocContext, "dedup-assertions"){};
+
+DedupAssertions::Statistics::Statistics()
+    : d_duplicates("preprocessing::passes::DedupAssertions::Duplicates", 0),
+      d_subsumed("preprocessing::passes::DedupAssertions::Subsumed", 0),
+      d_strengthened("preprocessing::passes::DedupAssertions::Strengthened",
+                     0)
+{
+  smtStatisticsRegistry()->registerStat(&d_duplicates);
+  smtStatisticsRegistry()->registerStat(&d_subsumed);
+  smtStatisticsRegistry()->registerStat(&d_strengthened);
+}
+
+DedupAssertions::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_duplicates);
+  smtStatisticsRegistry()->unregisterStat(&d_subsumed);
+  smtStatisticsRegistry()->unregisterStat(&d_strengthened);
+}
+
+uint64_t DedupAssertions::getSignature(const std::vector<Node>& lits)
+{
+  uint64_t sig = 0;
+  for (const Node& lit : lits)
+  {
+    sig |= uint64_t(1) << (lit.getId() % 64);
+  }
+  return sig;
+}
+
+bool DedupAssertions::propagateUnits(std::vector<Clause>& clauses)
+{
+  std::unordered_set<Node, NodeHashFunction> falsified;
+  for (const Node& u : d_units)
+  {
+    falsified.insert(negate(u));
+  }
+  bool changed = true;
+  while (changed)
+  {
+    changed = false;
+    for (Clause& c : clauses)
+    {
+      if (c.d_removed)
+      {
+        continue;
+      }
+      std::vector<Node>& lits = c.d_lits;
+      if (lits.size() > 1
+          && std::any_of(lits.begin(), lits.end(), [this](const Node& lit) {
+               return d_units.find(lit) != d_units.end();
+             }))
+      {
+        c.d_removed = true;
+        continue;
+      }
+      size_t size = lits.size();
+      lits.erase(std::remove_if(lits.begin(),
+                                lits.end(),
+                                [&falsified](const Node& lit) {
+                                  return falsified.find(lit) != falsified.end();
+                                }),
+                 lits.end());
+      if (lits.size() == size)
+      {
+        continue;
+      }
+      c.d_strengthened = true;
+      c.d_signature = getSignature(lits);
+      if (lits.empty())
+      {
+        return false;
+      }
+      if (lits.size() == 1 && d_units.insert(lits[0]).second)
+      {
+        falsified.insert(negate(lits[0]));
+        changed = true;
+      }
+    }
+  }
+  return true;
+}
+
+void DedupAssertions::removeSubsumed(std::vector<Clause>& clauses)
+{
+  // the units have already removed the clauses that contain them
+  std::vector<size_t> order;
+  std::unordered_map<Node, std::vector<size_t>, NodeHashFunction> occurrences;
+  for (size_t i = 0, size = clauses.size(); i < size; ++i)
+  {
+    if (clauses[i].d_removed || clauses[i].d_lits.size() < 2)
+    {
+      continue;
+    }
+    order.push_back(i);
+    for (const Node& lit : clauses[i].d_lits)
+    {
+      occurrences[lit].push_back(i);
+    }
+  }
+  // smaller clauses first, so that a clause is only subsumed by a clause
+  // that is not itself subsumed
+  std::stable_sort(order.begin(), order.end(), [&clauses](size_t i, size_t j) {
+    return clauses[i].d_lits.size() < clauses[j].d_lits.size();
+  });
+  for (size_t i : order)
+  {
+    const Clause& d = clauses[i];
+    if (d.d_removed)
+    {
+      continue;
+    }
+    // the candidates are the clauses containing the least frequent literal
+    const std::vector<size_t>* candidates = nullptr;
+    for (const Node& lit : d.d_lits)
+    {
+      const std::vector<size_t>& occs = occurrences[lit];
+      if (candidates == nullptr || occs.size() < candidates->size())
+      {
+        candidates = &occs;
+      }
+    }
+    if (candidates->size() > s_maxOccurrences)
+    {
+      continue;
+    }
+    for (size_t j : *candidates)
+    {
+      Clause& c = clauses[j];
+      if (j == i || c.d_removed || c.d_lits.size() < d.d_lits.size()
+          || (d.d_signature & ~c.d_signature) != 0)
+      {
+        continue;
+      }
+      if (std::includes(
+              c.d_lits.begin(), c.d_lits.end(), d.d_lits.begin(), d.d_lits.end()))
+      {
+        Trace("dedup-assertions") << "dedup-assertions: " << c.d_index
+                                  << " is subsumed by " << d.d_index
+                                  << std::endl;
+        c.d_removed = true;
+      }
+    }
+  }
+}
+
+PreprocessingPassResult DedupAssertions::applyInternal(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  Node t = nm->mkConst(true);
+  d_units.clear();
+
+  std::vector<Clause> clauses;
+  std::unordered_set<Node, NodeHashFunction> seen;
+  for (size_t i = 0, size = assertionsToPreprocess->getRealAssertionsEnd();
+       i < size;
+       ++i)
+  {
+    Node a = (*assertionsToPreprocess)[i];
+    if (assertionsToPreprocess->isSubstsIndex(i) || a.isConst())
+    {
+      continue;
+    }
+    if (!seen.insert(a).second)
+    {
+      ++d_statistics.d_duplicates;
+      assertionsToPreprocess->replace(i, t);
+      continue;
+    }
+    if (a.getKind() == kind::AND)
+    {
+      // the conjuncts are units, the conjunction itself is not a clause
+      d_units.insert(a.begin(), a.end());
+      continue;
+    }
+    Clause c;
+    c.d_index = i;
+    if (a.getKind() == kind::OR)
+    {
+      c.d_lits.insert(c.d_lits.end(), a.begin(), a.end());
+      std::sort(c.d_lits.begin(), c.d_lits.end());
+      c.d_lits.erase(std::unique(c.d_lits.begin(), c.d_lits.end()),
+                     c.d_lits.end());
+    }
+    else
+    {
+      c.d_lits.push_back(a);
+      d_units.insert(a);
+    }
+    c.d_signature = getSignature(c.d_lits);
+    c.d_removed = false;
+    c.d_strengthened = false;
+    clauses.push_back(c);
+  }
+
+  if (!propagateUnits(clauses))
+  {
+    Trace("dedup-assertions") << "dedup-assertions: conflict" << std::endl;
+    Assert(!options::unsatCores());
+    assertionsToPreprocess->clear();
+    assertionsToPreprocess->push_back(nm->mkConst(false));
+    return PreprocessingPassResult::CONFLICT;
+  }
+  removeSubsumed(clauses);
+
+  for (const Clause& c : clauses)
+  {
+    if (c.d_removed)
+    {
+      ++d_statistics.d_subsumed;
+      assertionsToPreprocess->replace(c.d_index, t);
+    }
+    else if (c.d_strengthened)
+    {
+      ++d_statistics.d_strengthened;
+      Node a = c.d_lits.size() == 1 ? c.d_lits[0]
+                                    : nm->mkNode(kind::OR, c.d_lits);
+      assertionsToPreprocess->replace(c.d_index, Rewriter::rewrite(a));
+    }
+  }
+  return PreprocessingPassResult::NO_CONFLICT;
+}
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
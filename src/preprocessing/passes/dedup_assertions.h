@@ -0,0 +1,96 @@
+/*********************                                                        */
+/*! \file dedup_assertions.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Removes duplicate and subsumed assertions
+ **
+ ** This preprocessing pass views each (rewritten) assertion as a clause,
+ ** i.e. the set of the children of a disjunction or the assertion itself,
+ ** and the conjuncts of top-level conjunctions as unit clauses. It removes
+ ** duplicate assertions and clauses satisfied by a unit, removes from the
+ ** clauses the literals falsified by a unit, and removes the clauses that
+ ** are supersets of another clause. The removed assertions are replaced by
+ ** true.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PREPROCESSING__PASSES__DEDUP_ASSERTIONS_H
+#define CVC4__PREPROCESSING__PASSES__DEDUP_ASSERTIONS_H
+
+#include <unordered_set>
+#include <vector>
+
+#include "expr/node.h"
+#include "preprocessing/preprocessing_pass.h"
+#include "preprocessing/preprocessing_pass_context.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+class DedupAssertions : public PreprocessingPass
+{
+ public:
+  DedupAssertions(PreprocessingPassContext* preprocContext);
+
+ protected:
+  PreprocessingPassResult applyInternal(
+      AssertionPipeline* assertionsToPreprocess) override;
+
+ private:
+  /** A clause of an assertion */
+  struct Clause
+  {
+    /** The index of the assertion */
+    size_t d_index;
+    /** The literals, sorted by id */
+    std::vector<Node> d_lits;
+    /** The union of the bits (id mod 64) of the literals */
+    uint64_t d_signature;
+    /** Whether the clause has been removed */
+    bool d_removed;
+    /** Whether literals of the clause have been removed */
+    bool d_strengthened;
+  };
+
+  /** Returns the signature of the literals lits. */
+  static uint64_t getSignature(const std::vector<Node>& lits);
+  /**
+   * Removes the clauses satisfied by the units and the literals falsified
+   * by the units until a fixpoint, returns false if a clause becomes empty.
+   */
+  bool propagateUnits(std::vector<Clause>& clauses);
+  /** Removes the clauses that are supersets of another clause. */
+  void removeSubsumed(std::vector<Clause>& clauses);
+
+  /** The unit literals */
+  std::unordered_set<Node, NodeHashFunction> d_units;
+
+  struct Statistics
+  {
+    /** The number of removed duplicate assertions */
+    IntStat d_duplicates;
+    /** The number of removed subsumed assertions */
+    IntStat d_subsumed;
+    /** The number of assertions from which literals were removed */
+    IntStat d_strengthened;
+    Statistics();
+    ~Statistics();
+  };
+  Statistics d_statistics;
+};
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
+
+#endif /* CVC4__PREPROCESSING__PASSES__DEDUP_ASSERTIONS_H */
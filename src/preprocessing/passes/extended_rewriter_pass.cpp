@@ -25,16 +25,10 @@ namespace passes {
 ExtRewPre::ExtRewPre(PreprocessingPassContext* preprocContext)
     : PreprocessingPass(preprocContext, "ext-rew-pre"){};
 
-PreprocessingPassResult ExtRewPre::applyInternal(
-    AssertionPipeline* assertionsToPreprocess)
+Node ExtRewPre::simplifyAssertion(TNode a)
 {
   theory::quantifiers::ExtendedRewriter extr(options::extRewPrepAgg());
-  for (unsigned i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
-  {
-    assertionsToPreprocess->replace(
-        i, extr.extendedRewrite((*assertionsToPreprocess)[i]));
-  }
-  return PreprocessingPassResult::NO_CONFLICT;
+  return extr.extendedRewrite(a);
 }
 
 
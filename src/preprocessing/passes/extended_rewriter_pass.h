@@ -32,8 +32,8 @@ class ExtRewPre : public PreprocessingPass
   ExtRewPre(PreprocessingPassContext* preprocContext);
 
  protected:
-  PreprocessingPassResult applyInternal(
-      AssertionPipeline* assertionsToPreprocess) override;
+  bool isAssertionLocal() const override { return true; }
+  Node simplifyAssertion(TNode a) override;
 };
 
 }  // namespace passes
@@ -14,6 +14,7 @@
 
 #include "preprocessing/passes/ite_simp.h"
 
+#include <chrono>
 #include <vector>
 
 #include "options/proof_options.h"
@@ -103,14 +104,21 @@ void compressBeforeRealAssertions(AssertionPipeline* assertionsToPreprocess,
 
 ITESimp::Statistics::Statistics()
     : d_arithSubstitutionsAdded(
-          "preprocessing::passes::ITESimp::ArithSubstitutionsAdded", 0)
+          "preprocessing::passes::ITESimp::ArithSubstitutionsAdded", 0),
+      d_cacheClears("preprocessing::passes::ITESimp::CacheClears", 0),
+      d_unsimplifiedAssertions(
+          "preprocessing::passes::ITESimp::UnsimplifiedAssertions", 0)
 {
   smtStatisticsRegistry()->registerStat(&d_arithSubstitutionsAdded);
+  smtStatisticsRegistry()->registerStat(&d_cacheClears);
+  smtStatisticsRegistry()->registerStat(&d_unsimplifiedAssertions);
 }
 
 ITESimp::Statistics::~Statistics()
 {
   smtStatisticsRegistry()->unregisterStat(&d_arithSubstitutionsAdded);
+  smtStatisticsRegistry()->unregisterStat(&d_cacheClears);
+  smtStatisticsRegistry()->unregisterStat(&d_unsimplifiedAssertions);
 }
 
 bool ITESimp::doneSimpITE(AssertionPipeline* assertionsToPreprocess)
@@ -186,6 +194,7 @@ bool ITESimp::doneSimpITE(AssertionPipeline* assertionsToPreprocess)
         aiteu.learnSubstitutions(assertionsToPreprocess->ref());
         if (prevSubCount < aiteu.getSubCount())
         {
+          d_addedModelSubstitutions = true;
           d_statistics.d_arithSubstitutionsAdded +=
               aiteu.getSubCount() - prevSubCount;
           bool anySuccess = false;
@@ -227,7 +236,9 @@ bool ITESimp::doneSimpITE(AssertionPipeline* assertionsToPreprocess)
 /* -------------------------------------------------------------------------- */
 
 ITESimp::ITESimp(PreprocessingPassContext* preprocContext)
-    : PreprocessingPass(preprocContext, "ite-simp")
+    : PreprocessingPass(preprocContext, "ite-simp"),
+      d_addedModelSubstitutions(false),
+      d_timedOut(false)
 {
 }
 
@@ -235,8 +246,12 @@ PreprocessingPassResult ITESimp::applyInternal(
     AssertionPipeline* assertionsToPreprocess)
 {
   d_preprocContext->spendResource(ResourceManager::Resource::PreprocessStep);
+  d_addedModelSubstitutions = false;
+  d_timedOut = false;
 
   size_t nasserts = assertionsToPreprocess->size();
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
   for (size_t i = 0; i < nasserts; ++i)
   {
     d_preprocContext->spendResource(ResourceManager::Resource::PreprocessStep);
@@ -246,6 +261,28 @@ PreprocessingPassResult ITESimp::applyInternal(
     {
       return PreprocessingPassResult::CONFLICT;
     }
+    // the caches only memoize the simplifications, so they can be cleared
+    // between two assertions, which is also done once the memory limit is
+    // exceeded
+    if ((options::iteSimpCacheLimit() > 0
+         && d_iteUtilities.cacheSize() > options::iteSimpCacheLimit())
+        || (d_preprocContext->memoryShed() && d_iteUtilities.cacheSize() > 0))
+    {
+      Chat() << "..ite simplifier caches exceed their limit, clearing them"
+             << endl;
+      ++d_statistics.d_cacheClears;
+      d_iteUtilities.clear();
+    }
+    if (options::iteSimpTimeLimit() > 0 && i + 1 < nasserts
+        && std::chrono::steady_clock::now() - start
+               > std::chrono::milliseconds(options::iteSimpTimeLimit()))
+    {
+      Chat() << "..ite simplifier exceeded its time limit after " << i + 1
+             << " of " << nasserts << " assertions" << endl;
+      d_statistics.d_unsimplifiedAssertions += nasserts - i - 1;
+      d_timedOut = true;
+      break;
+    }
   }
   bool done = doneSimpITE(assertionsToPreprocess);
   if (nasserts < assertionsToPreprocess->size())
@@ -256,6 +293,10 @@ PreprocessingPassResult ITESimp::applyInternal(
               : PreprocessingPassResult::CONFLICT;
 }
 
+bool ITESimp::recordSideEffects(PreprocessingCache::Entry& entry)
+{
+  return !d_addedModelSubstitutions && !d_timedOut;
+}
 
 /* -------------------------------------------------------------------------- */
 
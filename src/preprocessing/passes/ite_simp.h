@@ -33,10 +33,26 @@ class ITESimp : public PreprocessingPass
    PreprocessingPassResult applyInternal(
        AssertionPipeline* assertionsToPreprocess) override;
 
+   bool isCacheable() const override { return true; }
+
+   /*
+    * The result is cached unless the arithmetic ITE reduction added
+    * substitutions to the model, or the time limit of the simplification was
+    * reached, in which case the result depends on the time.
+    */
+   bool recordSideEffects(PreprocessingCache::Entry& entry) override;
+
  private:
   struct Statistics
   {
     IntStat d_arithSubstitutionsAdded;
+    /**
+     * The number of times the caches exceeded --simp-ite-cache-limit, or were
+     * cleared since the memory limit was exceeded
+     */
+    IntStat d_cacheClears;
+    /** The number of assertions skipped because of --simp-ite-tlimit */
+    IntStat d_unsimplifiedAssertions;
     Statistics();
     ~Statistics();
   };
@@ -47,6 +63,12 @@ class ITESimp : public PreprocessingPass
   util::ITEUtilities d_iteUtilities;
 
   Statistics d_statistics;
+
+  /** Did the last call to applyInternal add substitutions to the model? */
+  bool d_addedModelSubstitutions;
+
+  /** Did the last call to applyInternal reach the time limit? */
+  bool d_timedOut;
 };
 
 }  // namespace passes
@@ -0,0 +1,395 @@
+/*********************                                                        */
+/*! \file local_search.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A local search for a model of the assertions
+ **/
+
+#include "preprocessing/passes/local_search.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "options/smt_options.h"
+#include "smt/smt_statistics_registry.h"
+#include "theory/theory_model.h"
+#include "util/bitvector.h"
+#include "util/random.h"
+#include "util/rational.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+using namespace CVC4::theory;
+
+namespace {
+
+/** The maximal number of bits of a bit-vector that are flipped in a move */
+const unsigned s_maxFlips = 64;
+/** The maximal number of integer constants used as candidate values */
+const size_t s_maxIntConstants = 32;
+/** The probability of a random move */
+const double s_noise = 0.1;
+
+}  // namespace
+
+LocalSearch::LocalSearch(PreprocessingPassContext* preprocContext)
+    : PreprocessingPass(preprocContext, "local-search"), d_numUnsatisfied(0){};
+
+LocalSearch::Statistics::Statistics()
+    : d_steps("preprocessing::passes::LocalSearch::Steps", 0),
+      d_models("preprocessing::passes::LocalSearch::Models", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_steps);
+  smtStatisticsRegistry()->registerStat(&d_models);
+}
+
+LocalSearch::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_steps);
+  smtStatisticsRegistry()->unregisterStat(&d_models);
+}
+
+bool LocalSearch::init(AssertionPipeline* assertionsToPreprocess)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  d_vars.clear();
+  d_values.clear();
+  d_constraints.clear();
+  d_programs.clear();
+  d_varConstraints.clear();
+  d_constraintVars.clear();
+  d_satisfied.clear();
+  d_intConstants.clear();
+
+  // the constraints are the conjuncts of the assertions
+  std::vector<TNode> toVisit;
+  for (size_t i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
+  {
+    toVisit.push_back((*assertionsToPreprocess)[i]);
+  }
+  while (!toVisit.empty())
+  {
+    TNode cur = toVisit.back();
+    toVisit.pop_back();
+    if (cur.getKind() == kind::AND)
+    {
+      toVisit.insert(toVisit.end(), cur.begin(), cur.end());
+    }
+    else if (cur.isConst())
+    {
+      if (!cur.getConst<bool>())
+      {
+        return false;
+      }
+    }
+    else
+    {
+      d_constraints.push_back(cur);
+    }
+  }
+
+  std::unordered_map<Node, size_t, NodeHashFunction> varIndex;
+  std::unordered_set<Node, NodeHashFunction> intConstants;
+  for (const Node& c : d_constraints)
+  {
+    std::vector<size_t> vars;
+    std::unordered_set<TNode, TNodeHashFunction> visited;
+    toVisit.push_back(c);
+    while (!toVisit.empty())
+    {
+      TNode cur = toVisit.back();
+      toVisit.pop_back();
+      if (!visited.insert(cur).second)
+      {
+        continue;
+      }
+      TypeNode tn = cur.getType();
+      if (cur.isVar())
+      {
+        if (cur.getKind() == kind::BOUND_VARIABLE
+            || !(tn.isBoolean() || tn.isBitVector() || tn.isInteger()))
+        {
+          return false;
+        }
+        std::unordered_map<Node, size_t, NodeHashFunction>::iterator it =
+            varIndex.find(cur);
+        if (it == varIndex.end())
+        {
+          it = varIndex.insert(std::make_pair(cur, d_vars.size())).first;
+          d_vars.push_back(cur);
+          d_varConstraints.emplace_back();
+        }
+        vars.push_back(it->second);
+        continue;
+      }
+      TheoryId tid = kindToTheoryId(cur.getKind());
+      if (tid != THEORY_BUILTIN && tid != THEORY_BOOL && tid != THEORY_BV
+          && tid != THEORY_ARITH)
+      {
+        return false;
+      }
+      if (cur.getKind() == kind::CONST_RATIONAL
+          && cur.getConst<Rational>().isIntegral()
+          && intConstants.size() < s_maxIntConstants)
+      {
+        intConstants.insert(cur);
+      }
+      toVisit.insert(toVisit.end(), cur.begin(), cur.end());
+    }
+    for (size_t v : vars)
+    {
+      d_varConstraints[v].push_back(d_constraintVars.size());
+    }
+    d_constraintVars.push_back(vars);
+  }
+  d_intConstants.insert(
+      d_intConstants.end(), intConstants.begin(), intConstants.end());
+  // sorted for the search to not depend on the hashes of the constants
+  std::sort(d_intConstants.begin(), d_intConstants.end());
+
+  for (const Node& c : d_constraints)
+  {
+    d_programs.emplace_back(new EvaluatorProgram(c, d_vars));
+  }
+  for (const Node& v : d_vars)
+  {
+    TypeNode tn = v.getType();
+    if (tn.isBoolean())
+    {
+      d_values.push_back(nm->mkConst(false));
+    }
+    else if (tn.isBitVector())
+    {
+      d_values.push_back(nm->mkConst(BitVector(tn.getBitVectorSize())));
+    }
+    else
+    {
+      d_values.push_back(nm->mkConst(Rational(0)));
+    }
+  }
+  d_numUnsatisfied = 0;
+  for (size_t c = 0, size = d_constraints.size(); c < size; ++c)
+  {
+    int sat = evaluate(c);
+    if (sat < 0)
+    {
+      return false;
+    }
+    d_satisfied.push_back(sat == 1);
+    d_numUnsatisfied += sat == 1 ? 0 : 1;
+  }
+  return true;
+}
+
+int LocalSearch::evaluate(size_t c) const
+{
+  std::vector<Node> results;
+  d_programs[c]->eval({d_values}, results);
+  return toTruthValue(results[0]);
+}
+
+int LocalSearch::toTruthValue(TNode n)
+{
+  if (n.isNull() || !n.isConst() || !n.getType().isBoolean())
+  {
+    return -1;
+  }
+  return n.getConst<bool>() ? 1 : 0;
+}
+
+void LocalSearch::getMoves(size_t v, std::vector<Node>& moves) const
+{
+  NodeManager* nm = NodeManager::currentNM();
+  TNode val = d_values[v];
+  TypeNode tn = val.getType();
+  moves.clear();
+  if (tn.isBoolean())
+  {
+    moves.push_back(nm->mkConst(!val.getConst<bool>()));
+  }
+  else if (tn.isBitVector())
+  {
+    const BitVector& bv = val.getConst<BitVector>();
+    unsigned width = bv.getSize();
+    BitVector one(width, 1u);
+    Random& rnd = Random::getRandom();
+    for (unsigned i = 0; i < width && i < s_maxFlips; ++i)
+    {
+      unsigned bit = width <= s_maxFlips ? i : rnd.pick(0, width - 1);
+      moves.push_back(nm->mkConst(bv ^ one.leftShift(BitVector(width, bit))));
+    }
+    moves.push_back(nm->mkConst(bv + one));
+    moves.push_back(nm->mkConst(bv - one));
+    moves.push_back(nm->mkConst(~bv));
+    moves.push_back(nm->mkConst(BitVector(width)));
+  }
+  else
+  {
+    const Rational& r = val.getConst<Rational>();
+    moves.push_back(nm->mkConst(r + Rational(1)));
+    moves.push_back(nm->mkConst(r - Rational(1)));
+    moves.push_back(nm->mkConst(-r));
+    moves.push_back(nm->mkConst(Rational(0)));
+    for (const Node& c : d_intConstants)
+    {
+      const Rational& cr = c.getConst<Rational>();
+      moves.push_back(c);
+      moves.push_back(nm->mkConst(cr + Rational(1)));
+      moves.push_back(nm->mkConst(cr - Rational(1)));
+    }
+  }
+}
+
+bool LocalSearch::scoreMoves(size_t v,
+                             const std::vector<Node>& moves,
+                             std::vector<int64_t>& scores) const
+{
+  std::vector<std::vector<Node>> points(moves.size(), d_values);
+  for (size_t k = 0, size = moves.size(); k < size; ++k)
+  {
+    points[k][v] = moves[k];
+  }
+  scores.assign(moves.size(), 0);
+  std::vector<Node> results;
+  for (size_t c : d_varConstraints[v])
+  {
+    results.clear();
+    d_programs[c]->eval(points, results);
+    for (size_t k = 0, size = moves.size(); k < size; ++k)
+    {
+      int sat = toTruthValue(results[k]);
+      if (sat < 0)
+      {
+        return false;
+      }
+      scores[k] += sat - (d_satisfied[c] ? 1 : 0);
+    }
+  }
+  return true;
+}
+
+bool LocalSearch::setValue(size_t v, Node val)
+{
+  d_values[v] = val;
+  for (size_t c : d_varConstraints[v])
+  {
+    int sat = evaluate(c);
+    if (sat < 0)
+    {
+      return false;
+    }
+    if (d_satisfied[c] != (sat == 1))
+    {
+      d_satisfied[c] = sat == 1;
+      d_numUnsatisfied += sat == 1 ? -1 : 1;
+    }
+  }
+  return true;
+}
+
+bool LocalSearch::search(uint64_t steps)
+{
+  Random& rnd = Random::getRandom();
+  std::vector<Node> moves;
+  std::vector<int64_t> scores;
+  for (uint64_t step = 0; step < steps && d_numUnsatisfied > 0; ++step)
+  {
+    ++d_statistics.d_steps;
+    // pick a random unsatisfied constraint
+    size_t size = d_constraints.size();
+    size_t c = rnd.pick(0, size - 1);
+    while (d_satisfied[c])
+    {
+      c = (c + 1) % size;
+    }
+    const std::vector<size_t>& vars = d_constraintVars[c];
+    if (vars.empty())
+    {
+      return false;
+    }
+    if (rnd.pickWithProb(s_noise))
+    {
+      size_t v = vars[rnd.pick(0, vars.size() - 1)];
+      getMoves(v, moves);
+      if (!setValue(v, moves[rnd.pick(0, moves.size() - 1)]))
+      {
+        return false;
+      }
+      continue;
+    }
+    // otherwise, take the best move of the variables of the constraint
+    size_t bestVar = 0;
+    Node bestVal;
+    int64_t bestScore = 0;
+    for (size_t v : vars)
+    {
+      getMoves(v, moves);
+      if (!scoreMoves(v, moves, scores))
+      {
+        return false;
+      }
+      for (size_t k = 0, msize = moves.size(); k < msize; ++k)
+      {
+        if (bestVal.isNull() || scores[k] > bestScore)
+        {
+          bestVar = v;
+          bestVal = moves[k];
+          bestScore = scores[k];
+        }
+      }
+    }
+    Trace("local-search") << "local-search: step " << step << ", "
+                          << d_vars[bestVar] << " := " << bestVal << " ("
+                          << bestScore << ")" << std::endl;
+    if (!setValue(bestVar, bestVal))
+    {
+      return false;
+    }
+  }
+  return d_numUnsatisfied == 0;
+}
+
+PreprocessingPassResult LocalSearch::applyInternal(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  if (!init(assertionsToPreprocess))
+  {
+    Trace("local-search") << "local-search: unsupported assertions"
+                          << std::endl;
+    return PreprocessingPassResult::NO_CONFLICT;
+  }
+  if (!search(options::localSearchSteps()))
+  {
+    Trace("local-search") << "local-search: no model found, "
+                          << d_numUnsatisfied << " unsatisfied constraints"
+                          << std::endl;
+    return PreprocessingPassResult::NO_CONFLICT;
+  }
+  Trace("local-search") << "local-search: found a model" << std::endl;
+  ++d_statistics.d_models;
+  TheoryModel* m = d_preprocContext->getTheoryEngine()->getModel();
+  for (size_t v = 0, size = d_vars.size(); v < size; ++v)
+  {
+    m->addSubstitution(d_vars[v], d_values[v]);
+  }
+  Node t = NodeManager::currentNM()->mkConst(true);
+  for (size_t i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
+  {
+    assertionsToPreprocess->replace(i, t);
+  }
+  return PreprocessingPassResult::NO_CONFLICT;
+}
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
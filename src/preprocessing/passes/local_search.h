@@ -0,0 +1,122 @@
+/*********************                                                        */
+/*! \file local_search.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A local search for a model of the assertions
+ **
+ ** This preprocessing pass runs a bounded stochastic local search (in the
+ ** style of WalkSAT, but on the word-level values of the variables) for a
+ ** model of the assertions, when their free variables are Booleans,
+ ** bit-vectors or integers. If a model is found, the variables are
+ ** substituted by their values in the model and the assertions are replaced
+ ** by true, otherwise the assertions are unchanged.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PREPROCESSING__PASSES__LOCAL_SEARCH_H
+#define CVC4__PREPROCESSING__PASSES__LOCAL_SEARCH_H
+
+#include <memory>
+#include <vector>
+
+#include "expr/node.h"
+#include "preprocessing/preprocessing_pass.h"
+#include "preprocessing/preprocessing_pass_context.h"
+#include "theory/evaluator.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+class LocalSearch : public PreprocessingPass
+{
+ public:
+  LocalSearch(PreprocessingPassContext* preprocContext);
+
+ protected:
+  PreprocessingPassResult applyInternal(
+      AssertionPipeline* assertionsToPreprocess) override;
+
+ private:
+  /**
+   * Initializes the search for the assertions, returns false if they are
+   * not supported.
+   */
+  bool init(AssertionPipeline* assertionsToPreprocess);
+  /**
+   * Searches for a model in at most steps steps, returns true if the current
+   * values are a model.
+   */
+  bool search(uint64_t steps);
+  /**
+   * Adds to moves the candidate new values of the variable of index v, which
+   * are its neighbors in the search space.
+   */
+  void getMoves(size_t v, std::vector<Node>& moves) const;
+  /**
+   * Sets scores[k] to the number of constraints that become satisfied minus
+   * the number of constraints that become unsatisfied when the variable of
+   * index v takes the value moves[k]. Returns false if a constraint does not
+   * evaluate to a Boolean constant.
+   */
+  bool scoreMoves(size_t v,
+                  const std::vector<Node>& moves,
+                  std::vector<int64_t>& scores) const;
+  /**
+   * Sets the value of the variable of index v to val, returns false if a
+   * constraint does not evaluate to a Boolean constant.
+   */
+  bool setValue(size_t v, Node val);
+  /**
+   * Returns 1 (resp. 0) if the constraint of index c evaluates to true
+   * (resp. false) under the current values, and -1 otherwise.
+   */
+  int evaluate(size_t c) const;
+  /** Returns 1 (resp. 0) if n is true (resp. false), and -1 otherwise */
+  static int toTruthValue(TNode n);
+
+  /** The variables of the assertions */
+  std::vector<Node> d_vars;
+  /** The current values of the variables */
+  std::vector<Node> d_values;
+  /** The constraints, which are the conjuncts of the assertions */
+  std::vector<Node> d_constraints;
+  /** The evaluators of the constraints over d_vars */
+  std::vector<std::unique_ptr<theory::EvaluatorProgram>> d_programs;
+  /** The indices of the constraints of each variable */
+  std::vector<std::vector<size_t>> d_varConstraints;
+  /** The indices of the variables of each constraint */
+  std::vector<std::vector<size_t>> d_constraintVars;
+  /** Whether each constraint is satisfied by the current values */
+  std::vector<bool> d_satisfied;
+  /** The number of unsatisfied constraints */
+  size_t d_numUnsatisfied;
+  /** The integer constants of the assertions, used as candidate values */
+  std::vector<Node> d_intConstants;
+
+  struct Statistics
+  {
+    /** The number of moves of the searches */
+    IntStat d_steps;
+    /** The number of searches that found a model */
+    IntStat d_models;
+    Statistics();
+    ~Statistics();
+  };
+  Statistics d_statistics;
+};
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
+
+#endif /* CVC4__PREPROCESSING__PASSES__LOCAL_SEARCH_H */
@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "context/cdo.h"
+#include "options/arith_options.h"
 #include "options/proof_options.h"
 #include "smt/smt_statistics_registry.h"
 #include "theory/theory_model.h"
@@ -47,10 +48,50 @@ NonClausalSimp::Statistics::~Statistics()
 /* -------------------------------------------------------------------------- */
 
 NonClausalSimp::NonClausalSimp(PreprocessingPassContext* preprocContext)
-    : PreprocessingPass(preprocContext, "non-clausal-simp")
+    : PreprocessingPass(preprocContext, "non-clausal-simp"),
+      d_propagatorLevels(preprocContext->getUserContext(), 0),
+      d_propagatorUserLevel(preprocContext->getUserContext(), -1),
+      d_propagatorPushes(0)
 {
 }
 
+void NonClausalSimp::initializePropagator(
+    theory::booleans::CircuitPropagator* propagator)
+{
+  if (!options::nonClausalIncremental())
+  {
+    if (propagator->getNeedsFinish())
+    {
+      propagator->finish();
+      propagator->setNeedsFinish(false);
+    }
+    propagator->initialize();
+    return;
+  }
+  while (d_propagatorPushes > d_propagatorLevels.get())
+  {
+    propagator->finish();
+    --d_propagatorPushes;
+  }
+  int userLevel = d_preprocContext->getUserContext()->getLevel();
+  if (d_propagatorUserLevel.get() != userLevel)
+  {
+    propagator->initialize();
+    ++d_propagatorPushes;
+    d_propagatorLevels = d_propagatorPushes;
+    d_propagatorUserLevel = userLevel;
+  }
+}
+
+void NonClausalSimp::finishPropagator(
+    theory::booleans::CircuitPropagator* propagator)
+{
+  if (!options::nonClausalIncremental())
+  {
+    propagator->setNeedsFinish(true);
+  }
+}
+
 PreprocessingPassResult NonClausalSimp::applyInternal(
     AssertionPipeline* assertionsToPreprocess)
 {
@@ -58,6 +99,9 @@ PreprocessingPassResult NonClausalSimp::applyInternal(
 
   d_preprocContext->spendResource(ResourceManager::Resource::PreprocessStep);
 
+  d_lastTopLevelSubstitutions.clear();
+  d_lastModelSubstitutions.clear();
+
   theory::booleans::CircuitPropagator* propagator =
       d_preprocContext->getCircuitPropagator();
 
@@ -67,12 +111,7 @@ PreprocessingPassResult NonClausalSimp::applyInternal(
                                   << (*assertionsToPreprocess)[i] << std::endl;
   }
 
-  if (propagator->getNeedsFinish())
-  {
-    propagator->finish();
-    propagator->setNeedsFinish(false);
-  }
-  propagator->initialize();
+  initializePropagator(propagator);
 
   // Assert all the assertions to the propagator
   Trace("non-clausal-simplify") << "asserting to propagator" << std::endl;
@@ -103,7 +142,7 @@ PreprocessingPassResult NonClausalSimp::applyInternal(
     Node n = NodeManager::currentNM()->mkConst<bool>(false);
     assertionsToPreprocess->push_back(n);
     PROOF(ProofManager::currentPM()->addDependence(n, Node::null()));
-    propagator->setNeedsFinish(true);
+    finishPropagator(propagator);
     return PreprocessingPassResult::CONFLICT;
   }
 
@@ -118,6 +157,15 @@ PreprocessingPassResult NonClausalSimp::applyInternal(
   SubstitutionMap::iterator pos;
   size_t j = 0;
   std::vector<Node>& learned_literals = propagator->getLearnedLiterals();
+  if (options::nonClausalIncremental())
+  {
+    // the literals learned from the assertions of the earlier calls may
+    // contain variables that were substituted since then
+    for (Node& lit : learned_literals)
+    {
+      lit = Rewriter::rewrite(top_level_substs.apply(lit));
+    }
+  }
   for (size_t i = 0, size = learned_literals.size(); i < size; ++i)
   {
     // Simplify the literal we learned wrt previous substitutions
@@ -165,7 +213,7 @@ PreprocessingPassResult NonClausalSimp::applyInternal(
         Node n = NodeManager::currentNM()->mkConst<bool>(false);
         assertionsToPreprocess->push_back(n);
         PROOF(ProofManager::currentPM()->addDependence(n, Node::null()));
-        propagator->setNeedsFinish(true);
+        finishPropagator(propagator);
         return PreprocessingPassResult::CONFLICT;
       }
     }
@@ -208,7 +256,7 @@ PreprocessingPassResult NonClausalSimp::applyInternal(
         Node n = NodeManager::currentNM()->mkConst<bool>(false);
         assertionsToPreprocess->push_back(n);
         PROOF(ProofManager::currentPM()->addDependence(n, Node::null()));
-        propagator->setNeedsFinish(true);
+        finishPropagator(propagator);
         return PreprocessingPassResult::CONFLICT;
       }
       default:
@@ -356,6 +404,7 @@ PreprocessingPassResult NonClausalSimp::applyInternal(
       Trace("non-clausal-simplify")
           << "substitute: " << lhs << " " << rhs << std::endl;
       m->addSubstitution(lhs, rhs);
+      d_lastModelSubstitutions.push_back(std::make_pair(lhs, rhs));
     }
     else
     {
@@ -431,6 +480,11 @@ PreprocessingPassResult NonClausalSimp::applyInternal(
   // because SubstitutionMap::apply does a fixed-point iteration when
   // substituting
   top_level_substs.addSubstitutions(newSubstitutions);
+  for (pos = newSubstitutions.begin(); pos != newSubstitutions.end(); ++pos)
+  {
+    d_lastTopLevelSubstitutions.push_back(
+        std::make_pair((*pos).first, (*pos).second));
+  }
 
   if (learnedBuilder.getNumChildren() > 1)
   {
@@ -439,10 +493,23 @@ PreprocessingPassResult NonClausalSimp::applyInternal(
         Rewriter::rewrite(Node(learnedBuilder)));
   }
 
-  propagator->setNeedsFinish(true);
+  finishPropagator(propagator);
   return PreprocessingPassResult::NO_CONFLICT;
 }  // namespace passes
 
+bool NonClausalSimp::isCacheable() const
+{
+  return !options::arithMLTrick() && !options::nonClausalIncremental()
+         && d_preprocContext->getTopLevelSubstitutions().empty();
+}
+
+bool NonClausalSimp::recordSideEffects(PreprocessingCache::Entry& entry)
+{
+  entry.d_topLevelSubstitutions = d_lastTopLevelSubstitutions;
+  entry.d_modelSubstitutions = d_lastModelSubstitutions;
+  return true;
+}
+
 
 /* -------------------------------------------------------------------------- */
 
@@ -17,8 +17,10 @@
 #ifndef CVC4__PREPROCESSING__PASSES__NON_CLAUSAL_SIMP_H
 #define CVC4__PREPROCESSING__PASSES__NON_CLAUSAL_SIMP_H
 
+#include <utility>
 #include <vector>
 
+#include "context/cdo.h"
 #include "expr/node.h"
 #include "preprocessing/preprocessing_pass.h"
 #include "preprocessing/preprocessing_pass_context.h"
@@ -36,6 +38,15 @@ class NonClausalSimp : public PreprocessingPass
   PreprocessingPassResult applyInternal(
       AssertionPipeline* assertionsToPreprocess) override;
 
+  /*
+   * The pass is cacheable when starting from an empty set of top-level
+   * substitutions. It is not cacheable with --miplib-trick, which reads the
+   * state of the circuit propagator that a replay would not restore.
+   */
+  bool isCacheable() const override;
+
+  bool recordSideEffects(PreprocessingCache::Entry& entry) override;
+
  private:
   struct Statistics
   {
@@ -46,8 +57,33 @@ class NonClausalSimp : public PreprocessingPass
 
   Statistics d_statistics;
 
+  /**
+   * Prepares the circuit propagator for the assertions of this call. With
+   * --simp-incremental-propagation, the propagator has one level for each
+   * user context where this pass was applied, which keeps the assertions of
+   * the earlier calls in this user context. The levels of the popped user
+   * contexts are popped here. Otherwise, the propagator is reset.
+   */
+  void initializePropagator(theory::booleans::CircuitPropagator* propagator);
+
+  /** Called when this call is done with the circuit propagator. */
+  void finishPropagator(theory::booleans::CircuitPropagator* propagator);
+
+  /** The number of levels of the propagator that are not popped */
+  context::CDO<unsigned> d_propagatorLevels;
+  /** The user context level of the last level of the propagator, or -1 */
+  context::CDO<int> d_propagatorUserLevel;
+  /** The number of levels pushed on the propagator by this pass */
+  unsigned d_propagatorPushes;
+
   /** Learned literals */
   std::vector<Node> d_nonClausalLearnedLiterals;
+
+  /** The substitutions added to the top-level substitutions by the last call
+   * to applyInternal */
+  std::vector<std::pair<Node, Node>> d_lastTopLevelSubstitutions;
+  /** The substitutions added to the model by the last call to applyInternal */
+  std::vector<std::pair<Node, Node>> d_lastModelSubstitutions;
 };
 
 }  // namespace passes
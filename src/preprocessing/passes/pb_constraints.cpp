@@ -0,0 +1,245 @@
+/*********************                                                        */
+/*! \file pb_constraints.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Passes pseudo-Boolean constraints to the SAT solver
+ **/
+
+#include "preprocessing/passes/pb_constraints.h"
+
+#include "prop/prop_engine.h"
+#include "smt/smt_statistics_registry.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+PbConstraints::PbConstraints(PreprocessingPassContext* preprocContext)
+    : PreprocessingPass(preprocContext, "pb-constraints"){};
+
+PbConstraints::Statistics::Statistics()
+    : d_constraints("preprocessing::passes::PbConstraints::Constraints", 0),
+      d_cardinality("preprocessing::passes::PbConstraints::Cardinality", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_constraints);
+  smtStatisticsRegistry()->registerStat(&d_cardinality);
+}
+
+PbConstraints::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_constraints);
+  smtStatisticsRegistry()->unregisterStat(&d_cardinality);
+}
+
+bool PbConstraints::addTerm(TNode t,
+                            const Rational& c,
+                            std::map<Node, Rational>& coeffs,
+                            Rational& constant) const
+{
+  switch (t.getKind())
+  {
+    case kind::CONST_RATIONAL:
+      constant += c * t.getConst<Rational>();
+      return true;
+    case kind::PLUS:
+      for (TNode tc : t)
+      {
+        if (!addTerm(tc, c, coeffs, constant))
+        {
+          return false;
+        }
+      }
+      return true;
+    case kind::MINUS:
+      return addTerm(t[0], c, coeffs, constant)
+             && addTerm(t[1], -c, coeffs, constant);
+    case kind::UMINUS: return addTerm(t[0], -c, coeffs, constant);
+    case kind::MULT:
+    {
+      // A constant times a term
+      Rational cc = c;
+      TNode term;
+      for (TNode tc : t)
+      {
+        if (tc.isConst())
+        {
+          cc *= tc.getConst<Rational>();
+        }
+        else if (term.isNull())
+        {
+          term = tc;
+        }
+        else
+        {
+          return false;
+        }
+      }
+      return term.isNull() ? (constant += cc, true)
+                           : addTerm(term, cc, coeffs, constant);
+    }
+    case kind::ITE:
+    {
+      // (ite b c1 c2) is c2 + (c1 - c2) * b
+      if (t[1].getKind() != kind::CONST_RATIONAL
+          || t[2].getKind() != kind::CONST_RATIONAL)
+      {
+        return false;
+      }
+      TNode b = t[0];
+      Rational c1 = t[1].getConst<Rational>();
+      Rational c2 = t[2].getConst<Rational>();
+      if (b.getKind() == kind::NOT)
+      {
+        b = b[0];
+        std::swap(c1, c2);
+      }
+      if (!b.isVar())
+      {
+        return false;
+      }
+      constant += c * c2;
+      coeffs[b] += c * (c1 - c2);
+      return true;
+    }
+    default: return false;
+  }
+}
+
+bool PbConstraints::makeConstraint(const std::map<Node, Rational>& coeffs,
+                                   const Rational& constant,
+                                   bool strict,
+                                   std::vector<Constraint>& constraints) const
+{
+  // Scale to integer coefficients
+  Integer lcm = constant.getDenominator();
+  size_t numAtoms = 0;
+  for (const std::pair<const Node, Rational>& p : coeffs)
+  {
+    if (p.second.sgn() != 0)
+    {
+      lcm = lcm.lcm(p.second.getDenominator());
+      ++numAtoms;
+    }
+  }
+  if (numAtoms < 2)
+  {
+    return false;
+  }
+  // sum coeffs >= -constant, or >= -constant + 1 for an integral sum > 0
+  Rational scale(lcm);
+  Integer bound = (-constant * scale).getNumerator();
+  if (strict)
+  {
+    bound += 1;
+  }
+  // The coefficients must fit in 64 bits, as well as their sums
+  Integer total = bound.abs();
+  Integer max = Integer(1).multiplyByPow2(62);
+  Constraint constraint;
+  for (const std::pair<const Node, Rational>& p : coeffs)
+  {
+    if (p.second.sgn() != 0)
+    {
+      Integer a = (p.second * scale).getNumerator();
+      total += a.abs();
+      if (total >= max)
+      {
+        return false;
+      }
+      constraint.d_atoms.push_back(p.first);
+      constraint.d_coeffs.push_back(a.getLong());
+    }
+  }
+  constraint.d_bound = bound.getLong();
+  constraints.push_back(constraint);
+  return true;
+}
+
+bool PbConstraints::getConstraints(TNode a,
+                                   std::vector<Constraint>& constraints) const
+{
+  bool pol = a.getKind() != kind::NOT;
+  TNode atom = pol ? a : a[0];
+  Kind k = atom.getKind();
+  if (k != kind::GEQ && k != kind::GT && k != kind::LEQ && k != kind::LT
+      && (k != kind::EQUAL || !pol || !atom[0].getType().isReal()))
+  {
+    return false;
+  }
+  // The atom is lhs - rhs (>= | >) 0, or rhs - lhs (>= | >) 0
+  bool geq = k == kind::GEQ || k == kind::GT || k == kind::EQUAL;
+  bool strict = k == kind::GT || k == kind::LT;
+  // not (s >= 0) is -s > 0, not (s > 0) is -s >= 0
+  if (!pol)
+  {
+    geq = !geq;
+    strict = !strict;
+  }
+  std::map<Node, Rational> coeffs;
+  Rational constant;
+  Rational c(geq ? 1 : -1);
+  if (!addTerm(atom[0], c, coeffs, constant)
+      || !addTerm(atom[1], -c, coeffs, constant)
+      || !makeConstraint(coeffs, constant, strict, constraints))
+  {
+    return false;
+  }
+  if (k == kind::EQUAL)
+  {
+    // Also rhs - lhs >= 0
+    for (std::pair<const Node, Rational>& p : coeffs)
+    {
+      p.second = -p.second;
+    }
+    return makeConstraint(coeffs, -constant, false, constraints);
+  }
+  return true;
+}
+
+PreprocessingPassResult PbConstraints::applyInternal(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  prop::PropEngine* pe = d_preprocContext->getPropEngine();
+  Node t = NodeManager::currentNM()->mkConst(true);
+  for (size_t i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
+  {
+    std::vector<Constraint> constraints;
+    if (!getConstraints((*assertionsToPreprocess)[i], constraints))
+    {
+      continue;
+    }
+    Trace("pb-constraints") << "pb-constraints: " << (*assertionsToPreprocess)[i]
+                            << std::endl;
+    bool cardinality = true;
+    for (const Constraint& c : constraints)
+    {
+      if (!pe->assertPbConstraint(c.d_atoms, c.d_coeffs, c.d_bound))
+      {
+        // The SAT solver has no native pseudo-Boolean constraints
+        return PreprocessingPassResult::NO_CONFLICT;
+      }
+      for (int64_t a : c.d_coeffs)
+      {
+        cardinality = cardinality && (a == 1 || a == -1);
+      }
+    }
+    ++d_statistics.d_constraints;
+    if (cardinality)
+    {
+      ++d_statistics.d_cardinality;
+    }
+    assertionsToPreprocess->replace(i, t);
+  }
+  return PreprocessingPassResult::NO_CONFLICT;
+}
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
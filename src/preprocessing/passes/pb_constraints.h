@@ -0,0 +1,99 @@
+/*********************                                                        */
+/*! \file pb_constraints.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Passes pseudo-Boolean constraints to the SAT solver
+ **
+ ** This preprocessing pass recognizes the assertions that are linear
+ ** (in)equalities over terms (ite b c1 c2), where b is a Boolean variable and
+ ** c1, c2 are constants, such as the cardinality constraint
+ ** (<= (+ (ite b1 1 0) ... (ite bn 1 0)) k). These assertions are asserted to
+ ** the SAT solver as pseudo-Boolean constraints, which it propagates
+ ** natively, and are replaced by true.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PREPROCESSING__PASSES__PB_CONSTRAINTS_H
+#define CVC4__PREPROCESSING__PASSES__PB_CONSTRAINTS_H
+
+#include <map>
+#include <vector>
+
+#include "expr/node.h"
+#include "preprocessing/preprocessing_pass.h"
+#include "preprocessing/preprocessing_pass_context.h"
+#include "util/rational.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+class PbConstraints : public PreprocessingPass
+{
+ public:
+  PbConstraints(PreprocessingPassContext* preprocContext);
+
+ protected:
+  PreprocessingPassResult applyInternal(
+      AssertionPipeline* assertionsToPreprocess) override;
+
+ private:
+  /** A pseudo-Boolean constraint sum d_coeffs[i] * d_atoms[i] >= d_bound */
+  struct Constraint
+  {
+    std::vector<Node> d_atoms;
+    std::vector<int64_t> d_coeffs;
+    int64_t d_bound;
+  };
+
+  /**
+   * Adds to constraints the pseudo-Boolean constraints equivalent to the
+   * assertion a, returns false if a is not a linear (in)equality over terms
+   * (ite b c1 c2) whose coefficients fit in 64 bits.
+   */
+  bool getConstraints(TNode a, std::vector<Constraint>& constraints) const;
+  /**
+   * Adds c times the term t to the linear sum whose coefficients are coeffs
+   * (by Boolean variable) and whose constant is constant, returns false if
+   * t is not a linear sum of terms (ite b c1 c2).
+   */
+  bool addTerm(TNode t,
+               const Rational& c,
+               std::map<Node, Rational>& coeffs,
+               Rational& constant) const;
+  /**
+   * Adds to constraints the constraint sum coeffs + constant >= 0, or > 0 if
+   * strict, returns false if it has too large coefficients or less than two
+   * variables.
+   */
+  bool makeConstraint(const std::map<Node, Rational>& coeffs,
+                      const Rational& constant,
+                      bool strict,
+                      std::vector<Constraint>& constraints) const;
+
+  struct Statistics
+  {
+    /** The number of assertions passed to the SAT solver */
+    IntStat d_constraints;
+    /** The number of them that are cardinality constraints */
+    IntStat d_cardinality;
+    Statistics();
+    ~Statistics();
+  };
+  Statistics d_statistics;
+};
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
+
+#endif /* CVC4__PREPROCESSING__PASSES__PB_CONSTRAINTS_H */
@@ -29,15 +29,7 @@ Rewrite::Rewrite(PreprocessingPassContext* preprocContext)
     : PreprocessingPass(preprocContext, "rewrite"){};
 
 
-PreprocessingPassResult Rewrite::applyInternal(
-  AssertionPipeline* assertionsToPreprocess)
-{	
-  for (unsigned i = 0; i < assertionsToPreprocess->size(); ++i) {
-    assertionsToPreprocess->replace(i, Rewriter::rewrite((*assertionsToPreprocess)[i]));
-  }
-
-  return PreprocessingPassResult::NO_CONFLICT;
-}
+Node Rewrite::simplifyAssertion(TNode a) { return Rewriter::rewrite(a); }
 
 
 }  // namespace passes
@@ -32,8 +32,8 @@ class Rewrite : public PreprocessingPass
   Rewrite(PreprocessingPassContext* preprocContext);
 
  protected:
-  PreprocessingPassResult applyInternal(
-      AssertionPipeline* assertionsToPreprocess) override;
+  bool isAssertionLocal() const override { return true; }
+  Node simplifyAssertion(TNode a) override;
 };
 
 }  // namespace passes
@@ -0,0 +1,301 @@
+/*********************                                                        */
+/*! \file str_to_bv.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The StrToBV preprocessing pass
+ **
+ ** Converts the constraints on strings of bounded length into bit-vector
+ ** constraints.
+ **/
+
+#include "preprocessing/passes/str_to_bv.h"
+
+#include <sstream>
+
+#include "expr/node_builder.h"
+#include "options/smt_options.h"
+#include "theory/rewriter.h"
+#include "theory/strings/theory_strings_utils.h"
+#include "util/bitvector.h"
+#include "util/regexp.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+using namespace CVC4::kind;
+using namespace CVC4::theory;
+
+StrToBV::StrToBV(PreprocessingPassContext* preprocContext)
+    : PreprocessingPass(preprocContext, "str-to-bv"), d_bound(0), d_width(0)
+{
+}
+
+Node StrToBV::mkLen(unsigned i) const
+{
+  return NodeManager::currentNM()->mkConst(BitVector(d_width, i));
+}
+
+Node StrToBV::mkChar(unsigned c) const
+{
+  return NodeManager::currentNM()->mkConst(BitVector(8, c));
+}
+
+Node StrToBV::translate(TNode n)
+{
+  std::unordered_map<Node, Node, NodeHashFunction>::iterator it =
+      d_cache.find(n);
+  if (it != d_cache.end())
+  {
+    return it->second;
+  }
+  NodeManager* nm = NodeManager::currentNM();
+  Kind k = n.getKind();
+  Node ret;
+  if (k == EQUAL && n[0].getType().isStringLike())
+  {
+    Encoding e0, e1;
+    if (encode(n[0], e0) && encode(n[1], e1))
+    {
+      std::vector<Node> conj;
+      conj.push_back(e0.d_len.eqNode(e1.d_len));
+      for (unsigned i = 0; i < d_bound; i++)
+      {
+        conj.push_back(e0.d_chars[i].eqNode(e1.d_chars[i]));
+      }
+      ret = nm->mkNode(AND, conj);
+    }
+  }
+  else if (k == STRING_PREFIX || k == STRING_SUFFIX || k == STRING_STRCTN)
+  {
+    // s is the string that is a prefix, suffix or substring of t
+    Encoding es, et;
+    if (encode(n[k == STRING_STRCTN ? 1 : 0], es)
+        && encode(n[k == STRING_STRCTN ? 0 : 1], et))
+    {
+      // the disjunction over the offsets of s in t
+      std::vector<Node> disj;
+      for (unsigned o = 0; o <= d_bound; o++)
+      {
+        if (k == STRING_PREFIX && o > 0)
+        {
+          break;
+        }
+        std::vector<Node> conj;
+        Node end = nm->mkNode(BITVECTOR_PLUS, es.d_len, mkLen(o));
+        conj.push_back(k == STRING_SUFFIX
+                           ? end.eqNode(et.d_len)
+                           : nm->mkNode(BITVECTOR_ULE, end, et.d_len));
+        for (unsigned i = 0; i + o < d_bound; i++)
+        {
+          Node inS = nm->mkNode(BITVECTOR_ULT, mkLen(i), es.d_len);
+          conj.push_back(nm->mkNode(
+              IMPLIES, inS, es.d_chars[i].eqNode(et.d_chars[i + o])));
+        }
+        disj.push_back(nm->mkNode(AND, conj));
+      }
+      ret = disj.size() == 1 ? disj[0] : nm->mkNode(OR, disj);
+    }
+  }
+  else if (k == STRING_LENGTH)
+  {
+    Encoding e;
+    if (encode(n[0], e))
+    {
+      ret = nm->mkNode(BITVECTOR_TO_NAT, e.d_len);
+    }
+  }
+  else if (n.getNumChildren() == 0)
+  {
+    if (!n.getType().isStringLike() && !n.getType().isRegExp())
+    {
+      ret = n;
+    }
+  }
+  else
+  {
+    NodeBuilder<> nb(k);
+    if (n.getMetaKind() == metakind::PARAMETERIZED)
+    {
+      nb << n.getOperator();
+    }
+    for (const Node& nc : n)
+    {
+      Node tc = translate(nc);
+      if (tc.isNull())
+      {
+        break;
+      }
+      nb << tc;
+    }
+    if (nb.getNumChildren() == n.getNumChildren())
+    {
+      ret = nb.constructNode();
+    }
+  }
+  if (ret.isNull())
+  {
+    Trace("str-to-bv") << "StrToBV: unsupported term " << n << std::endl;
+  }
+  d_cache[n] = ret;
+  return ret;
+}
+
+bool StrToBV::encode(TNode s, Encoding& e)
+{
+  std::unordered_map<Node, Encoding, NodeHashFunction>::iterator it =
+      d_encodings.find(s);
+  if (it != d_encodings.end())
+  {
+    e = it->second;
+    return true;
+  }
+  if (!s.getType().isString())
+  {
+    return false;
+  }
+  NodeManager* nm = NodeManager::currentNM();
+  Kind k = s.getKind();
+  if (k == CONST_STRING)
+  {
+    std::vector<unsigned> vec = s.getConst<String>().getVec();
+    if (vec.size() > d_bound)
+    {
+      Trace("str-to-bv") << "StrToBV: constant " << s << " exceeds the bound"
+                         << std::endl;
+      return false;
+    }
+    e.d_len = mkLen(vec.size());
+    for (unsigned i = 0; i < d_bound; i++)
+    {
+      e.d_chars.push_back(
+          mkChar(i < vec.size() ? String::convertUnsignedIntToCode(vec[i])
+                                : 0));
+    }
+  }
+  else if (s.isVar())
+  {
+    std::stringstream ss;
+    ss << s;
+    e.d_len = nm->mkSkolem("__strToBV_len_" + ss.str(),
+                           nm->mkBitVectorType(d_width),
+                           "length introduced in strToBV pass");
+    d_constraints.push_back(nm->mkNode(BITVECTOR_ULE, e.d_len, mkLen(d_bound)));
+    unsigned card = theory::strings::utils::getAlphabetCardinality();
+    for (unsigned i = 0; i < d_bound; i++)
+    {
+      std::stringstream ssc;
+      ssc << "__strToBV_char_" << s << "_" << i;
+      Node c = nm->mkSkolem(ssc.str(),
+                            nm->mkBitVectorType(8),
+                            "character introduced in strToBV pass");
+      e.d_chars.push_back(c);
+      // the characters beyond the length are zero
+      Node inS = nm->mkNode(BITVECTOR_ULT, mkLen(i), e.d_len);
+      Node inCard = card < 256 ? nm->mkNode(BITVECTOR_ULT, c, mkChar(card))
+                               : nm->mkConst(true);
+      d_constraints.push_back(
+          nm->mkNode(ITE, inS, inCard, c.eqNode(mkChar(0))));
+    }
+  }
+  else if (k == STRING_CONCAT)
+  {
+    if (!encode(s[0], e))
+    {
+      return false;
+    }
+    for (unsigned j = 1, nchild = s.getNumChildren(); j < nchild; j++)
+    {
+      Encoding eb;
+      if (!encode(s[j], eb))
+      {
+        return false;
+      }
+      Encoding ec;
+      ec.d_len = nm->mkNode(BITVECTOR_PLUS, e.d_len, eb.d_len);
+      d_constraints.push_back(
+          nm->mkNode(BITVECTOR_ULE, ec.d_len, mkLen(d_bound)));
+      for (unsigned i = 0; i < d_bound; i++)
+      {
+        // the character i - L_a of b, which is zero beyond its length
+        Node cb = mkChar(0);
+        for (unsigned o = 0; o <= i; o++)
+        {
+          cb = nm->mkNode(ITE, e.d_len.eqNode(mkLen(i - o)), eb.d_chars[o], cb);
+        }
+        Node inA = nm->mkNode(BITVECTOR_ULT, mkLen(i), e.d_len);
+        ec.d_chars.push_back(nm->mkNode(ITE, inA, e.d_chars[i], cb));
+      }
+      e = ec;
+    }
+  }
+  else if (k == ITE)
+  {
+    Node cond = translate(s[0]);
+    Encoding e1, e2;
+    if (cond.isNull() || !encode(s[1], e1) || !encode(s[2], e2))
+    {
+      return false;
+    }
+    e.d_len = nm->mkNode(ITE, cond, e1.d_len, e2.d_len);
+    for (unsigned i = 0; i < d_bound; i++)
+    {
+      e.d_chars.push_back(nm->mkNode(ITE, cond, e1.d_chars[i], e2.d_chars[i]));
+    }
+  }
+  else
+  {
+    Trace("str-to-bv") << "StrToBV: unsupported string term " << s
+                       << std::endl;
+    return false;
+  }
+  d_encodings[s] = e;
+  return true;
+}
+
+PreprocessingPassResult StrToBV::applyInternal(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  d_bound = options::solveStrAsBV();
+  Assert(d_bound > 0);
+  // the width must hold the sum of two lengths
+  d_width = 1;
+  while ((uint64_t(1) << d_width) <= 2 * uint64_t(d_bound))
+  {
+    d_width++;
+  }
+  std::vector<Node> results;
+  for (size_t i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
+  {
+    Node result = translate((*assertionsToPreprocess)[i]);
+    if (result.isNull())
+    {
+      // leave the assertions to the theory of strings
+      Trace("str-to-bv") << "StrToBV: assertions are unchanged" << std::endl;
+      d_constraints.clear();
+      return PreprocessingPassResult::NO_CONFLICT;
+    }
+    results.push_back(result);
+  }
+  for (size_t i = 0, size = results.size(); i < size; ++i)
+  {
+    assertionsToPreprocess->replace(i, Rewriter::rewrite(results[i]));
+  }
+  for (const Node& c : d_constraints)
+  {
+    assertionsToPreprocess->push_back(Rewriter::rewrite(c));
+  }
+  d_constraints.clear();
+  return PreprocessingPassResult::NO_CONFLICT;
+}
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
@@ -0,0 +1,99 @@
+/*********************                                                        */
+/*! \file str_to_bv.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The StrToBV preprocessing pass
+ **
+ ** Converts the constraints on strings of bounded length into bit-vector
+ ** constraints. The bound on the length of the strings is controlled through
+ ** the `--solve-str-as-bv` command line option.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PREPROCESSING__PASSES__STR_TO_BV_H
+#define CVC4__PREPROCESSING__PASSES__STR_TO_BV_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "preprocessing/preprocessing_pass.h"
+#include "preprocessing/preprocessing_pass_context.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+/**
+ * This pass encodes each string term t of length at most N, where N is the
+ * value of --solve-str-as-bv, as a bit-vector L_t for its length and N
+ * bit-vectors c_t[0], ..., c_t[N-1] of width 8 for the codes of its
+ * characters, where the characters at positions L_t and beyond are zero.
+ * The string constraints are then encoded eagerly as bit-vector constraints,
+ * for example x = y ++ z is encoded by L_x = L_y + L_z and, for each i,
+ * c_x[i] = ite( i < L_y, c_y[i], c_z[i - L_y] ).
+ *
+ * This applies to the constraints built from string variables and
+ * constants, str.++, ite, str.len, equalities, str.prefixof, str.suffixof
+ * and str.contains. If another string operator occurs in the assertions, or
+ * a constant longer than N, then the assertions are unchanged, and the
+ * problem is solved by the theory of strings.
+ *
+ * Since the lengths of the strings are bounded, an unsatisfiable answer is
+ * reported as unknown.
+ */
+class StrToBV : public PreprocessingPass
+{
+ public:
+  StrToBV(PreprocessingPassContext* preprocContext);
+
+ protected:
+  PreprocessingPassResult applyInternal(
+      AssertionPipeline* assertionsToPreprocess) override;
+
+ private:
+  /** The encoding of a string term */
+  struct Encoding
+  {
+    Node d_len;
+    std::vector<Node> d_chars;
+  };
+  /**
+   * Returns the translation of the non-string term n, or null if n contains
+   * a string term that is not supported.
+   */
+  Node translate(TNode n);
+  /**
+   * Computes the encoding of the string term s in e, returns false if s is
+   * not supported.
+   */
+  bool encode(TNode s, Encoding& e);
+  /** Returns the bit-vector constant i of the width of lengths */
+  Node mkLen(unsigned i) const;
+  /** Returns the character constant c */
+  Node mkChar(unsigned c) const;
+  /** The bound on the length of strings */
+  unsigned d_bound;
+  /** The width of the bit-vectors for lengths */
+  unsigned d_width;
+  /** The translations of the non-string terms */
+  std::unordered_map<Node, Node, NodeHashFunction> d_cache;
+  /** The encodings of the string terms */
+  std::unordered_map<Node, Encoding, NodeHashFunction> d_encodings;
+  /** The constraints on the encodings of the string terms */
+  std::vector<Node> d_constraints;
+};
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
+
+#endif /* CVC4__PREPROCESSING__PASSES__STR_TO_BV_H */
@@ -0,0 +1,261 @@
+/*********************                                                        */
+/*! \file symmetry_break.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the SymmetryBreak preprocessing pass
+ **/
+
+#include "preprocessing/passes/symmetry_break.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "expr/node_builder.h"
+#include "theory/rewriter.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+using namespace CVC4::kind;
+using namespace CVC4::theory;
+
+/** The maximal number of transpositions checked */
+static const unsigned s_maxChecks = 1000;
+
+/** Returns true if k is a commutative operator */
+static bool isCommutative(Kind k)
+{
+  switch (k)
+  {
+    case AND:
+    case OR:
+    case XOR:
+    case EQUAL:
+    case DISTINCT:
+    case PLUS:
+    case MULT:
+    case NONLINEAR_MULT:
+    case BITVECTOR_AND:
+    case BITVECTOR_OR:
+    case BITVECTOR_XOR:
+    case BITVECTOR_NAND:
+    case BITVECTOR_NOR:
+    case BITVECTOR_XNOR:
+    case BITVECTOR_COMP:
+    case BITVECTOR_PLUS:
+    case BITVECTOR_MULT: return true;
+    default: break;
+  }
+  return false;
+}
+
+SymmetryBreak::SymmetryBreak(PreprocessingPassContext* preprocContext)
+    : PreprocessingPass(preprocContext, "symmetry-break"){};
+
+Node SymmetryBreak::canonize(
+    TNode n, std::unordered_map<TNode, Node, TNodeHashFunction>& cache)
+{
+  std::unordered_map<TNode, Node, TNodeHashFunction>::iterator it =
+      cache.find(n);
+  if (it != cache.end())
+  {
+    return it->second;
+  }
+  Node ret = n;
+  if (n.getNumChildren() > 0)
+  {
+    std::vector<Node> children;
+    for (const Node& nc : n)
+    {
+      children.push_back(canonize(nc, cache));
+    }
+    if (isCommutative(n.getKind()))
+    {
+      std::sort(children.begin(), children.end());
+    }
+    NodeBuilder<> nb(n.getKind());
+    if (n.getMetaKind() == metakind::PARAMETERIZED)
+    {
+      nb << n.getOperator();
+    }
+    nb.append(children);
+    ret = nb.constructNode();
+  }
+  cache[n] = ret;
+  return ret;
+}
+
+bool SymmetryBreak::isSymmetric(const std::vector<Node>& assertions,
+                                const std::vector<Node>& canonical,
+                                Node x,
+                                Node y)
+{
+  std::vector<Node> vars;
+  vars.push_back(x);
+  vars.push_back(y);
+  std::vector<Node> subs;
+  subs.push_back(y);
+  subs.push_back(x);
+  std::unordered_map<TNode, Node, TNodeHashFunction> cache;
+  std::vector<Node> transposed;
+  for (const Node& a : assertions)
+  {
+    Node at = a.substitute(vars.begin(), vars.end(), subs.begin(), subs.end());
+    transposed.push_back(canonize(at, cache));
+  }
+  std::sort(transposed.begin(), transposed.end());
+  return transposed == canonical;
+}
+
+Node SymmetryBreak::mkOrder(Node x, Node y)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  TypeNode tn = x.getType();
+  if (tn.isBoolean())
+  {
+    return nm->mkNode(IMPLIES, x, y);
+  }
+  else if (tn.isBitVector())
+  {
+    return nm->mkNode(BITVECTOR_ULE, x, y);
+  }
+  Assert(tn.isReal());
+  return nm->mkNode(LEQ, x, y);
+}
+
+PreprocessingPassResult SymmetryBreak::applyInternal(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  std::vector<Node> assertions;
+  for (size_t i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
+  {
+    assertions.push_back((*assertionsToPreprocess)[i]);
+  }
+  // the signature of each candidate constant, which maps the kinds of its
+  // parents, and its positions in them if they are not commutative, to the
+  // number of its occurrences
+  typedef std::map<std::pair<Kind, int>, unsigned> Signature;
+  std::map<Node, Signature> sigs;
+  std::vector<Node> cands;
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::vector<TNode> visit;
+  for (const Node& a : assertions)
+  {
+    visit.push_back(a);
+  }
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    if (!visited.insert(cur).second)
+    {
+      continue;
+    }
+    if (cur.isVar() && cur.getKind() != BOUND_VARIABLE)
+    {
+      TypeNode tn = cur.getType();
+      if (tn.isBoolean() || tn.isBitVector() || tn.isReal())
+      {
+        cands.push_back(cur);
+      }
+    }
+    bool comm = isCommutative(cur.getKind());
+    for (unsigned i = 0, nchild = cur.getNumChildren(); i < nchild; i++)
+    {
+      if (cur[i].isVar())
+      {
+        sigs[cur[i]][std::make_pair(cur.getKind(), comm ? -1 : int(i))]++;
+      }
+      visit.push_back(cur[i]);
+    }
+  }
+  for (const Node& a : assertions)
+  {
+    if (a.isVar())
+    {
+      sigs[a][std::make_pair(UNDEFINED_KIND, -1)]++;
+    }
+  }
+  // group the candidates by their type and signature
+  std::map<std::pair<TypeNode, Signature>, std::vector<Node> > groups;
+  for (const Node& c : cands)
+  {
+    groups[std::make_pair(c.getType(), sigs[c])].push_back(c);
+  }
+  std::vector<Node> canonical;
+  std::unordered_map<TNode, Node, TNodeHashFunction> cache;
+  for (const Node& a : assertions)
+  {
+    canonical.push_back(canonize(a, cache));
+  }
+  std::sort(canonical.begin(), canonical.end());
+  unsigned nchecks = 0;
+  std::vector<Node> constraints;
+  for (const std::pair<const std::pair<TypeNode, Signature>,
+                       std::vector<Node> >& g : groups)
+  {
+    if (g.second.size() < 2)
+    {
+      continue;
+    }
+    // the classes of interchangeable constants in this group
+    std::vector<std::vector<Node> > classes;
+    for (const Node& c : g.second)
+    {
+      bool added = false;
+      for (std::vector<Node>& cl : classes)
+      {
+        if (nchecks >= s_maxChecks)
+        {
+          break;
+        }
+        nchecks++;
+        if (isSymmetric(assertions, canonical, cl[0], c))
+        {
+          cl.push_back(c);
+          added = true;
+          break;
+        }
+      }
+      if (!added)
+      {
+        classes.push_back(std::vector<Node>(1, c));
+      }
+    }
+    for (const std::vector<Node>& cl : classes)
+    {
+      if (cl.size() < 2)
+      {
+        continue;
+      }
+      Trace("sym-break") << "SymmetryBreak: interchangeable constants";
+      for (const Node& c : cl)
+      {
+        Trace("sym-break") << " " << c;
+      }
+      Trace("sym-break") << std::endl;
+      for (size_t i = 0, size = cl.size(); i + 1 < size; i++)
+      {
+        constraints.push_back(mkOrder(cl[i], cl[i + 1]));
+      }
+    }
+  }
+  for (const Node& c : constraints)
+  {
+    Trace("sym-break") << "SymmetryBreak: add " << c << std::endl;
+    assertionsToPreprocess->push_back(Rewriter::rewrite(c));
+  }
+  return PreprocessingPassResult::NO_CONFLICT;
+}
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
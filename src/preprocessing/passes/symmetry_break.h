@@ -0,0 +1,83 @@
+/*********************                                                        */
+/*! \file symmetry_break.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The SymmetryBreak preprocessing pass
+ **
+ ** Detects the sets of interchangeable free constants of Boolean, bit-vector
+ ** and arithmetic type in the assertions, and breaks their symmetry by
+ ** ordering them.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PREPROCESSING__PASSES__SYMMETRY_BREAK_H
+#define CVC4__PREPROCESSING__PASSES__SYMMETRY_BREAK_H
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "preprocessing/preprocessing_pass.h"
+#include "preprocessing/preprocessing_pass_context.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+/**
+ * This pass computes classes of free constants x1, ..., xn of the same
+ * Boolean, bit-vector, integer or real type, such that the assertions are
+ * invariant, modulo the commutativity of operators, under the transposition
+ * of x1 and xi for each i. Since these transpositions generate all the
+ * permutations of x1, ..., xn, any model of the assertions can be permuted to
+ * a model where x1 <= ... <= xn, hence these constraints are added to the
+ * assertions, where <= is the unsigned order for bit-vectors and the order
+ * false < true for Booleans (the lex-leader constraints for the permutations
+ * of a single set of constants).
+ *
+ * The candidate constants are grouped by a signature of their occurrences,
+ * which is invariant under the symmetries of the assertions, so that only the
+ * constants with the same signature are compared.
+ */
+class SymmetryBreak : public PreprocessingPass
+{
+ public:
+  SymmetryBreak(PreprocessingPassContext* preprocContext);
+
+ protected:
+  PreprocessingPassResult applyInternal(
+      AssertionPipeline* assertionsToPreprocess) override;
+
+ private:
+  /**
+   * Returns the canonical form of n modulo the commutativity of operators,
+   * where the children of commutative operators are sorted.
+   */
+  Node canonize(TNode n,
+                std::unordered_map<TNode, Node, TNodeHashFunction>& cache);
+  /**
+   * Returns true if the set of the canonical forms of the assertions is
+   * invariant under the transposition of x and y.
+   */
+  bool isSymmetric(const std::vector<Node>& assertions,
+                   const std::vector<Node>& canonical,
+                   Node x,
+                   Node y);
+  /** Returns the constraint x <= y for constants x and y of the same type */
+  Node mkOrder(Node x, Node y);
+};
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
+
+#endif /* CVC4__PREPROCESSING__PASSES__SYMMETRY_BREAK_H */
@@ -18,6 +18,8 @@
 
 #include "preprocessing/passes/unconstrained_simplifier.h"
 
+#include "expr/node_algorithm.h"
+#include "options/smt_options.h"
 #include "smt/smt_statistics_registry.h"
 #include "theory/logic_info.h"
 #include "theory/rewriter.h"
@@ -34,14 +36,21 @@ UnconstrainedSimplifier::UnconstrainedSimplifier(
       d_numUnconstrainedElim("preprocessor::number of unconstrained elims", 0),
       d_context(preprocContext->getDecisionContext()),
       d_substitutions(preprocContext->getDecisionContext()),
-      d_logicInfo(preprocContext->getLogicInfo())
+      d_logicInfo(preprocContext->getLogicInfo()),
+      d_seenVars(preprocContext->getUserContext()),
+      d_eliminated(preprocContext->getUserContext()),
+      d_reintroduced(preprocContext->getUserContext()),
+      d_numReintroduced("preprocessor::number of unconstrained reintroductions",
+                        0)
 {
   smtStatisticsRegistry()->registerStat(&d_numUnconstrainedElim);
+  smtStatisticsRegistry()->registerStat(&d_numReintroduced);
 }
 
 UnconstrainedSimplifier::~UnconstrainedSimplifier()
 {
   smtStatisticsRegistry()->unregisterStat(&d_numUnconstrainedElim);
+  smtStatisticsRegistry()->unregisterStat(&d_numReintroduced);
 }
 
 struct unc_preprocess_stack_element
@@ -85,8 +94,9 @@ void UnconstrainedSimplifier::visitAll(TNode assertion)
 
     if (current.getNumChildren() == 0)
     {
-      if (current.getKind() == kind::VARIABLE
-          || current.getKind() == kind::SKOLEM)
+      if ((current.getKind() == kind::VARIABLE
+           || current.getKind() == kind::SKOLEM)
+          && d_seenVars.find(current) == d_seenVars.end())
       {
         d_unconstrained.insert(current);
       }
@@ -816,6 +826,39 @@ PreprocessingPassResult UnconstrainedSimplifier::applyInternal(
   d_preprocContext->spendResource(ResourceManager::Resource::PreprocessStep);
 
   std::vector<Node>& assertions = assertionsToPreprocess->ref();
+  bool incremental = options::incrementalSolving();
+
+  if (incremental && !d_eliminated.empty())
+  {
+    // the new assertions constrain again the variables they share with the
+    // ones simplified before: assert again the definitions of those
+    std::unordered_set<Node, NodeHashFunction> syms;
+    for (size_t i = 0; i < assertions.size(); ++i)
+    {
+      syms.clear();
+      expr::getSymbols(assertions[i], syms);
+      for (const Node& v : syms)
+      {
+        context::CDHashMap<Node, unsigned, NodeHashFunction>::const_iterator
+            it = d_eliminated.find(v);
+        if (it == d_eliminated.end()
+            || d_reintroduced.find((*it).second) != d_reintroduced.end())
+        {
+          continue;
+        }
+        unsigned call = (*it).second;
+        Trace("unc-simp") << "unconstrained: " << v
+                          << " is constrained again, reintroduce call " << call
+                          << std::endl;
+        d_reintroduced.insert(call);
+        ++d_numReintroduced;
+        for (const Node& def : d_definitions[call])
+        {
+          assertionsToPreprocess->push_back(def);
+        }
+      }
+    }
+  }
 
   d_context->push();
 
@@ -832,6 +875,34 @@ PreprocessingPassResult UnconstrainedSimplifier::applyInternal(
     {
       assertion = Rewriter::rewrite(d_substitutions.apply(assertion));
     }
+    if (incremental)
+    {
+      // remember how to constrain the eliminated terms again
+      unsigned call = d_definitions.size();
+      d_definitions.push_back(std::vector<Node>());
+      for (SubstitutionMap::iterator it = d_substitutions.begin();
+           it != d_substitutions.end();
+           ++it)
+      {
+        d_definitions[call].push_back((*it).first.eqNode((*it).second));
+      }
+      for (TNode v : d_unconstrained)
+      {
+        d_eliminated.insert(v, call);
+      }
+    }
+  }
+  if (incremental)
+  {
+    std::unordered_set<Node, NodeHashFunction> syms;
+    for (const Node& assertion : assertions)
+    {
+      expr::getSymbols(assertion, syms);
+    }
+    for (const Node& v : syms)
+    {
+      d_seenVars.insert(v);
+    }
   }
 
   // to clear substitutions map
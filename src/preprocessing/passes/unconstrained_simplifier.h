@@ -25,6 +25,8 @@
 #include <unordered_set>
 #include <vector>
 
+#include "context/cdhashmap.h"
+#include "context/cdhashset.h"
 #include "context/context.h"
 #include "expr/node.h"
 #include "preprocessing/preprocessing_pass.h"
@@ -63,6 +65,25 @@ class UnconstrainedSimplifier : public PreprocessingPass
 
   const LogicInfo& d_logicInfo;
 
+  /**
+   * For incremental solving: the variables of the assertions simplified so
+   * far (in the current user context), which are not unconstrained in the
+   * later assertions.
+   */
+  context::CDHashSet<Node, NodeHashFunction> d_seenVars;
+  /**
+   * For incremental solving: the variables eliminated by each call, mapped
+   * to the index of the call, and the definitions ( t = s ) of the
+   * substitutions of each call.  If an eliminated variable occurs in a later
+   * assertion, the definitions of its call are asserted again, once for
+   * each user context.
+   */
+  context::CDHashMap<Node, unsigned, NodeHashFunction> d_eliminated;
+  std::vector<std::vector<Node> > d_definitions;
+  context::CDHashSet<unsigned, std::hash<unsigned> > d_reintroduced;
+  /** number of calls whose definitions were asserted again */
+  IntStat d_numReintroduced;
+
   void visitAll(TNode assertion);
   Node newUnconstrainedVar(TypeNode t, TNode var);
   void processUnconstrained();
@@ -0,0 +1,111 @@
+/*********************                                                        */
+/*! \file preprocessing_cache.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A cache of the results of preprocessing passes
+ **/
+
+#include "preprocessing/preprocessing_cache.h"
+
+#include <functional>
+
+#include "options/options.h"
+#include "util/hash.h"
+
+namespace CVC4 {
+namespace preprocessing {
+
+bool PreprocessingCache::Key::operator==(const Key& k) const
+{
+  return d_hash == k.d_hash && d_realAssertionsEnd == k.d_realAssertionsEnd
+         && d_pass == k.d_pass && d_assertions == k.d_assertions;
+}
+
+PreprocessingCache::Key PreprocessingCache::makeKey(
+    const std::string& pass,
+    const std::vector<Node>& assertions,
+    size_t realAssertionsEnd)
+{
+  Key key;
+  key.d_pass = pass;
+  key.d_assertions = assertions;
+  key.d_realAssertionsEnd = realAssertionsEnd;
+
+  std::hash<std::string> hashString;
+  uint64_t hash = fnv1a::fnv1a_64(hashString(pass));
+  hash = fnv1a::fnv1a_64(realAssertionsEnd, hash);
+  for (const Node& a : assertions)
+  {
+    hash = fnv1a::fnv1a_64(a.getId(), hash);
+  }
+  key.d_hash = static_cast<size_t>(hash);
+  return key;
+}
+
+void PreprocessingCache::setLogicAndOptions(const std::string& logic)
+{
+  const Options* opts = Options::current();
+  if (logic == d_logic && opts->getValuesVersion() == d_optionsVersion
+      && !d_fingerprint.empty())
+  {
+    return;
+  }
+  std::string fingerprint = logic;
+  for (const std::vector<std::string>& opt : opts->getOptions())
+  {
+    for (const std::string& s : opt)
+    {
+      fingerprint += ' ';
+      fingerprint += s;
+    }
+  }
+  if (fingerprint != d_fingerprint)
+  {
+    clear();
+    d_fingerprint = fingerprint;
+  }
+  d_logic = logic;
+  d_optionsVersion = opts->getValuesVersion();
+}
+
+const PreprocessingCache::Entry* PreprocessingCache::lookup(
+    const Key& key) const
+{
+  EntryMap::const_iterator it = d_entries.find(key);
+  return it == d_entries.end() ? nullptr : &it->second;
+}
+
+void PreprocessingCache::insert(const Key& key,
+                                const Entry& entry,
+                                size_t budget)
+{
+  std::pair<EntryMap::iterator, bool> res = d_entries.emplace(key, entry);
+  if (!res.second)
+  {
+    res.first->second = entry;
+    return;
+  }
+  d_order.push_back(&res.first->first);
+  while (d_entries.size() > budget)
+  {
+    EntryMap::iterator oldest = d_entries.find(*d_order.front());
+    d_order.pop_front();
+    d_entries.erase(oldest);
+  }
+}
+
+void PreprocessingCache::clear()
+{
+  d_order.clear();
+  d_entries.clear();
+}
+
+}  // namespace preprocessing
+}  // namespace CVC4
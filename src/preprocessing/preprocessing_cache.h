@@ -0,0 +1,134 @@
+/*********************                                                        */
+/*! \file preprocessing_cache.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A cache of the results of preprocessing passes
+ **
+ ** The cache maps the input of a preprocessing pass, i.e. the name of the
+ ** pass and the list of assertions, to the list of assertions that the pass
+ ** produced and to the substitutions it added.  It is owned by the
+ ** SmtEngine, so that the results survive (reset-assertions).  The entries
+ ** are only valid for the logic and the options they were computed under
+ ** and the cache is emptied when either changes.  Since nodes are
+ ** hash-consed, two lists of assertions are structurally equal iff they
+ ** contain the same nodes.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PREPROCESSING__PREPROCESSING_CACHE_H
+#define CVC4__PREPROCESSING__PREPROCESSING_CACHE_H
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "expr/node.h"
+
+namespace CVC4 {
+namespace preprocessing {
+
+class PreprocessingCache
+{
+ public:
+  /** The input of a pass. */
+  struct Key
+  {
+    /** The name of the pass */
+    std::string d_pass;
+    /** The assertions to preprocess */
+    std::vector<Node> d_assertions;
+    /** The number of assertions before the ones added by ITE removal */
+    size_t d_realAssertionsEnd;
+    /** The hash of all of the above */
+    size_t d_hash;
+
+    bool operator==(const Key& k) const;
+  };
+
+  /** The result of a pass. */
+  struct Entry
+  {
+    Entry() : d_conflict(false) {}
+
+    /** The preprocessed assertions */
+    std::vector<Node> d_assertions;
+    /** Did the pass find a conflict? */
+    bool d_conflict;
+    /** The substitutions added to the top-level substitutions */
+    std::vector<std::pair<Node, Node>> d_topLevelSubstitutions;
+    /** The substitutions added to the model */
+    std::vector<std::pair<Node, Node>> d_modelSubstitutions;
+  };
+
+  PreprocessingCache() : d_optionsVersion(0) {}
+
+  /**
+   * Make the key for applying pass to assertions.
+   *
+   * @param pass the name of the pass
+   * @param assertions the assertions to preprocess
+   * @param realAssertionsEnd the number of assertions not added by ITE
+   * removal
+   */
+  static Key makeKey(const std::string& pass,
+                     const std::vector<Node>& assertions,
+                     size_t realAssertionsEnd);
+
+  /**
+   * Notify the cache that passes are applied under the logic and the current
+   * options. Passes are only replayed for the same logic and options, so the
+   * cache is cleared if they differ from those of the entries. The options
+   * are only compared if they were written to since the last call.
+   */
+  void setLogicAndOptions(const std::string& logic);
+
+  /** Returns the entry for key, or nullptr if there is none. */
+  const Entry* lookup(const Key& key) const;
+
+  /**
+   * Store the entry for key. If the cache then holds more than budget
+   * entries, the oldest ones are evicted.
+   */
+  void insert(const Key& key, const Entry& entry, size_t budget);
+
+  /** Remove all the entries. */
+  void clear();
+
+  /** Returns the number of entries. */
+  size_t size() const { return d_entries.size(); }
+
+ private:
+  struct KeyHashFunction
+  {
+    size_t operator()(const Key& k) const { return k.d_hash; }
+  };
+  typedef std::unordered_map<Key, Entry, KeyHashFunction> EntryMap;
+
+  /** The logic and the values of the options of the entries */
+  std::string d_fingerprint;
+  /** The version of the options that d_fingerprint was computed from */
+  uint64_t d_optionsVersion;
+  /** The logic of the entries */
+  std::string d_logic;
+
+  /** The entries */
+  EntryMap d_entries;
+  /** The keys of the entries (owned by d_entries), oldest first */
+  std::deque<const Key*> d_order;
+}; /* class PreprocessingCache */
+
+}  // namespace preprocessing
+}  // namespace CVC4
+
+#endif /* CVC4__PREPROCESSING__PREPROCESSING_CACHE_H */
@@ -16,8 +16,13 @@
 
 #include "preprocessing/preprocessing_pass.h"
 
+#include <memory>
+
+#include "options/smt_options.h"
 #include "smt/dump.h"
 #include "smt/smt_statistics_registry.h"
+#include "theory/theory_model.h"
+#include "util/phase_profiler.h"
 
 namespace CVC4 {
 namespace preprocessing {
@@ -25,15 +30,101 @@ namespace preprocessing {
 PreprocessingPassResult PreprocessingPass::apply(
     AssertionPipeline* assertionsToPreprocess) {
   TimerStat::CodeTimer codeTimer(d_timer);
+  PhaseScope phase(d_name);
   Trace("preprocessing") << "PRE " << d_name << std::endl;
   Chat() << d_name << "..." << std::endl;
   dumpAssertions(("pre-" + d_name).c_str(), *assertionsToPreprocess);
-  PreprocessingPassResult result = applyInternal(assertionsToPreprocess);
+  PreprocessingProfile* profile = d_preprocContext->getProfile();
+  std::unique_ptr<PreprocessingProfile::Run> run;
+  if (profile != nullptr)
+  {
+    run.reset(new PreprocessingProfile::Run(assertionsToPreprocess->ref()));
+  }
+  PreprocessingPassResult result;
+  // The cached results do not record the dependencies of the assertions
+  // (for unsat cores and proofs), the substitutions stored as assertions (in
+  // incremental mode) or the ITE skolems (once ITEs have been removed)
+  if (options::preprocessCache() > 0 && isCacheable()
+      && !assertionsToPreprocess->storeSubstsInAsserts()
+      && assertionsToPreprocess->getIteSkolemMap().empty()
+      && !options::unsatCores() && !options::proof())
+  {
+    result = applyCached(assertionsToPreprocess);
+  }
+  else
+  {
+    result = applyInternal(assertionsToPreprocess);
+  }
+  if (profile != nullptr)
+  {
+    profile->record(d_name, *run, assertionsToPreprocess->ref());
+  }
   dumpAssertions(("post-" + d_name).c_str(), *assertionsToPreprocess);
   Trace("preprocessing") << "POST " << d_name << std::endl;
   return result;
 }
 
+PreprocessingPassResult PreprocessingPass::applyCached(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  PreprocessingCache* cache = d_preprocContext->getPreprocessingCache();
+  cache->setLogicAndOptions(d_preprocContext->getLogicInfo().getLogicString());
+  PreprocessingCache::Key key = PreprocessingCache::makeKey(
+      d_name,
+      assertionsToPreprocess->ref(),
+      assertionsToPreprocess->getRealAssertionsEnd());
+
+  const PreprocessingCache::Entry* cached = cache->lookup(key);
+  if (cached != nullptr)
+  {
+    Trace("preprocessing") << "CACHED " << d_name << std::endl;
+    d_preprocContext->notifyCacheHit();
+    assertionsToPreprocess->ref() = cached->d_assertions;
+    theory::SubstitutionMap& top_level_substs =
+        d_preprocContext->getTopLevelSubstitutions();
+    for (const std::pair<Node, Node>& s : cached->d_topLevelSubstitutions)
+    {
+      top_level_substs.addSubstitution(s.first, s.second);
+    }
+    theory::TheoryModel* m = d_preprocContext->getTheoryEngine()->getModel();
+    for (const std::pair<Node, Node>& s : cached->d_modelSubstitutions)
+    {
+      m->addSubstitution(s.first, s.second);
+    }
+    return cached->d_conflict ? PreprocessingPassResult::CONFLICT
+                              : PreprocessingPassResult::NO_CONFLICT;
+  }
+
+  d_preprocContext->notifyCacheMiss();
+  PreprocessingPassResult result = applyInternal(assertionsToPreprocess);
+  PreprocessingCache::Entry entry;
+  if (recordSideEffects(entry))
+  {
+    entry.d_assertions = assertionsToPreprocess->ref();
+    entry.d_conflict = result == PreprocessingPassResult::CONFLICT;
+    cache->insert(key, entry, options::preprocessCache());
+  }
+  return result;
+}
+
+PreprocessingPassResult PreprocessingPass::applyInternal(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  Assert(isAssertionLocal());
+  for (size_t i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
+  {
+    assertionsToPreprocess->replace(
+        i, simplifyAssertion((*assertionsToPreprocess)[i]));
+  }
+  return PreprocessingPassResult::NO_CONFLICT;
+}
+
+Node PreprocessingPass::simplifyAssertion(TNode a)
+{
+  Unreachable() << "simplifyAssertion on the pass " << d_name
+                << ", which is not assertion-local";
+}
+
 void PreprocessingPass::dumpAssertions(const char* key,
                                        const AssertionPipeline& assertionList) {
   if (Dump.isOn("assertions") && Dump.isOn(std::string("assertions:") + key))
@@ -21,6 +21,9 @@
  ** - Dumping assertions before and after the pass
  ** - Initializing the timer
  ** - Tracing and chatting
+ ** - Profiling the pass, with --preprocess-profile
+ ** - Replaying the result of the pass from the preprocessing cache, if the
+ **   pass is cacheable and --preprocess-cache is on
  **
  ** Optionally, preprocessing passes can overwrite the initInteral() method to
  ** do work that only needs to be done once.
@@ -34,6 +37,7 @@
 #include <string>
 
 #include "preprocessing/assertion_pipeline.h"
+#include "preprocessing/preprocessing_cache.h"
 #include "preprocessing/preprocessing_pass_context.h"
 #include "smt/smt_engine_scope.h"
 #include "theory/logic_info.h"
@@ -64,15 +68,52 @@ class PreprocessingPass {
   void dumpAssertions(const char* key, const AssertionPipeline& assertionList);
 
   /*
-   * Abstract method that each pass implements to do the actual preprocessing.
+   * Method that each pass implements to do the actual preprocessing. The
+   * default implementation, which is only valid for assertion-local passes,
+   * replaces each assertion by the result of simplifyAssertion on it.
    */
   virtual PreprocessingPassResult applyInternal(
-      AssertionPipeline* assertionsToPreprocess) = 0;
+      AssertionPipeline* assertionsToPreprocess);
+
+  /*
+   * Returns true if the pass is assertion-local, that is, it only replaces
+   * each assertion by the result of simplifyAssertion on it, independently of
+   * the other assertions and without other side effects. Passes are not
+   * assertion-local by default.
+   */
+  virtual bool isAssertionLocal() const { return false; }
+
+  /* Returns the result of an assertion-local pass on the assertion a. */
+  virtual Node simplifyAssertion(TNode a);
+
+  /*
+   * Returns true if the result of applyInternal only depends on the
+   * assertions, the logic and the options, so that it can be stored in the
+   * preprocessing cache and replayed. Passes are not cacheable by default.
+   */
+  virtual bool isCacheable() const { return false; }
+
+  /*
+   * Called after applyInternal on a cacheable pass. Records the
+   * substitutions added by the last call to applyInternal in entry, or
+   * returns false if that call had other side effects, in which case its
+   * result is not cached.
+   */
+  virtual bool recordSideEffects(PreprocessingCache::Entry& entry)
+  {
+    return true;
+  }
 
   /* Context for Preprocessing Passes that initializes necessary variables */
   PreprocessingPassContext* d_preprocContext;
 
  private:
+  /*
+   * Replays the cached result of this pass on assertionsToPreprocess, if
+   * there is one, and stores the result of the pass in the cache otherwise.
+   */
+  PreprocessingPassResult applyCached(AssertionPipeline* assertionsToPreprocess);
+
   /* Name of pass */
   std::string d_name;
   /* Timer for registering the preprocessing time of this pass */
@@ -17,6 +17,8 @@
 #include "preprocessing_pass_context.h"
 
 #include "expr/node_algorithm.h"
+#include "options/smt_options.h"
+#include "smt/smt_statistics_registry.h"
 
 namespace CVC4 {
 namespace preprocessing {
@@ -31,8 +33,30 @@ PreprocessingPassContext::PreprocessingPassContext(
       d_iteRemover(iteRemover),
       d_topLevelSubstitutions(smt->getUserContext()),
       d_circuitPropagator(circuitPropagator),
-      d_symsInAssertions(smt->getUserContext())
+      d_symsInAssertions(smt->getUserContext()),
+      d_cacheHits("preprocessing::cacheHits", 0),
+      d_cacheMisses("preprocessing::cacheMisses", 0)
 {
+  smtStatisticsRegistry()->registerStat(&d_cacheHits);
+  smtStatisticsRegistry()->registerStat(&d_cacheMisses);
+  if (options::preprocessProfile())
+  {
+    d_profile.reset(new PreprocessingProfile("preprocessing::profile"));
+    smtStatisticsRegistry()->registerStat(d_profile.get());
+  }
+}
+
+PreprocessingPassContext::~PreprocessingPassContext()
+{
+  if (smtStatisticsRegistry() != nullptr)
+  {
+    smtStatisticsRegistry()->unregisterStat(&d_cacheHits);
+    smtStatisticsRegistry()->unregisterStat(&d_cacheMisses);
+    if (d_profile != nullptr)
+    {
+      smtStatisticsRegistry()->unregisterStat(d_profile.get());
+    }
+  }
 }
 
 void PreprocessingPassContext::widenLogic(theory::TheoryId id)
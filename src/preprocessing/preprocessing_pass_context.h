@@ -21,15 +21,19 @@
 #ifndef CVC4__PREPROCESSING__PREPROCESSING_PASS_CONTEXT_H
 #define CVC4__PREPROCESSING__PREPROCESSING_PASS_CONTEXT_H
 
+#include <memory>
+
 #include "context/cdo.h"
 #include "context/context.h"
 #include "decision/decision_engine.h"
+#include "preprocessing/preprocessing_profile.h"
 #include "preprocessing/util/ite_utilities.h"
 #include "smt/smt_engine.h"
 #include "smt/term_formula_removal.h"
 #include "theory/booleans/circuit_propagator.h"
 #include "theory/theory_engine.h"
 #include "util/resource_manager.h"
+#include "util/statistics_registry.h"
 
 namespace CVC4 {
 namespace preprocessing {
@@ -42,6 +46,7 @@ class PreprocessingPassContext
       ResourceManager* resourceManager,
       RemoveTermFormulas* iteRemover,
       theory::booleans::CircuitPropagator* circuitPropagator);
+  ~PreprocessingPassContext();
 
   SmtEngine* getSmt() { return d_smt; }
   TheoryEngine* getTheoryEngine() { return d_smt->getTheoryEngine(); }
@@ -65,6 +70,9 @@ class PreprocessingPassContext
     d_resourceManager->spendResource(r);
   }
 
+  /** Returns true if the memory limit was exceeded during this call */
+  bool memoryShed() const { return d_resourceManager->memoryShed(); }
+
   const LogicInfo& getLogicInfo() { return d_smt->d_logic; }
 
   /* Widen the logic to include the given theory. */
@@ -86,6 +94,20 @@ class PreprocessingPassContext
    */
   void recordSymbolsInAssertions(const std::vector<Node>& assertions);
 
+  /** Returns the profile of the passes, or nullptr if not profiling */
+  PreprocessingProfile* getProfile() { return d_profile.get(); }
+
+  /** Gets the cache of the results of the passes of this SmtEngine */
+  PreprocessingCache* getPreprocessingCache()
+  {
+    return d_smt->getPreprocessingCache();
+  }
+
+  /** Count a pass whose result was replayed from the preprocessing cache */
+  void notifyCacheHit() { ++d_cacheHits; }
+  /** Count a cacheable pass that was not found in the preprocessing cache */
+  void notifyCacheMiss() { ++d_cacheMisses; }
+
  private:
   /** Pointer to the SmtEngine that this context was created in. */
   SmtEngine* d_smt;
@@ -108,6 +130,14 @@ class PreprocessingPassContext
    */
   context::CDHashSet<Node, NodeHashFunction> d_symsInAssertions;
 
+  /** The number of hits in the preprocessing cache */
+  IntStat d_cacheHits;
+  /** The number of misses in the preprocessing cache */
+  IntStat d_cacheMisses;
+
+  /** The profile of the passes, with --preprocess-profile */
+  std::unique_ptr<PreprocessingProfile> d_profile;
+
 };  // class PreprocessingPassContext
 
 }  // namespace preprocessing
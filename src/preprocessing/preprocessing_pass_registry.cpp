@@ -32,14 +32,18 @@
 #include "preprocessing/passes/bv_intro_pow2.h"
 #include "preprocessing/passes/bv_to_bool.h"
 #include "preprocessing/passes/bv_to_int.h"
+#include "preprocessing/passes/decompose_assertions.h"
+#include "preprocessing/passes/dedup_assertions.h"
 #include "preprocessing/passes/extended_rewriter_pass.h"
 #include "preprocessing/passes/global_negate.h"
 #include "preprocessing/passes/ho_elim.h"
 #include "preprocessing/passes/int_to_bv.h"
 #include "preprocessing/passes/ite_removal.h"
 #include "preprocessing/passes/ite_simp.h"
+#include "preprocessing/passes/local_search.h"
 #include "preprocessing/passes/miplib_trick.h"
 #include "preprocessing/passes/nl_ext_purify.h"
+#include "preprocessing/passes/pb_constraints.h"
 #include "preprocessing/passes/non_clausal_simp.h"
 #include "preprocessing/passes/pseudo_boolean_processor.h"
 #include "preprocessing/passes/quantifier_macros.h"
@@ -49,7 +53,9 @@
 #include "preprocessing/passes/sep_skolem_emp.h"
 #include "preprocessing/passes/sort_infer.h"
 #include "preprocessing/passes/static_learning.h"
+#include "preprocessing/passes/str_to_bv.h"
 #include "preprocessing/passes/sygus_inference.h"
+#include "preprocessing/passes/symmetry_break.h"
 #include "preprocessing/passes/synth_rew_rules.h"
 #include "preprocessing/passes/theory_preprocess.h"
 #include "preprocessing/passes/unconstrained_simplifier.h"
@@ -121,6 +127,8 @@ PreprocessingPassRegistry::PreprocessingPassRegistry()
   registerPassInfo("ite-simp", callCtor<ITESimp>);
   registerPassInfo("global-negate", callCtor<GlobalNegate>);
   registerPassInfo("int-to-bv", callCtor<IntToBV>);
+  registerPassInfo("str-to-bv", callCtor<StrToBV>);
+  registerPassInfo("symmetry-break", callCtor<SymmetryBreak>);
   registerPassInfo("bv-to-int", callCtor<BVToInt>);
   registerPassInfo("synth-rr", callCtor<SynthRewRulesPass>);
   registerPassInfo("real-to-int", callCtor<RealToInt>);
@@ -139,6 +147,10 @@ PreprocessingPassRegistry::PreprocessingPassRegistry()
   registerPassInfo("quantifiers-preprocess", callCtor<QuantifiersPreprocess>);
   registerPassInfo("ite-removal", callCtor<IteRemoval>);
   registerPassInfo("miplib-trick", callCtor<MipLibTrick>);
+  registerPassInfo("dedup-assertions", callCtor<DedupAssertions>);
+  registerPassInfo("decompose-assertions", callCtor<DecomposeAssertions>);
+  registerPassInfo("local-search", callCtor<LocalSearch>);
+  registerPassInfo("pb-constraints", callCtor<PbConstraints>);
   registerPassInfo("non-clausal-simp", callCtor<NonClausalSimp>);
   registerPassInfo("ackermann", callCtor<Ackermann>);
   registerPassInfo("ext-rew-pre", callCtor<ExtRewPre>);
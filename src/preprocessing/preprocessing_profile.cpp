@@ -0,0 +1,178 @@
+/*********************                                                        */
+/*! \file preprocessing_profile.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A profile of the preprocessing passes
+ **/
+
+#include "preprocessing/preprocessing_profile.h"
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <unordered_set>
+
+#include "theory/rewriter.h"
+
+namespace CVC4 {
+namespace preprocessing {
+
+namespace {
+
+/** Returns the percentage of part in total, or 0 if total is 0. */
+double percentage(uint64_t part, uint64_t total)
+{
+  return total == 0 ? 0.0 : (100.0 * part) / total;
+}
+
+}  // namespace
+
+PreprocessingProfile::Run::Run(const std::vector<Node>& assertions)
+    : d_assertions(assertions.size()),
+      d_dagSize(PreprocessingProfile::getDagSize(assertions))
+{
+  theory::Rewriter::getCacheCounts(d_rewriteCacheLookups, d_rewriteCacheHits);
+  // start the clock last, so that the measurements are not part of the run
+  d_start = std::chrono::steady_clock::now();
+}
+
+PreprocessingProfile::PassProfile::PassProfile()
+    : d_runs(0),
+      d_time(0),
+      d_assertionsBefore(0),
+      d_assertionsAfter(0),
+      d_dagSizeBefore(0),
+      d_dagSizeAfter(0),
+      d_maxDagSizeAfter(0),
+      d_rewriteCacheLookups(0),
+      d_rewriteCacheHits(0)
+{
+}
+
+PreprocessingProfile::PreprocessingProfile(const std::string& name)
+    : Stat(name)
+{
+}
+
+void PreprocessingProfile::record(const std::string& pass,
+                                  const Run& run,
+                                  const std::vector<Node>& assertions)
+{
+  std::chrono::duration<double> time =
+      std::chrono::steady_clock::now() - run.d_start;
+  uint64_t lookups, hits;
+  theory::Rewriter::getCacheCounts(lookups, hits);
+  size_t dagSize = getDagSize(assertions);
+
+  std::map<std::string, PassProfile>::iterator it = d_passes.find(pass);
+  if (it == d_passes.end())
+  {
+    it = d_passes.insert(std::make_pair(pass, PassProfile())).first;
+    d_order.push_back(pass);
+  }
+  PassProfile& p = it->second;
+  p.d_runs++;
+  p.d_time += time.count();
+  p.d_assertionsBefore += run.d_assertions;
+  p.d_assertionsAfter += assertions.size();
+  p.d_dagSizeBefore += run.d_dagSize;
+  p.d_dagSizeAfter += dagSize;
+  p.d_maxDagSizeAfter = std::max<uint64_t>(p.d_maxDagSizeAfter, dagSize);
+  p.d_rewriteCacheLookups += lookups - run.d_rewriteCacheLookups;
+  p.d_rewriteCacheHits += hits - run.d_rewriteCacheHits;
+}
+
+void PreprocessingProfile::printTable(std::ostream& out) const
+{
+  std::ios_base::fmtflags flags = out.flags();
+  std::streamsize precision = out.precision();
+  out << std::left << std::setw(28) << "pass" << std::right << std::setw(6)
+      << "runs" << std::setw(12) << "time (s)" << std::setw(12)
+      << "assertions" << std::setw(12) << "delta" << std::setw(12)
+      << "dag before" << std::setw(12) << "dag after" << std::setw(10)
+      << "rw hits" << std::endl;
+  out << std::fixed;
+  for (const std::string& name : d_order)
+  {
+    const PassProfile& p = d_passes.at(name);
+    int64_t delta = static_cast<int64_t>(p.d_assertionsAfter)
+                    - static_cast<int64_t>(p.d_assertionsBefore);
+    std::stringstream hits;
+    hits << std::fixed << std::setprecision(1)
+         << percentage(p.d_rewriteCacheHits, p.d_rewriteCacheLookups) << "%";
+    out << std::left << std::setw(28) << name << std::right << std::setw(6)
+        << p.d_runs << std::setw(12) << std::setprecision(6) << p.d_time
+        << std::setw(12) << p.d_assertionsAfter << std::setw(12)
+        << std::showpos << delta << std::noshowpos << std::setw(12)
+        << p.d_dagSizeBefore << std::setw(12) << p.d_dagSizeAfter
+        << std::setw(10) << hits.str() << std::endl;
+  }
+  out.flags(flags);
+  out.precision(precision);
+}
+
+void PreprocessingProfile::flushInformation(std::ostream& out) const
+{
+  std::ios_base::fmtflags flags = out.flags();
+  std::streamsize precision = out.precision();
+  out << std::fixed;
+  out << "{\"passes\": [";
+  for (size_t i = 0, size = d_order.size(); i < size; ++i)
+  {
+    const PassProfile& p = d_passes.at(d_order[i]);
+    out << (i == 0 ? "" : ", ") << "{\"name\": \"" << d_order[i] << "\""
+        << ", \"runs\": " << p.d_runs << ", \"time\": " << std::setprecision(6)
+        << p.d_time << ", \"assertionsBefore\": " << p.d_assertionsBefore
+        << ", \"assertionsAfter\": " << p.d_assertionsAfter
+        << ", \"dagSizeBefore\": " << p.d_dagSizeBefore
+        << ", \"dagSizeAfter\": " << p.d_dagSizeAfter
+        << ", \"maxDagSizeAfter\": " << p.d_maxDagSizeAfter
+        << ", \"rewriteCacheLookups\": " << p.d_rewriteCacheLookups
+        << ", \"rewriteCacheHits\": " << p.d_rewriteCacheHits
+        << ", \"rewriteCacheHitRate\": " << std::setprecision(4)
+        << percentage(p.d_rewriteCacheHits, p.d_rewriteCacheLookups) / 100
+        << "}";
+  }
+  out << "]}";
+  out.flags(flags);
+  out.precision(precision);
+}
+
+void PreprocessingProfile::safeFlushInformation(int fd) const
+{
+  // Formatting the report allocates, which is not safe in a signal handler.
+  safe_print(fd, "<unsupported>");
+}
+
+SExpr PreprocessingProfile::getValue() const
+{
+  std::stringstream ss;
+  flushInformation(ss);
+  return SExpr(SExprKeyword(ss.str()));
+}
+
+size_t PreprocessingProfile::getDagSize(const std::vector<Node>& assertions)
+{
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::vector<TNode> visit(assertions.begin(), assertions.end());
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    if (visited.insert(cur).second)
+    {
+      visit.insert(visit.end(), cur.begin(), cur.end());
+    }
+  }
+  return visited.size();
+}
+
+}  // namespace preprocessing
+}  // namespace CVC4
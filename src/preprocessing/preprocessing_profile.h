@@ -0,0 +1,118 @@
+/*********************                                                        */
+/*! \file preprocessing_profile.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A profile of the preprocessing passes
+ **
+ ** With --preprocess-profile, every run of a preprocessing pass records its
+ ** wall time, the number of assertions and the size of the assertion DAG
+ ** before and after the run, and the lookups in the rewrite caches during
+ ** the run.  The profile is registered as the statistic
+ ** preprocessing::profile, whose value is a JSON report, and is printed as a
+ ** table with --stats.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PREPROCESSING__PREPROCESSING_PROFILE_H
+#define CVC4__PREPROCESSING__PREPROCESSING_PROFILE_H
+
+#include <chrono>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "expr/node.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace preprocessing {
+
+class PreprocessingProfile : public Stat
+{
+ public:
+  /** The measurements of a run, taken before and after it. */
+  class Run
+  {
+   public:
+    /** Start the measurements of a run on assertions. */
+    Run(const std::vector<Node>& assertions);
+
+   private:
+    friend class PreprocessingProfile;
+
+    std::chrono::steady_clock::time_point d_start;
+    size_t d_assertions;
+    size_t d_dagSize;
+    uint64_t d_rewriteCacheLookups;
+    uint64_t d_rewriteCacheHits;
+  };
+
+  PreprocessingProfile(const std::string& name);
+
+  /**
+   * Record the run of pass that started with run and ended with the given
+   * assertions.
+   */
+  void record(const std::string& pass,
+              const Run& run,
+              const std::vector<Node>& assertions);
+
+  /** Print the profile as a table, one pass per line. */
+  void printTable(std::ostream& out) const;
+
+  /** Print the profile as a JSON object (on one line). */
+  void flushInformation(std::ostream& out) const override;
+
+  void safeFlushInformation(int fd) const override;
+
+  /**
+   * Returns the JSON report as a keyword, so that it is printed without
+   * quoting when the statistics are exported.
+   */
+  SExpr getValue() const override;
+
+  /** Returns the number of distinct nodes in assertions. */
+  static size_t getDagSize(const std::vector<Node>& assertions);
+
+ private:
+  /** The accumulated measurements of a pass. */
+  struct PassProfile
+  {
+    PassProfile();
+
+    /** The number of runs */
+    uint64_t d_runs;
+    /** The total wall time of the runs, in seconds */
+    double d_time;
+    /** The total number of assertions before and after the runs */
+    uint64_t d_assertionsBefore;
+    uint64_t d_assertionsAfter;
+    /** The total DAG size before and after the runs */
+    uint64_t d_dagSizeBefore;
+    uint64_t d_dagSizeAfter;
+    /** The largest DAG size after a run */
+    uint64_t d_maxDagSizeAfter;
+    /** The lookups and hits in the rewrite caches during the runs */
+    uint64_t d_rewriteCacheLookups;
+    uint64_t d_rewriteCacheHits;
+  };
+
+  /** The profiles of the passes, by name */
+  std::map<std::string, PassProfile> d_passes;
+  /** The names of the passes, in the order of their first run */
+  std::vector<std::string> d_order;
+}; /* class PreprocessingProfile */
+
+}  // namespace preprocessing
+}  // namespace CVC4
+
+#endif /* CVC4__PREPROCESSING__PREPROCESSING_PROFILE_H */
@@ -148,6 +148,20 @@ Node ITEUtilities::simplifyWithCare(TNode e)
   return d_careSimp->simplifyWithCare(e);
 }
 
+size_t ITEUtilities::cacheSize() const
+{
+  size_t size = d_containsVisitor->cache_size();
+  if (d_simplifier != NULL)
+  {
+    size += d_simplifier->cacheSize();
+  }
+  if (d_compressor != NULL)
+  {
+    size += d_compressor->cacheSize();
+  }
+  return size;
+}
+
 void ITEUtilities::clear()
 {
   if (d_simplifier != NULL)
@@ -179,11 +193,10 @@ bool ContainsTermITEVisitor::containsTermITE(TNode e)
     return false;
   }
 
-  NodeBoolMap::const_iterator end = d_cache.end();
-  NodeBoolMap::const_iterator tmp_it = d_cache.find(e);
-  if (tmp_it != end)
+  uint8_t cached;
+  if (d_cache.find(e, cached))
   {
-    return (*tmp_it).second;
+    return cached != 0;
   }
 
   bool foundTermIte = false;
@@ -197,7 +210,7 @@ bool ContainsTermITEVisitor::containsTermITE(TNode e)
     {
       // all of the children have been visited
       // no term ites were found
-      d_cache[curr] = false;
+      d_cache.insert(curr, 0);
       stack.pop_back();
     }
     else
@@ -212,10 +225,9 @@ bool ContainsTermITEVisitor::containsTermITE(TNode e)
       }
       else
       {
-        tmp_it = d_cache.find(child);
-        if (tmp_it != end)
+        if (d_cache.find(child, cached))
         {
-          foundTermIte = (*tmp_it).second;
+          foundTermIte = cached != 0;
         }
         else
         {
@@ -231,7 +243,7 @@ bool ContainsTermITEVisitor::containsTermITE(TNode e)
     {
       TNode curr = stack.back().curr;
       stack.pop_back();
-      d_cache[curr] = true;
+      d_cache.insert(curr, 1);
     }
   }
   return foundTermIte;
@@ -585,11 +597,10 @@ uint32_t TermITEHeightCounter::termITEHeight(TNode e)
     return 0;
   }
 
-  NodeCountMap::const_iterator end = d_termITEHeight.end();
-  NodeCountMap::const_iterator tmp_it = d_termITEHeight.find(e);
-  if (tmp_it != end)
+  uint32_t cached;
+  if (d_termITEHeight.find(e, cached))
   {
-    return (*tmp_it).second;
+    return cached;
   }
 
   uint32_t returnValue = 0;
@@ -606,7 +617,7 @@ uint32_t TermITEHeightCounter::termITEHeight(TNode e)
     {
       // done with the current node
       returnValue = top.maxChildHeight + (ite::isTermITE(curr) ? 1 : 0);
-      d_termITEHeight[curr] = returnValue;
+      d_termITEHeight.insert(curr, returnValue);
       stack.pop_back();
       continue;
     }
@@ -627,10 +638,9 @@ uint32_t TermITEHeightCounter::termITEHeight(TNode e)
       }
       else
       {
-        tmp_it = d_termITEHeight.find(child);
-        if (tmp_it != end)
+        if (d_termITEHeight.find(child, cached))
         {
-          returnValue = (*tmp_it).second;
+          returnValue = cached;
         }
         else
         {
@@ -673,6 +683,15 @@ bool ITESimplifier::leavesAreConst(TNode e)
   return leavesAreConst(e, theory::Theory::theoryOf(e));
 }
 
+size_t ITESimplifier::cacheSize() const
+{
+  return d_termITEHeight.cache_size() + d_constantLeaves.size()
+         + d_constantIteEqualsConstantCache.size() + d_replaceOverCache.size()
+         + d_replaceOverTermIteCache.size() + d_leavesConstCache.size()
+         + d_simpConstCache.size() + d_simpContextCache.size()
+         + d_simpITECache.size();
+}
+
 void ITESimplifier::clearSimpITECaches()
 {
   Chat() << "clear ite caches " << endl;
@@ -23,6 +23,8 @@
 #ifndef CVC4__ITE_UTILITIES_H
 #define CVC4__ITE_UTILITIES_H
 
+#include <algorithm>
+#include <cstdint>
 #include <unordered_map>
 #include <vector>
 
@@ -43,6 +45,80 @@ class ITECareSimplifier;
 /**
  * A caching visitor that computes whether a node contains a term ite.
  */
+/**
+ * A cache of unsigned values indexed by the ids of the nodes. Since the ids
+ * of nodes are not reused, the cache does not need to keep its nodes alive.
+ * The values are stored in an array indexed by the ids, offset by one so that
+ * zero marks the nodes that are not in the cache, and the nodes whose id is
+ * beyond the size limit of the array are stored in a hash map.
+ */
+template <class T>
+class NodeIdCache
+{
+ public:
+  NodeIdCache() : d_size(0) {}
+
+  /** Sets val to the value of n and returns true if n is in the cache */
+  bool find(TNode n, T& val) const
+  {
+    uint64_t id = n.getId();
+    if (id < d_values.size())
+    {
+      val = d_values[id] - 1;
+      return d_values[id] != 0;
+    }
+    typename std::unordered_map<uint64_t, T>::const_iterator it =
+        d_large.find(id);
+    if (it == d_large.end())
+    {
+      return false;
+    }
+    val = it->second;
+    return true;
+  }
+
+  /** Sets the value of n to val, which is less than the maximal value of T */
+  void insert(TNode n, T val)
+  {
+    uint64_t id = n.getId();
+    if (id >= d_values.size() && id < s_maxDense)
+    {
+      d_values.resize(
+          std::min(s_maxDense, std::max(id + 1, uint64_t(2 * d_values.size()))),
+          0);
+    }
+    if (id < d_values.size())
+    {
+      d_size += d_values[id] == 0 ? 1 : 0;
+      d_values[id] = val + 1;
+      return;
+    }
+    d_size += d_large.find(id) == d_large.end() ? 1 : 0;
+    d_large[id] = val;
+  }
+
+  /** Removes all of the entries and frees the memory of the array */
+  void clear()
+  {
+    std::vector<T>().swap(d_values);
+    d_large.clear();
+    d_size = 0;
+  }
+
+  /** The number of entries */
+  size_t size() const { return d_size; }
+
+ private:
+  /** The maximal size of the array */
+  static const uint64_t s_maxDense = uint64_t(1) << 22;
+  /** The values plus one, indexed by the ids, zero if there is none */
+  std::vector<T> d_values;
+  /** The values of the nodes whose id is beyond the size of the array */
+  std::unordered_map<uint64_t, T> d_large;
+  /** The number of entries */
+  size_t d_size;
+};
+
 class ContainsTermITEVisitor
 {
  public:
@@ -59,8 +135,8 @@ class ContainsTermITEVisitor
   size_t cache_size() const { return d_cache.size(); }
 
  private:
-  typedef std::unordered_map<Node, bool, NodeHashFunction> NodeBoolMap;
-  NodeBoolMap d_cache;
+  /** Whether each visited node contains a term ITE */
+  NodeIdCache<uint8_t> d_cache;
 };
 
 class ITEUtilities
@@ -80,6 +156,9 @@ class ITEUtilities
 
   void clear();
 
+  /** The number of entries of the caches */
+  size_t cacheSize() const;
+
   ContainsTermITEVisitor* getContainsVisitor()
   {
     return d_containsVisitor.get();
@@ -152,8 +231,7 @@ class TermITEHeightCounter
   size_t cache_size() const;
 
  private:
-  typedef std::unordered_map<Node, uint32_t, NodeHashFunction> NodeCountMap;
-  NodeCountMap d_termITEHeight;
+  NodeIdCache<uint32_t> d_termITEHeight;
 }; /* class TermITEHeightCounter */
 
 /**
@@ -172,6 +250,9 @@ class ITECompressor
   /* garbage Collects the compressor. */
   void garbageCollect();
 
+  /** The number of entries of the caches */
+  size_t cacheSize() const { return d_compressed.size(); }
+
  private:
   Node d_true;  /* Copy of true. */
   Node d_false; /* Copy of false. */
@@ -212,6 +293,9 @@ class ITESimplifier
   bool doneALotOfWorkHeuristic() const;
   void clearSimpITECaches();
 
+  /** The number of entries of the caches */
+  size_t cacheSize() const;
+
  private:
   Node d_true;
   Node d_false;
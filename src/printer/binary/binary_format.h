@@ -0,0 +1,102 @@
+/*********************                                                        */
+/*! \file binary_format.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The records of the binary output and input language
+ **
+ ** The records of the binary output and input language, shared by the
+ ** printer and the parser.  A binary stream is a sequence of records, each
+ ** starting with a one-byte tag (stray newlines between records, as written
+ ** by the dump channel, are ignored).  Unsigned numbers are LEB128-encoded
+ ** and strings are a length followed by the bytes.
+ **
+ ** Terms are written once, as a DAG: every record defining a kind, a type or
+ ** a term gets the next id in its own table, and later records refer to it
+ ** by that id.  Kinds are recorded by name so that a stream stays readable
+ ** when the kind enumeration changes.  A header record starts a stream and
+ ** resets all tables.
+ **/
+
+#include "cvc4_public.h"
+
+#ifndef CVC4__PRINTER__BINARY__BINARY_FORMAT_H
+#define CVC4__PRINTER__BINARY__BINARY_FORMAT_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace CVC4 {
+namespace binary {
+
+/** The version of the format, written in the header. */
+const uint64_t s_version = 1;
+
+/** The magic bytes following the header tag. */
+const char s_magic[] = "CVC4";
+
+enum RecordTag : char
+{
+  /** "CVC4", version: start of a stream */
+  TAG_HEADER = '#',
+  /** kind name: the next kind of the kind table */
+  TAG_KIND = 'k',
+  /** kind, payload: the next type of the type table */
+  TAG_TYPE = 't',
+  /** kind, payload: the next term of the term table */
+  TAG_TERM = 'n',
+  /** term: a term, as printed on its own */
+  TAG_EXPR = 'E',
+  /** name: set-logic */
+  TAG_SET_LOGIC = 'L',
+  /** type, arity: declare-sort */
+  TAG_DECLARE_SORT = 'S',
+  /** term: declare-fun */
+  TAG_DECLARE_FUN = 'D',
+  /** term, n, n formals, term: define-fun */
+  TAG_DEFINE_FUN = 'F',
+  /** term: assert */
+  TAG_ASSERT = 'A',
+  /** 0 for none or 1 and a term: check-sat */
+  TAG_CHECK_SAT = 'C',
+  /** n, n terms: check-sat-assuming */
+  TAG_CHECK_SAT_ASSUMING = 'c',
+  /** push */
+  TAG_PUSH = 'P',
+  /** pop */
+  TAG_POP = 'O',
+  /** get-model */
+  TAG_GET_MODEL = 'M',
+  /** exit */
+  TAG_QUIT = 'Q'
+};
+
+/** Write n as an unsigned LEB128 number. */
+inline void writeUnsigned(std::ostream& out, uint64_t n)
+{
+  while (n >= 0x80)
+  {
+    out.put(static_cast<char>((n & 0x7f) | 0x80));
+    n >>= 7;
+  }
+  out.put(static_cast<char>(n));
+}
+
+/** Write s as its length followed by its bytes. */
+inline void writeString(std::ostream& out, const std::string& s)
+{
+  writeUnsigned(out, s.size());
+  out.write(s.data(), s.size());
+}
+
+}  // namespace binary
+}  // namespace CVC4
+
+#endif /* CVC4__PRINTER__BINARY__BINARY_FORMAT_H */
@@ -0,0 +1,610 @@
+/*********************                                                        */
+/*! \file binary_printer.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The printer for the binary output language
+ **/
+#include "printer/binary/binary_printer.h"
+
+#include <limits>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "expr/expr_manager_scope.h"
+#include "expr/node_manager_attributes.h"  // for VarNameAttr
+#include "options/language.h"
+#include "printer/binary/binary_format.h"
+#include "smt/command.h"
+#include "smt/model.h"
+#include "smt/smt_engine.h"
+#include "util/bitvector.h"
+#include "util/rational.h"
+
+using namespace std;
+
+namespace CVC4 {
+namespace printer {
+namespace binary {
+
+using namespace CVC4::binary;
+
+namespace {
+
+/** The tables of the records written to a stream so far. */
+class BinaryTable
+{
+ public:
+  BinaryTable(NodeManager* nm)
+      : d_nm(nm),
+        d_kinds(kind::LAST_KIND, s_none),
+        d_numKinds(0),
+        d_numTypes(0),
+        d_numTerms(0)
+  {
+  }
+
+  /** Write the header starting the tables. */
+  void writeHeader(std::ostream& out)
+  {
+    out.put(TAG_HEADER);
+    out.write(s_magic, sizeof(s_magic) - 1);
+    writeUnsigned(out, s_version);
+  }
+
+  /** Write the record of kind k if needed, and return its id. */
+  uint64_t writeKind(std::ostream& out, Kind k)
+  {
+    if (d_kinds[k] == s_none)
+    {
+      out.put(TAG_KIND);
+      writeString(out, kind::kindToString(k));
+      d_kinds[k] = d_numKinds++;
+    }
+    return d_kinds[k];
+  }
+
+  /** Write the records of tn if needed, and return its id. */
+  uint64_t writeType(std::ostream& out, TypeNode tn);
+
+  /** Write the records of n and its subterms if needed, and return its id. */
+  uint64_t writeTerm(std::ostream& out, TNode n);
+
+  /** The node manager of the terms in the tables. */
+  NodeManager* d_nm;
+
+ private:
+  /** Write the term record of n, whose subterms are already written. */
+  void writeTermRecord(std::ostream& out, TNode n);
+
+  static const uint64_t s_none = std::numeric_limits<uint64_t>::max();
+
+  /** The ids of the kinds, or s_none. */
+  std::vector<uint64_t> d_kinds;
+  /**
+   * The ids of the types and terms, by node id.  Node ids are never reused
+   * by a node manager, so the tables do not need to keep the nodes alive.
+   */
+  std::unordered_map<uint64_t, uint64_t> d_types;
+  std::unordered_map<uint64_t, uint64_t> d_terms;
+  uint64_t d_numKinds;
+  uint64_t d_numTypes;
+  uint64_t d_numTerms;
+}; /* class BinaryTable */
+
+const uint64_t BinaryTable::s_none;
+
+/**
+ * Print n in SMT-LIB for an error message (the output language may be the
+ * binary one).
+ */
+template <class T>
+std::string toSmt2(const T& n)
+{
+  std::stringstream ss;
+  ss << Node::setlanguage(language::output::LANG_SMTLIB_V2_6) << n;
+  return ss.str();
+}
+
+/** Get the name of a variable or sort n. */
+template <class T>
+std::string getName(const T& n)
+{
+  std::string name;
+  if (n.getAttribute(expr::VarNameAttr(), name))
+  {
+    return name;
+  }
+  std::stringstream ss;
+  ss << "var_" << n.getId();
+  return ss.str();
+}
+
+uint64_t BinaryTable::writeType(std::ostream& out, TypeNode tn)
+{
+  std::unordered_map<uint64_t, uint64_t>::const_iterator it =
+      d_types.find(tn.getId());
+  if (it != d_types.end())
+  {
+    return it->second;
+  }
+  Kind k = tn.getKind();
+  std::vector<uint64_t> children;
+  if (k == kind::FUNCTION_TYPE || k == kind::ARRAY_TYPE)
+  {
+    for (const TypeNode& c : tn)
+    {
+      children.push_back(writeType(out, c));
+    }
+  }
+  uint64_t kid = writeKind(out, k);
+  std::string payload;
+  switch (k)
+  {
+    case kind::TYPE_CONSTANT:
+      switch (tn.getConst<TypeConstant>())
+      {
+        case BOOLEAN_TYPE: payload = "Bool"; break;
+        case INTEGER_TYPE: payload = "Int"; break;
+        case REAL_TYPE: payload = "Real"; break;
+        case STRING_TYPE: payload = "String"; break;
+        case REGEXP_TYPE: payload = "RegLan"; break;
+        case ROUNDINGMODE_TYPE: payload = "RoundingMode"; break;
+        default:
+          throw Exception("the binary format cannot represent the type "
+                          + toSmt2(tn));
+      }
+      break;
+    case kind::SORT_TYPE:
+      if (tn.getNumChildren() > 0)
+      {
+        throw Exception(
+            "the binary format cannot represent the parametric sort "
+            + toSmt2(tn));
+      }
+      payload = getName(tn);
+      break;
+    case kind::BITVECTOR_TYPE:
+    case kind::FLOATINGPOINT_TYPE:
+    case kind::FUNCTION_TYPE:
+    case kind::ARRAY_TYPE: break;
+    default:
+      throw Exception("the binary format cannot represent the type "
+                      + toSmt2(tn));
+  }
+  out.put(TAG_TYPE);
+  writeUnsigned(out, kid);
+  if (k == kind::BITVECTOR_TYPE)
+  {
+    writeUnsigned(out, tn.getBitVectorSize());
+  }
+  else if (k == kind::FLOATINGPOINT_TYPE)
+  {
+    writeUnsigned(out, tn.getFloatingPointExponentSize());
+    writeUnsigned(out, tn.getFloatingPointSignificandSize());
+  }
+  else if (k == kind::FUNCTION_TYPE || k == kind::ARRAY_TYPE)
+  {
+    writeUnsigned(out, children.size());
+    for (uint64_t c : children)
+    {
+      writeUnsigned(out, c);
+    }
+  }
+  else
+  {
+    writeString(out, payload);
+  }
+  d_types[tn.getId()] = d_numTypes;
+  return d_numTypes++;
+}
+
+uint64_t BinaryTable::writeTerm(std::ostream& out, TNode n)
+{
+  // write the subterms first, without recursion since terms can be deep
+  std::vector<std::pair<TNode, bool> > visit;
+  visit.push_back(std::make_pair(n, false));
+  while (!visit.empty())
+  {
+    TNode cur = visit.back().first;
+    if (d_terms.find(cur.getId()) != d_terms.end())
+    {
+      visit.pop_back();
+    }
+    else if (!visit.back().second)
+    {
+      visit.back().second = true;
+      for (size_t i = cur.getNumChildren(); i > 0; --i)
+      {
+        visit.push_back(std::make_pair(cur[i - 1], false));
+      }
+      if (cur.getMetaKind() == kind::metakind::PARAMETERIZED)
+      {
+        visit.push_back(std::make_pair(cur.getOperator(), false));
+      }
+    }
+    else
+    {
+      visit.pop_back();
+      writeTermRecord(out, cur);
+    }
+  }
+  return d_terms[n.getId()];
+}
+
+void BinaryTable::writeTermRecord(std::ostream& out, TNode n)
+{
+  Kind k = n.getKind();
+  uint64_t kid = writeKind(out, k);
+  switch (n.getMetaKind())
+  {
+    case kind::metakind::VARIABLE:
+    {
+      if (k != kind::VARIABLE && k != kind::BOUND_VARIABLE
+          && k != kind::SKOLEM)
+      {
+        throw Exception("the binary format cannot represent the variable "
+                        + toSmt2(n));
+      }
+      uint64_t tid = writeType(out, n.getType());
+      out.put(TAG_TERM);
+      writeUnsigned(out, kid);
+      writeUnsigned(out, tid);
+      writeString(out, getName(n));
+      break;
+    }
+    case kind::metakind::CONSTANT:
+    {
+      std::stringstream payload;
+      switch (k)
+      {
+        case kind::CONST_BOOLEAN:
+          writeUnsigned(payload, n.getConst<bool>() ? 1 : 0);
+          break;
+        case kind::CONST_RATIONAL:
+          writeString(payload, n.getConst<Rational>().toString());
+          break;
+        case kind::CONST_BITVECTOR:
+        {
+          const BitVector& bv = n.getConst<BitVector>();
+          writeUnsigned(payload, bv.getSize());
+          writeString(payload, bv.getValue().toString());
+          break;
+        }
+        case kind::BITVECTOR_EXTRACT_OP:
+          writeUnsigned(payload, n.getConst<BitVectorExtract>().d_high);
+          writeUnsigned(payload, n.getConst<BitVectorExtract>().d_low);
+          break;
+        case kind::BITVECTOR_REPEAT_OP:
+          writeUnsigned(payload, n.getConst<BitVectorRepeat>().d_repeatAmount);
+          break;
+        case kind::BITVECTOR_ZERO_EXTEND_OP:
+          writeUnsigned(payload,
+                        n.getConst<BitVectorZeroExtend>().d_zeroExtendAmount);
+          break;
+        case kind::BITVECTOR_SIGN_EXTEND_OP:
+          writeUnsigned(payload,
+                        n.getConst<BitVectorSignExtend>().d_signExtendAmount);
+          break;
+        case kind::BITVECTOR_ROTATE_LEFT_OP:
+          writeUnsigned(payload,
+                        n.getConst<BitVectorRotateLeft>().d_rotateLeftAmount);
+          break;
+        case kind::BITVECTOR_ROTATE_RIGHT_OP:
+          writeUnsigned(
+              payload, n.getConst<BitVectorRotateRight>().d_rotateRightAmount);
+          break;
+        case kind::INT_TO_BITVECTOR_OP:
+          writeUnsigned(payload, n.getConst<IntToBitVector>().d_size);
+          break;
+        case kind::BITVECTOR_BITOF_OP:
+          writeUnsigned(payload, n.getConst<BitVectorBitOf>().d_bitIndex);
+          break;
+        default:
+          throw Exception("the binary format cannot represent the constant "
+                          + toSmt2(n));
+      }
+      out.put(TAG_TERM);
+      writeUnsigned(out, kid);
+      out << payload.str();
+      break;
+    }
+    default:
+    {
+      out.put(TAG_TERM);
+      writeUnsigned(out, kid);
+      bool parameterized = n.getMetaKind() == kind::metakind::PARAMETERIZED;
+      writeUnsigned(out, n.getNumChildren() + (parameterized ? 1 : 0));
+      if (parameterized)
+      {
+        writeUnsigned(out, d_terms[n.getOperator().getId()]);
+      }
+      for (TNode c : n)
+      {
+        writeUnsigned(out, d_terms[c.getId()]);
+      }
+      break;
+    }
+  }
+  d_terms[n.getId()] = d_numTerms++;
+}
+
+/** The ios_base index of the table of a stream. */
+const int s_tableIndex = std::ios_base::xalloc();
+
+/** Free the table of a stream with the stream, and never share it. */
+void tableCallback(std::ios_base::event ev, std::ios_base& ios, int index)
+{
+  if (ev == std::ios_base::erase_event)
+  {
+    delete static_cast<BinaryTable*>(ios.pword(index));
+    ios.pword(index) = nullptr;
+  }
+  else if (ev == std::ios_base::copyfmt_event)
+  {
+    ios.pword(index) = nullptr;
+  }
+}
+
+/**
+ * Get the table of out, starting a new one (and writing its header) the
+ * first time, or when the terms come from a different node manager.
+ */
+BinaryTable& getTable(std::ostream& out)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  void*& p = out.pword(s_tableIndex);
+  BinaryTable* table = static_cast<BinaryTable*>(p);
+  if (table != nullptr && table->d_nm == nullptr)
+  {
+    table->d_nm = nm;
+  }
+  if (table == nullptr || (nm != nullptr && table->d_nm != nm))
+  {
+    if (out.iword(s_tableIndex) == 0)
+    {
+      out.register_callback(tableCallback, s_tableIndex);
+      out.iword(s_tableIndex) = 1;
+    }
+    delete table;
+    table = new BinaryTable(nm);
+    p = table;
+    table->writeHeader(out);
+  }
+  return *table;
+}
+
+/** Write the records of the expressions of c and the command records. */
+void toStreamCommand(std::ostream& out, const Command* c)
+{
+  if (const CommandSequence* seq = dynamic_cast<const CommandSequence*>(c))
+  {
+    for (CommandSequence::const_iterator it = seq->begin(); it != seq->end();
+         ++it)
+    {
+      toStreamCommand(out, *it);
+    }
+  }
+  else if (const SetBenchmarkLogicCommand* logic =
+               dynamic_cast<const SetBenchmarkLogicCommand*>(c))
+  {
+    getTable(out);
+    out.put(TAG_SET_LOGIC);
+    writeString(out, logic->getLogic());
+  }
+  else if (const DeclareTypeCommand* sort =
+               dynamic_cast<const DeclareTypeCommand*>(c))
+  {
+    ExprManagerScope ems(sort->getType());
+    uint64_t tid =
+        getTable(out).writeType(out, TypeNode::fromType(sort->getType()));
+    out.put(TAG_DECLARE_SORT);
+    writeUnsigned(out, tid);
+    writeUnsigned(out, sort->getArity());
+  }
+  else if (const DeclareFunctionCommand* decl =
+               dynamic_cast<const DeclareFunctionCommand*>(c))
+  {
+    ExprManagerScope ems(decl->getFunction());
+    uint64_t id =
+        getTable(out).writeTerm(out, Node::fromExpr(decl->getFunction()));
+    out.put(TAG_DECLARE_FUN);
+    writeUnsigned(out, id);
+  }
+  else if (const DefineFunctionCommand* def =
+               dynamic_cast<const DefineFunctionCommand*>(c))
+  {
+    ExprManagerScope ems(def->getFunction());
+    BinaryTable& table = getTable(out);
+    uint64_t id = table.writeTerm(out, Node::fromExpr(def->getFunction()));
+    std::vector<uint64_t> formals;
+    for (const Expr& e : def->getFormals())
+    {
+      formals.push_back(table.writeTerm(out, Node::fromExpr(e)));
+    }
+    uint64_t body = table.writeTerm(out, Node::fromExpr(def->getFormula()));
+    out.put(TAG_DEFINE_FUN);
+    writeUnsigned(out, id);
+    writeUnsigned(out, formals.size());
+    for (uint64_t f : formals)
+    {
+      writeUnsigned(out, f);
+    }
+    writeUnsigned(out, body);
+  }
+  else if (const AssertCommand* a = dynamic_cast<const AssertCommand*>(c))
+  {
+    ExprManagerScope ems(a->getExpr());
+    uint64_t id = getTable(out).writeTerm(out, Node::fromExpr(a->getExpr()));
+    out.put(TAG_ASSERT);
+    writeUnsigned(out, id);
+  }
+  else if (const CheckSatCommand* cs = dynamic_cast<const CheckSatCommand*>(c))
+  {
+    if (cs->getExpr().isNull())
+    {
+      getTable(out);
+      out.put(TAG_CHECK_SAT);
+      writeUnsigned(out, 0);
+    }
+    else
+    {
+      ExprManagerScope ems(cs->getExpr());
+      uint64_t id =
+          getTable(out).writeTerm(out, Node::fromExpr(cs->getExpr()));
+      out.put(TAG_CHECK_SAT);
+      writeUnsigned(out, 1);
+      writeUnsigned(out, id);
+    }
+  }
+  else if (const CheckSatAssumingCommand* csa =
+               dynamic_cast<const CheckSatAssumingCommand*>(c))
+  {
+    const std::vector<Expr>& terms = csa->getTerms();
+    std::vector<uint64_t> ids;
+    if (!terms.empty())
+    {
+      ExprManagerScope ems(terms[0]);
+      BinaryTable& table = getTable(out);
+      for (const Expr& e : terms)
+      {
+        ids.push_back(table.writeTerm(out, Node::fromExpr(e)));
+      }
+    }
+    else
+    {
+      getTable(out);
+    }
+    out.put(TAG_CHECK_SAT_ASSUMING);
+    writeUnsigned(out, ids.size());
+    for (uint64_t id : ids)
+    {
+      writeUnsigned(out, id);
+    }
+  }
+  else if (dynamic_cast<const PushCommand*>(c) != nullptr)
+  {
+    getTable(out);
+    out.put(TAG_PUSH);
+  }
+  else if (dynamic_cast<const PopCommand*>(c) != nullptr)
+  {
+    getTable(out);
+    out.put(TAG_POP);
+  }
+  else if (dynamic_cast<const GetModelCommand*>(c) != nullptr)
+  {
+    getTable(out);
+    out.put(TAG_GET_MODEL);
+  }
+  else if (dynamic_cast<const QuitCommand*>(c) != nullptr)
+  {
+    getTable(out);
+    out.put(TAG_QUIT);
+  }
+  else
+  {
+    Trace("binary-printer") << "skipping " << c->getCommandName() << std::endl;
+  }
+}
+
+}  // namespace
+
+void BinaryPrinter::toStream(
+    std::ostream& out, TNode n, int toDepth, bool types, size_t dag) const
+{
+  if (n.isNull())
+  {
+    throw Exception("the binary format cannot represent the null term");
+  }
+  uint64_t id = getTable(out).writeTerm(out, n);
+  out.put(TAG_EXPR);
+  writeUnsigned(out, id);
+}
+
+void BinaryPrinter::toStream(std::ostream& out,
+                             const Command* c,
+                             int toDepth,
+                             bool types,
+                             size_t dag) const
+{
+  toStreamCommand(out, c);
+}
+
+void BinaryPrinter::toStream(std::ostream& out, const CommandStatus* s) const
+{
+  getPrinter(language::output::LANG_SMTLIB_V2_6)->toStream(out, s);
+}
+
+void BinaryPrinter::toStream(std::ostream& out, const Model& m) const
+{
+  // the values of the declared functions, printed like in SMT-LIB
+  std::vector<Expr> funs;
+  for (size_t i = 0, ncmds = m.getNumCommands(); i < ncmds; ++i)
+  {
+    const DeclareFunctionCommand* dfc =
+        dynamic_cast<const DeclareFunctionCommand*>(m.getCommand(i));
+    if (dfc == nullptr || !m.isModelCoreSymbol(dfc->getFunction()))
+    {
+      continue;
+    }
+    if (dfc->getPrintInModelSetByUser() ? !dfc->getPrintInModel()
+                                        : dfc->getFunction().getKind()
+                                              == kind::SKOLEM)
+    {
+      continue;
+    }
+    funs.push_back(dfc->getFunction());
+  }
+  if (funs.empty())
+  {
+    getTable(out);
+    return;
+  }
+  ExprManagerScope ems(funs[0]);
+  // all the values are computed with a single check of the model
+  std::vector<Expr> values = m.getSmtEngine()->getValues(funs);
+  BinaryTable& table = getTable(out);
+  for (size_t i = 0, nfuns = funs.size(); i < nfuns; ++i)
+  {
+    Node val = Node::fromExpr(values[i]);
+    uint64_t id = table.writeTerm(out, Node::fromExpr(funs[i]));
+    std::vector<uint64_t> formals;
+    if (val.getKind() == kind::LAMBDA)
+    {
+      for (const Node& v : val[0])
+      {
+        formals.push_back(table.writeTerm(out, v));
+      }
+      val = val[1];
+    }
+    uint64_t body = table.writeTerm(out, val);
+    out.put(TAG_DEFINE_FUN);
+    writeUnsigned(out, id);
+    writeUnsigned(out, formals.size());
+    for (uint64_t f : formals)
+    {
+      writeUnsigned(out, f);
+    }
+    writeUnsigned(out, body);
+  }
+}
+
+void BinaryPrinter::toStream(std::ostream& out,
+                             const Model& m,
+                             const Command* c) const
+{
+  toStreamUsing(language::output::LANG_SMTLIB_V2_6, out, m, c);
+}
+
+}  // namespace binary
+}  // namespace printer
+}  // namespace CVC4
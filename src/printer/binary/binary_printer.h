@@ -0,0 +1,75 @@
+/*********************                                                        */
+/*! \file binary_printer.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The printer for the binary output language
+ **
+ ** The printer for the binary output language (see binary_format.h).  The
+ ** kind, type and term tables live with the output stream, so that all the
+ ** commands dumped to the same stream share their subterms.  Only the
+ ** commands needed to reload a problem are written; the others (set-info,
+ ** set-option, comments, ...) are skipped.  Command statuses are printed in
+ ** SMT-LIB.  Models are written as the define-fun records of the values of
+ ** the declared functions, which are computed in one pass over the model.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PRINTER__BINARY__BINARY_PRINTER_H
+#define CVC4__PRINTER__BINARY__BINARY_PRINTER_H
+
+#include <iostream>
+
+#include "printer/printer.h"
+
+namespace CVC4 {
+namespace printer {
+namespace binary {
+
+class BinaryPrinter : public CVC4::Printer
+{
+ public:
+  using CVC4::Printer::toStream;
+  /**
+   * Write the records defining n, followed by an expression record.
+   *
+   * @throws Exception if n has a kind, constant or type that the format
+   * cannot represent
+   */
+  void toStream(std::ostream& out,
+                TNode n,
+                int toDepth,
+                bool types,
+                size_t dag) const override;
+  /**
+   * Write the records of command c.
+   *
+   * @throws Exception if c refers to a term that the format cannot
+   * represent
+   */
+  void toStream(std::ostream& out,
+                const Command* c,
+                int toDepth,
+                bool types,
+                size_t dag) const override;
+  void toStream(std::ostream& out, const CommandStatus* s) const override;
+  void toStream(std::ostream& out, const Model& m) const override;
+
+ private:
+  void toStream(std::ostream& out,
+                const Model& m,
+                const Command* c) const override;
+}; /* class BinaryPrinter */
+
+}  // namespace binary
+}  // namespace printer
+}  // namespace CVC4
+
+#endif /* CVC4__PRINTER__BINARY__BINARY_PRINTER_H */
@@ -16,11 +16,10 @@
 
 #include "printer/dagification_visitor.h"
 
-#include "context/context.h"
 #include "expr/node_algorithm.h"
 #include "expr/node_manager_attributes.h"
-#include "theory/substitutions.h"
 
+#include <algorithm>
 #include <sstream>
 
 namespace CVC4 {
@@ -30,25 +29,20 @@ DagificationVisitor::DagificationVisitor(unsigned threshold,
                                          std::string letVarPrefix)
     : d_threshold(threshold),
       d_letVarPrefix(letVarPrefix),
-      d_nodeCount(),
+      d_occurrences(),
       d_reservedLetNames(),
       d_top(),
-      d_context(new context::Context()),
-      d_substitutions(new theory::SubstitutionMap(d_context)),
+      d_lets(),
+      d_letVars(),
+      d_substituted(),
       d_letVar(0),
       d_done(false),
-      d_uniqueParent(),
       d_substNodes()
 {
   // 0 doesn't make sense
   AlwaysAssertArgument(threshold > 0, threshold);
 }
 
-DagificationVisitor::~DagificationVisitor() {
-  delete d_substitutions;
-  delete d_context;
-}
-
 bool DagificationVisitor::alreadyVisited(TNode current, TNode parent) {
   Kind ck = current.getKind();
   if (current.isClosure())
@@ -82,12 +76,18 @@ bool DagificationVisitor::alreadyVisited(TNode current, TNode parent) {
   // the count beyond the threshold already, we've done the same
   // for all subexpressions, so it isn't useful to traverse and
   // increment again (they'll be dagified anyway).
-  return current.isVar() || current.getMetaKind() == kind::metakind::CONSTANT
-         || current.getNumChildren() == 0
-         || ((ck == kind::NOT || ck == kind::UMINUS)
-             && (current[0].isVar()
-                 || current[0].getMetaKind() == kind::metakind::CONSTANT))
-         || ck == kind::SORT_TYPE || d_nodeCount[current] > d_threshold;
+  if (current.isVar() || current.getMetaKind() == kind::metakind::CONSTANT
+      || current.getNumChildren() == 0
+      || ((ck == kind::NOT || ck == kind::UMINUS)
+          && (current[0].isVar()
+              || current[0].getMetaKind() == kind::metakind::CONSTANT))
+      || ck == kind::SORT_TYPE)
+  {
+    return true;
+  }
+  std::unordered_map<TNode, Occurrences, TNodeHashFunction>::const_iterator
+      it = d_occurrences.find(current);
+  return it != d_occurrences.end() && it->second.d_count > d_threshold;
 }
 
 void DagificationVisitor::visit(TNode current, TNode parent) {
@@ -101,33 +101,31 @@ void DagificationVisitor::visit(TNode current, TNode parent) {
   Node::dag::Scope scopeTrace(Trace.getStream(), false);
 #endif /* CVC4_TRACING */
 
-  if(d_uniqueParent.find(current) != d_uniqueParent.end()) {
+  Occurrences& occ = d_occurrences[current];
+  if (occ.d_count > 0)
+  {
     // we've seen this expr before
 
-    TNode& uniqueParent = d_uniqueParent[current];
-
     // We restrict this optimization to nodes with arity 1 since otherwise we
     // may run into issues with tree traverals. Without this restriction
     // dumping regress3/pp-regfile increases the file size by a factor of 5000.
-    if (!uniqueParent.isNull()
-        && (uniqueParent != parent || parent.getNumChildren() > 1))
+    if (!occ.d_uniqueParent.isNull()
+        && (occ.d_uniqueParent != parent || parent.getNumChildren() > 1))
     {
       // there is not a unique parent for this expr, mark it
-      uniqueParent = TNode::null();
+      occ.d_uniqueParent = TNode::null();
     }
 
     // increase the count
-    const unsigned count = ++d_nodeCount[current];
-
-    if(count > d_threshold) {
+    if (++occ.d_count > d_threshold)
+    {
       // candidate for a let binder
       d_substNodes.push_back(current);
     }
   } else {
     // we haven't seen this expr before
-    Assert(d_nodeCount[current] == 0);
-    d_nodeCount[current] = 1;
-    d_uniqueParent[current] = parent;
+    occ.d_count = 1;
+    occ.d_uniqueParent = parent;
   }
 }
 
@@ -150,15 +148,16 @@ void DagificationVisitor::done(TNode node) {
   Node::dag::Scope scopeTrace(Trace.getStream(), false);
 #endif /* CVC4_TRACING */
 
-  // letify subexprs before parents (cascading LETs)
+  // letify subexprs before parents (cascading LETs), the id of a node being
+  // greater than the ids of its children
   std::sort(d_substNodes.begin(), d_substNodes.end());
 
-  for(std::vector<TNode>::iterator i = d_substNodes.begin();
-      i != d_substNodes.end();
-      ++i) {
-    Assert(d_nodeCount[*i] > d_threshold);
-    TNode parent = d_uniqueParent[*i];
-    if(!parent.isNull() && d_nodeCount[parent] > d_threshold) {
+  for (TNode current : d_substNodes)
+  {
+    Assert(d_occurrences[current].d_count > d_threshold);
+    TNode parent = d_occurrences[current].d_uniqueParent;
+    if (!parent.isNull() && d_occurrences[parent].d_count > d_threshold)
+    {
       // no need to letify this expr, because it only occurs in
       // a single super-expression, and that one will be letified
       continue;
@@ -171,20 +170,78 @@ void DagificationVisitor::done(TNode node) {
       ss.str("");
       ss << d_letVarPrefix << d_letVar++;
     } while (d_reservedLetNames.find(ss.str()) != d_reservedLetNames.end());
-    Node letvar = NodeManager::currentNM()->mkSkolem(ss.str(), (*i).getType(), "dagification", NodeManager::SKOLEM_NO_NOTIFY | NodeManager::SKOLEM_EXACT_NAME);
+    Node letvar = NodeManager::currentNM()->mkSkolem(ss.str(), current.getType(), "dagification", NodeManager::SKOLEM_NO_NOTIFY | NodeManager::SKOLEM_EXACT_NAME);
 
     // apply previous substitutions to the rhs, enabling cascading LETs
-    Node n = d_substitutions->apply(*i);
-    Assert(!d_substitutions->hasSubstitution(n));
-    d_substitutions->addSubstitution(n, letvar);
+    Node n = substitute(current);
+    Assert(d_letVars.find(current) == d_letVars.end());
+    d_letVars[current] = letvar;
+    d_lets.push_back(std::make_pair(n, letvar));
+  }
+}
+
+Node DagificationVisitor::getSubstituted(TNode n) const
+{
+  std::unordered_map<TNode, Node, TNodeHashFunction>::const_iterator it =
+      d_letVars.find(n);
+  if (it != d_letVars.end())
+  {
+    return it->second;
   }
+  it = d_substituted.find(n);
+  Assert(it != d_substituted.end() && !it->second.isNull());
+  return it->second;
+}
+
+Node DagificationVisitor::substitute(TNode n)
+{
+  std::unordered_map<TNode, Node, TNodeHashFunction>::iterator it;
+  std::vector<TNode> visit;
+  visit.push_back(n);
+  do
+  {
+    TNode cur = visit.back();
+    it = d_substituted.find(cur);
+    if (it == d_substituted.end())
+    {
+      // the children are substituted before cur
+      d_substituted[cur] = Node::null();
+      if (cur.getMetaKind() == kind::metakind::PARAMETERIZED)
+      {
+        visit.push_back(cur.getOperator());
+      }
+      visit.insert(visit.end(), cur.begin(), cur.end());
+      continue;
+    }
+    visit.pop_back();
+    if (!it->second.isNull())
+    {
+      continue;
+    }
+    bool childChanged = false;
+    NodeBuilder<> nb(cur.getKind());
+    if (cur.getMetaKind() == kind::metakind::PARAMETERIZED)
+    {
+      Node op = getSubstituted(cur.getOperator());
+      childChanged = childChanged || op != cur.getOperator();
+      nb << op;
+    }
+    for (const Node& cn : cur)
+    {
+      Node scn = getSubstituted(cn);
+      childChanged = childChanged || scn != cn;
+      nb << scn;
+    }
+    d_substituted[cur] = childChanged ? Node(nb) : Node(cur);
+  } while (!visit.empty());
+  return d_substituted[n];
 }
 
-const theory::SubstitutionMap& DagificationVisitor::getLets() {
+const DagificationVisitor::LetList& DagificationVisitor::getLets() {
   AlwaysAssert(d_done)
       << "DagificationVisitor must be used as a visitor before "
          "getting the dagified version out!";
-  return *d_substitutions;
+  return d_lets;
 }
 
 Node DagificationVisitor::getDagifiedBody() {
@@ -201,7 +258,8 @@ Node DagificationVisitor::getDagifiedBody() {
   Node::dag::Scope scopeTrace(Trace.getStream(), false);
 #endif /* CVC4_TRACING */
 
-  return d_substitutions->apply(d_top);
+  substitute(d_top);
+  return getSubstituted(d_top);
 }
 
 }/* CVC4::printer namespace */
@@ -22,21 +22,13 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "expr/node.h"
 #include "util/hash.h"
 
 namespace CVC4 {
-
-namespace context {
-  class Context;
-}/* CVC4::context namespace */
-
-namespace theory {
-  class SubstitutionMap;
-}/* CVC4::theory namespace */
-
 namespace printer {
 
 /**
@@ -50,8 +42,40 @@ namespace printer {
  * unary-minus exprs over variables or constants, or NOT exprs over
  * variables or constants.  This dagifier never introduces let bindings
  * for types.
+ *
+ * The let bindings are computed in time linear in the size of the DAG of
+ * the expression: the bound subexprs are substituted in the order of their
+ * ids, which is a topological order of the DAG, with a single cache.
  */
 class DagificationVisitor {
+ public:
+  /**
+   * The let bindings, in the order they are introduced, as pairs of a
+   * subexpr (in which the previous bindings are substituted) and its let
+   * variable.
+   */
+  typedef std::vector<std::pair<Node, Node> > LetList;
+
+ private:
+  /** The occurrences of a subexpr */
+  struct Occurrences
+  {
+    Occurrences() : d_count(0), d_uniqueParent() {}
+    /** The occurrence count */
+    unsigned d_count;
+    /**
+     * If the subexpr occurs uniquely in one parent expr, this points to it,
+     * otherwise this is null.
+     *
+     * This information is kept because if a subexpr occurs more than the
+     * threshold, it is normally subject to dagification.  But if it occurs
+     * only in one unique parent expression, and the parent meets the
+     * threshold too, then the parent will be dagified and there's no point
+     * in independently dagifying the child.  (If it is beyond the threshold
+     * and occurs in more than one parent, we'll independently dagify.)
+     */
+    TNode d_uniqueParent;
+  };
 
   /**
    * The threshold for dagification.  Subexprs occurring more than this
@@ -65,9 +89,10 @@ class DagificationVisitor {
   const std::string d_letVarPrefix;
 
   /**
-   * A map of subexprs to their occurrence count.
+   * A map of the visited subexprs to their occurrences.  A subexpr that is
+   * not a key of this map has not been visited yet.
    */
-  std::unordered_map<TNode, unsigned, TNodeHashFunction> d_nodeCount;
+  std::unordered_map<TNode, Occurrences, TNodeHashFunction> d_occurrences;
 
   /**
    * The set of variable names with the let prefix that appear in the
@@ -80,16 +105,18 @@ class DagificationVisitor {
    */
   TNode d_top;
 
-  /**
-   * This class doesn't operate in a context-dependent fashion, but
-   * SubstitutionMap does, so we need a context.
-   */
-  context::Context* d_context;
+  /** The let bindings */
+  LetList d_lets;
+
+  /** A map of the bound subexprs to their let variables */
+  std::unordered_map<TNode, Node, TNodeHashFunction> d_letVars;
 
   /**
-   * A map of subexprs to their newly-introduced let bindings.
+   * A map of subexprs to the result of substituting the let bindings in
+   * them.  Since the bindings are introduced children first, the results
+   * stay valid when bindings are added.
    */
-  theory::SubstitutionMap* d_substitutions;
+  std::unordered_map<TNode, Node, TNodeHashFunction> d_substituted;
 
   /**
    * The current count of let bindings.  Used to build unique names
@@ -103,22 +130,6 @@ class DagificationVisitor {
    */
   bool d_done;
 
-  /**
-   * If a subexpr occurs uniquely in one parent expr, this map points to
-   * it.  An expr not occurring as a key in this map means we haven't
-   * seen it yet (and its occurrence count should be zero).  If an expr
-   * points to the null expr in this map, it means we've seen more than
-   * one parent, so the subexpr doesn't have a unique parent.
-   *
-   * This information is kept because if a subexpr occurs more than the
-   * threshold, it is normally subject to dagification.  But if it occurs
-   * only in one unique parent expression, and the parent meets the
-   * threshold too, then the parent will be dagified and there's no point
-   * in independently dagifying the child.  (If it is beyond the threshold
-   * and occurs in more than one parent, we'll independently dagify.)
-   */
-  std::unordered_map<TNode, TNode, TNodeHashFunction> d_uniqueParent;
-
   /**
    * A list of all nodes that meet the occurrence threshold and therefore
    * *may* be subject to dagification, except for the unique-parent rule
@@ -126,6 +137,12 @@ class DagificationVisitor {
    */
   std::vector<TNode> d_substNodes;
 
+  /** Returns the let variable of n if n is bound, or n substituted. */
+  Node getSubstituted(TNode n) const;
+
+  /** Substitutes the let bindings in n, iteratively. */
+  Node substitute(TNode n);
+
 public:
 
   /** Our visitor doesn't return anything. */
@@ -140,11 +157,6 @@ public:
    */
   DagificationVisitor(unsigned threshold, std::string letVarPrefix = "_let_");
 
-  /**
-   * Simple destructor, clean up memory.
-   */
-  ~DagificationVisitor();
-
   /**
    * Returns true if "current" has already been visited a sufficient
    * number of times to make it a candidate for dagification, or if
@@ -168,9 +180,9 @@ public:
   void done(TNode node);
 
   /**
-   * Get the let substitutions.
+   * Get the let bindings.
    */
-  const theory::SubstitutionMap& getLets();
+  const LetList& getLets();
 
   /**
    * Return the let-substituted expression.
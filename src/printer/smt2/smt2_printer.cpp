@@ -33,7 +33,6 @@
 #include "smt_util/boolean_simplification.h"
 #include "theory/arrays/theory_arrays_rewriter.h"
 #include "theory/quantifiers/quantifiers_attributes.h"
-#include "theory/substitutions.h"
 #include "theory/theory_model.h"
 #include "util/smt2_quote_string.h"
 
@@ -65,10 +64,10 @@ void Smt2Printer::toStream(
     DagificationVisitor dv(dag);
     NodeVisitor<DagificationVisitor> visitor;
     visitor.run(dv, n);
-    const theory::SubstitutionMap& lets = dv.getLets();
+    const DagificationVisitor::LetList& lets = dv.getLets();
     if(!lets.empty()) {
-      theory::SubstitutionMap::const_iterator i = lets.begin();
-      theory::SubstitutionMap::const_iterator i_end = lets.end();
+      DagificationVisitor::LetList::const_iterator i = lets.begin();
+      DagificationVisitor::LetList::const_iterator i_end = lets.end();
       for(; i != i_end; ++ i) {
         out << "(let ((";
         toStream(out, (*i).second, toDepth, types, TypeNode::null());
@@ -80,8 +79,8 @@ void Smt2Printer::toStream(
     Node body = dv.getDagifiedBody();
     toStream(out, body, toDepth, types, TypeNode::null());
     if(!lets.empty()) {
-      theory::SubstitutionMap::const_iterator i = lets.begin();
-      theory::SubstitutionMap::const_iterator i_end = lets.end();
+      DagificationVisitor::LetList::const_iterator i = lets.begin();
+      DagificationVisitor::LetList::const_iterator i_end = lets.end();
       for(; i != i_end; ++ i) {
         out << ")";
       }
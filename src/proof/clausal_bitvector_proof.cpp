@@ -17,6 +17,7 @@
 #include "cvc4_private.h"
 
 #include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <iterator>
 #include <map>
@@ -46,13 +47,20 @@ ClausalBitVectorProof::ClausalBitVectorProof(theory::bv::TheoryBV* bv,
     : BitVectorProof(bv, proofEngine),
       d_clauses(),
       d_originalClauseIndices(),
-      d_binaryDratProof(),
+      d_binaryDratProofFilename("cvc4-drat-XXXXXX"),
+      d_binaryDratProof(openTmpFile(&d_binaryDratProofFilename)),
       d_coreClauseIndices(),
       d_dratTranslationStatistics(),
       d_dratOptimizationStatistics()
 {
 }
 
+ClausalBitVectorProof::~ClausalBitVectorProof()
+{
+  d_binaryDratProof->close();
+  remove(d_binaryDratProofFilename.c_str());
+}
+
 void ClausalBitVectorProof::attachToSatSolver(prop::SatSolver& sat_solver)
 {
   sat_solver.setClausalProofLog(this);
@@ -92,16 +100,17 @@ void ClausalBitVectorProof::registerUsedClause(ClauseId id,
 
 void ClausalBitVectorProof::calculateAtomsInBitblastingProof()
 {
+  // The SAT solver is done, the proof is written out for the tools to read
+  d_binaryDratProof->flush();
   optimizeDratProof();
 
   // Debug dump of DRAT Proof
   if (Debug.isOn("bv::clausal"))
   {
-    std::string serializedDratProof = d_binaryDratProof.str();
     Debug("bv::clausal") << "option: " << options::bvOptimizeSatProof()
                          << std::endl;
     Debug("bv::clausal") << "binary DRAT proof byte count: "
-                         << serializedDratProof.size() << std::endl;
+                         << fileSize(d_binaryDratProofFilename) << std::endl;
     Debug("bv::clausal") << "clause count: " << d_coreClauseIndices.size()
                          << std::endl;
   }
@@ -117,6 +126,12 @@ void ClausalBitVectorProof::calculateAtomsInBitblastingProof()
   }
 }
 
+int64_t ClausalBitVectorProof::fileSize(const std::string& filename)
+{
+  std::ifstream in(filename, std::ios::binary | std::ios::ate);
+  return static_cast<int64_t>(in.tellg());
+}
+
 struct SatClausePointerComparator
 {
   inline bool operator()(const prop::SatClause* const& l,
@@ -136,7 +151,6 @@ void ClausalBitVectorProof::optimizeDratProof()
   {
     Debug("bv::clausal") << "Optimizing DRAT" << std::endl;
     std::string formulaFilename("cvc4-dimacs-XXXXXX");
-    std::string dratFilename("cvc4-drat-XXXXXX");
     std::string optDratFilename("cvc4-optimized-drat-XXXXXX");
     std::string optFormulaFilename("cvc4-optimized-formula-XXXXXX");
 
@@ -149,14 +163,8 @@ void ClausalBitVectorProof::optimizeDratProof()
       formStream->close();
     }
 
-    {
-      std::unique_ptr<std::fstream> dratStream = openTmpFile(&dratFilename);
-      const int64_t startPos = static_cast<int64_t>(dratStream->tellp());
-      (*dratStream) << d_binaryDratProof.str();
-      d_dratOptimizationStatistics.d_initialDratSize.setData(
-          static_cast<int64_t>(dratStream->tellp()) - startPos);
-      dratStream->close();
-    }
+    d_dratOptimizationStatistics.d_initialDratSize.setData(
+        fileSize(d_binaryDratProofFilename));
 
     std::unique_ptr<std::fstream> optDratStream = openTmpFile(&optDratFilename);
     std::unique_ptr<std::fstream> optFormulaStream =
@@ -168,7 +176,7 @@ void ClausalBitVectorProof::optimizeDratProof()
           d_dratOptimizationStatistics.d_toolTime};
       int dratTrimExitCode =
           drat2er::drat_trim::OptimizeWithDratTrim(formulaFilename,
-                                                   dratFilename,
+                                                   d_binaryDratProofFilename,
                                                    optFormulaFilename,
                                                    optDratFilename,
                                                    drat2er::options::QUIET);
@@ -181,18 +189,13 @@ void ClausalBitVectorProof::optimizeDratProof()
         << "Run contrib/get-drat2er, reconfigure with --drat2er, and rebuild";
 #endif
 
-    {
-      d_binaryDratProof.str("");
-      Assert(d_binaryDratProof.str().size() == 0);
-
-      const int64_t startPos = static_cast<int64_t>(d_binaryDratProof.tellp());
-      std::ifstream lratStream(optDratFilename);
-      std::copy(std::istreambuf_iterator<char>(lratStream),
-                std::istreambuf_iterator<char>(),
-                std::ostreambuf_iterator<char>(d_binaryDratProof));
-      d_dratOptimizationStatistics.d_optimizedDratSize.setData(
-          static_cast<int64_t>(d_binaryDratProof.tellp()) - startPos);
-    }
+    // The optimized proof replaces the original one, without being copied
+    d_binaryDratProof->close();
+    remove(d_binaryDratProofFilename.c_str());
+    d_binaryDratProof = std::move(optDratStream);
+    d_binaryDratProofFilename = optDratFilename;
+    d_dratOptimizationStatistics.d_optimizedDratSize.setData(
+        fileSize(d_binaryDratProofFilename));
 
     if (options::bvOptimizeSatProof() == options::BvOptimizeSatProof::FORMULA)
     {
@@ -241,8 +244,6 @@ void ClausalBitVectorProof::optimizeDratProof()
 
     Assert(d_coreClauseIndices.size() > 0);
     remove(formulaFilename.c_str());
-    remove(dratFilename.c_str());
-    remove(optDratFilename.c_str());
     remove(optFormulaFilename.c_str());
     Debug("bv::clausal") << "Optimized DRAT" << std::endl;
   }
@@ -349,7 +350,8 @@ void LfscDratBitVectorProof::printEmptyClauseProof(std::ostream& os,
   os << "(@ dratProof ";
   paren << ")";
   d_dratTranslationStatistics.d_totalTime.start();
-  drat::DratProof pf = drat::DratProof::fromBinary(d_binaryDratProof.str());
+  std::ifstream dratStream(d_binaryDratProofFilename, std::ios::binary);
+  drat::DratProof pf = drat::DratProof::fromBinary(dratStream);
   d_dratTranslationStatistics.d_totalTime.stop();
   pf.outputAsLfsc(os, 2);
   os << "\n";
@@ -378,7 +380,7 @@ void LfscLratBitVectorProof::printEmptyClauseProof(std::ostream& os,
   lrat::LratProof pf =
       lrat::LratProof::fromDratProof(d_clauses,
                                      d_coreClauseIndices,
-                                     d_binaryDratProof.str(),
+                                     d_binaryDratProofFilename,
                                      d_dratTranslationStatistics.d_toolTime);
   d_dratTranslationStatistics.d_totalTime.stop();
   pf.outputAsLfsc(os);
@@ -400,7 +402,7 @@ void LfscErBitVectorProof::printEmptyClauseProof(std::ostream& os,
   er::ErProof pf =
       er::ErProof::fromBinaryDratProof(d_clauses,
                                        d_coreClauseIndices,
-                                       d_binaryDratProof.str(),
+                                       d_binaryDratProofFilename,
                                        d_dratTranslationStatistics.d_toolTime);
   d_dratTranslationStatistics.d_totalTime.stop();
 
@@ -11,9 +11,10 @@
  **
  ** \brief Bitvector proof for clausal (DRAT/LRAT) formats
  **
- ** An internal string stream is hooked up to CryptoMiniSat, which spits out a
- ** binary DRAT proof. Depending on which kind of proof we're going to turn
- ** that into, we process it in different ways.
+ ** A temporary file is hooked up to CryptoMiniSat, which spits out a binary
+ ** DRAT proof. Depending on which kind of proof we're going to turn that
+ ** into, we process it in different ways. The binary proof is only ever read
+ ** back from the file, so it is never held in memory as a whole.
  **/
 
 #include "cvc4_private.h"
@@ -21,7 +22,9 @@
 #ifndef CVC4__PROOF__CLAUSAL_BITVECTOR_PROOF_H
 #define CVC4__PROOF__CLAUSAL_BITVECTOR_PROOF_H
 
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <unordered_map>
 
@@ -45,7 +48,7 @@ class ClausalBitVectorProof : public BitVectorProof
   ClausalBitVectorProof(theory::bv::TheoryBV* bv,
                         TheoryProofEngine* proofEngine);
 
-  ~ClausalBitVectorProof() = default;
+  ~ClausalBitVectorProof();
 
   void attachToSatSolver(prop::SatSolver& sat_solver) override;
 
@@ -54,7 +57,7 @@ class ClausalBitVectorProof : public BitVectorProof
                     prop::SatVariable trueVar,
                     prop::SatVariable falseVar) override;
 
-  std::ostream& getDratOstream() { return d_binaryDratProof; }
+  std::ostream& getDratOstream() { return *d_binaryDratProof; }
 
   void registerUsedClause(ClauseId id, prop::SatClause& clause);
 
@@ -64,8 +67,10 @@ class ClausalBitVectorProof : public BitVectorProof
   // A list of all clauses and their ids which are passed into the SAT solver
   std::unordered_map<ClauseId, prop::SatClause> d_clauses{};
   std::vector<ClauseId> d_originalClauseIndices{};
-  // Stores the proof recieved from the SAT solver.
-  std::ostringstream d_binaryDratProof{};
+  // The temporary file which stores the proof recieved from the SAT solver,
+  // and then its optimized version
+  std::string d_binaryDratProofFilename;
+  std::unique_ptr<std::fstream> d_binaryDratProof;
   std::vector<ClauseId> d_coreClauseIndices{};
 
   struct DratTranslationStatistics
@@ -87,6 +92,9 @@ class ClausalBitVectorProof : public BitVectorProof
   // of clause actually needed to check that proof (a smaller UNSAT core)
   void optimizeDratProof();
 
+  // Returns the number of bytes in the file `filename`
+  static int64_t fileSize(const std::string& filename);
+
   // Given reference to a SAT clause encoded as a vector of literals, puts the
   // literals into a canonical order
   static void canonicalizeClause(prop::SatClause& clause);
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <bitset>
 #include <iostream>
+#include <iterator>
 
 #include "proof/proof_manager.h"
 
@@ -35,8 +36,8 @@ namespace drat {
  *
  * If the literal overruns `end`, then raises a `InvalidDratProofException`.
  */
-SatLiteral parse_binary_literal(std::string::const_iterator& start,
-                                const std::string::const_iterator& proof_end)
+template <class Iterator>
+SatLiteral parse_binary_literal(Iterator& start, const Iterator& proof_end)
 {
   // lit is encoded as uint represented by a variable-length byte sequence
   uint64_t literal_represented_as_uint = 0;
@@ -79,8 +80,8 @@ SatLiteral parse_binary_literal(std::string::const_iterator& start,
  *
  * If the clause overruns `end`, then raises a `InvalidDratProofException`.
  */
-SatClause parse_binary_clause(std::string::const_iterator& start,
-                              const std::string::const_iterator& proof_end)
+template <class Iterator>
+SatClause parse_binary_clause(Iterator& start, const Iterator& proof_end)
 {
   SatClause clause;
   // A clause is a 0-terminated sequence of literals
@@ -104,6 +105,47 @@ SatClause parse_binary_clause(std::string::const_iterator& start,
       "EOF was encountered");
 }
 
+/**
+ * Parses the binary DRAT instructions from `i` to `end`, and appends them to
+ * `instructions`.
+ *
+ * If an instruction is invalid, then raises a `InvalidDratProofException`.
+ */
+template <class Iterator>
+void parse_binary_instructions(Iterator i,
+                               const Iterator& end,
+                               std::vector<DratInstruction>& instructions)
+{
+  // For each instruction
+  while (i != end)
+  {
+    switch (*i)
+    {
+      case 'a':
+      {
+        ++i;
+        instructions.emplace_back(ADDITION, parse_binary_clause(i, end));
+        break;
+      }
+      case 'd':
+      {
+        ++i;
+        instructions.emplace_back(DELETION, parse_binary_clause(i, end));
+        break;
+      }
+      default:
+      {
+        std::ostringstream errmsg;
+        errmsg << "Invalid instruction in Drat proof. Instruction bits: "
+               << std::bitset<8>(*i)
+               << ". Expected 'a' (01100001) or 'd' "
+                  "(01100100).";
+        throw InvalidDratProofException(errmsg.str());
+      }
+    }
+  }
+}
+
 /**
  * Writes this SAT literal in the textual DIMACS format. i.e. as a non-zero
  * integer.
@@ -194,37 +236,26 @@ DratProof DratProof::fromBinary(const std::string& s)
     Debug("pf::drat") << std::endl << "parsing proof..." << std::endl;
   }
 
-  // For each instruction
-  for (auto i = s.cbegin(), end = s.cend(); i != end;)
+  parse_binary_instructions(s.cbegin(), s.cend(), proof.d_instructions);
+
+  if (Debug.isOn("pf::drat"))
   {
-    switch (*i)
-    {
-      case 'a':
-      {
-        ++i;
-        proof.d_instructions.emplace_back(ADDITION,
-                                          parse_binary_clause(i, end));
-        break;
-      }
-      case 'd':
-      {
-        ++i;
-        proof.d_instructions.emplace_back(DELETION,
-                                          parse_binary_clause(i, end));
-        break;
-      }
-      default:
-      {
-        std::ostringstream errmsg;
-        errmsg << "Invalid instruction in Drat proof. Instruction bits: "
-               << std::bitset<8>(*i)
-               << ". Expected 'a' (01100001) or 'd' "
-                  "(01100100).";
-        throw InvalidDratProofException(errmsg.str());
-      }
-    }
+    Debug("pf::drat") << "Printing out DRAT in textual format:" << std::endl;
+    proof.outputAsText(Debug("pf::drat"));
   }
 
+  return proof;
+};
+
+DratProof DratProof::fromBinary(std::istream& in)
+{
+  DratProof proof;
+  Debug("pf::drat") << "Parsing binary DRAT proof from a stream" << std::endl;
+
+  parse_binary_instructions(std::istreambuf_iterator<char>(in),
+                            std::istreambuf_iterator<char>(),
+                            proof.d_instructions);
+
   if (Debug.isOn("pf::drat"))
   {
     Debug("pf::drat") << "Printing out DRAT in textual format:" << std::endl;
@@ -232,7 +263,7 @@ DratProof DratProof::fromBinary(const std::string& s)
   }
 
   return proof;
-};
+}
 
 const std::vector<DratInstruction>& DratProof::getInstructions() const
 {
@@ -23,6 +23,9 @@
 #define CVC4__PROOF__DRAT__DRAT_PROOF_H
 
 #include "cvc4_private.h"
+
+#include <iosfwd>
+
 #include "prop/sat_solver.h"
 #include "prop/sat_solver_types.h"
 
@@ -95,6 +98,18 @@ class DratProof
    */
   static DratProof fromBinary(const std::string& binaryProof);
 
+  /**
+   * Parses a DRAT proof from the **binary format**, reading the bytes from a
+   * stream as they are parsed, so that the binary proof is never held in
+   * memory as a whole.
+   *
+   * @param binaryProof a stream of the bytes of the binary proof, e.g. a file
+   *        opened in binary mode
+   *
+   * @return the parsed proof
+   */
+  static DratProof fromBinary(std::istream& binaryProof);
+
   /**
    * @return The instructions in this proof
    */
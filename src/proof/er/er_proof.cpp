@@ -84,11 +84,10 @@ TraceCheckProof TraceCheckProof::fromText(std::istream& in)
 ErProof ErProof::fromBinaryDratProof(
     const std::unordered_map<ClauseId, prop::SatClause>& clauses,
     const std::vector<ClauseId>& usedIds,
-    const std::string& dratBinary,
+    const std::string& dratFilename,
     TimerStat& toolTimer)
 {
   std::string formulaFilename("cvc4-dimacs-XXXXXX");
-  std::string dratFilename("cvc4-drat-XXXXXX");
   std::string tracecheckFilename("cvc4-tracecheck-er-XXXXXX");
 
   // Write the formula
@@ -96,11 +95,6 @@ ErProof ErProof::fromBinaryDratProof(
   printDimacs(*formStream, clauses, usedIds);
   formStream->close();
 
-  // Write the (binary) DRAT proof
-  std::unique_ptr<std::fstream> dratStream = openTmpFile(&dratFilename);
-  (*dratStream) << dratBinary;
-  dratStream->close();
-
   std::unique_ptr<std::fstream> tracecheckStream =
       openTmpFile(&tracecheckFilename);
 
@@ -127,7 +121,6 @@ ErProof ErProof::fromBinaryDratProof(
   tracecheckStream->close();
 
   remove(formulaFilename.c_str());
-  remove(dratFilename.c_str());
   remove(tracecheckFilename.c_str());
 
   return proof;
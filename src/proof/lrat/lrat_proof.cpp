@@ -127,22 +127,17 @@ void printIndices(std::ostream& o, const std::vector<ClauseIdx>& indices)
 LratProof LratProof::fromDratProof(
     const std::unordered_map<ClauseId, prop::SatClause>& clauses,
     const std::vector<ClauseId> usedIds,
-    const std::string& dratBinary,
+    const std::string& dratFilename,
     TimerStat& toolTimer)
 {
   std::ostringstream cmd;
   std::string formulaFilename("cvc4-dimacs-XXXXXX");
-  std::string dratFilename("cvc4-drat-XXXXXX");
   std::string lratFilename("cvc4-lrat-XXXXXX");
 
   std::unique_ptr<std::fstream> formStream = openTmpFile(&formulaFilename);
   printDimacs(*formStream, clauses, usedIds);
   formStream->close();
 
-  std::unique_ptr<std::fstream> dratStream = openTmpFile(&dratFilename);
-  (*dratStream) << dratBinary;
-  dratStream->close();
-
   std::unique_ptr<std::fstream> lratStream = openTmpFile(&lratFilename);
 
   {
@@ -159,7 +154,6 @@ LratProof LratProof::fromDratProof(
 
   LratProof lrat(*lratStream);
   remove(formulaFilename.c_str());
-  remove(dratFilename.c_str());
   remove(lratFilename.c_str());
   return lrat;
 }
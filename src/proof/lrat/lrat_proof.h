@@ -133,14 +133,14 @@ class LratProof
    *
    * @param clauses A store of clauses that might be in our formula
    * @param usedIds the ids of clauses that are actually in our formula
-   * @param dratBinary  The DRAT proof from the SAT solver, as a binary stream.
+   * @param dratFilename the file of the binary DRAT proof from the SAT solver
    *
    * @return an LRAT proof an a timer for how long it took to run drat-trim
    */
   static LratProof fromDratProof(
       const std::unordered_map<ClauseId, prop::SatClause>& clauses,
       const std::vector<ClauseId> usedIds,
-      const std::string& dratBinary,
+      const std::string& dratFilename,
       TimerStat& toolTimer);
   /**
    * @brief Construct an LRAT proof from its textual representation
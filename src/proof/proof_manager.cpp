@@ -1074,30 +1074,49 @@ void ProofManager::dumpRewriteLog() const {
 }
 
 void bind(Expr term, ProofLetMap& map, Bindings& letOrder) {
-  ProofLetMap::iterator it = map.find(term);
-  if (it != map.end())
-    return;
+  // Iterative post-order traversal: the subterms of a term are bound before
+  // it, so that deep terms do not overflow the stack. A pair (t, true) is on
+  // the stack once each child of t is bound or on the stack above it.
+  std::vector<std::pair<Expr, bool> > visit;
+  visit.push_back(std::make_pair(term, false));
+  while (!visit.empty()) {
+    Expr current = visit.back().first;
+    bool childrenBound = visit.back().second;
+    visit.pop_back();
+    if (map.find(current) != map.end())
+      continue;
 
-  for (unsigned i = 0; i < term.getNumChildren(); ++i)
-    bind(term[i], map, letOrder);
-
-  // Special case: chain operators. If we have and(a,b,c), it will be prineted as and(a,and(b,c)).
-  // The subterm and(b,c) may repeat elsewhere, so we need to bind it, too.
-  Kind k = term.getKind();
-  if (((k == kind::OR) || (k == kind::AND)) && term.getNumChildren() > 2) {
-    Node currentExpression = term[term.getNumChildren() - 1];
-    for (int i = term.getNumChildren() - 2; i >= 0; --i) {
-      NodeBuilder<> builder(k);
-      builder << term[i];
-      builder << currentExpression.toExpr();
-      currentExpression = builder;
-      bind(currentExpression.toExpr(), map, letOrder);
+    if (!childrenBound) {
+      visit.push_back(std::make_pair(current, true));
+      for (unsigned i = current.getNumChildren(); i > 0; --i)
+        visit.push_back(std::make_pair(current[i - 1], false));
+      continue;
+    }
+
+    // Special case: chain operators. If we have and(a,b,c), it will be prineted as and(a,and(b,c)).
+    // The subterm and(b,c) may repeat elsewhere, so we need to bind it, too.
+    Kind k = current.getKind();
+    if (((k == kind::OR) || (k == kind::AND)) && current.getNumChildren() > 2) {
+      Node currentExpression = current[current.getNumChildren() - 1];
+      for (int i = current.getNumChildren() - 2; i >= 0; --i) {
+        NodeBuilder<> builder(k);
+        builder << current[i];
+        builder << currentExpression.toExpr();
+        currentExpression = builder;
+        // the children of the binary chain are already bound
+        Expr chain = currentExpression.toExpr();
+        if (map.find(chain) == map.end()) {
+          unsigned newId = ProofLetCount::newId();
+          map[chain] = ProofLetCount(newId);
+          letOrder.push_back(LetOrderElement(chain, newId));
+        }
+      }
+    } else {
+      unsigned newId = ProofLetCount::newId();
+      ProofLetCount letCount(newId);
+      map[current] = letCount;
+      letOrder.push_back(LetOrderElement(current, newId));
     }
-  } else {
-    unsigned newId = ProofLetCount::newId();
-    ProofLetCount letCount(newId);
-    map[term] = letCount;
-    letOrder.push_back(LetOrderElement(term, newId));
   }
 }
 
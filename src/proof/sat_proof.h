@@ -25,6 +25,7 @@
 #include <set>
 #include <sstream>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "context/cdhashmap.h"
@@ -69,26 +70,29 @@ template <class Solver>
 class ResChain {
  public:
   typedef std::vector<ResStep<Solver> > ResSteps;
-  typedef std::set<typename Solver::TLit> LitSet;
+  typedef std::vector<typename Solver::TLit> LitVector;
 
   ResChain(ClauseId start);
   ~ResChain();
 
   void addStep(typename Solver::TLit, ClauseId, bool);
-  bool redundantRemoved() {
-    return (d_redundantLits == NULL || d_redundantLits->empty());
-  }
+  bool redundantRemoved() { return d_redundantLits.empty(); }
   void addRedundantLit(typename Solver::TLit lit);
 
   // accessor methods
   ClauseId getStart() const { return d_start; }
   const ResSteps& getSteps() const { return d_steps; }
-  LitSet* getRedundant() const { return d_redundantLits; }
+  /**
+   * The redundant literals, in the order they were added, possibly with
+   * duplicates. They are only sorted and deduplicated when they are resolved
+   * out, to keep recording them cheap during conflict analysis.
+   */
+  LitVector& getRedundant() { return d_redundantLits; }
 
  private:
   ClauseId d_start;
   ResSteps d_steps;
-  LitSet* d_redundantLits;
+  LitVector d_redundantLits;
 }; /* class ResChain */
 
 template <class Solver>
@@ -97,6 +101,12 @@ class TSatProof {
   typedef ResChain<Solver> ResolutionChain;
 
   typedef std::set<typename Solver::TLit> LitSet;
+  struct LitHashFunction
+  {
+    size_t operator()(typename Solver::TLit l) const { return toInt(l); }
+  };
+  typedef std::unordered_set<typename Solver::TLit, LitHashFunction>
+      LitHashSet;
   typedef std::set<typename Solver::TVar> VarSet;
   typedef std::unordered_map<ClauseId, typename Solver::TCRef> IdCRefMap;
   typedef std::unordered_map<typename Solver::TCRef, ClauseId> ClauseIdMap;
@@ -232,7 +242,9 @@ class TSatProof {
   bool isUnit(typename Solver::TLit lit) const;
   ClauseId getUnitId(typename Solver::TLit lit) const;
 
-  void createLitSet(ClauseId id, LitSet& set);
+  /** Inserts the literals of the clause id into set (a LitSet or LitHashSet) */
+  template <class Set>
+  void createLitSet(ClauseId id, Set& set);
 
   /**
    * Registers a ClauseId with a resolution chain res.
@@ -271,11 +283,14 @@ class TSatProof {
    * to be removed in the proper order to the stack.
    *
    * @param lit the literal we are recursing on
-   * @param removedSet the previously computed set of redundant literals
    * @param removeStack the stack of literals in reverse order of resolution
+   * @param inClause the literals of the learned clause
+   * @param seen the literals already visited by the search
    */
-  void removedDfs(typename Solver::TLit lit, LitSet* removedSet,
-                  LitVector& removeStack, LitSet& inClause, LitSet& seen);
+  void removedDfs(typename Solver::TLit lit,
+                  LitVector& removeStack,
+                  LitHashSet& inClause,
+                  LitHashSet& seen);
   void removeRedundantFromRes(ResChain<Solver>* res, ClauseId id);
 
   void print(ClauseId id) const;
@@ -19,6 +19,8 @@
 #ifndef CVC4__SAT__PROOF_IMPLEMENTATION_H
 #define CVC4__SAT__PROOF_IMPLEMENTATION_H
 
+#include <algorithm>
+
 #include "proof/clause_id.h"
 #include "proof/cnf_proof.h"
 #include "proof/sat_proof.h"
@@ -80,7 +82,8 @@ void printDebug(typename Solver::TClause& c) {
  * @param set the clause converted to a set of literals
  */
 template <class Solver>
-void TSatProof<Solver>::createLitSet(ClauseId id, LitSet& set) {
+template <class Set>
+void TSatProof<Solver>::createLitSet(ClauseId id, Set& set) {
   Assert(set.empty());
   if (isUnit(id)) {
     set.insert(getUnit(id));
@@ -158,14 +161,10 @@ bool resolve(const typename Solver::TLit v,
 /// ResChain
 template <class Solver>
 ResChain<Solver>::ResChain(ClauseId start)
-    : d_start(start), d_steps(), d_redundantLits(NULL) {}
+    : d_start(start), d_steps(), d_redundantLits() {}
 
 template <class Solver>
-ResChain<Solver>::~ResChain() {
-  if (d_redundantLits != NULL) {
-    delete d_redundantLits;
-  }
-}
+ResChain<Solver>::~ResChain() {}
 
 template <class Solver>
 void ResChain<Solver>::addStep(typename Solver::TLit lit, ClauseId id,
@@ -176,12 +175,7 @@ void ResChain<Solver>::addStep(typename Solver::TLit lit, ClauseId id,
 
 template <class Solver>
 void ResChain<Solver>::addRedundantLit(typename Solver::TLit lit) {
-  if (d_redundantLits) {
-    d_redundantLits->insert(lit);
-  } else {
-    d_redundantLits = new LitSet();
-    d_redundantLits->insert(lit);
-  }
+  d_redundantLits.push_back(lit);
 }
 
 /// SatProof
@@ -627,8 +621,9 @@ ClauseId TSatProof<Solver>::registerAssumptionConflict(
 
 template <class Solver>
 void TSatProof<Solver>::removedDfs(typename Solver::TLit lit,
-                                   LitSet* removedSet, LitVector& removeStack,
-                                   LitSet& inClause, LitSet& seen) {
+                                   LitVector& removeStack,
+                                   LitHashSet& inClause,
+                                   LitHashSet& seen) {
   // if we already added the literal return
   if (seen.count(lit)) {
     return;
@@ -645,7 +640,7 @@ void TSatProof<Solver>::removedDfs(typename Solver::TLit lit,
   for (int i = 1; i < size; i++) {
     typename Solver::TLit v = getClause(reason_ref)[i];
     if (inClause.count(v) == 0 && seen.count(v) == 0) {
-      removedDfs(v, removedSet, removeStack, inClause, seen);
+      removedDfs(v, removeStack, inClause, seen);
     }
   }
   if (seen.count(lit) == 0) {
@@ -657,19 +652,24 @@ void TSatProof<Solver>::removedDfs(typename Solver::TLit lit,
 template <class Solver>
 void TSatProof<Solver>::removeRedundantFromRes(ResChain<Solver>* res,
                                                ClauseId id) {
-  LitSet* removed = res->getRedundant();
-  if (removed == NULL) {
+  LitVector& removed = res->getRedundant();
+  if (removed.empty()) {
     return;
   }
+  // the literals are visited in order, as a set would, so that the proof
+  // does not depend on the order they were found in
+  std::sort(removed.begin(), removed.end());
+  removed.erase(std::unique(removed.begin(), removed.end()), removed.end());
 
-  LitSet inClause;
+  LitHashSet inClause;
   createLitSet(id, inClause);
 
   LitVector removeStack;
-  LitSet seen;
-  for (typename LitSet::iterator it = removed->begin(); it != removed->end();
+  LitHashSet seen;
+  for (typename LitVector::const_iterator it = removed.begin();
+       it != removed.end();
        ++it) {
-    removedDfs(*it, removed, removeStack, inClause, seen);
+    removedDfs(*it, removeStack, inClause, seen);
   }
 
   for (int i = removeStack.size() - 1; i >= 0; --i) {
@@ -685,7 +685,7 @@ void TSatProof<Solver>::removeRedundantFromRes(ResChain<Solver>* res,
     }
     res->addStep(lit, reason_id, !sign(lit));
   }
-  removed->clear();
+  removed.clear();
 }
 
 template <class Solver>
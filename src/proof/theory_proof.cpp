@@ -260,18 +260,30 @@ theory::TheoryId TheoryProofEngine::getTheoryForLemma(const prop::SatClause* cla
 }
 
 void LFSCTheoryProofEngine::bind(Expr term, ProofLetMap& map, Bindings& let_order) {
-  ProofLetMap::iterator it = map.find(term);
-  if (it != map.end()) {
-    ProofLetCount& count = it->second;
-    count.increment();
-    return;
-  }
-  for (unsigned i = 0; i < term.getNumChildren(); ++i) {
-    bind(term[i], map, let_order);
+  // Iterative post-order traversal, which counts the occurrences of the
+  // terms already bound, and binds the subterms of a term before it.
+  std::vector<std::pair<Expr, bool> > visit;
+  visit.push_back(std::make_pair(term, false));
+  while (!visit.empty()) {
+    Expr current = visit.back().first;
+    bool children_bound = visit.back().second;
+    visit.pop_back();
+    if (children_bound) {
+      unsigned new_id = ProofLetCount::newId();
+      map[current] = ProofLetCount(new_id);
+      let_order.push_back(LetOrderElement(current, new_id));
+      continue;
+    }
+    ProofLetMap::iterator it = map.find(current);
+    if (it != map.end()) {
+      it->second.increment();
+      continue;
+    }
+    visit.push_back(std::make_pair(current, true));
+    for (unsigned i = current.getNumChildren(); i > 0; --i) {
+      visit.push_back(std::make_pair(current[i - 1], false));
+    }
   }
-  unsigned new_id = ProofLetCount::newId();
-  map[term] = ProofLetCount(new_id);
-  let_order.push_back(LetOrderElement(term, new_id));
 }
 
 void LFSCTheoryProofEngine::printLetTerm(Expr term, std::ostream& os) {
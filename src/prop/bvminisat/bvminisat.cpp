@@ -148,6 +148,20 @@ SatValue BVMinisatSatSolver::solve(long unsigned int& resource){
   return result;
 }
 
+SatValue BVMinisatSatSolver::solve(const std::vector<SatLiteral>& assumptions)
+{
+  TimerStat::CodeTimer solveTimer(d_statistics.d_statSolveTime);
+  ++d_statistics.d_statCallsToSolve;
+  BVMinisat::vec<BVMinisat::Lit> assumps;
+  for (const SatLiteral& lit : assumptions)
+  {
+    assumps.push(toMinisatLit(lit));
+  }
+  // the trail may still hold the decisions of the previous solve
+  d_minisat->resetTrail();
+  return toSatLiteralValue(d_minisat->solve(assumps));
+}
+
 bool BVMinisatSatSolver::ok() const {
   return d_minisat->okay(); 
 }
@@ -96,6 +96,11 @@ public:
 
   SatValue solve() override;
   SatValue solve(long unsigned int&) override;
+  /**
+   * Solves under the given assumptions, which replace those of
+   * assertAssumption(). Used by the incremental eager bit-blaster.
+   */
+  SatValue solve(const std::vector<SatLiteral>& assumptions) override;
   bool ok() const override;
   void getUnsatCore(SatClause& unsatCore) override;
 
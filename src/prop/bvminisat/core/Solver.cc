@@ -28,6 +28,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "base/exception.h"
 #include "base/output.h"
 #include "options/bv_options.h"
+#include "options/prop_options.h"
 #include "options/smt_options.h"
 #include "proof/clause_id.h"
 #include "proof/proof_manager.h"
@@ -117,7 +118,16 @@ Solver::Solver(CVC4::context::Context* context)
       //
       ,
       learntsize_adjust_start_confl(100),
-      learntsize_adjust_inc(1.5)
+      learntsize_adjust_inc(1.5),
+      use_lbd_tiers(CVC4::options::satLbdReduce()),
+      lbd_core(2),
+      lbd_tier2(6),
+      glucose_restart(CVC4::options::satRestartMode()
+                      == CVC4::options::SatRestartMode::GLUCOSE),
+      restart_fast_alpha(1.0 / 32),
+      restart_slow_alpha(1.0 / 16384),
+      restart_margin(1.25),
+      restart_min_confl(50)
 
       // Statistics: (formerly in 'SolverStats')
       //
@@ -161,6 +171,12 @@ Solver::Solver(CVC4::context::Context* context)
       analyze_stack(),
       analyze_toclear(),
       add_tmp(),
+      lbd_seen(),
+      lbd_stamp(0),
+      lbd_fast(0),
+      lbd_slow(0),
+      lbd_count(0),
+      learnts_core(0),
       max_learnts(0.0),
       learntsize_adjust_confl(0.0),
       learntsize_adjust_cnt(0)
@@ -461,7 +477,11 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel, UIP uip
         assert(confl != CRef_Undef); // (otherwise should be UIP)
         Clause& clause = ca[confl];
 
-        if (clause.learnt()) claBumpActivity(clause);
+        if (clause.learnt())
+        {
+          claBumpActivity(clause);
+          if (use_lbd_tiers) updateLbd(clause);
+        }
 
         for (int j = (p == lit_Undef) ? 0 : 1; j < clause.size(); j++)
         {
@@ -928,6 +948,12 @@ CRef Solver::propagate()
 |  Description:
 |    Remove half of the learnt clauses, minus the clauses locked by the current assignment. Locked
 |    clauses are clauses that are reason to some assignment. Binary clauses are never removed.
+|
+|    With 'use_lbd_tiers', the learnt clauses are first split by literal block distance: the clauses
+|    with an LBD of at most 'lbd_core' are never removed, and the clauses with an LBD of at most
+|    'lbd_tier2' are kept if they were used in a conflict since the last reduction. Only the other
+|    clauses are reduced by activity, and the clauses of the core tier are not counted against
+|    'max_learnts'.
 |________________________________________________________________________________________________@*/
 struct reduceDB_lt { 
     ClauseAllocator& ca;
@@ -940,22 +966,79 @@ void Solver::reduceDB()
     int     i, j;
     double  extra_lim = cla_inc / learnts.size();    // Remove any clause below this activity
 
-    sort(learnts, reduceDB_lt(ca));
+    int     kept = 0;
+
+    if (use_lbd_tiers){
+      // Move the clauses of the core and tier 2 tiers to the front, and only reduce the others:
+      learnts_core = 0;
+      for (i = 0; i < learnts.size(); i++){
+        Clause& clause = ca[learnts[i]];
+        bool keep = clause.lbd() <= lbd_core || (clause.lbd() <= lbd_tier2 && clause.used());
+        if (clause.lbd() <= lbd_core) learnts_core++;
+        clause.setUsed(false);
+        if (keep){
+          CRef cr = learnts[kept];
+          learnts[kept++] = learnts[i];
+          learnts[i] = cr; }
+      }
+    }
+
+    vec<CRef> local;
+    for (i = kept; i < learnts.size(); i++)
+      local.push(learnts[i]);
+    sort(local, reduceDB_lt(ca));
     // Don't delete binary or locked clauses. From the rest, delete clauses from the first half
     // and clauses with activity smaller than 'extra_lim':
-    for (i = j = 0; i < learnts.size(); i++){
-      Clause& clause = ca[learnts[i]];
+    for (i = 0, j = kept; i < local.size(); i++){
+      Clause& clause = ca[local[i]];
       if (clause.size() > 2 && !locked(clause)
-          && (i < learnts.size() / 2 || clause.activity() < extra_lim))
-        removeClause(learnts[i]);
+          && (i < local.size() / 2 || clause.activity() < extra_lim))
+        removeClause(local[i]);
       else
-        learnts[j++] = learnts[i];
+        learnts[j++] = local[i];
     }
-    learnts.shrink(i - j);
+    learnts.shrink(learnts.size() - j);
     checkGarbage();
 }
 
 
+void Solver::updateLbd(Clause& clause)
+{
+    clause.setUsed(true);
+    if (clause.lbd() > lbd_core){
+      unsigned lbd = computeLbd(clause);
+      if (lbd < clause.lbd())
+        clause.setLbd(lbd);
+    }
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  lbdRestart : (nof_conflicts : int)  ->  [bool]
+|
+|  Description:
+|    Glucose-style dynamic restarts: keeps a fast and a slow exponential moving average of the LBD of
+|    the learnt clauses, and restarts when the fast one exceeds the slow one by 'restart_margin', i.e.
+|    when the recently learnt clauses are worse than usual. 'nof_conflicts' is the number of
+|    conflicts since the last restart, which must be at least 'restart_min_confl'.
+|________________________________________________________________________________________________@*/
+void Solver::addLbdSample(unsigned lbd)
+{
+    lbd_count++;
+    // Use the plain average of the first samples, so that the averages are not biased towards 0:
+    double fast = std::max(restart_fast_alpha, 1.0 / lbd_count);
+    double slow = std::max(restart_slow_alpha, 1.0 / lbd_count);
+    lbd_fast += fast * (lbd - lbd_fast);
+    lbd_slow += slow * (lbd - lbd_slow);
+}
+
+bool Solver::lbdRestart(int nof_conflicts) const
+{
+    return nof_conflicts >= restart_min_confl && lbd_fast > restart_margin * lbd_slow;
+}
+
+
 void Solver::removeSatisfied(vec<CRef>& cs)
 {
     int i, j;
@@ -1057,6 +1140,8 @@ lbool Solver::search(int nof_conflicts, UIP uip)
 
             learnt_clause.clear();
             analyze(confl, learnt_clause, backtrack_level, uip);
+            unsigned lbd = computeLbd(learnt_clause);
+            if (glucose_restart) addLbdSample(lbd);
 
             Lit p = learnt_clause[0];
             //bool assumption = marker[var(p)] == 2;
@@ -1064,6 +1149,7 @@ lbool Solver::search(int nof_conflicts, UIP uip)
             CRef cr = CRef_Undef;
             if (learnt_clause.size() > 1) {
               cr = ca.alloc(learnt_clause, true);
+              ca[cr].setLbd(lbd);
               learnts.push(cr);
               attachClause(cr);
               claBumpActivity(ca[cr]);
@@ -1157,8 +1243,9 @@ lbool Solver::search(int nof_conflicts, UIP uip)
               throw e; 
             }
 
-            if ((decisionLevel() > assumptions.size() && nof_conflicts >= 0
-                 && conflictC >= nof_conflicts)
+            if ((decisionLevel() > assumptions.size()
+                 && ((nof_conflicts >= 0 && conflictC >= nof_conflicts)
+                     || (glucose_restart && lbdRestart(conflictC))))
                 || !isWithinBudget)
             {
               // Reached bound on number of conflicts:
@@ -1177,7 +1264,7 @@ lbool Solver::search(int nof_conflicts, UIP uip)
 
             // We can't erase clauses if there is unprocessed assumptions, there might be some
             // propagationg we need to redu
-            if (decisionLevel() >= assumptions.size() && learnts.size()-nAssigns() >= max_learnts) {
+            if (decisionLevel() >= assumptions.size() && learnts.size()-learnts_core-nAssigns() >= max_learnts) {
                 // Reduce the set of learnt clauses:
                 Debug("bvminisat::search") << OUTPUT_TAG << " cleaning up database" << std::endl;
                 reduceDB();
@@ -1304,7 +1391,7 @@ lbool Solver::solve_()
     int curr_restarts = 0;
     while (status == l_Undef){
         double rest_base = luby_restart ? luby(restart_inc, curr_restarts) : pow(restart_inc, curr_restarts);
-        status = search(rest_base * restart_first);
+        status = search(glucose_restart ? -1 : rest_base * restart_first);
         if (!withinBudget(ResourceManager::Resource::BvSatConflictsStep)) break;
         curr_restarts++;
     }
@@ -1553,6 +1640,8 @@ void ClauseAllocator::reloc(CRef& cr,
   // Copy extra data-fields: 
   // (This could be cleaned-up. Generalize Clause-constructor to be applicable here instead?)
   to[cr].mark(c.mark());
+  to[cr].setLbd(c.lbd());
+  to[cr].setUsed(c.used());
   if (to[cr].learnt())         to[cr].activity() = c.activity();
   else if (to[cr].has_extra()) to[cr].calcAbstraction();
 }
@@ -131,6 +131,7 @@ public:
     lbool   assertAssumption(Lit p, bool propagate);  // Assert a new assumption, start BCP if propagate = true
     lbool   propagateAssumptions();                   // Do BCP over asserted assumptions
     void    popAssumption();                          // Pop an assumption
+    void    resetTrail   ();                          // Backtrack to level 0, e.g. before solving under new assumptions
 
     void    toDimacs     (FILE* f, const vec<Lit>& assumps);            // Write CNF to file in DIMACS-format.
     void    toDimacs     (const char *file, const vec<Lit>& assumps);
@@ -201,6 +202,15 @@ public:
     int       learntsize_adjust_start_confl;
     double    learntsize_adjust_inc;
 
+    bool      use_lbd_tiers;      // Reduce the learnt clauses by tiers of literal block distance (see 'reduceDB()').       (default false)
+    unsigned  lbd_core;           // Learnt clauses up to this LBD are never removed.                                          (default 2)
+    unsigned  lbd_tier2;          // Learnt clauses up to this LBD are kept while they are used in conflicts.                  (default 6)
+    bool      glucose_restart;    // Restart when the recent LBD average exceeds the long-term one (see 'lbdRestart()').    (default false)
+    double    restart_fast_alpha; // The smoothing factor of the moving average of recent LBDs.                                (default 1/32)
+    double    restart_slow_alpha; // The smoothing factor of the moving average of all LBDs.                                   (default 1/16384)
+    double    restart_margin;     // Restart when the recent average is this factor above the long-term one.                   (default 1.25)
+    int       restart_min_confl;  // The minimal number of conflicts between two restarts.                                     (default 50)
+
     // Statistics: (read-only member variable)
     //
     uint64_t solves, starts, decisions, rnd_decisions, propagations, conflicts;
@@ -283,6 +293,13 @@ public:
     vec<Lit>            analyze_stack;
     vec<Lit>            analyze_toclear;
     vec<Lit>            add_tmp;
+    vec<uint64_t>       lbd_seen;         // The stamp of each decision level, used by 'computeLbd()'.
+    uint64_t            lbd_stamp;
+
+    double              lbd_fast;         // Moving averages of the LBD of the learnt clauses (see 'lbdRestart()').
+    double              lbd_slow;
+    uint64_t            lbd_count;
+    int                 learnts_core;     // Number of learnt clauses of the core tier at the last 'reduceDB()'.
 
     double              max_learnts;
     double              learntsize_adjust_confl;
@@ -319,6 +336,11 @@ public:
     lbool    search           (int nof_conflicts, UIP uip = UIP_FIRST);                // Search for a given number of conflicts.
     lbool    solve_           ();                                                      // Main solve method (assumptions given in 'assumptions').
     void     reduceDB         ();                                                      // Reduce the set of learnt clauses.
+    template<class Lits>
+    unsigned computeLbd       (const Lits& ps);                                        // Number of distinct decision levels of 'ps', counting each unassigned literal apart.
+    void     updateLbd        (Clause& c);                                             // Lower the LBD of a learnt clause used in conflict analysis, and mark it as used.
+    void     addLbdSample     (unsigned lbd);                                          // Update the moving averages of the LBD of the learnt clauses.
+    bool     lbdRestart       (int nof_conflicts) const;                               // Whether the LBD averages call for a restart.
     void     removeSatisfied  (vec<CRef>& cs);                                         // Shrink 'cs' to contain only non-satisfied clauses.
     void     rebuildOrderHeap ();
 
@@ -427,6 +449,21 @@ inline void Solver::claBumpActivity(Clause& clause)
   }
 }
 
+template<class Lits>
+inline unsigned Solver::computeLbd(const Lits& ps) {
+        if (lbd_seen.size() <= decisionLevel())
+            lbd_seen.growTo(decisionLevel() + 1, 0);
+        lbd_stamp++;
+        unsigned lbd = 0;
+        for (int i = 0; i < ps.size(); i++){
+            Var x = var(ps[i]);
+            if (value(x) == l_Undef)
+                lbd++;
+            else if (lbd_seen[level(x)] != lbd_stamp){
+                lbd_seen[level(x)] = lbd_stamp;
+                lbd++; } }
+        return lbd; }
+
 inline void Solver::checkGarbage(void){ return checkGarbage(garbage_frac); }
 inline void Solver::checkGarbage(double gf){
     if (ca.wasted() > ca.size() * gf)
@@ -479,6 +516,7 @@ inline lbool     Solver::solve         (Lit p, Lit q, Lit r) { budgetOff(); assu
 inline lbool     Solver::solve         (const vec<Lit>& assumps){ budgetOff(); assumps.copyTo(assumptions); return solve_(); }
 inline lbool    Solver::solveLimited  (const vec<Lit>& assumps){ assumps.copyTo(assumptions); return solve_(); }
 inline bool     Solver::okay          ()      const   { return ok; }
+inline void     Solver::resetTrail    ()              { cancelUntil(0); }
 
 inline void     Solver::toDimacs     (const char* file){ vec<Lit> as; toDimacs(file, as); }
 inline void     Solver::toDimacs     (const char* file, Lit p){ vec<Lit> as; as.push(p); toDimacs(file, as); }
@@ -149,7 +149,9 @@ class Clause {
         unsigned learnt    : 1;
         unsigned has_extra : 1;
         unsigned reloced   : 1;
-        unsigned size      : 27; }                            header;
+        unsigned size      : 27;
+        unsigned used      : 1;
+        unsigned lbd       : 6; }                             header;
     union { Lit lit; float act; uint32_t abs; CRef rel; } data[0];
 
     friend class ClauseAllocator;
@@ -162,6 +164,8 @@ class Clause {
         header.has_extra = use_extra;
         header.reloced   = 0;
         header.size      = ps.size();
+        header.used      = 0;
+        header.lbd       = 0;
 
         for (int i = 0; i < ps.size(); i++) 
             data[i].lit = ps[i];
@@ -191,6 +195,14 @@ public:
     void         mark        (uint32_t m)    { header.mark = m; }
     const Lit&   last        ()      const   { return data[header.size-1].lit; }
 
+    // The literal block distance (number of distinct decision levels), saturated at 'lbd_max', and
+    // whether the clause took part in a conflict since the last reduction of the learnt clauses:
+    enum { lbd_max = 63 };
+    unsigned     lbd         ()      const   { return header.lbd; }
+    void         setLbd      (unsigned l)    { header.lbd = l < lbd_max ? l : lbd_max; }
+    bool         used        ()      const   { return header.used; }
+    void         setUsed     (bool u)        { header.used = u; }
+
     bool         reloced     ()      const   { return header.reloced; }
     CRef         relocation  ()      const   { return data[0].rel; }
     void         relocate    (CRef c)        { header.reloced = 1; data[0].rel = c; }
@@ -0,0 +1,798 @@
+/*********************                                                        */
+/*! \file cadical_dpll.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief CaDiCaL as the SAT solver of the DPLL(T) search
+ **/
+
+#include "prop/cadical_dpll.h"
+
+#ifdef CVC4_USE_CADICAL_PROPAGATOR
+
+#include <cstdlib>
+#include <deque>
+#include <utility>
+
+#include "base/check.h"
+#include "options/prop_options.h"
+#include "prop/theory_proxy.h"
+#include "theory/theory.h"
+
+namespace CVC4 {
+namespace prop {
+
+using CadicalLit = int;
+
+// helper functions
+namespace {
+
+SatValue toSatValue(int result)
+{
+  if (result == 10) return SAT_VALUE_TRUE;
+  if (result == 20) return SAT_VALUE_FALSE;
+  Assert(result == 0);
+  return SAT_VALUE_UNKNOWN;
+}
+
+CadicalLit toCadicalLit(const SatLiteral lit)
+{
+  return lit.isNegated() ? -lit.getSatVariable() : lit.getSatVariable();
+}
+
+SatLiteral toSatLiteral(CadicalLit lit)
+{
+  return SatLiteral(std::abs(lit), lit < 0);
+}
+
+}  // namespace helper functions
+
+/**
+ * The connection of CaDiCaL to the theories.  It keeps the assignment of the
+ * observed variables in the order of the notifications, pushes the SAT
+ * context at each decision level and asserts the literals of the theory atoms
+ * to the theories, as Minisat does in uncheckedEnqueue().
+ */
+class CadicalPropagator : public CaDiCaL::ExternalPropagator
+{
+ public:
+  CadicalPropagator(CadicalDPLLSatSolver& solver)
+      : d_solver(solver),
+        d_proxy(nullptr),
+        d_inSearch(false),
+        d_theoryCheckNeeded(false),
+        d_userLevel(0),
+        d_nextPropagation(0),
+        d_reasonPos(0),
+        d_clausePos(0)
+  {
+    // CaDiCaL variables start with index 1
+    d_vars.push_back(VarInfo(false, 0));
+  }
+
+  void setTheoryProxy(TheoryProxy* proxy) { d_proxy = proxy; }
+
+  void setInSearch(bool inSearch) { d_inSearch = inSearch; }
+  bool inSearch() const { return d_inSearch; }
+
+  /** Adds the information of variable var, of the current user level. */
+  void addVar(SatVariable var, bool isTheoryAtom, bool preRegister)
+  {
+    Assert(var == d_vars.size());
+    d_vars.push_back(VarInfo(isTheoryAtom, d_userLevel));
+    if (preRegister)
+    {
+      d_toRegister.push_back(std::make_pair(var, d_levels.size()));
+    }
+  }
+
+  SatValue value(SatLiteral lit) const
+  {
+    SatVariable var = lit.getSatVariable();
+    if (var >= d_vars.size() || d_vars[var].d_value == 0)
+    {
+      return SAT_VALUE_UNKNOWN;
+    }
+    return (d_vars[var].d_value > 0) != lit.isNegated() ? SAT_VALUE_TRUE
+                                                        : SAT_VALUE_FALSE;
+  }
+
+  /** Returns true if lit is assigned before expl, or expl is not assigned. */
+  bool assignedBefore(SatLiteral lit, SatLiteral expl) const
+  {
+    if (value(lit) == SAT_VALUE_UNKNOWN || value(expl) == SAT_VALUE_UNKNOWN)
+    {
+      return false;
+    }
+    return d_vars[expl.getSatVariable()].d_trailIndex
+           < d_vars[lit.getSatVariable()].d_trailIndex;
+  }
+
+  /** Queues a clause for CaDiCaL, which asks for it during the search. */
+  void addExternalClause(const std::vector<CadicalLit>& clause)
+  {
+    d_clauses.push_back(clause);
+  }
+
+  /** Hands the clauses that CaDiCaL did not ask for back to the solver. */
+  void takeExternalClauses(std::deque<std::vector<CadicalLit>>& clauses)
+  {
+    // A clause that CaDiCaL got in part is handed back whole
+    d_clausePos = 0;
+    clauses.swap(d_clauses);
+    d_clauses.clear();
+  }
+
+  /** Cancels all decision levels, see CadicalDPLLSatSolver::resetTrail(). */
+  void resetTrail()
+  {
+    if (!d_levels.empty())
+    {
+      backtrack(0);
+    }
+  }
+
+  void userPush() { ++d_userLevel; }
+
+  /**
+   * Pops a user level: the variables introduced in it are forgotten by the
+   * CNF stream, and the literals of the fixed theory atoms asserted in it are
+   * asserted again, since they stay fixed in CaDiCaL.
+   */
+  void userPop()
+  {
+    Assert(d_levels.empty());
+    Assert(d_userLevel > 0);
+    --d_userLevel;
+    for (VarInfo& info : d_vars)
+    {
+      if (info.d_userLevel > d_userLevel)
+      {
+        info.d_alive = false;
+      }
+    }
+    d_toRegister.clear();
+    for (CadicalLit lit : d_trail)
+    {
+      VarInfo& info = d_vars[std::abs(lit)];
+      if (info.d_alive && info.d_theoryAtom
+          && info.d_assertedLevel > d_userLevel)
+      {
+        info.d_assertedLevel = d_userLevel;
+        d_proxy->enqueueTheoryLiteral(toSatLiteral(lit));
+      }
+    }
+  }
+
+  void notify_assignment(int lit, bool is_fixed) override
+  {
+    VarInfo& info = d_vars[std::abs(lit)];
+    if (info.d_value != 0)
+    {
+      // A literal becomes fixed after it was assigned at a decision level
+      Assert(info.d_value == (lit > 0 ? 1 : -1));
+      info.d_fixed = info.d_fixed || is_fixed;
+      return;
+    }
+    assign(lit, is_fixed);
+  }
+
+  void notify_new_decision_level() override
+  {
+    d_solver.d_context->push();
+    d_levels.push_back(d_trail.size());
+  }
+
+  void notify_backtrack(size_t new_level) override
+  {
+    if (new_level >= d_levels.size())
+    {
+      // the trail was already reset by resetTrail()
+      return;
+    }
+    backtrack(new_level);
+    if (d_inSearch)
+    {
+      d_proxy->spendResource(ResourceManager::Resource::SatConflictStep);
+      // Backtracking to the activation literals is a restart
+      if (new_level <= d_solver.d_activation.size())
+      {
+        d_proxy->notifyRestart();
+        importShared();
+      }
+    }
+  }
+
+  bool cb_check_found_model(const std::vector<int>& model) override
+  {
+    do
+    {
+      d_theoryCheckNeeded = false;
+      d_proxy->theoryCheck(theory::Theory::EFFORT_FULL);
+      // Pick up the theory propagated literals; a false one is a conflict
+      collectPropagations();
+      if (!d_clauses.empty())
+      {
+        return false;
+      }
+    } while (d_proxy->theoryNeedCheck());
+    return true;
+  }
+
+  int cb_decide() override
+  {
+    SatLiteral lit = d_proxy->getNextTheoryDecisionRequest();
+    if (isDecidable(lit))
+    {
+      return toCadicalLit(lit);
+    }
+    bool stopSearch = false;
+    lit = d_proxy->getNextDecisionEngineRequest(stopSearch);
+    if (!stopSearch && isDecidable(lit))
+    {
+      d_proxy->spendResource(ResourceManager::Resource::DecisionStep);
+      return toCadicalLit(lit);
+    }
+    return 0;
+  }
+
+  int cb_propagate() override
+  {
+    if (d_nextPropagation == d_propagations.size()
+        && (d_theoryCheckNeeded || d_proxy->theoryNeedCheck()))
+    {
+      d_theoryCheckNeeded = false;
+      d_propagations.clear();
+      d_nextPropagation = 0;
+      d_proxy->theoryCheck(theory::Theory::EFFORT_STANDARD);
+      collectPropagations();
+    }
+    while (d_nextPropagation < d_propagations.size())
+    {
+      CadicalLit lit = d_propagations[d_nextPropagation++];
+      if (value(toSatLiteral(lit)) == SAT_VALUE_UNKNOWN)
+      {
+        ++d_solver.d_statistics.d_numTheoryPropagations;
+        return lit;
+      }
+    }
+    return 0;
+  }
+
+  int cb_add_reason_clause_lit(int propagated_lit) override
+  {
+    if (d_reasonPos == 0)
+    {
+      SatClause explanation;
+      d_proxy->explainPropagation(toSatLiteral(propagated_lit), explanation);
+      Assert(explanation[0] == toSatLiteral(propagated_lit));
+      d_reason.clear();
+      for (const SatLiteral& lit : explanation)
+      {
+        d_reason.push_back(toCadicalLit(lit));
+      }
+      ++d_solver.d_statistics.d_numExplanations;
+    }
+    if (d_reasonPos < d_reason.size())
+    {
+      return d_reason[d_reasonPos++];
+    }
+    d_reasonPos = 0;
+    return 0;
+  }
+
+  bool cb_has_external_clause() override { return !d_clauses.empty(); }
+
+  int cb_add_external_clause_lit() override
+  {
+    Assert(!d_clauses.empty());
+    const std::vector<CadicalLit>& clause = d_clauses.front();
+    if (d_clausePos < clause.size())
+    {
+      return clause[d_clausePos++];
+    }
+    d_clauses.pop_front();
+    d_clausePos = 0;
+    return 0;
+  }
+
+ private:
+  struct VarInfo
+  {
+    VarInfo(bool theoryAtom, unsigned userLevel)
+        : d_value(0),
+          d_fixed(false),
+          d_theoryAtom(theoryAtom),
+          d_alive(true),
+          d_userLevel(userLevel),
+          d_assertedLevel(0),
+          d_trailIndex(0)
+    {
+    }
+    /** 1 if the variable is true, -1 if it is false and 0 if unassigned */
+    int d_value;
+    /** Is the variable fixed by CaDiCaL? */
+    bool d_fixed;
+    /** Is the variable the literal of a theory atom? */
+    bool d_theoryAtom;
+    /** Is the variable still known to the CNF stream? */
+    bool d_alive;
+    /** The user level at which the variable was introduced */
+    unsigned d_userLevel;
+    /** The user level at which its literal was asserted to the theories */
+    unsigned d_assertedLevel;
+    /** The position of its literal in the trail */
+    size_t d_trailIndex;
+  };
+
+  /** Assigns lit at the current decision level. */
+  void assign(CadicalLit lit, bool fixed)
+  {
+    VarInfo& info = d_vars[std::abs(lit)];
+    info.d_value = lit > 0 ? 1 : -1;
+    info.d_fixed = fixed;
+    info.d_trailIndex = d_trail.size();
+    d_trail.push_back(lit);
+    if (info.d_alive && info.d_theoryAtom)
+    {
+      info.d_assertedLevel = d_userLevel;
+      d_proxy->enqueueTheoryLiteral(toSatLiteral(lit));
+      d_theoryCheckNeeded = true;
+    }
+  }
+
+  /** Cancels the decision levels above level, as Minisat's cancelUntil(). */
+  void backtrack(size_t level)
+  {
+    Assert(level < d_levels.size());
+    std::vector<CadicalLit> fixed;
+    for (size_t i = d_levels[level], size = d_trail.size(); i < size; ++i)
+    {
+      VarInfo& info = d_vars[std::abs(d_trail[i])];
+      if (info.d_fixed)
+      {
+        fixed.push_back(d_trail[i]);
+      }
+      info.d_value = 0;
+      info.d_fixed = false;
+    }
+    d_trail.resize(d_levels[level]);
+    context::Context* context = d_solver.d_context;
+    context->popto(context->getLevel() - (d_levels.size() - level));
+    d_levels.resize(level);
+    d_propagations.clear();
+    d_nextPropagation = 0;
+
+    // The literals fixed at a higher level stay assigned in CaDiCaL, but
+    // their assertions to the theories were popped with the SAT context
+    for (CadicalLit lit : fixed)
+    {
+      assign(lit, true);
+    }
+
+    // Register the variables introduced above the level again
+    for (size_t i = d_toRegister.size();
+         i > 0 && d_toRegister[i - 1].second > level;
+         --i)
+    {
+      d_toRegister[i - 1].second = level;
+      if (d_vars[d_toRegister[i - 1].first].d_alive)
+      {
+        d_proxy->variableNotify(d_toRegister[i - 1].first);
+      }
+    }
+  }
+
+  /** Queues the clauses shared by the other solvers, as lemmas. */
+  void importShared()
+  {
+    if (!d_proxy->isSharingClauses())
+    {
+      return;
+    }
+    std::vector<SatClause> clauses;
+    d_proxy->importSharedClauses(clauses);
+    for (SatClause& clause : clauses)
+    {
+      d_solver.addClause(clause, true);
+    }
+  }
+
+  /** Returns true if lit is the literal of an unassigned variable. */
+  bool isDecidable(SatLiteral lit) const
+  {
+    return !lit.isNull() && lit.getSatVariable() < d_vars.size()
+           && d_vars[lit.getSatVariable()].d_alive
+           && value(lit) == SAT_VALUE_UNKNOWN;
+  }
+
+  /**
+   * Collects the literals propagated by the theories.  A propagated literal
+   * that is already false is a conflict, whose explanation is added as a
+   * clause, as in Minisat's propagateTheory().
+   */
+  void collectPropagations()
+  {
+    SatClause propagations;
+    d_proxy->theoryPropagate(propagations);
+    for (const SatLiteral& lit : propagations)
+    {
+      SatValue v = value(lit);
+      if (v == SAT_VALUE_UNKNOWN)
+      {
+        d_propagations.push_back(toCadicalLit(lit));
+      }
+      else if (v == SAT_VALUE_FALSE)
+      {
+        SatClause explanation;
+        d_proxy->explainPropagation(lit, explanation);
+        d_solver.addClause(explanation, true);
+      }
+    }
+  }
+
+  CadicalDPLLSatSolver& d_solver;
+  TheoryProxy* d_proxy;
+
+  /** Is CaDiCaL solving? */
+  bool d_inSearch;
+  /** Were theory literals asserted since the last theory check? */
+  bool d_theoryCheckNeeded;
+  /** The current user level */
+  unsigned d_userLevel;
+
+  /** The variables, by index */
+  std::vector<VarInfo> d_vars;
+  /** The assigned literals, in the order of their notification */
+  std::vector<CadicalLit> d_trail;
+  /** The size of the trail at the start of each decision level */
+  std::vector<size_t> d_levels;
+  /** The variables to register again on backtracks, with their level */
+  std::vector<std::pair<SatVariable, size_t>> d_toRegister;
+
+  /** The theory propagations, and the next one to hand to CaDiCaL */
+  std::vector<CadicalLit> d_propagations;
+  size_t d_nextPropagation;
+  /** The reason clause being handed to CaDiCaL, and the next literal */
+  std::vector<CadicalLit> d_reason;
+  size_t d_reasonPos;
+  /** The clauses to hand to CaDiCaL, and the next literal of the first */
+  std::deque<std::vector<CadicalLit>> d_clauses;
+  size_t d_clausePos;
+}; /* class CadicalPropagator */
+
+/**
+ * Exports the short clauses learned by CaDiCaL to the other solvers.
+ * CaDiCaL does not report the LBD of its learned clauses, so they are only
+ * filtered by their size.
+ */
+class CadicalLearner : public CaDiCaL::Learner
+{
+ public:
+  CadicalLearner(TheoryProxy* proxy)
+      : d_proxy(proxy), d_maxSize(options::satShareLength())
+  {
+  }
+
+  bool learning(int size) override
+  {
+    return static_cast<unsigned>(size) <= d_maxSize;
+  }
+
+  void learn(int lit) override
+  {
+    if (lit != 0)
+    {
+      d_clause.push_back(toSatLiteral(lit));
+      return;
+    }
+    d_proxy->exportLearnedClause(d_clause);
+    d_clause.clear();
+  }
+
+ private:
+  TheoryProxy* d_proxy;
+  unsigned d_maxSize;
+  /** The literals of the clause being learned */
+  SatClause d_clause;
+}; /* class CadicalLearner */
+
+CadicalDPLLSatSolver::CadicalDPLLSatSolver(StatisticsRegistry* registry)
+    : d_solver(new CaDiCaL::Solver()),
+      d_context(nullptr),
+      d_theoryProxy(nullptr),
+      d_nextVar(1),
+      d_inconsistent(false),
+      d_statistics(registry)
+{
+  d_propagator.reset(new CadicalPropagator(*this));
+  d_solver->set("quiet", 1);  // CaDiCaL is verbose by default
+  // The propagator expects the assignments in the order of the decision
+  // levels, which chronological backtracking does not preserve.
+  d_solver->set("chrono", 0);
+
+  d_true = newVar();
+  d_false = newVar();
+  d_solver->add(toCadicalLit(SatLiteral(d_true)));
+  d_solver->add(0);
+  d_solver->add(toCadicalLit(SatLiteral(d_false, true)));
+  d_solver->add(0);
+}
+
+CadicalDPLLSatSolver::~CadicalDPLLSatSolver()
+{
+  if (d_learner != nullptr)
+  {
+    d_solver->disconnect_learner();
+  }
+  if (d_context != nullptr)
+  {
+    d_solver->disconnect_external_propagator();
+  }
+}
+
+void CadicalDPLLSatSolver::initialize(context::Context* context,
+                                      TheoryProxy* theoryProxy)
+{
+  d_context = context;
+  d_theoryProxy = theoryProxy;
+  d_propagator->setTheoryProxy(theoryProxy);
+  d_solver->connect_external_propagator(d_propagator.get());
+  // Observe the variables introduced before, among them trueVar() and
+  // falseVar()
+  for (SatVariable var = 1; var < d_nextVar; ++var)
+  {
+    d_solver->add_observed_var(var);
+  }
+}
+
+ClauseId CadicalDPLLSatSolver::addClause(SatClause& clause, bool removable)
+{
+  std::vector<CadicalLit> lits;
+  for (const SatLiteral& lit : clause)
+  {
+    lits.push_back(toCadicalLit(lit));
+  }
+  addCadicalClause(lits);
+  return ClauseIdError;
+}
+
+void CadicalDPLLSatSolver::addCadicalClause(std::vector<CadicalLit>& clause)
+{
+  // The clause only holds while its user level is active
+  if (!d_activation.empty())
+  {
+    clause.push_back(-d_activation.back());
+  }
+  ++d_statistics.d_numClauses;
+  if (d_propagator->inSearch())
+  {
+    ++d_statistics.d_numLemmas;
+    d_propagator->addExternalClause(clause);
+    return;
+  }
+  for (CadicalLit lit : clause)
+  {
+    d_solver->add(lit);
+  }
+  d_solver->add(0);
+}
+
+ClauseId CadicalDPLLSatSolver::addXorClause(SatClause& clause,
+                                            bool rhs,
+                                            bool removable)
+{
+  Unreachable() << "CaDiCaL does not support adding XOR clauses.";
+}
+
+SatVariable CadicalDPLLSatSolver::newVar(bool isTheoryAtom,
+                                         bool preRegister,
+                                         bool canErase)
+{
+  // Observed variables are never eliminated by CaDiCaL, so canErase is moot
+  return newCadicalVar(isTheoryAtom, preRegister, true);
+}
+
+SatVariable CadicalDPLLSatSolver::newCadicalVar(bool isTheoryAtom,
+                                                bool preRegister,
+                                                bool observed)
+{
+  SatVariable var = d_nextVar++;
+  d_propagator->addVar(var, isTheoryAtom, preRegister);
+  if (observed && d_context != nullptr)
+  {
+    d_solver->add_observed_var(var);
+  }
+  ++d_statistics.d_numVariables;
+  return var;
+}
+
+SatVariable CadicalDPLLSatSolver::trueVar() { return d_true; }
+
+SatVariable CadicalDPLLSatSolver::falseVar() { return d_false; }
+
+SatValue CadicalDPLLSatSolver::solve()
+{
+  return solveInternal(std::vector<SatLiteral>());
+}
+
+SatValue CadicalDPLLSatSolver::solve(long unsigned int&)
+{
+  Unimplemented() << "Setting limits for CaDiCaL not supported yet";
+}
+
+SatValue CadicalDPLLSatSolver::solve(const std::vector<SatLiteral>& assumptions)
+{
+  return solveInternal(assumptions);
+}
+
+SatValue CadicalDPLLSatSolver::solveInternal(
+    const std::vector<SatLiteral>& assumptions)
+{
+  TimerStat::CodeTimer codeTimer(d_statistics.d_solveTime);
+  for (CadicalLit lit : d_requiredPhases)
+  {
+    d_solver->phase(lit);
+  }
+  d_requiredPhases.clear();
+  // The clause sharing is set up after the initialization
+  if (d_learner == nullptr && d_theoryProxy->isSharingClauses())
+  {
+    d_learner.reset(new CadicalLearner(d_theoryProxy));
+    d_solver->connect_learner(d_learner.get());
+  }
+  for (CadicalLit act : d_activation)
+  {
+    d_solver->assume(act);
+  }
+  for (const SatLiteral& lit : assumptions)
+  {
+    d_solver->assume(toCadicalLit(lit));
+  }
+
+  d_propagator->setInSearch(true);
+  SatValue res = toSatValue(d_solver->solve());
+  d_propagator->setInSearch(false);
+  ++d_statistics.d_numSatCalls;
+
+  // Add the lemmas that CaDiCaL did not ask for before the search ended
+  std::deque<std::vector<CadicalLit>> clauses;
+  d_propagator->takeExternalClauses(clauses);
+  for (const std::vector<CadicalLit>& clause : clauses)
+  {
+    for (CadicalLit lit : clause)
+    {
+      d_solver->add(lit);
+    }
+    d_solver->add(0);
+  }
+
+  if (res == SAT_VALUE_FALSE && d_activation.empty() && assumptions.empty())
+  {
+    d_inconsistent = true;
+  }
+  return res;
+}
+
+void CadicalDPLLSatSolver::interrupt() { d_solver->terminate(); }
+
+SatValue CadicalDPLLSatSolver::value(SatLiteral l)
+{
+  return d_propagator->value(l);
+}
+
+SatValue CadicalDPLLSatSolver::modelValue(SatLiteral l)
+{
+  // CaDiCaL does not backtrack after finding a model, so the trail holds it
+  return d_propagator->value(l);
+}
+
+unsigned CadicalDPLLSatSolver::getAssertionLevel() const
+{
+  return d_activation.size();
+}
+
+bool CadicalDPLLSatSolver::ok() const { return !d_inconsistent; }
+
+void CadicalDPLLSatSolver::push()
+{
+  Assert(!d_propagator->inSearch());
+  d_propagator->resetTrail();
+  // The activation variable is not observed: it is not the literal of a node
+  SatVariable act = newCadicalVar(false, false, false);
+  d_activation.push_back(toCadicalLit(SatLiteral(act)));
+  d_context->push();
+  d_propagator->userPush();
+}
+
+void CadicalDPLLSatSolver::pop()
+{
+  Assert(!d_propagator->inSearch());
+  Assert(!d_activation.empty());
+  d_propagator->resetTrail();
+  d_context->pop();
+  // Disable the clauses of the level for good
+  CadicalLit act = d_activation.back();
+  d_activation.pop_back();
+  d_solver->add(-act);
+  d_solver->add(0);
+  d_propagator->userPop();
+}
+
+void CadicalDPLLSatSolver::resetTrail() { d_propagator->resetTrail(); }
+
+bool CadicalDPLLSatSolver::properExplanation(SatLiteral lit,
+                                             SatLiteral expl) const
+{
+  return d_propagator->assignedBefore(lit, expl);
+}
+
+void CadicalDPLLSatSolver::requirePhase(SatLiteral lit)
+{
+  if (d_propagator->inSearch())
+  {
+    d_requiredPhases.push_back(toCadicalLit(lit));
+  }
+  else
+  {
+    d_solver->phase(toCadicalLit(lit));
+  }
+}
+
+bool CadicalDPLLSatSolver::isDecision(SatVariable decn) const
+{
+  return d_propagator->value(SatLiteral(decn)) != SAT_VALUE_UNKNOWN
+         && d_solver->is_decision(decn);
+}
+
+void CadicalDPLLSatSolver::setDecisionHint(SatVariable var,
+                                           bool phase,
+                                           double activity)
+{
+  if (!d_propagator->inSearch())
+  {
+    SatLiteral lit(var, !phase);
+    d_solver->phase(toCadicalLit(lit));
+  }
+}
+
+CadicalDPLLSatSolver::Statistics::Statistics(StatisticsRegistry* registry)
+    : d_registry(registry),
+      d_numSatCalls("sat::cadical::calls_to_solve", 0),
+      d_numVariables("sat::cadical::variables", 0),
+      d_numClauses("sat::cadical::clauses", 0),
+      d_numLemmas("sat::cadical::lemmas", 0),
+      d_numTheoryPropagations("sat::cadical::theory_propagations", 0),
+      d_numExplanations("sat::cadical::explanations", 0),
+      d_solveTime("sat::cadical::solve_time")
+{
+  d_registry->registerStat(&d_numSatCalls);
+  d_registry->registerStat(&d_numVariables);
+  d_registry->registerStat(&d_numClauses);
+  d_registry->registerStat(&d_numLemmas);
+  d_registry->registerStat(&d_numTheoryPropagations);
+  d_registry->registerStat(&d_numExplanations);
+  d_registry->registerStat(&d_solveTime);
+}
+
+CadicalDPLLSatSolver::Statistics::~Statistics()
+{
+  d_registry->unregisterStat(&d_numSatCalls);
+  d_registry->unregisterStat(&d_numVariables);
+  d_registry->unregisterStat(&d_numClauses);
+  d_registry->unregisterStat(&d_numLemmas);
+  d_registry->unregisterStat(&d_numTheoryPropagations);
+  d_registry->unregisterStat(&d_numExplanations);
+  d_registry->unregisterStat(&d_solveTime);
+}
+
+}  // namespace prop
+}  // namespace CVC4
+
+#endif  // CVC4_USE_CADICAL_PROPAGATOR
@@ -0,0 +1,151 @@
+/*********************                                                        */
+/*! \file cadical_dpll.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief CaDiCaL as the SAT solver of the DPLL(T) search
+ **
+ ** The theories are connected to CaDiCaL through its external propagator
+ ** interface (IPASIR-UP, CaDiCaL 1.9 or later).  CaDiCaL notifies the
+ ** assignments of the variables, which are asserted to the theories as in
+ ** Minisat, and asks for theory propagations, their explanations, lemmas and
+ ** decisions through callbacks.  The user levels are implemented with one
+ ** activation literal per level: the clauses of a level are guarded by its
+ ** activation literal, which is assumed while the level is active and
+ ** asserted false when it is popped.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PROP__CADICAL_DPLL_H
+#define CVC4__PROP__CADICAL_DPLL_H
+
+#ifdef CVC4_USE_CADICAL_PROPAGATOR
+
+#include <memory>
+#include <vector>
+
+#include <cadical.hpp>
+
+#include "context/context.h"
+#include "prop/sat_solver.h"
+
+namespace CVC4 {
+namespace prop {
+
+class CadicalLearner;
+class CadicalPropagator;
+
+class CadicalDPLLSatSolver : public DPLLSatSolverInterface
+{
+ public:
+  CadicalDPLLSatSolver(StatisticsRegistry* registry);
+
+  ~CadicalDPLLSatSolver() override;
+
+  ClauseId addClause(SatClause& clause, bool removable) override;
+
+  ClauseId addXorClause(SatClause& clause, bool rhs, bool removable) override;
+
+  SatVariable newVar(bool isTheoryAtom = false,
+                     bool preRegister = false,
+                     bool canErase = true) override;
+
+  SatVariable trueVar() override;
+
+  SatVariable falseVar() override;
+
+  SatValue solve() override;
+  SatValue solve(long unsigned int&) override;
+  SatValue solve(const std::vector<SatLiteral>& assumptions) override;
+
+  void interrupt() override;
+
+  SatValue value(SatLiteral l) override;
+
+  SatValue modelValue(SatLiteral l) override;
+
+  unsigned getAssertionLevel() const override;
+
+  bool ok() const override;
+
+  void initialize(context::Context* context, TheoryProxy* theoryProxy) override;
+
+  void push() override;
+
+  void pop() override;
+
+  void resetTrail() override;
+
+  bool properExplanation(SatLiteral lit, SatLiteral expl) const override;
+
+  void requirePhase(SatLiteral lit) override;
+
+  bool isDecision(SatVariable decn) const override;
+
+  /** Sets the phase of var in CaDiCaL, its activity is ignored. */
+  void setDecisionHint(SatVariable var, bool phase, double activity) override;
+
+ private:
+  friend class CadicalPropagator;
+
+  /** Returns a new variable of CaDiCaL, observed by the propagator if
+   * observed is true. */
+  SatVariable newCadicalVar(bool isTheoryAtom, bool preRegister, bool observed);
+
+  /** Adds a clause, directly or through the propagator during the search. */
+  void addCadicalClause(std::vector<int>& clause);
+
+  /** Solves under the active user levels and the given assumptions. */
+  SatValue solveInternal(const std::vector<SatLiteral>& assumptions);
+
+  std::unique_ptr<CaDiCaL::Solver> d_solver;
+  std::unique_ptr<CadicalPropagator> d_propagator;
+  /** The exporter of the learned clauses, if they are shared */
+  std::unique_ptr<CadicalLearner> d_learner;
+
+  /** The SAT context, of which the user levels are the lowest levels */
+  context::Context* d_context;
+  /** The proxy to the theories, set by initialize() */
+  TheoryProxy* d_theoryProxy;
+
+  /** The next variable of CaDiCaL */
+  SatVariable d_nextVar;
+  SatVariable d_true;
+  SatVariable d_false;
+
+  /** The activation variable of each user level */
+  std::vector<int> d_activation;
+  /** The phases required during the search, passed on at the next solve */
+  std::vector<int> d_requiredPhases;
+  /** Are the clauses unsatisfiable in the lowest user level? */
+  bool d_inconsistent;
+
+  struct Statistics
+  {
+    StatisticsRegistry* d_registry;
+    IntStat d_numSatCalls;
+    IntStat d_numVariables;
+    IntStat d_numClauses;
+    IntStat d_numLemmas;
+    IntStat d_numTheoryPropagations;
+    IntStat d_numExplanations;
+    TimerStat d_solveTime;
+    Statistics(StatisticsRegistry* registry);
+    ~Statistics();
+  };
+
+  Statistics d_statistics;
+}; /* class CadicalDPLLSatSolver */
+
+}  // namespace prop
+}  // namespace CVC4
+
+#endif  // CVC4_USE_CADICAL_PROPAGATOR
+#endif  // CVC4__PROP__CADICAL_DPLL_H
@@ -0,0 +1,244 @@
+/*********************                                                        */
+/*! \file cnf_plan.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The Tseitin clauses of an assertion, over local literals
+ **/
+
+#include "prop/cnf_plan.h"
+
+#include "base/check.h"
+
+using namespace CVC4::kind;
+
+namespace CVC4 {
+namespace prop {
+
+CnfPlan::CnfPlan(TNode node) { addTop(node, false); }
+
+bool CnfPlan::isGateKind(Kind k)
+{
+  switch (k)
+  {
+    case NOT:
+    case XOR:
+    case ITE:
+    case IMPLIES:
+    case OR:
+    case AND:
+    case EQUAL: return true;
+    default: return false;
+  }
+}
+
+void CnfPlan::getGateClauses(Kind k,
+                             SatLiteral lit,
+                             const SatClause& children,
+                             std::vector<Clause>& clauses)
+{
+  switch (k)
+  {
+    case XOR:
+    {
+      SatLiteral a = children[0];
+      SatLiteral b = children[1];
+      clauses.push_back(Clause(false, {a, b, ~lit}));
+      clauses.push_back(Clause(false, {~a, ~b, ~lit}));
+      clauses.push_back(Clause(true, {a, ~b, lit}));
+      clauses.push_back(Clause(true, {~a, b, lit}));
+      break;
+    }
+    case OR:
+    {
+      // lit <- (a_1 | a_2 | a_3 | ... | a_n)
+      for (const SatLiteral& c : children)
+      {
+        clauses.push_back(Clause(true, {lit, ~c}));
+      }
+      // lit -> (a_1 | a_2 | a_3 | ... | a_n)
+      SatClause clause(children);
+      clause.push_back(~lit);
+      clauses.push_back(Clause(false, clause));
+      break;
+    }
+    case AND:
+    {
+      // lit -> (a_1 & a_2 & a_3 & ... & a_n)
+      for (const SatLiteral& c : children)
+      {
+        clauses.push_back(Clause(false, {~lit, c}));
+      }
+      // lit <- (a_1 & a_2 & a_3 & ... a_n)
+      SatClause clause;
+      for (const SatLiteral& c : children)
+      {
+        clause.push_back(~c);
+      }
+      clause.push_back(lit);
+      clauses.push_back(Clause(true, clause));
+      break;
+    }
+    case IMPLIES:
+    {
+      SatLiteral a = children[0];
+      SatLiteral b = children[1];
+      clauses.push_back(Clause(false, {~lit, ~a, b}));
+      clauses.push_back(Clause(true, {a, lit}));
+      clauses.push_back(Clause(true, {~b, lit}));
+      break;
+    }
+    case EQUAL:
+    {
+      SatLiteral a = children[0];
+      SatLiteral b = children[1];
+      clauses.push_back(Clause(false, {~a, b, ~lit}));
+      clauses.push_back(Clause(false, {a, ~b, ~lit}));
+      clauses.push_back(Clause(true, {~a, ~b, lit}));
+      clauses.push_back(Clause(true, {a, b, lit}));
+      break;
+    }
+    case ITE:
+    {
+      SatLiteral condLit = children[0];
+      SatLiteral thenLit = children[1];
+      SatLiteral elseLit = children[2];
+      // lit -> (!lit | t | e) & (!lit | !b | t) & (!lit | b | e)
+      clauses.push_back(Clause(false, {~lit, thenLit, elseLit}));
+      clauses.push_back(Clause(false, {~lit, ~condLit, thenLit}));
+      clauses.push_back(Clause(false, {~lit, condLit, elseLit}));
+      // !lit -> (lit | !t | !e) & (lit | !b | !t) & (lit | b | !e)
+      clauses.push_back(Clause(true, {lit, ~thenLit, ~elseLit}));
+      clauses.push_back(Clause(true, {lit, ~condLit, ~thenLit}));
+      clauses.push_back(Clause(true, {lit, condLit, ~elseLit}));
+      break;
+    }
+    default: Unreachable() << "not a gate: " << k;
+  }
+}
+
+uint32_t CnfPlan::getEntry(TNode node)
+{
+  std::unordered_map<TNode, uint32_t, TNodeHashFunction>::const_iterator it =
+      d_entryOf.find(node);
+  if (it != d_entryOf.end())
+  {
+    return it->second;
+  }
+  Entry entry;
+  entry.d_node = node;
+  Kind k = node.getKind();
+  if (isGateKind(k))
+  {
+    SatClause children;
+    for (TNode child : node)
+    {
+      uint32_t c = getEntry(child);
+      entry.d_children.push_back(c);
+      children.push_back(SatLiteral(c));
+    }
+    if (k != NOT)
+    {
+      getGateClauses(k, SatLiteral(d_entries.size()), children, entry.d_clauses);
+    }
+  }
+  uint32_t id = d_entries.size();
+  d_entries.push_back(entry);
+  d_entryOf[node] = id;
+  return id;
+}
+
+SatLiteral CnfPlan::getLiteral(TNode node, bool negated)
+{
+  return SatLiteral(getEntry(node), negated);
+}
+
+// This follows TseitinCnfStream::convertAndAssert(TNode, bool).
+void CnfPlan::addTop(TNode node, bool negated)
+{
+  TopItem item;
+  item.d_translateOnly = false;
+  item.d_equal = false;
+  item.d_entry = 0;
+  item.d_negated = false;
+  switch (node.getKind())
+  {
+    case AND:
+    case OR:
+      if ((node.getKind() == AND) != negated)
+      {
+        for (TNode child : node)
+        {
+          addTop(child, negated);
+        }
+      }
+      else
+      {
+        for (TNode child : node)
+        {
+          item.d_clause.push_back(getLiteral(child, negated));
+        }
+        d_topItems.push_back(item);
+      }
+      break;
+    case XOR:
+    {
+      SatLiteral p = getLiteral(node[0]);
+      SatLiteral q = getLiteral(node[1]);
+      item.d_clause = {~p, negated ? q : ~q};
+      d_topItems.push_back(item);
+      item.d_clause = {p, negated ? ~q : q};
+      d_topItems.push_back(item);
+      break;
+    }
+    case IMPLIES:
+      if (!negated)
+      {
+        SatLiteral p = getLiteral(node[0]);
+        SatLiteral q = getLiteral(node[1]);
+        item.d_clause = {~p, q};
+        d_topItems.push_back(item);
+      }
+      else
+      {
+        addTop(node[0], false);
+        addTop(node[1], true);
+      }
+      break;
+    case ITE:
+    {
+      SatLiteral p = getLiteral(node[0]);
+      SatLiteral q = getLiteral(node[1], negated);
+      SatLiteral r = getLiteral(node[2], negated);
+      item.d_clause = {p, q, r};
+      item.d_translateOnly = true;
+      d_topItems.push_back(item);
+      item.d_translateOnly = false;
+      item.d_clause = {~p, q};
+      d_topItems.push_back(item);
+      item.d_clause = {p, r};
+      d_topItems.push_back(item);
+      break;
+    }
+    case NOT: addTop(node[0], !negated); break;
+    case EQUAL:
+      item.d_equal = true;
+      item.d_entry = getEntry(node);
+      item.d_negated = negated;
+      d_topItems.push_back(item);
+      break;
+    default:
+      item.d_clause = {getLiteral(node, negated)};
+      d_topItems.push_back(item);
+      break;
+  }
+}
+
+}  // namespace prop
+}  // namespace CVC4
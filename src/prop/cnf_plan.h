@@ -0,0 +1,127 @@
+/*********************                                                        */
+/*! \file cnf_plan.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The Tseitin clauses of an assertion, over local literals
+ **
+ ** A CnfPlan is the Tseitin translation of one assertion in which the
+ ** literals are not yet SAT literals but indices into the plan: literal i
+ ** stands for the i-th Boolean subformula (entry) of the assertion.  Plans
+ ** are built concurrently by the TseitinCnfStream, one assertion per
+ ** thread, and then merged into the SAT solver in the order of the
+ ** assertions (see TseitinCnfStream::convertAndAssertBatch()).
+ **
+ ** Building a plan only reads the nodes through TNodes: it does not create
+ ** nodes, change reference counts or read attributes, so it is safe while
+ ** no other thread modifies the node manager.  The one decision that needs
+ ** the type of a node, whether an EQUAL is an equivalence or a theory atom,
+ ** is left to the merge.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PROP__CNF_PLAN_H
+#define CVC4__PROP__CNF_PLAN_H
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "expr/node.h"
+#include "prop/sat_solver_types.h"
+
+namespace CVC4 {
+namespace prop {
+
+class CnfPlan
+{
+ public:
+  /**
+   * A Tseitin clause, together with whether it is justified by the formula
+   * (true) or by its negation (false).
+   */
+  typedef std::pair<bool, SatClause> Clause;
+
+  /** A subformula of the assertion. */
+  struct Entry
+  {
+    /** The subformula */
+    TNode d_node;
+    /** The entries of its children, if it is a gate */
+    std::vector<uint32_t> d_children;
+    /**
+     * The clauses defining the literal of the entry in terms of the
+     * literals of the children, if it is a gate.
+     */
+    std::vector<Clause> d_clauses;
+  };
+
+  /**
+   * An item of the top-level translation.  It is either a clause, or an
+   * EQUAL whose translation depends on its type: on Booleans it is asserted
+   * as an equivalence, otherwise as a (possibly negated) atom.
+   */
+  struct TopItem
+  {
+    /** The clause, if d_equal is false */
+    SatClause d_clause;
+    /**
+     * Are the literals of d_clause only to be translated, and not asserted?
+     * This keeps the order of the serial translation of ITEs, which
+     * translates all three children before asserting the first clause.
+     */
+    bool d_translateOnly;
+    /** Is this an EQUAL to be decided by the merge? */
+    bool d_equal;
+    /** The entry of the EQUAL */
+    uint32_t d_entry;
+    /** Is the EQUAL asserted negated? */
+    bool d_negated;
+  };
+
+  /** Builds the plan of asserting node. */
+  explicit CnfPlan(TNode node);
+
+  const std::vector<Entry>& getEntries() const { return d_entries; }
+  const std::vector<TopItem>& getTopItems() const { return d_topItems; }
+
+  /** Returns true if entries of kind k are translated as gates. */
+  static bool isGateKind(Kind k);
+
+  /**
+   * Computes the Tseitin clauses defining lit as the gate of kind k over
+   * the literals children, in the order in which TseitinCnfStream asserts
+   * them. Kind k must not be NOT, which has no literal of its own.
+   */
+  static void getGateClauses(Kind k,
+                             SatLiteral lit,
+                             const SatClause& children,
+                             std::vector<Clause>& clauses);
+
+ private:
+  /** Returns the entry of node, adding the entries of its subformulas. */
+  uint32_t getEntry(TNode node);
+  /** Returns the literal of node, negated if negated is true. */
+  SatLiteral getLiteral(TNode node, bool negated = false);
+  /** Adds the top-level translation of node, negated if negated is true. */
+  void addTop(TNode node, bool negated);
+
+  /** The entries, children before parents */
+  std::vector<Entry> d_entries;
+  /** The entry of each node of d_entries */
+  std::unordered_map<TNode, uint32_t, TNodeHashFunction> d_entryOf;
+  /** The top-level translation */
+  std::vector<TopItem> d_topItems;
+}; /* class CnfPlan */
+
+}  // namespace prop
+}  // namespace CVC4
+
+#endif /* CVC4__PROP__CNF_PLAN_H */
@@ -17,7 +17,11 @@
  **/
 #include "prop/cnf_stream.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <queue>
+#include <thread>
 
 #include "base/check.h"
 #include "base/output.h"
@@ -97,6 +101,19 @@ void CnfStream::assertClause(TNode node, SatClause& c) {
   };
 }
 
+bool CnfStream::useNativeXor() const
+{
+  return options::bvSatXor() && d_satSolver->nativeXor();
+}
+
+void CnfStream::assertXorClause(TNode node, SatClause& c, bool rhs)
+{
+  Debug("cnf") << "Inserting xor into stream " << c << " = " << rhs
+               << " node = " << node << endl;
+  Assert(!(PROOF_ON() && d_cnfProof)) << "XOR clauses do not support proofs";
+  d_satSolver->addXorClause(c, rhs, d_removable);
+}
+
 void CnfStream::assertClause(TNode node, SatLiteral a) {
   SatClause clause(1);
   clause[0] = a;
@@ -289,6 +306,18 @@ SatLiteral TseitinCnfStream::handleXor(TNode xorNode) {
   Assert(xorNode.getNumChildren() == 2) << "Expecting exactly 2 children!";
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
 
+  if (useNativeXor())
+  {
+    // xorLit = a ^ b ^ ... is xorLit ^ a ^ b ^ ... = false
+    SatClause clause;
+    bool rhs = false;
+    collectXorLiterals(xorNode, clause, rhs);
+    SatLiteral xorLit = newLiteral(xorNode);
+    clause.push_back(xorLit);
+    assertXorClause(xorNode, clause, rhs);
+    return xorLit;
+  }
+
   SatLiteral a = toCNF(xorNode[0]);
   SatLiteral b = toCNF(xorNode[1]);
 
@@ -302,6 +331,28 @@ SatLiteral TseitinCnfStream::handleXor(TNode xorNode) {
   return xorLit;
 }
 
+void TseitinCnfStream::collectXorLiterals(TNode node,
+                                          SatClause& literals,
+                                          bool& rhs)
+{
+  for (TNode child : node)
+  {
+    if (child.getKind() == NOT && child[0].getKind() == XOR)
+    {
+      rhs = !rhs;
+      child = child[0];
+    }
+    if (child.getKind() == XOR && !hasLiteral(child))
+    {
+      collectXorLiterals(child, literals, rhs);
+    }
+    else
+    {
+      literals.push_back(toCNF(child));
+    }
+  }
+}
+
 SatLiteral TseitinCnfStream::handleOr(TNode orNode) {
   Assert(!hasLiteral(orNode)) << "Atom already mapped!";
   Assert(orNode.getKind() == OR) << "Expecting an OR expression!";
@@ -417,6 +468,17 @@ SatLiteral TseitinCnfStream::handleIff(TNode iffNode) {
   // Get the now literal
   SatLiteral iffLit = newLiteral(iffNode);
 
+  if (useNativeXor())
+  {
+    // iffLit = (a <-> b) is iffLit ^ a ^ b = true
+    SatClause clause(3);
+    clause[0] = a;
+    clause[1] = b;
+    clause[2] = iffLit;
+    assertXorClause(iffNode, clause, true);
+    return iffLit;
+  }
+
   // lit -> ((a-> b) & (b->a))
   // ~lit | ((~a | b) & (~b | a))
   // (~a | b | ~lit) & (~b | a | ~lit)
@@ -486,12 +548,13 @@ SatLiteral TseitinCnfStream::toCNF(TNode node, bool negated) {
   Debug("cnf") << "toCNF(" << node << ", negated = " << (negated ? "true" : "false") << ")" << endl;
 
   SatLiteral nodeLit;
-  Node negatedNode = node.notNode();
 
   // If the non-negated node has already been translated, get the translation
-  if(hasLiteral(node)) {
+  NodeToLiteralMap::const_iterator it = d_nodeToLiteralMap.find(node);
+  if (it != d_nodeToLiteralMap.end())
+  {
     Debug("cnf") << "toCNF(): already translated" << endl;
-    nodeLit = getLiteral(node);
+    nodeLit = (*it).second;
   } else {
     // Handle each Boolean operator case
     switch(node.getKind()) {
@@ -537,6 +600,116 @@ SatLiteral TseitinCnfStream::toCNF(TNode node, bool negated) {
   else return ~nodeLit;
 }
 
+SatLiteral TseitinCnfStream::toCNF(const CnfPlan& plan,
+                                   SatLiteral lit,
+                                   std::vector<SatLiteral>& literals)
+{
+  SatVariable index = lit.getSatVariable();
+  if (literals[index].isNull())
+  {
+    const CnfPlan::Entry& entry = plan.getEntries()[index];
+    TNode node = entry.d_node;
+    NodeToLiteralMap::const_iterator it = d_nodeToLiteralMap.find(node);
+    if (it != d_nodeToLiteralMap.end())
+    {
+      literals[index] = (*it).second;
+    }
+    else if (node.getKind() == NOT)
+    {
+      literals[index] = ~toCNF(plan, SatLiteral(entry.d_children[0]), literals);
+    }
+    else if (entry.d_children.empty()
+             || (node.getKind() == EQUAL && !node[0].getType().isBoolean()))
+    {
+      literals[index] = convertAtom(node);
+    }
+    else
+    {
+      // as in the handleX() methods, children first, then the gate
+      for (uint32_t child : entry.d_children)
+      {
+        toCNF(plan, SatLiteral(child), literals);
+      }
+      literals[index] = newLiteral(node);
+      for (const CnfPlan::Clause& planClause : entry.d_clauses)
+      {
+        SatClause clause;
+        for (const SatLiteral& l : planClause.second)
+        {
+          SatLiteral satLit = literals[l.getSatVariable()];
+          clause.push_back(l.isNegated() ? ~satLit : satLit);
+        }
+        // the justifying node is only needed by proofs, which do not use
+        // plans, so we avoid constructing the negation of node
+        assertClause(node, clause);
+      }
+    }
+  }
+  return lit.isNegated() ? ~literals[index] : literals[index];
+}
+
+void TseitinCnfStream::assertPlan(TNode node, const CnfPlan& plan)
+{
+  Debug("cnf") << "assertPlan(" << node << ")" << endl;
+  std::vector<SatLiteral> literals(plan.getEntries().size());
+  for (const CnfPlan::TopItem& item : plan.getTopItems())
+  {
+    if (item.d_translateOnly)
+    {
+      for (const SatLiteral& l : item.d_clause)
+      {
+        toCNF(plan, l, literals);
+      }
+      continue;
+    }
+
+    if (d_convertAndAssertCounter % ResourceManager::getFrequencyCount() == 0)
+    {
+      NodeManager::currentResourceManager()->spendResource(
+          ResourceManager::Resource::CnfStep);
+      d_convertAndAssertCounter = 0;
+    }
+    ++d_convertAndAssertCounter;
+
+    if (!item.d_equal)
+    {
+      SatClause clause;
+      for (const SatLiteral& l : item.d_clause)
+      {
+        clause.push_back(toCNF(plan, l, literals));
+      }
+      assertClause(node, clause);
+      continue;
+    }
+
+    // an EQUAL, which is an equivalence if its children are Boolean
+    const CnfPlan::Entry& entry = plan.getEntries()[item.d_entry];
+    TNode eq = entry.d_node;
+    if (eq[0].getType().isBoolean())
+    {
+      SatLiteral p = toCNF(plan, SatLiteral(entry.d_children[0]), literals);
+      SatLiteral q = toCNF(plan, SatLiteral(entry.d_children[1]), literals);
+      if (!item.d_negated)
+      {
+        // p <=> q
+        assertClause(eq, ~p, q);
+        assertClause(eq, p, ~q);
+      }
+      else
+      {
+        // !(p <=> q) is the same as p XOR q
+        assertClause(eq, ~p, ~q);
+        assertClause(eq, p, q);
+      }
+    }
+    else
+    {
+      assertClause(
+          eq, toCNF(plan, SatLiteral(item.d_entry, item.d_negated), literals));
+    }
+  }
+}
+
 void TseitinCnfStream::convertAndAssertAnd(TNode node, bool negated) {
   Assert(node.getKind() == AND);
   if (!negated) {
@@ -584,6 +757,14 @@ void TseitinCnfStream::convertAndAssertOr(TNode node, bool negated) {
 }
 
 void TseitinCnfStream::convertAndAssertXor(TNode node, bool negated) {
+  if (useNativeXor())
+  {
+    SatClause clause;
+    bool rhs = !negated;
+    collectXorLiterals(node, clause, rhs);
+    assertXorClause(negated ? node.negate() : Node(node), clause, rhs);
+    return;
+  }
   if (!negated) {
     // p XOR q
     SatLiteral p = toCNF(node[0], false);
@@ -717,6 +898,62 @@ void TseitinCnfStream::convertAndAssert(TNode node,
     });
 }
 
+void CnfStream::convertAndAssertBatch(const std::vector<Node>& nodes,
+                                      bool removable,
+                                      ProofRule proof_id,
+                                      unsigned threads)
+{
+  for (const Node& node : nodes)
+  {
+    convertAndAssert(node, removable, false, proof_id);
+  }
+}
+
+void TseitinCnfStream::convertAndAssertBatch(const std::vector<Node>& nodes,
+                                             bool removable,
+                                             ProofRule proof_id,
+                                             unsigned threads)
+{
+  size_t n = std::min<size_t>(threads, nodes.size());
+  if (n <= 1 || (PROOF_ON() && d_cnfProof) || useNativeXor())
+  {
+    CnfStream::convertAndAssertBatch(nodes, removable, proof_id, threads);
+    return;
+  }
+  Debug("cnf") << "convertAndAssertBatch(" << nodes.size()
+               << " nodes, threads = " << n << ")" << endl;
+
+  // Build the plans.  The workers only read the nodes, which nobody
+  // modifies until they are joined: the merge below creates nodes and
+  // literals, so it has to wait for all plans to be built.
+  std::vector<std::unique_ptr<CnfPlan>> plans(nodes.size());
+  std::atomic<size_t> next(0);
+  auto work = [&nodes, &plans, &next]() {
+    for (size_t i = next++; i < nodes.size(); i = next++)
+    {
+      plans[i].reset(new CnfPlan(nodes[i]));
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < n; ++i)
+  {
+    workers.emplace_back(work);
+  }
+  work();
+  for (std::thread& worker : workers)
+  {
+    worker.join();
+  }
+
+  // Merge them in order
+  d_removable = removable;
+  for (size_t i = 0, size = nodes.size(); i < size; ++i)
+  {
+    assertPlan(nodes[i], *plans[i]);
+    plans[i].reset();
+  }
+}
+
 void TseitinCnfStream::convertAndAssert(TNode node, bool negated) {
   Debug("cnf") << "convertAndAssert(" << node
                << ", negated = " << (negated ? "true" : "false") << ")" << endl;
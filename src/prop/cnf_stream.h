@@ -29,6 +29,7 @@
 #include "context/cdlist.h"
 #include "expr/node.h"
 #include "proof/proof_manager.h"
+#include "prop/cnf_plan.h"
 #include "prop/registrar.h"
 #include "prop/theory_proxy.h"
 
@@ -134,6 +135,21 @@ class CnfStream {
    */
   void assertClause(TNode node, SatLiteral a, SatLiteral b, SatLiteral c);
 
+  /**
+   * Returns true if XOR gates are asserted as native XOR clauses, see
+   * --bv-sat-xor.
+   */
+  bool useNativeXor() const;
+
+  /**
+   * Asserts the XOR clause to the sat solver, i.e., that the exclusive or of
+   * the literals of clause is rhs.
+   * @param node the node giving rise to this clause
+   * @param clause the literals of the clause
+   * @param rhs the value of the exclusive or
+   */
+  void assertXorClause(TNode node, SatClause& clause, bool rhs);
+
   /**
    * Acquires a new variable from the SAT solver to represent the node
    * and inserts the necessary data it into the mapping tables.
@@ -191,6 +207,20 @@ class CnfStream {
                                 ProofRule proof_id,
                                 TNode from = TNode::null()) = 0;
 
+  /**
+   * Converts and asserts a sequence of formulas, in order, as if by calling
+   * convertAndAssert(node, removable, false, proof_id) on each of them.
+   * Subclasses may use up to the given number of threads for the
+   * translation; this implementation converts them one by one.
+   * @param nodes the nodes to convert and assert
+   * @param removable whether the sat solver can choose to remove the clauses
+   * @param threads the maximal number of threads
+   */
+  virtual void convertAndAssertBatch(const std::vector<Node>& nodes,
+                                     bool removable,
+                                     ProofRule proof_id,
+                                     unsigned threads);
+
   /**
    * Get the node that is represented by the given SatLiteral.
    * @param literal the literal from the sat solver
@@ -272,12 +302,30 @@ class TseitinCnfStream : public CnfStream {
                         ProofRule rule,
                         TNode from = TNode::null()) override;
 
+  /**
+   * Convert the given formulas to CNF and assert them to the SAT solver.
+   *
+   * The traversal of the formulas and the construction of their Tseitin
+   * clauses is split among up to threads threads, each building the
+   * CnfPlan of a slice of the formulas.  The plans are then merged in the
+   * order of the formulas, which creates the SAT variables and asserts the
+   * clauses in exactly the order of the serial conversion.  Proofs need the
+   * serial conversion, which is used when they are enabled.
+   */
+  void convertAndAssertBatch(const std::vector<Node>& nodes,
+                             bool removable,
+                             ProofRule proof_id,
+                             unsigned threads) override;
+
  private:
   /**
    * Same as above, except that removable is remembered.
    */
   void convertAndAssert(TNode node, bool negated);
 
+  /** Asserts the clauses of plan, as convertAndAssert(node, false) would. */
+  void assertPlan(TNode node, const CnfPlan& plan);
+
   // Each of these formulas handles takes care of a Node of each Kind.
   //
   // Each handleX(Node &n) is responsible for:
@@ -296,6 +344,13 @@ class TseitinCnfStream : public CnfStream {
   SatLiteral handleAnd(TNode node);
   SatLiteral handleOr(TNode node);
 
+  /**
+   * Collects the literals the exclusive or of which is node, flattening the
+   * XOR children that are not translated yet.  Negations are pushed into
+   * rhs.
+   */
+  void collectXorLiterals(TNode node, SatClause& literals, bool& rhs);
+
   void convertAndAssertAnd(TNode node, bool negated);
   void convertAndAssertOr(TNode node, bool negated);
   void convertAndAssertXor(TNode node, bool negated);
@@ -311,6 +366,18 @@ class TseitinCnfStream : public CnfStream {
    */
   SatLiteral toCNF(TNode node, bool negated = false);
 
+  /**
+   * Returns the SAT literal of the literal lit of plan, translating its
+   * entry as toCNF() would if it has not been translated yet.
+   * @param plan the plan of lit
+   * @param lit a literal of plan
+   * @param literals the SAT literal of each translated entry of plan
+   * @return the SAT literal of lit
+   */
+  SatLiteral toCNF(const CnfPlan& plan,
+                   SatLiteral lit,
+                   std::vector<SatLiteral>& literals);
+
   void ensureLiteral(TNode n, bool noPreregistration = false) override;
 
 }; /* class TseitinCnfStream */
@@ -19,6 +19,7 @@
 #include "prop/cryptominisat.h"
 
 #include "base/check.h"
+#include "options/bv_options.h"
 #include "proof/clause_id.h"
 #include "proof/sat_proof.h"
 
@@ -69,6 +70,10 @@ CryptoMinisatSolver::CryptoMinisatSolver(StatisticsRegistry* registry,
       d_okay(true),
       d_statistics(registry, name)
 {
+  if (options::bvSatGauss())
+  {
+    d_solver->set_allow_otf_gauss();
+  }
   d_true = newVar();
   d_false = newVar();
 
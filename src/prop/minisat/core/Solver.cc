@@ -22,7 +22,9 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include <math.h>
 
+#include <algorithm>
 #include <iostream>
+#include <map>
 #include <unordered_set>
 
 #include "base/output.h"
@@ -60,6 +62,12 @@ bool assertionLevelOnly()
 //=================================================================================================
 // Helper functions for decision tree tracing
 
+// The tags of decision tree tracing, which are checked in the search and
+// propagation loops
+TraceTag s_dtviewTag("dtview");
+TraceTag s_dtviewPropTag("dtview::prop");
+TraceTag s_dtviewConflictTag("dtview::conflict");
+
 // Writes to Trace macro for decision tree tracing
 static inline void dtviewDecisionHelper(size_t level,
                                         const Node& node,
@@ -180,7 +188,24 @@ Solver::Solver(CVC4::prop::TheoryProxy* proxy,
       //
       ,
       learntsize_adjust_start_confl(100),
-      learntsize_adjust_inc(1.5)
+      learntsize_adjust_inc(1.5),
+      use_inprocessing(options::satInprocess() && !PROOF_ON()),
+      inprocess_interval(options::satInprocessInterval()),
+      inprocess_effort(options::satInprocessEffort()),
+      use_lbd_tiers(options::satLbdReduce()),
+      lbd_core(2),
+      lbd_tier2(6),
+      glucose_restart(options::satRestartMode()
+                      == options::SatRestartMode::GLUCOSE),
+      restart_fast_alpha(1.0 / 32),
+      restart_slow_alpha(1.0 / 16384),
+      restart_margin(1.25),
+      restart_min_confl(50),
+      chrono_backtrack(options::satChronoBacktrack()),
+      track_lemma_use(options::satLemmaUseStats()),
+      share_max_size(options::satShareLength()),
+      share_max_lbd(options::satShareLbd()),
+      lemma_source(0)
 
       // Statistics: (formerly in 'SolverStats')
       //
@@ -196,19 +221,35 @@ Solver::Solver(CVC4::prop::TheoryProxy* proxy,
       clauses_literals(0),
       learnts_literals(0),
       max_literals(0),
-      tot_literals(0)
+      tot_literals(0),
+      inprocess_rounds(0),
+      inprocess_subsumed(0),
+      inprocess_strengthened(0),
+      inprocess_vivified(0),
+      chrono_backtracks(0),
+      pb_propagations(0),
+      pb_conflicts(0),
+      arena_bytes(0)
 
       ,
       ok(true),
       cla_inc(1),
       var_inc(1),
       watches(WatcherDeleted(ca)),
+      bin_watches(WatcherDeleted(ca)),
       qhead(0),
       simpDB_assigns(-1),
       simpDB_props(0),
+      next_inprocess(inprocess_interval),
       order_heap(VarOrderLt(activity)),
       progress_estimate(0),
-      remove_satisfied(!enable_incremental)
+      remove_satisfied(!enable_incremental),
+      pb_qhead(0),
+      lbd_stamp(0),
+      lbd_fast(0),
+      lbd_slow(0),
+      lbd_count(0),
+      learnts_core(0)
 
       // Resource constraints:
       //
@@ -219,6 +260,10 @@ Solver::Solver(CVC4::prop::TheoryProxy* proxy,
 {
   PROOF(ProofManager::currentPM()->initSatProof(this);)
 
+  std::fill(lemma_clauses, lemma_clauses + Clause::source_max, 0);
+  std::fill(lemma_propagations, lemma_propagations + Clause::source_max, 0);
+  std::fill(lemma_conflicts, lemma_conflicts + Clause::source_max, 0);
+
   // Create the constant variables
   varTrue = newVar(true, false, false);
   varFalse = newVar(false, false, false);
@@ -253,6 +298,8 @@ Var Solver::newVar(bool sign, bool dvar, bool isTheoryAtom, bool preRegister, bo
 
     watches  .init(mkLit(v, false));
     watches  .init(mkLit(v, true ));
+    bin_watches.init(mkLit(v, false));
+    bin_watches.init(mkLit(v, true ));
     assigns  .push(l_Undef);
     vardata  .push(VarData(CRef_Undef, -1, -1, assertionLevel, -1));
     activity .push(rnd_init_act ? drand(random_seed) * 0.00001 : 0);
@@ -283,6 +330,7 @@ void Solver::resizeVars(int newSize) {
 
     // Resize watches up to the negated last literal
     watches.resizeTo(mkLit(newSize-1, true));
+    bin_watches.resizeTo(mkLit(newSize-1, true));
 
     // Resize all info arrays
     assigns.shrink(shrinkSize);
@@ -306,21 +354,46 @@ CRef Solver::reason(Var x) {
   Debug("pf::sat") << "Solver::reason(" << x << ")" << std::endl;
 
   // If we already have a reason, just return it
-  if (vardata[x].d_reason != CRef_Lazy) return vardata[x].d_reason;
+  CRef r = vardata[x].d_reason;
+  if (r != CRef_Lazy)
+  {
+    // Binary clauses propagate without being inspected, so their implied
+    // literal is put first here (see propagateBool()). A relocated clause
+    // stores its new reference in place of its literals.
+    if (r != CRef_Undef)
+    {
+      Clause& c = ca[r];
+      if (c.size() == 2 && !c.reloced() && var(c[0]) != x)
+      {
+        Lit tmp = c[0];
+        c[0] = c[1];
+        c[1] = tmp;
+      }
+    }
+    return r;
+  }
 
   // What's the literal we are trying to explain
   Lit l = mkLit(x, value(x) != l_True);
 
-  // Get the explanation from the theory
-  SatClause explanation_cl;
-  // FIXME: at some point return a tag with the theory that spawned you
-  d_proxy->explainPropagation(MinisatSatSolver::toSatLiteral(l),
-                              explanation_cl);
   vec<Lit> explanation;
-  MinisatSatSolver::toMinisatClause(explanation_cl, explanation);
-
-  Debug("pf::sat") << "Solver::reason: explanation_cl = " << explanation_cl
-                   << std::endl;
+  if (x < (int)pb_reason.size() && pb_reason[x] >= 0)
+  {
+    // Get the explanation from the pseudo-Boolean constraint
+    explainPb(pb_reason[x], l, explanation);
+  }
+  else
+  {
+    // Get the explanation from the theory
+    SatClause explanation_cl;
+    // FIXME: at some point return a tag with the theory that spawned you
+    d_proxy->explainPropagation(MinisatSatSolver::toSatLiteral(l),
+                                explanation_cl);
+    MinisatSatSolver::toMinisatClause(explanation_cl, explanation);
+
+    Debug("pf::sat") << "Solver::reason: explanation_cl = " << explanation_cl
+                     << std::endl;
+  }
 
   // Sort the literals by trail index level
   lemma_lt lt(*this);
@@ -387,6 +460,7 @@ CRef Solver::reason(Var x) {
 
     // Construct the reason
     CRef real_reason = ca.alloc(explLevel, explanation, true);
+    ca[real_reason].setLbd(computeLbd(explanation));
     // FIXME: at some point will need more information about where this explanation
     // came from (ie. the theory/sharing)
     Debug("pf::sat") << "Minisat::Solver registering a THEORY_LEMMA (1)" << std::endl;
@@ -467,6 +541,7 @@ bool Solver::addClause_(vec<Lit>& ps, bool removable, ClauseId& id)
       lemmas.push();
       ps.copyTo(lemmas.last());
       lemmas_removable.push(removable);
+      lemmas_source.push(lemma_source);
       PROOF(
             // Store the expression being converted to CNF until
             // the clause is actually created
@@ -508,6 +583,8 @@ bool Solver::addClause_(vec<Lit>& ps, bool removable, ClauseId& id)
         sort(ps, lt);
 
         cr = ca.alloc(clauseLevel, ps, false);
+        ca[cr].setSource(lemma_source);
+        lemma_clauses[lemma_source]++;
         clauses_persistent.push(cr);
 	attachClause(cr);
 
@@ -566,8 +643,9 @@ void Solver::attachClause(CRef cr) {
     const Clause& c = ca[cr];
     Debug("minisat") << "Solver::attachClause(" << c << "): level " << c.level() << std::endl;
     Assert(c.size() > 1);
-    watches[~c[0]].push(Watcher(cr, c[1]));
-    watches[~c[1]].push(Watcher(cr, c[0]));
+    OccLists<Lit, vec<Watcher>, WatcherDeleted>& ws = c.size() == 2 ? bin_watches : watches;
+    ws[~c[0]].push(Watcher(cr, c[1]));
+    ws[~c[1]].push(Watcher(cr, c[0]));
     if (c.removable()) learnts_literals += c.size();
     else            clauses_literals += c.size();
 }
@@ -578,14 +656,15 @@ void Solver::detachClause(CRef cr, bool strict) {
     PROOF( ProofManager::getSatProof()->markDeleted(cr); );
     Debug("minisat") << "Solver::detachClause(" << c << ")" << std::endl;
     assert(c.size() > 1);
+    OccLists<Lit, vec<Watcher>, WatcherDeleted>& ws = c.size() == 2 ? bin_watches : watches;
 
     if (strict){
-        remove(watches[~c[0]], Watcher(cr, c[1]));
-        remove(watches[~c[1]], Watcher(cr, c[0]));
+        remove(ws[~c[0]], Watcher(cr, c[1]));
+        remove(ws[~c[1]], Watcher(cr, c[0]));
     }else{
         // Lazy detaching: (NOTE! Must clean all watcher lists before garbage collecting this clause)
-        watches.smudge(~c[0]);
-        watches.smudge(~c[1]);
+        ws.smudge(~c[0]);
+        ws.smudge(~c[1]);
     }
 
     if (c.removable()) learnts_literals -= c.size();
@@ -597,12 +676,95 @@ void Solver::removeClause(CRef cr) {
     Debug("minisat::remove-clause") << "Solver::removeClause(" << c << ")" << std::endl;
     detachClause(cr);
     // Don't leave pointers to free'd memory!
-    if (locked(c)) vardata[var(c[0])].d_reason = CRef_Undef;
+    Var v = lockedVar(c);
+    if (v != var_Undef) vardata[v].d_reason = CRef_Undef;
     c.mark(1);
     ca.free(cr);
 }
 
 
+bool Solver::addPbConstraint(const vec<Lit>& ps, const vec<int64_t>& coeffs, int64_t bound)
+{
+    if (!ok) return false;
+    assert(decisionLevel() == 0);
+    assert(ps.size() == coeffs.size());
+
+    // Merge the terms of each variable, on the way removing the variables fixed at level 0. The
+    // terms are then made positive, using 'a * ~x = a - a * x':
+    std::map<Var, int64_t> var_coeffs;
+    for (int i = 0; i < ps.size(); i++){
+        Var x = var(ps[i]);
+        if (sign(ps[i])){
+            bound -= coeffs[i];
+            var_coeffs[x] -= coeffs[i];
+        }else
+            var_coeffs[x] += coeffs[i];
+    }
+    std::vector<std::pair<int64_t, Lit> > terms;
+    int64_t total = 0;
+    for (std::map<Var, int64_t>::const_iterator it = var_coeffs.begin(); it != var_coeffs.end(); ++it){
+        Var     x = it->first;
+        int64_t a = it->second;
+        if (a == 0) continue;
+        if (value(x) != l_Undef && level(x) == 0 && user_level(x) == 0){
+            if (value(x) == l_True) bound -= a;
+            continue;
+        }
+        if (a > 0)
+            terms.push_back(std::make_pair(a, mkLit(x, false)));
+        else{
+            bound -= a;
+            terms.push_back(std::make_pair(-a, mkLit(x, true)));
+        }
+    }
+
+    // Trivially satisfied
+    if (bound <= 0) return true;
+
+    // Saturate the coefficients, which cannot be worth more than the bound
+    int64_t min_coeff = bound;
+    for (size_t i = 0; i < terms.size(); i++){
+        terms[i].first = std::min(terms[i].first, bound);
+        min_coeff      = std::min(min_coeff, terms[i].first);
+        total         += terms[i].first;
+    }
+    if (total < bound) return ok = false;
+
+    // If any literal satisfies the constraint, it is a clause
+    if (min_coeff == bound){
+        vec<Lit> clause;
+        for (size_t i = 0; i < terms.size(); i++)
+            clause.push(terms[i].second);
+        ClauseId id = ClauseIdUndef;
+        return addClause_(clause, false, id);
+    }
+
+    // Sort by decreasing coefficients, so that the propagating literals come first
+    std::sort(terms.begin(), terms.end(),
+              [](const std::pair<int64_t, Lit>& a, const std::pair<int64_t, Lit>& b) { return a.first > b.first; });
+
+    int index = pb_constraints.size();
+    pb_constraints.push_back(PbConstraint());
+    PbConstraint& c = pb_constraints.back();
+    c.slack = total - bound;
+    if (pb_occurs.size() < (size_t)2 * nVars()) pb_occurs.resize(2 * nVars());
+    if (pb_reason.size() < (size_t)nVars()) pb_reason.resize(nVars(), -1);
+    for (size_t i = 0; i < terms.size(); i++){
+        c.lits.push_back(terms[i].second);
+        c.coeffs.push_back(terms[i].first);
+        pb_occurs[toInt(terms[i].second)].push_back(std::make_pair(index, terms[i].first));
+    }
+
+    // Propagate at level 0
+    for (size_t i = 0; i < c.lits.size() && c.coeffs[i] > c.slack; i++){
+        uncheckedEnqueue(c.lits[i]);
+        pb_propagations++;
+    }
+
+    return true;
+}
+
+
 bool Solver::satisfied(const Clause& c) const {
     for (int i = 0; i < c.size(); i++)
         if (value(c[i]) == l_True)
@@ -623,10 +785,21 @@ void Solver::cancelUntil(int level) {
             d_proxy->dumpStatePop();
           }
         }
+        // Give back the literals that become unassigned to the slacks of the pseudo-Boolean
+        // constraints they were removed from
+        for (int c = std::min(pb_qhead, trail.size())-1; c >= trail_lim[level]; c--){
+            Lit p = trail[c];
+            if (toInt(~p) >= (int)pb_occurs.size()) continue;
+            const std::vector<std::pair<int, int64_t> >& occs = pb_occurs[toInt(~p)];
+            for (size_t k = 0; k < occs.size(); k++)
+                pb_constraints[occs[k].first].slack += occs[k].second;
+        }
+        pb_qhead = std::min(pb_qhead, trail_lim[level]);
         for (int c = trail.size()-1; c >= trail_lim[level]; c--){
             Var      x  = var(trail[c]);
             assigns [x] = l_Undef;
             vardata[x].d_trail_index = -1;
+            if (x < (int)pb_reason.size()) pb_reason[x] = -1;
             if ((phase_saving > 1 ||
                  ((phase_saving == 1) && c > trail_lim.last())
                  ) && ((polarity[x] & 0x2) == 0)) {
@@ -682,7 +855,7 @@ Lit Solver::pickBranchLit()
         decisions++;
 
         // org-mode tracing -- theory decision
-        if (Trace.isOn("dtview"))
+        if (Trace.isOn(s_dtviewTag))
         {
           dtviewDecisionHelper(
               d_context->getLevel(),
@@ -690,7 +863,7 @@ Lit Solver::pickBranchLit()
               "THEORY");
         }
 
-        if (Trace.isOn("dtview::prop"))
+        if (Trace.isOn(s_dtviewPropTag))
         {
           dtviewPropagationHeaderHelper(d_context->getLevel());
         }
@@ -712,7 +885,9 @@ Lit Solver::pickBranchLit()
     bool stopSearch = false;
     nextLit = MinisatSatSolver::toMinisatLit(
         d_proxy->getNextDecisionEngineRequest(stopSearch));
-    if(stopSearch) {
+    // The decision engine does not know the pseudo-Boolean constraints, which may not be
+    // satisfied when it stops
+    if(stopSearch && pb_constraints.empty()) {
       return lit_Undef;
     }
     if(nextLit != lit_Undef) {
@@ -725,7 +900,7 @@ Lit Solver::pickBranchLit()
       }
 
       // org-mode tracing -- decision engine decision
-      if (Trace.isOn("dtview"))
+      if (Trace.isOn(s_dtviewTag))
       {
         dtviewDecisionHelper(
             d_context->getLevel(),
@@ -733,7 +908,7 @@ Lit Solver::pickBranchLit()
             "DE");
       }
 
-      if (Trace.isOn("dtview::prop"))
+      if (Trace.isOn(s_dtviewPropTag))
       {
         dtviewPropagationHeaderHelper(d_context->getLevel());
       }
@@ -787,7 +962,7 @@ Lit Solver::pickBranchLit()
       }
 
       // org-mode tracing -- decision engine decision
-      if (Trace.isOn("dtview"))
+      if (Trace.isOn(s_dtviewTag))
       {
         dtviewDecisionHelper(
             d_context->getLevel(),
@@ -795,7 +970,7 @@ Lit Solver::pickBranchLit()
             "DE");
       }
 
-      if (Trace.isOn("dtview::prop"))
+      if (Trace.isOn(s_dtviewPropTag))
       {
         dtviewPropagationHeaderHelper(d_context->getLevel());
       }
@@ -847,7 +1022,12 @@ int Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
           Clause& c = ca[confl];
           max_resolution_level = std::max(max_resolution_level, c.level());
 
-          if (c.removable()) claBumpActivity(c);
+          if (c.removable())
+          {
+            claBumpActivity(c);
+            if (use_lbd_tiers) updateLbd(c);
+          }
+          if (track_lemma_use) lemma_conflicts[c.source()]++;
         }
 
         for (int j = (p == lit_Undef) ? 0 : 1, size = ca[confl].size();
@@ -1120,7 +1300,7 @@ CRef Solver::propagate(TheoryCheckType type)
             }
         } else {
           // if dumping decision tree, print the conflict
-          if (Trace.isOn("dtview::conflict"))
+          if (Trace.isOn(s_dtviewConflictTag))
           {
             if (confl != CRef_Undef)
             {
@@ -1215,19 +1395,48 @@ CRef Solver::propagateBool()
     CRef    confl     = CRef_Undef;
     int     num_props = 0;
     watches.cleanAll();
+    bin_watches.cleanAll();
+
+    for (;;){
+        // The pseudo-Boolean constraints are propagated once the clauses are
+        if (qhead == trail.size()){
+            if (pb_qhead == trail.size() || pb_constraints.empty())
+                break;
+            confl = propagatePb();
+            if (confl != CRef_Undef){
+                qhead = trail.size();
+                break;
+            }
+            continue;
+        }
 
-    while (qhead < trail.size()){
         Lit            p   = trail[qhead++];     // 'p' is enqueued fact to propagate.
         vec<Watcher>&  ws  = watches[p];
         Watcher        *i, *j, *end;
         num_props++;
 
         // if propagation tracing enabled, print boolean propagation
-        if (Trace.isOn("dtview::prop"))
+        if (Trace.isOn(s_dtviewPropTag))
         {
           dtviewBoolPropagationHelper(decisionLevel(), p, d_proxy);
         }
 
+        // Binary clauses first: the blocker is the other literal, so the clause is never inspected.
+        // The literals of the reason are put in order when it is needed (see 'reason()').
+        vec<Watcher>& bws = bin_watches[p];
+        for (int k = 0; k < bws.size(); k++){
+            Lit other = bws[k].blocker;
+            if (value(other) == l_False){
+                confl = bws[k].cref;
+                qhead = trail.size();
+                break;
+            }else if (value(other) == l_Undef){
+                if (track_lemma_use) lemma_propagations[ca[bws[k].cref].source()]++;
+                uncheckedEnqueue(other, bws[k].cref); }
+        }
+        if (confl != CRef_Undef)
+            break;
+
         for (i = j = (Watcher*)ws, end = i + ws.size();  i != end;){
             // Try to avoid inspecting the clause:
             Lit blocker = i->blocker;
@@ -1265,8 +1474,9 @@ CRef Solver::propagateBool()
                 // Copy the remaining watches:
                 while (i < end)
                     *j++ = *i++;
-            }else
-                uncheckedEnqueue(first, cr);
+            }else{
+                if (track_lemma_use) lemma_propagations[c.source()]++;
+                uncheckedEnqueue(first, cr); }
 
         NextClause:;
         }
@@ -1278,6 +1488,76 @@ CRef Solver::propagateBool()
     return confl;
 }
 
+/*_________________________________________________________________________________________________
+|
+|  propagatePb : [void]  ->  [Clause*]
+|
+|  Description:
+|    Removes the literals that became false from the slacks of their pseudo-Boolean constraints,
+|    and propagates the literals whose coefficients exceed the slack. Stops after the first
+|    literal that propagates, for the clauses to be propagated first. If a conflict arises,
+|    the conflicting clause is learnt and returned, otherwise CRef_Undef.
+|________________________________________________________________________________________________@*/
+CRef Solver::propagatePb()
+{
+    CRef confl = CRef_Undef;
+    int  trail_size = trail.size();
+
+    while (confl == CRef_Undef && pb_qhead < trail.size() && trail.size() == trail_size){
+        Lit p = trail[pb_qhead++];
+        if (toInt(~p) >= (int)pb_occurs.size()) continue;
+        const std::vector<std::pair<int, int64_t> >& occs = pb_occurs[toInt(~p)];
+        // All the constraints are updated, even after a conflict, as 'cancelUntil()' restores them
+        for (size_t k = 0; k < occs.size(); k++){
+            PbConstraint& c = pb_constraints[occs[k].first];
+            c.slack -= occs[k].second;
+            if (confl != CRef_Undef) continue;
+
+            if (c.slack < 0){
+                // The false literals of the constraint are a conflict
+                vec<Lit> lits;
+                int      lvl = assertionLevelOnly() ? assertionLevel : 0;
+                for (size_t i = 0; i < c.lits.size(); i++){
+                    Lit l = c.lits[i];
+                    if (value(l) == l_False && trail_index(var(l)) < pb_qhead){
+                        lits.push(l);
+                        if (!assertionLevelOnly()) lvl = std::max(lvl, intro_level(var(l)));
+                    }
+                }
+                lemma_lt lt(*this);
+                sort(lits, lt);
+                if (lits.size() == 1) lits.push(mkLit(varTrue, true));
+                confl = ca.alloc(lvl, lits, true);
+                ca[confl].setLbd(computeLbd(lits));
+                clauses_removable.push(confl);
+                attachClause(confl);
+                pb_conflicts++;
+            }else if (c.slack < c.coeffs[0]){
+                for (size_t i = 0; i < c.lits.size() && c.coeffs[i] > c.slack; i++)
+                    if (value(c.lits[i]) == l_Undef){
+                        uncheckedEnqueue(c.lits[i], CRef_Lazy);
+                        pb_reason[var(c.lits[i])] = occs[k].first;
+                        pb_propagations++;
+                    }
+            }
+        }
+    }
+
+    return confl;
+}
+
+void Solver::explainPb(int c, Lit p, vec<Lit>& out_expl)
+{
+    // The literals false before 'p' include the ones removed from the slack when it propagated
+    const PbConstraint& pc = pb_constraints[c];
+    out_expl.push(p);
+    for (size_t i = 0; i < pc.lits.size(); i++){
+        Lit l = pc.lits[i];
+        if (l != p && value(l) == l_False && trail_index(var(l)) < trail_index(var(p)))
+            out_expl.push(l);
+    }
+}
+
 
 /*_________________________________________________________________________________________________
 |
@@ -1286,6 +1566,12 @@ CRef Solver::propagateBool()
 |  Description:
 |    Remove half of the learnt clauses, minus the clauses locked by the current assignment. Locked
 |    clauses are clauses that are reason to some assignment. Binary clauses are never removed.
+|
+|    With 'use_lbd_tiers', the learnt clauses are first split by literal block distance: the clauses
+|    with an LBD of at most 'lbd_core' are never removed, and the clauses with an LBD of at most
+|    'lbd_tier2' are kept if they were used in a conflict since the last reduction. Only the other
+|    clauses are reduced by activity, and the clauses of the core tier are not counted against
+|    'max_learnts'.
 |________________________________________________________________________________________________@*/
 struct reduceDB_lt {
     ClauseAllocator& ca;
@@ -1298,21 +1584,105 @@ void Solver::reduceDB()
     int     i, j;
     double  extra_lim = cla_inc / clauses_removable.size();    // Remove any clause below this activity
 
-    sort(clauses_removable, reduceDB_lt(ca));
+    int     kept = 0;
+
+    if (use_lbd_tiers){
+        // Move the clauses of the core and tier 2 tiers to the front, and only reduce the others:
+        learnts_core = 0;
+        for (i = 0; i < clauses_removable.size(); i++){
+            Clause& c = ca[clauses_removable[i]];
+            bool keep = c.lbd() <= lbd_core || (c.lbd() <= lbd_tier2 && c.used());
+            if (c.lbd() <= lbd_core) learnts_core++;
+            c.setUsed(false);
+            if (keep){
+                CRef cr = clauses_removable[kept];
+                clauses_removable[kept++] = clauses_removable[i];
+                clauses_removable[i] = cr; }
+        }
+    }
+
+    vec<CRef> local;
+    for (i = kept; i < clauses_removable.size(); i++)
+        local.push(clauses_removable[i]);
+    sort(local, reduceDB_lt(ca));
     // Don't delete binary or locked clauses. From the rest, delete clauses from the first half
     // and clauses with activity smaller than 'extra_lim':
-    for (i = j = 0; i < clauses_removable.size(); i++){
-        Clause& c = ca[clauses_removable[i]];
-        if (c.size() > 2 && !locked(c) && (i < clauses_removable.size() / 2 || c.activity() < extra_lim))
-            removeClause(clauses_removable[i]);
+    for (i = 0, j = kept; i < local.size(); i++){
+        Clause& c = ca[local[i]];
+        if (c.size() > 2 && !locked(c) && (i < local.size() / 2 || c.activity() < extra_lim))
+            removeClause(local[i]);
         else
-            clauses_removable[j++] = clauses_removable[i];
+            clauses_removable[j++] = local[i];
     }
-    clauses_removable.shrink(i - j);
+    clauses_removable.shrink(clauses_removable.size() - j);
     checkGarbage();
 }
 
 
+void Solver::updateLbd(Clause& c)
+{
+    c.setUsed(true);
+    if (c.lbd() > lbd_core){
+        unsigned lbd = computeLbd(c);
+        if (lbd < c.lbd())
+            c.setLbd(lbd);
+    }
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  lbdRestart : (nof_conflicts : int)  ->  [bool]
+|
+|  Description:
+|    Glucose-style dynamic restarts: keeps a fast and a slow exponential moving average of the LBD of
+|    the learnt clauses, and restarts when the fast one exceeds the slow one by 'restart_margin', i.e.
+|    when the recently learnt clauses are worse than usual. 'nof_conflicts' is the number of
+|    conflicts since the last restart, which must be at least 'restart_min_confl'.
+|________________________________________________________________________________________________@*/
+void Solver::addLbdSample(unsigned lbd)
+{
+    lbd_count++;
+    // Use the plain average of the first samples, so that the averages are not biased towards 0:
+    double fast = std::max(restart_fast_alpha, 1.0 / lbd_count);
+    double slow = std::max(restart_slow_alpha, 1.0 / lbd_count);
+    lbd_fast += fast * (lbd - lbd_fast);
+    lbd_slow += slow * (lbd - lbd_slow);
+}
+
+bool Solver::lbdRestart(int nof_conflicts) const
+{
+    return nof_conflicts >= restart_min_confl && lbd_fast > restart_margin * lbd_slow;
+}
+
+void Solver::exportLearnt(const vec<Lit>& learnt, unsigned lbd)
+{
+    if (!d_proxy->isSharingClauses() || (unsigned)learnt.size() > share_max_size || lbd > share_max_lbd)
+        return;
+    CVC4::prop::SatClause clause;
+    for (int i = 0; i < learnt.size(); i++)
+        clause.push_back(MinisatSatSolver::toSatLiteral(learnt[i]));
+    d_proxy->exportLearnedClause(clause);
+}
+
+void Solver::importShared()
+{
+    if (!d_proxy->isSharingClauses())
+        return;
+    assert(decisionLevel() == 0);
+    std::vector<CVC4::prop::SatClause> clauses;
+    d_proxy->importSharedClauses(clauses);
+    // The clauses are consequences of the problem, like the learnt clauses,
+    // and thus removable. They are attached at the next propagation.
+    for (CVC4::prop::SatClause& clause : clauses) {
+        vec<Lit> ps;
+        MinisatSatSolver::toMinisatClause(clause, ps);
+        ClauseId id = ClauseIdUndef;
+        addClause_(ps, true, id);
+    }
+}
+
+
 void Solver::removeSatisfied(vec<CRef>& cs)
 {
     int i, j;
@@ -1356,6 +1726,204 @@ void Solver::rebuildOrderHeap()
 }
 
 
+/*_________________________________________________________________________________________________
+|
+|  inprocess : [void]  ->  [void]
+|
+|  Description:
+|    Simplifies the learnt clauses between restarts, at decision level 0: removes the learnt
+|    clauses subsumed by other learnt clauses, strengthens them by self-subsuming resolution, and
+|    shortens them by vivification. A round is bounded by 'inprocess_effort' steps, and every clause
+|    it considers spends a 'SatInprocessStep' resource.
+|
+|    The problem clauses, and with them the theory atoms, are left alone. A clause is only
+|    simplified by clauses of the same or a lower user level, so that the result is popped together
+|    with the clause it replaces.
+|________________________________________________________________________________________________@*/
+void Solver::inprocess()
+{
+    assert(decisionLevel() == 0);
+    assert(ok);
+    Debug("minisat") << "Solver::inprocess(): " << clauses_removable.size() << " learnt clauses" << std::endl;
+    inprocess_rounds++;
+
+    int64_t budget = inprocess_effort;
+    subsumeLearnts(budget);
+    vivifyLearnts(budget);
+
+    // Forget the removed clauses:
+    int i, j;
+    for (i = j = 0; i < clauses_removable.size(); i++)
+        if (ca[clauses_removable[i]].mark() != 1)
+            clauses_removable[j++] = clauses_removable[i];
+    clauses_removable.shrink(i - j);
+    checkGarbage();
+}
+
+
+bool Solver::inprocessable(const Clause& c) const
+{
+    if (!c.removable() || c.mark() == 1 || c.size() <= 2)
+        return false;
+    // The watched literals may change, so none of the literals may be assigned. This also means
+    // that the clause is not locked.
+    for (int i = 0; i < c.size(); i++)
+        if (value(c[i]) != l_Undef)
+            return false;
+    return true;
+}
+
+
+struct subsume_lt {
+    ClauseAllocator& ca;
+    const vec<CRef>& cs;
+    subsume_lt(ClauseAllocator& ca_, const vec<CRef>& cs_) : ca(ca_), cs(cs_) {}
+    bool operator () (int x, int y) { return ca[cs[x]].size() < ca[cs[y]].size(); }
+};
+void Solver::subsumeLearnts(int64_t& budget)
+{
+    vec<CRef>& cs = clauses_removable;
+
+    // Occurrences of the literals in the clauses that can be simplified, and the abstractions of
+    // all clauses (by index in 'cs'):
+    vec<vec<int> > occs(2 * nVars());
+    vec<uint32_t>  abstractions(cs.size(), 0);
+    vec<int>       order;
+    for (int i = 0; i < cs.size(); i++){
+        const Clause& c = ca[cs[i]];
+        if (c.mark() == 1)
+            continue;
+        for (int k = 0; k < c.size(); k++)
+            abstractions[i] |= 1 << (var(c[k]) & 31);
+        if (inprocessable(c))
+            for (int k = 0; k < c.size(); k++)
+                occs[toInt(c[k])].push(i);
+        order.push(i);
+    }
+
+    // Try the short clauses first, they subsume the most:
+    sort(order, subsume_lt(ca, cs));
+    vec<char> marks(2 * nVars(), 0);
+    for (int o = 0; o < order.size() && budget > 0; o++){
+        int d = order[o];
+        const Clause& sub = ca[cs[d]];
+        if (sub.mark() == 1)
+            continue;
+        if (!withinBudget(ResourceManager::Resource::SatInprocessStep))
+            break;
+
+        // Look for the clauses containing the rarest literal of 'sub', or its negation:
+        Lit best = sub[0];
+        for (int k = 1; k < sub.size(); k++)
+            if (occs[toInt(sub[k])].size() + occs[toInt(~sub[k])].size()
+                < occs[toInt(best)].size() + occs[toInt(~best)].size())
+                best = sub[k];
+
+        for (int pass = 0; pass < 2; pass++){
+            const vec<int>& os = occs[toInt(pass == 0 ? best : ~best)];
+            for (int j = 0; j < os.size() && budget > 0; j++){
+                int   c  = os[j];
+                CRef  cr = cs[c];
+                Clause& cl = ca[cr];
+                if (c == d || cl.mark() == 1 || cl.size() < sub.size() || sub.level() > cl.level()
+                    || (abstractions[d] & ~abstractions[c]) != 0)
+                    continue;
+                budget--;
+
+                // Does 'sub' subsume 'cl', with at most one literal negated?
+                for (int k = 0; k < cl.size(); k++)
+                    marks[toInt(cl[k])] = 1;
+                Lit  flip     = lit_Undef;
+                bool subsumes = true;
+                for (int k = 0; k < sub.size() && subsumes; k++)
+                    if (!marks[toInt(sub[k])]){
+                        if (flip == lit_Undef && marks[toInt(~sub[k])])
+                            flip = ~sub[k];
+                        else
+                            subsumes = false; }
+                for (int k = 0; k < cl.size(); k++)
+                    marks[toInt(cl[k])] = 0;
+                if (!subsumes)
+                    continue;
+
+                if (flip == lit_Undef){
+                    removeClause(cr);
+                    inprocess_subsumed++;
+                }else if (cl.size() > 2){
+                    // Self-subsuming resolution: 'flip' can be removed from 'cl'.
+                    detachClause(cr, true);
+                    for (int k = 0; k < cl.size(); k++)
+                        if (cl[k] == flip){
+                            cl[k] = cl[cl.size() - 1];
+                            break; }
+                    cl.pop();
+                    attachClause(cr);
+                    abstractions[c] = 0;
+                    for (int k = 0; k < cl.size(); k++)
+                        abstractions[c] |= 1 << (var(cl[k]) & 31);
+                    inprocess_strengthened++;
+                }
+            }
+        }
+    }
+}
+
+
+void Solver::vivifyLearnts(int64_t& budget)
+{
+    vec<Lit>  kept;
+    vec<Lit>  assigned;
+    vec<char> phases;
+    for (int i = 0; i < clauses_removable.size() && budget > 0; i++){
+        CRef    cr = clauses_removable[i];
+        Clause& c  = ca[cr];
+        // Only the clauses of the current user level, since the propagations may use any clause:
+        if (!inprocessable(c) || c.level() != assertionLevel)
+            continue;
+        if (!withinBudget(ResourceManager::Resource::SatInprocessStep))
+            break;
+
+        // Assign the negation of the literals of 'c' one by one, propagating on the other clauses.
+        // A literal that becomes false is redundant, and the clause can be cut after a literal that
+        // becomes true or that leads to a conflict.
+        detachClause(cr, true);
+        kept.clear();
+        int trail_start = trail.size();
+        for (int k = 0; k < c.size(); k++){
+            Lit p = c[k];
+            if (value(p) == l_False)
+                continue;
+            kept.push(p);
+            if (value(p) == l_True)
+                break;
+            newDecisionLevel();
+            uncheckedEnqueue(~p);
+            if (propagateBool() != CRef_Undef)
+                break;
+        }
+        budget -= 1 + trail.size() - trail_start;
+
+        // Backtrack without saving the phases of the temporary assignments:
+        assigned.clear();
+        phases.clear();
+        for (int t = trail_start; t < trail.size(); t++){
+            assigned.push(trail[t]);
+            phases.push(polarity[var(trail[t])]); }
+        cancelUntil(0);
+        for (int t = 0; t < assigned.size(); t++)
+            polarity[var(assigned[t])] = phases[t];
+
+        if (kept.size() >= 2 && kept.size() < c.size()){
+            inprocess_vivified += c.size() - kept.size();
+            for (int k = 0; k < kept.size(); k++)
+                c[k] = kept[k];
+            c.shrink(c.size() - kept.size());
+        }
+        attachClause(cr);
+    }
+}
+
+
 /*_________________________________________________________________________________________________
 |
 |  simplify : [void]  ->  [bool]
@@ -1428,6 +1996,17 @@ lbool Solver::search(int nof_conflicts)
             // Analyze the conflict
             learnt_clause.clear();
             int max_level = analyze(confl, learnt_clause, backtrack_level);
+            unsigned lbd = computeLbd(learnt_clause);
+            if (glucose_restart) addLbdSample(lbd);
+            // Backtrack chronologically instead of popping many levels, whose theory literals would
+            // have to be asserted again. The learnt clause is still asserting one level below the
+            // conflict, its literal is just assigned at a higher level than necessary. Units are
+            // always learnt at level 0.
+            if (chrono_backtrack > 0 && learnt_clause.size() > 1
+                && decisionLevel() - backtrack_level > chrono_backtrack) {
+                backtrack_level = decisionLevel() - 1;
+                chrono_backtracks++;
+            }
             cancelUntil(backtrack_level);
 
             // Assert the conflict clause and the asserting literal
@@ -1441,6 +2020,7 @@ lbool Solver::search(int nof_conflicts)
                   ca.alloc(assertionLevelOnly() ? assertionLevel : max_level,
                            learnt_clause,
                            true);
+              ca[cr].setLbd(lbd);
               clauses_removable.push(cr);
               attachClause(cr);
               claBumpActivity(ca[cr]);
@@ -1455,6 +2035,7 @@ lbool Solver::search(int nof_conflicts)
                         ProofManager::getSatProof()
                             ->endResChain(id););
             }
+            exportLearnt(learnt_clause, lbd);
 
             varDecayActivity();
             claDecayActivity();
@@ -1481,7 +2062,8 @@ lbool Solver::search(int nof_conflicts)
 
 	    // If this was a final check, we are satisfiable
             if (check_type == CHECK_FINAL) {
-              bool decisionEngineDone = d_proxy->isDecisionEngineDone();
+              bool decisionEngineDone =
+                  pb_constraints.empty() && d_proxy->isDecisionEngineDone();
               // Unless a lemma has added more stuff to the queues
               if (!decisionEngineDone  &&
 		  (!order_heap.empty() || qhead < trail.size()) ) {
@@ -1499,6 +2081,7 @@ lbool Solver::search(int nof_conflicts)
             }
 
             if ((nof_conflicts >= 0 && conflictC >= nof_conflicts)
+                || (glucose_restart && lbdRestart(conflictC))
                 || !withinBudget(ResourceManager::Resource::SatConflictStep))
             {
               // Reached bound on number of conflicts:
@@ -1507,6 +2090,7 @@ lbool Solver::search(int nof_conflicts)
               // [mdeters] notify theory engine of restarts for deferred
               // theory processing
               d_proxy->notifyRestart();
+              importShared();
               return l_Undef;
             }
 
@@ -1515,7 +2099,7 @@ lbool Solver::search(int nof_conflicts)
                 return l_False;
             }
 
-            if (clauses_removable.size()-nAssigns() >= max_learnts) {
+            if (clauses_removable.size()-learnts_core-nAssigns() >= max_learnts) {
                 // Reduce the set of learnt clauses:
                 reduceDB();
             }
@@ -1637,10 +2221,17 @@ lbool Solver::solve_()
     int curr_restarts = 0;
     while (status == l_Undef){
         double rest_base = luby_restart ? luby(restart_inc, curr_restarts) : pow(restart_inc, curr_restarts);
-        status = search(rest_base * restart_first);
+        status = search(glucose_restart ? -1 : rest_base * restart_first);
+        arena_bytes = std::max(arena_bytes, (uint64_t)ca.size() * ClauseAllocator::Unit_Size);
         if (!withinBudget(ResourceManager::Resource::SatConflictStep))
           break;  // FIXME add restart option?
         curr_restarts++;
+
+        // Simplify the learnt clauses every 'inprocess_interval' conflicts:
+        if (use_inprocessing && status == l_Undef && decisionLevel() == 0 && conflicts >= next_inprocess){
+            next_inprocess = conflicts + inprocess_interval;
+            inprocess();
+        }
     }
 
     if (!withinBudget(ResourceManager::Resource::SatConflictStep))
@@ -1751,6 +2342,7 @@ void Solver::relocAll(ClauseAllocator& to)
     //
     // for (int i = 0; i < watches.size(); i++)
     watches.cleanAll();
+    bin_watches.cleanAll();
     for (int v = 0; v < nVars(); v++)
         for (int s = 0; s < 2; s++){
             Lit p = mkLit(v, s);
@@ -1758,6 +2350,9 @@ void Solver::relocAll(ClauseAllocator& to)
             vec<Watcher>& ws = watches[p];
             for (int j = 0; j < ws.size(); j++)
               ca.reloc(ws[j].cref, to, NULLPROOF(ProofManager::getSatProof()));
+            vec<Watcher>& bws = bin_watches[p];
+            for (int j = 0; j < bws.size(); j++)
+              ca.reloc(bws[j].cref, to, NULLPROOF(ProofManager::getSatProof()));
         }
 
     // All reasons:
@@ -1941,6 +2536,9 @@ CRef Solver::updateLemmas() {
       }
 
       lemma_ref = ca.alloc(clauseLevel, lemma, removable);
+      ca[lemma_ref].setLbd(computeLbd(lemma));
+      ca[lemma_ref].setSource(lemmas_source[j]);
+      lemma_clauses[lemmas_source[j]]++;
       PROOF(TNode cnf_assertion = lemmas_cnf_assertion[j].first;
             TNode cnf_def = lemmas_cnf_assertion[j].second;
 
@@ -1983,9 +2581,11 @@ CRef Solver::updateLemmas() {
             Debug("minisat::lemmas") << "Solver::updateLemmas(): unit conflict or empty clause" << std::endl;
             conflict = CRef_Lazy;
             PROOF( ProofManager::getSatProof()->storeUnitConflict(lemma[0], LEARNT); );
+            if (track_lemma_use) lemma_conflicts[lemmas_source[j]]++;
           }
         } else {
           Debug("minisat::lemmas") << "lemma size is " << lemma.size() << std::endl;
+          if (track_lemma_use) lemma_propagations[lemmas_source[j]]++;
           uncheckedEnqueue(lemma[0], lemma_ref);
         }
       }
@@ -1997,6 +2597,7 @@ CRef Solver::updateLemmas() {
   lemmas.clear();
   lemmas_cnf_assertion.clear();
   lemmas_removable.clear();
+  lemmas_source.clear();
 
   if (conflict != CRef_Undef) {
     theoryConflict = true;
@@ -2028,6 +2629,9 @@ void ClauseAllocator::reloc(CRef& cr,
   // Copy extra data-fields:
   // (This could be cleaned-up. Generalize Clause-constructor to be applicable here instead?)
   to[cr].mark(c.mark());
+  to[cr].setLbd(c.lbd());
+  to[cr].setUsed(c.used());
+  to[cr].setSource(c.source());
   if (to[cr].removable())         to[cr].activity() = c.activity();
   else if (to[cr].has_extra()) to[cr].calcAbstraction();
 }
@@ -24,6 +24,8 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "cvc4_private.h"
 
 #include <iosfwd>
+#include <utility>
+#include <vector>
 
 #include "base/output.h"
 #include "context/context.h"
@@ -97,6 +99,9 @@ public:
   /** Is the lemma removable */
   vec<bool> lemmas_removable;
 
+  /** The source of the lemma */
+  vec<unsigned> lemmas_source;
+
   /** Nodes being converted to CNF */
   std::vector<std::pair<CVC4::Node, CVC4::Node> > lemmas_cnf_assertion;
 
@@ -191,6 +196,8 @@ public:
     bool    addClause (Lit p, Lit q, Lit r, bool removable, ClauseId& id); // Add a ternary clause to the solver.
     bool    addClause_(      vec<Lit>& ps, bool removable, ClauseId& id);  // Add a clause to the solver without making superflous internal copy. Will
                                                                                  // change the passed vector 'ps'.
+    bool    addPbConstraint(const vec<Lit>& ps, const vec<int64_t>& coeffs, int64_t bound); // Add the constraint 'sum coeffs[i] * ps[i] >= bound' at level 0,
+                                                                                 // propagated natively (see 'propagatePb()').
 
     // Solving:
     //
@@ -232,6 +239,10 @@ public:
     int     nVars      ()      const;       // The current number of variables.
     int     nFreeVars  ()      const;
     bool    isDecision (Var x) const;       // is the given var a decision?
+    double  getActivity(Var x) const { return activity[x]; } // the activity of the given var
+    bool    getPolarity(Var x) const { return polarity[x] & 0x1; } // the preferred polarity of the given var
+    bool    isPolarityFrozen(Var x) const { return polarity[x] & 0x2; } // whether the polarity of the given var was frozen
+    void    bumpActivity(Var x, double scale) { varBumpActivity(x, scale * var_inc); } // bump the given var by scale times the current increment
 
     // Debugging SMT explanations
     //
@@ -280,10 +291,35 @@ public:
     int       learntsize_adjust_start_confl;
     double    learntsize_adjust_inc;
 
+    bool      use_inprocessing;   // Simplify the learnt clauses between restarts (see 'inprocess()').                      (default false)
+    uint64_t  inprocess_interval; // The number of conflicts between two inprocessing rounds.                                  (default 5000)
+    int64_t   inprocess_effort;   // The number of subsumption checks and propagations of an inprocessing round.               (default 100000)
+
+    bool      use_lbd_tiers;      // Reduce the learnt clauses by tiers of literal block distance (see 'reduceDB()').       (default false)
+    unsigned  lbd_core;           // Learnt clauses up to this LBD are never removed.                                          (default 2)
+    unsigned  lbd_tier2;          // Learnt clauses up to this LBD are kept while they are used in conflicts.                  (default 6)
+    bool      glucose_restart;    // Restart when the recent LBD average exceeds the long-term one (see 'lbdRestart()').    (default false)
+    double    restart_fast_alpha; // The smoothing factor of the moving average of recent LBDs.                                (default 1/32)
+    double    restart_slow_alpha; // The smoothing factor of the moving average of all LBDs.                                   (default 1/16384)
+    double    restart_margin;     // Restart when the recent average is this factor above the long-term one.                   (default 1.25)
+    int       restart_min_confl;  // The minimal number of conflicts between two restarts.                                     (default 50)
+    int       chrono_backtrack;   // Backtrack a single level when a backjump would pop more levels than this, 0 to disable.  (default 0)
+    bool      track_lemma_use;    // Count the propagations and conflicts of the lemma clauses by source.                      (default false)
+    unsigned  share_max_size;     // Export the learnt clauses of at most this many literals when sharing clauses.             (default 8)
+    unsigned  share_max_lbd;      // ... whose LBD is at most this.                                                            (default 2)
+    unsigned  lemma_source;       // The source of the clauses being added, 0 if they are not lemmas (see 'Clause::source()').
+
     // Statistics: (read-only member variable)
     //
     uint64_t solves, starts, decisions, rnd_decisions, propagations, conflicts, resources_consumed;
     uint64_t dec_vars, clauses_literals, learnts_literals, max_literals, tot_literals;
+    uint64_t inprocess_rounds, inprocess_subsumed, inprocess_strengthened, inprocess_vivified;
+    uint64_t chrono_backtracks;
+    uint64_t pb_propagations, pb_conflicts;
+    uint64_t arena_bytes;         // The peak size of the clause arena, sampled at restarts.
+    uint64_t lemma_clauses[Clause::source_max];      // The lemma clauses, by source.
+    uint64_t lemma_propagations[Clause::source_max]; // The propagations by lemma clauses, by source.
+    uint64_t lemma_conflicts[Clause::source_max];    // The conflicts the lemma clauses took part in, by source.
 
 protected:
 
@@ -345,6 +381,8 @@ protected:
     double              var_inc;            // Amount to bump next variable with.
     OccLists<Lit, vec<Watcher>, WatcherDeleted>
                         watches;            // 'watches[lit]' is a list of constraints watching 'lit' (will go there if literal becomes true).
+    OccLists<Lit, vec<Watcher>, WatcherDeleted>
+                        bin_watches;        // 'bin_watches[lit]' is the same for binary clauses, whose blocker is the other literal.
     vec<lbool>          assigns;            // The current assignments.
     vec<int>            assigns_lim;        // The size by levels of the current assignment
     vec<char>           polarity;           // The preferred polarity of each variable (bit 0) and whether it's locked (bit 1).
@@ -357,6 +395,7 @@ protected:
     int                 qhead;              // Head of queue (as index into the trail -- no more explicit propagation queue in MiniSat).
     int                 simpDB_assigns;     // Number of top-level assignments since last execution of 'simplify()'.
     int64_t             simpDB_props;       // Remaining number of propagations that must be made before next execution of 'simplify()'.
+    uint64_t            next_inprocess;     // Number of conflicts before the next execution of 'inprocess()'.
     vec<Lit>            assumptions;        // Current set of assumptions provided to solve by the user.
     Heap<VarOrderLt>    order_heap;         // A priority queue of variables ordered with respect to the variable activity.
     double              progress_estimate;  // Set by 'search()'.
@@ -364,6 +403,19 @@ protected:
 
     ClauseAllocator     ca;
 
+    // Pseudo-Boolean constraints 'sum coeffs[i] * lits[i] >= bound', with positive coefficients:
+    //
+    struct PbConstraint {
+      std::vector<Lit>     lits;          // The literals, by decreasing coefficients.
+      std::vector<int64_t> coeffs;
+      int64_t              slack;         // The sum of the coefficients of the literals that are not false, minus the bound.
+    };
+    std::vector<PbConstraint> pb_constraints;
+    std::vector<std::vector<std::pair<int, int64_t> > >
+                        pb_occurs;          // 'pb_occurs[toInt(lit)]' lists the constraints of 'lit' and its coefficients, visited when 'lit' becomes false.
+    std::vector<int>    pb_reason;          // The constraint that propagated each variable (whose reason is then 'CRef_Lazy'), or -1.
+    int                 pb_qhead;           // Head of the queue of the pseudo-Boolean constraints (as index into the trail).
+
     // CVC4 Stuff
     vec<bool>           theory;           // Is the variable representing a theory atom
 
@@ -386,6 +438,12 @@ protected:
     vec<Lit>            analyze_toclear;
     vec<Lit>            add_tmp;
 
+    vec<uint64_t>       lbd_seen;         // The stamp of each decision level, used by 'computeLbd()'.
+    uint64_t            lbd_stamp;
+    double              lbd_fast;         // Moving averages of the LBD of the learnt clauses (see 'lbdRestart()').
+    double              lbd_slow;
+    uint64_t            lbd_count;
+    int                 learnts_core;     // Number of learnt clauses of the core tier at the last 'reduceDB()'.
     double              max_learnts;
     double              learntsize_adjust_confl;
     int                 learntsize_adjust_cnt;
@@ -407,6 +465,8 @@ protected:
     CRef     propagate        (TheoryCheckType type);                                  // Perform Boolean and Theory. Returns possibly conflicting clause.
     CRef     propagateBool    ();                                                      // Perform Boolean propagation. Returns possibly conflicting clause.
     void     propagateTheory  ();                                                      // Perform Theory propagation.
+    CRef     propagatePb      ();                                                      // Perform pseudo-Boolean propagation. Returns possibly conflicting clause.
+    void     explainPb        (int c, Lit p, vec<Lit>& out_expl);                      // The literals of constraint 'c' that imply 'p', with 'p' first.
     void     theoryCheck      (CVC4::theory::Theory::Effort effort);                   // Perform a theory satisfiability check. Adds lemmas.
     CRef     updateLemmas     ();                                                      // Add the lemmas, backtraking if necessary and return a conflict if there is one
     void     cancelUntil      (int level);                                             // Backtrack until a certain level.
@@ -416,8 +476,19 @@ protected:
     lbool    search           (int nof_conflicts);                                     // Search for a given number of conflicts.
     lbool    solve_           ();                                                      // Main solve method (assumptions given in 'assumptions').
     void     reduceDB         ();                                                      // Reduce the set of learnt clauses.
+    template<class Lits>
+    unsigned computeLbd       (const Lits& ps);                                        // Number of distinct decision levels of 'ps', counting each unassigned literal apart.
+    void     updateLbd        (Clause& c);                                             // Lower the LBD of a learnt clause used in conflict analysis, and mark it as used.
+    void     addLbdSample     (unsigned lbd);                                          // Update the moving averages of the LBD of the learnt clauses.
+    bool     lbdRestart       (int nof_conflicts) const;                               // Whether the LBD averages call for a restart.
+    void     exportLearnt     (const vec<Lit>& learnt, unsigned lbd);                  // Export a short learnt clause to the other solvers, if sharing clauses.
+    void     importShared     ();                                                      // Add the clauses shared by the other solvers as removable lemmas.
     void     removeSatisfied  (vec<CRef>& cs);                                         // Shrink 'cs' to contain only non-satisfied clauses.
     void     rebuildOrderHeap ();
+    void     inprocess        ();                                                      // Simplify the learnt clauses at level 0, within a budget.
+    void     subsumeLearnts   (int64_t& budget);                                       // Remove or strengthen the learnt clauses subsumed by other learnt clauses.
+    void     vivifyLearnts    (int64_t& budget);                                       // Shorten the learnt clauses of the current user level by propagation.
+    bool     inprocessable    (const Clause& c) const;                                 // Can 'c' be simplified by 'inprocess()'?
 
     // Maintaining Variable/Clause activity:
     //
@@ -433,6 +504,7 @@ protected:
     void     detachClause     (CRef cr, bool strict = false); // Detach a clause to watcher lists.
     void     removeClause     (CRef cr);               // Detach and free a clause.
     bool     locked           (const Clause& c) const; // Returns TRUE if a clause is a reason for some implication in the current state.
+    Var      lockedVar        (const Clause& c) const; // Returns the variable implied by a locked clause, or 'var_Undef'.
     bool     satisfied        (const Clause& c) const; // Returns TRUE if a clause is satisfied in the current state.
 
     void     relocAll         (ClauseAllocator& to);
@@ -490,7 +562,7 @@ inline bool Solver::isPropagated(Var x) const
 inline bool Solver::isPropagatedBy(Var x, const Clause& c) const
 {
   return vardata[x].d_reason != CRef_Undef && vardata[x].d_reason != CRef_Lazy
-         && ca.lea(vardata[var(c[0])].d_reason) == &c;
+         && ca.lea(vardata[x].d_reason) == &c;
 }
 
 inline bool Solver::isDecision(Var x) const
@@ -550,6 +622,21 @@ inline void Solver::claBumpActivity (Clause& c) {
                 ca[clauses_removable[i]].activity() *= 1e-20;
             cla_inc *= 1e-20; } }
 
+template<class Lits>
+inline unsigned Solver::computeLbd(const Lits& ps) {
+        if (lbd_seen.size() <= decisionLevel())
+            lbd_seen.growTo(decisionLevel() + 1, 0);
+        lbd_stamp++;
+        unsigned lbd = 0;
+        for (int i = 0; i < ps.size(); i++){
+            Var x = var(ps[i]);
+            if (value(x) == l_Undef)
+                lbd++;
+            else if (lbd_seen[level(x)] != lbd_stamp){
+                lbd_seen[level(x)] = lbd_stamp;
+                lbd++; } }
+        return lbd; }
+
 inline void Solver::checkGarbage(void){ return checkGarbage(garbage_frac); }
 inline void Solver::checkGarbage(double gf){
     if (ca.wasted() > ca.size() * gf)
@@ -566,7 +653,12 @@ inline bool     Solver::addClause       (Lit p, Lit q, bool removable, ClauseId&
                                                                 { add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); return addClause_(add_tmp, removable, id); }
 inline bool     Solver::addClause       (Lit p, Lit q, Lit r, bool removable, ClauseId& id)
                                                                 { add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); add_tmp.push(r); return addClause_(add_tmp, removable, id); }
-inline bool     Solver::locked          (const Clause& c) const { return value(c[0]) == l_True && isPropagatedBy(var(c[0]), c); }
+inline bool     Solver::locked          (const Clause& c) const { return lockedVar(c) != var_Undef; }
+inline Var      Solver::lockedVar       (const Clause& c) const {
+    if (value(c[0]) == l_True && isPropagatedBy(var(c[0]), c)) return var(c[0]);
+    // Binary clauses propagate without being inspected, so c[1] may be implied (see 'propagateBool()'):
+    if (c.size() == 2 && value(c[1]) == l_True && isPropagatedBy(var(c[1]), c)) return var(c[1]);
+    return var_Undef; }
 inline void Solver::newDecisionLevel()
 {
   trail_lim.push(trail.size());
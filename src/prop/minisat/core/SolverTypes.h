@@ -193,7 +193,10 @@ class Clause {
         unsigned has_extra : 1;
         unsigned reloced   : 1;
         unsigned size      : 27;
-        unsigned level     : 32; }                            header;
+        unsigned level     : 21;
+        unsigned source    : 4;
+        unsigned used      : 1;
+        unsigned lbd       : 6; }                             header;
     union { Lit lit; float act; uint32_t abs; CRef rel; } data[0];
 
     friend class ClauseAllocator;
@@ -207,6 +210,9 @@ class Clause {
         header.reloced   = 0;
         header.size      = ps.size();
         header.level     = level;
+        header.source    = 0;
+        header.used      = 0;
+        header.lbd       = 0;
 
         for (int i = 0; i < ps.size(); i++) 
             data[i].lit = ps[i];
@@ -237,6 +243,20 @@ public:
     void         mark        (uint32_t m)    { header.mark = m; }
     const Lit&   last        ()      const   { return data[header.size-1].lit; }
 
+    // The literal block distance (number of distinct decision levels), saturated at 'lbd_max', and
+    // whether the clause took part in a conflict since the last reduction of the learnt clauses:
+    enum { lbd_max = 63 };
+    unsigned     lbd         ()      const   { return header.lbd; }
+    void         setLbd      (unsigned l)    { header.lbd = l < lbd_max ? l : lbd_max; }
+    bool         used        ()      const   { return header.used; }
+    void         setUsed     (bool u)        { header.used = u; }
+
+    // The source of a lemma clause, below 'source_max', or 0 if it is not a lemma (see
+    // 'Solver::lemma_source'):
+    enum { source_max = 16 };
+    unsigned     source      ()      const   { return header.source; }
+    void         setSource   (unsigned s)    { assert(s < source_max); header.source = s; }
+
     bool         reloced     ()      const   { return header.reloced; }
     CRef         relocation  ()      const   { return data[0].rel; }
     void         relocate    (CRef c)        { header.reloced = 1; data[0].rel = c; }
@@ -263,8 +283,13 @@ const CRef CRef_Undef = RegionAllocator<uint32_t>::Ref_Undef;
 const CRef CRef_Lazy  = RegionAllocator<uint32_t>::Ref_Undef - 1;
 class ClauseAllocator : public RegionAllocator<uint32_t>
 {
+    // Clauses are padded to a multiple of 'Clause_Align' words, so that the header and the two
+    // watched literals, which are all that propagation reads of most clauses, never straddle
+    // a cache line.
+    enum { Clause_Align = 4 };
     static int clauseWord32Size(int size, bool has_extra){
-        return (sizeof(Clause) + (sizeof(Lit) * (size + (int)has_extra))) / sizeof(uint32_t); }
+        int words = (sizeof(Clause) + (sizeof(Lit) * (size + (int)has_extra))) / sizeof(uint32_t);
+        return (words + Clause_Align - 1) & ~(Clause_Align - 1); }
  public:
     bool extra_clause_field;
 
@@ -158,6 +158,23 @@ ClauseId MinisatSatSolver::addClause(SatClause& clause, bool removable) {
   return clause_id;
 }
 
+bool MinisatSatSolver::addPbConstraint(const SatClause& lits,
+                                       const std::vector<int64_t>& coeffs,
+                                       int64_t bound)
+{
+  Minisat::vec<Minisat::Lit> minisat_lits;
+  Minisat::vec<int64_t> minisat_coeffs;
+  for (unsigned i = 0; i < lits.size(); ++i)
+  {
+    minisat_lits.push(toMinisatLit(lits[i]));
+    minisat_coeffs.push(coeffs[i]);
+    // The variables of the constraint are not seen by variable elimination
+    d_minisat->setFrozen(Minisat::var(minisat_lits.last()), true);
+  }
+  d_minisat->addPbConstraint(minisat_lits, minisat_coeffs, bound);
+  return true;
+}
+
 SatVariable MinisatSatSolver::newVar(bool isTheoryAtom, bool preRegister, bool canErase) {
   return d_minisat->newVar(true, true, isTheoryAtom, preRegister, canErase);
 }
@@ -216,6 +233,42 @@ bool MinisatSatSolver::isDecision(SatVariable decn) const {
   return d_minisat->isDecision( decn );
 }
 
+double MinisatSatSolver::getActivity(SatVariable var) const
+{
+  return d_minisat->getActivity(var);
+}
+
+bool MinisatSatSolver::getDecisionHint(SatVariable var,
+                                       bool& phase,
+                                       double& activity) const
+{
+  // the polarity of Minisat is the sign of the decided literal
+  phase = !d_minisat->getPolarity(var);
+  activity = d_minisat->getActivity(var);
+  return true;
+}
+
+void MinisatSatSolver::setDecisionHint(SatVariable var,
+                                       bool phase,
+                                       double activity)
+{
+  if (!d_minisat->isPolarityFrozen(var))
+  {
+    d_minisat->setPolarity(var, !phase);
+  }
+  d_minisat->bumpActivity(var, activity);
+}
+
+void MinisatSatSolver::setLemmaSource(theory::TheoryId source)
+{
+  // the clause sources are shifted by one, 0 is for the clauses that are not
+  // lemmas
+  static_assert(static_cast<int>(theory::THEORY_LAST)
+                    < static_cast<int>(Minisat::Clause::source_max),
+                "the Minisat clauses cannot record every theory");
+  d_minisat->lemma_source = source == theory::THEORY_LAST ? 0 : source + 1;
+}
+
 /** Incremental interface */
 
 unsigned MinisatSatSolver::getAssertionLevel() const {
@@ -244,7 +297,15 @@ MinisatSatSolver::Statistics::Statistics(StatisticsRegistry* registry) :
     d_statClausesLiterals("sat::clauses_literals"),
     d_statLearntsLiterals("sat::learnts_literals"),
     d_statMaxLiterals("sat::max_literals"),
-    d_statTotLiterals("sat::tot_literals")
+    d_statTotLiterals("sat::tot_literals"),
+    d_statInprocessRounds("sat::inprocess_rounds"),
+    d_statInprocessSubsumed("sat::inprocess_subsumed"),
+    d_statInprocessStrengthened("sat::inprocess_strengthened"),
+    d_statInprocessVivified("sat::inprocess_vivified"),
+    d_statChronoBacktracks("sat::chrono_backtracks"),
+    d_statArenaBytes("sat::arena_bytes"),
+    d_statPbPropagations("sat::pb_propagations"),
+    d_statPbConflicts("sat::pb_conflicts")
 {
   d_registry->registerStat(&d_statStarts);
   d_registry->registerStat(&d_statDecisions);
@@ -255,6 +316,31 @@ MinisatSatSolver::Statistics::Statistics(StatisticsRegistry* registry) :
   d_registry->registerStat(&d_statLearntsLiterals);
   d_registry->registerStat(&d_statMaxLiterals);
   d_registry->registerStat(&d_statTotLiterals);
+  d_registry->registerStat(&d_statInprocessRounds);
+  d_registry->registerStat(&d_statInprocessSubsumed);
+  d_registry->registerStat(&d_statInprocessStrengthened);
+  d_registry->registerStat(&d_statInprocessVivified);
+  d_registry->registerStat(&d_statChronoBacktracks);
+  d_registry->registerStat(&d_statArenaBytes);
+  d_registry->registerStat(&d_statPbPropagations);
+  d_registry->registerStat(&d_statPbConflicts);
+  for (theory::TheoryId id = theory::THEORY_FIRST; id < theory::THEORY_LAST;
+       ++id)
+  {
+    std::string prefix = theory::getStatsPrefix(id);
+    d_statLemmaClauses.emplace_back(
+        new ReferenceStat<uint64_t>(prefix + "::satLemmaClauses"));
+    d_registry->registerStat(d_statLemmaClauses.back().get());
+    if (options::satLemmaUseStats())
+    {
+      d_statLemmaPropagations.emplace_back(
+          new ReferenceStat<uint64_t>(prefix + "::satLemmaPropagations"));
+      d_registry->registerStat(d_statLemmaPropagations.back().get());
+      d_statLemmaConflicts.emplace_back(
+          new ReferenceStat<uint64_t>(prefix + "::satLemmaConflicts"));
+      d_registry->registerStat(d_statLemmaConflicts.back().get());
+    }
+  }
 }
 
 MinisatSatSolver::Statistics::~Statistics() {
@@ -267,6 +353,28 @@ MinisatSatSolver::Statistics::~Statistics() {
   d_registry->unregisterStat(&d_statLearntsLiterals);
   d_registry->unregisterStat(&d_statMaxLiterals);
   d_registry->unregisterStat(&d_statTotLiterals);
+  d_registry->unregisterStat(&d_statInprocessRounds);
+  d_registry->unregisterStat(&d_statInprocessSubsumed);
+  d_registry->unregisterStat(&d_statInprocessStrengthened);
+  d_registry->unregisterStat(&d_statInprocessVivified);
+  d_registry->unregisterStat(&d_statChronoBacktracks);
+  d_registry->unregisterStat(&d_statArenaBytes);
+  d_registry->unregisterStat(&d_statPbPropagations);
+  d_registry->unregisterStat(&d_statPbConflicts);
+  for (const std::unique_ptr<ReferenceStat<uint64_t> >& s : d_statLemmaClauses)
+  {
+    d_registry->unregisterStat(s.get());
+  }
+  for (const std::unique_ptr<ReferenceStat<uint64_t> >& s :
+       d_statLemmaPropagations)
+  {
+    d_registry->unregisterStat(s.get());
+  }
+  for (const std::unique_ptr<ReferenceStat<uint64_t> >& s :
+       d_statLemmaConflicts)
+  {
+    d_registry->unregisterStat(s.get());
+  }
 }
 
 void MinisatSatSolver::Statistics::init(Minisat::SimpSolver* d_minisat){
@@ -279,6 +387,23 @@ void MinisatSatSolver::Statistics::init(Minisat::SimpSolver* d_minisat){
   d_statLearntsLiterals.setData(d_minisat->learnts_literals);
   d_statMaxLiterals.setData(d_minisat->max_literals);
   d_statTotLiterals.setData(d_minisat->tot_literals);
+  d_statInprocessRounds.setData(d_minisat->inprocess_rounds);
+  d_statInprocessSubsumed.setData(d_minisat->inprocess_subsumed);
+  d_statInprocessStrengthened.setData(d_minisat->inprocess_strengthened);
+  d_statInprocessVivified.setData(d_minisat->inprocess_vivified);
+  d_statChronoBacktracks.setData(d_minisat->chrono_backtracks);
+  d_statArenaBytes.setData(d_minisat->arena_bytes);
+  d_statPbPropagations.setData(d_minisat->pb_propagations);
+  d_statPbConflicts.setData(d_minisat->pb_conflicts);
+  for (size_t i = 0, size = d_statLemmaClauses.size(); i < size; ++i)
+  {
+    d_statLemmaClauses[i]->setData(d_minisat->lemma_clauses[i + 1]);
+  }
+  for (size_t i = 0, size = d_statLemmaPropagations.size(); i < size; ++i)
+  {
+    d_statLemmaPropagations[i]->setData(d_minisat->lemma_propagations[i + 1]);
+    d_statLemmaConflicts[i]->setData(d_minisat->lemma_conflicts[i + 1]);
+  }
 }
 
 } /* namespace CVC4::prop */
@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "prop/sat_solver.h"
 #include "prop/minisat/simp/SimpSolver.h"
 #include "util/statistics_registry.h"
@@ -45,6 +48,9 @@ public:
   {
     Unreachable() << "Minisat does not support native XOR reasoning";
   }
+  bool addPbConstraint(const SatClause& lits,
+                       const std::vector<int64_t>& coeffs,
+                       int64_t bound) override;
 
   SatVariable newVar(bool isTheoryAtom,
                      bool preRegister,
@@ -79,6 +85,18 @@ public:
 
   bool isDecision(SatVariable decn) const override;
 
+  bool hasActivities() const override { return true; }
+
+  double getActivity(SatVariable var) const override;
+
+  bool getDecisionHint(SatVariable var,
+                       bool& phase,
+                       double& activity) const override;
+
+  void setDecisionHint(SatVariable var, bool phase, double activity) override;
+
+  void setLemmaSource(theory::TheoryId source) override;
+
  private:
 
   /** The SatSolver used */
@@ -97,6 +115,18 @@ public:
     ReferenceStat<uint64_t> d_statConflicts, d_statClausesLiterals;
     ReferenceStat<uint64_t> d_statLearntsLiterals,  d_statMaxLiterals;
     ReferenceStat<uint64_t> d_statTotLiterals;
+    ReferenceStat<uint64_t> d_statInprocessRounds, d_statInprocessSubsumed;
+    ReferenceStat<uint64_t> d_statInprocessStrengthened, d_statInprocessVivified;
+    ReferenceStat<uint64_t> d_statChronoBacktracks, d_statArenaBytes;
+    ReferenceStat<uint64_t> d_statPbPropagations, d_statPbConflicts;
+    /**
+     * The lemma clauses of each theory, and with --sat-lemma-use-stats their
+     * propagations and conflicts
+     */
+    std::vector<std::unique_ptr<ReferenceStat<uint64_t> > > d_statLemmaClauses;
+    std::vector<std::unique_ptr<ReferenceStat<uint64_t> > >
+        d_statLemmaPropagations;
+    std::vector<std::unique_ptr<ReferenceStat<uint64_t> > > d_statLemmaConflicts;
   public:
     Statistics(StatisticsRegistry* registry);
     ~Statistics();
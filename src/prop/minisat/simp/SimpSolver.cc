@@ -573,6 +573,8 @@ bool SimpSolver::eliminateVar(Var v)
     // Free watchers lists for this variable, if possible:
     if (watches[ mkLit(v)].size() == 0) watches[ mkLit(v)].clear(true);
     if (watches[~mkLit(v)].size() == 0) watches[~mkLit(v)].clear(true);
+    if (bin_watches[ mkLit(v)].size() == 0) bin_watches[ mkLit(v)].clear(true);
+    if (bin_watches[~mkLit(v)].size() == 0) bin_watches[~mkLit(v)].clear(true);
 
     return backwardSubsumptionCheck();
 }
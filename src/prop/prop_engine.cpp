@@ -16,8 +16,12 @@
 
 #include "prop/prop_engine.h"
 
+#include <algorithm>
+#include <fstream>
 #include <iomanip>
 #include <map>
+#include <sstream>
+#include <unordered_map>
 #include <utility>
 
 #include "base/check.h"
@@ -28,6 +32,7 @@
 #include "options/decision_options.h"
 #include "options/main_options.h"
 #include "options/options.h"
+#include "options/prop_options.h"
 #include "options/smt_options.h"
 #include "proof/proof_manager.h"
 #include "prop/cnf_stream.h"
@@ -38,6 +43,7 @@
 #include "smt/smt_statistics_registry.h"
 #include "theory/theory_engine.h"
 #include "theory/theory_registrar.h"
+#include "util/phase_profiler.h"
 #include "util/resource_manager.h"
 #include "util/result.h"
 
@@ -79,7 +85,8 @@ PropEngine::PropEngine(TheoryEngine* te,
                        UserContext* userContext,
                        std::ostream* replayLog,
                        ExprStream* replayStream)
-    : d_inCheckSat(false),
+    : d_decisionHintsLoaded(false),
+      d_inCheckSat(false),
       d_theoryEngine(te),
       d_context(satContext),
       d_theoryProxy(NULL),
@@ -95,7 +102,14 @@ PropEngine::PropEngine(TheoryEngine* te,
   d_decisionEngine.reset(new DecisionEngine(satContext, userContext));
   d_decisionEngine->init();  // enable appropriate strategies
 
-  d_satSolver = SatSolverFactory::createDPLLMinisat(smtStatisticsRegistry());
+  if (options::satSolver() == options::PropSatSolverMode::CADICAL)
+  {
+    d_satSolver = SatSolverFactory::createDPLLCadical(smtStatisticsRegistry());
+  }
+  else
+  {
+    d_satSolver = SatSolverFactory::createDPLLMinisat(smtStatisticsRegistry());
+  }
 
   d_registrar = new theory::TheoryRegistrar(d_theoryEngine);
   d_cnfStream = new CVC4::prop::TseitinCnfStream(
@@ -105,6 +119,7 @@ PropEngine::PropEngine(TheoryEngine* te,
                                   d_theoryEngine,
                                   d_decisionEngine.get(),
                                   d_context,
+                                  userContext,
                                   d_cnfStream,
                                   replayLog,
                                   replayStream);
@@ -130,19 +145,92 @@ PropEngine::~PropEngine() {
 void PropEngine::assertFormula(TNode node) {
   Assert(!d_inCheckSat) << "Sat solver in solve()!";
   Debug("prop") << "assertFormula(" << node << ")" << endl;
+  PhaseScope phase("cnf");
+  if (options::relevancy())
+  {
+    d_theoryProxy->notifyInputFormula(node);
+  }
   // Assert as non-removable
   d_cnfStream->convertAndAssert(node, false, false, RULE_GIVEN);
 }
 
+void PropEngine::assertFormulas(const std::vector<Node>& nodes,
+                                unsigned threads)
+{
+  Assert(!d_inCheckSat) << "Sat solver in solve()!";
+  Debug("prop") << "assertFormulas(" << nodes.size() << " formulas)" << endl;
+  PhaseScope phase("cnf");
+  if (options::relevancy())
+  {
+    for (const Node& n : nodes)
+    {
+      d_theoryProxy->notifyInputFormula(n);
+    }
+  }
+  // Assert as non-removable
+  d_cnfStream->convertAndAssertBatch(nodes, false, RULE_GIVEN, threads);
+}
+
+void PropEngine::assertDimacsClauses(const std::vector<int>& literals)
+{
+  Assert(!d_inCheckSat) << "Sat solver in solve()!";
+  Debug("prop") << "assertDimacsClauses(" << literals.size() << " literals)"
+                << endl;
+  SatClause clause;
+  for (int lit : literals)
+  {
+    if (lit == 0)
+    {
+      // Assert as non-removable
+      d_satSolver->addClause(clause, false);
+      clause.clear();
+      continue;
+    }
+    size_t v = static_cast<size_t>(lit < 0 ? -static_cast<int64_t>(lit) : lit);
+    while (d_dimacsVars.size() < v)
+    {
+      d_dimacsVars.push_back(d_satSolver->newVar(false, false, false));
+    }
+    clause.push_back(SatLiteral(d_dimacsVars[v - 1], lit < 0));
+  }
+  Assert(clause.empty()) << "DIMACS clause not terminated by 0";
+}
+
+bool PropEngine::assertPbConstraint(const std::vector<Node>& atoms,
+                                    const std::vector<int64_t>& coeffs,
+                                    int64_t bound)
+{
+  Assert(!d_inCheckSat) << "Sat solver in solve()!";
+  Assert(atoms.size() == coeffs.size());
+  Debug("prop") << "assertPbConstraint(" << atoms.size() << " atoms, " << bound
+                << ")" << endl;
+  PhaseScope phase("cnf");
+  SatClause lits;
+  for (const Node& atom : atoms)
+  {
+    d_cnfStream->ensureLiteral(atom);
+    lits.push_back(d_cnfStream->getLiteral(atom));
+  }
+  return d_satSolver->addPbConstraint(lits, coeffs, bound);
+}
+
 void PropEngine::assertLemma(TNode node, bool negated,
                              bool removable,
                              ProofRule rule,
-                             TNode from) {
+                             TNode from,
+                             theory::TheoryId source) {
   //Assert(d_inCheckSat, "Sat solver should be in solve()!");
   Debug("prop::lemmas") << "assertLemma(" << node << ")" << endl;
+  PhaseScope phase("cnf");
+  if (options::relevancy())
+  {
+    d_theoryProxy->notifyLemma(node);
+  }
 
   // Assert as (possibly) removable
+  d_satSolver->setLemmaSource(source);
   d_cnfStream->convertAndAssert(node, removable, negated, rule, from);
+  d_satSolver->setLemmaSource(theory::THEORY_LAST);
 }
 
 void PropEngine::addAssertionsToDecisionEngine(
@@ -164,6 +252,12 @@ bool PropEngine::isDecision(Node lit) const {
   return d_satSolver->isDecision(d_cnfStream->getLiteral(lit).getSatVariable());
 }
 
+void PropEngine::setClauseSharing(ClauseSharing* sharing,
+                                  const std::vector<Node>& atoms)
+{
+  d_theoryProxy->setClauseSharing(sharing, atoms);
+}
+
 void PropEngine::printSatisfyingAssignment(){
   const CnfStream::NodeToLiteralMap& transCache =
     d_cnfStream->getTranslationCache();
@@ -187,6 +281,7 @@ void PropEngine::printSatisfyingAssignment(){
 Result PropEngine::checkSat() {
   Assert(!d_inCheckSat) << "Sat solver in solve()!";
   Debug("prop") << "PropEngine::checkSat()" << endl;
+  PhaseScope phase("sat");
 
   // Mark that we are in the checkSat
   ScopedBool scopedBool(d_inCheckSat);
@@ -202,9 +297,25 @@ Result PropEngine::checkSat() {
   // Reset the interrupted flag
   d_interrupted = false;
 
+  if (!d_decisionHintsLoaded && !options::satHintsLoad().empty())
+  {
+    d_decisionHintsLoaded = true;
+    loadDecisionHints(options::satHintsLoad());
+  }
+
+  if (d_theoryProxy->isSharingClauses())
+  {
+    d_theoryProxy->mapSharedAtoms();
+  }
+
   // Check the problem
   SatValue result = d_satSolver->solve();
 
+  if (!options::satHintsSave().empty())
+  {
+    saveDecisionHints(options::satHintsSave());
+  }
+
   if( result == SAT_VALUE_UNKNOWN ) {
 
     Result::UnknownExplanation why = Result::INTERRUPTED;
@@ -212,6 +323,8 @@ Result PropEngine::checkSat() {
       why = Result::TIMEOUT;
     if (d_resourceManager->outOfResources())
       why = Result::RESOURCEOUT;
+    if (d_resourceManager->outOfMemory())
+      why = Result::MEMOUT;
 
     return Result(Result::SAT_UNKNOWN, why);
   }
@@ -227,6 +340,115 @@ Result PropEngine::checkSat() {
   return Result(result == SAT_VALUE_TRUE ? Result::SAT : Result::UNSAT);
 }
 
+namespace {
+
+/**
+ * Returns true if n is an atom of the Boolean structure, i.e. not a Boolean
+ * connective.
+ */
+bool isAtom(TNode n)
+{
+  switch (n.getKind())
+  {
+    case kind::CONST_BOOLEAN:
+    case kind::NOT:
+    case kind::AND:
+    case kind::OR:
+    case kind::XOR:
+    case kind::IMPLIES:
+    case kind::ITE: return false;
+    case kind::EQUAL: return !n[0].getType().isBoolean();
+    default: return true;
+  }
+}
+
+}  // namespace
+
+void PropEngine::saveDecisionHints(const std::string& file)
+{
+  std::vector<std::string> keys;
+  std::vector<bool> phases;
+  std::vector<double> activities;
+  double maxActivity = 0;
+  for (const std::pair<const Node, SatLiteral>& nl :
+       d_cnfStream->getTranslationCache())
+  {
+    bool phase;
+    double activity;
+    if (!isAtom(nl.first)
+        || !d_satSolver->getDecisionHint(
+               nl.second.getSatVariable(), phase, activity))
+    {
+      continue;
+    }
+    std::stringstream ss;
+    ss << nl.first;
+    keys.push_back(ss.str());
+    phases.push_back(phase != nl.second.isNegated());
+    activities.push_back(activity);
+    maxActivity = std::max(maxActivity, activity);
+  }
+  std::ofstream out(file);
+  if (!out)
+  {
+    Warning() << "cannot write the SAT hints to " << file << std::endl;
+    return;
+  }
+  for (size_t i = 0, size = keys.size(); i < size; ++i)
+  {
+    out << phases[i] << " "
+        << (maxActivity > 0 ? activities[i] / maxActivity : 0) << " "
+        << keys[i] << std::endl;
+  }
+  Trace("sat-hints") << "Saved " << keys.size() << " SAT hints to " << file
+                     << std::endl;
+}
+
+void PropEngine::loadDecisionHints(const std::string& file)
+{
+  std::ifstream in(file);
+  if (!in)
+  {
+    Warning() << "cannot read the SAT hints from " << file << std::endl;
+    return;
+  }
+  std::unordered_map<std::string, std::pair<bool, double>> hints;
+  std::string line;
+  while (std::getline(in, line))
+  {
+    std::stringstream ss(line);
+    bool phase;
+    double activity;
+    std::string key;
+    if (ss >> phase >> activity && ss.get() == ' ' && std::getline(ss, key))
+    {
+      hints[key] = std::make_pair(phase, activity);
+    }
+  }
+  size_t nset = 0;
+  for (const std::pair<const Node, SatLiteral>& nl :
+       d_cnfStream->getTranslationCache())
+  {
+    if (!isAtom(nl.first))
+    {
+      continue;
+    }
+    std::stringstream ss;
+    ss << nl.first;
+    std::unordered_map<std::string, std::pair<bool, double>>::iterator it =
+        hints.find(ss.str());
+    if (it != hints.end())
+    {
+      d_satSolver->setDecisionHint(nl.second.getSatVariable(),
+                                   it->second.first != nl.second.isNegated(),
+                                   it->second.second);
+      ++nset;
+    }
+  }
+  Trace("sat-hints") << "Set " << nset << " of " << hints.size()
+                     << " SAT hints from " << file << std::endl;
+}
+
 Node PropEngine::getValue(TNode node) const {
   Assert(node.getType().isBoolean());
   Assert(d_cnfStream->hasLiteral(node));
@@ -29,12 +29,15 @@
 #include "options/options.h"
 #include "preprocessing/assertion_pipeline.h"
 #include "proof/proof_manager.h"
+#include "prop/sat_solver_types.h"
+#include "theory/theory_id.h"
 #include "util/resource_manager.h"
 #include "util/result.h"
 #include "util/unsafe_interrupt_exception.h"
 
 namespace CVC4 {
 
+class ClauseSharing;
 class ResourceManager;
 class DecisionEngine;
 class TheoryEngine;
@@ -87,6 +90,40 @@ class PropEngine
    */
   void assertFormula(TNode node);
 
+  /**
+   * Converts the given formulas to CNF and asserts the CNF to the SAT solver,
+   * in order.  The result is the same as calling assertFormula() on each of
+   * them, but the translation may use up to the given number of threads.
+   * @param nodes the formulas to assert
+   * @param threads the maximal number of threads
+   */
+  void assertFormulas(const std::vector<Node>& nodes, unsigned threads);
+
+  /**
+   * Asserts clauses given in DIMACS form directly to the SAT solver, without
+   * converting any formula. The literals are the nonzero integers v (for
+   * variable v) and -v (for its negation), and each clause is terminated by
+   * 0. The DIMACS variable v is a fresh SAT variable, created the first time
+   * v is used, that is not associated with any node. The clauses are
+   * asserted permanently for the current context.
+   * @param literals the literals of the clauses
+   */
+  void assertDimacsClauses(const std::vector<int>& literals);
+
+  /**
+   * Asserts the pseudo-Boolean constraint sum coeffs[i] * atoms[i] >= bound
+   * directly to the SAT solver, which propagates it natively. The atoms are
+   * Boolean formulas, whose literals are created if they do not exist yet.
+   * Returns false if the SAT solver does not support pseudo-Boolean
+   * constraints, in which case nothing is asserted.
+   * @param atoms the Boolean atoms of the constraint
+   * @param coeffs the coefficients of the atoms
+   * @param bound the lower bound of the sum
+   */
+  bool assertPbConstraint(const std::vector<Node>& atoms,
+                          const std::vector<int64_t>& coeffs,
+                          int64_t bound);
+
   /**
    * Converts the given formula to CNF and assert the CNF to the SAT solver.
    * The formula can be removed by the SAT solver after backtracking lower
@@ -97,12 +134,15 @@ class PropEngine
    * at the top level (or not)
    * @param removable whether this lemma can be quietly removed based
    * on an activity heuristic (or not)
+   * @param source the theory that sent the lemma, or THEORY_LAST, which
+   * the SAT solver records with its clauses
    */
   void assertLemma(TNode node,
                    bool negated,
                    bool removable,
                    ProofRule rule,
-                   TNode from = TNode::null());
+                   TNode from = TNode::null(),
+                   theory::TheoryId source = theory::THEORY_LAST);
 
   /**
    * Pass a list of assertions from an AssertionPipeline to the decision engine.
@@ -128,6 +168,12 @@ class PropEngine
    */
   bool isDecision(Node lit) const;
 
+  /**
+   * Share the short learned clauses of the SAT solver over atoms with other
+   * solvers through sharing, see SmtEngine::setClauseSharing().
+   */
+  void setClauseSharing(ClauseSharing* sharing, const std::vector<Node>& atoms);
+
   /**
    * Checks the current context for satisfiability.
    *
@@ -219,6 +265,19 @@ class PropEngine
  private:
   /** Dump out the satisfying assignment (after SAT result) */
   void printSatisfyingAssignment();
+  /**
+   * Save the phases and activities of the atoms of the SAT solver to file,
+   * one atom per line. The atoms are identified by their printed form and
+   * the activities are relative to the largest one.
+   */
+  void saveDecisionHints(const std::string& file);
+  /**
+   * Set the phases and activities of the atoms of the SAT solver that have
+   * the same printed form as an atom saved in file by saveDecisionHints.
+   */
+  void loadDecisionHints(const std::string& file);
+  /** Whether the decision hints have been loaded */
+  bool d_decisionHintsLoaded;
   /**
    * Indicates that the SAT solver is currently solving something and we should
    * not mess with it's internal state.
@@ -249,6 +308,9 @@ class PropEngine
   /** The CNF converter in use */
   CnfStream* d_cnfStream;
 
+  /** The SAT variables of the DIMACS variables 1, 2, ... */
+  std::vector<SatVariable> d_dimacsVars;
+
   /** Whether we were just interrupted (or not) */
   bool d_interrupted;
   /** Pointer to resource manager for associated SmtEngine */
@@ -22,6 +22,7 @@
 #include <stdint.h>
 
 #include <string>
+#include <vector>
 
 #include "context/cdlist.h"
 #include "context/context.h"
@@ -29,6 +30,7 @@
 #include "proof/clause_id.h"
 #include "prop/sat_solver_types.h"
 #include "prop/bv_sat_solver_notify.h"
+#include "theory/theory_id.h"
 #include "util/statistics_registry.h"
 
 namespace CVC4 {
@@ -155,6 +157,58 @@ class DPLLSatSolverInterface : public SatSolver
   virtual void requirePhase(SatLiteral lit) = 0;
 
   virtual bool isDecision(SatVariable decn) const = 0;
+
+  /**
+   * Returns true if the SAT solver exposes the activities and the phases of
+   * its variables, i.e. if it implements getActivity and getDecisionHint.
+   */
+  virtual bool hasActivities() const { return false; }
+
+  /**
+   * Returns the activity of the variable var in the decision heuristic of
+   * the SAT solver, i.e. a score that increases with its recent involvement
+   * in conflicts. It is 0 for all variables if !hasActivities().
+   */
+  virtual double getActivity(SatVariable var) const { return 0; }
+
+  /**
+   * Gets the preferred value of the variable var in the next decision on it,
+   * and its activity (see getActivity), returns false if the SAT solver does
+   * not have them, which is always the case if !hasActivities().
+   */
+  virtual bool getDecisionHint(SatVariable var,
+                               bool& phase,
+                               double& activity) const
+  {
+    return false;
+  }
+
+  /**
+   * Sets the preferred value of the variable var in the decisions on it, if
+   * its phase is not required by requirePhase, and increases its activity by
+   * activity times the current activity increment.
+   */
+  virtual void setDecisionHint(SatVariable var, bool phase, double activity) = 0;
+
+  /**
+   * Adds the pseudo-Boolean constraint sum coeffs[i] * lits[i] >= bound, to
+   * be propagated natively, before solving and at assertion level 0. Returns
+   * false if the SAT solver does not support such constraints, in which case
+   * it is not added.
+   */
+  virtual bool addPbConstraint(const SatClause& lits,
+                               const std::vector<int64_t>& coeffs,
+                               int64_t bound)
+  {
+    return false;
+  }
+
+  /**
+   * Sets the theory that sent the clauses added from now on, or THEORY_LAST
+   * if they are not lemmas, for the SAT solvers that record the use of the
+   * lemmas of each theory.
+   */
+  virtual void setLemmaSource(theory::TheoryId source) {}
 }; /* class DPLLSatSolverInterface */
 
 inline std::ostream& operator <<(std::ostream& out, prop::SatLiteral lit) {
@@ -18,6 +18,7 @@
 
 #include "prop/bvminisat/bvminisat.h"
 #include "prop/cadical.h"
+#include "prop/cadical_dpll.h"
 #include "prop/cryptominisat.h"
 #include "prop/minisat/minisat.h"
 
@@ -38,6 +39,17 @@ DPLLSatSolverInterface* SatSolverFactory::createDPLLMinisat(
   return new MinisatSatSolver(registry);
 }
 
+DPLLSatSolverInterface* SatSolverFactory::createDPLLCadical(
+    StatisticsRegistry* registry)
+{
+#ifdef CVC4_USE_CADICAL_PROPAGATOR
+  return new CadicalDPLLSatSolver(registry);
+#else
+  Unreachable() << "CVC4 was not compiled with a CaDiCaL that provides the "
+                   "external propagator interface.";
+#endif
+}
+
 SatSolver* SatSolverFactory::createCryptoMinisat(StatisticsRegistry* registry,
                                                  const std::string& name)
 {
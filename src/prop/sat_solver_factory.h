@@ -39,6 +39,9 @@ class SatSolverFactory
   static DPLLSatSolverInterface* createDPLLMinisat(
       StatisticsRegistry* registry);
 
+  static DPLLSatSolverInterface* createDPLLCadical(
+      StatisticsRegistry* registry);
+
   static SatSolver* createCryptoMinisat(StatisticsRegistry* registry,
                                         const std::string& name = "");
 
@@ -19,7 +19,9 @@
 #include "context/context.h"
 #include "decision/decision_engine.h"
 #include "expr/expr_stream.h"
+#include "expr/node_traversal.h"
 #include "options/decision_options.h"
+#include "options/prop_options.h"
 #include "prop/cnf_stream.h"
 #include "prop/prop_engine.h"
 #include "proof/cnf_proof.h"
@@ -33,10 +35,13 @@
 namespace CVC4 {
 namespace prop {
 
+const uint32_t TheoryProxy::s_notShared;
+
 TheoryProxy::TheoryProxy(PropEngine* propEngine,
                          TheoryEngine* theoryEngine,
                          DecisionEngine* decisionEngine,
                          context::Context* context,
+                         context::UserContext* userContext,
                          CnfStream* cnfStream,
                          std::ostream* replayLog,
                          ExprStream* replayStream)
@@ -47,14 +52,32 @@ TheoryProxy::TheoryProxy(PropEngine* propEngine,
       d_replayLog(replayLog),
       d_replayStream(replayStream),
       d_queue(context),
-      d_replayedDecisions("prop::theoryproxy::replayedDecisions", 0)
+      d_inputFormulas(userContext),
+      d_eagerAtoms(userContext),
+      d_delayed(context),
+      d_delayedAsserted(context),
+      d_clauseSharing(nullptr),
+      d_replayedDecisions("prop::theoryproxy::replayedDecisions", 0),
+      d_delayedLiterals("prop::theoryproxy::delayedLiterals", 0),
+      d_relevantDelayedLiterals("prop::theoryproxy::relevantDelayedLiterals",
+                                0),
+      d_exportedClauses("prop::theoryproxy::exportedClauses", 0),
+      d_importedClauses("prop::theoryproxy::importedClauses", 0)
 {
   smtStatisticsRegistry()->registerStat(&d_replayedDecisions);
+  smtStatisticsRegistry()->registerStat(&d_delayedLiterals);
+  smtStatisticsRegistry()->registerStat(&d_relevantDelayedLiterals);
+  smtStatisticsRegistry()->registerStat(&d_exportedClauses);
+  smtStatisticsRegistry()->registerStat(&d_importedClauses);
 }
 
 TheoryProxy::~TheoryProxy() {
   /* nothing to do for now */
   smtStatisticsRegistry()->unregisterStat(&d_replayedDecisions);
+  smtStatisticsRegistry()->unregisterStat(&d_delayedLiterals);
+  smtStatisticsRegistry()->unregisterStat(&d_relevantDelayedLiterals);
+  smtStatisticsRegistry()->unregisterStat(&d_exportedClauses);
+  smtStatisticsRegistry()->unregisterStat(&d_importedClauses);
 }
 
 void TheoryProxy::variableNotify(SatVariable var) {
@@ -62,14 +85,167 @@ void TheoryProxy::variableNotify(SatVariable var) {
 }
 
 void TheoryProxy::theoryCheck(theory::Theory::Effort effort) {
+  bool relevancy = options::relevancy();
   while (!d_queue.empty()) {
     TNode assertion = d_queue.front();
     d_queue.pop();
+    if (relevancy
+        && !d_eagerAtoms.contains(assertion.getKind() == kind::NOT
+                                      ? assertion[0]
+                                      : assertion))
+    {
+      d_delayed.push_back(assertion);
+      ++d_delayedLiterals;
+      continue;
+    }
     d_theoryEngine->assertFact(assertion);
   }
+  if (relevancy && effort == theory::Theory::EFFORT_FULL)
+  {
+    assertRelevantDelayed();
+  }
   d_theoryEngine->check(effort);
 }
 
+void TheoryProxy::notifyInputFormula(TNode n) { d_inputFormulas.push_back(n); }
+
+/** Returns true if n is a Boolean connective that the CNF stream converts. */
+static bool isBooleanConnective(TNode n)
+{
+  switch (n.getKind())
+  {
+    case kind::NOT:
+    case kind::AND:
+    case kind::OR:
+    case kind::IMPLIES:
+    case kind::XOR: return true;
+    case kind::ITE:
+    case kind::EQUAL: return n[1].getType().isBoolean();
+    default: return false;
+  }
+}
+
+void TheoryProxy::notifyLemma(TNode n)
+{
+  expr::NodeIdSet visited;
+  std::vector<TNode> visit{n};
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    if (!visited.insert(cur))
+    {
+      continue;
+    }
+    if (isBooleanConnective(cur))
+    {
+      visit.insert(visit.end(), cur.begin(), cur.end());
+    }
+    else
+    {
+      d_eagerAtoms.insert(cur);
+    }
+  }
+}
+
+void TheoryProxy::assertRelevantDelayed()
+{
+  // the value of a formula, or SAT_VALUE_UNKNOWN if it has no literal
+  auto value = [this](TNode f) {
+    return d_cnfStream->hasLiteral(f)
+               ? d_decisionEngine->getSatValue(d_cnfStream->getLiteral(f))
+               : SAT_VALUE_UNKNOWN;
+  };
+  std::unordered_set<TNode, TNodeHashFunction> relevant;
+  expr::NodeIdSet visited;
+  // the formulas to visit, with their values
+  std::vector<std::pair<TNode, SatValue> > visit;
+  for (const Node& f : d_inputFormulas)
+  {
+    visit.push_back(std::make_pair(f, SAT_VALUE_TRUE));
+  }
+  while (!visit.empty())
+  {
+    TNode cur = visit.back().first;
+    SatValue val = visit.back().second;
+    visit.pop_back();
+    while (cur.getKind() == kind::NOT)
+    {
+      cur = cur[0];
+      val = invertValue(val);
+    }
+    if (!visited.insert(cur))
+    {
+      continue;
+    }
+    if (!isBooleanConnective(cur))
+    {
+      relevant.insert(cur);
+      continue;
+    }
+    Kind k = cur.getKind();
+    // the value of a child that satisfies cur by itself, if any
+    SatValue justifying = SAT_VALUE_UNKNOWN;
+    if ((k == kind::OR || k == kind::IMPLIES) && val == SAT_VALUE_TRUE)
+    {
+      justifying = SAT_VALUE_TRUE;
+    }
+    else if (k == kind::AND && val == SAT_VALUE_FALSE)
+    {
+      justifying = SAT_VALUE_FALSE;
+    }
+    if (justifying != SAT_VALUE_UNKNOWN)
+    {
+      // follow one justifying child, preferably one already relevant
+      TNode best;
+      for (unsigned i = 0, n = cur.getNumChildren(); i < n; ++i)
+      {
+        SatValue expected = (k == kind::IMPLIES && i == 0)
+                                ? invertValue(justifying)
+                                : justifying;
+        if (value(cur[i]) == expected
+            && (best.isNull() || visited.contains(cur[i])))
+        {
+          best = cur[i];
+        }
+      }
+      if (!best.isNull())
+      {
+        visit.push_back(std::make_pair(best, value(best)));
+        continue;
+      }
+    }
+    else if (k == kind::ITE)
+    {
+      SatValue cond = value(cur[0]);
+      visit.push_back(std::make_pair(cur[0], cond));
+      if (cond != SAT_VALUE_UNKNOWN)
+      {
+        TNode branch = cur[cond == SAT_VALUE_TRUE ? 1 : 2];
+        visit.push_back(std::make_pair(branch, value(branch)));
+        continue;
+      }
+    }
+    for (const Node& child : cur)
+    {
+      visit.push_back(std::make_pair(child, value(child)));
+    }
+  }
+  for (TNode lit : d_delayed)
+  {
+    TNode atom = lit.getKind() == kind::NOT ? lit[0] : lit;
+    if (relevant.find(atom) == relevant.end()
+        || d_delayedAsserted.contains(lit))
+    {
+      continue;
+    }
+    d_delayedAsserted.insert(lit);
+    d_eagerAtoms.insert(atom);
+    d_theoryEngine->assertFact(lit);
+    ++d_relevantDelayedLiterals;
+  }
+}
+
 void TheoryProxy::theoryPropagate(std::vector<SatLiteral>& output) {
   // Get the propagated literals
   std::vector<TNode> outputNodes;
@@ -190,6 +366,90 @@ SatValue TheoryProxy::getDecisionPolarity(SatVariable var) {
   return d_decisionEngine->getPolarity(var);
 }
 
+void TheoryProxy::setClauseSharing(ClauseSharing* sharing,
+                                   const std::vector<Node>& atoms)
+{
+  d_clauseSharing = sharing;
+  d_sharedLiterals.clear();
+  for (const Node& a : atoms)
+  {
+    d_sharedLiterals.push_back(theory::Rewriter::rewrite(a));
+  }
+}
+
+void TheoryProxy::mapSharedAtoms()
+{
+  d_sharedCodes.clear();
+  for (uint32_t i = 0, size = d_sharedLiterals.size(); i < size; ++i)
+  {
+    TNode lit = d_sharedLiterals[i];
+    bool negated = lit.getKind() == kind::NOT;
+    TNode atom = negated ? lit[0] : lit;
+    if (atom.isConst() || !d_cnfStream->hasLiteral(atom))
+    {
+      continue;
+    }
+    SatLiteral l = d_cnfStream->getLiteral(atom);
+    SatVariable var = l.getSatVariable();
+    if (var >= d_sharedCodes.size())
+    {
+      d_sharedCodes.resize(var + 1, s_notShared);
+    }
+    // atoms that are equal after rewriting share the first index
+    if (d_sharedCodes[var] == s_notShared)
+    {
+      d_sharedCodes[var] = 2 * i + (negated != l.isNegated() ? 1 : 0);
+    }
+  }
+}
+
+void TheoryProxy::exportLearnedClause(const SatClause& clause)
+{
+  std::vector<uint32_t> shared;
+  for (const SatLiteral& l : clause)
+  {
+    SatVariable var = l.getSatVariable();
+    if (var >= d_sharedCodes.size() || d_sharedCodes[var] == s_notShared)
+    {
+      return;
+    }
+    shared.push_back(d_sharedCodes[var] ^ (l.isNegated() ? 1 : 0));
+  }
+  d_clauseSharing->exportClause(shared);
+  ++d_exportedClauses;
+}
+
+void TheoryProxy::importSharedClauses(std::vector<SatClause>& clauses)
+{
+  std::vector<std::vector<uint32_t> > imported;
+  d_clauseSharing->importClauses(imported);
+  for (const std::vector<uint32_t>& c : imported)
+  {
+    SatClause clause;
+    for (uint32_t code : c)
+    {
+      if (code / 2 >= d_sharedLiterals.size())
+      {
+        break;
+      }
+      TNode lit = d_sharedLiterals[code / 2];
+      bool negated = (lit.getKind() == kind::NOT) != (code % 2 == 1);
+      TNode atom = lit.getKind() == kind::NOT ? lit[0] : lit;
+      if (atom.isConst() || !d_cnfStream->hasLiteral(atom))
+      {
+        break;
+      }
+      SatLiteral l = d_cnfStream->getLiteral(atom);
+      clause.push_back(negated ? ~l : l);
+    }
+    if (clause.size() == c.size())
+    {
+      clauses.push_back(clause);
+      ++d_importedClauses;
+    }
+  }
+}
+
 void TheoryProxy::dumpStatePop() {
   if(Dump.isOn("state")) {
     Dump("state") << PopCommand();
@@ -23,13 +23,18 @@
 // Optional blocks below will be unconditionally included
 #define CVC4_USE_MINISAT
 
+#include <cstdint>
 #include <iosfwd>
 #include <unordered_set>
+#include <vector>
 
+#include "context/cdhashset.h"
+#include "context/cdlist.h"
 #include "context/cdqueue.h"
 #include "expr/expr_stream.h"
 #include "expr/node.h"
 #include "prop/sat_solver.h"
+#include "smt/clause_sharing.h"
 #include "theory/theory.h"
 #include "util/resource_manager.h"
 #include "util/statistics_registry.h"
@@ -54,6 +59,7 @@ class TheoryProxy
               TheoryEngine* theoryEngine,
               DecisionEngine* decisionEngine,
               context::Context* context,
+              context::UserContext* userContext,
               CnfStream* cnfStream,
               std::ostream* replayLog,
               ExprStream* replayStream);
@@ -98,7 +104,54 @@ class TheoryProxy
   /** Shorthand for Dump("state") << PopCommand() */
   void dumpStatePop();
 
+  /**
+   * Notifies that the formula n is asserted as an input formula. The input
+   * formulas are the roots of the relevancy computation (see --relevancy).
+   */
+  void notifyInputFormula(TNode n);
+
+  /**
+   * Notifies that the formula n is asserted as a lemma. The atoms of the
+   * lemmas are always relevant, since the lemmas are not part of the
+   * structure of the input formulas.
+   */
+  void notifyLemma(TNode n);
+
+  /**
+   * Shares the learned clauses over atoms through sharing, see
+   * SmtEngine::setClauseSharing().  The atoms are matched with those of the
+   * CNF stream after rewriting.
+   */
+  void setClauseSharing(ClauseSharing* sharing, const std::vector<Node>& atoms);
+
+  /** Is the SAT solver to export and import learned clauses? */
+  bool isSharingClauses() const { return d_clauseSharing != nullptr; }
+
+  /**
+   * Maps the shared atoms that have a literal to their SAT variables, called
+   * before each satisfiability check.  Only the clauses over these variables
+   * are exported.
+   */
+  void mapSharedAtoms();
+
+  /** Exports the learned clause if all of its variables are shared. */
+  void exportLearnedClause(const SatClause& clause);
+
+  /**
+   * Appends the clauses of the other solvers to clauses, skipping those over
+   * shared atoms that have no literal here.
+   */
+  void importSharedClauses(std::vector<SatClause>& clauses);
+
  private:
+  /**
+   * Computes the relevant atoms under the current assignment, i.e. the atoms
+   * reached from the input formulas when only one satisfying child of each
+   * satisfied disjunction (or falsified conjunction) is followed, and
+   * asserts the delayed literals of these atoms.
+   */
+  void assertRelevantDelayed();
+
   /** The prop engine we are using. */
   PropEngine* d_propEngine;
 
@@ -120,17 +173,49 @@ class TheoryProxy
   /** Queue of asserted facts */
   context::CDQueue<TNode> d_queue;
 
+  /** The input formulas (user-context dependent) */
+  context::CDList<Node> d_inputFormulas;
+  /**
+   * The atoms whose literals are asserted without delay, i.e. the atoms of
+   * lemmas and those that were found relevant once (user-context dependent)
+   */
+  context::CDHashSet<Node, NodeHashFunction> d_eagerAtoms;
+  /** The delayed literals (SAT-context dependent) */
+  context::CDList<TNode> d_delayed;
+  /** The delayed literals that are asserted (SAT-context dependent) */
+  context::CDHashSet<Node, NodeHashFunction> d_delayedAsserted;
+
+  /** The channel of the shared learned clauses, if any */
+  ClauseSharing* d_clauseSharing;
+  /** The rewritten shared atoms, by index, which may be negations */
+  std::vector<Node> d_sharedLiterals;
   /**
-   * Set of all lemmas that have been "shared" in the portfolio---i.e.,
-   * all imported and exported lemmas.
+   * The shared literal of the positive literal of each SAT variable, see
+   * clause_sharing.h, or s_notShared
    */
-  std::unordered_set<Node, NodeHashFunction> d_shared;
+  std::vector<uint32_t> d_sharedCodes;
+  static const uint32_t s_notShared = static_cast<uint32_t>(-1);
 
   /**
    * Statistic: the number of replayed decisions (via --replay).
    */
   IntStat d_replayedDecisions;
 
+  /** Statistic: the number of delayed literals (via --relevancy). */
+  IntStat d_delayedLiterals;
+
+  /**
+   * Statistic: the number of delayed literals that were asserted after they
+   * were found relevant (via --relevancy).
+   */
+  IntStat d_relevantDelayedLiterals;
+
+  /** Statistic: the number of learned clauses exported to other solvers. */
+  IntStat d_exportedClauses;
+
+  /** Statistic: the number of learned clauses imported from other solvers. */
+  IntStat d_importedClauses;
+
 }; /* class SatSolver */
 
 }/* CVC4::prop namespace */
@@ -0,0 +1,51 @@
+/*********************                                                        */
+/*! \file clause_sharing.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The exchange of learned clauses between solvers
+ **
+ ** Solvers racing on the same problem can share the short learned clauses of
+ ** their SAT solvers.  Since the solvers have their own ExprManager, the
+ ** clauses are over the indices of a list of shared atoms that every solver
+ ** is given in its own ExprManager (see SmtEngine::setClauseSharing()): the
+ ** literal 2 * i is the i-th shared atom and the literal 2 * i + 1 is its
+ ** negation.
+ **/
+
+#include "cvc4_public.h"
+
+#ifndef CVC4__SMT__CLAUSE_SHARING_H
+#define CVC4__SMT__CLAUSE_SHARING_H
+
+#include <cstdint>
+#include <vector>
+
+namespace CVC4 {
+
+/**
+ * The channel through which a solver exports its learned clauses and imports
+ * those of the other solvers.  Both methods are called by the thread of the
+ * solver during the search, and must not block.
+ */
+class CVC4_PUBLIC ClauseSharing
+{
+ public:
+  virtual ~ClauseSharing() {}
+
+  /** Exports a clause learned by the solver, over the shared atoms. */
+  virtual void exportClause(const std::vector<uint32_t>& clause) = 0;
+
+  /** Appends the clauses exported by the other solvers to clauses. */
+  virtual void importClauses(std::vector<std::vector<uint32_t> >& clauses) = 0;
+}; /* class ClauseSharing */
+
+}  // namespace CVC4
+
+#endif /* CVC4__SMT__CLAUSE_SHARING_H */
@@ -308,6 +308,53 @@ Command* AssertCommand::clone() const
 
 std::string AssertCommand::getCommandName() const { return "assert"; }
 
+/* -------------------------------------------------------------------------- */
+/* class AssertClausesCommand                                                 */
+/* -------------------------------------------------------------------------- */
+
+AssertClausesCommand::AssertClausesCommand(std::vector<int> literals)
+    : d_literals(std::move(literals))
+{
+}
+
+const std::vector<int>& AssertClausesCommand::getLiterals() const
+{
+  return d_literals;
+}
+
+void AssertClausesCommand::invoke(SmtEngine* smtEngine)
+{
+  try
+  {
+    smtEngine->assertClauses(d_literals);
+    d_commandStatus = CommandSuccess::instance();
+  }
+  catch (UnsafeInterruptException& e)
+  {
+    d_commandStatus = new CommandInterrupted();
+  }
+  catch (exception& e)
+  {
+    d_commandStatus = new CommandFailure(e.what());
+  }
+}
+
+Command* AssertClausesCommand::exportTo(ExprManager* exprManager,
+                                        ExprManagerMapCollection& variableMap)
+{
+  return new AssertClausesCommand(d_literals);
+}
+
+Command* AssertClausesCommand::clone() const
+{
+  return new AssertClausesCommand(d_literals);
+}
+
+std::string AssertClausesCommand::getCommandName() const
+{
+  return "assert-clauses";
+}
+
 /* -------------------------------------------------------------------------- */
 /* class PushCommand                                                          */
 /* -------------------------------------------------------------------------- */
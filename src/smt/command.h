@@ -338,6 +338,29 @@ class CVC4_PUBLIC AssertCommand : public Command
   std::string getCommandName() const override;
 }; /* class AssertCommand */
 
+/**
+ * The command asserting clauses in DIMACS form, which are added directly to
+ * the SAT solver (see SmtEngine::assertClauses). It is produced by the DIMACS
+ * and OPB inputs.
+ */
+class CVC4_PUBLIC AssertClausesCommand : public Command
+{
+ public:
+  AssertClausesCommand(std::vector<int> literals);
+
+  const std::vector<int>& getLiterals() const;
+
+  void invoke(SmtEngine* smtEngine) override;
+  Command* exportTo(ExprManager* exprManager,
+                    ExprManagerMapCollection& variableMap) override;
+  Command* clone() const override;
+  std::string getCommandName() const override;
+
+ private:
+  /** The literals of the clauses, each terminated by 0 */
+  std::vector<int> d_literals;
+}; /* class AssertClausesCommand */
+
 class CVC4_PUBLIC PushCommand : public Command
 {
  public:
@@ -0,0 +1,205 @@
+/*********************                                                        */
+/*! \file cube_generator.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Lookahead-based cube generation for cube-and-conquer solving
+ **/
+
+#include "smt/cube_generator.h"
+
+#include <algorithm>
+
+#include "base/check.h"
+#include "base/output.h"
+#include "expr/kind.h"
+#include "expr/type.h"
+
+namespace CVC4 {
+
+const unsigned CubeGenerator::d_opaque;
+
+void CubeGenerator::addAssertion(Expr a) { addClauses(a, true); }
+
+bool CubeGenerator::isAtom(Expr a)
+{
+  if (!a.getType().isBoolean() || a.isConst())
+  {
+    return false;
+  }
+  switch (a.getKind())
+  {
+    case kind::NOT:
+    case kind::AND:
+    case kind::OR:
+    case kind::IMPLIES:
+    case kind::XOR:
+    case kind::ITE:
+    case kind::FORALL:
+    case kind::EXISTS: return false;
+    case kind::EQUAL: return !a[0].getType().isBoolean();
+    default: return true;
+  }
+}
+
+unsigned CubeGenerator::mkLiteral(Expr a, bool pol)
+{
+  std::map<Expr, unsigned>::const_iterator it = d_atomId.find(a);
+  unsigned id;
+  if (it == d_atomId.end())
+  {
+    id = d_atoms.size();
+    d_atomId[a] = id;
+    d_atoms.push_back(a);
+    d_occurs.resize(2 * d_atoms.size());
+  }
+  else
+  {
+    id = it->second;
+  }
+  return 2 * id + (pol ? 0 : 1);
+}
+
+void CubeGenerator::addClauses(Expr a, bool pol)
+{
+  Kind k = a.getKind();
+  if (k == kind::NOT)
+  {
+    addClauses(a[0], !pol);
+    return;
+  }
+  if ((pol && k == kind::AND) || (!pol && k == kind::OR))
+  {
+    for (unsigned i = 0, n = a.getNumChildren(); i < n; ++i)
+    {
+      addClauses(a[i], pol);
+    }
+    return;
+  }
+  if (!pol && k == kind::IMPLIES)
+  {
+    addClauses(a[0], true);
+    addClauses(a[1], false);
+    return;
+  }
+  std::vector<unsigned> c;
+  collectDisjuncts(a, pol, c);
+  size_t index = d_clauses.size();
+  for (unsigned l : c)
+  {
+    if (l != d_opaque)
+    {
+      d_occurs[l].push_back(index);
+    }
+  }
+  d_clauses.push_back(c);
+}
+
+void CubeGenerator::collectDisjuncts(Expr a,
+                                     bool pol,
+                                     std::vector<unsigned>& c)
+{
+  Kind k = a.getKind();
+  if (k == kind::NOT)
+  {
+    collectDisjuncts(a[0], !pol, c);
+  }
+  else if ((pol && k == kind::OR) || (!pol && k == kind::AND))
+  {
+    for (unsigned i = 0, n = a.getNumChildren(); i < n; ++i)
+    {
+      collectDisjuncts(a[i], pol, c);
+    }
+  }
+  else if (pol && k == kind::IMPLIES)
+  {
+    collectDisjuncts(a[0], false, c);
+    collectDisjuncts(a[1], true, c);
+  }
+  else if (isAtom(a))
+  {
+    c.push_back(mkLiteral(a, pol));
+  }
+  else
+  {
+    c.push_back(d_opaque);
+  }
+}
+
+double CubeGenerator::getReduction(unsigned l) const
+{
+  // assigning l shrinks the clauses that contain its negation
+  double w = 0.0;
+  for (size_t index : d_occurs[l ^ 1])
+  {
+    // a falsified unit is a conflict, a shrunk binary clause propagates,
+    // and longer clauses count for less the longer they are
+    size_t len = d_clauses[index].size();
+    if (len <= 1)
+    {
+      w += 4.0;
+    }
+    else
+    {
+      w += 1.0 / double(size_t(1) << std::min<size_t>(len - 2, 30));
+    }
+  }
+  return w;
+}
+
+double CubeGenerator::getScore(unsigned id) const
+{
+  double wpos = getReduction(2 * id);
+  double wneg = getReduction(2 * id + 1);
+  return (1.0 + wpos) * (1.0 + wneg) - 1.0;
+}
+
+double CubeGenerator::getScore(Expr a) const
+{
+  std::map<Expr, unsigned>::const_iterator it = d_atomId.find(a);
+  return it == d_atomId.end() ? 0.0 : getScore(it->second);
+}
+
+std::vector<std::vector<Expr> > CubeGenerator::getCubes(unsigned depth)
+{
+  std::vector<std::pair<double, unsigned> > scored;
+  for (unsigned i = 0, n = d_atoms.size(); i < n; ++i)
+  {
+    double score = getScore(i);
+    if (score > 0.0)
+    {
+      // negate the id so that ties go to the atom seen first
+      scored.push_back(std::make_pair(score, n - i));
+    }
+  }
+  std::sort(scored.rbegin(), scored.rend());
+  size_t k = std::min<size_t>(std::min<size_t>(depth, scored.size()), 20);
+
+  std::vector<Expr> split;
+  for (size_t j = 0; j < k; ++j)
+  {
+    split.push_back(d_atoms[d_atoms.size() - scored[j].second]);
+    Trace("cubes") << "split on " << split.back() << ", score "
+                   << scored[j].first << std::endl;
+  }
+
+  std::vector<std::vector<Expr> > cubes;
+  for (size_t mask = 0, nmasks = size_t(1) << k; mask < nmasks; ++mask)
+  {
+    std::vector<Expr> cube;
+    for (size_t j = 0; j < k; ++j)
+    {
+      cube.push_back(((mask >> j) & 1) ? split[j].notExpr() : split[j]);
+    }
+    cubes.push_back(cube);
+  }
+  return cubes;
+}
+
+}  // namespace CVC4
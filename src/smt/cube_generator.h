@@ -0,0 +1,93 @@
+/*********************                                                        */
+/*! \file cube_generator.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Lookahead-based cube generation for cube-and-conquer solving
+ **
+ ** Splits a set of assertions into cubes, i.e. conjunctions of literals over
+ ** atoms of the assertions, that partition the search space.  The cubes can
+ ** then be solved independently with check-sat-assuming.
+ **/
+
+#include "cvc4_public.h"
+
+#ifndef CVC4__SMT__CUBE_GENERATOR_H
+#define CVC4__SMT__CUBE_GENERATOR_H
+
+#include <map>
+#include <vector>
+
+#include "expr/expr.h"
+
+namespace CVC4 {
+
+/**
+ * Generates cubes for cube-and-conquer solving.
+ *
+ * The assertions are viewed as clauses: each assertion contributes one
+ * clause consisting of its top-level disjuncts, and top-level conjunctions
+ * are split into several clauses.  The split atoms are chosen by a
+ * lookahead score in the style of march: assigning a literal l satisfies
+ * the clauses containing l and shrinks those containing its negation, and
+ * an atom is scored by the product of the reductions caused by both of its
+ * literals, where short clauses count more since shrinking them is more
+ * likely to cause propagation.
+ */
+class CVC4_PUBLIC CubeGenerator
+{
+ public:
+  CubeGenerator() {}
+
+  /** Add an assertion to split on. */
+  void addAssertion(Expr a);
+
+  /**
+   * Compute the cubes on the depth best scoring atoms. Returns 2^depth
+   * cubes, or fewer if there are fewer than depth atoms that occur in a
+   * clause that can shrink (depth is capped at 20).  Returns a single
+   * empty cube if there is nothing to split on.
+   */
+  std::vector<std::vector<Expr> > getCubes(unsigned depth);
+
+  /** Get the lookahead score of atom a. */
+  double getScore(Expr a) const;
+
+ private:
+  /** Add the clauses of a, which is asserted with polarity pol. */
+  void addClauses(Expr a, bool pol);
+  /**
+   * Add the literals of the disjunction a (with polarity pol) to c.
+   * Disjuncts that are neither atoms nor disjunctions are added as
+   * d_opaque, they only count towards the length of the clause.
+   */
+  void collectDisjuncts(Expr a, bool pol, std::vector<unsigned>& c);
+  /** Get the literal for atom a with polarity pol. */
+  unsigned mkLiteral(Expr a, bool pol);
+  /** Get the weighted number of clauses shrunk by assigning literal l. */
+  double getReduction(unsigned l) const;
+  /** Get the lookahead score of the atom with the given id. */
+  double getScore(unsigned id) const;
+  /** Is a an atom we can split on? */
+  static bool isAtom(Expr a);
+  /** Literal code for disjuncts that are not literals. */
+  static const unsigned d_opaque = static_cast<unsigned>(-1);
+  /** The atoms; atom i has literals 2 * i (positive) and 2 * i + 1. */
+  std::vector<Expr> d_atoms;
+  /** Maps atoms to their index in d_atoms. */
+  std::map<Expr, unsigned> d_atomId;
+  /** The clauses. */
+  std::vector<std::vector<unsigned> > d_clauses;
+  /** For each literal, the indices of the clauses it occurs in. */
+  std::vector<std::vector<size_t> > d_occurs;
+}; /* class CubeGenerator */
+
+}  // namespace CVC4
+
+#endif /* CVC4__SMT__CUBE_GENERATOR_H */
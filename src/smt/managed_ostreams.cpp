@@ -23,6 +23,7 @@
 #include "options/open_ostream.h"
 #include "options/smt_options.h"
 #include "smt/update_ostream.h"
+#include "util/async_ostream.h"
 
 namespace CVC4 {
 
@@ -35,6 +36,12 @@ ManagedOstream::~ManagedOstream() {
 
 void ManagedOstream::set(const std::string& filename) {
   std::pair<bool, std::ostream*> pair = open(filename);
+  // Only the opened files are written asynchronously, the standard streams
+  // are shared with the other output
+  if (pair.first && options::asyncOutput())
+  {
+    pair.second = new AsyncOstream(pair.second);
+  }
   initialize(pair.second);
   manage(pair.first ? pair.second : NULL);
 }
@@ -44,6 +44,7 @@ class ManagedOstream {
    * Set opens a file with filename, initializes the stream.
    * If the opened ostream is marked as managed, this calls manage(stream).
    * If the opened ostream is not marked as managed, this calls manage(NULL).
+   * With --async-output, a managed ostream is written by a background thread.
    */
   void set(const std::string& filename);
 
@@ -0,0 +1,139 @@
+/*********************                                                        */
+/*! \file model_counter.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of utility for counting projected models.
+ **
+ **/
+
+#include "smt/model_counter.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "base/check.h"
+#include "base/modal_exception.h"
+#include "base/output.h"
+#include "expr/expr_manager.h"
+#include "options/smt_options.h"
+#include "smt/smt_engine.h"
+#include "util/bitvector.h"
+#include "util/random.h"
+#include "util/result.h"
+
+namespace CVC4 {
+
+ModelCounter::ModelCounter(SmtEngine* smt, const std::vector<Expr>& terms)
+    : d_smt(smt), d_terms(terms)
+{
+  ExprManager* em = smt->getExprManager();
+  Expr one = em->mkConst(BitVector(1u, 1u));
+  for (const Expr& t : d_terms)
+  {
+    Type tt = t.getType();
+    PrettyCheckArgument(tt.isBoolean() || tt.isBitVector(),
+                        t,
+                        "models can only be counted on Boolean and bit-vector "
+                        "terms");
+    if (tt.isBoolean())
+    {
+      d_bits.push_back(t);
+      continue;
+    }
+    unsigned size = BitVectorType(tt).getSize();
+    for (unsigned i = 0; i < size; i++)
+    {
+      Expr bit = em->mkExpr(em->mkConst(BitVectorExtract(i, i)), t);
+      d_bits.push_back(em->mkExpr(kind::EQUAL, bit, one));
+    }
+  }
+}
+
+Integer ModelCounter::count(bool approximate)
+{
+  if (!approximate)
+  {
+    return Integer(countBounded(std::vector<Expr>(),
+                                std::numeric_limits<uint64_t>::max() - 1));
+  }
+  uint64_t threshold = options::modelCountThreshold();
+  uint64_t n = countBounded(std::vector<Expr>(), threshold);
+  if (n <= threshold)
+  {
+    Trace("model-counter") << "...exact count " << n << std::endl;
+    return Integer(n);
+  }
+  std::vector<Integer> estimates;
+  for (unsigned i = 0; i < options::modelCountIterations(); i++)
+  {
+    // the cells of m + 1 constraints split the cells of m constraints
+    std::vector<Expr> xors;
+    do
+    {
+      xors.push_back(mkRandomXor());
+      n = countBounded(xors, threshold);
+    } while (n > threshold && xors.size() < d_bits.size());
+    Integer estimate = Integer(n).multiplyByPow2(xors.size());
+    Trace("model-counter") << "...estimate " << estimate << " with "
+                           << xors.size() << " constraints" << std::endl;
+    estimates.push_back(estimate);
+  }
+  std::sort(estimates.begin(), estimates.end());
+  return estimates[estimates.size() / 2];
+}
+
+uint64_t ModelCounter::countBounded(const std::vector<Expr>& xors,
+                                    uint64_t limit)
+{
+  d_smt->push();
+  for (const Expr& x : xors)
+  {
+    d_smt->assertFormula(x);
+  }
+  uint64_t n = 0;
+  while (n <= limit)
+  {
+    Result r = d_smt->checkSat();
+    if (r.isSat() == Result::UNSAT)
+    {
+      break;
+    }
+    if (r.isSat() != Result::SAT)
+    {
+      d_smt->pop();
+      throw RecoverableModalException(
+          "Cannot count the models, a check of the enumeration is unknown.");
+    }
+    n++;
+    if (n <= limit)
+    {
+      d_smt->blockModelValues(d_terms);
+    }
+  }
+  d_smt->pop();
+  return n;
+}
+
+Expr ModelCounter::mkRandomXor() const
+{
+  ExprManager* em = d_smt->getExprManager();
+  Random& rnd = Random::getRandom();
+  Expr x = em->mkConst(rnd.pickWithProb(0.5));
+  for (const Expr& b : d_bits)
+  {
+    if (rnd.pickWithProb(0.5))
+    {
+      x = em->mkExpr(kind::XOR, x, b);
+    }
+  }
+  return x;
+}
+
+}  // namespace CVC4
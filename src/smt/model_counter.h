@@ -0,0 +1,84 @@
+/*********************                                                        */
+/*! \file model_counter.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Utility for counting the models projected on a set of terms
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__SMT__MODEL_COUNTER_H
+#define CVC4__SMT__MODEL_COUNTER_H
+
+#include <vector>
+
+#include "expr/expr.h"
+#include "util/integer.h"
+
+namespace CVC4 {
+
+class SmtEngine;
+
+/**
+ * A utility for counting the distinct values of a tuple of Boolean and
+ * bit-vector terms t1 ... tn in the models of the assertions of an SMT
+ * engine, i.e. the number of models projected on t1 ... tn.
+ *
+ * The exact count enumerates the projected models, by blocking the values
+ * of t1 ... tn in each model (see SmtEngine::blockModelValues, which blocks
+ * in the SAT solver when --block-models-sat is set).
+ *
+ * The approximate count is the hashing-based counting of ApproxMC
+ * (Chakraborty, Meel and Vardi, "Algorithmic Improvements in Approximate
+ * Counting for Probabilistic Inference", IJCAI 2016). The projected models
+ * are split into cells by m random XOR constraints over the bits of the
+ * terms, with m increased from 1 until the models of a cell can be
+ * enumerated up to the threshold --model-count-threshold. The number of
+ * models of that cell, multiplied by 2^m, is an estimate of the count, and
+ * the median of --model-count-iterations estimates is returned.
+ *
+ * The SMT engine must be incremental and produce models. The counting is
+ * done in a user context that is popped before returning.
+ */
+class ModelCounter
+{
+ public:
+  /**
+   * Creates a counter of the models of the assertions of smt projected on
+   * terms, whose types must be Boolean or bit-vector.
+   */
+  ModelCounter(SmtEngine* smt, const std::vector<Expr>& terms);
+
+  /**
+   * Returns the number of models, exactly if approximate is false. Throws a
+   * RecoverableModalException if a check of the enumeration is unknown.
+   */
+  Integer count(bool approximate);
+
+ private:
+  /**
+   * Returns the number of models of the assertions and of xors, up to
+   * limit + 1.
+   */
+  uint64_t countBounded(const std::vector<Expr>& xors, uint64_t limit);
+  /** Returns a random XOR constraint over d_bits. */
+  Expr mkRandomXor() const;
+
+  /** The SMT engine */
+  SmtEngine* d_smt;
+  /** The terms on which the models are projected */
+  std::vector<Expr> d_terms;
+  /** The bits of d_terms, as Boolean terms */
+  std::vector<Expr> d_bits;
+};
+
+}  // namespace CVC4
+
+#endif /* CVC4__SMT__MODEL_COUNTER_H */
@@ -0,0 +1,273 @@
+/*********************                                                        */
+/*! \file result_cache.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A cache of the results of satisfiability checks
+ **/
+
+#include "smt/result_cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <unordered_set>
+
+#include "expr/dtype.h"
+#include "expr/term_canonize.h"
+#include "smt/smt_statistics_registry.h"
+
+namespace CVC4 {
+
+MemoryResultCacheBackend::MemoryResultCacheBackend(size_t capacity)
+    : d_capacity(capacity == 0 ? 1 : capacity)
+{
+}
+
+bool MemoryResultCacheBackend::lookup(const std::string& f, Result& r)
+{
+  std::lock_guard<std::mutex> lock(d_mutex);
+  auto it = d_index.find(f);
+  if (it == d_index.end())
+  {
+    return false;
+  }
+  // Now the most recently used one
+  d_entries.splice(d_entries.begin(), d_entries, it->second);
+  r = Result(it->second->second ? Result::SAT : Result::UNSAT);
+  return true;
+}
+
+void MemoryResultCacheBackend::store(const std::string& f, const Result& r)
+{
+  std::lock_guard<std::mutex> lock(d_mutex);
+  insert(f, r.isSat() == Result::SAT);
+}
+
+bool MemoryResultCacheBackend::insert(const std::string& f, bool sat)
+{
+  auto it = d_index.find(f);
+  if (it != d_index.end())
+  {
+    d_entries.splice(d_entries.begin(), d_entries, it->second);
+    if (it->second->second == sat)
+    {
+      return false;
+    }
+    it->second->second = sat;
+    return true;
+  }
+  d_entries.emplace_front(f, sat);
+  d_index[f] = d_entries.begin();
+  if (d_entries.size() > d_capacity)
+  {
+    d_index.erase(d_entries.back().first);
+    d_entries.pop_back();
+  }
+  return true;
+}
+
+FileResultCacheBackend::FileResultCacheBackend(const std::string& filename,
+                                               size_t capacity)
+    : MemoryResultCacheBackend(capacity),
+      d_filename(filename),
+      d_lines(0),
+      d_capacity(capacity)
+{
+  // The last lines are the most recently stored ones
+  std::ifstream in(filename);
+  std::string f, r;
+  while (in >> f >> r)
+  {
+    insert(f, r == "sat");
+    ++d_lines;
+  }
+}
+
+void FileResultCacheBackend::store(const std::string& f, const Result& r)
+{
+  std::lock_guard<std::mutex> lock(d_mutex);
+  bool sat = r.isSat() == Result::SAT;
+  if (!insert(f, sat))
+  {
+    return;
+  }
+  if (d_lines < 2 * d_capacity)
+  {
+    std::ofstream out(d_filename, std::ios::app);
+    out << f << (sat ? " sat" : " unsat") << std::endl;
+    ++d_lines;
+    return;
+  }
+  // Rewrite the file with the retained entries, the least recently used
+  // first, and replace the old one only once it is written
+  std::string tmp = d_filename + ".tmp";
+  {
+    std::ofstream out(tmp, std::ios::trunc);
+    for (auto it = d_entries.rbegin(); it != d_entries.rend(); ++it)
+    {
+      out << it->first << (it->second ? " sat" : " unsat") << '\n';
+    }
+    if (!out)
+    {
+      return;
+    }
+  }
+  if (std::rename(tmp.c_str(), d_filename.c_str()) == 0)
+  {
+    d_lines = d_entries.size();
+  }
+}
+
+namespace {
+
+/** The backends of the caches, by name */
+std::map<std::string, std::shared_ptr<ResultCacheBackend> > s_backends;
+/** Protects s_backends */
+std::mutex s_backendsMutex;
+
+}  // namespace
+
+ResultCache::Statistics::Statistics()
+    : d_hits("smt::ResultCache::hits", 0),
+      d_misses("smt::ResultCache::misses", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_hits);
+  smtStatisticsRegistry()->registerStat(&d_misses);
+}
+
+ResultCache::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_hits);
+  smtStatisticsRegistry()->unregisterStat(&d_misses);
+}
+
+ResultCache::ResultCache(const std::string& name, size_t capacity)
+{
+  std::lock_guard<std::mutex> lock(s_backendsMutex);
+  std::shared_ptr<ResultCacheBackend>& backend = s_backends[name];
+  if (backend == nullptr)
+  {
+    if (name.empty())
+    {
+      backend.reset(new MemoryResultCacheBackend(capacity));
+    }
+    else
+    {
+      backend.reset(new FileResultCacheBackend(name, capacity));
+    }
+  }
+  d_backend = backend;
+}
+
+void ResultCache::registerBackend(const std::string& name,
+                                  std::shared_ptr<ResultCacheBackend> backend)
+{
+  std::lock_guard<std::mutex> lock(s_backendsMutex);
+  s_backends[name] = backend;
+}
+
+std::string ResultCache::fingerprint(const std::vector<Node>& assertions,
+                                     const std::string& config)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  // The free symbols are replaced by bound variables, so that they are
+  // renamed along with the bound variables of the assertions. The
+  // definitions of the datatypes are part of the fingerprint.
+  std::vector<Node> syms;
+  std::vector<Node> vars;
+  std::vector<TypeNode> dtypes;
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::unordered_set<TypeNode, TypeNodeHashFunction> visitedTypes;
+  std::vector<TNode> visit(assertions.begin(), assertions.end());
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    if (!visited.insert(cur).second)
+    {
+      continue;
+    }
+    TypeNode tn = cur.getType();
+    if (tn.isDatatype() && visitedTypes.insert(tn).second)
+    {
+      dtypes.push_back(tn);
+    }
+    if (cur.isVar())
+    {
+      if (cur.getKind() != kind::BOUND_VARIABLE)
+      {
+        syms.push_back(cur);
+        vars.push_back(nm->mkBoundVar(tn));
+      }
+      continue;
+    }
+    if (cur.getMetaKind() == kind::metakind::PARAMETERIZED)
+    {
+      visit.push_back(cur.getOperator());
+    }
+    visit.insert(visit.end(), cur.begin(), cur.end());
+  }
+  Node conj = assertions.empty()
+                  ? nm->mkConst(true)
+                  : (assertions.size() == 1 ? assertions[0]
+                                            : nm->mkNode(kind::AND, assertions));
+  conj = conj.substitute(syms.begin(), syms.end(), vars.begin(), vars.end());
+  expr::TermCanonize tcanon;
+  Node canon = tcanon.getCanonicalTerm(conj);
+
+  std::stringstream ss;
+  ss << config << '\n';
+  for (const TypeNode& tn : dtypes)
+  {
+    ss << tn.getDType() << '\n';
+  }
+  // The types of the variables are printed, since the names of the canonical
+  // variables only have the first letter of their types
+  canon.toStream(ss, -1, true, 1, language::output::LANG_SMTLIB_V2_6);
+
+  // Two 64 bit hashes, FNV-1a and a multiplicative one
+  const std::string& s = ss.str();
+  uint64_t h1 = 14695981039346656037ULL;
+  uint64_t h2 = 0;
+  for (unsigned char c : s)
+  {
+    h1 = (h1 ^ c) * 1099511628211ULL;
+    h2 = (h2 + c + 1) * 0x9E3779B97F4A7C15ULL;
+    h2 ^= h2 >> 29;
+  }
+  std::stringstream fs;
+  fs << std::hex << std::setfill('0') << std::setw(16) << h1 << std::setw(16)
+     << h2;
+  return fs.str();
+}
+
+bool ResultCache::lookup(const std::string& f, Result& r)
+{
+  if (d_backend->lookup(f, r))
+  {
+    ++d_statistics.d_hits;
+    return true;
+  }
+  ++d_statistics.d_misses;
+  return false;
+}
+
+void ResultCache::store(const std::string& f, const Result& r)
+{
+  Result::Sat sat = r.asSatisfiabilityResult().isSat();
+  if (sat == Result::SAT || sat == Result::UNSAT)
+  {
+    d_backend->store(f, r.asSatisfiabilityResult());
+  }
+}
+
+}  // namespace CVC4
@@ -0,0 +1,166 @@
+/*********************                                                        */
+/*! \file result_cache.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A cache of the results of satisfiability checks
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__SMT__RESULT_CACHE_H
+#define CVC4__SMT__RESULT_CACHE_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "expr/node.h"
+#include "util/result.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+
+/**
+ * A backend of the result cache, which stores the sat and unsat results by
+ * the fingerprints of their assertions. A backend may be shared by several
+ * SMT engines, possibly in different threads.
+ */
+class ResultCacheBackend
+{
+ public:
+  virtual ~ResultCacheBackend() {}
+  /**
+   * Returns true and sets r to the result of the assertions of fingerprint f
+   * if it is stored.
+   */
+  virtual bool lookup(const std::string& f, Result& r) = 0;
+  /** Stores the result r, sat or unsat, of the assertions of fingerprint f */
+  virtual void store(const std::string& f, const Result& r) = 0;
+};
+
+/**
+ * A backend storing at most a given number of results in memory, which
+ * evicts the least recently used ones.
+ */
+class MemoryResultCacheBackend : public ResultCacheBackend
+{
+ public:
+  MemoryResultCacheBackend(size_t capacity);
+
+  bool lookup(const std::string& f, Result& r) override;
+  void store(const std::string& f, const Result& r) override;
+
+ protected:
+  /**
+   * Inserts the result of fingerprint f as the most recently used one,
+   * returns false if it was already stored with the same result. The caller
+   * must hold d_mutex.
+   */
+  bool insert(const std::string& f, bool sat);
+
+  /** Protects the entries */
+  std::mutex d_mutex;
+  /**
+   * The fingerprints and results (true for sat), the most recently used
+   * first.
+   */
+  std::list<std::pair<std::string, bool> > d_entries;
+
+ private:
+  /** The maximal number of entries */
+  size_t d_capacity;
+  /** The entries by fingerprint */
+  std::unordered_map<std::string,
+                     std::list<std::pair<std::string, bool> >::iterator>
+      d_index;
+};
+
+/**
+ * A backend storing the results in a file, shared by the processes using
+ * it. The file has a line "<fingerprint> sat" or "<fingerprint> unsat" per
+ * result. It is read when the backend is created, appended to by stores, and
+ * rewritten with the retained entries when it has twice as many lines.
+ */
+class FileResultCacheBackend : public MemoryResultCacheBackend
+{
+ public:
+  FileResultCacheBackend(const std::string& filename, size_t capacity);
+
+  void store(const std::string& f, const Result& r) override;
+
+ private:
+  /** The file of the entries */
+  std::string d_filename;
+  /** The number of lines in the file */
+  size_t d_lines;
+  /** The maximal number of entries */
+  size_t d_capacity;
+};
+
+/**
+ * The result cache of an SMT engine. The assertions are identified by a
+ * fingerprint, the hash of their canonical form up to the renaming of their
+ * free symbols and bound variables (see expr::TermCanonize) along with the
+ * logic and the options that change their semantics.
+ */
+class ResultCache
+{
+ public:
+  /**
+   * Creates a cache using the backend registered with name (see
+   * registerBackend). Otherwise, the backend is shared by the caches with the
+   * same name: in memory if name is empty, else in the file name, with the
+   * capacity of the first one.
+   */
+  ResultCache(const std::string& name, size_t capacity);
+
+  /**
+   * Returns the fingerprint of assertions, whose definitions are expanded,
+   * for the logic and options described by config.
+   */
+  static std::string fingerprint(const std::vector<Node>& assertions,
+                                 const std::string& config);
+
+  /** Looks up the result of fingerprint f in the backend. */
+  bool lookup(const std::string& f, Result& r);
+
+  /** Stores r in the backend unless it is unknown. */
+  void store(const std::string& f, const Result& r);
+
+  /**
+   * Registers the backend used by the caches created with name, e.g. a
+   * backend of an application that stores the results in a database.
+   */
+  static void registerBackend(const std::string& name,
+                              std::shared_ptr<ResultCacheBackend> backend);
+
+ private:
+  /** The backend */
+  std::shared_ptr<ResultCacheBackend> d_backend;
+
+  struct Statistics
+  {
+    /** The number of results found in the cache */
+    IntStat d_hits;
+    /** The number of results not found */
+    IntStat d_misses;
+    Statistics();
+    ~Statistics();
+  };
+  Statistics d_statistics;
+};
+
+}  // namespace CVC4
+
+#endif /* CVC4__SMT__RESULT_CACHE_H */
@@ -16,8 +16,15 @@
 
 #include "smt/smt_engine.h"
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif /* _WIN32 */
+
 #include <algorithm>
 #include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
 #include <iterator>
 #include <memory>
 #include <sstream>
@@ -57,6 +64,7 @@
 #include "options/bv_options.h"
 #include "options/datatypes_options.h"
 #include "options/decision_options.h"
+#include "options/idl_options.h"
 #include "options/language.h"
 #include "options/main_options.h"
 #include "options/open_ostream.h"
@@ -85,7 +93,9 @@
 #include "smt/logic_request.h"
 #include "smt/managed_ostreams.h"
 #include "smt/model_blocker.h"
+#include "smt/model_counter.h"
 #include "smt/model_core_builder.h"
+#include "smt/result_cache.h"
 #include "smt/smt_engine_scope.h"
 #include "smt/term_formula_removal.h"
 #include "smt/update_ostream.h"
@@ -94,13 +104,16 @@
 #include "theory/booleans/circuit_propagator.h"
 #include "theory/bv/theory_bv_rewriter.h"
 #include "theory/logic_info.h"
+#include "theory/quantifiers/extended_rewrite.h"
 #include "theory/quantifiers/fun_def_process.h"
 #include "theory/quantifiers/single_inv_partition.h"
 #include "theory/quantifiers/sygus/sygus_abduct.h"
 #include "theory/quantifiers/sygus/synth_engine.h"
 #include "theory/quantifiers/term_util.h"
 #include "theory/quantifiers_engine.h"
+#include "theory/rewrite_cache.h"
 #include "theory/rewriter.h"
+#include "theory/smt_engine_subsolver.h"
 #include "theory/sort_inference.h"
 #include "theory/strings/theory_strings.h"
 #include "theory/substitutions.h"
@@ -110,6 +123,7 @@
 #include "util/hash.h"
 #include "util/proof.h"
 #include "util/random.h"
+#include "util/phase_profiler.h"
 #include "util/resource_manager.h"
 
 #if (IS_LFSC_BUILD && IS_PROOFS_BUILD)
@@ -206,6 +220,13 @@ struct SmtEngineStatistics {
   IntStat d_simplifiedToFalse;
   /** Number of resource units spent. */
   ReferenceStat<uint64_t> d_resourceUnitsUsed;
+  /** Number of lookups and hits in the extended rewriter caches. */
+  ReferenceStat<uint64_t> d_extRewCacheLookups;
+  ReferenceStat<uint64_t> d_extRewCacheHits;
+  /** Peak number of nodes in the node pool after a check. */
+  IntStat d_nodePoolSize;
+  /** Peak number of bytes held by the context memory managers after a check. */
+  IntStat d_contextMemory;
 
   SmtEngineStatistics()
       : d_definitionExpansionTime("smt::SmtEngine::definitionExpansionTime"),
@@ -221,7 +242,11 @@ struct SmtEngineStatistics {
         d_pushPopTime("smt::SmtEngine::pushPopTime"),
         d_processAssertionsTime("smt::SmtEngine::processAssertionsTime"),
         d_simplifiedToFalse("smt::SmtEngine::simplifiedToFalse", 0),
-        d_resourceUnitsUsed("smt::SmtEngine::resourceUnitsUsed")
+        d_resourceUnitsUsed("smt::SmtEngine::resourceUnitsUsed"),
+        d_extRewCacheLookups("smt::SmtEngine::extRewCacheLookups"),
+        d_extRewCacheHits("smt::SmtEngine::extRewCacheHits"),
+        d_nodePoolSize("smt::SmtEngine::nodePoolSize", 0),
+        d_contextMemory("smt::SmtEngine::contextMemory", 0)
   {
     smtStatisticsRegistry()->registerStat(&d_definitionExpansionTime);
     smtStatisticsRegistry()->registerStat(&d_numConstantProps);
@@ -237,6 +262,10 @@ struct SmtEngineStatistics {
     smtStatisticsRegistry()->registerStat(&d_processAssertionsTime);
     smtStatisticsRegistry()->registerStat(&d_simplifiedToFalse);
     smtStatisticsRegistry()->registerStat(&d_resourceUnitsUsed);
+    smtStatisticsRegistry()->registerStat(&d_extRewCacheLookups);
+    smtStatisticsRegistry()->registerStat(&d_extRewCacheHits);
+    smtStatisticsRegistry()->registerStat(&d_nodePoolSize);
+    smtStatisticsRegistry()->registerStat(&d_contextMemory);
   }
 
   ~SmtEngineStatistics() {
@@ -254,6 +283,10 @@ struct SmtEngineStatistics {
     smtStatisticsRegistry()->unregisterStat(&d_processAssertionsTime);
     smtStatisticsRegistry()->unregisterStat(&d_simplifiedToFalse);
     smtStatisticsRegistry()->unregisterStat(&d_resourceUnitsUsed);
+    smtStatisticsRegistry()->unregisterStat(&d_extRewCacheLookups);
+    smtStatisticsRegistry()->unregisterStat(&d_extRewCacheHits);
+    smtStatisticsRegistry()->unregisterStat(&d_nodePoolSize);
+    smtStatisticsRegistry()->unregisterStat(&d_contextMemory);
   }
 };/* struct SmtEngineStatistics */
 
@@ -284,6 +317,20 @@ class HardResourceOutListener : public Listener {
   SmtEngine* d_smt;
 }; /* class HardResourceOutListener */
 
+class MemoryLimitListener : public Listener {
+ public:
+  MemoryLimitListener(SmtEngine& smt) : d_smt(&smt) {}
+  void notify() override
+  {
+    SmtScope scope(d_smt);
+    // the caches that are only memoized results may be dropped at any point
+    theory::Rewriter::shedCaches();
+    theory::quantifiers::ExtendedRewriter::clearCaches();
+  }
+ private:
+  SmtEngine* d_smt;
+}; /* class MemoryLimitListener */
+
 class BeforeSearchListener : public Listener {
  public:
   BeforeSearchListener(SmtEngine& smt) : d_smt(&smt) {}
@@ -493,6 +540,12 @@ class SmtEnginePrivate : public NodeManagerListener {
  public:
   IteSkolemMap& getIteSkolemMap() { return d_assertions.getIteSkolemMap(); }
 
+  /** Returns the context of the passes, or nullptr before finishInit() */
+  PreprocessingPassContext* getPreprocessingPassContext() const
+  {
+    return d_preprocessingPassContext.get();
+  }
+
   /** Instance of the ITE remover */
   RemoveTermFormulas d_iteRemover;
 
@@ -577,6 +630,9 @@ class SmtEnginePrivate : public NodeManagerListener {
     d_listenerRegistrations->add(d_resourceManager->registerHardListener(
         new HardResourceOutListener(d_smt)));
 
+    d_listenerRegistrations->add(d_resourceManager->registerMemoryListener(
+        new MemoryLimitListener(d_smt)));
+
     try
     {
       Options& nodeManagerOptions = NodeManager::currentNM()->getOptions();
@@ -877,7 +933,8 @@ SmtEngine::SmtEngine(ExprManager* em)
       d_replayStream(nullptr),
       d_private(nullptr),
       d_statisticsRegistry(nullptr),
-      d_stats(nullptr)
+      d_stats(nullptr),
+      d_clauseSharing(nullptr)
 {
   SmtScope smts(this);
   d_originalOptions.copyValues(em->getOptions());
@@ -886,6 +943,15 @@ SmtEngine::SmtEngine(ExprManager* em)
   d_stats.reset(new SmtEngineStatistics());
   d_stats->d_resourceUnitsUsed.setData(
       d_private->getResourceManager()->getResourceUsage());
+  d_stats->d_extRewCacheLookups.setData(
+      theory::quantifiers::ExtendedRewriter::getCacheLookups());
+  d_stats->d_extRewCacheHits.setData(
+      theory::quantifiers::ExtendedRewriter::getCacheHits());
+  if (options::rewriteCacheBudget() > 0)
+  {
+    d_rewriteCache.reset(
+        new theory::RewriteCache(options::rewriteCacheBudget()));
+  }
 
   // The ProofManager is constructed before any other proof objects such as
   // SatProof and TheoryProofs. The TheoryProofEngine and the SatProof are
@@ -914,8 +980,35 @@ void SmtEngine::finishInit()
                                         d_private->d_iteRemover,
                                         const_cast<const LogicInfo&>(d_logic)));
 
-  // Add the theories
+  // Pure integer difference logic is solved by the IDL solver, unless proofs
+  // are needed, which it does not support
+  if (options::idlAuto() && options::useTheoryList().empty()
+      && d_logic.isPure(THEORY_ARITH) && !d_logic.isQuantified()
+      && d_logic.isDifferenceLogic() && !d_logic.areRealsUsed()
+      && !options::proof() && !options::checkProofs()
+      && !options::unsatCores() && !options::checkUnsatCores())
+  {
+    Trace("smt") << "using the IDL solver for " << d_logic << std::endl;
+    d_theoryEngine->enableTheoryAlternative("idl");
+  }
+
+  d_private->addUseTheoryListListener(getTheoryEngine());
+
+  // ensure that our heuristics are properly set up
+  setDefaults();
+
+  // Add the theories of the (final) logic.  The builtin and Boolean theories
+  // and UF, to which the theories may widen the logic, are always added.
+  // Finite model finding uses arithmetic constants in cardinality constraints.
   for(TheoryId id = theory::THEORY_FIRST; id < theory::THEORY_LAST; ++id) {
+    if (!d_logic.isTheoryEnabled(id) && id != THEORY_BUILTIN
+        && id != THEORY_BOOL && id != THEORY_UF
+        && !(id == THEORY_ARITH && options::finiteModelFind()))
+    {
+      Trace("smt") << "not adding " << id << ", not in " << d_logic
+                   << std::endl;
+      continue;
+    }
     TheoryConstructor::addTheory(getTheoryEngine(), id);
     //register with proof engine if applicable
 #ifdef CVC4_PROOF
@@ -923,11 +1016,6 @@ void SmtEngine::finishInit()
 #endif
   }
 
-  d_private->addUseTheoryListListener(getTheoryEngine());
-
-  // ensure that our heuristics are properly set up
-  setDefaults();
-
   Trace("smt-debug") << "Making decision engine..." << std::endl;
 
   Trace("smt-debug") << "Making prop engine..." << std::endl;
@@ -940,6 +1028,7 @@ void SmtEngine::finishInit()
                                     getUserContext(),
                                     d_private->getReplayLog(),
                                     d_replayStream));
+  setPropEngineClauseSharing();
 
   Trace("smt-debug") << "Setting up theory engine..." << std::endl;
   d_theoryEngine->setPropEngine(getPropEngine());
@@ -988,10 +1077,22 @@ void SmtEngine::finishInit()
   PROOF( ProofManager::currentPM()->setLogic(d_logic); );
   PROOF({
       for(TheoryId id = theory::THEORY_FIRST; id < theory::THEORY_LAST; ++id) {
-        ProofManager::currentPM()->getTheoryProofEngine()->
-          finishRegisterTheory(d_theoryEngine->theoryOf(id));
+        if (d_theoryEngine->theoryOf(id) != nullptr)
+        {
+          ProofManager::currentPM()->getTheoryProofEngine()->
+            finishRegisterTheory(d_theoryEngine->theoryOf(id));
+        }
       }
     });
+  // The results are cached unless the checks have to produce more than them
+  if (options::resultCache() && !d_isInternalSubsolver
+      && !options::produceModels() && !options::produceAssignments()
+      && !options::unsatCores() && !options::proof())
+  {
+    d_resultCache.reset(new ResultCache(options::resultCacheFile(),
+                                        options::resultCacheSize()));
+  }
+
   d_private->finishInit();
   Trace("smt-debug") << "SmtEngine::finishInit done" << std::endl;
 }
@@ -1015,6 +1116,18 @@ void SmtEngine::finalOptionsAreSet() {
   d_fullyInited = true;
   Assert(d_logic.isLocked());
 
+  if (options::incrementalSolving())
+  {
+    // the assertions of the global user context level go in their own SAT
+    // level, which resetAssertions() pops instead of rebuilding the
+    // PropEngine
+    d_propEngine->push();
+  }
+  assertTrueAndNotFalse();
+}
+
+void SmtEngine::assertTrueAndNotFalse()
+{
   d_propEngine->assertFormula(NodeManager::currentNM()->mkConst<bool>(true));
   d_propEngine->assertFormula(NodeManager::currentNM()->mkConst<bool>(false).notNode());
 }
@@ -1043,6 +1156,10 @@ SmtEngine::~SmtEngine()
   try {
     shutdown();
 
+    // the subsolvers refer to expressions of this SmtEngine
+    d_subsolverPool.reset(nullptr);
+    d_preprocessingCache.reset(nullptr);
+
     // global push/pop around everything, to ensure proper destruction
     // of context-dependent data structures
     d_context->popto(0);
@@ -1088,6 +1205,8 @@ SmtEngine::~SmtEngine()
     d_theoryEngine.reset(nullptr);
     d_propEngine.reset(nullptr);
 
+    d_rewriteCache.reset(nullptr);
+    d_resultCache.reset(nullptr);
     d_stats.reset(nullptr);
     d_statisticsRegistry.reset(nullptr);
 
@@ -1197,6 +1316,29 @@ void SmtEngine::setDefaults() {
     d_logic.lock();
   }
 
+  if (options::symmetryBreakPp()
+      && (options::incrementalSolving() || options::unsatCores()))
+  {
+    throw OptionException(
+        "--symmetry-break-pp is currently not supported with incremental "
+        "solving or unsat cores.");
+  }
+
+  if (options::solveStrAsBV() > 0)
+  {
+    if (options::incrementalSolving())
+    {
+      throw OptionException(
+          "--solve-str-as-bv is currently not supported with incremental "
+          "solving.");
+    }
+    d_logic = d_logic.getUnlockedCopy();
+    d_logic.enableTheory(THEORY_BV);
+    d_logic.enableTheory(THEORY_ARITH);
+    d_logic.enableIntegers();
+    d_logic.lock();
+  }
+
   if (options::solveBVAsInt() > 0)
   {
     if (d_logic.isTheoryEnabled(THEORY_BV))
@@ -1305,6 +1447,8 @@ void SmtEngine::setDefaults() {
     d_logic = d_logic.getUnlockedCopy();
     d_logic.enableSygus();
     d_logic.lock();
+    // the results of sygus conjectures come with their solutions
+    options::resultCache.set(false);
   }
 
   // sygus core connective requires unsat cores
@@ -1314,7 +1458,7 @@ void SmtEngine::setDefaults() {
   }
 
   if ((options::checkModels() || options::checkSynthSol()
-       || options::produceAbducts()
+       || options::produceAbducts() || options::resultCache()
        || options::modelCoresMode() != options::ModelCoresMode::NONE
        || options::blockModelsMode() != options::BlockModelsMode::NONE)
       && !options::produceAssertions())
@@ -1328,6 +1472,53 @@ void SmtEngine::setDefaults() {
   // proofs or output an error if enabled explicitly
   if (options::incrementalSolving() || options::unsatCores()
       || options::proof())
+  {
+    if (options::streamAssertions())
+    {
+      if (options::streamAssertions.wasSetByUser())
+      {
+        throw OptionException(
+            "streaming assertions not supported with unsat "
+            "cores/proofs/incremental solving");
+      }
+      options::streamAssertions.set(false);
+    }
+    if (options::decomposeAssertions())
+    {
+      if (options::decomposeAssertions.wasSetByUser())
+      {
+        throw OptionException(
+            "assertion decomposition not supported with unsat "
+            "cores/proofs/incremental solving");
+      }
+      options::decomposeAssertions.set(false);
+    }
+    if (options::localSearch())
+    {
+      if (options::localSearch.wasSetByUser())
+      {
+        throw OptionException(
+            "local search not supported with unsat cores/proofs/incremental "
+            "solving");
+      }
+      options::localSearch.set(false);
+    }
+    if (options::pbNative())
+    {
+      if (options::pbNative.wasSetByUser())
+      {
+        throw OptionException(
+            "native pseudo-Boolean constraints not supported with unsat "
+            "cores/proofs/incremental solving");
+      }
+      options::pbNative.set(false);
+    }
+  }
+
+  // Unconstrained simplification supports incremental solving, by asserting
+  // again the definitions of the eliminated terms when needed, but not unsat
+  // cores and proofs
+  if (options::unsatCores() || options::proof())
   {
     if (options::unconstrainedSimp())
     {
@@ -1335,15 +1526,15 @@ void SmtEngine::setDefaults() {
       {
         throw OptionException(
             "unconstrained simplification not supported with unsat "
-            "cores/proofs/incremental solving");
+            "cores/proofs");
       }
       Notice() << "SmtEngine: turning off unconstrained simplification to "
-                  "support unsat cores/proofs/incremental solving"
+                  "support unsat cores/proofs"
                << endl;
       options::unconstrainedSimp.set(false);
     }
   }
-  else
+  else if (!options::incrementalSolving())
   {
     // Turn on unconstrained simplification for QF_AUFBV
     if (!options::unconstrainedSimp.wasSetByUser())
@@ -1378,6 +1569,21 @@ void SmtEngine::setDefaults() {
     }
   }
 
+  if (options::satSolver() == options::PropSatSolverMode::CADICAL)
+  {
+    // CaDiCaL does not expose the activities and phases of its variables
+    if (options::decisionActivity())
+    {
+      throw OptionException(
+          "--decision-activity not supported with --sat-solver=cadical");
+    }
+    if (!options::satHintsSave().empty())
+    {
+      throw OptionException(
+          "--sat-hints-save not supported with --sat-solver=cadical");
+    }
+  }
+
   // Disable options incompatible with unsat cores and proofs or output an
   // error if enabled explicitly
   if (options::unsatCores() || options::proof())
@@ -1395,6 +1601,12 @@ void SmtEngine::setDefaults() {
       options::simplificationMode.set(options::SimplificationMode::NONE);
     }
 
+    if (options::satSolver() == options::PropSatSolverMode::CADICAL)
+    {
+      throw OptionException(
+          "--sat-solver=cadical not supported with unsat cores/proofs");
+    }
+
     if (options::pbRewrites())
     {
       if (options::pbRewrites.wasSetByUser())
@@ -1434,6 +1646,19 @@ void SmtEngine::setDefaults() {
       options::preSkolemQuant.set(false);
     }
 
+    if (options::dedupAssertions())
+    {
+      if (options::dedupAssertions.wasSetByUser())
+      {
+        throw OptionException(
+            "assertion deduplication not supported with unsat cores/proofs");
+      }
+      Notice() << "SmtEngine: turning off assertion deduplication to support "
+                  "unsat cores/proofs"
+               << endl;
+      options::dedupAssertions.set(false);
+    }
+
     if (options::solveBVAsInt() > 0)
     {
       /**
@@ -2239,6 +2464,33 @@ void SmtEngine::setDefaults() {
                << std::endl;
       options::bitvectorInequalitySolver.set(false);
     }
+    if (options::bitvectorGateSimp())
+    {
+      if (options::bitvectorGateSimp.wasSetByUser())
+      {
+        throw OptionException("--bv-gate-simp is not supported with proofs");
+      }
+      Notice() << "SmtEngine: turning off bv gate simplification to support "
+                  "proofs"
+               << std::endl;
+      options::bitvectorGateSimp.set(false);
+    }
+    if (options::bvSatXor())
+    {
+      throw OptionException("--bv-sat-xor is not supported with proofs");
+    }
+    if (options::bvMultiplierMode() != options::BvMultiplierMode::SHIFT_ADD
+        || options::bvDividerMode() != options::BvDividerMode::RESTORING)
+    {
+      if (options::bvMultiplierMode.wasSetByUser()
+          || options::bvDividerMode.wasSetByUser())
+      {
+        throw OptionException(
+            "--bv-mult and --bv-div only support their default with proofs");
+      }
+      options::bvMultiplierMode.set(options::BvMultiplierMode::SHIFT_ADD);
+      options::bvDividerMode.set(options::BvDividerMode::RESTORING);
+    }
   }
 
   if (!options::bitvectorEqualitySolver())
@@ -2283,6 +2535,31 @@ void SmtEngine::setDefaults() {
     options::stringProcessLoopMode.set(options::ProcessLoopMode::SIMPLE);
   }
 
+  if (d_clauseSharing != nullptr)
+  {
+    // The shared clauses must be consequences of the input at user level 0
+    if (!options::satShareClauses() || options::incrementalSolving()
+        || options::unsatCores() || options::proof())
+    {
+      d_clauseSharing = nullptr;
+    }
+    else if (options::minisatUseElim())
+    {
+      // The imported clauses may contain variables that Minisat eliminated
+      if (options::minisatUseElim.wasSetByUser())
+      {
+        Notice() << "SmtEngine: not sharing clauses to support "
+                    "minisat-elimination"
+                 << endl;
+        d_clauseSharing = nullptr;
+      }
+      else
+      {
+        options::minisatUseElim.set(false);
+      }
+    }
+  }
+
   // !!! All options that require disabling models go here
   bool disableModels = false;
   std::string sOptNoModel;
@@ -2852,9 +3129,8 @@ Node SmtEnginePrivate::expandDefinitions(TNode n, unordered_map<Node, Node, Node
       } else if(! expandOnly) {
         // do not do any theory stuff if expandOnly is true
 
-        theory::Theory* t = d_smt.d_theoryEngine->theoryOf(node);
-
-        Assert(t != NULL);
+        theory::Theory* t = d_smt.d_theoryEngine->theoryOfInLogic(
+            theory::Theory::theoryOf(node), node);
         LogicRequest req(d_smt);
         node = t->expandDefinition(req, n);
       }
@@ -3051,6 +3327,10 @@ Result SmtEngine::check() {
   resourceManager->endCall();
   Trace("limit") << "SmtEngine::check(): cumulative millis " << resourceManager->getTimeUsage()
                  << ", resources " << resourceManager->getResourceUsage() << endl;
+  d_stats->d_nodePoolSize.maxAssign(d_nodeManager->poolSize());
+  d_stats->d_contextMemory.maxAssign(
+      d_context->getCMM()->getMemoryUsage()
+      + d_userContext->getCMM()->getMemoryUsage());
 
 
   return Result(result, d_filename);
@@ -3162,6 +3442,7 @@ bool SmtEnginePrivate::checkForBadSkolems(TNode n, TNode skolem, unordered_map<N
 
 void SmtEnginePrivate::processAssertions() {
   TimerStat::CodeTimer paTimer(d_smt.d_stats->d_processAssertionsTime);
+  PhaseScope phase("preprocess");
   spendResource(ResourceManager::Resource::PreprocessStep);
   Assert(d_smt.d_fullyInited);
   Assert(d_smt.d_pendingPops == 0);
@@ -3251,6 +3532,11 @@ void SmtEnginePrivate::processAssertions() {
     d_passes["int-to-bv"]->apply(&d_assertions);
   }
 
+  if (options::solveStrAsBV() > 0)
+  {
+    d_passes["str-to-bv"]->apply(&d_assertions);
+  }
+
   if (options::bitblastMode() == options::BitblastMode::EAGER
       && !d_smt.d_logic.isPure(THEORY_BV)
       && d_smt.d_logic.getLogicString() != "QF_UFBV"
@@ -3301,6 +3587,11 @@ void SmtEnginePrivate::processAssertions() {
   // Assertions MUST BE guaranteed to be rewritten by this point
   d_passes["rewrite"]->apply(&d_assertions);
 
+  if (options::dedupAssertions())
+  {
+    d_passes["dedup-assertions"]->apply(&d_assertions);
+  }
+
   // Lift bit-vectors of size 1 to bool
   if (options::bitvectorToBool())
   {
@@ -3391,6 +3682,11 @@ void SmtEnginePrivate::processAssertions() {
     d_passes["pseudo-boolean-processor"]->apply(&d_assertions);
   }
 
+  if (options::symmetryBreakPp())
+  {
+    d_passes["symmetry-break"]->apply(&d_assertions);
+  }
+
   // rephrasing normal inputs as sygus problems
   if (!d_smt.d_isInternalSubsolver)
   {
@@ -3415,11 +3711,29 @@ void SmtEnginePrivate::processAssertions() {
   Trace("smt-proc") << "SmtEnginePrivate::processAssertions() : post-simplify" << endl;
   dumpAssertions("post-simplify", d_assertions);
 
+  if (options::decomposeAssertions() && noConflict)
+  {
+    noConflict = d_passes["decompose-assertions"]->apply(&d_assertions)
+                 != PreprocessingPassResult::CONFLICT;
+  }
+
+  if (options::localSearch() && noConflict)
+  {
+    d_passes["local-search"]->apply(&d_assertions);
+  }
+
   if(options::doStaticLearning()) {
     d_passes["static-learning"]->apply(&d_assertions);
   }
   Debug("smt") << " d_assertions     : " << d_assertions.size() << endl;
 
+  // The variables of the constraints passed to the SAT solver must not be
+  // substituted afterwards by repeated simplification
+  if (options::pbNative() && !options::repeatSimp() && noConflict)
+  {
+    d_passes["pb-constraints"]->apply(&d_assertions);
+  }
+
   {
     d_smt.d_stats->d_numAssertionsPre += d_assertions.size();
     d_passes["ite-removal"]->apply(&d_assertions);
@@ -3554,9 +3868,18 @@ void SmtEnginePrivate::processAssertions() {
   {
     Chat() << "converting to CNF..." << endl;
     TimerStat::CodeTimer codeTimer(d_smt.d_stats->d_cnfConversionTime);
-    for (unsigned i = 0; i < d_assertions.size(); ++ i) {
-      Chat() << "+ " << d_assertions[i] << std::endl;
-      d_smt.d_propEngine->assertFormula(d_assertions[i]);
+    if (options::cnfThreads() > 1)
+    {
+      d_smt.d_propEngine->assertFormulas(d_assertions.ref(),
+                                         options::cnfThreads());
+    }
+    else
+    {
+      for (unsigned i = 0; i < d_assertions.size(); ++i)
+      {
+        Chat() << "+ " << d_assertions[i] << std::endl;
+        d_smt.d_propEngine->assertFormula(d_assertions[i]);
+      }
     }
   }
 
@@ -3610,6 +3933,15 @@ void SmtEnginePrivate::addFormula(
     }
   );
 
+  if (options::streamAssertions() && inInput && !isAssumption)
+  {
+    // Expand and rewrite n now, so that the parsed form of n is released
+    // when its command is done instead of when the assertions are processed.
+    unordered_map<Node, Node, NodeHashFunction> cache;
+    d_assertions.push_back(Rewriter::rewrite(expandDefinitions(n, cache)));
+    return;
+  }
+
   // Add the normalized formula to the queue
   d_assertions.push_back(n, isAssumption);
   //d_assertions.push_back(Rewriter::rewrite(n));
@@ -3746,34 +4078,67 @@ Result SmtEngine::checkSatisfiability(const vector<Expr>& assumptions,
       d_private->addFormula(e.getNode(), inUnsatCore, true, true);
     }
 
-    r = check();
-
-    if ((options::solveRealAsInt() || options::solveIntAsBV() > 0)
-        && r.asSatisfiabilityResult().isSat() == Result::UNSAT)
+    // Look for the result of the same assertions, the pending ones are
+    // processed by the next check or discarded by the pop of the assumptions
+    std::string fingerprint;
+    bool cached = false;
+    if (d_resultCache != nullptr)
     {
-      r = Result(Result::SAT_UNKNOWN, Result::UNKNOWN_REASON);
-    }
-    // flipped if we did a global negation
-    if (d_globalNegation)
+      std::vector<Node> assertions;
+      for (const Expr& e : getExpandedAssertions())
+      {
+        assertions.push_back(Node::fromExpr(e));
+      }
+      // The options that change the meaning of the assertions: division by
+      // zero in arithmetic and bit-vectors, and the alphabet of strings
+      std::stringstream config;
+      config << d_logic.getLogicString() << ' '
+             << options::arithNoPartialFun() << ' '
+             << options::bitvectorDivByZeroConst() << ' '
+             << options::stdPrintASCII();
+      fingerprint = ResultCache::fingerprint(assertions, config.str());
+      cached = d_resultCache->lookup(fingerprint, r);
+      Trace("smt") << "SmtEngine::checkSat: fingerprint " << fingerprint
+                   << (cached ? " cached" : "") << endl;
+    }
+
+    if (!cached)
     {
-      Trace("smt") << "SmtEngine::process global negate " << r << std::endl;
-      if (r.asSatisfiabilityResult().isSat() == Result::UNSAT)
+      r = check();
+
+      if ((options::solveRealAsInt() || options::solveIntAsBV() > 0
+           || options::solveStrAsBV() > 0)
+          && r.asSatisfiabilityResult().isSat() == Result::UNSAT)
       {
-        r = Result(Result::SAT);
+        r = Result(Result::SAT_UNKNOWN, Result::UNKNOWN_REASON);
       }
-      else if (r.asSatisfiabilityResult().isSat() == Result::SAT)
+      // flipped if we did a global negation
+      if (d_globalNegation)
       {
-        // only if satisfaction complete
-        if (d_logic.isPure(THEORY_ARITH) || d_logic.isPure(THEORY_BV))
+        Trace("smt") << "SmtEngine::process global negate " << r << std::endl;
+        if (r.asSatisfiabilityResult().isSat() == Result::UNSAT)
         {
-          r = Result(Result::UNSAT);
+          r = Result(Result::SAT);
         }
-        else
+        else if (r.asSatisfiabilityResult().isSat() == Result::SAT)
         {
-          r = Result(Result::SAT_UNKNOWN, Result::UNKNOWN_REASON);
+          // only if satisfaction complete
+          if (d_logic.isPure(THEORY_ARITH) || d_logic.isPure(THEORY_BV))
+          {
+            r = Result(Result::UNSAT);
+          }
+          else
+          {
+            r = Result(Result::SAT_UNKNOWN, Result::UNKNOWN_REASON);
+          }
         }
+        Trace("smt") << "SmtEngine::global negate returned " << r << std::endl;
+      }
+
+      if (d_resultCache != nullptr)
+      {
+        d_resultCache->store(fingerprint, r);
       }
-      Trace("smt") << "SmtEngine::global negate returned " << r << std::endl;
     }
 
     d_needPostsolve = true;
@@ -3837,6 +4202,10 @@ Result SmtEngine::checkSatisfiability(const vector<Expr>& assumptions,
     AlwaysAssert(d_private->getResourceManager()->out());
     Result::UnknownExplanation why = d_private->getResourceManager()->outOfResources() ?
       Result::RESOURCEOUT : Result::TIMEOUT;
+    if (d_private->getResourceManager()->outOfMemory())
+    {
+      why = Result::MEMOUT;
+    }
     return Result(Result::SAT_UNKNOWN, why, d_filename);
   }
 }
@@ -3896,6 +4265,23 @@ Result SmtEngine::assertFormula(const Expr& ex, bool inUnsatCore)
   return quickCheck().asValidityResult();
 }/* SmtEngine::assertFormula() */
 
+void SmtEngine::assertClauses(const std::vector<int>& literals)
+{
+  SmtScope smts(this);
+  finalOptionsAreSet();
+  doPendingPops();
+
+  Trace("smt") << "SmtEngine::assertClauses(" << literals.size()
+               << " literals)" << endl;
+
+  if (options::proof() || options::unsatCores())
+  {
+    throw ModalException(
+        "Cannot assert DIMACS clauses when proofs or unsat cores are enabled.");
+  }
+  d_propEngine->assertDimacsClauses(literals);
+}
+
 /*
    --------------------------------------------------------------------------
     Handling SyGuS commands
@@ -4199,6 +4585,16 @@ Expr SmtEngine::getValue(const Expr& ex) const
     Dump("benchmark") << GetValueCommand(ex);
   }
 
+  TheoryModel* m = getAvailableModel("get-value");
+  unordered_map<Node, Node, NodeHashFunction> cache;
+  return getValueInternal(ex, m, cache);
+}
+
+Expr SmtEngine::getValueInternal(
+    const Expr& ex,
+    TheoryModel* m,
+    unordered_map<Node, Node, NodeHashFunction>& cache) const
+{
   // Substitute out any abstract values in ex.
   Expr e = d_private->substituteAbstractValues(Node::fromExpr(ex)).toExpr();
 
@@ -4213,7 +4609,6 @@ Expr SmtEngine::getValue(const Expr& ex) const
   TypeNode expectedType = n.getType();
 
   // Expand, then normalize
-  unordered_map<Node, Node, NodeHashFunction> cache;
   n = d_private->expandDefinitions(n, cache);
   // There are two ways model values for terms are computed (for historical
   // reasons).  One way is that used in check-model; the other is that
@@ -4227,7 +4622,6 @@ Expr SmtEngine::getValue(const Expr& ex) const
   }
 
   Trace("smt") << "--- getting value of " << n << endl;
-  TheoryModel* m = getAvailableModel("get-value");
   Node resultNode;
   if(m != NULL) {
     resultNode = m->getValue(n);
@@ -4258,12 +4652,29 @@ Expr SmtEngine::getValue(const Expr& ex) const
   return resultNode.toExpr();
 }
 
-vector<Expr> SmtEngine::getValues(const vector<Expr>& exprs)
+vector<Expr> SmtEngine::getValues(const vector<Expr>& exprs) const
 {
+  SmtScope smts(this);
+
+  Trace("smt") << "SMT getValues(" << exprs.size() << " terms)" << endl;
+  if (Dump.isOn("benchmark"))
+  {
+    for (const Expr& e : exprs)
+    {
+      Dump("benchmark") << GetValueCommand(e);
+    }
+  }
+
+  // the model is checked once, and the definitions of the subterms common
+  // to the terms are expanded once
+  TheoryModel* m = getAvailableModel("get-value");
+  unordered_map<Node, Node, NodeHashFunction> cache;
   vector<Expr> result;
+  result.reserve(exprs.size());
   for (const Expr& e : exprs)
   {
-    result.push_back(getValue(e));
+    Assert(e.getExprManager() == d_exprManager);
+    result.push_back(getValueInternal(e, m, cache));
   }
   return result;
 }
@@ -4445,7 +4856,7 @@ Result SmtEngine::blockModel()
   std::vector<Expr> eassertsProc = getExpandedAssertions();
   Expr eblocker = ModelBlocker::getModelBlocker(
       eassertsProc, m, options::blockModelsMode());
-  return assertFormula(eblocker);
+  return assertModelBlocker(eblocker);
 }
 
 Result SmtEngine::blockModelValues(const std::vector<Expr>& exprs)
@@ -4470,7 +4881,62 @@ Result SmtEngine::blockModelValues(const std::vector<Expr>& exprs)
   // we always do block model values mode here
   Expr eblocker = ModelBlocker::getModelBlocker(
       eassertsProc, m, options::BlockModelsMode::VALUES, exprs);
-  return assertFormula(eblocker);
+  return assertModelBlocker(eblocker);
+}
+
+Integer SmtEngine::countModels(const std::vector<Expr>& exprs,
+                               bool approximate)
+{
+  Trace("smt") << "SMT countModels(" << exprs << ")" << endl;
+  SmtScope smts(this);
+
+  finalOptionsAreSet();
+
+  if (!options::produceModels() || !options::incrementalSolving())
+  {
+    throw ModalException(
+        "Cannot count models unless produce-models and incremental are on.");
+  }
+  ModelCounter counter(this, exprs);
+  return counter.count(approximate);
+}
+
+Result SmtEngine::assertModelBlocker(const Expr& blocker)
+{
+  // the proofs and unsat cores need the blocker as an input assertion
+  if (!options::blockModelsSat() || options::unsatCores() || options::proof())
+  {
+    return assertFormula(blocker);
+  }
+  Node b = Rewriter::rewrite(Node::fromExpr(blocker));
+  std::vector<Node> lits;
+  if (b.getKind() == kind::OR)
+  {
+    lits.insert(lits.end(), b.begin(), b.end());
+  }
+  else
+  {
+    lits.push_back(b);
+  }
+  for (const Node& lit : lits)
+  {
+    Node atom = lit.getKind() == kind::NOT ? lit[0] : lit;
+    // atoms unknown to the SAT solver may need to be preprocessed, e.g. if
+    // their variables were eliminated, or to be registered with the theories
+    if (!atom.isConst() && !d_propEngine->isSatLiteral(atom))
+    {
+      Trace("smt") << "SMT model blocker " << atom << " is not a SAT literal"
+                   << endl;
+      return assertFormula(blocker);
+    }
+  }
+  doPendingPops();
+  if (d_assertionList != NULL)
+  {
+    d_assertionList->push_back(blocker);
+  }
+  d_propEngine->assertFormula(b);
+  return quickCheck().asValidityResult();
 }
 
 std::pair<Expr, Expr> SmtEngine::getSepHeapAndNilExpr(void)
@@ -4567,7 +5033,12 @@ UnsatCore SmtEngine::getUnsatCoreInternal()
   }
 
   d_proofManager->traceUnsatCore();  // just to trigger core creation
-  return UnsatCore(this, d_proofManager->extractUnsatCore());
+  std::vector<Expr> core = d_proofManager->extractUnsatCore();
+  if (options::minimalUnsatCores())
+  {
+    core = minimizeUnsatCore(core);
+  }
+  return UnsatCore(this, core);
 #else  /* IS_PROOFS_BUILD */
   throw ModalException(
       "This build of CVC4 doesn't have proof support (required for unsat "
@@ -4575,6 +5046,78 @@ UnsatCore SmtEngine::getUnsatCoreInternal()
 #endif /* IS_PROOFS_BUILD */
 }
 
+std::vector<Expr> SmtEngine::minimizeUnsatCore(const std::vector<Expr>& core)
+{
+  Trace("smt-min-core") << "SmtEngine::minimizeUnsatCore: core of size "
+                        << core.size() << endl;
+  const unsigned long timeLimit = options::minimalUnsatCoresTimeLimit();
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  const bool checkUnsatCores = options::checkUnsatCores();
+  const bool checkProofs = options::checkProofs();
+  options::checkUnsatCores.set(false);
+  options::checkProofs.set(false);
+
+  std::vector<Expr> minimal = core;
+  try
+  {
+    // minimal[i] is removed if minimal without it is unsatisfiable
+    for (size_t i = 0; i < minimal.size();)
+    {
+      unsigned long elapsed = static_cast<unsigned long>(
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::steady_clock::now() - start)
+              .count());
+      if (timeLimit > 0 && elapsed >= timeLimit)
+      {
+        Trace("smt-min-core") << "...time limit reached" << endl;
+        break;
+      }
+      SmtEngine coreChecker(d_exprManager);
+      coreChecker.setLogic(getLogicInfo());
+      if (timeLimit > 0)
+      {
+        coreChecker.setTimeLimit(timeLimit - elapsed);
+      }
+      PROOF(
+      std::vector<Command*>::const_iterator itg = d_defineCommands.begin();
+      for (; itg != d_defineCommands.end(); ++itg) {
+        (*itg)->invoke(&coreChecker);
+      }
+      );
+      for (size_t j = 0; j < minimal.size(); j++)
+      {
+        if (j != i)
+        {
+          coreChecker.assertFormula(minimal[j]);
+        }
+      }
+      Result r = coreChecker.checkSat();
+      Trace("smt-min-core") << "...without " << minimal[i] << ": " << r
+                            << endl;
+      if (r.asSatisfiabilityResult().isSat() == Result::UNSAT)
+      {
+        minimal.erase(minimal.begin() + i);
+      }
+      else
+      {
+        i++;
+      }
+    }
+  }
+  catch (...)
+  {
+    options::checkUnsatCores.set(checkUnsatCores);
+    options::checkProofs.set(checkProofs);
+    throw;
+  }
+  options::checkUnsatCores.set(checkUnsatCores);
+  options::checkProofs.set(checkProofs);
+  Trace("smt-min-core") << "SmtEngine::minimizeUnsatCore: minimal core of size "
+                        << minimal.size() << endl;
+  return minimal;
+}
+
 void SmtEngine::checkUnsatCore() {
   Assert(options::unsatCores())
       << "cannot check unsat core if unsat cores are turned off";
@@ -5535,6 +6078,22 @@ void SmtEngine::resetAssertions()
   // Remember the global push/pop around everything when beyond Start mode
   // (see solver execution modes in the SMT-LIB standard)
   Assert(d_userLevels.size() == 0 && d_userContext->getLevel() == 1);
+  if (options::incrementalSolving())
+  {
+    // Pop the SAT level of the global assertions, which keeps the clause
+    // database and the other structures of the SAT solver allocated, and the
+    // variables and clauses of level 0.
+    TimerStat::CodeTimer pushPopTimer(d_stats->d_pushPopTime);
+    d_propEngine->pop();
+    d_context->popto(0);
+    d_userContext->popto(0);
+    DeleteAndClearCommandVector(d_modelGlobalCommands);
+    d_userContext->push();
+    d_context->push();
+    d_propEngine->push();
+    assertTrueAndNotFalse();
+    return;
+  }
   d_context->popto(0);
   d_userContext->popto(0);
   DeleteAndClearCommandVector(d_modelGlobalCommands);
@@ -5551,9 +6110,35 @@ void SmtEngine::resetAssertions()
                                     getUserContext(),
                                     d_private->getReplayLog(),
                                     d_replayStream));
+  setPropEngineClauseSharing();
   d_theoryEngine->setPropEngine(getPropEngine());
 }
 
+int SmtEngine::fork()
+{
+  SmtScope smts(this);
+  finalOptionsAreSet();
+  doPendingPops();
+  Trace("smt") << "SMT fork()" << endl;
+  d_private->processAssertions();
+  // buffered output would otherwise be printed by both processes
+  cout.flush();
+  cerr.flush();
+  NodeManager::currentNM()->getOptions().flushOut();
+  NodeManager::currentNM()->getOptions().flushErr();
+#ifndef _WIN32
+  pid_t pid = ::fork();
+  if (pid < 0)
+  {
+    throw Exception(std::string("cannot fork the solver: ")
+                    + strerror(errno));
+  }
+  return pid;
+#else  /* _WIN32 */
+  throw Exception("forking the solver is not supported on this platform");
+#endif /* _WIN32 */
+}
+
 void SmtEngine::interrupt()
 {
   if(!d_fullyInited) {
@@ -5602,6 +6187,21 @@ void SmtEngine::safeFlushStatistics(int fd) const {
   d_statisticsRegistry->safeFlushInformation(fd);
 }
 
+void SmtEngine::printPreprocessingProfile(std::ostream& out) const
+{
+  if (d_private == nullptr
+      || d_private->getPreprocessingPassContext() == nullptr)
+  {
+    return;
+  }
+  PreprocessingProfile* profile =
+      d_private->getPreprocessingPassContext()->getProfile();
+  if (profile != nullptr)
+  {
+    profile->printTable(out);
+  }
+}
+
 void SmtEngine::setUserAttribute(const std::string& attr,
                                  Expr expr,
                                  const std::vector<Expr>& expr_values,
@@ -5684,6 +6284,51 @@ void SmtEngine::setOption(const std::string& key, const CVC4::SExpr& value)
 }
 
 void SmtEngine::setIsInternalSubsolver() { d_isInternalSubsolver = true; }
+
+void SmtEngine::setClauseSharing(ClauseSharing* sharing,
+                                 const std::vector<Expr>& atoms)
+{
+  if (d_fullyInited)
+  {
+    throw ModalException(
+        "Cannot set up the clause sharing of SmtEngine after the engine has "
+        "finished initializing.");
+  }
+  d_clauseSharing = sharing;
+  d_sharedAtoms = atoms;
+}
+
+void SmtEngine::setPropEngineClauseSharing()
+{
+  if (d_clauseSharing == nullptr)
+  {
+    return;
+  }
+  std::vector<Node> atoms;
+  for (const Expr& a : d_sharedAtoms)
+  {
+    atoms.push_back(Node::fromExpr(a));
+  }
+  d_propEngine->setClauseSharing(d_clauseSharing, atoms);
+}
+
+theory::SubsolverPool* SmtEngine::getSubsolverPool()
+{
+  if (d_subsolverPool == nullptr)
+  {
+    d_subsolverPool.reset(new theory::SubsolverPool);
+  }
+  return d_subsolverPool.get();
+}
+
+preprocessing::PreprocessingCache* SmtEngine::getPreprocessingCache()
+{
+  if (d_preprocessingCache == nullptr)
+  {
+    d_preprocessingCache.reset(new preprocessing::PreprocessingCache);
+  }
+  return d_preprocessingCache.get();
+}
 CVC4::SExpr SmtEngine::getOption(const std::string& key) const
 {
   NodeManagerScope nms(d_nodeManager);
@@ -20,6 +20,7 @@
 #define CVC4__SMT_ENGINE_H
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "base/modal_exception.h"
@@ -34,6 +35,7 @@
 #include "smt/logic_exception.h"
 #include "theory/logic_info.h"
 #include "util/hash.h"
+#include "util/integer.h"
 #include "util/proof.h"
 #include "util/result.h"
 #include "util/sexpr.h"
@@ -62,6 +64,8 @@ class ProofManager;
 
 class Model;
 class LogicRequest;
+class ClauseSharing;
+class ResultCache;
 class StatisticsRegistry;
 
 /* -------------------------------------------------------------------------- */
@@ -74,6 +78,7 @@ namespace context {
 /* -------------------------------------------------------------------------- */
 
 namespace preprocessing {
+class PreprocessingCache;
 class PreprocessingPassContext;
 }
 
@@ -109,6 +114,9 @@ namespace smt {
 
 namespace theory {
   class TheoryModel;
+  class Rewriter;
+  class RewriteCache;
+  class SubsolverPool;
 }/* CVC4::theory namespace */
 
 // TODO: SAT layer (esp. CNF- versus non-clausal solvers under the
@@ -135,6 +143,7 @@ class CVC4_PUBLIC SmtEngine
   friend class ::CVC4::LogicRequest;
   friend class ::CVC4::Model;  // to access d_modelCommands
   friend class ::CVC4::theory::TheoryModel;
+  friend class ::CVC4::theory::Rewriter;
 
   /* .......................................................................  */
  public:
@@ -204,6 +213,25 @@ class CVC4_PUBLIC SmtEngine
    */
   void setIsInternalSubsolver();
 
+  /**
+   * Get the pool of subsolvers owned by this SmtEngine, which is used by
+   * theory::checkWithSubsolver if --subsolver-pool is enabled.
+   */
+  theory::SubsolverPool* getSubsolverPool();
+
+  /**
+   * Share the short learned clauses of the SAT solver with other solvers on
+   * the same problem through sharing (see smt/clause_sharing.h), over the
+   * given atoms. The other solvers must preprocess the problem alike, i.e.
+   * have the same options up to those of the search (--random-seed,
+   * --decision, --sat-solver), since the clauses are consequences of the
+   * preprocessed assertions. Sharing is disabled by --no-share-clauses and
+   * with incremental solving, unsat cores or proofs.
+   *
+   * @throw ModalException if the engine has finished initializing
+   */
+  void setClauseSharing(ClauseSharing* sharing, const std::vector<Expr>& atoms);
+
   /** set the input name */
   void setFilename(std::string filename);
   /** return the input name (if any) */
@@ -241,6 +269,16 @@ class CVC4_PUBLIC SmtEngine
    */
   Result blockModelValues(const std::vector<Expr>& exprs);
 
+  /**
+   * Returns the number of models of the current assertions projected on
+   * exprs, i.e. the number of distinct tuples of values of exprs in the
+   * models, where exprs are Boolean or bit-vector terms. The count is exact
+   * if approximate is false, and is otherwise an estimate by hashing, which
+   * is likely close to the exact count (see ModelCounter). Only permitted if
+   * produce-models and incremental are on.
+   */
+  Integer countModels(const std::vector<Expr>& exprs, bool approximate);
+
   /** When using separation logic, obtain the expression for the heap.  */
   Expr getSepHeapExpr();
 
@@ -308,6 +346,18 @@ class CVC4_PUBLIC SmtEngine
    */
   Result assertFormula(const Expr& e, bool inUnsatCore = true);
 
+  /**
+   * Add clauses in DIMACS form to the current context, directly to the SAT
+   * solver. The literals are the nonzero integers v and -v for the
+   * propositional variable v, and each clause is terminated by 0. The
+   * variables are not symbols of this SmtEngine and do not appear in its
+   * models; this is meant for pure SAT inputs (DIMACS and OPB), which skip
+   * term construction and preprocessing.
+   *
+   * @throw ModalException if proofs or unsat cores are enabled
+   */
+  void assertClauses(const std::vector<int>& literals);
+
   /**
    * Check validity of an expression with respect to the current set
    * of assertions by asserting the query expression's negation and
@@ -465,9 +515,11 @@ class CVC4_PUBLIC SmtEngine
   Expr getValue(const Expr& e) const;
 
   /**
-   * Same as getValue but for a vector of expressions
+   * Same as getValue but for a vector of expressions. The model is checked
+   * once for all the expressions, and the definitions of their common
+   * subexpressions are expanded once.
    */
-  std::vector<Expr> getValues(const std::vector<Expr>& exprs);
+  std::vector<Expr> getValues(const std::vector<Expr>& exprs) const;
 
   /**
    * Add a function to the set of expressions whose value is to be
@@ -657,6 +709,17 @@ class CVC4_PUBLIC SmtEngine
   /** Reset all assertions, global declarations, etc.  */
   void resetAssertions();
 
+  /**
+   * Fork the process, so that the child continues with a copy of this
+   * SmtEngine in its current state. The pending assertions are preprocessed
+   * before forking, so that the children do not preprocess them again.
+   * This can only be used when no other thread uses the solver.
+   *
+   * @return the pid of the child in the parent, and 0 in the child
+   * @throw Exception if the process cannot be forked
+   */
+  int fork();
+
   /**
    * Interrupt a running query.  This can be called from another thread
    * or from a signal handler.  Throws a ModalException if the SmtEngine
@@ -773,6 +836,12 @@ class CVC4_PUBLIC SmtEngine
   /** Flush statistic from this SmtEngine. Safe to use in a signal handler. */
   void safeFlushStatistics(int fd) const;
 
+  /**
+   * Print the profile of the preprocessing passes as a table, if
+   * --preprocess-profile is on.
+   */
+  void printPreprocessingProfile(std::ostream& out) const;
+
   /** Returns the most recent result of checkSat/query or (set-info :status). */
   Result getStatusOfLastCommand() const { return d_status; }
 
@@ -880,6 +949,12 @@ class CVC4_PUBLIC SmtEngine
     return d_statisticsRegistry.get();
   };
 
+  /**
+   * Get a pointer to the bounded rewrite cache owned by this SmtEngine, or
+   * null if the rewriter caches in attributes (--rewrite-cache-budget=0).
+   */
+  theory::RewriteCache* getRewriteCache() { return d_rewriteCache.get(); }
+
   /**
    * Check that a generated proof (via getProof()) checks.
    */
@@ -893,6 +968,15 @@ class CVC4_PUBLIC SmtEngine
    */
   UnsatCore getUnsatCoreInternal();
 
+  /**
+   * Returns a subset of core which is still unsatisfiable, obtained by
+   * deletion: each assertion of core is removed if the other assertions are
+   * unsatisfiable without it, which is checked by a subsolver. The
+   * minimization stops when its time limit (minimal-unsat-cores-tlimit) is
+   * reached, keeping the assertions that were not checked.
+   */
+  std::vector<Expr> minimizeUnsatCore(const std::vector<Expr>& core);
+
   /**
    * Check that an unsatisfiable core is indeed unsatisfiable.
    */
@@ -938,6 +1022,9 @@ class CVC4_PUBLIC SmtEngine
    */
   void finalOptionsAreSet();
 
+  /** Asserts true and (not false) to the PropEngine. */
+  void assertTrueAndNotFalse();
+
   /**
    * Apply heuristics settings and other defaults.  Done once, at
    * finishInit() time.
@@ -951,6 +1038,15 @@ class CVC4_PUBLIC SmtEngine
    */
   void setProblemExtended();
 
+  /**
+   * Asserts the blocking formula blocker of the current model. If
+   * --block-models-sat is set and the atoms of the rewritten blocker are all
+   * literals of the SAT solver, the blocker is given to the SAT solver as a
+   * clause at the current user level, without preprocessing it. Otherwise,
+   * it is asserted like assertFormula does.
+   */
+  Result assertModelBlocker(const Expr& blocker);
+
   /**
    * Create theory engine, prop engine, decision engine. Called by
    * finalOptionsAreSet()
@@ -990,6 +1086,15 @@ class CVC4_PUBLIC SmtEngine
    */
   theory::TheoryModel* getAvailableModel(const char* c) const;
 
+  /**
+   * Get the value of ex in model m, where cache is the cache of the
+   * expansion of definitions.
+   */
+  Expr getValueInternal(
+      const Expr& ex,
+      theory::TheoryModel* m,
+      std::unordered_map<Node, Node, NodeHashFunction>& cache) const;
+
   /**
    * Fully type-check the argument, and also type-check that it's
    * actually Boolean.
@@ -1259,6 +1364,32 @@ class CVC4_PUBLIC SmtEngine
 
   std::unique_ptr<smt::SmtEngineStatistics> d_stats;
 
+  /** The bounded rewrite cache, if --rewrite-cache-budget is set. */
+  std::unique_ptr<theory::RewriteCache> d_rewriteCache;
+
+  /** The pool of subsolvers, created on demand */
+  std::unique_ptr<theory::SubsolverPool> d_subsolverPool;
+
+  /**
+   * The results of the preprocessing passes, with --preprocess-cache, created
+   * on demand. It survives (reset-assertions).
+   */
+  std::unique_ptr<preprocessing::PreprocessingCache> d_preprocessingCache;
+
+  /** Get the cache of the results of the preprocessing passes. */
+  preprocessing::PreprocessingCache* getPreprocessingCache();
+
+  /** The cache of the results of the checks, if --result-cache is set */
+  std::unique_ptr<ResultCache> d_resultCache;
+
+  /** The channel of the shared learned clauses, see setClauseSharing() */
+  ClauseSharing* d_clauseSharing;
+  /** The atoms of the shared learned clauses */
+  std::vector<Expr> d_sharedAtoms;
+
+  /** Set up the clause sharing of the PropEngine, if there is one. */
+  void setPropEngineClauseSharing();
+
   /*---------------------------- sygus commands  ---------------------------*/
 
   /**
@@ -0,0 +1,366 @@
+/*********************                                                        */
+/*! \file strategy_selector.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Selection of option presets from the features of a problem
+ **/
+
+#include "smt/strategy_selector.h"
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+#include "base/exception.h"
+#include "expr/type.h"
+
+namespace CVC4 {
+
+namespace {
+
+/** Is a a Boolean term that is not built by a connective? */
+bool isAtom(Expr a)
+{
+  if (!a.getType().isBoolean() || a.isConst())
+  {
+    return false;
+  }
+  switch (a.getKind())
+  {
+    case kind::NOT:
+    case kind::AND:
+    case kind::OR:
+    case kind::IMPLIES:
+    case kind::XOR:
+    case kind::ITE:
+    case kind::FORALL:
+    case kind::EXISTS: return false;
+    case kind::EQUAL: return !a[0].getType().isBoolean();
+    default: return true;
+  }
+}
+
+/**
+ * The table shipped with CVC4.  It starts from the final configurations of
+ * the SMT-COMP run script (contrib/competitions/smt-comp), and refines them
+ * on the features that matter for the alternatives the script tries.
+ */
+const char* s_defaultTable =
+    "# pure bit-vector problems are bit-blasted eagerly\n"
+    "logic=QF_BV apply-uf=0 => bitblast=eager\n"
+    "# ITE-heavy integer problems are usually encoded pseudo-Boolean ones\n"
+    "logic=QF_LIA ite-density>=0.05 => miplib-trick=true ite-simp=true "
+    "simp-ite-compress=true\n"
+    "logic=QF_LIA => miplib-trick=true\n"
+    "logic=QF_LRA => miplib-trick=true use-soi=true\n"
+    "logic=QF_NIA => nl-ext-tplanes=true decision=internal\n"
+    "logic=QF_NRA => nl-ext-tplanes=true decision=justification\n"
+    "logic=QF_AUFLIA => arrays-eager-lemmas=true decision=justification\n"
+    "logic=QF_AX => arrays-eager-lemmas=true decision=internal\n"
+    "logic=QF_AUFBV => ite-simp=true\n"
+    "# quantified bit-vector problems are essentially bit-vector problems\n"
+    "quantifiers>0 bv-terms>0 => full-saturate-quant=true decision=internal\n"
+    "quantifiers>0 => full-saturate-quant=true\n";
+
+}  // namespace
+
+ProblemFeatures::ProblemFeatures()
+{
+  for (const std::string& name : getNames())
+  {
+    d_features[name] = 0;
+  }
+}
+
+const std::vector<std::string>& ProblemFeatures::getNames()
+{
+  static const std::vector<std::string> names = {"assertions",
+                                                 "dag-size",
+                                                 "tree-size",
+                                                 "sharing",
+                                                 "depth",
+                                                 "avg-arity",
+                                                 "atoms",
+                                                 "variables",
+                                                 "apply-uf",
+                                                 "ite",
+                                                 "ite-density",
+                                                 "bv-terms",
+                                                 "max-bv-width",
+                                                 "quantifiers",
+                                                 "quantifier-nesting"};
+  return names;
+}
+
+bool ProblemFeatures::isName(const std::string& name)
+{
+  const std::vector<std::string>& names = getNames();
+  return name.compare(0, 5, "kind:") == 0
+         || std::find(names.begin(), names.end(), name) != names.end();
+}
+
+void ProblemFeatures::addAssertion(Expr a)
+{
+  const TermInfo& info = visit(a);
+  d_features["assertions"] += 1;
+  d_features["tree-size"] += info.d_treeSize;
+  d_features["depth"] = std::max<double>(d_features["depth"], info.d_height);
+  d_features["quantifier-nesting"] = std::max<double>(
+      d_features["quantifier-nesting"], info.d_quantNesting);
+}
+
+const ProblemFeatures::TermInfo& ProblemFeatures::visit(Expr e)
+{
+  // visit the subterms before the terms, without recursion
+  std::vector<std::pair<Expr, bool> > toVisit;
+  toVisit.push_back(std::make_pair(e, false));
+  while (!toVisit.empty())
+  {
+    Expr cur = toVisit.back().first;
+    bool childrenDone = toVisit.back().second;
+    if (d_visited.find(cur) != d_visited.end())
+    {
+      toVisit.pop_back();
+      continue;
+    }
+    if (!childrenDone)
+    {
+      toVisit.back().second = true;
+      for (const Expr& c : cur)
+      {
+        toVisit.push_back(std::make_pair(c, false));
+      }
+      continue;
+    }
+    toVisit.pop_back();
+    TermInfo info;
+    info.d_height = 0;
+    info.d_quantNesting = 0;
+    info.d_treeSize = 1;
+    for (const Expr& c : cur)
+    {
+      const TermInfo& ci = d_visited[c];
+      info.d_height = std::max(info.d_height, ci.d_height + 1);
+      info.d_quantNesting = std::max(info.d_quantNesting, ci.d_quantNesting);
+      // saturate, trees can be exponentially larger than their DAGs
+      info.d_treeSize = std::min(info.d_treeSize + ci.d_treeSize, 1e18);
+    }
+
+    Kind k = cur.getKind();
+    ++d_kinds[k];
+    d_features["dag-size"] += 1;
+    d_features["avg-arity"] += cur.getNumChildren();
+    if (k == kind::FORALL || k == kind::EXISTS)
+    {
+      d_features["quantifiers"] += 1;
+      ++info.d_quantNesting;
+    }
+    else if (k == kind::ITE)
+    {
+      d_features["ite"] += 1;
+    }
+    else if (k == kind::APPLY_UF)
+    {
+      d_features["apply-uf"] += 1;
+    }
+    if (cur.isVariable() && k != kind::BOUND_VARIABLE)
+    {
+      d_features["variables"] += 1;
+    }
+    if (isAtom(cur))
+    {
+      d_features["atoms"] += 1;
+    }
+    Type t = cur.getType();
+    if (t.isBitVector())
+    {
+      d_features["bv-terms"] += 1;
+      d_features["max-bv-width"] = std::max<double>(
+          d_features["max-bv-width"], BitVectorType(t).getSize());
+    }
+    d_visited[cur] = info;
+  }
+  return d_visited[e];
+}
+
+double ProblemFeatures::get(const std::string& name) const
+{
+  if (name.compare(0, 5, "kind:") == 0)
+  {
+    for (const std::pair<const Kind, uint64_t>& kc : d_kinds)
+    {
+      if (kind::kindToString(kc.first) == name.substr(5))
+      {
+        return kc.second;
+      }
+    }
+    return 0;
+  }
+  // the ratios are kept as the counts of their numerators
+  double dagSize = std::max(d_features.at("dag-size"), 1.0);
+  if (name == "sharing")
+  {
+    return d_features.at("tree-size") / dagSize;
+  }
+  if (name == "ite-density")
+  {
+    return d_features.at("ite") / dagSize;
+  }
+  if (name == "avg-arity")
+  {
+    return d_features.at("avg-arity") / dagSize;
+  }
+  std::map<std::string, double>::const_iterator it = d_features.find(name);
+  return it == d_features.end() ? 0 : it->second;
+}
+
+void ProblemFeatures::toStream(std::ostream& out) const
+{
+  out << "logic " << (d_logic.empty() ? "ALL" : d_logic) << std::endl;
+  for (const std::string& name : getNames())
+  {
+    out << name << " " << get(name) << std::endl;
+  }
+  for (const std::pair<const Kind, uint64_t>& kc : d_kinds)
+  {
+    out << "kind:" << kc.first << " " << kc.second << std::endl;
+  }
+}
+
+StrategyTable::StrategyTable(std::istream& in, const std::string& name)
+{
+  std::string line;
+  for (unsigned lineNo = 1; std::getline(in, line); ++lineNo)
+  {
+    std::string where = name + ":" + std::to_string(lineNo) + ": ";
+    std::istringstream words(line);
+    std::string word;
+    if (!(words >> word) || word[0] == '#')
+    {
+      continue;
+    }
+    Rule r;
+    bool inOptions = false;
+    do
+    {
+      if (word == "=>")
+      {
+        inOptions = true;
+        continue;
+      }
+      if (inOptions)
+      {
+        size_t eq = word.find('=');
+        if (eq == std::string::npos || eq == 0)
+        {
+          throw Exception(where + "expected OPTION=VALUE, got " + word);
+        }
+        r.d_options.push_back(
+            std::make_pair(word.substr(0, eq), word.substr(eq + 1)));
+        continue;
+      }
+      size_t op = word.find_first_of("<>=!");
+      if (op == std::string::npos || op == 0)
+      {
+        throw Exception(where + "expected a condition, got " + word);
+      }
+      size_t value = word.find_first_not_of("<>=!", op);
+      Condition c;
+      c.d_feature = word.substr(0, op);
+      c.d_op = word.substr(op, value - op);
+      c.d_value = 0;
+      std::string v = value == std::string::npos ? "" : word.substr(value);
+      if (c.d_op != "<" && c.d_op != "<=" && c.d_op != ">" && c.d_op != ">="
+          && c.d_op != "=" && c.d_op != "!=")
+      {
+        throw Exception(where + "unknown relation " + c.d_op);
+      }
+      if (c.d_feature == "logic")
+      {
+        if (c.d_op != "=" && c.d_op != "!=")
+        {
+          throw Exception(where + "logics can only be compared by = and !=");
+        }
+        c.d_logic = v;
+      }
+      else
+      {
+        if (!ProblemFeatures::isName(c.d_feature))
+        {
+          throw Exception(where + "unknown feature " + c.d_feature);
+        }
+        std::istringstream vs(v);
+        if (!(vs >> c.d_value) || !vs.eof())
+        {
+          throw Exception(where + "expected a number, got " + v);
+        }
+      }
+      r.d_conditions.push_back(c);
+    } while (words >> word);
+    if (!inOptions)
+    {
+      throw Exception(where + "expected => in rule");
+    }
+    d_rules.push_back(r);
+  }
+}
+
+const StrategyTable& StrategyTable::getDefault()
+{
+  static std::istringstream in(s_defaultTable);
+  static const StrategyTable table(in, "<default>");
+  return table;
+}
+
+bool StrategyTable::holds(const Condition& c, const ProblemFeatures& f)
+{
+  if (c.d_feature == "logic")
+  {
+    return (f.getLogic() == c.d_logic) == (c.d_op == "=");
+  }
+  double v = f.get(c.d_feature);
+  if (c.d_op == "<")
+  {
+    return v < c.d_value;
+  }
+  if (c.d_op == "<=")
+  {
+    return v <= c.d_value;
+  }
+  if (c.d_op == ">")
+  {
+    return v > c.d_value;
+  }
+  if (c.d_op == ">=")
+  {
+    return v >= c.d_value;
+  }
+  return (v == c.d_value) == (c.d_op == "=");
+}
+
+std::vector<std::pair<std::string, std::string> > StrategyTable::select(
+    const ProblemFeatures& f) const
+{
+  for (const Rule& r : d_rules)
+  {
+    bool all = true;
+    for (const Condition& c : r.d_conditions)
+    {
+      all = all && holds(c, f);
+    }
+    if (all)
+    {
+      return r.d_options;
+    }
+  }
+  return {};
+}
+
+}  // namespace CVC4
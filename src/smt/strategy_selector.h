@@ -0,0 +1,162 @@
+/*********************                                                        */
+/*! \file strategy_selector.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Selection of option presets from the features of a problem.
+ **
+ ** ProblemFeatures summarizes a set of assertions (term kinds, bit-vector
+ ** widths, quantifiers, ITE density, the shape of the term graph), and a
+ ** StrategySelector maps these features to option settings.  The selector
+ ** shipped with CVC4 is a StrategyTable, a decision list that can be
+ ** replaced by one trained offline and loaded from a file.
+ **/
+
+#include "cvc4_public.h"
+
+#ifndef CVC4__SMT__STRATEGY_SELECTOR_H
+#define CVC4__SMT__STRATEGY_SELECTOR_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "expr/expr.h"
+#include "expr/kind.h"
+
+namespace CVC4 {
+
+/** The features of a problem that strategies are selected on. */
+class CVC4_PUBLIC ProblemFeatures
+{
+ public:
+  ProblemFeatures();
+
+  /** Set the logic of the problem. */
+  void setLogic(const std::string& logic) { d_logic = logic; }
+  /** Get the logic of the problem, or the empty string if not set. */
+  const std::string& getLogic() const { return d_logic; }
+
+  /** Add an assertion of the problem. */
+  void addAssertion(Expr a);
+
+  /**
+   * Get the numeric feature name, one of getNames() or "kind:K" for the
+   * number of distinct terms of kind K (e.g. "kind:BITVECTOR_MULT").
+   * Returns 0 for kinds that do not occur.
+   */
+  double get(const std::string& name) const;
+
+  /** Is name the name of a numeric feature? */
+  static bool isName(const std::string& name);
+
+  /** Get the names of the numeric features, except the kind counts. */
+  static const std::vector<std::string>& getNames();
+
+  /** Print the features, one "name value" per line. */
+  void toStream(std::ostream& out) const;
+
+ private:
+  /** Summary of the (shared) subterm rooted at a term. */
+  struct TermInfo
+  {
+    /** The height of the term. */
+    unsigned d_height;
+    /** The nesting depth of quantifiers in the term. */
+    unsigned d_quantNesting;
+    /** The size of the term as a tree, saturated. */
+    double d_treeSize;
+  };
+
+  /** Visit e and its subterms, return its summary. */
+  const TermInfo& visit(Expr e);
+
+  /** The logic */
+  std::string d_logic;
+  /** The summaries of the visited terms. */
+  std::map<Expr, TermInfo> d_visited;
+  /** The number of distinct terms of each kind. */
+  std::map<Kind, uint64_t> d_kinds;
+  /** The numeric features, by name. */
+  std::map<std::string, double> d_features;
+}; /* class ProblemFeatures */
+
+/** Maps the features of a problem to option settings. */
+class CVC4_PUBLIC StrategySelector
+{
+ public:
+  virtual ~StrategySelector() {}
+
+  /**
+   * Select the options (pairs of an option name and a value, as in
+   * set-option) for a problem with features f.
+   */
+  virtual std::vector<std::pair<std::string, std::string> > select(
+      const ProblemFeatures& f) const = 0;
+}; /* class StrategySelector */
+
+/**
+ * A strategy selector given by a decision list.  Each rule is a line
+ *
+ *   COND ... => OPTION=VALUE ...
+ *
+ * where each COND is FEATURE OP NUMBER with OP one of <, <=, >, >=, = and
+ * !=, or logic=LOGIC or logic!=LOGIC.  The options of the first rule whose
+ * conditions all hold are selected.  Empty lines and lines starting with #
+ * are ignored; a rule without conditions always applies.  A decision tree
+ * is written as the list of its paths.
+ */
+class CVC4_PUBLIC StrategyTable : public StrategySelector
+{
+ public:
+  /**
+   * Read the rules of a table from in, named name in error messages.
+   *
+   * @throws Exception if the table is malformed
+   */
+  StrategyTable(std::istream& in, const std::string& name);
+
+  /** Get the table shipped with CVC4. */
+  static const StrategyTable& getDefault();
+
+  std::vector<std::pair<std::string, std::string> > select(
+      const ProblemFeatures& f) const override;
+
+ private:
+  /** A condition of a rule. */
+  struct Condition
+  {
+    std::string d_feature;
+    std::string d_op;
+    /** The value of logic conditions. */
+    std::string d_logic;
+    /** The value of numeric conditions. */
+    double d_value;
+  };
+
+  /** A rule of the table. */
+  struct Rule
+  {
+    std::vector<Condition> d_conditions;
+    std::vector<std::pair<std::string, std::string> > d_options;
+  };
+
+  /** Does c hold for f? */
+  static bool holds(const Condition& c, const ProblemFeatures& f);
+
+  /** The rules, in order. */
+  std::vector<Rule> d_rules;
+}; /* class StrategyTable */
+
+}  // namespace CVC4
+
+#endif /* CVC4__SMT__STRATEGY_SELECTOR_H */
@@ -19,6 +19,7 @@
 
 #include "expr/node_algorithm.h"
 #include "options/proof_options.h"
+#include "options/smt_options.h"
 #include "proof/proof_manager.h"
 
 using namespace std;
@@ -32,6 +33,26 @@ RemoveTermFormulas::RemoveTermFormulas(context::UserContext* u)
 
 RemoveTermFormulas::~RemoveTermFormulas() {}
 
+template <class MkSkolem>
+Node RemoveTermFormulas::getPersistentSkolemForNode(Node node, MkSkolem mk)
+{
+  if (!options::persistentTermSkolems())
+  {
+    return mk();
+  }
+  std::unordered_map<Node, Node, NodeHashFunction>::const_iterator it =
+      d_persistentSkolems.find(node);
+  if (it != d_persistentSkolems.end())
+  {
+    Debug("ite") << "removeITEs: reusing the skolem " << it->second << " of "
+                 << node << std::endl;
+    return it->second;
+  }
+  Node skolem = mk();
+  d_persistentSkolems[node] = skolem;
+  return skolem;
+}
+
 void RemoveTermFormulas::run(std::vector<Node>& output, IteSkolemMap& iteSkolemMap, bool reportDeps)
 {
   size_t n = output.size();
@@ -96,10 +117,12 @@ Node RemoveTermFormulas::run(TNode node, std::vector<Node>& output,
       if (skolem.isNull())
       {
         // Make the skolem to represent the ITE
-        skolem = nodeManager->mkSkolem(
-            "termITE",
-            nodeType,
-            "a variable introduced due to term-level ITE removal");
+        skolem = getPersistentSkolemForNode(node, [&]() {
+          return nodeManager->mkSkolem(
+              "termITE",
+              nodeType,
+              "a variable introduced due to term-level ITE removal");
+        });
         d_skolem_cache.insert(node, skolem);
 
         // The new assertion
@@ -117,10 +140,12 @@ Node RemoveTermFormulas::run(TNode node, std::vector<Node>& output,
       if (skolem.isNull())
       {
         // Make the skolem to represent the lambda
-        skolem = nodeManager->mkSkolem(
-            "lambdaF",
-            nodeType,
-            "a function introduced due to term-level lambda removal");
+        skolem = getPersistentSkolemForNode(node, [&]() {
+          return nodeManager->mkSkolem(
+              "lambdaF",
+              nodeType,
+              "a function introduced due to term-level lambda removal");
+        });
         d_skolem_cache.insert(node, skolem);
 
         // The new assertion
@@ -149,10 +174,12 @@ Node RemoveTermFormulas::run(TNode node, std::vector<Node>& output,
       if (skolem.isNull())
       {
         // Make the skolem to witness the choice
-        skolem = nodeManager->mkSkolem(
-            "choiceK",
-            nodeType,
-            "a skolem introduced due to term-level Hilbert choice removal");
+        skolem = getPersistentSkolemForNode(node, [&]() {
+          return nodeManager->mkSkolem(
+              "choiceK",
+              nodeType,
+              "a skolem introduced due to term-level Hilbert choice removal");
+        });
         d_skolem_cache.insert(node, skolem);
 
         Assert(node[0].getNumChildren() == 1);
@@ -176,7 +203,8 @@ Node RemoveTermFormulas::run(TNode node, std::vector<Node>& output,
       // special kind (BOOLEAN_TERM_VARIABLE) that ensures they are handled
       // properly in theory combination. We must use this kind here instead of a
       // generic skolem.
-      skolem = nodeManager->mkBooleanTermVariable();
+      skolem = getPersistentSkolemForNode(
+          node, [&]() { return nodeManager->mkBooleanTermVariable(); });
       d_skolem_cache.insert(node, skolem);
 
       // The new assertion
@@ -76,6 +76,28 @@ class RemoveTermFormulas {
    */
   inline Node getSkolemForNode(Node node) const;
 
+  /** persistent skolem cache
+   *
+   * With --persistent-term-skolems, this maps terms to the skolem we used to
+   * replace them in any user context, including the popped ones. When a term
+   * is processed again after its user context was popped, its skolem is
+   * reused and its defining assertion, which was popped too, is added again.
+   * This is sound since the skolem only occurs in this definition and in the
+   * assertions where it replaces the term. Reusing the skolem keeps the
+   * atoms of the asserted formulas the same across the queries, so that
+   * their entries in the caches indexed by nodes (rewriter, theory
+   * preprocessing, ...) are reused.
+   */
+  std::unordered_map<Node, Node, NodeHashFunction> d_persistentSkolems;
+
+  /**
+   * Returns the skolem of node that is stored in d_persistentSkolems, or the
+   * result of mk(), which is stored in d_persistentSkolems, if there is none
+   * or the skolems are not persistent.
+   */
+  template <class MkSkolem>
+  Node getPersistentSkolemForNode(Node node, MkSkolem mk);
+
   static bool hasNestedTermChildren( TNode node );
 public:
 
@@ -362,6 +362,414 @@ public:
   double sumInfeasibilities(bool mip) const override { return 0.0; }
 };
 
+/**
+ * A dense bounded-variable primal simplex on doubles.
+ *
+ * The problem is the one of the exact solver: one row per auxiliary variable,
+ * which is the linear sum of the original variables given by its polynomial,
+ * and the bounds of all variables.  Starting from the slack basis, it
+ * minimizes the sum of the infeasibilities of the basic variables (phase 1
+ * only, there is no objective).  Each step moves the entering variable up
+ * to the first breakpoint of the sum, so that the sum decreases strictly on
+ * non-degenerate steps, and switches to Bland's rule after a run of
+ * degenerate pivots.
+ *
+ * The resulting basis and assignment are only a guess: they are handed to
+ * the exact solver, which confirms or repairs them.
+ */
+class ApproxDouble : public ApproximateSimplex {
+public:
+  ApproxDouble(const ArithVariables& v, TreeLog& l, ApproximateStatistics& s);
+  ~ApproxDouble() {}
+
+  LinResult solveRelaxation() override;
+  Solution extractRelaxation() const override;
+
+  ArithRatPairVec heuristicOptCoeffs() const override
+  {
+    return ArithRatPairVec();
+  }
+
+  MipResult solveMIP(bool al) override { return MipUnknown; }
+  Solution extractMIP() const override { return Solution(); }
+
+  void setOptCoeffs(const ArithRatPairVec& ref) override {}
+
+  void tryCut(int nid, CutInfo& cut) override {}
+
+  std::vector<const CutInfo*> getValidCuts(const NodeLog& node) override
+  {
+    return std::vector<const CutInfo*>();
+  }
+
+  ArithVar getBranchVar(const NodeLog& nl) const override
+  {
+    return ARITHVAR_SENTINEL;
+  }
+
+  double sumInfeasibilities(bool mip) const override;
+
+ private:
+  /** Tolerance on the bounds, relative to their magnitude */
+  static const double s_feasTol;
+  /** Smallest magnitude of a pivot element */
+  static const double s_pivotTol;
+  /** Maximum number of entries of the tableau */
+  static const size_t s_maxEntries;
+  /** Number of consecutive degenerate pivots before Bland's rule is used */
+  static const int s_degenerateLimit;
+
+  bool belowLower(size_t j) const
+  {
+    return d_lb[j] > -HUGE_VAL
+           && d_val[j] < d_lb[j] - s_feasTol * (1.0 + fabs(d_lb[j]));
+  }
+  bool aboveUpper(size_t j) const
+  {
+    return d_ub[j] < HUGE_VAL
+           && d_val[j] > d_ub[j] + s_feasTol * (1.0 + fabs(d_ub[j]));
+  }
+  /** Recomputes the values of the basic variables from the non-basic ones. */
+  void computeBasicValues();
+  /** Makes column j basic in row r. */
+  void pivot(size_t r, size_t j);
+  /** Converts the value of column j to a DeltaRational for the solution. */
+  DeltaRational toDeltaRational(size_t j) const;
+
+  /** The variable of each column, the rows come after the original ones */
+  std::vector<ArithVar> d_colVar;
+  size_t d_numRows;
+  size_t d_numCols;
+  /**
+   * The tableau, row i is basic column d_basic[i] = sum_j d_tab[i][j] col_j,
+   * with zeros in the basic columns
+   */
+  std::vector<std::vector<double>> d_tab;
+  std::vector<size_t> d_basic;
+  std::vector<bool> d_isBasic;
+  std::vector<double> d_lb;
+  std::vector<double> d_ub;
+  std::vector<double> d_val;
+  /** Whether the problem could be built */
+  bool d_valid;
+  bool d_solved;
+};
+
+const double ApproxDouble::s_feasTol = 1e-9;
+const double ApproxDouble::s_pivotTol = 1e-9;
+const size_t ApproxDouble::s_maxEntries = 1 << 22;
+const int ApproxDouble::s_degenerateLimit = 50;
+
+ApproxDouble::ApproxDouble(const ArithVariables& v,
+                           TreeLog& l,
+                           ApproximateStatistics& s)
+    : ApproximateSimplex(v, l, s),
+      d_numRows(0),
+      d_numCols(0),
+      d_valid(true),
+      d_solved(false)
+{
+  DenseMap<size_t> colIndex;
+  std::vector<ArithVar> rows;
+  for (ArithVariables::var_iterator vi = d_vars.var_begin(),
+                                    vi_end = d_vars.var_end();
+       vi != vi_end;
+       ++vi)
+  {
+    ArithVar av = *vi;
+    if (d_vars.isAuxiliary(av))
+    {
+      rows.push_back(av);
+    }
+    else
+    {
+      colIndex.set(av, d_colVar.size());
+      d_colVar.push_back(av);
+    }
+  }
+  d_numRows = rows.size();
+  for (ArithVar av : rows)
+  {
+    colIndex.set(av, d_colVar.size());
+    d_colVar.push_back(av);
+  }
+  d_numCols = d_colVar.size();
+  if (d_numRows == 0 || d_numRows * d_numCols > s_maxEntries)
+  {
+    d_valid = false;
+    return;
+  }
+
+  d_lb.resize(d_numCols, -HUGE_VAL);
+  d_ub.resize(d_numCols, HUGE_VAL);
+  d_val.resize(d_numCols, 0.0);
+  d_isBasic.resize(d_numCols, false);
+  for (size_t j = 0; j < d_numCols; ++j)
+  {
+    ArithVar av = d_colVar[j];
+    if (d_vars.hasLowerBound(av))
+    {
+      d_lb[j] = d_vars.getLowerBound(av).approx(SMALL_FIXED_DELTA);
+    }
+    if (d_vars.hasUpperBound(av))
+    {
+      d_ub[j] = d_vars.getUpperBound(av).approx(SMALL_FIXED_DELTA);
+    }
+    /* start the non-basic variables from the current assignment */
+    double val = d_vars.getAssignment(av).approx(SMALL_FIXED_DELTA);
+    d_val[j] = std::min(std::max(val, d_lb[j]), d_ub[j]);
+  }
+
+  d_tab.resize(d_numRows, std::vector<double>(d_numCols, 0.0));
+  d_basic.resize(d_numRows);
+  for (size_t i = 0; i < d_numRows; ++i)
+  {
+    size_t b = d_numCols - d_numRows + i;
+    d_basic[i] = b;
+    d_isBasic[b] = true;
+    Polynomial p = Polynomial::parsePolynomial(d_vars.asNode(rows[i]));
+    for (Polynomial::iterator it = p.begin(), end = p.end(); it != end; ++it)
+    {
+      const Monomial& mono = *it;
+      Node n = mono.getVarList().getNode();
+      Assert(d_vars.hasArithVar(n));
+      ArithVar av = d_vars.asArithVar(n);
+      d_tab[i][colIndex[av]] += mono.getConstant().getValue().getDouble();
+    }
+  }
+  computeBasicValues();
+}
+
+void ApproxDouble::computeBasicValues()
+{
+  for (size_t i = 0; i < d_numRows; ++i)
+  {
+    const std::vector<double>& row = d_tab[i];
+    double sum = 0.0;
+    for (size_t j = 0; j < d_numCols; ++j)
+    {
+      sum += row[j] * d_val[j];
+    }
+    d_val[d_basic[i]] = sum;
+  }
+}
+
+void ApproxDouble::pivot(size_t r, size_t j)
+{
+  size_t leaving = d_basic[r];
+  std::vector<double>& prow = d_tab[r];
+  double p = prow[j];
+  Assert(fabs(p) > s_pivotTol);
+
+  /* col_j = (leaving - sum_{k != j} prow[k] col_k) / p */
+  for (size_t k = 0; k < d_numCols; ++k)
+  {
+    prow[k] = -prow[k] / p;
+  }
+  prow[j] = 0.0;
+  prow[leaving] = 1.0 / p;
+
+  for (size_t i = 0; i < d_numRows; ++i)
+  {
+    if (i == r) continue;
+    std::vector<double>& row = d_tab[i];
+    double c = row[j];
+    if (c == 0.0) continue;
+    row[j] = 0.0;
+    for (size_t k = 0; k < d_numCols; ++k)
+    {
+      row[k] += c * prow[k];
+    }
+  }
+  d_basic[r] = j;
+  d_isBasic[j] = true;
+  d_isBasic[leaving] = false;
+}
+
+LinResult ApproxDouble::solveRelaxation()
+{
+  if (!d_valid)
+  {
+    return LinUnknown;
+  }
+  std::vector<double> dir(d_numRows);
+  /* the reduced costs of the sum of infeasibilities */
+  std::vector<double> cost(d_numCols);
+  int degenerate = 0;
+  for (int pivots = 0; pivots <= d_pivotLimit; ++pivots)
+  {
+    /* the direction in which each basic variable has to move */
+    bool feasible = true;
+    for (size_t i = 0; i < d_numRows; ++i)
+    {
+      size_t b = d_basic[i];
+      dir[i] = belowLower(b) ? 1.0 : (aboveUpper(b) ? -1.0 : 0.0);
+      feasible = feasible && dir[i] == 0.0;
+    }
+    if (feasible)
+    {
+      d_solved = true;
+      return LinFeasible;
+    }
+
+    /* choose the entering column, by the largest reduced cost or Bland */
+    bool bland = degenerate >= s_degenerateLimit;
+    size_t enter = d_numCols;
+    double enterDir = 0.0;
+    double best = 0.0;
+    std::fill(cost.begin(), cost.end(), 0.0);
+    for (size_t i = 0; i < d_numRows; ++i)
+    {
+      if (dir[i] == 0.0) continue;
+      const std::vector<double>& row = d_tab[i];
+      for (size_t j = 0; j < d_numCols; ++j)
+      {
+        cost[j] += dir[i] * row[j];
+      }
+    }
+    for (size_t j = 0; j < d_numCols; ++j)
+    {
+      if (d_isBasic[j]) continue;
+      double g = cost[j];
+      if (g > s_pivotTol && d_val[j] < d_ub[j])
+      {
+        // increasing col_j decreases the infeasibility
+      }
+      else if (g < -s_pivotTol && d_val[j] > d_lb[j])
+      {
+        // decreasing col_j decreases the infeasibility
+      }
+      else
+      {
+        continue;
+      }
+      if (fabs(g) > best)
+      {
+        best = fabs(g);
+        enter = j;
+        enterDir = g > 0 ? 1.0 : -1.0;
+        if (bland) break;
+      }
+    }
+    if (enter == d_numCols)
+    {
+      /* the sum of infeasibilities is minimal and positive */
+      d_solved = true;
+      return LinInfeasible;
+    }
+
+    /* ratio test: move up to the first breakpoint */
+    double step = enterDir > 0 ? d_ub[enter] - d_val[enter]
+                               : d_val[enter] - d_lb[enter];
+    size_t leave = d_numRows;
+    double leaveVal = 0.0;
+    for (size_t i = 0; i < d_numRows; ++i)
+    {
+      double alpha = d_tab[i][enter] * enterDir;
+      if (fabs(alpha) <= s_pivotTol) continue;
+      size_t b = d_basic[i];
+      double target;
+      if (alpha > 0)
+      {
+        /* increasing, up to the lower bound if below it, else the upper */
+        target = dir[i] > 0 ? d_lb[b] : (dir[i] == 0.0 ? d_ub[b] : HUGE_VAL);
+      }
+      else
+      {
+        target = dir[i] < 0 ? d_ub[b] : (dir[i] == 0.0 ? d_lb[b] : -HUGE_VAL);
+      }
+      if (target == HUGE_VAL || target == -HUGE_VAL) continue;
+      double t = std::max((target - d_val[b]) / alpha, 0.0);
+      if (t < step || (bland && t == step && leave < d_numRows
+                       && b < d_basic[leave]))
+      {
+        step = t;
+        leave = i;
+        leaveVal = target;
+      }
+    }
+    if (step == HUGE_VAL)
+    {
+      return LinUnknown;
+    }
+
+    for (size_t i = 0; i < d_numRows; ++i)
+    {
+      d_val[d_basic[i]] += d_tab[i][enter] * enterDir * step;
+    }
+    d_val[enter] += enterDir * step;
+    degenerate = step <= s_feasTol ? degenerate + 1 : 0;
+
+    if (leave < d_numRows)
+    {
+      d_val[d_basic[leave]] = leaveVal;
+      pivot(leave, enter);
+      if (pivots % 100 == 99)
+      {
+        computeBasicValues();
+      }
+    }
+  }
+  return LinExhausted;
+}
+
+double ApproxDouble::sumInfeasibilities(bool mip) const
+{
+  double sum = 0.0;
+  for (size_t j = 0; j < d_numCols; ++j)
+  {
+    if (belowLower(j))
+    {
+      sum += d_lb[j] - d_val[j];
+    }
+    else if (aboveUpper(j))
+    {
+      sum += d_val[j] - d_ub[j];
+    }
+  }
+  return sum;
+}
+
+DeltaRational ApproxDouble::toDeltaRational(size_t j) const
+{
+  ArithVar av = d_colVar[j];
+  double val = d_val[j];
+  if (d_vars.hasLowerBound(av) && roughlyEqual(val, d_lb[j]))
+  {
+    return d_vars.getLowerBound(av);
+  }
+  if (d_vars.hasUpperBound(av) && roughlyEqual(val, d_ub[j]))
+  {
+    return d_vars.getUpperBound(av);
+  }
+  double rounded = round(val);
+  if (roughlyEqual(val, rounded))
+  {
+    val = rounded;
+  }
+  if (Maybe<Rational> maybe_new = estimateWithCFE(val))
+  {
+    return DeltaRational(maybe_new.value());
+  }
+  return d_vars.getAssignment(av);
+}
+
+ApproximateSimplex::Solution ApproxDouble::extractRelaxation() const
+{
+  Assert(d_solved);
+  Solution sol;
+  for (size_t j = 0; j < d_numCols; ++j)
+  {
+    ArithVar av = d_colVar[j];
+    if (d_isBasic[j])
+    {
+      sol.newBasis.add(av);
+    }
+    sol.newValues.set(av, toDeltaRational(j));
+  }
+  return sol;
+}
+
 }/* CVC4::theory::arith namespace */
 }/* CVC4::theory namespace */
 }/* CVC4 namespace */
@@ -547,6 +955,11 @@ ApproximateSimplex* ApproximateSimplex::mkApproximateSimplexSolver(const ArithVa
   return new ApproxNoOp(vars, l, s);
 #endif
 }
+ApproximateSimplex* ApproximateSimplex::mkDoubleSimplexSolver(
+    const ArithVariables& vars, TreeLog& l, ApproximateStatistics& s)
+{
+  return new ApproxDouble(vars, l, s);
+}
 bool ApproximateSimplex::enabled() {
 #ifdef CVC4_USE_GLPK
   return true;
@@ -78,6 +78,12 @@ class ApproximateSimplex{
    * If glpk is disabled, return a subclass that does nothing.
    */
   static ApproximateSimplex* mkApproximateSimplexSolver(const ArithVariables& vars, TreeLog& l, ApproximateStatistics& s);
+
+  /**
+   * Returns a built-in double-precision simplex that only solves the linear
+   * relaxation, which is available with or without glpk.
+   */
+  static ApproximateSimplex* mkDoubleSimplexSolver(const ArithVariables& vars, TreeLog& l, ApproximateStatistics& s);
   ApproximateSimplex(const ArithVariables& v, TreeLog& l, ApproximateStatistics& s);
   virtual ~ApproximateSimplex(){}
 
@@ -0,0 +1,307 @@
+/*********************                                                        */
+/*! \file branch_cut_engine.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Gomory cuts and pseudo-cost branching over the exact tableau.
+ **
+ ** Gomory cuts and pseudo-cost branching over the exact tableau.
+ **/
+
+#include "theory/arith/branch_cut_engine.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/output.h"
+#include "smt/smt_statistics_registry.h"
+#include "theory/arith/arith_utilities.h"
+#include "theory/arith/constraint.h"
+#include "theory/rewriter.h"
+
+using namespace std;
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+/** Rows with coefficients more complex than this are not cut. */
+static const uint32_t s_maxCutComplexity = 256;
+
+BranchCutEngine::BranchCutEngine(const ArithVariables& vars,
+                                 const Tableau& tableau)
+    : d_vars(vars),
+      d_tableau(tableau),
+      d_branchVar(ARITHVAR_SENTINEL),
+      d_branchFractional(0)
+{
+  for (unsigned up = 0; up < 2; ++up)
+  {
+    d_pcTotal[up] = 0;
+    d_pcTotalCount[up] = 0;
+  }
+}
+
+BranchCutEngine::Statistics::Statistics()
+    : d_cuts("theory::arith::mip::cuts", 0),
+      d_poolHits("theory::arith::mip::poolHits", 0),
+      d_rowsSkipped("theory::arith::mip::rowsSkipped", 0),
+      d_pseudoCostUpdates("theory::arith::mip::pseudoCostUpdates", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_cuts);
+  smtStatisticsRegistry()->registerStat(&d_poolHits);
+  smtStatisticsRegistry()->registerStat(&d_rowsSkipped);
+  smtStatisticsRegistry()->registerStat(&d_pseudoCostUpdates);
+}
+
+BranchCutEngine::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_cuts);
+  smtStatisticsRegistry()->unregisterStat(&d_poolHits);
+  smtStatisticsRegistry()->unregisterStat(&d_rowsSkipped);
+  smtStatisticsRegistry()->unregisterStat(&d_pseudoCostUpdates);
+}
+
+bool BranchCutEngine::gomoryCut(ArithVar basic, Cut& cut) const
+{
+  const DeltaRational& beta = d_vars.getAssignment(basic);
+  if (!beta.infinitesimalIsZero())
+  {
+    return false;
+  }
+  // f0 is the fractional part of the basic variable
+  Rational f0 = beta.getNoninfinitesimalPart().floor_frac();
+  Assert(f0.sgn() > 0);
+  Rational oneMinusF0 = Rational(1) - f0;
+
+  // The row is basic = \sum_j a_j x_j.  Each non-basic x_j is at a bound
+  // b_j, and y_j = s_j (x_j - b_j) >= 0 with s_j = 1 at a lower bound and
+  // s_j = -1 at an upper bound.  Then basic - \sum_j s_j a_j y_j = beta,
+  // and the Gomory mixed-integer cut of this equation is \sum_j g_j y_j >= 1,
+  // i.e. \sum_j s_j g_j x_j >= 1 + \sum_j s_j g_j b_j.
+  NodeManager* nm = NodeManager::currentNM();
+  NodeBuilder<> sum(kind::PLUS);
+  Rational rhs(1);
+  double norm = 0;
+  cut.d_explain.clear();
+  for (Tableau::CompressedIterator i = d_tableau.compressedBasicRowIterator(basic);
+       !i.atEnd(); ++i)
+  {
+    const Tableau::Entry& entry = *i;
+    ArithVar x = entry.getColVar();
+    if (x == basic)
+    {
+      continue;
+    }
+    const Rational& a = entry.getCoefficient();
+    if (a.complexity() > s_maxCutComplexity)
+    {
+      return false;
+    }
+    bool atLower = d_vars.hasLowerBound(x)
+                   && d_vars.cmpAssignmentLowerBound(x) == 0;
+    bool atUpper = !atLower && d_vars.hasUpperBound(x)
+                   && d_vars.cmpAssignmentUpperBound(x) == 0;
+    if (!atLower && !atUpper)
+    {
+      return false;
+    }
+    const DeltaRational& bound =
+        atLower ? d_vars.getLowerBound(x) : d_vars.getUpperBound(x);
+    if (!bound.infinitesimalIsZero())
+    {
+      return false;
+    }
+    const Rational& b = bound.getNoninfinitesimalPart();
+    int s = atLower ? 1 : -1;
+    // the coefficient of y_j in basic + \sum_j abar_j y_j = beta
+    Rational abar = atLower ? -a : a;
+
+    Rational g;
+    if (d_vars.isInteger(x) && b.isIntegral())
+    {
+      Rational fj = abar.floor_frac();
+      g = fj <= f0 ? fj / f0 : (Rational(1) - fj) / oneMinusF0;
+    }
+    else
+    {
+      g = abar.sgn() >= 0 ? abar / f0 : -abar / oneMinusF0;
+    }
+    if (g.isZero())
+    {
+      continue;
+    }
+    Rational c = s > 0 ? g : -g;
+    sum << nm->mkNode(kind::MULT, mkRationalNode(c), d_vars.asNode(x));
+    rhs += c * b;
+    double gd = g.getDouble();
+    norm += gd * gd;
+    cut.d_explain.push_back(atLower ? d_vars.getLowerBoundConstraint(x)
+                                    : d_vars.getUpperBoundConstraint(x));
+  }
+  if (sum.getNumChildren() == 0)
+  {
+    // 0 >= 1: the bounds are in conflict with integrality, which the
+    // branching finds as well
+    return false;
+  }
+  Node lhs = sum.getNumChildren() == 1 ? sum[0] : Node(sum);
+  cut.d_cut = Rewriter::rewrite(nm->mkNode(kind::GEQ, lhs, mkRationalNode(rhs)));
+  cut.d_efficacy = 1.0 / std::sqrt(norm);
+  return true;
+}
+
+void BranchCutEngine::gomoryCuts(unsigned max, std::vector<Cut>& cuts)
+{
+  std::vector<Cut> found;
+  for (Tableau::BasicIterator i = d_tableau.beginBasic(),
+                              iend = d_tableau.endBasic();
+       i != iend; ++i)
+  {
+    ArithVar basic = *i;
+    if (!d_vars.isInteger(basic) || d_vars.integralAssignment(basic))
+    {
+      continue;
+    }
+    Cut cut;
+    if (!gomoryCut(basic, cut))
+    {
+      ++d_statistics.d_rowsSkipped;
+      continue;
+    }
+    if (cut.d_cut.isConst() || d_pool.find(cut.d_cut) != d_pool.end())
+    {
+      ++d_statistics.d_poolHits;
+      continue;
+    }
+    found.push_back(cut);
+  }
+  std::stable_sort(found.begin(), found.end(), [](const Cut& a, const Cut& b) {
+    return a.d_efficacy > b.d_efficacy;
+  });
+  for (const Cut& cut : found)
+  {
+    if (cuts.size() >= max)
+    {
+      break;
+    }
+    if (d_pool.insert(cut.d_cut).second)
+    {
+      Debug("arith::mip") << "gomory cut " << cut.d_cut << endl;
+      ++d_statistics.d_cuts;
+      cuts.push_back(cut);
+    }
+  }
+}
+
+uint32_t BranchCutEngine::countFractional() const
+{
+  uint32_t count = 0;
+  for (ArithVar v = 0, n = d_vars.getNumberOfVariables(); v < n; ++v)
+  {
+    if (d_vars.isIntegerInput(v) && !d_vars.integralAssignment(v))
+    {
+      ++count;
+    }
+  }
+  return count;
+}
+
+double BranchCutEngine::pseudoCost(ArithVar x, bool up) const
+{
+  if (x < d_pcCount[up].size() && d_pcCount[up][x] > 0)
+  {
+    return d_pcSum[up][x] / d_pcCount[up][x];
+  }
+  return d_pcTotalCount[up] > 0 ? d_pcTotal[up] / d_pcTotalCount[up] : 1.0;
+}
+
+ArithVar BranchCutEngine::selectBranchVariable()
+{
+  static const double eps = 1e-6;
+  ArithVar best = ARITHVAR_SENTINEL;
+  double bestScore = -1;
+  for (ArithVar v = 0, n = d_vars.getNumberOfVariables(); v < n; ++v)
+  {
+    if (!d_vars.isIntegerInput(v) || d_vars.integralAssignment(v)
+        || !d_vars.assignmentIsConsistent(v))
+    {
+      continue;
+    }
+    double value = d_vars.getAssignment(v).getNoninfinitesimalPart().getDouble();
+    double f = value - std::floor(value);
+    // the product rule
+    double score = std::max(pseudoCost(v, false) * f, eps)
+                   * std::max(pseudoCost(v, true) * (1 - f), eps);
+    if (score > bestScore)
+    {
+      best = v;
+      bestScore = score;
+    }
+  }
+  return best;
+}
+
+void BranchCutEngine::notifyBranch(ArithVar x)
+{
+  d_branchVar = x;
+  d_branchValue = d_vars.getAssignment(x).getNoninfinitesimalPart();
+  d_branchFractional = countFractional();
+}
+
+void BranchCutEngine::observe()
+{
+  if (d_branchVar == ARITHVAR_SENTINEL
+      || d_branchVar >= d_vars.getNumberOfVariables())
+  {
+    d_branchVar = ARITHVAR_SENTINEL;
+    return;
+  }
+  ArithVar x = d_branchVar;
+  d_branchVar = ARITHVAR_SENTINEL;
+
+  const Rational& value = d_vars.getAssignment(x).getNoninfinitesimalPart();
+  Integer floor = d_branchValue.floor();
+  bool up;
+  Rational distance;
+  if (value <= Rational(floor))
+  {
+    up = false;
+    distance = d_branchValue - Rational(floor);
+  }
+  else if (value >= Rational(floor + 1))
+  {
+    up = true;
+    distance = Rational(floor + 1) - d_branchValue;
+  }
+  else
+  {
+    // the branch literal is not asserted yet
+    return;
+  }
+  uint32_t fractional = countFractional();
+  double gain = d_branchFractional > fractional
+                    ? double(d_branchFractional - fractional)
+                    : 0.0;
+  double cost = gain / distance.getDouble();
+  if (d_pcSum[up].size() <= x)
+  {
+    d_pcSum[up].resize(x + 1, 0);
+    d_pcCount[up].resize(x + 1, 0);
+  }
+  d_pcSum[up][x] += cost;
+  ++d_pcCount[up][x];
+  d_pcTotal[up] += cost;
+  ++d_pcTotalCount[up];
+  ++d_statistics.d_pseudoCostUpdates;
+}
+
+}/* CVC4::theory::arith namespace */
+}/* CVC4::theory namespace */
+}/* CVC4 namespace */
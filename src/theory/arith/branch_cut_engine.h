@@ -0,0 +1,120 @@
+/*********************                                                        */
+/*! \file branch_cut_engine.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Gomory cuts and pseudo-cost branching over the exact tableau.
+ **
+ ** Unlike the cuts of approx_simplex.cpp, which need GLPK, these are
+ ** derived from the rows of the exact Tableau after the simplex found a
+ ** feasible assignment of the relaxation.  A row whose basic variable is an
+ ** integer with a fractional value and whose non-basic variables are all at
+ ** a bound yields a Gomory mixed-integer cut, which is a lemma implied by the
+ ** bound constraints of the non-basic variables.  The cuts are kept in a pool
+ ** so that the same cut is not emitted twice.
+ **
+ ** The branching variable is chosen by pseudo-costs: the average decrease,
+ ** per unit of change, of the number of fractional integer variables that
+ ** followed branching down and up on each variable.
+ **/
+
+#include "cvc4_private.h"
+
+#pragma once
+
+#include <unordered_set>
+#include <vector>
+
+#include "expr/node.h"
+#include "theory/arith/arithvar.h"
+#include "theory/arith/constraint_forward.h"
+#include "theory/arith/partial_model.h"
+#include "theory/arith/tableau.h"
+#include "util/rational.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+class BranchCutEngine {
+public:
+  /** A cut and the bound constraints it follows from. */
+  struct Cut {
+    Node d_cut;
+    ConstraintCPVec d_explain;
+    /** The distance of the current assignment to the cut, up to scaling */
+    double d_efficacy;
+  };
+
+  BranchCutEngine(const ArithVariables& vars, const Tableau& tableau);
+
+  /**
+   * Adds to cuts the Gomory mixed-integer cuts of the rows of the basic
+   * integer variables with a fractional assignment, the most efficacious
+   * first, that are not in the pool.  At most max cuts are returned, and
+   * they are added to the pool.
+   */
+  void gomoryCuts(unsigned max, std::vector<Cut>& cuts);
+
+  /**
+   * Returns the integer variable with a fractional assignment to branch on
+   * by pseudo-costs, or ARITHVAR_SENTINEL if there is none.
+   */
+  ArithVar selectBranchVariable();
+
+  /** Records that the next branch is on x. */
+  void notifyBranch(ArithVar x);
+
+  /**
+   * Updates the pseudo-costs with the outcome of the last branch, given the
+   * current assignment.  Called at each full effort check.
+   */
+  void observe();
+
+private:
+  /** Returns the Gomory cut of the row of basic in cut, if there is one. */
+  bool gomoryCut(ArithVar basic, Cut& cut) const;
+  /** The number of integer variables with a fractional assignment. */
+  uint32_t countFractional() const;
+  /** Returns the pseudo-cost of x in direction up, or the average. */
+  double pseudoCost(ArithVar x, bool up) const;
+
+  const ArithVariables& d_vars;
+  const Tableau& d_tableau;
+
+  /** The cuts that were returned, by their node */
+  std::unordered_set<Node, NodeHashFunction> d_pool;
+
+  /** The sums and counts of the pseudo-cost observations by variable. */
+  std::vector<double> d_pcSum[2];
+  std::vector<uint32_t> d_pcCount[2];
+  double d_pcTotal[2];
+  uint32_t d_pcTotalCount[2];
+
+  /** The last branch and the assignment and infeasibility before it. */
+  ArithVar d_branchVar;
+  Rational d_branchValue;
+  uint32_t d_branchFractional;
+
+  class Statistics {
+  public:
+    IntStat d_cuts;
+    IntStat d_poolHits;
+    IntStat d_rowsSkipped;
+    IntStat d_pseudoCostUpdates;
+    Statistics();
+    ~Statistics();
+  };
+  Statistics d_statistics;
+};/* class BranchCutEngine */
+
+}/* CVC4::theory::arith namespace */
+}/* CVC4::theory namespace */
+}/* CVC4 namespace */
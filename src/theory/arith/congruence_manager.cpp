@@ -406,6 +406,12 @@ void ArithCongruenceManager::addWatchedPair(ArithVar s, TNode x, TNode y){
   d_watchedEqualities.set(s, eq);
 }
 
+void ArithCongruenceManager::removeWatchedPair(ArithVar s){
+  Assert(isWatchedVariable(s));
+  d_watchedVariables.remove(s);
+  d_watchedEqualities.remove(s);
+}
+
 void ArithCongruenceManager::assertionToEqualityEngine(bool isEquality, ArithVar s, TNode reason){
   Assert(isWatchedVariable(s));
 
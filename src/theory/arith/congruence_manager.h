@@ -152,6 +152,8 @@ public:
   void explain(TNode lit, NodeBuilder<>& out);
 
   void addWatchedPair(ArithVar s, TNode x, TNode y);
+  /** Stops watching s, which is being released. */
+  void removeWatchedPair(ArithVar s);
 
   inline bool isWatchedVariable(ArithVar s) const {
     return d_watchedVariables.isMember(s);
@@ -1025,6 +1025,41 @@ void ConstraintDatabase::removeVariable(ArithVar v){
   d_reclaimable.add(v);
 }
 
+bool ConstraintDatabase::variableConstraintsAreGarbage(ArithVar v) const{
+  SortedConstraintMap& scm = getVariableSCM(v);
+  std::vector<ConstraintP> constraintList;
+  for(SortedConstraintMapIterator i = scm.begin(), end = scm.end(); i != end; ++i){
+    (i->second).push_into(constraintList);
+  }
+  for(ConstraintP c : constraintList){
+    if(!c->safeToGarbageCollect()){
+      return false;
+    }
+  }
+  return true;
+}
+
+void ConstraintDatabase::deleteVariableConstraints(ArithVar v, std::vector<Node>& literals){
+  SortedConstraintMap& scm = getVariableSCM(v);
+  std::vector<ConstraintP> constraintList;
+  for(SortedConstraintMapIterator i = scm.begin(), end = scm.end(); i != end; ++i){
+    (i->second).push_into(constraintList);
+  }
+  // the negations are in the list as well
+  for(ConstraintP c : constraintList){
+    if(c->hasLiteral()){
+      literals.push_back(c->getLiteral());
+    }
+  }
+  while(!constraintList.empty()){
+    ConstraintP c = constraintList.back();
+    constraintList.pop_back();
+    Assert(c->safeToGarbageCollect());
+    delete c;
+  }
+  Assert(scm.empty());
+}
+
 bool Constraint::safeToGarbageCollect() const{
   // Do not call during destructor as getNegation() may be Null by this point
   Assert(getNegation() != NullConstraint);
@@ -1141,6 +1141,17 @@ public:
   bool variableDatabaseIsSetup(ArithVar v) const;
   void removeVariable(ArithVar v);
 
+  /**
+   * Returns true if no constraint on v has context dependent data, so that
+   * all of them can be deleted by deleteVariableConstraints(v).
+   */
+  bool variableConstraintsAreGarbage(ArithVar v) const;
+  /**
+   * Deletes all of the constraints on v, and adds the literals they had to
+   * literals.
+   */
+  void deleteVariableConstraints(ArithVar v, std::vector<Node>& literals);
+
   Node eeExplain(ConstraintCP c) const;
   void eeExplain(ConstraintCP c, NodeBuilder<>& nb) const;
 
@@ -46,7 +46,18 @@ DioSolver::DioSolver(context::Context* ctxt)
       d_usedDecomposeIndex(ctxt, false),
       d_lastPureSubstitution(ctxt, 0),
       d_pureSubstitionIter(ctxt, 0),
-      d_decompositionLemmaQueue(ctxt) {}
+      d_decompositionLemmaQueue(ctxt),
+      d_derivations(1),
+      d_derivation(ctxt, 0),
+      d_recordedLemmas(nullptr)
+{
+  d_derivations[0].d_allowDecomposition = false;
+  d_derivations[0].d_trailStart = 0;
+  d_derivations[0].d_nextInputConstraint = 0;
+  d_derivations[0].d_usedDecomposeIndex = false;
+  d_derivations[0].d_conflict = false;
+  d_derivations[0].d_conflictIndex = 0;
+}
 
 DioSolver::Statistics::Statistics() :
   d_conflictCalls("theory::arith::dio::conflictCalls",0),
@@ -54,7 +65,8 @@ DioSolver::Statistics::Statistics() :
   d_cuts("theory::arith::dio::cuts",0),
   d_conflicts("theory::arith::dio::conflicts",0),
   d_conflictTimer("theory::arith::dio::conflictTimer"),
-  d_cutTimer("theory::arith::dio::cutTimer")
+  d_cutTimer("theory::arith::dio::cutTimer"),
+  d_replays("theory::arith::dio::replays", 0)
 {
   smtStatisticsRegistry()->registerStat(&d_conflictCalls);
   smtStatisticsRegistry()->registerStat(&d_cutCalls);
@@ -64,6 +76,8 @@ DioSolver::Statistics::Statistics() :
 
   smtStatisticsRegistry()->registerStat(&d_conflictTimer);
   smtStatisticsRegistry()->registerStat(&d_cutTimer);
+
+  smtStatisticsRegistry()->registerStat(&d_replays);
 }
 
 DioSolver::Statistics::~Statistics(){
@@ -75,6 +89,8 @@ DioSolver::Statistics::~Statistics(){
 
   smtStatisticsRegistry()->unregisterStat(&d_conflictTimer);
   smtStatisticsRegistry()->unregisterStat(&d_cutTimer);
+
+  smtStatisticsRegistry()->unregisterStat(&d_replays);
 }
 
 bool DioSolver::queueConditions(TrailIndex t){
@@ -420,9 +436,95 @@ DioSolver::TrailIndex DioSolver::impliedGcdOfOne(){
   }
 }
 
+void DioSolver::collectNewInputs(std::vector<Node>& inputs) const{
+  for(size_t i = d_nextInputConstraintToEnqueue, N = d_inputConstraints.size();
+      i < N; ++i){
+    const InputConstraint& ic = d_inputConstraints[i];
+    inputs.push_back(ic.d_reason);
+    inputs.push_back(d_trail[ic.d_trailPos].d_eq.getNode());
+  }
+}
+
+void DioSolver::replayDerivation(const Derivation& d){
+  Assert(d_trail.size() == d.d_trailStart);
+  for(const Constraint& c : d.d_trail){
+    d_trail.push_back(c);
+  }
+  for(const Substitution& s : d.d_subs){
+    d_subs.push_back(s);
+  }
+  for(TrailIndex i : d.d_lemmas){
+    d_decompositionLemmaQueue.push(i);
+  }
+  d_nextInputConstraintToEnqueue = d.d_nextInputConstraint;
+  if(d.d_usedDecomposeIndex){
+    d_usedDecomposeIndex = true;
+  }
+  if(d.d_conflict){
+    raiseConflict(d.d_conflictIndex);
+  }
+}
+
 bool DioSolver::processEquations(bool allowDecomposition){
   Assert(!inConflict());
 
+  size_t parent = d_derivation;
+  if(!options::dioReplay() || parent == DERIVATION_UNTRACKED ||
+     d_savedQueueIndex < d_savedQueue.size()){
+    // the saved queue is not part of the key of a derivation
+    d_derivation = DERIVATION_UNTRACKED;
+    return computeEquations(allowDecomposition);
+  }
+
+  std::vector<Node> inputs;
+  collectNewInputs(inputs);
+  for(size_t child : d_derivations[parent].d_children){
+    const Derivation& d = d_derivations[child];
+    if(d.d_allowDecomposition == allowDecomposition && d.d_inputs == inputs){
+      Debug("arith::dio") << "replaying derivation " << child << endl;
+      ++(d_statistics.d_replays);
+      replayDerivation(d);
+      d_derivation = child;
+      return inConflict();
+    }
+  }
+
+  TrailIndex trailStart = d_trail.size();
+  SubIndex subsStart = d_subs.size();
+  std::vector<TrailIndex> lemmas;
+  d_recordedLemmas = &lemmas;
+  bool result = computeEquations(allowDecomposition);
+  d_recordedLemmas = nullptr;
+
+  if(d_derivations.size() >= MAX_DERIVATIONS){
+    d_derivation = DERIVATION_UNTRACKED;
+    return result;
+  }
+  size_t child = d_derivations.size();
+  d_derivations.push_back(Derivation());
+  d_derivations[parent].d_children.push_back(child);
+  Derivation& d = d_derivations.back();
+  d.d_inputs.swap(inputs);
+  d.d_allowDecomposition = allowDecomposition;
+  d.d_trailStart = trailStart;
+  for(TrailIndex i = trailStart, N = d_trail.size(); i < N; ++i){
+    d.d_trail.push_back(d_trail[i]);
+  }
+  for(SubIndex i = subsStart, N = d_subs.size(); i < N; ++i){
+    d.d_subs.push_back(d_subs[i]);
+  }
+  d.d_lemmas.swap(lemmas);
+  d.d_nextInputConstraint = d_nextInputConstraintToEnqueue;
+  d.d_usedDecomposeIndex = d_usedDecomposeIndex;
+  d.d_conflict = inConflict();
+  d.d_conflictIndex = inConflict() ? getConflictIndex() : 0;
+  d_derivation = child;
+  return result;
+}
+
+bool DioSolver::computeEquations(bool allowDecomposition){
+  Assert(!inConflict());
+
   enqueueInputConstraints();
   while(! queueEmpty() && !inConflict()){
     moveMinimumByAbsToQueueFront();
@@ -822,6 +924,9 @@ void DioSolver::subAndReduceCurrentFByIndex(DioSolver::SubIndex subIndex){
 void DioSolver::addTrailElementAsLemma(TrailIndex i) {
   if(options::exportDioDecompositions()){
     d_decompositionLemmaQueue.push(i);
+    if(d_recordedLemmas != nullptr){
+      d_recordedLemmas->push_back(i);
+    }
   }
 }
 
@@ -174,6 +174,48 @@ private:
    */
   context::CDQueue<TrailIndex> d_decompositionLemmaQueue;
 
+  /**
+   * A derivation of processEquations(): the elements it added to the trail,
+   * the substitutions and the decomposition lemmas, and the resulting state.
+   *
+   * The derivations are recorded in a tree that is not context dependent.
+   * The children of a derivation are the calls that followed it, keyed by
+   * the input constraints they processed.  As the derivation is a function
+   * of the input constraints, a call that processes the same inputs in the
+   * same state as a recorded one replays its derivation instead of
+   * recomputing it.  This avoids re-deriving the same substitutions after
+   * every pop, as in incremental solving.  The fresh variables of the
+   * decompositions are the ones of the recorded derivation, so replaying
+   * re-exports the same decomposition lemmas.
+   */
+  struct Derivation {
+    std::vector<Node> d_inputs;
+    bool d_allowDecomposition;
+    TrailIndex d_trailStart;
+    std::vector<Constraint> d_trail;
+    std::vector<Substitution> d_subs;
+    std::vector<TrailIndex> d_lemmas;
+    size_t d_nextInputConstraint;
+    bool d_usedDecomposeIndex;
+    bool d_conflict;
+    TrailIndex d_conflictIndex;
+    std::vector<size_t> d_children;
+  };
+  /** The recorded derivations, d_derivations[0] is the root. */
+  std::vector<Derivation> d_derivations;
+  /** The last derivation, or DERIVATION_UNTRACKED. */
+  context::CDO<size_t> d_derivation;
+  /** The decomposition lemmas of the call being recorded, if any. */
+  std::vector<TrailIndex>* d_recordedLemmas;
+  static const size_t DERIVATION_UNTRACKED = static_cast<size_t>(-1);
+  /** The maximum number of recorded derivations. */
+  static const size_t MAX_DERIVATIONS = 1 << 16;
+
+  /** The input constraints that the next call of processEquations() uses. */
+  void collectNewInputs(std::vector<Node>& inputs) const;
+  /** Applies the recorded derivation d. */
+  void replayDerivation(const Derivation& d);
+
 public:
 
   /** Construct a Diophantine equation solver with the given context. */
@@ -368,8 +410,10 @@ private:
    * Processing the current set of equations.
    *
    * decomposeIndex() rule is only applied if allowDecomposition is true.
+   * With --dio-replay, this replays a recorded derivation if there is one.
    */
   bool processEquations(bool allowDecomposition);
+  bool computeEquations(bool allowDecomposition);
 
   /**
    * Constructs a proof from any d_trail[i] in terms of input literals.
@@ -413,6 +457,8 @@ public:
     TimerStat d_conflictTimer;
     TimerStat d_cutTimer;
 
+    IntStat d_replays;
+
     Statistics();
     ~Statistics();
   };
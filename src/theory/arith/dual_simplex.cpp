@@ -213,6 +213,9 @@ bool DualSimplexDecisionProcedure::searchForFeasibleSolution(uint32_t remainingI
         // return true;
       }else{
         const DeltaRational& l_i = d_variables.getLowerBound(x_i);
+        if(d_errorSet.getSelectionRule() == options::ErrorSelectionRule::DEVEX){
+          d_errorSet.pivotDevexWeights(x_i, x_j, d_tableau);
+        }
         d_linEq.pivotAndUpdate(x_i, x_j, l_i);
       }
     }else if(d_variables.cmpAssignmentUpperBound(x_i) > 0){
@@ -228,6 +231,9 @@ bool DualSimplexDecisionProcedure::searchForFeasibleSolution(uint32_t remainingI
         // return true;
       }else{
         const DeltaRational& u_i = d_variables.getUpperBound(x_i);
+        if(d_errorSet.getSelectionRule() == options::ErrorSelectionRule::DEVEX){
+          d_errorSet.pivotDevexWeights(x_i, x_j, d_tableau);
+        }
         d_linEq.pivotAndUpdate(x_i, x_j, u_i);
       }
     }
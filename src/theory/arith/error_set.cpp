@@ -17,8 +17,11 @@
 
 #include "theory/arith/error_set.h"
 
+#include <algorithm>
+
 #include "smt/smt_statistics_registry.h"
 #include "theory/arith/constraint.h"
+#include "theory/arith/tableau.h"
 
 using namespace std;
 
@@ -36,6 +39,7 @@ ErrorInformation::ErrorInformation()
   , d_handle()
   , d_amount(NULL)
   , d_metric(0)
+  , d_priority(0)
 {
   Debug("arith::error::mem") << "def constructor " << d_variable << " "  << d_amount << endl;
 }
@@ -49,6 +53,7 @@ ErrorInformation::ErrorInformation(ArithVar var, ConstraintP vio, int sgn)
   , d_handle()
   , d_amount(NULL)
   , d_metric(0)
+  , d_priority(0)
 {
   Assert(debugInitialized());
   Debug("arith::error::mem") << "constructor " << d_variable << " "  << d_amount << endl;
@@ -73,6 +78,7 @@ ErrorInformation::ErrorInformation(const ErrorInformation& ei)
   , d_inFocus(ei.d_inFocus)
   , d_handle(ei.d_handle)
   , d_metric(0)
+  , d_priority(ei.d_priority)
 {
   if(ei.d_amount == NULL){
     d_amount = NULL;
@@ -90,6 +96,7 @@ ErrorInformation& ErrorInformation::operator=(const ErrorInformation& ei){
   d_inFocus = (ei.d_inFocus);
   d_handle = (ei.d_handle);
   d_metric = ei.d_metric;
+  d_priority = ei.d_priority;
   if(d_amount != NULL && ei.d_amount != NULL){
     Debug("arith::error::mem") << "assignment assign " << d_variable << " "  << d_amount << endl;
     *d_amount = *ei.d_amount;
@@ -181,15 +188,71 @@ void ErrorSet::recomputeAmount(ErrorInformation& ei,
     case options::ErrorSelectionRule::SUM_METRIC:
       ei.setMetric(sumMetric(ei.getVariable()));
       break;
+    case options::ErrorSelectionRule::DEVEX:
+      setDevexPriority(ei);
+      break;
     case options::ErrorSelectionRule::VAR_ORDER:
       // do nothing
       break;
   }
 }
 
+void ErrorSet::setDevexPriority(ErrorInformation& ei)
+{
+  ei.setAmount(computeDiff(ei.getVariable()));
+  double amount = ei.getAmount().getNoninfinitesimalPart().getDouble();
+  ei.setPriority(amount * amount / getDevexWeight(ei.getVariable()));
+}
+
+void ErrorSet::pivotDevexWeights(ArithVar leaving,
+                                 ArithVar entering,
+                                 const Tableau& tableau)
+{
+  double pivotCoeff = 0;
+  for (Tableau::ColIterator iter = tableau.colIterator(entering);
+       !iter.atEnd();
+       ++iter)
+  {
+    const Tableau::Entry& entry = *iter;
+    if (tableau.rowIndexToBasic(entry.getRowIndex()) == leaving)
+    {
+      pivotCoeff = entry.getCoefficient().getDouble();
+      break;
+    }
+  }
+  Assert(pivotCoeff != 0);
+
+  // The rows k of the column are updated by a_kj / a_ij times the pivot row
+  double leavingWeight = getDevexWeight(leaving);
+  for (Tableau::ColIterator iter = tableau.colIterator(entering);
+       !iter.atEnd();
+       ++iter)
+  {
+    const Tableau::Entry& entry = *iter;
+    ArithVar basic = tableau.rowIndexToBasic(entry.getRowIndex());
+    if (basic != leaving)
+    {
+      double ratio = entry.getCoefficient().getDouble() / pivotCoeff;
+      double weight = ratio * ratio * leavingWeight;
+      if (weight > getDevexWeight(basic))
+      {
+        d_devexWeights.set(basic, weight);
+      }
+    }
+  }
+  d_devexWeights.set(
+      entering,
+      std::max(leavingWeight / (pivotCoeff * pivotCoeff), 1.0));
+}
+
 void ErrorSet::setSelectionRule(options::ErrorSelectionRule rule)
 {
   if(rule != getSelectionRule()){
+    if (rule == options::ErrorSelectionRule::DEVEX)
+    {
+      // Start a new reference framework
+      d_devexWeights.purge();
+    }
     FocusSet into(ComparatorPivotRule(this, rule));
     FocusSet::const_iterator iter = d_focus.begin();
     FocusSet::const_iterator i_end = d_focus.end();
@@ -250,6 +313,21 @@ bool ComparatorPivotRule::operator()(ArithVar v, ArithVar u) const {
         return cmp < 0;
       }
     }
+    case options::ErrorSelectionRule::DEVEX:
+    {
+      double vpri = d_errorSet->getPriority(v);
+      double upri = d_errorSet->getPriority(u);
+      if(vpri != upri){
+        return vpri < upri;
+      }
+      // Infinitesimal violations have the same priority
+      int cmp = d_errorSet->getAmount(v).cmp(d_errorSet->getAmount(u));
+      if(cmp == 0){
+        return v > u;
+      }else{
+        return cmp < 0;
+      }
+    }
   }
   Unreachable();
 }
@@ -267,6 +345,10 @@ void ErrorSet::update(ErrorInformation& ei){
         ei.setMetric(sumMetric(ei.getVariable()));
         d_focus.update(ei.getHandle(), ei.getVariable());
         break;
+      case options::ErrorSelectionRule::DEVEX:
+        setDevexPriority(ei);
+        d_focus.update(ei.getHandle(), ei.getVariable());
+        break;
       case options::ErrorSelectionRule::VAR_ORDER:
         // do nothing
         break;
@@ -314,6 +396,9 @@ void ErrorSet::transitionVariableIntoError(ArithVar v) {
     case options::ErrorSelectionRule::SUM_METRIC:
       ei.setMetric(sumMetric(ei.getVariable()));
       break;
+    case options::ErrorSelectionRule::DEVEX:
+      setDevexPriority(ei);
+      break;
     case options::ErrorSelectionRule::VAR_ORDER:
       // do nothing
       break;
@@ -344,6 +429,9 @@ void ErrorSet::addBackIntoFocus(ArithVar v) {
     case options::ErrorSelectionRule::SUM_METRIC:
       ei.setMetric(sumMetric(v));
       break;
+    case options::ErrorSelectionRule::DEVEX:
+      setDevexPriority(ei);
+      break;
     case options::ErrorSelectionRule::VAR_ORDER:
       // do nothing
       break;
@@ -30,6 +30,7 @@
 #include "theory/arith/partial_model.h"
 #include "theory/arith/tableau_sizes.h"
 #include "util/bin_heap.h"
+#include "util/dense_map.h"
 #include "util/statistics_registry.h"
 
 namespace CVC4 {
@@ -141,6 +142,9 @@ private:
   /** */
   uint32_t d_metric;
 
+  /** The Devex priority of the variable, only set for the Devex rule. */
+  double d_priority;
+
 public:
   ErrorInformation();
   ErrorInformation(ArithVar var, ConstraintP vio, int sgn);
@@ -181,6 +185,8 @@ public:
   void setAmount(const DeltaRational& am);
   void setMetric(uint32_t m) { d_metric = m; }
   uint32_t getMetric() const { return d_metric; }
+  void setPriority(double p) { d_priority = p; }
+  double getPriority() const { return d_priority; }
 
   inline void setHandle(FocusSetHandle h) {
     Assert(d_inFocus);
@@ -254,6 +260,16 @@ private:
 
   BoundCountingLookup d_boundLookup;
 
+  /**
+   * The Devex reference weights of the basic variables, 1 if not set.
+   * These approximate the squared norms of the rows of the steepest edge
+   * rule, and are reset each time the Devex rule is selected.
+   */
+  DenseMap<double> d_devexWeights;
+
+  /** Sets the amount of ei and its Devex priority amount^2 / weight. */
+  void setDevexPriority(ErrorInformation& ei);
+
   /**
    * Computes the difference between the assignment and its bound for x.
    */
@@ -286,6 +302,10 @@ public:
   error_iterator errorBegin() const { return d_errInfo.begin(); }
   error_iterator errorEnd() const { return d_errInfo.end(); }
 
+  typedef ArithVarVec::const_iterator signal_iterator;
+  signal_iterator signalBegin() const { return d_signals.begin(); }
+  signal_iterator signalEnd() const { return d_signals.end(); }
+
   bool inError(ArithVar v) const { return d_errInfo.isKey(v); }
   bool inFocus(ArithVar v) const { return d_errInfo[v].inFocus(); }
 
@@ -385,6 +405,22 @@ public:
     return d_errInfo[a].getMetric();
   }
 
+  double getPriority(ArithVar a) const {
+    return d_errInfo[a].getPriority();
+  }
+
+  double getDevexWeight(ArithVar basic) const {
+    return d_devexWeights.isKey(basic) ? d_devexWeights[basic] : 1.0;
+  }
+
+  /**
+   * Updates the Devex reference weights of the rows in the column of
+   * entering for the pivot of the basic variable leaving with entering.
+   */
+  void pivotDevexWeights(ArithVar leaving,
+                         ArithVar entering,
+                         const Tableau& tableau);
+
   ConstraintP getViolated(ArithVar a) const {
     return d_errInfo[a].getViolated();
   }
@@ -110,7 +110,7 @@ void LinearEqualityModule::includeBoundUpdate(ArithVar v, const BoundsInfo& prev
   BoundsInfo curr = d_variables.boundsInfo(v);
 
   Assert(prev != curr);
-  Tableau::ColIterator basicIter = d_tableau.colIterator(v);
+  Tableau::CompressedIterator basicIter = d_tableau.compressedColIterator(v);
   for(; !basicIter.atEnd(); ++basicIter){
     const Tableau::Entry& entry = *basicIter;
     Assert(entry.getColVar() == v);
@@ -205,7 +205,7 @@ void LinearEqualityModule::updateUntracked(ArithVar x_i, const DeltaRational& v)
                  << assignment_x_i << "|-> " << v << endl;
   DeltaRational diff = v - assignment_x_i;
 
-  Tableau::ColIterator colIter = d_tableau.colIterator(x_i);
+  Tableau::CompressedIterator colIter = d_tableau.compressedColIterator(x_i);
   for(; !colIter.atEnd(); ++colIter){
     const Tableau::Entry& entry = *colIter;
     Assert(entry.getColVar() == x_i);
@@ -244,7 +244,7 @@ void LinearEqualityModule::updateTracked(ArithVar x_i, const DeltaRational& v){
 
   bool anyChange = before != after;
 
-  Tableau::ColIterator colIter = d_tableau.colIterator(x_i);
+  Tableau::CompressedIterator colIter = d_tableau.compressedColIterator(x_i);
   for(; !colIter.atEnd(); ++colIter){
     const Tableau::Entry& entry = *colIter;
     Assert(entry.getColVar() == x_i);
@@ -442,7 +442,8 @@ bool LinearEqualityModule::debugEntireLinEqIsConsistent(const string& s){
 
 DeltaRational LinearEqualityModule::computeRowBound(RowIndex ridx, bool rowUb, ArithVar skip) const {
   DeltaRational sum(0,0);
-  for(Tableau::RowIterator i = d_tableau.ridRowIterator(ridx); !i.atEnd(); ++i){
+  for(Tableau::CompressedIterator i = d_tableau.compressedRidRowIterator(ridx);
+      !i.atEnd(); ++i){
     const Tableau::Entry& entry = (*i);
     ArithVar v = entry.getColVar();
     if(v == skip){ continue; }
@@ -467,7 +468,8 @@ DeltaRational LinearEqualityModule::computeRowValue(ArithVar x, bool useSafe) co
   Assert(d_tableau.isBasic(x));
   DeltaRational sum(0);
 
-  for(Tableau::RowIterator i = d_tableau.basicRowIterator(x); !i.atEnd(); ++i){
+  for(Tableau::CompressedIterator i = d_tableau.compressedBasicRowIterator(x);
+      !i.atEnd(); ++i){
     const Tableau::Entry& entry = (*i);
     ArithVar nonbasic = entry.getColVar();
     if(nonbasic == x) continue;
@@ -479,8 +481,8 @@ DeltaRational LinearEqualityModule::computeRowValue(ArithVar x, bool useSafe) co
   return sum;
 }
 
-const Tableau::Entry* LinearEqualityModule::rowLacksBound(RowIndex ridx, bool rowUb, ArithVar skip){
-  Tableau::RowIterator iter = d_tableau.ridRowIterator(ridx);
+const Tableau::Entry* LinearEqualityModule::rowLacksBound(RowIndex ridx, bool rowUb, ArithVar skip) const{
+  Tableau::CompressedIterator iter = d_tableau.compressedRidRowIterator(ridx);
   for(; !iter.atEnd(); ++iter){
     const Tableau::Entry& entry = *iter;
 
@@ -884,7 +886,7 @@ void LinearEqualityModule::trackRowIndex(RowIndex ridx){
 BoundsInfo LinearEqualityModule::computeRowBoundInfo(RowIndex ridx, bool inQueue) const{
   BoundsInfo bi;
 
-  Tableau::RowIterator iter = d_tableau.ridRowIterator(ridx);
+  Tableau::CompressedIterator iter = d_tableau.compressedRidRowIterator(ridx);
   for(; !iter.atEnd();  ++iter){
     const Tableau::Entry& entry = *iter;
     ArithVar v = entry.getColVar();
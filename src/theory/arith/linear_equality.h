@@ -273,7 +273,7 @@ public:
    *
    * If skip == ARITHVAR_SENTINEL, this is equivalent to considering the whole row.
    */
-  const Tableau::Entry* rowLacksBound(RowIndex ridx, bool upperBound, ArithVar skip);
+  const Tableau::Entry* rowLacksBound(RowIndex ridx, bool upperBound, ArithVar skip) const;
 
 
   void startTrackingBoundCounts();
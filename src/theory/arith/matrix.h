@@ -362,6 +362,86 @@ public:
     : SuperT(head, size, mev){}
 };/* class ColumnVector<T> */
 
+/**
+ * A compressed copy of the linked row or column vectors of a Matrix.  The
+ * ids of the entries of each vector are kept contiguously, so traversing a
+ * vector does not chase the links between its entries.  A vector is copied
+ * the first time it is traversed after it changed, so the copies are built
+ * lazily after each batch of pivots; the linked vectors remain the primary
+ * representation that is updated by pivoting.
+ */
+template <class T>
+class CompressedVectors {
+public:
+  class Iterator {
+  private:
+    const EntryID* d_curr;
+    const EntryID* d_end;
+    const MatrixEntryVector<T>* d_entries;
+
+  public:
+    Iterator(const EntryID* begin, const EntryID* end,
+             const MatrixEntryVector<T>* entries)
+      : d_curr(begin), d_end(end), d_entries(entries)
+    {}
+
+    EntryID getID() const { return *d_curr; }
+
+    const MatrixEntry<T>& operator*() const{
+      Assert(!atEnd());
+      return (*d_entries)[*d_curr];
+    }
+
+    Iterator& operator++(){
+      Assert(!atEnd());
+      ++d_curr;
+      return *this;
+    }
+
+    bool atEnd() const { return d_curr == d_end; }
+  }; /* class CompressedVectors<T>::Iterator */
+
+private:
+  /* The ids of the entries of each vector, valid if d_upToDate is set. */
+  std::vector< std::vector<EntryID> > d_ids;
+  std::vector<bool> d_upToDate;
+
+public:
+  void resize(size_t n){
+    d_ids.resize(n);
+    d_upToDate.resize(n, false);
+  }
+
+  void invalidate(Index i){
+    Assert(i < d_upToDate.size());
+    d_upToDate[i] = false;
+  }
+
+  void invalidateAll(){
+    d_upToDate.assign(d_upToDate.size(), false);
+  }
+
+  /* Returns an iterator over the compressed copy of v, the vector i. */
+  template <bool isRow>
+  Iterator get(Index i, const MatrixVector<T, isRow>& v,
+               const MatrixEntryVector<T>* entries){
+    Assert(i < d_ids.size());
+    std::vector<EntryID>& ids = d_ids[i];
+    if(!d_upToDate[i]){
+      ids.clear();
+      ids.reserve(v.getSize());
+      for(typename MatrixVector<T, isRow>::const_iterator j = v.begin();
+          !j.atEnd(); ++j){
+        ids.push_back(j.getID());
+      }
+      d_upToDate[i] = true;
+    }
+    Assert(ids.size() == v.getSize());
+    const EntryID* begin = ids.data();
+    return Iterator(begin, begin + ids.size(), entries);
+  }
+};/* class CompressedVectors<T> */
+
 template <class T>
 class Matrix {
 public:
@@ -374,6 +454,7 @@ protected:
 public:
   typedef typename RowVectorT::const_iterator RowIterator;
   typedef typename ColumnVectorT::const_iterator ColIterator;
+  typedef typename CompressedVectors<T>::Iterator CompressedIterator;
 
 protected:
   // RowTable : RowID |-> RowVector
@@ -384,10 +465,19 @@ protected:
   typedef std::vector< ColumnVectorT > ColumnTable;
   ColumnTable d_columns;
 
-  /* The merge buffer is used to store a row in order to optimize row addition. */
-  typedef std::pair<EntryID, bool> PosUsedPair;
-  typedef DenseMap< PosUsedPair > RowToPosUsedPairMap;
-  RowToPosUsedPairMap d_mergeBuffer;
+  /*
+   * The merge buffer is used to store a row in order to optimize row addition.
+   * It maps the columns of the row to their positions in the dense arrays
+   * below, which hold a copy of the row. Row additions thus read the buffered
+   * coefficients contiguously instead of following the entries of the row.
+   */
+  typedef DenseMap<uint32_t> ColumnToPosMap;
+  ColumnToPosMap d_mergeBuffer;
+
+  /* The columns, coefficients and merge marks of the row in the buffer. */
+  std::vector<ArithVar> d_bufferColumns;
+  std::vector<T> d_bufferCoefficients;
+  std::vector<bool> d_bufferUsed;
 
   /* The row that is in the merge buffer. */
   RowIndex d_rowInMergeBuffer;
@@ -397,6 +487,10 @@ protected:
 
   std::vector<RowIndex> d_pool;
 
+  /* Compressed copies of the rows and columns for read-only traversals. */
+  mutable CompressedVectors<T> d_compressedRows;
+  mutable CompressedVectors<T> d_compressedColumns;
+
   T d_zero;
 
 public:
@@ -407,6 +501,9 @@ public:
   : d_rows(),
     d_columns(),
     d_mergeBuffer(),
+    d_bufferColumns(),
+    d_bufferCoefficients(),
+    d_bufferUsed(),
     d_rowInMergeBuffer(ROW_INDEX_SENTINEL),
     d_entriesInUse(0),
     d_entries(),
@@ -417,6 +514,9 @@ public:
   : d_rows(),
     d_columns(),
     d_mergeBuffer(),
+    d_bufferColumns(),
+    d_bufferCoefficients(),
+    d_bufferUsed(),
     d_rowInMergeBuffer(ROW_INDEX_SENTINEL),
     d_entriesInUse(0),
     d_entries(),
@@ -427,6 +527,9 @@ public:
   : d_rows(),
     d_columns(),
     d_mergeBuffer(m.d_mergeBuffer),
+    d_bufferColumns(m.d_bufferColumns),
+    d_bufferCoefficients(m.d_bufferCoefficients),
+    d_bufferUsed(m.d_bufferUsed),
     d_rowInMergeBuffer(m.d_rowInMergeBuffer),
     d_entriesInUse(m.d_entriesInUse),
     d_entries(m.d_entries),
@@ -442,10 +545,15 @@ public:
       const RowVectorT& row = *r;
       d_rows.push_back(RowVectorT(row.getHead(),row.getSize(),&d_entries));
     }
+    d_compressedRows.resize(d_rows.size());
+    d_compressedColumns.resize(d_columns.size());
   }
 
   Matrix& operator=(const Matrix& m){
     d_mergeBuffer = (m.d_mergeBuffer);
+    d_bufferColumns = (m.d_bufferColumns);
+    d_bufferCoefficients = (m.d_bufferCoefficients);
+    d_bufferUsed = (m.d_bufferUsed);
     d_rowInMergeBuffer = (m.d_rowInMergeBuffer);
     d_entriesInUse = (m.d_entriesInUse);
     d_entries = (m.d_entries);
@@ -460,6 +568,10 @@ public:
       const RowVector<T>& row = *r;
       d_rows.push_back(RowVector<T>(row.getHead(), row.getSize(), &d_entries));
     }
+    d_compressedRows = CompressedVectors<T>();
+    d_compressedRows.resize(d_rows.size());
+    d_compressedColumns = CompressedVectors<T>();
+    d_compressedColumns.resize(d_columns.size());
     return *this;
   }
 
@@ -482,6 +594,8 @@ protected:
 
     d_rows[row].insert(newId);
     d_columns[col].insert(newId);
+    d_compressedRows.invalidate(row);
+    d_compressedColumns.invalidate(col);
   }
 
   void removeEntry(EntryID id){
@@ -498,6 +612,8 @@ protected:
 
     d_rows[ridx].remove(id);
     d_columns[col].remove(id);
+    d_compressedRows.invalidate(ridx);
+    d_compressedColumns.invalidate(col);
 
     entry.markBlank();
 
@@ -509,6 +625,7 @@ protected:
     if(d_pool.empty()){
       RowIndex ridx = d_rows.size();
       d_rows.push_back(RowVectorT(&d_entries));
+      d_compressedRows.resize(d_rows.size());
       return ridx;
     }else{
       RowIndex rid = d_pool.back();
@@ -533,6 +650,7 @@ public:
 
   void increaseSize(){
     d_columns.push_back(ColumnVector<T>(&d_entries));
+    d_compressedColumns.resize(d_columns.size());
   }
 
   void increaseSizeTo(size_t s){
@@ -551,6 +669,25 @@ public:
     return d_columns[v];
   }
 
+  /**
+   * Returns an iterator over the entries of the row r that does not follow
+   * the links of the row.  It is invalidated by any change to the row.
+   */
+  CompressedIterator getCompressedRow(RowIndex r) const {
+    Assert(r < d_rows.size());
+    return d_compressedRows.get(r, d_rows[r], &d_entries);
+  }
+
+  /**
+   * Returns an iterator over the entries of the column v that does not
+   * follow the links of the column.  It is invalidated by any change to the
+   * column.
+   */
+  CompressedIterator getCompressedColumn(ArithVar v) const {
+    Assert(v < d_columns.size());
+    return d_compressedColumns.get(v, d_columns[v], &d_entries);
+  }
+
   uint32_t getRowLength(RowIndex r) const{
     return getRow(r).getSize();
   }
@@ -593,11 +730,13 @@ public:
 
     RowIterator i = getRow(rid).begin(), i_end = getRow(rid).end();
     for(; i != i_end; ++i){
-      EntryID id = i.getID();
       const MatrixEntry<T>& entry = *i;
       ArithVar colVar = entry.getColVar();
-      d_mergeBuffer.set(colVar, std::make_pair(id, false));
+      d_mergeBuffer.set(colVar, d_bufferColumns.size());
+      d_bufferColumns.push_back(colVar);
+      d_bufferCoefficients.push_back(entry.getCoefficient());
     }
+    d_bufferUsed.assign(d_bufferColumns.size(), false);
 
     d_rowInMergeBuffer = rid;
   }
@@ -607,6 +746,9 @@ public:
 
     d_rowInMergeBuffer = ROW_INDEX_SENTINEL;
     d_mergeBuffer.purge();
+    d_bufferColumns.clear();
+    d_bufferCoefficients.clear();
+    d_bufferUsed.clear();
   }
 
   /* to *= mult */
@@ -659,13 +801,12 @@ public:
       ++i;
 
       if(d_mergeBuffer.isKey(colVar)){
-        EntryID bufferEntry = d_mergeBuffer[colVar].first;
-        Assert(!d_mergeBuffer[colVar].second);
-        d_mergeBuffer.get(colVar).second = true;
+        uint32_t pos = d_mergeBuffer[colVar];
+        Assert(!d_bufferUsed[pos]);
+        d_bufferUsed[pos] = true;
 
-        const Entry& other = d_entries.get(bufferEntry);
         T& coeff = entry.getCoefficient();
-        coeff += mult * other.getCoefficient();
+        coeff += mult * d_bufferCoefficients[pos];
 
         if(coeff.sgn() == 0){
           removeEntry(id);
@@ -673,19 +814,12 @@ public:
       }
     }
 
-    i = getRow(d_rowInMergeBuffer).begin();
-    i_end = getRow(d_rowInMergeBuffer).end();
-
-    for(; i != i_end; ++i){
-      const Entry& entry = *i;
-      ArithVar colVar = entry.getColVar();
-
-      if(d_mergeBuffer[colVar].second){
-        d_mergeBuffer.get(colVar).second = false;
+    for(uint32_t pos = 0, size = d_bufferColumns.size(); pos < size; ++pos){
+      if(d_bufferUsed[pos]){
+        d_bufferUsed[pos] = false;
       }else{
-        Assert(!(d_mergeBuffer[colVar]).second);
-        T newCoeff =  mult * entry.getCoefficient();
-        addEntry(to, colVar, newCoeff);
+        T newCoeff =  mult * d_bufferCoefficients[pos];
+        addEntry(to, d_bufferColumns[pos], newCoeff);
       }
     }
 
@@ -718,14 +852,13 @@ public:
       ++i;
 
       if(d_mergeBuffer.isKey(colVar)){
-        EntryID bufferEntry = d_mergeBuffer[colVar].first;
-        Assert(!d_mergeBuffer[colVar].second);
-        d_mergeBuffer.get(colVar).second = true;
+        uint32_t pos = d_mergeBuffer[colVar];
+        Assert(!d_bufferUsed[pos]);
+        d_bufferUsed[pos] = true;
 
-        const Entry& other = d_entries.get(bufferEntry);
         T& coeff = entry.getCoefficient();
         int coeffOldSgn = coeff.sgn();
-        coeff += mult * other.getCoefficient();
+        coeff += mult * d_bufferCoefficients[pos];
         int coeffNewSgn = coeff.sgn();
 
         if(coeffOldSgn != coeffNewSgn){
@@ -738,18 +871,12 @@ public:
       }
     }
 
-    i = getRow(d_rowInMergeBuffer).begin();
-    i_end = getRow(d_rowInMergeBuffer).end();
-
-    for(; i != i_end; ++i){
-      const Entry& entry = *i;
-      ArithVar colVar = entry.getColVar();
-
-      if(d_mergeBuffer[colVar].second){
-        d_mergeBuffer.get(colVar).second = false;
+    for(uint32_t pos = 0, size = d_bufferColumns.size(); pos < size; ++pos){
+      if(d_bufferUsed[pos]){
+        d_bufferUsed[pos] = false;
       }else{
-        Assert(!(d_mergeBuffer[colVar]).second);
-        T newCoeff =  mult * entry.getCoefficient();
+        ArithVar colVar = d_bufferColumns[pos];
+        T newCoeff =  mult * d_bufferCoefficients[pos];
         addEntry(to, colVar, newCoeff);
 
         cb.update(to, colVar, 0,  newCoeff.sgn());
@@ -762,11 +889,8 @@ public:
   }
 
   bool mergeBufferIsClear() const{
-    RowToPosUsedPairMap::const_iterator i = d_mergeBuffer.begin();
-    RowToPosUsedPairMap::const_iterator i_end = d_mergeBuffer.end();
-    for(; i != i_end; ++i){
-      RowIndex rid = *i;
-      if(d_mergeBuffer[rid].second){
+    for(uint32_t pos = 0, size = d_bufferUsed.size(); pos < size; ++pos){
+      if(d_bufferUsed[pos]){
         return false;
       }
     }
@@ -0,0 +1,725 @@
+/*********************                                                        */
+/*! \file nl_cad.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Exact cylindrical sampling for the non-linear extension class
+ **/
+
+#include "theory/arith/nl_cad.h"
+
+#include <algorithm>
+
+#include "base/check.h"
+#include "base/output.h"
+#include "expr/node_manager.h"
+#include "theory/arith/arith_msum.h"
+
+using namespace CVC4::kind;
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+namespace {
+
+typedef std::vector<Rational> UPoly;
+
+/** Beyond this many cached decompositions, the cache is cleared */
+const size_t s_maxCacheSize = 4096;
+
+/** Removes the leading zeros of p */
+void trim(UPoly& p)
+{
+  while (!p.empty() && p.back().isZero())
+  {
+    p.pop_back();
+  }
+}
+
+Rational eval(const UPoly& p, const Rational& x)
+{
+  Rational r(0);
+  for (size_t i = p.size(); i > 0; --i)
+  {
+    r = r * x + p[i - 1];
+  }
+  return r;
+}
+
+int signAt(const UPoly& p, const Rational& x) { return eval(p, x).sgn(); }
+
+UPoly derivative(const UPoly& p)
+{
+  UPoly d;
+  for (size_t i = 1; i < p.size(); ++i)
+  {
+    d.push_back(p[i] * Rational(static_cast<int64_t>(i)));
+  }
+  return d;
+}
+
+UPoly multiply(const UPoly& a, const UPoly& b)
+{
+  if (a.empty() || b.empty())
+  {
+    return UPoly();
+  }
+  UPoly r(a.size() + b.size() - 1, Rational(0));
+  for (size_t i = 0; i < a.size(); ++i)
+  {
+    for (size_t j = 0; j < b.size(); ++j)
+    {
+      r[i + j] += a[i] * b[j];
+    }
+  }
+  return r;
+}
+
+/** Divides a by the non-zero b, sets q to the quotient, returns the rest */
+UPoly divide(UPoly a, const UPoly& b, UPoly& q)
+{
+  Assert(!b.empty());
+  q.clear();
+  if (a.size() < b.size())
+  {
+    return a;
+  }
+  q.resize(a.size() - b.size() + 1, Rational(0));
+  for (size_t i = a.size(); i >= b.size(); --i)
+  {
+    Rational c = a[i - 1] / b.back();
+    q[i - b.size()] = c;
+    for (size_t j = 0; j < b.size(); ++j)
+    {
+      a[i - b.size() + j] -= c * b[j];
+    }
+  }
+  trim(a);
+  return a;
+}
+
+/** Returns the monic greatest common divisor of a and b */
+UPoly gcd(UPoly a, UPoly b)
+{
+  UPoly q;
+  while (!b.empty())
+  {
+    UPoly r = divide(a, b, q);
+    a = b;
+    b = r;
+  }
+  if (!a.empty())
+  {
+    Rational lc = a.back();
+    for (Rational& c : a)
+    {
+      c /= lc;
+    }
+  }
+  return a;
+}
+
+/** Returns the square-free part of the non-zero p */
+UPoly squareFree(const UPoly& p)
+{
+  UPoly g = gcd(p, derivative(p));
+  UPoly q;
+  divide(p, g, q);
+  return q;
+}
+
+/** The Sturm sequence of a non-constant, square-free polynomial */
+class Sturm
+{
+ public:
+  Sturm(const UPoly& p)
+  {
+    d_seq.push_back(p);
+    d_seq.push_back(derivative(p));
+    UPoly q;
+    while (d_seq.back().size() > 1)
+    {
+      UPoly r = divide(d_seq[d_seq.size() - 2], d_seq.back(), q);
+      if (r.empty())
+      {
+        break;
+      }
+      for (Rational& c : r)
+      {
+        c = -c;
+      }
+      d_seq.push_back(r);
+    }
+  }
+  /** The number of roots in ( lo, hi ] */
+  unsigned countRoots(const Rational& lo, const Rational& hi) const
+  {
+    return variations(lo) - variations(hi);
+  }
+
+ private:
+  unsigned variations(const Rational& x) const
+  {
+    unsigned v = 0;
+    int last = 0;
+    for (const UPoly& s : d_seq)
+    {
+      int sg = signAt(s, x);
+      if (sg != 0)
+      {
+        v += (last != 0 && sg != last) ? 1 : 0;
+        last = sg;
+      }
+    }
+    return v;
+  }
+  std::vector<UPoly> d_seq;
+};
+
+/** Does the non-zero p have a root in ( lo, hi ]? */
+bool hasRoot(const UPoly& p, const Rational& lo, const Rational& hi)
+{
+  if (p.size() <= 1)
+  {
+    return false;
+  }
+  return Sturm(squareFree(p)).countRoots(lo, hi) > 0;
+}
+
+}  // namespace
+
+CadSolver::CadSolver() {}
+
+unsigned CadSolver::mkVariable(Node n)
+{
+  std::unordered_map<Node, unsigned, NodeHashFunction>::iterator it =
+      d_varIndex.find(n);
+  if (it != d_varIndex.end())
+  {
+    return it->second;
+  }
+  unsigned i = d_vars.size();
+  d_varIndex[n] = i;
+  d_vars.push_back(n);
+  d_integral.push_back(n.getType().isInteger());
+  d_levelLits.push_back(std::vector<unsigned>());
+  return i;
+}
+
+bool CadSolver::addLiteral(Node lit)
+{
+  bool pol = lit.getKind() != NOT;
+  Node atom = pol ? lit : lit[0];
+  Kind k = atom.getKind();
+  if ((k != GEQ && k != GT && k != EQUAL) || !atom[0].getType().isReal())
+  {
+    return false;
+  }
+  std::map<Node, Node> msum;
+  if (!ArithMSum::getMonomialSumLit(atom, msum))
+  {
+    return false;
+  }
+  Literal l;
+  l.d_lit = lit;
+  for (const std::pair<const Node, Node>& m : msum)
+  {
+    Rational coeff =
+        m.second.isNull() ? Rational(1) : m.second.getConst<Rational>();
+    std::map<unsigned, unsigned> powers;
+    if (m.first.getKind() == NONLINEAR_MULT)
+    {
+      for (const Node& f : m.first)
+      {
+        ++powers[mkVariable(f)];
+      }
+    }
+    else if (!m.first.isNull())
+    {
+      ++powers[mkVariable(m.first)];
+    }
+    for (const std::pair<const unsigned, unsigned>& p : powers)
+    {
+      l.d_vars.push_back(p.first);
+    }
+    l.d_terms.push_back(
+        std::make_pair(coeff, Monomial(powers.begin(), powers.end())));
+  }
+  std::sort(l.d_vars.begin(), l.d_vars.end());
+  l.d_vars.erase(std::unique(l.d_vars.begin(), l.d_vars.end()),
+                 l.d_vars.end());
+  if (l.d_vars.empty())
+  {
+    return false;
+  }
+  // bits: negative (1), zero (2), positive (4)
+  unsigned signs = k == GEQ ? 6 : (k == GT ? 4 : 2);
+  l.d_signs = pol ? signs : (~signs & 7);
+  d_levelLits[l.d_vars.back()].push_back(d_lits.size());
+  d_lits.push_back(l);
+  return true;
+}
+
+CadSolver::UPoly CadSolver::substitute(
+    const Literal& lit, const std::vector<Rational>& assignment) const
+{
+  unsigned x = lit.d_vars.back();
+  UPoly p;
+  for (const std::pair<Rational, Monomial>& t : lit.d_terms)
+  {
+    Rational c = t.first;
+    unsigned degree = 0;
+    for (const std::pair<unsigned, unsigned>& vp : t.second)
+    {
+      if (vp.first == x)
+      {
+        degree = vp.second;
+        continue;
+      }
+      for (unsigned e = 0; e < vp.second; ++e)
+      {
+        c *= assignment[vp.first];
+      }
+    }
+    if (p.size() <= degree)
+    {
+      p.resize(degree + 1, Rational(0));
+    }
+    p[degree] += c;
+  }
+  trim(p);
+  return p;
+}
+
+CadSolver::Decomposition& CadSolver::decompose(const std::vector<UPoly>& polys)
+{
+  std::map<std::vector<UPoly>, Decomposition>::iterator it =
+      d_cache.find(polys);
+  if (it != d_cache.end())
+  {
+    return it->second;
+  }
+  if (d_cache.size() >= s_maxCacheSize)
+  {
+    d_cache.clear();
+  }
+  Decomposition& d = d_cache[polys];
+
+  // the roots of the polynomials are the roots of their square-free product
+  UPoly product(1, Rational(1));
+  std::vector<Rational> rationalRoots;
+  for (const UPoly& p : polys)
+  {
+    if (p.size() > 1)
+    {
+      product = squareFree(multiply(product, squareFree(p)));
+    }
+    if (p.size() == 2)
+    {
+      rationalRoots.push_back(-p[0] / p[1]);
+    }
+  }
+  d.d_product = product;
+
+  // isolate the roots by bisection on the Sturm sequence
+  if (product.size() > 1)
+  {
+    Sturm sturm(product);
+    Rational bound(0);
+    for (size_t i = 0; i + 1 < product.size(); ++i)
+    {
+      bound = std::max(bound, (product[i] / product.back()).abs());
+    }
+    bound += Rational(1);
+    std::vector<std::pair<Rational, Rational> > toIsolate;
+    toIsolate.push_back(std::make_pair(-bound, bound));
+    while (!toIsolate.empty())
+    {
+      Rational lo = toIsolate.back().first;
+      Rational hi = toIsolate.back().second;
+      toIsolate.pop_back();
+      unsigned n = sturm.countRoots(lo, hi);
+      if (n == 0)
+      {
+        continue;
+      }
+      if (n == 1)
+      {
+        Root r;
+        r.d_lo = signAt(product, hi) == 0 ? hi : lo;
+        r.d_hi = hi;
+        d.d_roots.push_back(r);
+        continue;
+      }
+      Rational mid = (lo + hi) / Rational(2);
+      toIsolate.push_back(std::make_pair(lo, mid));
+      toIsolate.push_back(std::make_pair(mid, hi));
+    }
+    // the integer roots and the roots of the linear factors are made exact
+    for (Root& r : d.d_roots)
+    {
+      while (!r.isExact() && r.d_hi - r.d_lo > Rational(1))
+      {
+        refine(product, r);
+      }
+      Rational n(r.d_hi.floor());
+      if (!r.isExact() && r.d_lo < n && signAt(product, n) == 0)
+      {
+        r.d_lo = n;
+        r.d_hi = n;
+      }
+      for (const Rational& q : rationalRoots)
+      {
+        if (!r.isExact() && r.d_lo < q && q < r.d_hi
+            && signAt(product, q) == 0)
+        {
+          r.d_lo = q;
+          r.d_hi = q;
+        }
+      }
+    }
+    std::sort(d.d_roots.begin(),
+              d.d_roots.end(),
+              [](const Root& a, const Root& b) { return a.d_hi < b.d_hi; });
+  }
+
+  // the signs on the roots, refining those that are not exact
+  size_t nroots = d.d_roots.size();
+  d.d_signs.resize(2 * nroots + 1, std::vector<int>(polys.size(), 0));
+  d.d_samples.resize(2 * nroots + 1, Rational(0));
+  for (size_t j = 0; j < nroots; ++j)
+  {
+    Root& r = d.d_roots[j];
+    for (size_t i = 0; i < polys.size(); ++i)
+    {
+      const UPoly& p = polys[i];
+      int& sg = d.d_signs[2 * j + 1][i];
+      if (p.size() <= 1 || r.isExact())
+      {
+        sg = p.empty() ? 0 : signAt(p, r.d_lo);
+        continue;
+      }
+      if (hasRoot(gcd(product, p), r.d_lo, r.d_hi))
+      {
+        sg = 0;
+        continue;
+      }
+      // p does not vanish at r, so its sign is constant near r
+      while (!r.isExact() && hasRoot(p, r.d_lo, r.d_hi))
+      {
+        refine(product, r);
+      }
+      sg = signAt(p, r.isExact() ? r.d_lo : r.d_hi);
+    }
+    d.d_samples[2 * j + 1] = r.d_lo;
+  }
+
+  // a sample of each sector, as simple as possible
+  for (size_t j = 0; j <= nroots; ++j)
+  {
+    Rational& s = d.d_samples[2 * j];
+    if (nroots == 0)
+    {
+      s = Rational(0);
+    }
+    else if (j == 0)
+    {
+      Rational hi = d.d_roots[0].d_lo;
+      s = hi > Rational(0) ? Rational(0) : Rational(hi.ceiling() - 1);
+    }
+    else if (j == nroots)
+    {
+      Rational lo = d.d_roots[j - 1].d_hi;
+      s = lo < Rational(0) ? Rational(0) : Rational(lo.floor() + 1);
+    }
+    else
+    {
+      Root& left = d.d_roots[j - 1];
+      Root& right = d.d_roots[j];
+      while (left.d_hi >= right.d_lo)
+      {
+        if (!left.isExact())
+        {
+          refine(product, left);
+        }
+        if (!right.isExact())
+        {
+          refine(product, right);
+        }
+      }
+      Rational n(left.d_hi.floor() + 1);
+      if (left.d_hi < Rational(0) && Rational(0) < right.d_lo)
+      {
+        s = Rational(0);
+      }
+      else if (n < right.d_lo)
+      {
+        s = right.d_lo <= Rational(0) ? Rational(right.d_lo.ceiling() - 1) : n;
+      }
+      else
+      {
+        s = (left.d_hi + right.d_lo) / Rational(2);
+      }
+    }
+    for (size_t i = 0; i < polys.size(); ++i)
+    {
+      d.d_signs[2 * j][i] = polys[i].empty() ? 0 : signAt(polys[i], s);
+    }
+  }
+  return d;
+}
+
+void CadSolver::refine(const UPoly& product, Root& r)
+{
+  Rational mid = (r.d_lo + r.d_hi) / Rational(2);
+  int sm = signAt(product, mid);
+  if (sm == 0)
+  {
+    r.d_lo = mid;
+    r.d_hi = mid;
+  }
+  else if (sm == signAt(product, r.d_hi))
+  {
+    r.d_hi = mid;
+  }
+  else
+  {
+    r.d_lo = mid;
+  }
+}
+
+bool CadSolver::isBelow(const Rational& v, const UPoly& product, Root& r)
+{
+  for (;;)
+  {
+    if (r.isExact())
+    {
+      return v < r.d_lo;
+    }
+    if (v <= r.d_lo || v >= r.d_hi)
+    {
+      return v <= r.d_lo;
+    }
+    if (signAt(product, v) == 0)
+    {
+      // v is the root
+      return false;
+    }
+    refine(product, r);
+  }
+}
+
+bool CadSolver::isAbove(const Rational& v, const UPoly& product, Root& r)
+{
+  for (;;)
+  {
+    if (r.isExact())
+    {
+      return v > r.d_lo;
+    }
+    if (v <= r.d_lo || v >= r.d_hi)
+    {
+      return v >= r.d_hi;
+    }
+    if (signAt(product, v) == 0)
+    {
+      return false;
+    }
+    refine(product, r);
+  }
+}
+
+std::vector<unsigned> CadSolver::satisfyingCells(
+    const Decomposition& d, const std::vector<unsigned>& lits) const
+{
+  std::vector<unsigned> cells;
+  for (unsigned c = 0; c < d.d_signs.size(); ++c)
+  {
+    bool sat = true;
+    for (unsigned i = 0; i < lits.size() && sat; ++i)
+    {
+      int sg = d.d_signs[c][i];
+      sat = (d_lits[lits[i]].d_signs & (1u << (sg + 1))) != 0;
+    }
+    if (sat)
+    {
+      cells.push_back(c);
+    }
+  }
+  return cells;
+}
+
+bool CadSolver::pickValue(Decomposition& d,
+                          unsigned c,
+                          bool integral,
+                          Rational& value) const
+{
+  if (c % 2 == 1)
+  {
+    // a root, rational if it is exact
+    const Root& r = d.d_roots[c / 2];
+    value = r.d_lo;
+    return r.isExact() && (!integral || value.isIntegral());
+  }
+  value = d.d_samples[c];
+  if (!integral || value.isIntegral())
+  {
+    return true;
+  }
+  // the least integer above the root left of the sector, if it is below the
+  // root right of it (the samples of the unbounded sectors are integers)
+  unsigned j = c / 2;
+  Assert(j > 0 && j < d.d_roots.size());
+  Root& left = d.d_roots[j - 1];
+  Root& right = d.d_roots[j];
+  value = Rational(left.d_lo.floor() + 1);
+  while (!isAbove(value, d.d_product, left))
+  {
+    value += Rational(1);
+  }
+  return isBelow(value, d.d_product, right);
+}
+
+bool CadSolver::search(unsigned level,
+                       std::vector<Rational>& assignment,
+                       unsigned& budget)
+{
+  if (level == d_vars.size())
+  {
+    return true;
+  }
+  const std::vector<unsigned>& lits = d_levelLits[level];
+  if (lits.empty())
+  {
+    assignment[level] = Rational(0);
+    return search(level + 1, assignment, budget);
+  }
+  std::vector<UPoly> polys;
+  for (unsigned i : lits)
+  {
+    polys.push_back(substitute(d_lits[i], assignment));
+  }
+  Decomposition& d = decompose(polys);
+  std::vector<unsigned> cells = satisfyingCells(d, lits);
+  for (unsigned c : cells)
+  {
+    if (budget == 0)
+    {
+      return false;
+    }
+    --budget;
+    // the decomposition may move in the cache when it is cleared, so it is
+    // looked up again for each cell
+    Rational value;
+    if (!pickValue(decompose(polys), c, d_integral[level], value))
+    {
+      continue;
+    }
+    assignment[level] = value;
+    if (search(level + 1, assignment, budget))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool CadSolver::check(const std::vector<Node>& assertions,
+                      std::vector<Node>& lemmas,
+                      std::vector<std::pair<Node, Node> >& model,
+                      unsigned budget)
+{
+  d_vars.clear();
+  d_integral.clear();
+  d_varIndex.clear();
+  d_lits.clear();
+  d_levelLits.clear();
+  bool complete = true;
+  for (const Node& a : assertions)
+  {
+    complete = addLiteral(a) && complete;
+  }
+  Trace("nl-cad") << "CAD: " << d_lits.size() << " literals over "
+                  << d_vars.size() << " variables" << std::endl;
+
+  // the univariate literals of each variable, which must have a common cell
+  NodeManager* nm = NodeManager::currentNM();
+  std::vector<Rational> none(d_vars.size(), Rational(0));
+  for (unsigned v = 0; v < d_vars.size(); ++v)
+  {
+    std::vector<unsigned> lits;
+    for (unsigned i : d_levelLits[v])
+    {
+      if (d_lits[i].d_vars.size() == 1)
+      {
+        lits.push_back(i);
+      }
+    }
+    std::vector<UPoly> polys;
+    for (unsigned i : lits)
+    {
+      polys.push_back(substitute(d_lits[i], none));
+    }
+    if (lits.empty() || !satisfyingCells(decompose(polys), lits).empty())
+    {
+      continue;
+    }
+    // minimize the conflict by deletion
+    for (unsigned k = lits.size(); k > 0; --k)
+    {
+      std::vector<unsigned> sub(lits);
+      std::vector<UPoly> subPolys(polys);
+      sub.erase(sub.begin() + (k - 1));
+      subPolys.erase(subPolys.begin() + (k - 1));
+      if (!sub.empty() && satisfyingCells(decompose(subPolys), sub).empty())
+      {
+        lits = sub;
+        polys = subPolys;
+      }
+    }
+    std::vector<Node> conflict;
+    for (unsigned i : lits)
+    {
+      conflict.push_back(d_lits[i].d_lit.negate());
+    }
+    Node lem = conflict.size() == 1 ? conflict[0] : nm->mkNode(OR, conflict);
+    Trace("nl-cad") << "CAD: univariate conflict " << lem << std::endl;
+    lemmas.push_back(lem);
+    return true;
+  }
+
+  // a model of all the literals, if they all are polynomial literals over
+  // variables
+  for (const Node& v : d_vars)
+  {
+    complete = complete && v.isVar();
+  }
+  if (!complete)
+  {
+    return false;
+  }
+  std::vector<Rational> assignment(d_vars.size(), Rational(0));
+  if (!search(0, assignment, budget))
+  {
+    Trace("nl-cad") << "CAD: no model found" << std::endl;
+    return false;
+  }
+  for (unsigned v = 0; v < d_vars.size(); ++v)
+  {
+    Trace("nl-cad") << "CAD: " << d_vars[v] << " -> " << assignment[v]
+                    << std::endl;
+    model.push_back(std::make_pair(d_vars[v], nm->mkConst(assignment[v])));
+  }
+  return false;
+}
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace CVC4
@@ -0,0 +1,166 @@
+/*********************                                                        */
+/*! \file nl_cad.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Exact cylindrical sampling for the non-linear extension class
+ **/
+
+#ifndef CVC4__THEORY__ARITH__NL_CAD_H
+#define CVC4__THEORY__ARITH__NL_CAD_H
+
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "expr/kind.h"
+#include "expr/node.h"
+#include "util/rational.h"
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+/** Exact cylindrical sampling
+ *
+ * This class decides sets of polynomial literals ( sum_i c_i * m_i ) <k> c
+ * with exact arithmetic, in the style of model-constructing CAD (NLSAT):
+ * the variables are assigned one after the other, and the literals whose
+ * last variable is x become univariate polynomials in x once the previous
+ * variables are assigned.  The real line is then decomposed into the real
+ * algebraic roots of these polynomials (isolated by Sturm sequences into
+ * rational intervals, so that the sign of a polynomial at a root is
+ * computed exactly) and the open sectors between them.  A cell on which all
+ * of the literals hold gives the value of x.
+ *
+ * The decomposition of the literals of the first variable does not depend
+ * on any assignment, so a variable whose univariate literals have no
+ * satisfying cell gives an exact conflict.  Multivariate conflicts would
+ * need the projection of the polynomials onto the previous variables, which
+ * is not done: only models are constructed for them, by a bounded search
+ * over the rational sample points of the cells.  The decompositions are
+ * cached, since the same (univariate) polynomials recur in every check.
+ */
+class CadSolver
+{
+ public:
+  CadSolver();
+
+  /** check
+   *
+   * If the univariate literals of assertions over some variable are
+   * unsatisfiable, this method adds the negation of an unsatisfiable subset
+   * of them to lemmas and returns true.  Otherwise, it looks for a rational
+   * model of all of assertions by cylindrical sampling, visiting at most
+   * budget cells.  If it finds one, it adds the value of each variable to
+   * model.  It returns false in both cases.
+   */
+  bool check(const std::vector<Node>& assertions,
+             std::vector<Node>& lemmas,
+             std::vector<std::pair<Node, Node> >& model,
+             unsigned budget);
+
+ private:
+  /** A univariate polynomial, by increasing degree, without leading zeros */
+  typedef std::vector<Rational> UPoly;
+  /** A product of powers of variables, by variable index */
+  typedef std::vector<std::pair<unsigned, unsigned> > Monomial;
+  /** A literal over sum_i d_terms[i].first * d_terms[i].second */
+  struct Literal
+  {
+    Node d_lit;
+    std::vector<std::pair<Rational, Monomial> > d_terms;
+    /**
+     * The signs of the sum for which the literal holds, as a bit set over
+     * negative (1), zero (2) and positive (4)
+     */
+    unsigned d_signs;
+    /** The variables of the literal, by increasing index */
+    std::vector<unsigned> d_vars;
+  };
+  /**
+   * A real root of a polynomial, the only one in ( d_lo, d_hi ), or d_lo if
+   * d_lo = d_hi
+   */
+  struct Root
+  {
+    Rational d_lo;
+    Rational d_hi;
+    bool isExact() const { return d_lo == d_hi; }
+  };
+  /**
+   * The decomposition of the real line for a list of polynomials.  Cell
+   * 2j is the open sector below root j (or above all roots if j is the
+   * number of roots), cell 2j + 1 is root j.
+   */
+  struct Decomposition
+  {
+    /** The square-free product of the polynomials */
+    UPoly d_product;
+    /** The distinct roots of the polynomials, in increasing order */
+    std::vector<Root> d_roots;
+    /** The sign of each polynomial on each cell */
+    std::vector<std::vector<int> > d_signs;
+    /** A rational point of each sector and exact root */
+    std::vector<Rational> d_samples;
+  };
+
+  /** Returns the index of the variable n, registering it if it is new */
+  unsigned mkVariable(Node n);
+  /** Registers lit, returns false if it is not a polynomial literal */
+  bool addLiteral(Node lit);
+  /**
+   * Returns lit as a univariate polynomial in its last variable, where the
+   * other variables have their values in assignment.
+   */
+  UPoly substitute(const Literal& lit,
+                   const std::vector<Rational>& assignment) const;
+  /** Returns the (cached) decomposition for the polynomials polys */
+  Decomposition& decompose(const std::vector<UPoly>& polys);
+  /** Halves the interval of the root r of the square-free product */
+  static void refine(const UPoly& product, Root& r);
+  /** Is v below (resp. above) the root r of product? Refines r as needed. */
+  static bool isBelow(const Rational& v, const UPoly& product, Root& r);
+  static bool isAbove(const Rational& v, const UPoly& product, Root& r);
+  /** Returns the cells of d where all the literals lits hold */
+  std::vector<unsigned> satisfyingCells(
+      const Decomposition& d, const std::vector<unsigned>& lits) const;
+  /**
+   * Sets value to a point of the cell c of d, integral if integral is true,
+   * and returns true if there is one.
+   */
+  bool pickValue(Decomposition& d,
+                 unsigned c,
+                 bool integral,
+                 Rational& value) const;
+  /**
+   * Extends assignment to the variables from index level on, such that all
+   * the literals hold, visiting at most budget cells.
+   */
+  bool search(unsigned level,
+              std::vector<Rational>& assignment,
+              unsigned& budget);
+
+  /** The variables, and whether they are integral */
+  std::vector<Node> d_vars;
+  std::vector<bool> d_integral;
+  std::unordered_map<Node, unsigned, NodeHashFunction> d_varIndex;
+  /** The literals, and the literals whose last variable is each variable */
+  std::vector<Literal> d_lits;
+  std::vector<std::vector<unsigned> > d_levelLits;
+  /** The cached decompositions */
+  std::map<std::vector<UPoly>, Decomposition> d_cache;
+}; /* class CadSolver */
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__ARITH__NL_CAD_H */
@@ -0,0 +1,638 @@
+/*********************                                                        */
+/*! \file nl_icp.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Interval constraint propagation for the non-linear extension class
+ **/
+
+#include "theory/arith/nl_icp.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <map>
+
+#include "base/output.h"
+#include "expr/node_manager.h"
+#include "theory/arith/arith_msum.h"
+#include "util/rational.h"
+
+using namespace CVC4::kind;
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+namespace {
+
+typedef IcpSolver::Interval Interval;
+
+const double s_inf = std::numeric_limits<double>::infinity();
+
+/**
+ * Round x, which is within one ulp of the exact result of an operation, down
+ * and up.
+ */
+double down(double x)
+{
+  return std::isnan(x) ? -s_inf : std::isinf(x) ? x : std::nextafter(x, -s_inf);
+}
+double up(double x)
+{
+  return std::isnan(x) ? s_inf : std::isinf(x) ? x : std::nextafter(x, s_inf);
+}
+
+/**
+ * Round x, the result of a function of the math library, down and up.  The
+ * relative error of these functions is far below the slack added here.
+ */
+double downApprox(double x)
+{
+  return std::isinf(x) ? down(x) : down(x - std::fabs(x) * 1e-12);
+}
+double upApprox(double x)
+{
+  return std::isinf(x) ? up(x) : up(x + std::fabs(x) * 1e-12);
+}
+
+Interval fromRational(const Rational& r)
+{
+  // the conversion and a division may each be off by one ulp
+  double d = r.getDouble();
+  return Interval(down(down(d)), up(up(d)));
+}
+
+/** Returns a rational below (or above if isUp) d with 24 significant bits. */
+Rational toRational(double d, bool isUp)
+{
+  int exp;
+  std::frexp(d, &exp);
+  int k = 24 - exp;
+  double scaled = std::ldexp(d, k);
+  scaled = isUp ? std::ceil(scaled) : std::floor(scaled);
+  Rational r(Integer(static_cast<long>(scaled)));
+  Rational p(Integer(1).multiplyByPow2(static_cast<uint32_t>(std::abs(k))));
+  return k >= 0 ? r / p : r * p;
+}
+
+Interval intersect(const Interval& a, const Interval& b)
+{
+  return Interval(std::max(a.d_lo, b.d_lo), std::min(a.d_hi, b.d_hi));
+}
+
+Interval hull(const Interval& a, const Interval& b)
+{
+  if (a.isEmpty())
+  {
+    return b;
+  }
+  if (b.isEmpty())
+  {
+    return a;
+  }
+  return Interval(std::min(a.d_lo, b.d_lo), std::max(a.d_hi, b.d_hi));
+}
+
+Interval add(const Interval& a, const Interval& b)
+{
+  return Interval(down(a.d_lo + b.d_lo), up(a.d_hi + b.d_hi));
+}
+
+Interval sub(const Interval& a, const Interval& b)
+{
+  return Interval(down(a.d_lo - b.d_hi), up(a.d_hi - b.d_lo));
+}
+
+Interval mul(const Interval& a, const Interval& b)
+{
+  double ps[4];
+  unsigned n = 0;
+  for (double x : {a.d_lo, a.d_hi})
+  {
+    for (double y : {b.d_lo, b.d_hi})
+    {
+      // 0 * inf is 0 here, since 0 is in the interval
+      ps[n++] = x == 0 || y == 0 ? 0 : x * y;
+    }
+  }
+  return Interval(down(*std::min_element(ps, ps + 4)),
+                  up(*std::max_element(ps, ps + 4)));
+}
+
+/** Divides a by b, which does not contain zero. */
+Interval div(const Interval& a, const Interval& b)
+{
+  Assert(!b.containsZero());
+  std::vector<double> qs;
+  for (double x : {a.d_lo, a.d_hi})
+  {
+    for (double y : {b.d_lo, b.d_hi})
+    {
+      if (std::isinf(y))
+      {
+        qs.push_back(0);
+        if (std::isinf(x))
+        {
+          // the quotient tends to any value of the sign of x / y
+          qs.push_back((x > 0) == (y > 0) ? s_inf : -s_inf);
+        }
+      }
+      else
+      {
+        qs.push_back(x / y);
+      }
+    }
+  }
+  return Interval(down(*std::min_element(qs.begin(), qs.end())),
+                  up(*std::max_element(qs.begin(), qs.end())));
+}
+
+/** Returns x^e for x >= 0, rounded down or up. */
+double powRounded(double x, unsigned e, bool isUp)
+{
+  double r = 1;
+  for (unsigned i = 0; i < e; i++)
+  {
+    r = isUp ? up(r * x) : down(r * x);
+  }
+  return isUp ? r : std::max(r, 0.0);
+}
+
+Interval pow(const Interval& a, unsigned e)
+{
+  if (e == 1)
+  {
+    return a;
+  }
+  if (e % 2 == 1)
+  {
+    double lo = a.d_lo >= 0 ? powRounded(a.d_lo, e, false)
+                            : -powRounded(-a.d_lo, e, true);
+    double hi = a.d_hi >= 0 ? powRounded(a.d_hi, e, true)
+                            : -powRounded(-a.d_hi, e, false);
+    return Interval(lo, hi);
+  }
+  if (a.d_lo >= 0)
+  {
+    return Interval(powRounded(a.d_lo, e, false), powRounded(a.d_hi, e, true));
+  }
+  if (a.d_hi <= 0)
+  {
+    return Interval(powRounded(-a.d_hi, e, false),
+                    powRounded(-a.d_lo, e, true));
+  }
+  return Interval(0,
+                  std::max(powRounded(-a.d_lo, e, true),
+                           powRounded(a.d_hi, e, true)));
+}
+
+/** Returns the e^th root of x >= 0, rounded down or up. */
+double root(double x, unsigned e, bool isUp)
+{
+  if (e == 1 || x == 0 || std::isinf(x))
+  {
+    return x;
+  }
+  double r = std::pow(x, 1.0 / e);
+  return isUp ? upApprox(r) : std::max(downApprox(r), 0.0);
+}
+
+/** Returns the e^th root of x for an odd e, rounded down or up. */
+double signedRoot(double x, unsigned e, bool isUp)
+{
+  return x >= 0 ? root(x, e, isUp) : -root(-x, e, !isUp);
+}
+
+/**
+ * Returns an interval that contains the values in cur whose e^th power is
+ * in a.
+ */
+Interval rootInterval(const Interval& a, unsigned e, const Interval& cur)
+{
+  if (e == 1)
+  {
+    return a;
+  }
+  if (e % 2 == 1)
+  {
+    return Interval(signedRoot(a.d_lo, e, false), signedRoot(a.d_hi, e, true));
+  }
+  if (a.d_hi < 0)
+  {
+    return Interval(1, 0);
+  }
+  double rlo = root(std::max(a.d_lo, 0.0), e, false);
+  double rhi = root(a.d_hi, e, true);
+  return hull(intersect(cur, Interval(rlo, rhi)),
+              intersect(cur, Interval(-rhi, -rlo)));
+}
+
+}  // namespace
+
+IcpSolver::Interval::Interval() : d_lo(-s_inf), d_hi(s_inf) {}
+
+IcpSolver::Interval::Interval(double lo, double hi) : d_lo(lo), d_hi(hi) {}
+
+IcpSolver::IcpSolver() {}
+
+unsigned IcpSolver::mkVariable(Node n)
+{
+  std::unordered_map<Node, unsigned, NodeHashFunction>::iterator it =
+      d_varIndex.find(n);
+  if (it != d_varIndex.end())
+  {
+    return it->second;
+  }
+  unsigned v = d_vars.size();
+  d_varIndex[n] = v;
+  d_vars.push_back(Variable());
+  d_vars[v].d_node = n;
+  d_vars[v].d_derived[0] = false;
+  d_vars[v].d_derived[1] = false;
+  Kind k = n.getKind();
+  if (k == EXPONENTIAL || k == SINE)
+  {
+    Node arg = n[0];
+    Kind ak = arg.getKind();
+    if (!arg.isConst() && ak != PLUS && ak != MULT && ak != NONLINEAR_MULT)
+    {
+      unsigned a = mkVariable(arg);
+      unsigned f = d_functions.size();
+      d_functions.push_back(Function{k, v, a});
+      d_vars[v].d_functions.push_back(f);
+      d_vars[a].d_functions.push_back(f);
+    }
+  }
+  return v;
+}
+
+bool IcpSolver::addConstraint(Node lit)
+{
+  bool pol = lit.getKind() != NOT;
+  Node atom = pol ? lit : lit[0];
+  Kind k = atom.getKind();
+  if (k != GEQ && (k != EQUAL || !pol || !atom[0].getType().isReal()))
+  {
+    return false;
+  }
+  std::map<Node, Node> msum;
+  if (!ArithMSum::getMonomialSumLit(atom, msum))
+  {
+    return false;
+  }
+  unsigned c = d_constraints.size();
+  Constraint con;
+  con.d_lit = lit;
+  con.d_nonlinear = false;
+  // the literal is ( sum + k ) <k> 0
+  Interval constant(0, 0);
+  for (const std::pair<const Node, Node>& m : msum)
+  {
+    Interval coeff = m.second.isNull()
+                         ? Interval(1, 1)
+                         : fromRational(m.second.getConst<Rational>());
+    if (m.first.isNull())
+    {
+      constant = coeff;
+      continue;
+    }
+    std::map<unsigned, unsigned> powers;
+    if (m.first.getKind() == NONLINEAR_MULT)
+    {
+      for (const Node& f : m.first)
+      {
+        ++powers[mkVariable(f)];
+      }
+      con.d_nonlinear = true;
+    }
+    else
+    {
+      ++powers[mkVariable(m.first)];
+    }
+    con.d_terms.push_back(
+        std::make_pair(coeff, Monomial(powers.begin(), powers.end())));
+    for (const std::pair<const unsigned, unsigned>& p : powers)
+    {
+      d_vars[p.first].d_constraints.push_back(c);
+    }
+  }
+  if (con.d_terms.empty())
+  {
+    return false;
+  }
+  Interval rhs(-constant.d_hi, -constant.d_lo);
+  con.d_rhs = k == EQUAL ? rhs
+                         : pol ? Interval(rhs.d_lo, s_inf)
+                               : Interval(-s_inf, rhs.d_hi);
+  d_constraints.push_back(con);
+  return true;
+}
+
+IcpSolver::Interval IcpSolver::evaluate(const Monomial& m, size_t skip) const
+{
+  Interval r(1, 1);
+  for (size_t j = 0, size = m.size(); j < size; j++)
+  {
+    if (j != skip)
+    {
+      r = mul(r, pow(d_vars[m[j].first].d_interval, m[j].second));
+    }
+  }
+  return r;
+}
+
+bool IcpSolver::narrow(unsigned v,
+                       const Interval& i,
+                       const std::set<unsigned>& deps,
+                       bool derived,
+                       bool direct,
+                       std::vector<unsigned>& changed)
+{
+  Variable& var = d_vars[v];
+  if (direct)
+  {
+    var.d_direct = intersect(var.d_direct, i);
+  }
+  Interval next = intersect(var.d_interval, i);
+  if (next.isEmpty())
+  {
+    d_conflict = deps;
+    for (unsigned side = 0; side < 2; side++)
+    {
+      d_conflict.insert(var.d_deps[side].begin(), var.d_deps[side].end());
+    }
+    return false;
+  }
+  // only take steps that are large enough, so that the propagation does not
+  // creep towards a limit
+  const Interval& cur = var.d_interval;
+  double width = cur.d_hi - cur.d_lo;
+  bool isChanged = false;
+  if (next.d_lo > cur.d_lo
+      && (std::isinf(cur.d_lo)
+          || next.d_lo - cur.d_lo > (std::isinf(width)
+                                         ? 1e-3 * (std::fabs(cur.d_lo) + 1)
+                                         : 1e-2 * width)))
+  {
+    var.d_interval.d_lo = next.d_lo;
+    var.d_deps[0] = deps;
+    var.d_derived[0] = derived;
+    isChanged = true;
+  }
+  if (next.d_hi < cur.d_hi
+      && (std::isinf(cur.d_hi)
+          || cur.d_hi - next.d_hi > (std::isinf(width)
+                                         ? 1e-3 * (std::fabs(cur.d_hi) + 1)
+                                         : 1e-2 * width)))
+  {
+    var.d_interval.d_hi = next.d_hi;
+    var.d_deps[1] = deps;
+    var.d_derived[1] = derived;
+    isChanged = true;
+  }
+  if (isChanged)
+  {
+    Trace("nl-icp-debug") << "  " << var.d_node << " in ["
+                          << var.d_interval.d_lo << ", "
+                          << var.d_interval.d_hi << "]" << std::endl;
+    changed.push_back(v);
+  }
+  return true;
+}
+
+bool IcpSolver::contract(unsigned c, std::vector<unsigned>& changed)
+{
+  const Constraint& con = d_constraints[c];
+  size_t n = con.d_terms.size();
+  bool direct = n == 1 && con.d_terms[0].second.size() == 1
+                && con.d_terms[0].second[0].second == 1;
+  // the bounds follow from this literal and the bounds of its variables
+  std::set<unsigned> deps;
+  deps.insert(c);
+  bool derived = con.d_nonlinear;
+  if (!direct)
+  {
+    for (const std::pair<Interval, Monomial>& t : con.d_terms)
+    {
+      for (const std::pair<unsigned, unsigned>& p : t.second)
+      {
+        const Variable& var = d_vars[p.first];
+        for (unsigned side = 0; side < 2; side++)
+        {
+          deps.insert(var.d_deps[side].begin(), var.d_deps[side].end());
+          derived = derived || var.d_derived[side];
+        }
+      }
+    }
+  }
+
+  std::vector<Interval> terms(n);
+  for (size_t i = 0; i < n; i++)
+  {
+    const Monomial& m = con.d_terms[i].second;
+    terms[i] = mul(con.d_terms[i].first, evaluate(m, m.size()));
+  }
+  // the sums of the terms before and after each term
+  std::vector<Interval> prefix(n + 1), suffix(n + 1);
+  prefix[0] = Interval(0, 0);
+  suffix[n] = Interval(0, 0);
+  for (size_t i = 0; i < n; i++)
+  {
+    prefix[i + 1] = add(prefix[i], terms[i]);
+    suffix[n - i - 1] = add(terms[n - i - 1], suffix[n - i]);
+  }
+  if (intersect(prefix[n], con.d_rhs).isEmpty())
+  {
+    d_conflict = deps;
+    return false;
+  }
+
+  for (size_t i = 0; i < n; i++)
+  {
+    const Interval& coeff = con.d_terms[i].first;
+    const Monomial& m = con.d_terms[i].second;
+    Interval t = intersect(
+        terms[i], sub(con.d_rhs, add(prefix[i], suffix[i + 1])));
+    if (t.isEmpty())
+    {
+      d_conflict = deps;
+      return false;
+    }
+    if (coeff.containsZero())
+    {
+      continue;
+    }
+    Interval mi = div(t, coeff);
+    for (size_t j = 0, size = m.size(); j < size; j++)
+    {
+      Interval rest = evaluate(m, j);
+      if (rest.containsZero())
+      {
+        continue;
+      }
+      unsigned v = m[j].first;
+      Interval x =
+          rootInterval(div(mi, rest), m[j].second, d_vars[v].d_interval);
+      if (!narrow(v, x, deps, derived, direct, changed))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool IcpSolver::contractFunction(unsigned f, std::vector<unsigned>& changed)
+{
+  const Function& fn = d_functions[f];
+  if (fn.d_kind == SINE)
+  {
+    return narrow(
+        fn.d_app, Interval(-1, 1), std::set<unsigned>(), false, false, changed);
+  }
+  Assert(fn.d_kind == EXPONENTIAL);
+  // exp( arg ) is in [ exp( lo ), exp( hi ) ]
+  std::set<unsigned> deps = d_vars[fn.d_arg].d_deps[0];
+  deps.insert(d_vars[fn.d_arg].d_deps[1].begin(),
+              d_vars[fn.d_arg].d_deps[1].end());
+  Interval a = d_vars[fn.d_arg].d_interval;
+  Interval e(std::max(downApprox(std::exp(a.d_lo)), 0.0),
+             upApprox(std::exp(a.d_hi)));
+  if (!narrow(fn.d_app, e, deps, true, false, changed))
+  {
+    return false;
+  }
+  // arg is in [ log( lo ), log( hi ) ]
+  deps = d_vars[fn.d_app].d_deps[0];
+  deps.insert(d_vars[fn.d_app].d_deps[1].begin(),
+              d_vars[fn.d_app].d_deps[1].end());
+  Interval y = d_vars[fn.d_app].d_interval;
+  Interval l(y.d_lo <= 0 ? -s_inf : downApprox(std::log(y.d_lo)),
+             y.d_hi <= 0 ? -s_inf : upApprox(std::log(y.d_hi)));
+  if (y.d_hi <= 0)
+  {
+    l = Interval(1, 0);
+  }
+  return narrow(fn.d_arg, l, deps, true, false, changed);
+}
+
+void IcpSolver::addPremises(const std::set<unsigned>& deps,
+                            std::vector<Node>& disj) const
+{
+  for (unsigned c : deps)
+  {
+    disj.push_back(d_constraints[c].d_lit.negate());
+  }
+}
+
+bool IcpSolver::check(const std::vector<Node>& assertions,
+                      std::vector<Node>& lemmas,
+                      unsigned rounds)
+{
+  d_vars.clear();
+  d_varIndex.clear();
+  d_constraints.clear();
+  d_functions.clear();
+  d_conflict.clear();
+  for (const Node& lit : assertions)
+  {
+    addConstraint(lit);
+  }
+  Trace("nl-icp") << "ICP: " << d_constraints.size() << " literals over "
+                  << d_vars.size() << " variables" << std::endl;
+  NodeManager* nm = NodeManager::currentNM();
+
+  // constraints then functions, by index
+  unsigned nc = d_constraints.size();
+  unsigned total = nc + d_functions.size();
+  std::deque<unsigned> queue;
+  std::vector<bool> queued(total, true);
+  for (unsigned i = 0; i < total; i++)
+  {
+    queue.push_back(i);
+  }
+  std::vector<unsigned> changed;
+  for (unsigned budget = rounds * total; budget > 0 && !queue.empty();
+       budget--)
+  {
+    unsigned item = queue.front();
+    queue.pop_front();
+    queued[item] = false;
+    changed.clear();
+    bool ok =
+        item < nc ? contract(item, changed) : contractFunction(item - nc, changed);
+    if (!ok)
+    {
+      std::vector<Node> disj;
+      addPremises(d_conflict, disj);
+      if (disj.empty())
+      {
+        return false;
+      }
+      Node lem = disj.size() == 1 ? disj[0] : nm->mkNode(OR, disj);
+      Trace("nl-icp") << "ICP conflict : " << lem << std::endl;
+      lemmas.push_back(lem);
+      return true;
+    }
+    for (unsigned v : changed)
+    {
+      for (unsigned c : d_vars[v].d_constraints)
+      {
+        if (!queued[c])
+        {
+          queued[c] = true;
+          queue.push_back(c);
+        }
+      }
+      for (unsigned f : d_vars[v].d_functions)
+      {
+        if (!queued[nc + f])
+        {
+          queued[nc + f] = true;
+          queue.push_back(nc + f);
+        }
+      }
+    }
+  }
+
+  // the bounds that are tighter than the ones of the literals on a single
+  // variable, and follow from a non-linear literal
+  for (const Variable& var : d_vars)
+  {
+    for (unsigned side = 0; side < 2; side++)
+    {
+      if (!var.d_derived[side] || var.d_deps[side].empty())
+      {
+        continue;
+      }
+      double b = side == 0 ? var.d_interval.d_lo : var.d_interval.d_hi;
+      if (std::isinf(b)
+          || (side == 0 ? b <= var.d_direct.d_lo : b >= var.d_direct.d_hi))
+      {
+        continue;
+      }
+      Node bound = nm->mkNode(side == 0 ? GEQ : LEQ,
+                              var.d_node,
+                              nm->mkConst(toRational(b, side == 1)));
+      std::vector<Node> disj;
+      addPremises(var.d_deps[side], disj);
+      disj.push_back(bound);
+      Node lem = nm->mkNode(OR, disj);
+      Trace("nl-icp") << "ICP bound : " << lem << std::endl;
+      lemmas.push_back(lem);
+    }
+  }
+  return false;
+}
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace CVC4
@@ -0,0 +1,146 @@
+/*********************                                                        */
+/*! \file nl_icp.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Interval constraint propagation for the non-linear extension class
+ **/
+
+#ifndef CVC4__THEORY__ARITH__NL_ICP_H
+#define CVC4__THEORY__ARITH__NL_ICP_H
+
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "expr/kind.h"
+#include "expr/node.h"
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+/** Interval constraint propagation
+ *
+ * This class contracts the intervals of the variables of a set of arithmetic
+ * literals of the form ( sum_i c_i * m_i ) <k> c, where each m_i is a product
+ * of variables, by propagating the intervals through each literal in turn
+ * until a fixed point or a budget is reached.  The applications of
+ * exponential and sine are variables whose intervals are further related to
+ * those of their arguments.
+ *
+ * Intervals have double bounds rounded outwards, so that an empty interval
+ * is a proof that the literals are unsatisfiable.  Strict inequalities are
+ * treated as non-strict ones and disequalities are ignored.  Each bound
+ * records the literals it was derived from, which gives the conflict lemma
+ * and the premises of the bound lemmas.
+ */
+class IcpSolver
+{
+ public:
+  /** A closed interval, empty if d_lo > d_hi */
+  struct Interval
+  {
+    Interval();
+    Interval(double lo, double hi);
+    bool isEmpty() const { return d_lo > d_hi; }
+    bool containsZero() const { return d_lo <= 0 && 0 <= d_hi; }
+    double d_lo;
+    double d_hi;
+  };
+
+  IcpSolver();
+
+  /** check
+   *
+   * Propagates the intervals of the variables of assertions.  If the
+   * interval of a variable becomes empty, this method adds a conflict lemma
+   * to lemmas and returns true.  Otherwise, it adds to lemmas the bounds
+   * derived through a non-linear literal that are tighter than the bounds
+   * asserted on the variables, and returns false.
+   */
+  bool check(const std::vector<Node>& assertions,
+             std::vector<Node>& lemmas,
+             unsigned rounds);
+
+ private:
+  /** A product of powers of variables, by variable index */
+  typedef std::vector<std::pair<unsigned, unsigned> > Monomial;
+  /** A literal sum_i d_terms[i].first * d_terms[i].second in d_rhs */
+  struct Constraint
+  {
+    Node d_lit;
+    std::vector<std::pair<Interval, Monomial> > d_terms;
+    Interval d_rhs;
+    bool d_nonlinear;
+  };
+  struct Variable
+  {
+    Node d_node;
+    Interval d_interval;
+    /** The interval given by the literals on this variable alone */
+    Interval d_direct;
+    /** The indices of the literals the lower and upper bounds depend on */
+    std::set<unsigned> d_deps[2];
+    /** Whether the lower and upper bounds were derived non-linearly */
+    bool d_derived[2];
+    /** The constraints and functions this variable occurs in */
+    std::vector<unsigned> d_constraints;
+    std::vector<unsigned> d_functions;
+  };
+  /** A variable d_app that is an application of d_kind to d_arg */
+  struct Function
+  {
+    Kind d_kind;
+    unsigned d_app;
+    unsigned d_arg;
+  };
+
+  /** Returns the index of the variable n, registering it if it is new. */
+  unsigned mkVariable(Node n);
+  /** Registers literal lit, returns false if it is not a sum of monomials. */
+  bool addConstraint(Node lit);
+  /** Returns the interval of m, skipping its factor at index skip. */
+  Interval evaluate(const Monomial& m, size_t skip) const;
+  /**
+   * Contracts the variables of constraint c, and adds the variables whose
+   * interval changed to changed.  Returns false if it found a conflict.
+   */
+  bool contract(unsigned c, std::vector<unsigned>& changed);
+  /** Same as above, for the function f. */
+  bool contractFunction(unsigned f, std::vector<unsigned>& changed);
+  /**
+   * Intersects the interval of variable v with i, where i follows from the
+   * literals deps.  Returns false if the intersection is empty, in which case
+   * d_conflict is set.
+   */
+  bool narrow(unsigned v,
+              const Interval& i,
+              const std::set<unsigned>& deps,
+              bool derived,
+              bool direct,
+              std::vector<unsigned>& changed);
+  /** Adds the negations of the literals deps to disj. */
+  void addPremises(const std::set<unsigned>& deps,
+                   std::vector<Node>& disj) const;
+
+  std::vector<Variable> d_vars;
+  std::unordered_map<Node, unsigned, NodeHashFunction> d_varIndex;
+  std::vector<Constraint> d_constraints;
+  std::vector<Function> d_functions;
+  /** The literals of the conflict, if there is one */
+  std::set<unsigned> d_conflict;
+}; /* class IcpSolver */
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__ARITH__NL_ICP_H */
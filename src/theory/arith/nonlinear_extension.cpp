@@ -185,6 +185,7 @@ NonlinearExtension::NonlinearExtension(TheoryArith& containing,
                                        eq::EqualityEngine* ee)
     : d_lemmas(containing.getUserContext()),
       d_zero_split(containing.getUserContext()),
+      d_refuted_points(containing.getUserContext()),
       d_containing(containing),
       d_ee(ee),
       d_needsLastCall(false),
@@ -591,6 +592,29 @@ unsigned NonlinearExtension::filterLemma(Node lem, std::vector<Node>& out)
   return 1;
 }
 
+void NonlinearExtension::addPointLemmas(Node point,
+                                        const std::vector<Node>& plemmas,
+                                        std::vector<Node>& lemmas)
+{
+  bool allSent = true;
+  for (const Node& lem : plemmas)
+  {
+    if (d_lemmas.find(Rewriter::rewrite(lem)) == d_lemmas.end())
+    {
+      allSent = false;
+      break;
+    }
+  }
+  if (allSent)
+  {
+    Trace("nl-ext-lemma-debug")
+        << "NonlinearExtension::refuted point : " << point << std::endl;
+    d_refuted_points.insert(point);
+    return;
+  }
+  lemmas.insert(lemmas.end(), plemmas.begin(), plemmas.end());
+}
+
 unsigned NonlinearExtension::filterLemmas(std::vector<Node>& lemmas,
                                           std::vector<Node>& out)
 {
@@ -806,6 +830,7 @@ bool NonlinearExtension::checkModel(const std::vector<Node>& assertions,
   // get model bounds for all transcendental functions
   Trace("nl-ext-cm") << "----- Get bounds for transcendental functions..."
                      << std::endl;
+  d_tf_approximated.clear();
   for (std::pair<const Kind, std::vector<Node> >& tfs : d_funcMap)
   {
     Kind k = tfs.first;
@@ -823,12 +848,14 @@ bool NonlinearExtension::checkModel(const std::vector<Node>& assertions,
       }
       else
       {
-        std::pair<Node, Node> bounds = getTfModelBounds(tf, d_taylor_degree);
+        std::pair<Node, Node> bounds =
+            getTfModelBounds(tf, getTfTaylorDegree(tf));
         bl = bounds.first;
         bu = bounds.second;
         if (bl != bu)
         {
           d_model.setUsedApproximate();
+          d_tf_approximated.push_back(tf);
         }
       }
       if (!bl.isNull() && !bu.isNull())
@@ -1383,6 +1410,45 @@ bool NonlinearExtension::modelBasedRefinement(
   // get the assertions that are false in the model
   const std::vector<Node> false_asserts = checkModelEval(assertions);
 
+  // contract the intervals of the variables before the linearization
+  if (options::nlIcp() && !false_asserts.empty())
+  {
+    std::vector<Node> lemmas;
+    d_icp.check(assertions, lemmas, options::nlIcpRounds());
+    filterLemmas(lemmas, mlems);
+    if (!mlems.empty())
+    {
+      Trace("nl-ext") << "  ...finished with " << mlems.size()
+                      << " interval lemmas." << std::endl;
+      return true;
+    }
+  }
+
+  // decide the polynomial literals exactly, by cylindrical sampling
+  if (options::nlCad() && !false_asserts.empty())
+  {
+    std::vector<Node> lemmas;
+    std::vector<std::pair<Node, Node> > cadModel;
+    if (d_cad.check(assertions, lemmas, cadModel, options::nlCadBudget()))
+    {
+      filterLemmas(lemmas, mlems);
+    }
+    // a model of the cylindrical sampling is a set of decisions
+    for (const std::pair<Node, Node>& vv : cadModel)
+    {
+      Node eq = Rewriter::rewrite(vv.first.eqNode(vv.second));
+      Node literal = d_containing.getValuation().ensureLiteral(eq);
+      d_containing.getOutputChannel().requirePhase(literal, true);
+      filterLemma(literal.orNode(literal.negate()), mlems);
+    }
+    if (!mlems.empty())
+    {
+      Trace("nl-ext") << "  ...finished with " << mlems.size()
+                      << " cylindrical sampling lemmas." << std::endl;
+      return true;
+    }
+  }
+
   // get the extended terms belonging to this theory
   std::vector<Node> xts;
   d_containing.getExtTheory()->getTerms(xts);
@@ -1543,12 +1609,23 @@ bool NonlinearExtension::modelBasedRefinement(
       // we are incomplete
       if (options::nlExtIncPrecision() && d_model.usedApproximate())
       {
-        d_taylor_degree++;
+        // only the applications whose bounds were approximate are refined,
+        // the bounds of the others are reused as they are
+        for (const Node& tf : d_tf_approximated)
+        {
+          d_tf_degree_inc[tf]++;
+          Trace("nl-ext") << "...increment Taylor degree of " << tf << " to "
+                          << getTfTaylorDegree(tf) << std::endl;
+        }
+        if (d_tf_approximated.empty())
+        {
+          d_taylor_degree++;
+          Trace("nl-ext") << "...increment Taylor degree to "
+                          << d_taylor_degree << std::endl;
+        }
         needsRecheck = true;
         // increase precision for PI?
         // Difficult since Taylor series is very slow to converge
-        Trace("nl-ext") << "...increment Taylor degree to " << d_taylor_degree
-                        << std::endl;
       }
       else
       {
@@ -2241,7 +2318,16 @@ std::vector<Node> NonlinearExtension::checkTangentPlanes() {
               for( unsigned p=0; p<pts[0].size(); p++ ){
                 Node a_v = pts[0][p];
                 Node b_v = pts[1][p];
-              
+                Node point = nm->mkNode(SEXPR, t, a, b, a_v, b_v);
+                if (d_refuted_points.find(point) != d_refuted_points.end())
+                {
+                  Trace("nl-ext-tplanes")
+                      << "  already refuted at " << a_v << ", " << b_v
+                      << std::endl;
+                  continue;
+                }
+                std::vector<Node> plemmas;
+
                 // tangent plane
                 Node tplane = nm->mkNode(MINUS,
                                          nm->mkNode(PLUS,
@@ -2255,7 +2341,7 @@ std::vector<Node> NonlinearExtension::checkTangentPlanes() {
                   Node tlem = nm->mkNode(OR, aa.negate(), ab.negate(), conc);
                   Trace("nl-ext-tplanes")
                       << "Tangent plane lemma : " << tlem << std::endl;
-                  lemmas.push_back(tlem);
+                  plemmas.push_back(tlem);
                 }
 
                 // tangent plane reverse implication
@@ -2278,13 +2364,13 @@ std::vector<Node> NonlinearExtension::checkTangentPlanes() {
                 Trace("nl-ext-tplanes")
                     << "Tangent plane lemma (reverse) : " << ub_reverse1
                     << std::endl;
-                lemmas.push_back(ub_reverse1);
+                plemmas.push_back(ub_reverse1);
                 Node ub_reverse2 =
                     nm->mkNode(OR, t_leq_tplane.negate(), b_geq_bv_or_a_geq_av);
                 Trace("nl-ext-tplanes")
                     << "Tangent plane lemma (reverse) : " << ub_reverse2
                     << std::endl;
-                lemmas.push_back(ub_reverse2);
+                plemmas.push_back(ub_reverse2);
 
                 // t >= tplane -> ( (a <= a_v ^ b <= b_v) v
                 // (a >= a_v ^ b >= b_v) ).
@@ -2299,13 +2385,14 @@ std::vector<Node> NonlinearExtension::checkTangentPlanes() {
                 Trace("nl-ext-tplanes")
                     << "Tangent plane lemma (reverse) : " << lb_reverse1
                     << std::endl;
-                lemmas.push_back(lb_reverse1);
+                plemmas.push_back(lb_reverse1);
                 Node lb_reverse2 =
                     nm->mkNode(OR, t_geq_tplane.negate(), a_geq_av_or_b_leq_bv);
                 Trace("nl-ext-tplanes")
                     << "Tangent plane lemma (reverse) : " << lb_reverse2
                     << std::endl;
-                lemmas.push_back(lb_reverse2);
+                plemmas.push_back(lb_reverse2);
+                addPointLemmas(point, plemmas, lemmas);
               }
             }
           }
@@ -3111,7 +3198,7 @@ std::vector<Node> NonlinearExtension::checkTranscendentalTangentPlanes(
       // tf is Figure 3 : tf( x )
       Trace("nl-ext-tftp") << "Compute tangent planes " << tf << std::endl;
       // go until max degree is reached, or we don't meet bound criteria
-      for (unsigned d = 1; d <= d_taylor_degree; d++)
+      for (unsigned d = 1, dmax = getTfTaylorDegree(tf); d <= dmax; d++)
       {
         Trace("nl-ext-tftp") << "- run at degree " << d << "..." << std::endl;
         unsigned prev = lemmas.size();
@@ -3820,6 +3907,20 @@ void NonlinearExtension::getPolynomialApproximationBoundForArg(
   Assert(c.isConst());
   if (k == EXPONENTIAL && c.getConst<Rational>().sgn() == 1)
   {
+    std::pair<unsigned, Node> key(d, c);
+    std::map<std::pair<unsigned, Node>, unsigned>::iterator itd =
+        d_poly_bound_degree.find(key);
+    if (itd != d_poly_bound_degree.end())
+    {
+      unsigned ds = itd->second;
+      if (ds > d)
+      {
+        std::vector<Node> pboundss;
+        getPolynomialApproximationBounds(k, ds, pboundss);
+        pbounds[2] = pboundss[2];
+      }
+      return;
+    }
     NodeManager* nm = NodeManager::currentNM();
     Node tft = nm->mkNode(k, d_zero);
     bool success = false;
@@ -3842,6 +3943,7 @@ void NonlinearExtension::getPolynomialApproximationBoundForArg(
         ds = ds + 1;
       }
     } while (!success);
+    d_poly_bound_degree[key] = ds;
     if (ds > d)
     {
       Trace("nl-ext-exp-taylor")
@@ -3855,6 +3957,13 @@ void NonlinearExtension::getPolynomialApproximationBoundForArg(
   }
 }
 
+unsigned NonlinearExtension::getTfTaylorDegree(Node tf) const
+{
+  std::unordered_map<Node, unsigned, NodeHashFunction>::const_iterator it =
+      d_tf_degree_inc.find(tf);
+  return d_taylor_degree + (it == d_tf_degree_inc.end() ? 0 : it->second);
+}
+
 std::pair<Node, Node> NonlinearExtension::getTfModelBounds(Node tf, unsigned d)
 {
   // compute the model value of the argument
@@ -3887,8 +3996,18 @@ std::pair<Node, Node> NonlinearExtension::getTfModelBounds(Node tf, unsigned d)
     if (!pab.isNull())
     {
       // { x -> tf[0] }
-      pab = pab.substitute(tfv, tfs);
-      pab = Rewriter::rewrite(pab);
+      std::pair<Node, Node> key(pab, tf[0]);
+      std::map<std::pair<Node, Node>, Node>::iterator it =
+          d_poly_bound_inst.find(key);
+      if (it == d_poly_bound_inst.end())
+      {
+        pab = Rewriter::rewrite(pab.substitute(tfv, tfs));
+        d_poly_bound_inst[key] = pab;
+      }
+      else
+      {
+        pab = it->second;
+      }
       Node v_pab = d_model.computeAbstractModelValue(pab);
       bounds.push_back(v_pab);
     }
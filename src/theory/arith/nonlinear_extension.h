@@ -35,6 +35,8 @@
 #include "expr/kind.h"
 #include "expr/node.h"
 #include "theory/arith/nl_lemma_utils.h"
+#include "theory/arith/nl_cad.h"
+#include "theory/arith/nl_icp.h"
 #include "theory/arith/nl_model.h"
 #include "theory/arith/theory_arith.h"
 #include "theory/uf/equality_engine.h"
@@ -402,6 +404,14 @@ class NonlinearExtension {
   unsigned filterLemmas(std::vector<Node>& lemmas, std::vector<Node>& out);
   /** singleton version of above */
   unsigned filterLemma(Node lem, std::vector<Node>& out);
+  /**
+   * Adds plemmas, the lemmas refining the model point point, to lemmas
+   * unless all of them were sent already.  In that case point is cached as
+   * refuted, and its lemmas are not constructed again.
+   */
+  void addPointLemmas(Node point,
+                      const std::vector<Node>& plemmas,
+                      std::vector<Node>& lemmas);
 
   /**
    * Send lemmas in out on the output channel of theory of arithmetic.
@@ -441,6 +451,12 @@ class NonlinearExtension {
   NodeSet d_lemmas;
   /** cache of terms t for which we have added the lemma ( t = 0 V t != 0 ). */
   NodeSet d_zero_split;
+  /**
+   * The model points all the refinement lemmas of which were sent, each the
+   * SEXPR of a monomial, its factors and their values
+   * (user-context-dependent).
+   */
+  NodeSet d_refuted_points;
 
   /** commonly used terms */
   Node d_zero;
@@ -488,6 +504,16 @@ class NonlinearExtension {
    * and for establishing when we are able to answer "SAT".
    */
   NlModel d_model;
+  /**
+   * Interval constraint propagation, which is run on the assertions before
+   * the lemmas of the incremental linearization if options::nlIcp() is true.
+   */
+  IcpSolver d_icp;
+  /**
+   * Exact cylindrical sampling, which is run on the assertions after the
+   * interval constraint propagation if options::nlCad() is true.
+   */
+  CadSolver d_cad;
   /**
    * The lemmas we computed during collectModelInfo. We store two vectors of
    * lemmas to be sent out on the output channel of TheoryArith. The first
@@ -631,6 +657,17 @@ class NonlinearExtension {
    * if the option options::nlExtTfIncPrecision() is enabled.
    */
   unsigned d_taylor_degree;
+  /**
+   * The increments of the Taylor degree over d_taylor_degree for individual
+   * (master) applications of transcendental functions. When the precision
+   * is incremented (options::nlExtIncPrecision()), only the applications
+   * whose bounds were approximate in the last call to checkModel, stored in
+   * d_tf_approximated, are incremented.
+   */
+  std::unordered_map<Node, unsigned, NodeHashFunction> d_tf_degree_inc;
+  std::vector<Node> d_tf_approximated;
+  /** get the Taylor degree of (master) application tf */
+  unsigned getTfTaylorDegree(Node tf) const;
   /** polynomial approximation bounds
    *
    * This adds P_l+[x], P_l-[x], P_u+[x], P_u-[x] to pbounds, where x is
@@ -661,6 +698,11 @@ class NonlinearExtension {
                                              std::vector<Node>& pbounds);
   /** cache of the above function */
   std::map<Kind, std::map<unsigned, std::vector<Node> > > d_poly_bounds;
+  /**
+   * Cache of the function above for positive arguments of exponential, the
+   * degree d' for each ( d, c )
+   */
+  std::map<std::pair<unsigned, Node>, unsigned> d_poly_bound_degree;
   /** get transcendental function model bounds
    *
    * This returns the current lower and upper bounds of transcendental
@@ -668,6 +710,11 @@ class NonlinearExtension {
    * on the model value of its argument.
    */
   std::pair<Node, Node> getTfModelBounds(Node tf, unsigned d);
+  /**
+   * Cache of the polynomial bounds of the function above, instantiated for
+   * the argument of tf, for each ( bound, argument )
+   */
+  std::map<std::pair<Node, Node>, Node> d_poly_bound_inst;
   /** get approximate sqrt
    *
    * This approximates the square root of positive constant c. If this method
@@ -165,6 +165,8 @@ void ArithVariables::VarInfo::initialize(ArithVar v, Node n, bool aux){
 void ArithVariables::VarInfo::uninitialize(){
   d_var = ARITHVAR_SENTINEL;
   d_node = Node::null();
+  // released variables are not integer variables to branch on
+  d_type = ArithType::Unset;
 }
 
 bool ArithVariables::VarInfo::setAssignment(const DeltaRational& a, BoundsInfo& prev){
@@ -54,6 +54,7 @@ public:
 
   typedef Matrix<Rational>::ColIterator ColIterator;
   typedef Matrix<Rational>::RowIterator RowIterator;
+  typedef Matrix<Rational>::CompressedIterator CompressedIterator;
   typedef BasicToRowMap::const_iterator BasicIterator;
 
   typedef MatrixEntry<Rational> Entry;
@@ -98,6 +99,22 @@ public:
     return ridRowIterator(basicToRowIndex(basic));
   }
 
+  /**
+   * Iterators over the compressed copies of the columns and rows, which are
+   * faster for read-only traversals.  They must not be used across pivots.
+   */
+  CompressedIterator compressedColIterator(ArithVar x) const {
+    return getCompressedColumn(x);
+  }
+
+  CompressedIterator compressedRidRowIterator(RowIndex rid) const {
+    return getCompressedRow(rid);
+  }
+
+  CompressedIterator compressedBasicRowIterator(ArithVar basic) const {
+    return compressedRidRowIterator(basicToRowIndex(basic));
+  }
+
   const Entry& basicFindEntry(ArithVar basic, ArithVar col) const {
     return findEntry(basicToRowIndex(basic), col);
   }
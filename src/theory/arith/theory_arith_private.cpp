@@ -19,8 +19,11 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <queue>
+#include <thread>
 #include <vector>
 
 #include "base/output.h"
@@ -96,6 +99,9 @@ TheoryArithPrivate::TheoryArithPrivate(TheoryArith& containing,
       d_unknownsInARow(0),
       d_hasDoneWorkSinceCut(false),
       d_learner(u),
+      d_userVariables(),
+      d_userVariablesCount(u, 0),
+      d_poppedVariables(),
       d_assertionsThatDoNotMatchTheirLiterals(c),
       d_nextIntegerCheckVar(0),
       d_constantIntegerVariables(c),
@@ -111,6 +117,7 @@ TheoryArithPrivate::TheoryArithPrivate(TheoryArith& containing,
               d_rowTracking,
               BasicVarModelUpdateCallBack(*this)),
       d_diosolver(c),
+      d_branchCutEngine(d_partialModel, d_tableau),
       d_restartsCounter(0),
       d_tableauSizeHasBeenModified(false),
       d_tableauResetDensity(1.6),
@@ -141,6 +148,7 @@ TheoryArithPrivate::TheoryArithPrivate(TheoryArith& containing,
       d_approxCuts(c),
       d_fullCheckCounter(0),
       d_cutCount(c, 0),
+      d_gomoryRounds(c, 0),
       d_cutInContext(c),
       d_likelyIntegerInfeasible(c, false),
       d_guessedCoeffSet(c, false),
@@ -337,6 +345,7 @@ TheoryArithPrivate::Statistics::Statistics()
   , d_statAssertLowerConflicts("theory::arith::AssertLowerConflicts", 0)
   , d_statUserVariables("theory::arith::UserVariables", 0)
   , d_statAuxiliaryVariables("theory::arith::AuxiliaryVariables", 0)
+  , d_statCollectedVariables("theory::arith::CollectedVariables", 0)
   , d_statDisequalitySplits("theory::arith::DisequalitySplits", 0)
   , d_statDisequalityConflicts("theory::arith::DisequalityConflicts", 0)
   , d_simplifyTimer("theory::arith::simplifyTimer")
@@ -385,6 +394,11 @@ TheoryArithPrivate::Statistics::Statistics()
   , d_relaxLinInfeasFailures("theory::arith::z::arith::relax::infeasible::failures",0)
   , d_relaxLinExhausted("theory::arith::z::arith::relax::exhausted",0)
   , d_relaxOthers("theory::arith::z::arith::relax::other",0)
+  , d_fpSimplexCalls("theory::arith::fpSimplex::calls",0)
+  , d_fpSimplexResolved("theory::arith::fpSimplex::resolved",0)
+  , d_fpSimplexTimer("theory::arith::fpSimplex::timer")
+  , d_boundsRepairUpdates("theory::arith::boundsRepair::updates", 0)
+  , d_boundsRepairResolved("theory::arith::boundsRepair::resolved", 0)
   , d_applyRowsDeleted("theory::arith::z::arith::cuts::applyRowsDeleted",0)
   , d_replaySimplexTimer("theory::arith::z::approx::replay::simplex::timer")
   , d_replayLogTimer("theory::arith::z::approx::replay::log::timer")
@@ -412,6 +426,7 @@ TheoryArithPrivate::Statistics::Statistics()
 
   smtStatisticsRegistry()->registerStat(&d_statUserVariables);
   smtStatisticsRegistry()->registerStat(&d_statAuxiliaryVariables);
+  smtStatisticsRegistry()->registerStat(&d_statCollectedVariables);
   smtStatisticsRegistry()->registerStat(&d_statDisequalitySplits);
   smtStatisticsRegistry()->registerStat(&d_statDisequalityConflicts);
   smtStatisticsRegistry()->registerStat(&d_simplifyTimer);
@@ -472,6 +487,11 @@ TheoryArithPrivate::Statistics::Statistics()
   smtStatisticsRegistry()->registerStat(&d_relaxLinInfeasFailures);
   smtStatisticsRegistry()->registerStat(&d_relaxLinExhausted);
   smtStatisticsRegistry()->registerStat(&d_relaxOthers);
+  smtStatisticsRegistry()->registerStat(&d_fpSimplexCalls);
+  smtStatisticsRegistry()->registerStat(&d_fpSimplexResolved);
+  smtStatisticsRegistry()->registerStat(&d_fpSimplexTimer);
+  smtStatisticsRegistry()->registerStat(&d_boundsRepairUpdates);
+  smtStatisticsRegistry()->registerStat(&d_boundsRepairResolved);
 
   smtStatisticsRegistry()->registerStat(&d_applyRowsDeleted);
 
@@ -505,6 +525,7 @@ TheoryArithPrivate::Statistics::~Statistics(){
 
   smtStatisticsRegistry()->unregisterStat(&d_statUserVariables);
   smtStatisticsRegistry()->unregisterStat(&d_statAuxiliaryVariables);
+  smtStatisticsRegistry()->unregisterStat(&d_statCollectedVariables);
   smtStatisticsRegistry()->unregisterStat(&d_statDisequalitySplits);
   smtStatisticsRegistry()->unregisterStat(&d_statDisequalityConflicts);
   smtStatisticsRegistry()->unregisterStat(&d_simplifyTimer);
@@ -565,6 +586,11 @@ TheoryArithPrivate::Statistics::~Statistics(){
   smtStatisticsRegistry()->unregisterStat(&d_relaxLinInfeasFailures);
   smtStatisticsRegistry()->unregisterStat(&d_relaxLinExhausted);
   smtStatisticsRegistry()->unregisterStat(&d_relaxOthers);
+  smtStatisticsRegistry()->unregisterStat(&d_fpSimplexCalls);
+  smtStatisticsRegistry()->unregisterStat(&d_fpSimplexResolved);
+  smtStatisticsRegistry()->unregisterStat(&d_fpSimplexTimer);
+  smtStatisticsRegistry()->unregisterStat(&d_boundsRepairUpdates);
+  smtStatisticsRegistry()->unregisterStat(&d_boundsRepairResolved);
 
   smtStatisticsRegistry()->unregisterStat(&d_applyRowsDeleted);
 
@@ -1758,6 +1784,12 @@ ArithVar TheoryArithPrivate::requestArithVar(TNode x, bool aux, bool internal){
   }
   d_constraintDatabase.addVariable(varX);
 
+  if(!internal && options::arithCollectVariables()){
+    notePoppedVariables();
+    d_userVariables.push_back(varX);
+    d_userVariablesCount = d_userVariables.size();
+  }
+
   Debug("arith::arithvar") << "@" << getSatContext()->getLevel()
                            << " " << x << " |-> " << varX
                            << "(relaiming " << reclaim << ")" << endl;
@@ -2939,26 +2971,7 @@ std::vector<ConstraintCPVec> TheoryArithPrivate::replayLogRec(ApproximateSimplex
       ArithVar v = d_replayVariables.back();
       d_replayVariables.pop_back();
       Assert(d_partialModel.canBeReleased(v));
-      if(!d_tableau.isBasic(v)){
-        /* if it is not basic make it basic. */
-        ArithVar b = ARITHVAR_SENTINEL;
-        for(Tableau::ColIterator ci = d_tableau.colIterator(v); !ci.atEnd(); ++ci){
-          const Tableau::Entry& e = *ci;
-          b = d_tableau.rowIndexToBasic(e.getRowIndex());
-          break;
-        }
-        Assert(b != ARITHVAR_SENTINEL);
-        DeltaRational cp = d_partialModel.getAssignment(b);
-        if(d_partialModel.cmpAssignmentLowerBound(b) < 0){
-          cp = d_partialModel.getLowerBound(b);
-        }else if(d_partialModel.cmpAssignmentUpperBound(b) > 0){
-          cp = d_partialModel.getUpperBound(b);
-        }
-        d_linEq.pivotAndUpdate(b, v, cp);
-      }
-      Assert(d_tableau.isBasic(v));
-      d_linEq.stopTrackingRowIndex(d_tableau.basicToRowIndex(v));
-      d_tableau.removeBasicRow(v);
+      removeBasicRowOf(v);
 
       releaseArithVar(v);
       Debug("approx::vars") << "releasing " << v << endl;
@@ -2970,6 +2983,106 @@ std::vector<ConstraintCPVec> TheoryArithPrivate::replayLogRec(ApproximateSimplex
   return res;
 }
 
+void TheoryArithPrivate::removeBasicRowOf(ArithVar v){
+  if(!d_tableau.isBasic(v)){
+    /* if it is not basic make it basic. */
+    ArithVar b = ARITHVAR_SENTINEL;
+    for(Tableau::ColIterator ci = d_tableau.colIterator(v); !ci.atEnd(); ++ci){
+      const Tableau::Entry& e = *ci;
+      b = d_tableau.rowIndexToBasic(e.getRowIndex());
+      break;
+    }
+    Assert(b != ARITHVAR_SENTINEL);
+    DeltaRational cp = d_partialModel.getAssignment(b);
+    if(d_partialModel.cmpAssignmentLowerBound(b) < 0){
+      cp = d_partialModel.getLowerBound(b);
+    }else if(d_partialModel.cmpAssignmentUpperBound(b) > 0){
+      cp = d_partialModel.getUpperBound(b);
+    }
+    d_linEq.pivotAndUpdate(b, v, cp);
+  }
+  Assert(d_tableau.isBasic(v));
+  d_linEq.stopTrackingRowIndex(d_tableau.basicToRowIndex(v));
+  d_tableau.removeBasicRow(v);
+}
+
+void TheoryArithPrivate::notePoppedVariables(){
+  size_t kept = d_userVariablesCount;
+  if(d_userVariables.size() > kept){
+    d_poppedVariables.insert(d_poppedVariables.end(),
+                             d_userVariables.begin() + kept,
+                             d_userVariables.end());
+    d_userVariables.resize(kept);
+  }
+}
+
+void TheoryArithPrivate::collectPoppedVariables(){
+  notePoppedVariables();
+  if(d_poppedVariables.empty()){
+    return;
+  }
+
+  // the shared terms of the current context are still referred to
+  std::unordered_set<TNode, TNodeHashFunction> shared;
+  for(Theory::shared_terms_iterator i = d_containing.shared_terms_begin(),
+        i_end = d_containing.shared_terms_end(); i != i_end; ++i){
+    shared.insert(*i);
+  }
+
+  d_partialModel.stopQueueingBoundCounts();
+  UpdateTrackingCallback utcb(&d_linEq);
+  d_partialModel.processBoundsQueue(utcb);
+  d_linEq.startTrackingBoundCounts();
+
+  // the slacks are released before the variables of their rows, which were
+  // created before them
+  std::vector<ArithVar> kept;
+  std::vector<Node> literals;
+  while(!d_poppedVariables.empty()){
+    ArithVar v = d_poppedVariables.back();
+    d_poppedVariables.pop_back();
+    Node n = d_partialModel.asNode(v);
+
+    bool inUse = !d_partialModel.canBeReleased(v)
+                 || d_errorSet.inError(v)
+                 || shared.find(n) != shared.end()
+                 || !d_constraintDatabase.variableConstraintsAreGarbage(v);
+    if(!inUse && !isAuxiliaryVariable(v)){
+      // the variable is in the row of a slack that is kept
+      inUse = d_tableau.isBasic(v) || d_tableau.getColLength(v) > 0;
+    }
+    if(inUse){
+      kept.push_back(v);
+      continue;
+    }
+
+    if(isAuxiliaryVariable(v)){
+      removeBasicRowOf(v);
+    }
+    if(d_congruenceManager.isWatchedVariable(v)){
+      d_congruenceManager.removeWatchedPair(v);
+    }
+    literals.clear();
+    d_constraintDatabase.deleteVariableConstraints(v, literals);
+    for(const Node& lit : literals){
+      d_setupNodes.erase(lit);
+    }
+    d_setupNodes.erase(n);
+
+    Debug("arith::collect") << "collecting " << v << " " << n << endl;
+    releaseArithVar(v);
+    ++(d_statistics.d_statCollectedVariables);
+  }
+
+  d_linEq.stopTrackingBoundCounts();
+  d_partialModel.startQueueingBoundCounts();
+  d_partialModel.attemptToReclaimReleased();
+
+  // the variables still in use now belong to the current user context
+  d_userVariables.insert(d_userVariables.end(), kept.rbegin(), kept.rend());
+  d_userVariablesCount = d_userVariables.size();
+}
+
 TreeLog& TheoryArithPrivate::getTreeLog(){
   if(d_treeLog == NULL){
     d_treeLog = new TreeLog();
@@ -3344,8 +3457,47 @@ bool TheoryArithPrivate::solveRealRelaxation(Theory::Effort effortLevel){
     << " " << safeToCallApprox()
     << endl;
   
+  if (options::arithBoundsRepair()
+      && (d_errorSet.moreSignals() || !d_errorSet.errorEmpty())
+      && repairBoundsWithoutPivots())
+  {
+    // the simplex below only processes the signals of the repaired variables
+    ++d_statistics.d_boundsRepairResolved;
+  }
+
+  bool fpResolved = false;
+  if (options::arithFpSimplex() && Theory::fullEffort(effortLevel)
+      && (d_errorSet.moreSignals() || !d_errorSet.errorEmpty())
+      && safeToCallApprox())
+  {
+    // pass0: find a candidate basis with doubles, confirm or repair it
+    // exactly in importSolution()
+    static const int32_t fpPivotLimit = 10000;
+    TimerStat::CodeTimer codeTimer1(d_statistics.d_fpSimplexTimer);
+    ++d_statistics.d_fpSimplexCalls;
+    std::unique_ptr<ApproximateSimplex> fpSolver(
+        ApproximateSimplex::mkDoubleSimplexSolver(
+            d_partialModel, getTreeLog(), getApproxStats()));
+    fpSolver->setPivotLimit(fpPivotLimit);
+    LinResult fpRes = fpSolver->solveRelaxation();
+    Debug("TheoryArithPrivate::solveRealRelaxation")
+        << "solveRealRelaxation() fp simplex " << fpRes << endl;
+    if (fpRes == LinFeasible || fpRes == LinInfeasible)
+    {
+      importSolution(fpSolver->extractRelaxation());
+      fpResolved = d_qflraStatus != Result::SAT_UNKNOWN;
+      if (fpResolved)
+      {
+        ++d_statistics.d_fpSimplexResolved;
+      }
+    }
+  }
+
   bool noPivotLimitPass1 = noPivotLimit && !useApprox;
-  d_qflraStatus = simplex.findModel(noPivotLimitPass1);
+  if (!fpResolved)
+  {
+    d_qflraStatus = simplex.findModel(noPivotLimitPass1);
+  }
 
   Debug("TheoryArithPrivate::solveRealRelaxation")
     << "solveRealRelaxation()" << " pass1 " << d_qflraStatus << endl;
@@ -3574,6 +3726,67 @@ bool TheoryArithPrivate::hasFreshArithLiteral(Node n) const{
   }
 }
 
+bool TheoryArithPrivate::repairBoundsWithoutPivots()
+{
+  // the updates signal variables, copy the candidates first
+  ArithVarVec candidates;
+  for (ErrorSet::error_iterator ei = d_errorSet.errorBegin(),
+                                ei_end = d_errorSet.errorEnd();
+       ei != ei_end;
+       ++ei)
+  {
+    candidates.push_back(*ei);
+  }
+  candidates.insert(
+      candidates.end(), d_errorSet.signalBegin(), d_errorSet.signalEnd());
+
+  bool repaired = true;
+  for (ArithVar basic : candidates)
+  {
+    if (!d_tableau.isBasic(basic)
+        || d_partialModel.assignmentIsConsistent(basic))
+    {
+      continue;
+    }
+    bool below = d_partialModel.cmpAssignmentLowerBound(basic) < 0;
+    for (Tableau::RowIterator iter = d_tableau.basicRowIterator(basic);
+         !iter.atEnd() && !d_partialModel.assignmentIsConsistent(basic);
+         ++iter)
+    {
+      const Tableau::Entry& entry = *iter;
+      ArithVar nb = entry.getColVar();
+      if (nb == basic || d_tableau.getColLength(nb) != 1)
+      {
+        continue;
+      }
+      // basic changes by the coefficient times the change of nb
+      const DeltaRational& beta = d_partialModel.getAssignment(basic);
+      DeltaRational diff = below ? d_partialModel.getLowerBound(basic) - beta
+                                 : d_partialModel.getUpperBound(basic) - beta;
+      DeltaRational value = d_partialModel.getAssignment(nb)
+                            + diff / entry.getCoefficient();
+      if (d_partialModel.strictlyGreaterThanUpperBound(nb, value))
+      {
+        value = d_partialModel.getUpperBound(nb);
+      }
+      else if (d_partialModel.strictlyLessThanLowerBound(nb, value))
+      {
+        value = d_partialModel.getLowerBound(nb);
+      }
+      if (value == d_partialModel.getAssignment(nb))
+      {
+        continue;
+      }
+      d_linEq.update(nb, value);
+      ++d_statistics.d_boundsRepairUpdates;
+    }
+    repaired = repaired && d_partialModel.assignmentIsConsistent(basic);
+  }
+  Debug("arith::boundsRepair")
+      << "repairBoundsWithoutPivots() " << repaired << endl;
+  return repaired;
+}
+
 void TheoryArithPrivate::check(Theory::Effort effortLevel){
   Assert(d_currentPropagationList.empty());
 
@@ -3851,6 +4064,11 @@ void TheoryArithPrivate::check(Theory::Effort effortLevel){
        << " fulleffort " << Theory::fullEffort(effortLevel)
        << " hasintmodel " << hasIntegerModel() << endl;
 
+  if(!emmittedConflictOrSplit && Theory::fullEffort(effortLevel)
+     && options::arithPseudoCost()){
+    d_branchCutEngine.observe();
+  }
+
   if(!emmittedConflictOrSplit && Theory::fullEffort(effortLevel) && !hasIntegerModel()){
     Node possibleConflict = Node::null();
     if(!emmittedConflictOrSplit && options::arithDioSolver()){
@@ -3877,6 +4095,15 @@ void TheoryArithPrivate::check(Theory::Effort effortLevel){
       }
     }
 
+    if(!emmittedConflictOrSplit && options::arithMipCuts()
+       && d_gomoryRounds < options::arithMipCutRounds()){
+      if(gomoryCutting()){
+        emmittedConflictOrSplit = true;
+        d_gomoryRounds = d_gomoryRounds + 1;
+        d_cutCount = d_cutCount + 1;
+      }
+    }
+
     if(!emmittedConflictOrSplit) {
       Node possibleLemma = roundRobinBranch();
       if(!possibleLemma.isNull()){
@@ -3992,6 +4219,13 @@ Node TheoryArithPrivate::roundRobinBranch(){
     return Node::null();
   }else{
     ArithVar v = d_nextIntegerCheckVar;
+    if(options::arithPseudoCost()){
+      ArithVar best = d_branchCutEngine.selectBranchVariable();
+      if(best != ARITHVAR_SENTINEL){
+        v = best;
+      }
+      d_branchCutEngine.notifyBranch(v);
+    }
 
     Assert(isInteger(v));
     Assert(!isAuxiliaryVariable(v));
@@ -4524,6 +4758,10 @@ void TheoryArithPrivate::presolve(){
     callCount = callCount + 1;
   }
 
+  if(options::arithCollectVariables()){
+    collectPoppedVariables();
+  }
+
   vector<Node> lemmas;
   if(!options::incrementalSolving()) {
     switch(options::arithUnateLemmaMode()){
@@ -4719,6 +4957,9 @@ void TheoryArithPrivate::propagateCandidates(){
   Debug("arith::prop") << "propagateCandidates end" << endl << endl << endl;
 }
 
+/** The minimum number of candidate rows scanned by each propagation thread */
+static const size_t s_minRowsPerPropThread = 64;
+
 void TheoryArithPrivate::propagateCandidatesNew(){
   /* Four criteria must be met for progagation on a variable to happen using a row:
    * 0: A new bound has to have been added to the row.
@@ -4747,6 +4988,11 @@ void TheoryArithPrivate::propagateCandidatesNew(){
     d_partialModel.processBoundsQueue(utcb);
   }
 
+  unsigned threads = options::arithPropThreads();
+  if (threads > 1 && d_candidateRows.size() >= 2 * s_minRowsPerPropThread)
+  {
+    propagateCandidateRowsInParallel(threads);
+  }
   while(!d_candidateRows.empty()){
     RowIndex candidate = d_candidateRows.back();
     d_candidateRows.pop_back();
@@ -4755,6 +5001,84 @@ void TheoryArithPrivate::propagateCandidatesNew(){
   Debug("arith::prop") << "propagateCandidatesNew end" << endl << endl << endl;
 }
 
+void TheoryArithPrivate::propagateCandidateRowsInParallel(unsigned threads)
+{
+  // The rows are taken in the order of the serial loop, which also decides
+  // which long rows are skipped, so that the random choices are the same.
+  std::vector<RowIndex> rows;
+  while (!d_candidateRows.empty())
+  {
+    RowIndex ridx = d_candidateRows.back();
+    d_candidateRows.pop_back();
+    uint32_t rowLength = d_tableau.getRowLength(ridx);
+    if (rowLength >= options::arithPropagateMaxLength()
+        && Random::getRandom().pickWithProb(
+               1.0 - double(options::arithPropagateMaxLength()) / rowLength))
+    {
+      continue;
+    }
+    // builds the compressed copy of the row, which the workers only read
+    d_tableau.compressedRidRowIterator(ridx);
+    rows.push_back(ridx);
+  }
+
+  // Scan the rows.  Nothing modifies the tableau, the partial model or the
+  // constraint database until the workers are joined.
+  std::vector<std::vector<RowPropagation> > props(rows.size());
+  std::atomic<size_t> next(0);
+  auto work = [this, &rows, &props, &next]() {
+    for (size_t i = next++; i < rows.size(); i = next++)
+    {
+      collectRowPropagations(rows[i], props[i]);
+    }
+  };
+  size_t n = std::min<size_t>(threads, rows.size() / s_minRowsPerPropThread);
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < n; ++i)
+  {
+    workers.emplace_back(work);
+  }
+  work();
+  for (std::thread& worker : workers)
+  {
+    worker.join();
+  }
+
+  // Propagate in order.  An earlier propagation may have given the
+  // strongest bound on a variable a proof, which the serial loop would have
+  // seen before computing the bound, so propagateMightSucceed is checked
+  // again.
+  for (const std::vector<RowPropagation>& rowProps : props)
+  {
+    for (const RowPropagation& p : rowProps)
+    {
+      if (propagateMightSucceed(p.d_var, p.d_varUb))
+      {
+        tryToPropagate(p.d_ridx, p.d_rowUp, p.d_var, p.d_varUb, p.d_bound);
+      }
+    }
+  }
+}
+
+void TheoryArithPrivate::collectRowPropagations(
+    RowIndex ridx, std::vector<RowPropagation>& out) const
+{
+  BoundCounts hasCount = d_linEq.hasBoundCount(ridx);
+  uint32_t rowLength = d_tableau.getRowLength(ridx);
+
+  if(hasCount.lowerBoundCount() == rowLength){
+    collectFull(ridx, false, out);
+  }else if(hasCount.lowerBoundCount() + 1 == rowLength){
+    collectSingleton(ridx, false, out);
+  }
+
+  if(hasCount.upperBoundCount() == rowLength){
+    collectFull(ridx, true, out);
+  }else if(hasCount.upperBoundCount() + 1 == rowLength){
+    collectSingleton(ridx, true, out);
+  }
+}
+
 bool TheoryArithPrivate::propagateMightSucceed(ArithVar v, bool ub) const{
   int cmp = ub ? d_partialModel.cmpAssignmentUpperBound(v)
     : d_partialModel.cmpAssignmentLowerBound(v);
@@ -4783,8 +5107,21 @@ bool TheoryArithPrivate::propagateMightSucceed(ArithVar v, bool ub) const{
 }
 
 bool TheoryArithPrivate::attemptSingleton(RowIndex ridx, bool rowUp){
-  Debug("arith::prop") << "  attemptSingleton" << ridx;
+  Debug("arith::prop") << "  attemptSingleton" << ridx << endl;
 
+  std::vector<RowPropagation> props;
+  collectSingleton(ridx, rowUp, props);
+  bool any = false;
+  for (const RowPropagation& p : props)
+  {
+    any |= tryToPropagate(ridx, rowUp, p.d_var, p.d_varUb, p.d_bound);
+  }
+  return any;
+}
+
+void TheoryArithPrivate::collectSingleton(
+    RowIndex ridx, bool rowUp, std::vector<RowPropagation>& out) const
+{
   const Tableau::Entry* ep;
   ep = d_linEq.rowLacksBound(ridx, rowUp, ARITHVAR_SENTINEL);
   Assert(ep != NULL);
@@ -4803,23 +5140,35 @@ bool TheoryArithPrivate::attemptSingleton(RowIndex ridx, bool rowUp){
   // if c < 0, v \geq -D/c so !vUp
   bool vUp = (rowUp == ( coeff.sgn() < 0));
 
-  Debug("arith::prop") << "  " << rowUp << " " << v << " " << coeff << " " << vUp << endl;
-  Debug("arith::prop") << "  " << propagateMightSucceed(v, vUp) << endl;
-
   if(propagateMightSucceed(v, vUp)){
     DeltaRational dr = d_linEq.computeRowBound(ridx, rowUp, v);
     DeltaRational bound = dr / (- coeff);
-    return tryToPropagate(ridx, rowUp, v, vUp, bound);
+    out.push_back(RowPropagation{ridx, rowUp, v, vUp, bound});
   }
-  return false;
 }
 
 bool TheoryArithPrivate::attemptFull(RowIndex ridx, bool rowUp){
   Debug("arith::prop") << "  attemptFull" << ridx << endl;
 
+  std::vector<RowPropagation> props;
+  collectFull(ridx, rowUp, props);
+  bool any = false;
+  for (const RowPropagation& p : props)
+  {
+    bool success = tryToPropagate(ridx, rowUp, p.d_var, p.d_varUb, p.d_bound);
+    any |= success;
+  }
+  return any;
+}
+
+void TheoryArithPrivate::collectFull(RowIndex ridx,
+                                     bool rowUp,
+                                     std::vector<RowPropagation>& out) const
+{
   vector<const Tableau::Entry*> candidates;
 
-  for(Tableau::RowIterator i = d_tableau.ridRowIterator(ridx); !i.atEnd(); ++i){
+  for(Tableau::CompressedIterator i = d_tableau.compressedRidRowIterator(ridx);
+      !i.atEnd(); ++i){
     const Tableau::Entry& e =*i;
     const Rational& c = e.getCoefficient();
     ArithVar v = e.getColVar();
@@ -4828,18 +5177,17 @@ bool TheoryArithPrivate::attemptFull(RowIndex ridx, bool rowUp){
       candidates.push_back(&e);
     }
   }
-  if(candidates.empty()){ return false; }
+  if(candidates.empty()){ return; }
 
   const DeltaRational slack =
     d_linEq.computeRowBound(ridx, rowUp, ARITHVAR_SENTINEL);
-  bool any = false;
   vector<const Tableau::Entry*>::const_iterator i, iend;
   for(i = candidates.begin(), iend = candidates.end(); i != iend; ++i){
     const Tableau::Entry* ep = *i;
     const Rational& c = ep->getCoefficient();
     ArithVar v = ep->getColVar();
 
-    // See the comment for attemptSingleton()
+    // See the comment for collectSingleton()
     bool activeUp = (rowUp == (c.sgn() > 0));
     bool vUb = (rowUp == (c.sgn() < 0));
 
@@ -4850,10 +5198,8 @@ bool TheoryArithPrivate::attemptFull(RowIndex ridx, bool rowUp){
     DeltaRational contribution = activeBound * c;
     DeltaRational impliedBound = (slack - contribution)/(-c);
 
-    bool success = tryToPropagate(ridx, rowUp, v, vUb, impliedBound);
-    any |= success;
+    out.push_back(RowPropagation{ridx, rowUp, v, vUb, impliedBound});
   }
-  return any;
 }
 
 bool TheoryArithPrivate::tryToPropagate(RowIndex ridx, bool rowUp, ArithVar v, bool vUb, const DeltaRational& bound){
@@ -4896,6 +5242,18 @@ Node flattenImplication(Node imp){
   return nb;
 }
 
+bool TheoryArithPrivate::gomoryCutting(){
+  std::vector<BranchCutEngine::Cut> cuts;
+  d_branchCutEngine.gomoryCuts(options::arithMipCutsPerCheck(), cuts);
+  for(const BranchCutEngine::Cut& cut : cuts){
+    Node explain = Constraint::externalExplainByAssertions(cut.d_explain);
+    Node lemma = flattenImplication(explain.impNode(cut.d_cut));
+    Debug("arith::lemma") << "gomory cut " << lemma << endl;
+    outputLemma(lemma);
+  }
+  return !cuts.empty();
+}
+
 bool TheoryArithPrivate::rowImplicationCanBeApplied(RowIndex ridx, bool rowUp, ConstraintP implied){
   Assert(implied != NullConstraint);
   ArithVar v = implied->getVariable();
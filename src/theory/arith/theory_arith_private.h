@@ -40,6 +40,7 @@
 #include "theory/arith/arith_utilities.h"
 #include "theory/arith/arithvar.h"
 #include "theory/arith/attempt_solution_simplex.h"
+#include "theory/arith/branch_cut_engine.h"
 #include "theory/arith/congruence_manager.h"
 #include "theory/arith/constraint.h"
 #include "theory/arith/constraint.h"
@@ -134,6 +135,29 @@ public:
   void releaseArithVar(ArithVar v);
   void signal(ArithVar v){ d_errorSet.signalVariable(v); }
 
+private:
+  /**
+   * The variables of the terms of the assertions, in the order they were
+   * created in, and the number of them that were created in user contexts
+   * that are not popped (user-context-dependent).  The variables past
+   * d_userVariablesCount are moved to d_poppedVariables.
+   */
+  std::vector<ArithVar> d_userVariables;
+  context::CDO<size_t> d_userVariablesCount;
+  std::vector<ArithVar> d_poppedVariables;
+
+  /** Moves the variables of the popped user contexts to d_poppedVariables. */
+  void notePoppedVariables();
+  /**
+   * Releases the variables of the popped user contexts that nothing refers
+   * to anymore, with their constraints, so that their ids are reused.
+   */
+  void collectPoppedVariables();
+  /** Makes v basic if it is not, and removes its row from the tableau. */
+  void removeBasicRowOf(ArithVar v);
+
+public:
+
 
 private:
   // t does not contain constants
@@ -239,6 +263,12 @@ private:
   Node callDioSolver();
   Node dioCutting();
 
+  /**
+   * Outputs the Gomory cuts of the current tableau as lemmas, at most
+   * options::arithMipCutsPerCheck() of them.  Returns true if it output any.
+   */
+  bool gomoryCutting();
+
   Comparison mkIntegerEqualityFromAssignment(ArithVar v);
 
   /**
@@ -291,6 +321,12 @@ private:
    */
   DioSolver d_diosolver;
 
+  /**
+   * Gomory cuts and pseudo-cost branching over the tableau.  Accesses the
+   * tableau and partial model (each in a read-only fashion).
+   */
+  BranchCutEngine d_branchCutEngine;
+
   /** Counts the number of notifyRestart() calls to the theory. */
   uint32_t d_restartsCounter;
 
@@ -379,6 +415,15 @@ private:
 
   bool solveRealRelaxation(Theory::Effort effortLevel);
 
+  /**
+   * Moves the basic variables out of their bounds into them with the nonbasic
+   * variables of their rows that occur in no other row.  These updates stay
+   * within the bounds of the nonbasic variables and do not change the other
+   * basic variables, so they need no pivot.  Returns true if the basic
+   * variables out of their bounds are all repaired.
+   */
+  bool repairBoundsWithoutPivots();
+
   /* Returns true if this is heuristically a good time to try
    * to solve the integers.
    */
@@ -573,14 +618,42 @@ private:
 
   void revertOutOfConflict();
 
+  /** A bound on d_var implied by the row d_ridx. */
+  struct RowPropagation
+  {
+    RowIndex d_ridx;
+    bool d_rowUp;
+    ArithVar d_var;
+    bool d_varUb;
+    DeltaRational d_bound;
+  };
+
   void propagateCandidatesNew();
+  /**
+   * Scans the candidate rows for implied bounds on up to threads threads,
+   * and then tries to propagate the bounds in the order of the rows.
+   */
+  void propagateCandidateRowsInParallel(unsigned threads);
   void dumpUpdatedBoundsToRows();
   bool propagateCandidateRow(RowIndex rid);
+  /**
+   * Adds the bounds that might be propagated using the row ridx to out.
+   * This only reads the tableau, the partial model and the constraint
+   * database, so that rows can be scanned concurrently.
+   */
+  void collectRowPropagations(RowIndex ridx,
+                              std::vector<RowPropagation>& out) const;
   bool propagateMightSucceed(ArithVar v, bool ub) const;
   /** Attempt to perform a row propagation where there is at most 1 possible variable.*/
   bool attemptSingleton(RowIndex ridx, bool rowUp);
+  void collectSingleton(RowIndex ridx,
+                        bool rowUp,
+                        std::vector<RowPropagation>& out) const;
   /** Attempt to perform a row propagation where every variable is a potential candidate.*/
   bool attemptFull(RowIndex ridx, bool rowUp);
+  void collectFull(RowIndex ridx,
+                   bool rowUp,
+                   std::vector<RowPropagation>& out) const;
   bool tryToPropagate(RowIndex ridx, bool rowUp, ArithVar v, bool vUp, const DeltaRational& bound);
   bool rowImplicationCanBeApplied(RowIndex ridx, bool rowUp, ConstraintP bestImplied);
   //void enqueueConstraints(std::vector<ConstraintCP>& out, Node n) const;
@@ -676,6 +749,8 @@ private:
   void branchVector(const std::vector<ArithVar>& lemmas);
 
   context::CDO<unsigned> d_cutCount;
+  /** The number of rounds of Gomory cuts in the context */
+  context::CDO<unsigned> d_gomoryRounds;
   context::CDHashSet<ArithVar, std::hash<ArithVar> > d_cutInContext;
 
   context::CDO<bool> d_likelyIntegerInfeasible;
@@ -732,6 +807,7 @@ private:
     IntStat d_statAssertUpperConflicts, d_statAssertLowerConflicts;
 
     IntStat d_statUserVariables, d_statAuxiliaryVariables;
+    IntStat d_statCollectedVariables;
     IntStat d_statDisequalitySplits;
     IntStat d_statDisequalityConflicts;
     TimerStat d_simplifyTimer;
@@ -789,6 +865,12 @@ private:
       d_relaxLinExhausted,
       d_relaxOthers;
 
+    IntStat d_fpSimplexCalls,
+      d_fpSimplexResolved;
+    TimerStat d_fpSimplexTimer;
+
+    IntStat d_boundsRepairUpdates, d_boundsRepairResolved;
+
     IntStat d_applyRowsDeleted;
     TimerStat d_replaySimplexTimer;
 
@@ -79,6 +79,8 @@ TheoryArrays::TheoryArrays(context::Context* c,
           name + "theory::arrays::number of setModelVal splits", 0),
       d_numSetModelValConflicts(
           name + "theory::arrays::number of setModelVal conflicts", 0),
+      d_numWeakEquivLemmas(
+          name + "theory::arrays::number of weak equivalence lemmas", 0),
       d_ppEqualityEngine(u, name + "theory::arrays::pp", true),
       d_ppFacts(u),
       //      d_ppCache(u),
@@ -125,6 +127,7 @@ TheoryArrays::TheoryArrays(context::Context* c,
   smtStatisticsRegistry()->registerStat(&d_numGetModelValConflicts);
   smtStatisticsRegistry()->registerStat(&d_numSetModelValSplits);
   smtStatisticsRegistry()->registerStat(&d_numSetModelValConflicts);
+  smtStatisticsRegistry()->registerStat(&d_numWeakEquivLemmas);
 
   d_true = NodeManager::currentNM()->mkConst<bool>(true);
   d_false = NodeManager::currentNM()->mkConst<bool>(false);
@@ -176,6 +179,7 @@ TheoryArrays::~TheoryArrays() {
   smtStatisticsRegistry()->unregisterStat(&d_numGetModelValConflicts);
   smtStatisticsRegistry()->unregisterStat(&d_numSetModelValSplits);
   smtStatisticsRegistry()->unregisterStat(&d_numSetModelValConflicts);
+  smtStatisticsRegistry()->unregisterStat(&d_numWeakEquivLemmas);
 }
 
 void TheoryArrays::setMasterEqualityEngine(eq::EqualityEngine* eq) {
@@ -487,12 +491,61 @@ void TheoryArrays::visitAllLeaves(TNode reason, vector<TNode>& conjunctions) {
   }
 }
 
-void TheoryArrays::weakEquivBuildCond(TNode node, TNode index, vector<TNode>& conjunctions) {
+TNode TheoryArrays::weakEquivGetMeet(TNode a, TNode b, TNode index)
+{
+  // the nodes of the path from a, as followed by weakEquivGetRepIndex
+  std::unordered_set<TNode, TNodeHashFunction> path;
+  TNode pointer, index2;
+  while (true)
+  {
+    path.insert(a);
+    pointer = d_infoMap.getWeakEquivPointer(a);
+    if (pointer.isNull())
+    {
+      break;
+    }
+    index2 = d_infoMap.getWeakEquivIndex(a);
+    if (index2.isNull() || !d_equalityEngine.areEqual(index, index2))
+    {
+      a = pointer;
+    }
+    else
+    {
+      TNode secondary = d_infoMap.getWeakEquivSecondary(a);
+      if (secondary.isNull())
+      {
+        break;
+      }
+      a = secondary;
+    }
+  }
+  // the first node of the path from b on the path from a
+  while (path.find(b) == path.end())
+  {
+    index2 = d_infoMap.getWeakEquivIndex(b);
+    if (index2.isNull() || !d_equalityEngine.areEqual(index, index2))
+    {
+      b = d_infoMap.getWeakEquivPointer(b);
+    }
+    else
+    {
+      b = d_infoMap.getWeakEquivSecondary(b);
+    }
+    Assert(!b.isNull());
+  }
+  return b;
+}
+
+void TheoryArrays::weakEquivBuildCond(TNode node,
+                                      TNode index,
+                                      vector<TNode>& conjunctions,
+                                      TNode stop)
+{
   Assert(!index.isNull());
   TNode pointer, index2;
   while (true) {
     pointer = d_infoMap.getWeakEquivPointer(node);
-    if (pointer.isNull()) {
+    if (pointer.isNull() || node == stop) {
       return;
     }
     index2 = d_infoMap.getWeakEquivIndex(node);
@@ -1464,6 +1517,9 @@ void TheoryArrays::check(Effort e) {
 #endif
 
     d_readTableContext->push();
+    // the lemmas of this round, one for each read that disagrees with a
+    // weakly equivalent one
+    std::unordered_set<Node, NodeHashFunction> lemmas;
     TNode mayRep, iRep;
     CTNodeList* bucketList = NULL;
     CTNodeList::const_iterator i = d_reads.begin(), readsEnd = d_reads.end();
@@ -1508,21 +1564,31 @@ void TheoryArrays::check(Effort e) {
           if (r[1] != r2[1]) {
             d_equalityEngine.explainEquality(r[1], r2[1], true, conjunctions);
           }
-          // TODO: get smaller lemmas by eliminating shared parts of path
-          weakEquivBuildCond(r[0], r[1], conjunctions);
-          weakEquivBuildCond(r2[0], r[1], conjunctions);
+          // the paths meet before the representative, the rest of them
+          // is shared and is not needed in the lemma
+          TNode meet = weakEquivGetMeet(r[0], r2[0], r[1]);
+          weakEquivBuildCond(r[0], r[1], conjunctions, meet);
+          weakEquivBuildCond(r2[0], r[1], conjunctions, meet);
           lemma = mkAnd(conjunctions, true);
-          // LSH FIXME: which kind of arrays lemma is this
-          Trace("arrays-lem") << "Arrays::addExtLemma " << lemma <<"\n";
-          d_out->lemma(lemma, RULE_INVALID, false, false, true);
-          d_readTableContext->pop();
-          Trace("arrays") << spaces(getSatContext()->getLevel()) << "Arrays::check(): done" << endl;
-          return;
+          if (lemmas.insert(lemma).second)
+          {
+            // LSH FIXME: which kind of arrays lemma is this
+            Trace("arrays-lem") << "Arrays::addExtLemma " << lemma << "\n";
+            d_out->lemma(lemma, RULE_INVALID, false, false, true);
+            ++d_numWeakEquivLemmas;
+          }
+          break;
         }
       }
       bucketList->push_back(r);
     }
     d_readTableContext->pop();
+    if (!lemmas.empty())
+    {
+      Trace("arrays") << spaces(getSatContext()->getLevel())
+                      << "Arrays::check(): done" << endl;
+      return;
+    }
   }
 
   if(!options::arraysEagerLemmas() && fullEffort(e) && !d_conflict && !options::arraysWeakEquivalence()) {
@@ -2179,96 +2245,111 @@ Node TheoryArrays::getNextDecisionRequest()
 bool TheoryArrays::dischargeLemmas()
 {
   bool lemmasAdded = false;
-  size_t sz = d_RowQueue.size();
-  for (unsigned count = 0; count < sz; ++count) {
-    RowLemmaType l = d_RowQueue.front();
-    d_RowQueue.pop();
-    if (d_RowAlreadyAdded.contains(l)) {
-      continue;
+  // In the first round, only the lemmas whose reads already exist are
+  // discharged, the other ones are queued again. They are discharged in the
+  // second round, if no lemma was added in the first one.
+  for (unsigned round = options::arraysLazyNewReads() ? 0 : 1; round < 2;
+       ++round) {
+    if (lemmasAdded) {
+      break;
     }
+    size_t sz = d_RowQueue.size();
+    for (unsigned count = 0; count < sz; ++count) {
+      RowLemmaType l = d_RowQueue.front();
+      d_RowQueue.pop();
+      if (d_RowAlreadyAdded.contains(l)) {
+        continue;
+      }
 
-    TNode a, b, i, j;
-    std::tie(a, b, i, j) = l;
-    Assert(a.getType().isArray() && b.getType().isArray());
+      TNode a, b, i, j;
+      std::tie(a, b, i, j) = l;
+      Assert(a.getType().isArray() && b.getType().isArray());
 
-    NodeManager* nm = NodeManager::currentNM();
-    Node aj = nm->mkNode(kind::SELECT, a, j);
-    Node bj = nm->mkNode(kind::SELECT, b, j);
-    bool ajExists = d_equalityEngine.hasTerm(aj);
-    bool bjExists = d_equalityEngine.hasTerm(bj);
-
-    // Check for redundant lemma
-    // TODO: more checks possible (i.e. check d_RowAlreadyAdded in context)
-    if (!d_equalityEngine.hasTerm(i) || !d_equalityEngine.hasTerm(j) || d_equalityEngine.areEqual(i,j) ||
-        !d_equalityEngine.hasTerm(a) || !d_equalityEngine.hasTerm(b) || d_equalityEngine.areEqual(a,b) ||
-        (ajExists && bjExists && d_equalityEngine.areEqual(aj,bj))) {
-      continue;
-    }
+      NodeManager* nm = NodeManager::currentNM();
+      Node aj = nm->mkNode(kind::SELECT, a, j);
+      Node bj = nm->mkNode(kind::SELECT, b, j);
+      bool ajExists = d_equalityEngine.hasTerm(aj);
+      bool bjExists = d_equalityEngine.hasTerm(bj);
+
+      // Check for redundant lemma
+      // TODO: more checks possible (i.e. check d_RowAlreadyAdded in context)
+      if (!d_equalityEngine.hasTerm(i) || !d_equalityEngine.hasTerm(j) || d_equalityEngine.areEqual(i,j) ||
+          !d_equalityEngine.hasTerm(a) || !d_equalityEngine.hasTerm(b) || d_equalityEngine.areEqual(a,b) ||
+          (ajExists && bjExists && d_equalityEngine.areEqual(aj,bj))) {
+        continue;
+      }
 
-    int prop = options::arraysPropagate();
-    if (prop > 0) {
-      propagate(l);
-      if (d_conflict) {
-        return true;
+      // Delay the lemmas that introduce new read terms
+      if (round == 0 && !(ajExists && bjExists)) {
+        d_RowQueue.push(l);
+        continue;
       }
-    }
 
-    // Make sure that any terms introduced by rewriting are appropriately stored in the equality database
-    Node aj2 = Rewriter::rewrite(aj);
-    if (aj != aj2) {
-      if (!ajExists) {
-        preRegisterTermInternal(aj);
+      int prop = options::arraysPropagate();
+      if (prop > 0) {
+        propagate(l);
+        if (d_conflict) {
+          return true;
+        }
       }
-      if (!d_equalityEngine.hasTerm(aj2)) {
-        preRegisterTermInternal(aj2);
+
+      // Make sure that any terms introduced by rewriting are appropriately stored in the equality database
+      Node aj2 = Rewriter::rewrite(aj);
+      if (aj != aj2) {
+        if (!ajExists) {
+          preRegisterTermInternal(aj);
+        }
+        if (!d_equalityEngine.hasTerm(aj2)) {
+          preRegisterTermInternal(aj2);
+        }
+        d_equalityEngine.assertEquality(aj.eqNode(aj2), true, d_true);
       }
-      d_equalityEngine.assertEquality(aj.eqNode(aj2), true, d_true);
-    }
-    Node bj2 = Rewriter::rewrite(bj);
-    if (bj != bj2) {
-      if (!bjExists) {
-        preRegisterTermInternal(bj);
+      Node bj2 = Rewriter::rewrite(bj);
+      if (bj != bj2) {
+        if (!bjExists) {
+          preRegisterTermInternal(bj);
+        }
+        if (!d_equalityEngine.hasTerm(bj2)) {
+          preRegisterTermInternal(bj2);
+        }
+        d_equalityEngine.assertEquality(bj.eqNode(bj2), true, d_true);
+
       }
-      if (!d_equalityEngine.hasTerm(bj2)) {
-        preRegisterTermInternal(bj2);
+      if (aj2 == bj2) {
+        continue;
       }
-      d_equalityEngine.assertEquality(bj.eqNode(bj2), true, d_true);
-
-    }
-    if (aj2 == bj2) {
-      continue;
-    }
 
-    // construct lemma
-    Node eq1 = aj2.eqNode(bj2);
-    Node eq1_r = Rewriter::rewrite(eq1);
-    if (eq1_r == d_true) {
-      if (!d_equalityEngine.hasTerm(aj2)) {
-        preRegisterTermInternal(aj2);
-      }
-      if (!d_equalityEngine.hasTerm(bj2)) {
-        preRegisterTermInternal(bj2);
+      // construct lemma
+      Node eq1 = aj2.eqNode(bj2);
+      Node eq1_r = Rewriter::rewrite(eq1);
+      if (eq1_r == d_true) {
+        if (!d_equalityEngine.hasTerm(aj2)) {
+          preRegisterTermInternal(aj2);
+        }
+        if (!d_equalityEngine.hasTerm(bj2)) {
+          preRegisterTermInternal(bj2);
+        }
+        d_equalityEngine.assertEquality(eq1, true, d_true);
+        continue;
       }
-      d_equalityEngine.assertEquality(eq1, true, d_true);
-      continue;
-    }
 
-    Node eq2 = i.eqNode(j);
-    Node eq2_r = Rewriter::rewrite(eq2);
-    if (eq2_r == d_true) {
-      d_equalityEngine.assertEquality(eq2, true, d_true);
-      continue;
-    }
+      Node eq2 = i.eqNode(j);
+      Node eq2_r = Rewriter::rewrite(eq2);
+      if (eq2_r == d_true) {
+        d_equalityEngine.assertEquality(eq2, true, d_true);
+        continue;
+      }
 
-    Node lem = nm->mkNode(kind::OR, eq2_r, eq1_r);
+      Node lem = nm->mkNode(kind::OR, eq2_r, eq1_r);
 
-    Trace("arrays-lem")<<"Arrays::addRowLemma adding "<<lem<<"\n";
-    d_RowAlreadyAdded.insert(l);
-    d_out->lemma(lem);
-    ++d_numRow;
-    lemmasAdded = true;
-    if (options::arraysReduceSharing()) {
-      return true;
+      Trace("arrays-lem")<<"Arrays::addRowLemma adding "<<lem<<"\n";
+      d_RowAlreadyAdded.insert(l);
+      d_out->lemma(lem);
+      ++d_numRow;
+      lemmasAdded = true;
+      if (options::arraysReduceSharing()) {
+        return true;
+      }
     }
   }
   return lemmasAdded;
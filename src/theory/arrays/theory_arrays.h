@@ -127,6 +127,8 @@ class TheoryArrays : public Theory {
   IntStat d_numSetModelValSplits;
   /** conflicts in setModelVal */
   IntStat d_numSetModelValConflicts;
+  /** number of lemmas of the weak equivalence algorithm */
+  IntStat d_numWeakEquivLemmas;
 
   // Merge reason types
 
@@ -264,7 +266,20 @@ class TheoryArrays : public Theory {
   TNode weakEquivGetRep(TNode node);
   TNode weakEquivGetRepIndex(TNode node, TNode index);
   void visitAllLeaves(TNode reason, std::vector<TNode>& conjunctions);
-  void weakEquivBuildCond(TNode node, TNode index, std::vector<TNode>& conjunctions);
+  /**
+   * Get the first node where the paths from a and from b to their common
+   * representative for index meet.
+   */
+  TNode weakEquivGetMeet(TNode a, TNode b, TNode index);
+  /**
+   * Add to conjunctions the conditions under which node and the node stop
+   * of its path (by default its representative for index) are equal at
+   * index.
+   */
+  void weakEquivBuildCond(TNode node,
+                          TNode index,
+                          std::vector<TNode>& conjunctions,
+                          TNode stop = TNode());
   void weakEquivMakeRep(TNode node);
   void weakEquivMakeRepIndex(TNode node);
   void weakEquivAddSecondary(TNode index, TNode arrayFrom, TNode arrayTo, TNode reason);
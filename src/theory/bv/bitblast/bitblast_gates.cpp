@@ -0,0 +1,372 @@
+/*********************                                                        */
+/*! \file bitblast_gates.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Simplifying gate constructors for bit-blasting to nodes.
+ **
+ ** Simplifying gate constructors for bit-blasting to nodes.
+ **/
+
+#include "theory/bv/bitblast/bitblast_gates.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "options/bv_options.h"
+
+namespace CVC4 {
+namespace theory {
+namespace bv {
+namespace gates {
+
+namespace {
+
+/** Returns true if a is the negation of b, or b the negation of a. */
+bool isNegationOf(TNode a, TNode b)
+{
+  return (a.getKind() == kind::NOT && a[0] == b)
+         || (b.getKind() == kind::NOT && b[0] == a);
+}
+
+/** Returns true if a is a binary AND. */
+bool isAnd(TNode a)
+{
+  return a.getKind() == kind::AND && a.getNumChildren() == 2;
+}
+
+/** Returns true if a is a negated binary AND. */
+bool isNand(TNode a) { return a.getKind() == kind::NOT && isAnd(a[0]); }
+
+Node mkConst(bool value)
+{
+  return NodeManager::currentNM()->mkConst<bool>(value);
+}
+
+/**
+ * Simplifies the n-ary gate of kind k (AND or OR) over children into
+ * simplified: the neutral constants are dropped and the duplicates removed.
+ * Returns true if the gate is equal to its absorbing constant, that is if a
+ * child is that constant or two children are complementary.
+ */
+bool simplifyChildren(Kind k,
+                      const std::vector<Node>& children,
+                      std::vector<Node>& simplified)
+{
+  bool absorbing = k == kind::OR;
+  std::unordered_set<TNode, TNodeHashFunction> seen;
+  for (const Node& child : children)
+  {
+    if (child.isConst())
+    {
+      if (child.getConst<bool>() == absorbing)
+      {
+        return true;
+      }
+      continue;
+    }
+    Node negation = child.getKind() == kind::NOT ? child[0] : child.notNode();
+    if (seen.find(negation) != seen.end())
+    {
+      return true;
+    }
+    if (seen.insert(child).second)
+    {
+      simplified.push_back(child);
+    }
+  }
+  std::sort(simplified.begin(), simplified.end());
+  return false;
+}
+
+}  // namespace
+
+Node mkNot(TNode a)
+{
+  if (!options::bitvectorGateSimp())
+  {
+    return NodeManager::currentNM()->mkNode(kind::NOT, a);
+  }
+  if (a.isConst())
+  {
+    return mkConst(!a.getConst<bool>());
+  }
+  if (a.getKind() == kind::NOT)
+  {
+    return a[0];
+  }
+  return NodeManager::currentNM()->mkNode(kind::NOT, a);
+}
+
+Node mkAnd(TNode a, TNode b)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  if (!options::bitvectorGateSimp())
+  {
+    return nm->mkNode(kind::AND, a, b);
+  }
+  // constant propagation
+  if (a.isConst())
+  {
+    return a.getConst<bool>() ? Node(b) : Node(a);
+  }
+  if (b.isConst())
+  {
+    return b.getConst<bool>() ? Node(a) : Node(b);
+  }
+  // idempotence and contradiction
+  if (a == b)
+  {
+    return a;
+  }
+  if (isNegationOf(a, b))
+  {
+    return mkConst(false);
+  }
+  // the two-level rules, with x the gate below y
+  for (unsigned i = 0; i < 2; ++i)
+  {
+    TNode x = i == 0 ? a : b;
+    TNode y = i == 0 ? b : a;
+    if (isAnd(x))
+    {
+      // contradiction: (x0 & x1) & ~x0 = false
+      if (isNegationOf(x[0], y) || isNegationOf(x[1], y))
+      {
+        return mkConst(false);
+      }
+      // idempotence: (x0 & x1) & x0 = x0 & x1
+      if (x[0] == y || x[1] == y)
+      {
+        return x;
+      }
+      // contradiction: (x0 & x1) & (~x0 & y1) = false
+      if (isAnd(y))
+      {
+        for (unsigned j = 0; j < 2; ++j)
+        {
+          if (isNegationOf(x[j], y[0]) || isNegationOf(x[j], y[1]))
+          {
+            return mkConst(false);
+          }
+        }
+      }
+    }
+    else if (isNand(x))
+    {
+      TNode z = x[0];
+      // subsumption: ~(z0 & z1) & ~z0 = ~z0
+      if (isNegationOf(z[0], y) || isNegationOf(z[1], y))
+      {
+        return y;
+      }
+      // substitution: ~(z0 & z1) & z0 = z0 & ~z1
+      if (z[0] == y)
+      {
+        return mkAnd(y, mkNot(z[1]));
+      }
+      if (z[1] == y)
+      {
+        return mkAnd(y, mkNot(z[0]));
+      }
+      // resolution: ~(z0 & z1) & ~(z0 & ~z1) = ~z0
+      if (i == 0 && isNand(y))
+      {
+        TNode w = y[0];
+        for (unsigned j = 0; j < 2; ++j)
+        {
+          for (unsigned k = 0; k < 2; ++k)
+          {
+            if (z[j] == w[k] && isNegationOf(z[1 - j], w[1 - k]))
+            {
+              return mkNot(z[j]);
+            }
+          }
+        }
+      }
+    }
+  }
+  // structural hashing: order the operands so that a & b and b & a are
+  // the same node
+  return b < a ? nm->mkNode(kind::AND, b, a) : nm->mkNode(kind::AND, a, b);
+}
+
+Node mkAnd(const std::vector<Node>& children)
+{
+  Assert(children.size());
+  if (!options::bitvectorGateSimp())
+  {
+    if (children.size() == 1) return children[0];
+    return NodeManager::currentNM()->mkNode(kind::AND, children);
+  }
+  std::vector<Node> simplified;
+  if (simplifyChildren(kind::AND, children, simplified))
+  {
+    return mkConst(false);
+  }
+  if (simplified.empty())
+  {
+    return mkConst(true);
+  }
+  if (simplified.size() == 2)
+  {
+    return mkAnd(simplified[0], simplified[1]);
+  }
+  if (simplified.size() == 1) return simplified[0];
+  return NodeManager::currentNM()->mkNode(kind::AND, simplified);
+}
+
+Node mkOr(TNode a, TNode b)
+{
+  if (!options::bitvectorGateSimp())
+  {
+    return NodeManager::currentNM()->mkNode(kind::OR, a, b);
+  }
+  return mkNot(mkAnd(mkNot(a), mkNot(b)));
+}
+
+Node mkOr(const std::vector<Node>& children)
+{
+  Assert(children.size());
+  if (!options::bitvectorGateSimp())
+  {
+    if (children.size() == 1) return children[0];
+    return NodeManager::currentNM()->mkNode(kind::OR, children);
+  }
+  std::vector<Node> simplified;
+  if (simplifyChildren(kind::OR, children, simplified))
+  {
+    return mkConst(true);
+  }
+  if (simplified.empty())
+  {
+    return mkConst(false);
+  }
+  if (simplified.size() == 2)
+  {
+    return mkOr(simplified[0], simplified[1]);
+  }
+  if (simplified.size() == 1) return simplified[0];
+  return NodeManager::currentNM()->mkNode(kind::OR, simplified);
+}
+
+Node mkXor(TNode a, TNode b)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  if (!options::bitvectorGateSimp())
+  {
+    return nm->mkNode(kind::XOR, a, b);
+  }
+  if (a.isConst())
+  {
+    return a.getConst<bool>() ? mkNot(b) : Node(b);
+  }
+  if (b.isConst())
+  {
+    return b.getConst<bool>() ? mkNot(a) : Node(a);
+  }
+  if (a == b)
+  {
+    return mkConst(false);
+  }
+  if (isNegationOf(a, b))
+  {
+    return mkConst(true);
+  }
+  // ~a ^ b = ~(a ^ b)
+  bool negated = false;
+  if (a.getKind() == kind::NOT)
+  {
+    a = a[0];
+    negated = !negated;
+  }
+  if (b.getKind() == kind::NOT)
+  {
+    b = b[0];
+    negated = !negated;
+  }
+  Node res = b < a ? nm->mkNode(kind::XOR, b, a) : nm->mkNode(kind::XOR, a, b);
+  return negated ? res.notNode() : res;
+}
+
+Node mkIff(TNode a, TNode b)
+{
+  if (!options::bitvectorGateSimp())
+  {
+    return NodeManager::currentNM()->mkNode(kind::EQUAL, a, b);
+  }
+  return mkNot(mkXor(a, b));
+}
+
+Node mkIte(TNode cond, TNode a, TNode b)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  if (!options::bitvectorGateSimp())
+  {
+    return nm->mkNode(kind::ITE, cond, a, b);
+  }
+  if (cond.isConst())
+  {
+    return cond.getConst<bool>() ? a : b;
+  }
+  if (a == b)
+  {
+    return a;
+  }
+  // ite(~c, a, b) = ite(c, b, a)
+  if (cond.getKind() == kind::NOT)
+  {
+    cond = cond[0];
+    std::swap(a, b);
+  }
+  // reduce to ANDs and ORs when a branch is a constant or the condition
+  if (a.isConst() || a == cond || isNegationOf(a, cond))
+  {
+    return (a.isConst() ? a.getConst<bool>() : a == cond)
+               ? mkOr(cond, b)
+               : mkAnd(mkNot(cond), b);
+  }
+  if (b.isConst() || b == cond || isNegationOf(b, cond))
+  {
+    return (b.isConst() ? b.getConst<bool>() : b != cond)
+               ? mkOr(mkNot(cond), a)
+               : mkAnd(cond, a);
+  }
+  // ite(c, ~a, ~b) = ~ite(c, a, b)
+  if (a.getKind() == kind::NOT && b.getKind() == kind::NOT)
+  {
+    return nm->mkNode(kind::ITE, cond, a[0], b[0]).notNode();
+  }
+  return nm->mkNode(kind::ITE, cond, a, b);
+}
+
+Node mkCarry(TNode a, TNode b, TNode c)
+{
+  Node ab = mkXor(a, b);
+  if (!options::bitvectorGateSimp())
+  {
+    return mkOr(mkAnd(a, b), mkAnd(ab, c));
+  }
+  return mkIte(ab, c, a);
+}
+
+Node mkLessThanStep(TNode a, TNode b, TNode lt)
+{
+  Node ab = mkIff(a, b);
+  if (!options::bitvectorGateSimp())
+  {
+    return mkOr(mkAnd(ab, lt), mkAnd(mkNot(a), b));
+  }
+  return mkIte(ab, lt, b);
+}
+
+}  // namespace gates
+}  // namespace bv
+}  // namespace theory
+}  // namespace CVC4
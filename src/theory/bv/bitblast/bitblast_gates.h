@@ -0,0 +1,67 @@
+/*********************                                                        */
+/*! \file bitblast_gates.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Simplifying gate constructors for bit-blasting to nodes.
+ **
+ ** The bits of the bit-blasted terms are Boolean nodes, which the node
+ ** manager already hashes structurally.  With --bv-gate-simp the gates are
+ ** additionally simplified when they are built, as in an and-inverter graph:
+ ** constants are propagated, the operands of commutative gates are ordered
+ ** so that equal gates are shared, negations are pushed to the outside of
+ ** XORs and ITEs, and the two-level rules of Brummayer and Biere ("Local
+ ** Two-Level And-Inverter Graph Minimization without Blowup", MEMICS 2006)
+ ** are applied to ANDs.  Binary ORs are built as negated ANDs so that the
+ ** rules apply to them as well; the CNF conversion translates both with the
+ ** same number of clauses.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__BV__BITBLAST__BITBLAST_GATES_H
+#define CVC4__THEORY__BV__BITBLAST__BITBLAST_GATES_H
+
+#include <vector>
+
+#include "expr/node.h"
+
+namespace CVC4 {
+namespace theory {
+namespace bv {
+namespace gates {
+
+Node mkNot(TNode a);
+Node mkAnd(TNode a, TNode b);
+Node mkAnd(const std::vector<Node>& children);
+Node mkOr(TNode a, TNode b);
+Node mkOr(const std::vector<Node>& children);
+Node mkXor(TNode a, TNode b);
+Node mkIff(TNode a, TNode b);
+Node mkIte(TNode cond, TNode a, TNode b);
+/**
+ * The carry out of the full adder of a, b and the carry in c, i.e. the
+ * majority of a, b and c.  It is built as ite(a xor b, c, a), which shares
+ * the XOR with the sum bit and needs 6 clauses and one variable instead of
+ * the 9 clauses and three variables of (a & b) | ((a xor b) & c).
+ */
+Node mkCarry(TNode a, TNode b, TNode c);
+/**
+ * The comparison (a <-> b & lt) | (~a & b) of a bit of an unsigned
+ * comparator, where lt is the comparison of the lower bits.  It is built as
+ * ite(a <-> b, lt, b) for the same reason as mkCarry.
+ */
+Node mkLessThanStep(TNode a, TNode b, TNode lt);
+
+}  // namespace gates
+}  // namespace bv
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__BV__BITBLAST__BITBLAST_GATES_H */
@@ -23,6 +23,7 @@
 #include <ostream>
 
 #include "expr/node.h"
+#include "options/bv_options.h"
 #include "theory/bv/bitblast/bitblast_utils.h"
 #include "theory/bv/theory_bv_utils.h"
 #include "theory/rewriter.h"
@@ -82,9 +83,7 @@ T AdderUltBB(TNode node, TBitblaster<T>* bb) {
   T carry = mkTrue<T>();
   
   for (unsigned i = 0 ; i < a.size(); ++i) {
-    carry = mkOr( mkAnd(a[i], not_b[i]),
-                  mkAnd( mkXor(a[i], not_b[i]),
-                         carry));
+    carry = mkCarry(a[i], not_b[i], carry);
   }
   return mkNot(carry); 
 }
@@ -384,9 +383,23 @@ void DefaultMultBB (TNode node, std::vector<T>& res, TBitblaster<T>* bb) {
     std::vector<T> current;
     bb->bbTerm(node[i], current);
     newres.clear(); 
-    // constructs a simple shift and add multiplier building the result
-    // in res
-    shiftAddMultiplier(res, current, newres);
+    options::BvMultiplierMode mode = options::bvMultiplierMode();
+    if (mode == options::BvMultiplierMode::AUTO)
+    {
+      mode = res.size() >= options::bvMultiplierWallaceWidth()
+                 ? options::BvMultiplierMode::WALLACE
+                 : options::BvMultiplierMode::SHIFT_ADD;
+    }
+    if (mode == options::BvMultiplierMode::WALLACE)
+    {
+      wallaceMultiplier(res, current, newres);
+    }
+    else
+    {
+      // constructs a simple shift and add multiplier building the result
+      // in res
+      shiftAddMultiplier(res, current, newres);
+    }
     res = newres;
   }
   if(Debug.isOn("bitvector-bb")) {
@@ -512,6 +525,73 @@ void uDivModRec(const std::vector<T>& a, const std::vector<T>& b, std::vector<T>
 
 }
 
+/**
+ * Constructs a non-restoring divider: in each step the next bit of a is
+ * shifted into the remainder, from which b is subtracted if it is not
+ * negative and to which b is added otherwise.  The remainder is kept in
+ * a.size() + 1 bits, and b is added once more at the end if it is negative.
+ * Division by zero is left to the caller.
+ */
+template <class T>
+void uDivModNonRestoring(const std::vector<T>& a,
+                         const std::vector<T>& b,
+                         std::vector<T>& q,
+                         std::vector<T>& r)
+{
+  Assert(q.size() == 0 && r.size() == 0 && a.size() == b.size());
+  unsigned size = a.size();
+
+  std::vector<T> divisor = b;
+  divisor.push_back(mkFalse<T>());
+  std::vector<T> rem;
+  makeZero(rem, size + 1);
+  T negative = mkFalse<T>();
+  q.resize(size);
+  for (unsigned i = size; i-- > 0;)
+  {
+    std::vector<T> shifted;
+    shifted.push_back(a[i]);
+    shifted.insert(shifted.end(), rem.begin(), rem.end() - 1);
+    // shifted - divisor = shifted + ~divisor + 1
+    T subtract = mkNot(negative);
+    std::vector<T> operand;
+    for (unsigned k = 0; k <= size; ++k)
+    {
+      operand.push_back(mkXor(divisor[k], subtract));
+    }
+    rem.clear();
+    rippleCarryAdder(shifted, operand, rem, subtract);
+    negative = rem[size];
+    q[i] = mkNot(negative);
+  }
+
+  std::vector<T> correction;
+  for (unsigned k = 0; k <= size; ++k)
+  {
+    correction.push_back(mkAnd(divisor[k], negative));
+  }
+  std::vector<T> restored;
+  rippleCarryAdder(rem, correction, restored, mkFalse<T>());
+  r.insert(r.end(), restored.begin(), restored.end() - 1);
+}
+
+/** Constructs the quotient and remainder of a and b, see --bv-div. */
+template <class T>
+void uDivMod(const std::vector<T>& a,
+             const std::vector<T>& b,
+             std::vector<T>& q,
+             std::vector<T>& r)
+{
+  if (options::bvDividerMode() == options::BvDividerMode::NON_RESTORING)
+  {
+    uDivModNonRestoring(a, b, q, r);
+  }
+  else
+  {
+    uDivModRec(a, b, q, r, a.size());
+  }
+}
+
 template <class T>
 void DefaultUdivBB(TNode node, std::vector<T>& q, TBitblaster<T>* bb)
 {
@@ -524,7 +604,7 @@ void DefaultUdivBB(TNode node, std::vector<T>& q, TBitblaster<T>* bb)
   bb->bbTerm(node[1], b);
 
   std::vector<T> r;
-  uDivModRec(a, b, q, r, utils::getSize(node));
+  uDivMod(a, b, q, r);
   // adding a special case for division by 0
   std::vector<T> iszero;
   for (unsigned i = 0; i < b.size(); ++i)
@@ -557,7 +637,7 @@ void DefaultUremBB(TNode node, std::vector<T>& rem, TBitblaster<T>* bb)
   bb->bbTerm(node[1], b);
 
   std::vector<T> q;
-  uDivModRec(a, b, q, rem, utils::getSize(node));
+  uDivMod(a, b, q, rem);
   // adding a special case for division by 0
   std::vector<T> iszero;
   for (unsigned i = 0; i < b.size(); ++i)
@@ -0,0 +1,234 @@
+/*********************                                                        */
+/*! \file bitblast_template.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Bit-blasting of multiplications and divisions from templates.
+ **
+ ** The bits of a multiplication, division or remainder of two terms of width
+ ** w only depend on the bits of the two terms.  They are built once for the
+ ** values of two bound variables of width w, the inputs of the templates, and
+ ** stored as an attribute of the template term, so that all the bit-blasters
+ ** of the node manager share them.  Other terms of the same kind and width
+ ** are bit-blasted by replacing the bits of the inputs by the bits of their
+ ** children in the template.
+ **/
+
+#include "theory/bv/bitblast/bitblaster.h"
+
+#include "expr/attribute.h"
+#include "options/bv_options.h"
+#include "theory/bv/theory_bv_utils.h"
+
+namespace CVC4 {
+namespace theory {
+namespace bv {
+
+namespace {
+
+/**
+ * The inputs a and b of the templates of a bit-vector type, followed by the
+ * template terms a * b, a udiv b and a urem b, as a SEXPR.  The attribute
+ * keeps the template terms alive.
+ */
+struct BitblastTemplateTermsAttributeId
+{
+};
+typedef expr::Attribute<BitblastTemplateTermsAttributeId, Node>
+    BitblastTemplateTermsAttribute;
+
+/** The bits of a template term, as a SEXPR */
+struct BitblastTemplateAttributeId
+{
+};
+typedef expr::Attribute<BitblastTemplateAttributeId, Node>
+    BitblastTemplateAttribute;
+
+/** Returns the template terms of the bit-vector type tn */
+Node getTemplateTerms(TypeNode tn)
+{
+  Node terms = tn.getAttribute(BitblastTemplateTermsAttribute());
+  if (terms.isNull())
+  {
+    NodeManager* nm = NodeManager::currentNM();
+    Node a = nm->mkBoundVar(tn);
+    Node b = nm->mkBoundVar(tn);
+    std::vector<Node> children = {a,
+                                  b,
+                                  nm->mkNode(kind::BITVECTOR_MULT, a, b),
+                                  nm->mkNode(kind::BITVECTOR_UDIV_TOTAL, a, b),
+                                  nm->mkNode(kind::BITVECTOR_UREM_TOTAL, a, b)};
+    terms = nm->mkNode(kind::SEXPR, children);
+    tn.setAttribute(BitblastTemplateTermsAttribute(), terms);
+  }
+  return terms;
+}
+
+/** Returns the index of the template term of kind k in getTemplateTerms */
+unsigned getTemplateIndex(Kind k)
+{
+  switch (k)
+  {
+    case kind::BITVECTOR_MULT: return 2;
+    case kind::BITVECTOR_UDIV_TOTAL: return 3;
+    default: Assert(k == kind::BITVECTOR_UREM_TOTAL); return 4;
+  }
+}
+
+/**
+ * Returns the instance of the bits of the template tmpl, where the bits of
+ * the inputs have the values in inst.  The bits are instantiated without
+ * recursion, the templates of the divisions are deep.
+ */
+void instantiate(Node tmpl,
+                 std::unordered_map<TNode, Node, TNodeHashFunction>& inst,
+                 std::vector<Node>& bits)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  std::vector<TNode> toVisit;
+  for (const Node& b : tmpl)
+  {
+    toVisit.push_back(b);
+    while (!toVisit.empty())
+    {
+      TNode cur = toVisit.back();
+      if (inst.find(cur) != inst.end())
+      {
+        toVisit.pop_back();
+        continue;
+      }
+      if (cur.getNumChildren() == 0)
+      {
+        inst[cur] = cur;
+        toVisit.pop_back();
+        continue;
+      }
+      // the gates are not parameterized, the bits of the inputs are in inst
+      Assert(cur.getMetaKind() != kind::metakind::PARAMETERIZED);
+      std::vector<Node> children;
+      for (const Node& c : cur)
+      {
+        std::unordered_map<TNode, Node, TNodeHashFunction>::iterator it =
+            inst.find(c);
+        if (it == inst.end())
+        {
+          toVisit.push_back(c);
+        }
+        else if (toVisit.back() == cur)
+        {
+          children.push_back(it->second);
+        }
+      }
+      if (toVisit.back() == cur)
+      {
+        inst[cur] = nm->mkNode(cur.getKind(), children);
+        toVisit.pop_back();
+      }
+    }
+    bits.push_back(inst[b]);
+  }
+}
+
+}  // namespace
+
+template <>
+bool TBitblaster<Node>::bbTermFromTemplate(TNode node, std::vector<Node>& bits)
+{
+  Kind k = node.getKind();
+  if ((k != kind::BITVECTOR_MULT && k != kind::BITVECTOR_UDIV_TOTAL
+       && k != kind::BITVECTOR_UREM_TOTAL)
+      || node.getNumChildren() != 2 || !options::bitblastTemplates()
+      || d_bvp != nullptr)
+  {
+    return false;
+  }
+  std::vector<Node> a, b;
+  bbTerm(node[0], a);
+  bbTerm(node[1], b);
+  // the gate constructors simplify constant and shared bits, the templates
+  // would not
+  if (a == b)
+  {
+    return false;
+  }
+  for (unsigned i = 0, size = a.size(); i < size; ++i)
+  {
+    if (a[i].isConst() || b[i].isConst())
+    {
+      return false;
+    }
+  }
+
+  Node terms = getTemplateTerms(node.getType());
+  unsigned index = getTemplateIndex(k);
+  Node tmpl = terms[index].getAttribute(BitblastTemplateAttribute());
+  if (tmpl.isNull())
+  {
+    // bit-blast the template term, with the bits of the inputs as their bits
+    NodeManager* nm = NodeManager::currentNM();
+    for (unsigned i = 0; i < 2; ++i)
+    {
+      std::vector<Node> ibits;
+      for (unsigned j = 0, size = a.size(); j < size; ++j)
+      {
+        ibits.push_back(utils::mkBitOf(terms[i], j));
+      }
+      d_termCache[terms[i]] = ibits;
+    }
+    std::vector<Node> tbits;
+    d_termBBStrategies[k](terms[index], tbits, this);
+    tmpl = nm->mkNode(kind::SEXPR, tbits);
+    terms[index].setAttribute(BitblastTemplateAttribute(), tmpl);
+    // the division strategies also bit-blast the remainder and vice versa
+    for (unsigned i = 3; i <= 4; ++i)
+    {
+      TermDefMap::iterator it = d_termCache.find(terms[i]);
+      if (it != d_termCache.end())
+      {
+        terms[i].setAttribute(BitblastTemplateAttribute(),
+                              nm->mkNode(kind::SEXPR, it->second));
+        d_termCache.erase(it);
+      }
+    }
+    d_termCache.erase(terms[0]);
+    d_termCache.erase(terms[1]);
+  }
+
+  std::unordered_map<TNode, Node, TNodeHashFunction> inst;
+  std::vector<Node> inputBits;
+  for (unsigned j = 0, size = a.size(); j < size; ++j)
+  {
+    inputBits.push_back(utils::mkBitOf(terms[0], j));
+    inst[inputBits.back()] = a[j];
+    inputBits.push_back(utils::mkBitOf(terms[1], j));
+    inst[inputBits.back()] = b[j];
+  }
+  instantiate(tmpl, inst, bits);
+  if (k != kind::BITVECTOR_MULT)
+  {
+    // cache the other of the quotient and the remainder, like the strategies
+    Node other = Rewriter::rewrite(NodeManager::currentNM()->mkNode(
+        k == kind::BITVECTOR_UDIV_TOTAL ? kind::BITVECTOR_UREM_TOTAL
+                                        : kind::BITVECTOR_UDIV_TOTAL,
+        node[0],
+        node[1]));
+    Node otmpl = terms[7 - index].getAttribute(BitblastTemplateAttribute());
+    if (!otmpl.isNull() && !hasBBTerm(other))
+    {
+      std::vector<Node> obits;
+      instantiate(otmpl, inst, obits);
+      storeBBTerm(other, obits);
+    }
+  }
+  return true;
+}
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace CVC4
@@ -22,6 +22,7 @@
 
 #include <ostream>
 #include "expr/node.h"
+#include "theory/bv/bitblast/bitblast_gates.h"
 
 namespace CVC4 {
 namespace theory {
@@ -58,6 +59,23 @@ template <class T> T mkXor(T a, T b);
 template <class T> T mkIff(T a, T b);
 template <class T> T mkIte(T cond, T a, T b);
 
+/** The carry out of the full adder of a, b and the carry in c */
+template <class T>
+T inline mkCarry(T a, T b, T c)
+{
+  return mkOr(mkAnd(a, b), mkAnd(mkXor(a, b), c));
+}
+
+/**
+ * The result (a <-> b & lt) | (~a & b) of comparing the bits a and b of an
+ * unsigned comparison, where lt is the result for the lower bits
+ */
+template <class T>
+T inline mkLessThanStep(T a, T b, T lt)
+{
+  return mkOr(mkAnd(mkIff(a, b), lt), mkAnd(mkNot(a), b));
+}
+
 
 template <> inline
 Node mkTrue<Node>() {
@@ -71,50 +89,56 @@ Node mkFalse<Node>() {
 
 template <> inline
 Node mkNot<Node>(Node a) {
-  return NodeManager::currentNM()->mkNode(kind::NOT, a);
+  return gates::mkNot(a);
 }
 
 template <> inline
 Node mkOr<Node>(Node a, Node b) {
-  return NodeManager::currentNM()->mkNode(kind::OR, a, b);
+  return gates::mkOr(a, b);
 }
 
 template <> inline
 Node mkOr<Node>(const std::vector<Node>& children) {
-  Assert(children.size());
-  if (children.size() == 1)
-    return children[0]; 
-  return NodeManager::currentNM()->mkNode(kind::OR, children); 
+  return gates::mkOr(children);
 }
 
 
 template <> inline
 Node mkAnd<Node>(Node a, Node b) {
-  return NodeManager::currentNM()->mkNode(kind::AND, a, b);
+  return gates::mkAnd(a, b);
 }
 
 template <> inline
 Node mkAnd<Node>(const std::vector<Node>& children) {
-  Assert(children.size());
-  if (children.size() == 1)
-    return children[0]; 
-  return NodeManager::currentNM()->mkNode(kind::AND, children); 
+  return gates::mkAnd(children);
 }
 
 
 template <> inline
 Node mkXor<Node>(Node a, Node b) {
-  return NodeManager::currentNM()->mkNode(kind::XOR, a, b);
+  return gates::mkXor(a, b);
 }
 
 template <> inline
 Node mkIff<Node>(Node a, Node b) {
-  return NodeManager::currentNM()->mkNode(kind::EQUAL, a, b);
+  return gates::mkIff(a, b);
 }
 
 template <> inline
 Node mkIte<Node>(Node cond, Node a, Node b) {
-  return NodeManager::currentNM()->mkNode(kind::ITE, cond, a, b);
+  return gates::mkIte(cond, a, b);
+}
+
+template <> inline
+Node mkCarry<Node>(Node a, Node b, Node c)
+{
+  return gates::mkCarry(a, b, c);
+}
+
+template <> inline
+Node mkLessThanStep<Node>(Node a, Node b, Node lt)
+{
+  return gates::mkLessThanStep(a, b, lt);
 }
 
 /*
@@ -191,9 +215,7 @@ T inline rippleCarryAdder(const std::vector<T>&a, const std::vector<T>& b, std::
 
   for (unsigned i = 0 ; i < a.size(); ++i) {
     T sum = mkXor(mkXor(a[i], b[i]), carry);
-    carry = mkOr( mkAnd(a[i], b[i]),
-                  mkAnd( mkXor(a[i], b[i]),
-                         carry));
+    carry = mkCarry(a[i], b[i], carry);
     res.push_back(sum); 
   }
 
@@ -212,14 +234,81 @@ inline void shiftAddMultiplier(const std::vector<T>&a, const std::vector<T>&b, s
   T carry_out;
     for(unsigned j = 0; j < res.size() -k; ++j) {
       T aj = mkAnd(b[k], a[j]);
-      carry_out = mkOr(mkAnd(res[j+k], aj),
-                       mkAnd( mkXor(res[j+k], aj), carry_in));
+      carry_out = mkCarry(res[j + k], aj, carry_in);
       res[j+k] = mkXor(mkXor(res[j+k], aj), carry_in);
       carry_in = carry_out; 
     }
   }
 }
 
+/**
+ * Constructs a multiplier that reduces the partial products with a Wallace
+ * tree: in each layer the bits of every column are added three at a time by
+ * full adders, until no column has more than two bits, which are then added
+ * by a ripple carry adder.  Only the low a.size() bits of the product are
+ * built.
+ *
+ * @param a first term to be multiplied
+ * @param b second term to be multiplied
+ * @param res the result
+ */
+template <class T>
+inline void wallaceMultiplier(const std::vector<T>& a,
+                              const std::vector<T>& b,
+                              std::vector<T>& res)
+{
+  Assert(a.size() == b.size() && res.size() == 0);
+  unsigned size = a.size();
+
+  std::vector<std::vector<T> > columns(size);
+  for (unsigned i = 0; i < size; ++i)
+  {
+    for (unsigned j = 0; i + j < size; ++j)
+    {
+      columns[i + j].push_back(mkAnd(b[i], a[j]));
+    }
+  }
+
+  bool reduced = false;
+  while (!reduced)
+  {
+    reduced = true;
+    std::vector<std::vector<T> > next(size);
+    for (unsigned k = 0; k < size; ++k)
+    {
+      const std::vector<T>& column = columns[k];
+      unsigned i = 0;
+      for (; i + 3 <= column.size(); i += 3)
+      {
+        T x = column[i], y = column[i + 1], z = column[i + 2];
+        T xy = mkXor(x, y);
+        next[k].push_back(mkXor(xy, z));
+        if (k + 1 < size)
+        {
+          next[k + 1].push_back(mkCarry(x, y, z));
+        }
+      }
+      for (; i < column.size(); ++i)
+      {
+        next[k].push_back(column[i]);
+      }
+    }
+    for (unsigned k = 0; k < size; ++k)
+    {
+      reduced = reduced && next[k].size() <= 2;
+    }
+    columns.swap(next);
+  }
+
+  std::vector<T> first, second;
+  for (unsigned k = 0; k < size; ++k)
+  {
+    first.push_back(columns[k].size() > 0 ? columns[k][0] : mkFalse<T>());
+    second.push_back(columns[k].size() > 1 ? columns[k][1] : mkFalse<T>());
+  }
+  rippleCarryAdder(first, second, res, mkFalse<T>());
+}
+
 template <class T>
 T inline uLessThanBB(const std::vector<T>&a, const std::vector<T>& b, bool orEqual) {
   Assert(a.size() && b.size());
@@ -232,8 +321,7 @@ T inline uLessThanBB(const std::vector<T>&a, const std::vector<T>& b, bool orEqu
   
   for (unsigned i = 1; i < a.size(); ++i) {
     // a < b iff ( a[i] <-> b[i] AND a[i-1:0] < b[i-1:0]) OR (~a[i] AND b[i]) 
-    res = mkOr(mkAnd(mkIff(a[i], b[i]), res),
-               mkAnd(mkNot(a[i]), b[i])); 
+    res = mkLessThanStep(a[i], b[i], res);
   }
   return res;
 }
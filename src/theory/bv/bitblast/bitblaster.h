@@ -76,6 +76,12 @@ class TBitblaster
   AtomBBStrategy d_atomBBStrategies[kind::LAST_KIND];
   virtual Node getModelFromSatSolver(TNode node, bool fullModel) = 0;
   virtual prop::SatSolver* getSatSolver() = 0;
+  /**
+   * Bit-blast node from the shared template of its kind and width, if it is
+   * a multiplication, division or remainder the templates apply to.  Returns
+   * false if node should be bit-blasted by its strategy.
+   */
+  bool bbTermFromTemplate(TNode node, Bits& bits);
 
 
  public:
@@ -211,6 +217,15 @@ void TBitblaster<T>::storeBBTerm(TNode node, const Bits& bits)
   d_termCache.insert(std::make_pair(node, bits));
 }
 
+template <class T>
+bool TBitblaster<T>::bbTermFromTemplate(TNode node, Bits& bits)
+{
+  return false;
+}
+
+template <>
+bool TBitblaster<Node>::bbTermFromTemplate(TNode node, std::vector<Node>& bits);
+
 template <class T>
 void TBitblaster<T>::invalidateModelCache()
 {
@@ -75,16 +75,8 @@ EagerBitblaster::~EagerBitblaster() {}
 
 void EagerBitblaster::bbFormula(TNode node)
 {
-  /* For incremental eager solving we assume formulas at context levels > 1. */
-  if (options::incrementalSolving() && d_context->getLevel() > 1)
-  {
-    d_cnfStream->ensureLiteral(node);
-  }
-  else
-  {
-    d_cnfStream->convertAndAssert(
-        node, false, false, RULE_INVALID, TNode::null());
-  }
+  d_cnfStream->convertAndAssert(
+      node, false, false, RULE_INVALID, TNode::null());
 }
 
 /**
@@ -155,7 +147,10 @@ void EagerBitblaster::bbTerm(TNode node, Bits& bits) {
   d_bv->spendResource(ResourceManager::Resource::BitblastStep);
   Debug("bitvector-bitblast") << "Bitblasting node " << node << "\n";
 
-  d_termBBStrategies[node.getKind()](node, bits, this);
+  if (!bbTermFromTemplate(node, bits))
+  {
+    d_termBBStrategies[node.getKind()](node, bits, this);
+  }
 
   Assert(bits.size() == utils::getSize(node));
 
@@ -0,0 +1,204 @@
+/*********************                                                        */
+/*! \file bv_core_cache.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Cache of the conflicts of the lazy bit-blaster.
+ **
+ ** Cache of the conflicts of the lazy bit-blaster.
+ **/
+
+#include "theory/bv/bv_core_cache.h"
+
+#include <algorithm>
+
+namespace CVC4 {
+namespace theory {
+namespace bv {
+
+CoreCache::CoreCache(unsigned maxSize) : d_size(0), d_maxSize(maxSize) {}
+
+int CoreCache::find(const LiteralSet& literals) const
+{
+  // a conflict is contained in literals if all its literals are hit
+  std::unordered_map<unsigned, unsigned> hits;
+  for (TNode lit : literals)
+  {
+    auto it = d_occurrences.find(lit);
+    if (it == d_occurrences.end())
+    {
+      continue;
+    }
+    for (unsigned id : it->second)
+    {
+      if (++hits[id] == d_cores[id].size())
+      {
+        return id;
+      }
+    }
+  }
+  return -1;
+}
+
+bool CoreCache::findCore(const LiteralSet& literals,
+                         std::vector<Node>& core,
+                         bool& minimized) const
+{
+  int id = find(literals);
+  if (id < 0)
+  {
+    return false;
+  }
+  core = d_cores[id];
+  minimized = d_minimized[id];
+  return true;
+}
+
+bool CoreCache::addCore(const std::vector<Node>& core, bool minimized)
+{
+  if (d_maxSize == 0 || core.empty())
+  {
+    return false;
+  }
+  std::vector<Node> sorted = core;
+  std::sort(sorted.begin(), sorted.end());
+  sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+  LiteralSet literals(sorted.begin(), sorted.end());
+  if (find(literals) >= 0)
+  {
+    return false;
+  }
+
+  // remove the conflicts that contain the new one, which are all among the
+  // conflicts of its least frequent literal
+  const std::vector<unsigned>* candidates = nullptr;
+  for (const Node& lit : sorted)
+  {
+    auto it = d_occurrences.find(lit);
+    if (it == d_occurrences.end())
+    {
+      candidates = nullptr;
+      break;
+    }
+    if (candidates == nullptr || it->second.size() < candidates->size())
+    {
+      candidates = &it->second;
+    }
+  }
+  if (candidates != nullptr)
+  {
+    std::vector<unsigned> subsumed;
+    for (unsigned id : *candidates)
+    {
+      if (d_cores[id].size() > sorted.size()
+          && std::includes(d_cores[id].begin(),
+                           d_cores[id].end(),
+                           sorted.begin(),
+                           sorted.end()))
+      {
+        subsumed.push_back(id);
+      }
+    }
+    for (unsigned id : subsumed)
+    {
+      remove(id);
+    }
+  }
+
+  unsigned id = d_cores.size();
+  d_cores.push_back(sorted);
+  d_minimized.push_back(minimized);
+  for (const Node& lit : sorted)
+  {
+    d_occurrences[lit].push_back(id);
+  }
+  d_order.push(id);
+  ++d_size;
+
+  // evict the oldest conflicts
+  while (d_size > d_maxSize)
+  {
+    unsigned oldest = d_order.front();
+    d_order.pop();
+    if (!d_cores[oldest].empty())
+    {
+      remove(oldest);
+    }
+  }
+  if (d_cores.size() > 2 * d_size + 16)
+  {
+    compact();
+  }
+  return true;
+}
+
+void CoreCache::removeCore(const std::vector<Node>& core)
+{
+  LiteralSet literals(core.begin(), core.end());
+  int id = find(literals);
+  if (id >= 0 && d_cores[id].size() == literals.size())
+  {
+    remove(id);
+  }
+}
+
+void CoreCache::remove(unsigned id)
+{
+  Assert(!d_cores[id].empty());
+  for (const Node& lit : d_cores[id])
+  {
+    std::vector<unsigned>& ids = d_occurrences[lit];
+    ids.erase(std::find(ids.begin(), ids.end(), id));
+    if (ids.empty())
+    {
+      d_occurrences.erase(lit);
+    }
+  }
+  d_cores[id].clear();
+  --d_size;
+}
+
+void CoreCache::compact()
+{
+  std::vector<unsigned> newId(d_cores.size());
+  std::vector<std::vector<Node> > cores;
+  std::vector<bool> minimized;
+  for (unsigned id = 0; id < d_cores.size(); ++id)
+  {
+    if (!d_cores[id].empty())
+    {
+      newId[id] = cores.size();
+      cores.push_back(d_cores[id]);
+      minimized.push_back(d_minimized[id]);
+    }
+  }
+  std::queue<unsigned> order;
+  for (; !d_order.empty(); d_order.pop())
+  {
+    if (!d_cores[d_order.front()].empty())
+    {
+      order.push(newId[d_order.front()]);
+    }
+  }
+  for (auto& occurrence : d_occurrences)
+  {
+    for (unsigned& id : occurrence.second)
+    {
+      id = newId[id];
+    }
+  }
+  d_cores.swap(cores);
+  d_minimized.swap(minimized);
+  d_order.swap(order);
+}
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace CVC4
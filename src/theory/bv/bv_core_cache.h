@@ -0,0 +1,92 @@
+/*********************                                                        */
+/*! \file bv_core_cache.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Cache of the conflicts of the lazy bit-blaster.
+ **
+ ** A conflict of the bit-blaster is a set of bit-vector literals that is
+ ** unsatisfiable in the theory, independently of the context in which it was
+ ** found.  The cache keeps these sets, without the ones subsumed by others,
+ ** so that a conflict can be reported without solving when all its literals
+ ** are asserted again.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__BV__BV_CORE_CACHE_H
+#define CVC4__THEORY__BV__BV_CORE_CACHE_H
+
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "expr/node.h"
+
+namespace CVC4 {
+namespace theory {
+namespace bv {
+
+class CoreCache
+{
+ public:
+  typedef std::unordered_set<TNode, TNodeHashFunction> LiteralSet;
+
+  /** Creates a cache of at most maxSize conflicts. */
+  CoreCache(unsigned maxSize);
+
+  /**
+   * Adds the conflict core, unless a cached conflict subsumes it; the cached
+   * conflicts that core subsumes are removed.  Returns true if it was added.
+   */
+  bool addCore(const std::vector<Node>& core, bool minimized);
+
+  /**
+   * Finds a cached conflict all the literals of which are in literals.
+   * Returns true if it found one, which is then in core, and in minimized
+   * whether it has been minimized.
+   */
+  bool findCore(const LiteralSet& literals,
+                std::vector<Node>& core,
+                bool& minimized) const;
+
+  /** Removes the cached conflict core. */
+  void removeCore(const std::vector<Node>& core);
+
+  /** The number of cached conflicts */
+  unsigned size() const { return d_size; }
+
+ private:
+  /** Returns the id of a cached conflict contained in literals, or -1. */
+  int find(const LiteralSet& literals) const;
+  /** Removes the conflict with the given id. */
+  void remove(unsigned id);
+  /** Renumbers the conflicts to drop the removed ones. */
+  void compact();
+
+  /** The conflicts by id, sorted; removed conflicts are empty */
+  std::vector<std::vector<Node> > d_cores;
+  /** Whether the conflict of each id is minimized */
+  std::vector<bool> d_minimized;
+  /** The ids of the conflicts that contain each literal */
+  std::unordered_map<Node, std::vector<unsigned>, NodeHashFunction>
+      d_occurrences;
+  /** The ids in the order in which they were added, for the eviction */
+  std::queue<unsigned> d_order;
+  /** The number of conflicts that are not removed */
+  unsigned d_size;
+  unsigned d_maxSize;
+}; /* class CoreCache */
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__BV__BV_CORE_CACHE_H */
@@ -28,7 +28,7 @@ namespace bv {
 
 EagerBitblastSolver::EagerBitblastSolver(context::Context* c, TheoryBV* bv)
     : d_assertionSet(c),
-      d_assumptionSet(c),
+      d_activation(c),
       d_context(c),
       d_bitblaster(),
       d_aigBitblaster(),
@@ -74,10 +74,6 @@ void EagerBitblastSolver::assertFormula(TNode formula) {
   Assert(isInitialized());
   Debug("bitvector-eager") << "EagerBitblastSolver::assertFormula " << formula
                            << "\n";
-  if (options::incrementalSolving() && d_context->getLevel() > 1)
-  {
-    d_assumptionSet.insert(formula);
-  }
   d_assertionSet.insert(formula);
   // ensures all atoms are bit-blasted and converted to AIG
   if (d_useAig) {
@@ -87,12 +83,35 @@ void EagerBitblastSolver::assertFormula(TNode formula) {
     Unreachable();
 #endif
   }
+  else if (options::incrementalSolving() && d_context->getLevel() > 1)
+  {
+    d_bitblaster->bbFormula(NodeManager::currentNM()->mkNode(
+        kind::OR, getActivationLiteral().notNode(), formula));
+  }
   else
   {
     d_bitblaster->bbFormula(formula);
   }
 }
 
+Node EagerBitblastSolver::getActivationLiteral()
+{
+  unsigned level = d_context->getLevel();
+  context::CDHashMap<unsigned, Node>::const_iterator it =
+      d_activation.find(level);
+  if (it != d_activation.end())
+  {
+    return (*it).second;
+  }
+  NodeManager* nm = NodeManager::currentNM();
+  Node act = nm->mkSkolem("bvEagerAct",
+                          nm->booleanType(),
+                          "activation literal of a level of the eager "
+                          "bit-blaster");
+  d_activation.insert(level, act);
+  return act;
+}
+
 bool EagerBitblastSolver::checkSat() {
   Assert(isInitialized());
   if (d_assertionSet.empty()) {
@@ -114,8 +133,14 @@ bool EagerBitblastSolver::checkSat() {
 
   if (options::incrementalSolving())
   {
-    const std::vector<Node> assumptions = {d_assumptionSet.key_begin(),
-                                           d_assumptionSet.key_end()};
+    std::vector<Node> assumptions;
+    for (context::CDHashMap<unsigned, Node>::const_iterator it =
+             d_activation.begin();
+         it != d_activation.end();
+         ++it)
+    {
+      assumptions.push_back((*it).second);
+    }
     return d_bitblaster->solve(assumptions);
   }
   return d_bitblaster->solve();
@@ -22,6 +22,8 @@
 #include <unordered_set>
 #include <vector>
 
+#include "context/cdhashmap.h"
+#include "context/cdhashset.h"
 #include "expr/node.h"
 #include "proof/resolution_bitvector_proof.h"
 #include "theory/bv/theory_bv.h"
@@ -51,8 +53,19 @@ class EagerBitblastSolver {
   void setProofLog(proof::BitVectorProof* bvp);
 
  private:
+  /**
+   * Returns the activation literal of the current context level, creating it
+   * if needed. In incremental mode, the formulas asserted above the base level
+   * are asserted as (or (not act) formula), where act is the activation
+   * literal of their level, and checkSat() assumes the activation literals of
+   * the active levels. The literal of a popped level is never assumed again,
+   * so the bit-blasted clauses and the SAT solver are kept across push/pop.
+   */
+  Node getActivationLiteral();
+
   context::CDHashSet<Node, NodeHashFunction> d_assertionSet;
-  context::CDHashSet<Node, NodeHashFunction> d_assumptionSet;
+  /** The activation literals of the active context levels, by level */
+  context::CDHashMap<unsigned, Node> d_activation;
   context::Context* d_context;
 
   /** Bitblasters */
@@ -72,9 +72,9 @@ bool InequalityGraph::addInequality(TNode a, TNode b, bool strict, TNode reason)
   
   // add the inequality edge
   addEdge(id_a, id_b, strict, id_reason);
-  BFSQueue queue(&d_modelValues);
+  BFSQueue queue;
   Assert(hasModelValue(id_a));
-  queue.push(id_a);
+  queue.push(QueueEntry(a_val, id_a));
   return processQueue(queue, id_a); 
 }
 
@@ -119,12 +119,17 @@ bool InequalityGraph::updateValue(TermId id, ModelValue new_mv, TermId start, bo
 
 bool InequalityGraph::processQueue(BFSQueue& queue, TermId start) {
   while (!queue.empty()) {
-    TermId current = queue.top();
+    TermId current = queue.top().id;
+    BitVector current_value = getValue(current);
+    if (current_value != queue.top().value) {
+      // the value of current was increased after this entry was pushed, it is
+      // processed from the newer entry
+      queue.pop();
+      continue;
+    }
     queue.pop();
     Debug("bv-inequality-internal") << "InequalityGraph::processQueue processing " << getTermNode(current) << "\n";
   
-    BitVector current_value = getValue(current);
-  
     unsigned size = getBitwidth(current);
     const BitVector zero(size, 0u); 
     const BitVector one(size, 1u); 
@@ -171,7 +176,7 @@ bool InequalityGraph::processQueue(BFSQueue& queue, TermId start) {
         continue; 
       }
 
-      queue.push(next);
+      queue.push(QueueEntry(next_lower_bound, next));
       Debug("bv-inequality-internal") << "   enqueue " << getTermNode(next) << "\n"; 
     }
   }
@@ -188,10 +193,13 @@ void InequalityGraph::computeExplanation(TermId from, TermId to, std::vector<Rea
     }
   }
 
-  TermIdSet seen;
+  if (d_explanationSeen.size() < d_termNodes.size()) {
+    d_explanationSeen.resize(d_termNodes.size(), 0);
+  }
+  ++d_explanationStamp;
 
-  while(hasReason(to) && from != to && !seen.count(to)) {
-    seen.insert(to); 
+  while(hasReason(to) && from != to && d_explanationSeen[to] != d_explanationStamp) {
+    d_explanationSeen[to] = d_explanationStamp; 
     const ModelValue& exp = getModelValue(to);
     Assert(exp.reason != UndefinedReasonId);
     explanation.push_back(exp.reason);
@@ -290,8 +298,10 @@ void InequalityGraph::setConflict(const std::vector<ReasonId>& conflict) {
   Assert(!d_inConflict);
   d_inConflict = true;
   d_conflict.clear(); 
+  // the explanations of the terms of a conflict may share reasons
+  std::unordered_set<ReasonId> added;
   for (unsigned i = 0; i < conflict.size(); ++i) {
-    if (conflict[i] != AxiomReasonId) {
+    if (conflict[i] != AxiomReasonId && added.insert(conflict[i]).second) {
       d_conflict.push_back(getReasonNode(conflict[i]));
     }
   }
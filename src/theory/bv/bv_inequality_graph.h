@@ -89,16 +89,22 @@ class InequalityGraph : public context::ContextNotifyObj{
   
   typedef context::CDHashMap<TermId, ModelValue> ModelValues;
 
-  struct QueueComparator {
-    const ModelValues* d_model;
-    QueueComparator(const ModelValues* model)
-      : d_model(model)
-    {}
-    bool operator() (TermId left, TermId right) const {
-      Assert(d_model->find(left) != d_model->end()
-             && d_model->find(right) != d_model->end());
+  /**
+   * An entry of the queue of processQueue, with the value of the term when it
+   * was pushed. The queue is lazy: the value of a term may be increased while
+   * it is in the queue, in which case the term is pushed again and its older
+   * entries are skipped.
+   */
+  struct QueueEntry {
+    BitVector value;
+    TermId id;
+    QueueEntry(const BitVector& v, TermId i) : value(v), id(i) {}
+  };
 
-      return (*(d_model->find(left))).second.value < (*(d_model->find(right))).second.value; 
+  /** Orders the queue by increasing value */
+  struct QueueComparator {
+    bool operator() (const QueueEntry& left, const QueueEntry& right) const {
+      return right.value < left.value;
     }
   }; 
 
@@ -108,7 +114,7 @@ class InequalityGraph : public context::ContextNotifyObj{
   typedef std::vector<InequalityEdge> Edges; 
   typedef std::unordered_set<TermId> TermIdSet;
 
-  typedef std::priority_queue<TermId, std::vector<TermId>, QueueComparator> BFSQueue; 
+  typedef std::priority_queue<QueueEntry, std::vector<QueueEntry>, QueueComparator> BFSQueue; 
   typedef std::unordered_set<TNode, TNodeHashFunction> TNodeSet;
   typedef std::unordered_set<Node, NodeHashFunction> NodeSet;
 
@@ -126,6 +132,13 @@ class InequalityGraph : public context::ContextNotifyObj{
   context::CDO<bool> d_inConflict;
   std::vector<TNode> d_conflict;
 
+  /**
+   * The terms visited by the current call to computeExplanation are the ones
+   * whose stamp is d_explanationStamp.
+   */
+  std::vector<unsigned> d_explanationSeen;
+  unsigned d_explanationStamp;
+
   ModelValues  d_modelValues;
   void initializeModelValue(TNode node); 
   void setModelValue(TermId term, const ModelValue& mv);
@@ -226,6 +239,8 @@ public:
       d_ineqEdges(),
       d_inConflict(c, false),
       d_conflict(),
+      d_explanationSeen(),
+      d_explanationStamp(0),
       d_modelValues(c),
       d_disequalities(c),
       d_disequalitiesAlreadySplit(u),
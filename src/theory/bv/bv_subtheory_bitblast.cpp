@@ -22,6 +22,7 @@
 #include "smt/smt_statistics_registry.h"
 #include "theory/bv/abstraction.h"
 #include "theory/bv/bitblast/lazy_bitblaster.h"
+#include "theory/bv/bv_core_cache.h"
 #include "theory/bv/bv_quick_check.h"
 #include "theory/bv/theory_bv.h"
 #include "theory/bv/theory_bv_utils.h"
@@ -43,13 +44,18 @@ BitblastSolver::BitblastSolver(context::Context* c, TheoryBV* bv)
       d_useSatPropagation(options::bitvectorPropagate()),
       d_abstractionModule(NULL),
       d_quickCheck(),
-      d_quickXplain()
+      d_quickXplain(),
+      d_coreCache()
 {
-  if (options::bitvectorQuickXplain())
+  if (options::bitvectorQuickXplain() || options::bvCoreCache())
   {
     d_quickCheck.reset(new BVQuickCheck("bb", bv));
     d_quickXplain.reset(new QuickXPlain("bb", d_quickCheck.get()));
   }
+  if (options::bvCoreCache())
+  {
+    d_coreCache.reset(new CoreCache(options::bvCoreCacheSize()));
+  }
 }
 
 BitblastSolver::~BitblastSolver() {}
@@ -57,13 +63,16 @@ BitblastSolver::~BitblastSolver() {}
 BitblastSolver::Statistics::Statistics()
   : d_numCallstoCheck("theory::bv::BitblastSolver::NumCallsToCheck", 0)
   , d_numBBLemmas("theory::bv::BitblastSolver::NumTimesLemmasBB", 0)
+  , d_numCoreCacheHits("theory::bv::BitblastSolver::NumCoreCacheHits", 0)
 {
   smtStatisticsRegistry()->registerStat(&d_numCallstoCheck);
   smtStatisticsRegistry()->registerStat(&d_numBBLemmas);
+  smtStatisticsRegistry()->registerStat(&d_numCoreCacheHits);
 }
 BitblastSolver::Statistics::~Statistics() {
   smtStatisticsRegistry()->unregisterStat(&d_numCallstoCheck);
   smtStatisticsRegistry()->unregisterStat(&d_numBBLemmas);
+  smtStatisticsRegistry()->unregisterStat(&d_numCoreCacheHits);
 }
 
 void BitblastSolver::setAbstraction(AbstractionModule* abs) {
@@ -189,6 +198,10 @@ bool BitblastSolver::check(Theory::Effort e)
   if (e == Theory::EFFORT_FULL)
   {
     Assert(!d_bv->inConflict());
+    if (d_coreCache && checkCoreCache())
+    {
+      return false;
+    }
     Debug("bitvector::bitblaster")
         << "BitblastSolver::addAssertions solving. \n";
     bool ok = d_bitblaster->solve();
@@ -273,9 +286,56 @@ void BitblastSolver::setConflict(TNode conflict) {
     final_conflict = d_quickXplain->minimizeConflict(conflict);
     //std::cout << "Minimized conflict " << final_conflict.getNumChildren() << "\n";
   }
+  if (d_coreCache)
+  {
+    std::vector<Node> core;
+    if (final_conflict.getKind() == kind::AND)
+    {
+      core.insert(core.end(), final_conflict.begin(), final_conflict.end());
+    }
+    else
+    {
+      core.push_back(final_conflict);
+    }
+    d_coreCache->addCore(core, options::bitvectorQuickXplain());
+  }
   d_bv->setConflict(final_conflict);
 }
 
+bool BitblastSolver::checkCoreCache()
+{
+  CoreCache::LiteralSet asserted(assertionsBegin(), assertionsEnd());
+  std::vector<Node> core;
+  bool minimized;
+  if (!d_coreCache->findCore(asserted, core, minimized))
+  {
+    return false;
+  }
+  ++(d_statistics.d_numCoreCacheHits);
+  Node conflict = utils::mkAnd(core);
+  Debug("bv-bitblast") << "BitblastSolver::checkCoreCache " << conflict
+                       << "\n";
+  if (!minimized && core.size() > 1)
+  {
+    // the conflict is reused, so it is worth minimizing
+    d_coreCache->removeCore(core);
+    Node minimal = d_quickXplain->minimizeConflict(conflict);
+    core.clear();
+    if (minimal.getKind() == kind::AND)
+    {
+      core.insert(core.end(), minimal.begin(), minimal.end());
+    }
+    else
+    {
+      core.push_back(minimal);
+    }
+    d_coreCache->addCore(core, true);
+    conflict = minimal;
+  }
+  d_bv->setConflict(conflict);
+  return true;
+}
+
 void BitblastSolver::setProofLog(proof::BitVectorProof* bvp)
 {
   d_bitblaster->setProofLog( bvp );
@@ -34,6 +34,7 @@ namespace bv {
 class TLazyBitblaster;
 class AbstractionModule;
 class BVQuickCheck;
+class CoreCache;
 class QuickXPlain;
 
 /**
@@ -43,6 +44,7 @@ class BitblastSolver : public SubtheorySolver {
   struct Statistics {
     IntStat d_numCallstoCheck;
     IntStat d_numBBLemmas;
+    IntStat d_numCoreCacheHits;
     Statistics();
     ~Statistics();
   };
@@ -63,8 +65,16 @@ class BitblastSolver : public SubtheorySolver {
   AbstractionModule* d_abstractionModule;
   std::unique_ptr<BVQuickCheck> d_quickCheck;
   std::unique_ptr<QuickXPlain> d_quickXplain;
+  /** The conflicts found so far, see --bv-core-cache */
+  std::unique_ptr<CoreCache> d_coreCache;
   //  Node getModelValueRec(TNode node);
   void setConflict(TNode conflict);
+  /**
+   * Reports a cached conflict if all its literals are asserted, and returns
+   * true if it did.  A cached conflict is minimized the first time it is
+   * reported again.
+   */
+  bool checkCoreCache();
 public:
   BitblastSolver(context::Context* c, TheoryBV* bv);
   ~BitblastSolver();
@@ -36,12 +36,11 @@ CoreSolver::CoreSolver(context::Context* c, TheoryBV* bv)
   : SubtheorySolver(c, bv),
     d_notify(*this),
     d_equalityEngine(d_notify, c, "theory::bv::ee", true),
-    d_slicer(new Slicer()),
+    d_slicer(new Slicer(bv->getUserContext())),
     d_isComplete(c, true),
     d_lemmaThreshold(16),
     d_useSlicer(false),
     d_preregisterCalled(false),
-    d_checkCalled(false),
     d_reasons(c)
 {
   // The kinds we are treating as function application in congruence
@@ -86,7 +85,12 @@ void CoreSolver::setMasterEqualityEngine(eq::EqualityEngine* eq) {
 }
 
 void CoreSolver::enableSlicer() {
-  AlwaysAssert(!d_preregisterCalled);
+  // the slicer has to process all the equalities, so it cannot be enabled once
+  // some were registered, e.g. by a previous check in incremental mode
+  if (d_preregisterCalled)
+  {
+    return;
+  }
   d_useSlicer = true;
   d_statistics.d_slicerEnabled.setData(true);
 }
@@ -96,8 +100,10 @@ void CoreSolver::preRegister(TNode node) {
   if (node.getKind() == kind::EQUAL) {
       d_equalityEngine.addTriggerEquality(node);
       if (d_useSlicer) {
+        // in incremental mode, the slicing may be refined after some facts
+        // were decomposed, which only makes the core solver weaker since the
+        // decompositions it asserts are valid
         d_slicer->processEquality(node);
-        AlwaysAssert(!d_checkCalled);
       }
   } else {
     d_equalityEngine.addTerm(node);
@@ -173,7 +179,6 @@ bool CoreSolver::check(Theory::Effort e) {
 
   d_bv->spendResource(ResourceManager::Resource::TheoryCheckStep);
 
-  d_checkCalled = true;
   Assert(!d_bv->inConflict());
   ++(d_statistics.d_numCallstoCheck);
   bool ok = true;
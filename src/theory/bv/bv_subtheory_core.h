@@ -89,7 +89,6 @@ class CoreSolver : public SubtheorySolver {
   /** Used to ensure that the core slicer is used properly*/
   bool d_useSlicer;
   bool d_preregisterCalled;
-  bool d_checkCalled;
   
   /** To make sure we keep the explanations */
   context::CDHashSet<Node, NodeHashFunction> d_reasons;
@@ -0,0 +1,1173 @@
+/*********************                                                        */
+/*! \file bv_subtheory_domain.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Word-level propagation of the domains of bit-vector terms.
+ **
+ ** Word-level propagation of the domains of bit-vector terms.
+ **/
+
+#include "theory/bv/bv_subtheory_domain.h"
+
+#include "smt/smt_statistics_registry.h"
+#include "theory/bv/theory_bv.h"
+#include "theory/bv/theory_bv_utils.h"
+
+using namespace std;
+using namespace CVC4;
+using namespace CVC4::context;
+using namespace CVC4::theory;
+using namespace CVC4::theory::bv;
+
+namespace {
+
+/** The maximal number of propagation rounds of DomainPropagator */
+const unsigned s_maxRounds = 16;
+
+/** Returns the bit-vector of the given size whose n lowest bits are set. */
+BitVector lowOnes(unsigned size, unsigned n)
+{
+  if (n == 0)
+  {
+    return BitVector(size);
+  }
+  if (n >= size)
+  {
+    return BitVector::mkOnes(size);
+  }
+  return BitVector::mkOnes(n).zeroExtend(size - n);
+}
+
+BitVector signBit(unsigned size) { return BitVector(size).setBit(size - 1); }
+
+const BitVector& bvMin(const BitVector& a, const BitVector& b)
+{
+  return a.unsignedLessThan(b) ? a : b;
+}
+
+const BitVector& bvMax(const BitVector& a, const BitVector& b)
+{
+  return a.unsignedLessThan(b) ? b : a;
+}
+
+/** Returns the number of lowest bits of d that are known. */
+unsigned knownLowBits(const BVDomain& d)
+{
+  unsigned i = 0;
+  while (i < d.getSize() && d.getMask().isBitSet(i))
+  {
+    ++i;
+  }
+  return i;
+}
+
+/** Returns the number of lowest bits of d that are known to be 0. */
+unsigned knownTrailingZeros(const BVDomain& d)
+{
+  unsigned i = 0;
+  while (i < d.getSize() && d.getMask().isBitSet(i) && !d.getBits().isBitSet(i))
+  {
+    ++i;
+  }
+  return i;
+}
+
+/** Returns the inverse of the odd c modulo 2^size. */
+BitVector inverse(const BitVector& c)
+{
+  Assert(c.isBitSet(0));
+  unsigned size = c.getSize();
+  BitVector one(size, 1u);
+  BitVector two(size, 2u);
+  // Newton's iteration doubles the number of correct bits each time
+  BitVector inv = c;
+  while (c * inv != one)
+  {
+    inv = inv * (two - c * inv);
+  }
+  return inv;
+}
+
+/** Places bv at bit low of a bit-vector of the given size. */
+BitVector place(const BitVector& bv, unsigned size, unsigned low)
+{
+  BitVector res = bv;
+  if (low > 0)
+  {
+    res = res.concat(BitVector(low));
+  }
+  if (res.getSize() < size)
+  {
+    res = res.zeroExtend(size - res.getSize());
+  }
+  return res;
+}
+
+BVDomain forwardNot(const BVDomain& a)
+{
+  BVDomain res(a.getSize());
+  res.fixBits(a.getMask(), ~a.getBits() & a.getMask());
+  res.restrict(~a.getMax(), ~a.getMin());
+  res.restrictSigned(~a.getSignedMax(), ~a.getSignedMin());
+  return res;
+}
+
+BVDomain forwardAnd(const BVDomain& a, const BVDomain& b)
+{
+  BVDomain res(a.getSize());
+  BitVector ones = a.getBits() & b.getBits();
+  BitVector zeros = (a.getMask() & ~a.getBits()) | (b.getMask() & ~b.getBits());
+  res.fixBits(ones | zeros, ones);
+  res.restrict(BitVector(a.getSize()), bvMin(a.getMax(), b.getMax()));
+  return res;
+}
+
+BVDomain forwardOr(const BVDomain& a, const BVDomain& b)
+{
+  BVDomain res(a.getSize());
+  BitVector ones = a.getBits() | b.getBits();
+  BitVector zeros = (a.getMask() & ~a.getBits()) & (b.getMask() & ~b.getBits());
+  res.fixBits(ones | zeros, ones);
+  res.restrict(bvMax(a.getMin(), b.getMin()), BitVector::mkOnes(a.getSize()));
+  return res;
+}
+
+BVDomain forwardXor(const BVDomain& a, const BVDomain& b)
+{
+  BVDomain res(a.getSize());
+  BitVector mask = a.getMask() & b.getMask();
+  res.fixBits(mask, (a.getBits() ^ b.getBits()) & mask);
+  return res;
+}
+
+BVDomain forwardConcat(const BVDomain& a, const BVDomain& b)
+{
+  BVDomain res(a.getSize() + b.getSize());
+  res.fixBits(a.getMask().concat(b.getMask()), a.getBits().concat(b.getBits()));
+  res.restrict(a.getMin().concat(b.getMin()), a.getMax().concat(b.getMax()));
+  return res;
+}
+
+BVDomain forwardExtract(const BVDomain& a, unsigned high, unsigned low)
+{
+  unsigned size = a.getSize();
+  BVDomain res(high - low + 1);
+  res.fixBits(a.getMask().extract(high, low), a.getBits().extract(high, low));
+  // the extract is monotone on the values that agree above high
+  if (high + 1 == size
+      || a.getMin().extract(size - 1, high + 1)
+             == a.getMax().extract(size - 1, high + 1))
+  {
+    res.restrict(a.getMin().extract(high, low), a.getMax().extract(high, low));
+  }
+  return res;
+}
+
+BVDomain forwardZeroExtend(const BVDomain& a, unsigned n)
+{
+  unsigned size = a.getSize() + n;
+  BVDomain res(size);
+  res.fixBits(a.getMask().zeroExtend(n) | ~lowOnes(size, a.getSize()),
+              a.getBits().zeroExtend(n));
+  res.restrict(a.getMin().zeroExtend(n), a.getMax().zeroExtend(n));
+  return res;
+}
+
+BVDomain forwardSignExtend(const BVDomain& a, unsigned n)
+{
+  BVDomain res(a.getSize() + n);
+  res.fixBits(a.getMask().signExtend(n), a.getBits().signExtend(n));
+  res.restrictSigned(a.getSignedMin().signExtend(n),
+                     a.getSignedMax().signExtend(n));
+  return res;
+}
+
+BVDomain forwardAdd(const BVDomain& a, const BVDomain& b)
+{
+  unsigned size = a.getSize();
+  BVDomain res(size);
+  // ripple the known bits through the adder, with -1 for an unknown bit
+  BitVector mask(size);
+  BitVector bits(size);
+  int carry = 0;
+  for (unsigned i = 0; i < size; ++i)
+  {
+    int x = a.getMask().isBitSet(i) ? a.getBits().isBitSet(i) : -1;
+    int y = b.getMask().isBitSet(i) ? b.getBits().isBitSet(i) : -1;
+    if (x >= 0 && y >= 0 && carry >= 0)
+    {
+      mask = mask.setBit(i);
+      if ((x + y + carry) % 2 == 1)
+      {
+        bits = bits.setBit(i);
+      }
+      carry = (x + y + carry) / 2;
+    }
+    else if (x >= 0 && (x == y || x == carry))
+    {
+      carry = x;
+    }
+    else if (y >= 0 && y == carry)
+    {
+      carry = y;
+    }
+    else
+    {
+      carry = -1;
+    }
+  }
+  res.fixBits(mask, bits);
+  // the unsigned range, if all sums overflow or none does
+  Integer modulus = Integer(1).multiplyByPow2(size);
+  Integer lo = a.getMin().toInteger() + b.getMin().toInteger();
+  Integer hi = a.getMax().toInteger() + b.getMax().toInteger();
+  if (hi < modulus || lo >= modulus)
+  {
+    res.restrict(BitVector(size, lo), BitVector(size, hi));
+  }
+  // the signed range, if no sum overflows
+  Integer half = Integer(1).multiplyByPow2(size - 1);
+  Integer slo = a.getSignedMin().toSignedInteger()
+                + b.getSignedMin().toSignedInteger();
+  Integer shi = a.getSignedMax().toSignedInteger()
+                + b.getSignedMax().toSignedInteger();
+  if (slo >= -half && shi < half)
+  {
+    res.restrictSigned(BitVector(size, slo), BitVector(size, shi));
+  }
+  return res;
+}
+
+BVDomain forwardNeg(const BVDomain& a)
+{
+  return forwardAdd(forwardNot(a), BVDomain(BitVector(a.getSize(), 1u)));
+}
+
+BVDomain forwardMul(const BVDomain& a, const BVDomain& b)
+{
+  unsigned size = a.getSize();
+  BVDomain res(size);
+  // the low bits of the product depend only on the low bits of the factors
+  unsigned low = std::min(knownLowBits(a), knownLowBits(b));
+  BitVector lowMask = lowOnes(size, low);
+  res.fixBits(lowMask, (a.getBits() * b.getBits()) & lowMask);
+  unsigned zeros = knownTrailingZeros(a) + knownTrailingZeros(b);
+  res.fixBits(lowOnes(size, zeros), BitVector(size));
+  // the unsigned range, if no product overflows
+  Integer hi = a.getMax().toInteger() * b.getMax().toInteger();
+  if (hi < Integer(1).multiplyByPow2(size))
+  {
+    res.restrict(BitVector(size, a.getMin().toInteger() * b.getMin().toInteger()),
+                 BitVector(size, hi));
+  }
+  return res;
+}
+
+BVDomain forwardShl(const BVDomain& a, const BVDomain& s)
+{
+  unsigned size = a.getSize();
+  BVDomain res(size);
+  if (s.getMin().toInteger() >= size)
+  {
+    return BVDomain(BitVector(size));
+  }
+  unsigned min = s.getMin().toInteger().getUnsignedInt();
+  if (s.isFixed())
+  {
+    res.fixBits(a.getMask().leftShift(s.getBits()) | lowOnes(size, min),
+                a.getBits().leftShift(s.getBits()));
+  }
+  else
+  {
+    res.fixBits(lowOnes(size, min), BitVector(size));
+  }
+  return res;
+}
+
+BVDomain forwardLshr(const BVDomain& a, const BVDomain& s)
+{
+  unsigned size = a.getSize();
+  BVDomain res(size);
+  if (s.getMin().toInteger() >= size)
+  {
+    return BVDomain(BitVector(size));
+  }
+  unsigned min = s.getMin().toInteger().getUnsignedInt();
+  BitVector top = ~lowOnes(size, size - min);
+  if (s.isFixed())
+  {
+    res.fixBits(a.getMask().logicalRightShift(s.getBits()) | top,
+                a.getBits().logicalRightShift(s.getBits()));
+    res.restrict(a.getMin().logicalRightShift(s.getBits()),
+                 a.getMax().logicalRightShift(s.getBits()));
+  }
+  else
+  {
+    res.fixBits(top, BitVector(size));
+    res.restrict(BitVector(size), a.getMax().logicalRightShift(s.getMin()));
+  }
+  return res;
+}
+
+BVDomain forwardAshr(const BVDomain& a, const BVDomain& s)
+{
+  BVDomain res(a.getSize());
+  if (s.isFixed())
+  {
+    res.fixBits(a.getMask().arithRightShift(s.getBits()),
+                a.getBits().arithRightShift(s.getBits()));
+    res.restrictSigned(a.getSignedMin().arithRightShift(s.getBits()),
+                       a.getSignedMax().arithRightShift(s.getBits()));
+  }
+  return res;
+}
+
+BVDomain forwardUdiv(const BVDomain& a, const BVDomain& b)
+{
+  BVDomain res(a.getSize());
+  if (b.isFixed() && b.getBits() != BitVector(b.getSize()))
+  {
+    res.restrict(a.getMin().unsignedDivTotal(b.getBits()),
+                 a.getMax().unsignedDivTotal(b.getBits()));
+  }
+  return res;
+}
+
+BVDomain forwardUrem(const BVDomain& a, const BVDomain& b)
+{
+  unsigned size = a.getSize();
+  BVDomain res(size);
+  // the remainder of a division by 0 is the dividend
+  res.restrict(BitVector(size), a.getMax());
+  if (b.isFixed() && b.getBits() != BitVector(size))
+  {
+    res.restrict(BitVector(size), b.getBits() - BitVector(size, 1u));
+  }
+  return res;
+}
+
+/** Returns true if the children of t have domains. */
+bool hasDomainChildren(TNode t)
+{
+  switch (t.getKind())
+  {
+    case kind::BITVECTOR_NOT:
+    case kind::BITVECTOR_AND:
+    case kind::BITVECTOR_OR:
+    case kind::BITVECTOR_XOR:
+    case kind::BITVECTOR_CONCAT:
+    case kind::BITVECTOR_EXTRACT:
+    case kind::BITVECTOR_ZERO_EXTEND:
+    case kind::BITVECTOR_SIGN_EXTEND:
+    case kind::BITVECTOR_PLUS:
+    case kind::BITVECTOR_SUB:
+    case kind::BITVECTOR_NEG:
+    case kind::BITVECTOR_MULT:
+    case kind::BITVECTOR_SHL:
+    case kind::BITVECTOR_LSHR:
+    case kind::BITVECTOR_ASHR:
+    case kind::BITVECTOR_UDIV_TOTAL:
+    case kind::BITVECTOR_UREM_TOTAL:
+    case kind::ITE: return true;
+    default: return false;
+  }
+}
+
+}  // namespace
+
+/* -------------------------------------------------------------------------- */
+
+BVDomain::BVDomain(unsigned size)
+    : d_empty(false),
+      d_mask(size),
+      d_bits(size),
+      d_min(size),
+      d_max(BitVector::mkOnes(size)),
+      d_smin(size),
+      d_smax(BitVector::mkOnes(size))
+{
+}
+
+BVDomain::BVDomain(const BitVector& value)
+    : d_empty(false),
+      d_mask(BitVector::mkOnes(value.getSize())),
+      d_bits(value),
+      d_min(value),
+      d_max(value),
+      d_smin(value ^ signBit(value.getSize())),
+      d_smax(value ^ signBit(value.getSize()))
+{
+}
+
+bool BVDomain::isFixed() const
+{
+  return d_mask == BitVector::mkOnes(getSize());
+}
+
+BitVector BVDomain::getSignedMin() const
+{
+  return d_smin ^ signBit(getSize());
+}
+
+BitVector BVDomain::getSignedMax() const
+{
+  return d_smax ^ signBit(getSize());
+}
+
+void BVDomain::setEmpty() { d_empty = true; }
+
+bool BVDomain::fixBits(const BitVector& mask, const BitVector& bits)
+{
+  if (d_empty)
+  {
+    return false;
+  }
+  BitVector fixed = bits & mask;
+  if ((d_mask & mask & (d_bits ^ fixed)) != BitVector(getSize()))
+  {
+    setEmpty();
+    return true;
+  }
+  if ((d_mask | mask) == d_mask)
+  {
+    return false;
+  }
+  d_mask = d_mask | mask;
+  d_bits = d_bits | fixed;
+  normalize();
+  return true;
+}
+
+bool BVDomain::restrict(const BitVector& lo, const BitVector& hi)
+{
+  if (d_empty || !tighten(d_min, d_max, lo, hi))
+  {
+    return false;
+  }
+  normalize();
+  return true;
+}
+
+bool BVDomain::restrictSigned(const BitVector& lo, const BitVector& hi)
+{
+  BitVector sign = signBit(getSize());
+  if (d_empty || !tighten(d_smin, d_smax, lo ^ sign, hi ^ sign))
+  {
+    return false;
+  }
+  normalize();
+  return true;
+}
+
+bool BVDomain::meet(const BVDomain& other)
+{
+  Assert(getSize() == other.getSize());
+  if (d_empty)
+  {
+    return false;
+  }
+  if (other.d_empty)
+  {
+    setEmpty();
+    return true;
+  }
+  if ((d_mask & other.d_mask & (d_bits ^ other.d_bits)) != BitVector(getSize()))
+  {
+    setEmpty();
+    return true;
+  }
+  bool changed = (d_mask | other.d_mask) != d_mask;
+  d_mask = d_mask | other.d_mask;
+  d_bits = d_bits | other.d_bits;
+  changed |= tighten(d_min, d_max, other.d_min, other.d_max);
+  changed |= tighten(d_smin, d_smax, other.d_smin, other.d_smax);
+  if (changed)
+  {
+    normalize();
+  }
+  return changed;
+}
+
+BVDomain BVDomain::join(const BVDomain& a, const BVDomain& b)
+{
+  Assert(a.getSize() == b.getSize());
+  if (a.d_empty)
+  {
+    return b;
+  }
+  if (b.d_empty)
+  {
+    return a;
+  }
+  BVDomain res(a.getSize());
+  res.d_mask = a.d_mask & b.d_mask & ~(a.d_bits ^ b.d_bits);
+  res.d_bits = a.d_bits & res.d_mask;
+  res.d_min = bvMin(a.d_min, b.d_min);
+  res.d_max = bvMax(a.d_max, b.d_max);
+  res.d_smin = bvMin(a.d_smin, b.d_smin);
+  res.d_smax = bvMax(a.d_smax, b.d_smax);
+  res.normalize();
+  return res;
+}
+
+bool BVDomain::tighten(BitVector& lo,
+                       BitVector& hi,
+                       const BitVector& l,
+                       const BitVector& h)
+{
+  bool changed = false;
+  if (lo.unsignedLessThan(l))
+  {
+    lo = l;
+    changed = true;
+  }
+  if (h.unsignedLessThan(hi))
+  {
+    hi = h;
+    changed = true;
+  }
+  if (hi.unsignedLessThan(lo))
+  {
+    setEmpty();
+  }
+  return changed;
+}
+
+bool BVDomain::fixPrefix(const BitVector& lo,
+                         const BitVector& hi,
+                         const BitVector& flip)
+{
+  unsigned size = getSize();
+  Integer diff = (lo ^ hi).toInteger();
+  unsigned free = diff.isZero() ? 0 : diff.length();
+  if (free == size)
+  {
+    return false;
+  }
+  // all values of [lo, hi] agree on the bits above the highest differing bit
+  BitVector prefix = ~lowOnes(size, free);
+  BitVector bits = (lo ^ flip) & prefix;
+  if ((d_mask & prefix & (d_bits ^ bits)) != BitVector(size))
+  {
+    setEmpty();
+    return true;
+  }
+  if ((d_mask | prefix) == d_mask)
+  {
+    return false;
+  }
+  d_mask = d_mask | prefix;
+  d_bits = d_bits | bits;
+  return true;
+}
+
+void BVDomain::normalize()
+{
+  unsigned size = getSize();
+  BitVector sign = signBit(size);
+  // the propagation between the components is cut off after a few rounds,
+  // the domain solver calls it again the next time the domain changes
+  for (unsigned i = 0; i < 4 && !d_empty; ++i)
+  {
+    bool changed = false;
+    // known bits -> ranges
+    changed |= tighten(d_min, d_max, d_bits, d_bits | ~d_mask);
+    BitVector sbits = d_bits ^ (sign & d_mask);
+    changed |= tighten(d_smin, d_smax, sbits, sbits | ~d_mask);
+    if (d_empty)
+    {
+      break;
+    }
+    // ranges -> known bits
+    changed |= fixPrefix(d_min, d_max, BitVector(size));
+    changed |= fixPrefix(d_smin, d_smax, sign);
+    if (d_empty)
+    {
+      break;
+    }
+    // unsigned range <-> signed range, if the range does not cross the sign
+    if (d_min.isBitSet(size - 1) == d_max.isBitSet(size - 1))
+    {
+      changed |= tighten(d_smin, d_smax, d_min ^ sign, d_max ^ sign);
+    }
+    if (d_smin.isBitSet(size - 1) == d_smax.isBitSet(size - 1))
+    {
+      changed |= tighten(d_min, d_max, d_smin ^ sign, d_smax ^ sign);
+    }
+    if (!changed)
+    {
+      break;
+    }
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool DomainPropagator::isDomainFact(TNode fact)
+{
+  TNode atom = fact.getKind() == kind::NOT ? fact[0] : fact;
+  switch (atom.getKind())
+  {
+    case kind::EQUAL: return atom[0].getType().isBitVector();
+    case kind::BITVECTOR_ULT:
+    case kind::BITVECTOR_ULE:
+    case kind::BITVECTOR_SLT:
+    case kind::BITVECTOR_SLE: return true;
+    default: return false;
+  }
+}
+
+int DomainPropagator::getIndex(TNode t) const
+{
+  std::unordered_map<TNode, unsigned, TNodeHashFunction>::const_iterator it =
+      d_index.find(t);
+  return it == d_index.end() ? -1 : it->second;
+}
+
+void DomainPropagator::addTerm(TNode t)
+{
+  std::vector<std::pair<TNode, bool> > visit;
+  visit.push_back(std::make_pair(t, false));
+  while (!visit.empty())
+  {
+    TNode current = visit.back().first;
+    bool expanded = visit.back().second;
+    visit.pop_back();
+    if (d_index.find(current) != d_index.end())
+    {
+      continue;
+    }
+    if (expanded || !hasDomainChildren(current))
+    {
+      d_index[current] = d_terms.size();
+      d_terms.push_back(current);
+      d_domains.push_back(BVDomain(utils::getSize(current)));
+      continue;
+    }
+    visit.push_back(std::make_pair(current, true));
+    // the condition of an ITE is not a bit-vector
+    for (unsigned i = current.getKind() == kind::ITE ? 1 : 0;
+         i < current.getNumChildren();
+         ++i)
+    {
+      visit.push_back(std::make_pair(current[i], false));
+    }
+  }
+}
+
+BVDomain DomainPropagator::forward(TNode t) const
+{
+  unsigned size = utils::getSize(t);
+  std::vector<const BVDomain*> children;
+  for (unsigned i = t.getKind() == kind::ITE ? 1 : 0; i < t.getNumChildren();
+       ++i)
+  {
+    int index = getIndex(t[i]);
+    if (index < 0)
+    {
+      return BVDomain(size);
+    }
+    children.push_back(&d_domains[index]);
+  }
+  switch (t.getKind())
+  {
+    case kind::CONST_BITVECTOR: return BVDomain(t.getConst<BitVector>());
+    case kind::BITVECTOR_NOT: return forwardNot(*children[0]);
+    case kind::BITVECTOR_EXTRACT:
+      return forwardExtract(*children[0],
+                            utils::getExtractHigh(t),
+                            utils::getExtractLow(t));
+    case kind::BITVECTOR_ZERO_EXTEND:
+      return forwardZeroExtend(*children[0], size - children[0]->getSize());
+    case kind::BITVECTOR_SIGN_EXTEND:
+      return forwardSignExtend(*children[0], size - children[0]->getSize());
+    case kind::BITVECTOR_NEG: return forwardNeg(*children[0]);
+    case kind::BITVECTOR_SUB:
+      return forwardAdd(*children[0], forwardNeg(*children[1]));
+    case kind::BITVECTOR_SHL: return forwardShl(*children[0], *children[1]);
+    case kind::BITVECTOR_LSHR: return forwardLshr(*children[0], *children[1]);
+    case kind::BITVECTOR_ASHR: return forwardAshr(*children[0], *children[1]);
+    case kind::BITVECTOR_UDIV_TOTAL:
+      return forwardUdiv(*children[0], *children[1]);
+    case kind::BITVECTOR_UREM_TOTAL:
+      return forwardUrem(*children[0], *children[1]);
+    case kind::ITE: return BVDomain::join(*children[0], *children[1]);
+    case kind::BITVECTOR_AND:
+    case kind::BITVECTOR_OR:
+    case kind::BITVECTOR_XOR:
+    case kind::BITVECTOR_CONCAT:
+    case kind::BITVECTOR_PLUS:
+    case kind::BITVECTOR_MULT:
+    {
+      BVDomain res = *children[0];
+      for (unsigned i = 1; i < children.size(); ++i)
+      {
+        switch (t.getKind())
+        {
+          case kind::BITVECTOR_AND: res = forwardAnd(res, *children[i]); break;
+          case kind::BITVECTOR_OR: res = forwardOr(res, *children[i]); break;
+          case kind::BITVECTOR_XOR: res = forwardXor(res, *children[i]); break;
+          case kind::BITVECTOR_CONCAT:
+            res = forwardConcat(res, *children[i]);
+            break;
+          case kind::BITVECTOR_PLUS: res = forwardAdd(res, *children[i]); break;
+          default: res = forwardMul(res, *children[i]); break;
+        }
+      }
+      return res;
+    }
+    default: return BVDomain(size);
+  }
+}
+
+bool DomainPropagator::meet(TNode t, const BVDomain& d, bool& changed)
+{
+  BVDomain& domain = d_domains[d_index[t]];
+  if (domain.meet(d))
+  {
+    changed = true;
+  }
+  return !domain.isEmpty();
+}
+
+bool DomainPropagator::backward(TNode t, bool& changed)
+{
+  if (!hasDomainChildren(t))
+  {
+    return true;
+  }
+  // copied, as the meets below may change the domains of the children
+  BVDomain d = d_domains[d_index[t]];
+  unsigned size = d.getSize();
+  switch (t.getKind())
+  {
+    case kind::BITVECTOR_NOT: return meet(t[0], forwardNot(d), changed);
+    case kind::BITVECTOR_AND:
+    case kind::BITVECTOR_OR:
+    {
+      bool isAnd = t.getKind() == kind::BITVECTOR_AND;
+      // the bits that all children have
+      BitVector mask = isAnd ? d.getBits() : d.getMask() & ~d.getBits();
+      BVDomain all(size);
+      all.fixBits(mask, isAnd ? d.getBits() : BitVector(size));
+      if (isAnd)
+      {
+        all.restrict(d.getMin(), BitVector::mkOnes(size));
+      }
+      else
+      {
+        all.restrict(BitVector(size), d.getMax());
+      }
+      for (unsigned i = 0; i < t.getNumChildren(); ++i)
+      {
+        if (!meet(t[i], all, changed))
+        {
+          return false;
+        }
+      }
+      if (t.getNumChildren() == 2)
+      {
+        // a bit of the result differs from the bit of one child only where
+        // the other child decides it
+        for (unsigned i = 0; i < 2; ++i)
+        {
+          const BVDomain& other = d_domains[d_index[t[1 - i]]];
+          BitVector decided =
+              isAnd ? d.getMask() & ~d.getBits() & other.getBits()
+                    : d.getBits() & other.getMask() & ~other.getBits();
+          BVDomain child(size);
+          child.fixBits(decided, isAnd ? BitVector(size) : decided);
+          if (!meet(t[i], child, changed))
+          {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+    case kind::BITVECTOR_XOR:
+    case kind::BITVECTOR_PLUS:
+    case kind::BITVECTOR_MULT:
+    {
+      if (t.getNumChildren() != 2)
+      {
+        return true;
+      }
+      for (unsigned i = 0; i < 2; ++i)
+      {
+        BVDomain other = d_domains[d_index[t[1 - i]]];
+        if (t.getKind() == kind::BITVECTOR_XOR)
+        {
+          if (!meet(t[i], forwardXor(d, other), changed)) return false;
+        }
+        else if (t.getKind() == kind::BITVECTOR_PLUS)
+        {
+          if (!meet(t[i], forwardAdd(d, forwardNeg(other)), changed))
+            return false;
+        }
+        else if (other.isFixed() && other.getBits().isBitSet(0))
+        {
+          // the multiplication by an odd constant is invertible
+          BVDomain inv(inverse(other.getBits()));
+          if (!meet(t[i], forwardMul(d, inv), changed)) return false;
+        }
+      }
+      return true;
+    }
+    case kind::BITVECTOR_CONCAT:
+    {
+      unsigned high = size;
+      for (unsigned i = 0; i < t.getNumChildren(); ++i)
+      {
+        unsigned childSize = utils::getSize(t[i]);
+        if (!meet(t[i], forwardExtract(d, high - 1, high - childSize), changed))
+        {
+          return false;
+        }
+        high -= childSize;
+      }
+      return true;
+    }
+    case kind::BITVECTOR_EXTRACT:
+    {
+      unsigned childSize = utils::getSize(t[0]);
+      unsigned low = utils::getExtractLow(t);
+      BVDomain child(childSize);
+      child.fixBits(place(d.getMask(), childSize, low),
+                    place(d.getBits(), childSize, low));
+      return meet(t[0], child, changed);
+    }
+    case kind::BITVECTOR_ZERO_EXTEND:
+    case kind::BITVECTOR_SIGN_EXTEND:
+      return meet(t[0], forwardExtract(d, utils::getSize(t[0]) - 1, 0), changed);
+    case kind::BITVECTOR_NEG: return meet(t[0], forwardNeg(d), changed);
+    default: return true;
+  }
+}
+
+bool DomainPropagator::applyFact(TNode fact, bool& changed)
+{
+  bool polarity = fact.getKind() != kind::NOT;
+  TNode atom = polarity ? fact : fact[0];
+  Kind k = atom.getKind();
+  TNode a = atom[0];
+  TNode b = atom[1];
+  BVDomain da = d_domains[d_index[a]];
+  BVDomain db = d_domains[d_index[b]];
+  if (k == kind::EQUAL)
+  {
+    if (!polarity)
+    {
+      return !(da.isFixed() && db.isFixed() && da.getBits() == db.getBits());
+    }
+    return meet(a, db, changed) && meet(b, da, changed);
+  }
+  // a < b, a <= b, or their negations b <= a and b < a
+  bool strict = (k == kind::BITVECTOR_ULT || k == kind::BITVECTOR_SLT);
+  if (!polarity)
+  {
+    std::swap(a, b);
+    std::swap(da, db);
+    strict = !strict;
+  }
+  unsigned size = da.getSize();
+  BitVector one(size, 1u);
+  BVDomain ra(size);
+  BVDomain rb(size);
+  if (k == kind::BITVECTOR_ULT || k == kind::BITVECTOR_ULE)
+  {
+    BitVector ones = BitVector::mkOnes(size);
+    if (strict && (db.getMax() == BitVector(size) || da.getMin() == ones))
+    {
+      return false;
+    }
+    ra.restrict(BitVector(size), strict ? db.getMax() - one : db.getMax());
+    rb.restrict(strict ? da.getMin() + one : da.getMin(), ones);
+  }
+  else
+  {
+    BitVector min = BitVector::mkMinSigned(size);
+    BitVector max = BitVector::mkMaxSigned(size);
+    if (strict && (db.getSignedMax() == min || da.getSignedMin() == max))
+    {
+      return false;
+    }
+    ra.restrictSigned(min, strict ? db.getSignedMax() - one : db.getSignedMax());
+    rb.restrictSigned(strict ? da.getSignedMin() + one : da.getSignedMin(), max);
+  }
+  return meet(a, ra, changed) && meet(b, rb, changed);
+}
+
+bool DomainPropagator::propagate(const std::vector<TNode>& facts)
+{
+  d_terms.clear();
+  d_index.clear();
+  d_domains.clear();
+  for (TNode fact : facts)
+  {
+    TNode atom = fact.getKind() == kind::NOT ? fact[0] : fact;
+    addTerm(atom[0]);
+    addTerm(atom[1]);
+  }
+
+  for (unsigned round = 0; round < s_maxRounds; ++round)
+  {
+    bool changed = false;
+    for (TNode t : d_terms)
+    {
+      if (!meet(t, forward(t), changed)) return false;
+    }
+    for (TNode fact : facts)
+    {
+      if (!applyFact(fact, changed)) return false;
+    }
+    for (unsigned i = d_terms.size(); i > 0; --i)
+    {
+      if (!backward(d_terms[i - 1], changed)) return false;
+    }
+    if (!changed)
+    {
+      break;
+    }
+  }
+  // the facts hold on the final domains, so that a literal decided by them
+  // is in conflict with its negation (see DomainSolver::explain())
+  bool changed = false;
+  for (TNode fact : facts)
+  {
+    if (!applyFact(fact, changed)) return false;
+  }
+  return true;
+}
+
+bool DomainPropagator::evaluate(TNode atom, bool& value) const
+{
+  if (!isDomainFact(atom) || atom.getKind() == kind::NOT)
+  {
+    return false;
+  }
+  int ia = getIndex(atom[0]);
+  int ib = getIndex(atom[1]);
+  if (ia < 0 || ib < 0)
+  {
+    return false;
+  }
+  const BVDomain& da = d_domains[ia];
+  const BVDomain& db = d_domains[ib];
+  switch (atom.getKind())
+  {
+    case kind::EQUAL:
+      if (da.isFixed() && db.isFixed())
+      {
+        value = da.getBits() == db.getBits();
+        return true;
+      }
+      if ((da.getMask() & db.getMask() & (da.getBits() ^ db.getBits()))
+              != BitVector(da.getSize())
+          || da.getMax().unsignedLessThan(db.getMin())
+          || db.getMax().unsignedLessThan(da.getMin())
+          || da.getSignedMax().signedLessThan(db.getSignedMin())
+          || db.getSignedMax().signedLessThan(da.getSignedMin()))
+      {
+        value = false;
+        return true;
+      }
+      return false;
+    case kind::BITVECTOR_ULT:
+      if (da.getMax().unsignedLessThan(db.getMin())
+          || db.getMax().unsignedLessThanEq(da.getMin()))
+      {
+        value = da.getMax().unsignedLessThan(db.getMin());
+        return true;
+      }
+      return false;
+    case kind::BITVECTOR_ULE:
+      if (da.getMax().unsignedLessThanEq(db.getMin())
+          || db.getMax().unsignedLessThan(da.getMin()))
+      {
+        value = da.getMax().unsignedLessThanEq(db.getMin());
+        return true;
+      }
+      return false;
+    case kind::BITVECTOR_SLT:
+      if (da.getSignedMax().signedLessThan(db.getSignedMin())
+          || db.getSignedMax().signedLessThanEq(da.getSignedMin()))
+      {
+        value = da.getSignedMax().signedLessThan(db.getSignedMin());
+        return true;
+      }
+      return false;
+    case kind::BITVECTOR_SLE:
+      if (da.getSignedMax().signedLessThanEq(db.getSignedMin())
+          || db.getSignedMax().signedLessThan(da.getSignedMin()))
+      {
+        value = da.getSignedMax().signedLessThanEq(db.getSignedMin());
+        return true;
+      }
+      return false;
+    default: return false;
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+DomainSolver::DomainSolver(context::Context* c, TheoryBV* bv)
+    : SubtheorySolver(c, bv), d_propagations(c), d_statistics()
+{
+}
+
+void DomainSolver::preRegister(TNode node)
+{
+  if (node.getKind() != kind::NOT && DomainPropagator::isDomainFact(node)
+      && d_atomSet.insert(node).second)
+  {
+    d_atoms.push_back(node);
+  }
+}
+
+void DomainSolver::getFacts(unsigned n, std::vector<TNode>& facts)
+{
+  AssertionQueue::const_iterator it = assertionsBegin();
+  for (unsigned i = 0; i < n && it != assertionsEnd(); ++i, ++it)
+  {
+    if (DomainPropagator::isDomainFact(*it))
+    {
+      facts.push_back(*it);
+    }
+  }
+}
+
+void DomainSolver::minimize(std::vector<TNode>& conflict, TNode required)
+{
+  // deletion-based: drop each fact that the conflict does not need
+  for (unsigned i = 0; i < conflict.size();)
+  {
+    std::vector<TNode> facts;
+    for (unsigned j = 0; j < conflict.size(); ++j)
+    {
+      if (j != i)
+      {
+        facts.push_back(conflict[j]);
+      }
+    }
+    if (!required.isNull())
+    {
+      facts.push_back(required);
+    }
+    DomainPropagator propagator;
+    if (!propagator.propagate(facts))
+    {
+      conflict.erase(conflict.begin() + i);
+    }
+    else
+    {
+      ++i;
+    }
+  }
+}
+
+bool DomainSolver::check(Theory::Effort e)
+{
+  Debug("bv-domain") << "DomainSolver::check(" << e << ")\n";
+  TimerStat::CodeTimer solveTimer(d_statistics.d_solveTime);
+  ++(d_statistics.d_numCallsToCheck);
+  d_bv->spendResource(ResourceManager::Resource::TheoryCheckStep);
+
+  if (done())
+  {
+    return true;
+  }
+  while (!done())
+  {
+    get();
+  }
+  std::unordered_set<TNode, TNodeHashFunction> asserted;
+  for (AssertionQueue::const_iterator it = assertionsBegin();
+       it != assertionsEnd();
+       ++it)
+  {
+    asserted.insert(*it);
+  }
+
+  std::vector<TNode> facts;
+  getFacts(d_assertionQueue.size(), facts);
+  DomainPropagator propagator;
+  if (!propagator.propagate(facts))
+  {
+    minimize(facts, TNode::null());
+    Node conflict = utils::flattenAnd(facts);
+    Debug("bv-domain") << "DomainSolver::check conflict " << conflict << "\n";
+    ++(d_statistics.d_numConflicts);
+    d_bv->setConflict(conflict);
+    return false;
+  }
+
+  for (const Node& atom : d_atoms)
+  {
+    bool value;
+    if (asserted.find(atom) != asserted.end()
+        || !propagator.evaluate(atom, value))
+    {
+      continue;
+    }
+    Node literal = value ? atom : atom.notNode();
+    if (asserted.find(literal) != asserted.end()
+        || d_propagations.find(literal) != d_propagations.end())
+    {
+      continue;
+    }
+    Debug("bv-domain") << "DomainSolver::check propagate " << literal << "\n";
+    d_propagations[literal] = d_assertionQueue.size();
+    ++(d_statistics.d_numPropagations);
+    d_bv->storePropagation(literal, SUB_DOMAIN);
+  }
+  return true;
+}
+
+void DomainSolver::explain(TNode literal, std::vector<TNode>& assumptions)
+{
+  Assert(d_propagations.find(literal) != d_propagations.end());
+  std::vector<TNode> facts;
+  getFacts(d_propagations[literal], facts);
+  Node negation =
+      literal.getKind() == kind::NOT ? (Node)literal[0] : literal.notNode();
+  DomainPropagator propagator;
+  std::vector<TNode> all = facts;
+  all.push_back(negation);
+  // the propagation is monotone, so the facts that decided the literal are
+  // in conflict with its negation
+  if (!propagator.propagate(all))
+  {
+    minimize(facts, negation);
+  }
+  Debug("bv-domain") << "DomainSolver::explain " << literal << " with "
+                     << facts.size() << " facts\n";
+  assumptions.insert(assumptions.end(), facts.begin(), facts.end());
+}
+
+DomainSolver::Statistics::Statistics()
+    : d_numCallsToCheck("theory::bv::domain::NumCallsToCheck", 0),
+      d_numConflicts("theory::bv::domain::NumConflicts", 0),
+      d_numPropagations("theory::bv::domain::NumPropagations", 0),
+      d_solveTime("theory::bv::domain::SolveTime")
+{
+  smtStatisticsRegistry()->registerStat(&d_numCallsToCheck);
+  smtStatisticsRegistry()->registerStat(&d_numConflicts);
+  smtStatisticsRegistry()->registerStat(&d_numPropagations);
+  smtStatisticsRegistry()->registerStat(&d_solveTime);
+}
+
+DomainSolver::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_numCallsToCheck);
+  smtStatisticsRegistry()->unregisterStat(&d_numConflicts);
+  smtStatisticsRegistry()->unregisterStat(&d_numPropagations);
+  smtStatisticsRegistry()->unregisterStat(&d_solveTime);
+}
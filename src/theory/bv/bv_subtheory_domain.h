@@ -0,0 +1,193 @@
+/*********************                                                        */
+/*! \file bv_subtheory_domain.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Word-level propagation of the domains of bit-vector terms.
+ **
+ ** The domain of a bit-vector term is the set of its known bits together
+ ** with an unsigned and a signed range.  The domain solver propagates the
+ ** domains through the terms of the asserted facts, forward from the
+ ** children to the parents and backward from the parents and the facts to
+ ** the children, until a fixed point or a bounded number of rounds.  An
+ ** empty domain is a conflict, which is explained by the facts it needs;
+ ** registered atoms that the domains decide are propagated.  Both happen
+ ** before the bit-blaster runs, so queries that are decided by simple
+ ** bit-level reasoning do not need their terms bit-blasted.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__BV__BV_SUBTHEORY_DOMAIN_H
+#define CVC4__THEORY__BV__BV_SUBTHEORY_DOMAIN_H
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "context/cdhashmap.h"
+#include "expr/node.h"
+#include "theory/bv/bv_subtheory.h"
+#include "util/bitvector.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace theory {
+namespace bv {
+
+/**
+ * A set of bit-vectors of the same size, given by known bits, an unsigned
+ * range and a signed range.  The modifiers keep the three components
+ * consistent with each other and return true if the domain changed.
+ */
+class BVDomain
+{
+ public:
+  /** The domain of all bit-vectors of the given size. */
+  explicit BVDomain(unsigned size);
+  /** The domain containing only value. */
+  explicit BVDomain(const BitVector& value);
+
+  unsigned getSize() const { return d_mask.getSize(); }
+  bool isEmpty() const { return d_empty; }
+  /** Are all bits known? */
+  bool isFixed() const;
+
+  /** Bit i is known to be getBits()[i] if getMask()[i] is set. */
+  const BitVector& getMask() const { return d_mask; }
+  const BitVector& getBits() const { return d_bits; }
+  /** The unsigned range */
+  const BitVector& getMin() const { return d_min; }
+  const BitVector& getMax() const { return d_max; }
+  /** The signed range, in two's complement */
+  BitVector getSignedMin() const;
+  BitVector getSignedMax() const;
+
+  void setEmpty();
+  /** Fixes the bits of mask to bits. */
+  bool fixBits(const BitVector& mask, const BitVector& bits);
+  /** Restricts the unsigned range to [lo, hi]. */
+  bool restrict(const BitVector& lo, const BitVector& hi);
+  /** Restricts the signed range to [lo, hi]. */
+  bool restrictSigned(const BitVector& lo, const BitVector& hi);
+  /** Intersects with other. */
+  bool meet(const BVDomain& other);
+  /** Returns a domain containing both a and b. */
+  static BVDomain join(const BVDomain& a, const BVDomain& b);
+
+ private:
+  /** Tightens the range [lo, hi] to [l, h], returns true if it changed. */
+  bool tighten(BitVector& lo, BitVector& hi, const BitVector& l, const BitVector& h);
+  /** Fixes the common prefix of lo ^ flip and hi ^ flip. */
+  bool fixPrefix(const BitVector& lo, const BitVector& hi, const BitVector& flip);
+  /** Propagates between the known bits and the ranges. */
+  void normalize();
+
+  bool d_empty;
+  BitVector d_mask;
+  BitVector d_bits;
+  BitVector d_min;
+  BitVector d_max;
+  /**
+   * The signed range, with the sign bit flipped so that the signed order is
+   * the unsigned order of the flipped values.
+   */
+  BitVector d_smin;
+  BitVector d_smax;
+}; /* class BVDomain */
+
+/**
+ * Propagates the domains of the terms of a set of facts.
+ */
+class DomainPropagator
+{
+ public:
+  /**
+   * Propagates the domains through the terms of facts, returns false if a
+   * domain is empty.
+   */
+  bool propagate(const std::vector<TNode>& facts);
+  /**
+   * Returns true if the domains decide atom, with its value in value.
+   */
+  bool evaluate(TNode atom, bool& value) const;
+
+  /** Returns true if fact constrains the domains. */
+  static bool isDomainFact(TNode fact);
+
+ private:
+  /** Adds t and its bit-vector subterms to the terms. */
+  void addTerm(TNode t);
+  /** Returns the index of the domain of t, or -1 if t has none. */
+  int getIndex(TNode t) const;
+  /** Returns the domain over-approximating t from its children. */
+  BVDomain forward(TNode t) const;
+  /** Restricts the children of t by the domain of t. */
+  bool backward(TNode t, bool& changed);
+  /** Applies fact to the domains of its terms. */
+  bool applyFact(TNode fact, bool& changed);
+  /** Intersects the domain of t with d. */
+  bool meet(TNode t, const BVDomain& d, bool& changed);
+
+  /** The terms, children before parents */
+  std::vector<TNode> d_terms;
+  std::unordered_map<TNode, unsigned, TNodeHashFunction> d_index;
+  std::vector<BVDomain> d_domains;
+}; /* class DomainPropagator */
+
+class DomainSolver : public SubtheorySolver
+{
+  struct Statistics
+  {
+    IntStat d_numCallsToCheck;
+    IntStat d_numConflicts;
+    IntStat d_numPropagations;
+    TimerStat d_solveTime;
+    Statistics();
+    ~Statistics();
+  };
+
+  /** The registered bit-vector atoms */
+  std::vector<Node> d_atoms;
+  std::unordered_set<Node, NodeHashFunction> d_atomSet;
+  /** The number of asserted facts when each literal was propagated */
+  context::CDHashMap<Node, unsigned, NodeHashFunction> d_propagations;
+  Statistics d_statistics;
+
+  /** The facts among the first n asserted facts that constrain domains */
+  void getFacts(unsigned n, std::vector<TNode>& facts);
+  /**
+   * Removes from conflict the facts that are not needed for the domains to
+   * be in conflict together with required, if not null.
+   */
+  void minimize(std::vector<TNode>& conflict, TNode required);
+
+ public:
+  DomainSolver(context::Context* c, TheoryBV* bv);
+
+  bool check(Theory::Effort e) override;
+  void explain(TNode literal, std::vector<TNode>& assumptions) override;
+  void preRegister(TNode node) override;
+  bool isComplete() override { return false; }
+  bool collectModelInfo(TheoryModel* m, bool fullModel) override
+  {
+    return true;
+  }
+  Node getModelValue(TNode var) override { return Node::null(); }
+  EqualityStatus getEqualityStatus(TNode a, TNode b) override
+  {
+    return EQUALITY_UNKNOWN;
+  }
+}; /* class DomainSolver */
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__BV__BV_SUBTHEORY_DOMAIN_H */
@@ -194,6 +194,7 @@ TermId UnionFind::addTerm(Index bitwidth) {
   TermId id = d_nodes.size() - 1; 
   d_representatives.insert(id);
   ++(d_statistics.d_numRepresentatives); 
+  pushUndo(UNDO_ADD_TERM, id);
 
   Debug("bv-slicer-uf") << "UnionFind::addTerm " << id << " size " << bitwidth << endl;
   return id; 
@@ -245,6 +246,32 @@ void UnionFind::merge(TermId t1, TermId t2) {
   d_statistics.d_numRepresentatives += -1; 
 }
 
+void UnionFind::backtrack() {
+  Debug("bv-slicer-uf") << "UnionFind::backtrack to " << d_undoStackIndex.get()
+                        << endl;
+  while (d_undoStack.size() > d_undoStackIndex.get()) {
+    const UndoEntry& entry = d_undoStack.back();
+    switch (entry.kind) {
+      case UNDO_ADD_TERM:
+        Assert(entry.id == d_nodes.size() - 1);
+        d_nodes.pop_back();
+        d_representatives.erase(entry.id);
+        d_statistics.d_numRepresentatives += -1;
+        break;
+      case UNDO_SET_REPR:
+        d_nodes[entry.id].setRepr(entry.repr);
+        if (entry.repr == UndefinedId) {
+          // undo a merge
+          d_representatives.insert(entry.id);
+          ++(d_statistics.d_numRepresentatives);
+        }
+        break;
+      case UNDO_SET_CHILDREN: d_nodes[entry.id].clearChildren(); break;
+    }
+    d_undoStack.pop_back();
+  }
+}
+
 TermId UnionFind::find(TermId id) {
   TermId repr = getRepr(id); 
   if (repr != UndefinedId) {
@@ -466,12 +493,16 @@ ExtractTerm Slicer::registerTerm(TNode node) {
     high = utils::getExtractHigh(node);
     low = utils::getExtractLow(node); 
   }
-  if (d_nodeToId.find(n) == d_nodeToId.end()) {
-    TermId id = d_unionFind.addTerm(utils::getSize(n)); 
-    d_nodeToId[n] = id;
-    d_idToNode[id] = n; 
+  context::CDHashMap<Node, TermId, NodeHashFunction>::const_iterator it =
+      d_nodeToId.find(n);
+  TermId id;
+  if (it == d_nodeToId.end()) {
+    id = d_unionFind.addTerm(utils::getSize(n)); 
+    d_nodeToId.insert(n, id);
+    d_idToNode.insert(id, n); 
+  } else {
+    id = (*it).second;
   }
-  TermId id = d_nodeToId[n];
   ExtractTerm res(id, high, low); 
   Debug("bv-slicer") << "Slicer::registerTerm " << node << " => " << res.debugPrint() << endl;
   return res; 
@@ -507,8 +538,10 @@ void Slicer::getBaseDecomposition(TNode node, std::vector<Node>& decomp) {
     low = utils::getExtractLow(node);
     top = node[0]; 
   }
-  AlwaysAssert(d_nodeToId.find(top) != d_nodeToId.end());
-  TermId id = d_nodeToId[top];
+  context::CDHashMap<Node, TermId, NodeHashFunction>::const_iterator it =
+      d_nodeToId.find(top);
+  AlwaysAssert(it != d_nodeToId.end());
+  TermId id = (*it).second;
   NormalForm nf(high-low+1); 
   d_unionFind.getNormalForm(ExtractTerm(id, high, low), nf);
   
@@ -22,6 +22,9 @@
 #include <list>
 #include <unordered_map>
 
+#include "context/cdhashmap.h"
+#include "context/cdo.h"
+#include "context/context.h"
 #include "expr/node.h"
 #include "theory/bv/theory_bv_utils.h"
 #include "util/bitvector.h"
@@ -120,7 +123,12 @@ struct NormalForm {
 };
 
 
-class UnionFind {
+/**
+ * The union-find over the slices of the registered terms. It is
+ * context-dependent: each change to the nodes is recorded on an undo stack,
+ * which is unwound when the context is popped.
+ */
+class UnionFind : public context::ContextNotifyObj {
   class Node {
     Index d_bitwidth;
     TermId d_ch1, d_ch0;
@@ -150,6 +158,10 @@ class UnionFind {
       d_ch1 = ch1;
       d_ch0 = ch0; 
     }
+    void clearChildren() {
+      d_ch1 = UndefinedId;
+      d_ch0 = UndefinedId;
+    }
     std::string debugPrint() const;
   };
   
@@ -157,6 +169,35 @@ class UnionFind {
   std::vector<Node> d_nodes;
   /// a term is in this set if it is its own representative
   TermSet d_representatives;
+
+  /** The kinds of changes recorded on the undo stack */
+  enum UndoKind
+  {
+    /** the term was added, it is the last of d_nodes */
+    UNDO_ADD_TERM,
+    /** the representative of the term was changed, from repr */
+    UNDO_SET_REPR,
+    /** the term was split */
+    UNDO_SET_CHILDREN
+  };
+  struct UndoEntry
+  {
+    UndoKind kind;
+    TermId id;
+    TermId repr;
+    UndoEntry(UndoKind k, TermId i, TermId r) : kind(k), id(i), repr(r) {}
+  };
+  std::vector<UndoEntry> d_undoStack;
+  context::CDO<unsigned> d_undoStackIndex;
+
+  void pushUndo(UndoKind kind, TermId id, TermId repr = UndefinedId)
+  {
+    d_undoStack.push_back(UndoEntry(kind, id, repr));
+    d_undoStackIndex = d_undoStack.size();
+  }
+  void contextNotifyPop() override { backtrack(); }
+  /** Undoes the changes made since the current context level was pushed */
+  void backtrack();
   
   void getDecomposition(const ExtractTerm& term, Decomposition& decomp);
   void handleCommonSlice(const Decomposition& d1, const Decomposition& d2, TermId common);
@@ -179,11 +220,15 @@ class UnionFind {
   /// setter methods for the internal nodes
   void setRepr(TermId id, TermId new_repr) {
     Assert(id < d_nodes.size());
+    TermId old_repr = d_nodes[id].getRepr();
+    if (old_repr == new_repr) return;
+    pushUndo(UNDO_SET_REPR, id, old_repr);
     d_nodes[id].setRepr(new_repr); 
   }
   void setChildren(TermId id, TermId ch1, TermId ch0) {
     Assert(id < d_nodes.size()
            && getBitwidth(id) == getBitwidth(ch1) + getBitwidth(ch0));
+    pushUndo(UNDO_SET_CHILDREN, id);
     d_nodes[id].setChildren(ch1, ch0); 
   }
 
@@ -204,9 +249,12 @@ class UnionFind {
 ;
   
 public:
-  UnionFind()
-    : d_nodes(),
-      d_representatives()
+  UnionFind(context::Context* c)
+    : context::ContextNotifyObj(c),
+      d_nodes(),
+      d_representatives(),
+      d_undoStack(),
+      d_undoStackIndex(c, 0)
   {}
 
   TermId addTerm(Index bitwidth);
@@ -226,18 +274,24 @@ public:
   friend class Slicer; 
 };
 
+/**
+ * The slicer of the core sub-theory. The registered terms and their slicing
+ * are dependent on the context given to the constructor, so that the
+ * equalities registered in incremental mode are forgotten when they are
+ * popped.
+ */
 class Slicer {
-  std::unordered_map<TermId, TNode> d_idToNode;
-  std::unordered_map<TNode, TermId, TNodeHashFunction> d_nodeToId;
-  std::unordered_map<TNode, bool, TNodeHashFunction> d_coreTermCache;
+  context::CDHashMap<TermId, Node> d_idToNode;
+  context::CDHashMap<Node, TermId, NodeHashFunction> d_nodeToId;
+  std::unordered_map<Node, bool, NodeHashFunction> d_coreTermCache;
   UnionFind d_unionFind;
   ExtractTerm registerTerm(TNode node); 
 public:
-  Slicer()
-    : d_idToNode(),
-      d_nodeToId(),
+  Slicer(context::Context* c)
+    : d_idToNode(c),
+      d_nodeToId(c),
       d_coreTermCache(),
-      d_unionFind()
+      d_unionFind(c)
   {}
   
   void getBaseDecomposition(TNode node, std::vector<Node>& decomp);
@@ -26,6 +26,7 @@
 #include "theory/bv/bv_subtheory_algebraic.h"
 #include "theory/bv/bv_subtheory_bitblast.h"
 #include "theory/bv/bv_subtheory_core.h"
+#include "theory/bv/bv_subtheory_domain.h"
 #include "theory/bv/bv_subtheory_inequality.h"
 #include "theory/bv/slicer.h"
 #include "theory/bv/theory_bv_rewrite_rules_normalization.h"
@@ -95,6 +96,12 @@ TheoryBV::TheoryBV(context::Context* c,
     d_subtheoryMap[SUB_INEQUALITY] = d_subtheories.back().get();
   }
 
+  if (options::bitvectorDomainSolver() && !options::proof())
+  {
+    d_subtheories.emplace_back(new DomainSolver(c, this));
+    d_subtheoryMap[SUB_DOMAIN] = d_subtheories.back().get();
+  }
+
   if (options::bitvectorAlgebraicSolver() && !options::proof())
   {
     d_subtheories.emplace_back(new AlgebraicSolver(c, this));
@@ -264,6 +264,7 @@ public:
   friend class EqualitySolver;
   friend class CoreSolver;
   friend class InequalitySolver;
+  friend class DomainSolver;
   friend class AlgebraicSolver;
   friend class EagerBitblastSolver;
 };/* class TheoryBV */
@@ -628,6 +628,55 @@ struct ApplyRuleToChildren {
   }
 };
 
+/**
+ * Applies the rules R, Rs... in this order to current.
+ *
+ * The sequence stops at the first EmptyRule, which are the unused trailing
+ * rules of the strategies below, so that these are not even instantiated.
+ * It also stops when current becomes a leaf (a constant or a variable),
+ * since every rule applies to a node with a given operator kind only.
+ */
+template <typename R, typename... Rs>
+struct RuleSequence
+{
+  static inline void apply(Node& current)
+  {
+    if (current.getNumChildren() == 0)
+    {
+      return;
+    }
+    if (R::applies(current))
+    {
+      current = R::template run<false>(current);
+    }
+    RuleSequence<Rs...>::apply(current);
+  }
+};
+
+template <typename R>
+struct RuleSequence<R>
+{
+  static inline void apply(Node& current)
+  {
+    if (current.getNumChildren() != 0 && R::applies(current))
+    {
+      current = R::template run<false>(current);
+    }
+  }
+};
+
+template <typename... Rs>
+struct RuleSequence<RewriteRule<EmptyRule>, Rs...>
+{
+  static inline void apply(Node& current) {}
+};
+
+template <>
+struct RuleSequence<RewriteRule<EmptyRule>>
+{
+  static inline void apply(Node& current) {}
+};
+
 template <
   typename R1,
   typename R2  = RewriteRule<EmptyRule>,
@@ -653,26 +702,8 @@ template <
 struct LinearRewriteStrategy {
   static Node apply(TNode node) {
     Node current = node;
-    if (R1::applies(current)) current  = R1::template run<false>(current);
-    if (R2::applies(current)) current  = R2::template run<false>(current);
-    if (R3::applies(current)) current  = R3::template run<false>(current);
-    if (R4::applies(current)) current  = R4::template run<false>(current);
-    if (R5::applies(current)) current  = R5::template run<false>(current);
-    if (R6::applies(current)) current  = R6::template run<false>(current);
-    if (R7::applies(current)) current  = R7::template run<false>(current);
-    if (R8::applies(current)) current  = R8::template run<false>(current);
-    if (R9::applies(current)) current  = R9::template run<false>(current);
-    if (R10::applies(current)) current = R10::template run<false>(current);
-    if (R11::applies(current)) current = R11::template run<false>(current);
-    if (R12::applies(current)) current = R12::template run<false>(current);
-    if (R13::applies(current)) current = R13::template run<false>(current);
-    if (R14::applies(current)) current = R14::template run<false>(current);
-    if (R15::applies(current)) current = R15::template run<false>(current);
-    if (R16::applies(current)) current = R16::template run<false>(current);
-    if (R17::applies(current)) current = R17::template run<false>(current);
-    if (R18::applies(current)) current = R18::template run<false>(current);
-    if (R19::applies(current)) current = R19::template run<false>(current);
-    if (R20::applies(current)) current = R20::template run<false>(current);
+    RuleSequence<R1, R2, R3, R4, R5, R6, R7, R8, R9, R10, R11, R12, R13, R14, R15, R16, R17,
+                 R18, R19, R20>::apply(current);
     return current;
   }
 };
@@ -705,26 +736,8 @@ struct FixpointRewriteStrategy {
     Node current = node;
     do {
       previous = current;
-      if (R1::applies(current)) current  = R1::template run<false>(current);
-      if (R2::applies(current)) current  = R2::template run<false>(current);
-      if (R3::applies(current)) current  = R3::template run<false>(current);
-      if (R4::applies(current)) current  = R4::template run<false>(current);
-      if (R5::applies(current)) current  = R5::template run<false>(current);
-      if (R6::applies(current)) current  = R6::template run<false>(current);
-      if (R7::applies(current)) current  = R7::template run<false>(current);
-      if (R8::applies(current)) current  = R8::template run<false>(current);
-      if (R9::applies(current)) current  = R9::template run<false>(current);
-      if (R10::applies(current)) current = R10::template run<false>(current);
-      if (R11::applies(current)) current = R11::template run<false>(current);
-      if (R12::applies(current)) current = R12::template run<false>(current);
-      if (R13::applies(current)) current = R13::template run<false>(current);
-      if (R14::applies(current)) current = R14::template run<false>(current);
-      if (R15::applies(current)) current = R15::template run<false>(current);
-      if (R16::applies(current)) current = R16::template run<false>(current);
-      if (R17::applies(current)) current = R17::template run<false>(current);
-      if (R18::applies(current)) current = R18::template run<false>(current);
-      if (R19::applies(current)) current = R19::template run<false>(current);
-      if (R20::applies(current)) current = R20::template run<false>(current);
+      RuleSequence<R1, R2, R3, R4, R5, R6, R7, R8, R9, R10, R11, R12, R13, R14, R15, R16, R17,
+                 R18, R19, R20>::apply(current);
     } while (previous != current);
     
     return current;
@@ -162,6 +162,7 @@ void SygusExtension::registerTerm( Node n, std::vector< Node >& lemmas ) {
         d_anchor_to_conj[n] = d_tds->getConjectureForEnumerator(n);
         // this assertion fails if we have a sygus term in the search that is unmeasured
         Assert(d_anchor_to_conj[n] != NULL);
+        initializeSearchCache(n);
         d = 0;
         is_top_level = true;
         success = true;
@@ -1005,7 +1006,7 @@ Node SygusExtension::registerSearchValue(Node a,
   std::map<TypeNode, int> var_count;
   Node cnv = d_tds->canonizeBuiltin(nv, var_count);
   Trace("sygus-sb-debug") << "  ...canonized value is " << cnv << std::endl;
-  SearchCache& sca = d_cache[a];
+  SymBreakStore& sca = *d_cache[a].d_store;
   // must do this for all nodes, regardless of top-level
   if (sca.d_search_val_proc.find(cnv) == sca.d_search_val_proc.end())
   {
@@ -1172,10 +1173,16 @@ void SygusExtension::registerSymBreakLemmaForValue(
   lem = lem.negate();
   Trace("sygus-sb-exc") << "  ........exc lemma is " << lem << ", size = " << sz
                         << std::endl;
-  registerSymBreakLemma(tn, lem, sz, a, lemmas);
+  registerSymBreakLemma(tn, lem, sz, a, lemmas, true);
 }
 
-void SygusExtension::registerSymBreakLemma( TypeNode tn, Node lem, unsigned sz, Node a, std::vector< Node >& lemmas ) {
+void SygusExtension::registerSymBreakLemma(TypeNode tn,
+                                           Node lem,
+                                           unsigned sz,
+                                           Node a,
+                                           std::vector<Node>& lemmas,
+                                           bool isValueLemma)
+{
   // lem holds for all terms of type tn, and is applicable to terms of size sz
   Trace("sygus-sb-debug") << "  register sym break lemma : " << lem
                           << std::endl;
@@ -1184,28 +1191,98 @@ void SygusExtension::registerSymBreakLemma( TypeNode tn, Node lem, unsigned sz,
   Trace("sygus-sb-debug") << "     size : " << sz << std::endl;
   Assert(!a.isNull());
   SearchCache& sca = d_cache[a];
-  sca.d_sb_lemmas[tn][sz].push_back(lem);
-  TNode x = getFreeVar( tn );
-  unsigned csz = getSearchSizeForAnchor( a );
-  int max_depth = ((int)csz)-((int)sz);
+  std::map<unsigned, std::vector<Node>> sbLemmas;
+  sbLemmas[sz].push_back(lem);
+  if (!isValueLemma)
+  {
+    sca.d_sb_lemmas[tn][sz].push_back(lem);
+    instantiateSymBreakLemmas(
+        tn, sbLemmas, a, getSearchSizeForAnchor(a), false, lemmas);
+    return;
+  }
+  SymBreakStore* store = sca.d_store;
+  store->d_sb_lemmas[tn][sz].push_back(lem);
+  // the lemma applies to all the anchors that share the store of a, the
+  // anchors that are registered later get it in addSymBreakLemmasFor
+  for (std::pair<const Node, SearchCache>& c : d_cache)
+  {
+    if (c.second.d_store == store)
+    {
+      instantiateSymBreakLemmas(tn,
+                                sbLemmas,
+                                c.first,
+                                getSearchSizeForAnchor(c.first),
+                                false,
+                                lemmas);
+    }
+  }
+}
+
+void SygusExtension::initializeSearchCache(Node a)
+{
+  SearchCache& sca = d_cache[a];
+  if (!options::sygusSymBreakShare() || d_tds->isVariableAgnosticEnumerator(a))
+  {
+    return;
+  }
+  // symmetry breaking based on examples is specific to the conjecture of a
+  Assert(d_anchor_to_conj.find(a) != d_anchor_to_conj.end());
+  if (d_anchor_to_conj[a]->getExampleEvalCache(a) != nullptr)
+  {
+    return;
+  }
+  Trace("sygus-sb") << "Sygus : anchor " << a
+                    << " shares the symmetry breaking of its grammar"
+                    << std::endl;
+  sca.d_store = &d_grammarStore[a.getType()];
+}
+
+void SygusExtension::instantiateSymBreakLemmas(
+    TypeNode tn,
+    const std::map<unsigned, std::vector<Node>>& sbLemmas,
+    Node a,
+    unsigned searchSize,
+    bool onlyMaxDepth,
+    std::vector<Node>& lemmas)
+{
+  std::map<TypeNode, std::map<unsigned, std::vector<Node>>>::iterator itst =
+      d_cache[a].d_search_terms.find(tn);
+  if (itst == d_cache[a].d_search_terms.end())
+  {
+    return;
+  }
+  TNode x = getFreeVar(tn);
   NodeManager* nm = NodeManager::currentNM();
-  for( int d=0; d<=max_depth; d++ ){
-    std::map<unsigned, std::vector<Node>>::iterator itt =
-        sca.d_search_terms[tn].find(d);
-    if (itt != sca.d_search_terms[tn].end())
+  for (std::map<unsigned, std::vector<Node>>::const_iterator it =
+           sbLemmas.begin();
+       it != sbLemmas.end();
+       ++it)
+  {
+    int maxDepth = static_cast<int>(searchSize) - static_cast<int>(it->first);
+    for (int d = onlyMaxDepth ? maxDepth : 0; d <= maxDepth; d++)
     {
+      std::map<unsigned, std::vector<Node>>::iterator itt =
+          itst->second.find(d);
+      if (itt == itst->second.end())
+      {
+        continue;
+      }
       for (const TNode& t : itt->second)
       {
         if (!options::sygusSymBreakLazy()
             || d_active_terms.find(t) != d_active_terms.end())
         {
-          Node slem = lem.substitute(x, t);
           Node rlv = getRelevancyCondition(t);
-          if (!rlv.isNull())
+          std::unordered_map<TNode, TNode, TNodeHashFunction> cache;
+          for (const Node& lem : it->second)
           {
-            slem = nm->mkNode(OR, rlv, slem);
+            Node slem = lem.substitute(x, t, cache);
+            if (!rlv.isNull())
+            {
+              slem = nm->mkNode(OR, rlv, slem);
+            }
+            lemmas.push_back(slem);
           }
-          lemmas.push_back(slem);
         }
       }
     }
@@ -1224,23 +1301,33 @@ void SygusExtension::addSymBreakLemmasFor( TypeNode tn, Node t, unsigned d, Node
   Trace("sygus-sb-debug2") << "add sym break lemmas for " << t << " " << d
                            << " " << a << std::endl;
   SearchCache& sca = d_cache[a];
-  std::map<TypeNode, std::map<unsigned, std::vector<Node>>>::iterator its =
-      sca.d_sb_lemmas.find(tn);
   Node rlv = getRelevancyCondition(t);
   NodeManager* nm = NodeManager::currentNM();
-  if (its != sca.d_sb_lemmas.end())
+  TNode x = getFreeVar(tn);
+  //get symmetry breaking lemmas for this term
+  unsigned csz = getSearchSizeForAnchor(a);
+  int max_sz = ((int)csz) - ((int)d);
+  Trace("sygus-sb-debug2") << "add lemmas up to size " << max_sz
+                           << ", which is (search_size) " << csz
+                           << " - (depth) " << d << std::endl;
+  std::unordered_map<TNode, TNode, TNodeHashFunction> cache;
+  // the lemmas of the conjecture for a, and the ones of its store
+  for (unsigned i = 0; i < 2; i++)
   {
-    TNode x = getFreeVar( tn );
-    //get symmetry breaking lemmas for this term 
-    unsigned csz = getSearchSizeForAnchor( a );
-    int max_sz = ((int)csz) - ((int)d);
-    Trace("sygus-sb-debug2")
-        << "add lemmas up to size " << max_sz << ", which is (search_size) "
-        << csz << " - (depth) " << d << std::endl;
-    std::unordered_map<TNode, TNode, TNodeHashFunction> cache;
-    for( std::map< unsigned, std::vector< Node > >::iterator it = its->second.begin(); it != its->second.end(); ++it ){
-      if( (int)it->first<=max_sz ){
-        for (const Node& lem : it->second)
+    std::map<TypeNode, std::map<unsigned, std::vector<Node>>>& sbl =
+        i == 0 ? sca.d_sb_lemmas : sca.d_store->d_sb_lemmas;
+    std::map<TypeNode, std::map<unsigned, std::vector<Node>>>::iterator its =
+        sbl.find(tn);
+    if (its == sbl.end())
+    {
+      continue;
+    }
+    for (const std::pair<const unsigned, std::vector<Node>>& lems :
+         its->second)
+    {
+      if ((int)lems.first <= max_sz)
+      {
+        for (const Node& lem : lems.second)
         {
           Node slem = lem.substitute(x, t, cache);
           // add the relevancy condition for t
@@ -1451,43 +1538,25 @@ void SygusExtension::incrementCurrentSearchSize( Node m, std::vector< Node >& le
   Assert(itsz != d_szinfo.end());
   itsz->second->d_curr_search_size++;
   Trace("sygus-fair") << "  register search size " << itsz->second->d_curr_search_size << " for " << m << std::endl;
-  NodeManager* nm = NodeManager::currentNM();
   for( std::map< Node, SearchCache >::iterator itc = d_cache.begin(); itc != d_cache.end(); ++itc ){
     Node a = itc->first;
     Trace("sygus-fair-debug") << "  look at anchor " << a << "..." << std::endl;
     // check whether a is bounded by m
     Assert(d_anchor_to_measure_term.find(a) != d_anchor_to_measure_term.end());
     if( d_anchor_to_measure_term[a]==m ){
-      for( std::map< TypeNode, std::map< unsigned, std::vector< Node > > >::iterator its = itc->second.d_sb_lemmas.begin();
-           its != itc->second.d_sb_lemmas.end(); ++its ){
-        TypeNode tn = its->first;
-        TNode x = getFreeVar( tn );
-        for( std::map< unsigned, std::vector< Node > >::iterator it = its->second.begin(); it != its->second.end(); ++it ){
-          unsigned sz = it->first;
-          int new_depth = ((int)itsz->second->d_curr_search_size) - ((int)sz);
-          std::map< unsigned, std::vector< Node > >::iterator itt = itc->second.d_search_terms[tn].find( new_depth );
-          if( itt!=itc->second.d_search_terms[tn].end() ){
-            for (const TNode& t : itt->second)
-            {
-              if (!options::sygusSymBreakLazy()
-                  || (d_active_terms.find(t) != d_active_terms.end()
-                      && !it->second.empty()))
-              {
-                Node rlv = getRelevancyCondition(t);
-                std::unordered_map<TNode, TNode, TNodeHashFunction> cache;
-                for (const Node& lem : it->second)
-                {
-                  Node slem = lem.substitute(x, t, cache);
-                  if (!rlv.isNull())
-                  {
-                    slem = nm->mkNode(OR, rlv, slem);
-                  }
-                  lemmas.push_back(slem);
-                }
-              }
-            }
-          }
-        }
+      unsigned csz = itsz->second->d_curr_search_size;
+      SearchCache& sca = itc->second;
+      for (const std::pair<const TypeNode,
+                           std::map<unsigned, std::vector<Node>>>& sbl :
+           sca.d_sb_lemmas)
+      {
+        instantiateSymBreakLemmas(sbl.first, sbl.second, a, csz, true, lemmas);
+      }
+      for (const std::pair<const TypeNode,
+                           std::map<unsigned, std::vector<Node>>>& sbl :
+           sca.d_store->d_sb_lemmas)
+      {
+        instantiateSymBreakLemmas(sbl.first, sbl.second, a, csz, true, lemmas);
       }
     }
   }
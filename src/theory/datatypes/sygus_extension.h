@@ -176,17 +176,22 @@ class SygusExtension
    */
   bool computeTopLevel( TypeNode tn, Node n );
 private:
- /** This caches all information regarding symmetry breaking for an anchor. */
- class SearchCache
+ /**
+  * The symmetry breaking information that is derived from the search values
+  * of anchors, i.e. the redundancy of terms by rewriting and the symmetry
+  * breaking lemma templates that exclude them. It only depends on the
+  * grammar of the anchors when they have no examples and are not variable
+  * agnostic, in which case it is shared by all such anchors of the same
+  * sygus datatype (see d_grammarStore).
+  */
+ class SymBreakStore
  {
   public:
-    SearchCache(){}
+    SymBreakStore() {}
     /**
-     * A cache of all search terms for (types, sizes). See registerSearchTerm
-     * for definition of search terms.
+     * A cache of the symmetry breaking lemma templates for search values, for
+     * (types, sizes).
      */
-    std::map< TypeNode, std::map< unsigned, std::vector< Node > > > d_search_terms;
-    /** A cache of all symmetry breaking lemma templates for (types, sizes). */
     std::map< TypeNode, std::map< unsigned, std::vector< Node > > > d_sb_lemmas;
     /** search value
      *
@@ -203,8 +208,58 @@ private:
     /** For each term, whether this cache has processed that term */
     std::unordered_set<Node, NodeHashFunction> d_search_val_proc;
   };
+ /** This caches all information regarding symmetry breaking for an anchor. */
+ class SearchCache
+ {
+  public:
+    SearchCache() : d_store(&d_localStore) {}
+    SearchCache(const SearchCache&) = delete;
+    /**
+     * A cache of all search terms for (types, sizes). See registerSearchTerm
+     * for definition of search terms.
+     */
+    std::map< TypeNode, std::map< unsigned, std::vector< Node > > > d_search_terms;
+    /**
+     * A cache of the symmetry breaking lemma templates registered for this
+     * anchor by the conjecture, for (types, sizes).
+     */
+    std::map< TypeNode, std::map< unsigned, std::vector< Node > > > d_sb_lemmas;
+    /**
+     * The store of the search values of this anchor, either d_localStore or
+     * the store of its grammar in d_grammarStore.
+     */
+    SymBreakStore* d_store;
+    /** The store of this anchor if it does not share the one of its grammar */
+    SymBreakStore d_localStore;
+  };
   /** An instance of the above cache, for each anchor */
   std::map< Node, SearchCache > d_cache;
+  /**
+   * The symmetry breaking stores shared by the anchors of each sygus
+   * datatype, see SymBreakStore.
+   */
+  std::map<TypeNode, SymBreakStore> d_grammarStore;
+  /**
+   * Initializes the search cache of anchor a, which uses the store of its
+   * grammar if option sygusSymBreakShare is set and a has no examples and is
+   * not variable agnostic.
+   */
+  void initializeSearchCache(Node a);
+  /**
+   * Adds to lemmas the instances of the symmetry breaking lemma templates
+   * sbLemmas of type tn, by size, for the search terms of anchor a to which
+   * they apply when the search size is searchSize, i.e. the terms of depth at
+   * most searchSize minus the size of the template. If onlyMaxDepth is true,
+   * only the terms of exactly that depth are considered, which are the ones
+   * the templates newly apply to when the search size is incremented.
+   */
+  void instantiateSymBreakLemmas(
+      TypeNode tn,
+      const std::map<unsigned, std::vector<Node>>& sbLemmas,
+      Node a,
+      unsigned searchSize,
+      bool onlyMaxDepth,
+      std::vector<Node>& lemmas);
   //-----------------------------------traversal predicates
   /** pre/post traversal predicates for each type, variable
    *
@@ -394,7 +449,10 @@ private:
   /** Register symmetry breaking lemma
    *
    * This function adds the symmetry breaking lemma template lem for terms of
-   * type tn with anchor a. This is added to d_cache[a].d_sb_lemmas. Notice that
+   * type tn with anchor a. This is added to d_cache[a].d_sb_lemmas, or if
+   * isValueLemma is true (lem excludes a search value), to the store
+   * d_cache[a].d_store, in which case the lemma also applies to the other
+   * anchors sharing that store. Notice that
    * we use lem as a template with free variable x, e.g. our template is:
    *   (lambda ((x tn)) lem)
    * where x = getFreeVar( tn ). For all search terms t of the appropriate
@@ -408,8 +466,12 @@ private:
    * This is equivalent to sum of weights of constructors corresponding to each
    * tester, e.g. above + has weight 1, and x and 0 have weight 0.
    */
-  void registerSymBreakLemma(
-      TypeNode tn, Node lem, unsigned sz, Node a, std::vector<Node>& lemmas);
+  void registerSymBreakLemma(TypeNode tn,
+                             Node lem,
+                             unsigned sz,
+                             Node a,
+                             std::vector<Node>& lemmas,
+                             bool isValueLemma = false);
   /** Register symmetry breaking lemma for value
    *
    * This function adds a symmetry breaking lemma template for selector chains
@@ -1817,6 +1817,11 @@ void TheoryDatatypes::instantiate( EqcInfo* eqc, Node n ){
 void TheoryDatatypes::checkCycles() {
   Trace("datatypes-cycle-check") << "Check acyclicity" << std::endl;
   std::vector< Node > cdt_eqc;
+  // The equivalence classes whose descendants were all searched without
+  // finding a cycle. This is shared by the searches from all equivalence
+  // classes, since no cycle is reachable from these classes, so that each
+  // class is visited once, as in a depth-first search on the whole graph.
+  std::map< TNode, bool > proc;
   eq::EqClassesIterator eqcs_i = eq::EqClassesIterator( &d_equalityEngine );
   while( !eqcs_i.isFinished() ){
     Node eqc = (*eqcs_i);
@@ -1826,7 +1831,6 @@ void TheoryDatatypes::checkCycles() {
         if( options::dtCyclic() ){
           //do cycle checks
           std::map< TNode, bool > visited;
-          std::map< TNode, bool > proc;
           std::vector< TNode > expl;
           Trace("datatypes-cycle-check") << "...search for cycle starting at " << eqc << std::endl;
           Node cn = searchForCycle( eqc, eqc, visited, proc, expl );
@@ -389,6 +389,16 @@ typedef expr::Attribute<SygusToBuiltinTermAttributeId, Node>
 Node sygusToBuiltin(Node n)
 {
   Assert(n.isConst());
+  // values are usually converted more than once, in which case the result is
+  // returned without setting up the traversal
+  if (n.getKind() == APPLY_CONSTRUCTOR)
+  {
+    Node ret = n.getAttribute(SygusToBuiltinTermAttribute());
+    if (!ret.isNull())
+    {
+      return ret;
+    }
+  }
   std::unordered_map<TNode, Node, TNodeHashFunction> visited;
   std::unordered_map<TNode, Node, TNodeHashFunction>::iterator it;
   std::vector<TNode> visit;
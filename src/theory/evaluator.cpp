@@ -16,6 +16,8 @@
 
 #include "theory/evaluator.h"
 
+#include <algorithm>
+
 #include "theory/bv/theory_bv_utils.h"
 #include "theory/rewriter.h"
 #include "theory/strings/theory_strings_utils.h"
@@ -900,5 +902,434 @@ Node Evaluator::reconstruct(
   return Rewriter::rewrite(nn);
 }
 
+/** The number of points evaluated at once by EvaluatorProgram */
+static const size_t s_blockSize = 64;
+
+/** Returns the width of the values of type tn, or 0 if it is not supported */
+static unsigned getValueWidth(TypeNode tn)
+{
+  if (tn.isBoolean())
+  {
+    return 1;
+  }
+  if (tn.isBitVector() && tn.getBitVectorSize() <= 64)
+  {
+    return tn.getBitVectorSize();
+  }
+  return 0;
+}
+
+static uint64_t mkMask(unsigned width)
+{
+  return width >= 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+}
+
+/** Returns the signed value of the width-bit value x */
+static int64_t signExtend(uint64_t x, unsigned width)
+{
+  return width >= 64 ? static_cast<int64_t>(x)
+                     : static_cast<int64_t>(x << (64 - width)) >> (64 - width);
+}
+
+EvaluatorProgram::EvaluatorProgram(TNode n, const std::vector<Node>& args)
+    : d_node(n), d_args(args), d_isBool(n.getType().isBoolean())
+{
+  if (!compile())
+  {
+    Trace("evaluator") << "EvaluatorProgram: cannot compile " << n
+                       << std::endl;
+    d_code.clear();
+  }
+}
+
+unsigned EvaluatorProgram::addInstruction(
+    Op op, unsigned width, unsigned a0, unsigned a1, unsigned a2, uint64_t value)
+{
+  Instruction ins;
+  ins.d_op = op;
+  ins.d_width = width;
+  ins.d_arg[0] = a0;
+  ins.d_arg[1] = a1;
+  ins.d_arg[2] = a2;
+  ins.d_value = value;
+  d_code.push_back(ins);
+  return d_code.size() - 1;
+}
+
+bool EvaluatorProgram::compile()
+{
+  std::unordered_map<TNode, unsigned, TNodeHashFunction> slot;
+  std::vector<TNode> visit;
+  visit.push_back(d_node);
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    if (slot.find(cur) != slot.end())
+    {
+      visit.pop_back();
+      continue;
+    }
+    bool ready = true;
+    for (TNode cn : cur)
+    {
+      if (slot.find(cn) == slot.end())
+      {
+        visit.push_back(cn);
+        ready = false;
+      }
+    }
+    if (!ready)
+    {
+      continue;
+    }
+    visit.pop_back();
+    unsigned width = getValueWidth(cur.getType());
+    if (width == 0)
+    {
+      return false;
+    }
+    std::vector<unsigned> a;
+    for (TNode cn : cur)
+    {
+      a.push_back(slot[cn]);
+    }
+    unsigned res;
+    Kind k = cur.getKind();
+    if (cur.isVar())
+    {
+      const auto& it = std::find(d_args.begin(), d_args.end(), cur);
+      if (it == d_args.end())
+      {
+        return false;
+      }
+      res = addInstruction(VAR, width, 0, 0, 0, it - d_args.begin());
+      slot[cur] = res;
+      continue;
+    }
+    switch (k)
+    {
+      case kind::CONST_BOOLEAN:
+        res = addInstruction(CONST, 1, 0, 0, 0, cur.getConst<bool>() ? 1 : 0);
+        break;
+      case kind::CONST_BITVECTOR:
+        res = addInstruction(
+            CONST,
+            width,
+            0,
+            0,
+            0,
+            cur.getConst<BitVector>().getValue().getUnsignedLong());
+        break;
+      case kind::NOT: res = addInstruction(NOT, 1, a[0]); break;
+      case kind::IMPLIES: res = addInstruction(IMPLIES, 1, a[0], a[1]); break;
+      case kind::AND:
+      case kind::OR:
+      case kind::XOR:
+      case kind::BITVECTOR_AND:
+      case kind::BITVECTOR_OR:
+      case kind::BITVECTOR_XOR:
+      case kind::BITVECTOR_PLUS:
+      case kind::BITVECTOR_MULT:
+      {
+        Op op = (k == kind::AND || k == kind::BITVECTOR_AND)
+                    ? AND
+                    : (k == kind::OR || k == kind::BITVECTOR_OR)
+                          ? OR
+                          : (k == kind::XOR || k == kind::BITVECTOR_XOR)
+                                ? XOR
+                                : k == kind::BITVECTOR_PLUS ? ADD : MUL;
+        res = a[0];
+        for (size_t i = 1, nargs = a.size(); i < nargs; i++)
+        {
+          res = addInstruction(op, width, res, a[i]);
+        }
+        break;
+      }
+      case kind::BITVECTOR_NOT: res = addInstruction(BVNOT, width, a[0]); break;
+      case kind::BITVECTOR_NEG: res = addInstruction(NEG, width, a[0]); break;
+      case kind::BITVECTOR_SUB:
+        res = addInstruction(SUB, width, a[0], a[1]);
+        break;
+      case kind::BITVECTOR_UDIV_TOTAL:
+        res = addInstruction(UDIV, width, a[0], a[1]);
+        break;
+      case kind::BITVECTOR_UREM_TOTAL:
+        res = addInstruction(UREM, width, a[0], a[1]);
+        break;
+      case kind::BITVECTOR_UDIV:
+        res = addInstruction(UDIV_PARTIAL, width, a[0], a[1]);
+        break;
+      case kind::BITVECTOR_UREM:
+        res = addInstruction(UREM_PARTIAL, width, a[0], a[1]);
+        break;
+      case kind::BITVECTOR_SHL:
+        res = addInstruction(SHL, width, a[0], a[1]);
+        break;
+      case kind::BITVECTOR_LSHR:
+        res = addInstruction(LSHR, width, a[0], a[1]);
+        break;
+      case kind::BITVECTOR_ASHR:
+        res = addInstruction(ASHR, width, a[0], a[1], 0, width);
+        break;
+      case kind::EQUAL: res = addInstruction(EQ, 1, a[0], a[1]); break;
+      case kind::BITVECTOR_ULT: res = addInstruction(ULT, 1, a[0], a[1]); break;
+      case kind::BITVECTOR_ULE: res = addInstruction(ULE, 1, a[0], a[1]); break;
+      case kind::BITVECTOR_UGT: res = addInstruction(ULT, 1, a[1], a[0]); break;
+      case kind::BITVECTOR_UGE: res = addInstruction(ULE, 1, a[1], a[0]); break;
+      case kind::BITVECTOR_SLT:
+      case kind::BITVECTOR_SLE:
+      case kind::BITVECTOR_SGT:
+      case kind::BITVECTOR_SGE:
+      {
+        Op op = (k == kind::BITVECTOR_SLT || k == kind::BITVECTOR_SGT) ? SLT
+                                                                       : SLE;
+        bool swap = k == kind::BITVECTOR_SGT || k == kind::BITVECTOR_SGE;
+        res = addInstruction(op,
+                             1,
+                             a[swap ? 1 : 0],
+                             a[swap ? 0 : 1],
+                             0,
+                             getValueWidth(cur[0].getType()));
+        break;
+      }
+      case kind::BITVECTOR_CONCAT:
+      {
+        res = a[0];
+        unsigned w = getValueWidth(cur[0].getType());
+        for (size_t i = 1, nargs = a.size(); i < nargs; i++)
+        {
+          unsigned wi = getValueWidth(cur[i].getType());
+          w += wi;
+          res = addInstruction(CONCAT, w, res, a[i], 0, wi);
+        }
+        break;
+      }
+      case kind::BITVECTOR_EXTRACT:
+        res = addInstruction(
+            EXTRACT, width, a[0], 0, 0, bv::utils::getExtractLow(cur));
+        break;
+      case kind::BITVECTOR_ZERO_EXTEND:
+        // the values are masked, hence extending with zeros is a no-op
+        res = addInstruction(EXTRACT, width, a[0], 0, 0, 0);
+        break;
+      case kind::BITVECTOR_SIGN_EXTEND:
+        res = addInstruction(SIGN_EXTEND,
+                             width,
+                             a[0],
+                             0,
+                             0,
+                             getValueWidth(cur[0].getType()));
+        break;
+      case kind::ITE: res = addInstruction(ITE, width, a[0], a[1], a[2]); break;
+      default:
+        Trace("evaluator") << "EvaluatorProgram: kind " << k
+                           << " not supported" << std::endl;
+        return false;
+    }
+    slot[cur] = res;
+  }
+  return true;
+}
+
+void EvaluatorProgram::evalBlock(const std::vector<std::vector<Node>>& points,
+                                 size_t begin,
+                                 size_t end,
+                                 std::vector<uint64_t>& columns,
+                                 std::vector<char>& failed) const
+{
+  size_t size = end - begin;
+  for (size_t i = 0, ncode = d_code.size(); i < ncode; i++)
+  {
+    const Instruction& ins = d_code[i];
+    uint64_t* r = &columns[i * s_blockSize];
+    const uint64_t* x = &columns[ins.d_arg[0] * s_blockSize];
+    const uint64_t* y = &columns[ins.d_arg[1] * s_blockSize];
+    const uint64_t* z = &columns[ins.d_arg[2] * s_blockSize];
+    const uint64_t mask = mkMask(ins.d_width);
+    const uint64_t width = ins.d_width;
+    const uint64_t value = ins.d_value;
+    switch (ins.d_op)
+    {
+      case CONST:
+        std::fill(r, r + size, value);
+        break;
+      case VAR:
+        for (size_t j = 0; j < size; j++)
+        {
+          TNode v = points[begin + j][value];
+          if (v.getKind() == kind::CONST_BOOLEAN)
+          {
+            r[j] = v.getConst<bool>() ? 1 : 0;
+          }
+          else if (v.getKind() == kind::CONST_BITVECTOR
+                   && v.getConst<BitVector>().getSize() == width)
+          {
+            r[j] = v.getConst<BitVector>().getValue().getUnsignedLong();
+          }
+          else
+          {
+            r[j] = 0;
+            failed[j] = 1;
+          }
+        }
+        break;
+      case NOT:
+        for (size_t j = 0; j < size; j++) r[j] = x[j] ^ 1;
+        break;
+      case AND:
+        for (size_t j = 0; j < size; j++) r[j] = x[j] & y[j];
+        break;
+      case OR:
+        for (size_t j = 0; j < size; j++) r[j] = x[j] | y[j];
+        break;
+      case XOR:
+        for (size_t j = 0; j < size; j++) r[j] = x[j] ^ y[j];
+        break;
+      case IMPLIES:
+        for (size_t j = 0; j < size; j++) r[j] = (x[j] ^ 1) | y[j];
+        break;
+      case BVNOT:
+        for (size_t j = 0; j < size; j++) r[j] = ~x[j] & mask;
+        break;
+      case NEG:
+        for (size_t j = 0; j < size; j++) r[j] = (0 - x[j]) & mask;
+        break;
+      case ADD:
+        for (size_t j = 0; j < size; j++) r[j] = (x[j] + y[j]) & mask;
+        break;
+      case SUB:
+        for (size_t j = 0; j < size; j++) r[j] = (x[j] - y[j]) & mask;
+        break;
+      case MUL:
+        for (size_t j = 0; j < size; j++) r[j] = (x[j] * y[j]) & mask;
+        break;
+      case UDIV:
+        for (size_t j = 0; j < size; j++)
+        {
+          r[j] = y[j] == 0 ? mask : x[j] / y[j];
+        }
+        break;
+      case UREM:
+        for (size_t j = 0; j < size; j++)
+        {
+          r[j] = y[j] == 0 ? x[j] : x[j] % y[j];
+        }
+        break;
+      case UDIV_PARTIAL:
+      case UREM_PARTIAL:
+        // undefined on zero, which is left to the Evaluator class
+        for (size_t j = 0; j < size; j++)
+        {
+          if (y[j] == 0)
+          {
+            r[j] = 0;
+            failed[j] = 1;
+          }
+          else
+          {
+            r[j] = ins.d_op == UDIV_PARTIAL ? x[j] / y[j] : x[j] % y[j];
+          }
+        }
+        break;
+      case SHL:
+        for (size_t j = 0; j < size; j++)
+        {
+          r[j] = y[j] >= width ? 0 : (x[j] << y[j]) & mask;
+        }
+        break;
+      case LSHR:
+        for (size_t j = 0; j < size; j++)
+        {
+          r[j] = y[j] >= width ? 0 : x[j] >> y[j];
+        }
+        break;
+      case ASHR:
+        for (size_t j = 0; j < size; j++)
+        {
+          r[j] = static_cast<uint64_t>(signExtend(x[j], value)
+                                       >> std::min(y[j], width - 1))
+                 & mask;
+        }
+        break;
+      case EQ:
+        for (size_t j = 0; j < size; j++) r[j] = x[j] == y[j];
+        break;
+      case ULT:
+        for (size_t j = 0; j < size; j++) r[j] = x[j] < y[j];
+        break;
+      case ULE:
+        for (size_t j = 0; j < size; j++) r[j] = x[j] <= y[j];
+        break;
+      case SLT:
+        for (size_t j = 0; j < size; j++)
+        {
+          r[j] = signExtend(x[j], value) < signExtend(y[j], value);
+        }
+        break;
+      case SLE:
+        for (size_t j = 0; j < size; j++)
+        {
+          r[j] = signExtend(x[j], value) <= signExtend(y[j], value);
+        }
+        break;
+      case CONCAT:
+        for (size_t j = 0; j < size; j++) r[j] = (x[j] << value) | y[j];
+        break;
+      case EXTRACT:
+        for (size_t j = 0; j < size; j++) r[j] = (x[j] >> value) & mask;
+        break;
+      case SIGN_EXTEND:
+        for (size_t j = 0; j < size; j++)
+        {
+          r[j] = static_cast<uint64_t>(signExtend(x[j], value)) & mask;
+        }
+        break;
+      case ITE:
+        for (size_t j = 0; j < size; j++) r[j] = x[j] ? y[j] : z[j];
+        break;
+    }
+  }
+}
+
+void EvaluatorProgram::eval(const std::vector<std::vector<Node>>& points,
+                            std::vector<Node>& results) const
+{
+  if (!isCompiled())
+  {
+    for (const std::vector<Node>& pt : points)
+    {
+      results.push_back(d_eval.eval(d_node, d_args, pt));
+    }
+    return;
+  }
+  NodeManager* nm = NodeManager::currentNM();
+  unsigned width = d_code.back().d_width;
+  std::vector<uint64_t> columns(d_code.size() * s_blockSize);
+  std::vector<char> failed(s_blockSize);
+  for (size_t begin = 0, npoints = points.size(); begin < npoints;
+       begin += s_blockSize)
+  {
+    size_t end = std::min(begin + s_blockSize, npoints);
+    std::fill(failed.begin(), failed.end(), 0);
+    evalBlock(points, begin, end, columns, failed);
+    const uint64_t* r = &columns[(d_code.size() - 1) * s_blockSize];
+    for (size_t j = 0; j < end - begin; j++)
+    {
+      if (failed[j])
+      {
+        results.push_back(d_eval.eval(d_node, d_args, points[begin + j]));
+      }
+      else if (d_isBool)
+      {
+        results.push_back(nm->mkConst(r[j] != 0));
+      }
+      else
+      {
+        results.push_back(nm->mkConst(BitVector(width, r[j])));
+      }
+    }
+  }
+}
+
 }  // namespace theory
 }  // namespace CVC4
@@ -20,6 +20,7 @@
 #ifndef CVC4__THEORY__EVALUATOR_H
 #define CVC4__THEORY__EVALUATOR_H
 
+#include <cstdint>
 #include <utility>
 #include <vector>
 
@@ -142,6 +143,114 @@ class Evaluator
       std::unordered_map<TNode, Node, NodeHashFunction>& evalAsNode) const;
 };
 
+/**
+ * A term compiled for its evaluation under many substitutions of the same
+ * variables, e.g. on the sample points of a sygus sampler or on the examples
+ * of a PBE conjecture.
+ *
+ * The term is flattened into a sequence of instructions, one for each of its
+ * subterms, whose operands are earlier instructions. The points are evaluated
+ * in blocks, one instruction at a time, where each instruction computes a
+ * column of values, one per point, with a loop over contiguous memory that
+ * the compiler can vectorize. This applies to the terms whose subterms are
+ * Booleans and bit-vectors of width at most 64 built from the operators
+ * supported by compile. Other terms, and the points where a partial operator
+ * is undefined, are evaluated by the Evaluator class.
+ */
+class EvaluatorProgram
+{
+ public:
+  EvaluatorProgram(TNode n, const std::vector<Node>& args);
+
+  /** Returns true if the term could be compiled */
+  bool isCompiled() const { return !d_code.empty(); }
+
+  /**
+   * Adds to results the evaluation of the term under the substitution of
+   * args by points[j] for each j, which is the same as the result of
+   * Evaluator::eval on each point.
+   */
+  void eval(const std::vector<std::vector<Node>>& points,
+            std::vector<Node>& results) const;
+
+ private:
+  /** The operations of the instructions */
+  enum Op
+  {
+    CONST,
+    VAR,
+    NOT,
+    AND,
+    OR,
+    XOR,
+    IMPLIES,
+    BVNOT,
+    NEG,
+    ADD,
+    SUB,
+    MUL,
+    UDIV,
+    UREM,
+    UDIV_PARTIAL,
+    UREM_PARTIAL,
+    SHL,
+    LSHR,
+    ASHR,
+    EQ,
+    ULT,
+    ULE,
+    SLT,
+    SLE,
+    CONCAT,
+    EXTRACT,
+    SIGN_EXTEND,
+    ITE
+  };
+  /**
+   * An instruction whose value is the operation d_op applied to the values
+   * of the instructions d_arg, masked to d_width bits. The meaning of
+   * d_value depends on d_op: it is the constant of CONST, the index of the
+   * variable of VAR, the shift of EXTRACT and the width of the operand of
+   * CONCAT, SIGN_EXTEND and of the signed operations.
+   */
+  struct Instruction
+  {
+    Op d_op;
+    unsigned d_width;
+    unsigned d_arg[3];
+    uint64_t d_value;
+  };
+
+  /** Compiles the term d_node, returns false if it is not supported */
+  bool compile();
+  /** Adds an instruction, returns its index */
+  unsigned addInstruction(Op op,
+                          unsigned width,
+                          unsigned a0,
+                          unsigned a1 = 0,
+                          unsigned a2 = 0,
+                          uint64_t value = 0);
+  /**
+   * Evaluates the points [begin, end) into the columns. Sets failed[j - begin]
+   * for the points j that must be evaluated by the Evaluator class.
+   */
+  void evalBlock(const std::vector<std::vector<Node>>& points,
+                 size_t begin,
+                 size_t end,
+                 std::vector<uint64_t>& columns,
+                 std::vector<char>& failed) const;
+
+  /** The term and its variables */
+  Node d_node;
+  std::vector<Node> d_args;
+  /** The instructions, the last one is the term, empty if not compiled */
+  std::vector<Instruction> d_code;
+  /** Whether the term is a Boolean */
+  bool d_isBool;
+  /** The evaluator of the points the instructions do not apply to */
+  Evaluator d_eval;
+};
+
 }  // namespace theory
 }  // namespace CVC4
 
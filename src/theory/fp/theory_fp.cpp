@@ -394,6 +394,48 @@ Node TheoryFp::abstractFloatToReal(Node node)
   return uf;
 }
 
+bool TheoryFp::isLazyOperation(Kind k)
+{
+  return k == kind::FLOATINGPOINT_MULT || k == kind::FLOATINGPOINT_DIV
+         || k == kind::FLOATINGPOINT_FMA || k == kind::FLOATINGPOINT_SQRT
+         || k == kind::FLOATINGPOINT_REM;
+}
+
+Node TheoryFp::abstractOperation(Node node)
+{
+  Assert(isLazyOperation(node.getKind()));
+  NodeManager *nm = NodeManager::currentNM();
+  std::pair<Kind, TypeNode> key(node.getKind(), node.getType());
+  std::map<std::pair<Kind, TypeNode>, Node>::const_iterator i =
+      d_operationUFMap.find(key);
+
+  Node fun;
+  if (i == d_operationUFMap.end())
+  {
+    std::vector<TypeNode> args;
+    for (const Node &n : node)
+    {
+      args.push_back(n.getType());
+    }
+    fun = nm->mkSkolem("floatingpoint_abstract_operation",
+                       nm->mkFunctionType(args, node.getType()),
+                       "floatingpoint_abstract_operation");
+    d_operationUFMap[key] = fun;
+  }
+  else
+  {
+    fun = (*i).second;
+  }
+  std::vector<Node> children;
+  children.push_back(fun);
+  children.insert(children.end(), node.begin(), node.end());
+  Node uf = nm->mkNode(kind::APPLY_UF, children);
+
+  abstractionMap.insert(uf, node);
+
+  return uf;
+}
+
 Node TheoryFp::expandDefinition(LogicRequest &lr, Node node)
 {
   Trace("fp-expandDefinition") << "TheoryFp::expandDefinition(): " << node
@@ -445,7 +487,8 @@ Node TheoryFp::expandDefinition(LogicRequest &lr, Node node)
 
   // We will need to enable UF to abstract these in ppRewrite
   if (res.getKind() == kind::FLOATINGPOINT_TO_REAL_TOTAL
-      || res.getKind() == kind::FLOATINGPOINT_TO_FP_REAL)
+      || res.getKind() == kind::FLOATINGPOINT_TO_FP_REAL
+      || (options::fpLazyOps() && isLazyOperation(res.getKind())))
   {
     enableUF(lr);
   }
@@ -511,6 +554,12 @@ Node TheoryFp::ppRewrite(TNode node)
     // TODO : rounding-mode specific bounds on floats that don't give infinity
     // BEWARE of directed rounding!   #1914
   }
+  else if (options::fpLazyOps() && isLazyOperation(node.getKind()))
+  {
+    // Start without the circuit of the operation, it is only added by
+    // refineAbstraction if the candidate models disagree with it.
+    res = abstractOperation(node);
+  }
 
   if (res != node)
   {
@@ -734,6 +783,45 @@ bool TheoryFp::refineAbstraction(TheoryModel *m, TNode abstract, TNode concrete)
       return false;
     }
   }
+  else if (isLazyOperation(k))
+  {
+    // Evaluate the operation on the values of its arguments
+    Assert(m->hasTerm(abstract));
+    Node abstractValue = m->getValue(abstract);
+    Assert(abstractValue.isConst());
+
+    NodeManager *nm = NodeManager::currentNM();
+    std::vector<Node> argValues;
+    for (const Node &n : concrete)
+    {
+      argValues.push_back(m->getValue(n));
+      Assert(argValues.back().isConst());
+    }
+    Node concreteValue = Rewriter::rewrite(nm->mkNode(k, argValues));
+    Assert(concreteValue.isConst());
+
+    Trace("fp-refineAbstraction")
+        << "TheoryFp::refineAbstraction(): " << abstract << " = "
+        << abstractValue << std::endl
+        << "TheoryFp::refineAbstraction(): " << concrete << " = "
+        << concreteValue << std::endl;
+
+    if (abstractValue != concreteValue)
+    {
+      // Bit-blast the operation.  The lemma is not preprocessed, which would
+      // abstract the operation again; its arguments are preprocessed already.
+      Node def = nm->mkNode(kind::EQUAL, abstract, concrete);
+      Trace("fp") << "TheoryFp::refineAbstraction(): asserting " << def
+                  << std::endl;
+      d_out->lemma(def, false, false);
+      return true;
+    }
+    else
+    {
+      // No refinement needed
+      return false;
+    }
+  }
   else
   {
     Unreachable() << "Unknown abstraction";
@@ -20,6 +20,7 @@
 #ifndef CVC4__THEORY__FP__THEORY_FP_H
 #define CVC4__THEORY__FP__THEORY_FP_H
 
+#include <map>
 #include <string>
 #include <utility>
 
@@ -137,6 +138,17 @@ class TheoryFp : public Theory {
   Node abstractRealToFloat(Node);
   Node abstractFloatToReal(Node);
 
+  /**
+   * Uninterpreted functions for the lazy handling of the operations with
+   * large circuits (--fp-lazy-ops), by kind and type of the operation.  They
+   * are fresh symbols, so they are kept across user contexts.
+   */
+  std::map<std::pair<Kind, TypeNode>, Node> d_operationUFMap;
+
+  /** Is k an operation that is abstracted with --fp-lazy-ops? */
+  static bool isLazyOperation(Kind k);
+  Node abstractOperation(Node);
+
   typedef context::CDHashMap<Node, Node, NodeHashFunction> abstractionMapType;
   abstractionMapType abstractionMap;  // abstract -> original
 
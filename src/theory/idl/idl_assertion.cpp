@@ -51,6 +51,14 @@ IDLAssertion::IDLAssertion(TNode node) {
   d_original = node;
 }
 
+IDLAssertion::IDLAssertion(TNode x,
+                           TNode y,
+                           const Integer& c,
+                           TNode original)
+    : d_x(x), d_y(y), d_op(kind::LEQ), d_c(c), d_original(original)
+{
+}
+
 IDLAssertion::IDLAssertion(const IDLAssertion& other)
 : d_x(other.d_x)
 , d_y(other.d_y)
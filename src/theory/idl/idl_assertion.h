@@ -51,6 +51,8 @@ public:
   IDLAssertion();
   /** Create the assertion from given node */
   IDLAssertion(TNode node);
+  /** Create the assertion (x - y <= c) justified by the given node */
+  IDLAssertion(TNode x, TNode y, const Integer& c, TNode original);
   /** Copy constructor */
   IDLAssertion(const IDLAssertion& other);
 
@@ -58,6 +60,7 @@ public:
   TNode getY() const { return d_y; }
   Kind getOp() const { return d_op;}
   Integer getC() const { return d_c; }
+  TNode getOriginal() const { return d_original; }
 
   /**
    * Propagate the constraint using the model. For example, if the constraint
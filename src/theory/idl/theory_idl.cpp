@@ -17,11 +17,13 @@
 
 #include "theory/idl/theory_idl.h"
 
-#include <set>
 #include <queue>
+#include <set>
+#include <unordered_set>
 
 #include "options/idl_options.h"
 #include "theory/rewriter.h"
+#include "theory/theory_model.h"
 
 
 using namespace std;
@@ -30,12 +32,41 @@ namespace CVC4 {
 namespace theory {
 namespace idl {
 
+namespace {
+
+/** An entry of the priority queues of the searches */
+struct QueueEntry
+{
+  /** The key of the entry */
+  Integer d_value;
+  /** The variable of the entry */
+  TNode d_var;
+
+  QueueEntry(const Integer& value, TNode var) : d_value(value), d_var(var) {}
+
+  bool operator<(const QueueEntry& other) const
+  {
+    return d_value < other.d_value;
+  }
+  bool operator>(const QueueEntry& other) const
+  {
+    return d_value > other.d_value;
+  }
+};
+
+}  // namespace
+
 TheoryIdl::TheoryIdl(context::Context* c, context::UserContext* u,
                      OutputChannel& out, Valuation valuation,
                      const LogicInfo& logicInfo)
     : Theory(THEORY_ARITH, c, u, out, valuation, logicInfo)
     , d_model(c)
     , d_assertionsDB(c)
+    , d_incomingDB(c)
+    , d_atomsDB(u)
+    , d_disequalities(c)
+    , d_splitDisequalities(u)
+    , d_explanations(c)
 {}
 
 Node TheoryIdl::ppRewrite(TNode atom) {
@@ -51,6 +82,19 @@ Node TheoryIdl::ppRewrite(TNode atom) {
   }
 }
 
+void TheoryIdl::preRegisterTerm(TNode node) {
+  Kind k = node.getKind();
+  if (k != kind::LT && k != kind::LEQ && k != kind::GT && k != kind::GEQ) {
+    return;
+  }
+  IDLAssertion atom(node);
+  if (atom.ok()) {
+    Debug("theory::idl") << "TheoryIdl::preRegisterTerm(): " << atom
+                         << std::endl;
+    d_atomsDB.add(atom, atom.getX());
+  }
+}
+
 void TheoryIdl::check(Effort level) {
   if (done() && !fullEffort(level)) {
     return;
@@ -70,16 +114,27 @@ void TheoryIdl::check(Effort level) {
     Debug("theory::idl") << "TheoryIdl::check(): got " << idlAssertion << std::endl;
 
     if (idlAssertion.ok()) {
+      bool ok = true;
       if (idlAssertion.getOp() == kind::DISTINCT) {
-        // We don't handle dis-equalities
-        d_out->setIncomplete();
+        // Dis-equalities are split at full effort if violated
+        d_disequalities.push_back(idlAssertion);
+      } else if (idlAssertion.getOp() == kind::EQUAL) {
+        // (x - y = c) is both (x - y <= c) and (y - x <= -c)
+        ok = processAssertion(IDLAssertion(idlAssertion.getX(),
+                                           idlAssertion.getY(),
+                                           idlAssertion.getC(),
+                                           idlAssertion.getOriginal()))
+             && processAssertion(IDLAssertion(idlAssertion.getY(),
+                                              idlAssertion.getX(),
+                                              -idlAssertion.getC(),
+                                              idlAssertion.getOriginal()));
       } else {
         // Process the convex assertions immediately
-        bool ok = processAssertion(idlAssertion);
-        if (!ok) {
-          // In conflict, we're done
-          return;
-        }
+        ok = processAssertion(idlAssertion);
+      }
+      if (!ok) {
+        // In conflict, we're done
+        return;
       }
     } else {
       // Not an IDL assertion, set incomplete
@@ -87,62 +142,93 @@ void TheoryIdl::check(Effort level) {
     }
   }
 
+  if (fullEffort(level)) {
+    splitDisequalities();
+  }
 }
 
 bool TheoryIdl::processAssertion(const IDLAssertion& assertion) {
 
   Debug("theory::idl") << "TheoryIdl::processAssertion(" << assertion << ")" << std::endl;
 
-  // Add the constraint (x - y op c) to the list assertions of x
+  // Add the constraint (x - y op c) to the list assertions of x and y
   d_assertionsDB.add(assertion, assertion.getX());
+  d_incomingDB.add(assertion, assertion.getY());
 
-  // Update the model, if forced by the assertion
-  bool y_updated = assertion.propagate(d_model);
-
-  // If the value of y was updated, we might need to update further
-  if (y_updated) {
-
-    std::queue<TNode> queue; // Queue of variables to consider
-    std::set<TNode> inQueue; // Current elements of the queue
-
-    // Add the first updated variable to the queue
-    queue.push(assertion.getY());
-    inQueue.insert(assertion.getY());
-
-    while (!queue.empty()) {
-      // Pop a new variable x off the queue
-      TNode x = queue.front();
-      queue.pop();
-      inQueue.erase(x);
-
-      // Go through the constraint (x - y op c), and update values of y
-      IDLAssertionDB::iterator it(d_assertionsDB, x);
-      while (!it.done()) {
-        // Get the assertion and update y
-        IDLAssertion x_y_assertion = it.get();
-        y_updated = x_y_assertion.propagate(d_model);
-        // If updated add to the queue
-        if (y_updated) {
-          // If the variable that we updated is the same as the first
-          // variable that we updated, it's a cycle of updates => conflict
-          if (x_y_assertion.getY() == assertion.getX()) {
-            std::vector<TNode> reasons;
-            d_model.getReasonCycle(x_y_assertion.getY(), reasons);
-            // Construct the reason of the conflict
-            Node conflict = NodeManager::currentNM()->mkNode(kind::AND, reasons);
-            d_out->conflict(conflict);
-            return false;
-          } else {
-            // No cycle, just a model update, so we add to the queue
-            TNode y = x_y_assertion.getY();
-            if (inQueue.count(y) == 0) {
-              queue.push(y);
-              inQueue.insert(x_y_assertion.getY());
-            }
-          }
-        }
-        // Go to the next constraint
-        it.next();
+  return updateModel(assertion) && propagateAtoms(assertion);
+}
+
+bool TheoryIdl::updateModel(const IDLAssertion& assertion) {
+  TNode x = assertion.getX();
+  TNode y = assertion.getY();
+
+  // The constraint requires y >= x - c
+  Integer increase =
+      d_model.getValue(x) - assertion.getC() - d_model.getValue(y);
+  if (increase.sgn() <= 0) {
+    return true;
+  }
+
+  // The model satisfies all other constraints, so the increase needed by a
+  // variable is bounded by the increases of the variables it depends on. The
+  // variables are thus processed by decreasing increase, each one once, and
+  // the constraint closes a negative cycle iff x has to increase.
+  std::unordered_map<TNode, Integer, TNodeHashFunction> increases;
+  std::unordered_map<TNode, IDLReason, TNodeHashFunction> reasons;
+  std::unordered_set<TNode, TNodeHashFunction> processed;
+  std::priority_queue<QueueEntry> queue;
+  increases[y] = increase;
+  reasons[y] = IDLReason(x, assertion.getOriginal());
+  queue.push(QueueEntry(increase, y));
+
+  while (!queue.empty()) {
+    QueueEntry entry = queue.top();
+    queue.pop();
+    TNode var = entry.d_var;
+    if (processed.find(var) != processed.end()
+        || increases[var] != entry.d_value) {
+      // Stale entry
+      continue;
+    }
+
+    if (var == x) {
+      std::vector<TNode> cycle;
+      TNode current = x;
+      do {
+        const IDLReason& reason = reasons[current];
+        cycle.push_back(reason.d_constraint);
+        current = reason.d_x;
+      } while (current != x);
+      Node conflict = mkExplanation(cycle);
+      Debug("theory::idl") << "TheoryIdl::updateModel(): conflict " << conflict
+                           << std::endl;
+      d_out->conflict(conflict);
+      return false;
+    }
+
+    processed.insert(var);
+    Integer value = d_model.getValue(var) + entry.d_value;
+    d_model.setValue(var, value, reasons[var]);
+
+    // Go through the constraints (var - z <= c), and update the increases of z
+    for (IDLAssertionDB::iterator it(d_assertionsDB, var); !it.done();
+         it.next()) {
+      IDLAssertion var_z_assertion = it.get();
+      TNode z = var_z_assertion.getY();
+      if (processed.find(z) != processed.end()) {
+        continue;
+      }
+      Integer z_increase =
+          value - var_z_assertion.getC() - d_model.getValue(z);
+      if (z_increase.sgn() <= 0) {
+        continue;
+      }
+      std::unordered_map<TNode, Integer, TNodeHashFunction>::iterator find =
+          increases.find(z);
+      if (find == increases.end() || (*find).second < z_increase) {
+        increases[z] = z_increase;
+        reasons[z] = IDLReason(var, var_z_assertion.getOriginal());
+        queue.push(QueueEntry(z_increase, z));
       }
     }
   }
@@ -151,6 +237,218 @@ bool TheoryIdl::processAssertion(const IDLAssertion& assertion) {
   return true;
 }
 
+void TheoryIdl::boundedSearch(TNode root, bool forward, SearchTree& tree) {
+  // The reduced lengths c - x + y of the constraints (x - y <= c) are
+  // non-negative, so Dijkstra applies to them
+  std::unordered_map<TNode, Integer, TNodeHashFunction> distances;
+  std::unordered_map<TNode, SearchNode, TNodeHashFunction> parents;
+  std::priority_queue<QueueEntry,
+                      std::vector<QueueEntry>,
+                      std::greater<QueueEntry>>
+      queue;
+  Integer rootValue = d_model.getValue(root);
+  distances[root] = 0;
+  parents[root] = SearchNode{0, root, TNode::null()};
+  queue.push(QueueEntry(0, root));
+
+  unsigned limit = options::idlPropagationLimit();
+  while (!queue.empty() && tree.size() < limit) {
+    QueueEntry entry = queue.top();
+    queue.pop();
+    TNode var = entry.d_var;
+    if (tree.find(var) != tree.end() || distances[var] != entry.d_value) {
+      // Stale entry
+      continue;
+    }
+
+    // The distance is final, get the actual length of the path
+    Integer value = d_model.getValue(var);
+    SearchNode node = parents[var];
+    node.d_distance = forward ? entry.d_value + rootValue - value
+                              : entry.d_value + value - rootValue;
+    tree[var] = node;
+
+    IDLAssertionDB& db = forward ? d_assertionsDB : d_incomingDB;
+    for (IDLAssertionDB::iterator it(db, var); !it.done(); it.next()) {
+      IDLAssertion edge = it.get();
+      TNode next = forward ? edge.getY() : edge.getX();
+      if (tree.find(next) != tree.end()) {
+        continue;
+      }
+      Integer nextValue = d_model.getValue(next);
+      Integer reduced = forward ? edge.getC() - value + nextValue
+                                : edge.getC() - nextValue + value;
+      Assert(reduced.sgn() >= 0);
+      Integer distance = entry.d_value + reduced;
+      std::unordered_map<TNode, Integer, TNodeHashFunction>::iterator find =
+          distances.find(next);
+      if (find == distances.end() || distance < (*find).second) {
+        distances[next] = distance;
+        parents[next] = SearchNode{0, var, edge.getOriginal()};
+        queue.push(QueueEntry(distance, next));
+      }
+    }
+  }
+}
+
+bool TheoryIdl::propagateAtoms(const IDLAssertion& assertion) {
+  if (options::idlPropagationLimit() == 0) {
+    return true;
+  }
+
+  // The paths u ~> x -> y ~> v through the constraint (x - y <= c)
+  SearchTree backward;
+  SearchTree forward;
+  boundedSearch(assertion.getX(), false, backward);
+  boundedSearch(assertion.getY(), true, forward);
+
+  // The atoms (u - v <= k) are implied if d(u, x) + c + d(y, v) <= k
+  for (const std::pair<const TNode, SearchNode>& b : backward) {
+    for (IDLAssertionDB::iterator it(d_atomsDB, b.first); !it.done();
+         it.next()) {
+      IDLAssertion atom = it.get();
+      SearchTree::const_iterator f = forward.find(atom.getY());
+      if (f != forward.end()
+          && b.second.d_distance + assertion.getC() + (*f).second.d_distance
+                 <= atom.getC()) {
+        if (!propagateLiteral(
+                atom.getOriginal(), assertion, b.first, f->first, backward,
+                forward)) {
+          return false;
+        }
+      }
+    }
+  }
+
+  // The atoms (u - v <= k) are falsified if (v - u <= -k - 1) is implied,
+  // i.e. if d(v, x) + c + d(y, u) < -k
+  for (const std::pair<const TNode, SearchNode>& f : forward) {
+    for (IDLAssertionDB::iterator it(d_atomsDB, f.first); !it.done();
+         it.next()) {
+      IDLAssertion atom = it.get();
+      SearchTree::const_iterator b = backward.find(atom.getY());
+      if (b != backward.end()
+          && (*b).second.d_distance + assertion.getC() + f.second.d_distance
+                 < -atom.getC()) {
+        if (!propagateLiteral(atom.getOriginal().notNode(),
+                              assertion,
+                              b->first,
+                              f.first,
+                              backward,
+                              forward)) {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+bool TheoryIdl::propagateLiteral(TNode lit,
+                                 const IDLAssertion& assertion,
+                                 TNode from,
+                                 TNode to,
+                                 const SearchTree& backward,
+                                 const SearchTree& forward) {
+  TNode atom = lit.getKind() == kind::NOT ? lit[0] : lit;
+  bool value;
+  if (!d_valuation.isSatLiteral(atom) || d_valuation.hasSatValue(atom, value)
+      || d_explanations.find(lit) != d_explanations.end()) {
+    return true;
+  }
+
+  // The constraints on the path from ~> x -> y ~> to
+  std::vector<TNode> reasons;
+  for (SearchTree::const_iterator it = backward.find(from);
+       !(*it).second.d_reason.isNull();
+       it = backward.find((*it).second.d_parent)) {
+    reasons.push_back((*it).second.d_reason);
+  }
+  reasons.push_back(assertion.getOriginal());
+  for (SearchTree::const_iterator it = forward.find(to);
+       !(*it).second.d_reason.isNull();
+       it = forward.find((*it).second.d_parent)) {
+    reasons.push_back((*it).second.d_reason);
+  }
+
+  Node explanation = mkExplanation(reasons);
+  Debug("theory::idl") << "TheoryIdl::propagateLiteral(): " << lit
+                       << " by " << explanation << std::endl;
+  d_explanations[lit] = explanation;
+  return d_out->propagate(lit);
+}
+
+Node TheoryIdl::explain(TNode n) {
+  context::CDHashMap<Node, Node, NodeHashFunction>::const_iterator find =
+      d_explanations.find(n);
+  Assert(find != d_explanations.end());
+  return (*find).second;
+}
+
+bool TheoryIdl::splitDisequalities() {
+  NodeManager* nm = NodeManager::currentNM();
+  bool split = false;
+  for (context::CDList<IDLAssertion>::const_iterator
+           it = d_disequalities.begin(),
+           it_end = d_disequalities.end();
+       it != it_end;
+       ++it) {
+    const IDLAssertion& diseq = *it;
+    if (d_model.getValue(diseq.getX()) - d_model.getValue(diseq.getY())
+        != diseq.getC()) {
+      continue;
+    }
+    Assert(diseq.getOriginal().getKind() == kind::NOT);
+    Node eq = diseq.getOriginal()[0];
+    if (d_splitDisequalities.contains(eq)) {
+      continue;
+    }
+    d_splitDisequalities.insert(eq);
+    Node lt = Rewriter::rewrite(nm->mkNode(kind::LT, eq[0], eq[1]));
+    Node gt = Rewriter::rewrite(nm->mkNode(kind::GT, eq[0], eq[1]));
+    Node lemma = nm->mkNode(kind::OR, eq, lt, gt);
+    Debug("theory::idl") << "TheoryIdl::splitDisequalities(): " << lemma
+                         << std::endl;
+    d_out->lemma(lemma);
+    split = true;
+  }
+  return split;
+}
+
+Node TheoryIdl::mkExplanation(const std::vector<TNode>& reasons) {
+  std::vector<TNode> conjuncts;
+  std::unordered_set<TNode, TNodeHashFunction> seen;
+  for (TNode reason : reasons) {
+    if (seen.insert(reason).second) {
+      conjuncts.push_back(reason);
+    }
+  }
+  return conjuncts.size() == 1
+             ? Node(conjuncts[0])
+             : NodeManager::currentNM()->mkNode(kind::AND, conjuncts);
+}
+
+bool TheoryIdl::collectModelInfo(TheoryModel* m) {
+  std::set<Node> termSet;
+  computeRelevantTerms(termSet);
+
+  // The values are relative to the one of the null variable, i.e. zero
+  NodeManager* nm = NodeManager::currentNM();
+  Integer zero = d_model.getValue(TNode::null());
+  for (const Node& term : termSet) {
+    if (term.isConst() || !term.getType().isReal()
+        || !Theory::isLeafOf(term, THEORY_ARITH)) {
+      continue;
+    }
+    Node value = nm->mkConst(Rational(d_model.getValue(term) - zero));
+    if (!m->assertEquality(term, value, true)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 } /* namepsace CVC4::theory::idl */
 } /* namepsace CVC4::theory */
 } /* namepsace CVC4 */
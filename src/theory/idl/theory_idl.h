@@ -17,8 +17,12 @@
 
 #pragma once
 
-#include "cvc4_private.h"
+#include <unordered_map>
+#include <vector>
 
+#include "context/cdhashmap.h"
+#include "context/cdhashset.h"
+#include "context/cdlist.h"
 #include "theory/theory.h"
 #include "theory/idl/idl_model.h"
 #include "theory/idl/idl_assertion_db.h"
@@ -29,6 +33,15 @@ namespace idl {
 
 /**
  * Handles integer difference logic (IDL) constraints.
+ *
+ * The constraints (x - y <= c) are the edges of a graph, and the model is a
+ * feasible potential function on its variables. A new edge is added by
+ * repairing the model with a Dijkstra-like search that increases the values
+ * of the affected variables, visiting each of them at most once, and that
+ * detects the negative cycles. The preregistered atoms implied by the new
+ * edge are propagated by bounded shortest path searches from and to its
+ * variables, and explained by the edges of these paths. Disequalities are
+ * split on demand at full effort.
  */
 class TheoryIdl : public Theory {
 
@@ -38,9 +51,72 @@ class TheoryIdl : public Theory {
   /** The asserted constraints, organized by variable */
   IDLAssertionDB d_assertionsDB;
 
+  /** The asserted constraints, organized by their negative variable */
+  IDLAssertionDB d_incomingDB;
+
+  /** The preregistered atoms, organized by variable */
+  IDLAssertionDB d_atomsDB;
+
+  /** The asserted disequalities */
+  context::CDList<IDLAssertion> d_disequalities;
+
+  /** The equalities whose disequalities have been split */
+  context::CDHashSet<Node, NodeHashFunction> d_splitDisequalities;
+
+  /** The explanations of the propagated literals */
+  context::CDHashMap<Node, Node, NodeHashFunction> d_explanations;
+
+  /** A vertex of the shortest path tree of a bounded search */
+  struct SearchNode
+  {
+    /** The length of the path from (or to) the root */
+    Integer d_distance;
+    /** The previous variable on the path */
+    TNode d_parent;
+    /** The constraint between the parent and the variable, null at root */
+    TNode d_reason;
+  };
+  typedef std::unordered_map<TNode, SearchNode, TNodeHashFunction> SearchTree;
+
   /** Process a new assertion, returns false if in conflict */
   bool processAssertion(const IDLAssertion& assertion);
 
+  /**
+   * Repairs the model for the new constraint. Returns false and sends a
+   * conflict if the constraint closes a negative cycle.
+   */
+  bool updateModel(const IDLAssertion& assertion);
+
+  /**
+   * Computes the shortest paths from root (or to root if not forward) to at
+   * most idlPropagationLimit variables, using the model as potential.
+   */
+  void boundedSearch(TNode root, bool forward, SearchTree& tree);
+
+  /**
+   * Propagates the unassigned atoms implied by the new constraint and the
+   * paths to and from its variables. Returns false if in conflict.
+   */
+  bool propagateAtoms(const IDLAssertion& assertion);
+
+  /**
+   * Propagates lit, implied by the path from the variable from to the
+   * variable to through the constraint assertion. Returns false if in
+   * conflict.
+   */
+  bool propagateLiteral(TNode lit,
+                        const IDLAssertion& assertion,
+                        TNode from,
+                        TNode to,
+                        const SearchTree& backward,
+                        const SearchTree& forward);
+
+  /** Splits the disequalities violated by the model, true if any was split */
+  bool splitDisequalities();
+
+  /** Returns the conjunction of the reasons, without duplicates */
+  static Node mkExplanation(const std::vector<TNode>& reasons);
+
 public:
 
   /** Theory constructor. */
@@ -50,9 +126,18 @@ public:
   /** Pre-processing of input atoms */
   Node ppRewrite(TNode atom) override;
 
+  /** Registers the atoms for theory propagation */
+  void preRegisterTerm(TNode node) override;
+
   /** Check the assertions for satisfiability */
   void check(Effort effort) override;
 
+  /** Explain a propagated literal */
+  Node explain(TNode n) override;
+
+  /** Assert the values of the variables to the model */
+  bool collectModelInfo(TheoryModel* m) override;
+
   /** Identity string */
   std::string identify() const override { return "THEORY_IDL"; }
 
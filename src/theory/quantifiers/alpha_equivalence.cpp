@@ -15,6 +15,8 @@
 
 #include "theory/quantifiers/alpha_equivalence.h"
 
+#include "expr/attribute.h"
+#include "theory/quantifiers/term_util.h"
 #include "theory/quantifiers_engine.h"
 
 using namespace CVC4;
@@ -23,6 +25,76 @@ using namespace CVC4::theory;
 using namespace CVC4::theory::quantifiers;
 using namespace CVC4::kind;
 
+namespace {
+
+struct AlphaEquivalenceHashAttributeId
+{
+};
+typedef expr::Attribute<AlphaEquivalenceHashAttributeId, uint64_t>
+    AlphaEquivalenceHashAttribute;
+
+/** Mixes the bits of h, to combine hashes commutatively by addition */
+uint64_t mixHash(uint64_t h)
+{
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return h;
+}
+
+/**
+ * Computes the hash of n in which the bound variables are identified by
+ * their type only, and the arguments of commutative operators are combined
+ * commutatively, mirroring TermCanonize::getCanonicalTerm.
+ */
+uint64_t computeHash(
+    TNode n, std::unordered_map<TNode, uint64_t, TNodeHashFunction>& visited)
+{
+  std::unordered_map<TNode, uint64_t, TNodeHashFunction>::iterator it =
+      visited.find(n);
+  if (it != visited.end())
+  {
+    return it->second;
+  }
+  uint64_t h;
+  if (n.getKind() == BOUND_VARIABLE)
+  {
+    h = mixHash(TypeNodeHashFunction()(n.getType()) + 1);
+  }
+  else if (n.getNumChildren() == 0)
+  {
+    h = mixHash(n.getId());
+  }
+  else
+  {
+    h = mixHash(static_cast<uint64_t>(n.getKind()) + 0x9e3779b97f4a7c15ULL);
+    if (n.getMetaKind() == metakind::PARAMETERIZED)
+    {
+      h = h * 31 + computeHash(n.getOperator(), visited);
+    }
+    if (TermUtil::isComm(n.getKind()))
+    {
+      uint64_t sum = 0;
+      for (TNode nc : n)
+      {
+        sum += mixHash(computeHash(nc, visited));
+      }
+      h = h * 31 + sum;
+    }
+    else
+    {
+      for (TNode nc : n)
+      {
+        h = h * 31 + computeHash(nc, visited);
+      }
+    }
+  }
+  visited[n] = h;
+  return h;
+}
+
+}  // namespace
+
 struct sortTypeOrder {
   expr::TermCanonize* d_tu;
   bool operator() (TypeNode i, TypeNode j) {
@@ -103,9 +175,46 @@ Node AlphaEquivalenceTypeNode::registerNode(Node q,
   return aetn->d_data.registerNode(q, t);
 }
 
+uint64_t AlphaEquivalenceDb::getHash(Node q)
+{
+  AlphaEquivalenceHashAttribute aeha;
+  if (q.hasAttribute(aeha))
+  {
+    return q.getAttribute(aeha);
+  }
+  std::unordered_map<TNode, uint64_t, TNodeHashFunction> visited;
+  uint64_t h = computeHash(q[1], visited);
+  // the multi-set of the types of the bound variables
+  for (const Node& v : q[0])
+  {
+    h += mixHash(computeHash(v, visited) + 1);
+  }
+  q.setAttribute(aeha, h);
+  return h;
+}
+
 Node AlphaEquivalenceDb::addTerm(Node q)
 {
   Assert(q.getKind() == FORALL);
+  uint64_t h = getHash(q);
+  std::unordered_map<uint64_t, Node>::iterator it = d_hashFirst.find(h);
+  if (it == d_hashFirst.end())
+  {
+    // no other quantified formula may be alpha-equivalent to q
+    Trace("aeq") << "Alpha equivalence : unique hash for " << q << std::endl;
+    d_hashFirst[h] = q;
+    return q;
+  }
+  if (!it->second.isNull())
+  {
+    registerTerm(it->second);
+    it->second = Node::null();
+  }
+  return registerTerm(q);
+}
+
+Node AlphaEquivalenceDb::registerTerm(Node q)
+{
   Trace("aeq") << "Alpha equivalence : register " << q << std::endl;
   //construct canonical quantified formula
   Node t = d_tc->getCanonicalTerm(q[1], true);
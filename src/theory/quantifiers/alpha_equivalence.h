@@ -17,6 +17,8 @@
 #ifndef CVC4__ALPHA_EQUIVALENCE_H
 #define CVC4__ALPHA_EQUIVALENCE_H
 
+#include <unordered_map>
+
 #include "theory/quantifiers/quant_util.h"
 
 #include "expr/term_canonize.h"
@@ -89,6 +91,21 @@ class AlphaEquivalenceDb
   Node addTerm(Node q);
 
  private:
+  /**
+   * Get the structural hash of quantified formula q, which is invariant
+   * under renaming of bound variables and under reordering of the arguments
+   * of commutative operators, and hence equal for alpha-equivalent
+   * quantified formulas. It is cached in an attribute of q.
+   */
+  static uint64_t getHash(Node q);
+  /** registers q to the trie below, returns the result of addTerm */
+  Node registerTerm(Node q);
+  /**
+   * Maps the hashes of the formulas added to this database to the first
+   * such formula, which is only canonized and registered to the trie when a
+   * second formula with the same hash is added. It is null afterwards.
+   */
+  std::unordered_map<uint64_t, Node> d_hashFirst;
   /** a trie per # of variables per type */
   AlphaEquivalenceTypeNode d_ae_typ_trie;
   /** pointer to the term canonize utility */
@@ -14,6 +14,10 @@
 
 #include "theory/quantifiers/candidate_rewrite_database.h"
 
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
 #include "options/base_options.h"
 #include "options/quantifiers_options.h"
 #include "printer/printer.h"
@@ -37,7 +41,8 @@ CandidateRewriteDatabase::CandidateRewriteDatabase()
       d_tds(nullptr),
       d_ext_rewrite(nullptr),
       d_using_sygus(false),
-      d_silent(false)
+      d_silent(false),
+      d_verified_store_loaded(false)
 {
 }
 void CandidateRewriteDatabase::initialize(const std::vector<Node>& vars,
@@ -133,69 +138,82 @@ bool CandidateRewriteDatabase::addTerm(Node sol,
         Node crr = solbr.eqNode(eq_solr).negate();
         Trace("rr-check") << "Check candidate rewrite : " << crr << std::endl;
 
-        // Notice we don't set produce-models. rrChecker takes the same
-        // options as the SmtEngine we belong to, where we ensure that
-        // produce-models is set.
-        bool needExport = false;
-        ExprManager em(nm->getOptions());
-        std::unique_ptr<SmtEngine> rrChecker;
-        ExprManagerMapCollection varMap;
-        initializeChecker(rrChecker, em, varMap, crr, needExport);
-        Result r = rrChecker->checkSat();
-        Trace("rr-check") << "...result : " << r << std::endl;
-        if (r.asSatisfiabilityResult().isSat() == Result::SAT)
+        // a rewrite verified by an earlier run is not checked again
+        verified = isVerifiedInStore(crr);
+        if (verified)
         {
-          Trace("rr-check") << "...rewrite does not hold for: " << std::endl;
-          is_unique_term = true;
-          std::vector<Node> vars;
-          d_sampler->getVariables(vars);
-          std::vector<Node> pt;
-          for (const Node& v : vars)
+          Trace("rr-check") << "...verified by the store" << std::endl;
+        }
+        else
+        {
+          // Notice we don't set produce-models. rrChecker takes the same
+          // options as the SmtEngine we belong to, where we ensure that
+          // produce-models is set.
+          bool needExport = false;
+          ExprManager em(nm->getOptions());
+          std::unique_ptr<SmtEngine> rrChecker;
+          ExprManagerMapCollection varMap;
+          initializeChecker(rrChecker, em, varMap, crr, needExport);
+          Result r = rrChecker->checkSat();
+          Trace("rr-check") << "...result : " << r << std::endl;
+          if (r.asSatisfiabilityResult().isSat() == Result::SAT)
           {
-            Node val;
-            Node refv = v;
-            // if a bound variable, map to the skolem we introduce before
-            // looking up the model value
-            if (v.getKind() == BOUND_VARIABLE)
+            Trace("rr-check") << "...rewrite does not hold for: " << std::endl;
+            is_unique_term = true;
+            std::vector<Node> vars;
+            d_sampler->getVariables(vars);
+            std::vector<Node> pt;
+            for (const Node& v : vars)
             {
-              std::map<Node, Node>::iterator itf = d_fv_to_skolem.find(v);
-              if (itf == d_fv_to_skolem.end())
+              Node val;
+              Node refv = v;
+              // if a bound variable, map to the skolem we introduce before
+              // looking up the model value
+              if (v.getKind() == BOUND_VARIABLE)
               {
-                // not in conjecture, can use arbitrary value
-                val = v.getType().mkGroundTerm();
+                std::map<Node, Node>::iterator itf = d_fv_to_skolem.find(v);
+                if (itf == d_fv_to_skolem.end())
+                {
+                  // not in conjecture, can use arbitrary value
+                  val = v.getType().mkGroundTerm();
+                }
+                else
+                {
+                  // get the model value of its skolem
+                  refv = itf->second;
+                }
               }
-              else
+              if (val.isNull())
               {
-                // get the model value of its skolem
-                refv = itf->second;
+                Assert(!refv.isNull() && refv.getKind() != BOUND_VARIABLE);
+                if (needExport)
+                {
+                  Expr erefv = refv.toExpr().exportTo(&em, varMap);
+                  val = Node::fromExpr(rrChecker->getValue(erefv).exportTo(
+                      nm->toExprManager(), varMap));
+                }
+                else
+                {
+                  val = Node::fromExpr(rrChecker->getValue(refv.toExpr()));
+                }
               }
+              Trace("rr-check") << "  " << v << " -> " << val << std::endl;
+              pt.push_back(val);
             }
-            if (val.isNull())
+            d_sampler->addSamplePoint(pt);
+            // add the solution again
+            // by construction of the above point, we should be unique now
+            Node eq_sol_new = d_sampler->registerTerm(sol);
+            Assert(eq_sol_new == sol);
+          }
+          else
+          {
+            verified = !r.asSatisfiabilityResult().isUnknown();
+            if (verified)
             {
-              Assert(!refv.isNull() && refv.getKind() != BOUND_VARIABLE);
-              if (needExport)
-              {
-                Expr erefv = refv.toExpr().exportTo(&em, varMap);
-                val = Node::fromExpr(rrChecker->getValue(erefv).exportTo(
-                    nm->toExprManager(), varMap));
-              }
-              else
-              {
-                val = Node::fromExpr(rrChecker->getValue(refv.toExpr()));
-              }
+              addVerifiedToStore(crr);
             }
-            Trace("rr-check") << "  " << v << " -> " << val << std::endl;
-            pt.push_back(val);
           }
-          d_sampler->addSamplePoint(pt);
-          // add the solution again
-          // by construction of the above point, we should be unique now
-          Node eq_sol_new = d_sampler->registerTerm(sol);
-          Assert(eq_sol_new == sol);
-        }
-        else
-        {
-          verified = !r.asSatisfiabilityResult().isUnknown();
         }
       }
       else
@@ -293,6 +311,60 @@ void CandidateRewriteDatabase::setExtendedRewriter(ExtendedRewriter* er)
   d_ext_rewrite = er;
 }
 
+bool CandidateRewriteDatabase::isVerifiedInStore(Node crr)
+{
+  const std::string& file = options::sygusRewSynthCheckStore();
+  if (file.empty())
+  {
+    return false;
+  }
+  if (!d_verified_store_loaded)
+  {
+    d_verified_store_loaded = true;
+    std::ifstream in(file);
+    std::string line;
+    while (std::getline(in, line))
+    {
+      d_verified_store.insert(line);
+    }
+    Trace("rr-check") << "Loaded " << d_verified_store.size()
+                      << " verified rewrites from " << file << std::endl;
+  }
+  return d_verified_store.find(getStoreKey(crr)) != d_verified_store.end();
+}
+
+void CandidateRewriteDatabase::addVerifiedToStore(Node crr)
+{
+  const std::string& file = options::sygusRewSynthCheckStore();
+  if (file.empty())
+  {
+    return;
+  }
+  std::string key = getStoreKey(crr);
+  if (d_verified_store.insert(key).second)
+  {
+    std::ofstream out(file, std::ios::app);
+    out << key << std::endl;
+  }
+}
+
+std::string CandidateRewriteDatabase::getStoreKey(Node crr)
+{
+  // the printed form of crr does not include the types of its variables
+  std::stringstream ss;
+  ss << crr << " ;";
+  std::vector<Node> vars;
+  d_sampler->getVariables(vars);
+  for (const Node& v : vars)
+  {
+    ss << " " << v << ":" << v.getType();
+  }
+  // keys are stored one per line
+  std::string key = ss.str();
+  std::replace(key.begin(), key.end(), '\n', ' ');
+  return key;
+}
+
 CandidateRewriteDatabaseGen::CandidateRewriteDatabaseGen(
     std::vector<Node>& vars, unsigned nsamples)
     : d_qe(nullptr), d_vars(vars.begin(), vars.end()), d_nsamples(nsamples)
@@ -19,6 +19,7 @@
 
 #include <map>
 #include <memory>
+#include <string>
 #include <unordered_set>
 #include <vector>
 #include "theory/quantifiers/candidate_rewrite_filter.h"
@@ -101,6 +102,24 @@ class CandidateRewriteDatabase : public ExprMiner
   std::unordered_map<Node, bool, NodeHashFunction> d_add_term_cache;
   /** if true, we silence the output of candidate rewrites */
   bool d_silent;
+  //----------------------the store of verified rewrites
+  /**
+   * Returns true if the query crr, the negation of a candidate rewrite, was
+   * shown unsatisfiable by a run using the file given by
+   * --sygus-rr-synth-check-store.
+   */
+  bool isVerifiedInStore(Node crr);
+  /** Adds the query crr, shown unsatisfiable, to the store */
+  void addVerifiedToStore(Node crr);
+  /**
+   * Returns the key of crr in the store, which is its printed form followed
+   * by the types of the variables of sampling.
+   */
+  std::string getStoreKey(Node crr);
+  /** the keys of the store, loaded on the first use */
+  std::unordered_set<std::string> d_verified_store;
+  bool d_verified_store_loaded;
+  //----------------------end the store of verified rewrites
 };
 
 /**
@@ -1312,6 +1312,18 @@ Node CegInstantiator::applySubstitutionToLiteral( Node lit, std::vector< Node >&
   
 bool CegInstantiator::check() {
   processAssertions();
+  std::vector<Node> inputs;
+  if (options::cbqiSkipUnchanged())
+  {
+    getCheckInputs(inputs);
+    if (inputs == d_failedInputs)
+    {
+      Trace("cbqi-engine") << "  skip check, the inputs of the last failed "
+                              "check did not change."
+                           << std::endl;
+      return false;
+    }
+  }
   for( unsigned r=0; r<2; r++ ){
     d_effort = r == 0 ? CEG_INST_EFFORT_STANDARD : CEG_INST_EFFORT_FULL;
     SolvedForm sf;
@@ -1325,6 +1337,7 @@ bool CegInstantiator::check() {
     }
   }
   Trace("cbqi-engine") << "  WARNING : unable to find CEGQI single invocation instantiation." << std::endl;
+  d_failedInputs = inputs;
   return false;
 }
 
@@ -1512,6 +1525,39 @@ void CegInstantiator::processAssertions() {
   }
 }
 
+void CegInstantiator::getCheckInputs(std::vector<Node>& inputs)
+{
+  std::unordered_set<Node, NodeHashFunction> syms;
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  // the lists are separated by null nodes
+  for (const std::pair<const TheoryId, std::vector<Node> >& ca :
+       d_curr_asserts)
+  {
+    for (const Node& lit : ca.second)
+    {
+      inputs.push_back(lit);
+      expr::getSymbols(lit, syms, visited);
+    }
+    inputs.push_back(Node::null());
+  }
+  for (const std::pair<const Node, std::vector<Node> >& eqc : d_curr_eqc)
+  {
+    inputs.push_back(eqc.first);
+    inputs.push_back(getModelValue(eqc.first));
+    inputs.insert(inputs.end(), eqc.second.begin(), eqc.second.end());
+    inputs.push_back(Node::null());
+  }
+  // the symbols in the order of their ids, so that the inputs of rounds are
+  // comparable
+  std::vector<Node> symsSorted(syms.begin(), syms.end());
+  std::sort(symsSorted.begin(), symsSorted.end());
+  for (const Node& sym : symsSorted)
+  {
+    inputs.push_back(sym);
+    inputs.push_back(getModelValue(sym));
+  }
+}
+
 Node CegInstantiator::getModelValue( Node n ) {
   return d_qe->getModel()->getValue( n );
 }
@@ -216,6 +216,12 @@ class CegInstantiator {
    * on the output channel d_out of this class.
    */
   bool check();
+  /**
+   * Forget the inputs of the last failed check, which is necessary when
+   * instantiations may have been removed, e.g. at the start of a
+   * satisfiability check.
+   */
+  void clearFailedInputs() { d_failedInputs.clear(); }
   /** presolve for quantified formula
    *
    * This initializes formulas that help static learning of the quantifier-free
@@ -396,6 +402,18 @@ class CegInstantiator {
    * such as the above data structures.
    */
   void processAssertions();
+  /**
+   * Get the inputs of the search for an instantiation in this round, i.e.
+   * the current assertions, the current equivalence classes, and the model
+   * values of their representatives and of the symbols of the assertions.
+   */
+  void getCheckInputs(std::vector<Node>& inputs);
+  /**
+   * The inputs of the last check that did not find an instantiation. Since
+   * the set of instantiations only grows, a check with the same inputs fails
+   * again.
+   */
+  std::vector<Node> d_failedInputs;
   /** cache bound variables for type returned
    * by getBoundVariable(...).
    */
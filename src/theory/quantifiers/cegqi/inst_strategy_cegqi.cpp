@@ -719,6 +719,10 @@ BvInverter* InstStrategyCegqi::getBvInverter() const
 }
 
 void InstStrategyCegqi::presolve() {
+  for (std::pair<const Node, std::unique_ptr<CegInstantiator>>& ci : d_cinst)
+  {
+    ci.second->clearFailedInputs();
+  }
   if (!options::cbqiPreRegInst())
   {
     return;
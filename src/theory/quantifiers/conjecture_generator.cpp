@@ -384,6 +384,7 @@ void ConjectureGenerator::check(Theory::Effort e, QEffort quant_e)
       Trace("sg-proc") << "Get eq classes..." << std::endl;
       d_op_arg_index.clear();
       d_ground_eqc_map.clear();
+      d_rhs_eval.clear();
       d_bool_eqc[0] = Node::null();
       d_bool_eqc[1] = Node::null();
       std::vector< TNode > eqcs;
@@ -1354,8 +1355,32 @@ bool ConjectureGenerator::notifySubstitution( TNode glhs, std::map< TNode, TNode
     }
   }
   Trace("sg-cconj-debug") << "Evaluate RHS : : " << rhs << std::endl;
-  //get the representative of rhs with substitution subs
-  TNode grhs = getTermDatabase()->getEntailedTerm( rhs, subs, true );
+  //get the representative of rhs with substitution subs, which only depends
+  //on the substitution of the variables of rhs
+  std::vector<Node> key;
+  key.push_back(rhs);
+  std::map<TNode, std::map<TypeNode, unsigned> >::iterator itv =
+      d_pattern_var_id.find(rhs);
+  Assert(itv != d_pattern_var_id.end());
+  for (const std::pair<const TypeNode, unsigned>& tv : itv->second)
+  {
+    for (unsigned j = 0; j <= tv.second; j++)
+    {
+      std::map<TNode, TNode>::iterator its = subs.find(getFreeVar(tv.first, j));
+      key.push_back(its == subs.end() ? Node::null() : Node(its->second));
+    }
+  }
+  TNode grhs;
+  std::map<std::vector<Node>, Node>::iterator ite = d_rhs_eval.find(key);
+  if (ite != d_rhs_eval.end())
+  {
+    grhs = ite->second;
+  }
+  else
+  {
+    grhs = getTermDatabase()->getEntailedTerm(rhs, subs, true);
+    d_rhs_eval[key] = grhs;
+  }
   Trace("sg-cconj-debug") << "...done evaluating term, got : " << grhs << std::endl;
   if( !grhs.isNull() ){
     if( glhs!=grhs ){
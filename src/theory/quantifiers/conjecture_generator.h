@@ -427,6 +427,14 @@ public:  //for property enumeration
   std::map< TNode, std::vector< TNode > > d_subs_confirmWitnessDomain;
   //number of ground substitutions whose equality is unknown
   unsigned d_subs_unkCount;
+  /**
+   * The entailed terms of the right hand sides of the candidate conjectures
+   * under ground substitutions in this round, keyed by the right hand side
+   * followed by the substitution of its variables. Many candidates share a
+   * right hand side, and the substitutions of their left hand sides agree
+   * on its variables.
+   */
+  std::map<std::vector<Node>, Node> d_rhs_eval;
 private:  //information about ground equivalence classes
   TNode d_bool_eqc[2];
   std::map< TNode, Node > d_ground_eqc_map;
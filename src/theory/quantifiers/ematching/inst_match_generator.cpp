@@ -1028,7 +1028,7 @@ void InstMatchGeneratorMulti::processNewInstantiations(QuantifiersEngine* qe,
 InstMatchGeneratorSimple::InstMatchGeneratorSimple(Node q,
                                                    Node pat,
                                                    QuantifiersEngine* qe)
-    : d_quant(q), d_match_pattern(pat)
+    : d_quant(q), d_match_pattern(pat), d_code_id(-1)
 {
   if( d_match_pattern.getKind()==NOT ){
     d_match_pattern = d_match_pattern[0];
@@ -1053,6 +1053,11 @@ InstMatchGeneratorSimple::InstMatchGeneratorSimple(Node q,
     d_match_pattern_arg_types.push_back( d_match_pattern[i].getType() );
   }
   d_op = qe->getTermDatabase()->getMatchOperator( d_match_pattern );
+  inst::MatchCodeTree* mct = qe->getMatchCodeTree();
+  if (mct != nullptr)
+  {
+    d_code_id = mct->addPattern(q, d_match_pattern, d_op, d_eqc, d_pol);
+  }
 }
 
 void InstMatchGeneratorSimple::resetInstantiationRound( QuantifiersEngine* qe ) {
@@ -1063,6 +1068,29 @@ int InstMatchGeneratorSimple::addInstantiations(Node q,
                                                 Trigger* tparent)
 {
   int addedLemmas = 0;
+  if (d_code_id >= 0)
+  {
+    // the matches are shared with the triggers of the same operator, and
+    // those already instantiated are skipped
+    inst::MatchCodeTree* mct = qe->getMatchCodeTree();
+    const std::vector<Node>& matches = mct->getMatches(d_code_id);
+    for (unsigned i = 0, nmatches = matches.size(); i < nmatches; i++)
+    {
+      if (mct->isInstantiated(d_code_id, matches[i]))
+      {
+        continue;
+      }
+      if (addInstantiationForMatch(matches[i], qe, addedLemmas))
+      {
+        mct->setInstantiated(d_code_id, matches[i]);
+      }
+      if (qe->inConflict())
+      {
+        break;
+      }
+    }
+    return addedLemmas;
+  }
   TNodeTrie* tat;
   if( d_eqc.isNull() ){
     tat = qe->getTermDatabase()->getTermArgTrie( d_op );
@@ -1099,6 +1127,31 @@ int InstMatchGeneratorSimple::addInstantiations(Node q,
   return addedLemmas;
 }
 
+bool InstMatchGeneratorSimple::addInstantiationForMatch(TNode t,
+                                                        QuantifiersEngine* qe,
+                                                        int& addedLemmas)
+{
+  Debug("simple-trigger") << "Actual term is " << t << std::endl;
+  InstMatch m(d_quant);
+  for (std::map<unsigned, int>::iterator it = d_var_num.begin();
+       it != d_var_num.end();
+       ++it)
+  {
+    if (it->second >= 0)
+    {
+      Assert(it->first < t.getNumChildren());
+      m.setValue(it->second, t[it->first]);
+    }
+  }
+  if (qe->getInstantiate()->addInstantiation(d_quant, m))
+  {
+    addedLemmas++;
+    Debug("simple-trigger") << "-> Produced instantiation " << m << std::endl;
+    return true;
+  }
+  return false;
+}
+
 void InstMatchGeneratorSimple::addInstantiations(InstMatch& m,
                                                  QuantifiersEngine* qe,
                                                  int& addedLemmas,
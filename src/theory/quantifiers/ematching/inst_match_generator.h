@@ -647,6 +647,15 @@ class InstMatchGeneratorSimple : public IMGenerator {
    * child is not a variable.
    */
   std::map<unsigned, int> d_var_num;
+  /** The identifier of this trigger in the match code tree, if it is used */
+  int d_code_id;
+  /**
+   * Adds the instantiation for the match t of the match code tree, returns
+   * true if it was added.
+   */
+  bool addInstantiationForMatch(TNode t,
+                                QuantifiersEngine* qe,
+                                int& addedLemmas);
   /** add instantiations, helper function.
    *
    * m is the current match we are building,
@@ -0,0 +1,254 @@
+/*********************                                                        */
+/*! \file match_code_tree.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the code tree for matching simple triggers
+ **/
+
+#include "theory/quantifiers/ematching/match_code_tree.h"
+
+#include "options/quantifiers_options.h"
+#include "theory/quantifiers/instantiate.h"
+#include "theory/quantifiers/term_database.h"
+#include "theory/quantifiers/term_util.h"
+#include "theory/quantifiers_engine.h"
+
+using namespace CVC4::kind;
+
+namespace CVC4 {
+namespace theory {
+namespace inst {
+
+MatchCodeTree::MatchCodeTree(QuantifiersEngine* qe, context::UserContext* u)
+    : d_qe(qe), d_instantiated(u)
+{
+}
+
+bool MatchCodeTree::reset(Theory::Effort e)
+{
+  // the matches are kept, in case they are unchanged
+  for (Tree& t : d_trees)
+  {
+    t.d_computed = false;
+  }
+  return true;
+}
+
+unsigned MatchCodeTree::addPattern(
+    Node q, Node pat, Node op, Node eqc, bool pol)
+{
+  std::tuple<Node, Node, bool> key(op, eqc, pol);
+  std::map<std::tuple<Node, Node, bool>, unsigned>::iterator itt =
+      d_treeIndex.find(key);
+  unsigned tid;
+  if (itt == d_treeIndex.end())
+  {
+    tid = d_trees.size();
+    d_treeIndex[key] = tid;
+    Tree t;
+    t.d_op = op;
+    t.d_eqc = eqc;
+    t.d_pol = pol;
+    t.d_root = d_nodes.size();
+    t.d_computed = false;
+    t.d_version = 0;
+    d_trees.push_back(t);
+    d_nodes.push_back(CodeNode());
+  }
+  else
+  {
+    tid = itt->second;
+  }
+  // compile the arguments
+  unsigned n = d_trees[tid].d_root;
+  std::map<Node, unsigned> firstOcc;
+  for (unsigned i = 0, nchild = pat.getNumChildren(); i < nchild; i++)
+  {
+    Node pc = pat[i];
+    // as in InstMatchGeneratorSimple, the variables of other quantified
+    // formulas are treated as ground terms
+    if (pc.getKind() == INST_CONSTANT
+        && (!options::cbqi()
+            || quantifiers::TermUtil::getInstConstAttr(pc) == q))
+    {
+      std::map<Node, unsigned>::iterator itf = firstOcc.find(pc);
+      if (itf == firstOcc.end())
+      {
+        firstOcc[pc] = i;
+        n = mkChild(n, BIND, 0, Node::null());
+      }
+      else
+      {
+        n = mkChild(n, COMPARE, itf->second, Node::null());
+      }
+    }
+    else
+    {
+      size_t nnodes = d_nodes.size();
+      n = mkChild(n, GROUND, 0, pc);
+      if (d_nodes.size() > nnodes)
+      {
+        d_trees[tid].d_groundNodes.push_back(n);
+      }
+    }
+  }
+  unsigned id = d_matches.size();
+  d_nodes[n].d_patterns.push_back(id);
+  d_trees[tid].d_patterns.push_back(id);
+  d_patternTree.push_back(tid);
+  d_matches.push_back(std::vector<Node>());
+  // the matches of the new pattern must be computed
+  d_trees[tid].d_computed = false;
+  d_trees[tid].d_version = 0;
+  Trace("match-code-tree") << "MatchCodeTree: pattern " << id << " is " << pat
+                           << ", tree " << tid << " has "
+                           << d_trees[tid].d_patterns.size() << " patterns"
+                           << std::endl;
+  return id;
+}
+
+unsigned MatchCodeTree::mkChild(unsigned n,
+                                Instruction inst,
+                                unsigned arg,
+                                Node ground)
+{
+  for (unsigned c : d_nodes[n].d_children)
+  {
+    const CodeNode& cn = d_nodes[c];
+    if (cn.d_inst == inst && cn.d_arg == arg && cn.d_ground == ground)
+    {
+      return c;
+    }
+  }
+  unsigned c = d_nodes.size();
+  CodeNode cn;
+  cn.d_inst = inst;
+  cn.d_arg = arg;
+  cn.d_ground = ground;
+  d_nodes.push_back(cn);
+  d_nodes[n].d_children.push_back(c);
+  return c;
+}
+
+const std::vector<Node>& MatchCodeTree::getMatches(unsigned id)
+{
+  Assert(id < d_matches.size());
+  Tree& t = d_trees[d_patternTree[id]];
+  if (!t.d_computed)
+  {
+    run(t);
+    t.d_computed = true;
+  }
+  return d_matches[id];
+}
+
+bool MatchCodeTree::isInstantiated(unsigned id, TNode t) const
+{
+  return d_instantiated.find(std::pair<unsigned, Node>(id, t))
+         != d_instantiated.end();
+}
+
+void MatchCodeTree::setInstantiated(unsigned id, Node t)
+{
+  d_instantiated.insert(std::pair<unsigned, Node>(id, t));
+}
+
+void MatchCodeTree::run(Tree& t)
+{
+  quantifiers::TermDb* tdb = d_qe->getTermDatabase();
+  EqualityQuery* eq = d_qe->getEqualityQuery();
+  TNodeTrie* tat = t.d_eqc.isNull()
+                       ? tdb->getTermArgTrie(t.d_op)
+                       : tdb->getTermArgTrie(t.d_pol ? t.d_eqc : Node::null(),
+                                             t.d_op);
+  uint64_t version = tdb->getTermArgTrieVersion(t.d_op, !t.d_eqc.isNull());
+  Node eqcRep = (t.d_eqc.isNull() || t.d_pol) ? Node::null()
+                                              : eq->getRepresentative(t.d_eqc);
+  bool changed = version == 0 || version != t.d_version || eqcRep != t.d_eqcRep;
+  for (unsigned g : t.d_groundNodes)
+  {
+    Node r = eq->getRepresentative(d_nodes[g].d_ground);
+    if (r != d_nodes[g].d_rep)
+    {
+      d_nodes[g].d_rep = r;
+      changed = true;
+    }
+  }
+  if (!changed)
+  {
+    Trace("match-code-tree") << "MatchCodeTree: tree for " << t.d_op
+                             << " is unchanged" << std::endl;
+    return;
+  }
+  t.d_version = version;
+  t.d_eqcRep = eqcRep;
+  for (unsigned p : t.d_patterns)
+  {
+    d_matches[p].clear();
+  }
+  if (tat == nullptr)
+  {
+    return;
+  }
+  std::vector<TNode> reps;
+  if (eqcRep.isNull())
+  {
+    run(t.d_root, tat, reps);
+    return;
+  }
+  // all classes except that of d_eqc
+  for (std::pair<const TNode, TNodeTrie>& tt : tat->d_data)
+  {
+    if (tt.first != eqcRep)
+    {
+      run(t.d_root, &tt.second, reps);
+    }
+  }
+}
+
+void MatchCodeTree::run(unsigned n, TNodeTrie* tat, std::vector<TNode>& reps)
+{
+  if (!d_nodes[n].d_patterns.empty())
+  {
+    Assert(!tat->d_data.empty());
+    Node t = tat->getData();
+    for (unsigned p : d_nodes[n].d_patterns)
+    {
+      d_matches[p].push_back(t);
+    }
+  }
+  for (unsigned i = 0, nchild = d_nodes[n].d_children.size(); i < nchild; i++)
+  {
+    unsigned c = d_nodes[n].d_children[i];
+    const CodeNode& cn = d_nodes[c];
+    if (cn.d_inst == BIND)
+    {
+      for (std::pair<const TNode, TNodeTrie>& tt : tat->d_data)
+      {
+        reps.push_back(tt.first);
+        run(c, &tt.second, reps);
+        reps.pop_back();
+      }
+      continue;
+    }
+    TNode r = cn.d_inst == COMPARE ? reps[cn.d_arg] : TNode(cn.d_rep);
+    std::map<TNode, TNodeTrie>::iterator it = tat->d_data.find(r);
+    if (it != tat->d_data.end())
+    {
+      reps.push_back(r);
+      run(c, &it->second, reps);
+      reps.pop_back();
+    }
+  }
+}
+
+}  // namespace inst
+}  // namespace theory
+}  // namespace CVC4
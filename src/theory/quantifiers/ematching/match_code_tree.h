@@ -0,0 +1,172 @@
+/*********************                                                        */
+/*! \file match_code_tree.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Code tree for matching simple triggers
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__QUANTIFIERS__MATCH_CODE_TREE_H
+#define CVC4__THEORY__QUANTIFIERS__MATCH_CODE_TREE_H
+
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "context/cdhashset.h"
+#include "expr/node.h"
+#include "expr/node_trie.h"
+#include "util/hash.h"
+#include "theory/quantifiers/quant_util.h"
+
+namespace CVC4 {
+namespace theory {
+
+class QuantifiersEngine;
+
+namespace inst {
+
+/** Match code tree
+ *
+ * This class matches the simple triggers of all quantified formulas (see
+ * InstMatchGeneratorSimple) against the term indices of the term database.
+ * Each simple trigger f( t_1, ..., t_n ) is compiled into a sequence of n
+ * instructions, one per argument:
+ * - BIND if t_i is the first occurrence of a variable,
+ * - COMPARE j if t_i is a variable that is also t_j for some j < i,
+ * - GROUND if t_i is a ground term, which is looked up by its representative.
+ * The instruction sequences of the triggers with the same match operator and
+ * the same equivalence class constraint are stored in a tree that shares
+ * their common prefixes. For example, f( x, y ) and f( y, x ) for different
+ * quantified formulas have the same instructions, and f( x, x ) shares the
+ * first instruction with them.
+ *
+ * Each tree is run once per instantiation round, on demand, by a single
+ * traversal of the term index of its operator, which computes the matching
+ * terms of all of its triggers. The traversal is skipped if this index was
+ * not rebuilt since the last one (see --term-db-incremental) and the
+ * representatives of the ground arguments did not change, in which case the
+ * matches are those of the previous round.
+ *
+ * The matches that were instantiated are recorded, so that the previous
+ * matches are not instantiated again.
+ */
+class MatchCodeTree : public QuantifiersUtil
+{
+ public:
+  MatchCodeTree(QuantifiersEngine* qe, context::UserContext* u);
+  ~MatchCodeTree() {}
+  /** reset, which clears the matches of the previous round */
+  bool reset(Theory::Effort e) override;
+  /** register quantifier, does nothing */
+  void registerQuantifier(Node q) override {}
+  /** identify */
+  std::string identify() const override { return "MatchCodeTree"; }
+  /**
+   * Adds the simple trigger pat for q, whose match operator is op, with
+   * equivalence class constraint eqc and pol (see InstMatchGeneratorSimple),
+   * and returns its identifier.
+   */
+  unsigned addPattern(Node q, Node pat, Node op, Node eqc, bool pol);
+  /**
+   * Returns the ground terms matching the pattern with identifier id in the
+   * current round. The returned vector is valid until the next call to
+   * addPattern.
+   */
+  const std::vector<Node>& getMatches(unsigned id);
+  /** Returns true if the instantiation for the match t of id was added */
+  bool isInstantiated(unsigned id, TNode t) const;
+  /** Records that the instantiation for the match t of id was added */
+  void setInstantiated(unsigned id, Node t);
+
+ private:
+  /** The instructions */
+  enum Instruction
+  {
+    BIND,
+    COMPARE,
+    GROUND
+  };
+  /**
+   * A node of a tree, whose instruction applies to the argument at its depth,
+   * minus one. The root of a tree has no instruction.
+   */
+  struct CodeNode
+  {
+    Instruction d_inst;
+    /** The index of the argument compared with, for COMPARE */
+    unsigned d_arg;
+    /** The ground term and its representative in the last run, for GROUND */
+    Node d_ground;
+    Node d_rep;
+    /** The nodes for the next argument */
+    std::vector<unsigned> d_children;
+    /** The patterns whose instructions end at this node */
+    std::vector<unsigned> d_patterns;
+  };
+  /** A tree for an operator and an equivalence class constraint */
+  struct Tree
+  {
+    Node d_op;
+    Node d_eqc;
+    bool d_pol;
+    unsigned d_root;
+    /** The patterns of this tree */
+    std::vector<unsigned> d_patterns;
+    /** The GROUND nodes of this tree */
+    std::vector<unsigned> d_groundNodes;
+    /** Whether the matches of the patterns are computed in this round */
+    bool d_computed;
+    /**
+     * The version of the term index and the representative of d_eqc in the
+     * last run, where 0 means that the tree must be run.
+     */
+    uint64_t d_version;
+    Node d_eqcRep;
+  };
+  /** Returns the child of node n with the given instruction. */
+  unsigned mkChild(unsigned n, Instruction inst, unsigned arg, Node ground);
+  /** Computes the matches of the patterns of tree t, if they changed. */
+  void run(Tree& t);
+  /**
+   * Records the matches of the patterns ending at node n and runs its
+   * children on the term index tat, where reps are the representatives of
+   * the arguments matched so far.
+   */
+  void run(unsigned n, TNodeTrie* tat, std::vector<TNode>& reps);
+
+  typedef context::CDHashSet<std::pair<unsigned, Node>,
+                             PairHashFunction<unsigned,
+                                              Node,
+                                              std::hash<unsigned>,
+                                              NodeHashFunction> >
+      MatchSet;
+  /** Pointer to the quantifiers engine */
+  QuantifiersEngine* d_qe;
+  /** The nodes of all trees */
+  std::vector<CodeNode> d_nodes;
+  /** The trees, by operator, equivalence class and polarity */
+  std::vector<Tree> d_trees;
+  std::map<std::tuple<Node, Node, bool>, unsigned> d_treeIndex;
+  /** The tree of each pattern */
+  std::vector<unsigned> d_patternTree;
+  /** The matches of each pattern in the current round */
+  std::vector<std::vector<Node> > d_matches;
+  /** The pairs of patterns and matches that were instantiated */
+  MatchSet d_instantiated;
+}; /* class MatchCodeTree */
+
+}  // namespace inst
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__QUANTIFIERS__MATCH_CODE_TREE_H */
@@ -14,6 +14,7 @@
 
 #include "theory/quantifiers/extended_rewrite.h"
 
+#include "expr/attribute.h"
 #include "options/quantifiers_options.h"
 #include "theory/arith/arith_msum.h"
 #include "theory/bv/theory_bv_utils.h"
@@ -33,6 +34,14 @@ struct ExtRewriteAttributeId
 {
 };
 typedef expr::Attribute<ExtRewriteAttributeId, Node> ExtRewriteAttribute;
+struct ExtRewriteAggrAttributeId
+{
+};
+typedef expr::Attribute<ExtRewriteAggrAttributeId, Node>
+    ExtRewriteAggrAttribute;
+
+thread_local uint64_t ExtendedRewriter::s_cacheLookups = 0;
+thread_local uint64_t ExtendedRewriter::s_cacheHits = 0;
 
 ExtendedRewriter::ExtendedRewriter(bool aggr) : d_aggr(aggr)
 {
@@ -42,8 +51,41 @@ ExtendedRewriter::ExtendedRewriter(bool aggr) : d_aggr(aggr)
 
 void ExtendedRewriter::setCache(Node n, Node ret)
 {
-  ExtRewriteAttribute era;
-  n.setAttribute(era, ret);
+  if (d_aggr)
+  {
+    n.setAttribute(ExtRewriteAggrAttribute(), ret);
+  }
+  else
+  {
+    n.setAttribute(ExtRewriteAttribute(), ret);
+  }
+}
+
+Node ExtendedRewriter::getCache(Node n)
+{
+  ++s_cacheLookups;
+  Node ret = d_aggr ? n.getAttribute(ExtRewriteAggrAttribute())
+                    : n.getAttribute(ExtRewriteAttribute());
+  if (!ret.isNull())
+  {
+    ++s_cacheHits;
+  }
+  return ret;
+}
+
+void ExtendedRewriter::clearCaches()
+{
+  std::vector<expr::attr::AttributeUniqueId> ids;
+  ids.push_back(
+      expr::attr::AttributeManager::getAttributeId(ExtRewriteAttribute()));
+  ids.push_back(
+      expr::attr::AttributeManager::getAttributeId(ExtRewriteAggrAttribute()));
+  std::vector<const expr::attr::AttributeUniqueId*> idPtrs;
+  for (const expr::attr::AttributeUniqueId& id : ids)
+  {
+    idPtrs.push_back(&id);
+  }
+  NodeManager::currentNM()->deleteAttributes(idPtrs);
 }
 
 bool ExtendedRewriter::addToChildren(Node nc,
@@ -69,9 +111,10 @@ Node ExtendedRewriter::extendedRewrite(Node n)
   }
 
   // has it already been computed?
-  if (n.hasAttribute(ExtRewriteAttribute()))
+  Node cached = getCache(n);
+  if (!cached.isNull())
   {
-    return n.getAttribute(ExtRewriteAttribute());
+    return cached;
   }
 
   Node ret = n;
@@ -51,6 +51,14 @@ class ExtendedRewriter
   ~ExtendedRewriter() {}
   /** return the extended rewritten form of n */
   Node extendedRewrite(Node n);
+  /**
+   * The number of lookups and hits in the caches of the extended rewriters
+   * of this thread so far.
+   */
+  static const uint64_t& getCacheLookups() { return s_cacheLookups; }
+  static const uint64_t& getCacheHits() { return s_cacheHits; }
+  /** Garbage collects the caches of the extended rewriters. */
+  static void clearCaches();
 
  private:
   /**
@@ -67,8 +75,18 @@ class ExtendedRewriter
   /** true/false nodes */
   Node d_true;
   Node d_false;
-  /** cache that the extended rewritten form of n is ret */
+  /**
+   * Cache that the extended rewritten form of n is ret. The caches are
+   * attributes of n, hence they are shared by the extended rewriters of all
+   * SmtEngines using the same node manager. Aggressive and non-aggressive
+   * rewriting use separate caches since their results differ.
+   */
   void setCache(Node n, Node ret);
+  /** get the cached extended rewritten form of n, or null if none */
+  Node getCache(Node n);
+  /** the number of cache lookups and hits */
+  static thread_local uint64_t s_cacheLookups;
+  static thread_local uint64_t s_cacheHits;
   /** add to children
    *
    * Adds nc to the vector of children, if dropDup is true, we do not add
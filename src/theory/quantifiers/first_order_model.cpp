@@ -127,11 +127,12 @@ bool FirstOrderModel::initializeRepresentativesForType(TypeNode tn)
   else
   {
     // can we complete it?
-    if (d_qe->getTermEnumeration()->mayComplete(tn))
+    std::vector<Node> dom;
+    if (d_qe->getTermEnumeration()->getDomain(tn, dom))
     {
       Trace("fm-debug") << "  do complete, since cardinality is small ("
                         << tn.getCardinality() << ")..." << std::endl;
-      d_rep_set.complete(tn);
+      d_rep_set.complete(tn, dom);
       // must have succeeded
       Assert(d_rep_set.hasType(tn));
       return true;
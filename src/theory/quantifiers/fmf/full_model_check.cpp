@@ -484,6 +484,24 @@ bool FullModelChecker::processBuildModel(TheoryModel* m){
     }
     std::sort( indices.begin(), indices.end(), mbas );
 
+    // if the entries are the same as in the previous round, so is the
+    // simplified definition
+    std::vector<Node> sorted_conds;
+    std::vector<Node> sorted_values;
+    for (int i : indices)
+    {
+      sorted_conds.push_back(entry_conds[i]);
+      sorted_values.push_back(values[i]);
+    }
+    FunDefCache& fdc = d_fun_def_cache[op];
+    if (fdc.d_valid && fdc.d_conds == sorted_conds
+        && fdc.d_values == sorted_values)
+    {
+      Trace("fmc-model") << "Reuse the model for " << op << std::endl;
+      *fm->d_models[op] = fdc.d_def;
+      continue;
+    }
+
     for (int i=0; i<(int)indices.size(); i++) {
       fm->d_models[op]->addEntry(fm, entry_conds[indices[i]], values[indices[i]]);
     }
@@ -498,6 +516,12 @@ bool FullModelChecker::processBuildModel(TheoryModel* m){
     fm->d_models[op]->debugPrint("fmc-model", op, this);
     Trace("fmc-model") << std::endl;
 
+    fdc.d_valid = true;
+    fdc.d_conds.swap(sorted_conds);
+    fdc.d_values.swap(sorted_values);
+    fdc.d_def = *fm->d_models[op];
+    fdc.d_function_value = Node::null();
+
     //for debugging
     /*
     for( size_t i=0; i<fm->d_uf_terms[op].size(); i++ ){
@@ -517,8 +541,12 @@ bool FullModelChecker::processBuildModel(TheoryModel* m){
 
   //make function values
   for( std::map<Node, Def * >::iterator it = fm->d_models.begin(); it != fm->d_models.end(); ++it ){
-    Node f_def = getFunctionValue( fm, it->first, "$x" );
-    m->assignFunctionDefinition( it->first, f_def );
+    FunDefCache& fdc = d_fun_def_cache[it->first];
+    if (fdc.d_function_value.isNull())
+    {
+      fdc.d_function_value = getFunctionValue(fm, it->first, "$x");
+    }
+    m->assignFunctionDefinition(it->first, fdc.d_function_value);
   }
   return TheoryEngineModelBuilder::processBuildModel( m );
 }
@@ -791,33 +819,44 @@ bool FullModelChecker::exhaustiveInstantiate(FirstOrderModelFmc * fm, Node f, No
   {
     Trace("fmc-exh-debug") << "Set element domains..." << std::endl;
     int addedLemmas = 0;
+    // The terms and their representatives of the current instance. Between
+    // consecutive instances usually only the last terms change, so the
+    // representatives of the others are kept.
+    unsigned nterms = riter.getNumTerms();
+    std::vector<Node> ev_inst(nterms);
+    std::vector<Node> inst(nterms);
+    std::vector<bool> valTerm(nterms);
+    for (unsigned i = 0; i < nterms; i++)
+    {
+      // if the type is not closed enumerable (see
+      // TypeNode::isClosedEnumerable), then we must ensure that we are
+      // using a term and not a value. This ensures that e.g. uninterpreted
+      // constants do not appear in instantiations.
+      valTerm[i] = !riter.getTypeOf(i).isClosedEnumerable();
+    }
     //now do full iteration
     while( !riter.isFinished() ){
       d_triedLemmas++;
       Trace("fmc-exh-debug") << "Inst : ";
-      std::vector< Node > ev_inst;
-      std::vector< Node > inst;
-      for (unsigned i = 0; i < riter.getNumTerms(); i++)
+      for (unsigned i = 0; i < nterms; i++)
       {
-        TypeNode tn = riter.getTypeOf(i);
-        // if the type is not closed enumerable (see
-        // TypeNode::isClosedEnumerable), then we must ensure that we are
-        // using a term and not a value. This ensures that e.g. uninterpreted
-        // constants do not appear in instantiations.
-        Node rr = riter.getCurrentTerm(i, !tn.isClosedEnumerable());
-        Node r = fm->getRepresentative(rr);
-        debugPrint("fmc-exh-debug", r);
+        Node rr = riter.getCurrentTerm(i, valTerm[i]);
+        if (rr != inst[i])
+        {
+          inst[i] = rr;
+          ev_inst[i] = fm->getRepresentative(rr);
+        }
+        debugPrint("fmc-exh-debug", ev_inst[i]);
         Trace("fmc-exh-debug") << " (term : " << rr << ")";
-        ev_inst.push_back( r );
-        inst.push_back( rr );
       }
       int ev_index = d_quant_models[f].getGeneralizationIndex(fm, ev_inst);
       Trace("fmc-exh-debug") << ", index = " << ev_index << " / " << d_quant_models[f].d_value.size();
       Node ev = ev_index==-1 ? Node::null() : d_quant_models[f].d_value[ev_index];
       if (ev!=d_true) {
         Trace("fmc-exh-debug") << ", add!";
-        //add as instantiation
-        if (d_qe->getInstantiate()->addInstantiation(f, inst, true))
+        //add as instantiation, on a copy since the terms may be modified
+        std::vector<Node> terms(inst);
+        if (d_qe->getInstantiate()->addInstantiation(f, terms, true))
         {
           Trace("fmc-exh-debug")  << " ...success.";
           addedLemmas++;
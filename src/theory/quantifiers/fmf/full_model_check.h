@@ -90,6 +90,23 @@ protected:
   std::map< TypeNode, Node > d_array_cond;
   std::map< Node, Node > d_array_term_cond;
   std::map< Node, std::vector< int > > d_star_insts;
+  /** The definition of a function in the previous round */
+  struct FunDefCache
+  {
+    FunDefCache() : d_valid(false) {}
+    bool d_valid;
+    /** The sorted entries the definition was built from */
+    std::vector<Node> d_conds;
+    std::vector<Node> d_values;
+    /** The simplified definition and its function value */
+    Def d_def;
+    Node d_function_value;
+  };
+  /**
+   * Maps functions to their definitions in the previous round, which are
+   * reused by processBuildModel if their entries did not change.
+   */
+  std::map<Node, FunDefCache> d_fun_def_cache;
   //--------------------for preinitialization
   /** preInitializeType
    *
@@ -14,6 +14,8 @@
 
 #include "theory/quantifiers/inst_match_trie.h"
 
+#include <algorithm>
+
 #include "theory/quantifiers/instantiate.h"
 #include "theory/quantifiers/quant_util.h"
 #include "theory/quantifiers/term_database.h"
@@ -529,6 +531,336 @@ void CDInstMatchTrie::getExplanationForInstLemmas(
   }
 }
 
+const uint32_t InstMatchTrieFlat::s_none;
+const uint64_t InstMatchTrieFlat::s_emptyKey;
+
+InstMatchTrieFlat::InstMatchTrieFlat() : d_numKeys(0), d_shift(60)
+{
+  // the root
+  Entry root;
+  root.d_parent = s_none;
+  root.d_term = s_none;
+  d_nodes.push_back(root);
+  d_keys.resize(16, s_emptyKey);
+  d_children.resize(16, s_none);
+}
+
+bool InstMatchTrieFlat::addInstMatch(QuantifiersEngine* qe,
+                                     Node q,
+                                     std::vector<Node>& m,
+                                     bool modEq,
+                                     bool onlyExist,
+                                     unsigned index,
+                                     uint32_t node)
+{
+  unsigned nvars = q[0].getNumChildren();
+  if (index == nvars)
+  {
+    return false;
+  }
+  Node n = m[index];
+  uint32_t c = getChild(node, getTermId(n));
+  if (c != s_none)
+  {
+    bool ret = addInstMatch(qe, q, m, modEq, onlyExist, index + 1, c);
+    if (!onlyExist || !ret)
+    {
+      return ret;
+    }
+  }
+  if (modEq)
+  {
+    // check modulo equality if any other instantiation match exists
+    if (!n.isNull() && qe->getEqualityQuery()->getEngine()->hasTerm(n))
+    {
+      eq::EqClassIterator eqc(
+          qe->getEqualityQuery()->getEngine()->getRepresentative(n),
+          qe->getEqualityQuery()->getEngine());
+      while (!eqc.isFinished())
+      {
+        Node en = (*eqc);
+        if (en != n)
+        {
+          uint32_t cc = getChild(node, getTermId(en));
+          if (cc != s_none
+              && addInstMatch(qe, q, m, modEq, true, index + 1, cc))
+          {
+            return false;
+          }
+        }
+        ++eqc;
+      }
+    }
+  }
+  if (!onlyExist)
+  {
+    // the suffix of m from index is new
+    for (unsigned i = index; i < nvars; i++)
+    {
+      node = mkChild(node, mkTermId(m[i]));
+    }
+    d_leaves.push_back(node);
+  }
+  return true;
+}
+
+bool InstMatchTrieFlat::removeInstMatch(Node q, std::vector<Node>& m)
+{
+  uint32_t leaf = getLeaf(q, m);
+  if (leaf == s_none)
+  {
+    return false;
+  }
+  const Entry& e = d_nodes[leaf];
+  uint64_t key = (static_cast<uint64_t>(e.d_parent) << 32) | e.d_term;
+  d_children[findSlot(key)] = s_none;
+  d_lemmas.erase(leaf);
+  return true;
+}
+
+bool InstMatchTrieFlat::recordInstLemma(Node q,
+                                        std::vector<Node>& m,
+                                        Node lem)
+{
+  uint32_t leaf = getLeaf(q, m);
+  if (leaf == s_none)
+  {
+    return false;
+  }
+  d_lemmas[leaf] = lem;
+  return true;
+}
+
+void InstMatchTrieFlat::getInstantiations(std::vector<Node>& insts,
+                                          Node q,
+                                          QuantifiersEngine* qe,
+                                          bool useActive,
+                                          std::vector<Node>& active) const
+{
+  std::vector<Node> terms;
+  for (uint32_t leaf : d_leaves)
+  {
+    if (!isActive(leaf))
+    {
+      continue;
+    }
+    Node lem = getInstLemma(leaf);
+    if (useActive)
+    {
+      if (!lem.isNull()
+          && std::find(active.begin(), active.end(), lem) != active.end())
+      {
+        insts.push_back(lem);
+      }
+    }
+    else if (!lem.isNull())
+    {
+      insts.push_back(lem);
+    }
+    else if (!options::trackInstLemmas())
+    {
+      // as in InstMatchTrie, the instantiations that were recorded but not
+      // sent out as lemmas are only considered if lemmas are not tracked
+      getTerms(leaf, terms);
+      insts.push_back(qe->getInstantiate()->getInstantiation(q, terms, true));
+    }
+  }
+}
+
+void InstMatchTrieFlat::getExplanationForInstLemmas(
+    Node q,
+    const std::vector<Node>& lems,
+    std::map<Node, Node>& quant,
+    std::map<Node, std::vector<Node> >& tvec) const
+{
+  for (uint32_t leaf : d_leaves)
+  {
+    if (!isActive(leaf))
+    {
+      continue;
+    }
+    Node lem = getInstLemma(leaf);
+    if (!lem.isNull() && std::find(lems.begin(), lems.end(), lem) != lems.end())
+    {
+      quant[lem] = q;
+      getTerms(leaf, tvec[lem]);
+    }
+  }
+}
+
+void InstMatchTrieFlat::print(std::ostream& out,
+                              Node q,
+                              bool& firstTime,
+                              bool useActive,
+                              std::vector<Node>& active) const
+{
+  std::vector<Node> terms;
+  for (uint32_t leaf : d_leaves)
+  {
+    if (!isActive(leaf))
+    {
+      continue;
+    }
+    if (useActive)
+    {
+      Node lem = getInstLemma(leaf);
+      if (lem.isNull()
+          || std::find(active.begin(), active.end(), lem) == active.end())
+      {
+        continue;
+      }
+    }
+    if (firstTime)
+    {
+      out << "(instantiation " << q << std::endl;
+      firstTime = false;
+    }
+    getTerms(leaf, terms);
+    out << "  ( ";
+    for (unsigned i = 0, size = terms.size(); i < size; i++)
+    {
+      if (i > 0)
+      {
+        out << ", ";
+      }
+      out << terms[i];
+    }
+    out << " )" << std::endl;
+  }
+}
+
+uint32_t InstMatchTrieFlat::getTermId(TNode n) const
+{
+  std::unordered_map<Node, uint32_t, NodeHashFunction>::const_iterator it =
+      d_termIds.find(n);
+  return it == d_termIds.end() ? s_none : it->second;
+}
+
+uint32_t InstMatchTrieFlat::mkTermId(Node n)
+{
+  std::unordered_map<Node, uint32_t, NodeHashFunction>::iterator it =
+      d_termIds.find(n);
+  if (it != d_termIds.end())
+  {
+    return it->second;
+  }
+  uint32_t id = d_terms.size();
+  d_terms.push_back(n);
+  d_termIds[n] = id;
+  return id;
+}
+
+uint32_t InstMatchTrieFlat::getChild(uint32_t node, uint32_t term) const
+{
+  if (term == s_none)
+  {
+    return s_none;
+  }
+  uint64_t key = (static_cast<uint64_t>(node) << 32) | term;
+  // the child of an empty slot is s_none
+  return d_children[findSlot(key)];
+}
+
+uint32_t InstMatchTrieFlat::mkChild(uint32_t node, uint32_t term)
+{
+  uint64_t key = (static_cast<uint64_t>(node) << 32) | term;
+  size_t slot = findSlot(key);
+  if (d_children[slot] != s_none)
+  {
+    return d_children[slot];
+  }
+  if (d_keys[slot] == s_emptyKey)
+  {
+    // keep the load factor of the table below 3/4
+    if (4 * (d_numKeys + 1) > 3 * d_keys.size())
+    {
+      grow();
+      slot = findSlot(key);
+    }
+    d_keys[slot] = key;
+    d_numKeys++;
+  }
+  // otherwise, this is the slot of a removed edge, which is reused
+  uint32_t c = d_nodes.size();
+  Entry e;
+  e.d_parent = node;
+  e.d_term = term;
+  d_nodes.push_back(e);
+  d_children[slot] = c;
+  return c;
+}
+
+uint32_t InstMatchTrieFlat::getLeaf(Node q, const std::vector<Node>& m) const
+{
+  uint32_t node = 0;
+  for (unsigned i = 0, nvars = q[0].getNumChildren(); i < nvars; i++)
+  {
+    node = getChild(node, getTermId(m[i]));
+    if (node == s_none)
+    {
+      return s_none;
+    }
+  }
+  return node;
+}
+
+size_t InstMatchTrieFlat::findSlot(uint64_t key) const
+{
+  // Fibonacci hashing, whose high bits depend on both halves of the key
+  size_t mask = d_keys.size() - 1;
+  size_t i = (key * 0x9E3779B97F4A7C15ULL) >> d_shift;
+  while (d_keys[i] != key && d_keys[i] != s_emptyKey)
+  {
+    i = (i + 1) & mask;
+  }
+  return i;
+}
+
+void InstMatchTrieFlat::grow()
+{
+  std::vector<uint64_t> keys;
+  std::vector<uint32_t> children;
+  keys.swap(d_keys);
+  children.swap(d_children);
+  d_keys.resize(2 * keys.size(), s_emptyKey);
+  d_children.resize(2 * keys.size(), s_none);
+  d_shift--;
+  d_numKeys = 0;
+  for (size_t i = 0, size = keys.size(); i < size; i++)
+  {
+    // the removed edges are dropped
+    if (keys[i] != s_emptyKey && children[i] != s_none)
+    {
+      size_t slot = findSlot(keys[i]);
+      d_keys[slot] = keys[i];
+      d_children[slot] = children[i];
+      d_numKeys++;
+    }
+  }
+}
+
+bool InstMatchTrieFlat::isActive(uint32_t leaf) const
+{
+  const Entry& e = d_nodes[leaf];
+  return getChild(e.d_parent, e.d_term) == leaf;
+}
+
+void InstMatchTrieFlat::getTerms(uint32_t leaf, std::vector<Node>& terms) const
+{
+  terms.clear();
+  for (uint32_t node = leaf; node != 0; node = d_nodes[node].d_parent)
+  {
+    terms.push_back(d_terms[d_nodes[node].d_term]);
+  }
+  std::reverse(terms.begin(), terms.end());
+}
+
+Node InstMatchTrieFlat::getInstLemma(uint32_t leaf) const
+{
+  std::unordered_map<uint32_t, Node>::const_iterator it = d_lemmas.find(leaf);
+  return it == d_lemmas.end() ? Node::null() : it->second;
+}
+
 } /* CVC4::theory::inst namespace */
 } /* CVC4::theory namespace */
 } /* CVC4 namespace */
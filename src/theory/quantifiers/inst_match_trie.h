@@ -17,7 +17,9 @@
 #ifndef CVC4__THEORY__QUANTIFIERS__INST_MATCH_TRIE_H
 #define CVC4__THEORY__QUANTIFIERS__INST_MATCH_TRIE_H
 
+#include <cstdint>
 #include <map>
+#include <unordered_map>
 
 #include "context/cdlist.h"
 #include "context/cdo.h"
@@ -384,6 +386,131 @@ class CDInstMatchTrie
   Node getInstLemma() const { return d_data.begin()->first; }
 };
 
+/** flat trie for InstMatch objects
+ *
+ * This is an alternative representation of the context-independent
+ * instantiation match trie of a quantified formula, whose memory does not
+ * grow with one std::map per node of the trie. The terms of the entries are
+ * numbered once per trie, and the nodes of the trie are numbered in an
+ * arena, where the child of node p for the term numbered t is found in an
+ * open addressing hash table keyed by (p, t). Hence, each edge of the trie
+ * costs an entry of the arena and a slot of the hash table, instead of a
+ * node of a std::map and a Node.
+ *
+ * The entries are enumerated (e.g. by getInstantiations) in the order they
+ * were added, instead of the order of their terms.
+ */
+class InstMatchTrieFlat
+{
+ public:
+  InstMatchTrieFlat();
+  ~InstMatchTrieFlat() {}
+  /** exists inst match, same as for InstMatchTrie */
+  bool existsInstMatch(QuantifiersEngine* qe,
+                       Node q,
+                       std::vector<Node>& m,
+                       bool modEq = false)
+  {
+    return !addInstMatch(qe, q, m, modEq, true);
+  }
+  /** add inst match, same as for InstMatchTrie */
+  bool addInstMatch(QuantifiersEngine* qe,
+                    Node q,
+                    std::vector<Node>& m,
+                    bool modEq = false,
+                    bool onlyExist = false)
+  {
+    return addInstMatch(qe, q, m, modEq, onlyExist, 0, 0);
+  }
+  /** remove inst match, same as for InstMatchTrie */
+  bool removeInstMatch(Node q, std::vector<Node>& m);
+  /** record instantiation lemma, same as for InstMatchTrie */
+  bool recordInstLemma(Node q, std::vector<Node>& m, Node lem);
+  /** get instantiations, same as for InstMatchTrie */
+  void getInstantiations(std::vector<Node>& insts,
+                         Node q,
+                         QuantifiersEngine* qe,
+                         bool useActive,
+                         std::vector<Node>& active) const;
+  /** get explanation for inst lemmas, same as for InstMatchTrie */
+  void getExplanationForInstLemmas(
+      Node q,
+      const std::vector<Node>& lems,
+      std::map<Node, Node>& quant,
+      std::map<Node, std::vector<Node> >& tvec) const;
+  /** print this class, same as for InstMatchTrie */
+  void print(std::ostream& out,
+             Node q,
+             bool& firstTime,
+             bool useActive,
+             std::vector<Node>& active) const;
+
+ private:
+  /** The identifier of no term and of no node */
+  static const uint32_t s_none = UINT32_MAX;
+  /** The key of the empty slots of the hash table */
+  static const uint64_t s_emptyKey = UINT64_MAX;
+  /** A node of the trie, other than the root */
+  struct Entry
+  {
+    /** The parent node */
+    uint32_t d_parent;
+    /** The term labelling the edge from the parent */
+    uint32_t d_term;
+  };
+  /**
+   * Helper for add inst match, which considers the suffix of m starting at
+   * index from the node of the trie with the given identifier.
+   */
+  bool addInstMatch(QuantifiersEngine* qe,
+                    Node q,
+                    std::vector<Node>& m,
+                    bool modEq,
+                    bool onlyExist,
+                    unsigned index,
+                    uint32_t node);
+  /** Returns the identifier of term n, or s_none if it has none */
+  uint32_t getTermId(TNode n) const;
+  /** Returns the identifier of term n, which is assigned if n has none */
+  uint32_t mkTermId(Node n);
+  /** Returns the child of node for term, or s_none if it has none */
+  uint32_t getChild(uint32_t node, uint32_t term) const;
+  /** Returns the child of node for term, which is added if it has none */
+  uint32_t mkChild(uint32_t node, uint32_t term);
+  /** Returns the leaf reached by the path m, or s_none if it has none */
+  uint32_t getLeaf(Node q, const std::vector<Node>& m) const;
+  /** Returns the slot of the hash table for key, which is empty if absent */
+  size_t findSlot(uint64_t key) const;
+  /** Doubles the size of the hash table */
+  void grow();
+  /** Returns true if leaf was not removed from the trie */
+  bool isActive(uint32_t leaf) const;
+  /** Gets the terms of the path from the root to leaf */
+  void getTerms(uint32_t leaf, std::vector<Node>& terms) const;
+  /** Returns the instantiation lemma recorded for leaf, if any */
+  Node getInstLemma(uint32_t leaf) const;
+
+  /** The terms of the entries and their identifiers */
+  std::vector<Node> d_terms;
+  std::unordered_map<Node, uint32_t, NodeHashFunction> d_termIds;
+  /** The nodes of the trie, where d_nodes[0] is the root */
+  std::vector<Entry> d_nodes;
+  /**
+   * The hash table of edges, where d_keys[i] is (parent, term) and
+   * d_children[i] the child, s_none for a removed edge.
+   */
+  std::vector<uint64_t> d_keys;
+  std::vector<uint32_t> d_children;
+  /** The number of used slots of the hash table */
+  size_t d_numKeys;
+  /** The shift of the hash of a key, 64 minus log2 of the size of the table */
+  unsigned d_shift;
+  /** The leaves of the trie, in the order they were added */
+  std::vector<uint32_t> d_leaves;
+  /** The instantiation lemmas recorded for leaves */
+  std::unordered_map<uint32_t, Node> d_lemmas;
+};
+
 /** inst match trie ordered
  *
  * This is an ordered version of the context-independent instantiation match
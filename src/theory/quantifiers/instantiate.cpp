@@ -19,6 +19,7 @@
 #include "smt/smt_statistics_registry.h"
 #include "theory/quantifiers/cegqi/inst_strategy_cegqi.h"
 #include "theory/quantifiers/first_order_model.h"
+#include "theory/quantifiers/quant_ranking.h"
 #include "theory/quantifiers/quantifiers_attributes.h"
 #include "theory/quantifiers/quantifiers_rewriter.h"
 #include "theory/quantifiers/term_database.h"
@@ -316,6 +317,10 @@ bool Instantiate::addInstantiation(
     {
       recorded = d_c_inst_match_trie[q]->recordInstLemma(q, terms, lem);
     }
+    else if (options::instTrieFlat())
+    {
+      recorded = d_flat_inst_match_trie[q].recordInstLemma(q, terms, lem);
+    }
     else
     {
       recorded = d_inst_match_trie[q].recordInstLemma(q, terms, lem);
@@ -323,6 +328,12 @@ bool Instantiate::addInstantiation(
     Trace("inst-add-debug") << "...was recorded : " << recorded << std::endl;
     Assert(recorded);
   }
+  QuantRanking* qrank = d_qe->getQuantRanking();
+  if (qrank != nullptr)
+  {
+    qrank->notifyInstantiation(
+        q, d_qe->getCurrentQEffort() == QuantifiersModule::QEFFORT_CONFLICT);
+  }
   Trace("inst-add-debug") << " --> Success." << std::endl;
   ++(d_statistics.d_instantiations);
   return true;
@@ -362,6 +373,15 @@ bool Instantiate::existsInstantiation(Node q,
           d_qe, q, terms, d_qe->getUserContext(), modEq);
     }
   }
+  else if (options::instTrieFlat())
+  {
+    std::map<Node, inst::InstMatchTrieFlat>::iterator it =
+        d_flat_inst_match_trie.find(q);
+    if (it != d_flat_inst_match_trie.end())
+    {
+      return it->second.existsInstMatch(d_qe, q, terms, modEq);
+    }
+  }
   else
   {
     std::map<Node, inst::InstMatchTrie>::iterator it =
@@ -437,6 +457,10 @@ bool Instantiate::recordInstantiationInternal(Node q,
     return imt->addInstMatch(d_qe, q, terms, d_qe->getUserContext(), modEq);
   }
   Trace("inst-add-debug") << "Adding into inst trie" << std::endl;
+  if (options::instTrieFlat())
+  {
+    return d_flat_inst_match_trie[q].addInstMatch(d_qe, q, terms, modEq);
+  }
   return d_inst_match_trie[q].addInstMatch(d_qe, q, terms, modEq);
 }
 
@@ -452,6 +476,10 @@ bool Instantiate::removeInstantiationInternal(Node q, std::vector<Node>& terms)
     }
     return false;
   }
+  if (options::instTrieFlat())
+  {
+    return d_flat_inst_match_trie[q].removeInstMatch(q, terms);
+  }
   return d_inst_match_trie[q].removeInstMatch(q, terms);
 }
 
@@ -486,6 +514,20 @@ bool Instantiate::printInstantiations(std::ostream& out)
       printed = printed || !firstTime;
     }
   }
+  else if (options::instTrieFlat())
+  {
+    for (std::pair<const Node, inst::InstMatchTrieFlat>& t :
+         d_flat_inst_match_trie)
+    {
+      bool firstTime = true;
+      t.second.print(out, t.first, firstTime, useUnsatCore, active_lemmas);
+      if (!firstTime)
+      {
+        out << ")" << std::endl;
+      }
+      printed = printed || !firstTime;
+    }
+  }
   else
   {
     for (std::pair<const Node, inst::InstMatchTrie>& t : d_inst_match_trie)
@@ -514,6 +556,14 @@ void Instantiate::getInstantiatedQuantifiedFormulas(std::vector<Node>& qs)
       qs.push_back(*it);
     }
   }
+  else if (options::instTrieFlat())
+  {
+    for (std::pair<const Node, inst::InstMatchTrieFlat>& t :
+         d_flat_inst_match_trie)
+    {
+      qs.push_back(t.first);
+    }
+  }
   else
   {
     for (std::pair<const Node, inst::InstMatchTrie>& t : d_inst_match_trie)
@@ -596,6 +646,14 @@ void Instantiate::getInstantiationTermVectors(
       getInstantiationTermVectors(t.first, insts[t.first]);
     }
   }
+  else if (options::instTrieFlat())
+  {
+    for (std::pair<const Node, inst::InstMatchTrieFlat>& t :
+         d_flat_inst_match_trie)
+    {
+      getInstantiationTermVectors(t.first, insts[t.first]);
+    }
+  }
   else
   {
     for (std::pair<const Node, inst::InstMatchTrie>& t : d_inst_match_trie)
@@ -624,6 +682,14 @@ void Instantiate::getExplanationForInstLemmas(
       t.second->getExplanationForInstLemmas(t.first, lems, quant, tvec);
     }
   }
+  else if (options::instTrieFlat())
+  {
+    for (std::pair<const Node, inst::InstMatchTrieFlat>& t :
+         d_flat_inst_match_trie)
+    {
+      t.second.getExplanationForInstLemmas(t.first, lems, quant, tvec);
+    }
+  }
   else
   {
     for (std::pair<const Node, inst::InstMatchTrie>& t : d_inst_match_trie)
@@ -659,6 +725,15 @@ void Instantiate::getInstantiations(std::map<Node, std::vector<Node> >& insts)
           insts[t.first], t.first, d_qe, useUnsatCore, active_lemmas);
     }
   }
+  else if (options::instTrieFlat())
+  {
+    for (std::pair<const Node, inst::InstMatchTrieFlat>& t :
+         d_flat_inst_match_trie)
+    {
+      t.second.getInstantiations(
+          insts[t.first], t.first, d_qe, useUnsatCore, active_lemmas);
+    }
+  }
   else
   {
     for (std::pair<const Node, inst::InstMatchTrie>& t : d_inst_match_trie)
@@ -682,6 +757,17 @@ void Instantiate::getInstantiations(Node q, std::vector<Node>& insts)
           insts, it->first, d_qe, false, active_lemmas);
     }
   }
+  else if (options::instTrieFlat())
+  {
+    std::map<Node, inst::InstMatchTrieFlat>::iterator it =
+        d_flat_inst_match_trie.find(q);
+    if (it != d_flat_inst_match_trie.end())
+    {
+      std::vector<Node> active_lemmas;
+      it->second.getInstantiations(
+          insts, it->first, d_qe, false, active_lemmas);
+    }
+  }
   else
   {
     std::map<Node, inst::InstMatchTrie>::iterator it =
@@ -338,9 +338,11 @@ class Instantiate : public QuantifiersUtil
   /** list of all instantiations produced for each quantifier
    *
    * We store context (dependent, independent) versions. If incremental solving
-   * is disabled, we use d_inst_match_trie for performance reasons.
+   * is disabled, we use d_inst_match_trie for performance reasons, or
+   * d_flat_inst_match_trie if --inst-trie-flat is enabled.
    */
   std::map<Node, inst::InstMatchTrie> d_inst_match_trie;
+  std::map<Node, inst::InstMatchTrieFlat> d_flat_inst_match_trie;
   std::map<Node, inst::CDInstMatchTrie*> d_c_inst_match_trie;
   /**
    * The list of quantified formulas for which the domain of d_c_inst_match_trie
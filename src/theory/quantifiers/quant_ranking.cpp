@@ -0,0 +1,168 @@
+/*********************                                                        */
+/*! \file quant_ranking.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the ranking of quantified formulas
+ **/
+
+#include "theory/quantifiers/quant_ranking.h"
+
+#include <algorithm>
+
+#include "options/quantifiers_options.h"
+#include "smt/smt_statistics_registry.h"
+#include "theory/quantifiers/first_order_model.h"
+#include "theory/quantifiers_engine.h"
+
+using namespace CVC4::kind;
+
+namespace CVC4 {
+namespace theory {
+namespace quantifiers {
+
+QuantRanking::QuantRanking(QuantifiersEngine* qe)
+    : d_qe(qe),
+      d_bump(1.0),
+      d_topK(options::quantRankTopK()),
+      d_restricted(false)
+{
+}
+
+QuantRanking::~QuantRanking() {}
+
+bool QuantRanking::reset(Theory::Effort e)
+{
+  d_restricted = false;
+  return true;
+}
+
+void QuantRanking::registerQuantifier(Node q)
+{
+  if (d_score.find(q) == d_score.end())
+  {
+    // new formulas are ranked as if they had just been useful
+    d_score[q] = d_bump;
+  }
+}
+
+void QuantRanking::activate(Theory::Effort e)
+{
+  // age the scores, by increasing the amount of future bumps
+  double decay = options::quantRankDecay();
+  if (decay > 0.0 && decay < 1.0)
+  {
+    d_bump /= decay;
+  }
+  if (d_bump > 1e100)
+  {
+    rescale();
+  }
+  if (e != Theory::EFFORT_FULL)
+  {
+    return;
+  }
+  FirstOrderModel* fm = d_qe->getModel();
+  std::vector<std::pair<double, Node> > ranked;
+  for (unsigned i = 0, nquant = fm->getNumAssertedQuantifiers(); i < nquant;
+       i++)
+  {
+    Node q = fm->getAssertedQuantifier(i);
+    // formulas owned by a module are handled by that module
+    if (d_qe->getOwner(q) == nullptr)
+    {
+      ranked.push_back(std::pair<double, Node>(getScore(q), q));
+    }
+  }
+  if (ranked.size() <= d_topK)
+  {
+    return;
+  }
+  std::stable_sort(ranked.begin(),
+                   ranked.end(),
+                   [](const std::pair<double, Node>& a,
+                      const std::pair<double, Node>& b) {
+                     return a.first > b.first;
+                   });
+  d_restricted = true;
+  ++(d_statistics.d_restrictedRounds);
+  for (size_t i = d_topK, size = ranked.size(); i < size; i++)
+  {
+    Trace("quant-rank-debug") << "Inactive : " << ranked[i].second
+                              << ", score " << ranked[i].first << std::endl;
+    fm->setQuantifierActive(ranked[i].second, false);
+  }
+  d_statistics.d_inactive += ranked.size() - d_topK;
+  Trace("quant-rank") << "QuantRanking: " << d_topK << " / " << ranked.size()
+                      << " quantified formulas active" << std::endl;
+}
+
+void QuantRanking::finishRound(bool addedLemma)
+{
+  if (!d_restricted)
+  {
+    return;
+  }
+  d_restricted = false;
+  if (addedLemma)
+  {
+    d_topK = std::max(options::quantRankTopK(), d_topK / 2);
+  }
+  else
+  {
+    d_topK = 2 * d_topK;
+    ++(d_statistics.d_expansions);
+  }
+}
+
+void QuantRanking::notifyInstantiation(Node q, bool conflict)
+{
+  // instances found while searching for conflicts are the most useful
+  d_score[q] += conflict ? 2 * d_bump : d_bump;
+  if (d_score[q] > 1e100)
+  {
+    rescale();
+  }
+}
+
+double QuantRanking::getScore(Node q) const
+{
+  std::map<Node, double>::const_iterator it = d_score.find(q);
+  return it == d_score.end() ? 0.0 : it->second;
+}
+
+void QuantRanking::rescale()
+{
+  for (std::pair<const Node, double>& s : d_score)
+  {
+    s.second *= 1e-100;
+  }
+  d_bump *= 1e-100;
+}
+
+QuantRanking::Statistics::Statistics()
+    : d_restrictedRounds("QuantRanking::Restricted_Rounds", 0),
+      d_inactive("QuantRanking::Inactive_Quantifiers", 0),
+      d_expansions("QuantRanking::Expansions", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_restrictedRounds);
+  smtStatisticsRegistry()->registerStat(&d_inactive);
+  smtStatisticsRegistry()->registerStat(&d_expansions);
+}
+
+QuantRanking::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_restrictedRounds);
+  smtStatisticsRegistry()->unregisterStat(&d_inactive);
+  smtStatisticsRegistry()->unregisterStat(&d_expansions);
+}
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace CVC4
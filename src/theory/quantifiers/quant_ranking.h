@@ -0,0 +1,113 @@
+/*********************                                                        */
+/*! \file quant_ranking.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Ranking of quantified formulas for throttling instantiation
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__QUANTIFIERS__QUANT_RANKING_H
+#define CVC4__THEORY__QUANTIFIERS__QUANT_RANKING_H
+
+#include <map>
+
+#include "expr/node.h"
+#include "theory/quantifiers/quant_util.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace theory {
+
+class QuantifiersEngine;
+
+namespace quantifiers {
+
+/** QuantRanking
+ *
+ * This class maintains an activity score for each quantified formula, in the
+ * style of VSIDS. The score of a quantified formula is bumped each time one
+ * of its instances is added, and bumped more when that instance is added
+ * while searching for conflicting instances. The scores decay at each round,
+ * so that formulas that have not been useful recently age out of the ranking.
+ *
+ * At each full effort round, only the k asserted quantified formulas with
+ * the highest scores are active (see FirstOrderModel::isQuantifierActive).
+ * If a round restricted in this way does not add any lemma, k is doubled for
+ * the next round; if it does, k is halved back towards its initial value.
+ * All quantified formulas are active at last call effort, so the ranking only
+ * reorders the instantiation effort and does not affect completeness.
+ *
+ * This is enabled by the option --quant-rank-top-k=N.
+ */
+class QuantRanking : public QuantifiersUtil
+{
+ public:
+  QuantRanking(QuantifiersEngine* qe);
+  ~QuantRanking();
+  /** reset */
+  bool reset(Theory::Effort e) override;
+  /** register quantifier, which starts with the current bump amount */
+  void registerQuantifier(Node q) override;
+  /** identify */
+  std::string identify() const override { return "QuantRanking"; }
+  /**
+   * Activates the top-k asserted quantified formulas in the model of the
+   * quantifiers engine. This must be called after the model is reset for the
+   * round.
+   */
+  void activate(Theory::Effort e);
+  /**
+   * Called at the end of a round, where addedLemma is whether the round added
+   * any lemma. This adapts the number of active quantified formulas.
+   */
+  void finishRound(bool addedLemma);
+  /**
+   * Notifies this class that an instance of q was added, where conflict is
+   * whether it was added at the conflict effort of the quantifiers engine.
+   */
+  void notifyInstantiation(Node q, bool conflict);
+  /** get the score of q */
+  double getScore(Node q) const;
+
+ private:
+  /** pointer to the quantifiers engine */
+  QuantifiersEngine* d_qe;
+  /** the score of each quantified formula */
+  std::map<Node, double> d_score;
+  /** the current amount by which scores are bumped */
+  double d_bump;
+  /** the number of formulas active at full effort */
+  unsigned d_topK;
+  /** whether the current round was restricted to the top-k formulas */
+  bool d_restricted;
+  /** rescales all scores if the bump amount gets too large */
+  void rescale();
+
+  class Statistics
+  {
+   public:
+    /** the number of rounds restricted to the top-k formulas */
+    IntStat d_restrictedRounds;
+    /** the number of quantified formulas made inactive */
+    IntStat d_inactive;
+    /** the number of times k was expanded */
+    IntStat d_expansions;
+    Statistics();
+    ~Statistics();
+  };
+  Statistics d_statistics;
+};
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__QUANTIFIERS__QUANT_RANKING_H */
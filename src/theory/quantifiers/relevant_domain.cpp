@@ -30,15 +30,19 @@ void RelevantDomain::RDomain::merge( RDomain * r ) {
   Assert(!d_parent);
   Assert(!r->d_parent);
   d_parent = r;
-  for( unsigned i=0; i<d_terms.size(); i++ ){
-    r->addTerm( d_terms[i] );
+  for (const Node& t : d_candidates)
+  {
+    r->addTerm(t);
   }
   d_terms.clear();
+  d_candidates.clear();
+  d_candidateSet.clear();
 }
 
 void RelevantDomain::RDomain::addTerm( Node t ) {
-  if( std::find( d_terms.begin(), d_terms.end(), t )==d_terms.end() ){
-    d_terms.push_back( t );
+  if (d_candidateSet.insert(t).second)
+  {
+    d_candidates.push_back(t);
   }
 }
 
@@ -54,13 +58,15 @@ RelevantDomain::RDomain * RelevantDomain::RDomain::getParent() {
 
 void RelevantDomain::RDomain::removeRedundantTerms( QuantifiersEngine * qe ) {
   std::map< Node, Node > rterms;
-  for( unsigned i=0; i<d_terms.size(); i++ ){
-    Node r = d_terms[i];
-    if( !TermUtil::hasInstConstAttr( d_terms[i] ) ){
-      r = qe->getEqualityQuery()->getRepresentative( d_terms[i] );
+  for (const Node& t : d_candidates)
+  {
+    Node r = t;
+    if (!TermUtil::hasInstConstAttr(t))
+    {
+      r = qe->getEqualityQuery()->getRepresentative(t);
     }
     if( rterms.find( r )==rterms.end() ){
-      rterms[r] = d_terms[i];
+      rterms[r] = t;
     }
   }
   d_terms.clear();
@@ -100,17 +106,30 @@ bool RelevantDomain::reset( Theory::Effort e ) {
 }
 
 void RelevantDomain::registerQuantifier(Node q) {}
+
+void RelevantDomain::presolve()
+{
+  for (std::pair<const Node, std::map<int, RDomain*> >& rd : d_rel_doms)
+  {
+    for (std::pair<const int, RDomain*>& rdi : rd.second)
+    {
+      rdi.second->reset();
+    }
+  }
+  d_processedQuants.clear();
+  d_processedTerms.clear();
+}
+
 void RelevantDomain::compute(){
   if( !d_is_computed ){
     d_is_computed = true;
-    for( std::map< Node, std::map< int, RDomain * > >::iterator it = d_rel_doms.begin(); it != d_rel_doms.end(); ++it ){
-      for( std::map< int, RDomain * >::iterator it2 = it->second.begin(); it2 != it->second.end(); ++it2 ){
-        it2->second->reset();
-      }
-    }
     FirstOrderModel* fm = d_qe->getModel();
     for( unsigned i=0; i<fm->getNumAssertedQuantifiers(); i++ ){
       Node q = fm->getAssertedQuantifier( i );
+      if (!d_processedQuants.insert(q).second)
+      {
+        continue;
+      }
       Node icf = d_qe->getTermUtil()->getInstConstantBody( q );
       Trace("rel-dom-debug") << "compute relevant domain for " << icf << std::endl;
       computeRelevantDomain( q, icf, true, true );
@@ -121,16 +140,18 @@ void RelevantDomain::compute(){
     for (unsigned k = 0; k < db->getNumOperators(); k++)
     {
       Node op = db->getOperator(k);
-      unsigned sz = db->getNumGroundTerms( op );
-      for( unsigned i=0; i<sz; i++ ){
-        Node n = db->getGroundTerm(op, i);
-        //if it is a non-redundant term
-        if( db->isTermActive( n ) ){
-          for( unsigned j=0; j<n.getNumChildren(); j++ ){
-            RDomain * rf = getRDomain( op, j );
-            rf->addTerm( n[j] );
-            Trace("rel-dom-debug") << "...add ground term " << n[j] << " to rel dom " << op << "[" << j << "]" << std::endl;
-          }
+      size_t& processed = d_processedTerms[op];
+      size_t sz = db->getNumGroundTerms(op);
+      // terms that are congruent to others are not skipped, since they may
+      // become non-redundant in later rounds; their arguments are removed
+      // below if they are equal to others
+      for (; processed < sz; processed++)
+      {
+        Node n = db->getGroundTerm(op, processed);
+        for( unsigned j=0; j<n.getNumChildren(); j++ ){
+          RDomain * rf = getRDomain( op, j );
+          rf->addTerm( n[j] );
+          Trace("rel-dom-debug") << "...add ground term " << n[j] << " to rel dom " << op << "[" << j << "]" << std::endl;
         }
       }
     }
@@ -17,6 +17,8 @@
 #ifndef CVC4__THEORY__QUANTIFIERS__RELEVANT_DOMAIN_H
 #define CVC4__THEORY__QUANTIFIERS__RELEVANT_DOMAIN_H
 
+#include <unordered_set>
+
 #include "theory/quantifiers/first_order_model.h"
 #include "theory/quantifiers/quant_util.h"
 
@@ -36,6 +38,13 @@ namespace quantifiers {
  * by getRDomain(...) calls. It is intended to be called
  * at full effort check, after we have initialized
  * the term database.
+ *
+ * The computation is incremental: each quantified formula is processed once,
+ * when it is first asserted, and each ground term of the term database is
+ * processed once, when it is first added to the database. Hence the relevant
+ * domains only grow until presolve, and may contain terms from quantified
+ * formulas that are no longer asserted. Only the removal of terms that are
+ * equal in the current context is redone at each round.
  */
 class RelevantDomain : public QuantifiersUtil
 {
@@ -50,6 +59,8 @@ class RelevantDomain : public QuantifiersUtil
   std::string identify() const override { return "RelevantDomain"; }
   /** Compute the relevant domain */
   void compute();
+  /** Presolve, which clears the relevant domains */
+  void presolve();
   /** Relevant domain representation.
    *
    * This data structure is inspired by the paper
@@ -64,13 +75,18 @@ class RelevantDomain : public QuantifiersUtil
   {
   public:
     RDomain() : d_parent( NULL ) {}
-    /** the set of terms in this relevant domain */
+    /**
+     * The set of terms in this relevant domain, without duplicates modulo
+     * equality, as computed by the last call to removeRedundantTerms.
+     */
     std::vector< Node > d_terms;
     /** reset this object */
     void reset()
     {
       d_parent = NULL;
       d_terms.clear();
+      d_candidates.clear();
+      d_candidateSet.clear();
     }
     /** merge this with r
      * This sets d_parent of this to r and
@@ -81,8 +97,8 @@ class RelevantDomain : public QuantifiersUtil
     void addTerm( Node t );
     /** get the parent of this */
     RDomain * getParent();
-    /** remove redundant terms for d_terms, removes
-     * duplicates modulo equality.
+    /** remove redundant terms, which sets d_terms to the terms added to this
+     * relevant domain without duplicates modulo equality.
      */
     void removeRedundantTerms( QuantifiersEngine * qe );
     /** is n in this relevant domain? */
@@ -91,6 +107,10 @@ class RelevantDomain : public QuantifiersUtil
    private:
     /** the parent of this relevant domain */
     RDomain* d_parent;
+    /** the terms added to this relevant domain, in the order of addition */
+    std::vector<Node> d_candidates;
+    /** the set of terms in d_candidates */
+    std::unordered_set<Node, NodeHashFunction> d_candidateSet;
   };
   /** get the relevant domain
    *
@@ -119,6 +139,13 @@ class RelevantDomain : public QuantifiersUtil
   QuantifiersEngine* d_qe;
   /** have we computed the relevant domain on this full effort check? */
   bool d_is_computed;
+  /** the quantified formulas whose bodies have been processed */
+  std::unordered_set<Node, NodeHashFunction> d_processedQuants;
+  /**
+   * The number of ground terms of each operator of the term database that
+   * have been processed.
+   */
+  std::map<Node, size_t> d_processedTerms;
   /** relevant domain literal
    * Caches the effect of literals on the relevant domain.
    */
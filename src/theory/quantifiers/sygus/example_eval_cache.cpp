@@ -14,6 +14,8 @@
  **/
 #include "theory/quantifiers/sygus/example_eval_cache.h"
 
+#include "options/quantifiers_options.h"
+#include "theory/evaluator.h"
 #include "theory/quantifiers/sygus/example_min_eval.h"
 #include "theory/quantifiers/sygus/synth_conjecture.h"
 
@@ -91,9 +93,27 @@ void ExampleEvalCache::evaluateVec(Node bv,
 void ExampleEvalCache::evaluateVecInternal(Node bv,
                                            std::vector<Node>& exOut) const
 {
-  // use ExampleMinEval
   SygusTypeInfo& ti = d_tds->getTypeInfo(d_stn);
   const std::vector<Node>& varlist = ti.getVarList();
+  if (options::sygusEvalOpt() && options::sygusEvalBatch())
+  {
+    // evaluate on all examples at once if bv can be compiled
+    EvaluatorProgram prog(bv, varlist);
+    if (prog.isCompiled())
+    {
+      size_t start = exOut.size();
+      prog.eval(d_examples, exOut);
+      for (size_t j = start, esize = exOut.size(); j < esize; j++)
+      {
+        if (!exOut[j].isConst())
+        {
+          exOut[j] = d_tds->rewriteNode(exOut[j]);
+        }
+      }
+      return;
+    }
+  }
+  // use ExampleMinEval
   EmeEvalTds emetds(d_tds, d_stn);
   ExampleMinEval eme(bv, varlist, &emetds);
   for (size_t j = 0, esize = d_examples.size(); j < esize; j++)
@@ -31,7 +31,9 @@ SygusStatistics::SygusStatistics()
                                  0),
       d_enumTermsRewrite("SygusEnumerator::enumTermsRewrite", 0),
       d_enumTermsExampleEval("SygusEnumerator::enumTermsEvalExamples", 0),
-      d_enumTerms("SygusEnumerator::enumTerms", 0)
+      d_enumTerms("SygusEnumerator::enumTerms", 0),
+      d_sideConditionChecks("SynthConjecture::sideConditionChecks", 0),
+      d_sideConditionModelHits("SynthConjecture::sideConditionModelHits", 0)
 
 {
   smtStatisticsRegistry()->registerStat(&d_cegqi_lemmas_ce);
@@ -43,6 +45,8 @@ SygusStatistics::SygusStatistics()
   smtStatisticsRegistry()->registerStat(&d_enumTermsRewrite);
   smtStatisticsRegistry()->registerStat(&d_enumTermsExampleEval);
   smtStatisticsRegistry()->registerStat(&d_enumTerms);
+  smtStatisticsRegistry()->registerStat(&d_sideConditionChecks);
+  smtStatisticsRegistry()->registerStat(&d_sideConditionModelHits);
 }
 
 SygusStatistics::~SygusStatistics()
@@ -56,6 +60,8 @@ SygusStatistics::~SygusStatistics()
   smtStatisticsRegistry()->unregisterStat(&d_enumTermsRewrite);
   smtStatisticsRegistry()->unregisterStat(&d_enumTermsExampleEval);
   smtStatisticsRegistry()->unregisterStat(&d_enumTerms);
+  smtStatisticsRegistry()->unregisterStat(&d_sideConditionChecks);
+  smtStatisticsRegistry()->unregisterStat(&d_sideConditionModelHits);
 }
 
 }  // namespace quantifiers
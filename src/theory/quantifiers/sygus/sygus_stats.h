@@ -49,6 +49,10 @@ class SygusStatistics
   IntStat d_enumTermsExampleEval;
   /** Number of non-redundant terms generated by fast enumerators */
   IntStat d_enumTerms;
+  /** Number of side conditions checked by a subsolver */
+  IntStat d_sideConditionChecks;
+  /** Number of side conditions satisfied by the model of a previous one */
+  IntStat d_sideConditionModelHits;
 };
 
 }  // namespace quantifiers
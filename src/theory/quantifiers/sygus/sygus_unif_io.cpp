@@ -24,6 +24,7 @@
 #include "util/random.h"
 
 #include <math.h>
+#include <bitset>
 
 using namespace CVC4::kind;
 
@@ -1006,6 +1007,21 @@ void SygusUnifIo::EnumCache::addEnumValue(Node v, std::vector<Node>& results)
   d_enum_val_to_index[v] = d_enum_vals.size();
   d_enum_vals.push_back(v);
   d_enum_vals_res.push_back(results);
+  // pack the values if they are Boolean constants
+  std::vector<uint64_t> bits((results.size() + 63) / 64, 0);
+  for (size_t i = 0, nres = results.size(); i < nres; i++)
+  {
+    if (results[i].getKind() != CONST_BOOLEAN)
+    {
+      bits.clear();
+      break;
+    }
+    if (results[i].getConst<bool>())
+    {
+      bits[i / 64] |= uint64_t(1) << (i % 64);
+    }
+  }
+  d_enum_vals_bits.push_back(bits);
 }
 
 void SygusUnifIo::initializeConstructSol()
@@ -1135,44 +1151,32 @@ Node SygusUnifIo::constructSol(
     // maybe we can find one in the cache
     if (ret_dt.isNull() && !retValMod)
     {
-      bool firstTime = true;
-      std::unordered_set<Node, NodeHashFunction> intersection;
-      std::map<TypeNode, std::unordered_set<Node, NodeHashFunction>>::iterator
-          pit;
-      for (size_t i = 0, nvals = x.d_vals.size(); i < nvals; i++)
+      // the partial solutions for all points of the current context
+      std::vector<Node> intersection;
+      std::map<TypeNode, std::map<Node, std::vector<uint64_t>>>::iterator pit =
+          d_psolutions.find(etn);
+      if (pit != d_psolutions.end())
       {
-        if (x.d_vals[i].getConst<bool>())
+        size_t nvals = x.d_vals.size();
+        std::vector<uint64_t> active((nvals + 63) / 64, 0);
+        for (size_t i = 0; i < nvals; i++)
         {
-          pit = d_psolutions[i].find(etn);
-          if (pit == d_psolutions[i].end())
+          if (x.d_vals[i].getConst<bool>())
           {
-            // no cached solution
-            intersection.clear();
-            break;
+            active[i / 64] |= uint64_t(1) << (i % 64);
           }
-          if (firstTime)
+        }
+        for (const std::pair<const Node, std::vector<uint64_t>>& ps :
+             pit->second)
+        {
+          bool covers = true;
+          for (size_t w = 0, nwords = active.size(); w < nwords && covers; w++)
           {
-            intersection = pit->second;
-            firstTime = false;
+            covers = (active[w] & ~ps.second[w]) == 0;
           }
-          else
+          if (covers)
           {
-            std::vector<Node> rm;
-            for (const Node& a : intersection)
-            {
-              if (pit->second.find(a) == pit->second.end())
-              {
-                rm.push_back(a);
-              }
-            }
-            for (const Node& a : rm)
-            {
-              intersection.erase(a);
-            }
-            if (intersection.empty())
-            {
-              break;
-            }
+            intersection.push_back(ps.first);
           }
         }
       }
@@ -1183,14 +1187,11 @@ Node SygusUnifIo::constructSol(
           // if we are enabling minimality, the minimal cached solution may
           // still not be the best solution, thus we remember it and keep it if
           // we don't construct a better one below
-          std::vector<Node> intervec;
-          intervec.insert(
-              intervec.begin(), intersection.begin(), intersection.end());
-          cached_ret_dt = getMinimalTerm(intervec);
+          cached_ret_dt = getMinimalTerm(intersection);
         }
         else
         {
-          ret_dt = *intersection.begin();
+          ret_dt = intersection[0];
         }
         if (Trace.isOn("sygus-sui-dt"))
         {
@@ -1533,7 +1534,10 @@ Node SygusUnifIo::constructSol(
   {
     if (!retValMod && !ret_dt.isNull())
     {
-      for (size_t i = 0, nvals = x.d_vals.size(); i < nvals; i++)
+      size_t nvals = x.d_vals.size();
+      std::vector<uint64_t>& bits = d_psolutions[etn][ret_dt];
+      bits.resize((nvals + 63) / 64, 0);
+      for (size_t i = 0; i < nvals; i++)
       {
         if (x.d_vals[i].getConst<bool>())
         {
@@ -1544,7 +1548,7 @@ Node SygusUnifIo::constructSol(
             TermDbSygus::toStreamSygus("sygus-sui-cache", ret_dt);
             Trace("sygus-sui-cache") << std::endl;
           }
-          d_psolutions[i][etn].insert(ret_dt);
+          bits[i / 64] |= uint64_t(1) << (i % 64);
         }
       }
     }
@@ -1582,6 +1586,14 @@ Node SygusUnifIo::constructBestConditional(Node ce,
   {
     eindex.push_back(ecache.d_enum_val_to_index[conds[j]]);
   }
+  // if all conditions have packed values, the active points are packed per
+  // output, and the counts are computed using bit operations
+  bool useBits = nconds > 0;
+  for (unsigned j = 0; j < nconds && useBits; j++)
+  {
+    useBits = !ecache.d_enum_vals_bits[eindex[j]].empty();
+  }
+  std::map<Node, std::vector<uint64_t>> activeBits;
   unsigned activePoints = 0;
   for (unsigned i = 0, npoints = x.d_vals.size(); i < npoints; i++)
   {
@@ -1589,6 +1601,13 @@ Node SygusUnifIo::constructBestConditional(Node ce,
     {
       activePoints++;
       Node eo = d_examples_out[i];
+      if (useBits)
+      {
+        std::vector<uint64_t>& ab = activeBits[eo];
+        ab.resize((npoints + 63) / 64, 0);
+        ab[i / 64] |= uint64_t(1) << (i % 64);
+        continue;
+      }
       for (unsigned j = 0; j < nconds; j++)
       {
         Node resn = ecache.d_enum_vals_res[eindex[j]][i];
@@ -1615,6 +1634,51 @@ Node SygusUnifIo::constructBestConditional(Node ce,
     // where notice this is always between 0 and 1.
     double entropySum = 0.0;
     Trace("sygus-sui-dt-igain") << j << " : ";
+    if (useBits)
+    {
+      const std::vector<uint64_t>& cbits = ecache.d_enum_vals_bits[eindex[j]];
+      // the number of active points on which the condition is true (resp.
+      // false), for each output
+      std::vector<unsigned> counts[2];
+      unsigned ecount[2] = {0, 0};
+      for (std::pair<const Node, std::vector<uint64_t>>& ab : activeBits)
+      {
+        unsigned c[2] = {0, 0};
+        for (size_t w = 0, nwords = cbits.size(); w < nwords; w++)
+        {
+          c[1] += std::bitset<64>(cbits[w] & ab.second[w]).count();
+          c[0] += std::bitset<64>(~cbits[w] & ab.second[w]).count();
+        }
+        for (unsigned b = 0; b < 2; b++)
+        {
+          counts[b].push_back(c[b]);
+          ecount[b] += c[b];
+        }
+      }
+      // the branches are considered in the same order as the map eval above
+      unsigned bfirst = d_true < d_false ? 1 : 0;
+      for (unsigned bb = 0; bb < 2; bb++)
+      {
+        unsigned b = bb == 0 ? bfirst : 1 - bfirst;
+        if (ecount[b] == 0)
+        {
+          continue;
+        }
+        double probBranch = double(ecount[b]) / double(activePoints);
+        Trace("sygus-sui-dt-igain") << (b == 1 ? d_true : d_false) << " -> ( ";
+        for (unsigned c : counts[b])
+        {
+          if (c > 0)
+          {
+            double probVal = double(c) / double(ecount[b]);
+            Trace("sygus-sui-dt-igain") << c << " ";
+            double factor = -probVal * log2(probVal);
+            entropySum += probBranch * factor;
+          }
+        }
+        Trace("sygus-sui-dt-igain") << ") ";
+      }
+    }
     for (std::pair<const Node, std::map<Node, unsigned>>& ej : eval[j])
     {
       unsigned ecount = evalCount[j][ej.first];
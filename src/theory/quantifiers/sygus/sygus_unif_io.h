@@ -17,6 +17,7 @@
 #ifndef CVC4__THEORY__QUANTIFIERS__SYGUS_UNIF_IO_H
 #define CVC4__THEORY__QUANTIFIERS__SYGUS_UNIF_IO_H
 
+#include <cstdint>
 #include <map>
 #include "theory/quantifiers/sygus/sygus_unif.h"
 
@@ -305,14 +306,15 @@ class SygusUnifIo : public SygusUnif
   unsigned d_sol_term_size;
   /** partial solutions
    *
-   * Maps indices for I/O points to a list of solutions for that point, for each
-   * type. We may have more than one type for solutions, e.g. for grammar:
+   * Maps types to their partial solutions, each with the set of indices of
+   * the I/O points it is a solution for, packed into words of 64 bits. We may
+   * have more than one type for solutions, e.g. for grammar:
    *   A -> ite( A, B, C ) | ...
-   * where terms of type B and C can both act as solutions.
+   * where terms of type B and C can both act as solutions. These are kept
+   * across the rounds of solution construction, so that a solution for a set
+   * of points is found as a superset of their bits.
    */
-  std::map<size_t,
-           std::map<TypeNode, std::unordered_set<Node, NodeHashFunction>>>
-      d_psolutions;
+  std::map<TypeNode, std::map<Node, std::vector<uint64_t>>> d_psolutions;
   /**
    * This flag is set to true if the solution construction was
    * non-deterministic with respect to failure/success.
@@ -378,6 +380,13 @@ class SygusUnifIo : public SygusUnif
       */
     std::vector<std::vector<Node>> d_enum_vals_res;
     /**
+    * For each value in d_enum_vals, the set of examples on which it evaluates
+    * to true, packed into words of 64 bits, if all its values in
+    * d_enum_vals_res are Boolean constants, or the empty vector otherwise.
+    * This is used for computing the information gain of conditions.
+    */
+    std::vector<std::vector<uint64_t>> d_enum_vals_bits;
+    /**
     * The set of values in d_enum_vals that have been "subsumed" by others
     * (see SubsumeTrie for explanation of subsumed).
     */
@@ -460,7 +469,10 @@ class SygusUnifIo : public SygusUnif
    *
    * This returns the condition in conds that maximizes information gain with
    * respect to the current active points in d_context. For example, see
-   * Alur et al. TACAS 2017 for an example of information gain.
+   * Alur et al. TACAS 2017 for an example of information gain. If the values
+   * of all conditions are Boolean constants, the number of active points on
+   * which they are true for each output is computed by bit operations on
+   * their packed values (see EnumCache::d_enum_vals_bits).
    */
   Node constructBestConditional(Node ce,
                                 const std::vector<Node>& conds) override;
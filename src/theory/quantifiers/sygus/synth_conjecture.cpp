@@ -14,7 +14,11 @@
  **/
 #include "theory/quantifiers/sygus/synth_conjecture.h"
 
+#include <algorithm>
+#include <unordered_set>
+
 #include "expr/datatype.h"
+#include "expr/node_algorithm.h"
 #include "options/base_options.h"
 #include "options/datatypes_options.h"
 #include "options/quantifiers_options.h"
@@ -173,6 +177,16 @@ void SynthConjecture::assign(Node q)
   {
     d_embedSideCondition = d_embedSideCondition.substitute(
         vars.begin(), vars.end(), d_candidates.begin(), d_candidates.end());
+    std::unordered_set<Node, NodeHashFunction> syms;
+    expr::getSymbols(d_embedSideCondition, syms);
+    for (const Node& s : syms)
+    {
+      if (std::find(d_candidates.begin(), d_candidates.end(), s)
+          == d_candidates.end())
+      {
+        d_sideConditionVars.push_back(s);
+      }
+    }
   }
   Trace("cegqi") << "Base instantiation is :      " << d_base_inst << std::endl;
 
@@ -652,7 +666,7 @@ bool SynthConjecture::doCheck(std::vector<Node>& lems)
   return true;
 }
 
-bool SynthConjecture::checkSideCondition(const std::vector<Node>& cvals) const
+bool SynthConjecture::checkSideCondition(const std::vector<Node>& cvals)
 {
   if (!d_embedSideCondition.isNull())
   {
@@ -660,12 +674,37 @@ bool SynthConjecture::checkSideCondition(const std::vector<Node>& cvals) const
         d_candidates.begin(), d_candidates.end(), cvals.begin(), cvals.end());
     Trace("cegqi-engine") << "Check side condition..." << std::endl;
     Trace("cegqi-debug") << "Check side condition : " << sc << std::endl;
-    Result r = checkWithSubsolver(sc);
+    for (const std::vector<Node>& m : d_sideConditionModels)
+    {
+      Node scm = Rewriter::rewrite(sc.substitute(d_sideConditionVars.begin(),
+                                                 d_sideConditionVars.end(),
+                                                 m.begin(),
+                                                 m.end()));
+      if (scm.isConst() && scm.getConst<bool>())
+      {
+        ++(d_stats.d_sideConditionModelHits);
+        Trace("cegqi-engine") << "...passed side condition in a previous model"
+                              << std::endl;
+        return true;
+      }
+    }
+    ++(d_stats.d_sideConditionChecks);
+    std::vector<Node> mvals;
+    Result r = checkWithSubsolver(sc, d_sideConditionVars, mvals);
     Trace("cegqi-debug") << "...got side condition : " << r << std::endl;
     if (r == Result::UNSAT)
     {
       return false;
     }
+    if (r.asSatisfiabilityResult().isSat() == Result::SAT
+        && mvals.size() == d_sideConditionVars.size())
+    {
+      if (d_sideConditionModels.size() == s_maxSideConditionModels)
+      {
+        d_sideConditionModels.pop_back();
+      }
+      d_sideConditionModels.insert(d_sideConditionModels.begin(), mvals);
+    }
     Trace("cegqi-engine") << "...passed side condition" << std::endl;
   }
   return true;
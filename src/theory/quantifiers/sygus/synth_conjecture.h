@@ -181,8 +181,13 @@ class SynthConjecture
    * This returns false if the solution { d_candidates -> cvals } does not
    * satisfy the side condition of the conjecture maintained by this class,
    * if it exists, and true otherwise.
+   *
+   * The side conditions of the candidates only differ in the candidate, so
+   * the models of the side conditions that a subsolver found satisfiable are
+   * kept, and a candidate whose side condition holds in one of them is
+   * accepted without a subsolver call.
    */
-  bool checkSideCondition(const std::vector<Node>& cvals) const;
+  bool checkSideCondition(const std::vector<Node>& cvals);
 
  private:
   /** reference to quantifier engine */
@@ -325,6 +330,15 @@ class SynthConjecture
    * embedding.
    */
   Node d_embedSideCondition;
+  /** the free symbols of the side condition, except the candidates */
+  std::vector<Node> d_sideConditionVars;
+  /**
+   * The models of the side conditions found satisfiable, as values of
+   * d_sideConditionVars, the most recent first
+   */
+  std::vector<std::vector<Node> > d_sideConditionModels;
+  /** The maximal number of models in d_sideConditionModels */
+  static const size_t s_maxSideConditionModels = 16;
   /** (negated) conjecture after simplification */
   Node d_simp_quant;
   /** (negated) conjecture after simplification, conversion to deep embedding */
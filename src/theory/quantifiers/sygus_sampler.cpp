@@ -167,6 +167,7 @@ void SygusSampler::initializeSygus(TermDbSygus* tds,
 void SygusSampler::initializeSamples(unsigned nsamples)
 {
   d_samples.clear();
+  d_evalCache.clear();
   std::vector<TypeNode> types;
   for (const Node& v : d_vars)
   {
@@ -465,23 +466,44 @@ void SygusSampler::addSamplePoint(std::vector<Node>& pt)
 Node SygusSampler::evaluate(Node n, unsigned index)
 {
   Assert(index < d_samples.size());
+  std::unordered_map<Node, std::vector<Node>, NodeHashFunction>::iterator it =
+      d_evalCache.find(n);
+  if (it == d_evalCache.end())
+  {
+    if (d_evalCache.size() >= s_maxEvalCacheTerms)
+    {
+      d_evalCache.clear();
+    }
+    it = d_evalCache.emplace(n, std::vector<Node>()).first;
+  }
+  std::vector<Node>& evs = it->second;
+  if (index < evs.size() && !evs[index].isNull())
+  {
+    return evs[index];
+  }
+  if (index >= evs.size())
+  {
+    evs.resize(d_samples.size());
+  }
   // do beta-reductions in n first
-  n = Rewriter::rewrite(n);
+  Node nr = Rewriter::rewrite(n);
   // use efficient rewrite for substitution + rewrite
-  Node ev = d_eval.eval(n, d_vars, d_samples[index]);
-  Trace("sygus-sample-ev") << "Evaluate ( " << n << ", " << index << " ) -> ";
+  Node ev = d_eval.eval(nr, d_vars, d_samples[index]);
+  Trace("sygus-sample-ev") << "Evaluate ( " << nr << ", " << index << " ) -> ";
   if (!ev.isNull())
   {
     Trace("sygus-sample-ev") << ev << std::endl;
+    evs[index] = ev;
     return ev;
   }
   Trace("sygus-sample-ev") << "null" << std::endl;
   Trace("sygus-sample-ev") << "Rewrite -> ";
   // substitution + rewrite
   std::vector<Node>& pt = d_samples[index];
-  ev = n.substitute(d_vars.begin(), d_vars.end(), pt.begin(), pt.end());
+  ev = nr.substitute(d_vars.begin(), d_vars.end(), pt.begin(), pt.end());
   ev = Rewriter::rewrite(ev);
   Trace("sygus-sample-ev") << ev << std::endl;
+  evs[index] = ev;
   return ev;
 }
 
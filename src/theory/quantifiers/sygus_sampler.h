@@ -18,6 +18,7 @@
 #define CVC4__THEORY__QUANTIFIERS__SYGUS_SAMPLER_H
 
 #include <map>
+#include <unordered_map>
 #include "theory/evaluator.h"
 #include "theory/quantifiers/lazy_trie.h"
 #include "theory/quantifiers/sygus/term_database_sygus.h"
@@ -113,7 +114,12 @@ class SygusSampler : public LazyTrieEvaluator
                       std::vector<Node>& pt);
   /** Add pt to the set of sample points considered by this sampler */
   void addSamplePoint(std::vector<Node>& pt);
-  /** evaluate n on sample point index */
+  /**
+   * Evaluate n on sample point index. The evaluations are cached, since the
+   * expression miners evaluate the same terms on the same points: the
+   * candidate rewrite database when the term is added to its trie, and again
+   * the query generator and the solution filter.
+   */
   Node evaluate(Node n, unsigned index) override;
   /**
    * Compute the variables from the domain of d_var_index that occur in n,
@@ -181,6 +187,14 @@ class SygusSampler : public LazyTrieEvaluator
   std::vector<std::vector<Node> > d_samples;
   /** evaluator class */
   Evaluator d_eval;
+  /**
+   * The cache of evaluate, the values of each term on the sample points by
+   * index, or null if not computed. It is cleared when it has more than
+   * s_maxEvalCacheTerms terms.
+   */
+  std::unordered_map<Node, std::vector<Node>, NodeHashFunction> d_evalCache;
+  /** The most terms whose evaluations are cached */
+  static const size_t s_maxEvalCacheTerms = 4096;
   /** data structure to check duplication of sample points */
   class PtTrie
   {
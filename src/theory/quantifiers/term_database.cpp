@@ -36,7 +36,10 @@ namespace quantifiers {
 TermDb::TermDb(context::Context* c, context::UserContext* u,
                QuantifiersEngine* qe)
     : d_quantEngine(qe),
-      d_inactive_map(c) {
+      d_inactive_map(c),
+      d_indexCount(0),
+      d_indexStamp(c, 0)
+{
   d_consistent_ee = true;
   d_true = NodeManager::currentNM()->mkConst(true);
   d_false = NodeManager::currentNM()->mkConst(false);
@@ -218,6 +221,10 @@ void TermDb::addTerm(Node n,
         }
         d_op_map[op].push_back(n);
         added.insert(n);
+        if (options::termDbIncremental())
+        {
+          d_dirtyOps.insert(getOperatorRepresentative(op));
+        }
         // If we are higher-order, we may need to register more terms.
         if (options::ufHo())
         {
@@ -265,6 +272,7 @@ void TermDb::computeUfEqcTerms( TNode f ) {
     return;
   }
   d_func_map_eqc_trie[f].clear();
+  notifyIndexBuilt(f, true);
   // get the matchable operators in the equivalence class of f
   std::vector<TNode> ops;
   ops.push_back(f);
@@ -295,6 +303,7 @@ void TermDb::computeUfTerms( TNode f ) {
   }
   Assert(f == getOperatorRepresentative(f));
   d_op_nonred_count[f] = 0;
+  notifyIndexBuilt(f, false);
   // get the matchable operators in the equivalence class of f
   std::vector<TNode> ops;
   ops.push_back(f);
@@ -357,7 +366,8 @@ void TermDb::computeUfTerms( TNode f ) {
       Trace("term-db-debug2") << "...add term returned " << at << std::endl;
       if (at != n && ee->areEqual(at, n))
       {
-        setTermInactive(n);
+        // not setTermInactive, which would invalidate the index of f
+        d_inactive_map[n] = true;
         Trace("term-db-debug") << n << " is redundant." << std::endl;
         congruentCount++;
         continue;
@@ -414,6 +424,8 @@ void TermDb::computeUfTerms( TNode f ) {
           d_quantEngine->addLemma(lem);
           d_quantEngine->setConflict();
           d_consistent_ee = false;
+          // the index of f is incomplete
+          d_dirtyOps.insert(f);
           return;
         }
       }
@@ -897,6 +909,14 @@ bool TermDb::isTermActive( Node n ) {
 
 void TermDb::setTermInactive( Node n ) {
   d_inactive_map[n] = true;
+  if (options::termDbIncremental())
+  {
+    Node op = getMatchOperator(n);
+    if (!op.isNull())
+    {
+      d_dirtyOps.insert(getOperatorRepresentative(op));
+    }
+  }
   //Trace("term-db-debug2") << "set no match attribute" << std::endl;
   //NoMatchAttribute nma;
   //n.setAttribute(nma,true);
@@ -1013,12 +1033,133 @@ void TermDb::presolve() {
   }
 }
 
+void TermDb::eqNotifyMerge(TNode t1, TNode t2)
+{
+  if (options::termDbIncremental())
+  {
+    d_mergedReps.insert(t1);
+    d_mergedReps.insert(t2);
+  }
+}
+
+void TermDb::eqNotifyNewClass(TNode t)
+{
+  if (options::termDbIncremental() && inst::Trigger::isAtomicTrigger(t))
+  {
+    Node op = getMatchOperator(t);
+    if (!op.isNull())
+    {
+      d_dirtyOps.insert(getOperatorRepresentative(op));
+    }
+  }
+}
+
+void TermDb::notifyIndexBuilt(TNode f, bool inEqc)
+{
+  ++d_indexCount;
+  if (options::termDbIncremental())
+  {
+    d_indexStamp = d_indexCount;
+  }
+  d_indexVersion[inEqc ? 1 : 0][f] = d_indexCount;
+}
+
+uint64_t TermDb::getTermArgTrieVersion(Node f, bool inEqc) const
+{
+  if (options::ufHo())
+  {
+    f = getOperatorRepresentative(f);
+  }
+  const std::map<Node, uint64_t>& versions = d_indexVersion[inEqc ? 1 : 0];
+  std::map<Node, uint64_t>::const_iterator it = versions.find(f);
+  return it == versions.end() ? 0 : it->second;
+}
+
+bool TermDb::updateIndices()
+{
+  if (!options::termDbIncremental() || d_indexStamp.get() != d_indexCount
+      || d_quantEngine->usingModelEqualityEngine() || options::ufHo()
+      || options::termDbMode() != options::TermDbMode::ALL
+      || options::lteRestrictInstClosure())
+  {
+    return false;
+  }
+  // the operators with a term whose arguments were merged
+  std::vector<Node> stale;
+  for (const std::pair<const Node, int>& p : d_op_nonred_count)
+  {
+    bool isStale = d_dirtyOps.find(p.first) != d_dirtyOps.end();
+    std::map<Node, std::map<unsigned, std::vector<Node> > >::iterator itr =
+        d_func_map_rel_dom.find(p.first);
+    if (!isStale && itr != d_func_map_rel_dom.end())
+    {
+      for (const std::pair<const unsigned, std::vector<Node> >& dom :
+           itr->second)
+      {
+        for (const Node& r : dom.second)
+        {
+          if (d_mergedReps.find(r) != d_mergedReps.end())
+          {
+            isStale = true;
+            break;
+          }
+        }
+        if (isStale)
+        {
+          break;
+        }
+      }
+    }
+    if (isStale)
+    {
+      stale.push_back(p.first);
+    }
+  }
+  Trace("term-db-inc") << "TermDb: rebuild " << stale.size() << " / "
+                       << d_op_nonred_count.size() << " operator indices"
+                       << std::endl;
+  for (const Node& f : stale)
+  {
+    d_op_nonred_count.erase(f);
+    d_func_map_trie.erase(f);
+    d_func_map_rel_dom.erase(f);
+  }
+  // the equivalence class indices also depend on the classes of the terms
+  std::vector<Node> staleEqc;
+  for (const std::pair<const Node, TNodeTrie>& p : d_func_map_eqc_trie)
+  {
+    bool isStale = d_dirtyOps.find(p.first) != d_dirtyOps.end()
+                   || d_op_nonred_count.find(p.first) == d_op_nonred_count.end();
+    for (std::map<TNode, TNodeTrie>::const_iterator it = p.second.d_data.begin();
+         !isStale && it != p.second.d_data.end();
+         ++it)
+    {
+      isStale = d_mergedReps.find(it->first) != d_mergedReps.end();
+    }
+    if (isStale)
+    {
+      staleEqc.push_back(p.first);
+    }
+  }
+  for (const Node& f : staleEqc)
+  {
+    d_func_map_eqc_trie.erase(f);
+  }
+  return true;
+}
+
 bool TermDb::reset( Theory::Effort effort ){
-  d_op_nonred_count.clear();
+  if (!updateIndices())
+  {
+    d_op_nonred_count.clear();
+    d_func_map_trie.clear();
+    d_func_map_eqc_trie.clear();
+    d_func_map_rel_dom.clear();
+  }
+  d_mergedReps.clear();
+  d_dirtyOps.clear();
+  // the argument representatives are recomputed on demand
   d_arg_reps.clear();
-  d_func_map_trie.clear();
-  d_func_map_eqc_trie.clear();
-  d_func_map_rel_dom.clear();
   d_consistent_ee = true;
 
   eq::EqualityEngine* ee = d_quantEngine->getActiveEqualityEngine();
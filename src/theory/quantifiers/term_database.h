@@ -20,6 +20,7 @@
 #include <map>
 #include <unordered_set>
 
+#include "context/cdo.h"
 #include "expr/attribute.h"
 #include "expr/node_trie.h"
 #include "theory/quantifiers/quant_util.h"
@@ -128,6 +129,15 @@ class TermDb : public QuantifiersUtil {
                std::set<Node>& added,
                bool withinQuant = false,
                bool withinInstClosure = false);
+  /** notify that the equivalence classes of t1 and t2 were merged
+   *
+   * This is called by the quantifiers engine for the merges of the master
+   * equality engine. The indices of the operators with arguments in these
+   * classes are rebuilt at the next call to reset.
+   */
+  void eqNotifyMerge(TNode t1, TNode t2);
+  /** notify that t is a new term of the master equality engine */
+  void eqNotifyNewClass(TNode t);
   /** get match operator for term n
   *
   * If n has a kind that we index, this function will
@@ -156,6 +166,13 @@ class TermDb : public QuantifiersUtil {
   /** get the term arg trie for f-applications in the equivalence class of eqc.
    */
   TNodeTrie* getTermArgTrie(Node eqc, Node f);
+  /**
+   * Returns the version of the term index returned by getTermArgTrie(f), or
+   * by getTermArgTrie(eqc, f) if inEqc is true, which changes each time this
+   * index is rebuilt. This must be called after the index is requested in the
+   * current round.
+   */
+  uint64_t getTermArgTrieVersion(Node f, bool inEqc) const;
   /** get congruent term
   * If possible, returns a term t such that:
   * (1) t is a term that is currently indexed by this database,
@@ -333,6 +350,22 @@ class TermDb : public QuantifiersUtil {
   std::map<Node, TNodeTrie> d_func_map_eqc_trie;
   /** mapping from operators to their representative relevant domains */
   std::map< Node, std::map< unsigned, std::vector< Node > > > d_func_map_rel_dom;
+  /**
+   * The representatives of the classes merged, and the operators with new or
+   * inactive terms, since the last call to reset.
+   */
+  std::unordered_set<Node, NodeHashFunction> d_mergedReps;
+  std::unordered_set<Node, NodeHashFunction> d_dirtyOps;
+  /**
+   * The number of times the indices above were built. The SAT-context
+   * dependent stamp d_indexStamp is equal to it unless the context was popped
+   * below the level of one of the builds, in which case the indices refer to
+   * terms and merges that no longer exist.
+   */
+  uint64_t d_indexCount;
+  context::CDO<uint64_t> d_indexStamp;
+  /** The value of d_indexCount when the indices of each operator were built */
+  std::map<Node, uint64_t> d_indexVersion[2];
   /** has map */
   std::map< Node, bool > d_has_map;
   /** map from reps to a term in eqc in d_has_map */
@@ -368,6 +401,17 @@ class TermDb : public QuantifiersUtil {
   * Ensure that an entry for n is in d_arg_reps
   */
   void computeArgReps(TNode n);
+  /**
+   * Records that the index of f (of the equivalence classes of f if inEqc is
+   * true) was built in the current context.
+   */
+  void notifyIndexBuilt(TNode f, bool inEqc);
+  /**
+   * Removes the indices of the operators that are invalidated by the merges
+   * and the new terms since the last call to reset. Returns false if all
+   * indices must be cleared instead.
+   */
+  bool updateIndices();
   //------------------------------higher-order term indexing
   /**
    * Map from non-variable function terms to the operator used to purify it in
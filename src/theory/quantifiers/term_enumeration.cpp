@@ -14,6 +14,8 @@
 
 #include "theory/quantifiers/term_enumeration.h"
 
+#include <limits>
+
 #include "options/quantifiers_options.h"
 #include "theory/quantifiers/term_util.h"
 #include "theory/rewriter.h"
@@ -24,33 +26,47 @@ namespace CVC4 {
 namespace theory {
 namespace quantifiers {
 
-Node TermEnumeration::getEnumerateTerm(TypeNode tn, unsigned index)
+size_t TermEnumeration::getTypeIndex(TypeNode tn)
 {
-  Trace("term-db-enum") << "Get enumerate term " << tn << " " << index
-                        << std::endl;
   std::unordered_map<TypeNode, size_t, TypeNodeHashFunction>::iterator it =
       d_typ_enum_map.find(tn);
-  size_t teIndex;
-  if (it == d_typ_enum_map.end())
-  {
-    teIndex = d_typ_enum.size();
-    d_typ_enum_map[tn] = teIndex;
-    d_typ_enum.push_back(TypeEnumerator(tn));
-  }
-  else
+  if (it != d_typ_enum_map.end())
   {
-    teIndex = it->second;
+    return it->second;
   }
-  while (index >= d_enum_terms[tn].size())
+  size_t teIndex = d_typ_enum.size();
+  d_typ_enum_map[tn] = teIndex;
+  d_typ_enum.push_back(TypeEnumerator(tn));
+  d_enum_terms.emplace_back();
+  return teIndex;
+}
+
+bool TermEnumeration::enumerateTo(size_t teIndex, size_t index)
+{
+  std::vector<Node>& terms = d_enum_terms[teIndex];
+  TypeEnumerator& te = d_typ_enum[teIndex];
+  while (index >= terms.size())
   {
-    if (d_typ_enum[teIndex].isFinished())
+    if (te.isFinished())
     {
-      return Node::null();
+      return false;
     }
-    d_enum_terms[tn].push_back(*d_typ_enum[teIndex]);
-    ++d_typ_enum[teIndex];
+    terms.push_back(*te);
+    ++te;
   }
-  return d_enum_terms[tn][index];
+  return true;
+}
+
+Node TermEnumeration::getEnumerateTerm(TypeNode tn, unsigned index)
+{
+  Trace("term-db-enum") << "Get enumerate term " << tn << " " << index
+                        << std::endl;
+  size_t teIndex = getTypeIndex(tn);
+  if (!enumerateTo(teIndex, index))
+  {
+    return Node::null();
+  }
+  return d_enum_terms[teIndex][index];
 }
 
 bool TermEnumeration::mayComplete(TypeNode tn)
@@ -93,17 +109,11 @@ bool TermEnumeration::getDomain(TypeNode tn, std::vector<Node>& dom)
   {
     return false;
   }
-  Node curre;
-  unsigned counter = 0;
-  do
-  {
-    curre = getEnumerateTerm(tn, counter);
-    counter++;
-    if (!curre.isNull())
-    {
-      dom.push_back(curre);
-    }
-  } while (!curre.isNull());
+  size_t teIndex = getTypeIndex(tn);
+  // enumerate all the terms, the type is finite
+  enumerateTo(teIndex, std::numeric_limits<size_t>::max() - 1);
+  const std::vector<Node>& terms = d_enum_terms[teIndex];
+  dom.insert(dom.end(), terms.begin(), terms.end());
   return true;
 }
 
@@ -31,7 +31,10 @@ namespace quantifiers {
 /** Term enumeration
  *
  * This class has utilities for enumerating terms. It stores
- * a cache of terms enumerated per each type.
+ * a cache of terms enumerated per each type, so that the i^th term of a type
+ * is only enumerated once, by the first call that asks for it or a later
+ * term.  The modules of the quantifiers engine share its instance (see
+ * QuantifiersEngine::getTermEnumeration).
  * It also has various utility functions regarding type
  * enumeration.
  */
@@ -40,7 +43,10 @@ class TermEnumeration
  public:
   TermEnumeration() {}
   ~TermEnumeration() {}
-  /** get i^th term for type tn */
+  /**
+   * get i^th term for type tn, or null if tn has at most i terms. This takes
+   * constant time for the terms that were already enumerated.
+   */
   Node getEnumerateTerm(TypeNode tn, unsigned i);
   /** may complete type
    *
@@ -65,13 +71,22 @@ class TermEnumeration
   bool getDomain(TypeNode tn, std::vector<Node>& dom);
 
  private:
-  /** ground terms enumerated for types */
-  std::unordered_map<TypeNode, std::vector<Node>, TypeNodeHashFunction>
-      d_enum_terms;
-  /** map from type to the index of its type enumerator in d_typ_enum. */
+  /**
+   * Returns the index of tn in d_typ_enum and d_enum_terms, registering it if
+   * it is new.
+   */
+  size_t getTypeIndex(TypeNode tn);
+  /**
+   * Enumerates the terms of the type at index teIndex until there are more
+   * than index of them, returns false if the type has too few terms.
+   */
+  bool enumerateTo(size_t teIndex, size_t index);
+  /** map from type to its index in d_typ_enum and d_enum_terms */
   std::unordered_map<TypeNode, size_t, TypeNodeHashFunction> d_typ_enum_map;
   /** type enumerators */
   std::vector<TypeEnumerator> d_typ_enum;
+  /** ground terms enumerated for types, in the order of enumeration */
+  std::vector<std::vector<Node> > d_enum_terms;
   /** closed enumerable type cache */
   std::unordered_map<TypeNode, bool, TypeNodeHashFunction> d_typ_closed_enum;
   /** may complete */
@@ -26,12 +26,14 @@
 #include "theory/quantifiers/fmf/model_engine.h"
 #include "theory/quantifiers/inst_strategy_enumerative.h"
 #include "theory/quantifiers/quant_conflict_find.h"
+#include "theory/quantifiers/quant_ranking.h"
 #include "theory/quantifiers/quant_split.h"
 #include "theory/quantifiers/quantifiers_rewriter.h"
 #include "theory/quantifiers/sygus/synth_engine.h"
 #include "theory/sep/theory_sep.h"
 #include "theory/theory_engine.h"
 #include "theory/uf/equality_engine.h"
+#include "util/phase_profiler.h"
 
 using namespace std;
 using namespace CVC4::kind;
@@ -168,6 +170,7 @@ QuantifiersEngine::QuantifiersEngine(context::Context* c,
     : d_te(te),
       d_eq_query(new quantifiers::EqualityQueryQuantifiersEngine(c, this)),
       d_tr_trie(new inst::TriggerTrie),
+      d_match_code_tree(nullptr),
       d_model(nullptr),
       d_builder(nullptr),
       d_qepr(nullptr),
@@ -210,6 +213,18 @@ QuantifiersEngine::QuantifiersEngine(context::Context* c,
 
   d_util.push_back(d_instantiate.get());
 
+  if (options::ematchCodeTree())
+  {
+    d_match_code_tree.reset(new inst::MatchCodeTree(this, u));
+    d_util.push_back(d_match_code_tree.get());
+  }
+
+  if (options::quantRankTopK() > 0)
+  {
+    d_quant_rank.reset(new quantifiers::QuantRanking(this));
+    d_util.push_back(d_quant_rank.get());
+  }
+
   d_curr_effort_level = QuantifiersModule::QEFFORT_NONE;
   d_conflict = false;
   d_hasAddedLemma = false;
@@ -343,6 +358,16 @@ inst::TriggerTrie* QuantifiersEngine::getTriggerDatabase() const
   return d_tr_trie.get();
 }
 
+inst::MatchCodeTree* QuantifiersEngine::getMatchCodeTree() const
+{
+  return d_match_code_tree.get();
+}
+
+quantifiers::QuantRanking* QuantifiersEngine::getQuantRanking() const
+{
+  return d_quant_rank.get();
+}
+
 QuantifiersModule * QuantifiersEngine::getOwner( Node q ) {
   std::map< Node, QuantifiersModule * >::iterator it = d_owner.find( q );
   if( it==d_owner.end() ){
@@ -455,6 +480,10 @@ void QuantifiersEngine::presolve() {
     d_modules[i]->presolve();
   }
   d_term_db->presolve();
+  if (d_private->d_rel_dom)
+  {
+    d_private->d_rel_dom->presolve();
+  }
   d_presolve = false;
   //add all terms to database
   if( options::incrementalSolving() ){
@@ -488,7 +517,10 @@ void QuantifiersEngine::ppNotifyAssertions(
     // FIXME (as part of project 3) : cleanup
     sep::TheorySep* theory_sep =
         static_cast<sep::TheorySep*>(getTheoryEngine()->theoryOf(THEORY_SEP));
-    theory_sep->initializeBounds();
+    if (theory_sep != nullptr)
+    {
+      theory_sep->initializeBounds();
+    }
     d_qepr->finishInit();
   }
   if (options::sygus())
@@ -637,6 +669,10 @@ void QuantifiersEngine::check( Theory::Effort e ){
     //reset the model
     Trace("quant-engine-debug") << "Reset model..." << std::endl;
     d_model->reset_round();
+    if (d_quant_rank)
+    {
+      d_quant_rank->activate(e);
+    }
 
     //reset the modules
     Trace("quant-engine-debug") << "Resetting all modules..." << std::endl;
@@ -693,6 +729,7 @@ void QuantifiersEngine::check( Theory::Effort e ){
           Trace("quant-engine-debug") << "Check " << mdl->identify().c_str()
                                       << " at effort " << quant_e << "..."
                                       << std::endl;
+          PhaseScope phase("quant:" + mdl->identify());
           mdl->check(e, quant_e);
           if( d_conflict ){
             Trace("quant-engine-debug") << "...conflict!" << std::endl;
@@ -791,6 +828,10 @@ void QuantifiersEngine::check( Theory::Effort e ){
       }
     }
     d_curr_effort_level = QuantifiersModule::QEFFORT_NONE;
+    if (d_quant_rank)
+    {
+      d_quant_rank->finishRound(d_hasAddedLemma);
+    }
     Trace("quant-engine-debug") << "Done check modules that needed check." << std::endl;
     if( d_hasAddedLemma ){
       d_instantiate->debugPrint();
@@ -991,6 +1032,12 @@ void QuantifiersEngine::addTermToDatabase( Node n, bool withinQuant, bool within
 
 void QuantifiersEngine::eqNotifyNewClass(TNode t) {
   addTermToDatabase( t );
+  d_term_db->eqNotifyNewClass(t);
+}
+
+void QuantifiersEngine::eqNotifyPostMerge(TNode t1, TNode t2)
+{
+  d_term_db->eqNotifyMerge(t1, t2);
 }
 
 bool QuantifiersEngine::addLemma( Node lem, bool doCache, bool doRewrite ){
@@ -1107,11 +1154,29 @@ void QuantifiersEngine::flushLemmas(){
   if( !d_lemmas_waiting.empty() ){
     //take default output channel if none is provided
     d_hasAddedLemma = true;
-    for( unsigned i=0; i<d_lemmas_waiting.size(); i++ ){
+    size_t nsend = d_lemmas_waiting.size();
+    unsigned cap = options::instLemmaCap();
+    if (cap > 0 && nsend > cap)
+    {
+      // send the lemmas with the fewest disjuncts first, which are the most
+      // likely to propagate, the others wait for the next call to check
+      std::stable_sort(d_lemmas_waiting.begin(),
+                       d_lemmas_waiting.end(),
+                       [](const Node& a, const Node& b) {
+                         size_t na = a.getKind() == OR ? a.getNumChildren() : 1;
+                         size_t nb = b.getKind() == OR ? b.getNumChildren() : 1;
+                         return na < nb;
+                       });
+      d_statistics.d_lemmas_deferred += nsend - cap;
+      nsend = cap;
+    }
+    for (size_t i = 0; i < nsend; i++)
+    {
       Trace("qe-lemma") << "Lemma : " << d_lemmas_waiting[i] << std::endl;
       getOutputChannel().lemma( d_lemmas_waiting[i], false, true );
     }
-    d_lemmas_waiting.clear();
+    d_lemmas_waiting.erase(d_lemmas_waiting.begin(),
+                           d_lemmas_waiting.begin() + nsend);
   }
   if( !d_phase_req_waiting.empty() ){
     for( std::map< Node, bool >::iterator it = d_phase_req_waiting.begin(); it != d_phase_req_waiting.end(); ++it ){
@@ -1208,7 +1273,8 @@ QuantifiersEngine::Statistics::Statistics()
       d_instantiations_fmf_exh("QuantifiersEngine::Instantiations_Fmf_Exh", 0),
       d_instantiations_fmf_mbqi("QuantifiersEngine::Instantiations_Fmf_Mbqi", 0),
       d_instantiations_cbqi("QuantifiersEngine::Instantiations_Cbqi", 0),
-      d_instantiations_rr("QuantifiersEngine::Instantiations_Rewrite_Rules", 0)
+      d_instantiations_rr("QuantifiersEngine::Instantiations_Rewrite_Rules", 0),
+      d_lemmas_deferred("QuantifiersEngine::Lemmas_Deferred", 0)
 {
   smtStatisticsRegistry()->registerStat(&d_time);
   smtStatisticsRegistry()->registerStat(&d_qcf_time);
@@ -1230,6 +1296,7 @@ QuantifiersEngine::Statistics::Statistics()
   smtStatisticsRegistry()->registerStat(&d_instantiations_fmf_mbqi);
   smtStatisticsRegistry()->registerStat(&d_instantiations_cbqi);
   smtStatisticsRegistry()->registerStat(&d_instantiations_rr);
+  smtStatisticsRegistry()->registerStat(&d_lemmas_deferred);
 }
 
 QuantifiersEngine::Statistics::~Statistics(){
@@ -1253,6 +1320,7 @@ QuantifiersEngine::Statistics::~Statistics(){
   smtStatisticsRegistry()->unregisterStat(&d_instantiations_fmf_mbqi);
   smtStatisticsRegistry()->unregisterStat(&d_instantiations_cbqi);
   smtStatisticsRegistry()->unregisterStat(&d_instantiations_rr);
+  smtStatisticsRegistry()->unregisterStat(&d_lemmas_deferred);
 }
 
 eq::EqualityEngine* QuantifiersEngine::getMasterEqualityEngine() const
@@ -24,6 +24,7 @@
 #include "context/cdlist.h"
 #include "expr/attribute.h"
 #include "expr/term_canonize.h"
+#include "theory/quantifiers/ematching/match_code_tree.h"
 #include "theory/quantifiers/ematching/trigger.h"
 #include "theory/quantifiers/equality_query.h"
 #include "theory/quantifiers/first_order_model.h"
@@ -47,6 +48,10 @@ namespace theory {
 
 class QuantifiersEnginePrivate;
 
+namespace quantifiers {
+class QuantRanking;
+}
+
 // TODO: organize this more/review this, github issue #1163
 class QuantifiersEngine {
   typedef context::CDHashMap< Node, bool, NodeHashFunction > BoolMap;
@@ -100,8 +105,12 @@ public:
   quantifiers::Skolemize* getSkolemize() const;
   /** get term enumeration utility */
   quantifiers::TermEnumeration* getTermEnumeration() const;
+  /** get the ranking of quantified formulas, if --quant-rank-top-k */
+  quantifiers::QuantRanking* getQuantRanking() const;
   /** get trigger database */
   inst::TriggerTrie* getTriggerDatabase() const;
+  /** get the code tree for simple triggers, if --ematch-code-tree */
+  inst::MatchCodeTree* getMatchCodeTree() const;
   //---------------------- end utilities
  private:
   /**
@@ -189,7 +198,12 @@ private:
  void registerQuantifierInternal(Node q);
  /** reduceQuantifier, return true if reduced */
  bool reduceQuantifier(Node q);
- /** flush lemmas */
+ /** flush lemmas
+  *
+  * This sends the lemmas waiting to the output channel. If --inst-lemma-cap
+  * is N > 0, it sends at most N of them, those with the fewest disjuncts,
+  * and the others remain waiting.
+  */
  void flushLemmas();
 
 public:
@@ -228,6 +242,7 @@ public:
   void addTermToDatabase( Node n, bool withinQuant = false, bool withinInstClosure = false );
   /** notification when master equality engine is updated */
   void eqNotifyNewClass(TNode t);
+  void eqNotifyPostMerge(TNode t1, TNode t2);
   /** use model equality engine */
   bool usingModelEqualityEngine() const { return d_useModelEe; }
   /** debug print equality engine */
@@ -312,6 +327,7 @@ public:
     IntStat d_instantiations_fmf_mbqi;
     IntStat d_instantiations_cbqi;
     IntStat d_instantiations_rr;
+    IntStat d_lemmas_deferred;
     Statistics();
     ~Statistics();
   };/* class QuantifiersEngine::Statistics */
@@ -329,6 +345,8 @@ public:
   std::unique_ptr<quantifiers::EqualityQueryQuantifiersEngine> d_eq_query;
   /** all triggers will be stored in this trie */
   std::unique_ptr<inst::TriggerTrie> d_tr_trie;
+  /** code tree for the simple triggers of all quantified formulas */
+  std::unique_ptr<inst::MatchCodeTree> d_match_code_tree;
   /** extended model object */
   std::unique_ptr<quantifiers::FirstOrderModel> d_model;
   /** model builder */
@@ -351,6 +369,8 @@ public:
   std::unique_ptr<quantifiers::Skolemize> d_skolemize;
   /** term enumeration utility */
   std::unique_ptr<quantifiers::TermEnumeration> d_term_enum;
+  /** ranking of quantified formulas */
+  std::unique_ptr<quantifiers::QuantRanking> d_quant_rank;
   //------------- end quantifiers utilities
   /**
    * The private utility, which contains all of the quantifiers modules.
@@ -15,7 +15,6 @@
 #include <unordered_set>
 
 #include "theory/rep_set.h"
-#include "theory/type_enumerator.h"
 
 using namespace std;
 using namespace CVC4::kind;
@@ -110,7 +109,8 @@ int RepSet::getIndexFor( Node n ) const {
   }
 }
 
-bool RepSet::complete( TypeNode t ){
+bool RepSet::complete(TypeNode t, const std::vector<Node>& dom)
+{
   std::map< TypeNode, bool >::iterator it = d_type_complete.find( t );
   if( it==d_type_complete.end() ){
     //remove all previous
@@ -120,13 +120,13 @@ bool RepSet::complete( TypeNode t ){
     d_type_reps[t].clear();
     //now complete the type
     d_type_complete[t] = true;
-    TypeEnumerator te(t);
-    while( !te.isFinished() ){
-      Node n = *te;
-      if( std::find( d_type_reps[t].begin(), d_type_reps[t].end(), n )==d_type_reps[t].end() ){
-        add( t, n );
+    std::unordered_set<Node, NodeHashFunction> added;
+    for (const Node& n : dom)
+    {
+      if (added.insert(n).second)
+      {
+        add(t, n);
       }
-      ++te;
     }
     for( size_t i=0; i<d_type_reps[t].size(); i++ ){
       Trace("reps-complete") << d_type_reps[t][i] << " ";
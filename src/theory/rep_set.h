@@ -85,11 +85,12 @@ class RepSet {
   /** returns index in d_type_reps for node n */
   int getIndexFor( Node n ) const;
   /** complete the list for type t
-   * Resets d_type_reps[tn] and repopulates by running the type enumerator for
-   * that type exhaustively.
+   * Resets d_type_reps[tn] and repopulates it with the values dom of that
+   * type, which the caller enumerated exhaustively (e.g. by
+   * TermEnumeration::getDomain).
    * This should only be called for small finite interpreted types.
    */
-  bool complete( TypeNode t );
+  bool complete(TypeNode t, const std::vector<Node>& dom);
   /** get term for representative
    * Returns a term that is interpreted as representative n in the current
    * model, null otherwise.
@@ -0,0 +1,133 @@
+/*********************                                                        */
+/*! \file rewrite_cache.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A bounded cache for the results of the rewriter
+ **/
+
+#include "theory/rewrite_cache.h"
+
+#include "smt/smt_statistics_registry.h"
+
+namespace CVC4 {
+namespace theory {
+
+RewriteCache::RewriteCache(size_t budget)
+    : d_budget(budget),
+      d_hits("theory::rewriter::cacheHits", 0),
+      d_misses("theory::rewriter::cacheMisses", 0),
+      d_evictions("theory::rewriter::cacheEvictions", 0)
+{
+  Assert(budget > 0);
+  smtStatisticsRegistry()->registerStat(&d_hits);
+  smtStatisticsRegistry()->registerStat(&d_misses);
+  smtStatisticsRegistry()->registerStat(&d_evictions);
+}
+
+RewriteCache::~RewriteCache()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_hits);
+  smtStatisticsRegistry()->unregisterStat(&d_misses);
+  smtStatisticsRegistry()->unregisterStat(&d_evictions);
+}
+
+RewriteCache::Entry* RewriteCache::lookup(TheoryId theoryId, TNode node)
+{
+  EntryMap& entries = d_caches[theoryId].d_entries;
+  EntryMap::iterator it = entries.find(node);
+  return it == entries.end() ? nullptr : &it->second;
+}
+
+RewriteCache::Entry& RewriteCache::getOrInsert(TheoryId theoryId, TNode node)
+{
+  TheoryCache& tc = d_caches[theoryId];
+  EntryMap::iterator it = tc.d_entries.find(node);
+  if (it != tc.d_entries.end())
+  {
+    return it->second;
+  }
+  if (tc.d_clock.size() < d_budget)
+  {
+    it = tc.d_entries.insert(std::make_pair(Node(node), Entry())).first;
+    tc.d_clock.push_back(&*it);
+    return it->second;
+  }
+  // Advance the hand to the first entry that was not used since the hand
+  // last passed it, giving a second chance to the ones that were.  This
+  // terminates after at most one round.
+  while (tc.d_clock[tc.d_hand]->second.d_referenced)
+  {
+    tc.d_clock[tc.d_hand]->second.d_referenced = false;
+    tc.d_hand = (tc.d_hand + 1) % tc.d_clock.size();
+  }
+  Trace("rewriter-cache") << "evicting " << tc.d_clock[tc.d_hand]->first
+                          << " from the cache of " << theoryId << std::endl;
+  tc.d_entries.erase(tc.d_entries.find(tc.d_clock[tc.d_hand]->first));
+  ++d_evictions;
+  it = tc.d_entries.insert(std::make_pair(Node(node), Entry())).first;
+  tc.d_clock[tc.d_hand] = &*it;
+  tc.d_hand = (tc.d_hand + 1) % tc.d_clock.size();
+  return it->second;
+}
+
+Node RewriteCache::getPreRewrite(TheoryId theoryId, TNode node)
+{
+  Entry* e = lookup(theoryId, node);
+  if (e == nullptr || e->d_pre.isNull())
+  {
+    ++d_misses;
+    return Node::null();
+  }
+  ++d_hits;
+  e->d_referenced = true;
+  return e->d_pre;
+}
+
+Node RewriteCache::getPostRewrite(TheoryId theoryId, TNode node)
+{
+  Entry* e = lookup(theoryId, node);
+  if (e == nullptr || e->d_post.isNull())
+  {
+    ++d_misses;
+    return Node::null();
+  }
+  ++d_hits;
+  e->d_referenced = true;
+  return e->d_post;
+}
+
+void RewriteCache::setPreRewrite(TheoryId theoryId, TNode node, TNode cache)
+{
+  Assert(!cache.isNull());
+  Trace("rewriter") << "setting pre-rewrite of " << node << " to " << cache
+                    << std::endl;
+  getOrInsert(theoryId, node).d_pre = cache;
+}
+
+void RewriteCache::setPostRewrite(TheoryId theoryId, TNode node, TNode cache)
+{
+  Assert(!cache.isNull());
+  Trace("rewriter") << "setting rewrite of " << node << " to " << cache
+                    << std::endl;
+  getOrInsert(theoryId, node).d_post = cache;
+}
+
+void RewriteCache::clear()
+{
+  for (TheoryCache& tc : d_caches)
+  {
+    tc.d_clock.clear();
+    tc.d_entries.clear();
+    tc.d_hand = 0;
+  }
+}
+
+}  // namespace theory
+}  // namespace CVC4
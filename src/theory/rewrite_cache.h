@@ -0,0 +1,100 @@
+/*********************                                                        */
+/*! \file rewrite_cache.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A bounded cache for the results of the rewriter
+ **
+ ** A bounded cache for the results of the rewriter, used instead of the
+ ** rewrite cache attributes with --rewrite-cache-budget=N.  Each theory has
+ ** its own table of at most N terms; when a table is full, a cold entry is
+ ** evicted using the CLOCK (second chance) approximation of LRU.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__REWRITE_CACHE_H
+#define CVC4__THEORY__REWRITE_CACHE_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "theory/theory_id.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace theory {
+
+class RewriteCache
+{
+ public:
+  /** Create a cache holding at most budget terms per theory. */
+  RewriteCache(size_t budget);
+  ~RewriteCache();
+
+  /** Get the pre-rewrite of node, or null if it is not cached. */
+  Node getPreRewrite(TheoryId theoryId, TNode node);
+  /** Get the post-rewrite of node, or null if it is not cached. */
+  Node getPostRewrite(TheoryId theoryId, TNode node);
+  /** Cache that the pre-rewrite of node is cache. */
+  void setPreRewrite(TheoryId theoryId, TNode node, TNode cache);
+  /** Cache that the post-rewrite of node is cache. */
+  void setPostRewrite(TheoryId theoryId, TNode node, TNode cache);
+
+  /** Remove all entries. */
+  void clear();
+
+ private:
+  /** The cached rewrites of a term. */
+  struct Entry
+  {
+    Entry() : d_referenced(false) {}
+    /** The pre-rewrite of the term, if cached. */
+    Node d_pre;
+    /** The post-rewrite of the term, if cached. */
+    Node d_post;
+    /** Was the entry used since the clock hand last passed it? */
+    bool d_referenced;
+  };
+  typedef std::unordered_map<Node, Entry, NodeHashFunction> EntryMap;
+
+  /** The cache of a theory. */
+  struct TheoryCache
+  {
+    TheoryCache() : d_hand(0) {}
+    EntryMap d_entries;
+    /**
+     * The clock, i.e. the entries in a circular order.  The elements of an
+     * unordered_map do not move on rehashing, so these pointers stay valid
+     * until the entry is erased.
+     */
+    std::vector<EntryMap::value_type*> d_clock;
+    /** The position of the clock hand in d_clock. */
+    size_t d_hand;
+  };
+
+  /** Look up node in the cache of theoryId, or return null. */
+  Entry* lookup(TheoryId theoryId, TNode node);
+  /** Get the entry of node in the cache of theoryId, making room for it. */
+  Entry& getOrInsert(TheoryId theoryId, TNode node);
+
+  /** The maximal number of entries per theory. */
+  size_t d_budget;
+  TheoryCache d_caches[THEORY_LAST];
+
+  IntStat d_hits;
+  IntStat d_misses;
+  IntStat d_evictions;
+}; /* class RewriteCache */
+
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__REWRITE_CACHE_H */
@@ -18,8 +18,10 @@
 #include "theory/rewriter.h"
 
 #include "options/theory_options.h"
+#include "smt/smt_engine.h"
 #include "smt/smt_engine_scope.h"
 #include "smt/smt_statistics_registry.h"
+#include "theory/rewrite_cache.h"
 #include "theory/rewriter_tables.h"
 #include "theory/theory.h"
 #include "util/resource_manager.h"
@@ -93,7 +95,20 @@ Node Rewriter::rewrite(TNode node) {
     // eagerly for the sake of efficiency here.
     return node;
   }
-  return getInstance().rewriteTo(theoryOf(node), node);
+  if (node.isRewritten())
+  {
+    // The node is known to be in rewritten form, which saves the cache
+    // lookup of rewriteTo.
+    return node;
+  }
+  Node ret = getInstance().rewriteTo(theoryOf(node), node);
+  if (ret == node)
+  {
+    // Only nodes that are their own rewritten form are marked, so that the
+    // flag does not rely on the theory rewriters being idempotent.
+    ret.setRewritten();
+  }
+  return ret;
 }
 
 void Rewriter::registerPreRewrite(
@@ -143,8 +158,17 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId, Node node) {
 
   Trace("rewriter") << "Rewriter::rewriteTo(" << theoryId << "," << node << ")"<< std::endl;
 
+  ResourceManager* rm = NULL;
+  // the bounded cache of the SmtEngine, if it has one
+  RewriteCache* rc = nullptr;
+  bool hasSmtEngine = smt::smtEngineInScope();
+  if (hasSmtEngine) {
+    rm = NodeManager::currentResourceManager();
+    rc = smt::currentSmtEngine()->getRewriteCache();
+  }
+
   // Check if it's been cached already
-  Node cached = getPostRewriteCache(theoryId, node);
+  Node cached = getPostRewriteCache(rc, theoryId, node);
   if (!cached.isNull()) {
     return cached;
   }
@@ -153,11 +177,6 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId, Node node) {
   vector<RewriteStackElement> rewriteStack;
   rewriteStack.push_back(RewriteStackElement(node, theoryId));
 
-  ResourceManager* rm = NULL;
-  bool hasSmtEngine = smt::smtEngineInScope();
-  if (hasSmtEngine) {
-    rm = NodeManager::currentResourceManager();
-  }
   // Rewrite until the stack is empty
   for (;;){
 
@@ -178,7 +197,8 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId, Node node) {
     if (rewriteStackTop.d_nextChild == 0)
     {
       // Check if the pre-rewrite has already been done (it's in the cache)
-      cached = getPreRewriteCache(rewriteStackTop.getTheoryId(),
+      cached = getPreRewriteCache(rc,
+                                  rewriteStackTop.getTheoryId(),
                                   rewriteStackTop.d_node);
       if (cached.isNull()) {
         // Rewrite until fix-point is reached
@@ -198,7 +218,8 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId, Node node) {
           rewriteStackTop.d_theoryId = newTheory;
         }
         // Cache the rewrite
-        setPreRewriteCache(rewriteStackTop.getOriginalTheoryId(),
+        setPreRewriteCache(rc,
+                           rewriteStackTop.getOriginalTheoryId(),
                            rewriteStackTop.d_original,
                            rewriteStackTop.d_node);
       }
@@ -212,7 +233,8 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId, Node node) {
 
     rewriteStackTop.d_original = rewriteStackTop.d_node;
     // Now it's time to rewrite the children, check if this has already been done
-    cached = getPostRewriteCache(rewriteStackTop.getTheoryId(),
+    cached = getPostRewriteCache(rc,
+                                 rewriteStackTop.getTheoryId(),
                                  rewriteStackTop.d_node);
     // If not, go through the children
     if(cached.isNull()) {
@@ -296,7 +318,8 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId, Node node) {
         rewriteStackTop.d_node = response.d_node;
       }
       // We're done with the post rewrite, so we add to the cache
-      setPostRewriteCache(rewriteStackTop.getOriginalTheoryId(),
+      setPostRewriteCache(rc,
+                          rewriteStackTop.getOriginalTheoryId(),
                           rewriteStackTop.d_original,
                           rewriteStackTop.d_node);
     } else {
@@ -344,14 +367,90 @@ RewriteResponse Rewriter::postRewrite(theory::TheoryId theoryId, TNode n)
   return fn(&d_re, n);
 }
 
-void Rewriter::clearCaches() {
+Node Rewriter::getPreRewriteCache(RewriteCache* rc,
+                                  theory::TheoryId theoryId,
+                                  TNode node)
+{
+  Node cached = rc == nullptr ? getPreRewriteCache(theoryId, node)
+                              : rc->getPreRewrite(theoryId, node);
+  ++d_cacheLookups;
+  if (!cached.isNull())
+  {
+    ++d_cacheHits;
+  }
+  return cached;
+}
+
+Node Rewriter::getPostRewriteCache(RewriteCache* rc,
+                                   theory::TheoryId theoryId,
+                                   TNode node)
+{
+  Node cached = rc == nullptr ? getPostRewriteCache(theoryId, node)
+                              : rc->getPostRewrite(theoryId, node);
+  ++d_cacheLookups;
+  if (!cached.isNull())
+  {
+    ++d_cacheHits;
+  }
+  return cached;
+}
+
+void Rewriter::setPreRewriteCache(RewriteCache* rc,
+                                  theory::TheoryId theoryId,
+                                  TNode node,
+                                  TNode cache)
+{
+  if (rc == nullptr)
+  {
+    setPreRewriteCache(theoryId, node, cache);
+  }
+  else
+  {
+    rc->setPreRewrite(theoryId, node, cache);
+  }
+}
+
+void Rewriter::setPostRewriteCache(RewriteCache* rc,
+                                   theory::TheoryId theoryId,
+                                   TNode node,
+                                   TNode cache)
+{
+  if (rc == nullptr)
+  {
+    setPostRewriteCache(theoryId, node, cache);
+  }
+  else
+  {
+    rc->setPostRewrite(theoryId, node, cache);
+  }
+}
+
+void Rewriter::getCacheCounts(uint64_t& lookups, uint64_t& hits)
+{
   Rewriter& rewriter = getInstance();
+  lookups = rewriter.d_cacheLookups;
+  hits = rewriter.d_cacheHits;
+}
 
+void Rewriter::clearCaches() {
 #ifdef CVC4_ASSERTIONS
-  rewriter.d_rewriteStack.reset(nullptr);
+  getInstance().d_rewriteStack.reset(nullptr);
 #endif
 
-  rewriter.clearCachesInternal();
+  shedCaches();
+}
+
+void Rewriter::shedCaches()
+{
+  getInstance().clearCachesInternal();
+  if (smt::smtEngineInScope())
+  {
+    RewriteCache* rc = smt::currentSmtEngine()->getRewriteCache();
+    if (rc != nullptr)
+    {
+      rc->clear();
+    }
+  }
 }
 
 }/* CVC4::theory namespace */
@@ -26,6 +26,7 @@ namespace CVC4 {
 namespace theory {
 
 class RewriterInitializer;
+class RewriteCache;
 
 /**
  * The rewrite environment holds everything that the individual rewrites have
@@ -62,6 +63,20 @@ class Rewriter {
    */
   static void clearCaches();
 
+  /**
+   * Garbage collects the rewrite caches. Unlike clearCaches, this may be
+   * called while a rewrite is in progress, which is the case when the memory
+   * limit is exceeded.
+   */
+  static void shedCaches();
+
+  /**
+   * Get the number of lookups in the rewrite caches, and how many of them
+   * found a cached rewrite, since the rewriter was created. These are used
+   * to compute the hit rate of the caches over a span of time.
+   */
+  static void getCacheCounts(uint64_t& lookups, uint64_t& hits);
+
   /**
    * Register a prerewrite for a given kind.
    *
@@ -120,6 +135,34 @@ class Rewriter {
   /** Sets the appropriate cache for a node */
   void setPostRewriteCache(theory::TheoryId theoryId, TNode node, TNode cache);
 
+  /**
+   * Returns the pre-rewrite of node cached in rc, or in the attributes if rc
+   * is null.
+   */
+  Node getPreRewriteCache(RewriteCache* rc,
+                          theory::TheoryId theoryId,
+                          TNode node);
+
+  /**
+   * Returns the post-rewrite of node cached in rc, or in the attributes if
+   * rc is null.
+   */
+  Node getPostRewriteCache(RewriteCache* rc,
+                           theory::TheoryId theoryId,
+                           TNode node);
+
+  /** Sets the pre-rewrite of node in rc, or in the attributes if rc is null */
+  void setPreRewriteCache(RewriteCache* rc,
+                          theory::TheoryId theoryId,
+                          TNode node,
+                          TNode cache);
+
+  /** Sets the post-rewrite of node in rc, or in the attributes if rc is null */
+  void setPostRewriteCache(RewriteCache* rc,
+                           theory::TheoryId theoryId,
+                           TNode node,
+                           TNode cache);
+
   /**
    * Rewrites the node using the given theory rewriter.
    */
@@ -143,6 +186,11 @@ class Rewriter {
 
   unsigned long d_iterationCount = 0;
 
+  /** The number of lookups in the rewrite caches */
+  uint64_t d_cacheLookups = 0;
+  /** The number of lookups that found a cached rewrite */
+  uint64_t d_cacheHits = 0;
+
   /** Rewriter table for prewrites. Maps kinds to rewriter function. */
   std::function<RewriteResponse(RewriteEnvironment*, TNode)>
       d_preRewriters[kind::LAST_KIND];
@@ -26,6 +26,23 @@ namespace theory {
 template <bool pre, theory::TheoryId theoryId>
 struct RewriteCacheTag {};
 
+}/* CVC4::theory namespace */
+
+namespace expr {
+namespace attr {
+
+/** The rewrite caches are stored densely. */
+template <bool pre, theory::TheoryId theoryId>
+struct IsDenseAttribute<theory::RewriteCacheTag<pre, theoryId> >
+    : std::true_type
+{
+};
+
+}/* CVC4::expr::attr namespace */
+}/* CVC4::expr namespace */
+
+namespace theory {
+
 template <theory::TheoryId theoryId>
 struct RewriteAttibute {
 
@@ -514,6 +514,7 @@ void TheorySep::check(Effort e) {
   if( e == EFFORT_LAST_CALL && !d_conflict && !d_valuation.needCheck() ){
     Trace("sep-process") << "Checking heap at full effort..." << std::endl;
     d_label_model.clear();
+    d_loc_model_id.clear();
     d_tmodel.clear();
     d_pto_model.clear();
     Trace("sep-process") << "---Locations---" << std::endl;
@@ -1409,7 +1410,7 @@ Node TheorySep::instantiateLabel( Node n, Node o_lbl, Node lbl, Node lbl_v, std:
       Assert(d_label_model.find(o_lbl) != d_label_model.end());
       Node vr = d_valuation.getModel()->getRepresentative( n[0] );
       Node svr = NodeManager::currentNM()->mkNode( kind::SINGLETON, vr );
-      bool inBaseHeap = std::find( d_label_model[o_lbl].d_heap_locs_model.begin(), d_label_model[o_lbl].d_heap_locs_model.end(), svr )!=d_label_model[o_lbl].d_heap_locs_model.end();
+      bool inBaseHeap = d_label_model[o_lbl].hasLocation( getLocationModelId( svr ) );
       Trace("sep-inst-debug") << "Is in base (non-instantiating) heap : " << inBaseHeap << " for value ref " << vr << " in " << o_lbl << std::endl;
       std::vector< Node > children;
       if( inBaseHeap ){
@@ -1521,6 +1522,12 @@ void TheorySep::computeLabelModel( Node lbl ) {
     for( unsigned j=0; j<d_label_model[lbl].d_heap_locs_model.size(); j++ ){
       Node u = d_label_model[lbl].d_heap_locs_model[j];
       Assert(u.getKind() == kind::SINGLETON);
+      unsigned id = getLocationModelId( u );
+      std::vector< bool >& bits = d_label_model[lbl].d_heap_locs_bits;
+      if( id>=bits.size() ){
+        bits.resize( id+1, false );
+      }
+      bits[id] = true;
       u = u[0];
       Node tt;
       std::map< Node, Node >::iterator itm = d_tmodel.find( u );
@@ -1544,6 +1551,16 @@ void TheorySep::computeLabelModel( Node lbl ) {
   }
 }
 
+unsigned TheorySep::getLocationModelId( Node sv ) {
+  std::map< Node, unsigned >::iterator it = d_loc_model_id.find( sv );
+  if( it!=d_loc_model_id.end() ){
+    return it->second;
+  }
+  unsigned id = d_loc_model_id.size();
+  d_loc_model_id[sv] = id;
+  return id;
+}
+
 Node TheorySep::getRepresentative( Node t ) {
   if( d_equalityEngine.hasTerm( t ) ){
     return d_equalityEngine.getRepresentative( t );
@@ -1789,6 +1806,10 @@ Node TheorySep::HeapInfo::getValue( TypeNode tn ) {
   }
 }
 
+bool TheorySep::HeapInfo::hasLocation( unsigned id ) const {
+  return id<d_heap_locs_bits.size() && d_heap_locs_bits[id];
+}
+
 }/* CVC4::theory::sep namespace */
 }/* CVC4::theory namespace */
 }/* CVC4 namespace */
@@ -291,11 +291,20 @@ class TheorySep : public Theory {
     bool d_computed;
     std::vector< Node > d_heap_locs;
     std::vector< Node > d_heap_locs_model;
+    //bitset of the ids of the locations in d_heap_locs_model
+    std::vector< bool > d_heap_locs_bits;
     //get value
     Node getValue( TypeNode tn );
+    //does this heap contain the location with the given id?
+    bool hasLocation( unsigned id ) const;
   };
   //heap info ( label -> HeapInfo )
   std::map< Node, HeapInfo > d_label_model;
+  //the ids of the model values of locations ( singleton -> id ), used for the
+  //bitset representation of the heaps in d_label_model
+  std::map< Node, unsigned > d_loc_model_id;
+  //get the id of the model value of a location, given as a singleton
+  unsigned getLocationModelId( Node sv );
   // loc -> { data_1, ..., data_n } where (not (pto loc data_1))...(not (pto loc data_n))).
   std::map< Node, std::vector< Node > > d_heap_locs_nptos;
 
@@ -164,6 +164,15 @@ void SolverState::registerTerm(Node r, TypeNode tnn, Node n)
   }
 }
 
+Node SolverState::getRepresentative(Node a) const
+{
+  if (d_ee.hasTerm(a))
+  {
+    return d_ee.getRepresentative(a);
+  }
+  return a;
+}
+
 bool SolverState::areEqual(Node a, Node b) const
 {
   if (a == b)
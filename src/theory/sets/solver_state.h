@@ -68,6 +68,11 @@ class SolverState
   void setConflict();
   /** Set conf is a conflict node to be sent on the output channel.  */
   void setConflict(Node conf);
+  /**
+   * Get the representative of a in the equality engine, or a itself if it
+   * does not occur in the equality engine.
+   */
+  Node getRepresentative(Node a) const;
   /** Is a=b according to equality reasoning in the current context? */
   bool areEqual(Node a, Node b) const;
   /** Is a!=b according to equality reasoning in the current context? */
@@ -17,6 +17,7 @@
 #include "theory/sets/theory_sets_private.h"
 
 #include <algorithm>
+#include <unordered_set>
 
 #include "expr/emptyset.h"
 #include "expr/node_algorithm.h"
@@ -142,24 +143,22 @@ void TheorySetsPrivate::eqNotifyPostMerge(TNode t1, TNode t2)
       {
         n_members = (*mem_i1).second;
       }
+      // the representatives of the elements of t1, so that the redundancy
+      // check below is linear in the size of the membership lists
+      std::unordered_set<Node, NodeHashFunction> elems;
+      for (int j = 0; j < n_members; j++)
+      {
+        Assert(j < (int)d_members_data[t1].size()
+               && d_members_data[t1][j].getKind() == kind::MEMBER);
+        elems.insert(d_state.getRepresentative(d_members_data[t1][j][0]));
+      }
       for (int i = 0; i < (*mem_i2).second; i++)
       {
         Assert(i < (int)d_members_data[t2].size()
                && d_members_data[t2][i].getKind() == kind::MEMBER);
         Node m2 = d_members_data[t2][i];
         // check if redundant
-        bool add = true;
-        for (int j = 0; j < n_members; j++)
-        {
-          Assert(j < (int)d_members_data[t1].size()
-                 && d_members_data[t1][j].getKind() == kind::MEMBER);
-          if (d_state.areEqual(m2[0], d_members_data[t1][j][0]))
-          {
-            add = false;
-            break;
-          }
-        }
-        if (add)
+        if (elems.insert(d_state.getRepresentative(m2[0])).second)
         {
           if (!s1.isNull() && s2.isNull())
           {
@@ -15,6 +15,9 @@
  **/
 
 #include "theory/sets/theory_sets_rels.h"
+
+#include <algorithm>
+
 #include "expr/datatype.h"
 #include "theory/sets/theory_sets_private.h"
 #include "theory/sets/theory_sets.h"
@@ -642,8 +645,8 @@ void TheorySetsRels::check(Theory::Effort level)
 
     Node rel_rep = getRepresentative( tc_rel[0] );
     Node tc_rel_rep = getRepresentative( tc_rel );
-    std::vector< Node > members = d_rReps_memberReps_cache[rel_rep];
-    std::vector< Node > exps = d_rReps_memberReps_exp_cache[rel_rep];
+    const std::vector<Node>& members = d_rReps_memberReps_cache[rel_rep];
+    const std::vector<Node>& exps = d_rReps_memberReps_exp_cache[rel_rep];
 
     for( unsigned int i = 0; i < members.size(); i++ ) {
       Node fst_element_rep = getRepresentative( RelsUtils::nthElementOfTuple( members[i], 0 ));
@@ -669,19 +672,23 @@ void TheorySetsRels::check(Theory::Effort level)
     }
   }
 
-  void TheorySetsRels::doTCInference( std::map< Node, std::unordered_set<Node, NodeHashFunction> > rel_tc_graph, std::map< Node, Node > rel_tc_graph_exps, Node tc_rel ) {
+  void TheorySetsRels::doTCInference( std::map< Node, std::unordered_set<Node, NodeHashFunction> >& rel_tc_graph, std::map< Node, Node >& rel_tc_graph_exps, Node tc_rel ) {
     Trace("rels-debug") << "[Theory::Rels] ****** doTCInference !" << std::endl;
     for (TC_GRAPH_IT tc_graph_it = rel_tc_graph.begin();
          tc_graph_it != rel_tc_graph.end();
          ++tc_graph_it)
     {
+      // The nodes whose successors were already visited from this node. It
+      // is shared by all the edges from this node, so that each node reachable
+      // from it is expanded once, and each of the pairs of the closure from
+      // this node is inferred along a single path.
+      std::unordered_set<Node, NodeHashFunction> seen;
       for (std::unordered_set<Node, NodeHashFunction>::iterator
                snd_elements_it = tc_graph_it->second.begin();
            snd_elements_it != tc_graph_it->second.end();
            ++snd_elements_it)
       {
         std::vector< Node > reasons;
-        std::unordered_set<Node, NodeHashFunction> seen;
         Node tuple = RelsUtils::constructPair( tc_rel, getRepresentative( tc_graph_it->first ), getRepresentative( *snd_elements_it) );
         Assert(rel_tc_graph_exps.find(tuple) != rel_tc_graph_exps.end());
         Node exp   = rel_tc_graph_exps.find( tuple )->second;
@@ -1030,13 +1037,51 @@ void TheorySetsRels::check(Theory::Effort level)
     }
     NodeManager* nm = NodeManager::currentNM();
 
-    std::vector<Node> r1_rep_exps = d_rReps_memberReps_exp_cache[r1_rep];
-    std::vector<Node> r2_rep_exps = d_rReps_memberReps_exp_cache[r2_rep];
+    const std::vector<Node>& r1_rep_exps = d_rReps_memberReps_exp_cache[r1_rep];
+    const std::vector<Node>& r2_rep_exps = d_rReps_memberReps_exp_cache[r2_rep];
     unsigned int r1_tuple_len = r1.getType().getSetElementType().getTupleLength();
     unsigned int r2_tuple_len = r2.getType().getSetElementType().getTupleLength();
 
+    // For joins, index the members of r2 by the representative of their
+    // leftmost element, so that each member of r1 is only composed with the
+    // members of r2 that may match it. The members whose leftmost element is
+    // not in the equality engine are matched with all members of r1.
+    std::vector<unsigned> r2_all;
+    std::map<Node, std::vector<unsigned> > r2_index;
+    std::vector<unsigned> r2_unindexed;
+    for (unsigned j = 0, size = r2_rep_exps.size(); j < size; j++)
+    {
+      r2_all.push_back(j);
+      Node r2_lmost = RelsUtils::nthElementOfTuple(r2_rep_exps[j][0], 0);
+      if (hasTerm(r2_lmost))
+      {
+        r2_index[getRepresentative(r2_lmost)].push_back(j);
+      }
+      else
+      {
+        r2_unindexed.push_back(j);
+      }
+    }
+
     for( unsigned int i = 0; i < r1_rep_exps.size(); i++ ) {
-      for( unsigned int j = 0; j < r2_rep_exps.size(); j++ ) {
+      std::vector<unsigned> r2_matches;
+      Node r1_rmost_i =
+          RelsUtils::nthElementOfTuple(r1_rep_exps[i][0], r1_tuple_len - 1);
+      bool useIndex = rel.getKind() == kind::JOIN && hasTerm(r1_rmost_i);
+      if (useIndex)
+      {
+        std::map<Node, std::vector<unsigned> >::iterator itr =
+            r2_index.find(getRepresentative(r1_rmost_i));
+        if (itr != r2_index.end())
+        {
+          r2_matches = itr->second;
+        }
+        r2_matches.insert(
+            r2_matches.end(), r2_unindexed.begin(), r2_unindexed.end());
+        std::sort(r2_matches.begin(), r2_matches.end());
+      }
+      const std::vector<unsigned>& r2_cands = useIndex ? r2_matches : r2_all;
+      for (unsigned j : r2_cands) {
         std::vector<Node> tuple_elements;
         TypeNode tn = rel.getType().getSetElementType();
         Node r1_rmost = RelsUtils::nthElementOfTuple( r1_rep_exps[i][0], r1_tuple_len-1 );
@@ -15,6 +15,7 @@
 
 #include "theory/smt_engine_subsolver.h"
 
+#include "options/smt_options.h"
 #include "smt/smt_engine.h"
 #include "smt/smt_engine_scope.h"
 #include "theory/rewriter.h"
@@ -40,6 +41,68 @@ Result quickCheck(Node& query)
   return Result(Result::SAT_UNKNOWN, Result::REQUIRES_FULL_CHECK);
 }
 
+SubsolverPool::SubsolverPool() : d_inUse(false) {}
+
+SubsolverPool::~SubsolverPool() {}
+
+bool SubsolverPool::checkSat(Node query,
+                             const std::vector<Node>& vars,
+                             std::vector<Node>& modelVals,
+                             Result& r)
+{
+  if (d_inUse)
+  {
+    return false;
+  }
+  NodeManager* nm = NodeManager::currentNM();
+  const LogicInfo& logic = smt::currentSmtEngine()->getLogicInfo();
+  if (d_smte == nullptr || !(d_logic == logic))
+  {
+    // the subsolver and the exported expressions must be destroyed before
+    // their expression manager
+    d_smte.reset(nullptr);
+    d_varMap.reset(nullptr);
+    d_em.reset(new ExprManager(nm->getOptions()));
+    d_varMap.reset(new ExprManagerMapCollection);
+    d_smte.reset(new SmtEngine(d_em.get()));
+    d_smte->setIsInternalSubsolver();
+    d_smte->setOption("incremental", SExpr(true));
+    d_smte->setOption("produce-models", SExpr(true));
+    d_smte->setLogic(logic);
+    d_logic = logic;
+  }
+  d_inUse = true;
+  try
+  {
+    Expr equery = query.toExpr().exportTo(d_em.get(), *d_varMap);
+    std::vector<Expr> evars;
+    for (const Node& v : vars)
+    {
+      evars.push_back(v.toExpr().exportTo(d_em.get(), *d_varMap));
+    }
+    d_smte->resetAssertions();
+    d_smte->assertFormula(equery);
+    r = d_smte->checkSat();
+    if (r.asSatisfiabilityResult().isSat() == Result::SAT)
+    {
+      for (const Expr& ev : evars)
+      {
+        Expr val =
+            d_smte->getValue(ev).exportTo(nm->toExprManager(), *d_varMap);
+        modelVals.push_back(Node::fromExpr(val));
+      }
+    }
+  }
+  catch (const CVC4::ExportUnsupportedException& e)
+  {
+    modelVals.clear();
+    d_inUse = false;
+    return false;
+  }
+  d_inUse = false;
+  return true;
+}
+
 void initializeSubsolver(std::unique_ptr<SmtEngine>& smte)
 {
   NodeManager* nm = NodeManager::currentNM();
@@ -130,6 +193,12 @@ Result checkWithSubsolver(Node query,
     }
     return r;
   }
+  if (!needsTimeout && options::subsolverPool()
+      && smt::currentSmtEngine()->getSubsolverPool()->checkSat(
+             query, vars, modelVals, r))
+  {
+    return r;
+  }
   std::unique_ptr<SmtEngine> smte;
   ExprManagerMapCollection varMap;
   NodeManager* nm = NodeManager::currentNM();
@@ -26,10 +26,58 @@
 #include "expr/node.h"
 #include "expr/variable_type_map.h"
 #include "smt/smt_engine.h"
+#include "theory/logic_info.h"
+#include "util/result.h"
 
 namespace CVC4 {
 namespace theory {
 
+/**
+ * A pool of subsolvers, which is owned by an SMT engine and used by
+ * checkWithSubsolver below if --subsolver-pool is enabled.
+ *
+ * Constructing an SMT engine for each internal query dominates the runtime of
+ * the callers that check many small queries. Instead, this class keeps an
+ * SMT engine that is reset with resetAssertions between queries. Since a
+ * query may only be made once by an SMT engine that is not incremental, and
+ * the options of the current expression manager are shared with the current
+ * SMT engine, the subsolver uses its own expression manager with incremental
+ * solving enabled, and the queries and model values are exported between the
+ * two expression managers. The variables exported by previous queries are
+ * kept in a common map.
+ *
+ * The subsolver is reconstructed if the logic of the current SMT engine has
+ * changed since it was constructed.
+ */
+class SubsolverPool
+{
+ public:
+  SubsolverPool();
+  ~SubsolverPool();
+  /**
+   * Checks the satisfiability of query with the subsolver of this pool. If
+   * it is satisfiable, the model values of vars are added to modelVals.
+   * Returns false if the subsolver is already in use or the query cannot be
+   * exported, in which case the caller should use a new SMT engine instead.
+   */
+  bool checkSat(Node query,
+                const std::vector<Node>& vars,
+                std::vector<Node>& modelVals,
+                Result& r);
+
+ private:
+  /** the expression manager of the subsolver */
+  std::unique_ptr<ExprManager> d_em;
+  /** the map for exporting expressions to d_em, and back */
+  std::unique_ptr<ExprManagerMapCollection> d_varMap;
+  /** the subsolver */
+  std::unique_ptr<SmtEngine> d_smte;
+  /** the logic the subsolver was constructed for */
+  LogicInfo d_logic;
+  /** whether the subsolver is currently checking a query */
+  bool d_inUse;
+};
+
 /**
  * This function initializes the smt engine smte as a subsolver, e.g. it
  * creates a new SMT engine and sets the options of the current SMT engine.
@@ -32,6 +32,7 @@ namespace strings {
 CoreSolver::CoreSolver(context::Context* c, context::UserContext* u, SolverState& s, InferenceManager& im, SkolemCache& skc, BaseSolver& bs) :
 d_state(s), d_im(im), d_skCache(skc),
 d_bsolver(bs),
+d_nfCache(c),
 d_nf_pairs(c)
 {
   d_zero = NodeManager::currentNM()->mkConst( Rational( 0 ) );
@@ -550,6 +551,7 @@ void CoreSolver::checkNormalFormsEq()
   // calculate normal forms for each equivalence class, possibly adding
   // splitting lemmas
   d_normal_form.clear();
+  d_eqcEpoch.clear();
   std::map<Node, Node> nf_to_eqc;
   std::map<Node, Node> eqc_to_nf;
   std::map<Node, Node> eqc_to_exp;
@@ -558,6 +560,19 @@ void CoreSolver::checkNormalFormsEq()
     TypeNode stype = eqc.getType();
     Trace("strings-process-debug") << "- Verify normal forms are the same for "
                                    << eqc << std::endl;
+    // the components are ordered before eqc in d_strings_eqc
+    uint64_t epoch = d_state.getEpoch(eqc);
+    for (const Node& n : d_eqc[eqc])
+    {
+      for (const Node& nc : n)
+      {
+        Node nr = d_state.getRepresentative(nc);
+        std::map<Node, uint64_t>::iterator ite = d_eqcEpoch.find(nr);
+        epoch = std::max(
+            epoch, ite != d_eqcEpoch.end() ? ite->second : d_state.getEpoch(nr));
+      }
+    }
+    d_eqcEpoch[eqc] = epoch;
     normalizeEquivalenceClass(eqc, stype);
     Trace("strings-debug") << "Finished normalizing eqc..." << std::endl;
     if (d_im.hasProcessed())
@@ -629,6 +644,16 @@ void CoreSolver::normalizeEquivalenceClass(Node eqc, TypeNode stype)
   {
     // should not have computed the normal form of this equivalence class yet
     Assert(d_normal_form.find(eqc) == d_normal_form.end());
+    uint64_t epoch = d_eqcEpoch[eqc];
+    NormalFormCache::const_iterator itc = d_nfCache.find(eqc);
+    if (itc != d_nfCache.end() && (*itc).second.first == epoch)
+    {
+      d_normal_form[eqc] = (*itc).second.second;
+      Trace("strings-process-debug")
+          << "Return process equivalence class " << eqc
+          << " : unchanged since epoch " << epoch << std::endl;
+      return;
+    }
     // Normal forms for the relevant terms in the equivalence class of eqc
     std::vector<NormalForm> normal_forms;
     // map each term to its index in the above vector
@@ -658,6 +683,7 @@ void CoreSolver::normalizeEquivalenceClass(Node eqc, TypeNode stype)
       nf_index = it->second;
     }
     d_normal_form[eqc] = normal_forms[nf_index];
+    d_nfCache[eqc] = std::pair<uint64_t, NormalForm>(epoch, d_normal_form[eqc]);
     Trace("strings-process-debug")
         << "Return process equivalence class " << eqc
         << " : returned, size = " << d_normal_form[eqc].d_nf.size()
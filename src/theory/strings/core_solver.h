@@ -18,6 +18,7 @@
 #ifndef CVC4__THEORY__STRINGS__CORE_SOLVER_H
 #define CVC4__THEORY__STRINGS__CORE_SOLVER_H
 
+#include "context/cdhashmap.h"
 #include "context/cdhashset.h"
 #include "context/cdlist.h"
 #include "theory/strings/base_solver.h"
@@ -40,6 +41,10 @@ class CoreSolver
 {
   friend class InferenceManager;
   typedef context::CDHashMap<Node, int, NodeHashFunction> NodeIntMap;
+  typedef context::CDHashMap<Node,
+                             std::pair<uint64_t, NormalForm>,
+                             NodeHashFunction>
+      NormalFormCache;
 
  public:
   CoreSolver(context::Context* c,
@@ -349,6 +354,20 @@ class CoreSolver
   std::vector<Node> d_strings_eqc;
   /** map from terms to their normal forms */
   std::map<Node, NormalForm> d_normal_form;
+  /**
+   * The epoch of each equivalence class in the current call to
+   * checkNormalFormsEq, which is the maximum of the epochs (see
+   * SolverState::getEpoch) of the equivalence class and of the equivalence
+   * classes of the components of its concatenation terms, recursively.
+   */
+  std::map<Node, uint64_t> d_eqcEpoch;
+  /**
+   * The (SAT-context-dependent) normal forms computed without inferences in
+   * previous calls to checkNormalFormsEq, with the epoch of their
+   * equivalence class. If the epoch is unchanged, no merge happened in the
+   * equivalence classes the normal form depends on, and it is reused.
+   */
+  NormalFormCache d_nfCache;
   /**
    * In certain cases, we know that two terms are equivalent despite
    * not having to verify their normal forms are identical. For example,
@@ -72,6 +72,11 @@ class EqcInfo
   context::CDO<Node> d_prefixC;
   /** same as above, for suffix. */
   context::CDO<Node> d_suffixC;
+  /**
+   * The epoch of the last merge into this equivalence class, see
+   * SolverState::getEpoch.
+   */
+  context::CDO<uint64_t> d_epoch;
 };
 
 }  // namespace strings
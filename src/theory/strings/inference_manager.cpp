@@ -196,9 +196,12 @@ void InferenceManager::sendInference(const std::vector<Node>& exp,
                                      bool asLemma)
 {
   d_statistics.d_inferences << infer;
+  size_t nlemmas = d_pendingLem.size();
+  bool conflict = d_state.isInConflict();
   std::stringstream ss;
   ss << infer;
   sendInference(exp, exp_n, eq, ss.str().c_str(), asLemma);
+  recordInference(infer, nlemmas, conflict);
 }
 
 void InferenceManager::sendInference(const std::vector<Node>& exp,
@@ -207,9 +210,26 @@ void InferenceManager::sendInference(const std::vector<Node>& exp,
                                      bool asLemma)
 {
   d_statistics.d_inferences << infer;
+  size_t nlemmas = d_pendingLem.size();
+  bool conflict = d_state.isInConflict();
   std::stringstream ss;
   ss << infer;
   sendInference(exp, eq, ss.str().c_str(), asLemma);
+  recordInference(infer, nlemmas, conflict);
+}
+
+void InferenceManager::recordInference(Inference infer,
+                                       size_t nlemmas,
+                                       bool conflict)
+{
+  if (!conflict && d_state.isInConflict())
+  {
+    d_statistics.d_inferencesConflicts << infer;
+  }
+  else if (d_pendingLem.size() > nlemmas)
+  {
+    d_statistics.d_inferencesLemmas << infer;
+  }
 }
 
 void InferenceManager::sendInference(const InferInfo& i)
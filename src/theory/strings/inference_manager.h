@@ -324,6 +324,12 @@ class InferenceManager
   void markCongruent(Node a, Node b);
 
  private:
+  /**
+   * Records in the statistics whether the inference infer, sent when there
+   * were nlemmas pending lemmas and the conflict status was conflict, was
+   * sent as a lemma or as a conflict.
+   */
+  void recordInference(Inference infer, size_t nlemmas, bool conflict);
   /**
    * Indicates that ant => conc should be sent on the output channel of this
    * class. This will either trigger an immediate call to the conflict
@@ -0,0 +1,370 @@
+/*********************                                                        */
+/*! \file regexp_automaton.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of automata for constant regular expressions
+ **/
+
+#include "theory/strings/regexp_automaton.h"
+
+#include <algorithm>
+
+#include "base/output.h"
+#include "util/rational.h"
+
+using namespace CVC4::kind;
+
+namespace CVC4 {
+namespace theory {
+namespace strings {
+
+/** The maximal number of states of a non-deterministic automaton */
+static const size_t s_maxStates = 10000;
+/** The maximal number of pairs of states visited in a product */
+static const size_t s_maxProduct = 100000;
+
+RegExpAutomaton::RegExpAutomaton(Node r)
+    : d_compiled(false),
+      d_card(String::num_codes()),
+      d_init(0),
+      d_final(0),
+      d_detInit(0)
+{
+  d_init = mkState();
+  d_compiled = compile(r, d_init, d_final);
+  if (d_compiled)
+  {
+    std::vector<unsigned> ns;
+    ns.push_back(d_init);
+    d_detInit = mkDetState(ns);
+  }
+  Trace("regexp-automaton") << "RegExpAutomaton: " << r << " has "
+                            << d_trans.size() << " states, compiled is "
+                            << d_compiled << std::endl;
+}
+
+unsigned RegExpAutomaton::mkState()
+{
+  d_trans.push_back(std::vector<Transition>());
+  d_eps.push_back(std::vector<unsigned>());
+  return d_trans.size() - 1;
+}
+
+bool RegExpAutomaton::compile(Node r, unsigned s, unsigned& t)
+{
+  if (d_trans.size() > s_maxStates)
+  {
+    return false;
+  }
+  switch (r.getKind())
+  {
+    case REGEXP_EMPTY:
+    {
+      t = mkState();
+      return true;
+    }
+    case STRING_TO_REGEXP:
+    {
+      if (!r[0].isConst())
+      {
+        return false;
+      }
+      t = s;
+      for (unsigned c : r[0].getConst<String>().getVec())
+      {
+        unsigned code = String::convertUnsignedIntToCode(c);
+        unsigned n = mkState();
+        d_trans[t].push_back(Transition{code, code, n});
+        t = n;
+      }
+      return true;
+    }
+    case REGEXP_SIGMA:
+    {
+      t = mkState();
+      d_trans[s].push_back(Transition{0, d_card - 1, t});
+      return true;
+    }
+    case REGEXP_RANGE:
+    {
+      if (!r[0].isConst() || r[0].getConst<String>().size() != 1
+          || !r[1].isConst() || r[1].getConst<String>().size() != 1)
+      {
+        return false;
+      }
+      unsigned a =
+          String::convertUnsignedIntToCode(r[0].getConst<String>().front());
+      unsigned b =
+          String::convertUnsignedIntToCode(r[1].getConst<String>().front());
+      t = mkState();
+      if (a <= b)
+      {
+        d_trans[s].push_back(Transition{a, b, t});
+      }
+      return true;
+    }
+    case REGEXP_CONCAT:
+    {
+      t = s;
+      for (const Node& rc : r)
+      {
+        if (!compile(rc, t, t))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+    case REGEXP_UNION:
+    {
+      t = mkState();
+      for (const Node& rc : r)
+      {
+        unsigned cs = mkState();
+        unsigned ce;
+        d_eps[s].push_back(cs);
+        if (!compile(rc, cs, ce))
+        {
+          return false;
+        }
+        d_eps[ce].push_back(t);
+      }
+      return true;
+    }
+    case REGEXP_STAR:
+    case REGEXP_PLUS:
+    {
+      // the loop starts at a new state, so that it is not entered from the
+      // other transitions of s
+      unsigned cs = mkState();
+      unsigned ce;
+      d_eps[s].push_back(cs);
+      if (!compile(r[0], cs, ce))
+      {
+        return false;
+      }
+      t = mkState();
+      d_eps[ce].push_back(cs);
+      d_eps[r.getKind() == REGEXP_STAR ? cs : ce].push_back(t);
+      return true;
+    }
+    case REGEXP_OPT:
+    {
+      unsigned ce;
+      if (!compile(r[0], s, ce))
+      {
+        return false;
+      }
+      t = mkState();
+      d_eps[s].push_back(t);
+      d_eps[ce].push_back(t);
+      return true;
+    }
+    case REGEXP_LOOP:
+    {
+      unsigned bound[2] = {0, 0};
+      for (unsigned i = 1, nchild = r.getNumChildren(); i < nchild; i++)
+      {
+        if (!r[i].isConst()
+            || !r[i].getConst<Rational>().getNumerator().fitsUnsignedInt())
+        {
+          return false;
+        }
+        bound[i - 1] = r[i].getConst<Rational>().getNumerator().toUnsignedInt();
+        if (bound[i - 1] > s_maxStates)
+        {
+          return false;
+        }
+      }
+      t = s;
+      for (unsigned i = 0; i < bound[0]; i++)
+      {
+        if (!compile(r[0], t, t))
+        {
+          return false;
+        }
+      }
+      if (r.getNumChildren() == 2)
+      {
+        // at least bound[0] times, followed by a loop as for re.*
+        unsigned cs = mkState();
+        unsigned ce;
+        d_eps[t].push_back(cs);
+        if (!compile(r[0], cs, ce))
+        {
+          return false;
+        }
+        t = mkState();
+        d_eps[ce].push_back(cs);
+        d_eps[cs].push_back(t);
+        return true;
+      }
+      for (unsigned i = bound[0]; i < bound[1]; i++)
+      {
+        unsigned ce;
+        if (!compile(r[0], t, ce))
+        {
+          return false;
+        }
+        unsigned n = mkState();
+        d_eps[t].push_back(n);
+        d_eps[ce].push_back(n);
+        t = n;
+      }
+      return true;
+    }
+    default: break;
+  }
+  return false;
+}
+
+unsigned RegExpAutomaton::mkDetState(std::vector<unsigned>& ns)
+{
+  // the closure by epsilon transitions
+  std::vector<bool> visited(d_trans.size(), false);
+  std::vector<unsigned> closure;
+  std::vector<unsigned> visit = ns;
+  while (!visit.empty())
+  {
+    unsigned n = visit.back();
+    visit.pop_back();
+    if (visited[n])
+    {
+      continue;
+    }
+    visited[n] = true;
+    closure.push_back(n);
+    visit.insert(visit.end(), d_eps[n].begin(), d_eps[n].end());
+  }
+  std::sort(closure.begin(), closure.end());
+  std::map<std::vector<unsigned>, unsigned>::iterator it =
+      d_detIndex.find(closure);
+  if (it != d_detIndex.end())
+  {
+    return it->second;
+  }
+  unsigned d = d_detStates.size();
+  d_detIndex[closure] = d;
+  d_detAccept.push_back(visited[d_final]);
+  d_detStates.push_back(closure);
+  d_detNext.push_back(std::map<unsigned, unsigned>());
+  return d;
+}
+
+unsigned RegExpAutomaton::getNext(unsigned d, unsigned c)
+{
+  std::map<unsigned, unsigned>::iterator it = d_detNext[d].find(c);
+  if (it != d_detNext[d].end())
+  {
+    return it->second;
+  }
+  std::vector<unsigned> ns;
+  for (unsigned n : d_detStates[d])
+  {
+    for (const Transition& tr : d_trans[n])
+    {
+      if (tr.d_lo <= c && c <= tr.d_hi)
+      {
+        ns.push_back(tr.d_target);
+      }
+    }
+  }
+  unsigned dn = mkDetState(ns);
+  d_detNext[d][c] = dn;
+  return dn;
+}
+
+void RegExpAutomaton::getBounds(std::set<unsigned>& bounds) const
+{
+  for (const std::vector<Transition>& trs : d_trans)
+  {
+    for (const Transition& tr : trs)
+    {
+      bounds.insert(tr.d_lo);
+      bounds.insert(tr.d_hi + 1);
+    }
+  }
+}
+
+bool RegExpAutomaton::accepts(const String& s)
+{
+  Assert(d_compiled);
+  unsigned d = d_detInit;
+  for (unsigned c : s.getVec())
+  {
+    d = getNext(d, String::convertUnsignedIntToCode(c));
+    if (d_detStates[d].empty())
+    {
+      return false;
+    }
+  }
+  return d_detAccept[d];
+}
+
+bool RegExpAutomaton::isProductEmpty(RegExpAutomaton& a,
+                                     RegExpAutomaton& b,
+                                     bool complementA)
+{
+  Assert(a.d_compiled && b.d_compiled);
+  // the codes between consecutive bounds have the same transitions in both
+  // automata, hence it suffices to consider the first code of each range
+  std::set<unsigned> bounds;
+  bounds.insert(0);
+  a.getBounds(bounds);
+  b.getBounds(bounds);
+  std::vector<unsigned> codes;
+  for (unsigned c : bounds)
+  {
+    if (c < a.d_card)
+    {
+      codes.push_back(c);
+    }
+  }
+  std::set<std::pair<unsigned, unsigned>> visited;
+  std::vector<std::pair<unsigned, unsigned>> visit;
+  visit.push_back(std::make_pair(a.d_detInit, b.d_detInit));
+  while (!visit.empty())
+  {
+    std::pair<unsigned, unsigned> p = visit.back();
+    visit.pop_back();
+    if (!visited.insert(p).second)
+    {
+      continue;
+    }
+    if (visited.size() > s_maxProduct)
+    {
+      Trace("regexp-automaton") << "RegExpAutomaton: product too large"
+                                << std::endl;
+      return false;
+    }
+    bool acceptA = a.d_detAccept[p.first];
+    if (b.d_detAccept[p.second] && acceptA != complementA)
+    {
+      return false;
+    }
+    // no word is accepted from this pair
+    if (b.d_detStates[p.second].empty()
+        || (!complementA && a.d_detStates[p.first].empty()))
+    {
+      continue;
+    }
+    for (unsigned c : codes)
+    {
+      unsigned na = a.getNext(p.first, c);
+      unsigned nb = b.getNext(p.second, c);
+      visit.push_back(std::make_pair(na, nb));
+    }
+  }
+  return true;
+}
+
+}  // namespace strings
+}  // namespace theory
+}  // namespace CVC4
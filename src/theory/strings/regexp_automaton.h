@@ -0,0 +1,113 @@
+/*********************                                                        */
+/*! \file regexp_automaton.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Automata for constant regular expressions
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__STRINGS__REGEXP_AUTOMATON_H
+#define CVC4__THEORY__STRINGS__REGEXP_AUTOMATON_H
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "expr/node.h"
+#include "util/regexp.h"
+
+namespace CVC4 {
+namespace theory {
+namespace strings {
+
+/**
+ * An automaton for a constant regular expression.
+ *
+ * The regular expression is compiled into a non-deterministic automaton with
+ * epsilon transitions, whose transitions are labelled by ranges of character
+ * codes. This applies to the regular expressions built from constant strings,
+ * re.allchar, re.range, re.none, re.++, re.union, re.*, re.+, re.opt and
+ * re.loop. The automaton is determinized lazily, that is, the states of the
+ * deterministic automaton, which are the sets of states of the
+ * non-deterministic one, and their transitions are computed when they are
+ * first visited, and are cached.
+ *
+ * This allows to decide the membership of a constant string in time linear
+ * in its length, and the emptiness of the intersection of two regular
+ * expressions, or whether one includes the other, by a traversal of the
+ * product of their automata.
+ */
+class RegExpAutomaton
+{
+ public:
+  /** Compiles the automaton of r */
+  RegExpAutomaton(Node r);
+  /** Returns true if r could be compiled */
+  bool isCompiled() const { return d_compiled; }
+  /** Returns true if s is in the language of the automaton */
+  bool accepts(const String& s);
+  /**
+   * Returns true if it was shown that the intersection of the languages of a
+   * and b is empty, or, if complementA is true, that the language of b is
+   * included in that of a. Returns false if this is not the case, or if the
+   * product is too large to be explored.
+   */
+  static bool isProductEmpty(RegExpAutomaton& a,
+                             RegExpAutomaton& b,
+                             bool complementA);
+
+ private:
+  /** A transition of the non-deterministic automaton on [d_lo, d_hi] */
+  struct Transition
+  {
+    unsigned d_lo;
+    unsigned d_hi;
+    unsigned d_target;
+  };
+  /** Adds a state to the non-deterministic automaton */
+  unsigned mkState();
+  /**
+   * Adds the states of r from the state s, and sets t to its final state.
+   * Returns false if r is not supported or if the automaton is too large.
+   */
+  bool compile(Node r, unsigned s, unsigned& t);
+  /** Returns the deterministic state for the closure of the states in ns */
+  unsigned mkDetState(std::vector<unsigned>& ns);
+  /** Returns the successor of the deterministic state d on the code c */
+  unsigned getNext(unsigned d, unsigned c);
+  /** Adds the bounds of the ranges of the transitions to bounds */
+  void getBounds(std::set<unsigned>& bounds) const;
+
+  /** Whether the regular expression was compiled */
+  bool d_compiled;
+  /** The number of characters in the alphabet */
+  unsigned d_card;
+  /** The non-deterministic automaton, and its initial and final states */
+  std::vector<std::vector<Transition>> d_trans;
+  std::vector<std::vector<unsigned>> d_eps;
+  unsigned d_init;
+  unsigned d_final;
+  /** The states of the determinized automaton, as sorted sets of states */
+  std::vector<std::vector<unsigned>> d_detStates;
+  std::map<std::vector<unsigned>, unsigned> d_detIndex;
+  /** Whether the deterministic states contain the final state */
+  std::vector<bool> d_detAccept;
+  /** The computed transitions of the deterministic states, by code */
+  std::vector<std::map<unsigned, unsigned>> d_detNext;
+  /** The deterministic initial state */
+  unsigned d_detInit;
+}; /* class RegExpAutomaton */
+
+}  // namespace strings
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__STRINGS__REGEXP_AUTOMATON_H */
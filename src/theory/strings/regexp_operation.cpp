@@ -1631,6 +1631,16 @@ Node RegExpOpr::intersect(Node r1, Node r2, bool &spflag) {
   if(checkConstRegExp(r1) && checkConstRegExp(r2)) {
     Node rr1 = removeIntersection(r1);
     Node rr2 = removeIntersection(r2);
+    RegExpAutomaton* a1 = getAutomaton(r1);
+    RegExpAutomaton* a2 = getAutomaton(r2);
+    if (a1 != nullptr && a2 != nullptr
+        && RegExpAutomaton::isProductEmpty(*a1, *a2, false))
+    {
+      Trace("regexp-intersect") << "INTERSECTION(\n\t" << mkString(r1)
+                                << ",\n\t" << mkString(r2)
+                                << ") is empty by automata" << std::endl;
+      return d_emptyRegexp;
+    }
     std::map< PairNodes, Node > cache;
     Trace("regexp-intersect-node") << "Intersect (1): " << rr1 << std::endl;
     Trace("regexp-intersect-node") << "Intersect (2): " << rr2 << std::endl;
@@ -1765,6 +1775,19 @@ std::string RegExpOpr::mkString( Node r ) {
   return retStr;
 }
 
+RegExpAutomaton* RegExpOpr::getAutomaton(Node r)
+{
+  std::map<Node, std::unique_ptr<RegExpAutomaton>>::iterator it =
+      d_automata.find(r);
+  if (it == d_automata.end())
+  {
+    it = d_automata.emplace(r, std::unique_ptr<RegExpAutomaton>(
+                                   new RegExpAutomaton(r)))
+             .first;
+  }
+  return it->second->isCompiled() ? it->second.get() : nullptr;
+}
+
 bool RegExpOpr::regExpIncludes(Node r1, Node r2)
 {
   Assert(Rewriter::rewrite(r1) == r1);
@@ -1775,18 +1798,24 @@ bool RegExpOpr::regExpIncludes(Node r1, Node r2)
     return true;
   }
 
-  // This method only works on a fragment of regular expressions
-  if (!utils::isSimpleRegExp(r1) || !utils::isSimpleRegExp(r2))
-  {
-    return false;
-  }
-
   const auto& it = d_inclusionCache.find(std::make_pair(r1, r2));
   if (it != d_inclusionCache.end())
   {
     return (*it).second;
   }
 
+  // This method only works on a fragment of regular expressions, otherwise we
+  // use their automata, if they can be compiled
+  if (!utils::isSimpleRegExp(r1) || !utils::isSimpleRegExp(r2))
+  {
+    RegExpAutomaton* a1 = getAutomaton(r1);
+    RegExpAutomaton* a2 = getAutomaton(r2);
+    bool result = a1 != nullptr && a2 != nullptr
+                  && RegExpAutomaton::isProductEmpty(*a1, *a2, true);
+    d_inclusionCache[std::make_pair(r1, r2)] = result;
+    return result;
+  }
+
   std::vector<Node> v1, v2;
   utils::getRegexpComponents(r1, v1);
   utils::getRegexpComponents(r2, v2);
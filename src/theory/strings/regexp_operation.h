@@ -23,8 +23,10 @@
 #include <set>
 #include <algorithm>
 #include <climits>
+#include <memory>
 #include "util/hash.h"
 #include "util/regexp.h"
+#include "theory/strings/regexp_automaton.h"
 #include "theory/theory.h"
 #include "theory/rewriter.h"
 //#include "context/cdhashmap.h"
@@ -89,6 +91,13 @@ class RegExpOpr {
   std::map<Node, bool> d_norv_cache;
   std::map<Node, std::vector<PairNodes> > d_split_cache;
   std::map<PairNodes, bool> d_inclusionCache;
+  /** cache of the automata of regular expressions (see getAutomaton) */
+  std::map<Node, std::unique_ptr<RegExpAutomaton>> d_automata;
+  /**
+   * Returns the automaton of the regular expression r, or nullptr if r
+   * cannot be compiled to an automaton.
+   */
+  RegExpAutomaton* getAutomaton(Node r);
   void simplifyPRegExp(Node s, Node r, std::vector<Node> &new_nodes);
   void simplifyNRegExp(Node s, Node r, std::vector<Node> &new_nodes);
   /**
@@ -144,7 +153,9 @@ class RegExpOpr {
   Node derivativeSingle( Node r, CVC4::String c );
   /**
    * Returns the regular expression intersection of r1 and r2. If r1 or r2 is
-   * not constant, then this method returns null and sets spflag to true.
+   * not constant, then this method returns null and sets spflag to true. If
+   * the product of the automata of r1 and r2 shows that the intersection is
+   * empty, this returns re.none.
    */
   Node intersect(Node r1, Node r2, bool &spflag);
   /** Get the pretty printed version of the regular expression r */
@@ -155,7 +166,8 @@ class RegExpOpr {
    * the regular expression `r2` (i.e. `r1` matches a superset of sequences
    * that `r2` matches). This method only works on a fragment of regular
    * expressions, specifically regular expressions that pass the
-   * `isSimpleRegExp` check.
+   * `isSimpleRegExp` check, or that can be compiled to automata, in which
+   * case the inclusion is checked on the product of the automata.
    *
    * @param r1 The regular expression that may include `r2` (must be in
    *           rewritten form)
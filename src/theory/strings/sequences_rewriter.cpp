@@ -23,6 +23,7 @@
 #include "options/strings_options.h"
 #include "smt/logic_exception.h"
 #include "theory/arith/arith_msum.h"
+#include "theory/strings/regexp_automaton.h"
 #include "theory/strings/regexp_operation.h"
 #include "theory/strings/strings_rewriter.h"
 #include "theory/strings/theory_strings_utils.h"
@@ -1540,10 +1541,12 @@ Node SequencesRewriter::rewriteMembership(TNode node)
   }
   else if (x.isConst() && isConstRegExp(r))
   {
-    // test whether x in node[1]
+    // test whether x in node[1], using its automaton if it can be compiled
     CVC4::String s = x.getConst<String>();
-    retNode =
-        NodeManager::currentNM()->mkConst(testConstStringInRegExp(s, 0, r));
+    RegExpAutomaton ra(r);
+    bool test = ra.isCompiled() ? ra.accepts(s)
+                                : testConstStringInRegExp(s, 0, r);
+    retNode = NodeManager::currentNM()->mkConst(test);
   }
   else if (r.getKind() == kind::REGEXP_SIGMA)
   {
@@ -23,7 +23,10 @@ namespace strings {
 
 SequencesStatistics::SequencesStatistics()
     : d_inferences("theory::strings::inferences"),
+      d_inferencesLemmas("theory::strings::inferencesLemmas"),
+      d_inferencesConflicts("theory::strings::inferencesConflicts"),
       d_reductions("theory::strings::reductions"),
+      d_reductionsReused("theory::strings::reductionsReused"),
       d_conflictsEqEngine("theory::strings::conflictsEqEngine", 0),
       d_conflictsEagerPrefix("theory::strings::conflictsEagerPrefix", 0),
       d_conflictsInfer("theory::strings::conflictsInfer", 0),
@@ -35,7 +38,10 @@ SequencesStatistics::SequencesStatistics()
       d_lemmasInfer("theory::strings::lemmasInfer", 0)
 {
   smtStatisticsRegistry()->registerStat(&d_inferences);
+  smtStatisticsRegistry()->registerStat(&d_inferencesLemmas);
+  smtStatisticsRegistry()->registerStat(&d_inferencesConflicts);
   smtStatisticsRegistry()->registerStat(&d_reductions);
+  smtStatisticsRegistry()->registerStat(&d_reductionsReused);
   smtStatisticsRegistry()->registerStat(&d_conflictsEqEngine);
   smtStatisticsRegistry()->registerStat(&d_conflictsEagerPrefix);
   smtStatisticsRegistry()->registerStat(&d_conflictsInfer);
@@ -49,7 +55,10 @@ SequencesStatistics::SequencesStatistics()
 SequencesStatistics::~SequencesStatistics()
 {
   smtStatisticsRegistry()->unregisterStat(&d_inferences);
+  smtStatisticsRegistry()->unregisterStat(&d_inferencesLemmas);
+  smtStatisticsRegistry()->unregisterStat(&d_inferencesConflicts);
   smtStatisticsRegistry()->unregisterStat(&d_reductions);
+  smtStatisticsRegistry()->unregisterStat(&d_reductionsReused);
   smtStatisticsRegistry()->unregisterStat(&d_conflictsEqEngine);
   smtStatisticsRegistry()->unregisterStat(&d_conflictsEagerPrefix);
   smtStatisticsRegistry()->unregisterStat(&d_conflictsInfer);
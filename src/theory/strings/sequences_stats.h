@@ -33,8 +33,17 @@ class SequencesStatistics
 
   /** Counts the number of applications of each type of inference */
   HistogramStat<Inference> d_inferences;
+  /** Counts the applications of each type of inference sent as lemmas */
+  HistogramStat<Inference> d_inferencesLemmas;
+  /** Counts the applications of each type of inference that are conflicts */
+  HistogramStat<Inference> d_inferencesConflicts;
   /** Counts the number of applications of each type of reduction */
   HistogramStat<Kind> d_reductions;
+  /**
+   * Counts the number of reductions of each type that were reused instead of
+   * being computed again
+   */
+  HistogramStat<Kind> d_reductionsReused;
   //--------------- conflicts, partition of calls to OutputChannel::conflict
   /** Number of equality engine conflicts */
   IntStat d_conflictsEqEngine;
@@ -86,6 +86,26 @@ bool SkolemCache::isSkolem(Node n) const
   return d_allSkolems.find(n) != d_allSkolems.end();
 }
 
+void SkolemCache::setReduction(Node t, Node res, const std::vector<Node>& defs)
+{
+  d_reductions[t] = std::make_pair(res, defs);
+}
+
+bool SkolemCache::getReduction(Node t,
+                               Node& res,
+                               std::vector<Node>& defs) const
+{
+  std::unordered_map<Node, Reduction, NodeHashFunction>::const_iterator it =
+      d_reductions.find(t);
+  if (it == d_reductions.end())
+  {
+    return false;
+  }
+  res = it->second.first;
+  defs.insert(defs.end(), it->second.second.begin(), it->second.second.end());
+  return true;
+}
+
 std::tuple<SkolemCache::SkolemId, Node, Node>
 SkolemCache::normalizeStringSkolem(SkolemId id, Node a, Node b)
 {
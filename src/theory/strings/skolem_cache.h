@@ -19,7 +19,10 @@
 
 #include <map>
 #include <tuple>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "expr/node.h"
 
@@ -130,6 +133,19 @@ class SkolemCache
   Node mkTypedSkolem(TypeNode tn, const char* c);
   /** Returns true if n is a skolem allocated by this class */
   bool isSkolem(Node n) const;
+  /**
+   * Store that extended function term t reduces to res, given the lemmas
+   * defs that define the skolems introduced by the reduction. Like the
+   * skolems, reductions do not depend on the user context: since the
+   * skolems are fresh, re-asserting their definitions after a pop is
+   * equivalent to reducing t again with new skolems.
+   */
+  void setReduction(Node t, Node res, const std::vector<Node>& defs);
+  /**
+   * If a reduction of t was stored, return true, set res to the term it
+   * reduces to and append its definitions to defs.
+   */
+  bool getReduction(Node t, Node& res, std::vector<Node>& defs) const;
 
  private:
   /**
@@ -158,6 +174,10 @@ class SkolemCache
   std::map<Node, std::map<Node, std::map<SkolemId, Node> > > d_skolemCache;
   /** the set of all skolems we have generated */
   std::unordered_set<Node, NodeHashFunction> d_allSkolems;
+  /** a reduction and the definitions of its skolems */
+  typedef std::pair<Node, std::vector<Node> > Reduction;
+  /** map from extended function terms to their reductions */
+  std::unordered_map<Node, Reduction, NodeHashFunction> d_reductions;
 };
 
 }  // namespace strings
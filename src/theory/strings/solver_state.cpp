@@ -32,7 +32,8 @@ SolverState::SolverState(context::Context* c,
       d_eeDisequalities(c),
       d_valuation(v),
       d_conflict(c, false),
-      d_pendingConflict(c)
+      d_pendingConflict(c),
+      d_epoch(0)
 {
 }
 SolverState::~SolverState()
@@ -123,6 +124,11 @@ void SolverState::eqNotifyNewClass(TNode t)
 
 void SolverState::eqNotifyPreMerge(TNode t1, TNode t2)
 {
+  if (t1.getType().isStringLike())
+  {
+    d_epoch++;
+    getOrMakeEqcInfo(t1)->d_epoch = d_epoch;
+  }
   EqcInfo* e2 = getOrMakeEqcInfo(t2, false);
   if (e2)
   {
@@ -183,6 +189,12 @@ EqcInfo* SolverState::getOrMakeEqcInfo(Node eqc, bool doMake)
   return nullptr;
 }
 
+uint64_t SolverState::getEpoch(Node eqc)
+{
+  EqcInfo* ei = getOrMakeEqcInfo(eqc, false);
+  return ei == nullptr ? 0 : ei->d_epoch.get();
+}
+
 TheoryModel* SolverState::getModel() const { return d_valuation.getModel(); }
 
 void SolverState::addEndpointsToEqcInfo(Node t, Node concat, Node eqc)
@@ -124,6 +124,13 @@ class SolverState
    * should currently be a representative of the equality engine of this class.
    */
   EqcInfo* getOrMakeEqcInfo(Node eqc, bool doMake = true);
+  /**
+   * Get the epoch of equivalence class eqc, which is incremented each time
+   * an equivalence class is merged into it. The epochs are increasing over
+   * the whole run, including across backtracking, hence two equal epochs of
+   * eqc indicate that no merge into eqc happened in between.
+   */
+  uint64_t getEpoch(Node eqc);
   /** Get pointer to the model object of the Valuation object */
   TheoryModel* getModel() const;
 
@@ -170,6 +177,8 @@ class SolverState
   context::CDO<Node> d_pendingConflict;
   /** Map from representatives to their equivalence class information */
   std::map<Node, EqcInfo*> d_eqcInfo;
+  /** The last epoch of a merge (see getEpoch) */
+  uint64_t d_epoch;
 }; /* class TheoryStrings */
 
 }  // namespace strings
@@ -17,6 +17,7 @@
 #include "theory/strings/theory_strings.h"
 
 #include <cmath>
+#include <sstream>
 
 #include "expr/kind.h"
 #include "options/strings_options.h"
@@ -50,10 +51,14 @@ std::ostream& operator<<(std::ostream& out, InferStep s)
     case CHECK_EXTF_EVAL: out << "check_extf_eval"; break;
     case CHECK_CYCLES: out << "check_cycles"; break;
     case CHECK_FLAT_FORMS: out << "check_flat_forms"; break;
+    case CHECK_REGISTER_TERMS_PRE_NF:
+      out << "check_register_terms_pre_nf";
+      break;
     case CHECK_NORMAL_FORMS_EQ: out << "check_normal_forms_eq"; break;
     case CHECK_NORMAL_FORMS_DEQ: out << "check_normal_forms_deq"; break;
     case CHECK_CODES: out << "check_codes"; break;
     case CHECK_LENGTH_EQC: out << "check_length_eqc"; break;
+    case CHECK_REGISTER_TERMS_NF: out << "check_register_terms_nf"; break;
     case CHECK_EXTF_REDUCTION: out << "check_extf_reduction"; break;
     case CHECK_MEMBERSHIP: out << "check_membership"; break;
     case CHECK_CARDINALITY: out << "check_cardinality"; break;
@@ -81,8 +86,18 @@ TheoryStrings::TheoryStrings(context::Context* c,
       d_esolver(nullptr),
       d_rsolver(nullptr),
       d_stringsFmf(c, u, valuation, d_sk_cache),
-      d_strategy_init(false)
+      d_strategy_init(false),
+      d_stepInferences("theory::strings::stepInferences")
 {
+  smtStatisticsRegistry()->registerStat(&d_stepInferences);
+  for (unsigned i = CHECK_INIT; i <= CHECK_CARDINALITY; i++)
+  {
+    InferStep s = static_cast<InferStep>(i);
+    std::stringstream ss;
+    ss << "theory::strings::stepTime::" << s;
+    d_stepTime[s].reset(new TimerStat(ss.str()));
+    smtStatisticsRegistry()->registerStat(d_stepTime[s].get());
+  }
   setupExtTheory();
   ExtTheory* extt = getExtTheory();
   d_esolver.reset(new ExtfSolver(c,
@@ -126,7 +141,11 @@ TheoryStrings::TheoryStrings(context::Context* c,
 }
 
 TheoryStrings::~TheoryStrings() {
-
+  smtStatisticsRegistry()->unregisterStat(&d_stepInferences);
+  for (std::pair<const InferStep, std::unique_ptr<TimerStat>>& st : d_stepTime)
+  {
+    smtStatisticsRegistry()->unregisterStat(st.second.get());
+  }
 }
 
 bool TheoryStrings::areCareDisequal( TNode x, TNode y ) {
@@ -1186,6 +1205,7 @@ void TheoryStrings::runInferStep(InferStep s, int effort)
     Trace("strings-process") << ", effort = " << effort;
   }
   Trace("strings-process") << "..." << std::endl;
+  TimerStat::CodeTimer codeTimer(*d_stepTime[s]);
   switch (s)
   {
     case CHECK_INIT: d_bsolver.checkInit(); break;
@@ -1204,6 +1224,10 @@ void TheoryStrings::runInferStep(InferStep s, int effort)
     case CHECK_CARDINALITY: d_bsolver.checkCardinality(); break;
     default: Unreachable(); break;
   }
+  if (d_im.hasProcessed())
+  {
+    d_stepInferences << s;
+  }
   Trace("strings-process") << "Done " << s
                            << ", addedFact = " << d_im.hasPendingFact()
                            << ", addedLemma = " << d_im.hasPendingLemma()
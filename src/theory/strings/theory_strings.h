@@ -21,6 +21,7 @@
 
 #include <climits>
 #include <deque>
+#include <memory>
 
 #include "context/cdhashset.h"
 #include "context/cdlist.h"
@@ -91,6 +92,7 @@ enum InferStep
   CHECK_CARDINALITY,
 };
 std::ostream& operator<<(std::ostream& out, Inference i);
+std::ostream& operator<<(std::ostream& out, InferStep s);
 
 struct StringsProxyVarAttributeId {};
 typedef expr::Attribute< StringsProxyVarAttributeId, bool > StringsProxyVarAttribute;
@@ -408,6 +410,10 @@ private:
   bool d_strategy_init;
   /** run the given inference step */
   void runInferStep(InferStep s, int effort);
+  /** The time spent in each inference step */
+  std::map<InferStep, std::unique_ptr<TimerStat>> d_stepTime;
+  /** Counts the runs of each inference step that added inferences */
+  HistogramStat<InferStep> d_stepInferences;
   /** the strategy */
   std::vector<InferStep> d_infer_steps;
   /** the effort levels */
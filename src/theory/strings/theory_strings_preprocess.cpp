@@ -51,6 +51,16 @@ Node StringsPreprocess::simplify( Node t, std::vector< Node > &new_nodes ) {
   unsigned prev_new_nodes = new_nodes.size();
   Trace("strings-preprocess-debug") << "StringsPreprocess::simplify: " << t << std::endl;
   Node retNode = t;
+  // Reuse the reduction of t (e.g. from before a pop) with its skolems,
+  // instead of reducing it again with fresh ones.
+  if (d_sc->getReduction(t, retNode, new_nodes))
+  {
+    Trace("strings-preprocess")
+        << "StringsPreprocess::simplify: " << t << " -> " << retNode
+        << " (cached)" << std::endl;
+    d_statistics.d_reductionsReused << t.getKind();
+    return retNode;
+  }
   NodeManager *nm = NodeManager::currentNM();
 
   if( t.getKind() == kind::STRING_SUBSTR ) {
@@ -640,6 +650,10 @@ Node StringsPreprocess::simplify( Node t, std::vector< Node > &new_nodes ) {
       }
     }
     d_statistics.d_reductions << t.getKind();
+    d_sc->setReduction(
+        t,
+        retNode,
+        std::vector<Node>(new_nodes.begin() + prev_new_nodes, new_nodes.end()));
   }
   else
   {
@@ -61,18 +61,14 @@ Node SubstitutionMap::internalSubstitute(TNode t, NodeCache& cache) {
     if (!d_substituteUnderQuantifiers && current.isClosure())
     {
       Debug("substitution::internal") << "--not substituting under quantifier" << endl;
-      cache[current] = current;
+      cache[current] = std::make_pair(Node(current), size_t(0));
       toVisit.pop_back();
       continue;
     }
 
-    NodeMap::iterator find2 = d_substitutions.find(current);
-    if (find2 != d_substitutions.end()) {
-      Node rhs = (*find2).second;
-      Assert(rhs != current);
-      internalSubstitute(rhs, cache);
-      d_substitutions[current] = cache[rhs];
-      cache[current] = cache[rhs];
+    if (d_substitutions.find(current) != d_substitutions.end())
+    {
+      substituteVariable(current, cache);
       toVisit.pop_back();
       continue;
     }
@@ -80,36 +76,38 @@ Node SubstitutionMap::internalSubstitute(TNode t, NodeCache& cache) {
     // Not yet substituted, so process
     if (stackHead.d_children_added)
     {
-      // Children have been processed, so substitute
+      // Children have been processed, so substitute, the result depending on
+      // the substitutions used for the children
+      size_t level = 0;
       NodeBuilder<> builder(current.getKind());
       if (current.getMetaKind() == kind::metakind::PARAMETERIZED) {
-        builder << Node(cache[current.getOperator()]);
+        const std::pair<Node, size_t>& op = cache[current.getOperator()];
+        builder << op.first;
+        level = std::max(level, op.second);
       }
       for (unsigned i = 0; i < current.getNumChildren(); ++ i) {
         Assert(cache.find(current[i]) != cache.end());
-        builder << Node(cache[current[i]]);
+        const std::pair<Node, size_t>& child = cache[current[i]];
+        builder << child.first;
+        level = std::max(level, child.second);
       }
       // Mark the substitution and continue
       Node result = builder;
       if (result != current) {
         find = cache.find(result);
         if (find != cache.end()) {
-          result = find->second;
+          level = std::max(level, find->second.second);
+          result = find->second.first;
         }
-        else {
-          find2 = d_substitutions.find(result);
-          if (find2 != d_substitutions.end()) {
-            Node rhs = (*find2).second;
-            Assert(rhs != result);
-            internalSubstitute(rhs, cache);
-            d_substitutions[result] = cache[rhs];
-            cache[result] = cache[rhs];
-            result = cache[rhs];
-          }
+        else if (d_substitutions.find(result) != d_substitutions.end())
+        {
+          const std::pair<Node, size_t>& r = substituteVariable(result, cache);
+          level = std::max(level, r.second);
+          result = r.first;
         }
       }
       Debug("substitution::internal") << "SubstitutionMap::internalSubstitute(" << t << "): setting " << current << " -> " << result << endl;
-      cache[current] = result;
+      cache[current] = std::make_pair(result, level);
       toVisit.pop_back();
     }
     else
@@ -136,16 +134,57 @@ Node SubstitutionMap::internalSubstitute(TNode t, NodeCache& cache) {
       } else {
         // No children, so we're done
         Debug("substitution::internal") << "SubstitutionMap::internalSubstitute(" << t << "): setting " << current << " -> " << current << endl;
-        cache[current] = current;
+        cache[current] = std::make_pair(Node(current), size_t(0));
         toVisit.pop_back();
       }
     }
   }
 
   // Return the substituted version
-  return cache[t];
+  return cache[t].first;
 }/* SubstitutionMap::internalSubstitute() */
 
+const std::pair<Node, size_t>& SubstitutionMap::substituteVariable(
+    TNode x, NodeCache& cache)
+{
+  Node rhs = (*d_substitutions.find(x)).second;
+  Assert(rhs != x);
+  internalSubstitute(rhs, cache);
+  const std::pair<Node, size_t>& r = cache[rhs];
+  d_substitutions[x] = r.first;
+  std::pair<Node, size_t>& entry = cache[x];
+  entry = std::make_pair(r.first, std::max(r.second, getSubstitutionLevel(x)));
+  return entry;
+}
+
+size_t SubstitutionMap::getSubstitutionLevel(TNode x) const
+{
+  context::CDHashMap<Node, size_t, NodeHashFunction>::const_iterator it =
+      d_substitutionLevels.find(x);
+  Assert(it != d_substitutionLevels.end());
+  return (*it).second;
+}
+
+void SubstitutionMap::removeStaleEntries()
+{
+  for (NodeCache::iterator it = d_substitutionCache.begin();
+       it != d_substitutionCache.end();)
+  {
+    if (it->second.second > d_popLevel)
+    {
+      it = d_substitutionCache.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+  Debug("substitution") << "-- removed the entries above level " << d_popLevel
+                        << ", " << d_substitutionCache.size() << " left"
+                        << endl;
+  d_popLevel = s_noPop;
+}
+
 
 void SubstitutionMap::simplifyRHS(const SubstitutionMap& subMap)
 {
@@ -161,7 +200,7 @@ void SubstitutionMap::simplifyRHS(const SubstitutionMap& subMap)
 void SubstitutionMap::simplifyRHS(TNode x, TNode t) {
   // Temporary substitution cache
   NodeCache tempCache;
-  tempCache[x] = t;
+  tempCache[x] = std::make_pair(Node(t), size_t(0));
 
   // Put the new substitution into the old ones
   NodeMap::iterator it = d_substitutions.begin();
@@ -187,13 +226,15 @@ void SubstitutionMap::addSubstitution(TNode x, TNode t, bool invalidateCache)
   Assert(x != t) << "cannot substitute a term for itself";
 
   d_substitutions[x] = t;
+  size_t level = d_context->getLevel();
+  d_substitutionLevels.insert(x, level);
 
   // Also invalidate the cache if necessary
   if (invalidateCache) {
     d_cacheInvalidated = true;
   }
   else {
-    d_substitutionCache[x] = d_substitutions[x];
+    d_substitutionCache[x] = std::make_pair(Node(t), level);
   }
 }
 
@@ -202,11 +243,14 @@ void SubstitutionMap::addSubstitutions(SubstitutionMap& subMap, bool invalidateC
 {
   SubstitutionMap::NodeMap::const_iterator it = subMap.begin();
   SubstitutionMap::NodeMap::const_iterator it_end = subMap.end();
+  size_t level = d_context->getLevel();
   for (; it != it_end; ++ it) {
     Assert(d_substitutions.find((*it).first) == d_substitutions.end());
     d_substitutions[(*it).first] = (*it).second;
+    d_substitutionLevels.insert((*it).first, level);
     if (!invalidateCache) {
-      d_substitutionCache[(*it).first] = d_substitutions[(*it).first];
+      d_substitutionCache[(*it).first] =
+          std::make_pair(Node((*it).second), level);
     }
   }
   if (invalidateCache) {
@@ -242,8 +286,13 @@ Node SubstitutionMap::apply(TNode t) {
   if (d_cacheInvalidated) {
     d_substitutionCache.clear();
     d_cacheInvalidated = false;
+    d_popLevel = s_noPop;
     Debug("substitution") << "-- reset the cache" << endl;
   }
+  else if (d_popLevel != s_noPop)
+  {
+    removeStaleEntries();
+  }
 
   // Perform the substitution
   Node result = internalSubstitute(t, d_substitutionCache);
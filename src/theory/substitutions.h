@@ -20,6 +20,7 @@
 #define CVC4__THEORY__SUBSTITUTIONS_H
 
 //#include <algorithm>
+#include <algorithm>
 #include <utility>
 #include <vector>
 #include <unordered_map>
@@ -52,11 +53,24 @@ public:
 
 private:
 
-  typedef std::unordered_map<Node, Node, NodeHashFunction> NodeCache;
+  /**
+   * The cache of the substitutions, which maps each node to its substituted
+   * version and to the highest context level of the substitutions used to
+   * compute it, so that only the entries that depend on the substitutions
+   * removed by a pop are stale after this pop.
+   */
+  typedef std::unordered_map<Node, std::pair<Node, size_t>, NodeHashFunction>
+      NodeCache;
 
   /** The variables, in order of addition */
   NodeMap d_substitutions;
 
+  /** The context levels at which the variables were added */
+  context::CDHashMap<Node, size_t, NodeHashFunction> d_substitutionLevels;
+
+  /** The context of the substitutions */
+  context::Context* d_context;
+
   /** Cache of the already performed substitutions */
   NodeCache d_substitutionCache;
 
@@ -66,29 +80,56 @@ private:
   /** Has the cache been invalidated? */
   bool d_cacheInvalidated;
 
+  /**
+   * The lowest context level reached by a pop since the stale entries of the
+   * cache were last removed, or s_noPop if there was no such pop.
+   */
+  size_t d_popLevel;
+
+  /** The value of d_popLevel when there was no pop */
+  static const size_t s_noPop = static_cast<size_t>(-1);
+
   /** Whether to keep substitutions in solved form */
   bool d_solvedForm;
 
   /** Internal method that performs substitution */
   Node internalSubstitute(TNode t, NodeCache& cache);
 
-  /** Helper class to invalidate cache on user pop */
+  /**
+   * Substitutes x, which is in the map, by the substitution of its
+   * right-hand side, and returns the cache entry of x.
+   */
+  const std::pair<Node, size_t>& substituteVariable(TNode x, NodeCache& cache);
+
+  /** Returns the context level at which the variable x was added */
+  size_t getSubstitutionLevel(TNode x) const;
+
+  /** Removes the entries of the cache that are stale after the last pops */
+  void removeStaleEntries();
+
+  /** Helper class to record the pops of the context */
   class CacheInvalidator : public context::ContextNotifyObj {
-    bool& d_cacheInvalidated;
+    context::Context* d_context;
+    size_t& d_popLevel;
   protected:
-   void contextNotifyPop() override { d_cacheInvalidated = true; }
+   void contextNotifyPop() override
+   {
+     // notified after the pop, so the level is the one popped to
+     d_popLevel = std::min(d_popLevel, size_t(d_context->getLevel()));
+   }
 
   public:
-    CacheInvalidator(context::Context* context, bool& cacheInvalidated) :
+    CacheInvalidator(context::Context* context, size_t& popLevel) :
       context::ContextNotifyObj(context),
-      d_cacheInvalidated(cacheInvalidated) {
+      d_context(context),
+      d_popLevel(popLevel) {
     }
 
   };/* class SubstitutionMap::CacheInvalidator */
 
   /**
-   * This object is notified on user pop and marks the SubstitutionMap's
-   * cache as invalidated.
+   * This object is notified on pop and records the level popped to, so that
+   * the stale entries of the SubstitutionMap's cache are removed.
    */
   CacheInvalidator d_cacheInvalidator;
 
@@ -96,11 +137,14 @@ public:
 
   SubstitutionMap(context::Context* context, bool substituteUnderQuantifiers = true, bool solvedForm = false) :
     d_substitutions(context),
+    d_substitutionLevels(context),
+    d_context(context),
     d_substitutionCache(),
     d_substituteUnderQuantifiers(substituteUnderQuantifiers),
     d_cacheInvalidated(false),
+    d_popLevel(s_noPop),
     d_solvedForm(solvedForm),
-    d_cacheInvalidator(context, d_cacheInvalidated)
+    d_cacheInvalidator(context, d_popLevel)
     {
   }
 
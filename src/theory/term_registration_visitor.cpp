@@ -139,14 +139,14 @@ void PreRegisterVisitor::visit(TNode current, TNode parent) {
   if (!Theory::setContains(currentTheoryId, visitedTheories)) {
     visitedTheories = Theory::setInsert(currentTheoryId, visitedTheories);
     d_visited[current] = visitedTheories;
-    Theory* th = d_engine->theoryOf(currentTheoryId);
+    Theory* th = d_engine->theoryOfInLogic(currentTheoryId, current);
     th->preRegisterTerm(current);
     Debug("register::internal") << "PreRegisterVisitor::visit(" << current << "," << parent << "): adding " << currentTheoryId << std::endl;
   }
   if (!Theory::setContains(parentTheoryId, visitedTheories)) {
     visitedTheories = Theory::setInsert(parentTheoryId, visitedTheories);
     d_visited[current] = visitedTheories;
-    Theory* th = d_engine->theoryOf(parentTheoryId);
+    Theory* th = d_engine->theoryOfInLogic(parentTheoryId, current);
     th->preRegisterTerm(current);
     Debug("register::internal") << "PreRegisterVisitor::visit(" << current << "," << parent << "): adding " << parentTheoryId << std::endl;
   }
@@ -154,7 +154,7 @@ void PreRegisterVisitor::visit(TNode current, TNode parent) {
     if (!Theory::setContains(typeTheoryId, visitedTheories)) {
       visitedTheories = Theory::setInsert(typeTheoryId, visitedTheories);
       d_visited[current] = visitedTheories;
-      Theory* th = d_engine->theoryOf(typeTheoryId);
+      Theory* th = d_engine->theoryOfInLogic(typeTheoryId, current);
       th->preRegisterTerm(current);
       Debug("register::internal") << "PreRegisterVisitor::visit(" << current << "," << parent << "): adding " << parentTheoryId << std::endl;
     }
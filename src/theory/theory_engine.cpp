@@ -16,6 +16,8 @@
 
 #include "theory/theory_engine.h"
 
+#include <algorithm>
+#include <chrono>
 #include <list>
 #include <vector>
 
@@ -50,6 +52,7 @@
 #include "theory/theory_model.h"
 #include "theory/theory_traits.h"
 #include "theory/uf/equality_engine.h"
+#include "util/phase_profiler.h"
 #include "util/resource_manager.h"
 
 using namespace std;
@@ -87,6 +90,41 @@ namespace theory {
 
 /* -------------------------------------------------------------------------- */
 
+namespace {
+
+/** Returns the name of the phase of the check of theory id at effort e. */
+const char* checkPhase(theory::TheoryId id, theory::Theory::Effort e)
+{
+  static const char* s_names[theory::THEORY_LAST][3] = {};
+  unsigned i = e == theory::Theory::EFFORT_STANDARD
+                   ? 0
+                   : (e == theory::Theory::EFFORT_FULL ? 1 : 2);
+  if (s_names[id][i] == nullptr)
+  {
+    std::stringstream ss;
+    ss << "check:" << id << ":" << e;
+    s_names[id][i] = PhaseProfiler::intern(ss.str());
+  }
+  return s_names[id][i];
+}
+
+/** Does theory id implement check? */
+bool theoryHasCheck(theory::TheoryId id)
+{
+#ifdef CVC4_FOR_EACH_THEORY_STATEMENT
+#undef CVC4_FOR_EACH_THEORY_STATEMENT
+#endif
+#define CVC4_FOR_EACH_THEORY_STATEMENT(THEORY) \
+  if (id == THEORY)                            \
+  {                                            \
+    return theory::TheoryTraits<THEORY>::hasCheck; \
+  }
+  CVC4_FOR_EACH_THEORY;
+  return false;
+}
+
+}  // namespace
+
 inline void flattenAnd(Node n, std::vector<TNode>& out){
   Assert(n.getKind() == kind::AND);
   for(Node::iterator i=n.begin(), i_end=n.end(); i != i_end; ++i){
@@ -141,8 +179,13 @@ theory::LemmaStatus TheoryEngine::EngineOutputChannel::lemma(TNode lemma,
   PROOF({ registerLemmaRecipe(lemma, lemma, preprocess, d_theory); });
 
   theory::LemmaStatus result =
-      d_engine->lemma(lemma, rule, false, removable, preprocess,
-                      sendAtoms ? d_theory : theory::THEORY_LAST);
+      d_engine->lemma(lemma,
+                      rule,
+                      false,
+                      removable,
+                      preprocess,
+                      sendAtoms ? d_theory : theory::THEORY_LAST,
+                      d_theory);
   return result;
 }
 
@@ -241,7 +284,8 @@ theory::LemmaStatus TheoryEngine::EngineOutputChannel::splitLemma(
   Debug("pf::explain") << "TheoryEngine::EngineOutputChannel::splitLemma( "
                        << lemma << " )" << std::endl;
   theory::LemmaStatus result =
-      d_engine->lemma(lemma, RULE_SPLIT, false, removable, false, d_theory);
+      d_engine->lemma(
+          lemma, RULE_SPLIT, false, removable, false, d_theory, d_theory);
   return result;
 }
 
@@ -310,6 +354,14 @@ void TheoryEngine::eqNotifyNewClass(TNode t){
   }
 }
 
+void TheoryEngine::eqNotifyPostMerge(TNode t1, TNode t2)
+{
+  if (d_logicInfo.isQuantified())
+  {
+    d_quantEngine->eqNotifyPostMerge(t1, t2);
+  }
+}
+
 TheoryEngine::TheoryEngine(context::Context* context,
                            context::UserContext* userContext,
                            RemoveTermFormulas& iteRemover,
@@ -339,6 +391,7 @@ TheoryEngine::TheoryEngine(context::Context* context,
       d_propagationMapTimestamp(context, 0),
       d_propagatedLiterals(context),
       d_propagatedLiteralsIndex(context, 0),
+      d_inCheck(false),
       d_atomRequests(context),
       d_tform_remover(iteRemover),
       d_combineTheoriesTime("TheoryEngine::combineTheoriesTime"),
@@ -352,7 +405,10 @@ TheoryEngine::TheoryEngine(context::Context* context,
       d_sharedTermsVisitor(d_sharedTerms),
       d_theoryAlternatives(),
       d_attr_handle(),
-      d_arithSubstitutionsAdded("theory::arith::zzz::arith::substitutions", 0)
+      d_arithSubstitutionsAdded("theory::arith::zzz::arith::substitutions", 0),
+      d_duplicateLemmas("theory::duplicateLemmas", 0),
+      d_checksSkipped("theory::checksSkipped", 0),
+      d_checksDeferred("theory::checksDeferred", 0)
 {
   for(TheoryId theoryId = theory::THEORY_FIRST; theoryId != theory::THEORY_LAST;
       ++ theoryId)
@@ -370,6 +426,9 @@ TheoryEngine::TheoryEngine(context::Context* context,
 #endif
 
   smtStatisticsRegistry()->registerStat(&d_arithSubstitutionsAdded);
+  smtStatisticsRegistry()->registerStat(&d_duplicateLemmas);
+  smtStatisticsRegistry()->registerStat(&d_checksSkipped);
+  smtStatisticsRegistry()->registerStat(&d_checksDeferred);
 }
 
 TheoryEngine::~TheoryEngine() {
@@ -395,6 +454,9 @@ TheoryEngine::~TheoryEngine() {
 
   smtStatisticsRegistry()->unregisterStat(&d_combineTheoriesTime);
   smtStatisticsRegistry()->unregisterStat(&d_arithSubstitutionsAdded);
+  smtStatisticsRegistry()->unregisterStat(&d_duplicateLemmas);
+  smtStatisticsRegistry()->unregisterStat(&d_checksSkipped);
+  smtStatisticsRegistry()->unregisterStat(&d_checksDeferred);
 }
 
 void TheoryEngine::interrupt() { d_interrupted = true; }
@@ -549,18 +611,55 @@ void TheoryEngine::dumpAssertions(const char* tag) {
  * Check all (currently-active) theories for conflicts.
  * @param effort the effort level to use
  */
+namespace {
+
+/**
+ * Marks that the theory engine is in a call to check() during its lifetime,
+ * and clears the lemmas of the check when the check ends.
+ */
+class CheckScope
+{
+ public:
+  CheckScope(bool& inCheck,
+             std::unordered_map<Node,
+                                std::pair<theory::LemmaStatus, bool>,
+                                NodeHashFunction>& lemmas)
+      : d_inCheck(inCheck), d_lemmas(lemmas)
+  {
+    d_inCheck = true;
+  }
+  ~CheckScope()
+  {
+    d_inCheck = false;
+    d_lemmas.clear();
+  }
+
+ private:
+  bool& d_inCheck;
+  std::unordered_map<Node,
+                     std::pair<theory::LemmaStatus, bool>,
+                     NodeHashFunction>& d_lemmas;
+};
+
+}  // namespace
+
 void TheoryEngine::check(Theory::Effort effort) {
   // spendResource();
 
   // Reset the interrupt flag
   d_interrupted = false;
 
+  CheckScope checkScope(d_inCheck, d_checkLemmas);
+
 #ifdef CVC4_FOR_EACH_THEORY_STATEMENT
 #undef CVC4_FOR_EACH_THEORY_STATEMENT
 #endif
 #define CVC4_FOR_EACH_THEORY_STATEMENT(THEORY) \
     if (theory::TheoryTraits<THEORY>::hasCheck && d_logicInfo.isTheoryEnabled(THEORY)) { \
-       theoryOf(THEORY)->check(effort); \
+       { \
+         PhaseScope phase(checkPhase(THEORY, effort)); \
+         theoryOf(THEORY)->check(effort); \
+       } \
        if (d_inConflict) { \
          Debug("conflict") << THEORY << " in conflict. " << std::endl; \
          break; \
@@ -605,7 +704,18 @@ void TheoryEngine::check(Theory::Effort effort) {
       d_factsAsserted = false;
 
       // Do the checking
-      CVC4_FOR_EACH_THEORY;
+      if (options::theoryCheckSchedule())
+      {
+        checkScheduled(effort);
+        if (d_inConflict)
+        {
+          break;
+        }
+      }
+      else
+      {
+        CVC4_FOR_EACH_THEORY;
+      }
 
       if(Dump.isOn("missed-t-conflicts")) {
         Dump("missed-t-conflicts")
@@ -706,6 +816,94 @@ void TheoryEngine::check(Theory::Effort effort) {
   }
 }
 
+void TheoryEngine::checkScheduled(Theory::Effort effort)
+{
+  if (d_checkTheories.empty())
+  {
+    for (TheoryId id = THEORY_FIRST; id < THEORY_LAST; ++id)
+    {
+      if (theoryHasCheck(id) && d_logicInfo.isTheoryEnabled(id))
+      {
+        d_checkTheories.push_back(id);
+      }
+    }
+  }
+  bool full = Theory::fullEffort(effort);
+  std::vector<TheoryId> order = d_checkTheories;
+  if (!full)
+  {
+    // Strings depends on arithmetic and quantifiers must be last: these two
+    // keep their place at the end, the others are ordered by the number of
+    // conflicts they found per second of checking.
+    std::vector<TheoryId>::iterator last = std::stable_partition(
+        order.begin(), order.end(), [](TheoryId id) {
+          return id != THEORY_STRINGS && id != THEORY_QUANTIFIERS;
+        });
+    std::stable_sort(order.begin(), last, [this](TheoryId a, TheoryId b) {
+      const CheckInfo& ia = d_checkInfo[a];
+      const CheckInfo& ib = d_checkInfo[b];
+      double sa = (ia.d_conflicts + 1) / (ia.d_time + 1e-3);
+      double sb = (ib.d_conflicts + 1) / (ib.d_time + 1e-3);
+      return sa > sb;
+    });
+  }
+  // the average full effort check time of the cheapest theory sending lemmas
+  // in this round
+  double lemmaTime = -1;
+  for (TheoryId id : order)
+  {
+    Theory* t = theoryOf(id);
+    CheckInfo& info = d_checkInfo[id];
+    double avgFullTime =
+        info.d_fullChecks == 0 ? 0 : info.d_fullTime / info.d_fullChecks;
+    if (!full && t->done())
+    {
+      // no new facts since the last check
+      ++d_checksSkipped;
+      continue;
+    }
+    if (full && lemmaTime >= 0
+        && avgFullTime > options::theoryCheckDeferRatio() * lemmaTime)
+    {
+      // the lemmas already sent are processed first, the SAT solver comes
+      // back to a full effort check where this theory is checked
+      Trace("theory::schedule") << "TheoryEngine::checkScheduled: defer " << id
+                                << std::endl;
+      ++d_checksDeferred;
+      continue;
+    }
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    {
+      PhaseScope phase(checkPhase(id, effort));
+      t->check(effort);
+    }
+    double time = std::chrono::duration<double>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+    if (full)
+    {
+      ++info.d_fullChecks;
+      info.d_fullTime += time;
+    }
+    else
+    {
+      ++info.d_checks;
+      info.d_time += time;
+    }
+    if (d_inConflict)
+    {
+      ++info.d_conflicts;
+      Debug("conflict") << id << " in conflict. " << std::endl;
+      return;
+    }
+    if (full && d_lemmasAdded && lemmaTime < 0)
+    {
+      lemmaTime = info.d_fullTime / info.d_fullChecks;
+    }
+  }
+}
+
 void TheoryEngine::combineTheories() {
 
   Trace("combineTheories") << "TheoryEngine::combineTheories()" << endl;
@@ -744,16 +942,25 @@ void TheoryEngine::combineTheories() {
 
     // The equality in question (order for no repetition)
     Node equality = carePair.d_a.eqNode(carePair.d_b);
-    // EqualityStatus es = getEqualityStatus(carePair.d_a, carePair.d_b);
-    // Debug("combineTheories") << "TheoryEngine::combineTheories(): " <<
-    //   (es == EQUALITY_TRUE_AND_PROPAGATED ? "EQUALITY_TRUE_AND_PROPAGATED" :
-    //   es == EQUALITY_FALSE_AND_PROPAGATED ? "EQUALITY_FALSE_AND_PROPAGATED" :
-    //   es == EQUALITY_TRUE ? "EQUALITY_TRUE" :
-    //   es == EQUALITY_FALSE ? "EQUALITY_FALSE" :
-    //   es == EQUALITY_TRUE_IN_MODEL ? "EQUALITY_TRUE_IN_MODEL" :
-    //   es == EQUALITY_FALSE_IN_MODEL ? "EQUALITY_FALSE_IN_MODEL" :
-    //   es == EQUALITY_UNKNOWN ? "EQUALITY_UNKNOWN" :
-    //    "Unexpected case") << endl;
+
+    bool phase = true;
+    if (options::tcModelPhase())
+    {
+      // the equalities that the shared terms database already knows are
+      // known to all the theories sharing these terms
+      if (d_sharedTerms.isShared(carePair.d_a)
+          && d_sharedTerms.isShared(carePair.d_b)
+          && (d_sharedTerms.areEqual(carePair.d_a, carePair.d_b)
+              || d_sharedTerms.areDisequal(carePair.d_a, carePair.d_b)))
+      {
+        Debug("combineTheories")
+            << "TheoryEngine::combineTheories(): already entailed" << endl;
+        continue;
+      }
+      // follow the model of the theory of the type of the terms
+      EqualityStatus es = getEqualityStatus(carePair.d_a, carePair.d_b);
+      phase = es != EQUALITY_FALSE && es != EQUALITY_FALSE_IN_MODEL;
+    }
 
     // We need to split on it
     Debug("combineTheories") << "TheoryEngine::combineTheories(): requesting a split " << endl;
@@ -765,18 +972,8 @@ void TheoryEngine::combineTheories() {
           false,
           carePair.d_theory);
 
-    // This code is supposed to force preference to follow what the theory models already have
-    // but it doesn't seem to make a big difference - need to explore more -Clark
-    // if (true) {
-    //   if (es == EQUALITY_TRUE || es == EQUALITY_TRUE_IN_MODEL) {
     Node e = ensureLiteral(equality);
-    d_propEngine->requirePhase(e, true);
-    //   }
-    //   else if (es == EQUALITY_FALSE_IN_MODEL) {
-    //     Node e = ensureLiteral(equality);
-    //     d_propEngine->requirePhase(e, false);
-    //   }
-    // }
+    d_propEngine->requirePhase(e, phase);
   }
 }
 
@@ -984,7 +1181,7 @@ bool TheoryEngine::presolve() {
 #undef CVC4_FOR_EACH_THEORY_STATEMENT
 #endif
 #define CVC4_FOR_EACH_THEORY_STATEMENT(THEORY) \
-    if (theory::TheoryTraits<THEORY>::hasPresolve) {    \
+    if (theory::TheoryTraits<THEORY>::hasPresolve && theoryOf(THEORY) != nullptr) { \
       theoryOf(THEORY)->presolve(); \
       if(d_inConflict) { \
         return true; \
@@ -1013,7 +1210,8 @@ void TheoryEngine::postsolve() {
 #undef CVC4_FOR_EACH_THEORY_STATEMENT
 #endif
 #define CVC4_FOR_EACH_THEORY_STATEMENT(THEORY)    \
-  if (theory::TheoryTraits<THEORY>::hasPostsolve) \
+  if (theory::TheoryTraits<THEORY>::hasPostsolve  \
+      && theoryOf(THEORY) != nullptr)             \
   {                                               \
     theoryOf(THEORY)->postsolve();                \
     Assert(!d_inConflict || wasInConflict)        \
@@ -1054,7 +1252,7 @@ void TheoryEngine::ppStaticLearn(TNode in, NodeBuilder<>& learned) {
 #undef CVC4_FOR_EACH_THEORY_STATEMENT
 #endif
 #define CVC4_FOR_EACH_THEORY_STATEMENT(THEORY) \
-  if (theory::TheoryTraits<THEORY>::hasPpStaticLearn) { \
+  if (theory::TheoryTraits<THEORY>::hasPpStaticLearn && theoryOf(THEORY) != nullptr) { \
     theoryOf(THEORY)->ppStaticLearn(in, learned); \
   }
 
@@ -1078,12 +1276,28 @@ void TheoryEngine::shutdown() {
   d_ppCache.clear();
 }
 
+theory::Theory* TheoryEngine::theoryOfInLogic(theory::TheoryId theoryId,
+                                              TNode n) const
+{
+  Assert(theoryId < theory::THEORY_LAST);
+  if (d_theoryTable[theoryId] == nullptr)
+  {
+    stringstream ss;
+    ss << "The logic was specified as " << d_logicInfo.getLogicString()
+       << ", which doesn't include " << theoryId
+       << ", but found a term in that theory." << endl
+       << "The term:" << endl
+       << n;
+    throw LogicException(ss.str());
+  }
+  return d_theoryTable[theoryId];
+}
+
 theory::Theory::PPAssertStatus TheoryEngine::solve(TNode literal, SubstitutionMap& substitutionOut) {
   // Reset the interrupt flag
   d_interrupted = false;
 
   TNode atom = literal.getKind() == kind::NOT ? literal[0] : literal;
-  Trace("theory::solve") << "TheoryEngine::solve(" << literal << "): solving with " << theoryOf(atom)->getId() << endl;
 
   if(! d_logicInfo.isTheoryEnabled(Theory::theoryOf(atom)) &&
      Theory::theoryOf(atom) != THEORY_SAT_SOLVER) {
@@ -1095,6 +1309,7 @@ theory::Theory::PPAssertStatus TheoryEngine::solve(TNode literal, SubstitutionMa
        << literal;
     throw LogicException(ss.str());
   }
+  Trace("theory::solve") << "TheoryEngine::solve(" << literal << "): solving with " << theoryOf(atom)->getId() << endl;
 
   Theory::PPAssertStatus solveStatus = theoryOf(atom)->ppAssert(literal, substitutionOut);
   Trace("theory::solve") << "TheoryEngine::solve(" << literal << ") => " << solveStatus << endl;
@@ -1109,7 +1324,7 @@ Node TheoryEngine::ppTheoryRewrite(TNode term) {
   }
   unsigned nc = term.getNumChildren();
   if (nc == 0) {
-    return theoryOf(term)->ppRewrite(term);
+    return theoryOfInLogic(Theory::theoryOf(term), term)->ppRewrite(term);
   }
   Trace("theory-pp") << "ppTheoryRewrite { " << term << endl;
 
@@ -1131,7 +1346,8 @@ Node TheoryEngine::ppTheoryRewrite(TNode term) {
     }
     newTerm = Rewriter::rewrite(Node(newNode));
   }
-  Node newTerm2 = theoryOf(newTerm)->ppRewrite(newTerm);
+  Node newTerm2 =
+      theoryOfInLogic(Theory::theoryOf(newTerm), newTerm)->ppRewrite(newTerm);
   if (newTerm != newTerm2) {
     newTerm = ppTheoryRewrite(Rewriter::rewrite(newTerm2));
   }
@@ -1862,10 +2078,26 @@ theory::LemmaStatus TheoryEngine::lemma(TNode node,
                                         bool negated,
                                         bool removable,
                                         bool preprocess,
-                                        theory::TheoryId atomsTo) {
+                                        theory::TheoryId atomsTo,
+                                        theory::TheoryId from) {
   // For resource-limiting (also does a time check).
   // spendResource();
 
+  // A lemma that was already sent in this check, with no atoms to send, is
+  // already in the SAT solver.
+  Node key;
+  if (d_inCheck && atomsTo == theory::THEORY_LAST)
+  {
+    key = negated ? node.notNode() : Node(node);
+    auto it = d_checkLemmas.find(key);
+    if (it != d_checkLemmas.end() && (removable || !it->second.second))
+    {
+      ++d_duplicateLemmas;
+      d_lemmasAdded = true;
+      return it->second.first;
+    }
+  }
+
   // Do we need to check atoms
   if (atomsTo != theory::THEORY_LAST) {
     Debug("theory::atoms") << "TheoryEngine::lemma(" << node << ", " << atomsTo << ")" << endl;
@@ -1910,10 +2142,12 @@ theory::LemmaStatus TheoryEngine::lemma(TNode node,
   }
 
   // assert to prop engine
-  d_propEngine->assertLemma(additionalLemmas[0], negated, removable, rule, node);
+  d_propEngine->assertLemma(
+      additionalLemmas[0], negated, removable, rule, node, from);
   for (unsigned i = 1; i < additionalLemmas.size(); ++ i) {
     additionalLemmas.replace(i, theory::Rewriter::rewrite(additionalLemmas[i]));
-    d_propEngine->assertLemma(additionalLemmas[i], false, removable, rule, node);
+    d_propEngine->assertLemma(
+        additionalLemmas[i], false, removable, rule, node, from);
   }
 
   // WARNING: Below this point don't assume additionalLemmas[0] to be not negated.
@@ -1933,7 +2167,13 @@ theory::LemmaStatus TheoryEngine::lemma(TNode node,
 
   // Lemma analysis isn't online yet; this lemma may only live for this
   // user level.
-  return theory::LemmaStatus(additionalLemmas[0], d_userContext->getLevel());
+  theory::LemmaStatus status(additionalLemmas[0], d_userContext->getLevel());
+  if (!key.isNull())
+  {
+    d_checkLemmas.erase(key);
+    d_checkLemmas.emplace(key, std::make_pair(status, removable));
+  }
+  return status;
 }
 
 void TheoryEngine::conflict(TNode conflict, TheoryId theoryId) {
@@ -1979,7 +2219,13 @@ void TheoryEngine::conflict(TNode conflict, TheoryId theoryId) {
     Node fullConflict = mkExplanation(explanationVector);
     Debug("theory::conflict") << "TheoryEngine::conflict(" << conflict << ", " << theoryId << "): full = " << fullConflict << endl;
     Assert(properConflict(fullConflict));
-    lemma(fullConflict, RULE_CONFLICT, true, true, false, THEORY_LAST);
+    lemma(fullConflict,
+          RULE_CONFLICT,
+          true,
+          true,
+          false,
+          THEORY_LAST,
+          theoryId);
 
   } else {
     // When only one theory, the conflict should need no processing
@@ -2009,7 +2255,8 @@ void TheoryEngine::conflict(TNode conflict, TheoryId theoryId) {
         ProofManager::getCnfProof()->setProofRecipe(proofRecipe);
       });
 
-    lemma(conflict, RULE_CONFLICT, true, true, false, THEORY_LAST);
+    lemma(
+        conflict, RULE_CONFLICT, true, true, false, THEORY_LAST, theoryId);
   }
 
   PROOF({
@@ -2028,10 +2275,6 @@ void TheoryEngine::staticInitializeBVOptions(
       throw ModalException(
           "Slicer currently only supports pure QF_BV formulas. Use "
           "--bv-eq-slicer=off");
-    if (options::incrementalSolving())
-      throw ModalException(
-          "Slicer does not currently support incremental mode. Use "
-          "--bv-eq-slicer=off");
     if (options::produceModels())
       throw ModalException(
           "Slicer does not currently support model generation. Use "
@@ -2044,7 +2287,6 @@ void TheoryEngine::staticInitializeBVOptions(
   else if (options::bitvectorEqualitySlicer() == options::BvSlicerMode::AUTO)
   {
     if ((!d_logicInfo.isPure(theory::THEORY_BV) || d_logicInfo.isQuantified())
-        || options::incrementalSolving()
         || options::produceModels())
       return;
 
@@ -176,6 +176,7 @@ class TheoryEngine {
     }
     void eqNotifyPostMerge(TNode t1, TNode t2) override
     {
+      d_te.eqNotifyPostMerge(t1, t2);
     }
     void eqNotifyDisequal(TNode t1, TNode t2, TNode reason) override
     {
@@ -421,6 +422,21 @@ class TheoryEngine {
    */
   bool d_lemmasAdded;
 
+  /** Whether we are in a call to check() */
+  bool d_inCheck;
+
+  /**
+   * The lemmas sent during the current call to check(), as they are given
+   * to the SAT solver, with their status and whether they are removable. A
+   * lemma that is sent again during the same check is not preprocessed and
+   * converted to CNF again, since its clauses cannot be removed by the SAT
+   * solver before the check ends.
+   */
+  std::unordered_map<Node,
+                     std::pair<theory::LemmaStatus, bool>,
+                     NodeHashFunction>
+      d_checkLemmas;
+
   /**
    * A variable to mark if the OutputChannel was "used" by any theory
    * since the start of the last check.  If it has been, we require
@@ -439,13 +455,15 @@ class TheoryEngine {
    * @param negated should the lemma be asserted negated
    * @param removable can the lemma be remove (restrictions apply)
    * @param needAtoms if not THEORY_LAST, then
+   * @param from the theory that sent the lemma, or THEORY_LAST
    */
   theory::LemmaStatus lemma(TNode node,
                             ProofRule rule,
                             bool negated,
                             bool removable,
                             bool preprocess,
-                            theory::TheoryId atomsTo);
+                            theory::TheoryId atomsTo,
+                            theory::TheoryId from = theory::THEORY_LAST);
 
   /** Enusre that the given atoms are send to the given theory */
   void ensureLemmaAtoms(const std::vector<TNode>& atoms, theory::TheoryId theory);
@@ -802,6 +820,15 @@ public:
     return d_theoryTable[theoryId];
   }
 
+  /**
+   * Get the theory of the given theory id, to which the term n is sent.
+   * Only the theories of the logic are constructed, this throws a
+   * LogicException if the theory is not.
+   *
+   * @returns the theory
+   */
+  theory::Theory* theoryOfInLogic(theory::TheoryId theoryId, TNode n) const;
+
   inline bool isTheoryEnabled(theory::TheoryId theoryId) const {
     return d_logicInfo.isTheoryEnabled(theoryId);
   }
@@ -933,6 +960,41 @@ private:
  private:
   IntStat d_arithSubstitutionsAdded;
 
+  /** The number of lemmas that were sent again during the same check */
+  IntStat d_duplicateLemmas;
+
+  /**
+   * Scheduling of the checks of the theories, if
+   * options::theoryCheckSchedule() is true. The standard effort checks of
+   * theories without new facts are skipped, and the other ones are run
+   * cheapest and most conflicting first. The full effort checks run in the
+   * fixed order, but those of the expensive theories are deferred to a later
+   * round once a cheaper theory has sent lemmas in this one.
+   */
+  struct CheckInfo
+  {
+    CheckInfo()
+        : d_checks(0), d_conflicts(0), d_time(0), d_fullChecks(0), d_fullTime(0)
+    {
+    }
+    /** The number of standard effort checks, and how many were conflicts */
+    uint64_t d_checks;
+    uint64_t d_conflicts;
+    /** The time spent in standard effort checks, in seconds */
+    double d_time;
+    /** The number of full effort checks, and the time spent in them */
+    uint64_t d_fullChecks;
+    double d_fullTime;
+  };
+  CheckInfo d_checkInfo[theory::THEORY_LAST];
+  /** The theories to check, in their fixed order */
+  std::vector<theory::TheoryId> d_checkTheories;
+  /** Run the checks of the theories at effort, in the scheduled order */
+  void checkScheduled(theory::Theory::Effort effort);
+  /** The number of checks skipped and deferred by the scheduling */
+  IntStat d_checksSkipped;
+  IntStat d_checksDeferred;
+
 };/* class TheoryEngine */
 
 }/* CVC4 namespace */
@@ -13,6 +13,8 @@
  **/
 #include "theory/theory_model_builder.h"
 
+#include <algorithm>
+
 #include "expr/dtype.h"
 #include "options/quantifiers_options.h"
 #include "options/smt_options.h"
@@ -91,7 +93,7 @@ bool TheoryEngineModelBuilder::isAssignerActive(TheoryModel* tm, Assigner& a)
     return true;
   }
   std::vector<Node>& eset = a.d_assignExcSet;
-  std::map<Node, Node>::iterator it;
+  NodeMap::iterator it;
   for (unsigned i = 0, size = eset.size(); i < size; i++)
   {
     // Members of exclusion set must have values, otherwise we are not yet
@@ -203,7 +205,7 @@ void TheoryEngineModelBuilder::assignConstantRep(TheoryModel* tm,
 bool TheoryEngineModelBuilder::isExcludedCdtValue(
     Node val,
     std::set<Node>* repSet,
-    std::map<Node, Node>& assertedReps,
+    NodeMap& assertedReps,
     Node eqc)
 {
   Trace("model-builder-debug")
@@ -444,7 +446,7 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
 
   // Process all terms in the equality engine, store representatives for each EC
   d_constantReps.clear();
-  std::map<Node, Node> assertedReps;
+  NodeMap assertedReps;
   TypeSet typeConstSet, typeRepSet, typeNoRepSet;
   // Compute type enumerator properties. This code ensures we do not
   // enumerate terms that have uninterpreted constants that violate the
@@ -553,7 +555,7 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
   std::map<Node, Assigner> eqcToAssigner;
   // Maps equivalence classes to the equivalence class that maps to its assigner
   // object in the above map.
-  std::map<Node, Node> eqcToAssignerMaster;
+  NodeMap eqcToAssignerMaster;
   // Compute the above information
   computeAssignableInfo(
       tm, tep, assignableEqc, evaluableEqc, eqcToAssigner, eqcToAssignerMaster);
@@ -753,7 +755,7 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
                              << endl;
       bool assignable, evaluable CVC4_UNUSED;
       std::map<Node, Assigner>::iterator itAssigner;
-      std::map<Node, Node>::iterator itAssignerM;
+      NodeMap::iterator itAssignerM;
       set<Node>* repSet = typeRepSet.getSet(t);
       for (i = noRepSet.begin(); i != noRepSet.end();)
       {
@@ -911,20 +913,11 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
 
   Trace("model-builder") << "Copy representatives to model..." << std::endl;
   tm->d_reps.clear();
-  std::map<Node, Node>::iterator itMap;
-  for (itMap = d_constantReps.begin(); itMap != d_constantReps.end(); ++itMap)
-  {
-    tm->d_reps[itMap->first] = itMap->second;
-    tm->d_rep_set.add(itMap->second.getType(), itMap->second);
-  }
+  addRepresentatives(tm, d_constantReps);
 
   Trace("model-builder") << "Make sure ECs have reps..." << std::endl;
   // Make sure every EC has a rep
-  for (itMap = assertedReps.begin(); itMap != assertedReps.end(); ++itMap)
-  {
-    tm->d_reps[itMap->first] = itMap->second;
-    tm->d_rep_set.add(itMap->second.getType(), itMap->second);
-  }
+  addRepresentatives(tm, assertedReps);
   for (it = typeNoRepSet.begin(); it != typeNoRepSet.end(); ++it)
   {
     set<Node>& noRepSet = TypeSet::getSet(it);
@@ -946,13 +939,34 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
   tm->d_modelBuiltSuccess = true;
   return true;
 }
+void TheoryEngineModelBuilder::addRepresentatives(TheoryModel* tm,
+                                                  const NodeMap& reps)
+{
+  // the representatives are added in the order of the ids of their
+  // equivalence classes, so that the representative sets of the model do
+  // not depend on the order of the hash map
+  std::vector<Node> eqcs;
+  eqcs.reserve(reps.size());
+  for (const std::pair<const Node, Node>& r : reps)
+  {
+    eqcs.push_back(r.first);
+  }
+  std::sort(eqcs.begin(), eqcs.end());
+  for (const Node& eqc : eqcs)
+  {
+    const Node& rep = reps.find(eqc)->second;
+    tm->d_reps[eqc] = rep;
+    tm->d_rep_set.add(rep.getType(), rep);
+  }
+}
+
 void TheoryEngineModelBuilder::computeAssignableInfo(
     TheoryModel* tm,
     TypeEnumeratorProperties& tep,
     std::unordered_set<Node, NodeHashFunction>& assignableEqc,
     std::unordered_set<Node, NodeHashFunction>& evaluableEqc,
     std::map<Node, Assigner>& eqcToAssigner,
-    std::map<Node, Node>& eqcToAssignerMaster)
+    NodeMap& eqcToAssignerMaster)
 {
   eq::EqualityEngine* ee = tm->d_equalityEngine;
   bool computeAssigners = tm->hasAssignmentExclusionSets();
@@ -1131,7 +1145,7 @@ void TheoryEngineModelBuilder::debugCheckModel(TheoryModel* tm)
     return;
   }
   eq::EqClassesIterator eqcs_i = eq::EqClassesIterator(tm->d_equalityEngine);
-  std::map<Node, Node>::iterator itMap;
+  NodeMap::iterator itMap;
   // Check that every term evaluates to its representative in the model
   for (eqcs_i = eq::EqClassesIterator(tm->d_equalityEngine);
        !eqcs_i.isFinished();
@@ -1176,7 +1190,7 @@ void TheoryEngineModelBuilder::debugCheckModel(TheoryModel* tm)
 
 Node TheoryEngineModelBuilder::normalize(TheoryModel* m, TNode r, bool evalOnly)
 {
-  std::map<Node, Node>::iterator itMap = d_constantReps.find(r);
+  NodeMap::iterator itMap = d_constantReps.find(r);
   if (itMap != d_constantReps.end())
   {
     return (*itMap).second;
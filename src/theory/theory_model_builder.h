@@ -213,7 +213,12 @@ class TheoryEngineModelBuilder : public ModelBuilder
   NodeMap d_normalizedCache;
   /** mapping from terms to the constant associated with their equivalence class
    */
-  std::map<Node, Node> d_constantReps;
+  NodeMap d_constantReps;
+  /**
+   * Add the representatives reps of equivalence classes to the model tm, in
+   * a deterministic order.
+   */
+  void addRepresentatives(TheoryModel* tm, const NodeMap& reps);
 
   /** Theory engine model builder assigner class
    *
@@ -290,7 +295,7 @@ class TheoryEngineModelBuilder : public ModelBuilder
       std::unordered_set<Node, NodeHashFunction>& assignableEqc,
       std::unordered_set<Node, NodeHashFunction>& evaluableEqc,
       std::map<Node, Assigner>& eqcToAssigner,
-      std::map<Node, Node>& eqcToAssignerMaster);
+      NodeMap& eqcToAssignerMaster);
   //------------------------------------for codatatypes
   /** is v an excluded codatatype value?
    *
@@ -311,7 +316,7 @@ class TheoryEngineModelBuilder : public ModelBuilder
    */
   bool isExcludedCdtValue(Node v,
                           std::set<Node>* repSet,
-                          std::map<Node, Node>& assertedReps,
+                          NodeMap& assertedReps,
                           Node eqc);
   /** is codatatype value match
    *
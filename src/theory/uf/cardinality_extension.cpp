@@ -11,9 +11,10 @@
  **
  ** \brief Implementation of theory of UF with cardinality.
  **/
-
 #include "theory/uf/cardinality_extension.h"
 
+#include <algorithm>
+
 #include "options/uf_options.h"
 #include "theory/uf/theory_uf.h"
 #include "theory/uf/equality_engine.h"
@@ -304,12 +305,17 @@ bool Region::check( Theory::Effort level, int cardinality,
               //}
             }
           }
-          //choose remaining nodes with the highest degrees
+          //choose remaining nodes with the highest degrees, only the nodes
+          //that are chosen need to be sorted
           sortInternalDegree sidObj;
           sidObj.r = this;
-          std::sort( newClique.begin(), newClique.end(), sidObj );
-          int offset = ( cardinality - d_testCliqueSize ) + 1;
-          newClique.erase( newClique.begin() + offset, newClique.end() );
+          size_t offset = std::min(
+              newClique.size(), size_t(cardinality - d_testCliqueSize + 1));
+          std::partial_sort(newClique.begin(),
+                            newClique.begin() + offset,
+                            newClique.end(),
+                            sidObj);
+          newClique.resize(offset);
         }else{
           //scan for the highest degree
           int maxDeg = -1;
@@ -226,7 +226,7 @@ EqualityNodeId EqualityEngine::newNode(TNode node) {
 
   // Register the new id of the term
   EqualityNodeId newId = d_nodes.size();
-  d_nodeIds[node] = newId;
+  d_nodeIds.insert(node.getId(), newId);
   // Add the node to it's position
   d_nodes.push_back(node);
   // Note if this is an application or not
@@ -398,12 +398,12 @@ void EqualityEngine::addTermInternal(TNode t, bool isOperator) {
 }
 
 bool EqualityEngine::hasTerm(TNode t) const {
-  return d_nodeIds.find(t) != d_nodeIds.end();
+  return d_nodeIds.find(t.getId()) != null_id;
 }
 
 EqualityNodeId EqualityEngine::getNodeId(TNode node) const {
   Assert(hasTerm(node)) << node;
-  return (*d_nodeIds.find(node)).second;
+  return d_nodeIds.find(node.getId());
 }
 
 EqualityNode& EqualityEngine::getEqualityNode(TNode t) {
@@ -859,6 +859,7 @@ void EqualityEngine::backtrack() {
     }
 
     d_equalityEdges.resize(2 * d_assertedEqualitiesCount);
+    d_explanationCache.clear();
   }
 
   if (d_triggerTermSetUpdates.size() > d_triggerTermSetUpdatesSize) {
@@ -900,7 +901,7 @@ void EqualityEngine::backtrack() {
     for(int i = d_nodes.size() - 1, i_end = (int)d_nodesCount; i >= i_end; -- i) {
       // Remove from the node -> id map
       Debug("equality") << d_name << "::eq::backtrack(): removing node " << d_nodes[i] << std::endl;
-      d_nodeIds.erase(d_nodes[i]);
+      d_nodeIds.erase(d_nodes[i].getId());
 
       const FunctionApplication& app = d_applications[i].d_original;
       if (!app.isNull()) {
@@ -987,6 +988,26 @@ void EqualityEngine::explainEquality(TNode t1, TNode t2, bool polarity,
 
   std::map<std::pair<EqualityNodeId, EqualityNodeId>, EqProof*> cache;
   if (polarity) {
+    if (eqp == nullptr
+        && getEqualityNode(t1Id).getFind() == getEqualityNode(t2Id).getFind())
+    {
+      EqualityPair key = std::minmax(t1Id, t2Id);
+      std::unordered_map<EqualityPair,
+                         std::vector<TNode>,
+                         EqualityPairHashFunction>::const_iterator it =
+          d_explanationCache.find(key);
+      if (it != d_explanationCache.end())
+      {
+        equalities.insert(
+            equalities.end(), it->second.begin(), it->second.end());
+        return;
+      }
+      size_t start = equalities.size();
+      getExplanation(t1Id, t2Id, equalities, cache, eqp);
+      d_explanationCache[key].assign(equalities.begin() + start,
+                                     equalities.end());
+      return;
+    }
     // Get the explanation
     getExplanation(t1Id, t2Id, equalities, cache, eqp);
   } else {
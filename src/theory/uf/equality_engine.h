@@ -251,7 +251,7 @@ private:
   std::map<unsigned, const PathReconstructionNotify*> d_pathReconstructionTriggers;
 
   /** Map from nodes to their ids */
-  std::unordered_map<TNode, EqualityNodeId, TNodeHashFunction> d_nodeIds;
+  NodeIdMap d_nodeIds;
 
   /** Map from function applications to their ids */
   typedef std::unordered_map<FunctionApplication, EqualityNodeId, FunctionApplicationHashFunction> ApplicationIdsMap;
@@ -540,6 +540,19 @@ private:
       std::map<std::pair<EqualityNodeId, EqualityNodeId>, EqProof*>& cache,
       EqProof* eqp) const;
 
+  /**
+   * The explanations of the equalities computed by explainEquality when
+   * proofs are not being constructed, indexed by the ordered ids of the
+   * terms. Since the equality graph is a forest, the path between two terms,
+   * and hence the explanation of their equality, does not change when
+   * equalities are added. It is cleared when the edges of the graph are
+   * removed on backtracking.
+   */
+  mutable std::unordered_map<EqualityPair,
+                             std::vector<TNode>,
+                             EqualityPairHashFunction>
+      d_explanationCache;
+
   /**
    * Print the equality graph.
    */
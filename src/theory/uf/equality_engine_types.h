@@ -20,10 +20,15 @@
 #ifndef CVC4__THEORY__UF__EQUALITY_ENGINE_TYPES_H
 #define CVC4__THEORY__UF__EQUALITY_ENGINE_TYPES_H
 
+#include <algorithm>
+#include <cstdint>
 #include <string>
 #include <iostream>
 #include <sstream>
+#include <utility>
+#include <vector>
 
+#include "base/check.h"
 #include "util/hash.h"
 
 namespace CVC4 {
@@ -273,6 +278,114 @@ public:
   }
 };
 
+/**
+ * A map from the ids of the nodes (as given by Node::getId()) to their
+ * equality node ids, stored in a flat table with linear probing.
+ *
+ * The entries are removed in the reverse order of their insertion, as the
+ * nodes of the equality engine on backtracking. Hence no entry inserted after
+ * the removed one remains in the table, so no probe sequence goes through the
+ * removed slot, which can just be emptied. For the same reason, the entries
+ * are inserted in the order of their equality node ids when the table grows.
+ */
+class NodeIdMap
+{
+ public:
+  NodeIdMap() : d_size(0), d_bits(4), d_table(size_t(1) << 4) {}
+
+  /** Returns the equality node id of the node with id key, or null_id */
+  EqualityNodeId find(uint64_t key) const
+  {
+    for (size_t i = slot(key);; i = (i + 1) & mask())
+    {
+      const Entry& e = d_table[i];
+      if (e.d_id == null_id || e.d_key == key)
+      {
+        return e.d_id;
+      }
+    }
+  }
+
+  /** Maps key to id, where key is not in the map */
+  void insert(uint64_t key, EqualityNodeId id)
+  {
+    if (2 * (d_size + 1) > d_table.size())
+    {
+      grow();
+    }
+    insertInternal(key, id);
+    ++d_size;
+  }
+
+  /** Removes key, which is the last key inserted that is in the map */
+  void erase(uint64_t key)
+  {
+    for (size_t i = slot(key);; i = (i + 1) & mask())
+    {
+      Entry& e = d_table[i];
+      if (e.d_key == key && e.d_id != null_id)
+      {
+        e.d_id = null_id;
+        --d_size;
+        return;
+      }
+      Assert(e.d_id != null_id);
+    }
+  }
+
+ private:
+  struct Entry
+  {
+    Entry() : d_key(0), d_id(null_id) {}
+    uint64_t d_key;
+    EqualityNodeId d_id;
+  };
+
+  size_t mask() const { return d_table.size() - 1; }
+
+  size_t slot(uint64_t key) const
+  {
+    return (key * UINT64_C(0x9E3779B97F4A7C15)) >> (64 - d_bits);
+  }
+
+  void insertInternal(uint64_t key, EqualityNodeId id)
+  {
+    size_t i = slot(key);
+    while (d_table[i].d_id != null_id)
+    {
+      i = (i + 1) & mask();
+    }
+    d_table[i].d_key = key;
+    d_table[i].d_id = id;
+  }
+
+  void grow()
+  {
+    std::vector<std::pair<EqualityNodeId, uint64_t> > entries;
+    for (const Entry& e : d_table)
+    {
+      if (e.d_id != null_id)
+      {
+        entries.push_back(std::make_pair(e.d_id, e.d_key));
+      }
+    }
+    std::sort(entries.begin(), entries.end());
+    ++d_bits;
+    d_table.assign(size_t(1) << d_bits, Entry());
+    for (const std::pair<EqualityNodeId, uint64_t>& e : entries)
+    {
+      insertInternal(e.second, e.first);
+    }
+  }
+
+  /** The number of entries */
+  size_t d_size;
+  /** The logarithm of the size of the table */
+  unsigned d_bits;
+  /** The table */
+  std::vector<Entry> d_table;
+}; /* class NodeIdMap */
+
 /** A pair of ids */
 typedef std::pair<EqualityNodeId, EqualityNodeId> EqualityPair;
 using EqualityPairHashFunction =
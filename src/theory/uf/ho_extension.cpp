@@ -95,6 +95,21 @@ Node HoExtension::getExtensionalityDeq(TNode deq, bool isCached)
   return conc;
 }
 
+Node HoExtension::getExtensionalityPairDeq(Node a, Node b)
+{
+  std::pair<Node, Node> key =
+      a < b ? std::make_pair(a, b) : std::make_pair(b, a);
+  std::map<std::pair<Node, Node>, Node>::iterator it =
+      d_extensionality_pair.find(key);
+  if (it != d_extensionality_pair.end())
+  {
+    return it->second;
+  }
+  Node deq = Rewriter::rewrite(a.eqNode(b).negate());
+  d_extensionality_pair[key] = deq;
+  return deq;
+}
+
 unsigned HoExtension::applyExtensionality(TNode deq)
 {
   Assert(deq.getKind() == NOT && deq[0].getKind() == EQUAL);
@@ -217,6 +232,27 @@ unsigned HoExtension::checkExtensionality(TheoryModel* m)
     ++eqcs_i;
   }
 
+  // The pairs of equivalence classes that contain the sides of an
+  // extensionality lemma that was already sent. Each of these lemmas either
+  // merges the two classes, or ensures that they are distinct functions, hence
+  // we do not send a lemma again for these pairs.
+  std::set<std::pair<Node, Node> > processed;
+  if (!isCollectModel)
+  {
+    for (NodeSet::const_iterator it = d_extensionality.begin();
+         it != d_extensionality.end();
+         ++it)
+    {
+      Node eq = (*it)[0];
+      if (ee->hasTerm(eq[0]) && ee->hasTerm(eq[1]))
+      {
+        Node r1 = ee->getRepresentative(eq[0]);
+        Node r2 = ee->getRepresentative(eq[1]);
+        processed.insert(r1 < r2 ? std::make_pair(r1, r2)
+                                 : std::make_pair(r2, r1));
+      }
+    }
+  }
   for (std::map<TypeNode, std::vector<Node> >::iterator itf = func_eqcs.begin();
        itf != func_eqcs.end();
        ++itf)
@@ -227,10 +263,18 @@ unsigned HoExtension::checkExtensionality(TheoryModel* m)
       {
         // if these equivalence classes are not explicitly disequal, do
         // extensionality to ensure distinctness
-        if (!ee->areDisequal(itf->second[j], itf->second[k], false))
+        Node a = itf->second[j];
+        Node b = itf->second[k];
+        if (!isCollectModel
+            && processed.find(a < b ? std::make_pair(a, b)
+                                    : std::make_pair(b, a))
+                   != processed.end())
+        {
+          continue;
+        }
+        if (!ee->areDisequal(a, b, false))
         {
-          Node deq =
-              Rewriter::rewrite(itf->second[j].eqNode(itf->second[k]).negate());
+          Node deq = getExtensionalityPairDeq(a, b);
           // either add to model, or add lemma
           if (isCollectModel)
           {
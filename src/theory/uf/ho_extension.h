@@ -187,6 +187,13 @@ class HoExtension
 
   /** cache of getExtensionalityDeq below */
   std::map<Node, Node> d_extensionality_deq;
+  /**
+   * Cache of the (rewritten) disequalities between pairs of function terms
+   * considered by checkExtensionality, indexed by the ordered pair of terms.
+   */
+  std::map<std::pair<Node, Node>, Node> d_extensionality_pair;
+  /** get the rewritten disequality between function terms a and b, cached */
+  Node getExtensionalityPairDeq(Node a, Node b);
 
   /** map from non-standard operators to their skolems */
   NodeNodeMap d_uf_std_skolem;
@@ -512,23 +512,39 @@ bool TheoryUF::areCareDisequal(TNode x, TNode y){
   if( d_equalityEngine.isTriggerTerm(x, THEORY_UF) && d_equalityEngine.isTriggerTerm(y, THEORY_UF) ){
     TNode x_shared = d_equalityEngine.getTriggerTermRepresentative(x, THEORY_UF);
     TNode y_shared = d_equalityEngine.getTriggerTermRepresentative(y, THEORY_UF);
-    EqualityStatus eqStatus = d_valuation.getEqualityStatus(x_shared, y_shared);
-    if( eqStatus==EQUALITY_FALSE_AND_PROPAGATED || eqStatus==EQUALITY_FALSE || eqStatus==EQUALITY_FALSE_IN_MODEL ){
-      return true;
+    std::pair<TNode, TNode> key = x_shared < y_shared
+                                      ? std::make_pair(x_shared, y_shared)
+                                      : std::make_pair(y_shared, x_shared);
+    std::unordered_map<std::pair<TNode, TNode>,
+                       bool,
+                       PairHashFunction<TNode,
+                                        TNode,
+                                        TNodeHashFunction,
+                                        TNodeHashFunction> >::iterator it =
+        d_careDisequal.find(key);
+    if (it != d_careDisequal.end())
+    {
+      return it->second;
     }
+    EqualityStatus eqStatus = d_valuation.getEqualityStatus(x_shared, y_shared);
+    bool ret = eqStatus == EQUALITY_FALSE_AND_PROPAGATED
+               || eqStatus == EQUALITY_FALSE
+               || eqStatus == EQUALITY_FALSE_IN_MODEL;
+    d_careDisequal[key] = ret;
+    return ret;
   }
   return false;
 }
 
-void TheoryUF::addCarePairs(TNodeTrie* t1,
-                            TNodeTrie* t2,
+void TheoryUF::addCarePairs(TNodeFlatTrie::Index t1,
+                            TNodeFlatTrie::Index t2,
                             unsigned arity,
                             unsigned depth)
 {
   if( depth==arity ){
-    if( t2!=NULL ){
-      Node f1 = t1->getData();
-      Node f2 = t2->getData();
+    if( t2!=0 ){
+      Node f1 = d_careIndex.getData(t1);
+      Node f2 = d_careIndex.getData(t2);
       if( !d_equalityEngine.areEqual( f1, f2 ) ){
         Debug("uf::sharing") << "TheoryUf::computeCareGraph(): checking function " << f1 << " and " << f2 << std::endl;
         vector< pair<TNode, TNode> > currentPairs;
@@ -555,40 +571,46 @@ void TheoryUF::addCarePairs(TNodeTrie* t1,
       }
     }
   }else{
-    if( t2==NULL ){
+    if( t2==0 ){
       if( depth<(arity-1) ){
         //add care pairs internal to each child
-        for (std::pair<const TNode, TNodeTrie>& tt : t1->d_data)
+        for (TNodeFlatTrie::Index c = d_careIndex.getFirstChild(t1); c != 0;
+             c = d_careIndex.getNextSibling(c))
         {
-          addCarePairs(&tt.second, NULL, arity, depth + 1);
+          addCarePairs(c, 0, arity, depth + 1);
         }
       }
       //add care pairs based on each pair of non-disequal arguments
-      for (std::map<TNode, TNodeTrie>::iterator it = t1->d_data.begin();
-           it != t1->d_data.end();
-           ++it)
+      for (TNodeFlatTrie::Index c = d_careIndex.getFirstChild(t1); c != 0;
+           c = d_careIndex.getNextSibling(c))
       {
-        std::map<TNode, TNodeTrie>::iterator it2 = it;
-        ++it2;
-        for( ; it2 != t1->d_data.end(); ++it2 ){
-          if( !d_equalityEngine.areDisequal(it->first, it2->first, false) ){
-            if( !areCareDisequal(it->first, it2->first) ){
-              addCarePairs( &it->second, &it2->second, arity, depth+1 );
+        TNode x = d_careIndex.getKey(c);
+        for (TNodeFlatTrie::Index c2 = d_careIndex.getNextSibling(c); c2 != 0;
+             c2 = d_careIndex.getNextSibling(c2))
+        {
+          TNode y = d_careIndex.getKey(c2);
+          if( !d_equalityEngine.areDisequal(x, y, false) ){
+            if( !areCareDisequal(x, y) ){
+              addCarePairs( c, c2, arity, depth+1 );
             }
           }
         }
       }
     }else{
       //add care pairs based on product of indices, non-disequal arguments
-      for (std::pair<const TNode, TNodeTrie>& tt1 : t1->d_data)
+      for (TNodeFlatTrie::Index c1 = d_careIndex.getFirstChild(t1); c1 != 0;
+           c1 = d_careIndex.getNextSibling(c1))
       {
-        for (std::pair<const TNode, TNodeTrie>& tt2 : t2->d_data)
+        TNode x = d_careIndex.getKey(c1);
+        for (TNodeFlatTrie::Index c2 = d_careIndex.getFirstChild(t2); c2 != 0;
+             c2 = d_careIndex.getNextSibling(c2))
         {
-          if (!d_equalityEngine.areDisequal(tt1.first, tt2.first, false))
+          TNode y = d_careIndex.getKey(c2);
+          if (!d_equalityEngine.areDisequal(x, y, false))
           {
-            if (!areCareDisequal(tt1.first, tt2.first))
+            if (!areCareDisequal(x, y))
             {
-              addCarePairs(&tt1.second, &tt2.second, arity, depth + 1);
+              addCarePairs(c1, c2, arity, depth + 1);
             }
           }
         }
@@ -602,7 +624,7 @@ void TheoryUF::computeCareGraph() {
   if (d_sharedTerms.size() > 0) {
     //use term indexing
     Debug("uf::sharing") << "TheoryUf::computeCareGraph(): Build term indices..." << std::endl;
-    std::map<Node, TNodeTrie> index;
+    d_careIndex.clear();
     std::map< Node, unsigned > arity;
     unsigned functionTerms = d_functionsTerms.size();
     for (unsigned i = 0; i < functionTerms; ++ i) {
@@ -610,6 +632,7 @@ void TheoryUF::computeCareGraph() {
       Node op = getOperatorForApplyTerm( f1 );
       unsigned arg_start_index = getArgumentStartIndexForApplyTerm( f1 );
       std::vector< TNode > reps;
+      reps.push_back(op);
       bool has_trigger_arg = false;
       for( unsigned j=arg_start_index; j<f1.getNumChildren(); j++ ){
         reps.push_back( d_equalityEngine.getRepresentative( f1[j] ) );
@@ -618,17 +641,22 @@ void TheoryUF::computeCareGraph() {
         }
       }
       if( has_trigger_arg ){
-        index[op].addTerm(f1, reps);
-        arity[op] = reps.size();
+        d_careIndex.addTerm(f1, reps);
+        arity[op] = reps.size() - 1;
       }
     }
     //for each index
-    for (std::pair<const Node, TNodeTrie>& tt : index)
+    for (TNodeFlatTrie::Index t =
+             d_careIndex.getFirstChild(TNodeFlatTrie::root());
+         t != 0;
+         t = d_careIndex.getNextSibling(t))
     {
+      TNode op = d_careIndex.getKey(t);
       Debug("uf::sharing") << "TheoryUf::computeCareGraph(): Process index "
-                           << tt.first << "..." << std::endl;
-      addCarePairs(&tt.second, nullptr, arity[tt.first], 0);
+                           << op << "..." << std::endl;
+      addCarePairs(t, 0, arity[op], 0);
     }
+    d_careDisequal.clear();
     Debug("uf::sharing") << "TheoryUf::computeCareGraph(): finished." << std::endl;
   }
 }/* TheoryUF::computeCareGraph() */
@@ -20,6 +20,9 @@
 #ifndef CVC4__THEORY__UF__THEORY_UF_H
 #define CVC4__THEORY__UF__THEORY_UF_H
 
+#include <unordered_map>
+#include <utility>
+
 #include "context/cdo.h"
 #include "expr/node.h"
 #include "expr/node_trie.h"
@@ -218,9 +221,31 @@ private:
   bool inConflict() const { return d_conflict; }
 
  private:
+  /**
+   * Are x and y shared terms that are disequal in the current assignment of
+   * the theory that owns them? The results of the calls with pairs of trigger
+   * terms are cached in d_careDisequal during computeCareGraph.
+   */
   bool areCareDisequal(TNode x, TNode y);
-  void addCarePairs(TNodeTrie* t1,
-                    TNodeTrie* t2,
+  /** The results of areCareDisequal, by the pair of shared terms */
+  std::unordered_map<std::pair<TNode, TNode>,
+                     bool,
+                     PairHashFunction<TNode,
+                                      TNode,
+                                      TNodeHashFunction,
+                                      TNodeHashFunction> >
+      d_careDisequal;
+  /**
+   * The term index of computeCareGraph, whose first level is the operators
+   * of the indexed terms. It is kept to reuse its storage across calls.
+   */
+  TNodeFlatTrie d_careIndex;
+  /**
+   * Adds the care pairs of the terms in the subtries t1 and t2 of
+   * d_careIndex, or internal to t1 if t2 is 0.
+   */
+  void addCarePairs(TNodeFlatTrie::Index t1,
+                    TNodeFlatTrie::Index t2,
                     unsigned arity,
                     unsigned depth);
 };/* class TheoryUF */
@@ -0,0 +1,118 @@
+/*********************                                                        */
+/*! \file async_ostream.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief An ostream written to by a background thread.
+ **/
+
+#include "util/async_ostream.h"
+
+namespace CVC4 {
+
+const size_t AsyncStreambuf::s_chunkSize = 1 << 16;
+
+const size_t AsyncStreambuf::s_maxQueued = 1 << 24;
+
+AsyncStreambuf::AsyncStreambuf(std::ostream* out)
+    : d_out(out), d_chunk(s_chunkSize, '\0'), d_queued(0), d_stop(false)
+{
+  setp(&d_chunk[0], &d_chunk[0] + d_chunk.size());
+  d_thread = std::thread(&AsyncStreambuf::run, this);
+}
+
+AsyncStreambuf::~AsyncStreambuf()
+{
+  push();
+  {
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_stop = true;
+  }
+  d_pushed.notify_one();
+  d_thread.join();
+  delete d_out;
+}
+
+AsyncStreambuf::int_type AsyncStreambuf::overflow(int_type c)
+{
+  push();
+  if (!traits_type::eq_int_type(c, traits_type::eof()))
+  {
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+  }
+  return traits_type::not_eof(c);
+}
+
+int AsyncStreambuf::sync()
+{
+  push();
+  return 0;
+}
+
+void AsyncStreambuf::push()
+{
+  size_t size = pptr() - pbase();
+  if (size == 0)
+  {
+    return;
+  }
+  {
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_written.wait(lock, [this] { return d_queued < s_maxQueued; });
+    d_queue.emplace_back(pbase(), size);
+    d_queued += size;
+  }
+  d_pushed.notify_one();
+  setp(&d_chunk[0], &d_chunk[0] + d_chunk.size());
+}
+
+void AsyncStreambuf::run()
+{
+  std::deque<std::string> chunks;
+  std::unique_lock<std::mutex> lock(d_mutex);
+  for (;;)
+  {
+    d_pushed.wait(lock, [this] { return d_stop || !d_queue.empty(); });
+    if (d_queue.empty())
+    {
+      // d_stop, and everything is written
+      return;
+    }
+    chunks.swap(d_queue);
+    lock.unlock();
+    size_t size = 0;
+    for (const std::string& chunk : chunks)
+    {
+      d_out->write(chunk.data(), chunk.size());
+      size += chunk.size();
+    }
+    // Only flush once the pending output is written
+    chunks.clear();
+    lock.lock();
+    if (d_queue.empty())
+    {
+      lock.unlock();
+      d_out->flush();
+      lock.lock();
+    }
+    d_queued -= size;
+    d_written.notify_all();
+  }
+}
+
+AsyncOstream::AsyncOstream(std::ostream* os)
+    : std::ostream(nullptr), d_buf(os)
+{
+  rdbuf(&d_buf);
+}
+
+AsyncOstream::~AsyncOstream() { flush(); }
+
+}  // namespace CVC4
@@ -0,0 +1,97 @@
+/*********************                                                        */
+/*! \file async_ostream.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief An ostream written to by a background thread.
+ **
+ ** An ostream whose output is written to another ostream by a background
+ ** thread, so that writing, e.g. to files, does not wait on I/O. The output
+ ** is passed to the thread in chunks, on flushes and when the buffer of the
+ ** current chunk is full. The size of the chunks waiting to be written is
+ ** bounded: a writer waits when the bound is reached.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__UTIL__ASYNC_OSTREAM_H
+#define CVC4__UTIL__ASYNC_OSTREAM_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+namespace CVC4 {
+
+/** The stream buffer of AsyncOstream. */
+class AsyncStreambuf : public std::streambuf
+{
+ public:
+  /** Writes to out, which is owned by this buffer. */
+  AsyncStreambuf(std::ostream* out);
+  /** Writes the remaining output, and waits for it to be written. */
+  ~AsyncStreambuf() override;
+
+ protected:
+  int_type overflow(int_type c) override;
+  /** Passes the current chunk to the thread, does not wait for it. */
+  int sync() override;
+
+ private:
+  /** Passes the current chunk to the thread. */
+  void push();
+  /** The loop of the background thread. */
+  void run();
+
+  /** The size of a chunk */
+  static const size_t s_chunkSize;
+  /** The maximal size of the chunks waiting to be written */
+  static const size_t s_maxQueued;
+
+  /** The stream written to by the thread */
+  std::ostream* d_out;
+  /** The current chunk */
+  std::string d_chunk;
+  /** The chunks waiting to be written */
+  std::deque<std::string> d_queue;
+  /** The size of the chunks in d_queue, or being written */
+  size_t d_queued;
+  /** Protects d_queue, d_queued and d_stop */
+  std::mutex d_mutex;
+  /** Notified when chunks are pushed, or on d_stop */
+  std::condition_variable d_pushed;
+  /** Notified when chunks are written */
+  std::condition_variable d_written;
+  /** Whether the thread is terminating */
+  bool d_stop;
+  std::thread d_thread;
+}; /* class AsyncStreambuf */
+
+/**
+ * An ostream that writes to an owned ostream in a background thread (see
+ * above).
+ */
+class AsyncOstream : public std::ostream
+{
+ public:
+  AsyncOstream(std::ostream* os);
+  /** Writes the remaining output. */
+  ~AsyncOstream() override;
+
+ private:
+  AsyncStreambuf d_buf;
+}; /* class AsyncOstream */
+
+}  // namespace CVC4
+
+#endif /* CVC4__UTIL__ASYNC_OSTREAM_H */
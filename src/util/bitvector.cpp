@@ -18,8 +18,54 @@
 
 #include "util/bitvector.h"
 
+#include <limits>
+
 namespace CVC4 {
 
+namespace {
+
+/**
+ * Returns true if the operations on bit-vectors of the given width are
+ * computed on 64-bit machine words, which avoids the intermediate (possibly
+ * GMP-backed) integers of the general case.
+ */
+inline bool isWordSize(unsigned size)
+{
+  return size <= 64 && std::numeric_limits<unsigned long>::digits >= 64;
+}
+
+/** Returns the mask of the bits of a bit-vector of width size <= 64 */
+inline uint64_t wordMask(unsigned size)
+{
+  return size == 64 ? ~uint64_t(0) : (uint64_t(1) << size) - 1;
+}
+
+/** Returns the value of bit-vector bv of width at most 64 */
+inline uint64_t toWord(const BitVector& bv)
+{
+  return bv.getValue().getUnsignedLong();
+}
+
+/** Returns the value of bit-vector bv of width at most 64 as signed */
+inline int64_t toSignedWord(const BitVector& bv)
+{
+  uint64_t v = toWord(bv);
+  unsigned size = bv.getSize();
+  if (size < 64 && ((v >> (size - 1)) & 1))
+  {
+    v |= ~wordMask(size);
+  }
+  return static_cast<int64_t>(v);
+}
+
+/** Returns the bit-vector of width size <= 64 for the low bits of v */
+inline BitVector fromWord(unsigned size, uint64_t v)
+{
+  return BitVector(size, static_cast<uint64_t>(v & wordMask(size)));
+}
+
+}  // namespace
+
 unsigned BitVector::getSize() const { return d_size; }
 
 const Integer& BitVector::getValue() const { return d_value; }
@@ -84,6 +130,13 @@ unsigned BitVector::isPow2() const
 
 BitVector BitVector::concat(const BitVector& other) const
 {
+  if (isWordSize(d_size + other.d_size))
+  {
+    uint64_t lo = toWord(other);
+    // other.d_size < 64 if both sizes are positive
+    uint64_t hi = other.d_size < 64 ? toWord(*this) << other.d_size : 0;
+    return fromWord(d_size + other.d_size, hi | lo);
+  }
   return BitVector(d_size + other.d_size,
                    (d_value.multiplyByPow2(other.d_size)) + other.d_value);
 }
@@ -92,6 +145,10 @@ BitVector BitVector::extract(unsigned high, unsigned low) const
 {
   CheckArgument(high < d_size, high);
   CheckArgument(low <= high, low);
+  if (isWordSize(d_size))
+  {
+    return fromWord(high - low + 1, toWord(*this) >> low);
+  }
   return BitVector(high - low + 1,
                    d_value.extractBitRange(high - low + 1, low));
 }
@@ -155,6 +212,10 @@ bool BitVector::signedLessThan(const BitVector& y) const
   CheckArgument(d_size == y.d_size, y);
   CheckArgument(d_value >= 0, this);
   CheckArgument(y.d_value >= 0, y);
+  if (isWordSize(d_size))
+  {
+    return toSignedWord(*this) < toSignedWord(y);
+  }
   Integer a = (*this).toSignedInteger();
   Integer b = y.toSignedInteger();
 
@@ -166,6 +227,10 @@ bool BitVector::signedLessThanEq(const BitVector& y) const
   CheckArgument(d_size == y.d_size, y);
   CheckArgument(d_value >= 0, this);
   CheckArgument(y.d_value >= 0, y);
+  if (isWordSize(d_size))
+  {
+    return toSignedWord(*this) <= toSignedWord(y);
+  }
   Integer a = (*this).toSignedInteger();
   Integer b = y.toSignedInteger();
 
@@ -177,23 +242,39 @@ bool BitVector::signedLessThanEq(const BitVector& y) const
 BitVector BitVector::operator^(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isWordSize(d_size))
+  {
+    return fromWord(d_size, toWord(*this) ^ toWord(y));
+  }
   return BitVector(d_size, d_value.bitwiseXor(y.d_value));
 }
 
 BitVector BitVector::operator|(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isWordSize(d_size))
+  {
+    return fromWord(d_size, toWord(*this) | toWord(y));
+  }
   return BitVector(d_size, d_value.bitwiseOr(y.d_value));
 }
 
 BitVector BitVector::operator&(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isWordSize(d_size))
+  {
+    return fromWord(d_size, toWord(*this) & toWord(y));
+  }
   return BitVector(d_size, d_value.bitwiseAnd(y.d_value));
 }
 
 BitVector BitVector::operator~() const
 {
+  if (isWordSize(d_size))
+  {
+    return fromWord(d_size, ~toWord(*this));
+  }
   return BitVector(d_size, d_value.bitwiseNot());
 }
 
@@ -202,6 +283,10 @@ BitVector BitVector::operator~() const
 BitVector BitVector::operator+(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isWordSize(d_size))
+  {
+    return fromWord(d_size, toWord(*this) + toWord(y));
+  }
   Integer sum = d_value + y.d_value;
   return BitVector(d_size, sum);
 }
@@ -209,6 +294,10 @@ BitVector BitVector::operator+(const BitVector& y) const
 BitVector BitVector::operator-(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isWordSize(d_size))
+  {
+    return fromWord(d_size, toWord(*this) - toWord(y));
+  }
   // to maintain the invariant that we are only adding BitVectors of the
   // same size
   BitVector one(d_size, Integer(1));
@@ -217,6 +306,10 @@ BitVector BitVector::operator-(const BitVector& y) const
 
 BitVector BitVector::operator-() const
 {
+  if (isWordSize(d_size))
+  {
+    return fromWord(d_size, -toWord(*this));
+  }
   BitVector one(d_size, Integer(1));
   return ~(*this) + one;
 }
@@ -224,6 +317,10 @@ BitVector BitVector::operator-() const
 BitVector BitVector::operator*(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isWordSize(d_size))
+  {
+    return fromWord(d_size, toWord(*this) * toWord(y));
+  }
   Integer prod = d_value * y.d_value;
   return BitVector(d_size, prod);
 }
@@ -231,6 +328,11 @@ BitVector BitVector::operator*(const BitVector& y) const
 BitVector BitVector::unsignedDivTotal(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isWordSize(d_size))
+  {
+    uint64_t b = toWord(y);
+    return fromWord(d_size, b == 0 ? ~uint64_t(0) : toWord(*this) / b);
+  }
   /* d_value / 0 = -1 = 2^d_size - 1 */
   if (y.d_value == 0)
   {
@@ -244,6 +346,12 @@ BitVector BitVector::unsignedDivTotal(const BitVector& y) const
 BitVector BitVector::unsignedRemTotal(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isWordSize(d_size))
+  {
+    uint64_t a = toWord(*this);
+    uint64_t b = toWord(y);
+    return fromWord(d_size, b == 0 ? a : a % b);
+  }
   if (y.d_value == 0)
   {
     return BitVector(d_size, d_value);
@@ -275,6 +383,11 @@ BitVector BitVector::signExtend(unsigned n) const
 
 BitVector BitVector::leftShift(const BitVector& y) const
 {
+  if (isWordSize(d_size) && isWordSize(y.d_size))
+  {
+    uint64_t amount = toWord(y);
+    return fromWord(d_size, amount >= d_size ? 0 : toWord(*this) << amount);
+  }
   if (y.d_value > Integer(d_size))
   {
     return BitVector(d_size, Integer(0));
@@ -292,6 +405,11 @@ BitVector BitVector::leftShift(const BitVector& y) const
 
 BitVector BitVector::logicalRightShift(const BitVector& y) const
 {
+  if (isWordSize(d_size) && isWordSize(y.d_size))
+  {
+    uint64_t amount = toWord(y);
+    return fromWord(d_size, amount >= d_size ? 0 : toWord(*this) >> amount);
+  }
   if (y.d_value > Integer(d_size))
   {
     return BitVector(d_size, Integer(0));
@@ -305,6 +423,14 @@ BitVector BitVector::logicalRightShift(const BitVector& y) const
 
 BitVector BitVector::arithRightShift(const BitVector& y) const
 {
+  if (isWordSize(d_size) && isWordSize(y.d_size))
+  {
+    uint64_t amount = toWord(y);
+    int64_t a = toSignedWord(*this);
+    // the arithmetic shift of the sign-extended value
+    int64_t res = amount >= d_size ? (a < 0 ? -1 : 0) : a >> amount;
+    return fromWord(d_size, static_cast<uint64_t>(res));
+  }
   Integer sign_bit = d_value.extractBitRange(1, d_size - 1);
   if (y.d_value > Integer(d_size))
   {
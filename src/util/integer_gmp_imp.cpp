@@ -35,96 +35,100 @@ using namespace std;
 namespace CVC4 {
 
 Integer::Integer(const char* s, unsigned base)
-  : d_value(s, base)
-{}
+{
+  mpz_class value(s, base);
+  setBig(value.get_mpz_t());
+}
 
 Integer::Integer(const std::string& s, unsigned base)
-  : d_value(s, base)
-{}
+{
+  mpz_class value(s, base);
+  setBig(value.get_mpz_t());
+}
 
 
 bool Integer::fitsSignedInt() const {
-  return d_value.fits_sint_p();
+  return !d_isBig && d_small >= std::numeric_limits<int>::min()
+         && d_small <= std::numeric_limits<int>::max();
 }
 
 bool Integer::fitsUnsignedInt() const {
-  return d_value.fits_uint_p();
+  return !d_isBig && d_small >= 0
+         && static_cast<unsigned long int>(d_small)
+                <= std::numeric_limits<unsigned int>::max();
 }
 
 signed int Integer::getSignedInt() const {
   // ensure there isn't overflow
-  CheckArgument(d_value <= std::numeric_limits<int>::max(), this,
-                "Overflow detected in Integer::getSignedInt().");
-  CheckArgument(d_value >= std::numeric_limits<int>::min(), this,
-                "Overflow detected in Integer::getSignedInt().");
   CheckArgument(fitsSignedInt(), this,
                 "Overflow detected in Integer::getSignedInt().");
-  return (signed int) d_value.get_si();
+  return (signed int) d_small;
 }
 
 unsigned int Integer::getUnsignedInt() const {
   // ensure there isn't overflow
-  CheckArgument(d_value <= std::numeric_limits<unsigned int>::max(), this,
+  CheckArgument(fitsUnsignedInt(), this,
                 "Overflow detected in Integer::getUnsignedInt()");
-  CheckArgument(d_value >= std::numeric_limits<unsigned int>::min(), this,
-                "Overflow detected in Integer::getUnsignedInt()");
-  CheckArgument(fitsSignedInt(), this,
-                "Overflow detected in Integer::getUnsignedInt()");
-  return (unsigned int) d_value.get_ui();
+  return (unsigned int) d_small;
 }
 
 bool Integer::fitsSignedLong() const {
-  return d_value.fits_slong_p();
+  return !d_isBig;
 }
 
 bool Integer::fitsUnsignedLong() const {
-  return d_value.fits_ulong_p();
+  return d_isBig ? mpz_fits_ulong_p(d_big) != 0 : d_small >= 0;
 }
 
 Integer Integer::oneExtend(uint32_t size, uint32_t amount) const {
   // check that the size is accurate
   DebugCheckArgument((*this) < Integer(1).multiplyByPow2(size), size);
-  mpz_class res = d_value;
+  mpz_class res = getValue();
 
   for (unsigned i = size; i < size + amount; ++i) {
     mpz_setbit(res.get_mpz_t(), i);
   }
 
-  return Integer(res);
+  return Integer(std::move(res));
 }
 
 Integer Integer::exactQuotient(const Integer& y) const {
   DebugCheckArgument(y.divides(*this), y);
+  if (!d_isBig && !y.d_isBig
+      && !(y.d_small == -1
+           && d_small == std::numeric_limits<signed long int>::min()))
+  {
+    return Integer(d_small / y.d_small);
+  }
   mpz_class q;
-  mpz_divexact(q.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-  return Integer( q );
+  mpz_divexact(q.get_mpz_t(), View(*this).get(), View(y).get());
+  return Integer(std::move(q));
 }
 
 Integer Integer::modAdd(const Integer& y, const Integer& m) const
 {
   mpz_class res;
-  mpz_add(res.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-  mpz_mod(res.get_mpz_t(), res.get_mpz_t(), m.d_value.get_mpz_t());
-  return Integer(res);
+  mpz_add(res.get_mpz_t(), View(*this).get(), View(y).get());
+  mpz_mod(res.get_mpz_t(), res.get_mpz_t(), View(m).get());
+  return Integer(std::move(res));
 }
 
 Integer Integer::modMultiply(const Integer& y, const Integer& m) const
 {
   mpz_class res;
-  mpz_mul(res.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-  mpz_mod(res.get_mpz_t(), res.get_mpz_t(), m.d_value.get_mpz_t());
-  return Integer(res);
+  mpz_mul(res.get_mpz_t(), View(*this).get(), View(y).get());
+  mpz_mod(res.get_mpz_t(), res.get_mpz_t(), View(m).get());
+  return Integer(std::move(res));
 }
 
 Integer Integer::modInverse(const Integer& m) const
 {
   PrettyCheckArgument(m > 0, m, "m must be greater than zero");
   mpz_class res;
-  if (mpz_invert(res.get_mpz_t(), d_value.get_mpz_t(), m.d_value.get_mpz_t())
-      == 0)
+  if (mpz_invert(res.get_mpz_t(), View(*this).get(), View(m).get()) == 0)
   {
     return Integer(-1);
   }
-  return Integer(res);
+  return Integer(std::move(res));
 }
 } /* namespace CVC4 */
@@ -34,26 +34,131 @@ class Rational;
 class CVC4_PUBLIC Integer {
 private:
   /**
-   * Stores the value of the rational is stored in a C++ GMP integer class.
-   * Using this instead of mpz_t allows for easier destruction.
+   * The value is stored inline in d_small if it fits into a signed long, and
+   * in the GMP integer d_big otherwise.  The representation is canonical:
+   * d_big never holds a value that fits into d_small, so that most integers
+   * occurring in practice never allocate, and two integers with different
+   * representations are different.
    */
-  mpz_class d_value;
+  bool d_isBig;
+  union
+  {
+    signed long int d_small;
+    mpz_t d_big;
+  };
 
   /**
-   * Gets a reference to the gmp data that backs up the integer.
+   * A read-only GMP view of the value of an integer, which is a temporary
+   * if the value is stored inline.
+   */
+  class View
+  {
+   public:
+    View(const Integer& i)
+    {
+      if (i.d_isBig)
+      {
+        d_ptr = i.d_big;
+      }
+      else
+      {
+        mpz_init_set_si(d_tmp, i.d_small);
+        d_ptr = d_tmp;
+      }
+    }
+    ~View()
+    {
+      if (d_ptr == d_tmp)
+      {
+        mpz_clear(d_tmp);
+      }
+    }
+    mpz_srcptr get() const { return d_ptr; }
+
+   private:
+    mpz_t d_tmp;
+    mpz_srcptr d_ptr;
+  };
+
+  /** Returns the absolute value of v as an unsigned long. */
+  static unsigned long int absWord(signed long int v)
+  {
+    return v < 0 ? -static_cast<unsigned long int>(v)
+                 : static_cast<unsigned long int>(v);
+  }
+
+  /** Returns the greatest common divisor of a and b. */
+  static unsigned long int gcdWord(unsigned long int a, unsigned long int b)
+  {
+    while (b != 0)
+    {
+      unsigned long int t = a % b;
+      a = b;
+      b = t;
+    }
+    return a;
+  }
+
+  /** Stores the value of v, which is initialized, in a canonical way. */
+  void setBig(mpz_srcptr v)
+  {
+    if (mpz_fits_slong_p(v))
+    {
+      d_isBig = false;
+      d_small = mpz_get_si(v);
+    }
+    else
+    {
+      d_isBig = true;
+      mpz_init_set(d_big, v);
+    }
+  }
+
+  /** Moves the inline value back to d_small if it fits. */
+  void normalize()
+  {
+    if (d_isBig && mpz_fits_slong_p(d_big))
+    {
+      signed long int v = mpz_get_si(d_big);
+      mpz_clear(d_big);
+      d_isBig = false;
+      d_small = v;
+    }
+  }
+
+  /**
+   * Gets a copy of the gmp data that backs up the integer.
    * Only accessible to friend classes.
    */
-  const mpz_class& get_mpz() const { return d_value; }
+  mpz_class get_mpz() const { return getValue(); }
 
   /**
    * Constructs an Integer by copying a GMP C++ primitive.
    */
-  Integer(const mpz_class& val) : d_value(val) {}
+  Integer(const mpz_class& val) { setBig(val.get_mpz_t()); }
+
+  /**
+   * Constructs an Integer by taking the value of a GMP C++ primitive.
+   */
+  Integer(mpz_class&& val)
+  {
+    if (mpz_fits_slong_p(val.get_mpz_t()))
+    {
+      d_isBig = false;
+      d_small = mpz_get_si(val.get_mpz_t());
+    }
+    else
+    {
+      d_isBig = true;
+      mpz_init(d_big);
+      mpz_swap(d_big, val.get_mpz_t());
+    }
+  }
 
 public:
 
   /** Constructs a rational with the value 0. */
-  Integer() : d_value(0){}
+  Integer() : d_isBig(false), d_small(0) {}
 
   /**
    * Constructs a Integer from a C string.
@@ -64,120 +169,288 @@ public:
   explicit Integer(const char* s, unsigned base = 10);
   explicit Integer(const std::string& s, unsigned base = 10);
 
-  Integer(const Integer& q) : d_value(q.d_value) {}
+  Integer(const Integer& q) : d_isBig(q.d_isBig)
+  {
+    if (d_isBig)
+    {
+      mpz_init_set(d_big, q.d_big);
+    }
+    else
+    {
+      d_small = q.d_small;
+    }
+  }
+
+  Integer(Integer&& q) noexcept : d_isBig(q.d_isBig)
+  {
+    if (d_isBig)
+    {
+      d_big[0] = q.d_big[0];
+      q.d_isBig = false;
+      q.d_small = 0;
+    }
+    else
+    {
+      d_small = q.d_small;
+    }
+  }
 
-  Integer(  signed int z) : d_value(z) {}
-  Integer(unsigned int z) : d_value(z) {}
-  Integer(  signed long int z) : d_value(z) {}
-  Integer(unsigned long int z) : d_value(z) {}
+  Integer(  signed int z) : d_isBig(false), d_small(z) {}
+  Integer(unsigned int z)
+  {
+    if (z <= static_cast<unsigned long int>(
+            std::numeric_limits<signed long int>::max()))
+    {
+      d_isBig = false;
+      d_small = static_cast<signed long int>(z);
+    }
+    else
+    {
+      d_isBig = true;
+      mpz_init_set_ui(d_big, z);
+    }
+  }
+  Integer(  signed long int z) : d_isBig(false), d_small(z) {}
+  Integer(unsigned long int z)
+  {
+    if (z <= static_cast<unsigned long int>(
+            std::numeric_limits<signed long int>::max()))
+    {
+      d_isBig = false;
+      d_small = static_cast<signed long int>(z);
+    }
+    else
+    {
+      d_isBig = true;
+      mpz_init_set_ui(d_big, z);
+    }
+  }
 
 #ifdef CVC4_NEED_INT64_T_OVERLOADS
-  Integer( int64_t z) : d_value(static_cast<long>(z)) {}
-  Integer(uint64_t z) : d_value(static_cast<unsigned long>(z)) {}
+  Integer( int64_t z) : Integer(static_cast<long>(z)) {}
+  Integer(uint64_t z) : Integer(static_cast<unsigned long>(z)) {}
 #endif /* CVC4_NEED_INT64_T_OVERLOADS */
 
-  ~Integer() {}
+  ~Integer()
+  {
+    if (d_isBig)
+    {
+      mpz_clear(d_big);
+    }
+  }
 
   /**
-   * Returns a copy of d_value to enable public access of GMP data.
+   * Returns a copy of the value to enable public access of GMP data.
    */
   mpz_class getValue() const
   {
-    return d_value;
+    return d_isBig ? mpz_class(d_big) : mpz_class(d_small);
   }
 
   Integer& operator=(const Integer& x){
     if(this == &x) return *this;
-    d_value = x.d_value;
+    if (x.d_isBig)
+    {
+      if (d_isBig)
+      {
+        mpz_set(d_big, x.d_big);
+      }
+      else
+      {
+        mpz_init_set(d_big, x.d_big);
+        d_isBig = true;
+      }
+    }
+    else
+    {
+      if (d_isBig)
+      {
+        mpz_clear(d_big);
+        d_isBig = false;
+      }
+      d_small = x.d_small;
+    }
+    return *this;
+  }
+
+  Integer& operator=(Integer&& x) noexcept
+  {
+    if (this == &x) return *this;
+    if (d_isBig)
+    {
+      mpz_clear(d_big);
+    }
+    d_isBig = x.d_isBig;
+    if (d_isBig)
+    {
+      d_big[0] = x.d_big[0];
+      x.d_isBig = false;
+      x.d_small = 0;
+    }
+    else
+    {
+      d_small = x.d_small;
+    }
     return *this;
   }
 
   bool operator==(const Integer& y) const {
-    return d_value == y.d_value;
+    if (d_isBig != y.d_isBig) return false;
+    return d_isBig ? mpz_cmp(d_big, y.d_big) == 0 : d_small == y.d_small;
   }
 
   Integer operator-() const {
-    return Integer(-(d_value));
+    if (!d_isBig && d_small != std::numeric_limits<signed long int>::min())
+    {
+      return Integer(-d_small);
+    }
+    mpz_class result;
+    mpz_neg(result.get_mpz_t(), View(*this).get());
+    return Integer(std::move(result));
   }
 
 
   bool operator!=(const Integer& y) const {
-    return d_value != y.d_value;
+    return !(*this == y);
+  }
+
+  /** Returns a negative, zero or positive value if *this <, = or > y. */
+  int cmp(const Integer& y) const
+  {
+    if (!d_isBig && !y.d_isBig)
+    {
+      return d_small < y.d_small ? -1 : (d_small > y.d_small ? 1 : 0);
+    }
+    if (!y.d_isBig)
+    {
+      return mpz_cmp_si(d_big, y.d_small);
+    }
+    if (!d_isBig)
+    {
+      return -mpz_cmp_si(y.d_big, d_small);
+    }
+    return mpz_cmp(d_big, y.d_big);
   }
 
   bool operator< (const Integer& y) const {
-    return d_value < y.d_value;
+    return cmp(y) < 0;
   }
 
   bool operator<=(const Integer& y) const {
-    return d_value <= y.d_value;
+    return cmp(y) <= 0;
   }
 
   bool operator> (const Integer& y) const {
-    return d_value > y.d_value;
+    return cmp(y) > 0;
   }
 
   bool operator>=(const Integer& y) const {
-    return d_value >= y.d_value;
+    return cmp(y) >= 0;
   }
 
 
   Integer operator+(const Integer& y) const {
-    return Integer( d_value + y.d_value );
+    signed long int r;
+    if (!d_isBig && !y.d_isBig
+        && !__builtin_add_overflow(d_small, y.d_small, &r))
+    {
+      return Integer(r);
+    }
+    mpz_class result;
+    mpz_add(result.get_mpz_t(), View(*this).get(), View(y).get());
+    return Integer(std::move(result));
   }
   Integer& operator+=(const Integer& y) {
-    d_value += y.d_value;
+    *this = *this + y;
     return *this;
   }
 
   Integer operator-(const Integer& y) const {
-    return Integer( d_value - y.d_value );
+    signed long int r;
+    if (!d_isBig && !y.d_isBig
+        && !__builtin_sub_overflow(d_small, y.d_small, &r))
+    {
+      return Integer(r);
+    }
+    mpz_class result;
+    mpz_sub(result.get_mpz_t(), View(*this).get(), View(y).get());
+    return Integer(std::move(result));
   }
   Integer& operator-=(const Integer& y) {
-    d_value -= y.d_value;
+    *this = *this - y;
     return *this;
   }
 
   Integer operator*(const Integer& y) const {
-    return Integer( d_value * y.d_value );
+    signed long int r;
+    if (!d_isBig && !y.d_isBig
+        && !__builtin_mul_overflow(d_small, y.d_small, &r))
+    {
+      return Integer(r);
+    }
+    mpz_class result;
+    mpz_mul(result.get_mpz_t(), View(*this).get(), View(y).get());
+    return Integer(std::move(result));
   }
   Integer& operator*=(const Integer& y) {
-    d_value *= y.d_value;
+    *this = *this * y;
     return *this;
   }
 
 
   Integer bitwiseOr(const Integer& y) const {
+    if (!d_isBig && !y.d_isBig)
+    {
+      return Integer(d_small | y.d_small);
+    }
     mpz_class result;
-    mpz_ior(result.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-    return Integer(result);
+    mpz_ior(result.get_mpz_t(), View(*this).get(), View(y).get());
+    return Integer(std::move(result));
   }
 
   Integer bitwiseAnd(const Integer& y) const {
+    if (!d_isBig && !y.d_isBig)
+    {
+      return Integer(d_small & y.d_small);
+    }
     mpz_class result;
-    mpz_and(result.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-    return Integer(result);
+    mpz_and(result.get_mpz_t(), View(*this).get(), View(y).get());
+    return Integer(std::move(result));
   }
 
   Integer bitwiseXor(const Integer& y) const {
+    if (!d_isBig && !y.d_isBig)
+    {
+      return Integer(d_small ^ y.d_small);
+    }
     mpz_class result;
-    mpz_xor(result.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-    return Integer(result);
+    mpz_xor(result.get_mpz_t(), View(*this).get(), View(y).get());
+    return Integer(std::move(result));
   }
 
   Integer bitwiseNot() const {
+    if (!d_isBig)
+    {
+      return Integer(~d_small);
+    }
     mpz_class result;
-    mpz_com(result.get_mpz_t(), d_value.get_mpz_t());
-    return Integer(result);
+    mpz_com(result.get_mpz_t(), d_big);
+    return Integer(std::move(result));
   }
 
   /**
    * Return this*(2^pow).
    */
   Integer multiplyByPow2(uint32_t pow) const{
+    signed long int r;
+    if (!d_isBig && pow < std::numeric_limits<signed long int>::digits
+        && !__builtin_mul_overflow(d_small, 1L << pow, &r))
+    {
+      return Integer(r);
+    }
     mpz_class result;
-    mpz_mul_2exp(result.get_mpz_t(), d_value.get_mpz_t(), pow);
-    return Integer( result );
+    mpz_mul_2exp(result.get_mpz_t(), View(*this).get(), pow);
+    return Integer(std::move(result));
   }
 
   /**
@@ -185,9 +458,13 @@ public:
    * current Integer to 1.
    */
   Integer setBit(uint32_t i) const {
-    mpz_class res = d_value;
+    if (!d_isBig && i < std::numeric_limits<signed long int>::digits)
+    {
+      return Integer(d_small | (1L << i));
+    }
+    mpz_class res = getValue();
     mpz_setbit(res.get_mpz_t(), i);
-    return Integer(res);
+    return Integer(std::move(res));
   }
 
   bool isBitSet(uint32_t i) const {
@@ -201,62 +478,127 @@ public:
   Integer oneExtend(uint32_t size, uint32_t amount) const;
 
   uint32_t toUnsignedInt() const {
-    return  mpz_get_ui(d_value.get_mpz_t());
+    if (!d_isBig)
+    {
+      // the least significant bits of the absolute value, as mpz_get_ui
+      return static_cast<uint32_t>(absWord(d_small));
+    }
+    return  mpz_get_ui(d_big);
   }
 
   /** See GMP Documentation. */
   Integer extractBitRange(uint32_t bitCount, uint32_t low) const {
     // bitCount = high-low+1
     uint32_t high = low + bitCount-1;
+    if (!d_isBig && high + 1 < std::numeric_limits<unsigned long int>::digits)
+    {
+      // the two's complement bits are the ones of the floor remainder
+      unsigned long int bits = static_cast<unsigned long int>(d_small)
+                               & ((1UL << (high + 1)) - 1);
+      return Integer(bits >> low);
+    }
     //— Function: void mpz_fdiv_r_2exp (mpz_t r, mpz_t n, mp_bitcnt_t b)
     mpz_class rem, div;
-    mpz_fdiv_r_2exp(rem.get_mpz_t(), d_value.get_mpz_t(), high+1);
+    mpz_fdiv_r_2exp(rem.get_mpz_t(), View(*this).get(), high+1);
     mpz_fdiv_q_2exp(div.get_mpz_t(), rem.get_mpz_t(), low);
 
-    return Integer(div);
+    return Integer(std::move(div));
   }
 
   /**
    * Returns the floor(this / y)
    */
   Integer floorDivideQuotient(const Integer& y) const {
-    mpz_class q;
-    mpz_fdiv_q(q.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-    return Integer( q );
+    Integer q, r;
+    floorQR(q, r, *this, y);
+    return q;
   }
 
   /**
    * Returns r == this - floor(this/y)*y
    */
   Integer floorDivideRemainder(const Integer& y) const {
-    mpz_class r;
-    mpz_fdiv_r(r.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-    return Integer( r );
+    Integer q, r;
+    floorQR(q, r, *this, y);
+    return r;
   }
 
   /**
    * Computes a floor quotient and remainder for x divided by y.
    */
   static void floorQR(Integer& q, Integer& r, const Integer& x, const Integer& y) {
-    mpz_fdiv_qr(q.d_value.get_mpz_t(), r.d_value.get_mpz_t(), x.d_value.get_mpz_t(), y.d_value.get_mpz_t());
+    if (!x.d_isBig && !y.d_isBig && y.d_small != 0
+        && !(y.d_small == -1
+             && x.d_small == std::numeric_limits<signed long int>::min()))
+    {
+      signed long int qs = x.d_small / y.d_small;
+      signed long int rs = x.d_small % y.d_small;
+      if (rs != 0 && ((rs < 0) != (y.d_small < 0)))
+      {
+        qs -= 1;
+        rs += y.d_small;
+      }
+      q = Integer(qs);
+      r = Integer(rs);
+      return;
+    }
+    mpz_class qb, rb;
+    mpz_fdiv_qr(qb.get_mpz_t(),
+                rb.get_mpz_t(),
+                View(x).get(),
+                View(y).get());
+    q = Integer(std::move(qb));
+    r = Integer(std::move(rb));
   }
 
   /**
    * Returns the ceil(this / y)
    */
   Integer ceilingDivideQuotient(const Integer& y) const {
-    mpz_class q;
-    mpz_cdiv_q(q.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-    return Integer( q );
+    Integer q, r;
+    ceilingQR(q, r, *this, y);
+    return q;
   }
 
   /**
    * Returns the ceil(this / y)
    */
   Integer ceilingDivideRemainder(const Integer& y) const {
-    mpz_class r;
-    mpz_cdiv_r(r.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-    return Integer( r );
+    Integer q, r;
+    ceilingQR(q, r, *this, y);
+    return r;
+  }
+
+  /**
+   * Computes a ceiling quotient and remainder for x divided by y.
+   */
+  static void ceilingQR(Integer& q,
+                        Integer& r,
+                        const Integer& x,
+                        const Integer& y)
+  {
+    if (!x.d_isBig && !y.d_isBig && y.d_small != 0
+        && !(y.d_small == -1
+             && x.d_small == std::numeric_limits<signed long int>::min()))
+    {
+      signed long int qs = x.d_small / y.d_small;
+      signed long int rs = x.d_small % y.d_small;
+      if (rs != 0 && ((rs > 0) == (y.d_small > 0)))
+      {
+        qs += 1;
+        rs -= y.d_small;
+      }
+      q = Integer(qs);
+      r = Integer(rs);
+      return;
+    }
+    mpz_class qb, rb;
+    mpz_cdiv_qr(qb.get_mpz_t(),
+                rb.get_mpz_t(),
+                View(x).get(),
+                View(y).get());
+    q = Integer(std::move(qb));
+    r = Integer(std::move(rb));
   }
 
   /**
@@ -324,23 +666,39 @@ public:
    * Returns y mod 2^exp
    */
   Integer modByPow2(uint32_t exp) const {
+    if (!d_isBig && exp < std::numeric_limits<unsigned long int>::digits)
+    {
+      return Integer(static_cast<unsigned long int>(d_small)
+                     & ((1UL << exp) - 1));
+    }
     mpz_class res;
-    mpz_fdiv_r_2exp(res.get_mpz_t(), d_value.get_mpz_t(), exp);
-    return Integer(res);
+    mpz_fdiv_r_2exp(res.get_mpz_t(), View(*this).get(), exp);
+    return Integer(std::move(res));
   }
 
   /**
    * Returns y / 2^exp
    */
   Integer divByPow2(uint32_t exp) const {
+    if (!d_isBig)
+    {
+      // the arithmetic shift rounds towards negative infinity
+      return Integer(exp < std::numeric_limits<unsigned long int>::digits
+                         ? d_small >> exp
+                         : (d_small < 0 ? -1L : 0L));
+    }
     mpz_class res;
-    mpz_fdiv_q_2exp(res.get_mpz_t(), d_value.get_mpz_t(), exp);
-    return Integer(res);
+    mpz_fdiv_q_2exp(res.get_mpz_t(), d_big, exp);
+    return Integer(std::move(res));
   }
 
 
   int sgn() const {
-    return mpz_sgn(d_value.get_mpz_t());
+    if (!d_isBig)
+    {
+      return (d_small > 0) - (d_small < 0);
+    }
+    return mpz_sgn(d_big);
   }
 
   inline bool strictlyPositive() const {
@@ -356,11 +714,11 @@ public:
   }
 
   bool isOne() const {
-    return mpz_cmp_si(d_value.get_mpz_t(), 1) == 0;
+    return !d_isBig && d_small == 1;
   }
 
   bool isNegativeOne() const {
-    return mpz_cmp_si(d_value.get_mpz_t(), -1) == 0;
+    return !d_isBig && d_small == -1;
   }
 
   /**
@@ -370,26 +728,45 @@ public:
    */
   Integer pow(unsigned long int exp) const {
     mpz_class result;
-    mpz_pow_ui(result.get_mpz_t(), d_value.get_mpz_t(), exp);
-    return Integer(result);
+    mpz_pow_ui(result.get_mpz_t(), View(*this).get(), exp);
+    return Integer(std::move(result));
   }
 
   /**
    * Return the greatest common divisor of this integer with another.
    */
   Integer gcd(const Integer& y) const {
+    if (!d_isBig && !y.d_isBig)
+    {
+      // may be 2^63, which the unsigned constructor handles
+      return Integer(gcdWord(absWord(d_small), absWord(y.d_small)));
+    }
     mpz_class result;
-    mpz_gcd(result.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-    return Integer(result);
+    mpz_gcd(result.get_mpz_t(), View(*this).get(), View(y).get());
+    return Integer(std::move(result));
   }
 
   /**
    * Return the least common multiple of this integer with another.
    */
   Integer lcm(const Integer& y) const {
+    if (!d_isBig && !y.d_isBig)
+    {
+      unsigned long int a = absWord(d_small);
+      unsigned long int b = absWord(y.d_small);
+      unsigned long int r;
+      if (a == 0 || b == 0)
+      {
+        return Integer(0);
+      }
+      if (!__builtin_mul_overflow(a / gcdWord(a, b), b, &r))
+      {
+        return Integer(r);
+      }
+    }
     mpz_class result;
-    mpz_lcm(result.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-    return Integer(result);
+    mpz_lcm(result.get_mpz_t(), View(*this).get(), View(y).get());
+    return Integer(std::move(result));
   }
 
   /**
@@ -421,7 +798,15 @@ public:
    * ! zero.divides(zero)
    */
   bool divides(const Integer& y) const {
-    int res = mpz_divisible_p(y.d_value.get_mpz_t(), d_value.get_mpz_t());
+    if (!d_isBig && !y.d_isBig)
+    {
+      if (d_small == 0)
+      {
+        return y.d_small == 0;
+      }
+      return absWord(y.d_small) % absWord(d_small) == 0;
+    }
+    int res = mpz_divisible_p(View(y).get(), View(*this).get());
     return res != 0;
   }
 
@@ -429,11 +814,15 @@ public:
    * Return the absolute value of this integer.
    */
   Integer abs() const {
-    return d_value >= 0 ? *this : -*this;
+    return sgn() >= 0 ? *this : -*this;
   }
 
   std::string toString(int base = 10) const{
-    return d_value.get_str(base);
+    if (!d_isBig && base == 10)
+    {
+      return std::to_string(d_small);
+    }
+    return getValue().get_str(base);
   }
 
   bool fitsSignedInt() const;
@@ -449,19 +838,18 @@ public:
   bool fitsUnsignedLong() const;
 
   long getLong() const {
-    long si = d_value.get_si();
     // ensure there wasn't overflow
-    CheckArgument(mpz_cmp_si(d_value.get_mpz_t(), si) == 0, this,
+    CheckArgument(!d_isBig, this,
                  "Overflow detected in Integer::getLong().");
-    return si;
+    return d_small;
   }
 
   unsigned long getUnsignedLong() const {
-    unsigned long ui = d_value.get_ui();
     // ensure there wasn't overflow
-    CheckArgument(mpz_cmp_ui(d_value.get_mpz_t(), ui) == 0, this,
+    CheckArgument(fitsUnsignedLong(), this,
                   "Overflow detected in Integer::getUnsignedLong().");
-    return ui;
+    return d_isBig ? mpz_get_ui(d_big)
+                   : static_cast<unsigned long int>(d_small);
   }
 
   /**
@@ -469,7 +857,8 @@ public:
    * numerator, the denominator.
    */
   size_t hash() const {
-    return gmpz_hash(d_value.get_mpz_t());
+    // an inline value is a single limb, the hash of which is its magnitude
+    return d_isBig ? gmpz_hash(d_big) : absWord(d_small);
   }
 
   /**
@@ -479,7 +868,13 @@ public:
    * @return true if bit n is set in this integer; false otherwise
    */
   bool testBit(unsigned n) const {
-    return mpz_tstbit(d_value.get_mpz_t(), n);
+    if (!d_isBig)
+    {
+      return n < std::numeric_limits<unsigned long int>::digits
+                 ? (d_small >> n) & 1
+                 : d_small < 0;
+    }
+    return mpz_tstbit(d_big, n);
   }
 
   /**
@@ -487,11 +882,15 @@ public:
    * @return k if the integer is equal to 2^(k-1) and 0 otherwise
    */
   unsigned isPow2() const {
-    if (d_value <= 0) return 0;
+    if (sgn() <= 0) return 0;
+    if (!d_isBig)
+    {
+      return (d_small & (d_small - 1)) == 0 ? __builtin_ctzl(d_small) + 1 : 0;
+    }
     // check that the number of ones in the binary representation is 1
-    if (mpz_popcount(d_value.get_mpz_t()) == 1) {
+    if (mpz_popcount(d_big) == 1) {
       // return the index of the first one plus 1
-      return mpz_scan1(d_value.get_mpz_t(), 0) + 1;
+      return mpz_scan1(d_big, 0) + 1;
     }
     return 0; 
   }
@@ -504,15 +903,26 @@ public:
   size_t length() const {
     if(sgn() == 0){
       return 1;
+    }else if (!d_isBig){
+      return std::numeric_limits<unsigned long int>::digits
+             - __builtin_clzl(absWord(d_small));
     }else{
-      return mpz_sizeinbase(d_value.get_mpz_t(),2);
+      return mpz_sizeinbase(d_big,2);
     }
   }
 
   static void extendedGcd(Integer& g, Integer& s, Integer& t, const Integer& a, const Integer& b){
     //see the documentation for:
     //mpz_gcdext (mpz_t g, mpz_t s, mpz_t t, mpz_t a, mpz_t b);
-    mpz_gcdext (g.d_value.get_mpz_t(), s.d_value.get_mpz_t(), t.d_value.get_mpz_t(), a.d_value.get_mpz_t(), b.d_value.get_mpz_t());
+    mpz_class gb, sb, tb;
+    mpz_gcdext(gb.get_mpz_t(),
+               sb.get_mpz_t(),
+               tb.get_mpz_t(),
+               View(a).get(),
+               View(b).get());
+    g = Integer(std::move(gb));
+    s = Integer(std::move(sb));
+    t = Integer(std::move(tb));
   }
 
   /** Returns a reference to the minimum of two integers. */
@@ -0,0 +1,229 @@
+/*********************                                                        */
+/*! \file phase_profiler.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A sampling profiler of the phases of the solver
+ **
+ ** A sampling profiler of the phases of the solver.
+ **/
+
+#include "util/phase_profiler.h"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+#include "base/exception.h"
+#include "util/safe_print.h"
+
+namespace CVC4 {
+
+namespace {
+
+/** The maximal depth of the sampled stacks of phases */
+const unsigned s_maxDepth = 32;
+/** The maximal number of distinct sampled stacks */
+const unsigned s_maxStacks = 4096;
+
+/** A sampled stack of phases, with its number of samples */
+struct Stack
+{
+  unsigned d_depth;
+  const char* d_phases[s_maxDepth];
+  uint64_t d_count;
+};
+
+/** The stack of the current phases, whose depth may exceed s_maxDepth */
+const char* s_phases[s_maxDepth];
+volatile sig_atomic_t s_depth = 0;
+
+/** The sampled stacks, an open addressing table of their hashes */
+Stack s_stacks[s_maxStacks];
+/** The number of samples that did not fit in s_stacks */
+uint64_t s_dropped = 0;
+
+/** The file descriptor of the output file */
+int s_fd = -1;
+/** The thread whose phases are tracked */
+std::thread::id s_thread;
+/** The SIGPROF action and timer replaced by the profiler */
+struct sigaction s_oldAction;
+struct itimerval s_oldTimer;
+
+/** The SIGPROF handler, which records the stack of the current phases. */
+void sample(int sig)
+{
+  unsigned depth = s_depth < static_cast<sig_atomic_t>(s_maxDepth)
+                       ? static_cast<unsigned>(s_depth)
+                       : s_maxDepth;
+  uint64_t hash = depth;
+  for (unsigned i = 0; i < depth; i++)
+  {
+    hash = hash * 31 + reinterpret_cast<uintptr_t>(s_phases[i]);
+  }
+  for (unsigned probe = 0; probe < s_maxStacks; probe++)
+  {
+    Stack& s = s_stacks[(hash + probe) % s_maxStacks];
+    if (s.d_count == 0)
+    {
+      s.d_depth = depth;
+      std::memcpy(s.d_phases, s_phases, depth * sizeof(const char*));
+      s.d_count = 1;
+      return;
+    }
+    if (s.d_depth == depth
+        && std::memcmp(s.d_phases, s_phases, depth * sizeof(const char*))
+               == 0)
+    {
+      ++s.d_count;
+      return;
+    }
+  }
+  ++s_dropped;
+}
+
+void safe_print_phase(int fd, const char* phase)
+{
+  size_t n = std::strlen(phase);
+  if (write(fd, phase, n) != static_cast<ssize_t>(n))
+  {
+    abort();
+  }
+}
+
+}  // namespace
+
+bool PhaseProfiler::s_enabled = false;
+
+void PhaseProfiler::start(const std::string& filename, unsigned interval)
+{
+  if (s_enabled)
+  {
+    return;
+  }
+  s_fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (s_fd < 0)
+  {
+    throw Exception("cannot open " + filename
+                    + " for the phase profile: " + strerror(errno));
+  }
+  std::memset(s_stacks, 0, sizeof(s_stacks));
+  s_dropped = 0;
+  s_depth = 0;
+  s_thread = std::this_thread::get_id();
+
+  struct sigaction act;
+  std::memset(&act, 0, sizeof(act));
+  act.sa_handler = sample;
+  act.sa_flags = SA_RESTART;
+  sigemptyset(&act.sa_mask);
+  struct itimerval timer;
+  timer.it_interval.tv_sec = interval / 1000000;
+  timer.it_interval.tv_usec = interval % 1000000;
+  timer.it_value = timer.it_interval;
+  if (sigaction(SIGPROF, &act, &s_oldAction)
+      || setitimer(ITIMER_PROF, &timer, &s_oldTimer))
+  {
+    close(s_fd);
+    s_fd = -1;
+    throw Exception(std::string("cannot set the timer of the phase profile: ")
+                    + strerror(errno));
+  }
+  s_enabled = true;
+}
+
+void PhaseProfiler::stop()
+{
+  if (!s_enabled)
+  {
+    return;
+  }
+  setitimer(ITIMER_PROF, &s_oldTimer, nullptr);
+  sigaction(SIGPROF, &s_oldAction, nullptr);
+  s_enabled = false;
+  flush();
+  close(s_fd);
+  s_fd = -1;
+}
+
+void PhaseProfiler::flush()
+{
+  if (s_fd < 0 || lseek(s_fd, 0, SEEK_SET) < 0 || ftruncate(s_fd, 0) < 0)
+  {
+    return;
+  }
+  for (const Stack& s : s_stacks)
+  {
+    if (s.d_count == 0)
+    {
+      continue;
+    }
+    safe_print(s_fd, "cvc4");
+    for (unsigned i = 0; i < s.d_depth; i++)
+    {
+      safe_print(s_fd, ";");
+      safe_print_phase(s_fd, s.d_phases[i]);
+    }
+    safe_print(s_fd, " ");
+    safe_print<uint64_t>(s_fd, s.d_count);
+    safe_print(s_fd, "\n");
+  }
+  if (s_dropped > 0)
+  {
+    safe_print(s_fd, "cvc4;<dropped> ");
+    safe_print<uint64_t>(s_fd, s_dropped);
+    safe_print(s_fd, "\n");
+  }
+}
+
+const char* PhaseProfiler::intern(const std::string& name)
+{
+  static std::mutex s_lock;
+  // never deleted, since the names are used until the program exits
+  static std::unordered_set<std::string>* s_names =
+      new std::unordered_set<std::string>();
+  std::lock_guard<std::mutex> lock(s_lock);
+  return s_names->insert(name).first->c_str();
+}
+
+void PhaseProfiler::push(const char* phase)
+{
+  if (std::this_thread::get_id() != s_thread)
+  {
+    return;
+  }
+  if (s_depth < static_cast<sig_atomic_t>(s_maxDepth))
+  {
+    s_phases[s_depth] = phase;
+  }
+  // the phase is stored before the sampler can see it
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  s_depth = s_depth + 1;
+}
+
+void PhaseProfiler::pop()
+{
+  if (std::this_thread::get_id() != s_thread || s_depth == 0)
+  {
+    return;
+  }
+  s_depth = s_depth - 1;
+}
+
+}  // namespace CVC4
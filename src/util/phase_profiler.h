@@ -0,0 +1,123 @@
+/*********************                                                        */
+/*! \file phase_profiler.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A sampling profiler of the phases of the solver
+ **
+ ** The phases of the solver (parsing, preprocessing passes, CNF conversion,
+ ** SAT search, theory checks, quantifier strategies, ...) are tagged with
+ ** PhaseScope objects, which maintain a stack of the current phases. When
+ ** the profiler is started (see --profile-phases), a SIGPROF timer samples
+ ** this stack at a fixed interval of CPU time, and the number of samples of
+ ** each stack is written in the collapsed stack format of flame graphs,
+ ** i.e. one line "phase1;phase2;...;phaseN count" per stack.
+ **
+ ** The sampling and the writing of the samples are async-signal-safe, so
+ ** that the samples can be written from the signal handlers of the driver
+ ** (e.g. on a timeout). The phases are tracked for the thread that started
+ ** the profiler only.
+ **
+ ** This header is a "cvc4_private_library.h" header because it is private
+ ** but the profiler is started and flushed in the driver, and phases are
+ ** tagged in the parser.
+ **/
+
+#include "cvc4_private_library.h"
+
+#ifndef CVC4__UTIL__PHASE_PROFILER_H
+#define CVC4__UTIL__PHASE_PROFILER_H
+
+#include <string>
+
+namespace CVC4 {
+
+class CVC4_PUBLIC PhaseProfiler
+{
+ public:
+  /**
+   * Starts sampling the phases every interval microseconds of CPU time,
+   * the samples being written to the file filename by flush(). Throws an
+   * Exception if the file cannot be opened or the timer cannot be set.
+   */
+  static void start(const std::string& filename, unsigned interval);
+
+  /**
+   * Stops sampling, writes the samples and closes the file. Does nothing if
+   * the profiler is not started.
+   */
+  static void stop();
+
+  /**
+   * Writes the samples taken so far to the file, overwriting its content.
+   * Safe to use in a signal handler.
+   */
+  static void flush();
+
+  /** Returns true if the profiler is started. */
+  static bool isEnabled() { return s_enabled; }
+
+  /**
+   * Returns a copy of name that lives as long as the program, to be used as
+   * the name of a phase.
+   */
+  static const char* intern(const std::string& name);
+
+  /** Pushes phase on the stack of the current phases. */
+  static void push(const char* phase);
+  /** Pops the last phase of the stack of the current phases. */
+  static void pop();
+
+ private:
+  /** Whether the profiler is started */
+  static bool s_enabled;
+};
+
+/**
+ * A RAII tag of a phase, which is on the stack of the current phases during
+ * the lifetime of this object. It does nothing when the profiler is not
+ * started.
+ */
+class CVC4_PUBLIC PhaseScope
+{
+ public:
+  /** Tags the phase, whose name must live as long as the program. */
+  PhaseScope(const char* phase) : d_pushed(PhaseProfiler::isEnabled())
+  {
+    if (d_pushed)
+    {
+      PhaseProfiler::push(phase);
+    }
+  }
+  /** Tags the phase, whose name is interned if the profiler is started. */
+  PhaseScope(const std::string& phase) : d_pushed(PhaseProfiler::isEnabled())
+  {
+    if (d_pushed)
+    {
+      PhaseProfiler::push(PhaseProfiler::intern(phase));
+    }
+  }
+  ~PhaseScope()
+  {
+    if (d_pushed)
+    {
+      PhaseProfiler::pop();
+    }
+  }
+  PhaseScope(const PhaseScope&) = delete;
+  PhaseScope& operator=(const PhaseScope&) = delete;
+
+ private:
+  /** Whether the phase was pushed */
+  bool d_pushed;
+};
+
+}  // namespace CVC4
+
+#endif /* CVC4__UTIL__PHASE_PROFILER_H */
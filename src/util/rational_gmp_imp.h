@@ -28,6 +28,7 @@
 #include <cstddef>
 
 #include <gmp.h>
+#include <limits>
 #include <string>
 
 #include "base/exception.h"
@@ -54,10 +55,120 @@ namespace CVC4 {
 class CVC4_PUBLIC Rational {
 private:
   /**
-   * Stores the value of the rational is stored in a C++ GMP rational class.
-   * Using this instead of mpq_t allows for easier destruction.
+   * The value is stored inline as a numerator d_num and a positive
+   * denominator d_den if both fit into a signed long, and in the GMP
+   * rational d_big otherwise.  Both representations are canonical, and so is
+   * the choice between them: d_big never holds a value the numerator and
+   * denominator of which fit into a signed long.
    */
-  mpq_class d_value;
+  bool d_isBig;
+  union
+  {
+    struct
+    {
+      signed long int d_num;
+      signed long int d_den;
+    };
+    mpq_t d_big;
+  };
+
+  /**
+   * A read-only GMP view of the value of a rational, which is a temporary if
+   * the value is stored inline.
+   */
+  class View
+  {
+   public:
+    View(const Rational& q)
+    {
+      if (q.d_isBig)
+      {
+        d_ptr = q.d_big;
+      }
+      else
+      {
+        mpq_init(d_tmp);
+        mpq_set_si(d_tmp, q.d_num, q.d_den);
+        d_ptr = d_tmp;
+      }
+    }
+    ~View()
+    {
+      if (d_ptr == d_tmp)
+      {
+        mpq_clear(d_tmp);
+      }
+    }
+    mpq_srcptr get() const { return d_ptr; }
+
+   private:
+    mpq_t d_tmp;
+    mpq_srcptr d_ptr;
+  };
+
+  /** Stores the value of v, which is canonical, in a canonical way. */
+  void setBig(mpq_srcptr v)
+  {
+    if (mpz_fits_slong_p(mpq_numref(v)) && mpz_fits_slong_p(mpq_denref(v)))
+    {
+      d_isBig = false;
+      d_num = mpz_get_si(mpq_numref(v));
+      d_den = mpz_get_si(mpq_denref(v));
+    }
+    else
+    {
+      d_isBig = true;
+      mpq_init(d_big);
+      mpq_set(d_big, v);
+    }
+  }
+
+  /**
+   * Stores the value n/d inline if it can be canonicalized without
+   * overflow, and returns true if it could.  Requires d != 0.
+   */
+  bool setSmall(signed long int n, signed long int d)
+  {
+    if (d < 0)
+    {
+      if (n == std::numeric_limits<signed long int>::min()
+          || d == std::numeric_limits<signed long int>::min())
+      {
+        return false;
+      }
+      n = -n;
+      d = -d;
+    }
+    signed long int g = static_cast<signed long int>(
+        Integer::gcdWord(Integer::absWord(n), static_cast<unsigned long>(d)));
+    d_isBig = false;
+    d_num = n / g;
+    d_den = d / g;
+    return true;
+  }
+
+  /** Stores the value n/d, which need not be canonical. */
+  void set(signed long int n, signed long int d)
+  {
+    if (d == 0 || !setSmall(n, d))
+    {
+      mpq_class value(n, d);
+      value.canonicalize();
+      setBig(value.get_mpq_t());
+    }
+  }
+
+  /** Stores the value n/d, which need not be canonical. */
+  void set(const Integer& n, const Integer& d)
+  {
+    if (n.d_isBig || d.d_isBig || d.d_small == 0
+        || !setSmall(n.d_small, d.d_small))
+    {
+      mpq_class value(n.get_mpz(), d.get_mpz());
+      value.canonicalize();
+      setBig(value.get_mpq_t());
+    }
+  }
 
   /**
    * Constructs a Rational from a mpq_class object.
@@ -65,7 +176,27 @@ private:
    * Assumes that the value is in canonical form, and thus does not
    * have to call canonicalize() on the value.
    */
-  Rational(const mpq_class& val) : d_value(val) {  }
+  Rational(const mpq_class& val) { setBig(val.get_mpq_t()); }
+
+  /**
+   * Returns the inline value n/d, which is canonical, or the result of
+   * big() if n or d overflowed.
+   */
+  template <class F>
+  static Rational fromWords(bool overflow,
+                            signed long int n,
+                            signed long int d,
+                            F big)
+  {
+    if (overflow)
+    {
+      return big();
+    }
+    Rational q;
+    q.d_num = n;
+    q.d_den = d;
+    return q;
+  }
 
 public:
 
@@ -78,9 +209,7 @@ public:
   static Rational fromDecimal(const std::string& dec);
 
   /** Constructs a rational with the value 0/1. */
-  Rational() : d_value(0){
-    d_value.canonicalize();
-  }
+  Rational() : d_isBig(false), d_num(0), d_den(1) {}
 
   /**
    * Constructs a Rational from a C string in a given base (defaults to 10).
@@ -89,88 +218,114 @@ public:
    * For more information about what is a valid rational string,
    * see GMP's documentation for mpq_set_str().
    */
-  explicit Rational(const char* s, unsigned base = 10): d_value(s, base) {
-    d_value.canonicalize();
+  explicit Rational(const char* s, unsigned base = 10) {
+    mpq_class value(s, base);
+    value.canonicalize();
+    setBig(value.get_mpq_t());
   }
-  Rational(const std::string& s, unsigned base = 10) : d_value(s, base) {
-    d_value.canonicalize();
+  Rational(const std::string& s, unsigned base = 10) {
+    mpq_class value(s, base);
+    value.canonicalize();
+    setBig(value.get_mpq_t());
   }
 
   /**
    * Creates a Rational from another Rational, q, by performing a deep copy.
    */
-  Rational(const Rational& q) : d_value(q.d_value) {
-    d_value.canonicalize();
+  Rational(const Rational& q) : d_isBig(q.d_isBig) {
+    if (d_isBig)
+    {
+      mpq_init(d_big);
+      mpq_set(d_big, q.d_big);
+    }
+    else
+    {
+      d_num = q.d_num;
+      d_den = q.d_den;
+    }
+  }
+
+  Rational(Rational&& q) noexcept : d_isBig(q.d_isBig)
+  {
+    if (d_isBig)
+    {
+      d_big[0] = q.d_big[0];
+      q.d_isBig = false;
+      q.d_num = 0;
+      q.d_den = 1;
+    }
+    else
+    {
+      d_num = q.d_num;
+      d_den = q.d_den;
+    }
   }
 
   /**
    * Constructs a canonical Rational from a numerator.
    */
-  Rational(signed int n) : d_value(n,1) {
-    d_value.canonicalize();
-  }
-  Rational(unsigned int n) : d_value(n,1) {
-    d_value.canonicalize();
-  }
-  Rational(signed long int n) : d_value(n,1) {
-    d_value.canonicalize();
-  }
-  Rational(unsigned long int n) : d_value(n,1) {
-    d_value.canonicalize();
-  }
+  Rational(signed int n) : d_isBig(false), d_num(n), d_den(1) {}
+  Rational(unsigned int n) { set(Integer(n), Integer(1)); }
+  Rational(signed long int n) : d_isBig(false), d_num(n), d_den(1) {}
+  Rational(unsigned long int n) { set(Integer(n), Integer(1)); }
 
 #ifdef CVC4_NEED_INT64_T_OVERLOADS
-  Rational(int64_t n) : d_value(static_cast<long>(n), 1) {
-    d_value.canonicalize();
-  }
-  Rational(uint64_t n) : d_value(static_cast<unsigned long>(n), 1) {
-    d_value.canonicalize();
-  }
+  Rational(int64_t n) : Rational(static_cast<long>(n)) {}
+  Rational(uint64_t n) : Rational(static_cast<unsigned long>(n)) {}
 #endif /* CVC4_NEED_INT64_T_OVERLOADS */
 
   /**
    * Constructs a canonical Rational from a numerator and denominator.
    */
-  Rational(signed int n, signed int d) : d_value(n,d) {
-    d_value.canonicalize();
-  }
-  Rational(unsigned int n, unsigned int d) : d_value(n,d) {
-    d_value.canonicalize();
-  }
-  Rational(signed long int n, signed long int d) : d_value(n,d) {
-    d_value.canonicalize();
-  }
-  Rational(unsigned long int n, unsigned long int d) : d_value(n,d) {
-    d_value.canonicalize();
+  Rational(signed int n, signed int d) { set(n, d); }
+  Rational(unsigned int n, unsigned int d) { set(Integer(n), Integer(d)); }
+  Rational(signed long int n, signed long int d) { set(n, d); }
+  Rational(unsigned long int n, unsigned long int d)
+  {
+    set(Integer(n), Integer(d));
   }
 
 #ifdef CVC4_NEED_INT64_T_OVERLOADS
-  Rational(int64_t n, int64_t d) : d_value(static_cast<long>(n), static_cast<long>(d)) {
-    d_value.canonicalize();
+  Rational(int64_t n, int64_t d)
+      : Rational(static_cast<long>(n), static_cast<long>(d))
+  {
   }
-  Rational(uint64_t n, uint64_t d) : d_value(static_cast<unsigned long>(n), static_cast<unsigned long>(d)) {
-    d_value.canonicalize();
+  Rational(uint64_t n, uint64_t d)
+      : Rational(static_cast<unsigned long>(n), static_cast<unsigned long>(d))
+  {
   }
 #endif /* CVC4_NEED_INT64_T_OVERLOADS */
 
-  Rational(const Integer& n, const Integer& d) :
-    d_value(n.get_mpz(), d.get_mpz())
+  Rational(const Integer& n, const Integer& d) { set(n, d); }
+  Rational(const Integer& n)
   {
-    d_value.canonicalize();
+    if (n.d_isBig)
+    {
+      d_isBig = true;
+      mpq_init(d_big);
+      mpq_set_z(d_big, n.d_big);
+    }
+    else
+    {
+      d_isBig = false;
+      d_num = n.d_small;
+      d_den = 1;
+    }
   }
-  Rational(const Integer& n) :
-    d_value(n.get_mpz())
+  ~Rational()
   {
-    d_value.canonicalize();
+    if (d_isBig)
+    {
+      mpq_clear(d_big);
+    }
   }
-  ~Rational() {}
 
   /**
-   * Returns a copy of d_value to enable public access of GMP data.
+   * Returns a copy of the value to enable public access of GMP data.
    */
   mpq_class getValue() const
   {
-    return d_value;
+    return mpq_class(View(*this).get());
   }
 
   /**
@@ -178,7 +333,7 @@ public:
    * Note that this makes a deep copy of the numerator.
    */
   Integer getNumerator() const {
-    return Integer(d_value.get_num());
+    return d_isBig ? Integer(mpz_class(mpq_numref(d_big))) : Integer(d_num);
   }
 
   /**
@@ -186,7 +341,7 @@ public:
    * Note that this makes a deep copy of the denominator.
    */
   Integer getDenominator() const {
-    return Integer(d_value.get_den());
+    return d_isBig ? Integer(mpz_class(mpq_denref(d_big))) : Integer(d_den);
   }
 
   static Maybe<Rational> fromDouble(double d);
@@ -197,7 +352,12 @@ public:
    * infinity, and underflow may result in zero.
    */
   double getDouble() const {
-    return d_value.get_d();
+    // integers of at most 53 bits are exact doubles
+    if (!d_isBig && d_den == 1 && Integer::absWord(d_num) <= (1UL << 53))
+    {
+      return static_cast<double>(d_num);
+    }
+    return mpq_get_d(View(*this).get());
   }
 
   Rational inverse() const {
@@ -205,13 +365,30 @@ public:
   }
 
   int cmp(const Rational& x) const {
+    if (!d_isBig && !x.d_isBig)
+    {
+      signed long int a, b;
+      if (d_den == x.d_den)
+      {
+        return d_num < x.d_num ? -1 : (d_num > x.d_num ? 1 : 0);
+      }
+      if (!__builtin_mul_overflow(d_num, x.d_den, &a)
+          && !__builtin_mul_overflow(x.d_num, d_den, &b))
+      {
+        return a < b ? -1 : (a > b ? 1 : 0);
+      }
+    }
     //Don't use mpq_class's cmp() function.
     //The name ends up conflicting with this function.
-    return mpq_cmp(d_value.get_mpq_t(), x.d_value.get_mpq_t());
+    return mpq_cmp(View(*this).get(), View(x).get());
   }
 
   int sgn() const {
-    return mpq_sgn(d_value.get_mpq_t());
+    if (!d_isBig)
+    {
+      return (d_num > 0) - (d_num < 0);
+    }
+    return mpq_sgn(d_big);
   }
 
   bool isZero() const {
@@ -219,11 +396,11 @@ public:
   }
 
   bool isOne() const {
-    return mpq_cmp_si(d_value.get_mpq_t(), 1, 1) == 0;
+    return !d_isBig && d_num == 1 && d_den == 1;
   }
 
   bool isNegativeOne() const {
-    return mpq_cmp_si(d_value.get_mpq_t(), -1, 1) == 0;
+    return !d_isBig && d_num == -1 && d_den == 1;
   }
 
   Rational abs() const {
@@ -235,15 +412,25 @@ public:
   }
 
   Integer floor() const {
+    if (!d_isBig)
+    {
+      signed long int q = d_num / d_den;
+      return Integer(d_num % d_den < 0 ? q - 1 : q);
+    }
     mpz_class q;
-    mpz_fdiv_q(q.get_mpz_t(), d_value.get_num_mpz_t(), d_value.get_den_mpz_t());
-    return Integer(q);
+    mpz_fdiv_q(q.get_mpz_t(), mpq_numref(d_big), mpq_denref(d_big));
+    return Integer(std::move(q));
   }
 
   Integer ceiling() const {
+    if (!d_isBig)
+    {
+      signed long int q = d_num / d_den;
+      return Integer(d_num % d_den > 0 ? q + 1 : q);
+    }
     mpz_class q;
-    mpz_cdiv_q(q.get_mpz_t(), d_value.get_num_mpz_t(), d_value.get_den_mpz_t());
-    return Integer(q);
+    mpz_cdiv_q(q.get_mpz_t(), mpq_numref(d_big), mpq_denref(d_big));
+    return Integer(std::move(q));
   }
 
   Rational floor_frac() const {
@@ -252,78 +439,166 @@ public:
 
   Rational& operator=(const Rational& x){
     if(this == &x) return *this;
-    d_value = x.d_value;
+    if (x.d_isBig)
+    {
+      if (!d_isBig)
+      {
+        mpq_init(d_big);
+        d_isBig = true;
+      }
+      mpq_set(d_big, x.d_big);
+    }
+    else
+    {
+      if (d_isBig)
+      {
+        mpq_clear(d_big);
+        d_isBig = false;
+      }
+      d_num = x.d_num;
+      d_den = x.d_den;
+    }
+    return *this;
+  }
+
+  Rational& operator=(Rational&& x) noexcept
+  {
+    if (this == &x) return *this;
+    if (d_isBig)
+    {
+      mpq_clear(d_big);
+    }
+    d_isBig = x.d_isBig;
+    if (d_isBig)
+    {
+      d_big[0] = x.d_big[0];
+      x.d_isBig = false;
+      x.d_num = 0;
+      x.d_den = 1;
+    }
+    else
+    {
+      d_num = x.d_num;
+      d_den = x.d_den;
+    }
     return *this;
   }
 
   Rational operator-() const{
-    return Rational(-(d_value));
+    if (!d_isBig && d_num != std::numeric_limits<signed long int>::min())
+    {
+      return fromWords(false, -d_num, d_den, [] { return Rational(); });
+    }
+    mpq_class result;
+    mpq_neg(result.get_mpq_t(), View(*this).get());
+    return Rational(result);
   }
 
   bool operator==(const Rational& y) const {
-    return d_value == y.d_value;
+    if (d_isBig != y.d_isBig) return false;
+    return d_isBig ? mpq_equal(d_big, y.d_big) != 0
+                   : d_num == y.d_num && d_den == y.d_den;
   }
 
   bool operator!=(const Rational& y) const {
-    return d_value != y.d_value;
+    return !(*this == y);
   }
 
   bool operator< (const Rational& y) const {
-    return d_value < y.d_value;
+    return cmp(y) < 0;
   }
 
   bool operator<=(const Rational& y) const {
-    return d_value <= y.d_value;
+    return cmp(y) <= 0;
   }
 
   bool operator> (const Rational& y) const {
-    return d_value > y.d_value;
+    return cmp(y) > 0;
   }
 
   bool operator>=(const Rational& y) const {
-    return d_value >= y.d_value;
+    return cmp(y) >= 0;
   }
 
   Rational operator+(const Rational& y) const{
-    return Rational( d_value + y.d_value );
+    if (!d_isBig && !y.d_isBig)
+    {
+      return addWords(d_num, d_den, y.d_num, y.d_den, [this, &y] {
+        return addBig(*this, y);
+      });
+    }
+    return addBig(*this, y);
   }
   Rational operator-(const Rational& y) const {
-    return Rational( d_value - y.d_value );
+    if (!d_isBig && !y.d_isBig
+        && y.d_num != std::numeric_limits<signed long int>::min())
+    {
+      return addWords(d_num, d_den, -y.d_num, y.d_den, [this, &y] {
+        return subBig(*this, y);
+      });
+    }
+    return subBig(*this, y);
   }
 
   Rational operator*(const Rational& y) const {
-    return Rational( d_value * y.d_value );
+    if (!d_isBig && !y.d_isBig)
+    {
+      return mulWords(d_num, d_den, y.d_num, y.d_den, [this, &y] {
+        return mulBig(*this, y);
+      });
+    }
+    return mulBig(*this, y);
   }
   Rational operator/(const Rational& y) const {
-    return Rational( d_value / y.d_value );
+    if (!d_isBig && !y.d_isBig && y.d_num != 0
+        && y.d_num != std::numeric_limits<signed long int>::min())
+    {
+      // the inverse of n/d is canonical up to the sign
+      signed long int n = y.d_num < 0 ? -y.d_den : y.d_den;
+      signed long int d = y.d_num < 0 ? -y.d_num : y.d_num;
+      return mulWords(d_num, d_den, n, d, [this, &y] {
+        return divBig(*this, y);
+      });
+    }
+    return divBig(*this, y);
   }
 
   Rational& operator+=(const Rational& y){
-    d_value += y.d_value;
+    *this = *this + y;
     return (*this);
   }
   Rational& operator-=(const Rational& y){
-    d_value -= y.d_value;
+    *this = *this - y;
     return (*this);
   }
 
   Rational& operator*=(const Rational& y){
-    d_value *= y.d_value;
+    *this = *this * y;
     return (*this);
   }
 
   Rational& operator/=(const Rational& y){
-    d_value /= y.d_value;
+    *this = *this / y;
     return (*this);
   }
 
   bool isIntegral() const{
-    return getDenominator() == 1;
+    if (!d_isBig)
+    {
+      return d_den == 1;
+    }
+    return mpz_cmp_ui(mpq_denref(d_big), 1) == 0;
   }
 
   /** Returns a string representing the rational in the given base. */
   std::string toString(int base = 10) const {
-    return d_value.get_str(base);
+    if (!d_isBig && base == 10)
+    {
+      return d_den == 1
+                 ? std::to_string(d_num)
+                 : std::to_string(d_num) + "/" + std::to_string(d_den);
+    }
+    return getValue().get_str(base);
   }
 
   /**
@@ -331,8 +606,13 @@ public:
    * denominator.
    */
   size_t hash() const {
-    size_t numeratorHash = gmpz_hash(d_value.get_num_mpz_t());
-    size_t denominatorHash = gmpz_hash(d_value.get_den_mpz_t());
+    if (!d_isBig)
+    {
+      // the hash of a single limb is its magnitude
+      return Integer::absWord(d_num) xor static_cast<size_t>(d_den);
+    }
+    size_t numeratorHash = gmpz_hash(mpq_numref(d_big));
+    size_t denominatorHash = gmpz_hash(mpq_denref(d_big));
 
     return numeratorHash xor denominatorHash;
   }
@@ -346,6 +626,87 @@ public:
   /** Equivalent to calling (this->abs()).cmp(b.abs()) */
   int absCmp(const Rational& q) const;
 
+ private:
+  /**
+   * Returns a/b + c/d for canonical inline values, or big() on overflow.
+   * See Knuth, TAOCP Vol. 2, 4.5.1.
+   */
+  template <class F>
+  static Rational addWords(signed long int a,
+                           signed long int b,
+                           signed long int c,
+                           signed long int d,
+                           F big)
+  {
+    signed long int g = static_cast<signed long int>(
+        Integer::gcdWord(static_cast<unsigned long>(b),
+                         static_cast<unsigned long>(d)));
+    signed long int t1, t2, t, n, den;
+    bool overflow = __builtin_mul_overflow(a, d / g, &t1)
+                    || __builtin_mul_overflow(c, b / g, &t2)
+                    || __builtin_add_overflow(t1, t2, &t);
+    if (overflow)
+    {
+      return big();
+    }
+    // gcd(t, b*d/g) = gcd(t, g)
+    signed long int g2 = static_cast<signed long int>(Integer::gcdWord(
+        Integer::absWord(t), static_cast<unsigned long>(g)));
+    n = t / g2;
+    overflow = __builtin_mul_overflow(b / g, d / g2, &den);
+    return fromWords(overflow, n, den, big);
+  }
+
+  /**
+   * Returns (a/b) * (c/d) for canonical inline values, or big() on
+   * overflow.
+   */
+  template <class F>
+  static Rational mulWords(signed long int a,
+                           signed long int b,
+                           signed long int c,
+                           signed long int d,
+                           F big)
+  {
+    signed long int g1 = static_cast<signed long int>(Integer::gcdWord(
+        Integer::absWord(a), static_cast<unsigned long>(d)));
+    signed long int g2 = static_cast<signed long int>(Integer::gcdWord(
+        Integer::absWord(c), static_cast<unsigned long>(b)));
+    if (g1 == 0 || g2 == 0)
+    {
+      // a zero factor
+      return Rational();
+    }
+    signed long int n, den;
+    bool overflow = __builtin_mul_overflow(a / g1, c / g2, &n)
+                    || __builtin_mul_overflow(b / g2, d / g1, &den);
+    return fromWords(overflow, n, den, big);
+  }
+
+  static Rational addBig(const Rational& x, const Rational& y)
+  {
+    mpq_class result;
+    mpq_add(result.get_mpq_t(), View(x).get(), View(y).get());
+    return Rational(result);
+  }
+  static Rational subBig(const Rational& x, const Rational& y)
+  {
+    mpq_class result;
+    mpq_sub(result.get_mpq_t(), View(x).get(), View(y).get());
+    return Rational(result);
+  }
+  static Rational mulBig(const Rational& x, const Rational& y)
+  {
+    mpq_class result;
+    mpq_mul(result.get_mpq_t(), View(x).get(), View(y).get());
+    return Rational(result);
+  }
+  static Rational divBig(const Rational& x, const Rational& y)
+  {
+    mpq_class result;
+    mpq_div(result.get_mpq_t(), View(x).get(), View(y).get());
+    return Rational(result);
+  }
 };/* class Rational */
 
 struct RationalHashFunction {
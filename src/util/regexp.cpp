@@ -25,6 +25,7 @@
 
 #include "base/check.h"
 #include "base/exception.h"
+#include "util/hash.h"
 
 using namespace std;
 
@@ -58,12 +59,12 @@ unsigned String::convertUnsignedIntToCode(unsigned i)
   return (i + start_code()) % num_codes();
 }
 
-String::String(const std::vector<unsigned> &s) : d_str(s)
+String::String(const std::vector<unsigned> &s) : d_str(s.begin(), s.end())
 {
 #ifdef CVC4_ASSERTIONS
-  for (unsigned u : d_str)
+  for (unsigned u : s)
   {
-    Assert(convertUnsignedIntToCode(u) < num_codes());
+    Assert(u < num_codes());
   }
 #endif
 }
@@ -83,9 +84,21 @@ int String::cmp(const String &y) const {
 }
 
 String String::concat(const String &other) const {
-  std::vector<unsigned int> ret_vec(d_str);
+  std::vector<unsigned char> ret_vec;
+  ret_vec.reserve(size() + other.size());
+  ret_vec.insert(ret_vec.end(), d_str.begin(), d_str.end());
   ret_vec.insert(ret_vec.end(), other.d_str.begin(), other.d_str.end());
-  return String(ret_vec);
+  return String(std::move(ret_vec));
+}
+
+size_t String::hash() const
+{
+  uint64_t ret = fnv1a::fnv1a_64(d_str.size());
+  for (unsigned char c : d_str)
+  {
+    ret = fnv1a::fnv1a_64(c, ret);
+  }
+  return static_cast<size_t>(ret);
 }
 
 bool String::strncmp(const String& y, std::size_t n) const
@@ -122,9 +135,9 @@ bool String::rstrncmp(const String& y, std::size_t n) const
   return true;
 }
 
-std::vector<unsigned> String::toInternal(const std::string &s,
-                                         bool useEscSequences) {
-  std::vector<unsigned> str;
+std::vector<unsigned char> String::toInternal(const std::string &s,
+                                              bool useEscSequences) {
+  std::vector<unsigned char> str;
   unsigned i = 0;
   while (i < s.size()) {
     if (s[i] == '\\' && useEscSequences) {
@@ -375,7 +388,7 @@ std::size_t String::find(const String &y, const std::size_t start) const {
   if (y.empty()) return start;
   if (empty()) return std::string::npos;
 
-  std::vector<unsigned>::const_iterator itr = std::search(
+  std::vector<unsigned char>::const_iterator itr = std::search(
       d_str.begin() + start, d_str.end(), y.d_str.begin(), y.d_str.end());
   if (itr != d_str.end()) {
     return itr - d_str.begin();
@@ -388,7 +401,7 @@ std::size_t String::rfind(const String &y, const std::size_t start) const {
   if (y.empty()) return start;
   if (empty()) return std::string::npos;
 
-  std::vector<unsigned>::const_reverse_iterator itr = std::search(
+  std::vector<unsigned char>::const_reverse_iterator itr = std::search(
       d_str.rbegin() + start, d_str.rend(), y.d_str.rbegin(), y.d_str.rend());
   if (itr != d_str.rend()) {
     return itr - d_str.rbegin();
@@ -436,11 +449,11 @@ bool String::hasSuffix(const String& y) const
 String String::replace(const String &s, const String &t) const {
   std::size_t ret = find(s);
   if (ret != std::string::npos) {
-    std::vector<unsigned int> vec;
+    std::vector<unsigned char> vec;
     vec.insert(vec.begin(), d_str.begin(), d_str.begin() + ret);
     vec.insert(vec.end(), t.d_str.begin(), t.d_str.end());
     vec.insert(vec.end(), d_str.begin() + ret + s.size(), d_str.end());
-    return String(vec);
+    return String(std::move(vec));
   } else {
     return *this;
   }
@@ -448,18 +461,18 @@ String String::replace(const String &s, const String &t) const {
 
 String String::substr(std::size_t i) const {
   Assert(i <= size());
-  std::vector<unsigned int> ret_vec;
-  std::vector<unsigned int>::const_iterator itr = d_str.begin() + i;
+  std::vector<unsigned char> ret_vec;
+  std::vector<unsigned char>::const_iterator itr = d_str.begin() + i;
   ret_vec.insert(ret_vec.end(), itr, d_str.end());
-  return String(ret_vec);
+  return String(std::move(ret_vec));
 }
 
 String String::substr(std::size_t i, std::size_t j) const {
   Assert(i + j <= size());
-  std::vector<unsigned int> ret_vec;
-  std::vector<unsigned int>::const_iterator itr = d_str.begin() + i;
+  std::vector<unsigned char> ret_vec;
+  std::vector<unsigned char>::const_iterator itr = d_str.begin() + i;
   ret_vec.insert(ret_vec.end(), itr, itr + j);
-  return String(ret_vec);
+  return String(std::move(ret_vec));
 }
 
 bool String::noOverlapWith(const String& y) const
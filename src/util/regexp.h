@@ -24,6 +24,7 @@
 #include <functional>
 #include <ostream>
 #include <string>
+#include <utility>
 #include <vector>
 #include "util/rational.h"
 
@@ -72,7 +73,7 @@ class CVC4_PUBLIC String {
   /** constructors for String
   *
   * Internally, a CVC4::String is represented by a vector of unsigned
-  * integers (d_str), where the correspondence between C++ characters
+  * chars (d_str), where the correspondence between C++ characters
   * to and from unsigned integers is determined by
   * by convertCharToUnsignedInt and convertUnsignedIntToChar.
   *
@@ -222,7 +223,12 @@ class CVC4_PUBLIC String {
   /** Returns the corresponding rational for the text of this string. */
   Rational toNumber() const;
   /** get the internal unsigned representation of this string */
-  const std::vector<unsigned>& getVec() const { return d_str; }
+  std::vector<unsigned> getVec() const
+  {
+    return std::vector<unsigned>(d_str.begin(), d_str.end());
+  }
+  /** Returns a hash of this string */
+  size_t hash() const;
   /** get the internal unsigned value of the first character in this string */
   unsigned front() const;
   /** get the internal unsigned value of the last character in this string */
@@ -241,8 +247,10 @@ class CVC4_PUBLIC String {
   // guarded
   static unsigned char hexToDec(unsigned char c);
 
-  static std::vector<unsigned> toInternal(const std::string& s,
-                                          bool useEscSequences = true);
+  static std::vector<unsigned char> toInternal(const std::string& s,
+                                               bool useEscSequences = true);
+  /** Constructs the string whose internal representation is s */
+  explicit String(std::vector<unsigned char>&& s) : d_str(std::move(s)) {}
 
   /**
    * Returns a negative number if *this < y, 0 if *this and y are equal and a
@@ -250,14 +258,18 @@ class CVC4_PUBLIC String {
    */
   int cmp(const String& y) const;
 
-  std::vector<unsigned> d_str;
+  /**
+   * The internal representation of the characters, which is one byte per
+   * character since num_codes() is 256.
+   */
+  std::vector<unsigned char> d_str;
 }; /* class String */
 
 namespace strings {
 
 struct CVC4_PUBLIC StringHashFunction {
   size_t operator()(const ::CVC4::String& s) const {
-    return std::hash<std::string>()(s.toString());
+    return s.hash();
   }
 }; /* struct StringHashFunction */
 
@@ -16,6 +16,21 @@
 **/
 #include "util/resource_manager.h"
 
+#if defined(__linux__)
+#include <unistd.h>
+
+#include <fstream>
+#elif !defined(__MINGW32__)
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <thread>
+
 #include "base/check.h"
 #include "base/output.h"
 #include "options/smt_options.h"
@@ -73,6 +88,16 @@ uint64_t Timer::elapsed() const {
   return elapsedCPU();
 }
 
+uint64_t Timer::remaining() const
+{
+  if (!on())
+  {
+    return std::numeric_limits<uint64_t>::max();
+  }
+  uint64_t e = elapsed();
+  return e >= d_ms ? 0 : d_ms - e;
+}
+
 bool Timer::expired() const {
   if (!on()) return false;
 
@@ -118,7 +143,12 @@ struct ResourceManager::Statistics
   IntStat d_numRestartStep;
   IntStat d_numRewriteStep;
   IntStat d_numSatConflictStep;
+  IntStat d_numSatInprocessStep;
   IntStat d_numTheoryCheckStep;
+  /** The peak resident memory seen by the memory checks, in megabytes */
+  IntStat d_memoryUsage;
+  /** The number of times the memory listeners were asked to shed caches */
+  IntStat d_memoryCacheSheds;
   Statistics(StatisticsRegistry& stats);
   ~Statistics();
 
@@ -140,7 +170,10 @@ ResourceManager::Statistics::Statistics(StatisticsRegistry& stats)
       d_numRestartStep("resource::RestartStep", 0),
       d_numRewriteStep("resource::RewriteStep", 0),
       d_numSatConflictStep("resource::SatConflictStep", 0),
+      d_numSatInprocessStep("resource::SatInprocessStep", 0),
       d_numTheoryCheckStep("resource::TheoryCheckStep", 0),
+      d_memoryUsage("resource::MemoryUsage", 0),
+      d_memoryCacheSheds("resource::MemoryCacheSheds", 0),
       d_statisticsRegistry(stats)
 {
   d_statisticsRegistry.registerStat(&d_numBitblastStep);
@@ -156,7 +189,10 @@ ResourceManager::Statistics::Statistics(StatisticsRegistry& stats)
   d_statisticsRegistry.registerStat(&d_numRestartStep);
   d_statisticsRegistry.registerStat(&d_numRewriteStep);
   d_statisticsRegistry.registerStat(&d_numSatConflictStep);
+  d_statisticsRegistry.registerStat(&d_numSatInprocessStep);
   d_statisticsRegistry.registerStat(&d_numTheoryCheckStep);
+  d_statisticsRegistry.registerStat(&d_memoryUsage);
+  d_statisticsRegistry.registerStat(&d_memoryCacheSheds);
 }
 
 ResourceManager::Statistics::~Statistics()
@@ -174,13 +210,93 @@ ResourceManager::Statistics::~Statistics()
   d_statisticsRegistry.unregisterStat(&d_numRestartStep);
   d_statisticsRegistry.unregisterStat(&d_numRewriteStep);
   d_statisticsRegistry.unregisterStat(&d_numSatConflictStep);
+  d_statisticsRegistry.unregisterStat(&d_numSatInprocessStep);
   d_statisticsRegistry.unregisterStat(&d_numTheoryCheckStep);
+  d_statisticsRegistry.unregisterStat(&d_memoryUsage);
+  d_statisticsRegistry.unregisterStat(&d_memoryCacheSheds);
 }
 
 /*---------------------------------------------------------------------------*/
 
+class ResourceManager::Watchdog
+{
+ public:
+  Watchdog(std::atomic<bool>& expired)
+      : d_expired(expired),
+        d_armed(false),
+        d_stop(false),
+        d_thread(&Watchdog::run, this)
+  {
+  }
+  ~Watchdog()
+  {
+    {
+      std::lock_guard<std::mutex> lock(d_mutex);
+      d_stop = true;
+    }
+    d_cv.notify_one();
+    d_thread.join();
+  }
+
+  /** Sets the expired flag millis milliseconds from now */
+  void arm(uint64_t millis)
+  {
+    {
+      std::lock_guard<std::mutex> lock(d_mutex);
+      d_expired = false;
+      d_armed = true;
+      d_deadline =
+          std::chrono::steady_clock::now() + std::chrono::milliseconds(millis);
+    }
+    d_cv.notify_one();
+  }
+
+  void disarm()
+  {
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_armed = false;
+  }
+
+ private:
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (!d_stop)
+    {
+      if (!d_armed)
+      {
+        d_cv.wait(lock);
+      }
+      else if (d_cv.wait_until(lock, d_deadline) == std::cv_status::timeout
+               && d_armed && std::chrono::steady_clock::now() >= d_deadline)
+      {
+        d_expired = true;
+        d_armed = false;
+      }
+    }
+  }
+
+  std::atomic<bool>& d_expired;
+  std::mutex d_mutex;
+  std::condition_variable d_cv;
+  bool d_armed;
+  bool d_stop;
+  std::chrono::steady_clock::time_point d_deadline;
+  std::thread d_thread;
+};
+
+/*---------------------------------------------------------------------------*/
+
 const uint64_t ResourceManager::s_resourceCount = 1000;
 
+/** How often (in spent resources) the time of the progress callback is
+ * checked */
+static const uint64_t s_progressCount = 256;
+
+/** How often (in spent resources) the memory used is checked against the
+ * memory limit */
+static const uint64_t s_memoryCount = 4096;
+
 ResourceManager::ResourceManager(StatisticsRegistry& stats, Options& options)
     : d_cumulativeTimer(),
       d_perCallTimer(),
@@ -193,18 +309,29 @@ ResourceManager::ResourceManager(StatisticsRegistry& stats, Options& options)
       d_thisCallResourceUsed(0),
       d_thisCallTimeBudget(0),
       d_thisCallResourceBudget(0),
+      d_memoryLimit(0),
+      d_memoryShed(false),
+      d_outOfMemory(false),
       d_isHardLimit(),
       d_on(false),
       d_cpuTime(false),
       d_spendResourceCalls(0),
+      d_cancelled(false),
+      d_progressCallback(),
+      d_progressInterval(0),
+      d_progressLast(),
       d_hardListeners(),
       d_softListeners(),
+      d_memoryListeners(),
       d_statistics(new ResourceManager::Statistics(stats)),
+      d_timeExpired(false),
+      d_watchdogArmed(false),
+      d_watchdog(),
       d_options(options)
 
 {}
 
-ResourceManager::~ResourceManager() {}
+ResourceManager::~ResourceManager() { d_watchdog.reset(nullptr); }
 
 void ResourceManager::setResourceLimit(uint64_t units, bool cumulative) {
   d_on = true;
@@ -232,6 +359,17 @@ void ResourceManager::setTimeLimit(uint64_t millis, bool cumulative) {
 
 }
 
+void ResourceManager::setMemoryLimit(uint64_t megabytes)
+{
+  Trace("limit") << "ResourceManager: setting memory limit to " << megabytes
+                 << " MB" << endl;
+  d_memoryLimit = megabytes;
+  if (megabytes > 0)
+  {
+    d_on = true;
+  }
+}
+
 const uint64_t& ResourceManager::getResourceUsage() const {
   return d_cumulativeResourceUsed;
 }
@@ -256,10 +394,78 @@ uint64_t ResourceManager::getTimeRemaining() const {
   return d_thisCallTimeBudget - time_passed;
 }
 
+uint64_t ResourceManager::getMemoryUsage()
+{
+#if defined(__linux__)
+  // the second field of statm is the number of resident pages
+  std::ifstream statm("/proc/self/statm");
+  uint64_t size = 0, resident = 0;
+  if (!(statm >> size >> resident))
+  {
+    return 0;
+  }
+  return resident * sysconf(_SC_PAGESIZE) / (1024 * 1024);
+#elif !defined(__MINGW32__)
+  // only the peak resident memory is portably available
+  struct rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+#if defined(__APPLE__)
+  return ru.ru_maxrss / (1024 * 1024);
+#else
+  return ru.ru_maxrss / 1024;
+#endif
+#else
+  return 0;
+#endif
+}
+
+void ResourceManager::checkMemory()
+{
+  uint64_t usage = getMemoryUsage();
+  d_statistics->d_memoryUsage.maxAssign(usage);
+  if (usage <= d_memoryLimit)
+  {
+    return;
+  }
+  if (!d_memoryShed)
+  {
+    Trace("limit") << "ResourceManager::checkMemory: " << usage
+                   << " MB used, shedding caches" << std::endl;
+    d_memoryShed = true;
+    ++d_statistics->d_memoryCacheSheds;
+    d_memoryListeners.notify();
+    return;
+  }
+  Trace("limit") << "ResourceManager::checkMemory: " << usage
+                 << " MB used, out of memory" << std::endl;
+  d_outOfMemory = true;
+}
+
 void ResourceManager::spendResource(unsigned amount)
 {
   ++d_spendResourceCalls;
   d_cumulativeResourceUsed += amount;
+  if (d_cancelled)
+  {
+    Trace("limit") << "ResourceManager::spendResource: cancelled" << std::endl;
+    d_softListeners.notify();
+  }
+  if (d_progressCallback && d_spendResourceCalls % s_progressCount == 0)
+  {
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    uint64_t millis = (tv.tv_sec - d_progressLast.tv_sec) * 1000
+                      + (tv.tv_usec - d_progressLast.tv_usec) / 1000;
+    if (millis >= d_progressInterval)
+    {
+      d_progressLast = tv;
+      d_progressCallback();
+    }
+  }
+  if (d_memoryLimit > 0 && d_spendResourceCalls % s_memoryCount == 0)
+  {
+    checkMemory();
+  }
   if (!d_on) return;
 
   Debug("limit") << "ResourceManager::spendResource()" << std::endl;
@@ -271,6 +477,11 @@ void ResourceManager::spendResource(unsigned amount)
       Trace("limit") << "ResourceManager::spendResource: elapsed time"
                      << d_cumulativeTimer.elapsed() << std::endl;
     }
+    if (outOfMemory())
+    {
+      Trace("limit") << "ResourceManager::spendResource: out of memory"
+                     << std::endl;
+    }
 
     if (d_isHardLimit) {
       d_hardListeners.notify();
@@ -339,6 +550,10 @@ void ResourceManager::spendResource(Resource r)
       amount = d_options[options::satConflictStep];
       ++d_statistics->d_numSatConflictStep;
       break;
+    case Resource::SatInprocessStep:
+      amount = d_options[options::satInprocessStep];
+      ++d_statistics->d_numSatInprocessStep;
+      break;
     case Resource::TheoryCheckStep:
       amount = d_options[options::theoryCheckStep];
       ++d_statistics->d_numTheoryCheckStep;
@@ -348,10 +563,57 @@ void ResourceManager::spendResource(Resource r)
   spendResource(amount);
 }
 
+uint64_t ResourceManager::getStepCount(Resource r) const
+{
+  switch (r)
+  {
+    case Resource::BitblastStep:
+      return d_statistics->d_numBitblastStep.getData();
+    case Resource::BvEagerAssertStep:
+      return d_statistics->d_numBvEagerAssertStep.getData();
+    case Resource::BvPropagationStep:
+      return d_statistics->d_numBvPropagationStep.getData();
+    case Resource::BvSatConflictsStep:
+      return d_statistics->d_numBvSatConflictsStep.getData();
+    case Resource::CnfStep: return d_statistics->d_numCnfStep.getData();
+    case Resource::DecisionStep:
+      return d_statistics->d_numDecisionStep.getData();
+    case Resource::LemmaStep: return d_statistics->d_numLemmaStep.getData();
+    case Resource::ParseStep: return d_statistics->d_numParseStep.getData();
+    case Resource::PreprocessStep:
+      return d_statistics->d_numPreprocessStep.getData();
+    case Resource::QuantifierStep:
+      return d_statistics->d_numQuantifierStep.getData();
+    case Resource::RestartStep:
+      return d_statistics->d_numRestartStep.getData();
+    case Resource::RewriteStep:
+      return d_statistics->d_numRewriteStep.getData();
+    case Resource::SatConflictStep:
+      return d_statistics->d_numSatConflictStep.getData();
+    case Resource::SatInprocessStep:
+      return d_statistics->d_numSatInprocessStep.getData();
+    case Resource::TheoryCheckStep:
+      return d_statistics->d_numTheoryCheckStep.getData();
+    default: Unreachable() << "Invalid resource " << std::endl;
+  }
+  return 0;
+}
+
+void ResourceManager::setProgressCallback(std::function<void()> callback,
+                                          uint64_t millis)
+{
+  d_progressCallback = callback;
+  d_progressInterval = millis;
+  gettimeofday(&d_progressLast, NULL);
+}
+
 void ResourceManager::beginCall() {
 
+  gettimeofday(&d_progressLast, NULL);
   d_perCallTimer.set(d_timeBudgetPerCall, !d_cpuTime);
   d_thisCallResourceUsed = 0;
+  d_memoryShed = false;
+  d_outOfMemory = false;
   if (!d_on) return;
 
   if (cumulativeLimitOn()) {
@@ -372,7 +634,10 @@ void ResourceManager::beginCall() {
     // budget for this call to the per call budget
     if (d_thisCallTimeBudget == 0 ||
         d_thisCallResourceUsed == 0)
+    {
+      armWatchdog();
       return;
+    }
   }
 
   if (perCallLimitOn()) {
@@ -385,12 +650,38 @@ void ResourceManager::beginCall() {
       d_thisCallTimeBudget = d_thisCallTimeBudget < d_timeBudgetPerCall && d_thisCallTimeBudget != 0 ? d_thisCallTimeBudget : d_timeBudgetPerCall;
     }
   }
+  armWatchdog();
+}
+
+void ResourceManager::armWatchdog()
+{
+  if (!d_options[options::tlimitWatchdog] || d_cpuTime
+      || (d_timeBudgetPerCall == 0 && d_timeBudgetCumulative == 0))
+  {
+    return;
+  }
+  uint64_t millis =
+      std::min(d_cumulativeTimer.remaining(), d_perCallTimer.remaining());
+  Trace("limit") << "ResourceManager::armWatchdog(" << millis << ")"
+                 << std::endl;
+  if (d_watchdog == nullptr)
+  {
+    d_watchdog.reset(new Watchdog(d_timeExpired));
+  }
+  d_watchdog->arm(millis);
+  d_watchdogArmed = true;
 }
 
 void ResourceManager::endCall() {
+  if (d_watchdogArmed)
+  {
+    d_watchdog->disarm();
+    d_watchdogArmed = false;
+  }
   uint64_t usedInCall = d_perCallTimer.elapsed();
   d_perCallTimer.set(0);
   d_cumulativeTimeUsed += usedInCall;
+  d_cancelled = false;
 }
 
 bool ResourceManager::cumulativeLimitOn() const {
@@ -415,6 +706,11 @@ bool ResourceManager::outOfTime() const {
       d_timeBudgetCumulative == 0)
     return false;
 
+  if (d_watchdogArmed)
+  {
+    return d_timeExpired;
+  }
+
   return d_cumulativeTimer.expired() || d_perCallTimer.expired();
 }
 
@@ -445,4 +741,10 @@ ListenerCollection::Registration* ResourceManager::registerSoftListener(
   return d_softListeners.registerListener(listener);
 }
 
+ListenerCollection::Registration* ResourceManager::registerMemoryListener(
+    Listener* listener)
+{
+  return d_memoryListeners.registerListener(listener);
+}
+
 } /* namespace CVC4 */
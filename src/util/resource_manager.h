@@ -22,7 +22,9 @@
 
 #include <sys/time.h>
 
+#include <atomic>
 #include <cstddef>
+#include <functional>
 #include <memory>
 
 #include "base/exception.h"
@@ -61,6 +63,8 @@ class CVC4_PUBLIC Timer {
   /** Return the milliseconds elapsed since last set() wall/cpu time
    depending on d_wall_time*/
   uint64_t elapsed() const;
+  /** Return the milliseconds until the timer expires (max if it is off). */
+  uint64_t remaining() const;
   bool expired() const;
 
  private:
@@ -95,6 +99,7 @@ public:
    RestartStep,
    RewriteStep,
    SatConflictStep,
+   SatInprocessStep,
    TheoryCheckStep,
  };
 
@@ -107,7 +112,20 @@ public:
 
  bool outOfResources() const;
  bool outOfTime() const;
- bool out() const { return d_on && (outOfResources() || outOfTime()); }
+ /**
+  * Returns true if the memory used by the process stayed above the memory
+  * limit after the memory listeners shed their caches.
+  */
+ bool outOfMemory() const { return d_outOfMemory; }
+ /**
+  * Returns true if the memory limit was exceeded during this call, in which
+  * case caches should not be retained longer than necessary.
+  */
+ bool memoryShed() const { return d_memoryShed; }
+ bool out() const
+ {
+   return d_on && (outOfResources() || outOfTime() || outOfMemory());
+ }
 
  /**
   * This returns a const uint64_t& to support being used as a ReferenceStat.
@@ -116,6 +134,11 @@ public:
  uint64_t getTimeUsage() const;
  uint64_t getResourceRemaining() const;
  uint64_t getTimeRemaining() const;
+ /**
+  * Returns the resident memory of the process in megabytes, or 0 if it
+  * cannot be measured on this platform.
+  */
+ static uint64_t getMemoryUsage();
 
  uint64_t getResourceBudgetForThisCall() { return d_thisCallResourceBudget; }
  // Throws an UnsafeInterruptException if there are no remaining resources.
@@ -124,6 +147,8 @@ public:
  void setHardLimit(bool value);
  void setResourceLimit(uint64_t units, bool cumulative = false);
  void setTimeLimit(uint64_t millis, bool cumulative = false);
+ /** Sets the memory limit of the check calls, in megabytes (0==off). */
+ void setMemoryLimit(uint64_t megabytes);
  void useCPUTime(bool cpu);
 
  void enable(bool on);
@@ -142,6 +167,27 @@ public:
 
  static uint64_t getFrequencyCount() { return s_resourceCount; }
 
+ /** Returns the number of times resource r was spent. */
+ uint64_t getStepCount(Resource r) const;
+
+ /**
+  * Cancels the check call in progress, or the next one if no call is in
+  * progress. The check is interrupted at the next spent resource, as on a
+  * soft limit, and the cancellation is cleared at the end of the call.
+  * This is the only method of the ResourceManager that can be called from
+  * another thread than the one of the check call.
+  */
+ void cancel() { d_cancelled = true; }
+ /** Returns true if the check call in progress is cancelled. */
+ bool cancelled() const { return d_cancelled; }
+
+ /**
+  * Sets the callback that is called by the thread of the check call, at
+  * most every millis milliseconds while resources are spent. An empty
+  * callback disables it.
+  */
+ void setProgressCallback(std::function<void()> callback, uint64_t millis);
+
  /**
   * Registers a listener that is notified on a hard resource out.
   *
@@ -158,6 +204,18 @@ public:
   */
  ListenerCollection::Registration* registerSoftListener(Listener* listener);
 
+ /**
+  * Registers a listener that is notified when the memory limit is first
+  * exceeded during a check call, before the call runs out of memory. The
+  * listeners are expected to shed the caches they own; if the memory used
+  * is still above the limit at the next memory check, the call is
+  * interrupted as on a resource out.
+  *
+  * This Registration must be destroyed by the user before this
+  * ResourceManager.
+  */
+ ListenerCollection::Registration* registerMemoryListener(Listener* listener);
+
 private:
  Timer d_cumulativeTimer;
  Timer d_perCallTimer;
@@ -186,11 +244,26 @@ private:
  uint64_t d_thisCallTimeBudget;
  uint64_t d_thisCallResourceBudget;
 
+ /** A user-imposed memory limit, in megabytes. 0 = no limit. */
+ uint64_t d_memoryLimit;
+ /** Whether the memory listeners were notified during this call */
+ bool d_memoryShed;
+ /** Whether this call ran out of memory */
+ bool d_outOfMemory;
+
  bool d_isHardLimit;
  bool d_on;
  bool d_cpuTime;
  uint64_t d_spendResourceCalls;
 
+ /** Whether the check call is cancelled */
+ std::atomic<bool> d_cancelled;
+
+ /** The progress callback, its interval and the time of its last call */
+ std::function<void()> d_progressCallback;
+ uint64_t d_progressInterval;
+ timeval d_progressLast;
+
  /** Counter indicating how often to check resource manager in loops */
  static const uint64_t s_resourceCount;
 
@@ -200,6 +273,18 @@ private:
  /** Receives a notification on reaching a hard limit. */
  ListenerCollection d_softListeners;
 
+ /** Receives a notification on exceeding the memory limit. */
+ ListenerCollection d_memoryListeners;
+
+ /** Checks the memory used against the memory limit. */
+ void checkMemory();
+
+ /**
+  * Arms the watchdog with the time budget of the call that begins, if
+  * --tlimit-watchdog is set and the time limits are in wall time.
+  */
+ void armWatchdog();
+
  /**
   * ResourceManagers cannot be copied as they are given an explicit
   * list of Listeners to respond to.
@@ -217,6 +302,18 @@ private:
  struct Statistics;
  std::unique_ptr<Statistics> d_statistics;
 
+ /** Set by the watchdog when the time budget of the current call expired */
+ std::atomic<bool> d_timeExpired;
+ /** Whether the watchdog checks the time limit of the current call */
+ bool d_watchdogArmed;
+ /**
+  * The watchdog thread that sets d_timeExpired when the wall time budget of
+  * a check call expires, if --tlimit-watchdog is set. It is created on the
+  * first call with a time limit.
+  */
+ class Watchdog;
+ std::unique_ptr<Watchdog> d_watchdog;
+
  Options& d_options;
 
 };/* class ResourceManager */
@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+"""
+Usage:
+
+    compare_bench.py [--tolerance <ratio>] baseline.json current.json
+
+Compares the results of two runs of micro_bench or run_macro_bench.py, and
+reports the benchmarks whose time or memory grew by more than the tolerance.
+Exits with status 1 if there is such a slowdown.
+"""
+
+import argparse
+import json
+import sys
+
+METRICS = ['time', 'memory']
+
+
+def load(path):
+    with open(path, 'r') as f:
+        return {b['name']: b for b in json.load(f)['benchmarks']}
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compares the results of two benchmark runs.')
+    parser.add_argument('--tolerance', type=float, default=1.1,
+                        help='maximal ratio of current to baseline values')
+    parser.add_argument('baseline')
+    parser.add_argument('current')
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+    regressions = 0
+    for name in sorted(current):
+        if name not in baseline:
+            print('{:<50} new'.format(name))
+            continue
+        for metric in METRICS:
+            if metric not in current[name] or metric not in baseline[name]:
+                continue
+            old = baseline[name][metric]
+            new = current[name][metric]
+            ratio = new / old if old > 0 else 1.0
+            flag = ''
+            if ratio > args.tolerance:
+                flag = 'REGRESSION'
+                regressions += 1
+            print('{:<50} {:<7} {:>12.6g} -> {:>12.6g} ({:+.1%}) {}'.format(
+                name, metric, old, new, ratio - 1, flag))
+        if baseline[name].get('result') != current[name].get('result'):
+            print('{:<50} result {} -> {}'.format(
+                name, baseline[name].get('result'),
+                current[name].get('result')))
+    return 1 if regressions > 0 else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,348 @@
+/*********************                                                        */
+/*! \file micro_bench.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Microbenchmarks of core data structures and procedures
+ **
+ ** Microbenchmarks of node construction, rewriting, context-dependent maps,
+ ** the equality engine, the CNF conversion and the SAT solver. Each
+ ** benchmark is run with a doubling number of iterations until it takes at
+ ** least the minimal time, and the time per iteration is reported as a
+ ** table, and optionally written as JSON (see test/bench/compare_bench.py).
+ **/
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "context/cdhashmap.h"
+#include "context/context.h"
+#include "expr/expr_manager.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "prop/cnf_stream.h"
+#include "prop/registrar.h"
+#include "prop/sat_solver.h"
+#include "prop/sat_solver_factory.h"
+#include "smt/smt_engine.h"
+#include "smt/smt_engine_scope.h"
+#include "theory/rewriter.h"
+#include "theory/uf/equality_engine.h"
+#include "util/rational.h"
+#include "util/statistics_registry.h"
+
+using namespace CVC4;
+
+namespace {
+
+/** Measures the time of the timed part of a benchmark. */
+class Timer
+{
+ public:
+  void start() { d_start = std::chrono::steady_clock::now(); }
+  void stop()
+  {
+    d_seconds += std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - d_start)
+                     .count();
+  }
+  double seconds() const { return d_seconds; }
+
+ private:
+  std::chrono::steady_clock::time_point d_start;
+  double d_seconds = 0;
+};
+
+/**
+ * A benchmark, which runs n iterations, and times them (but not their
+ * setup) with the timer.
+ */
+typedef std::function<void(uint64_t n, Timer& timer)> Benchmark;
+
+/** Returns n distinct variables of type t. */
+std::vector<Node> mkVars(NodeManager* nm, TypeNode t, size_t n)
+{
+  std::vector<Node> vars;
+  for (size_t i = 0; i < n; i++)
+  {
+    vars.push_back(nm->mkSkolem("x", t));
+  }
+  return vars;
+}
+
+/** Returns a random Boolean formula of the given depth over vars. */
+Node mkRandomFormula(NodeManager* nm,
+                     std::mt19937& rng,
+                     const std::vector<Node>& vars,
+                     unsigned depth)
+{
+  if (depth == 0)
+  {
+    Node v = vars[rng() % vars.size()];
+    return rng() % 2 ? v : v.notNode();
+  }
+  static const Kind kinds[] = {kind::AND, kind::OR, kind::XOR, kind::EQUAL};
+  Kind k = kinds[rng() % 4];
+  return nm->mkNode(k,
+                    mkRandomFormula(nm, rng, vars, depth - 1),
+                    mkRandomFormula(nm, rng, vars, depth - 1));
+}
+
+/** Constructs (and looks up) arithmetic terms. */
+void benchMkNode(uint64_t n, Timer& timer)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  std::vector<Node> vars = mkVars(nm, nm->integerType(), 64);
+  timer.start();
+  for (uint64_t i = 0; i < n; i++)
+  {
+    Node a = nm->mkNode(kind::PLUS, vars[i % 64], vars[(i / 64) % 64]);
+    Node b = nm->mkNode(kind::MULT, a, vars[(i * 7) % 64]);
+  }
+  timer.stop();
+}
+
+/** Rewrites fresh arithmetic and Boolean terms. */
+void benchRewrite(uint64_t n, Timer& timer)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  std::vector<Node> vars = mkVars(nm, nm->integerType(), 16);
+  std::vector<Node> terms;
+  for (uint64_t i = 0; i < n; i++)
+  {
+    Node c = nm->mkConst(Rational(static_cast<int64_t>(i)));
+    Node sum = nm->mkNode(kind::PLUS, vars[i % 16], c, vars[(i / 16) % 16]);
+    Node leq = nm->mkNode(kind::LEQ, sum, vars[(i * 3) % 16]);
+    terms.push_back(nm->mkNode(kind::OR, leq, leq.notNode()));
+  }
+  timer.start();
+  for (const Node& t : terms)
+  {
+    theory::Rewriter::rewrite(t);
+  }
+  timer.stop();
+}
+
+/** Inserts into a CDHashMap in nested contexts, and restores them. */
+void benchCDHashMap(uint64_t n, Timer& timer)
+{
+  context::Context ctx;
+  context::CDHashMap<uint64_t, uint64_t> map(&ctx);
+  timer.start();
+  for (uint64_t i = 0; i < n; i++)
+  {
+    if (i % 64 == 0)
+    {
+      ctx.push();
+    }
+    map.insert(i % 1024, i);
+    if (i % 256 == 255)
+    {
+      ctx.popto(0);
+    }
+  }
+  ctx.popto(0);
+  timer.stop();
+}
+
+/** Asserts random equalities between terms to an equality engine. */
+void benchEqualityEngine(uint64_t n, Timer& timer)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  TypeNode u = nm->mkSort("U");
+  std::vector<Node> vars = mkVars(nm, u, 1024);
+  std::mt19937 rng(42);
+  std::vector<Node> eqs;
+  for (uint64_t i = 0; i < n; i++)
+  {
+    eqs.push_back(
+        nm->mkNode(kind::EQUAL, vars[rng() % 1024], vars[rng() % 1024]));
+  }
+  context::Context ctx;
+  theory::eq::EqualityEngine ee(&ctx, "bench", false);
+  for (const Node& v : vars)
+  {
+    ee.addTerm(v);
+  }
+  timer.start();
+  for (uint64_t i = 0; i < n; i++)
+  {
+    if (i % 512 == 0)
+    {
+      ctx.popto(0);
+      ctx.push();
+    }
+    ee.assertEquality(eqs[i], true, eqs[i]);
+  }
+  ctx.popto(0);
+  timer.stop();
+}
+
+/** Converts random Boolean formulas to CNF. */
+void benchCnfStream(uint64_t n, Timer& timer)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  std::vector<Node> vars = mkVars(nm, nm->booleanType(), 64);
+  std::mt19937 rng(42);
+  std::vector<Node> formulas;
+  for (uint64_t i = 0; i < n; i++)
+  {
+    formulas.push_back(mkRandomFormula(nm, rng, vars, 4));
+  }
+  StatisticsRegistry registry;
+  context::Context ctx;
+  std::unique_ptr<prop::SatSolver> sat(
+      prop::SatSolverFactory::createMinisat(&ctx, &registry, "bench"));
+  prop::NullRegistrar registrar;
+  prop::TseitinCnfStream cnf(sat.get(), &registrar, &ctx);
+  timer.start();
+  for (const Node& f : formulas)
+  {
+    cnf.convertAndAssert(f, false, false, RULE_INVALID);
+  }
+  timer.stop();
+}
+
+/**
+ * Solves random 3-SAT instances of 60 variables at the threshold ratio,
+ * which is mostly unit propagation. An iteration is one instance.
+ */
+void benchSatSolver(uint64_t n, Timer& timer)
+{
+  std::mt19937 rng(42);
+  StatisticsRegistry registry;
+  for (uint64_t i = 0; i < n; i++)
+  {
+    context::Context ctx;
+    std::unique_ptr<prop::SatSolver> sat(
+        prop::SatSolverFactory::createMinisat(&ctx, &registry, "bench"));
+    std::vector<prop::SatVariable> vars;
+    for (unsigned v = 0; v < 60; v++)
+    {
+      vars.push_back(sat->newVar(false, false, false));
+    }
+    std::vector<prop::SatClause> clauses(256);
+    for (prop::SatClause& c : clauses)
+    {
+      for (unsigned l = 0; l < 3; l++)
+      {
+        c.push_back(prop::SatLiteral(vars[rng() % 60], rng() % 2));
+      }
+    }
+    timer.start();
+    for (prop::SatClause& c : clauses)
+    {
+      sat->addClause(c, false);
+    }
+    sat->solve();
+    timer.stop();
+  }
+}
+
+/** Runs b with doubling iterations, returns the seconds per iteration. */
+double run(const Benchmark& b, double minTime, uint64_t& iterations)
+{
+  for (iterations = 1;; iterations *= 2)
+  {
+    Timer timer;
+    b(iterations, timer);
+    if (timer.seconds() >= minTime || iterations >= (uint64_t(1) << 30))
+    {
+      return timer.seconds() / iterations;
+    }
+  }
+}
+
+void usage(const char* prog)
+{
+  std::cerr << "usage: " << prog << " [--json <file>] [--min-time <seconds>] "
+            << "[<benchmark name substring>]" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  std::string json;
+  double minTime = 0.2;
+  std::string filter;
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+    {
+      json = argv[++i];
+    }
+    else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc)
+    {
+      minTime = atof(argv[++i]);
+    }
+    else if (argv[i][0] == '-')
+    {
+      usage(argv[0]);
+      return 1;
+    }
+    else
+    {
+      filter = argv[i];
+    }
+  }
+
+  const std::vector<std::pair<std::string, Benchmark> > benchmarks = {
+      {"mkNode", benchMkNode},
+      {"Rewriter::rewrite", benchRewrite},
+      {"CDHashMap::insert", benchCDHashMap},
+      {"EqualityEngine::assertEquality", benchEqualityEngine},
+      {"TseitinCnfStream::convertAndAssert", benchCnfStream},
+      {"Minisat::solve", benchSatSolver}};
+
+  ExprManager em;
+  SmtEngine smt(&em);
+  smt::SmtScope scope(&smt);
+
+  std::ofstream out;
+  if (!json.empty())
+  {
+    out.open(json);
+    out << "{\"benchmarks\": [";
+  }
+  bool first = true;
+  for (const std::pair<std::string, Benchmark>& b : benchmarks)
+  {
+    if (b.first.find(filter) == std::string::npos)
+    {
+      continue;
+    }
+    uint64_t iterations;
+    double seconds = run(b.second, minTime, iterations);
+    std::cout << std::left << std::setw(40) << b.first << std::right
+              << std::setw(12) << iterations << std::setw(14) << std::fixed
+              << std::setprecision(1) << seconds * 1e9 << " ns" << std::endl;
+    if (out.is_open())
+    {
+      out << (first ? "" : ",") << "\n  {\"name\": \"" << b.first
+          << "\", \"iterations\": " << iterations
+          << ", \"time\": " << std::scientific << std::setprecision(6)
+          << seconds << "}";
+    }
+    first = false;
+  }
+  if (out.is_open())
+  {
+    out << "\n]}" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""
+Usage:
+
+    run_macro_bench.py [--list <file>] [--output <file>] [--timeout <s>]
+        [--runs <n>] cvc4-binary
+
+Runs cvc4-binary on the benchmarks of the macro suite, with the command line
+options given in their COMMAND-LINE metadata, and writes the wall-clock time
+and the peak memory of each run as JSON, to be compared between revisions
+with compare_bench.py.
+"""
+
+import argparse
+import json
+import os
+import shlex
+import subprocess
+import sys
+import threading
+import time
+
+COMMAND_LINE = 'COMMAND-LINE:'
+
+
+def get_command_line(benchmark_path):
+    """Returns the options of the first COMMAND-LINE of the benchmark."""
+    comment_char = '%' if benchmark_path.endswith('.cvc') else ';'
+    with open(benchmark_path, 'r') as benchmark_file:
+        for line in benchmark_file:
+            if not line.startswith(comment_char):
+                continue
+            line = line[1:].lstrip()
+            if line.startswith(COMMAND_LINE):
+                return shlex.split(line[len(COMMAND_LINE):].strip())
+    return []
+
+
+def run_benchmark(cvc4_binary, benchmark_path, timeout):
+    """Runs cvc4 on the benchmark, returns its time, memory and output."""
+    args = [cvc4_binary] + get_command_line(benchmark_path) + [benchmark_path]
+    start = time.time()
+    proc = subprocess.Popen(args,
+                            cwd=os.path.dirname(benchmark_path),
+                            stdout=subprocess.PIPE,
+                            stderr=subprocess.DEVNULL)
+    timer = threading.Timer(timeout, lambda: proc.kill())
+    timer.start()
+    output = proc.stdout.read().decode()
+    proc.stdout.close()
+    # wait4 returns the resource usage of this child only
+    _, status, usage = os.wait4(proc.pid, 0)
+    # the child was reaped by wait4, do not let Popen wait for it
+    proc.returncode = status
+    elapsed = time.time() - start
+    timed_out = not timer.is_alive()
+    timer.cancel()
+    lines = output.split()
+    return {
+        'time': elapsed,
+        # ru_maxrss is in kilobytes on Linux
+        'memory': usage.ru_maxrss,
+        'result': 'timeout' if timed_out else (lines[0] if lines else ''),
+    }
+
+
+def main():
+    script_dir = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(
+        description='Runs the macro benchmark suite.')
+    parser.add_argument('--list',
+                        default=os.path.join(script_dir,
+                                             'macro_benchmarks.txt'))
+    parser.add_argument('--regress-dir',
+                        default=os.path.join(script_dir, '..', 'regress'))
+    parser.add_argument('--output')
+    parser.add_argument('--timeout', type=float, default=600)
+    parser.add_argument('--runs', type=int, default=1,
+                        help='number of runs; the fastest one is reported')
+    parser.add_argument('cvc4_binary')
+    args = parser.parse_args()
+
+    cvc4_binary = os.path.abspath(args.cvc4_binary)
+    with open(args.list, 'r') as list_file:
+        benchmarks = [
+            l.strip() for l in list_file
+            if l.strip() and not l.startswith('#')
+        ]
+
+    results = []
+    for benchmark in benchmarks:
+        path = os.path.abspath(os.path.join(args.regress_dir, benchmark))
+        runs = [
+            run_benchmark(cvc4_binary, path, args.timeout)
+            for _ in range(args.runs)
+        ]
+        best = min(runs, key=lambda r: r['time'])
+        best['name'] = benchmark
+        results.append(best)
+        print('{:<50} {:>10.3f} s {:>10} KB  {}'.format(
+            benchmark, best['time'], best['memory'], best['result']))
+
+    if args.output:
+        with open(args.output, 'w') as output_file:
+            json.dump({'benchmarks': results}, output_file, indent=2)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
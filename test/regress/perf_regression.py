@@ -0,0 +1,285 @@
+#!/usr/bin/env python3
+"""
+Usage:
+
+    perf_regression.py [--level N] [--repeat K] [--save results.json]
+        [--baseline baseline.json] [--tolerance P] [--wrapper cmd]
+        cvc4-binary [benchmark ...]
+
+Runs the benchmarks, by default those of regression level 0, and records the
+wall time, the peak resident set size, the resource units and the key
+statistics of each run. The results can be saved as a baseline and compared
+against a baseline of another build, in which case significant regressions
+are reported and the exit code is 1.
+"""
+
+import argparse
+import json
+import math
+import os
+import re
+import shlex
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+from run_regression import COMMAND_LINE, REQUIRES, STATUS_TIMEOUT, \
+    get_cvc4_features
+
+EXIT_OK = 0
+EXIT_FAILURE = 1
+
+# The statistics that are recorded, summed over the statistics matching each
+# regular expression. The resource units are deterministic and thus compared
+# without noise.
+RECORDED_STATS = {
+    'resourceUnits': r'^smt::SmtEngine::resourceUnitsUsed$',
+    'conflicts': r'^sat::conflicts$',
+    'lemmas': r'^theory::[^:]+::lemmas$',
+    'rewrites': r'^resource::RewriteStep$',
+    'instantiations': r'^Instantiate::Instantiations_Total$',
+}
+
+# The time measurements below this many seconds are noise
+MIN_TIME = 0.1
+
+
+def get_benchmarks(level):
+    """Returns the benchmarks of regression level `level` listed in
+    CMakeLists.txt, relative to the directory of this script."""
+
+    cmake_lists = os.path.join(os.path.dirname(__file__), 'CMakeLists.txt')
+    with open(cmake_lists, 'r') as cmake_file:
+        content = cmake_file.read()
+    match = re.search(r'set\(regress_{}_tests\s*(.*?)\)'.format(level),
+                      content, re.DOTALL)
+    if not match:
+        sys.exit('Cannot find the regressions of level {}'.format(level))
+    return [
+        line.strip() for line in match.group(1).splitlines()
+        if line.strip() and not line.strip().startswith('#')
+    ]
+
+
+def get_command_line(benchmark_path, cvc4_features):
+    """Returns the command line options of the first COMMAND-LINE directive of
+    the benchmark `benchmark_path`, or None if the benchmark requires a
+    feature that the binary does not have."""
+
+    command_line = ''
+    found = False
+    with open(benchmark_path, 'r') as benchmark_file:
+        for line in benchmark_file:
+            if not line or line[0] not in ';%c*':
+                continue
+            line = line[1:].lstrip()
+            if line.startswith(COMMAND_LINE) and not found:
+                command_line = line[len(COMMAND_LINE):].strip()
+                found = True
+            elif line.startswith(REQUIRES):
+                feature = line[len(REQUIRES):].strip()
+                if feature.startswith('no-'):
+                    if feature[len('no-'):] in cvc4_features:
+                        return None
+                elif feature not in cvc4_features:
+                    return None
+    return shlex.split(command_line)
+
+
+def parse_stats(error):
+    """Returns the recorded statistics in the `--stats` output `error`. The
+    last value of each statistic is the cumulative one."""
+
+    values = {}
+    for line in error.splitlines():
+        tokens = line.rsplit(',', 1)
+        if len(tokens) != 2:
+            continue
+        try:
+            values[tokens[0].strip()] = float(tokens[1].strip())
+        except ValueError:
+            pass
+    stats = {}
+    for key, regex in RECORDED_STATS.items():
+        matching = [v for name, v in values.items() if re.match(regex, name)]
+        if matching:
+            stats[key] = sum(matching)
+    return stats
+
+
+def run_once(args, cwd, timeout):
+    """Runs a process with a timeout `timeout` in seconds. Returns the wall
+    time in seconds, the peak resident set size in kilobytes, the error output
+    and the exit status of the process."""
+
+    with tempfile.TemporaryFile() as out, tempfile.TemporaryFile() as err:
+        start = time.time()
+        proc = subprocess.Popen(args,
+                                cwd=cwd,
+                                stdin=subprocess.DEVNULL,
+                                stdout=out,
+                                stderr=err)
+        timer = None
+        if timeout:
+            timer = threading.Timer(timeout, lambda p: p.kill(), [proc])
+            timer.start()
+        _, status, rusage = os.wait4(proc.pid, 0)
+        wall_time = time.time() - start
+        proc.returncode = os.WEXITSTATUS(status) if os.WIFEXITED(status) \
+            else -os.WTERMSIG(status)
+        exit_status = proc.returncode
+        if timer:
+            # The timer killed the process and is not active anymore.
+            if exit_status == -9 and not timer.is_alive():
+                exit_status = STATUS_TIMEOUT
+            timer.cancel()
+        err.seek(0)
+        error = err.read().decode(errors='replace')
+    return wall_time, rusage.ru_maxrss, error, exit_status
+
+
+def run_benchmark(wrapper, cvc4_binary, command_line, benchmark_path, repeat,
+                  timeout):
+    """Runs CVC4 `repeat` times on the benchmark `benchmark_path` with the
+    command line options `command_line` and returns the measurements, or None
+    if a run timed out."""
+
+    args = wrapper + [cvc4_binary] + command_line + \
+        ['--stats', os.path.basename(benchmark_path)]
+    result = {'time': [], 'rss': [], 'exit': None, 'stats': {}}
+    for _ in range(repeat):
+        wall_time, rss, error, exit_status = run_once(
+            args, os.path.dirname(benchmark_path), timeout)
+        if exit_status == STATUS_TIMEOUT:
+            return None
+        result['time'].append(wall_time)
+        result['rss'].append(rss)
+        result['exit'] = exit_status
+        # the statistics of the runs are identical up to the timers
+        result['stats'] = parse_stats(error)
+    return result
+
+
+def mean(values):
+    return sum(values) / len(values)
+
+
+def welch_t(old, new):
+    """Returns the t statistic of Welch's test for the difference of the means
+    of the samples `old` and `new`, or None if a sample has a single value."""
+
+    if len(old) < 2 or len(new) < 2:
+        return None
+    var_old = sum((v - mean(old))**2 for v in old) / (len(old) - 1)
+    var_new = sum((v - mean(new))**2 for v in new) / (len(new) - 1)
+    stderr = math.sqrt(var_old / len(old) + var_new / len(new))
+    if stderr == 0:
+        # the samples have no variance, the difference is exact
+        return math.copysign(float('inf'), mean(new) - mean(old))
+    return (mean(new) - mean(old)) / stderr
+
+
+def compare(baseline, results, tolerance, t_threshold):
+    """Compares the results against the baseline. Returns the list of the
+    regressions, as strings. The deterministic counts regress when they grow
+    by more than `tolerance`, the time and the peak memory also need a Welch
+    t statistic above `t_threshold` when there are repeated runs."""
+
+    regressions = []
+    for name, new in sorted(results.items()):
+        old = baseline.get(name)
+        if old is None or new is None:
+            continue
+        if old['exit'] != new['exit']:
+            regressions.append('{}: exit status {} -> {}'.format(
+                name, old['exit'], new['exit']))
+        for key, value in sorted(new['stats'].items()):
+            old_value = old['stats'].get(key)
+            if old_value is not None and value > old_value * (1 + tolerance):
+                regressions.append('{}: {} {:g} -> {:g}'.format(
+                    name, key, old_value, value))
+        for key in ['time', 'rss']:
+            old_mean, new_mean = mean(old[key]), mean(new[key])
+            if key == 'time' and max(old_mean, new_mean) < MIN_TIME:
+                continue
+            if new_mean <= old_mean * (1 + tolerance):
+                continue
+            t = welch_t(old[key], new[key])
+            if t is None or t > t_threshold:
+                regressions.append('{}: {} {:g} -> {:g}'.format(
+                    name, key, old_mean, new_mean))
+    return regressions
+
+
+def main():
+    """Parses the command line arguments, runs the benchmarks and compares
+    them against the baseline."""
+
+    parser = argparse.ArgumentParser(
+        description='Records and compares the performance of benchmarks.')
+    parser.add_argument('--level', type=int, action='append', default=[])
+    parser.add_argument('--repeat', type=int, default=1)
+    parser.add_argument('--save')
+    parser.add_argument('--baseline')
+    parser.add_argument('--tolerance', type=float, default=0.05)
+    parser.add_argument('--t-threshold', type=float, default=3.0)
+    parser.add_argument('--wrapper', default='')
+    parser.add_argument('cvc4_binary')
+    parser.add_argument('benchmarks', nargs='*')
+    args = parser.parse_args()
+    cvc4_binary = os.path.abspath(args.cvc4_binary)
+    if not os.access(cvc4_binary, os.X_OK):
+        sys.exit(
+            '"{}" does not exist or is not executable'.format(cvc4_binary))
+
+    regress_dir = os.path.dirname(os.path.abspath(__file__))
+    benchmarks = [os.path.abspath(b) for b in args.benchmarks]
+    levels = args.level if args.level or benchmarks else [0]
+    for level in levels:
+        benchmarks += [
+            os.path.join(regress_dir, b) for b in get_benchmarks(level)
+        ]
+
+    timeout = float(os.getenv('TEST_TIMEOUT', 1200.0))
+    cvc4_features = get_cvc4_features(cvc4_binary)
+    results = {}
+    for benchmark_path in benchmarks:
+        command_line = get_command_line(benchmark_path, cvc4_features)
+        if command_line is None:
+            continue
+        name = os.path.relpath(benchmark_path, regress_dir)
+        result = run_benchmark(shlex.split(args.wrapper), cvc4_binary, command_line,
+                               benchmark_path, args.repeat, timeout)
+        results[name] = result
+        if result is None:
+            print('Timeout - {}'.format(name))
+        else:
+            print('{} - time {:.3f} rss {} {}'.format(
+                name, mean(result['time']), max(result['rss']),
+                ' '.join('{} {:g}'.format(k, v)
+                         for k, v in sorted(result['stats'].items()))))
+
+    if args.save:
+        with open(args.save, 'w') as save_file:
+            json.dump({'binary': cvc4_binary, 'results': results},
+                      save_file,
+                      indent=1,
+                      sort_keys=True)
+
+    if args.baseline:
+        with open(args.baseline, 'r') as baseline_file:
+            baseline = json.load(baseline_file)['results']
+        regressions = compare(baseline, results, args.tolerance,
+                              args.t_threshold)
+        for regression in regressions:
+            print('regression - {}'.format(regression))
+        if regressions:
+            return EXIT_FAILURE
+    return EXIT_OK
+
+
+if __name__ == "__main__":
+    exit_code = main()
+    sys.exit(exit_code)
@@ -0,0 +1,25 @@
+; COMMAND-LINE: --incremental
+; COMMAND-LINE: --incremental --no-arith-bounds-repair
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_LRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(declare-fun w () Real)
+(assert (<= 0 x 10))
+(assert (<= 0 y 10))
+(assert (>= (+ x (* 2 y)) 7))
+(assert (<= (- z w) (- 3)))
+(assert (>= (+ z w) 12))
+(push 1)
+(assert (<= x 1))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (<= (+ x y) 3))
+(check-sat)
+(pop 1)
+(assert (<= (+ x y z) 10))
+(check-sat)
@@ -0,0 +1,21 @@
+; COMMAND-LINE: --error-selection-rule=devex
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_LRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(declare-fun w () Real)
+(assert (>= (+ x y z) 6))
+(assert (<= (- x (* 2 y)) (- 3)))
+(assert (>= (+ (* 3 z) w) 4))
+(assert (< (+ x w) 1))
+(assert (>= (- y z) (/ 1 2)))
+(assert (or (> (+ x z) 2) (< (- w y) (- 5))))
+(push 1)
+(check-sat)
+(pop 1)
+(assert (<= (+ x y z w) 5))
+(assert (>= (- z x) 2))
+(assert (<= y 2))
+(check-sat)
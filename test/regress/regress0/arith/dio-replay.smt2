@@ -0,0 +1,29 @@
+; COMMAND-LINE: --incremental --dio-replay
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (= (+ (* 3 x) (* 5 z)) 4))
+(push 1)
+(assert (= (+ (* 4 x) (* 6 y)) 7))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= (+ (* 4 x) (* 6 y)) 8))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= (+ (* 4 x) (* 6 y)) 7))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= (+ (* 4 x) (* 6 y)) 8))
+(check-sat)
+(assert (= (+ (* 9 y) (* 6 z)) 2))
+(check-sat)
+(pop 1)
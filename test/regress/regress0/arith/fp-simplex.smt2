@@ -0,0 +1,27 @@
+; COMMAND-LINE: --incremental --arith-fp-simplex
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_LRA)
+(declare-fun s1 () Real)
+(declare-fun s2 () Real)
+(declare-fun s3 () Real)
+(declare-fun s4 () Real)
+(declare-fun e () Real)
+(assert (>= s1 0))
+(assert (>= s2 (+ s1 (/ 3 2))))
+(assert (>= s3 (+ s1 (/ 7 3))))
+(assert (>= s4 (+ s2 (/ 1 10))))
+(assert (>= s4 (+ s3 (/ 5 4))))
+(assert (>= e (+ s4 (/ 2 7))))
+(assert (< (+ (* 2 s1) s3 (* (- 1) s2)) 4))
+(push 1)
+(assert (<= e 5))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (< e (/ 27 7)))
+(check-sat)
+(pop 1)
+(assert (<= (+ e s1) 4))
+(check-sat)
@@ -0,0 +1,13 @@
+; COMMAND-LINE: --check-models
+; EXPECT: sat
+(set-logic QF_IDL)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (<= (- x y) 2))
+(assert (<= (- y z) (- 1)))
+(assert (= (- z x) (- 1)))
+(assert (distinct x y))
+(assert (not (= (- x y) 2)))
+(assert (or (< x 0) (> z 10)))
+(check-sat)
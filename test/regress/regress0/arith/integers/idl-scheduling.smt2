@@ -0,0 +1,11 @@
+; EXPECT: unsat
+(set-logic QF_IDL)
+(declare-fun s1 () Int)
+(declare-fun s2 () Int)
+(declare-fun s3 () Int)
+(assert (and (>= s1 0) (>= s2 0) (>= s3 0)))
+(assert (and (<= s1 8) (<= s2 7) (<= s3 6)))
+(assert (or (>= (- s2 s1) 3) (>= (- s1 s2) 4)))
+(assert (or (>= (- s3 s1) 3) (>= (- s1 s3) 5)))
+(assert (or (>= (- s3 s2) 4) (>= (- s2 s3) 5)))
+(check-sat)
@@ -0,0 +1,12 @@
+; COMMAND-LINE: --arith-mip-cuts --arith-pseudo-cost
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (>= (- (* 2 x) (* 2 y)) 1))
+(assert (<= (- (* 2 x) (* 2 y)) (/ 3 2)))
+(assert (>= (+ x y z) 0))
+(assert (<= (+ x y z) 20))
+(assert (<= 0 z 10))
+(check-sat)
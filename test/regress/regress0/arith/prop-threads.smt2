@@ -0,0 +1,444 @@
+; COMMAND-LINE: --arith-prop-threads=4
+; EXPECT: sat
+(set-logic QF_LRA)
+(declare-fun x0 () Real)
+(declare-fun x1 () Real)
+(declare-fun x2 () Real)
+(declare-fun x3 () Real)
+(declare-fun x4 () Real)
+(declare-fun x5 () Real)
+(declare-fun x6 () Real)
+(declare-fun x7 () Real)
+(declare-fun x8 () Real)
+(declare-fun x9 () Real)
+(declare-fun x10 () Real)
+(declare-fun x11 () Real)
+(declare-fun x12 () Real)
+(declare-fun x13 () Real)
+(declare-fun x14 () Real)
+(declare-fun x15 () Real)
+(declare-fun x16 () Real)
+(declare-fun x17 () Real)
+(declare-fun x18 () Real)
+(declare-fun x19 () Real)
+(declare-fun x20 () Real)
+(declare-fun x21 () Real)
+(declare-fun x22 () Real)
+(declare-fun x23 () Real)
+(declare-fun x24 () Real)
+(declare-fun x25 () Real)
+(declare-fun x26 () Real)
+(declare-fun x27 () Real)
+(declare-fun x28 () Real)
+(declare-fun x29 () Real)
+(declare-fun x30 () Real)
+(declare-fun x31 () Real)
+(declare-fun x32 () Real)
+(declare-fun x33 () Real)
+(declare-fun x34 () Real)
+(declare-fun x35 () Real)
+(declare-fun x36 () Real)
+(declare-fun x37 () Real)
+(declare-fun x38 () Real)
+(declare-fun x39 () Real)
+(declare-fun x40 () Real)
+(declare-fun x41 () Real)
+(declare-fun x42 () Real)
+(declare-fun x43 () Real)
+(declare-fun x44 () Real)
+(declare-fun x45 () Real)
+(declare-fun x46 () Real)
+(declare-fun x47 () Real)
+(declare-fun x48 () Real)
+(declare-fun x49 () Real)
+(declare-fun x50 () Real)
+(declare-fun x51 () Real)
+(declare-fun x52 () Real)
+(declare-fun x53 () Real)
+(declare-fun x54 () Real)
+(declare-fun x55 () Real)
+(declare-fun x56 () Real)
+(declare-fun x57 () Real)
+(declare-fun x58 () Real)
+(declare-fun x59 () Real)
+(assert (and (<= 0 x0) (<= x0 10)))
+(assert (and (<= 0 x1) (<= x1 10)))
+(assert (and (<= 0 x2) (<= x2 10)))
+(assert (and (<= 0 x3) (<= x3 10)))
+(assert (and (<= 0 x4) (<= x4 10)))
+(assert (and (<= 0 x5) (<= x5 10)))
+(assert (and (<= 0 x6) (<= x6 10)))
+(assert (and (<= 0 x7) (<= x7 10)))
+(assert (and (<= 0 x8) (<= x8 10)))
+(assert (and (<= 0 x9) (<= x9 10)))
+(assert (and (<= 0 x10) (<= x10 10)))
+(assert (and (<= 0 x11) (<= x11 10)))
+(assert (and (<= 0 x12) (<= x12 10)))
+(assert (and (<= 0 x13) (<= x13 10)))
+(assert (and (<= 0 x14) (<= x14 10)))
+(assert (and (<= 0 x15) (<= x15 10)))
+(assert (and (<= 0 x16) (<= x16 10)))
+(assert (and (<= 0 x17) (<= x17 10)))
+(assert (and (<= 0 x18) (<= x18 10)))
+(assert (and (<= 0 x19) (<= x19 10)))
+(assert (and (<= 0 x20) (<= x20 10)))
+(assert (and (<= 0 x21) (<= x21 10)))
+(assert (and (<= 0 x22) (<= x22 10)))
+(assert (and (<= 0 x23) (<= x23 10)))
+(assert (and (<= 0 x24) (<= x24 10)))
+(assert (and (<= 0 x25) (<= x25 10)))
+(assert (and (<= 0 x26) (<= x26 10)))
+(assert (and (<= 0 x27) (<= x27 10)))
+(assert (and (<= 0 x28) (<= x28 10)))
+(assert (and (<= 0 x29) (<= x29 10)))
+(assert (and (<= 0 x30) (<= x30 10)))
+(assert (and (<= 0 x31) (<= x31 10)))
+(assert (and (<= 0 x32) (<= x32 10)))
+(assert (and (<= 0 x33) (<= x33 10)))
+(assert (and (<= 0 x34) (<= x34 10)))
+(assert (and (<= 0 x35) (<= x35 10)))
+(assert (and (<= 0 x36) (<= x36 10)))
+(assert (and (<= 0 x37) (<= x37 10)))
+(assert (and (<= 0 x38) (<= x38 10)))
+(assert (and (<= 0 x39) (<= x39 10)))
+(assert (and (<= 0 x40) (<= x40 10)))
+(assert (and (<= 0 x41) (<= x41 10)))
+(assert (and (<= 0 x42) (<= x42 10)))
+(assert (and (<= 0 x43) (<= x43 10)))
+(assert (and (<= 0 x44) (<= x44 10)))
+(assert (and (<= 0 x45) (<= x45 10)))
+(assert (and (<= 0 x46) (<= x46 10)))
+(assert (and (<= 0 x47) (<= x47 10)))
+(assert (and (<= 0 x48) (<= x48 10)))
+(assert (and (<= 0 x49) (<= x49 10)))
+(assert (and (<= 0 x50) (<= x50 10)))
+(assert (and (<= 0 x51) (<= x51 10)))
+(assert (and (<= 0 x52) (<= x52 10)))
+(assert (and (<= 0 x53) (<= x53 10)))
+(assert (and (<= 0 x54) (<= x54 10)))
+(assert (and (<= 0 x55) (<= x55 10)))
+(assert (and (<= 0 x56) (<= x56 10)))
+(assert (and (<= 0 x57) (<= x57 10)))
+(assert (and (<= 0 x58) (<= x58 10)))
+(assert (and (<= 0 x59) (<= x59 10)))
+(assert (or (< (+ x20 (* 3 x9) (- x25)) 1) (>= x20 5)))
+(assert (<= (+ x20 (* 3 x9) (- x25)) 15))
+(assert (or (< (+ x52 (* 2 x34) (- x6)) 9) (>= x52 5)))
+(assert (<= (+ x52 (* 2 x34) (- x6)) 10))
+(assert (or (< (+ x58 (* 1 x32) (- x13)) 0) (>= x58 5)))
+(assert (<= (+ x58 (* 1 x32) (- x13)) 8))
+(assert (or (< (+ x26 (* 1 x4) (- x15)) 4) (>= x26 5)))
+(assert (<= (+ x26 (* 1 x4) (- x15)) 8))
+(assert (or (< (+ x3 (* 1 x52) (- x36)) 1) (>= x3 5)))
+(assert (<= (+ x3 (* 1 x52) (- x36)) 5))
+(assert (or (< (+ x36 (* 1 x37) (- x25)) 1) (>= x36 5)))
+(assert (<= (+ x36 (* 1 x37) (- x25)) 5))
+(assert (or (< (+ x35 (* 2 x54) (- x8)) 6) (>= x35 5)))
+(assert (<= (+ x35 (* 2 x54) (- x8)) 11))
+(assert (or (< (+ x34 (* 2 x7) (- x36)) 8) (>= x34 5)))
+(assert (<= (+ x34 (* 2 x7) (- x36)) 11))
+(assert (or (< (+ x6 (* 3 x37) (- x36)) 6) (>= x6 5)))
+(assert (<= (+ x6 (* 3 x37) (- x36)) 17))
+(assert (or (< (+ x6 (* 1 x35) (- x45)) 4) (>= x6 5)))
+(assert (<= (+ x6 (* 1 x35) (- x45)) 5))
+(assert (or (< (+ x39 (* 3 x13) (- x31)) 13) (>= x39 5)))
+(assert (<= (+ x39 (* 3 x13) (- x31)) 17))
+(assert (or (< (+ x29 (* 2 x37) (- x59)) 5) (>= x29 5)))
+(assert (<= (+ x29 (* 2 x37) (- x59)) 12))
+(assert (or (< (+ x15 (* 3 x50) (- x11)) 7) (>= x15 5)))
+(assert (<= (+ x15 (* 3 x50) (- x11)) 15))
+(assert (or (< (+ x36 (* 2 x19) (- x33)) 5) (>= x36 5)))
+(assert (<= (+ x36 (* 2 x19) (- x33)) 13))
+(assert (or (< (+ x18 (* 1 x38) (- x4)) 4) (>= x18 5)))
+(assert (<= (+ x18 (* 1 x38) (- x4)) 8))
+(assert (or (< (+ x10 (* 1 x48) (- x21)) 3) (>= x10 5)))
+(assert (<= (+ x10 (* 1 x48) (- x21)) 8))
+(assert (or (< (+ x2 (* 3 x42) (- x4)) 10) (>= x2 5)))
+(assert (<= (+ x2 (* 3 x42) (- x4)) 17))
+(assert (or (< (+ x44 (* 2 x22) (- x38)) 9) (>= x44 5)))
+(assert (<= (+ x44 (* 2 x22) (- x38)) 13))
+(assert (or (< (+ x4 (* 2 x53) (- x5)) 7) (>= x4 5)))
+(assert (<= (+ x4 (* 2 x53) (- x5)) 10))
+(assert (or (< (+ x3 (* 2 x46) (- x44)) 10) (>= x3 5)))
+(assert (<= (+ x3 (* 2 x46) (- x44)) 13))
+(assert (or (< (+ x18 (* 3 x45) (- x24)) 11) (>= x18 5)))
+(assert (<= (+ x18 (* 3 x45) (- x24)) 15))
+(assert (or (< (+ x29 (* 3 x22) (- x10)) 3) (>= x29 5)))
+(assert (<= (+ x29 (* 3 x22) (- x10)) 18))
+(assert (or (< (+ x3 (* 2 x13) (- x49)) 2) (>= x3 5)))
+(assert (<= (+ x3 (* 2 x13) (- x49)) 11))
+(assert (or (< (+ x25 (* 2 x58) (- x55)) 1) (>= x25 5)))
+(assert (<= (+ x25 (* 2 x58) (- x55)) 11))
+(assert (or (< (+ x28 (* 2 x25) (- x35)) 2) (>= x28 5)))
+(assert (<= (+ x28 (* 2 x25) (- x35)) 13))
+(assert (or (< (+ x55 (* 3 x35) (- x17)) 13) (>= x55 5)))
+(assert (<= (+ x55 (* 3 x35) (- x17)) 17))
+(assert (or (< (+ x43 (* 1 x56) (- x24)) 1) (>= x43 5)))
+(assert (<= (+ x43 (* 1 x56) (- x24)) 5))
+(assert (or (< (+ x11 (* 3 x9) (- x14)) 7) (>= x11 5)))
+(assert (<= (+ x11 (* 3 x9) (- x14)) 15))
+(assert (or (< (+ x31 (* 1 x53) (- x37)) 2) (>= x31 5)))
+(assert (<= (+ x31 (* 1 x53) (- x37)) 7))
+(assert (or (< (+ x0 (* 3 x9) (- x26)) 11) (>= x0 5)))
+(assert (<= (+ x0 (* 3 x9) (- x26)) 17))
+(assert (or (< (+ x8 (* 3 x44) (- x54)) 1) (>= x8 5)))
+(assert (<= (+ x8 (* 3 x44) (- x54)) 18))
+(assert (or (< (+ x57 (* 3 x55) (- x49)) 12) (>= x57 5)))
+(assert (<= (+ x57 (* 3 x55) (- x49)) 18))
+(assert (or (< (+ x25 (* 3 x6) (- x30)) 12) (>= x25 5)))
+(assert (<= (+ x25 (* 3 x6) (- x30)) 15))
+(assert (or (< (+ x12 (* 2 x4) (- x13)) 2) (>= x12 5)))
+(assert (<= (+ x12 (* 2 x4) (- x13)) 10))
+(assert (or (< (+ x21 (* 1 x38) (- x3)) 0) (>= x21 5)))
+(assert (<= (+ x21 (* 1 x38) (- x3)) 6))
+(assert (or (< (+ x34 (* 3 x6) (- x23)) 0) (>= x34 5)))
+(assert (<= (+ x34 (* 3 x6) (- x23)) 15))
+(assert (or (< (+ x55 (* 2 x13) (- x39)) 2) (>= x55 5)))
+(assert (<= (+ x55 (* 2 x13) (- x39)) 12))
+(assert (or (< (+ x22 (* 2 x38) (- x23)) 1) (>= x22 5)))
+(assert (<= (+ x22 (* 2 x38) (- x23)) 10))
+(assert (or (< (+ x54 (* 2 x31) (- x29)) 7) (>= x54 5)))
+(assert (<= (+ x54 (* 2 x31) (- x29)) 12))
+(assert (or (< (+ x5 (* 3 x9) (- x6)) 10) (>= x5 5)))
+(assert (<= (+ x5 (* 3 x9) (- x6)) 17))
+(assert (or (< (+ x30 (* 1 x53) (- x44)) 4) (>= x30 5)))
+(assert (<= (+ x30 (* 1 x53) (- x44)) 5))
+(assert (or (< (+ x13 (* 1 x33) (- x23)) 5) (>= x13 5)))
+(assert (<= (+ x13 (* 1 x33) (- x23)) 5))
+(assert (or (< (+ x48 (* 3 x33) (- x19)) 2) (>= x48 5)))
+(assert (<= (+ x48 (* 3 x33) (- x19)) 17))
+(assert (or (< (+ x33 (* 1 x23) (- x58)) 2) (>= x33 5)))
+(assert (<= (+ x33 (* 1 x23) (- x58)) 6))
+(assert (or (< (+ x34 (* 2 x49) (- x32)) 10) (>= x34 5)))
+(assert (<= (+ x34 (* 2 x49) (- x32)) 11))
+(assert (or (< (+ x39 (* 1 x51) (- x50)) 1) (>= x39 5)))
+(assert (<= (+ x39 (* 1 x51) (- x50)) 8))
+(assert (or (< (+ x47 (* 1 x51) (- x14)) 4) (>= x47 5)))
+(assert (<= (+ x47 (* 1 x51) (- x14)) 8))
+(assert (or (< (+ x22 (* 1 x46) (- x1)) 2) (>= x22 5)))
+(assert (<= (+ x22 (* 1 x46) (- x1)) 8))
+(assert (or (< (+ x16 (* 3 x12) (- x44)) 11) (>= x16 5)))
+(assert (<= (+ x16 (* 3 x12) (- x44)) 18))
+(assert (or (< (+ x51 (* 2 x59) (- x46)) 5) (>= x51 5)))
+(assert (<= (+ x51 (* 2 x59) (- x46)) 10))
+(assert (or (< (+ x14 (* 1 x6) (- x30)) 2) (>= x14 5)))
+(assert (<= (+ x14 (* 1 x6) (- x30)) 6))
+(assert (or (< (+ x30 (* 3 x39) (- x57)) 0) (>= x30 5)))
+(assert (<= (+ x30 (* 3 x39) (- x57)) 18))
+(assert (or (< (+ x58 (* 3 x41) (- x22)) 2) (>= x58 5)))
+(assert (<= (+ x58 (* 3 x41) (- x22)) 15))
+(assert (or (< (+ x58 (* 3 x24) (- x50)) 6) (>= x58 5)))
+(assert (<= (+ x58 (* 3 x24) (- x50)) 18))
+(assert (or (< (+ x56 (* 3 x11) (- x27)) 10) (>= x56 5)))
+(assert (<= (+ x56 (* 3 x11) (- x27)) 15))
+(assert (or (< (+ x51 (* 2 x46) (- x25)) 6) (>= x51 5)))
+(assert (<= (+ x51 (* 2 x46) (- x25)) 10))
+(assert (or (< (+ x46 (* 1 x10) (- x8)) 1) (>= x46 5)))
+(assert (<= (+ x46 (* 1 x10) (- x8)) 8))
+(assert (or (< (+ x51 (* 3 x41) (- x9)) 15) (>= x51 5)))
+(assert (<= (+ x51 (* 3 x41) (- x9)) 17))
+(assert (or (< (+ x9 (* 1 x35) (- x8)) 0) (>= x9 5)))
+(assert (<= (+ x9 (* 1 x35) (- x8)) 5))
+(assert (or (< (+ x33 (* 1 x47) (- x59)) 3) (>= x33 5)))
+(assert (<= (+ x33 (* 1 x47) (- x59)) 6))
+(assert (or (< (+ x52 (* 1 x55) (- x13)) 2) (>= x52 5)))
+(assert (<= (+ x52 (* 1 x55) (- x13)) 6))
+(assert (or (< (+ x18 (* 3 x32) (- x15)) 10) (>= x18 5)))
+(assert (<= (+ x18 (* 3 x32) (- x15)) 17))
+(assert (or (< (+ x34 (* 1 x26) (- x53)) 0) (>= x34 5)))
+(assert (<= (+ x34 (* 1 x26) (- x53)) 7))
+(assert (or (< (+ x57 (* 3 x29) (- x42)) 13) (>= x57 5)))
+(assert (<= (+ x57 (* 3 x29) (- x42)) 16))
+(assert (or (< (+ x34 (* 3 x9) (- x33)) 0) (>= x34 5)))
+(assert (<= (+ x34 (* 3 x9) (- x33)) 18))
+(assert (or (< (+ x49 (* 1 x11) (- x38)) 1) (>= x49 5)))
+(assert (<= (+ x49 (* 1 x11) (- x38)) 6))
+(assert (or (< (+ x9 (* 3 x30) (- x39)) 3) (>= x9 5)))
+(assert (<= (+ x9 (* 3 x30) (- x39)) 15))
+(assert (or (< (+ x20 (* 3 x43) (- x33)) 15) (>= x20 5)))
+(assert (<= (+ x20 (* 3 x43) (- x33)) 15))
+(assert (or (< (+ x56 (* 1 x35) (- x3)) 1) (>= x56 5)))
+(assert (<= (+ x56 (* 1 x35) (- x3)) 7))
+(assert (or (< (+ x2 (* 3 x49) (- x6)) 14) (>= x2 5)))
+(assert (<= (+ x2 (* 3 x49) (- x6)) 15))
+(assert (or (< (+ x48 (* 1 x57) (- x58)) 3) (>= x48 5)))
+(assert (<= (+ x48 (* 1 x57) (- x58)) 7))
+(assert (or (< (+ x39 (* 3 x32) (- x38)) 6) (>= x39 5)))
+(assert (<= (+ x39 (* 3 x32) (- x38)) 17))
+(assert (or (< (+ x28 (* 2 x32) (- x34)) 8) (>= x28 5)))
+(assert (<= (+ x28 (* 2 x32) (- x34)) 11))
+(assert (or (< (+ x44 (* 2 x33) (- x56)) 8) (>= x44 5)))
+(assert (<= (+ x44 (* 2 x33) (- x56)) 11))
+(assert (or (< (+ x53 (* 2 x28) (- x8)) 1) (>= x53 5)))
+(assert (<= (+ x53 (* 2 x28) (- x8)) 13))
+(assert (or (< (+ x28 (* 3 x20) (- x4)) 7) (>= x28 5)))
+(assert (<= (+ x28 (* 3 x20) (- x4)) 18))
+(assert (or (< (+ x4 (* 2 x13) (- x42)) 1) (>= x4 5)))
+(assert (<= (+ x4 (* 2 x13) (- x42)) 11))
+(assert (or (< (+ x45 (* 2 x41) (- x42)) 2) (>= x45 5)))
+(assert (<= (+ x45 (* 2 x41) (- x42)) 12))
+(assert (or (< (+ x56 (* 1 x8) (- x29)) 5) (>= x56 5)))
+(assert (<= (+ x56 (* 1 x8) (- x29)) 5))
+(assert (or (< (+ x25 (* 1 x56) (- x31)) 5) (>= x25 5)))
+(assert (<= (+ x25 (* 1 x56) (- x31)) 6))
+(assert (or (< (+ x10 (* 3 x45) (- x27)) 12) (>= x10 5)))
+(assert (<= (+ x10 (* 3 x45) (- x27)) 17))
+(assert (or (< (+ x26 (* 2 x12) (- x22)) 1) (>= x26 5)))
+(assert (<= (+ x26 (* 2 x12) (- x22)) 12))
+(assert (or (< (+ x1 (* 2 x21) (- x35)) 7) (>= x1 5)))
+(assert (<= (+ x1 (* 2 x21) (- x35)) 10))
+(assert (or (< (+ x24 (* 3 x21) (- x33)) 9) (>= x24 5)))
+(assert (<= (+ x24 (* 3 x21) (- x33)) 15))
+(assert (or (< (+ x7 (* 1 x58) (- x50)) 0) (>= x7 5)))
+(assert (<= (+ x7 (* 1 x58) (- x50)) 5))
+(assert (or (< (+ x16 (* 1 x17) (- x2)) 2) (>= x16 5)))
+(assert (<= (+ x16 (* 1 x17) (- x2)) 6))
+(assert (or (< (+ x52 (* 3 x27) (- x54)) 8) (>= x52 5)))
+(assert (<= (+ x52 (* 3 x27) (- x54)) 18))
+(assert (or (< (+ x9 (* 3 x34) (- x58)) 15) (>= x9 5)))
+(assert (<= (+ x9 (* 3 x34) (- x58)) 17))
+(assert (or (< (+ x5 (* 3 x17) (- x3)) 5) (>= x5 5)))
+(assert (<= (+ x5 (* 3 x17) (- x3)) 18))
+(assert (or (< (+ x57 (* 1 x4) (- x17)) 5) (>= x57 5)))
+(assert (<= (+ x57 (* 1 x4) (- x17)) 5))
+(assert (or (< (+ x51 (* 3 x16) (- x5)) 7) (>= x51 5)))
+(assert (<= (+ x51 (* 3 x16) (- x5)) 15))
+(assert (or (< (+ x16 (* 2 x55) (- x7)) 0) (>= x16 5)))
+(assert (<= (+ x16 (* 2 x55) (- x7)) 12))
+(assert (or (< (+ x35 (* 2 x26) (- x59)) 9) (>= x35 5)))
+(assert (<= (+ x35 (* 2 x26) (- x59)) 11))
+(assert (or (< (+ x2 (* 1 x33) (- x45)) 0) (>= x2 5)))
+(assert (<= (+ x2 (* 1 x33) (- x45)) 6))
+(assert (or (< (+ x16 (* 1 x3) (- x11)) 2) (>= x16 5)))
+(assert (<= (+ x16 (* 1 x3) (- x11)) 7))
+(assert (or (< (+ x33 (* 2 x48) (- x13)) 7) (>= x33 5)))
+(assert (<= (+ x33 (* 2 x48) (- x13)) 11))
+(assert (or (< (+ x17 (* 1 x22) (- x51)) 2) (>= x17 5)))
+(assert (<= (+ x17 (* 1 x22) (- x51)) 5))
+(assert (or (< (+ x0 (* 3 x1) (- x46)) 6) (>= x0 5)))
+(assert (<= (+ x0 (* 3 x1) (- x46)) 18))
+(assert (or (< (+ x15 (* 1 x59) (- x28)) 5) (>= x15 5)))
+(assert (<= (+ x15 (* 1 x59) (- x28)) 8))
+(assert (or (< (+ x42 (* 2 x31) (- x34)) 8) (>= x42 5)))
+(assert (<= (+ x42 (* 2 x31) (- x34)) 12))
+(assert (or (< (+ x44 (* 2 x13) (- x14)) 3) (>= x44 5)))
+(assert (<= (+ x44 (* 2 x13) (- x14)) 11))
+(assert (or (< (+ x25 (* 1 x22) (- x3)) 0) (>= x25 5)))
+(assert (<= (+ x25 (* 1 x22) (- x3)) 5))
+(assert (or (< (+ x40 (* 2 x47) (- x56)) 6) (>= x40 5)))
+(assert (<= (+ x40 (* 2 x47) (- x56)) 11))
+(assert (or (< (+ x3 (* 2 x5) (- x42)) 8) (>= x3 5)))
+(assert (<= (+ x3 (* 2 x5) (- x42)) 12))
+(assert (or (< (+ x38 (* 2 x15) (- x44)) 0) (>= x38 5)))
+(assert (<= (+ x38 (* 2 x15) (- x44)) 13))
+(assert (or (< (+ x11 (* 2 x10) (- x17)) 0) (>= x11 5)))
+(assert (<= (+ x11 (* 2 x10) (- x17)) 12))
+(assert (or (< (+ x23 (* 2 x21) (- x35)) 3) (>= x23 5)))
+(assert (<= (+ x23 (* 2 x21) (- x35)) 10))
+(assert (or (< (+ x56 (* 2 x19) (- x13)) 2) (>= x56 5)))
+(assert (<= (+ x56 (* 2 x19) (- x13)) 10))
+(assert (or (< (+ x21 (* 2 x24) (- x5)) 4) (>= x21 5)))
+(assert (<= (+ x21 (* 2 x24) (- x5)) 11))
+(assert (or (< (+ x15 (* 1 x32) (- x49)) 0) (>= x15 5)))
+(assert (<= (+ x15 (* 1 x32) (- x49)) 7))
+(assert (or (< (+ x52 (* 2 x5) (- x9)) 9) (>= x52 5)))
+(assert (<= (+ x52 (* 2 x5) (- x9)) 10))
+(assert (or (< (+ x25 (* 2 x1) (- x19)) 10) (>= x25 5)))
+(assert (<= (+ x25 (* 2 x1) (- x19)) 11))
+(assert (or (< (+ x5 (* 1 x37) (- x33)) 5) (>= x5 5)))
+(assert (<= (+ x5 (* 1 x37) (- x33)) 8))
+(assert (or (< (+ x48 (* 2 x20) (- x46)) 2) (>= x48 5)))
+(assert (<= (+ x48 (* 2 x20) (- x46)) 12))
+(assert (or (< (+ x46 (* 1 x39) (- x41)) 0) (>= x46 5)))
+(assert (<= (+ x46 (* 1 x39) (- x41)) 8))
+(assert (or (< (+ x46 (* 3 x44) (- x51)) 4) (>= x46 5)))
+(assert (<= (+ x46 (* 3 x44) (- x51)) 15))
+(assert (or (< (+ x52 (* 3 x43) (- x37)) 7) (>= x52 5)))
+(assert (<= (+ x52 (* 3 x43) (- x37)) 15))
+(assert (or (< (+ x1 (* 3 x2) (- x8)) 11) (>= x1 5)))
+(assert (<= (+ x1 (* 3 x2) (- x8)) 15))
+(assert (or (< (+ x24 (* 3 x53) (- x28)) 1) (>= x24 5)))
+(assert (<= (+ x24 (* 3 x53) (- x28)) 15))
+(assert (or (< (+ x40 (* 1 x34) (- x43)) 3) (>= x40 5)))
+(assert (<= (+ x40 (* 1 x34) (- x43)) 7))
+(assert (or (< (+ x0 (* 1 x29) (- x51)) 5) (>= x0 5)))
+(assert (<= (+ x0 (* 1 x29) (- x51)) 5))
+(assert (or (< (+ x42 (* 3 x33) (- x4)) 15) (>= x42 5)))
+(assert (<= (+ x42 (* 3 x33) (- x4)) 17))
+(assert (or (< (+ x51 (* 2 x4) (- x54)) 3) (>= x51 5)))
+(assert (<= (+ x51 (* 2 x4) (- x54)) 11))
+(assert (or (< (+ x14 (* 2 x47) (- x41)) 7) (>= x14 5)))
+(assert (<= (+ x14 (* 2 x47) (- x41)) 13))
+(assert (or (< (+ x4 (* 3 x30) (- x58)) 9) (>= x4 5)))
+(assert (<= (+ x4 (* 3 x30) (- x58)) 15))
+(assert (or (< (+ x39 (* 1 x40) (- x41)) 0) (>= x39 5)))
+(assert (<= (+ x39 (* 1 x40) (- x41)) 6))
+(assert (or (< (+ x21 (* 3 x16) (- x41)) 9) (>= x21 5)))
+(assert (<= (+ x21 (* 3 x16) (- x41)) 16))
+(assert (or (< (+ x0 (* 2 x30) (- x3)) 4) (>= x0 5)))
+(assert (<= (+ x0 (* 2 x30) (- x3)) 10))
+(assert (or (< (+ x44 (* 2 x13) (- x43)) 4) (>= x44 5)))
+(assert (<= (+ x44 (* 2 x13) (- x43)) 12))
+(assert (or (< (+ x29 (* 3 x49) (- x7)) 6) (>= x29 5)))
+(assert (<= (+ x29 (* 3 x49) (- x7)) 17))
+(assert (or (< (+ x5 (* 1 x59) (- x30)) 2) (>= x5 5)))
+(assert (<= (+ x5 (* 1 x59) (- x30)) 8))
+(assert (or (< (+ x4 (* 2 x52) (- x32)) 4) (>= x4 5)))
+(assert (<= (+ x4 (* 2 x52) (- x32)) 13))
+(assert (or (< (+ x13 (* 1 x58) (- x59)) 0) (>= x13 5)))
+(assert (<= (+ x13 (* 1 x58) (- x59)) 5))
+(assert (or (< (+ x9 (* 2 x47) (- x33)) 5) (>= x9 5)))
+(assert (<= (+ x9 (* 2 x47) (- x33)) 11))
+(assert (or (< (+ x38 (* 3 x52) (- x40)) 8) (>= x38 5)))
+(assert (<= (+ x38 (* 3 x52) (- x40)) 15))
+(assert (or (< (+ x45 (* 2 x23) (- x14)) 7) (>= x45 5)))
+(assert (<= (+ x45 (* 2 x23) (- x14)) 13))
+(assert (or (< (+ x1 (* 2 x10) (- x0)) 10) (>= x1 5)))
+(assert (<= (+ x1 (* 2 x10) (- x0)) 13))
+(assert (or (< (+ x25 (* 1 x19) (- x46)) 3) (>= x25 5)))
+(assert (<= (+ x25 (* 1 x19) (- x46)) 7))
+(assert (or (< (+ x24 (* 2 x20) (- x7)) 0) (>= x24 5)))
+(assert (<= (+ x24 (* 2 x20) (- x7)) 12))
+(assert (or (< (+ x48 (* 2 x21) (- x53)) 1) (>= x48 5)))
+(assert (<= (+ x48 (* 2 x21) (- x53)) 11))
+(assert (or (< (+ x45 (* 3 x0) (- x57)) 9) (>= x45 5)))
+(assert (<= (+ x45 (* 3 x0) (- x57)) 17))
+(assert (or (< (+ x23 (* 2 x4) (- x25)) 9) (>= x23 5)))
+(assert (<= (+ x23 (* 2 x4) (- x25)) 10))
+(assert (or (< (+ x23 (* 2 x59) (- x27)) 0) (>= x23 5)))
+(assert (<= (+ x23 (* 2 x59) (- x27)) 12))
+(assert (or (< (+ x6 (* 3 x3) (- x53)) 9) (>= x6 5)))
+(assert (<= (+ x6 (* 3 x3) (- x53)) 16))
+(assert (or (< (+ x15 (* 3 x17) (- x27)) 10) (>= x15 5)))
+(assert (<= (+ x15 (* 3 x17) (- x27)) 16))
+(assert (or (< (+ x49 (* 2 x23) (- x50)) 0) (>= x49 5)))
+(assert (<= (+ x49 (* 2 x23) (- x50)) 13))
+(assert (or (< (+ x58 (* 3 x56) (- x35)) 6) (>= x58 5)))
+(assert (<= (+ x58 (* 3 x56) (- x35)) 15))
+(assert (or (< (+ x3 (* 2 x59) (- x46)) 7) (>= x3 5)))
+(assert (<= (+ x3 (* 2 x59) (- x46)) 11))
+(assert (or (< (+ x41 (* 2 x55) (- x18)) 0) (>= x41 5)))
+(assert (<= (+ x41 (* 2 x55) (- x18)) 11))
+(assert (or (< (+ x10 (* 2 x30) (- x26)) 4) (>= x10 5)))
+(assert (<= (+ x10 (* 2 x30) (- x26)) 12))
+(assert (or (< (+ x16 (* 2 x47) (- x41)) 6) (>= x16 5)))
+(assert (<= (+ x16 (* 2 x47) (- x41)) 11))
+(assert (or (< (+ x19 (* 3 x30) (- x35)) 12) (>= x19 5)))
+(assert (<= (+ x19 (* 3 x30) (- x35)) 15))
+(assert (or (< (+ x10 (* 1 x41) (- x4)) 4) (>= x10 5)))
+(assert (<= (+ x10 (* 1 x41) (- x4)) 8))
+(assert (or (< (+ x35 (* 2 x14) (- x28)) 7) (>= x35 5)))
+(assert (<= (+ x35 (* 2 x14) (- x28)) 13))
+(assert (or (< (+ x8 (* 1 x35) (- x12)) 0) (>= x8 5)))
+(assert (<= (+ x8 (* 1 x35) (- x12)) 6))
+(assert (or (< (+ x21 (* 2 x35) (- x5)) 3) (>= x21 5)))
+(assert (<= (+ x21 (* 2 x35) (- x5)) 12))
+(assert (or (< (+ x16 (* 1 x51) (- x36)) 0) (>= x16 5)))
+(assert (<= (+ x16 (* 1 x51) (- x36)) 8))
+(assert (or (< (+ x24 (* 3 x26) (- x47)) 6) (>= x24 5)))
+(assert (<= (+ x24 (* 3 x26) (- x47)) 18))
+(assert (or (< (+ x17 (* 1 x21) (- x48)) 3) (>= x17 5)))
+(assert (<= (+ x17 (* 1 x21) (- x48)) 7))
+(assert (or (< (+ x36 (* 3 x23) (- x8)) 6) (>= x36 5)))
+(assert (<= (+ x36 (* 3 x23) (- x8)) 15))
+(check-sat)
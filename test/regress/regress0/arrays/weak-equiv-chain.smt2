@@ -0,0 +1,17 @@
+; COMMAND-LINE: --arrays-weak-equiv
+; EXPECT: unsat
+(set-logic QF_AUFLIA)
+(declare-fun m0 () (Array Int Int))
+(declare-fun p () Int)
+(declare-fun q () Int)
+(declare-fun i1 () Int)
+(declare-fun i2 () Int)
+(declare-fun i3 () Int)
+(declare-fun i4 () Int)
+(define-fun m4 () (Array Int Int)
+  (store (store (store (store m0 i1 1) i2 2) i3 3) i4 4))
+(define-fun m5 () (Array Int Int) (store m4 i1 5))
+(assert (distinct p i1 i2 i3 i4))
+(assert (= p q))
+(assert (distinct (select m5 p) (select m0 q)))
+(check-sat)
@@ -1,4 +1,5 @@
 ; COMMAND-LINE: --tlimit-per 1000
+; COMMAND-LINE: --tlimit-per 1000 --tlimit-watchdog
 ; EXPECT: unknown
 (set-logic UF)
 (declare-sort T 0)
@@ -0,0 +1,11 @@
+; COMMAND-LINE: --bitblast=eager --ackermann-prune --no-check-models  --no-check-unsat-cores
+; EXPECT: unsat
+(set-logic QF_UFBV)
+(declare-fun x () (_ BitVec 4))
+(declare-fun y () (_ BitVec 4))
+(declare-fun f ((_ BitVec 4) (_ BitVec 4)) (_ BitVec 4))
+(assert (= (f #b0001 x) #b0011))
+(assert (= (f #b0010 x) #b0101))
+(assert (= (f #b0001 (bvadd y #b0001)) #b0110))
+(assert (= x (bvadd y #b0001)))
+(check-sat)
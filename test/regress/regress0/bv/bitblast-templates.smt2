@@ -0,0 +1,15 @@
+; COMMAND-LINE: --bitblast=eager
+; COMMAND-LINE: --bitblast=lazy
+; COMMAND-LINE: --no-bv-bitblast-templates
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 6))
+(declare-fun y () (_ BitVec 6))
+(declare-fun u () (_ BitVec 6))
+(declare-fun v () (_ BitVec 6))
+(assert (= x (bvnot u)))
+(assert (= y (bvnot v)))
+(assert (distinct (bvmul x y) (bvmul (bvnot u) (bvnot v))))
+(assert (or (distinct (bvudiv x y) (bvudiv (bvnot u) (bvnot v)))
+            (distinct u (bvadd (bvmul (bvudiv u v) v) (bvurem u v)))))
+(check-sat)
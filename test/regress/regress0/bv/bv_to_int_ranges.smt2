@@ -0,0 +1,14 @@
+; COMMAND-LINE: --solve-bv-as-int=1 --no-check-models  --no-check-unsat-cores --no-check-proofs
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(define-fun xx () (_ BitVec 16) ((_ zero_extend 8) x))
+(define-fun yy () (_ BitVec 16) ((_ zero_extend 8) y))
+; the sum and product of zero-extended operands cannot overflow
+(assert (or (bvult (bvadd xx yy) xx)
+            (not (= ((_ extract 8 0) (bvadd xx yy)) ((_ extract 8 0) (bvadd yy xx))))
+            (bvugt (bvmul xx yy) (_ bv65025 16))
+            (not (= ((_ extract 15 8) (bvlshr xx y)) (_ bv0 8)))))
+(check-sat)
+(exit)
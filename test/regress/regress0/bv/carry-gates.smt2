@@ -0,0 +1,12 @@
+; COMMAND-LINE: --bitblast=eager
+; COMMAND-LINE: --bitblast=lazy
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun a () (_ BitVec 12))
+(declare-fun b () (_ BitVec 12))
+(declare-fun c () (_ BitVec 12))
+(assert (bvult a (bvsub #xfff b)))
+(assert (not (bvult (bvadd b a) #xfff)))
+(assert (= c (bvmul a #x003)))
+(assert (distinct c (bvadd a (bvadd a a))))
+(check-sat)
@@ -0,0 +1,27 @@
+; COMMAND-LINE: --incremental --bitblast=lazy --bv-core-cache
+; COMMAND-LINE: --incremental --bitblast=lazy --bv-core-cache --bv-core-cache-size=1
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(declare-fun b () Bool)
+(assert (= (bvmul x y) #x0f))
+(assert (or b (not b)))
+(push 1)
+(assert (= ((_ extract 0 0) x) #b0))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= y #x03))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= ((_ extract 0 0) x) #b0))
+(assert (= y #x05))
+(check-sat)
+(pop 1)
+(assert (= ((_ extract 0 0) x) #b0))
+(check-sat)
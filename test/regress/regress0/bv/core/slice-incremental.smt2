@@ -0,0 +1,23 @@
+; COMMAND-LINE: --incremental --bv-eq-slicer=on
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(declare-fun z () (_ BitVec 4))
+(assert (= ((_ extract 7 4) x) z))
+(check-sat)
+(push 1)
+(assert (= x (concat z ((_ extract 3 0) y))))
+(assert (not (= ((_ extract 3 0) x) ((_ extract 3 0) y))))
+(check-sat)
+(pop 1)
+(assert (= ((_ extract 5 2) y) z))
+(check-sat)
+(assert (= x y))
+(assert (not (= ((_ extract 7 6) y) ((_ extract 5 4) y))))
+(assert (= ((_ extract 7 6) x) ((_ extract 3 2) y)))
+(assert (= ((_ extract 5 4) x) ((_ extract 3 2) y)))
+(check-sat)
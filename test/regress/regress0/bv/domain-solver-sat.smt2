@@ -0,0 +1,11 @@
+; COMMAND-LINE: --bv-domain-solver
+; EXPECT: sat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 32))
+(declare-fun y () (_ BitVec 32))
+(assert (bvslt x #x00000000))
+(assert (bvsgt x #xfffffff0))
+(assert (= (bvand x #x0000000f) #x00000003))
+(assert (bvult (bvadd y #x00000001) y))
+(assert (or (= (bvmul x y) #x0000000d) (= ((_ extract 3 0) y) #x7)))
+(check-sat)
@@ -0,0 +1,9 @@
+; COMMAND-LINE: --bv-domain-solver
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 32))
+(declare-fun y () (_ BitVec 32))
+(assert (bvult x #x00000100))
+(assert (bvult y #x00000100))
+(assert (= ((_ extract 31 16) (bvmul x y)) #x0001))
+(check-sat)
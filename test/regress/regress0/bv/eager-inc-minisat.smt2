@@ -0,0 +1,34 @@
+; COMMAND-LINE: --incremental --bitblast=eager
+(set-logic QF_BV)
+(set-option :incremental true)
+(declare-fun a () (_ BitVec 16))
+(declare-fun b () (_ BitVec 16))
+(declare-fun c () (_ BitVec 16))
+
+(assert (bvult a (bvadd b c)))
+(set-info :status sat)
+(check-sat)
+
+(push 1)
+(assert (bvult c b))
+(assert (bvult a b))
+(set-info :status sat)
+(check-sat)
+
+(push 1)
+(assert (bvugt c b))
+(set-info :status unsat)
+(check-sat)
+(pop 1)
+
+(push 1)
+(assert (= c #x0000))
+(set-info :status sat)
+(check-sat)
+(pop 2)
+
+(assert (= b #x0000))
+(assert (= c #x0000))
+(set-info :status unsat)
+(check-sat)
+(exit)
@@ -0,0 +1,10 @@
+; COMMAND-LINE: --bv-gate-simp
+; COMMAND-LINE: --no-bv-gate-simp
+; COMMAND-LINE: --bitblast=eager --bv-gate-simp
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun a () (_ BitVec 8))
+(declare-fun b () (_ BitVec 8))
+(declare-fun c () (_ BitVec 8))
+(assert (not (= (bvmul (bvadd a c) b) (bvadd (bvmul b a) (bvmul c b)))))
+(check-sat)
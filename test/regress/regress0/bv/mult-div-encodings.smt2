@@ -0,0 +1,9 @@
+; COMMAND-LINE: --bv-mult=wallace --bv-div=non-restoring
+; COMMAND-LINE: --bv-mult=auto --bv-mult-wallace-width=8 --bitblast=eager
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (not (= y #x00)))
+(assert (not (= x (bvadd (bvmul (bvudiv x y) y) (bvurem x y)))))
+(check-sat)
@@ -0,0 +1,16 @@
+; COMMAND-LINE: --result-cache
+; EXPECT: sat
+; EXPECT: unsat
+; The same query against the same cache, with both semantics of division by
+; zero.
+(set-option :bv-div-zero-const false)
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(assert (not (= (bvudiv x #x00) #xFF)))
+(check-sat)
+(reset)
+(set-option :bv-div-zero-const true)
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(assert (not (= (bvudiv x #x00) #xFF)))
+(check-sat)
@@ -0,0 +1,13 @@
+; REQUIRES: cryptominisat
+; COMMAND-LINE: --bitblast=eager --bv-sat-solver=cryptominisat --bv-sat-xor
+; COMMAND-LINE: --bitblast=eager --bv-sat-solver=cryptominisat --bv-sat-xor --bv-sat-gauss
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 16))
+(declare-fun y () (_ BitVec 16))
+(declare-fun z () (_ BitVec 16))
+(declare-fun w () (_ BitVec 16))
+(assert (= (bvxor x y z) w))
+(assert (= (bvxor x ((_ rotate_left 3) y)) (bvnot z)))
+(assert (not (= (bvxor w y z (bvxor x ((_ rotate_left 3) y))) (bvnot (bvxor x z)))))
+(check-sat)
@@ -0,0 +1,19 @@
+; COMMAND-LINE: --cnf-threads=3 --simplification=none
+; EXPECT: unsat
+(set-logic QF_UFLIA)
+(declare-fun a () Bool)
+(declare-fun b () Bool)
+(declare-fun c () Bool)
+(declare-fun d () Bool)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun f (Int) Int)
+(assert (or a (and b (> x 2))))
+(assert (xor a c))
+(assert (= c (and b (> x 2))))
+(assert (ite d (= (f x) y) (not (= a b))))
+(assert (=> (= (f x) y) (< x 0)))
+(assert (not (and (not d) (= a b))))
+(assert (= (> x 2) (not (= a (and b (> x 2))))))
+(assert (or (not a) (> x 2)))
+(check-sat)
@@ -0,0 +1,11 @@
+; COMMAND-LINE: --threads=2 --cube-depth=2
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (or (> x 3) (< y 0)))
+(assert (or (< x 2) (> y 5)))
+(assert (or (not (> x 3)) (< (+ x y) 4)))
+(assert (or (not (< y 0)) (> (+ x y) 7)))
+(assert (or (> x 3) (not (< x 2))))
+(check-sat)
@@ -0,0 +1,13 @@
+; COMMAND-LINE: --decision=justification --decision-activity
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun p1 () Int)
+(declare-fun p2 () Int)
+(declare-fun p3 () Int)
+(declare-fun b () Bool)
+(assert (or (= p1 1) (= p1 2)))
+(assert (or (= p2 1) (= p2 2)))
+(assert (or (= p3 1) (= p3 2)))
+(assert (distinct p1 p2 p3))
+(assert (=> b (> (ite (> p1 1) p2 p3) 0)))
+(check-sat)
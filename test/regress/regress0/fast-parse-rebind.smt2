@@ -0,0 +1,22 @@
+; COMMAND-LINE: --fast-parse
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic ALL)
+(declare-fun a () Int)
+(declare-fun f (Int) Int)
+(assert (= (f a) 3))
+; the parameter and the let bindings shadow a
+(define-fun g ((a Int)) Int (+ a 1))
+(assert (= (g 1) (let ((a 2)) (let ((a (+ a 0))) a))))
+(assert (= a (let ((a 5)) (- a 1))))
+; f is overloaded after its first uses
+(declare-fun f (Bool) Int)
+(assert (= (f true) (f a)))
+(check-sat)
+(push 1)
+(declare-fun b () Int)
+(assert (> b a))
+(pop 1)
+(declare-fun b () Int)
+(assert (and (< b a) (> b 4)))
+(check-sat)
@@ -0,0 +1,18 @@
+; COMMAND-LINE: --fast-parse
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic ALL)
+(set-info :status sat)
+(declare-fun x () (_ BitVec 8))
+(declare-const y Int)
+(declare-fun f (Int) Int)
+(define-fun g ((a Int) (b Int)) Int (+ a (* 2 b)))
+(assert (= ((_ extract 3 0) x) #b1010))
+(assert (let ((z (f y)) (w 1.5)) (and (> z (g y 3)) (< (to_real y) w))))
+(push 1)
+(check-sat)
+(pop 1)
+; the grammar handles the rest
+(assert (! (> y (- 5)) :named h))
+(assert (not (= x (bvadd x #x00))))
+(check-sat)
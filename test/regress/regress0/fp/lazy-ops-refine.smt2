@@ -0,0 +1,10 @@
+; REQUIRES: symfpu
+; COMMAND-LINE: --fp-lazy-ops --check-models
+; EXPECT: sat
+(set-logic QF_FP)
+(declare-const x Float32)
+(declare-const y Float32)
+(assert (fp.eq x ((_ to_fp 8 24) RNE 2.0)))
+(assert (fp.eq (fp.mul RNE x y) ((_ to_fp 8 24) RNE 6.0)))
+(assert (fp.lt (fp.sqrt RNE y) x))
+(check-sat)
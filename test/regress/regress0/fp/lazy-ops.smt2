@@ -0,0 +1,11 @@
+; REQUIRES: symfpu
+; COMMAND-LINE: --fp-lazy-ops
+; EXPECT: unsat
+(set-logic QF_FP)
+(declare-const x Float32)
+(declare-const y Float32)
+(declare-const z Float32)
+(assert (= z (fp.div RNE (fp.mul RNE x y) y)))
+(assert (= x y))
+(assert (not (= z (fp.div RNE (fp.mul RNE y x) x))))
+(check-sat)
@@ -0,0 +1,14 @@
+; COMMAND-LINE: --sat-lemma-use-stats
+; EXPECT: unsat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (or (= x 0) (= x 1)))
+(assert (or (= y 0) (= y 1)))
+(assert (distinct (f x) (f y)))
+(assert (= (+ x y) 1))
+(assert (> (f 0) (f 1)))
+(assert (> (+ (f 1) 1) (f x)))
+(assert (> (+ (f 1) 1) (f y)))
+(check-sat)
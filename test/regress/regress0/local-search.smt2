@@ -0,0 +1,12 @@
+; COMMAND-LINE: --local-search
+; EXPECT: sat
+(set-logic QF_BV)
+(set-option :check-models true)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(declare-fun b () Bool)
+(assert (= (bvadd x y) #x2a))
+(assert (bvult x y))
+(assert (= (bvand x #x0f) #x05))
+(assert (or b (= y #x00)))
+(check-sat)
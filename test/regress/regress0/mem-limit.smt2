@@ -0,0 +1,13 @@
+; COMMAND-LINE: --mem-limit=100000
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_UFLIA)
+(set-option :incremental true)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun f (Int) Int)
+(assert (> (f x) (f y)))
+(assert (or (= x (+ y 1)) (= y (+ x 1))))
+(check-sat)
+(assert (= x y))
+(check-sat)
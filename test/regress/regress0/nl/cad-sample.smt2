@@ -0,0 +1,11 @@
+; COMMAND-LINE: --nl-cad
+; EXPECT: sat
+(set-logic QF_NRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(assert (> (* x x) 3.0))
+(assert (< (* x x) 5.0))
+(assert (= (* x y y) 8.0))
+(assert (> y 1.5))
+(assert (< y 2.5))
+(check-sat)
@@ -0,0 +1,9 @@
+; COMMAND-LINE: --nl-cad
+; EXPECT: unsat
+(set-logic QF_NRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(assert (> x 0.0))
+(assert (< (+ (* x x x) (* (- 2.0) x) 5.0) 0.0))
+(assert (> (* x y) 1.0))
+(check-sat)
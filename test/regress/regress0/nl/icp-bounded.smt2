@@ -0,0 +1,11 @@
+; COMMAND-LINE: --nl-icp
+; EXPECT: unsat
+(set-logic QF_NRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(assert (and (<= 0 x) (<= x 2)))
+(assert (and (<= 0 y) (<= y 3)))
+(assert (= z (+ (* x y) (* x x))))
+(assert (>= z 10.5))
+(check-sat)
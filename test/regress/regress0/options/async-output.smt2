@@ -0,0 +1,9 @@
+; REQUIRES: dumping
+; COMMAND-LINE: --async-output --dump=assertions:pre-everything --dump-to=/dev/null
+; EXPECT: sat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (> x (+ y 2)))
+(assert (< y 5))
+(check-sat)
@@ -0,0 +1,9 @@
+; COMMAND-LINE: --auto-strategy
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (= (bvadd x y) #x10))
+(assert (ite (bvult x y) (= x #x03) (= y #x03)))
+(assert (not (or (= y #x0d) (= x #x0d))))
+(check-sat)
@@ -0,0 +1,14 @@
+; COMMAND-LINE: --theory-check-schedule
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_AUFLIA)
+(set-option :incremental true)
+(declare-fun a () (Array Int Int))
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (= (select a x) (f y)))
+(assert (> (f y) (+ y 1)))
+(check-sat)
+(assert (= (select a x) y))
+(check-sat)
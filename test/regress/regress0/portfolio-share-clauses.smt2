@@ -0,0 +1,69 @@
+; COMMAND-LINE: --threads=4 --share-clauses-length=4
+; EXPECT: unsat
+(set-logic QF_UF)
+(declare-fun p0h0 () Bool)
+(declare-fun p0h1 () Bool)
+(declare-fun p0h2 () Bool)
+(declare-fun p0h3 () Bool)
+(declare-fun p1h0 () Bool)
+(declare-fun p1h1 () Bool)
+(declare-fun p1h2 () Bool)
+(declare-fun p1h3 () Bool)
+(declare-fun p2h0 () Bool)
+(declare-fun p2h1 () Bool)
+(declare-fun p2h2 () Bool)
+(declare-fun p2h3 () Bool)
+(declare-fun p3h0 () Bool)
+(declare-fun p3h1 () Bool)
+(declare-fun p3h2 () Bool)
+(declare-fun p3h3 () Bool)
+(declare-fun p4h0 () Bool)
+(declare-fun p4h1 () Bool)
+(declare-fun p4h2 () Bool)
+(declare-fun p4h3 () Bool)
+(assert (or p0h0 p0h1 p0h2 p0h3))
+(assert (or p1h0 p1h1 p1h2 p1h3))
+(assert (or p2h0 p2h1 p2h2 p2h3))
+(assert (or p3h0 p3h1 p3h2 p3h3))
+(assert (or p4h0 p4h1 p4h2 p4h3))
+(assert (not (and p0h0 p1h0)))
+(assert (not (and p0h0 p2h0)))
+(assert (not (and p0h0 p3h0)))
+(assert (not (and p0h0 p4h0)))
+(assert (not (and p1h0 p2h0)))
+(assert (not (and p1h0 p3h0)))
+(assert (not (and p1h0 p4h0)))
+(assert (not (and p2h0 p3h0)))
+(assert (not (and p2h0 p4h0)))
+(assert (not (and p3h0 p4h0)))
+(assert (not (and p0h1 p1h1)))
+(assert (not (and p0h1 p2h1)))
+(assert (not (and p0h1 p3h1)))
+(assert (not (and p0h1 p4h1)))
+(assert (not (and p1h1 p2h1)))
+(assert (not (and p1h1 p3h1)))
+(assert (not (and p1h1 p4h1)))
+(assert (not (and p2h1 p3h1)))
+(assert (not (and p2h1 p4h1)))
+(assert (not (and p3h1 p4h1)))
+(assert (not (and p0h2 p1h2)))
+(assert (not (and p0h2 p2h2)))
+(assert (not (and p0h2 p3h2)))
+(assert (not (and p0h2 p4h2)))
+(assert (not (and p1h2 p2h2)))
+(assert (not (and p1h2 p3h2)))
+(assert (not (and p1h2 p4h2)))
+(assert (not (and p2h2 p3h2)))
+(assert (not (and p2h2 p4h2)))
+(assert (not (and p3h2 p4h2)))
+(assert (not (and p0h3 p1h3)))
+(assert (not (and p0h3 p2h3)))
+(assert (not (and p0h3 p3h3)))
+(assert (not (and p0h3 p4h3)))
+(assert (not (and p1h3 p2h3)))
+(assert (not (and p1h3 p3h3)))
+(assert (not (and p1h3 p4h3)))
+(assert (not (and p2h3 p3h3)))
+(assert (not (and p2h3 p4h3)))
+(assert (not (and p3h3 p4h3)))
+(check-sat)
@@ -0,0 +1,10 @@
+; COMMAND-LINE: --threads=3 --produce-models
+; EXPECT: sat
+; EXPECT: ((x 4))
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (and (> x 3) (< x 5)))
+(assert (= (+ x y) 10))
+(check-sat)
+(get-value (x))
@@ -0,0 +1,10 @@
+; COMMAND-LINE: --decompose-assertions
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun a () Int)
+(declare-fun b () Int)
+(assert (and (> x 2) (< y x) (> (+ x y) 5)))
+(assert (and (> a b) (> b a)))
+(check-sat)
@@ -0,0 +1,16 @@
+; COMMAND-LINE: --decompose-assertions
+; COMMAND-LINE: --decompose-assertions --check-models
+; COMMAND-LINE: --decompose-assertions --subsolver-pool --check-models
+; EXPECT: sat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun a () Int)
+(declare-fun b () Int)
+(declare-fun c () Int)
+(declare-fun p () Bool)
+(assert (and (> x 2) (< y x) (> (+ x y) 5)))
+(assert (or p (= (+ a b) 7)))
+(assert (and (> a 3) (> b 1) (not p)))
+(assert (and (> c 0) (< c 3)))
+(check-sat)
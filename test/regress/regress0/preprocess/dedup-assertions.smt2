@@ -0,0 +1,24 @@
+; COMMAND-LINE: --dedup-assertions
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_UFLIA)
+(set-option :incremental true)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun p () Bool)
+(declare-fun q () Bool)
+(declare-fun r () Bool)
+(assert (> x 0))
+(assert (> x 0))
+(assert (< 0 x))
+(assert (or p q))
+(assert (or q p r))
+(assert (or p (> x 0) r))
+(assert (or (not q) r (< y x)))
+(assert (not r))
+(check-sat)
+(push 1)
+(assert (or (not p) (< x 0)))
+(assert (or (not q) (< x 0)))
+(check-sat)
+(pop 1)
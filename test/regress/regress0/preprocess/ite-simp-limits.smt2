@@ -0,0 +1,13 @@
+; COMMAND-LINE: --ite-simp --simp-ite-cache-limit=1
+; COMMAND-LINE: --ite-simp --simp-ite-cache-limit=1 --simp-ite-tlimit=1
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun a () Bool)
+(declare-fun b () Bool)
+(assert (= x (ite a 1 (ite b 2 3))))
+(assert (= y (ite b 4 (ite a 5 6))))
+(assert (> (+ (ite a x y) (ite b y x)) 9))
+(assert (not (= (ite a 1 2) (ite b 1 2))))
+(check-sat)
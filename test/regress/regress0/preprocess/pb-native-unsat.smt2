@@ -0,0 +1,15 @@
+; COMMAND-LINE: --pb-native
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun p11 () Bool)
+(declare-fun p12 () Bool)
+(declare-fun p21 () Bool)
+(declare-fun p22 () Bool)
+(declare-fun p31 () Bool)
+(declare-fun p32 () Bool)
+(assert (>= (+ (ite p11 1 0) (ite p12 1 0)) 1))
+(assert (>= (+ (ite p21 1 0) (ite p22 1 0)) 1))
+(assert (>= (+ (ite p31 1 0) (ite p32 1 0)) 1))
+(assert (<= (+ (ite p11 1 0) (ite p21 1 0) (ite p31 1 0)) 1))
+(assert (< (+ (ite p12 1 0) (ite p22 1 0) (ite p32 1 0)) 2))
+(check-sat)
@@ -0,0 +1,15 @@
+; COMMAND-LINE: --pb-native
+; EXPECT: sat
+(set-logic QF_LIA)
+(declare-fun a () Bool)
+(declare-fun b () Bool)
+(declare-fun c () Bool)
+(declare-fun d () Bool)
+(declare-fun e () Bool)
+(declare-fun x () Int)
+(assert (<= (+ (ite a 1 0) (ite b 1 0) (ite c 1 0) (ite d 1 0) (ite e 1 0)) 2))
+(assert (>= (+ (* 3 (ite a 1 0)) (* 2 (ite b 1 0)) (ite c 1 0) (* 2 (ite d 1 0)) (ite e 1 0)) 4))
+(assert (= (+ (ite a 1 0) (ite (not c) 1 0) (ite e 2 0)) 2))
+(assert (=> b (> x 3)))
+(assert (< x (+ (ite d 5 0) 2)))
+(check-sat)
@@ -0,0 +1,36 @@
+; COMMAND-LINE: --incremental --preprocess-cache=8 --ite-simp --produce-models
+; EXPECT: sat
+; EXPECT: ((x 5) (y 4))
+; EXPECT: sat
+; EXPECT: ((x 5) (y 4))
+; EXPECT: unsat
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun b () Bool)
+(assert (= x (+ y 1)))
+(assert (> (ite b y (+ y 1)) 3))
+(assert (< y 5))
+(assert (not b))
+(assert (> y 3))
+(check-sat)
+(get-value (x y))
+(reset-assertions)
+(assert (= x (+ y 1)))
+(assert (> (ite b y (+ y 1)) 3))
+(assert (< y 5))
+(assert (not b))
+(assert (> y 3))
+(check-sat)
+(get-value (x y))
+(reset-assertions)
+(assert (= x (+ y 1)))
+(assert (> x 6))
+(assert (< y 5))
+(check-sat)
+(reset-assertions)
+(assert (= x (+ y 1)))
+(assert (> x 6))
+(assert (< y 5))
+(check-sat)
@@ -0,0 +1,10 @@
+; COMMAND-LINE: --preprocess-profile --ite-simp
+; EXPECT: sat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun b () Bool)
+(assert (= x (+ y 1)))
+(assert (> (ite b y (+ y 1)) 3))
+(assert (< y 5))
+(check-sat)
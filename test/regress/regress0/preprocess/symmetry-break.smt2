@@ -0,0 +1,13 @@
+; COMMAND-LINE: --symmetry-break-pp
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x1 () (_ BitVec 2))
+(declare-fun x2 () (_ BitVec 2))
+(declare-fun x3 () (_ BitVec 2))
+(declare-fun x4 () (_ BitVec 2))
+(assert (bvult x1 #b11))
+(assert (bvult x2 #b11))
+(assert (bvult x3 #b11))
+(assert (bvult x4 #b11))
+(assert (distinct x1 x2 x3 x4))
+(check-sat)
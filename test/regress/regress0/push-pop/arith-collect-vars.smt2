@@ -0,0 +1,32 @@
+; COMMAND-LINE: --incremental --arith-collect-vars
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_LRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(assert (>= x 0))
+(push 1)
+(assert (>= (+ x y) 5))
+(assert (<= y 1))
+(assert (< x 2))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (>= (+ x y) 5))
+(assert (<= y 1))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= (+ x z) y))
+(assert (< y 0))
+(assert (>= z 0))
+(check-sat)
+(pop 1)
+(check-sat)
+(assert (< (+ x y) 0))
+(assert (>= y 0))
+(check-sat)
@@ -0,0 +1,20 @@
+; REQUIRES: cadical-propagator
+; COMMAND-LINE: --incremental --sat-solver=cadical
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (or (= (f x) 1) (= (f y) 2)))
+(assert (> x 0))
+(check-sat)
+(push 1)
+(assert (= x y))
+(assert (< (f x) 2))
+(assert (not (= (f x) 1)))
+(check-sat)
+(pop 1)
+(assert (< (f x) 2))
+(check-sat)
@@ -0,0 +1,24 @@
+; COMMAND-LINE: --incremental --persistent-term-skolems
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun b () Bool)
+(push 1)
+(assert (> (ite b x y) 3))
+(check-sat)
+(assert (< x 3))
+(assert (< y 3))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (> (ite b x y) 3))
+(assert (< x 3))
+(check-sat)
+(assert (not b))
+(assert (< y 3))
+(check-sat)
+(pop 1)
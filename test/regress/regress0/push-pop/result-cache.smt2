@@ -0,0 +1,27 @@
+; COMMAND-LINE: --incremental --result-cache
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun g (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(push)
+(assert (> (f x) (+ x 1)))
+(check-sat)
+(assert (< (f x) x))
+(check-sat)
+(pop)
+(push)
+; the same assertions, up to renaming
+(assert (> (g y) (+ y 1)))
+(check-sat)
+(assert (< (g y) y))
+(check-sat)
+(pop)
+(check-sat-assuming ((> y 3) (< y 2)))
+(check-sat-assuming ((> x 3) (< x 5)))
@@ -0,0 +1,28 @@
+; COMMAND-LINE: --incremental --simp-incremental-propagation
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun a () Bool)
+(declare-fun b () Bool)
+(assert (or a (= x 3)))
+(assert (=> b (> y x)))
+(check-sat)
+(push 1)
+(assert (not a))
+(assert b)
+(check-sat)
+(assert (< y 4))
+(check-sat)
+(pop 1)
+(assert (< y 4))
+(check-sat)
+(push 1)
+(assert (not a))
+(assert b)
+(check-sat)
+(pop 1)
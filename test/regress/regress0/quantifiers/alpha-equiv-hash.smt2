@@ -0,0 +1,14 @@
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U U) U)
+(declare-fun p (U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(assert (forall ((x U) (y U)) (= (f x y) (f y x))))
+(assert (forall ((u U) (v U)) (= (f v u) (f u v))))
+(assert (forall ((x U)) (p (f x a))))
+(assert (forall ((z U)) (p (f z a))))
+(assert (forall ((z U)) (p (f z b))))
+(assert (not (p (f a a))))
+(check-sat)
@@ -0,0 +1,15 @@
+; COMMAND-LINE: --ematch-code-tree
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U U) U)
+(declare-fun P (U) Bool)
+(declare-fun Q (U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(assert (forall ((x U) (y U)) (P (f x y))))
+(assert (forall ((x U)) (=> (P (f x x)) (Q x))))
+(assert (forall ((y U)) (not (= (f a y) b))))
+(assert (or (= b (f a a)) (not (Q b))))
+(assert (= (f b b) b))
+(check-sat)
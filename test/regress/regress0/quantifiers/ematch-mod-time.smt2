@@ -0,0 +1,21 @@
+; COMMAND-LINE: --incremental --ematch-code-tree --term-db-incremental
+; EXPECT: unsat
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun g (U U) U)
+(declare-fun P (U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(assert (forall ((x U)) (P (f x))))
+(assert (forall ((x U)) (=> (P (g x a)) (= (f x) c))))
+(push 1)
+(assert (P (g b a)))
+(assert (not (P c)))
+(check-sat)
+(pop 1)
+(assert (= (f b) c))
+(assert (not (P c)))
+(check-sat)
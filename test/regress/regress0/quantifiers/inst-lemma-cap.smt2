@@ -0,0 +1,15 @@
+; COMMAND-LINE: --inst-lemma-cap=1
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun P (U) Bool)
+(declare-fun Q (U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(assert (forall ((x U)) (or (P x) (Q (f x)))))
+(assert (forall ((x U)) (=> (Q x) (P x))))
+(assert (forall ((x U)) (not (P (f x)))))
+(assert (not (P a)))
+(assert (not (P b)))
+(check-sat)
@@ -0,0 +1,16 @@
+; COMMAND-LINE: --inst-trie-flat
+; COMMAND-LINE: --inst-trie-flat --track-inst-lemmas
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U U) U)
+(declare-fun P (U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(assert (forall ((x U) (y U)) (=> (P x) (P (f x y)))))
+(assert (P a))
+(assert (= b (f a c)))
+(assert (= c (f b a)))
+(assert (not (P (f c b))))
+(check-sat)
@@ -0,0 +1,18 @@
+; COMMAND-LINE: --quant-rank-top-k=1
+; EXPECT: unsat
+(set-logic UFLIA)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun g (U) U)
+(declare-fun h (U) U)
+(declare-fun P (U) Bool)
+(declare-fun Q (U) Bool)
+(declare-fun R (U) Bool)
+(declare-fun a () U)
+(assert (forall ((x U)) (= (g (g x)) x)))
+(assert (forall ((x U)) (=> (R x) (R (h x)))))
+(assert (forall ((x U)) (=> (Q x) (Q (g x)))))
+(assert (forall ((x U)) (=> (P x) (P (f x)))))
+(assert (P a))
+(assert (not (P (f (f a)))))
+(check-sat)
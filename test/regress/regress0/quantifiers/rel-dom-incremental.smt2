@@ -0,0 +1,20 @@
+; COMMAND-LINE: --incremental --full-saturate-quant --no-e-matching
+; EXPECT: unsat
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun P (U U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(assert (forall ((x U) (y U)) (=> (P x y) (P y x))))
+(push 1)
+(assert (P a b))
+(assert (not (P b a)))
+(check-sat)
+(pop 1)
+(assert (P a a))
+(push 1)
+(assert (P b a))
+(assert (not (P a b)))
+(check-sat)
+(pop 1)
@@ -0,0 +1,13 @@
+; COMMAND-LINE: --term-db-incremental
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun P (U) Bool)
+(assert (forall ((x U)) (=> (P x) (P (f x)))))
+(assert (P a))
+(assert (or (= b a) (= b (f a))))
+(assert (not (P (f (f (f b))))))
+(check-sat)
@@ -0,0 +1,17 @@
+; COMMAND-LINE: --relevancy --check-models --incremental
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_UFLIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(declare-fun f (Int) Int)
+(assert (or (and (> x 10) (< x 5)) (and (= (f x) y) (> y z)) (= x (+ y z))))
+(assert (or (> z 3) (and (< z 0) (> (f z) 7))))
+(assert (=> (> (f x) z) (or (< x y) (> x (+ y 1)))))
+(check-sat)
+(push 1)
+(assert (not (= x (+ y z))))
+(assert (<= (f x) z))
+(check-sat)
+(pop 1)
@@ -0,0 +1,11 @@
+; COMMAND-LINE: --rewrite-cache-budget=2
+; EXPECT: unsat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (= (f (+ x 1)) (+ (f y) 2)))
+(assert (= y (+ 1 x)))
+(assert (or (> (+ x y) 3) (= (f (+ 1 x)) (+ 2 (f y)))))
+(assert (not (= (+ (f y) 2 0) (f (+ x 1)))))
+(check-sat)
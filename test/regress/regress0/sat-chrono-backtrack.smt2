@@ -0,0 +1,15 @@
+; COMMAND-LINE: --sat-chrono-backtrack=1
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x0 () Int)
+(declare-fun x1 () Int)
+(declare-fun x2 () Int)
+(declare-fun x3 () Int)
+(declare-fun x4 () Int)
+(assert (and (<= 1 x0) (<= x0 4)))
+(assert (and (<= 1 x1) (<= x1 4)))
+(assert (and (<= 1 x2) (<= x2 4)))
+(assert (and (<= 1 x3) (<= x3 4)))
+(assert (and (<= 1 x4) (<= x4 4)))
+(assert (distinct x0 x1 x2 x3 x4))
+(check-sat)
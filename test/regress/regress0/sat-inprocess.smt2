@@ -0,0 +1,116 @@
+; COMMAND-LINE: --sat-inprocess --sat-inprocess-interval=1
+; COMMAND-LINE: --sat-lbd-reduce --sat-restart=glucose
+; EXPECT: unsat
+(set-logic QF_UF)
+(declare-fun p0h0 () Bool)
+(declare-fun p0h1 () Bool)
+(declare-fun p0h2 () Bool)
+(declare-fun p0h3 () Bool)
+(declare-fun p0h4 () Bool)
+(declare-fun p1h0 () Bool)
+(declare-fun p1h1 () Bool)
+(declare-fun p1h2 () Bool)
+(declare-fun p1h3 () Bool)
+(declare-fun p1h4 () Bool)
+(declare-fun p2h0 () Bool)
+(declare-fun p2h1 () Bool)
+(declare-fun p2h2 () Bool)
+(declare-fun p2h3 () Bool)
+(declare-fun p2h4 () Bool)
+(declare-fun p3h0 () Bool)
+(declare-fun p3h1 () Bool)
+(declare-fun p3h2 () Bool)
+(declare-fun p3h3 () Bool)
+(declare-fun p3h4 () Bool)
+(declare-fun p4h0 () Bool)
+(declare-fun p4h1 () Bool)
+(declare-fun p4h2 () Bool)
+(declare-fun p4h3 () Bool)
+(declare-fun p4h4 () Bool)
+(declare-fun p5h0 () Bool)
+(declare-fun p5h1 () Bool)
+(declare-fun p5h2 () Bool)
+(declare-fun p5h3 () Bool)
+(declare-fun p5h4 () Bool)
+(assert (or p0h0 p0h1 p0h2 p0h3 p0h4))
+(assert (or p1h0 p1h1 p1h2 p1h3 p1h4))
+(assert (or p2h0 p2h1 p2h2 p2h3 p2h4))
+(assert (or p3h0 p3h1 p3h2 p3h3 p3h4))
+(assert (or p4h0 p4h1 p4h2 p4h3 p4h4))
+(assert (or p5h0 p5h1 p5h2 p5h3 p5h4))
+(assert (not (and p0h0 p1h0)))
+(assert (not (and p0h0 p2h0)))
+(assert (not (and p0h0 p3h0)))
+(assert (not (and p0h0 p4h0)))
+(assert (not (and p0h0 p5h0)))
+(assert (not (and p1h0 p2h0)))
+(assert (not (and p1h0 p3h0)))
+(assert (not (and p1h0 p4h0)))
+(assert (not (and p1h0 p5h0)))
+(assert (not (and p2h0 p3h0)))
+(assert (not (and p2h0 p4h0)))
+(assert (not (and p2h0 p5h0)))
+(assert (not (and p3h0 p4h0)))
+(assert (not (and p3h0 p5h0)))
+(assert (not (and p4h0 p5h0)))
+(assert (not (and p0h1 p1h1)))
+(assert (not (and p0h1 p2h1)))
+(assert (not (and p0h1 p3h1)))
+(assert (not (and p0h1 p4h1)))
+(assert (not (and p0h1 p5h1)))
+(assert (not (and p1h1 p2h1)))
+(assert (not (and p1h1 p3h1)))
+(assert (not (and p1h1 p4h1)))
+(assert (not (and p1h1 p5h1)))
+(assert (not (and p2h1 p3h1)))
+(assert (not (and p2h1 p4h1)))
+(assert (not (and p2h1 p5h1)))
+(assert (not (and p3h1 p4h1)))
+(assert (not (and p3h1 p5h1)))
+(assert (not (and p4h1 p5h1)))
+(assert (not (and p0h2 p1h2)))
+(assert (not (and p0h2 p2h2)))
+(assert (not (and p0h2 p3h2)))
+(assert (not (and p0h2 p4h2)))
+(assert (not (and p0h2 p5h2)))
+(assert (not (and p1h2 p2h2)))
+(assert (not (and p1h2 p3h2)))
+(assert (not (and p1h2 p4h2)))
+(assert (not (and p1h2 p5h2)))
+(assert (not (and p2h2 p3h2)))
+(assert (not (and p2h2 p4h2)))
+(assert (not (and p2h2 p5h2)))
+(assert (not (and p3h2 p4h2)))
+(assert (not (and p3h2 p5h2)))
+(assert (not (and p4h2 p5h2)))
+(assert (not (and p0h3 p1h3)))
+(assert (not (and p0h3 p2h3)))
+(assert (not (and p0h3 p3h3)))
+(assert (not (and p0h3 p4h3)))
+(assert (not (and p0h3 p5h3)))
+(assert (not (and p1h3 p2h3)))
+(assert (not (and p1h3 p3h3)))
+(assert (not (and p1h3 p4h3)))
+(assert (not (and p1h3 p5h3)))
+(assert (not (and p2h3 p3h3)))
+(assert (not (and p2h3 p4h3)))
+(assert (not (and p2h3 p5h3)))
+(assert (not (and p3h3 p4h3)))
+(assert (not (and p3h3 p5h3)))
+(assert (not (and p4h3 p5h3)))
+(assert (not (and p0h4 p1h4)))
+(assert (not (and p0h4 p2h4)))
+(assert (not (and p0h4 p3h4)))
+(assert (not (and p0h4 p4h4)))
+(assert (not (and p0h4 p5h4)))
+(assert (not (and p1h4 p2h4)))
+(assert (not (and p1h4 p3h4)))
+(assert (not (and p1h4 p4h4)))
+(assert (not (and p1h4 p5h4)))
+(assert (not (and p2h4 p3h4)))
+(assert (not (and p2h4 p4h4)))
+(assert (not (and p2h4 p5h4)))
+(assert (not (and p3h4 p4h4)))
+(assert (not (and p3h4 p5h4)))
+(assert (not (and p4h4 p5h4)))
+(check-sat)
@@ -0,0 +1,16 @@
+; COMMAND-LINE: --incremental --produce-models --block-models=values --block-models-sat
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_UF)
+(declare-fun a () Bool)
+(declare-fun b () Bool)
+(declare-fun c () Bool)
+(assert (or a b))
+(assert (or (not a) c))
+(assert (or (not b) (not c)))
+(check-sat)
+(block-model)
+(check-sat)
+(block-model)
+(check-sat)
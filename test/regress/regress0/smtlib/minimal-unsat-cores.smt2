@@ -0,0 +1,17 @@
+; COMMAND-LINE: --minimal-unsat-cores
+; EXPECT: unsat
+; EXPECT: (
+; EXPECT: ab
+; EXPECT: c
+; EXPECT: )
+; SCRUBBER: sed -e 's/^[ab]$/ab/'
+(set-option :produce-unsat-cores true)
+(set-logic QF_LIA)
+(declare-const x Int)
+(declare-const y Int)
+(assert (! (> x 2) :named a))
+(assert (! (> x 1) :named b))
+(assert (! (< x 0) :named c))
+(assert (! (> y 0) :named d))
+(check-sat)
+(get-unsat-core)
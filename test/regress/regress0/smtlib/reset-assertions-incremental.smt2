@@ -0,0 +1,28 @@
+; COMMAND-LINE: --incremental
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun p () Bool)
+(assert (and (> x 2) (< (f x) 0) (= (f x) x)))
+(check-sat)
+(reset-assertions)
+(assert (= (f x) x))
+(check-sat)
+(push 1)
+(assert (not (= (f x) x)))
+(check-sat)
+(reset-assertions)
+(assert (or p (> x 0)))
+(check-sat)
+(assert (not p))
+(assert (< x 0))
+(check-sat)
+(reset-assertions)
+(assert (not p))
+(check-sat)
@@ -0,0 +1,12 @@
+; COMMAND-LINE: --stream-assertions
+; COMMAND-LINE: --stream-assertions --check-models
+; EXPECT: sat
+(set-logic QF_UFLIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun f (Int) Int)
+(define-fun g ((z Int)) Int (+ (f z) 1))
+(assert (> (g x) (+ y 2)))
+(assert (= (div x 2) 3))
+(assert (< (* 2 y) (f x)))
+(check-sat)
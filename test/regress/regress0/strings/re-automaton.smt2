@@ -0,0 +1,12 @@
+; COMMAND-LINE: --strings-exp --no-re-elim
+(set-info :status unsat)
+(set-logic ALL)
+(declare-const x String)
+(declare-const y String)
+
+(assert (str.in.re "abaabbaaabbbaaaabbbbab" (re.* (re.union (re.+ (str.to.re "a")) (re.* (str.to.re "b")) (str.to.re "ab")))))
+
+(assert (str.in.re x (re.+ (re.union (re.range "a" "c") (str.to.re "ed")))))
+(assert (not (str.in.re x (re.* (re.union (re.range "a" "e") (re.opt (str.to.re "d")))))))
+
+(check-sat)
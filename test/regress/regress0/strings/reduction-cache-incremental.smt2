@@ -0,0 +1,23 @@
+; COMMAND-LINE: --incremental --strings-exp
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_SLIA)
+(declare-fun x () String)
+(declare-fun y () String)
+(assert (= (str.len x) 5))
+(push 1)
+(assert (= (str.indexof x "ab" 0) 2))
+(assert (= y (str.replace x "ab" "c")))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= (str.indexof x "ab" 0) 4))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= (str.indexof x "ab" 0) 2))
+(assert (= y (str.replace x "ab" "c")))
+(assert (= (str.substr x 0 2) "cd"))
+(check-sat)
+(pop 1)
@@ -0,0 +1,11 @@
+; COMMAND-LINE: --solve-str-as-bv=8
+; EXPECT: sat
+(set-logic QF_SLIA)
+(declare-fun x () String)
+(declare-fun y () String)
+(declare-fun z () String)
+(assert (= (str.++ x "ab" y) (str.++ "c" z)))
+(assert (str.prefixof "ca" z))
+(assert (> (str.len y) 1))
+(assert (not (= x y)))
+(check-sat)
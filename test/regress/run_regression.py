@@ -230,9 +230,15 @@ def run_regression(unsat_cores, proofs, dump, use_skip_return_code, wrapper,
         # Do not use proofs/unsat-cores with .sy files
         unsat_cores = False
         proofs = False
+    elif benchmark_ext == '.cnf' or benchmark_ext == '.opb':
+        comment_char = 'c' if benchmark_ext == '.cnf' else '*'
+        # The clauses of SAT inputs have no proofs or unsat cores
+        unsat_cores = False
+        proofs = False
     else:
-        sys.exit('"{}" must be *.cvc or *.smt or *.smt2 or *.p or *.sy'.format(
-            benchmark_basename))
+        sys.exit(
+            '"{}" must be *.cvc or *.smt or *.smt2 or *.p or *.sy or *.cnf or '
+            '*.opb'.format(benchmark_basename))
 
     benchmark_lines = None
     with open(benchmark_path, 'r') as benchmark_file:
@@ -16,6 +16,11 @@
 
 #include <cxxtest/TestSuite.h>
 
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif /* _WIN32 */
+
 #include "api/cvc4cpp.h"
 #include "base/configuration.h"
 
@@ -71,6 +76,7 @@ class SolverBlack : public CxxTest::TestSuite
   void testMkString();
   void testMkTerm();
   void testMkTermFromOp();
+  void testMkTerms();
   void testMkTrue();
   void testMkTuple();
   void testMkUninterpretedConst();
@@ -99,6 +105,10 @@ class SolverBlack : public CxxTest::TestSuite
   void testCheckValid2();
   void testCheckValidAssuming1();
   void testCheckValidAssuming2();
+  void testCheckSatCancel();
+  void testFork();
+  void testCountModels();
+  void testGetStatistics();
 
   void testSetInfo();
   void testSetLogic();
@@ -614,6 +624,35 @@ void SolverBlack::testMkTerm()
   TS_ASSERT_THROWS(d_solver->mkTerm(DISTINCT, v6), CVC4ApiException&);
 }
 
+void SolverBlack::testMkTerms()
+{
+  Sort bv32 = d_solver->mkBitVectorSort(32);
+  Term a = d_solver->mkConst(bv32, "a");
+  Term b = d_solver->mkConst(bv32, "b");
+  // (bvadd a b), (= (bvadd a b) a), (not (= (bvadd a b) a))
+  std::vector<Term> terms;
+  TS_ASSERT_THROWS_NOTHING(
+      terms = d_solver->mkTerms({BITVECTOR_PLUS, EQUAL, NOT},
+                                {{0, 1}, {2, 0}, {3}},
+                                {a, b}));
+  TS_ASSERT_EQUALS(terms.size(), 3);
+  TS_ASSERT_EQUALS(terms[0], d_solver->mkTerm(BITVECTOR_PLUS, a, b));
+  TS_ASSERT_EQUALS(terms[1], d_solver->mkTerm(EQUAL, terms[0], a));
+  TS_ASSERT_EQUALS(terms[2], d_solver->mkTerm(NOT, terms[1]));
+  TS_ASSERT_THROWS_NOTHING(d_solver->assertFormulas({terms[2]}));
+
+  // a child that is not yet built
+  TS_ASSERT_THROWS(d_solver->mkTerms({BITVECTOR_PLUS}, {{0, 2}}, {a, b}),
+                   CVC4ApiException&);
+  // ill-typed terms
+  TS_ASSERT_THROWS(
+      d_solver->mkTerms({EQUAL, NOT}, {{0, 1}, {0}}, {a, b}),
+      CVC4ApiException&);
+  // not as many children as kinds
+  TS_ASSERT_THROWS(d_solver->mkTerms({NOT}, {}, {a}), CVC4ApiException&);
+  TS_ASSERT_THROWS(d_solver->assertFormulas({Term()}), CVC4ApiException&);
+}
+
 void SolverBlack::testMkTermFromOp()
 {
   Sort bv32 = d_solver->mkBitVectorSort(32);
@@ -1197,6 +1236,118 @@ void SolverBlack::testCheckValidAssuming2()
       CVC4ApiException&);
 }
 
+void SolverBlack::testCheckSatCancel()
+{
+  d_solver->setOption("incremental", "true");
+  // 4 pigeons do not fit in 3 holes, which takes conflicts to prove
+  Sort boolSort = d_solver->getBooleanSort();
+  std::vector<std::vector<Term>> p(4);
+  for (unsigned i = 0; i < 4; i++)
+  {
+    for (unsigned j = 0; j < 3; j++)
+    {
+      p[i].push_back(d_solver->mkConst(boolSort));
+    }
+    d_solver->assertFormula(d_solver->mkTerm(OR, p[i]));
+  }
+  for (unsigned j = 0; j < 3; j++)
+  {
+    for (unsigned i = 0; i < 4; i++)
+    {
+      for (unsigned k = i + 1; k < 4; k++)
+      {
+        d_solver->assertFormula(
+            d_solver->mkTerm(AND, p[i][j], p[k][j]).notTerm());
+      }
+    }
+  }
+  // the counts of the progress callback never decrease
+  uint64_t conflicts = 0;
+  bool monotonic = true;
+  d_solver->setProgressCallback(
+      [&conflicts, &monotonic](const Progress& q) {
+        monotonic = monotonic && q.d_conflicts >= conflicts;
+        conflicts = q.d_conflicts;
+      },
+      0);
+
+  d_solver->cancel();
+  Result r = d_solver->checkSatAsync().get();
+  TS_ASSERT(r.isSatUnknown());
+  // the cancellation ends with the cancelled check
+  TS_ASSERT(d_solver->checkSatAsync().get().isUnsat());
+  TS_ASSERT(d_solver->checkSat().isUnsat());
+  TS_ASSERT(monotonic);
+  d_solver->setProgressCallback(std::function<void(const Progress&)>(), 0);
+}
+
+void SolverBlack::testFork()
+{
+#ifndef _WIN32
+  Sort intSort = d_solver->getIntegerSort();
+  Term x = d_solver->mkConst(intSort, "x");
+  Term zero = d_solver->mkReal(0);
+  d_solver->assertFormula(d_solver->mkTerm(GT, x, zero));
+  int pid = d_solver->fork();
+  TS_ASSERT(pid >= 0);
+  if (pid == 0)
+  {
+    // the child continues with the assertions of the parent
+    d_solver->assertFormula(d_solver->mkTerm(LT, x, zero));
+    _exit(d_solver->checkSat().isUnsat() ? 0 : 1);
+  }
+  int status;
+  TS_ASSERT_EQUALS(waitpid(pid, &status, 0), pid);
+  TS_ASSERT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  TS_ASSERT(d_solver->checkSat().isSat());
+#endif /* _WIN32 */
+}
+
+void SolverBlack::testCountModels()
+{
+  d_solver->setOption("incremental", "true");
+  d_solver->setOption("produce-models", "true");
+  d_solver->setOption("model-count-threshold", "4");
+  Sort bvSort = d_solver->mkBitVectorSort(4);
+  Term x = d_solver->mkConst(bvSort, "x");
+  Term b = d_solver->mkConst(d_solver->getBooleanSort(), "b");
+  Term y = d_solver->mkConst(d_solver->getIntegerSort(), "y");
+  d_solver->assertFormula(
+      d_solver->mkTerm(BITVECTOR_UGT, x, d_solver->mkBitVector(4, 3)));
+  TS_ASSERT_EQUALS(d_solver->countModels({x}).toString(), "12");
+  TS_ASSERT_EQUALS(d_solver->countModels({x, b}).toString(), "24");
+  TS_ASSERT_EQUALS(d_solver->countModels({b}).toString(), "2");
+  int estimate = std::stoi(d_solver->countModels({x, b}, true).toString());
+  TS_ASSERT(estimate > 0 && estimate <= 96);
+  TS_ASSERT_THROWS(d_solver->countModels({y}), CVC4ApiException&);
+  // the counting does not change the assertions
+  TS_ASSERT(d_solver->checkSat().isSat());
+}
+
+void SolverBlack::testGetStatistics()
+{
+#ifdef CVC4_STATISTICS_ON
+  d_solver->setOption("incremental", "true");
+  Term x = d_solver->mkConst(d_solver->getIntegerSort(), "x");
+  d_solver->assertFormula(d_solver->mkTerm(GT, x, d_solver->mkReal(0)));
+  d_solver->checkSat();
+  std::map<std::string, std::string> before = d_solver->getStatistics();
+  std::string used = "smt::SmtEngine::resourceUnitsUsed";
+  TS_ASSERT(before.find(used) != before.end());
+  d_solver->assertFormula(d_solver->mkTerm(LT, x, d_solver->mkReal(5)));
+  d_solver->checkSat();
+  std::map<std::string, std::string> after = d_solver->getStatistics();
+  std::map<std::string, std::string> query =
+      d_solver->getStatisticsSince(before);
+  TS_ASSERT(query.find(used) != query.end());
+  TS_ASSERT(std::stoll(query[used]) > 0);
+  TS_ASSERT_EQUALS(std::stoll(query[used]),
+                   std::stoll(after[used]) - std::stoll(before[used]));
+  // the statistics that did not change are omitted
+  TS_ASSERT(d_solver->getStatisticsSince(after).size() < after.size());
+#endif /* CVC4_STATISTICS_ON */
+}
+
 void SolverBlack::testSetLogic()
 {
   TS_ASSERT_THROWS_NOTHING(d_solver->setLogic("AUFLIRA"));
@@ -0,0 +1,110 @@
+/*********************                                                        */
+/*! \file cdtrail_hashmap_black.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of CVC4::context::CDTrailHashMap<>.
+ **
+ ** Black box testing of CVC4::context::CDTrailHashMap<>.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include <map>
+
+#include "context/cdtrail_hashmap.h"
+#include "context/context.h"
+
+using CVC4::context::Context;
+using CVC4::context::CDTrailHashMap;
+
+class CDTrailHashMapBlack : public CxxTest::TestSuite
+{
+  Context* d_context;
+
+ public:
+  void setUp() override { d_context = new Context; }
+
+  void tearDown() override { delete d_context; }
+
+  // Returns the elements in a CDTrailHashMap.
+  static std::map<int, int> GetElements(const CDTrailHashMap<int, int>& map)
+  {
+    return std::map<int, int>{map.begin(), map.end()};
+  }
+
+  // Returns true if the elements in map are the same as expected.
+  static bool ElementsAre(const CDTrailHashMap<int, int>& map,
+                          const std::map<int, int>& expected)
+  {
+    return GetElements(map) == expected;
+  }
+
+  void testSimpleSequence()
+  {
+    CDTrailHashMap<int, int> map(d_context);
+    TS_ASSERT(ElementsAre(map, {}));
+
+    TS_ASSERT(map.insert(3, 4));
+    TS_ASSERT(ElementsAre(map, {{3, 4}}));
+
+    {
+      d_context->push();
+      TS_ASSERT(ElementsAre(map, {{3, 4}}));
+
+      map.insert(5, 6);
+      map.insert(9, 8);
+      TS_ASSERT(ElementsAre(map, {{3, 4}, {5, 6}, {9, 8}}));
+
+      {
+        d_context->push();
+        map.insert(1, 2);
+        TS_ASSERT(!map.insert(3, 7));
+        TS_ASSERT(!map.insert(1, 45));
+        TS_ASSERT(ElementsAre(map, {{1, 45}, {3, 7}, {5, 6}, {9, 8}}));
+        TS_ASSERT_EQUALS(map[3], 7);
+        d_context->pop();
+      }
+
+      TS_ASSERT(ElementsAre(map, {{3, 4}, {5, 6}, {9, 8}}));
+      TS_ASSERT(!map.contains(1));
+      d_context->pop();
+    }
+
+    TS_ASSERT(ElementsAre(map, {{3, 4}}));
+    TS_ASSERT_EQUALS(map.size(), 1u);
+  }
+
+  void testGrowAndRestore()
+  {
+    CDTrailHashMap<int, int> map(d_context);
+    for (int i = 0; i < 100; i++)
+    {
+      map.insert(i, i);
+    }
+    {
+      d_context->push();
+      for (int i = 50; i < 1000; i++)
+      {
+        map.insert(i, -i);
+      }
+      TS_ASSERT_EQUALS(map.size(), 1000u);
+      TS_ASSERT_EQUALS(map[77], -77);
+      TS_ASSERT_EQUALS(map[999], -999);
+      d_context->pop();
+    }
+    TS_ASSERT_EQUALS(map.size(), 100u);
+    for (int i = 0; i < 100; i++)
+    {
+      TS_ASSERT_EQUALS(map[i], i);
+    }
+    TS_ASSERT(map.find(100) == map.end());
+    TS_ASSERT(!map.contains(500));
+  }
+};
@@ -34,6 +34,19 @@ using namespace CVC4::kind;
 using namespace CVC4::smt;
 using namespace std;
 
+struct DenseNodeAttributeId {};
+
+namespace CVC4 {
+namespace expr {
+namespace attr {
+template <>
+struct IsDenseAttribute<DenseNodeAttributeId> : std::true_type
+{
+};
+}  // namespace attr
+}  // namespace expr
+}  // namespace CVC4
+
 class AttributeBlack : public CxxTest::TestSuite {
 private:
 
@@ -135,4 +148,27 @@ private:
     delete node;
   }
 
+  typedef expr::Attribute<DenseNodeAttributeId, Node> DenseNodeAttribute;
+  void testDenseNodes(){
+    TypeNode booleanType = d_nodeManager->booleanType();
+    Node a = d_nodeManager->mkSkolem("a", booleanType);
+    Node b = d_nodeManager->mkSkolem("b", booleanType);
+    Node c = d_nodeManager->mkNode(kind::AND, a, b);
+    Node data;
+
+    DenseNodeAttribute attr;
+    TS_ASSERT(DenseNodeAttribute::dense);
+    TS_ASSERT(!a.hasAttribute(attr));
+    TS_ASSERT(!a.getAttribute(attr, data));
+    a.setAttribute(attr, c);
+    b.setAttribute(attr, a);
+    TS_ASSERT(a.hasAttribute(attr));
+    TS_ASSERT(a.getAttribute(attr, data));
+    TS_ASSERT_EQUALS(data, c);
+    TS_ASSERT_EQUALS(b.getAttribute(attr), a);
+    TS_ASSERT(!c.hasAttribute(attr));
+    b.setAttribute(attr, c);
+    TS_ASSERT_EQUALS(b.getAttribute(attr), c);
+  }
+
 };
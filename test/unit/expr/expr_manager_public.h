@@ -21,7 +21,9 @@
 
 #include "expr/expr_manager.h"
 #include "expr/expr.h"
+#include "expr/variable_type_map.h"
 #include "base/exception.h"
+#include "util/rational.h"
 
 using namespace CVC4;
 using namespace CVC4::kind;
@@ -128,4 +130,28 @@ private:
                      IllegalArgumentException&);
   }
 
+  void testExportCache()
+  {
+    ExprManager* em = new ExprManager;
+    {
+      ExprManagerMapCollection vmap;
+      std::vector<Expr> vars = mkVars(d_exprManager->integerType(), 2);
+      Expr sum = d_exprManager->mkExpr(PLUS, vars[0], vars[1]);
+      Expr zero = d_exprManager->mkConst(Rational(0));
+      Expr gt = d_exprManager->mkExpr(GT, sum, zero);
+      Expr lt = d_exprManager->mkExpr(LT, sum, zero);
+
+      Expr egt = gt.exportTo(em, vmap);
+      TS_ASSERT(egt.getExprManager() == em);
+      TS_ASSERT(vmap.d_exportCache.find(sum) != vmap.d_exportCache.end());
+      // exporting again and exporting back reuses the earlier translations
+      TS_ASSERT_EQUALS(gt.exportTo(em, vmap), egt);
+      TS_ASSERT_EQUALS(egt.exportTo(d_exprManager, vmap), gt);
+      // the shared subexpression is exported to the same expression
+      Expr elt = lt.exportTo(em, vmap);
+      TS_ASSERT_EQUALS(elt[0], egt[0]);
+    }
+    delete em;
+  }
+
 };
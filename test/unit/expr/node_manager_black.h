@@ -297,6 +297,35 @@ class NodeManagerBlack : public CxxTest::TestSuite {
 
   }
 
+  void testArenaArities()
+  {
+    TypeNode boolType = d_nodeManager->booleanType();
+    std::vector<Node> vars;
+    for (unsigned i = 0; i < 20; ++i)
+    {
+      vars.push_back(d_nodeManager->mkSkolem("b", boolType));
+    }
+    for (unsigned n = 2; n <= vars.size(); ++n)
+    {
+      std::vector<Node> children(vars.begin(), vars.begin() + n);
+      Node a1 = d_nodeManager->mkNode(AND, children);
+      // a NodeBuilder that outgrows its inline storage
+      NodeBuilder<2> nb(AND);
+      for (const Node& c : children)
+      {
+        nb << c;
+      }
+      Node a2 = nb;
+      TS_ASSERT_EQUALS(a1, a2);
+      TS_ASSERT_EQUALS(a2.getNumChildren(), n);
+      TS_ASSERT_EQUALS(a2[n - 1], vars[n - 1]);
+    }
+    // cells freed by the garbage collector are reused
+    d_nodeManager->reclaimZombiesUntil(0);
+    Node o = d_nodeManager->mkNode(OR, vars[0], vars[1]);
+    TS_ASSERT_EQUALS(o, d_nodeManager->mkNode(OR, vars[0], vars[1]));
+  }
+
   /* This test is only valid if assertions are enabled. */
   void testMkNodeTooFew() {
 #ifdef CVC4_ASSERTIONS
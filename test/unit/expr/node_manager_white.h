@@ -91,4 +91,23 @@ class NodeManagerWhite : public CxxTest::TestSuite {
       TS_ASSERT_EQUALS(NodeManager::TopologicalSort(roots), result);
     }
   }
+
+  void testPinNode()
+  {
+    Node t = d_nm->mkConst(true);
+    uint32_t rc = t.d_nv->getRefCount();
+    {
+      Node u = t;
+      TS_ASSERT_EQUALS(t.d_nv->getRefCount(), rc);
+    }
+    TS_ASSERT_EQUALS(t.d_nv->getRefCount(), rc);
+
+    TypeNode boolType = d_nm->booleanType();
+    Node x = d_nm->mkSkolem("x", boolType);
+    Node n = d_nm->mkNode(kind::NOT, x);
+    d_nm->pinNode(n);
+    TS_ASSERT(n.d_nv->HasMaximizedReferenceCount());
+    Node m = n;
+    TS_ASSERT(m.d_nv->HasMaximizedReferenceCount());
+  }
 };
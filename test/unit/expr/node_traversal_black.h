@@ -0,0 +1,91 @@
+/*********************                                                        */
+/*! \file node_traversal_black.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of the traversals in node_traversal.{h,cpp}
+ **
+ ** Black box testing of node_traversal.{h,cpp}
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "expr/node_manager.h"
+#include "expr/node_traversal.h"
+
+using namespace CVC4;
+using namespace CVC4::expr;
+using namespace CVC4::kind;
+
+class NodeTraversalBlack : public CxxTest::TestSuite
+{
+ private:
+  NodeManager* d_nodeManager;
+  NodeManagerScope* d_scope;
+
+ public:
+  void setUp() override
+  {
+    d_nodeManager = new NodeManager(NULL);
+    d_scope = new NodeManagerScope(d_nodeManager);
+  }
+
+  void tearDown() override
+  {
+    delete d_scope;
+    delete d_nodeManager;
+  }
+
+  // each subterm of (x + y) * (x + y) is visited once, and the children of a
+  // node are processed before the node in post-order
+  void testVisitOnce()
+  {
+    Node x = d_nodeManager->mkSkolem("x", d_nodeManager->integerType());
+    Node y = d_nodeManager->mkSkolem("y", d_nodeManager->integerType());
+    Node s = d_nodeManager->mkNode(PLUS, x, y);
+    Node n = d_nodeManager->mkNode(MULT, s, s);
+    std::vector<TNode> pre;
+    std::vector<TNode> post;
+    TS_ASSERT(traverseDagPost(n,
+                              [&pre](TNode cur) {
+                                pre.push_back(cur);
+                                return VisitAction::CONTINUE;
+                              },
+                              [&post](TNode cur) { post.push_back(cur); }));
+    TS_ASSERT_EQUALS(pre.size(), 4);
+    TS_ASSERT_EQUALS(post.size(), 4);
+    TS_ASSERT_EQUALS(post.back(), n);
+    TS_ASSERT(std::find(post.begin(), post.end(), s)
+              > std::find(post.begin(), post.end(), x));
+  }
+
+  // the traversal is aborted, and nested traversals are independent
+  void testAbortAndNest()
+  {
+    Node x = d_nodeManager->mkSkolem("x", d_nodeManager->booleanType());
+    Node nx = d_nodeManager->mkNode(NOT, x);
+    Node n = d_nodeManager->mkNode(AND, nx, x);
+    unsigned count = 0;
+    TS_ASSERT(!traverseDag(n, [&x](TNode cur) {
+      return cur == x ? VisitAction::ABORT : VisitAction::CONTINUE;
+    }));
+    TS_ASSERT(traverseDag(n, [&count, &nx](TNode) {
+      // the nested traversal visits its own subterms
+      traverseDag(nx, [&count](TNode) {
+        count++;
+        return VisitAction::CONTINUE;
+      });
+      return VisitAction::SKIP_CHILDREN;
+    }));
+    TS_ASSERT_EQUALS(count, 2);
+  }
+};
@@ -0,0 +1,93 @@
+/*********************                                                        */
+/*! \file node_trie_black.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of the flat trie of node_trie.{h,cpp}
+ **
+ ** Black box testing of NodeTemplateFlatTrie.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include <vector>
+
+#include "expr/node_manager.h"
+#include "expr/node_trie.h"
+
+using namespace CVC4;
+using namespace CVC4::kind;
+using namespace CVC4::theory;
+
+class NodeTrieBlack : public CxxTest::TestSuite
+{
+ private:
+  NodeManager* d_nodeManager;
+  NodeManagerScope* d_scope;
+
+ public:
+  void setUp() override
+  {
+    d_nodeManager = new NodeManager(NULL);
+    d_scope = new NodeManagerScope(d_nodeManager);
+  }
+
+  void tearDown() override
+  {
+    delete d_scope;
+    delete d_nodeManager;
+  }
+
+  void testAddAndExists()
+  {
+    TypeNode intType = d_nodeManager->integerType();
+    TypeNode fType = d_nodeManager->mkFunctionType(intType, intType);
+    Node f = d_nodeManager->mkSkolem("f", fType);
+    std::vector<Node> vars;
+    std::vector<Node> terms;
+    for (unsigned i = 0; i < 100; ++i)
+    {
+      vars.push_back(d_nodeManager->mkSkolem("x", intType));
+      terms.push_back(d_nodeManager->mkNode(APPLY_UF, f, vars.back()));
+    }
+
+    NodeFlatTrie trie;
+    TS_ASSERT(trie.empty());
+    for (unsigned i = 0; i < 100; ++i)
+    {
+      std::vector<Node> reps = {f, vars[i / 2]};
+      // the terms of odd index are congruent to the previous ones
+      TS_ASSERT_EQUALS(trie.addTerm(terms[i], reps), i % 2 == 0);
+      TS_ASSERT_EQUALS(trie.existsTerm(reps), terms[i - i % 2]);
+    }
+    std::vector<Node> missing = {f, vars[99]};
+    TS_ASSERT(trie.existsTerm(missing).isNull());
+
+    // the children are iterated in their order of insertion
+    NodeFlatTrie::Index ft = trie.getChild(NodeFlatTrie::root(), f);
+    TS_ASSERT_DIFFERS(ft, 0u);
+    unsigned count = 0;
+    for (NodeFlatTrie::Index c = trie.getFirstChild(ft); c != 0;
+         c = trie.getNextSibling(c))
+    {
+      TS_ASSERT_EQUALS(trie.getKey(c), vars[count]);
+      TS_ASSERT(trie.hasData(c));
+      TS_ASSERT_EQUALS(trie.getData(c), terms[2 * count]);
+      ++count;
+    }
+    TS_ASSERT_EQUALS(count, 50u);
+
+    trie.clear();
+    TS_ASSERT(trie.empty());
+    std::vector<Node> reps = {f, vars[0]};
+    TS_ASSERT(trie.existsTerm(reps).isNull());
+    TS_ASSERT(trie.addTerm(terms[1], reps));
+    TS_ASSERT_EQUALS(trie.existsTerm(reps), terms[1]);
+  }
+};
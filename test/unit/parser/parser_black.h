@@ -399,3 +399,83 @@ public:
 #endif /* ! CVC4_COMPETITION_MODE */
   }
 };/* class Smt2ParserTest */
+
+class BinaryParserTest : public CxxTest::TestSuite
+{
+ public:
+  void setUp() override
+  {
+    d_options.set(options::parseOnly, true);
+    d_solver.reset(new api::Solver(&d_options));
+  }
+
+  void tearDown() override { d_solver.reset(); }
+
+  /** Parse input with lang, printing the commands to out in outLang. */
+  void printCommands(const std::string& input,
+                     InputLanguage lang,
+                     std::ostream& out,
+                     OutputLanguage outLang)
+  {
+    Parser* parser = ParserBuilder(d_solver.get(), "test")
+                         .withStringInput(input)
+                         .withOptions(d_options)
+                         .withInputLanguage(lang)
+                         .build();
+    Command* cmd;
+    while ((cmd = parser->nextCommand()) != NULL)
+    {
+      cmd->toStream(out, -1, false, 0, outLang);
+      if (outLang != language::output::LANG_BINARY)
+      {
+        out << endl;
+      }
+      delete cmd;
+    }
+    TS_ASSERT(parser->done());
+    delete parser;
+  }
+
+  void testRoundTrip()
+  {
+    std::string input =
+        "(set-logic QF_AUFBV)\n"
+        "(declare-sort U 0)\n"
+        "(declare-fun f (U) (_ BitVec 8))\n"
+        "(declare-const x U)\n"
+        "(define-fun g ((y (_ BitVec 8))) (_ BitVec 8) (bvadd y #x01))\n"
+        "(assert (= ((_ extract 3 0) (g (f x))) #b0000))\n"
+        "(assert (= (g (f x)) (g (g (f x)))))\n"
+        "(push 1)\n"
+        "(check-sat)\n"
+        "(pop 1)\n"
+        "(exit)\n";
+    std::stringstream expected, binary, actual;
+    printCommands(input,
+                  LANG_SMTLIB_V2_6,
+                  expected,
+                  language::output::LANG_SMTLIB_V2_6);
+    printCommands(
+        input, LANG_SMTLIB_V2_6, binary, language::output::LANG_BINARY);
+    printCommands(binary.str(),
+                  LANG_BINARY,
+                  actual,
+                  language::output::LANG_SMTLIB_V2_6);
+    TS_ASSERT_EQUALS(expected.str(), actual.str());
+  }
+
+  void testBadBinaryInput()
+  {
+    Parser* parser = ParserBuilder(d_solver.get(), "test")
+                         .withStringInput("(assert true)")
+                         .withOptions(d_options)
+                         .withInputLanguage(LANG_BINARY)
+                         .build();
+    TS_ASSERT_THROWS(parser->nextCommand(), ParserException&);
+    delete parser;
+  }
+
+ private:
+  Options d_options;
+  std::unique_ptr<api::Solver> d_solver;
+}; /* class BinaryParserTest */
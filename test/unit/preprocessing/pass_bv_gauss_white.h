@@ -335,6 +335,42 @@ class TheoryBVGaussWhite : public CxxTest::TestSuite
     testGaussElimX(Integer(10), rhs, lhs, BVGauss::Result::INVALID);
     std::cout << "matrix 0, modulo 11" << std::endl;
     testGaussElimX(Integer(11), rhs, lhs, BVGauss::Result::UNIQUE);
+    std::cout << "matrix 0, modulo 4294967311" << std::endl;
+    testGaussElimX(
+        Integer("4294967311", 10), rhs, lhs, BVGauss::Result::UNIQUE);
+  }
+
+  void testGaussElimWide()
+  {
+    std::vector<Integer> rhs;
+    std::vector<std::vector<Integer>> lhs;
+
+    /* -------------------------------------------------------------------
+     *   lhs          rhs  modulo { 2, 3, 4294967311 }
+     *  --^--          ^
+     *  1 1 0 ... 0 0  1
+     *  0 1 1 ... 0 0  0
+     *  ...
+     *  0 0 0 ... 1 1  0
+     *  0 0 0 ... 0 1  1
+     *  (70 columns, i.e., more than one word per row modulo 2)
+     * ------------------------------------------------------------------- */
+    size_t n = 70;
+    lhs = std::vector<std::vector<Integer>>(
+        n, std::vector<Integer>(n, Integer(0)));
+    for (size_t i = 0; i < n; ++i)
+    {
+      lhs[i][i] = Integer(1);
+      if (i + 1 < n) lhs[i][i + 1] = Integer(1);
+      rhs.push_back(Integer(i % 3 == 0 ? 1 : 0));
+    }
+    std::cout << "wide matrix, modulo 2" << std::endl;
+    testGaussElimX(Integer(2), rhs, lhs, BVGauss::Result::UNIQUE);
+    std::cout << "wide matrix, modulo 3" << std::endl;
+    testGaussElimX(Integer(3), rhs, lhs, BVGauss::Result::UNIQUE);
+    std::cout << "wide matrix, modulo 4294967311" << std::endl;
+    testGaussElimX(
+        Integer("4294967311", 10), rhs, lhs, BVGauss::Result::UNIQUE);
   }
 
   void testGaussElimUniqueDone()
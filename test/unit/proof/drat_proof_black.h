@@ -17,6 +17,7 @@
 #include <cxxtest/TestSuite.h>
 
 #include <cctype>
+#include <sstream>
 
 #include "proof/drat/drat_proof.h"
 
@@ -36,6 +37,8 @@ class DratProofBlack : public CxxTest::TestSuite
   void testParseClauseOverflow();
 
   void testParseTwo();
+  void testParseTwoFromStream();
+  void testParseClauseOverflowFromStream();
 
   void testOutputTwoAsText();
   void testOutputTwoAsLfsc();
@@ -118,6 +121,36 @@ void DratProofBlack::testParseTwo()
                    SatLiteral(8190, true));
 }
 
+void DratProofBlack::testParseTwoFromStream()
+{
+  // d -63 -8193
+  // 129 -8191
+  std::istringstream input(
+      std::string("\x64\x7f\x83\x80\x01\x00\x61\x82\x02\xff\x7f\x00", 12));
+  DratProof proof = DratProof::fromBinary(input);
+
+  TS_ASSERT_EQUALS(proof.getInstructions().size(), 2);
+  TS_ASSERT_EQUALS(proof.getInstructions()[0].d_kind, DELETION);
+  TS_ASSERT_EQUALS(proof.getInstructions()[0].d_clause.size(), 2);
+  TS_ASSERT_EQUALS(proof.getInstructions()[0].d_clause[0],
+                   SatLiteral(62, true));
+  TS_ASSERT_EQUALS(proof.getInstructions()[0].d_clause[1],
+                   SatLiteral(8192, true));
+
+  TS_ASSERT_EQUALS(proof.getInstructions()[1].d_kind, ADDITION);
+  TS_ASSERT_EQUALS(proof.getInstructions()[1].d_clause.size(), 2);
+  TS_ASSERT_EQUALS(proof.getInstructions()[1].d_clause[0],
+                   SatLiteral(128, false));
+  TS_ASSERT_EQUALS(proof.getInstructions()[1].d_clause[1],
+                   SatLiteral(8190, true));
+}
+
+void DratProofBlack::testParseClauseOverflowFromStream()
+{
+  std::istringstream input(std::string("a\x80\x01", 3));
+  TS_ASSERT_THROWS(DratProof::fromBinary(input), InvalidDratProofException&);
+}
+
 void DratProofBlack::testOutputTwoAsText()
 {
   // d -63 -8193
@@ -121,6 +121,64 @@ class TheoryEvaluatorWhite : public CxxTest::TestSuite
                          args.begin(), args.end(), vals.begin(), vals.end())));
   }
 
+  void testBatch()
+  {
+    TypeNode bv8Type = d_nm->mkBitVectorType(8);
+    TypeNode bv64Type = d_nm->mkBitVectorType(64);
+
+    Node x = d_nm->mkVar("x", bv8Type);
+    Node y = d_nm->mkVar("y", bv8Type);
+    Node z = d_nm->mkVar("z", bv64Type);
+    Node b = d_nm->mkVar("b", d_nm->booleanType());
+
+    Node sum = d_nm->mkNode(kind::BITVECTOR_PLUS,
+                            d_nm->mkNode(kind::BITVECTOR_MULT, x, y),
+                            d_nm->mkNode(kind::BITVECTOR_ASHR, x, y));
+    Node yext = d_nm->mkNode(d_nm->mkConst(BitVectorZeroExtend(56)), y);
+    Node wide = d_nm->mkNode(
+        kind::BITVECTOR_XOR,
+        d_nm->mkNode(kind::BITVECTOR_LSHR, z, yext),
+        d_nm->mkNode(kind::BITVECTOR_CONCAT,
+                     bv::utils::mkExtract(z, 55, 0),
+                     d_nm->mkNode(kind::BITVECTOR_UREM, x, y)));
+    Node cond = d_nm->mkNode(
+        kind::AND,
+        d_nm->mkNode(kind::OR, b, d_nm->mkNode(kind::BITVECTOR_SLT, x, y)),
+        d_nm->mkNode(kind::BITVECTOR_UGE, sum, x));
+    Node t = d_nm->mkNode(kind::ITE,
+                          cond,
+                          wide,
+                          bv::utils::mkSignExtend(
+                              d_nm->mkNode(kind::BITVECTOR_SUB, sum, y), 56));
+
+    std::vector<Node> args = {x, y, z, b};
+    std::vector<std::vector<Node>> points;
+    uint64_t seed = 1;
+    for (unsigned i = 0; i < 100; i++)
+    {
+      seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+      std::vector<Node> pt = {
+          d_nm->mkConst(BitVector(8, (seed >> 56) & 0xff)),
+          d_nm->mkConst(BitVector(8, (unsigned int)(i % 9))),
+          d_nm->mkConst(BitVector(64, seed)),
+          d_nm->mkConst(i % 3 == 0)};
+      points.push_back(pt);
+    }
+
+    EvaluatorProgram prog(t, args);
+    TS_ASSERT(prog.isCompiled());
+    std::vector<Node> results;
+    prog.eval(points, results);
+    TS_ASSERT_EQUALS(results.size(), points.size());
+    for (unsigned i = 0, npoints = points.size(); i < npoints; i++)
+    {
+      TS_ASSERT_EQUALS(
+          results[i],
+          Rewriter::rewrite(t.substitute(
+              args.begin(), args.end(), points[i].begin(), points[i].end())));
+    }
+  }
+
   void testStrIdOf()
   {
     Node a = d_nm->mkConst(String("A"));
@@ -0,0 +1,90 @@
+/*********************                                                        */
+/*! \file substitutions_black.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of CVC4::theory::SubstitutionMap.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include <memory>
+
+#include "context/context.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "theory/substitutions.h"
+#include "util/rational.h"
+
+using namespace CVC4;
+using namespace CVC4::context;
+using namespace CVC4::kind;
+using namespace CVC4::theory;
+
+class SubstitutionsBlack : public CxxTest::TestSuite
+{
+ public:
+  void setUp() override
+  {
+    d_nm.reset(new NodeManager(nullptr));
+    d_scope.reset(new NodeManagerScope(d_nm.get()));
+    d_context.reset(new Context());
+  }
+
+  void tearDown() override
+  {
+    d_context.reset();
+    d_scope.reset();
+    d_nm.reset();
+  }
+
+  void testApplyAfterPop()
+  {
+    TypeNode intType = d_nm->integerType();
+    Node x = d_nm->mkSkolem("x", intType);
+    Node y = d_nm->mkSkolem("y", intType);
+    Node z = d_nm->mkSkolem("z", intType);
+    Node one = d_nm->mkConst(Rational(1));
+    Node five = d_nm->mkConst(Rational(5));
+    Node y1 = d_nm->mkNode(PLUS, y, one);
+    Node xz = d_nm->mkNode(PLUS, x, z);
+    Node xy = d_nm->mkNode(PLUS, x, y);
+
+    SubstitutionMap subs(d_context.get());
+    subs.addSubstitution(x, y1);
+    TS_ASSERT_EQUALS(subs.apply(xy), d_nm->mkNode(PLUS, y1, y));
+
+    d_context->push();
+    subs.addSubstitution(z, five);
+    TS_ASSERT_EQUALS(subs.apply(xz), d_nm->mkNode(PLUS, y1, five));
+    TS_ASSERT_EQUALS(subs.apply(xy), d_nm->mkNode(PLUS, y1, y));
+    d_context->pop();
+
+    // the substitutions of the popped level are not applied anymore, but
+    // the ones of the lower levels still are
+    TS_ASSERT(!subs.hasSubstitution(z));
+    TS_ASSERT_EQUALS(subs.apply(z), z);
+    TS_ASSERT_EQUALS(subs.apply(xz), d_nm->mkNode(PLUS, y1, z));
+    TS_ASSERT_EQUALS(subs.apply(xy), d_nm->mkNode(PLUS, y1, y));
+
+    // a new push does not see the entries of the popped level
+    d_context->push();
+    TS_ASSERT_EQUALS(subs.apply(xz), d_nm->mkNode(PLUS, y1, z));
+    subs.addSubstitution(y, five);
+    TS_ASSERT_EQUALS(subs.apply(xy),
+                     d_nm->mkNode(PLUS, d_nm->mkNode(PLUS, five, one), five));
+    d_context->pop();
+    TS_ASSERT_EQUALS(subs.apply(xy), d_nm->mkNode(PLUS, y1, y));
+  }
+
+ private:
+  std::unique_ptr<NodeManager> d_nm;
+  std::unique_ptr<NodeManagerScope> d_scope;
+  std::unique_ptr<Context> d_context;
+};
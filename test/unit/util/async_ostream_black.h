@@ -0,0 +1,57 @@
+/*********************                                                        */
+/*! \file async_ostream_black.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of CVC4::AsyncOstream.
+ **
+ ** Black box testing of CVC4::AsyncOstream.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include <sstream>
+#include <string>
+
+#include "util/async_ostream.h"
+
+using namespace CVC4;
+using namespace std;
+
+class AsyncOstreamBlack : public CxxTest::TestSuite
+{
+ public:
+  void testEmpty()
+  {
+    stringbuf buf;
+    delete new AsyncOstream(new ostream(&buf));
+    TS_ASSERT_EQUALS(buf.str(), "");
+  }
+
+  void testWrite()
+  {
+    stringbuf buf;
+    ostringstream expected;
+    AsyncOstream* out = new AsyncOstream(new ostream(&buf));
+    // Many chunks, with flushes
+    for (unsigned i = 0; i < 100000; ++i)
+    {
+      *out << "(assert (= x" << i << " " << i * i << "))" << endl;
+      expected << "(assert (= x" << i << " " << i * i << "))" << endl;
+    }
+    for (unsigned i = 0; i < 1000; ++i)
+    {
+      string line(i, 'a' + i % 26);
+      *out << line;
+      expected << line;
+    }
+    delete out;
+    TS_ASSERT_EQUALS(buf.str(), expected.str());
+  }
+};
@@ -556,4 +556,152 @@ public:
       }
     }
   }
+
+  void testSignedLongBoundaries()
+  {
+    const signed long lmax = numeric_limits<signed long>::max();
+    const signed long lmin = numeric_limits<signed long>::min();
+    const unsigned long ulmax = numeric_limits<unsigned long>::max();
+    // -lmin, the first value above the inline range
+    const Integer aboveMax(static_cast<unsigned long>(lmax) + 1);
+    const Integer max(lmax), min(lmin), one(1), zero(0);
+
+    TS_ASSERT_EQUALS(max + one, aboveMax);
+    TS_ASSERT_EQUALS(one + max, aboveMax);
+    TS_ASSERT_EQUALS(min + Integer(-1), -aboveMax - one);
+    TS_ASSERT_EQUALS(min + min, -aboveMax - aboveMax);
+    TS_ASSERT_EQUALS(max + max, Integer(ulmax - 1));
+    TS_ASSERT_EQUALS((max + min).getLong(), -1);
+
+    TS_ASSERT_EQUALS(min - one, -aboveMax - one);
+    TS_ASSERT_EQUALS(zero - min, aboveMax);
+    TS_ASSERT_EQUALS(max - min, Integer(ulmax));
+    TS_ASSERT_EQUALS(min - max, -Integer(ulmax));
+    TS_ASSERT_EQUALS((max - max).getLong(), 0);
+
+    TS_ASSERT_EQUALS(max * Integer(2), Integer(ulmax - 1));
+    TS_ASSERT_EQUALS(min * Integer(-1), aboveMax);
+    TS_ASSERT_EQUALS(Integer(-1) * min, aboveMax);
+    TS_ASSERT_EQUALS(min * Integer(2), -Integer(ulmax) - one);
+    TS_ASSERT_EQUALS(min * min, aboveMax * aboveMax);
+    TS_ASSERT_EQUALS((max * Integer(-1)).getLong(), -lmax);
+    TS_ASSERT_EQUALS((min * one).getLong(), lmin);
+
+    TS_ASSERT_EQUALS(-min, aboveMax);
+    TS_ASSERT_EQUALS((-max).getLong(), -lmax);
+    TS_ASSERT_EQUALS((-(-aboveMax)), aboveMax);
+    TS_ASSERT_EQUALS((-aboveMax).getLong(), lmin);
+
+    TS_ASSERT_EQUALS(min.abs(), aboveMax);
+    TS_ASSERT_EQUALS(max.abs().getLong(), lmax);
+    TS_ASSERT_EQUALS((min + one).abs().getLong(), lmax);
+    TS_ASSERT(!min.abs().fitsSignedLong());
+
+    TS_ASSERT(max.fitsSignedLong());
+    TS_ASSERT(min.fitsSignedLong());
+    TS_ASSERT(!aboveMax.fitsSignedLong());
+    TS_ASSERT(!(min - one).fitsSignedLong());
+  }
+
+  void testSignedLongDivision()
+  {
+    const signed long lmax = numeric_limits<signed long>::max();
+    const signed long lmin = numeric_limits<signed long>::min();
+    const Integer aboveMax(static_cast<unsigned long>(lmax) + 1);
+    const Integer min(lmin), zero(0);
+
+    // the only quotient of two inline values that does not fit into one
+    TS_ASSERT_EQUALS(min.floorDivideQuotient(-1), aboveMax);
+    TS_ASSERT_EQUALS(min.floorDivideRemainder(-1), zero);
+    TS_ASSERT_EQUALS(min.ceilingDivideQuotient(-1), aboveMax);
+    TS_ASSERT_EQUALS(min.ceilingDivideRemainder(-1), zero);
+    TS_ASSERT_EQUALS(min.euclidianDivideQuotient(-1), aboveMax);
+    TS_ASSERT_EQUALS(min.euclidianDivideRemainder(-1), zero);
+
+    TS_ASSERT_EQUALS(Integer(-7).floorDivideQuotient(2), Integer(-4));
+    TS_ASSERT_EQUALS(Integer(-7).floorDivideRemainder(2), Integer(1));
+    TS_ASSERT_EQUALS(Integer(7).floorDivideQuotient(-2), Integer(-4));
+    TS_ASSERT_EQUALS(Integer(7).floorDivideRemainder(-2), Integer(-1));
+    TS_ASSERT_EQUALS(Integer(-7).floorDivideQuotient(-2), Integer(3));
+    TS_ASSERT_EQUALS(Integer(-7).floorDivideRemainder(-2), Integer(-1));
+
+    TS_ASSERT_EQUALS(Integer(-7).ceilingDivideQuotient(2), Integer(-3));
+    TS_ASSERT_EQUALS(Integer(-7).ceilingDivideRemainder(2), Integer(-1));
+    TS_ASSERT_EQUALS(Integer(7).ceilingDivideQuotient(-2), Integer(-3));
+    TS_ASSERT_EQUALS(Integer(7).ceilingDivideRemainder(-2), Integer(1));
+    TS_ASSERT_EQUALS(Integer(-7).ceilingDivideQuotient(-2), Integer(4));
+    TS_ASSERT_EQUALS(Integer(-7).ceilingDivideRemainder(-2), Integer(1));
+
+    TS_ASSERT_EQUALS(Integer(-7).euclidianDivideQuotient(2), Integer(-4));
+    TS_ASSERT_EQUALS(Integer(-7).euclidianDivideRemainder(2), Integer(1));
+    TS_ASSERT_EQUALS(Integer(7).euclidianDivideQuotient(-2), Integer(-3));
+    TS_ASSERT_EQUALS(Integer(7).euclidianDivideRemainder(-2), Integer(1));
+    TS_ASSERT_EQUALS(Integer(-7).euclidianDivideQuotient(-2), Integer(4));
+    TS_ASSERT_EQUALS(Integer(-7).euclidianDivideRemainder(-2), Integer(1));
+
+    TS_ASSERT_EQUALS(min.floorDivideQuotient(lmax), Integer(-2));
+    TS_ASSERT_EQUALS(min.floorDivideRemainder(lmax), Integer(lmax - 1));
+    TS_ASSERT_EQUALS(min.ceilingDivideQuotient(lmax), Integer(-1));
+    TS_ASSERT_EQUALS(min.ceilingDivideRemainder(lmax), Integer(-1));
+    TS_ASSERT_EQUALS(min.euclidianDivideQuotient(-lmax), Integer(2));
+    TS_ASSERT_EQUALS(min.euclidianDivideRemainder(-lmax), Integer(lmax - 1));
+  }
+
+  void testSignedLongGcdLcm()
+  {
+    const signed long lmax = numeric_limits<signed long>::max();
+    const signed long lmin = numeric_limits<signed long>::min();
+    const unsigned long ulmax = numeric_limits<unsigned long>::max();
+    const Integer aboveMax(static_cast<unsigned long>(lmax) + 1);
+    const Integer max(lmax), min(lmin);
+
+    TS_ASSERT_EQUALS(min.gcd(min), aboveMax);
+    TS_ASSERT_EQUALS(min.gcd(0), aboveMax);
+    TS_ASSERT_EQUALS(Integer(0).gcd(min), aboveMax);
+    TS_ASSERT_EQUALS(min.gcd(max).getLong(), 1);
+    TS_ASSERT_EQUALS(min.gcd(-6).getLong(), 2);
+    TS_ASSERT_EQUALS(max.gcd(-max).getLong(), lmax);
+    TS_ASSERT_EQUALS(aboveMax.gcd(min + min), aboveMax);
+
+    TS_ASSERT_EQUALS(min.lcm(2), aboveMax);
+    TS_ASSERT_EQUALS(min.lcm(-1), aboveMax);
+    TS_ASSERT_EQUALS(min.lcm(3), aboveMax * Integer(3));
+    TS_ASSERT_EQUALS(max.lcm(2), Integer(ulmax - 1));
+    TS_ASSERT_EQUALS(max.lcm(max).getLong(), lmax);
+    TS_ASSERT_EQUALS(min.lcm(0).getLong(), 0);
+    TS_ASSERT_EQUALS(aboveMax.lcm(min), aboveMax);
+  }
+
+  void testShrinkBackToSignedLong()
+  {
+    const signed long lmax = numeric_limits<signed long>::max();
+    const signed long lmin = numeric_limits<signed long>::min();
+    const Integer max(lmax), min(lmin), one(1);
+    const Integer aboveMax = max + one;
+
+    // results that fit into a signed long again equal, and hash like, the
+    // values that never left it
+    Integer back = aboveMax - one;
+    TS_ASSERT_EQUALS(back, max);
+    TS_ASSERT_EQUALS(back.hash(), max.hash());
+    TS_ASSERT_EQUALS(back.getLong(), lmax);
+    TS_ASSERT_EQUALS((-aboveMax).getLong(), lmin);
+    TS_ASSERT_EQUALS((min - one + one).getLong(), lmin);
+    TS_ASSERT_EQUALS((aboveMax * aboveMax).floorDivideQuotient(aboveMax),
+                     aboveMax);
+    TS_ASSERT_EQUALS((aboveMax * Integer(6)).floorDivideQuotient(aboveMax)
+                         .getLong(),
+                     6);
+    TS_ASSERT_EQUALS((aboveMax * aboveMax).floorDivideRemainder(max).getLong(),
+                     1);
+    TS_ASSERT_EQUALS((aboveMax * Integer(0)).getLong(), 0);
+    TS_ASSERT_EQUALS((aboveMax - aboveMax).getLong(), 0);
+    TS_ASSERT_EQUALS((aboveMax * aboveMax).gcd(6).getLong(), 2);
+
+    Integer acc(lmax);
+    acc += one;
+    acc -= one;
+    TS_ASSERT_EQUALS(acc.getLong(), lmax);
+    TS_ASSERT_EQUALS(acc.hash(), max.hash());
+  }
 };
@@ -18,6 +18,8 @@
 
 #include <iostream>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include "base/output.h"
 
@@ -155,6 +157,43 @@ class OutputBlack : public CxxTest::TestSuite {
 #endif /* CVC4_MUZZLE */
   }
 
+  void testTraceTags()
+  {
+    TraceTag before("tag-before");
+    TraceChannel.on("tag-before");
+    TS_ASSERT(TraceChannel.isOn(before));
+    TraceTag after("tag-after");
+    TS_ASSERT(!TraceChannel.isOn(after));
+    TraceChannel.on("tag-after");
+    TS_ASSERT(TraceChannel.isOn(after));
+    TraceTag same("tag-after");
+    TS_ASSERT(TraceChannel.isOn(same));
+    TraceChannel.off("tag-before");
+    TS_ASSERT(!TraceChannel.isOn(before));
+    TS_ASSERT(TraceChannel.isOn(after));
+
+    // more tags than fit in one word of the bitmap
+    std::vector<std::string> names;
+    for (unsigned i = 0; i < 100; ++i)
+    {
+      names.push_back("tag-" + std::to_string(i));
+    }
+    std::vector<TraceTag> tags;
+    for (const std::string& name : names)
+    {
+      tags.push_back(TraceTag(name.c_str()));
+    }
+    TraceChannel.on("tag-99");
+    for (unsigned i = 0; i < 100; ++i)
+    {
+      TS_ASSERT_EQUALS(TraceChannel.isOn(tags[i]), i == 99);
+    }
+
+    TraceChannel.off();
+    TS_ASSERT(!TraceChannel.isOn(after));
+    TS_ASSERT(!TraceChannel.isOn(tags[99]));
+  }
+
   void testSimplePrint() {
 
 #ifdef CVC4_MUZZLE
@@ -15,6 +15,8 @@
  **/
 
 #include <cxxtest/TestSuite.h>
+
+#include <limits>
 #include <sstream>
 
 #include "util/rational.h"
@@ -44,4 +46,79 @@ public:
     TS_ASSERT_THROWS( Rational::fromDecimal("Hello, world!");, const std::invalid_argument& );
   }
 
+
+  void testSignedLongBoundaries()
+  {
+    const signed long lmax = numeric_limits<signed long>::max();
+    const signed long lmin = numeric_limits<signed long>::min();
+    // -lmin, the first value above the inline range
+    const Integer aboveMax(static_cast<unsigned long>(lmax) + 1);
+    const Rational max(lmax), min(lmin), one(1);
+
+    TS_ASSERT_EQUALS(-min, Rational(aboveMax));
+    TS_ASSERT_EQUALS(min.abs(), Rational(aboveMax));
+    TS_ASSERT_EQUALS(Rational(lmin, -1L), Rational(aboveMax));
+    TS_ASSERT_EQUALS(Rational(1L, lmin), Rational(Integer(-1), aboveMax));
+    TS_ASSERT_EQUALS(Rational(1L, lmin).getNumerator(), Integer(-1));
+    TS_ASSERT_EQUALS(Rational(1L, lmin).getDenominator(), aboveMax);
+    TS_ASSERT_EQUALS(Rational(1L, lmin).abs(), Rational(Integer(1), aboveMax));
+    TS_ASSERT(Rational(lmin, lmin).isOne());
+    TS_ASSERT(Rational(lmin, -lmax - 1).isOne());
+    TS_ASSERT(Rational(lmax, -lmax).isNegativeOne());
+
+    TS_ASSERT_EQUALS(max + one, Rational(aboveMax));
+    TS_ASSERT_EQUALS(min - one, Rational(-aboveMax - 1));
+    TS_ASSERT_EQUALS(Rational(lmax, 2L) + Rational(1, 2),
+                     Rational(aboveMax.floorDivideQuotient(2)));
+    TS_ASSERT_EQUALS(Rational(1L, lmax) + Rational(1L, lmin),
+                     Rational(Integer(1), Integer(lmax) * aboveMax));
+    TS_ASSERT_EQUALS(min * Rational(-1), Rational(aboveMax));
+    TS_ASSERT_EQUALS(min / Rational(-1), Rational(aboveMax));
+    TS_ASSERT(Rational(lmax, 2L) * Rational(2L, lmax) == one);
+    TS_ASSERT_EQUALS(Rational(lmin, 3L) * Rational(3, 2), Rational(lmin / 2));
+    TS_ASSERT_EQUALS(min.inverse(), Rational(Integer(-1), aboveMax));
+    TS_ASSERT_EQUALS(min.inverse().inverse(), min);
+
+    TS_ASSERT(min < max);
+    TS_ASSERT(Rational(1L, lmin) < Rational(1L, lmax));
+    TS_ASSERT(Rational(lmax - 1, lmax) > Rational(lmax - 2, lmax - 1));
+    TS_ASSERT_EQUALS(Rational(lmax, lmin).cmp(Rational(-1)), 1);
+  }
+
+  void testSignedLongRounding()
+  {
+    const signed long lmin = numeric_limits<signed long>::min();
+
+    TS_ASSERT_EQUALS(Rational(-7, 2).floor(), Integer(-4));
+    TS_ASSERT_EQUALS(Rational(-7, 2).ceiling(), Integer(-3));
+    TS_ASSERT_EQUALS(Rational(7, -2).floor(), Integer(-4));
+    TS_ASSERT_EQUALS(Rational(-7, -2).ceiling(), Integer(4));
+    TS_ASSERT_EQUALS(Rational(lmin).floor(), Integer(lmin));
+    TS_ASSERT_EQUALS(Rational(lmin + 1, 2L).floor(), Integer(lmin / 2));
+    TS_ASSERT_EQUALS(Rational(lmin + 1, 2L).ceiling(), Integer(lmin / 2 + 1));
+    TS_ASSERT_EQUALS(Rational(-1L, lmin).floor(), Integer(0));
+    TS_ASSERT_EQUALS(Rational(1L, lmin).floor(), Integer(-1));
+    TS_ASSERT_EQUALS(Rational(1L, lmin).ceiling(), Integer(0));
+  }
+
+  void testShrinkBackToSignedLong()
+  {
+    const signed long lmax = numeric_limits<signed long>::max();
+    const Integer aboveMax(static_cast<unsigned long>(lmax) + 1);
+    const Rational max(lmax), one(1);
+
+    // results that fit into signed longs again equal, and hash like, the
+    // values that never left them
+    Rational back = max + one - one;
+    TS_ASSERT_EQUALS(back, max);
+    TS_ASSERT_EQUALS(back.hash(), max.hash());
+    TS_ASSERT_EQUALS(back.getNumerator().getLong(), lmax);
+    Rational half(aboveMax, aboveMax + aboveMax);
+    TS_ASSERT_EQUALS(half, Rational(1, 2));
+    TS_ASSERT_EQUALS(half.hash(), Rational(1, 2).hash());
+    TS_ASSERT_EQUALS(half.getDenominator().getLong(), 2);
+    TS_ASSERT((Rational(aboveMax) * Rational(Integer(1), aboveMax)).isOne());
+    TS_ASSERT((Rational(aboveMax) / Rational(aboveMax)).isOne());
+    TS_ASSERT((Rational(aboveMax) - Rational(aboveMax)).isZero());
+  }
 };